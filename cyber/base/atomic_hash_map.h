@@ -19,18 +19,35 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "cyber/base/macros.h"
 
 namespace apollo {
 namespace cyber {
 namespace base {
 /**
- * @brief A implementation of lock-free fixed size hash map
+ * @brief A implementation of lock-free hash map with open addressing
+ *
+ * Keys are probed linearly from their hash, so a lookup usually touches a
+ * single cache line. A removed key leaves a tombstone that only the same
+ * key may reuse, tombstones are dropped when the table is rehashed. The
+ * table grows online once three quarters of its slots are used: lookups
+ * never block, writers wait while the entries are moved.
+ *
+ * Replacing or removing a value frees the old one right away, so a pointer
+ * returned by Get(key, &ptr) is only valid until the key is written again.
+ * Tables outgrown are kept until the map is destroyed, as readers may still
+ * be probing them, which costs at most the size of the current table.
  *
  * @tparam K Type of key, must be integral
  * @tparam V Type of value
- * @tparam 128 Size of hash table
+ * @tparam 128 Initial size of hash table
  * @tparam 0 Type traits, use for checking types of key & value
  */
 template <typename K, typename V, std::size_t TableSize = 128,
@@ -39,257 +56,294 @@ template <typename K, typename V, std::size_t TableSize = 128,
                                   int>::type = 0>
 class AtomicHashMap {
  public:
-  AtomicHashMap() : capacity_(TableSize), mode_num_(capacity_ - 1) {}
+  AtomicHashMap() : table_(new Table(TableSize > 1 ? TableSize : 2)) {}
   AtomicHashMap(const AtomicHashMap &other) = delete;
   AtomicHashMap &operator=(const AtomicHashMap &other) = delete;
+  ~AtomicHashMap() {
+    Table *table = table_.load(std::memory_order_acquire);
+    for (uint64_t i = 0; i < table->capacity; ++i) {
+      delete Untag(table->slots[i].value.load(std::memory_order_acquire));
+    }
+    delete table;
+  }
 
   bool Has(K key) {
-    uint64_t index = key & mode_num_;
-    return table_[index].Has(key);
+    V *value = nullptr;
+    return Get(key, &value);
   }
 
   bool Get(K key, V **value) {
-    uint64_t index = key & mode_num_;
-    return table_[index].Get(key, value);
+    Table *table = table_.load(std::memory_order_acquire);
+    uint64_t index = Hash(key) & table->mask;
+    for (uint64_t n = 0; n < table->capacity; ++n) {
+      Slot &slot = table->slots[index];
+      uint32_t state = slot.state.load(std::memory_order_acquire);
+      if (state == kEmpty || state == kSealed) {
+        return false;
+      }
+      if (state == kFull && slot.key == key) {
+        V *val = Untag(slot.value.load(std::memory_order_acquire));
+        if (val == nullptr) {
+          return false;
+        }
+        *value = val;
+        return true;
+      }
+      index = (index + 1) & table->mask;
+    }
+    return false;
   }
 
   bool Get(K key, V *value) {
-    uint64_t index = key & mode_num_;
     V *val = nullptr;
-    bool res = table_[index].Get(key, &val);
+    bool res = Get(key, &val);
     if (res) {
       *value = *val;
     }
     return res;
   }
 
-  void Set(K key) {
-    uint64_t index = key & mode_num_;
-    table_[index].Insert(key);
-  }
+  void Set(K key) { Insert(key, new V()); }
+
+  void Set(K key, const V &value) { Insert(key, new V(value)); }
 
-  void Set(K key, const V &value) {
-    uint64_t index = key & mode_num_;
-    table_[index].Insert(key, value);
+  void Set(K key, V &&value) { Insert(key, new V(std::forward<V>(value))); }
+
+  // Returns false if key was not there.
+  bool Remove(K key) {
+    while (true) {
+      Table *table = table_.load(std::memory_order_acquire);
+      int res = TryRemove(table, key);
+      if (res != kMoved) {
+        return res == kDone;
+      }
+      WaitForGrowth(table);
+    }
   }
 
-  void Set(K key, V &&value) {
-    uint64_t index = key & mode_num_;
-    table_[index].Insert(key, std::forward<V>(value));
+  // Number of keys with a value.
+  uint64_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  uint64_t Capacity() const {
+    return table_.load(std::memory_order_acquire)->capacity;
   }
 
  private:
-  struct Entry {
-    Entry() {}
-    explicit Entry(K key) : key(key) {
-      value_ptr.store(new V(), std::memory_order_release);
-    }
-    Entry(K key, const V &value) : key(key) {
-      value_ptr.store(new V(value), std::memory_order_release);
-    }
-    Entry(K key, V &&value) : key(key) {
-      value_ptr.store(new V(std::forward<V>(value)), std::memory_order_release);
-    }
-    ~Entry() { delete value_ptr.load(std::memory_order_acquire); }
+  // slot states, a slot only goes from empty to claimed to full, or from
+  // empty to sealed once its table is being moved
+  enum : uint32_t { kEmpty = 0, kClaimed, kFull, kSealed };
+
+  // results of a write on a single table
+  enum : int { kDone = 0, kNotFound, kMoved, kTableFull };
 
+  struct Slot {
+    std::atomic<uint32_t> state = {kEmpty};
     K key = 0;
-    std::atomic<V *> value_ptr = {nullptr};
-    std::atomic<Entry *> next = {nullptr};
+    // nullptr once removed, tagged once moved to a newer table
+    std::atomic<V *> value = {nullptr};
   };
 
-  class Bucket {
-   public:
-    Bucket() : head_(new Entry()) {}
-    ~Bucket() {
-      Entry *ite = head_;
-      while (ite) {
-        auto tmp = ite->next.load(std::memory_order_acquire);
-        delete ite;
-        ite = tmp;
-      }
+  struct Table {
+    explicit Table(uint64_t size)
+        : capacity(size), mask(size - 1), slots(new Slot[size]) {}
+    ~Table() { delete[] slots; }
+
+    const uint64_t capacity;
+    const uint64_t mask;
+    Slot *slots;
+    // claimed slots, tombstones included
+    std::atomic<uint64_t> used = {0};
+    std::atomic<bool> moving = {false};
+  };
+
+  static uint64_t Hash(K key) {
+    // murmur3 finalizer, ids that only differ in a few bits still spread
+    auto h = static_cast<uint64_t>(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  static bool IsTagged(V *value) {
+    return (reinterpret_cast<uintptr_t>(value) & 1) != 0;
+  }
+
+  static V *Tag(V *value) {
+    return reinterpret_cast<V *>(reinterpret_cast<uintptr_t>(value) | 1);
+  }
+
+  static V *Untag(V *value) {
+    return reinterpret_cast<V *>(reinterpret_cast<uintptr_t>(value) &
+                                 ~static_cast<uintptr_t>(1));
+  }
+
+  static uint32_t WaitClaimed(Slot *slot) {
+    uint32_t state = slot->state.load(std::memory_order_acquire);
+    while (state == kClaimed) {
+      cpu_relax();
+      state = slot->state.load(std::memory_order_acquire);
     }
+    return state;
+  }
 
-    bool Has(K key) {
-      Entry *m_target = head_->next.load(std::memory_order_acquire);
-      while (Entry *target = m_target) {
-        if (target->key < key) {
-          m_target = target->next.load(std::memory_order_acquire);
+  // Finds the slot of key, claims an empty one for it if create is set.
+  // Returns nullptr with *res set if there is none.
+  Slot *FindSlot(Table *table, K key, bool create, int *res) {
+    uint64_t index = Hash(key) & table->mask;
+    for (uint64_t n = 0; n < table->capacity; ++n) {
+      Slot &slot = table->slots[index];
+      uint32_t state = WaitClaimed(&slot);
+      if (state == kEmpty) {
+        if (!create) {
+          *res = table->moving.load() ? kMoved : kNotFound;
+          return nullptr;
+        }
+        if (!slot.state.compare_exchange_strong(state, kClaimed,
+                                                std::memory_order_acq_rel)) {
+          // lost the slot, look at it again
+          --n;
           continue;
-        } else {
-          return target->key == key;
         }
+        slot.key = key;
+        slot.state.store(kFull, std::memory_order_release);
+        table->used.fetch_add(1);
+        return &slot;
+      }
+      if (state == kSealed) {
+        *res = kMoved;
+        return nullptr;
       }
-      return false;
+      if (slot.key == key) {
+        return &slot;
+      }
+      index = (index + 1) & table->mask;
     }
+    *res = table->moving.load() ? kMoved : (create ? kTableFull : kNotFound);
+    return nullptr;
+  }
 
-    bool Find(K key, Entry **prev_ptr, Entry **target_ptr) {
-      Entry *prev = head_;
-      Entry *m_target = head_->next.load(std::memory_order_acquire);
-      while (Entry *target = m_target) {
-        if (target->key == key) {
-          *prev_ptr = prev;
-          *target_ptr = target;
-          return true;
-        } else if (target->key > key) {
-          *prev_ptr = prev;
-          *target_ptr = target;
-          return false;
-        } else {
-          prev = target;
-          m_target = target->next.load(std::memory_order_acquire);
-        }
+  int TrySet(Table *table, K key, V *value) {
+    int res = kDone;
+    Slot *slot = FindSlot(table, key, true, &res);
+    if (slot == nullptr) {
+      return res;
+    }
+    V *old = slot->value.load(std::memory_order_acquire);
+    do {
+      if (IsTagged(old)) {
+        return kMoved;
       }
-      *prev_ptr = prev;
-      *target_ptr = nullptr;
-      return false;
+    } while (!slot->value.compare_exchange_weak(old, value,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire));
+    if (old == nullptr) {
+      size_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      delete old;
     }
+    return kDone;
+  }
 
-    void Insert(K key, const V &value) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      Entry *new_entry = nullptr;
-      V *new_value = nullptr;
-      while (true) {
-        if (Find(key, &prev, &target)) {
-          // key exists, update value
-          if (!new_value) {
-            new_value = new V(value);
-          }
-          auto old_val_ptr = target->value_ptr.load(std::memory_order_acquire);
-          if (target->value_ptr.compare_exchange_strong(
-                  old_val_ptr, new_value, std::memory_order_acq_rel,
-                  std::memory_order_relaxed)) {
-            delete old_val_ptr;
-            if (new_entry) {
-              delete new_entry;
-              new_entry = nullptr;
-            }
-            return;
-          }
-          continue;
-        } else {
-          if (!new_entry) {
-            new_entry = new Entry(key, value);
-          }
-          new_entry->next.store(target, std::memory_order_release);
-          if (prev->next.compare_exchange_strong(target, new_entry,
-                                                 std::memory_order_acq_rel,
-                                                 std::memory_order_relaxed)) {
-            // Insert success
-            if (new_value) {
-              delete new_value;
-              new_value = nullptr;
-            }
-            return;
-          }
-          // another entry has been inserted, retry
-        }
-      }
+  int TryRemove(Table *table, K key) {
+    int res = kNotFound;
+    Slot *slot = FindSlot(table, key, false, &res);
+    if (slot == nullptr) {
+      return res;
     }
+    V *old = slot->value.load(std::memory_order_acquire);
+    do {
+      if (IsTagged(old)) {
+        return kMoved;
+      }
+      if (old == nullptr) {
+        return kNotFound;
+      }
+    } while (!slot->value.compare_exchange_weak(old, nullptr,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire));
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    delete old;
+    return kDone;
+  }
 
-    void Insert(K key, V &&value) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      Entry *new_entry = nullptr;
-      V *new_value = nullptr;
-      while (true) {
-        if (Find(key, &prev, &target)) {
-          // key exists, update value
-          if (!new_value) {
-            new_value = new V(std::forward<V>(value));
-          }
-          auto old_val_ptr = target->value_ptr.load(std::memory_order_acquire);
-          if (target->value_ptr.compare_exchange_strong(
-                  old_val_ptr, new_value, std::memory_order_acq_rel,
-                  std::memory_order_relaxed)) {
-            delete old_val_ptr;
-            if (new_entry) {
-              delete new_entry;
-              new_entry = nullptr;
-            }
-            return;
-          }
-          continue;
-        } else {
-          if (!new_entry) {
-            new_entry = new Entry(key, value);
-          }
-          new_entry->next.store(target, std::memory_order_release);
-          if (prev->next.compare_exchange_strong(target, new_entry,
-                                                 std::memory_order_acq_rel,
-                                                 std::memory_order_relaxed)) {
-            // Insert success
-            if (new_value) {
-              delete new_value;
-              new_value = nullptr;
-            }
-            return;
-          }
-          // another entry has been inserted, retry
+  void Insert(K key, V *value) {
+    while (true) {
+      Table *table = table_.load(std::memory_order_acquire);
+      int res = TrySet(table, key, value);
+      if (res == kDone) {
+        if (table->used.load() * 4 > table->capacity * 3) {
+          Grow(table);
         }
+        return;
+      }
+      if (res == kTableFull) {
+        Grow(table);
+      } else {
+        WaitForGrowth(table);
       }
     }
+  }
 
-    void Insert(K key) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      Entry *new_entry = nullptr;
-      V *new_value = nullptr;
-      while (true) {
-        if (Find(key, &prev, &target)) {
-          // key exists, update value
-          if (!new_value) {
-            new_value = new V();
-          }
-          auto old_val_ptr = target->value_ptr.load(std::memory_order_acquire);
-          if (target->value_ptr.compare_exchange_strong(
-                  old_val_ptr, new_value, std::memory_order_acq_rel,
-                  std::memory_order_relaxed)) {
-            delete old_val_ptr;
-            if (new_entry) {
-              delete new_entry;
-              new_entry = nullptr;
-            }
-            return;
-          }
-          continue;
-        } else {
-          if (!new_entry) {
-            new_entry = new Entry(key);
-          }
-          new_entry->next.store(target, std::memory_order_release);
-          if (prev->next.compare_exchange_strong(target, new_entry,
-                                                 std::memory_order_acq_rel,
-                                                 std::memory_order_relaxed)) {
-            // Insert success
-            if (new_value) {
-              delete new_value;
-              new_value = nullptr;
-            }
-            return;
-          }
-          // another entry has been inserted, retry
-        }
-      }
+  void WaitForGrowth(Table *table) {
+    while (table_.load(std::memory_order_acquire) == table) {
+      std::this_thread::yield();
     }
+  }
 
-    bool Get(K key, V **value) {
-      Entry *prev = nullptr;
-      Entry *target = nullptr;
-      if (Find(key, &prev, &target)) {
-        *value = target->value_ptr.load(std::memory_order_acquire);
-        return true;
+  // Moves the entries of table into a new one, twice as large unless most
+  // of its slots are tombstones.
+  void Grow(Table *table) {
+    std::lock_guard<std::mutex> lg(grow_mutex_);
+    if (table_.load(std::memory_order_acquire) != table) {
+      return;
+    }
+    uint64_t capacity = table->capacity;
+    if (size_.load() * 2 >= capacity) {
+      capacity *= 2;
+    }
+    std::unique_ptr<Table> new_table(new Table(capacity));
+    table->moving.store(true);
+    for (uint64_t i = 0; i < table->capacity; ++i) {
+      Slot &slot = table->slots[i];
+      uint32_t state = WaitClaimed(&slot);
+      while (state == kEmpty &&
+             !slot.state.compare_exchange_strong(state, kSealed,
+                                                 std::memory_order_acq_rel)) {
+        state = WaitClaimed(&slot);
       }
-      return false;
+      if (state != kFull) {
+        continue;
+      }
+      V *value = slot.value.load(std::memory_order_acquire);
+      while (!slot.value.compare_exchange_weak(value, Tag(value),
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+      }
+      if (value == nullptr) {
+        continue;
+      }
+      // nobody else sees the new table yet
+      uint64_t index = Hash(slot.key) & new_table->mask;
+      while (new_table->slots[index].state.load() != kEmpty) {
+        index = (index + 1) & new_table->mask;
+      }
+      Slot &new_slot = new_table->slots[index];
+      new_slot.key = slot.key;
+      new_slot.value.store(value, std::memory_order_relaxed);
+      new_slot.state.store(kFull, std::memory_order_relaxed);
+      new_table->used.fetch_add(1, std::memory_order_relaxed);
     }
+    table_.store(new_table.release(), std::memory_order_release);
+    retired_.emplace_back(table);
+  }
 
-    Entry *head_;
-  };
-
- private:
-  Bucket table_[TableSize];
-  uint64_t capacity_;
-  uint64_t mode_num_;
+  std::atomic<Table *> table_;
+  std::atomic<uint64_t> size_ = {0};
+  std::mutex grow_mutex_;
+  std::vector<std::unique_ptr<Table>> retired_;
 };
 
 }  // namespace base
@@ -98,6 +98,77 @@ TEST(AtomicHashMapTest, concurrency) {
   EXPECT_EQ("0", *str);
 }
 
+TEST(AtomicHashMapTest, remove) {
+  AtomicHashMap<uint64_t, int, 16> map;
+  int value = 0;
+  EXPECT_FALSE(map.Remove(1));
+  for (uint64_t i = 0; i < 1000; i++) {
+    map.Set(i, static_cast<int>(i));
+  }
+  EXPECT_EQ(1000, map.Size());
+  EXPECT_GE(map.Capacity(), 1000);
+
+  for (uint64_t i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(map.Remove(i));
+    EXPECT_FALSE(map.Remove(i));
+  }
+  EXPECT_EQ(500, map.Size());
+  for (uint64_t i = 0; i < 1000; i++) {
+    EXPECT_EQ(i % 2 == 1, map.Get(i, &value));
+    if (i % 2 == 1) {
+      EXPECT_EQ(i, value);
+    }
+  }
+
+  // a removed key can come back
+  map.Set(0, 42);
+  EXPECT_TRUE(map.Get(0, &value));
+  EXPECT_EQ(42, value);
+}
+
+TEST(AtomicHashMapTest, reclaim_tombstones) {
+  AtomicHashMap<uint64_t, int, 64> map;
+  // churn through far more keys than the table holds, as channels that come
+  // and go do, the table is rehashed instead of growing without bound
+  for (uint64_t i = 0; i < 100000; i++) {
+    map.Set(i, 1);
+    EXPECT_TRUE(map.Remove(i));
+  }
+  EXPECT_EQ(0, map.Size());
+  EXPECT_EQ(64, map.Capacity());
+}
+
+TEST(AtomicHashMapTest, concurrent_remove) {
+  AtomicHashMap<uint64_t, uint64_t, 32> map;
+  const int thread_num = 8;
+  const uint64_t key_num = 4096;
+  std::thread t[thread_num];
+  for (int i = 0; i < thread_num; i++) {
+    t[i] = std::thread([&, i]() {
+      for (uint64_t j = 0; j < key_num; j++) {
+        uint64_t key = j * thread_num + i;
+        map.Set(key, key);
+        if (j % 2 == 0) {
+          EXPECT_TRUE(map.Remove(key));
+        }
+      }
+    });
+  }
+  for (int i = 0; i < thread_num; i++) {
+    t[i].join();
+  }
+
+  EXPECT_EQ(thread_num * key_num / 2, map.Size());
+  uint64_t value = 0;
+  for (uint64_t key = 0; key < thread_num * key_num; key++) {
+    bool kept = (key / thread_num) % 2 == 1;
+    EXPECT_EQ(kept, map.Get(key, &value));
+    if (kept) {
+      EXPECT_EQ(key, value);
+    }
+  }
+}
+
 }  // namespace base
 }  // namespace cyber
 }  // namespace apollo
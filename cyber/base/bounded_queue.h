@@ -51,6 +51,12 @@ class BoundedQueue {
   bool WaitEnqueue(T&& element);
   bool Dequeue(T* element);
   bool WaitDequeue(T* element);
+  // Bulk versions claim the slots of all elements with a single CAS. They
+  // move as many as fit, or are available, and return how many that was.
+  template <typename InputIt>
+  uint64_t EnqueueBulk(InputIt first, uint64_t count);
+  uint64_t DequeueBulk(T* elements, uint64_t max_count);
+  uint64_t WaitDequeueBulk(T* elements, uint64_t max_count);
   uint64_t Size();
   bool Empty();
   void SetWaitStrategy(WaitStrategy* WaitStrategy);
@@ -167,6 +173,58 @@ bool BoundedQueue<T>::Dequeue(T* element) {
   return true;
 }
 
+template <typename T>
+template <typename InputIt>
+uint64_t BoundedQueue<T>::EnqueueBulk(InputIt first, uint64_t count) {
+  uint64_t num = 0;
+  uint64_t new_tail = 0;
+  uint64_t old_commit = 0;
+  uint64_t old_tail = tail_.load(std::memory_order_acquire);
+  do {
+    // one slot always stays free to tell a full queue from an empty one
+    uint64_t free_num =
+        head_.load(std::memory_order_acquire) + pool_size_ - 1 - old_tail;
+    num = std::min(count, free_num);
+    if (num == 0) {
+      return 0;
+    }
+    new_tail = old_tail + num;
+  } while (!tail_.compare_exchange_weak(old_tail, new_tail,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed));
+  for (uint64_t i = 0; i < num; ++i, ++first) {
+    pool_[GetIndex(old_tail + i)] = *first;
+  }
+  do {
+    old_commit = old_tail;
+  } while (cyber_unlikely(!commit_.compare_exchange_weak(
+      old_commit, new_tail, std::memory_order_acq_rel,
+      std::memory_order_relaxed)));
+  for (uint64_t i = 0; i < num; ++i) {
+    wait_strategy_->NotifyOne();
+  }
+  return num;
+}
+
+template <typename T>
+uint64_t BoundedQueue<T>::DequeueBulk(T* elements, uint64_t max_count) {
+  uint64_t num = 0;
+  uint64_t old_head = head_.load(std::memory_order_acquire);
+  do {
+    num = std::min(max_count,
+                   commit_.load(std::memory_order_acquire) - old_head - 1);
+    if (num == 0) {
+      return 0;
+    }
+    for (uint64_t i = 0; i < num; ++i) {
+      elements[i] = pool_[GetIndex(old_head + 1 + i)];
+    }
+  } while (!head_.compare_exchange_weak(old_head, old_head + num,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_relaxed));
+  return num;
+}
+
 template <typename T>
 bool BoundedQueue<T>::WaitEnqueue(const T& element) {
   while (!break_all_wait_) {
@@ -215,6 +273,23 @@ bool BoundedQueue<T>::WaitDequeue(T* element) {
   return false;
 }
 
+template <typename T>
+uint64_t BoundedQueue<T>::WaitDequeueBulk(T* elements, uint64_t max_count) {
+  while (!break_all_wait_) {
+    auto num = DequeueBulk(elements, max_count);
+    if (num > 0) {
+      return num;
+    }
+    if (wait_strategy_->EmptyWait()) {
+      continue;
+    }
+    // wait timeout
+    break;
+  }
+
+  return 0;
+}
+
 template <typename T>
 inline uint64_t BoundedQueue<T>::Size() {
   return tail_ - head_ - 1;
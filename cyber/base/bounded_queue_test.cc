@@ -17,6 +17,7 @@
 #include "cyber/base/bounded_queue.h"
 
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -161,6 +162,111 @@ TEST(BoundedQueueTest, busy_wait) {
   t.join();
 }
 
+TEST(BoundedQueueTest, futex_wait) {
+  BoundedQueue<int> queue;
+  queue.Init(100, new FutexWaitStrategy());
+  std::thread t([&]() {
+    int value = 0;
+    queue.WaitDequeue(&value);
+    EXPECT_EQ(100, value);
+    // only returns once broken
+    EXPECT_FALSE(queue.WaitDequeue(&value));
+  });
+  queue.Enqueue(100);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  queue.BreakAllWait();
+  t.join();
+
+  BoundedQueue<int> timeout_queue;
+  timeout_queue.Init(100, new FutexWaitStrategy(10));
+  int value = 0;
+  EXPECT_FALSE(timeout_queue.WaitDequeue(&value));
+}
+
+TEST(BoundedQueueTest, bulk) {
+  BoundedQueue<int> queue;
+  queue.Init(10);
+  std::vector<int> input(15);
+  for (int i = 0; i < 15; ++i) {
+    input[i] = i;
+  }
+  std::vector<int> output(15, -1);
+  EXPECT_EQ(0, queue.DequeueBulk(output.data(), output.size()));
+
+  EXPECT_EQ(4, queue.EnqueueBulk(input.begin(), 4));
+  EXPECT_EQ(4, queue.Size());
+  // only what fits is taken
+  EXPECT_EQ(6, queue.EnqueueBulk(input.begin() + 4, 11));
+  EXPECT_EQ(10, queue.Size());
+  EXPECT_EQ(0, queue.EnqueueBulk(input.begin() + 10, 5));
+
+  EXPECT_EQ(3, queue.DequeueBulk(output.data(), 3));
+  EXPECT_EQ(7, queue.DequeueBulk(output.data() + 3, 15));
+  EXPECT_TRUE(queue.Empty());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, output[i]);
+  }
+
+  // wraps around the end of the pool
+  for (int round = 0; round < 5; ++round) {
+    EXPECT_EQ(7, queue.EnqueueBulk(input.begin(), 7));
+    EXPECT_EQ(7, queue.DequeueBulk(output.data(), 15));
+    for (int i = 0; i < 7; ++i) {
+      EXPECT_EQ(i, output[i]);
+    }
+  }
+}
+
+TEST(BoundedQueueTest, bulk_concurrency) {
+  BoundedQueue<int> queue;
+  queue.Init(64, new FutexWaitStrategy());
+  const int kProducerNum = 4;
+  const int kBatchNum = 1000;
+  const int kBatchSize = 8;
+  std::atomic<int64_t> sum = {0};
+  std::atomic<int> received = {0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kProducerNum; ++i) {
+    threads.emplace_back([&]() {
+      std::vector<int> batch(kBatchSize);
+      for (int j = 0; j < kBatchNum; ++j) {
+        for (int k = 0; k < kBatchSize; ++k) {
+          batch[k] = j * kBatchSize + k;
+        }
+        uint64_t sent = 0;
+        while (sent < batch.size()) {
+          sent += queue.EnqueueBulk(batch.begin() + sent, batch.size() - sent);
+        }
+      }
+    });
+  }
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < 2; ++i) {
+    consumers.emplace_back([&]() {
+      int values[16];
+      uint64_t num = 0;
+      while ((num = queue.WaitDequeueBulk(values, 16)) > 0) {
+        for (uint64_t k = 0; k < num; ++k) {
+          sum += values[k];
+        }
+        received += static_cast<int>(num);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  while (received.load() < kProducerNum * kBatchNum * kBatchSize) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  queue.BreakAllWait();
+  for (auto& t : consumers) {
+    t.join();
+  }
+  const int64_t n = kBatchNum * kBatchSize;
+  EXPECT_EQ(kProducerNum * n * (n - 1) / 2, sum.load());
+}
+
 }  // namespace base
 }  // namespace cyber
 }  // namespace apollo
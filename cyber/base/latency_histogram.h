@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BASE_LATENCY_HISTOGRAM_H_
+#define CYBER_BASE_LATENCY_HISTOGRAM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+// Log2 histogram of durations. Bucket 0 counts samples under 1us, bucket i
+// counts samples in [2^(i-1), 2^i) us and the last bucket takes the rest.
+// Record() must not be called concurrently, readers may run at any time and
+// see a slightly stale but never torn view.
+class LatencyHistogram {
+ public:
+  static const uint32_t kBucketNum = 32;
+
+  void Record(uint64_t nanoseconds);
+  void Reset();
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t Sum() const { return sum_.load(std::memory_order_relaxed); }
+  uint64_t Max() const { return max_.load(std::memory_order_relaxed); }
+  uint64_t Bucket(uint32_t index) const {
+    return buckets_[index].load(std::memory_order_relaxed);
+  }
+
+  // upper bound in us of the bucket the given fraction of samples fall in
+  uint64_t Percentile(double fraction) const;
+
+  static uint32_t BucketIndex(uint64_t nanoseconds);
+
+ private:
+  static void Add(std::atomic<uint64_t>* counter, uint64_t value) {
+    counter->store(counter->load(std::memory_order_relaxed) + value,
+                   std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> buckets_[kBucketNum] = {};
+  std::atomic<uint64_t> count_ = {0};
+  std::atomic<uint64_t> sum_ = {0};
+  std::atomic<uint64_t> max_ = {0};
+};
+
+inline uint32_t LatencyHistogram::BucketIndex(uint64_t nanoseconds) {
+  uint64_t us = nanoseconds / 1000;
+  if (us == 0) {
+    return 0;
+  }
+  uint32_t index = 64 - __builtin_clzll(us);
+  return std::min(index, kBucketNum - 1);
+}
+
+inline void LatencyHistogram::Record(uint64_t nanoseconds) {
+  Add(&buckets_[BucketIndex(nanoseconds)], 1);
+  Add(&count_, 1);
+  Add(&sum_, nanoseconds);
+  if (nanoseconds > max_.load(std::memory_order_relaxed)) {
+    max_.store(nanoseconds, std::memory_order_relaxed);
+  }
+}
+
+inline void LatencyHistogram::Reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+inline uint64_t LatencyHistogram::Percentile(double fraction) const {
+  uint64_t total = 0;
+  uint64_t counts[kBucketNum];
+  for (uint32_t i = 0; i < kBucketNum; ++i) {
+    counts[i] = Bucket(i);
+    total += counts[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  auto rank = static_cast<uint64_t>(fraction * static_cast<double>(total));
+  uint64_t seen = 0;
+  for (uint32_t i = 0; i < kBucketNum; ++i) {
+    seen += counts[i];
+    if (seen > rank) {
+      return 1ULL << i;
+    }
+  }
+  return 1ULL << (kBucketNum - 1);
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BASE_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/base/latency_histogram.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace base {
+
+TEST(LatencyHistogramTest, bucket_index) {
+  EXPECT_EQ(LatencyHistogram::BucketIndex(0), 0);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(999), 0);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(1000), 1);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(1999), 1);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(2000), 2);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(1000 * 1000), 10);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX),
+            LatencyHistogram::kBucketNum - 1);
+}
+
+TEST(LatencyHistogramTest, record) {
+  LatencyHistogram hist;
+  EXPECT_EQ(hist.Count(), 0);
+  EXPECT_EQ(hist.Percentile(0.5), 0);
+
+  for (int i = 0; i < 98; ++i) {
+    hist.Record(1500);
+  }
+  hist.Record(50 * 1000);
+  hist.Record(3 * 1000 * 1000);
+  EXPECT_EQ(hist.Count(), 100);
+  EXPECT_EQ(hist.Sum(), 98 * 1500 + 50 * 1000 + 3 * 1000 * 1000);
+  EXPECT_EQ(hist.Max(), 3 * 1000 * 1000);
+  EXPECT_EQ(hist.Bucket(1), 98);
+  EXPECT_EQ(hist.Percentile(0.5), 2);
+  EXPECT_EQ(hist.Percentile(0.98), 64);
+  EXPECT_EQ(hist.Percentile(0.999), 4096);
+
+  hist.Reset();
+  EXPECT_EQ(hist.Count(), 0);
+  EXPECT_EQ(hist.Max(), 0);
+  EXPECT_EQ(hist.Bucket(1), 0);
+}
+
+}  // namespace base
+}  // namespace cyber
+}  // namespace apollo
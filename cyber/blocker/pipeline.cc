@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/blocker/pipeline.h"
+
+#include <sstream>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/log.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace blocker {
+
+constexpr uint64_t Pipeline::kReportInterval;
+
+void StageStats::Record(uint64_t ns) {
+  total_ns.fetch_add(ns, std::memory_order_relaxed);
+  uint64_t max = max_ns.load(std::memory_order_relaxed);
+  while (ns > max &&
+         !max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+  }
+  uint64_t runs = count.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (runs % Pipeline::kReportInterval == 0) {
+    AINFO << "pipeline stage " << name << " runs: " << runs
+          << ", avg: " << total_ns.load(std::memory_order_relaxed) / runs / 1000
+          << "us, max: " << max_ns.load(std::memory_order_relaxed) / 1000
+          << "us";
+  }
+}
+
+StageTimer::StageTimer(const std::shared_ptr<StageStats>& stats)
+    : stats_(stats) {
+  if (stats_ != nullptr) {
+    start_ns_ = Time::MonoTime().ToNanosecond();
+  }
+}
+
+StageTimer::~StageTimer() {
+  if (stats_ != nullptr) {
+    stats_->Record(Time::MonoTime().ToNanosecond() - start_ns_);
+  }
+}
+
+Pipeline::Pipeline() {
+  std::stringstream channels(common::GetEnv("CYBER_PIPELINE_CHANNELS"));
+  std::string channel;
+  while (std::getline(channels, channel, ',')) {
+    if (!channel.empty()) {
+      channels_.insert(channel);
+    }
+  }
+}
+
+bool Pipeline::Contains(const std::string& channel_name) const {
+  return !channels_.empty() && channels_.count(channel_name) > 0;
+}
+
+bool Pipeline::CheckReaders(const proto::ComponentConfig& config,
+                            bool* pipelined) const {
+  int fused = 0;
+  for (const auto& reader : config.readers()) {
+    if (Contains(reader.channel())) {
+      ++fused;
+    }
+  }
+  *pipelined = fused > 0;
+  if (fused > 0 && fused != config.readers_size()) {
+    AERROR << "component " << config.name()
+           << " mixes pipeline channels with transport channels.";
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<StageStats> Pipeline::Stage(const std::string& name) {
+  std::lock_guard<std::mutex> lock(stage_mutex_);
+  auto& stage = stages_[name];
+  if (stage == nullptr) {
+    stage = std::make_shared<StageStats>(name);
+  }
+  return stage;
+}
+
+}  // namespace blocker
+}  // namespace cyber
+}  // namespace apollo
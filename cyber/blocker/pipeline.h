@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BLOCKER_PIPELINE_H_
+#define CYBER_BLOCKER_PIPELINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "cyber/proto/component_conf.pb.h"
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace blocker {
+
+struct StageStats {
+  explicit StageStats(const std::string& stage_name) : name(stage_name) {}
+
+  void Record(uint64_t ns);
+
+  const std::string name;
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> total_ns{0};
+  std::atomic<uint64_t> max_ns{0};
+};
+
+/**
+ * @brief Accounts the time of one stage run to stats, does nothing for
+ * nullptr.
+ */
+class StageTimer {
+ public:
+  explicit StageTimer(const std::shared_ptr<StageStats>& stats);
+  ~StageTimer();
+
+ private:
+  std::shared_ptr<StageStats> stats_;
+  uint64_t start_ns_ = 0;
+};
+
+/**
+ * @class Pipeline
+ * @brief The channels listed in CYBER_PIPELINE_CHANNELS (comma separated)
+ * are carried by the blocker even in reality mode. Writing to one of them
+ * calls the readers of the channel in the same thread and hands them the
+ * pointer that was written, so components reading only pipeline channels
+ * run synchronously behind their upstream stage, without dispatcher or
+ * croutine in between. These channels stay inside the process, readers
+ * in other processes do not see them.
+ */
+class Pipeline {
+ public:
+  bool Contains(const std::string& channel_name) const;
+
+  /**
+   * @brief find out whether the readers of config are fused into the
+   * pipeline.
+   * @return false if only part of the readers are pipeline channels, which
+   * can not be served by either mode.
+   */
+  bool CheckReaders(const proto::ComponentConfig& config,
+                    bool* pipelined) const;
+
+  /**
+   * @brief the timing of the stage, reported every kReportInterval runs.
+   */
+  std::shared_ptr<StageStats> Stage(const std::string& name);
+
+  static constexpr uint64_t kReportInterval = 1000;
+
+ private:
+  std::unordered_set<std::string> channels_;
+  std::unordered_map<std::string, std::shared_ptr<StageStats>> stages_;
+  std::mutex stage_mutex_;
+
+  DECLARE_SINGLETON(Pipeline)
+};
+
+}  // namespace blocker
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BLOCKER_PIPELINE_H_
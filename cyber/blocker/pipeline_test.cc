@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/blocker/pipeline.h"
+
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "cyber/component/component.h"
+#include "cyber/init.h"
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace blocker {
+
+using apollo::cyber::proto::Chatter;
+
+class Forwarder : public Component<Chatter> {
+ public:
+  bool Init() override {
+    writer_ = node_->CreateWriter<Chatter>("/pipeline/b");
+    return writer_ != nullptr;
+  }
+
+  bool Proc(const std::shared_ptr<Chatter>& msg) override {
+    msg->set_seq(msg->seq() + 1);
+    return writer_->Write(msg);
+  }
+
+ private:
+  std::shared_ptr<Writer<Chatter>> writer_;
+};
+
+class Sink : public Component<Chatter> {
+ public:
+  bool Init() override { return true; }
+
+  bool Proc(const std::shared_ptr<Chatter>& msg) override {
+    received = msg;
+    thread_id = std::this_thread::get_id();
+    return true;
+  }
+
+  std::shared_ptr<Chatter> received;
+  std::thread::id thread_id;
+};
+
+TEST(PipelineTest, contains) {
+  auto pipeline = Pipeline::Instance();
+  EXPECT_TRUE(pipeline->Contains("/pipeline/a"));
+  EXPECT_TRUE(pipeline->Contains("/pipeline/b"));
+  EXPECT_FALSE(pipeline->Contains("/pipeline/c"));
+
+  proto::ComponentConfig config;
+  config.set_name("mixed");
+  config.add_readers()->set_channel("/pipeline/a");
+  bool pipelined = false;
+  EXPECT_TRUE(pipeline->CheckReaders(config, &pipelined));
+  EXPECT_TRUE(pipelined);
+
+  config.add_readers()->set_channel("/pipeline/c");
+  EXPECT_FALSE(pipeline->CheckReaders(config, &pipelined));
+}
+
+TEST(PipelineTest, fused_components) {
+  proto::ComponentConfig forwarder_config;
+  forwarder_config.set_name("forwarder");
+  forwarder_config.add_readers()->set_channel("/pipeline/a");
+  auto forwarder = std::make_shared<Forwarder>();
+  ASSERT_TRUE(forwarder->Initialize(forwarder_config));
+
+  proto::ComponentConfig sink_config;
+  sink_config.set_name("sink");
+  sink_config.add_readers()->set_channel("/pipeline/b");
+  auto sink = std::make_shared<Sink>();
+  ASSERT_TRUE(sink->Initialize(sink_config));
+
+  auto node = CreateNode("pipeline_source");
+  auto writer = node->CreateWriter<Chatter>("/pipeline/a");
+  ASSERT_NE(nullptr, writer);
+
+  auto msg = std::make_shared<Chatter>();
+  msg->set_seq(1);
+  EXPECT_TRUE(writer->Write(msg));
+
+  // both stages ran before Write returned, on this thread, on msg itself
+  EXPECT_EQ(msg, sink->received);
+  EXPECT_EQ(2, sink->received->seq());
+  EXPECT_EQ(std::this_thread::get_id(), sink->thread_id);
+
+  EXPECT_EQ(1, Pipeline::Instance()->Stage("forwarder")->count.load());
+  EXPECT_EQ(1, Pipeline::Instance()->Stage("sink")->count.load());
+}
+
+}  // namespace blocker
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  setenv("CYBER_PIPELINE_CHANNELS", "/pipeline/a,/pipeline/b", 1);
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  auto res = RUN_ALL_TESTS();
+  apollo::cyber::Clear();
+  return res;
+}
@@ -18,8 +18,9 @@
 namespace apollo {
 namespace cyber {
 namespace class_loader {
-ClassLoader::ClassLoader(const std::string& library_path)
+ClassLoader::ClassLoader(const std::string& library_path, bool bind_now)
     : library_path_(library_path),
+      bind_now_(bind_now),
       loadlib_ref_count_(0),
       classobj_ref_count_(0) {
   LoadLibrary();
@@ -35,7 +36,7 @@ bool ClassLoader::LoadLibrary() {
   std::lock_guard<std::mutex> lck(loadlib_ref_count_mutex_);
   ++loadlib_ref_count_;
   AINFO << "Begin LoadLibrary: " << library_path_;
-  return utility::LoadLibrary(library_path_, this);
+  return utility::LoadLibrary(library_path_, this, bind_now_);
 }
 
 int ClassLoader::UnloadLibrary() {
@@ -34,7 +34,7 @@ namespace class_loader {
  */
 class ClassLoader {
  public:
-  explicit ClassLoader(const std::string& library_path);
+  explicit ClassLoader(const std::string& library_path, bool bind_now = false);
   virtual ~ClassLoader();
 
   bool IsLibraryLoaded();
@@ -54,6 +54,7 @@ class ClassLoader {
 
  private:
   std::string library_path_;
+  bool bind_now_;
   int loadlib_ref_count_;
   std::mutex loadlib_ref_count_mutex_;
   int classobj_ref_count_;
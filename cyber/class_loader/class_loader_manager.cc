@@ -15,6 +15,13 @@
  *****************************************************************************/
 #include "cyber/class_loader/class_loader_manager.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "cyber/class_loader/utility/library_prefetcher.h"
+
 namespace apollo {
 namespace cyber {
 namespace class_loader {
@@ -62,6 +69,68 @@ bool ClassLoaderManager::LoadLibrary(const std::string& library_path) {
   return IsLibraryValid(library_path);
 }
 
+bool ClassLoaderManager::PreloadLibraries(
+    const std::vector<std::string>& library_paths, int thread_num) {
+  auto start = std::chrono::steady_clock::now();
+  utility::LibraryPrefetcher prefetcher;
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> threads;
+  const size_t num = std::min(library_paths.size(),
+                              static_cast<size_t>(std::max(thread_num, 1)));
+  for (size_t i = 0; i < num; ++i) {
+    threads.emplace_back([&library_paths, &next, &prefetcher]() {
+      for (size_t index = next++; index < library_paths.size();
+           index = next++) {
+        prefetcher.Prefetch(library_paths[index]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto prefetch_end = std::chrono::steady_clock::now();
+  AINFO << "Prefetch " << prefetcher.FileNum() << " files of "
+        << prefetcher.ByteNum() / (1024 * 1024) << " MB on " << num
+        << " threads in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(
+               prefetch_end - start)
+               .count()
+        << " ms";
+
+  // registering the classes of a library is serialized by the loader anyway,
+  // and several dags may depend on the order, so libraries load one by one
+  bool ret = true;
+  for (const auto& library_path : library_paths) {
+    auto load_start = std::chrono::steady_clock::now();
+    bool loaded = false;
+    {
+      std::lock_guard<std::mutex> lck(libpath_loader_map_mutex_);
+      if (!IsLibraryValid(library_path)) {
+        libpath_loader_map_[library_path] =
+            new class_loader::ClassLoader(library_path, true);
+      }
+      loaded = IsLibraryValid(library_path) &&
+               libpath_loader_map_[library_path]->IsLibraryLoaded();
+    }
+    if (!loaded) {
+      AERROR << "Preload library failed: " << library_path;
+      ret = false;
+      continue;
+    }
+    AINFO << "Preload library " << library_path << " in "
+          << std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - load_start)
+                 .count()
+          << " ms";
+  }
+  AINFO << "Preload " << library_paths.size() << " libraries in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now() - start)
+               .count()
+        << " ms";
+  return ret;
+}
+
 int ClassLoaderManager::UnloadLibrary(const std::string& library_path) {
   int num_remain_unload = 0;
   if (IsLibraryValid(library_path)) {
@@ -35,6 +35,14 @@ class ClassLoaderManager {
   virtual ~ClassLoaderManager();
 
   bool LoadLibrary(const std::string& library_path);
+  /**
+   * @brief Load the libraries before any class is created. Files of the
+   * libraries and their dependencies are read in on thread_num threads,
+   * then each library is loaded in order with all symbols bound at once.
+   * Later LoadLibrary calls for these paths find them already loaded.
+   */
+  bool PreloadLibraries(const std::vector<std::string>& library_paths,
+                        int thread_num);
   void UnloadAllLibrary();
   bool IsLibraryValid(const std::string& library_path);
   template <typename Base>
@@ -118,6 +118,21 @@ TEST(ClassLoaderManagerTest, testClassLoaderManager) {
   SUCCEED();
 }
 
+TEST(ClassLoaderManagerTest, preloadLibraries) {
+  ClassLoaderManager loader_mgr;
+  ASSERT_TRUE(loader_mgr.PreloadLibraries({LIBRARY_1, LIBRARY_2}, 2));
+  EXPECT_TRUE(loader_mgr.IsLibraryValid(LIBRARY_1));
+  EXPECT_TRUE(loader_mgr.IsLibraryValid(LIBRARY_2));
+  EXPECT_TRUE(loader_mgr.LoadLibrary(LIBRARY_1));
+  EXPECT_TRUE(loader_mgr.IsClassValid<Base>("Rect"));
+  EXPECT_TRUE(loader_mgr.IsClassValid<Base>("Pear"));
+  EXPECT_NE(nullptr, loader_mgr.CreateClassObj<Base>("Pear", LIBRARY_2));
+
+  ClassLoaderManager missing_mgr;
+  EXPECT_FALSE(missing_mgr.PreloadLibraries({"libNull.so"}, 1));
+  loader_mgr.UnloadAllLibrary();
+}
+
 void CreateObj(ClassLoaderManager* loader) {
   std::vector<std::string> classes = loader->GetValidClassNames<Base>();
   for (unsigned int i = 0; i < classes.size(); i++) {
@@ -16,6 +16,8 @@
 
 #include "cyber/class_loader/utility/class_loader_utility.h"
 
+#include <dlfcn.h>
+
 #include "cyber/class_loader/class_loader.h"
 
 namespace apollo {
@@ -193,7 +195,8 @@ bool IsLibraryLoaded(const std::string& library_path,
           (num_lib_loader_class_factory_objs <= num_lib_class_factory_objs));
 }
 
-bool LoadLibrary(const std::string& library_path, ClassLoader* loader) {
+bool LoadLibrary(const std::string& library_path, ClassLoader* loader,
+                 bool bind_now) {
   if (IsLibraryLoadedByAnybody(library_path)) {
     AINFO << "lib has been loaded by others,only attach to class factory obj."
           << library_path;
@@ -210,9 +213,18 @@ bool LoadLibrary(const std::string& library_path, ClassLoader* loader) {
   {
     std::lock_guard<std::recursive_mutex> lck(loader_mutex);
 
+    void* bound_handle = nullptr;
     try {
       SetCurActiveClassLoader(loader);
       SetCurLoadingLibraryName(library_path);
+      // Poco always binds lazily, open the library once ourselves so it is
+      // relocated right now, Poco then only takes another reference
+      if (bind_now) {
+        bound_handle = dlopen(library_path.c_str(), RTLD_NOW | RTLD_GLOBAL);
+        if (bound_handle == nullptr) {
+          AWARN << "Bind library now failed: " << dlerror();
+        }
+      }
       poco_library = PocoLibraryPtr(new Poco::SharedLibrary(library_path));
     } catch (const Poco::LibraryLoadException& e) {
       SetCurLoadingLibraryName("");
@@ -227,6 +239,9 @@ bool LoadLibrary(const std::string& library_path, ClassLoader* loader) {
       SetCurActiveClassLoader(nullptr);
       AERROR << "poco NotFoundException: " << e.message();
     }
+    if (bound_handle != nullptr) {
+      dlclose(bound_handle);
+    }
 
     SetCurLoadingLibraryName("");
     SetCurActiveClassLoader(nullptr);
@@ -64,7 +64,10 @@ ClassLoader* GetCurActiveClassLoader();
 void SetCurActiveClassLoader(ClassLoader* loader);
 bool IsLibraryLoaded(const std::string& library_path, ClassLoader* loader);
 bool IsLibraryLoadedByAnybody(const std::string& library_path);
-bool LoadLibrary(const std::string& library_path, ClassLoader* loader);
+// bind_now resolves all symbols of the library and the dependencies it pulls
+// in at load time instead of at their first call
+bool LoadLibrary(const std::string& library_path, ClassLoader* loader,
+                 bool bind_now = false);
 void UnloadLibrary(const std::string& library_path, ClassLoader* loader);
 template <typename Derived, typename Base>
 void RegisterClass(const std::string& class_name,
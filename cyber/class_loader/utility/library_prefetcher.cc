@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/class_loader/utility/library_prefetcher.h"
+
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace class_loader {
+namespace utility {
+
+namespace {
+
+std::string DirName(const std::string& path) {
+  auto pos = path.rfind('/');
+  if (pos == std::string::npos) {
+    return ".";
+  }
+  return pos == 0 ? "/" : path.substr(0, pos);
+}
+
+void AppendDirs(const std::string& dirs, const std::string& origin,
+                std::vector<std::string>* out) {
+  std::stringstream ss(dirs);
+  std::string dir;
+  while (std::getline(ss, dir, ':')) {
+    if (dir.empty()) {
+      continue;
+    }
+    for (const std::string token : {"${ORIGIN}", "$ORIGIN"}) {
+      auto pos = dir.find(token);
+      while (pos != std::string::npos) {
+        dir.replace(pos, token.size(), origin);
+        pos = dir.find(token, pos + origin.size());
+      }
+    }
+    out->push_back(dir);
+  }
+}
+
+}  // namespace
+
+void LibraryPrefetcher::Prefetch(const std::string& library_path) {
+  if (!MarkVisited(library_path)) {
+    return;
+  }
+  int fd = open(library_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    ADEBUG << "Open library failed, skip prefetching: " << library_path;
+    return;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  if (readahead(fd, 0, size) != 0) {
+    ADEBUG << "readahead failed, errno: " << errno << ", " << library_path;
+  }
+  ++file_num_;
+  byte_num_ += size;
+
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return;
+  }
+  std::vector<std::string> needed;
+  std::vector<std::string> dirs;
+  ReadDynamic(static_cast<const char*>(data), size, DirName(library_path),
+              &needed, &dirs);
+  munmap(data, size);
+
+  for (const auto& name : needed) {
+    const std::string path = Resolve(name, dirs);
+    if (!path.empty()) {
+      Prefetch(path);
+    }
+  }
+}
+
+bool LibraryPrefetcher::MarkVisited(const std::string& path) {
+  std::lock_guard<std::mutex> lock(visited_mutex_);
+  return visited_.insert(path).second;
+}
+
+void LibraryPrefetcher::ReadDynamic(const char* data, size_t size,
+                                    const std::string& origin,
+                                    std::vector<std::string>* needed,
+                                    std::vector<std::string>* dirs) const {
+  if (size < sizeof(Elf64_Ehdr) || std::memcmp(data, ELFMAG, SELFMAG) != 0 ||
+      data[EI_CLASS] != ELFCLASS64) {
+    return;
+  }
+  const auto* ehdr = reinterpret_cast<const Elf64_Ehdr*>(data);
+  if (ehdr->e_phentsize != sizeof(Elf64_Phdr) ||
+      ehdr->e_phoff + ehdr->e_phnum * sizeof(Elf64_Phdr) > size) {
+    return;
+  }
+  const auto* phdr = reinterpret_cast<const Elf64_Phdr*>(data + ehdr->e_phoff);
+  const Elf64_Phdr* dynamic = nullptr;
+  for (int i = 0; i < ehdr->e_phnum; ++i) {
+    if (phdr[i].p_type == PT_DYNAMIC) {
+      dynamic = &phdr[i];
+      break;
+    }
+  }
+  if (dynamic == nullptr || dynamic->p_offset + dynamic->p_filesz > size) {
+    return;
+  }
+
+  const auto* dyn =
+      reinterpret_cast<const Elf64_Dyn*>(data + dynamic->p_offset);
+  const size_t dyn_num = dynamic->p_filesz / sizeof(Elf64_Dyn);
+  uint64_t strtab = 0;
+  uint64_t strsz = 0;
+  std::vector<uint64_t> needed_offsets;
+  int64_t rpath = -1;
+  int64_t runpath = -1;
+  for (size_t i = 0; i < dyn_num && dyn[i].d_tag != DT_NULL; ++i) {
+    switch (dyn[i].d_tag) {
+      case DT_STRTAB:
+        strtab = dyn[i].d_un.d_ptr;
+        break;
+      case DT_STRSZ:
+        strsz = dyn[i].d_un.d_val;
+        break;
+      case DT_NEEDED:
+        needed_offsets.push_back(dyn[i].d_un.d_val);
+        break;
+      case DT_RPATH:
+        rpath = static_cast<int64_t>(dyn[i].d_un.d_val);
+        break;
+      case DT_RUNPATH:
+        runpath = static_cast<int64_t>(dyn[i].d_un.d_val);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // the string table is given as an address, find it through the segment
+  // that loads it
+  uint64_t strtab_offset = 0;
+  bool found = false;
+  for (int i = 0; i < ehdr->e_phnum; ++i) {
+    if (phdr[i].p_type == PT_LOAD && strtab >= phdr[i].p_vaddr &&
+        strtab < phdr[i].p_vaddr + phdr[i].p_filesz) {
+      strtab_offset = strtab - phdr[i].p_vaddr + phdr[i].p_offset;
+      found = true;
+      break;
+    }
+  }
+  if (!found || strtab_offset + strsz > size) {
+    return;
+  }
+  const char* strings = data + strtab_offset;
+  auto get_string = [strings, strsz](uint64_t offset) {
+    if (offset >= strsz) {
+      return std::string();
+    }
+    return std::string(strings + offset,
+                       strnlen(strings + offset, strsz - offset));
+  };
+
+  for (auto offset : needed_offsets) {
+    needed->push_back(get_string(offset));
+  }
+  if (runpath < 0 && rpath >= 0) {
+    AppendDirs(get_string(rpath), origin, dirs);
+  }
+  const char* ld_library_path = std::getenv("LD_LIBRARY_PATH");
+  if (ld_library_path != nullptr) {
+    AppendDirs(ld_library_path, origin, dirs);
+  }
+  if (runpath >= 0) {
+    AppendDirs(get_string(runpath), origin, dirs);
+  }
+}
+
+std::string LibraryPrefetcher::Resolve(
+    const std::string& name, const std::vector<std::string>& dirs) const {
+  if (name.empty()) {
+    return "";
+  }
+  if (name.find('/') != std::string::npos) {
+    return access(name.c_str(), R_OK) == 0 ? name : "";
+  }
+  for (const auto& dir : dirs) {
+    std::string path = dir + "/" + name;
+    if (access(path.c_str(), R_OK) == 0) {
+      return path;
+    }
+  }
+  return "";
+}
+
+}  // namespace utility
+}  // namespace class_loader
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CLASS_LOADER_UTILITY_LIBRARY_PREFETCHER_H_
+#define CYBER_CLASS_LOADER_UTILITY_LIBRARY_PREFETCHER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace class_loader {
+namespace utility {
+
+/**
+ * Reads shared libraries and the dependencies they name into the page cache
+ * so that dlopen does not stall on disk. Dependencies are found through the
+ * DT_NEEDED entries with the RPATH, LD_LIBRARY_PATH and RUNPATH of the
+ * library, the system directories are left alone. Prefetch is safe to call
+ * from several threads, each file is read once.
+ */
+class LibraryPrefetcher {
+ public:
+  void Prefetch(const std::string& library_path);
+
+  uint64_t FileNum() const { return file_num_.load(); }
+  uint64_t ByteNum() const { return byte_num_.load(); }
+
+ private:
+  bool MarkVisited(const std::string& path);
+  void ReadDynamic(const char* data, size_t size, const std::string& origin,
+                   std::vector<std::string>* needed,
+                   std::vector<std::string>* dirs) const;
+  std::string Resolve(const std::string& name,
+                      const std::vector<std::string>& dirs) const;
+
+  std::mutex visited_mutex_;
+  std::unordered_set<std::string> visited_;
+  std::atomic<uint64_t> file_num_ = {0};
+  std::atomic<uint64_t> byte_num_ = {0};
+};
+
+}  // namespace utility
+}  // namespace class_loader
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CLASS_LOADER_UTILITY_LIBRARY_PREFETCHER_H_
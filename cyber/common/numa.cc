@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/common/numa.h"
+
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace common {
+
+namespace {
+
+// from linux/mempolicy.h, which is not always installed
+const int kMpolPreferred = 1;
+const unsigned kMpolMfMove = 1 << 1;
+const int kMaxNode = 64;
+
+thread_local int thread_numa_node = -1;
+
+// calls f with the number of every "<prefix>N" entry in dir
+template <typename F>
+void ForEachNumbered(const std::string& dir, const char* prefix, F f) {
+  DIR* d = opendir(dir.c_str());
+  if (d == nullptr) {
+    return;
+  }
+  size_t prefix_len = strlen(prefix);
+  struct dirent* entry = nullptr;
+  while ((entry = readdir(d)) != nullptr) {
+    const char* name = entry->d_name;
+    if (strncmp(name, prefix, prefix_len) != 0) {
+      continue;
+    }
+    char* end = nullptr;
+    long num = strtol(name + prefix_len, &end, 10);  // NOLINT
+    if (end != name + prefix_len && *end == '\0') {
+      f(static_cast<int>(num));
+    }
+  }
+  closedir(d);
+}
+
+bool NodeValid(int node) {
+  return node >= 0 && node < kMaxNode && NumaNodeNum() > 1;
+}
+
+}  // namespace
+
+int NumaNodeNum() {
+  static const int num = []() {
+    int count = 0;
+    ForEachNumbered("/sys/devices/system/node", "node",
+                    [&count](int) { ++count; });
+    return count > 0 ? count : 1;
+  }();
+  return num;
+}
+
+int NumaNodeOfCpu(int cpu) {
+  int node = -1;
+  ForEachNumbered("/sys/devices/system/cpu/cpu" + std::to_string(cpu), "node",
+                  [&node](int n) { node = n; });
+  return node;
+}
+
+int NumaNodeOfCpus(const std::vector<int>& cpus) {
+  int node = -1;
+  for (auto cpu : cpus) {
+    int n = NumaNodeOfCpu(cpu);
+    if (n < 0 || (node >= 0 && n != node)) {
+      return -1;
+    }
+    node = n;
+  }
+  return node;
+}
+
+std::string SharedCacheOfCpu(int cpu) {
+  std::string dir =
+      "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache";
+  int last_index = -1;
+  ForEachNumbered(dir, "index", [&last_index](int index) {
+    if (index > last_index) {
+      last_index = index;
+    }
+  });
+  if (last_index < 0) {
+    return "";
+  }
+  std::ifstream in(dir + "/index" + std::to_string(last_index) +
+                   "/shared_cpu_list");
+  std::string list;
+  std::getline(in, list);
+  return list;
+}
+
+bool SetThreadNumaNode(int node) {
+  if (!NodeValid(node)) {
+    return false;
+  }
+  uint64_t mask = 1ULL << node;
+  if (syscall(SYS_set_mempolicy, kMpolPreferred, &mask, kMaxNode + 1) != 0) {
+    AWARN << "set_mempolicy to node " << node
+          << " failed: " << strerror(errno);
+    return false;
+  }
+  thread_numa_node = node;
+  return true;
+}
+
+int ThreadNumaNode() { return thread_numa_node; }
+
+bool BindToNumaNode(void* addr, size_t len, int node) {
+  if (addr == nullptr || len == 0 || !NodeValid(node)) {
+    return false;
+  }
+  static const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  uintptr_t begin = reinterpret_cast<uintptr_t>(addr) & ~(page - 1);
+  uintptr_t end =
+      (reinterpret_cast<uintptr_t>(addr) + len + page - 1) & ~(page - 1);
+  uint64_t mask = 1ULL << node;
+  if (syscall(SYS_mbind, begin, end - begin, kMpolPreferred, &mask,
+              kMaxNode + 1, kMpolMfMove) != 0) {
+    AWARN << "mbind to node " << node << " failed: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace common
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_COMMON_NUMA_H_
+#define CYBER_COMMON_NUMA_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace common {
+
+// Number of NUMA nodes the kernel reports, 1 on machines without NUMA.
+int NumaNodeNum();
+
+// Node of cpu, -1 if it cannot be told.
+int NumaNodeOfCpu(int cpu);
+
+// The node all of cpus are on, -1 if they are on several or unknown.
+int NumaNodeOfCpus(const std::vector<int>& cpus);
+
+// The cpus sharing the last level cache with cpu, in the kernel's list
+// format, empty if unknown.
+std::string SharedCacheOfCpu(int cpu);
+
+// Memory the calling thread touches from now on is taken from node when
+// it has some left. A node < 0, or a machine with a single node, leaves
+// the policy alone.
+bool SetThreadNumaNode(int node);
+
+// The node given to SetThreadNumaNode on this thread, -1 if none.
+int ThreadNumaNode();
+
+// Places [addr, addr + len) on node, the pages already touched are moved.
+bool BindToNumaNode(void* addr, size_t len, int node);
+
+}  // namespace common
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_COMMON_NUMA_H_
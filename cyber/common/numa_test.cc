@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/common/numa.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace common {
+
+TEST(NumaTest, topology) {
+  EXPECT_GE(NumaNodeNum(), 1);
+  EXPECT_EQ(NumaNodeOfCpus({}), -1);
+  EXPECT_EQ(NumaNodeOfCpu(-1), -1);
+
+  int node = NumaNodeOfCpu(0);
+  if (node >= 0) {
+    EXPECT_LT(node, NumaNodeNum());
+    EXPECT_EQ(NumaNodeOfCpus({0}), node);
+  }
+}
+
+TEST(NumaTest, bind) {
+  EXPECT_FALSE(SetThreadNumaNode(-1));
+  EXPECT_EQ(ThreadNumaNode(), -1);
+
+  std::vector<char> buf(4096);
+  EXPECT_FALSE(BindToNumaNode(nullptr, buf.size(), 0));
+  EXPECT_FALSE(BindToNumaNode(buf.data(), 0, 0));
+  EXPECT_FALSE(BindToNumaNode(buf.data(), buf.size(), -1));
+  if (NumaNodeNum() == 1) {
+    // nothing to choose from, the policy is left alone
+    EXPECT_FALSE(SetThreadNumaNode(0));
+    EXPECT_FALSE(BindToNumaNode(buf.data(), buf.size(), 0));
+  }
+}
+
+}  // namespace common
+}  // namespace cyber
+}  // namespace apollo
@@ -23,6 +23,7 @@
 
 #include "cyber/base/macros.h"
 #include "cyber/blocker/blocker_manager.h"
+#include "cyber/blocker/pipeline.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/types.h"
 #include "cyber/common/util.h"
@@ -174,7 +175,16 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
     return false;
   }
 
-  bool is_reality_mode = GlobalData::Instance()->IsRealityMode();
+  bool is_pipelined = false;
+  if (!blocker::Pipeline::Instance()->CheckReaders(config, &is_pipelined)) {
+    return false;
+  }
+  bool is_reality_mode =
+      GlobalData::Instance()->IsRealityMode() && !is_pipelined;
+  std::shared_ptr<blocker::StageStats> stage = nullptr;
+  if (is_pipelined) {
+    stage = blocker::Pipeline::Instance()->Stage(config.name());
+  }
 
   ReaderConfig reader_cfg;
   reader_cfg.channel_name = config.readers(0).channel();
@@ -183,9 +193,10 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
 
   std::weak_ptr<Component<M0>> self =
       std::dynamic_pointer_cast<Component<M0>>(shared_from_this());
-  auto func = [self](const std::shared_ptr<M0>& msg) {
+  auto func = [self, stage](const std::shared_ptr<M0>& msg) {
     auto ptr = self.lock();
     if (ptr) {
+      blocker::StageTimer timer(stage);
       ptr->Process(msg);
     } else {
       AERROR << "Component object has been destroyed.";
@@ -244,7 +255,16 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
     return false;
   }
 
-  bool is_reality_mode = GlobalData::Instance()->IsRealityMode();
+  bool is_pipelined = false;
+  if (!blocker::Pipeline::Instance()->CheckReaders(config, &is_pipelined)) {
+    return false;
+  }
+  bool is_reality_mode =
+      GlobalData::Instance()->IsRealityMode() && !is_pipelined;
+  std::shared_ptr<blocker::StageStats> stage = nullptr;
+  if (is_pipelined) {
+    stage = blocker::Pipeline::Instance()->Stage(config.name());
+  }
 
   ReaderConfig reader_cfg;
   reader_cfg.channel_name = config.readers(1).channel();
@@ -267,11 +287,12 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
     auto blocker1 = blocker::BlockerManager::Instance()->GetBlocker<M1>(
         config.readers(1).channel());
 
-    auto func = [self, blocker1](const std::shared_ptr<M0>& msg0) {
+    auto func = [self, blocker1, stage](const std::shared_ptr<M0>& msg0) {
       auto ptr = self.lock();
       if (ptr) {
         if (!blocker1->IsPublishedEmpty()) {
           auto msg1 = blocker1->GetLatestPublishedPtr();
+          blocker::StageTimer timer(stage);
           ptr->Process(msg0, msg1);
         }
       } else {
@@ -341,7 +362,16 @@ bool Component<M0, M1, M2, NullType>::Initialize(
     return false;
   }
 
-  bool is_reality_mode = GlobalData::Instance()->IsRealityMode();
+  bool is_pipelined = false;
+  if (!blocker::Pipeline::Instance()->CheckReaders(config, &is_pipelined)) {
+    return false;
+  }
+  bool is_reality_mode =
+      GlobalData::Instance()->IsRealityMode() && !is_pipelined;
+  std::shared_ptr<blocker::StageStats> stage = nullptr;
+  if (is_pipelined) {
+    stage = blocker::Pipeline::Instance()->Stage(config.name());
+  }
 
   ReaderConfig reader_cfg;
   reader_cfg.channel_name = config.readers(1).channel();
@@ -372,12 +402,14 @@ bool Component<M0, M1, M2, NullType>::Initialize(
     auto blocker2 = blocker::BlockerManager::Instance()->GetBlocker<M2>(
         config.readers(2).channel());
 
-    auto func = [self, blocker1, blocker2](const std::shared_ptr<M0>& msg0) {
+    auto func = [self, blocker1, blocker2,
+                 stage](const std::shared_ptr<M0>& msg0) {
       auto ptr = self.lock();
       if (ptr) {
         if (!blocker1->IsPublishedEmpty() && !blocker2->IsPublishedEmpty()) {
           auto msg1 = blocker1->GetLatestPublishedPtr();
           auto msg2 = blocker2->GetLatestPublishedPtr();
+          blocker::StageTimer timer(stage);
           ptr->Process(msg0, msg1, msg2);
         }
       } else {
@@ -451,7 +483,16 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
     return false;
   }
 
-  bool is_reality_mode = GlobalData::Instance()->IsRealityMode();
+  bool is_pipelined = false;
+  if (!blocker::Pipeline::Instance()->CheckReaders(config, &is_pipelined)) {
+    return false;
+  }
+  bool is_reality_mode =
+      GlobalData::Instance()->IsRealityMode() && !is_pipelined;
+  std::shared_ptr<blocker::StageStats> stage = nullptr;
+  if (is_pipelined) {
+    stage = blocker::Pipeline::Instance()->Stage(config.name());
+  }
 
   ReaderConfig reader_cfg;
   reader_cfg.channel_name = config.readers(1).channel();
@@ -491,8 +532,8 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
     auto blocker3 = blocker::BlockerManager::Instance()->GetBlocker<M3>(
         config.readers(3).channel());
 
-    auto func = [self, blocker1, blocker2,
-                 blocker3](const std::shared_ptr<M0>& msg0) {
+    auto func = [self, blocker1, blocker2, blocker3,
+                 stage](const std::shared_ptr<M0>& msg0) {
       auto ptr = self.lock();
       if (ptr) {
         if (!blocker1->IsPublishedEmpty() && !blocker2->IsPublishedEmpty() &&
@@ -500,6 +541,7 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
           auto msg1 = blocker1->GetLatestPublishedPtr();
           auto msg2 = blocker2->GetLatestPublishedPtr();
           auto msg3 = blocker3->GetLatestPublishedPtr();
+          blocker::StageTimer timer(stage);
           ptr->Process(msg0, msg1, msg2, msg3);
         }
       } else {
@@ -16,6 +16,7 @@
 
 #include "cyber/component/timer_component.h"
 
+#include "cyber/scheduler/realtime_executor.h"
 #include "cyber/timer/timer.h"
 
 namespace apollo {
@@ -38,6 +39,13 @@ bool TimerComponent::Initialize(const TimerComponentConfig& config) {
     return false;
   }
   node_.reset(new Node(config.name()));
+  scheduler::RealtimeOption option;
+  bool realtime =
+      scheduler::RealtimeExecutor::GetOption(config.name(), &option);
+  if (realtime) {
+    // lock before Init() so the memory it preallocates is resident
+    scheduler::RealtimeExecutor::LockMemory();
+  }
   LoadConfigFiles(config);
   if (!Init()) {
     return false;
@@ -46,12 +54,20 @@ bool TimerComponent::Initialize(const TimerComponentConfig& config) {
   std::shared_ptr<TimerComponent> self =
       std::dynamic_pointer_cast<TimerComponent>(shared_from_this());
   auto func = [self]() { self->Proc(); };
+  if (realtime) {
+    option.period_ms = config.interval();
+    executor_.reset(new scheduler::RealtimeExecutor(option));
+    return executor_->Start(func);
+  }
   timer_.reset(new Timer(config.interval(), func, false));
   timer_->Start();
   return true;
 }
 
-void TimerComponent::Clear() { timer_.reset(); }
+void TimerComponent::Clear() {
+  timer_.reset();
+  executor_.reset();
+}
 
 uint64_t TimerComponent::GetInterval() const { return interval_; }
 
@@ -26,11 +26,18 @@ namespace cyber {
 
 class Timer;
 
+namespace scheduler {
+class RealtimeExecutor;
+}  // namespace scheduler
+
 /**
  * @brief .
  * TimerComponent is a timer component. Your component can inherit from
  * Component, and implement Init() & Proc(), They are called by the CyberRT
  * frame.
+ *
+ * A component listed in CYBER_REALTIME_COMPONENTS runs Proc() on its own
+ * SCHED_FIFO thread instead of the shared timer, see RealtimeExecutor.
  */
 class TimerComponent : public ComponentBase {
  public:
@@ -48,6 +55,7 @@ class TimerComponent : public ComponentBase {
   void Clear() override;
   bool Process();
   uint64_t GetInterval() const;
+  bool IsRealtime() const { return executor_ != nullptr; }
 
  private:
   /**
@@ -59,6 +67,7 @@ class TimerComponent : public ComponentBase {
 
   uint64_t interval_ = 0;
   std::unique_ptr<Timer> timer_;
+  std::unique_ptr<scheduler::RealtimeExecutor> executor_;
 };
 
 }  // namespace cyber
@@ -17,12 +17,15 @@
 #include "cyber/croutine/croutine.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <string>
 #include <utility>
 
-#include "cyber/base/concurrent_object_pool.h"
+#include "cyber/common/environment.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
+#include "cyber/croutine/detail/stack_pool.h"
 
 namespace apollo {
 namespace cyber {
@@ -32,9 +35,13 @@ thread_local CRoutine *CRoutine::current_routine_ = nullptr;
 thread_local char *CRoutine::main_stack_ = nullptr;
 
 namespace {
-std::shared_ptr<base::CCObjectPool<RoutineContext>> context_pool = nullptr;
+std::shared_ptr<StackPool> stack_pool = nullptr;
 std::once_flag pool_init_flag;
 
+bool EnvFlag(const std::string &name) {
+  return std::strtol(common::GetEnv(name, "0").c_str(), nullptr, 10) != 0;
+}
+
 void CRoutineEntry(void *arg) {
   CRoutine *r = static_cast<CRoutine *>(arg);
   r->Run();
@@ -42,8 +49,8 @@ void CRoutineEntry(void *arg) {
 }
 }  // namespace
 
-CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
-  std::call_once(pool_init_flag, [&]() {
+void CRoutine::InitContextPool() {
+  std::call_once(pool_init_flag, []() {
     uint32_t routine_num = common::GlobalData::Instance()->ComponentNums();
     auto &global_conf = common::GlobalData::Instance()->Config();
     if (global_conf.has_scheduler_conf() &&
@@ -51,14 +58,36 @@ CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
       routine_num =
           std::max(routine_num, global_conf.scheduler_conf().routine_num());
     }
-    context_pool.reset(new base::CCObjectPool<RoutineContext>(routine_num));
+
+    size_t stack_size = STACK_SIZE;
+    auto stack_kb = std::strtoull(
+        common::GetEnv("CYBER_ROUTINE_STACK_KB", "0").c_str(), nullptr, 10);
+    if (stack_kb > 0) {
+      stack_size = stack_kb * 1024;
+    }
+    bool guard_page = EnvFlag("CYBER_ROUTINE_STACK_GUARD");
+    bool prefault = EnvFlag("CYBER_ROUTINE_STACK_PREFAULT");
+
+    stack_pool = std::make_shared<StackPool>(stack_size, guard_page);
+    auto reserved = stack_pool->Reserve(routine_num, prefault);
+    ADEBUG << "reserved " << reserved << " routine stacks of "
+           << stack_pool->stack_size() << " bytes, guard page: " << guard_page
+           << ", prefault: " << prefault;
   });
+}
 
-  context_ = context_pool->GetObject();
-  if (context_ == nullptr) {
+CRoutine::CRoutine(const std::function<void()> &func) : func_(func) {
+  InitContextPool();
+
+  if (cyber_unlikely(stack_pool->FreeNum() == 0)) {
     AWARN << "Maximum routine context number exceeded! Please check "
              "[routine_num] in config file.";
-    context_.reset(new RoutineContext());
+  }
+  context_ = stack_pool->GetContext();
+  if (context_ == nullptr) {
+    AERROR << "no stack for routine, it will never run.";
+    state_ = RoutineState::FINISHED;
+    return;
   }
 
   MakeContext(CRoutineEntry, this, context_.get());
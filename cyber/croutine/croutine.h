@@ -25,6 +25,7 @@
 #include <set>
 #include <string>
 
+#include "cyber/base/latency_histogram.h"
 #include "cyber/common/log.h"
 #include "cyber/croutine/detail/routine_context.h"
 
@@ -49,6 +50,12 @@ class CRoutine {
   static CRoutine *GetCurrentRoutine();
   static char **GetMainStack();
 
+  // Reserves the routine stacks, which are sized by CYBER_ROUTINE_STACK_KB
+  // and optionally guarded (CYBER_ROUTINE_STACK_GUARD) and pre-faulted
+  // (CYBER_ROUTINE_STACK_PREFAULT). Called by cyber::Init, later calls are
+  // no-ops.
+  static void InitContextPool();
+
   // public interfaces
   bool Acquire();
   void Release();
@@ -88,6 +95,16 @@ class CRoutine {
 
   std::chrono::steady_clock::time_point wake_time() const;
 
+  // steady clock nanoseconds of the first SetUpdateFlag() since the last
+  // call, 0 if the croutine was not notified in between
+  uint64_t TakeNotifyTime();
+  // same without consuming it
+  uint64_t notify_time() const;
+
+  // only written by the processor holding the croutine (see Acquire)
+  base::LatencyHistogram *wake_to_run() { return &wake_to_run_; }
+  base::LatencyHistogram *run_time() { return &run_time_; }
+
   void set_group_name(const std::string &group_name) {
     group_name_ = group_name;
   }
@@ -109,6 +126,10 @@ class CRoutine {
 
   std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
   std::atomic_flag updated_ = ATOMIC_FLAG_INIT;
+  std::atomic<uint64_t> notify_time_ = {0};
+
+  base::LatencyHistogram wake_to_run_;
+  base::LatencyHistogram run_time_;
 
   bool force_stop_ = false;
 
@@ -203,9 +224,26 @@ inline void CRoutine::Release() {
 }
 
 inline void CRoutine::SetUpdateFlag() {
+  if (notify_time_.load(std::memory_order_relaxed) == 0) {
+    notify_time_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                           .count(),
+                       std::memory_order_relaxed);
+  }
   updated_.clear(std::memory_order_release);
 }
 
+inline uint64_t CRoutine::notify_time() const {
+  return notify_time_.load(std::memory_order_relaxed);
+}
+
+inline uint64_t CRoutine::TakeNotifyTime() {
+  if (notify_time_.load(std::memory_order_relaxed) == 0) {
+    return 0;
+  }
+  return notify_time_.exchange(0, std::memory_order_relaxed);
+}
+
 }  // namespace croutine
 }  // namespace cyber
 }  // namespace apollo
@@ -39,14 +39,12 @@ constexpr size_t REGISTERS_SIZE = 56;
 #endif
 
 typedef void (*func)(void*);
+// The stack memory is owned by the StackPool the context comes from.
 struct RoutineContext {
-  char stack[STACK_SIZE];
+  char* stack = nullptr;
+  size_t stack_size = 0;
   char* sp = nullptr;
-#if defined __aarch64__
-} __attribute__((aligned(16)));
-#else
 };
-#endif
 
 void MakeContext(const func& f1, const void* arg, RoutineContext* ctx);
 
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+StackPool::StackPool(size_t stack_size, bool guard_page) {
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  stack_size_ = (stack_size + page_size - 1) / page_size * page_size;
+  if (stack_size_ == 0) {
+    stack_size_ = page_size;
+  }
+  guard_size_ = guard_page ? page_size : 0;
+}
+
+StackPool::~StackPool() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  for (auto ctx : all_) {
+    munmap(ctx->stack - guard_size_, guard_size_ + stack_size_);
+    delete ctx;
+  }
+  all_.clear();
+  free_.clear();
+}
+
+uint32_t StackPool::Reserve(uint32_t num, bool prefault) {
+  uint32_t i = 0;
+  for (; i < num; ++i) {
+    auto ctx = Allocate(prefault);
+    if (ctx == nullptr) {
+      break;
+    }
+    std::lock_guard<std::mutex> lg(mutex_);
+    free_.emplace_back(ctx);
+  }
+  return i;
+}
+
+std::shared_ptr<RoutineContext> StackPool::GetContext() {
+  RoutineContext *ctx = nullptr;
+  {
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (!free_.empty()) {
+      ctx = free_.back();
+      free_.pop_back();
+    }
+  }
+  if (ctx == nullptr) {
+    ctx = Allocate(false);
+    if (ctx == nullptr) {
+      return nullptr;
+    }
+  }
+
+  auto self = shared_from_this();
+  return std::shared_ptr<RoutineContext>(
+      ctx, [self](RoutineContext *ctx) { self->Release(ctx); });
+}
+
+uint32_t StackPool::FreeNum() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  return static_cast<uint32_t>(free_.size());
+}
+
+uint32_t StackPool::TotalNum() {
+  std::lock_guard<std::mutex> lg(mutex_);
+  return static_cast<uint32_t>(all_.size());
+}
+
+RoutineContext *StackPool::Allocate(bool prefault) {
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+  if (prefault) {
+    flags |= MAP_POPULATE;
+  }
+  void *addr = mmap(nullptr, guard_size_ + stack_size_,
+                    PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (addr == MAP_FAILED) {
+    AERROR << "map routine stack failed: " << strerror(errno);
+    return nullptr;
+  }
+
+  char *base = static_cast<char *>(addr);
+  if (guard_size_ > 0 && mprotect(base, guard_size_, PROT_NONE) != 0) {
+    AERROR << "protect routine stack guard failed: " << strerror(errno);
+    munmap(addr, guard_size_ + stack_size_);
+    return nullptr;
+  }
+
+  auto ctx = new RoutineContext();
+  ctx->stack = base + guard_size_;
+  ctx->stack_size = stack_size_;
+  std::lock_guard<std::mutex> lg(mutex_);
+  all_.emplace_back(ctx);
+  return ctx;
+}
+
+void StackPool::Release(RoutineContext *ctx) {
+  ctx->sp = nullptr;
+  std::lock_guard<std::mutex> lg(mutex_);
+  free_.emplace_back(ctx);
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
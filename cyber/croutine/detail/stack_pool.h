@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_CROUTINE_STACK_POOL_H_
+#define CYBER_CROUTINE_STACK_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cyber/croutine/detail/routine_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+// Hands out routine contexts whose stacks are mmapped once and recycled,
+// so creating a croutine does not allocate and, when pre-faulted, its
+// first run does not page fault either. With guard_page set the page
+// below every stack is made inaccessible to catch overflows.
+class StackPool : public std::enable_shared_from_this<StackPool> {
+ public:
+  StackPool(size_t stack_size, bool guard_page);
+  virtual ~StackPool();
+
+  // maps num more stacks, touching all of their pages if prefault is set
+  uint32_t Reserve(uint32_t num, bool prefault);
+
+  // a free context, or a newly mapped one when none is left
+  std::shared_ptr<RoutineContext> GetContext();
+
+  size_t stack_size() const { return stack_size_; }
+  size_t guard_size() const { return guard_size_; }
+  uint32_t FreeNum();
+  uint32_t TotalNum();
+
+ private:
+  StackPool(StackPool &) = delete;
+  StackPool &operator=(StackPool &) = delete;
+
+  RoutineContext *Allocate(bool prefault);
+  void Release(RoutineContext *ctx);
+
+  size_t stack_size_ = 0;
+  size_t guard_size_ = 0;
+
+  std::mutex mutex_;
+  std::vector<RoutineContext *> free_;
+  std::vector<RoutineContext *> all_;
+};
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_CROUTINE_STACK_POOL_H_
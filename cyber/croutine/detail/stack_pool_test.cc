@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/croutine/detail/stack_pool.h"
+
+#include <unistd.h>
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace croutine {
+
+TEST(StackPoolTest, reuse) {
+  auto pool = std::make_shared<StackPool>(64 * 1024 + 1, false);
+  EXPECT_EQ(pool->stack_size() % sysconf(_SC_PAGESIZE), 0);
+  EXPECT_GT(pool->stack_size(), 64 * 1024);
+  EXPECT_EQ(pool->Reserve(2, true), 2);
+  EXPECT_EQ(pool->FreeNum(), 2);
+
+  char* stack = nullptr;
+  {
+    auto ctx = pool->GetContext();
+    ASSERT_NE(ctx, nullptr);
+    EXPECT_EQ(ctx->stack_size, pool->stack_size());
+    ctx->stack[0] = 1;
+    ctx->stack[ctx->stack_size - 1] = 1;
+    stack = ctx->stack;
+    EXPECT_EQ(pool->FreeNum(), 1);
+  }
+  EXPECT_EQ(pool->FreeNum(), 2);
+  EXPECT_EQ(pool->GetContext()->stack, stack);
+
+  // grows past the reserved number of stacks
+  auto ctx0 = pool->GetContext();
+  auto ctx1 = pool->GetContext();
+  auto ctx2 = pool->GetContext();
+  ASSERT_NE(ctx2, nullptr);
+  EXPECT_EQ(pool->FreeNum(), 0);
+  EXPECT_EQ(pool->TotalNum(), 3);
+}
+
+TEST(StackPoolTest, guard_page) {
+  auto pool = std::make_shared<StackPool>(64 * 1024, true);
+  EXPECT_EQ(pool->guard_size(), sysconf(_SC_PAGESIZE));
+  auto ctx = pool->GetContext();
+  ASSERT_NE(ctx, nullptr);
+  ctx->stack[0] = 1;
+  EXPECT_DEATH(ctx->stack[-1] = 1, "");
+}
+
+}  // namespace croutine
+}  // namespace cyber
+}  // namespace apollo
@@ -24,6 +24,7 @@
 #include "cyber/common/log.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/data/data_visitor.h"
+#include "cyber/data/sync_data_visitor.h"
 #include "cyber/event/perf_event_cache.h"
 
 namespace apollo {
@@ -141,6 +142,28 @@ RoutineFactory CreateRoutineFactory(
   return factory;
 }
 
+template <typename M0, typename... Ms, typename F>
+RoutineFactory CreateRoutineFactory(
+    F&& f, const std::shared_ptr<data::SyncDataVisitor<M0, Ms...>>& dv) {
+  RoutineFactory factory;
+  factory.SetDataVisitor(dv);
+  factory.create_routine = [=]() {
+    return [=]() {
+      typename data::SyncDataVisitor<M0, Ms...>::MessageTuple msgs;
+      for (;;) {
+        CRoutine::GetCurrentRoutine()->set_state(RoutineState::DATA_WAIT);
+        if (dv->TryFetch(&msgs)) {
+          f(msgs);
+          CRoutine::Yield(RoutineState::READY);
+        } else {
+          CRoutine::Yield();
+        }
+      }
+    };
+  };
+  return factory;
+}
+
 template <typename Function>
 RoutineFactory CreateRoutineFactory(Function&& f) {
   RoutineFactory factory;
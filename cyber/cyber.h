@@ -26,6 +26,7 @@
 #include "cyber/init.h"
 #include "cyber/node/node.h"
 #include "cyber/task/task.h"
+#include "cyber/time/rate.h"
 #include "cyber/time/time.h"
 #include "cyber/timer/timer.h"
 
@@ -17,15 +17,21 @@
 #ifndef CYBER_DATA_CACHE_BUFFER_H_
 #define CYBER_DATA_CACHE_BUFFER_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <vector>
 
 namespace apollo {
 namespace cyber {
 namespace data {
 
+// Ring buffer with one writer at a time and any number of lock-free
+// readers. Writers serialize on Mutex(); a reader never takes it, it copies
+// a slot under that slot's latch with Read() and learns from the return
+// value whether the writer lapped it meanwhile. The latch is only contended
+// when a reader falls a full buffer behind the writer or when two readers
+// copy the same slot, and it is held for a single copy of T.
 template <typename T>
 class CacheBuffer {
  public:
@@ -33,63 +39,90 @@ class CacheBuffer {
   using size_type = std::size_t;
   using FusionCallback = std::function<void(const T&)>;
 
-  explicit CacheBuffer(uint64_t size) {
-    capacity_ = size + 1;
-    buffer_.resize(capacity_);
-  }
+  explicit CacheBuffer(uint64_t size)
+      : capacity_(size + 1), slots_(new Slot[capacity_]) {}
 
-  CacheBuffer(const CacheBuffer& rhs) {
+  CacheBuffer(const CacheBuffer& rhs)
+      : capacity_(rhs.capacity_), slots_(new Slot[capacity_]) {
     std::lock_guard<std::mutex> lg(rhs.mutex_);
-    head_ = rhs.head_;
-    tail_ = rhs.tail_;
-    buffer_ = rhs.buffer_;
-    capacity_ = rhs.capacity_;
+    for (uint64_t i = 0; i < capacity_; ++i) {
+      slots_[i].value = rhs.slots_[i].value;
+    }
+    head_.store(rhs.head_.load());
+    tail_.store(rhs.tail_.load());
     fusion_callback_ = rhs.fusion_callback_;
   }
 
-  T& operator[](const uint64_t& pos) { return buffer_[GetIndex(pos)]; }
-  const T& at(const uint64_t& pos) const { return buffer_[GetIndex(pos)]; }
+  // Unsynchronized access, only for the writer or a quiescent buffer.
+  T& operator[](const uint64_t& pos) { return slots_[GetIndex(pos)].value; }
+  const T& at(const uint64_t& pos) const {
+    return slots_[GetIndex(pos)].value;
+  }
 
-  uint64_t Head() const { return head_ + 1; }
-  uint64_t Tail() const { return tail_; }
-  uint64_t Size() const { return tail_ - head_; }
+  uint64_t Head() const { return head_.load(std::memory_order_acquire) + 1; }
+  uint64_t Tail() const { return tail_.load(std::memory_order_acquire); }
+  uint64_t Size() const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    return Tail() - head;
+  }
 
-  const T& Front() const { return buffer_[GetIndex(head_ + 1)]; }
-  const T& Back() const { return buffer_[GetIndex(tail_)]; }
+  const T& Front() const { return at(Head()); }
+  const T& Back() const { return at(Tail()); }
 
-  bool Empty() const { return tail_ == 0; }
-  bool Full() const { return capacity_ - 1 == tail_ - head_; }
+  bool Empty() const { return Tail() == 0; }
+  bool Full() const { return capacity_ - 1 == Size(); }
   uint64_t Capacity() const { return capacity_; }
 
+  // Copies the element at pos into value without blocking the writer.
+  // Returns false when pos has already been overwritten.
+  bool Read(uint64_t pos, T* value) const {
+    const Slot& slot = slots_[GetIndex(pos)];
+    while (slot.latch.test_and_set(std::memory_order_acquire)) {
+    }
+    *value = slot.value;
+    slot.latch.clear(std::memory_order_release);
+    return pos >= Head();
+  }
+
   void SetFusionCallback(const FusionCallback& callback) {
     fusion_callback_ = callback;
   }
 
+  // Must be called with Mutex() held.
   void Fill(const T& value) {
     if (fusion_callback_) {
       fusion_callback_(value);
-    } else {
-      if (Full()) {
-        buffer_[GetIndex(head_)] = value;
-        ++head_;
-        ++tail_;
-      } else {
-        buffer_[GetIndex(tail_ + 1)] = value;
-        ++tail_;
-      }
+      return;
+    }
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (Full()) {
+      // retire the oldest element first, a reader still holding the index
+      // this slot had one lap ago must see its Read() fail.
+      head_.fetch_add(1, std::memory_order_acq_rel);
     }
+    Slot& slot = slots_[GetIndex(tail + 1)];
+    while (slot.latch.test_and_set(std::memory_order_acquire)) {
+    }
+    slot.value = value;
+    slot.latch.clear(std::memory_order_release);
+    tail_.store(tail + 1, std::memory_order_release);
   }
 
   std::mutex& Mutex() { return mutex_; }
 
  private:
+  struct alignas(64) Slot {
+    mutable std::atomic_flag latch = ATOMIC_FLAG_INIT;
+    T value;
+  };
+
   CacheBuffer& operator=(const CacheBuffer& other) = delete;
   uint64_t GetIndex(const uint64_t& pos) const { return pos % capacity_; }
 
-  uint64_t head_ = 0;
-  uint64_t tail_ = 0;
+  std::atomic<uint64_t> head_ = {0};
+  std::atomic<uint64_t> tail_ = {0};
   uint64_t capacity_ = 0;
-  std::vector<T> buffer_;
+  std::unique_ptr<Slot[]> slots_;
   mutable std::mutex mutex_;
   FusionCallback fusion_callback_;
 };
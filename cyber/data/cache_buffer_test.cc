@@ -16,9 +16,12 @@
 
 #include "cyber/data/cache_buffer.h"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -53,6 +56,44 @@ TEST(CacheBufferTest, cache_buffer_test) {
   EXPECT_TRUE(buffer1.Full());
 }
 
+TEST(CacheBufferTest, concurrent_read) {
+  CacheBuffer<std::shared_ptr<uint64_t>> buffer(8);
+  const uint64_t kFillNum = 100000;
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&buffer, &stop]() {
+      std::shared_ptr<uint64_t> value;
+      while (!stop.load()) {
+        auto tail = buffer.Tail();
+        if (tail == 0) {
+          continue;
+        }
+        for (auto pos = buffer.Head(); pos <= tail; ++pos) {
+          // a slot that was read successfully holds the value filled at pos
+          if (buffer.Read(pos, &value)) {
+            EXPECT_EQ(pos, *value);
+          }
+        }
+      }
+    });
+  }
+  for (uint64_t i = 1; i <= kFillNum; ++i) {
+    std::lock_guard<std::mutex> lg(buffer.Mutex());
+    buffer.Fill(std::make_shared<uint64_t>(i));
+  }
+  stop.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  std::shared_ptr<uint64_t> value;
+  EXPECT_TRUE(buffer.Read(kFillNum, &value));
+  EXPECT_EQ(kFillNum, *value);
+  EXPECT_FALSE(buffer.Read(kFillNum - 8, &value));
+  EXPECT_EQ(8, buffer.Size());
+}
+
 }  // namespace data
 }  // namespace cyber
 }  // namespace apollo
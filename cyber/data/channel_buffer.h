@@ -56,52 +56,69 @@ class ChannelBuffer {
 template <typename T>
 bool ChannelBuffer<T>::Fetch(uint64_t* index,
                              std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
+  while (true) {
+    auto tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+
+    if (*index == 0) {
+      *index = tail;
+    } else if (*index == tail + 1) {
+      return false;
+    } else if (*index < buffer_->Head()) {
+      auto interval = tail - *index;
+      AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
+            << "read buffer overflow, drop_message[" << interval
+            << "] pre_index[" << *index << "] current_index[" << tail << "] ";
+      *index = tail;
+    }
+    if (buffer_->Read(*index, &m)) {
+      return true;
+    }
+    // the writer lapped us while copying, start over from the new head.
   }
-
-  if (*index == 0) {
-    *index = buffer_->Tail();
-  } else if (*index == buffer_->Tail() + 1) {
-    return false;
-  } else if (*index < buffer_->Head()) {
-    auto interval = buffer_->Tail() - *index;
-    AWARN << "channel[" << GlobalData::GetChannelById(channel_id_) << "] "
-          << "read buffer overflow, drop_message[" << interval << "] pre_index["
-          << *index << "] current_index[" << buffer_->Tail() << "] ";
-    *index = buffer_->Tail();
-  }
-  m = buffer_->at(*index);
-  return true;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::Latest(std::shared_ptr<T>& m) {  // NOLINT
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
+  while (true) {
+    auto tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+    if (buffer_->Read(tail, &m)) {
+      return true;
+    }
   }
-
-  m = buffer_->Back();
-  return true;
 }
 
 template <typename T>
 bool ChannelBuffer<T>::FetchMulti(uint64_t fetch_size,
                                   std::vector<std::shared_ptr<T>>* vec) {
-  std::lock_guard<std::mutex> lock(buffer_->Mutex());
-  if (buffer_->Empty()) {
-    return false;
-  }
-
-  auto num = std::min(buffer_->Size(), fetch_size);
-  vec->reserve(num);
-  for (auto index = buffer_->Tail() - num + 1; index <= buffer_->Tail();
-       ++index) {
-    vec->emplace_back(buffer_->at(index));
+  while (true) {
+    auto head = buffer_->Head();
+    auto tail = buffer_->Tail();
+    if (tail == 0) {
+      return false;
+    }
+
+    auto num = std::min(tail - head + 1, fetch_size);
+    auto begin = vec->size();
+    vec->reserve(begin + num);
+    bool lapped = false;
+    for (auto index = tail - num + 1; index <= tail; ++index) {
+      vec->emplace_back();
+      if (!buffer_->Read(index, &vec->back())) {
+        lapped = true;
+        break;
+      }
+    }
+    if (!lapped) {
+      return true;
+    }
+    vec->resize(begin);
   }
-  return true;
 }
 
 }  // namespace data
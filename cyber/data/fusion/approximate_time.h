@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_FUSION_APPROXIMATE_TIME_H_
+#define CYBER_DATA_FUSION_APPROXIMATE_TIME_H_
+
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
+#include "cyber/data/channel_buffer.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+// Timestamp in nanoseconds used to pair messages from different channels.
+// Covers every message carrying an apollo common Header, specialize it for
+// other types.
+template <typename M>
+struct MessageTime {
+  static uint64_t Get(const M& m) {
+    return static_cast<uint64_t>(m.header().timestamp_sec() * 1e9);
+  }
+};
+
+// Fuses any number of channels. Every message of the first channel is
+// paired with the message of each other channel closest to it in time, and
+// the set is published only if all of them lie within window_ns of it.
+// The other channels' buffers serve as the per input history and are read
+// without locking, so the first channel should be the one arriving last in
+// a synchronized set (e.g. the slowest sensor).
+template <typename M0, typename... Ms>
+class ApproximateTime {
+ public:
+  using FusionDataType =
+      std::tuple<std::shared_ptr<M0>, std::shared_ptr<Ms>...>;
+
+  ApproximateTime(uint64_t window_ns, const ChannelBuffer<M0>& buffer_0,
+                  const ChannelBuffer<Ms>&... buffers)
+      : window_ns_(window_ns),
+        buffer_m0_(buffer_0),
+        buffers_(buffers...),
+        buffer_fusion_(buffer_m0_.channel_id(),
+                       new CacheBuffer<std::shared_ptr<FusionDataType>>(
+                           buffer_0.Buffer()->Capacity() - uint64_t(1))) {
+    buffer_m0_.Buffer()->SetFusionCallback(
+        [this](const std::shared_ptr<M0>& m0) {
+          auto data = std::make_shared<FusionDataType>();
+          std::get<0>(*data) = m0;
+          if (!Match(MessageTime<M0>::Get(*m0), data.get(),
+                     std::index_sequence_for<Ms...>())) {
+            return;
+          }
+          std::lock_guard<std::mutex> lg(buffer_fusion_.Buffer()->Mutex());
+          buffer_fusion_.Buffer()->Fill(data);
+        });
+  }
+
+  bool Fusion(uint64_t* index, FusionDataType* data) {
+    std::shared_ptr<FusionDataType> fusion_data;
+    if (!buffer_fusion_.Fetch(index, fusion_data)) {
+      return false;
+    }
+    *data = *fusion_data;
+    return true;
+  }
+
+  uint64_t window_ns() const { return window_ns_; }
+
+ private:
+  template <std::size_t... I>
+  bool Match(uint64_t time, FusionDataType* data, std::index_sequence<I...>) {
+    bool matched[] = {
+        true, Closest(std::get<I>(buffers_), time, &std::get<I + 1>(*data))...};
+    for (auto m : matched) {
+      if (!m) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool Closest(const ChannelBuffer<T>& buffer, uint64_t time,
+               std::shared_ptr<T>* msg) const {
+    auto cache = buffer.Buffer();
+    uint64_t best = 0;
+    std::shared_ptr<T> candidate;
+    for (auto pos = cache->Tail(); pos > 0 && pos >= cache->Head(); --pos) {
+      if (!cache->Read(pos, &candidate)) {
+        // overwritten, so is everything older
+        break;
+      }
+      auto stamp = MessageTime<T>::Get(*candidate);
+      auto diff = stamp > time ? stamp - time : time - stamp;
+      if (diff <= window_ns_ && (*msg == nullptr || diff < best)) {
+        best = diff;
+        *msg = candidate;
+      } else if (stamp < time && diff > window_ns_) {
+        break;
+      }
+    }
+    return *msg != nullptr;
+  }
+
+  uint64_t window_ns_;
+  ChannelBuffer<M0> buffer_m0_;
+  std::tuple<ChannelBuffer<Ms>...> buffers_;
+  ChannelBuffer<FusionDataType> buffer_fusion_;
+};
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_FUSION_APPROXIMATE_TIME_H_
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/data/fusion/approximate_time.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+namespace fusion {
+
+struct Stamped {
+  Stamped(uint64_t t, const std::string& n) : stamp(t), name(n) {}
+  uint64_t stamp;
+  std::string name;
+};
+
+template <>
+struct MessageTime<Stamped> {
+  static uint64_t Get(const Stamped& m) { return m.stamp; }
+};
+
+TEST(ApproximateTimeTest, five_channels) {
+  CacheBuffer<std::shared_ptr<Stamped>>* caches[5];
+  for (auto& cache : caches) {
+    cache = new CacheBuffer<std::shared_ptr<Stamped>>(10);
+  }
+  ChannelBuffer<Stamped> buffer0(0, caches[0]);
+  ChannelBuffer<Stamped> buffer1(1, caches[1]);
+  ChannelBuffer<Stamped> buffer2(2, caches[2]);
+  ChannelBuffer<Stamped> buffer3(3, caches[3]);
+  ChannelBuffer<Stamped> buffer4(4, caches[4]);
+  ApproximateTime<Stamped, Stamped, Stamped, Stamped, Stamped> fusion(
+      10, buffer0, buffer1, buffer2, buffer3, buffer4);
+  ApproximateTime<Stamped, Stamped, Stamped, Stamped, Stamped>::FusionDataType
+      data;
+  uint64_t index = 0;
+
+  EXPECT_FALSE(fusion.Fusion(&index, &data));
+  for (int i = 1; i < 5; ++i) {
+    caches[i]->Fill(std::make_shared<Stamped>(95, "old"));
+    caches[i]->Fill(std::make_shared<Stamped>(100 + i, "match"));
+    caches[i]->Fill(std::make_shared<Stamped>(120, "new"));
+  }
+  caches[0]->Fill(std::make_shared<Stamped>(103, "pivot"));
+  EXPECT_TRUE(fusion.Fusion(&index, &data));
+  index++;
+  EXPECT_EQ("pivot", std::get<0>(data)->name);
+  EXPECT_EQ(101, std::get<1>(data)->stamp);
+  EXPECT_EQ(102, std::get<2>(data)->stamp);
+  EXPECT_EQ(103, std::get<3>(data)->stamp);
+  EXPECT_EQ(104, std::get<4>(data)->stamp);
+  EXPECT_FALSE(fusion.Fusion(&index, &data));
+
+  // channel 4 has nothing within the window
+  caches[0]->Fill(std::make_shared<Stamped>(200, "pivot"));
+  EXPECT_FALSE(fusion.Fusion(&index, &data));
+  for (int i = 1; i < 4; ++i) {
+    caches[i]->Fill(std::make_shared<Stamped>(205, "match"));
+  }
+  caches[4]->Fill(std::make_shared<Stamped>(195, "match"));
+  caches[0]->Fill(std::make_shared<Stamped>(200, "pivot"));
+  EXPECT_TRUE(fusion.Fusion(&index, &data));
+  EXPECT_EQ(195, std::get<4>(data)->stamp);
+}
+
+TEST(ApproximateTimeTest, overflow) {
+  auto cache0 = new CacheBuffer<std::shared_ptr<Stamped>>(2);
+  auto cache1 = new CacheBuffer<std::shared_ptr<Stamped>>(2);
+  ChannelBuffer<Stamped> buffer0(0, cache0);
+  ChannelBuffer<Stamped> buffer1(1, cache1);
+  ApproximateTime<Stamped, Stamped> fusion(5, buffer0, buffer1);
+  ApproximateTime<Stamped, Stamped>::FusionDataType data;
+
+  for (uint64_t t = 0; t < 100; t += 10) {
+    cache1->Fill(std::make_shared<Stamped>(t + 1, "sub"));
+  }
+  // the history only keeps the two most recent messages
+  cache0->Fill(std::make_shared<Stamped>(50, "pivot"));
+  uint64_t index = 0;
+  EXPECT_FALSE(fusion.Fusion(&index, &data));
+  cache0->Fill(std::make_shared<Stamped>(80, "pivot"));
+  EXPECT_TRUE(fusion.Fusion(&index, &data));
+  EXPECT_EQ(81, std::get<1>(data)->stamp);
+}
+
+}  // namespace fusion
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
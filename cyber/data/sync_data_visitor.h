@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_DATA_SYNC_DATA_VISITOR_H_
+#define CYBER_DATA_SYNC_DATA_VISITOR_H_
+
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cyber/data/channel_buffer.h"
+#include "cyber/data/data_dispatcher.h"
+#include "cyber/data/data_visitor.h"
+#include "cyber/data/data_visitor_base.h"
+#include "cyber/data/fusion/approximate_time.h"
+
+namespace apollo {
+namespace cyber {
+namespace data {
+
+// DataVisitor for any number of channels, notified once per set of
+// messages that fusion::ApproximateTime found within window_ns of each
+// other. configs[0] is the channel triggering the fusion.
+template <typename M0, typename... Ms>
+class SyncDataVisitor : public DataVisitorBase {
+ public:
+  using MessageTuple = std::tuple<std::shared_ptr<M0>, std::shared_ptr<Ms>...>;
+
+  SyncDataVisitor(const std::vector<VisitorConfig>& configs,
+                  uint64_t window_ns)
+      : SyncDataVisitor(configs, window_ns,
+                        std::index_sequence_for<Ms...>()) {}
+
+  bool TryFetch(MessageTuple* msgs) {
+    if (data_fusion_.Fusion(&next_msg_index_, msgs)) {
+      next_msg_index_++;
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  template <std::size_t... I>
+  SyncDataVisitor(const std::vector<VisitorConfig>& configs,
+                  uint64_t window_ns, std::index_sequence<I...>)
+      : buffer_m0_(configs[0].channel_id,
+                   new BufferType<M0>(configs[0].queue_size)),
+        buffers_(ChannelBuffer<Ms>(
+            configs[I + 1].channel_id,
+            new BufferType<Ms>(configs[I + 1].queue_size))...),
+        data_fusion_(window_ns, buffer_m0_, std::get<I>(buffers_)...) {
+    DataDispatcher<M0>::Instance()->AddBuffer(buffer_m0_);
+    int dummy[] = {
+        0, (DataDispatcher<Ms>::Instance()->AddBuffer(std::get<I>(buffers_)),
+            0)...};
+    (void)dummy;
+    data_notifier_->AddNotifier(buffer_m0_.channel_id(), notifier_);
+  }
+
+  ChannelBuffer<M0> buffer_m0_;
+  std::tuple<ChannelBuffer<Ms>...> buffers_;
+  fusion::ApproximateTime<M0, Ms...> data_fusion_;
+};
+
+}  // namespace data
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_DATA_SYNC_DATA_VISITOR_H_
@@ -31,6 +31,7 @@
 #include "cyber/binary.h"
 #include "cyber/common/file.h"
 #include "cyber/common/global_data.h"
+#include "cyber/croutine/croutine.h"
 #include "cyber/data/data_dispatcher.h"
 #include "cyber/logger/async_logger.h"
 #include "cyber/node/node.h"
@@ -102,6 +103,7 @@ bool Init(const char* binary_name) {
   InitLogger(binary_name);
   auto thread = const_cast<std::thread*>(async_logger->LogThread());
   scheduler::Instance()->SetInnerThreadAttr("async_log", thread);
+  croutine::CRoutine::InitContextPool();
   SysMo::Instance();
   std::signal(SIGINT, OnShutdown);
   // Register exit handlers
@@ -39,12 +39,6 @@ struct PollRequest {
   std::function<void(const PollResponse&)> callback = nullptr;
 };
 
-struct PollCtrlParam {
-  int operation;
-  int fd;
-  epoll_event event;
-};
-
 }  // namespace io
 }  // namespace cyber
 }  // namespace apollo
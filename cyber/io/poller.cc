@@ -18,6 +18,7 @@
 
 #include <fcntl.h>
 #include <sys/epoll.h>
+#include <sys/timerfd.h>
 #include <unistd.h>
 
 #include <csignal>
@@ -61,24 +62,29 @@ bool Poller::Register(const PollRequest& req) {
     return false;
   }
 
-  PollCtrlParam ctrl_param{};
-  ctrl_param.fd = req.fd;
-  ctrl_param.event.data.fd = req.fd;
-  ctrl_param.event.events = req.events;
-
   {
     WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    if (requests_.count(req.fd) == 0) {
-      ctrl_param.operation = EPOLL_CTL_ADD;
-      requests_[req.fd] = std::make_shared<PollRequest>();
-    } else {
-      ctrl_param.operation = EPOLL_CTL_MOD;
+    auto search = requests_.find(req.fd);
+    if (search == requests_.end()) {
+      if (!Control(EPOLL_CTL_ADD, req)) {
+        return false;
+      }
+      search = requests_.emplace(req.fd, std::make_shared<PollEntry>()).first;
+    } else if (!Control(EPOLL_CTL_MOD, req)) {
+      return false;
     }
-    *requests_[req.fd] = req;
-    ctrl_params_[ctrl_param.fd] = ctrl_param;
+    search->second->request = req;
+    search->second->deadline_ns =
+        req.timeout_ms < 0 ? 0
+                           : Time::MonoTime().ToNanosecond() +
+                                 static_cast<uint64_t>(req.timeout_ms) *
+                                     1000000;
   }
 
-  Notify();
+  // the poll thread has to recompute its timeout
+  if (req.timeout_ms >= 0) {
+    Notify();
+  }
   return true;
 }
 
@@ -92,21 +98,70 @@ bool Poller::Unregister(const PollRequest& req) {
     return false;
   }
 
-  {
-    WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    auto size = requests_.erase(req.fd);
-    if (size == 0) {
-      AERROR << "unregister failed, can't find fd: " << req.fd;
-      return false;
-    }
+  WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
+  auto size = requests_.erase(req.fd);
+  if (size == 0) {
+    AERROR << "unregister failed, can't find fd: " << req.fd;
+    return false;
+  }
+  Control(EPOLL_CTL_DEL, req);
+  return true;
+}
 
-    PollCtrlParam ctrl_param;
-    ctrl_param.operation = EPOLL_CTL_DEL;
-    ctrl_param.fd = req.fd;
-    ctrl_params_[ctrl_param.fd] = ctrl_param;
+int Poller::AddTimer(uint64_t interval_us, const TimerCallback& callback,
+                     bool oneshot) {
+  if (interval_us == 0 || callback == nullptr) {
+    AERROR << "input is invalid";
+    return -1;
+  }
+
+  int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (timer_fd < 0) {
+    AERROR << "timerfd create failed, " << strerror(errno);
+    return -1;
   }
 
-  Notify();
+  struct itimerspec spec = {};
+  spec.it_value.tv_sec = static_cast<time_t>(interval_us / 1000000);
+  spec.it_value.tv_nsec = static_cast<long>(  // NOLINT
+      (interval_us % 1000000) * 1000);
+  if (!oneshot) {
+    spec.it_interval = spec.it_value;
+  }
+  if (timerfd_settime(timer_fd, 0, &spec, nullptr) != 0) {
+    AERROR << "timerfd settime failed, " << strerror(errno);
+    close(timer_fd);
+    return -1;
+  }
+
+  PollRequest request;
+  request.fd = timer_fd;
+  request.events = EPOLLIN | EPOLLET;
+  request.timeout_ms = -1;
+  request.callback = [timer_fd, callback](const PollResponse& rsp) {
+    if (!(rsp.events & EPOLLIN)) {
+      return;
+    }
+    uint64_t expirations = 0;
+    if (read(timer_fd, &expirations, sizeof(expirations)) > 0) {
+      callback();
+    }
+  };
+  if (!Register(request)) {
+    close(timer_fd);
+    return -1;
+  }
+  return timer_fd;
+}
+
+bool Poller::RemoveTimer(int timer_id) {
+  PollRequest request;
+  request.fd = timer_id;
+  request.callback = [](const PollResponse&) {};
+  if (!Unregister(request)) {
+    return false;
+  }
+  close(timer_id);
   return true;
 }
 
@@ -132,23 +187,20 @@ bool Poller::Init() {
   }
 
   // add pipe[0] to epoll
-  auto request = std::make_shared<PollRequest>();
-  request->fd = pipe_fd_[0];
-  request->events = EPOLLIN;
-  request->timeout_ms = -1;
-  request->callback = [this](const PollResponse&) {
+  auto entry = std::make_shared<PollEntry>();
+  auto& request = entry->request;
+  request.fd = pipe_fd_[0];
+  request.events = EPOLLIN;
+  request.timeout_ms = -1;
+  request.callback = [this](const PollResponse&) {
     char c = 0;
     while (read(pipe_fd_[0], &c, 1) > 0) {
     }
   };
-  requests_[request->fd] = request;
-
-  PollCtrlParam ctrl_param{};
-  ctrl_param.operation = EPOLL_CTL_ADD;
-  ctrl_param.fd = pipe_fd_[0];
-  ctrl_param.event.data.fd = pipe_fd_[0];
-  ctrl_param.event.events = EPOLLIN;
-  ctrl_params_[ctrl_param.fd] = ctrl_param;
+  if (!Control(EPOLL_CTL_ADD, request)) {
+    return false;
+  }
+  requests_[request.fd] = entry;
 
   is_shutdown_.store(false);
   thread_ = std::thread(&Poller::ThreadFunc, this);
@@ -179,67 +231,47 @@ void Poller::Clear() {
   {
     WriteLockGuard<AtomicRWLock> lck(poll_data_lock_);
     requests_.clear();
-    ctrl_params_.clear();
   }
 }
 
+bool Poller::Control(int operation, const PollRequest& req) {
+  epoll_event event{};
+  event.data.fd = req.fd;
+  event.events = req.events;
+  ADEBUG << "epoll ctl, op[" << operation << "] fd[" << req.fd << "] events["
+         << req.events << "]";
+  if (epoll_ctl(epoll_fd_, operation, req.fd, &event) != 0 &&
+      errno != EBADF) {
+    AERROR << "epoll ctl failed, " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
 void Poller::Poll(int timeout_ms) {
   epoll_event evt[kPollSize];
-  auto before_time_ns = Time::Now().ToNanosecond();
   int ready_num = epoll_wait(epoll_fd_, evt, kPollSize, timeout_ms);
-  auto after_time_ns = Time::Now().ToNanosecond();
-  int interval_ms =
-      static_cast<int>((after_time_ns - before_time_ns) / 1000000);
-  if (interval_ms == 0) {
-    interval_ms = 1;
-  }
-
-  std::unordered_map<int, PollResponse> responses;
-  {
-    ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    for (auto& item : requests_) {
-      auto& request = item.second;
-      if (ctrl_params_.count(request->fd) != 0) {
-        continue;
-      }
-
-      if (request->timeout_ms > 0) {
-        request->timeout_ms -= interval_ms;
-        if (request->timeout_ms < 0) {
-          request->timeout_ms = 0;
-        }
-      }
-
-      if (request->timeout_ms == 0) {
-        responses[item.first] = PollResponse();
-        request->timeout_ms = -1;
-      }
-    }
-  }
-
-  if (ready_num > 0) {
-    for (int i = 0; i < ready_num; ++i) {
-      int fd = evt[i].data.fd;
-      uint32_t events = evt[i].events;
-      responses[fd] = PollResponse(events);
-    }
+  if (ready_num < 0 && errno != EINTR) {
+    AERROR << "epoll wait failed, " << strerror(errno);
   }
 
-  for (auto& item : responses) {
-    int fd = item.first;
-    auto& response = item.second;
-
-    ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    auto search = requests_.find(fd);
+  // all ready fds are handled under one lock, a fd that is ready does not
+  // time out in the same round
+  ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
+  for (int i = 0; i < ready_num; ++i) {
+    auto search = requests_.find(evt[i].data.fd);
     if (search != requests_.end()) {
-      search->second->timeout_ms = -1;
-      search->second->callback(response);
+      search->second->deadline_ns = 0;
+      search->second->request.callback(PollResponse(evt[i].events));
     }
   }
 
-  if (ready_num < 0) {
-    if (errno != EINTR) {
-      AERROR << "epoll wait failed, " << strerror(errno);
+  uint64_t now_ns = Time::MonoTime().ToNanosecond();
+  for (auto& item : requests_) {
+    auto& entry = item.second;
+    if (entry->deadline_ns != 0 && entry->deadline_ns <= now_ns) {
+      entry->deadline_ns = 0;
+      entry->request.callback(PollResponse());
     }
   }
 }
@@ -251,42 +283,29 @@ void Poller::ThreadFunc() {
   pthread_sigmask(SIG_BLOCK, &signal_set, nullptr);
 
   while (!is_shutdown_.load()) {
-    HandleChanges();
     int timeout_ms = GetTimeoutMs();
     ADEBUG << "this poll timeout ms: " << timeout_ms;
     Poll(timeout_ms);
   }
 }
 
-void Poller::HandleChanges() {
-  CtrlParamMap local_params;
-  {
-    ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
-    if (ctrl_params_.empty()) {
-      return;
-    }
-    local_params.swap(ctrl_params_);
-  }
-
-  for (auto& pair : local_params) {
-    auto& item = pair.second;
-    ADEBUG << "epoll ctl, op[" << item.operation << "] fd[" << item.fd
-           << "] events[" << item.event.events << "]";
-    if (epoll_ctl(epoll_fd_, item.operation, item.fd, &item.event) != 0 &&
-        errno != EBADF) {
-      AERROR << "epoll ctl failed, " << strerror(errno);
-    }
-  }
-}
-
 // min heap can be used to optimize
 int Poller::GetTimeoutMs() {
   int timeout_ms = kPollTimeoutMs;
+  uint64_t now_ns = Time::MonoTime().ToNanosecond();
   ReadLockGuard<AtomicRWLock> lck(poll_data_lock_);
   for (auto& item : requests_) {
-    auto& req = item.second;
-    if (req->timeout_ms >= 0 && req->timeout_ms < timeout_ms) {
-      timeout_ms = req->timeout_ms;
+    uint64_t deadline_ns = item.second->deadline_ns;
+    if (deadline_ns == 0) {
+      continue;
+    }
+    if (deadline_ns <= now_ns) {
+      return 0;
+    }
+    // round up so that the request is due when epoll_wait returns
+    int left_ms = static_cast<int>((deadline_ns - now_ns + 999999) / 1000000);
+    if (left_ms < timeout_ms) {
+      timeout_ms = left_ms;
     }
   }
   return timeout_ms;
@@ -18,6 +18,8 @@
 #define CYBER_IO_POLLER_H_
 
 #include <atomic>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -35,23 +37,38 @@ namespace io {
 
 class Poller {
  public:
-  using RequestPtr = std::shared_ptr<PollRequest>;
-  using RequestMap = std::unordered_map<int, RequestPtr>;
-  using CtrlParamMap = std::unordered_map<int, PollCtrlParam>;
+  // deadline_ns is the MonoTime at which the request times out, 0 if it
+  // has nothing to wait for
+  struct PollEntry {
+    PollRequest request;
+    uint64_t deadline_ns = 0;
+  };
+  using EntryPtr = std::shared_ptr<PollEntry>;
+  using RequestMap = std::unordered_map<int, EntryPtr>;
+  using TimerCallback = std::function<void()>;
 
   virtual ~Poller();
 
   void Shutdown();
 
+  // The fd is added to or modified in the epoll set right away, the poll
+  // thread is only woken up when the request has a timeout to watch.
   bool Register(const PollRequest& req);
   bool Unregister(const PollRequest& req);
 
+  // Runs callback on the io thread every interval_us, or once if oneshot,
+  // until the timer is removed. Like all poll callbacks it must be short and
+  // must not call back into the Poller. Returns the timer id, -1 on failure.
+  int AddTimer(uint64_t interval_us, const TimerCallback& callback,
+               bool oneshot = false);
+  bool RemoveTimer(int timer_id);
+
  private:
   bool Init();
   void Clear();
+  bool Control(int operation, const PollRequest& req);
   void Poll(int timeout_ms);
   void ThreadFunc();
-  void HandleChanges();
   int GetTimeoutMs();
   void Notify();
 
@@ -63,10 +80,9 @@ class Poller {
   std::mutex pipe_mutex_;
 
   RequestMap requests_;
-  CtrlParamMap ctrl_params_;
   base::AtomicRWLock poll_data_lock_;
 
-  const int kPollSize = 32;
+  static const int kPollSize = 128;
   const int kPollTimeoutMs = 100;
 
   DECLARE_SINGLETON(Poller)
@@ -19,6 +19,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <atomic>
 #include <thread>
 
 #include "gtest/gtest.h"
@@ -29,6 +30,33 @@ namespace apollo {
 namespace cyber {
 namespace io {
 
+TEST(PollerTest, timer) {
+  auto poller = Poller::Instance();
+  ASSERT_NE(poller, nullptr);
+
+  // invalid input
+  EXPECT_EQ(poller->AddTimer(0, []() {}), -1);
+  EXPECT_EQ(poller->AddTimer(1000, nullptr), -1);
+
+  std::atomic<int> count(0);
+  int timer_id = poller->AddTimer(10000, [&count]() { ++count; });
+  ASSERT_GE(timer_id, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(55));
+  EXPECT_GE(count.load(), 3);
+  EXPECT_TRUE(poller->RemoveTimer(timer_id));
+  EXPECT_FALSE(poller->RemoveTimer(timer_id));
+  int last = count.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(count.load(), last);
+
+  std::atomic<int> fired(0);
+  timer_id = poller->AddTimer(5000, [&fired]() { ++fired; }, true);
+  ASSERT_GE(timer_id, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  EXPECT_EQ(fired.load(), 1);
+  EXPECT_TRUE(poller->RemoveTimer(timer_id));
+}
+
 TEST(PollerTest, operation) {
   auto poller = Poller::Instance();
   ASSERT_NE(poller, nullptr);
@@ -180,6 +180,48 @@ ssize_t Session::SendTo(const void *buf, size_t len, int flags,
   return nbytes;
 }
 
+int Session::RecvMmsg(struct mmsghdr *msgvec, unsigned int vlen, int flags,
+                      int timeout_ms) {
+  ACHECK(msgvec != nullptr);
+  ACHECK(fd_ != -1);
+
+  int nmsgs = recvmmsg(fd_, msgvec, vlen, flags, nullptr);
+  if (timeout_ms == 0) {
+    return nmsgs;
+  }
+
+  while (nmsgs == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    if (poll_handler_->Block(timeout_ms, true)) {
+      nmsgs = recvmmsg(fd_, msgvec, vlen, flags, nullptr);
+    }
+    if (timeout_ms > 0) {
+      break;
+    }
+  }
+  return nmsgs;
+}
+
+int Session::SendMmsg(struct mmsghdr *msgvec, unsigned int vlen, int flags,
+                      int timeout_ms) {
+  ACHECK(msgvec != nullptr);
+  ACHECK(fd_ != -1);
+
+  int nmsgs = sendmmsg(fd_, msgvec, vlen, flags);
+  if (timeout_ms == 0) {
+    return nmsgs;
+  }
+
+  while ((nmsgs == -1) && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+    if (poll_handler_->Block(timeout_ms, false)) {
+      nmsgs = sendmmsg(fd_, msgvec, vlen, flags);
+    }
+    if (timeout_ms > 0) {
+      break;
+    }
+  }
+  return nmsgs;
+}
+
 ssize_t Session::Read(void *buf, size_t count, int timeout_ms) {
   ACHECK(buf != nullptr);
   ACHECK(fd_ != -1);
@@ -58,6 +58,13 @@ class Session {
                  const struct sockaddr *dest_addr, socklen_t addrlen,
                  int timeout_ms = -1);
 
+  // batched datagram io, the number of messages handled is returned and the
+  // length of each one is stored in msg_len of its entry.
+  int RecvMmsg(struct mmsghdr *msgvec, unsigned int vlen, int flags,
+               int timeout_ms = -1);
+  int SendMmsg(struct mmsghdr *msgvec, unsigned int vlen, int flags,
+               int timeout_ms = -1);
+
   ssize_t Read(void *buf, size_t count, int timeout_ms = -1);
   ssize_t Write(const void *buf, size_t count, int timeout_ms = -1);
 
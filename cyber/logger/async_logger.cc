@@ -16,12 +16,15 @@
 
 #include "cyber/logger/async_logger.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <string>
 #include <thread>
 #include <unordered_map>
 
 #include "cyber/base/macros.h"
+#include "cyber/common/environment.h"
 #include "cyber/logger/logger_util.h"
 
 namespace apollo {
@@ -31,11 +34,71 @@ namespace logger {
 static const std::unordered_map<char, int> log_level_map = {
     {'F', 3}, {'E', 2}, {'W', 1}, {'I', 0}};
 
-AsyncLogger::AsyncLogger(google::base::Logger* wrapped) : wrapped_(wrapped) {
-  active_buf_.reset(new std::deque<Msg>());
-  flushing_buf_.reset(new std::deque<Msg>());
+namespace {
+
+std::atomic<uint64_t> next_logger_id = {1};
+
+uint32_t EnvToUint(const char* name, uint32_t default_value) {
+  auto value = common::GetEnv(name);
+  if (value.empty()) {
+    return default_value;
+  }
+  return static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
 }
 
+// the ring the current thread writes to
+struct RingHandle {
+  uint64_t logger_id = 0;
+  std::shared_ptr<LogRing> ring;
+
+  ~RingHandle() {
+    if (ring != nullptr) {
+      ring->Close();
+    }
+  }
+};
+
+thread_local RingHandle ring_handle;
+
+}  // namespace
+
+LogRing::LogRing(uint32_t capacity, uint32_t rate_limit)
+    : capacity_(std::max(capacity, 1u)),
+      slots_(new Msg[capacity_]),
+      rate_limit_(rate_limit) {}
+
+bool LogRing::Push(time_t ts, int32_t level, const char* message,
+                   int message_len) {
+  if (rate_limit_ > 0 && level == google::INFO) {
+    if (ts != rate_ts_) {
+      rate_ts_ = ts;
+      rate_count_ = 0;
+    }
+    if (++rate_count_ > rate_limit_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+
+  uint64_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - head_.load(std::memory_order_acquire) >= capacity_) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  auto& slot = slots_[tail % capacity_];
+  slot.ts = ts;
+  slot.level = level;
+  slot.message.assign(message, message_len);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+AsyncLogger::AsyncLogger(google::base::Logger* wrapped)
+    : wrapped_(wrapped),
+      id_(next_logger_id.fetch_add(1)),
+      ring_size_(EnvToUint("CYBER_LOG_RING_SIZE", 4096)),
+      rate_limit_(EnvToUint("CYBER_LOG_RATE_LIMIT", 0)) {}
+
 AsyncLogger::~AsyncLogger() { Stop(); }
 
 void AsyncLogger::Start() {
@@ -51,12 +114,29 @@ void AsyncLogger::Stop() {
     log_thread_.join();
   }
 
-  FlushBuffer(active_buf_);
-  ACHECK(active_buf_->empty());
-  ACHECK(flushing_buf_->empty());
+  FlushRings();
+  ReportDrops();
+  Flush();
   // std::cout << "Async Logger Stop!" << std::endl;
 }
 
+LogRing* AsyncLogger::GetRing() {
+  if (cyber_likely(ring_handle.logger_id == id_)) {
+    return ring_handle.ring.get();
+  }
+  if (ring_handle.ring != nullptr) {
+    ring_handle.ring->Close();
+  }
+  auto ring = std::make_shared<LogRing>(ring_size_, rate_limit_);
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.emplace_back(ring);
+  }
+  ring_handle.logger_id = id_;
+  ring_handle.ring = ring;
+  return ring.get();
+}
+
 void AsyncLogger::Write(bool force_flush, time_t timestamp, const char* message,
                         int message_len) {
   if (cyber_unlikely(state_.load(std::memory_order_acquire) != RUNNING)) {
@@ -64,13 +144,10 @@ void AsyncLogger::Write(bool force_flush, time_t timestamp, const char* message,
     return;
   }
   if (message_len > 0) {
-    auto msg_str = std::string(message, message_len);
-    while (flag_.test_and_set(std::memory_order_acquire)) {
-      cpu_relax();
-    }
-    active_buf_->emplace_back(timestamp, std::move(msg_str),
-                              log_level_map.at(message[0]));
-    flag_.clear(std::memory_order_release);
+    auto level = log_level_map.find(message[0]);
+    GetRing()->Push(timestamp,
+                    level == log_level_map.end() ? google::INFO : level->second,
+                    message, message_len);
   }
 
   if (force_flush && timestamp == 0 && message && message_len == 0) {
@@ -86,42 +163,101 @@ void AsyncLogger::Flush() {
 
 uint32_t AsyncLogger::LogSize() { return wrapped_->LogSize(); }
 
+uint64_t AsyncLogger::DropCount() {
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  uint64_t count = removed_drop_count_;
+  for (auto& ring : rings_) {
+    count += ring->dropped();
+  }
+  return count;
+}
+
 void AsyncLogger::RunThread() {
   while (state_ == RUNNING) {
-    while (flag_.test_and_set(std::memory_order_acquire)) {
-      cpu_relax();
+    auto count = FlushRings();
+    ReportDrops();
+    if (count > 0) {
+      Flush();
+      flush_count_.fetch_add(1, std::memory_order_relaxed);
     }
-    active_buf_.swap(flushing_buf_);
-    flag_.clear(std::memory_order_release);
-    FlushBuffer(flushing_buf_);
-    if (active_buf_->size() < 800) {
+    if (count < 800) {
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
   }
 }
 
-void AsyncLogger::FlushBuffer(const std::unique_ptr<std::deque<Msg>>& buffer) {
-  std::string module_name = "";
-  while (!buffer->empty()) {
-    auto& msg = buffer->front();
-    FindModuleName(&(msg.message), &module_name);
-
-    if (module_logger_map_.find(module_name) == module_logger_map_.end()) {
-      std::string file_name = module_name + ".log.INFO.";
-      if (!FLAGS_log_dir.empty()) {
-        file_name = FLAGS_log_dir + "/" + file_name;
+uint32_t AsyncLogger::FlushRings() {
+  std::vector<std::shared_ptr<LogRing>> rings;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    // rings of threads that have exited go once they are drained
+    for (auto it = rings_.begin(); it != rings_.end();) {
+      if ((*it)->closed() && (*it)->empty()) {
+        removed_drop_count_ += (*it)->dropped();
+        it = rings_.erase(it);
+      } else {
+        ++it;
       }
-      module_logger_map_[module_name].reset(
-          new LogFileObject(google::INFO, file_name.c_str()));
-      module_logger_map_[module_name]->SetSymlinkBasename(module_name.c_str());
     }
-    const bool force_flush = msg.level > 0;
-    module_logger_map_.find(module_name)
-        ->second->Write(force_flush, msg.ts, msg.message.data(),
-                        static_cast<int>(msg.message.size()));
-    buffer->pop_front();
+    rings = rings_;
   }
-  Flush();
+
+  uint32_t count = 0;
+  for (auto& ring : rings) {
+    count += ring->Drain([this](LogRing::Msg* msg) { WriteMessage(msg); });
+  }
+  return count;
+}
+
+void AsyncLogger::WriteMessage(LogRing::Msg* msg) {
+  std::string module_name = "";
+  FindModuleName(&(msg->message), &module_name);
+
+  auto it = module_logger_map_.find(module_name);
+  if (it == module_logger_map_.end()) {
+    std::string file_name = module_name + ".log.INFO.";
+    if (!FLAGS_log_dir.empty()) {
+      file_name = FLAGS_log_dir + "/" + file_name;
+    }
+    it = module_logger_map_
+             .emplace(module_name, std::unique_ptr<LogFileObject>(
+                                       new LogFileObject(google::INFO,
+                                                         file_name.c_str())))
+             .first;
+    it->second->SetSymlinkBasename(module_name.c_str());
+  }
+  const bool force_flush = msg->level > 0;
+  it->second->Write(force_flush, msg->ts, msg->message.data(),
+                    static_cast<int>(msg->message.size()));
+}
+
+void AsyncLogger::ReportDrops() {
+  uint64_t drop_count = DropCount();
+  if (drop_count == reported_drop_count_) {
+    return;
+  }
+
+  time_t now = time(nullptr);
+  struct tm tm_time;
+  localtime_r(&now, &tm_time);
+  char buf[128];
+  int len = snprintf(buf, sizeof(buf),
+                     "W%02d%02d %02d:%02d:%02d.000000 %5d async_logger.cc:0] "
+                     "dropped %lu log messages\n",
+                     1 + tm_time.tm_mon, tm_time.tm_mday, tm_time.tm_hour,
+                     tm_time.tm_min, tm_time.tm_sec, GetMainThreadPid(),
+                     static_cast<unsigned long>(  // NOLINT
+                         drop_count - reported_drop_count_));
+  reported_drop_count_ = drop_count;
+  if (len <= 0) {
+    return;
+  }
+
+  LogRing::Msg msg;
+  msg.ts = now;
+  msg.level = google::WARNING;
+  msg.message.assign(buf, std::min<size_t>(len, sizeof(buf) - 1));
+  WriteMessage(&msg);
 }
 
 }  // namespace logger
@@ -18,17 +18,13 @@
 #define CYBER_LOGGER_ASYNC_LOGGER_H_
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <ctime>
-#include <deque>
-#include <iostream>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include "glog/logging.h"
@@ -40,22 +36,80 @@ namespace apollo {
 namespace cyber {
 namespace logger {
 
+/**
+ * @class LogRing
+ * @brief Bounded single producer single consumer queue of log messages.
+ * Each writing thread owns one, the logger thread drains them all. The
+ * slots keep their string capacity so that, once warmed up, pushing a
+ * message is a copy without allocation, and a full ring drops the message
+ * instead of waiting.
+ */
+class LogRing {
+ public:
+  struct Msg {
+    time_t ts = 0;
+    int32_t level = google::INFO;
+    std::string message;
+  };
+
+  LogRing(uint32_t capacity, uint32_t rate_limit);
+
+  // producer side
+  bool Push(time_t ts, int32_t level, const char* message, int message_len);
+  // consumer side, f is called with each message in order
+  template <typename F>
+  uint32_t Drain(F&& f);
+
+  // the producing thread has gone, the ring can go when drained
+  void Close() { closed_.store(true, std::memory_order_release); }
+  bool closed() const { return closed_.load(std::memory_order_acquire); }
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  const uint64_t capacity_;
+  std::unique_ptr<Msg[]> slots_;
+  alignas(64) std::atomic<uint64_t> head_ = {0};
+  alignas(64) std::atomic<uint64_t> tail_ = {0};
+  std::atomic<uint64_t> dropped_ = {0};
+  std::atomic<bool> closed_ = {false};
+
+  // INFO messages allowed per second, 0 for no limit, producer only
+  const uint32_t rate_limit_;
+  time_t rate_ts_ = 0;
+  uint32_t rate_count_ = 0;
+};
+
+template <typename F>
+uint32_t LogRing::Drain(F&& f) {
+  uint64_t head = head_.load(std::memory_order_relaxed);
+  uint64_t tail = tail_.load(std::memory_order_acquire);
+  uint32_t count = 0;
+  for (; head != tail; ++head, ++count) {
+    f(&slots_[head % capacity_]);
+    // hand the slot back before the next one is looked at
+    head_.store(head + 1, std::memory_order_release);
+  }
+  return count;
+}
+
 /**
  * @class AsyncLogger
  * @brief .
  * Wrapper for a glog Logger which asynchronously writes log messages.
  * This class starts a new thread responsible for forwarding the messages
- * to the logger, and performs double buffering. Writers append to the
- * current buffer and then wake up the logger thread. The logger swaps in
- * a new buffer and writes any accumulated messages to the wrapped
- * Logger.
+ * to the logger. Every application thread appends to a LogRing of its own
+ * without taking any lock, the logger thread drains the rings, works out
+ * the module of each message and writes it to the module's log file.
  *
- * This double-buffering design dramatically improves performance, especially
- * for logging messages which require flushing the underlying file (i.e WARNING
- * and above for default). The flush can take a couple of milliseconds, and in
- * some cases can even block for hundreds of milliseconds or more. With the
- * double-buffered approach, threads can proceed with useful work while the IO
- * thread blocks.
+ * This design dramatically improves performance, especially for logging
+ * messages which require flushing the underlying file (i.e WARNING and above
+ * for default). The flush can take a couple of milliseconds, and in some
+ * cases can even block for hundreds of milliseconds or more. With the
+ * rings, threads can proceed with useful work while the IO thread blocks.
  *
  * The semantics provided by this wrapper are slightly weaker than the default
  * glog semantics. By default, glog will immediately (synchronously) flush
@@ -63,12 +117,12 @@ namespace logger {
  * and above to the underlying file, whereas here we are deferring that flush to
  * a separate thread. This means that a crash just after a 'LOG_WARN' would
  * may be missing the message in the logs, but the perf benefit is probably
- * worth it. We do take care that a glog FATAL message flushes all buffered log
- * messages before exiting.
+ * worth it.
  *
- * @warning The logger limits the total amount of buffer space, so if the
- * underlying log blocks for too long, eventually the threads generating the log
- * messages will block as well. This prevents runaway memory usage.
+ * @warning Logging never blocks the caller. When the underlying log falls
+ * behind and a ring fills up, or a thread logs more INFO messages per second
+ * than CYBER_LOG_RATE_LIMIT, messages are dropped. The drops are counted and
+ * reported in the log. The ring size is taken from CYBER_LOG_RING_SIZE.
  */
 class AsyncLogger : public google::base::Logger {
  public:
@@ -125,69 +179,44 @@ class AsyncLogger : public google::base::Logger {
    */
   std::thread* LogThread() { return &log_thread_; }
 
- private:
-  // A buffered message.
-  //
-  // TODO(todd): using std::string for buffered messages is convenient but not
-  // as efficient as it could be. It's better to make the buffers just be
-  // Arenas and allocate both the message data and Msg struct from them, forming
-  // a linked list.
-  struct Msg {
-    time_t ts;
-    std::string message;
-    int32_t level;
-    Msg() : ts(0), message(), level(google::INFO) {}
-    Msg(time_t ts, std::string&& message, int32_t level)
-        : ts(ts), message(std::move(message)), level(level) {}
-    Msg(const Msg& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-    }
-    Msg(Msg&& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-    }
-    Msg& operator=(Msg&& rsh) {
-      ts = rsh.ts;
-      message = std::move(rsh.message);
-      level = rsh.level;
-      return *this;
-    }
-    Msg& operator=(const Msg& rsh) {
-      ts = rsh.ts;
-      message = rsh.message;
-      level = rsh.level;
-      return *this;
-    }
-  };
+  /**
+   * @brief get the number of messages dropped since start
+   */
+  uint64_t DropCount();
 
+ private:
+  LogRing* GetRing();
   void RunThread();
-  void FlushBuffer(const std::unique_ptr<std::deque<Msg>>& msg);
+  // drains every ring, returns the number of messages written
+  uint32_t FlushRings();
+  void WriteMessage(LogRing::Msg* msg);
+  void ReportDrops();
 
   google::base::Logger* const wrapped_;
   std::thread log_thread_;
+  // tells the rings of this logger apart from those of a previous one at the
+  // same address
+  const uint64_t id_;
+  const uint32_t ring_size_;
+  const uint32_t rate_limit_;
 
   // Count of how many times the writer thread has flushed the buffers.
   // 64 bits should be enough to never worry about overflow.
   std::atomic<uint64_t> flush_count_ = {0};
 
-  // Count of how many times the writer thread has dropped the log messages.
-  // 64 bits should be enough to never worry about overflow.
-  uint64_t drop_count_ = 0;
-
-  // The buffer to which application threads append new log messages.
-  std::unique_ptr<std::deque<Msg>> active_buf_;
+  // Count of how many log messages have been dropped and reported so far,
+  // only touched by the logger thread.
+  uint64_t reported_drop_count_ = 0;
 
-  // The buffer currently being flushed by the logger thread, cleared
-  // after a successful flush.
-  std::unique_ptr<std::deque<Msg>> flushing_buf_;
+  // only taken when a thread logs for the first time and by the logger thread
+  std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<LogRing>> rings_;
+  // dropped by rings that have been closed and removed
+  uint64_t removed_drop_count_ = 0;
 
   // Trigger for the logger thread to stop.
   enum State { INITTED, RUNNING, STOPPED };
   std::atomic<State> state_ = {INITTED};
-  std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
   std::unordered_map<std::string, std::unique_ptr<LogFileObject>>
       module_logger_map_;
 
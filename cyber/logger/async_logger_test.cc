@@ -16,6 +16,10 @@
 
 #include "cyber/logger/async_logger.h"
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "glog/logging.h"
@@ -69,6 +73,66 @@ TEST(AsyncLoggerTest, SetLoggerToGlog) {
   google::ShutdownGoogleLogging();
 }
 
+TEST(AsyncLoggerTest, LogRing) {
+  LogRing ring(2, 0);
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(ring.Push(1, google::INFO, "first", 5));
+  EXPECT_TRUE(ring.Push(1, google::WARNING, "second", 6));
+  // full, the message is dropped rather than waited for
+  EXPECT_FALSE(ring.Push(1, google::INFO, "third", 5));
+  EXPECT_EQ(ring.dropped(), 1);
+
+  std::vector<std::string> messages;
+  EXPECT_EQ(ring.Drain([&messages](LogRing::Msg* msg) {
+              messages.emplace_back(msg->message);
+            }),
+            2);
+  ASSERT_EQ(messages.size(), 2);
+  EXPECT_EQ(messages[0], "first");
+  EXPECT_EQ(messages[1], "second");
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(ring.Push(1, google::INFO, "third", 5));
+}
+
+TEST(AsyncLoggerTest, RateLimit) {
+  LogRing ring(16, 2);
+  EXPECT_TRUE(ring.Push(1, google::INFO, "a", 1));
+  EXPECT_TRUE(ring.Push(1, google::INFO, "b", 1));
+  EXPECT_FALSE(ring.Push(1, google::INFO, "c", 1));
+  // warnings and above are not limited
+  EXPECT_TRUE(ring.Push(1, google::ERROR, "d", 1));
+  // a new second
+  EXPECT_TRUE(ring.Push(2, google::INFO, "e", 1));
+  EXPECT_EQ(ring.dropped(), 1);
+}
+
+TEST(AsyncLoggerTest, MultiThreadWrite) {
+  AsyncLogger logger(google::base::GetLogger(google::INFO));
+  logger.Start();
+
+  time_t timep;
+  time(&timep);
+  std::string message = "I0909 99:99:99.999999 99999 logger_test.cc:999] ";
+  message.append(LEFT_BRACKET);
+  message.append("AsyncLoggerTest3");
+  message.append(RIGHT_BRACKET);
+  message.append("async logger test message\n");
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&logger, &message, timep]() {
+      for (int j = 0; j < 1000; ++j) {
+        logger.Write(false, timep, message.c_str(),
+                     static_cast<int>(message.length()));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  logger.Stop();
+  EXPECT_LE(logger.DropCount(), 4000);
+}
+
 }  // namespace logger
 }  // namespace cyber
 }  // namespace apollo
@@ -19,6 +19,9 @@
 #include <getopt.h>
 #include <libgen.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 using apollo::cyber::common::GlobalData;
 
 namespace apollo {
@@ -34,6 +37,13 @@ void ModuleArgument::DisplayUsage() {
            "namespace for running this module, default in manager process\n"
         << "    -s, --sched_name=sched_name: sched policy "
            "conf for hole process, sched_name should be conf in cyber.pb.conf\n"
+        << "    -j, --init_threads=N: initialize the modules of the dags on "
+           "N threads, components of one module still start in order, "
+           "default 1\n"
+        << "    -l, --preload_threads=N: load the libraries of all dags with "
+           "symbols bound at once before creating components, their files "
+           "are read in on N threads, default 0 loads each one lazily with "
+           "its dag\n"
         << "Example:\n"
         << "    " << binary_name_ << " -h\n"
         << "    " << binary_name_ << " -d dag_conf_file1 -d dag_conf_file2 "
@@ -64,12 +74,14 @@ void ModuleArgument::ParseArgument(const int argc, char* const argv[]) {
 void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
   opterr = 0;  // extern int opterr
   int long_index = 0;
-  const std::string short_opts = "hd:p:s:";
+  const std::string short_opts = "hd:p:s:j:l:";
   static const struct option long_opts[] = {
       {"help", no_argument, nullptr, 'h'},
       {"dag_conf", required_argument, nullptr, 'd'},
       {"process_name", required_argument, nullptr, 'p'},
       {"sched_name", required_argument, nullptr, 's'},
+      {"init_threads", required_argument, nullptr, 'j'},
+      {"preload_threads", required_argument, nullptr, 'l'},
       {NULL, no_argument, nullptr, 0}};
 
   // log command for info
@@ -108,6 +120,12 @@ void ModuleArgument::GetOptions(const int argc, char* const argv[]) {
       case 's':
         sched_name_ = std::string(optarg);
         break;
+      case 'j':
+        init_threads_ = std::max(1, std::atoi(optarg));
+        break;
+      case 'l':
+        preload_threads_ = std::max(0, std::atoi(optarg));
+        break;
       case 'h':
         DisplayUsage();
         exit(0);
@@ -42,12 +42,16 @@ class ModuleArgument {
   const std::string& GetProcessGroup() const;
   const std::string& GetSchedName() const;
   const std::list<std::string>& GetDAGConfList() const;
+  int GetInitThreads() const;
+  int GetPreloadThreads() const;
 
  private:
   std::list<std::string> dag_conf_list_;
   std::string binary_name_;
   std::string process_group_;
   std::string sched_name_;
+  int init_threads_ = 1;
+  int preload_threads_ = 0;
 };
 
 inline const std::string& ModuleArgument::GetBinaryName() const {
@@ -66,6 +70,12 @@ inline const std::list<std::string>& ModuleArgument::GetDAGConfList() const {
   return dag_conf_list_;
 }
 
+inline int ModuleArgument::GetInitThreads() const { return init_threads_; }
+
+inline int ModuleArgument::GetPreloadThreads() const {
+  return preload_threads_;
+}
+
 }  // namespace mainboard
 }  // namespace cyber
 }  // namespace apollo
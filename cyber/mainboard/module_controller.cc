@@ -16,11 +16,15 @@
 
 #include "cyber/mainboard/module_controller.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <utility>
 
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
 #include "cyber/component/component_base.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
@@ -61,6 +65,9 @@ bool ModuleController::LoadAll() {
     total_component_nums += scheduler::Instance()->TaskPoolSize();
   }
   common::GlobalData::Instance()->SetComponentNums(total_component_nums);
+  if (args_.GetPreloadThreads() > 0 && !PreloadLibraries(paths)) {
+    return false;
+  }
   for (auto module_path : paths) {
     AINFO << "Start initialize dag: " << module_path;
     if (!LoadModule(module_path)) {
@@ -68,47 +75,107 @@ bool ModuleController::LoadAll() {
       return false;
     }
   }
-  return true;
+  return InitModules();
 }
 
-bool ModuleController::LoadModule(const DagConfig& dag_config) {
-  const std::string work_root = common::WorkRoot();
+bool ModuleController::InitModules() {
+  auto start_ns = Time::MonoTime().ToNanosecond();
+  size_t thread_num = std::min(
+      static_cast<size_t>(args_.GetInitThreads()), pending_units_.size());
 
-  for (auto module_config : dag_config.module_config()) {
-    std::string load_path;
-    if (module_config.module_library().front() == '/') {
-      load_path = module_config.module_library();
-    } else {
-      load_path =
-          common::GetAbsolutePath(work_root, module_config.module_library());
+  bool ret = true;
+  if (thread_num <= 1) {
+    for (auto& unit : pending_units_) {
+      if (!InitModule(unit)) {
+        ret = false;
+        break;
+      }
+    }
+  } else {
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back([this, &next, &failed]() {
+        while (!failed.load()) {
+          size_t index = next.fetch_add(1);
+          if (index >= pending_units_.size()) {
+            break;
+          }
+          if (!InitModule(pending_units_[index])) {
+            failed.store(true);
+          }
+        }
+      });
     }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ret = !failed.load();
+  }
+  pending_units_.clear();
+
+  AINFO << "Initialize " << component_list_.size() << " components on "
+        << std::max(thread_num, static_cast<size_t>(1)) << " threads in "
+        << (Time::MonoTime().ToNanosecond() - start_ns) / 1000000 << " ms";
+  return ret;
+}
 
+bool ModuleController::InitModule(const ModuleUnit& unit) {
+  for (auto& pending : unit) {
+    auto start_ns = Time::MonoTime().ToNanosecond();
+    bool ret = pending.init();
+    auto cost_ms = (Time::MonoTime().ToNanosecond() - start_ns) / 1000000;
+    if (!ret) {
+      AERROR << "Failed to initialize component " << pending.class_name
+             << " after " << cost_ms << " ms";
+      return false;
+    }
+    AINFO << "Initialize component " << pending.class_name << " in "
+          << cost_ms << " ms";
+    std::lock_guard<std::mutex> lock(component_list_mutex_);
+    component_list_.emplace_back(pending.base);
+  }
+  return true;
+}
+
+bool ModuleController::LoadModule(const DagConfig& dag_config) {
+  for (auto module_config : dag_config.module_config()) {
+    std::string load_path = GetLibraryPath(module_config);
     if (!common::PathExists(load_path)) {
       AERROR << "Path does not exist: " << load_path;
       return false;
     }
 
+    // libraries are loaded and objects created on this thread, only the
+    // Initialize calls may run in parallel
     class_loader_manager_.LoadLibrary(load_path);
 
+    ModuleUnit unit;
     for (auto& component : module_config.components()) {
       const std::string& class_name = component.class_name();
       std::shared_ptr<ComponentBase> base =
           class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
+      if (base == nullptr) {
         return false;
       }
-      component_list_.emplace_back(std::move(base));
+      auto config = component.config();
+      unit.push_back({class_name, base,
+                      [base, config]() { return base->Initialize(config); }});
     }
 
     for (auto& component : module_config.timer_components()) {
       const std::string& class_name = component.class_name();
       std::shared_ptr<ComponentBase> base =
           class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
+      if (base == nullptr) {
         return false;
       }
-      component_list_.emplace_back(std::move(base));
+      auto config = component.config();
+      unit.push_back({class_name, base,
+                      [base, config]() { return base->Initialize(config); }});
     }
+    pending_units_.emplace_back(std::move(unit));
   }
   return true;
 }
@@ -122,6 +189,40 @@ bool ModuleController::LoadModule(const std::string& path) {
   return LoadModule(dag_config);
 }
 
+bool ModuleController::PreloadLibraries(
+    const std::vector<std::string>& paths) {
+  std::vector<std::string> library_paths;
+  for (const auto& path : paths) {
+    DagConfig dag_config;
+    if (!common::GetProtoFromFile(path, &dag_config)) {
+      AERROR << "Get proto failed, file: " << path;
+      return false;
+    }
+    for (const auto& module_config : dag_config.module_config()) {
+      std::string load_path = GetLibraryPath(module_config);
+      if (!common::PathExists(load_path)) {
+        AERROR << "Path does not exist: " << load_path;
+        return false;
+      }
+      if (std::find(library_paths.begin(), library_paths.end(), load_path) ==
+          library_paths.end()) {
+        library_paths.emplace_back(std::move(load_path));
+      }
+    }
+  }
+  return class_loader_manager_.PreloadLibraries(library_paths,
+                                                args_.GetPreloadThreads());
+}
+
+std::string ModuleController::GetLibraryPath(
+    const proto::ModuleConfig& module_config) const {
+  if (module_config.module_library().front() == '/') {
+    return module_config.module_library();
+  }
+  return common::GetAbsolutePath(common::WorkRoot(),
+                                 module_config.module_library());
+}
+
 int ModuleController::GetComponentNum(const std::string& path) {
   DagConfig dag_config;
   int component_nums = 0;
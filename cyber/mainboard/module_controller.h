@@ -16,7 +16,9 @@
 #ifndef CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 #define CYBER_MAINBOARD_MODULE_CONTROLLER_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -42,14 +44,30 @@ class ModuleController {
   void Clear();
 
  private:
+  // A component that is created but not initialized yet. The components of
+  // one module_config form a unit and are initialized in declaration order,
+  // later ones may rely on what earlier ones set up. Units are independent.
+  struct PendingComponent {
+    std::string class_name;
+    std::shared_ptr<ComponentBase> base;
+    std::function<bool()> init;
+  };
+  using ModuleUnit = std::vector<PendingComponent>;
+
   bool LoadModule(const std::string& path);
   bool LoadModule(const DagConfig& dag_config);
+  bool InitModules();
+  bool InitModule(const ModuleUnit& unit);
   int GetComponentNum(const std::string& path);
+  bool PreloadLibraries(const std::vector<std::string>& paths);
+  std::string GetLibraryPath(const proto::ModuleConfig& module_config) const;
   int total_component_nums = 0;
   bool has_timer_component = false;
 
   ModuleArgument args_;
   class_loader::ClassLoaderManager class_loader_manager_;
+  std::vector<ModuleUnit> pending_units_;
+  std::mutex component_list_mutex_;
   std::vector<std::shared_ptr<ComponentBase>> component_list_;
 };
 
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/arena_pool.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+namespace {
+
+std::mutex pools_mutex;
+std::unordered_map<uint64_t, std::shared_ptr<ArenaPool>> pools;
+
+}  // namespace
+
+ArenaPool::ArenaPool(uint32_t arena_num, uint64_t block_size)
+    : block_size_(block_size) {
+  idle_.Init(arena_num);
+  arenas_.reserve(arena_num);
+  for (uint32_t i = 0; i < arena_num; ++i) {
+    auto pooled = std::unique_ptr<PooledArena>(new PooledArena());
+    pooled->block.reset(new char[block_size_]);
+    google::protobuf::ArenaOptions options;
+    options.initial_block = pooled->block.get();
+    options.initial_block_size = block_size_;
+    pooled->arena.reset(new google::protobuf::Arena(options));
+    idle_.Enqueue(pooled.get());
+    arenas_.emplace_back(std::move(pooled));
+  }
+}
+
+ArenaPool::~ArenaPool() {}
+
+std::shared_ptr<google::protobuf::Arena> ArenaPool::Acquire() {
+  PooledArena* pooled = nullptr;
+  if (!idle_.Dequeue(&pooled)) {
+    return nullptr;
+  }
+  auto self = shared_from_this();
+  return std::shared_ptr<google::protobuf::Arena>(
+      pooled->arena.get(), [self, pooled](google::protobuf::Arena* arena) {
+        // frees the blocks grown past the initial one, which is kept
+        arena->Reset();
+        self->idle_.Enqueue(pooled);
+      });
+}
+
+void ArenaPool::Enable(uint64_t channel_id, uint32_t arena_num,
+                       uint64_t block_size) {
+  std::lock_guard<std::mutex> lock(pools_mutex);
+  auto& pool = pools[channel_id];
+  if (pool != nullptr) {
+    if (pool->block_size() != block_size) {
+      AWARN << "arena pool of channel " << channel_id
+            << " already uses blocks of " << pool->block_size() << " bytes";
+    }
+    return;
+  }
+  pool = std::make_shared<ArenaPool>(arena_num, block_size);
+}
+
+std::shared_ptr<ArenaPool> ArenaPool::Get(uint64_t channel_id) {
+  std::lock_guard<std::mutex> lock(pools_mutex);
+  auto it = pools.find(channel_id);
+  return it == pools.end() ? nullptr : it->second;
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_ARENA_POOL_H_
+#define CYBER_MESSAGE_ARENA_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+#include "google/protobuf/message.h"
+
+#include "cyber/base/bounded_queue.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+// Recycles protobuf arenas for the messages received on one channel. A
+// message created here lives in an arena whose initial block is reused, so
+// parsing a message with many repeated fields does not hit malloc once the
+// block is large enough. The arena is reset and returned to the pool when
+// the last shared_ptr to the message goes away, on that thread.
+class ArenaPool : public std::enable_shared_from_this<ArenaPool> {
+ public:
+  ArenaPool(uint32_t arena_num, uint64_t block_size);
+  virtual ~ArenaPool();
+
+  // Falls back to the heap when the type is not a protobuf or all arenas
+  // are in use.
+  template <typename MessageT>
+  typename std::enable_if<
+      std::is_base_of<google::protobuf::Message, MessageT>::value,
+      std::shared_ptr<MessageT>>::type
+  CreateMessage();
+
+  template <typename MessageT>
+  typename std::enable_if<
+      !std::is_base_of<google::protobuf::Message, MessageT>::value,
+      std::shared_ptr<MessageT>>::type
+  CreateMessage() {
+    return std::make_shared<MessageT>();
+  }
+
+  uint64_t block_size() const { return block_size_; }
+
+  // Opts the readers of channel_id into arena allocation, which takes
+  // effect for the listeners added to the dispatchers afterwards.
+  static void Enable(uint64_t channel_id, uint32_t arena_num,
+                     uint64_t block_size);
+  // nullptr unless Enable() was called for channel_id
+  static std::shared_ptr<ArenaPool> Get(uint64_t channel_id);
+
+  template <typename MessageT>
+  static std::shared_ptr<MessageT> NewMessage(
+      const std::shared_ptr<ArenaPool>& pool) {
+    if (pool == nullptr) {
+      return std::make_shared<MessageT>();
+    }
+    return pool->template CreateMessage<MessageT>();
+  }
+
+ private:
+  struct PooledArena {
+    std::unique_ptr<char[]> block;
+    std::unique_ptr<google::protobuf::Arena> arena;
+  };
+
+  std::shared_ptr<google::protobuf::Arena> Acquire();
+
+  uint64_t block_size_;
+  std::vector<std::unique_ptr<PooledArena>> arenas_;
+  base::BoundedQueue<PooledArena*> idle_;
+};
+
+template <typename MessageT>
+typename std::enable_if<
+    std::is_base_of<google::protobuf::Message, MessageT>::value,
+    std::shared_ptr<MessageT>>::type
+ArenaPool::CreateMessage() {
+  auto arena = Acquire();
+  if (arena == nullptr) {
+    return std::make_shared<MessageT>();
+  }
+  auto msg = google::protobuf::Arena::CreateMessage<MessageT>(arena.get());
+  // the message shares the ownership of its arena
+  return std::shared_ptr<MessageT>(arena, msg);
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_ARENA_POOL_H_
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/arena_pool.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+TEST(ArenaPoolTest, create_message) {
+  auto pool = std::make_shared<ArenaPool>(2, 4096);
+  auto msg0 = pool->CreateMessage<proto::Chatter>();
+  auto msg1 = pool->CreateMessage<proto::Chatter>();
+  ASSERT_NE(nullptr, msg0->GetArena());
+  ASSERT_NE(nullptr, msg1->GetArena());
+  EXPECT_NE(msg0->GetArena(), msg1->GetArena());
+
+  // all arenas in use, the next message is a heap one
+  auto msg2 = pool->CreateMessage<proto::Chatter>();
+  EXPECT_EQ(nullptr, msg2->GetArena());
+
+  msg0->set_content(std::string(8192, 'c'));
+  auto arena = msg0->GetArena();
+  auto copy = msg0;
+  msg0.reset();
+  EXPECT_EQ(8192, copy->content().size());
+  copy.reset();
+
+  // the released arena is reset and handed out again
+  auto msg3 = pool->CreateMessage<proto::Chatter>();
+  EXPECT_EQ(arena, msg3->GetArena());
+  EXPECT_TRUE(msg3->content().empty());
+
+  // only protobuf messages live in arenas
+  auto raw = pool->CreateMessage<RawMessage>();
+  EXPECT_NE(nullptr, raw);
+}
+
+TEST(ArenaPoolTest, enable) {
+  EXPECT_EQ(nullptr, ArenaPool::Get(1));
+  ArenaPool::Enable(1, 4, 1024);
+  auto pool = ArenaPool::Get(1);
+  ASSERT_NE(nullptr, pool);
+  EXPECT_EQ(1024, pool->block_size());
+
+  // a second reader of the channel shares the pool
+  ArenaPool::Enable(1, 4, 2048);
+  EXPECT_EQ(pool, ArenaPool::Get(1));
+
+  auto msg = ArenaPool::NewMessage<proto::Chatter>(nullptr);
+  EXPECT_EQ(nullptr, msg->GetArena());
+  msg = ArenaPool::NewMessage<proto::Chatter>(pool);
+  EXPECT_NE(nullptr, msg->GetArena());
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
@@ -18,6 +18,7 @@
 #define CYBER_MESSAGE_MESSAGE_TRAITS_H_
 
 #include <string>
+#include <type_traits>
 
 #include "cyber/base/macros.h"
 #include "cyber/common/log.h"
@@ -53,6 +54,21 @@ class HasSerializer {
 template <typename T>
 constexpr bool HasSerializer<T>::value;
 
+// A loanable message is a flat, fixed-size type that can be constructed
+// directly inside a shared memory block and read in place by readers, so
+// neither side serializes or copies it.
+template <typename T>
+class IsLoanable {
+ public:
+  static constexpr bool value =
+      std::is_trivially_copyable<T>::value &&
+      std::is_standard_layout<T>::value &&
+      !std::is_base_of<google::protobuf::Message, T>::value;
+};
+
+template <typename T>
+constexpr bool IsLoanable<T>::value;
+
 template <typename T,
           typename std::enable_if<HasType<T>::value &&
                                       std::is_member_function_pointer<
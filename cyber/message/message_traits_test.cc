@@ -77,6 +77,13 @@ class PbMessage {
   static std::string TypeName() { return "protobuf"; }
 };
 
+struct FlatFrame {
+  uint64_t timestamp;
+  uint32_t width;
+  uint32_t height;
+  uint8_t data[64];
+};
+
 TEST(MessageTraitsTest, type_trait) {
   EXPECT_FALSE(HasType<Data>::value);
   EXPECT_FALSE(HasSerializer<Data>::value);
@@ -104,6 +111,14 @@ TEST(MessageTraitsTest, type_trait) {
   EXPECT_EQ("protobuf", MessageType<PbMessage>());
 }
 
+TEST(MessageTraitsTest, is_loanable) {
+  EXPECT_TRUE(IsLoanable<FlatFrame>::value);
+  EXPECT_FALSE(IsLoanable<Data>::value);
+  EXPECT_FALSE(IsLoanable<Message>::value);
+  EXPECT_FALSE(IsLoanable<RawMessage>::value);
+  EXPECT_FALSE(IsLoanable<proto::UnitTest>::value);
+}
+
 TEST(MessageTraitsTest, byte_size) {
   Data data;
   EXPECT_EQ(ByteSize(data), -1);
@@ -46,6 +46,7 @@ class Node {
   template <typename M0, typename M1, typename M2, typename M3>
   friend class Component;
   friend class TimerComponent;
+  friend class SysMo;
   friend bool Init(const char*);
   friend std::unique_ptr<Node> CreateNode(const std::string&,
                                           const std::string&);
@@ -24,7 +24,9 @@
 
 #include "cyber/blocker/intra_reader.h"
 #include "cyber/blocker/intra_writer.h"
+#include "cyber/blocker/pipeline.h"
 #include "cyber/common/global_data.h"
+#include "cyber/message/arena_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/node/reader.h"
 #include "cyber/node/writer.h"
@@ -48,7 +50,8 @@ struct ReaderConfig {  ///< configurations for a Reader
   ReaderConfig(const ReaderConfig& other)
       : channel_name(other.channel_name),
         qos_profile(other.qos_profile),
-        pending_queue_size(other.pending_queue_size) {}
+        pending_queue_size(other.pending_queue_size),
+        arena_block_size(other.arena_block_size) {}
 
   std::string channel_name;       //< channel reads
   proto::QosProfile qos_profile;  //< the qos configuration
@@ -57,6 +60,12 @@ struct ReaderConfig {  ///< configurations for a Reader
    * Older messages will dropped if you have no time to handle
    */
   uint32_t pending_queue_size;
+  /**
+   * @brief parse received protobuf messages into recycled arenas whose
+   * initial block has this size, 0 allocates every message on the heap.
+   * Best sized to hold a whole message of the channel.
+   */
+  uint64_t arena_block_size = 0;
 };
 
 /**
@@ -159,7 +168,8 @@ auto NodeChannelImpl::CreateWriter(const proto::RoleAttributes& role_attr)
   FillInAttr<MessageT>(&new_attr);
 
   std::shared_ptr<Writer<MessageT>> writer_ptr = nullptr;
-  if (!is_reality_mode_) {
+  if (!is_reality_mode_ ||
+      blocker::Pipeline::Instance()->Contains(new_attr.channel_name())) {
     writer_ptr = std::make_shared<blocker::IntraWriter<MessageT>>(new_attr);
   } else {
     writer_ptr = std::make_shared<Writer<MessageT>>(new_attr);
@@ -194,6 +204,12 @@ auto NodeChannelImpl::CreateReader(const ReaderConfig& config,
   proto::RoleAttributes role_attr;
   role_attr.set_channel_name(config.channel_name);
   role_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
+  if (config.arena_block_size > 0) {
+    // messages queued for the callback and the one being handled
+    message::ArenaPool::Enable(
+        GlobalData::RegisterChannel(config.channel_name),
+        config.pending_queue_size + 2, config.arena_block_size);
+  }
   return this->template CreateReader<MessageT>(role_attr, reader_func,
                                                config.pending_queue_size);
 }
@@ -212,7 +228,8 @@ auto NodeChannelImpl::CreateReader(const proto::RoleAttributes& role_attr,
   FillInAttr<MessageT>(&new_attr);
 
   std::shared_ptr<Reader<MessageT>> reader_ptr = nullptr;
-  if (!is_reality_mode_) {
+  if (!is_reality_mode_ ||
+      blocker::Pipeline::Instance()->Contains(new_attr.channel_name())) {
     reader_ptr =
         std::make_shared<blocker::IntraReader<MessageT>>(new_attr, reader_func);
   } else {
@@ -219,6 +219,8 @@ class Reader : public ReaderBase {
   CallbackFunc<MessageT> reader_func_;
   ReceiverPtr receiver_ = nullptr;
   std::string croutine_name_;
+  // the notification the callback was last timed against
+  uint64_t last_notify_ns_ = 0;
 
   BlockerPtr blocker_ = nullptr;
 
@@ -259,14 +261,20 @@ bool Reader<MessageT>::Init() {
   if (init_.exchange(true)) {
     return true;
   }
+  auto stats = transport::TransportStats::Instance()->Get(
+      role_attr_.channel_name(), "reader", "");
   std::function<void(const std::shared_ptr<MessageT>&)> func;
   if (reader_func_ != nullptr) {
-    func = [this](const std::shared_ptr<MessageT>& msg) {
+    func = [this, stats](const std::shared_ptr<MessageT>& msg) {
+      stats->OnCallback(&this->last_notify_ns_);
       this->Enqueue(msg);
       this->reader_func_(msg);
     };
   } else {
-    func = [this](const std::shared_ptr<MessageT>& msg) { this->Enqueue(msg); };
+    func = [this, stats](const std::shared_ptr<MessageT>& msg) {
+      stats->OnCallback(&this->last_notify_ns_);
+      this->Enqueue(msg);
+    };
   }
   auto sched = scheduler::Instance();
   croutine_name_ = role_attr_.node_name() + "_" + role_attr_.channel_name();
@@ -26,6 +26,7 @@
 #include "cyber/common/macros.h"
 #include "cyber/common/util.h"
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/transport/common/transport_stats.h"
 #include "cyber/transport/transport.h"
 
 namespace apollo {
@@ -204,11 +205,13 @@ auto ReceiverManager<MessageT>::GetReceiver(
   // so reader for datacache we use map to keep one instance for per channel
   const std::string& channel_name = role_attr.channel_name();
   if (receiver_map_.count(channel_name) == 0) {
+    auto stats = transport::TransportStats::Instance()->Get(channel_name,
+                                                            "reader", "");
     receiver_map_[channel_name] =
         transport::Transport::Instance()->CreateReceiver<MessageT>(
-            role_attr, [](const std::shared_ptr<MessageT>& msg,
-                          const transport::MessageInfo& msg_info,
-                          const proto::RoleAttributes& reader_attr) {
+            role_attr, [stats](const std::shared_ptr<MessageT>& msg,
+                               const transport::MessageInfo& msg_info,
+                               const proto::RoleAttributes& reader_attr) {
               (void)msg_info;
               (void)reader_attr;
               PerfEventCache::Instance()->AddTransportEvent(
@@ -216,6 +219,7 @@ auto ReceiverManager<MessageT>::GetReceiver(
                   msg_info.seq_num());
               data::DataDispatcher<MessageT>::Instance()->Dispatch(
                   reader_attr.channel_id(), msg);
+              stats->OnNotify();
               PerfEventCache::Instance()->AddTransportEvent(
                   TransPerf::NOTIFY, reader_attr.channel_id(),
                   msg_info.seq_num());
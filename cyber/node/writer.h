@@ -84,6 +84,19 @@ class Writer : public WriterBase {
    */
   virtual bool Write(const std::shared_ptr<MessageT>& msg_ptr);
 
+  /**
+   * @brief Borrow a message from the underlying transport, fill it in place
+   * and publish it with Write(msg_ptr). For loanable (flat, fixed-size)
+   * message types read by other processes, the message lives in a shared
+   * memory block, so it is neither serialized nor copied on the way to the
+   * readers. Drop the pointer soon after writing, the block is not reused
+   * while any holder keeps it.
+   *
+   * @return std::shared_ptr<MessageT> the loaned message, nullptr if the
+   * writer is not initialized
+   */
+  std::shared_ptr<MessageT> Loan();
+
   /**
    * @brief Is there any Reader that subscribes our Channel?
    * You can publish message when this return true
@@ -169,6 +182,12 @@ bool Writer<MessageT>::Write(const std::shared_ptr<MessageT>& msg_ptr) {
   return transmitter_->Transmit(msg_ptr);
 }
 
+template <typename MessageT>
+std::shared_ptr<MessageT> Writer<MessageT>::Loan() {
+  RETURN_VAL_IF(!WriterBase::IsInit(), nullptr);
+  return transmitter_->Loan();
+}
+
 template <typename MessageT>
 void Writer<MessageT>::JoinTheTopology() {
   // add listener
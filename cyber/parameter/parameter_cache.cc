@@ -0,0 +1,370 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/parameter/parameter_cache.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <ctime>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x6379626572706172;  // "cyberpar"
+constexpr uint32_t kSlotNum = 1024;
+constexpr uint32_t kSlotDataSize = 1000;
+constexpr int kMaxReadRetries = 64;
+
+int FutexWait(std::atomic<uint32_t>* addr, uint32_t expected,
+              const struct timespec* timeout) {
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr),
+                                  FUTEX_WAIT, expected, timeout, nullptr, 0));
+}
+
+int FutexWake(std::atomic<uint32_t>* addr) {
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr),
+                                  FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0));
+}
+
+uint64_t NameHash(const std::string& name) {
+  // 0 marks an empty slot
+  uint64_t hash = static_cast<uint64_t>(common::Hash(name));
+  return hash == 0 ? 1 : hash;
+}
+
+}  // namespace
+
+// version is bumped on every write and is the futex word the readers wait on,
+// owner_pid is cleared when the table is given up by its server
+struct ParameterCache::Header {
+  uint64_t magic;
+  std::atomic<int32_t> owner_pid;
+  std::atomic<uint32_t> version;
+  uint32_t slot_num;
+};
+
+// seq is odd while the slot is written, name_hash is published once the slot
+// holds its first value and never changes afterwards
+struct ParameterCache::Slot {
+  std::atomic<uint64_t> name_hash;
+  std::atomic<uint32_t> seq;
+  std::atomic<uint32_t> version;
+  std::atomic<uint32_t> size;
+  char data[kSlotDataSize];
+};
+
+ParameterCache::ParameterCache(const std::string& node_name)
+    : shm_name_("/cyber_param_" + std::to_string(common::Hash(node_name))),
+      shm_size_(sizeof(Header) + kSlotNum * sizeof(Slot)) {}
+
+ParameterCache::~ParameterCache() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_owner_ && header_ != nullptr) {
+    header_->owner_pid.store(0);
+    header_->version.fetch_add(1);
+    FutexWake(&header_->version);
+    shm_unlink(shm_name_.c_str());
+  }
+  Detach();
+}
+
+bool ParameterCache::Create() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_owner_) {
+    return true;
+  }
+  Detach();
+
+  // readers still mapping the table of a server that crashed must not keep
+  // reading it once a new server is up
+  int fd = shm_open(shm_name_.c_str(), O_RDWR, 0644);
+  if (fd >= 0) {
+    void* old_shm =
+        mmap(nullptr, shm_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (old_shm != MAP_FAILED) {
+      auto old_header = static_cast<Header*>(old_shm);
+      if (old_header->magic == kMagic) {
+        old_header->owner_pid.store(0);
+        old_header->version.fetch_add(1);
+        FutexWake(&old_header->version);
+      }
+      munmap(old_shm, shm_size_);
+    }
+    shm_unlink(shm_name_.c_str());
+  }
+
+  fd = shm_open(shm_name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    AERROR << "create parameter cache failed: " << strerror(errno);
+    return false;
+  }
+  if (ftruncate(fd, shm_size_) < 0) {
+    AERROR << "ftruncate failed: " << strerror(errno);
+    close(fd);
+    shm_unlink(shm_name_.c_str());
+    return false;
+  }
+  managed_shm_ =
+      mmap(nullptr, shm_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (managed_shm_ == MAP_FAILED) {
+    AERROR << "attach parameter cache failed: " << strerror(errno);
+    managed_shm_ = nullptr;
+    shm_unlink(shm_name_.c_str());
+    return false;
+  }
+
+  // ftruncate zero fills, that is an empty table already
+  header_ = static_cast<Header*>(managed_shm_);
+  header_->slot_num = kSlotNum;
+  header_->owner_pid.store(static_cast<int32_t>(getpid()));
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = kMagic;
+  is_owner_ = true;
+  return true;
+}
+
+bool ParameterCache::Put(const Param& param) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_owner_) {
+    return false;
+  }
+
+  Slot* slot = nullptr;
+  uint64_t name_hash = NameHash(param.name());
+  auto search = slot_index_.find(param.name());
+  if (search != slot_index_.end()) {
+    slot = slots() + search->second;
+  }
+
+  std::string data;
+  bool fits = param.SerializeToString(&data) && data.size() <= kSlotDataSize;
+  if (slot == nullptr) {
+    if (!fits) {
+      // readers miss and fall back to the service
+      return false;
+    }
+    uint32_t index = static_cast<uint32_t>(name_hash % kSlotNum);
+    for (uint32_t i = 0; i < kSlotNum; ++i) {
+      uint32_t probe = (index + i) % kSlotNum;
+      if (slots()[probe].name_hash.load(std::memory_order_relaxed) == 0) {
+        slot = slots() + probe;
+        slot_index_[param.name()] = probe;
+        break;
+      }
+    }
+    if (slot == nullptr) {
+      AWARN << "parameter cache is full, " << param.name() << " not cached";
+      return false;
+    }
+  }
+
+  uint32_t version = header_->version.load(std::memory_order_relaxed) + 1;
+  if (version == 0) {
+    version = 1;
+  }
+  uint32_t seq = slot->seq.load(std::memory_order_relaxed);
+  slot->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  // a value that outgrew its slot is dropped, readers ask the service for it
+  uint32_t size = fits ? static_cast<uint32_t>(data.size()) : 0;
+  std::memcpy(slot->data, data.data(), size);
+  slot->size.store(size, std::memory_order_relaxed);
+  slot->version.store(version, std::memory_order_relaxed);
+  slot->seq.store(seq + 2, std::memory_order_release);
+  slot->name_hash.store(name_hash, std::memory_order_release);
+
+  header_->version.store(version, std::memory_order_release);
+  FutexWake(&header_->version);
+  return fits;
+}
+
+bool ParameterCache::Get(const std::string& name, Param* param) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!Attach()) {
+    return false;
+  }
+  uint32_t version = 0;
+  return ReadSlot(FindSlot(NameHash(name)), name, &version, param);
+}
+
+bool ParameterCache::WaitForChange(const std::string& name, uint32_t* version,
+                                   Param* param, int timeout_ms) {
+  uint64_t name_hash = NameHash(name);
+  uint64_t deadline_ns =
+      Time::MonoTime().ToNanosecond() + static_cast<uint64_t>(timeout_ms) *
+                                            1000000;
+  while (true) {
+    std::atomic<uint32_t>* futex = nullptr;
+    uint32_t current = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (Attach()) {
+        futex = &header_->version;
+        current = futex->load(std::memory_order_acquire);
+        uint32_t slot_version = *version;
+        Slot* slot = FindSlot(name_hash);
+        if (ReadSlot(slot, name, &slot_version, param) &&
+            slot_version != *version) {
+          *version = slot_version;
+          return true;
+        }
+      }
+    }
+
+    uint64_t now_ns = Time::MonoTime().ToNanosecond();
+    if (now_ns >= deadline_ns) {
+      return false;
+    }
+    uint64_t left_ns = deadline_ns - now_ns;
+    if (futex == nullptr) {
+      // no server yet, look again later
+      left_ns = std::min<uint64_t>(left_ns, 100000000);
+      struct timespec ts = {static_cast<time_t>(left_ns / 1000000000),
+                            static_cast<long>(left_ns % 1000000000)};  // NOLINT
+      nanosleep(&ts, nullptr);
+      continue;
+    }
+    struct timespec ts = {static_cast<time_t>(left_ns / 1000000000),
+                          static_cast<long>(left_ns % 1000000000)};  // NOLINT
+    FutexWait(futex, current, &ts);
+  }
+}
+
+bool ParameterCache::Attach() {
+  if (is_owner_) {
+    return true;
+  }
+  if (header_ != nullptr) {
+    if (header_->owner_pid.load() != 0) {
+      return true;
+    }
+    // the server is gone or replaced, map the table of the new one
+    Detach();
+  }
+
+  int fd = shm_open(shm_name_.c_str(), O_RDONLY, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_attr;
+  if (fstat(fd, &file_attr) < 0 ||
+      static_cast<size_t>(file_attr.st_size) < shm_size_) {
+    close(fd);
+    return false;
+  }
+  void* shm = mmap(nullptr, shm_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (shm == MAP_FAILED) {
+    return false;
+  }
+
+  auto header = static_cast<Header*>(shm);
+  if (header->magic != kMagic || header->slot_num != kSlotNum ||
+      header->owner_pid.load() == 0) {
+    munmap(shm, shm_size_);
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  managed_shm_ = shm;
+  header_ = header;
+  return true;
+}
+
+void ParameterCache::Detach() {
+  if (managed_shm_ != nullptr) {
+    munmap(managed_shm_, shm_size_);
+  }
+  managed_shm_ = nullptr;
+  header_ = nullptr;
+  is_owner_ = false;
+  slot_index_.clear();
+}
+
+ParameterCache::Slot* ParameterCache::FindSlot(uint64_t name_hash) const {
+  uint32_t index = static_cast<uint32_t>(name_hash % kSlotNum);
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    Slot* slot = slots() + (index + i) % kSlotNum;
+    uint64_t hash = slot->name_hash.load(std::memory_order_acquire);
+    if (hash == 0) {
+      return nullptr;
+    }
+    if (hash == name_hash) {
+      return slot;
+    }
+  }
+  return nullptr;
+}
+
+bool ParameterCache::ReadSlot(Slot* slot, const std::string& name,
+                              uint32_t* version, Param* param) const {
+  if (slot == nullptr) {
+    return false;
+  }
+
+  char buf[kSlotDataSize];
+  for (int i = 0; i < kMaxReadRetries; ++i) {
+    uint32_t seq = slot->seq.load(std::memory_order_acquire);
+    if (seq & 1) {
+      cpu_relax();
+      continue;
+    }
+    uint32_t size = slot->size.load(std::memory_order_relaxed);
+    uint32_t slot_version = slot->version.load(std::memory_order_relaxed);
+    if (size > kSlotDataSize) {
+      continue;
+    }
+    std::memcpy(buf, slot->data, size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->seq.load(std::memory_order_relaxed) != seq) {
+      continue;
+    }
+
+    // the hash may collide, the name in the value settles it
+    if (size == 0 || !param->ParseFromArray(buf, static_cast<int>(size)) ||
+        param->name() != name) {
+      return false;
+    }
+    *version = slot_version;
+    return true;
+  }
+  return false;
+}
+
+ParameterCache::Slot* ParameterCache::slots() const {
+  return reinterpret_cast<Slot*>(static_cast<char*>(managed_shm_) +
+                                 sizeof(Header));
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_PARAMETER_PARAMETER_CACHE_H_
+#define CYBER_PARAMETER_PARAMETER_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/proto/parameter.pb.h"
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class ParameterCache
+ * @brief A host local, read-mostly copy of the parameters of one
+ * ParameterServer, kept in shared memory. The server is the only writer,
+ * every slot is versioned with a seqlock so clients on the same host read
+ * without a service round trip and without taking any lock. Parameters that
+ * do not fit in a slot are not cached and must be fetched from the server.
+ */
+class ParameterCache {
+ public:
+  using Param = apollo::cyber::proto::Param;
+
+  /**
+   * @brief Construct a cache for the parameters served by node_name, no
+   * shared memory is touched until Create or the first read
+   */
+  explicit ParameterCache(const std::string& node_name);
+  virtual ~ParameterCache();
+
+  /**
+   * @brief Create the table as its owner, an old table of a previous server
+   * with the same node name is invalidated first
+   */
+  bool Create();
+
+  /**
+   * @brief Publish param to the readers, only valid on the owner
+   *
+   * @return false if the table is not created or full
+   */
+  bool Put(const Param& param);
+
+  /**
+   * @brief Read a parameter from the table of a running server
+   *
+   * @return false if there is no table, no such parameter or it is too big
+   * to be cached, the caller should ask the server then
+   */
+  bool Get(const std::string& name, Param* param);
+
+  /**
+   * @brief Block until the parameter is written with a version other than
+   * *version, or until timeout_ms passed. On success *version and param are
+   * updated, pass a version of 0 to get the current value right away.
+   */
+  bool WaitForChange(const std::string& name, uint32_t* version, Param* param,
+                     int timeout_ms);
+
+ private:
+  struct Header;
+  struct Slot;
+
+  bool Attach();
+  void Detach();
+  Slot* FindSlot(uint64_t name_hash) const;
+  bool ReadSlot(Slot* slot, const std::string& name, uint32_t* version,
+                Param* param) const;
+  Slot* slots() const;
+
+  std::string shm_name_;
+  size_t shm_size_;
+  bool is_owner_ = false;
+  std::mutex mutex_;
+  void* managed_shm_ = nullptr;
+  Header* header_ = nullptr;
+  std::unordered_map<std::string, uint32_t> slot_index_;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_PARAMETER_PARAMETER_CACHE_H_
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/parameter/parameter_cache.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+using apollo::cyber::proto::Param;
+using apollo::cyber::proto::ParamType;
+
+Param IntParam(const std::string& name, int64_t value) {
+  Param param;
+  param.set_name(name);
+  param.set_type(ParamType::INT);
+  param.set_int_value(value);
+  return param;
+}
+
+TEST(ParameterCacheTest, put_get) {
+  ParameterCache reader("parameter_cache_put_get");
+  Param param;
+  // no server yet
+  EXPECT_FALSE(reader.Get("int", &param));
+
+  ParameterCache owner("parameter_cache_put_get");
+  EXPECT_FALSE(owner.Put(IntParam("int", 1)));
+  ASSERT_TRUE(owner.Create());
+  EXPECT_FALSE(reader.Get("int", &param));
+
+  EXPECT_TRUE(owner.Put(IntParam("int", 1)));
+  ASSERT_TRUE(reader.Get("int", &param));
+  EXPECT_EQ(param.int_value(), 1);
+  EXPECT_TRUE(owner.Put(IntParam("int", 2)));
+  ASSERT_TRUE(reader.Get("int", &param));
+  EXPECT_EQ(param.int_value(), 2);
+  EXPECT_FALSE(reader.Get("other", &param));
+
+  // a value too big for a slot is dropped and read from the server instead
+  Param big;
+  big.set_name("int");
+  big.set_type(ParamType::STRING);
+  big.set_string_value(std::string(4096, 'x'));
+  EXPECT_FALSE(owner.Put(big));
+  EXPECT_FALSE(reader.Get("int", &param));
+  EXPECT_TRUE(owner.Put(IntParam("int", 3)));
+  ASSERT_TRUE(reader.Get("int", &param));
+  EXPECT_EQ(param.int_value(), 3);
+}
+
+TEST(ParameterCacheTest, owner_gone) {
+  ParameterCache reader("parameter_cache_owner_gone");
+  Param param;
+  {
+    ParameterCache owner("parameter_cache_owner_gone");
+    ASSERT_TRUE(owner.Create());
+    EXPECT_TRUE(owner.Put(IntParam("int", 1)));
+    EXPECT_TRUE(reader.Get("int", &param));
+  }
+  EXPECT_FALSE(reader.Get("int", &param));
+
+  // a new server replaces the table of the old one
+  ParameterCache first("parameter_cache_owner_gone");
+  ASSERT_TRUE(first.Create());
+  EXPECT_TRUE(first.Put(IntParam("int", 1)));
+  EXPECT_TRUE(reader.Get("int", &param));
+  ParameterCache second("parameter_cache_owner_gone");
+  ASSERT_TRUE(second.Create());
+  EXPECT_FALSE(reader.Get("int", &param));
+  EXPECT_TRUE(second.Put(IntParam("int", 2)));
+  ASSERT_TRUE(reader.Get("int", &param));
+  EXPECT_EQ(param.int_value(), 2);
+}
+
+TEST(ParameterCacheTest, wait_for_change) {
+  ParameterCache owner("parameter_cache_wait_for_change");
+  ASSERT_TRUE(owner.Create());
+  ParameterCache reader("parameter_cache_wait_for_change");
+
+  Param param;
+  uint32_t version = 0;
+  EXPECT_FALSE(reader.WaitForChange("int", &version, &param, 10));
+  EXPECT_TRUE(owner.Put(IntParam("int", 1)));
+  ASSERT_TRUE(reader.WaitForChange("int", &version, &param, 10));
+  EXPECT_EQ(param.int_value(), 1);
+  EXPECT_NE(version, 0);
+  // nothing new
+  EXPECT_FALSE(reader.WaitForChange("int", &version, &param, 10));
+
+  std::thread writer([&owner]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    owner.Put(IntParam("other", 0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    owner.Put(IntParam("int", 2));
+  });
+  ASSERT_TRUE(reader.WaitForChange("int", &version, &param, 1000));
+  EXPECT_EQ(param.int_value(), 2);
+  writer.join();
+}
+
+}  // namespace cyber
+}  // namespace apollo
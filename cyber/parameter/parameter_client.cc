@@ -24,7 +24,7 @@ namespace cyber {
 
 ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
                                  const std::string& service_node_name)
-    : node_(node) {
+    : node_(node), cache_(service_node_name) {
   get_parameter_client_ = node_->CreateClient<ParamName, Param>(
       FixParameterServiceName(service_node_name, GET_PARAMETER_SERVICE_NAME));
 
@@ -37,6 +37,12 @@ ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
 
 bool ParameterClient::GetParameter(const std::string& param_name,
                                    Parameter* parameter) {
+  Param param;
+  if (cache_.Get(param_name, &param)) {
+    parameter->FromProtoParam(param);
+    return true;
+  }
+
   auto request = std::make_shared<ParamName>();
   request->set_value(param_name);
   auto response = get_parameter_client_->SendRequest(request);
@@ -52,6 +58,17 @@ bool ParameterClient::GetParameter(const std::string& param_name,
   return true;
 }
 
+bool ParameterClient::WaitForParameter(const std::string& param_name,
+                                       Parameter* parameter, uint32_t* version,
+                                       int timeout_ms) {
+  Param param;
+  if (!cache_.WaitForChange(param_name, version, &param, timeout_ms)) {
+    return false;
+  }
+  parameter->FromProtoParam(param);
+  return true;
+}
+
 bool ParameterClient::SetParameter(const Parameter& parameter) {
   auto request = std::make_shared<Param>(parameter.ToProtoParam());
   auto response = set_parameter_client_->SendRequest(request);
@@ -24,6 +24,7 @@
 #include "cyber/proto/parameter.pb.h"
 
 #include "cyber/parameter/parameter.h"
+#include "cyber/parameter/parameter_cache.h"
 #include "cyber/service/client.h"
 
 namespace apollo {
@@ -56,7 +57,8 @@ class ParameterClient {
                   const std::string& service_node_name);
 
   /**
-   * @brief Get the Parameter object
+   * @brief Get the Parameter object, read from the shared memory cache when
+   * the server runs on this host and from the service otherwise
    *
    * @param param_name
    * @param parameter the pointer to store
@@ -65,6 +67,21 @@ class ParameterClient {
    */
   bool GetParameter(const std::string& param_name, Parameter* parameter);
 
+  /**
+   * @brief Wait for a parameter to be set, only works with a server on this
+   * host and a parameter that fits in the cache
+   *
+   * @param param_name
+   * @param parameter the pointer to store
+   * @param version version of the value the caller has, 0 for none. It is
+   * updated on success, pass it back in to wait for the next change
+   * @param timeout_ms
+   * @return true the parameter has a value of another version
+   * @return false timeout
+   */
+  bool WaitForParameter(const std::string& param_name, Parameter* parameter,
+                        uint32_t* version, int timeout_ms);
+
   /**
    * @brief Set the Parameter object
    *
@@ -90,6 +107,7 @@ class ParameterClient {
   std::shared_ptr<GetParameterClient> get_parameter_client_;
   std::shared_ptr<SetParameterClient> set_parameter_client_;
   std::shared_ptr<ListParametersClient> list_parameters_client_;
+  ParameterCache cache_;
 };
 
 }  // namespace cyber
@@ -23,8 +23,12 @@ namespace apollo {
 namespace cyber {
 
 ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
-    : node_(node) {
+    : node_(node), cache_(node->Name()) {
   auto name = node_->Name();
+  // clients on this host read from the cache, the services serve the rest
+  if (!cache_.Create()) {
+    AWARN << "no parameter cache for " << name << ", clients use services";
+  }
   get_parameter_service_ = node_->CreateService<ParamName, Param>(
       FixParameterServiceName(name, GET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<ParamName>& request,
@@ -43,6 +47,7 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
              std::shared_ptr<BoolResult>& response) {
         std::lock_guard<std::mutex> lock(param_map_mutex_);
         param_map_[request->name()] = *request;
+        cache_.Put(*request);
         response->set_value(true);
       });
 
@@ -60,7 +65,9 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
 
 void ParameterServer::SetParameter(const Parameter& parameter) {
   std::lock_guard<std::mutex> lock(param_map_mutex_);
-  param_map_[parameter.Name()] = parameter.ToProtoParam();
+  auto& param = param_map_[parameter.Name()];
+  param = parameter.ToProtoParam();
+  cache_.Put(param);
 }
 
 bool ParameterServer::GetParameter(const std::string& parameter_name,
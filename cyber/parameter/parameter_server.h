@@ -25,6 +25,7 @@
 #include "cyber/proto/parameter.pb.h"
 
 #include "cyber/parameter/parameter.h"
+#include "cyber/parameter/parameter_cache.h"
 #include "cyber/service/service.h"
 
 namespace apollo {
@@ -87,6 +88,7 @@ class ParameterServer {
 
   std::mutex param_map_mutex_;
   std::unordered_map<std::string, Param> param_map_;
+  ParameterCache cache_;
 };
 
 }  // namespace cyber
@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/file/chunk_codec.h"
+
+#include <cstring>
+#include <limits>
+
+#include "bzlib.h"
+#include "lz4.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::proto::CompressType;
+
+namespace {
+
+constexpr size_t kRawLengthSize = sizeof(uint64_t);
+constexpr int kBz2BlockSize100k = 9;
+
+}  // namespace
+
+bool ChunkCodec::IsSupported(CompressType type) {
+  switch (type) {
+    case CompressType::COMPRESS_NONE:
+    case CompressType::COMPRESS_LZ4:
+    case CompressType::COMPRESS_BZ2:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ChunkCodec::Compress(CompressType type, const std::string& raw,
+                          std::string* compressed) {
+  if (raw.size() > std::numeric_limits<unsigned int>::max()) {
+    AERROR << "Chunk too large to compress, size: " << raw.size();
+    return false;
+  }
+  uint64_t raw_length = raw.size();
+  size_t bound = 0;
+  switch (type) {
+    case CompressType::COMPRESS_LZ4:
+      if (raw.size() > LZ4_MAX_INPUT_SIZE) {
+        AERROR << "Chunk too large for lz4, size: " << raw.size();
+        return false;
+      }
+      bound = LZ4_compressBound(static_cast<int>(raw.size()));
+      break;
+    case CompressType::COMPRESS_BZ2:
+      // documented worst case of bzip2: 1% larger plus 600 bytes
+      bound = raw.size() + raw.size() / 100 + 600;
+      break;
+    default:
+      AERROR << "Unsupported compress type: " << type;
+      return false;
+  }
+
+  compressed->resize(kRawLengthSize + bound);
+  char* dst = &(*compressed)[0];
+  std::memcpy(dst, &raw_length, kRawLengthSize);
+  dst += kRawLengthSize;
+
+  size_t dst_size = 0;
+  if (type == CompressType::COMPRESS_LZ4) {
+    int ret = LZ4_compress_default(raw.data(), dst,
+                                   static_cast<int>(raw.size()),
+                                   static_cast<int>(bound));
+    if (ret <= 0) {
+      AERROR << "lz4 compress failed, ret: " << ret;
+      return false;
+    }
+    dst_size = static_cast<size_t>(ret);
+  } else {
+    unsigned int len = static_cast<unsigned int>(bound);
+    int ret = BZ2_bzBuffToBuffCompress(
+        dst, &len, const_cast<char*>(raw.data()),
+        static_cast<unsigned int>(raw.size()), kBz2BlockSize100k, 0, 0);
+    if (ret != BZ_OK) {
+      AERROR << "bz2 compress failed, ret: " << ret;
+      return false;
+    }
+    dst_size = len;
+  }
+  compressed->resize(kRawLengthSize + dst_size);
+  return true;
+}
+
+bool ChunkCodec::Decompress(CompressType type, const char* data, size_t size,
+                            std::string* raw) {
+  if (size < kRawLengthSize) {
+    AERROR << "Compressed chunk is truncated, size: " << size;
+    return false;
+  }
+  uint64_t raw_length = 0;
+  std::memcpy(&raw_length, data, kRawLengthSize);
+  data += kRawLengthSize;
+  size -= kRawLengthSize;
+  if (raw_length > std::numeric_limits<int>::max() ||
+      size > std::numeric_limits<int>::max()) {
+    AERROR << "Compressed chunk is broken, raw length: " << raw_length;
+    return false;
+  }
+
+  raw->resize(raw_length);
+  switch (type) {
+    case CompressType::COMPRESS_LZ4: {
+      int ret = LZ4_decompress_safe(data, &(*raw)[0], static_cast<int>(size),
+                                    static_cast<int>(raw_length));
+      if (ret < 0 || static_cast<uint64_t>(ret) != raw_length) {
+        AERROR << "lz4 decompress failed, ret: " << ret;
+        return false;
+      }
+      return true;
+    }
+    case CompressType::COMPRESS_BZ2: {
+      unsigned int len = static_cast<unsigned int>(raw_length);
+      int ret = BZ2_bzBuffToBuffDecompress(&(*raw)[0], &len,
+                                           const_cast<char*>(data),
+                                           static_cast<unsigned int>(size),
+                                           0, 0);
+      if (ret != BZ_OK || len != raw_length) {
+        AERROR << "bz2 decompress failed, ret: " << ret;
+        return false;
+      }
+      return true;
+    }
+    default:
+      AERROR << "Unsupported compress type: " << type;
+      return false;
+  }
+}
+
+bool ChunkCodec::ParseName(const std::string& name, CompressType* type) {
+  if (name == "none") {
+    *type = CompressType::COMPRESS_NONE;
+  } else if (name == "lz4") {
+    *type = CompressType::COMPRESS_LZ4;
+  } else if (name == "bz2") {
+    *type = CompressType::COMPRESS_BZ2;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_FILE_CHUNK_CODEC_H_
+#define CYBER_RECORD_FILE_CHUNK_CODEC_H_
+
+#include <string>
+
+#include "cyber/proto/record.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @brief Codec of the chunk body payload.
+ *
+ * A compressed chunk body section holds the uncompressed length as a
+ * uint64_t followed by the compressed bytes of the serialized ChunkBody.
+ * The codec in use is recorded once per file in Header.compress.
+ */
+class ChunkCodec {
+ public:
+  static bool IsSupported(proto::CompressType type);
+
+  static bool Compress(proto::CompressType type, const std::string& raw,
+                       std::string* compressed);
+
+  static bool Decompress(proto::CompressType type, const char* data,
+                         size_t size, std::string* raw);
+
+  static bool ParseName(const std::string& name, proto::CompressType* type);
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_FILE_CHUNK_CODEC_H_
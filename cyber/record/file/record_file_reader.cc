@@ -16,13 +16,25 @@
 
 #include "cyber/record/file/record_file_reader.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cstring>
+#include <string>
+
+#include "google/protobuf/wire_format_lite.h"
+
 #include "cyber/common/file.h"
 
 namespace apollo {
 namespace cyber {
 namespace record {
 
+using apollo::cyber::proto::ChunkBody;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::SectionType;
+using apollo::cyber::proto::SingleMessage;
+using google::protobuf::internal::WireFormatLite;
 
 bool RecordFileReader::Open(const std::string& path) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -42,10 +54,43 @@ bool RecordFileReader::Open(const std::string& path) {
     AERROR << "Read header section fail, file: " << path_;
     return false;
   }
+  MapFile();
   return true;
 }
 
-void RecordFileReader::Close() { close(fd_); }
+RecordFileReader::~RecordFileReader() { UnmapFile(); }
+
+void RecordFileReader::Close() {
+  UnmapFile();
+  close(fd_);
+}
+
+void RecordFileReader::MapFile() {
+  UnmapFile();
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) < 0 || file_stat.st_size <= 0) {
+    AWARN << "fstat failed, file: " << path_ << ", errno: " << errno;
+    return;
+  }
+  void* addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    AWARN << "mmap failed, file: " << path_ << ", errno: " << errno
+          << ", index driven reads fall back to seek and read.";
+    return;
+  }
+  // sections are visited in index order, read ahead would be wasted
+  madvise(addr, file_stat.st_size, MADV_RANDOM);
+  mapped_data_ = static_cast<const char*>(addr);
+  mapped_size_ = file_stat.st_size;
+}
+
+void RecordFileReader::UnmapFile() {
+  if (mapped_data_ != nullptr) {
+    munmap(const_cast<char*>(mapped_data_), mapped_size_);
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+  }
+}
 
 bool RecordFileReader::Reset() {
   if (!SetPosition(sizeof(struct Section) + HEADER_LENGTH)) {
@@ -74,6 +119,11 @@ bool RecordFileReader::ReadHeader() {
               "file.";
     return false;
   }
+  if (!ChunkCodec::IsSupported(header_.compress())) {
+    AERROR << "Unsupported compress type: " << header_.compress()
+           << ", the record file is written by a newer version.";
+    return false;
+  }
   if (!SetPosition(sizeof(struct Section) + HEADER_LENGTH)) {
     AERROR << "Skip bytes for reaching the nex section failed.";
     return false;
@@ -81,6 +131,151 @@ bool RecordFileReader::ReadHeader() {
   return true;
 }
 
+bool RecordFileReader::ReadMappedSection(int64_t position, SectionType type,
+                                         bool is_chunk_body,
+                                         google::protobuf::Message* message) {
+  if (position < 0 ||
+      static_cast<size_t>(position) + sizeof(Section) > mapped_size_) {
+    AERROR << "Section position out of file, position: " << position
+           << ", file size: " << mapped_size_;
+    return false;
+  }
+  Section section;
+  std::memcpy(&section, mapped_data_ + position, sizeof(section));
+  if (section.type != type) {
+    AERROR << "Check section type failed"
+           << ", expect: " << type << ", actual: " << section.type;
+    return false;
+  }
+  const char* data = mapped_data_ + position + sizeof(section);
+  if (section.size < 0 ||
+      static_cast<size_t>(section.size) >
+          mapped_size_ - position - sizeof(section) ||
+      section.size > std::numeric_limits<int>::max()) {
+    AERROR << "Section size out of file, size: " << section.size;
+    return false;
+  }
+  if (is_chunk_body && header_.compress() != CompressType::COMPRESS_NONE) {
+    std::string raw;
+    if (!ChunkCodec::Decompress(header_.compress(), data, section.size,
+                                &raw)) {
+      AERROR << "Decompress section failed.";
+      return false;
+    }
+    return message->ParseFromString(raw);
+  }
+  if (!message->ParseFromArray(data, static_cast<int>(section.size))) {
+    AERROR << "Parse section message failed.";
+    return false;
+  }
+  return true;
+}
+
+bool RecordFileReader::ReadRawSection(int64_t size, std::string* data) {
+  if (size < 0) {
+    AERROR << "Invalid section size: " << size;
+    return false;
+  }
+  data->resize(size);
+  int64_t offset = 0;
+  while (offset < size) {
+    ssize_t count = read(fd_, &(*data)[offset], size - offset);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "Read fd failed, fd_: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    if (count == 0) {
+      end_of_file_ = true;
+      AERROR << "Section is truncated, expect: " << size
+             << ", actual: " << offset;
+      return false;
+    }
+    offset += count;
+  }
+  return true;
+}
+
+bool RecordFileReader::DecodeChunkBody(const std::string& data,
+                                       std::string* serialized) const {
+  if (header_.compress() == CompressType::COMPRESS_NONE) {
+    *serialized = data;
+    return true;
+  }
+  if (!ChunkCodec::Decompress(header_.compress(), data.data(), data.size(),
+                              serialized)) {
+    AERROR << "Decompress section failed.";
+    return false;
+  }
+  return true;
+}
+
+bool RecordFileReader::CountChunkMessages(
+    const std::string& serialized,
+    std::unordered_map<std::string, uint64_t>* channel_message_number) {
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(serialized.data()),
+                         static_cast<int>(serialized.size()));
+  input.SetTotalBytesLimit(std::numeric_limits<int>::max(),
+                           std::numeric_limits<int>::max());
+  std::string channel_name;
+  while (uint32_t tag = input.ReadTag()) {
+    if (WireFormatLite::GetTagFieldNumber(tag) !=
+            ChunkBody::kMessagesFieldNumber ||
+        WireFormatLite::GetTagWireType(tag) !=
+            WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+    uint32_t length = 0;
+    if (!input.ReadVarint32(&length)) {
+      return false;
+    }
+    auto limit = input.PushLimit(static_cast<int>(length));
+    channel_name.clear();
+    while (uint32_t field = input.ReadTag()) {
+      if (WireFormatLite::GetTagFieldNumber(field) ==
+              SingleMessage::kChannelNameFieldNumber &&
+          WireFormatLite::GetTagWireType(field) ==
+              WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+        if (!WireFormatLite::ReadString(&input, &channel_name)) {
+          return false;
+        }
+      } else if (!WireFormatLite::SkipField(&input, field)) {
+        return false;
+      }
+    }
+    if (!input.ConsumedEntireMessage()) {
+      return false;
+    }
+    input.PopLimit(limit);
+    ++(*channel_message_number)[channel_name];
+  }
+  return input.ConsumedEntireMessage();
+}
+
+bool RecordFileReader::ReadCompressedSection(
+    int64_t size, google::protobuf::Message* message) {
+  std::string compressed;
+  if (!ReadRawSection(size, &compressed)) {
+    return false;
+  }
+  std::string raw;
+  if (!ChunkCodec::Decompress(header_.compress(), compressed.data(),
+                              compressed.size(), &raw)) {
+    AERROR << "Decompress section failed.";
+    return false;
+  }
+  if (!message->ParseFromString(raw)) {
+    AERROR << "Parse section message failed.";
+    return false;
+  }
+  return true;
+}
+
 bool RecordFileReader::ReadIndex() {
   if (!header_.is_complete()) {
     AERROR << "Record file is not complete.";
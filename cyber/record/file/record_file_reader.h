@@ -20,6 +20,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -30,6 +31,7 @@
 #include "google/protobuf/text_format.h"
 
 #include "cyber/common/log.h"
+#include "cyber/record/file/chunk_codec.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
 #include "cyber/time/time.h"
@@ -45,7 +47,7 @@ using google::protobuf::io::ZeroCopyInputStream;
 class RecordFileReader : public RecordFileBase {
  public:
   RecordFileReader() = default;
-  virtual ~RecordFileReader() = default;
+  virtual ~RecordFileReader();
   bool Open(const std::string& path) override;
   void Close() override;
   bool Reset();
@@ -54,11 +56,44 @@ class RecordFileReader : public RecordFileBase {
   template <typename T>
   bool ReadSection(int64_t size, T* message);
   bool ReadIndex();
+  /**
+   * @brief Read the bytes of the section as they are stored, a chunk body
+   * stays encoded with the compress type of the file header.
+   */
+  bool ReadRawSection(int64_t size, std::string* data);
+  /**
+   * @brief Decode a chunk body read by ReadRawSection into the serialized
+   * ChunkBody.
+   */
+  bool DecodeChunkBody(const std::string& data, std::string* serialized) const;
+  /**
+   * @brief Count the messages per channel of a serialized ChunkBody by
+   * walking its wire format, the message contents are skipped, not copied.
+   */
+  static bool CountChunkMessages(
+      const std::string& serialized,
+      std::unordered_map<std::string, uint64_t>* channel_message_number);
   bool EndOfFile() { return end_of_file_; }
 
+  /**
+   * @brief Read the section at an absolute position, usually one taken from
+   * the index. It is served from the file mapping and leaves the sequential
+   * position untouched, falling back to seek and read if mapping failed.
+   */
+  template <typename T>
+  bool ReadSectionAt(int64_t position, proto::SectionType type, T* message);
+
  private:
   bool ReadHeader();
+  bool ReadCompressedSection(int64_t size, google::protobuf::Message* message);
+  bool ReadMappedSection(int64_t position, proto::SectionType type,
+                         bool is_chunk_body,
+                         google::protobuf::Message* message);
+  void MapFile();
+  void UnmapFile();
   bool end_of_file_ = false;
+  const char* mapped_data_ = nullptr;
+  size_t mapped_size_ = 0;
 };
 
 template <typename T>
@@ -68,6 +103,10 @@ bool RecordFileReader::ReadSection(int64_t size, T* message) {
     AERROR << "Size value greater than the range of int value.";
     return false;
   }
+  if (std::is_same<T, proto::ChunkBody>::value &&
+      header_.compress() != proto::CompressType::COMPRESS_NONE) {
+    return ReadCompressedSection(size, message);
+  }
   FileInputStream raw_input(fd_, static_cast<int>(size));
   CodedInputStream coded_input(&raw_input);
   CodedInputStream::Limit limit = coded_input.PushLimit(static_cast<int>(size));
@@ -89,6 +128,27 @@ bool RecordFileReader::ReadSection(int64_t size, T* message) {
   return true;
 }
 
+template <typename T>
+bool RecordFileReader::ReadSectionAt(int64_t position, proto::SectionType type,
+                                     T* message) {
+  if (mapped_data_ != nullptr) {
+    return ReadMappedSection(position, type,
+                             std::is_same<T, proto::ChunkBody>::value,
+                             message);
+  }
+  Section section;
+  if (!SetPosition(position) || !ReadSection(&section)) {
+    AERROR << "Read section at position " << position << " failed.";
+    return false;
+  }
+  if (section.type != type) {
+    AERROR << "Check section type failed"
+           << ", expect: " << type << ", actual: " << section.type;
+    return false;
+  }
+  return ReadSection<T>(section.size, message);
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
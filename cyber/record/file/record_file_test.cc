@@ -17,6 +17,7 @@
 #include <unistd.h>
 #include <atomic>
 #include <string>
+#include <unordered_map>
 #include "gtest/gtest.h"
 
 #include "cyber/record/file/record_file_base.h"
@@ -31,6 +32,7 @@ namespace record {
 using apollo::cyber::proto::Channel;
 using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkHeader;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::Header;
 using apollo::cyber::proto::SectionType;
 using apollo::cyber::proto::SingleMessage;
@@ -306,6 +308,161 @@ TEST(RecordFileTest, TestIndex) {
   }
 }
 
+TEST(RecordFileTest, TestCompressedChunks) {
+  const std::string content(4096, 'x');
+  for (auto type : {CompressType::COMPRESS_LZ4, CompressType::COMPRESS_BZ2}) {
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 1);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    header.set_compress(type);
+    ASSERT_TRUE(rfw.WriteHeader(header));
+
+    Channel chan1;
+    chan1.set_name(kChan1);
+    chan1.set_message_type(kMsgType);
+    chan1.set_proto_desc(kStr10B);
+    ASSERT_TRUE(rfw.WriteChannel(chan1));
+
+    const int msg_num = 16;
+    uint64_t time_sum = 0;
+    for (int i = 1; i <= msg_num; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(chan1.name());
+      msg.set_content(content);
+      msg.set_time(i);
+      time_sum += i;
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+    ASSERT_EQ(msg_num, rfw.GetHeader().message_number());
+
+    RecordFileReader rfr;
+    ASSERT_TRUE(rfr.Open(kTestFile1));
+    ASSERT_EQ(type, rfr.GetHeader().compress());
+    ASSERT_TRUE(rfr.ReadIndex());
+    ASSERT_LT(rfr.GetHeader().size(), msg_num * content.size());
+
+    Section sec;
+    int read_num = 0;
+    uint64_t read_time_sum = 0;
+    while (rfr.ReadSection(&sec)) {
+      if (sec.type == SectionType::SECTION_INDEX) {
+        break;
+      }
+      if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(rfr.SkipSection(sec.size));
+        continue;
+      }
+      ChunkBody body;
+      ASSERT_TRUE(rfr.ReadSection<ChunkBody>(sec.size, &body));
+      for (const auto& msg : body.messages()) {
+        ASSERT_EQ(content, msg.content());
+        read_time_sum += msg.time();
+        ++read_num;
+      }
+    }
+    EXPECT_EQ(msg_num, read_num);
+    EXPECT_EQ(time_sum, read_time_sum);
+    rfr.Close();
+    ASSERT_FALSE(remove(kTestFile1));
+  }
+}
+
+TEST(RecordFileTest, TestEncodedChunks) {
+  const std::string content(1024, 'x');
+  for (auto type : {CompressType::COMPRESS_NONE, CompressType::COMPRESS_LZ4}) {
+    Header header = HeaderBuilder::GetHeaderWithChunkParams(0, 1);
+    header.set_segment_interval(0);
+    header.set_segment_raw_size(0);
+    header.set_compress(type);
+
+    RecordFileWriter rfw;
+    ASSERT_TRUE(rfw.Open(kTestFile1));
+    ASSERT_TRUE(rfw.WriteHeader(header));
+    const int msg_num = 8;
+    for (int i = 1; i <= msg_num; ++i) {
+      SingleMessage msg;
+      msg.set_channel_name(kChan1);
+      msg.set_content(content);
+      msg.set_time(i);
+      ASSERT_TRUE(rfw.WriteMessage(msg));
+    }
+    rfw.Close();
+
+    // copy the chunks of the first file between two messages of the second
+    RecordFileWriter copy;
+    ASSERT_TRUE(copy.Open(kTestFile2));
+    ASSERT_TRUE(copy.WriteHeader(header));
+    SingleMessage first;
+    first.set_channel_name(kChan2);
+    first.set_content(content);
+    first.set_time(0);
+    ASSERT_TRUE(copy.WriteMessage(first));
+
+    RecordFileReader rfr;
+    ASSERT_TRUE(rfr.Open(kTestFile1));
+    Section sec;
+    ChunkHeader chunk_header;
+    while (rfr.ReadSection(&sec)) {
+      if (sec.type == SectionType::SECTION_INDEX) {
+        break;
+      }
+      if (sec.type == SectionType::SECTION_CHUNK_HEADER) {
+        ASSERT_TRUE(rfr.ReadSection<ChunkHeader>(sec.size, &chunk_header));
+        continue;
+      }
+      if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(rfr.SkipSection(sec.size));
+        continue;
+      }
+      std::string data;
+      std::string serialized;
+      ASSERT_TRUE(rfr.ReadRawSection(sec.size, &data));
+      ASSERT_TRUE(rfr.DecodeChunkBody(data, &serialized));
+      std::unordered_map<std::string, uint64_t> counts;
+      ASSERT_TRUE(RecordFileReader::CountChunkMessages(serialized, &counts));
+      ASSERT_EQ(1, counts.size());
+      ASSERT_EQ(chunk_header.message_number(), counts[kChan1]);
+      ASSERT_TRUE(copy.WriteEncodedChunk(chunk_header, data, counts));
+    }
+    rfr.Close();
+
+    SingleMessage last = first;
+    last.set_time(msg_num + 1);
+    ASSERT_TRUE(copy.WriteMessage(last));
+    copy.Close();
+    EXPECT_EQ(msg_num, copy.GetMessageNumber(kChan1));
+    EXPECT_EQ(2, copy.GetMessageNumber(kChan2));
+    EXPECT_EQ(msg_num + 2, copy.GetHeader().message_number());
+
+    ASSERT_TRUE(rfr.Open(kTestFile2));
+    ASSERT_TRUE(rfr.ReadIndex());
+    rfr.Reset();
+    uint64_t expect_time = 0;
+    while (rfr.ReadSection(&sec)) {
+      if (sec.type == SectionType::SECTION_INDEX) {
+        break;
+      }
+      if (sec.type != SectionType::SECTION_CHUNK_BODY) {
+        ASSERT_TRUE(rfr.SkipSection(sec.size));
+        continue;
+      }
+      ChunkBody body;
+      ASSERT_TRUE(rfr.ReadSection<ChunkBody>(sec.size, &body));
+      for (const auto& msg : body.messages()) {
+        ASSERT_EQ(content, msg.content());
+        EXPECT_EQ(expect_time++, msg.time());
+      }
+    }
+    EXPECT_EQ(msg_num + 2, expect_time);
+    rfr.Close();
+    ASSERT_FALSE(remove(kTestFile1));
+    ASSERT_FALSE(remove(kTestFile2));
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -18,6 +18,7 @@
 
 #include <fcntl.h>
 
+#include "cyber/common/environment.h"
 #include "cyber/common/file.h"
 #include "cyber/time/time.h"
 
@@ -31,6 +32,7 @@ using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkBodyCache;
 using apollo::cyber::proto::ChunkHeader;
 using apollo::cyber::proto::ChunkHeaderCache;
+using apollo::cyber::proto::CompressType;
 using apollo::cyber::proto::Header;
 using apollo::cyber::proto::SectionType;
 using apollo::cyber::proto::SingleIndex;
@@ -69,7 +71,7 @@ void RecordFileWriter::Close() {
     while (1) {
       {
         std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-        if (chunk_flush_->empty()) {
+        if (chunk_flush_->empty() && encoded_chunks_.empty()) {
           break;
         }
       }
@@ -87,7 +89,7 @@ void RecordFileWriter::Close() {
     while (1) {
       {
         std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-        if (chunk_flush_->empty()) {
+        if (chunk_flush_->empty() && encoded_chunks_.empty()) {
           break;
         }
       }
@@ -119,7 +121,18 @@ void RecordFileWriter::Close() {
 
 bool RecordFileWriter::WriteHeader(const Header& header) {
   std::lock_guard<std::mutex> lock(mutex_);
+  if (!ChunkCodec::IsSupported(header.compress())) {
+    AERROR << "Unsupported compress type: " << header.compress();
+    return false;
+  }
   header_ = header;
+  if (header_.compress() != CompressType::COMPRESS_NONE &&
+      compress_pool_ == nullptr) {
+    int thread_num =
+        std::stoi(common::GetEnv("CYBER_RECORD_COMPRESS_THREADS", "2"));
+    compress_thread_num_ = thread_num > 0 ? thread_num : 1;
+    compress_pool_.reset(new base::ThreadPool(compress_thread_num_));
+  }
   if (!WriteSection<Header>(header_)) {
     AERROR << "Write header section fail";
     return false;
@@ -171,6 +184,34 @@ bool RecordFileWriter::WriteChannel(const Channel& channel) {
 bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
                                   const ChunkBody& chunk_body) {
   std::lock_guard<std::mutex> lock(mutex_);
+  if (!WriteChunkHeader(chunk_header)) {
+    return false;
+  }
+  uint64_t pos = CurrentPosition();
+  if (!WriteSection<ChunkBody>(chunk_body)) {
+    AERROR << "Write chunk body fail";
+    return false;
+  }
+  IndexChunkBody(chunk_header, pos);
+  return true;
+}
+
+bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
+                                  const std::string& compressed_body) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!WriteChunkHeader(chunk_header)) {
+    return false;
+  }
+  uint64_t pos = CurrentPosition();
+  if (!WriteCompressedSection(compressed_body)) {
+    AERROR << "Write chunk body fail";
+    return false;
+  }
+  IndexChunkBody(chunk_header, pos);
+  return true;
+}
+
+bool RecordFileWriter::WriteChunkHeader(const ChunkHeader& chunk_header) {
   uint64_t pos = CurrentPosition();
   if (!WriteSection<ChunkHeader>(chunk_header)) {
     AERROR << "Write chunk header fail";
@@ -185,12 +226,11 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   chunk_header_cache->set_message_number(chunk_header.message_number());
   chunk_header_cache->set_raw_size(chunk_header.raw_size());
   single_index->set_allocated_chunk_header_cache(chunk_header_cache);
+  return true;
+}
 
-  pos = CurrentPosition();
-  if (!WriteSection<ChunkBody>(chunk_body)) {
-    AERROR << "Write chunk body fail";
-    return false;
-  }
+void RecordFileWriter::IndexChunkBody(const ChunkHeader& chunk_header,
+                                      uint64_t pos) {
   header_.set_chunk_number(header_.chunk_number() + 1);
   if (header_.begin_time() == 0) {
     header_.set_begin_time(chunk_header.begin_time());
@@ -198,12 +238,38 @@ bool RecordFileWriter::WriteChunk(const ChunkHeader& chunk_header,
   header_.set_end_time(chunk_header.end_time());
   header_.set_message_number(header_.message_number() +
                              chunk_header.message_number());
-  single_index = index_.add_indexes();
+  SingleIndex* single_index = index_.add_indexes();
   single_index->set_type(SectionType::SECTION_CHUNK_BODY);
   single_index->set_position(pos);
   ChunkBodyCache* chunk_body_cache = new ChunkBodyCache();
-  chunk_body_cache->set_message_number(chunk_body.messages_size());
+  chunk_body_cache->set_message_number(chunk_header.message_number());
   single_index->set_allocated_chunk_body_cache(chunk_body_cache);
+}
+
+bool RecordFileWriter::WriteCompressedSection(const std::string& body) {
+  Section section;
+  /// zero out whole struct even if padded
+  memset(&section, 0, sizeof(section));
+  section = {SectionType::SECTION_CHUNK_BODY,
+             static_cast<int64_t>(body.size())};
+  ssize_t count = write(fd_, &section, sizeof(section));
+  if (count != sizeof(section)) {
+    AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+    return false;
+  }
+  size_t written = 0;
+  while (written < body.size()) {
+    count = write(fd_, body.data() + written, body.size() - written);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      AERROR << "Write fd failed, fd: " << fd_ << ", errno: " << errno;
+      return false;
+    }
+    written += count;
+  }
+  header_.set_size(CurrentPosition());
   return true;
 }
 
@@ -231,28 +297,144 @@ bool RecordFileWriter::WriteMessage(const proto::SingleMessage& message) {
   }
   {
     std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+    // the previous chunk is not taken by the flush thread yet, swapping now
+    // would put it behind this one, keep filling until the next message
+    if (!chunk_flush_->empty()) {
+      return true;
+    }
     chunk_flush_.swap(chunk_active_);
     flush_cv_.notify_one();
   }
   return true;
 }
 
+bool RecordFileWriter::WriteEncodedChunk(
+    const ChunkHeader& chunk_header, const std::string& body,
+    const std::unordered_map<std::string, uint64_t>& channel_message_number) {
+  if (!is_writing_) {
+    AERROR << "File is not open for writing: " << path_;
+    return false;
+  }
+  // keep a few chunks queued at most, a copy runs much faster than the disk
+  const size_t max_queued = compress_thread_num_ + 2;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> flush_lock(flush_mutex_);
+      if (chunk_flush_->empty()) {
+        if (chunk_active_->empty() && encoded_chunks_.size() < max_queued) {
+          EncodedChunk encoded;
+          encoded.header = chunk_header;
+          encoded.body = body;
+          encoded_chunks_.emplace_back(std::move(encoded));
+          flush_cv_.notify_one();
+          break;
+        }
+        if (!chunk_active_->empty()) {
+          chunk_flush_.swap(chunk_active_);
+          flush_cv_.notify_one();
+        }
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  for (const auto& item : channel_message_number) {
+    channel_message_number_map_[item.first] += item.second;
+  }
+  return true;
+}
+
+void RecordFileWriter::CompressChunk(Chunk* chunk) {
+  std::shared_ptr<ChunkBody> body(chunk->body_.release());
+  CompressType type = header_.compress();
+  CompressedChunk compressed;
+  compressed.header = chunk->header_;
+  compressed.body = compress_pool_->Enqueue([type, body]() -> std::string {
+    std::string raw;
+    std::string out;
+    if (!body->SerializeToString(&raw) ||
+        !ChunkCodec::Compress(type, raw, &out)) {
+      return std::string();
+    }
+    return out;
+  });
+  compressed_chunks_.emplace_back(std::move(compressed));
+  chunk->clear();
+}
+
+void RecordFileWriter::WriteCompressedChunks(bool wait_all) {
+  while (!compressed_chunks_.empty()) {
+    auto& front = compressed_chunks_.front();
+    // bound the chunks in flight to the workers so memory stays flat when
+    // the disk or the codec cannot keep up
+    bool must_wait =
+        wait_all || compressed_chunks_.size() > compress_thread_num_;
+    if (front.body.valid() && !must_wait &&
+        front.body.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready) {
+      break;
+    }
+    std::string body = front.body.valid() ? front.body.get() : "";
+    if (body.empty()) {
+      AERROR << "Compress chunk fail.";
+    } else if (!WriteChunk(front.header, body)) {
+      AERROR << "Write chunk fail.";
+    }
+    compressed_chunks_.pop_front();
+  }
+}
+
+void RecordFileWriter::WriteEncodedChunks() {
+  while (!encoded_chunks_.empty()) {
+    auto& front = encoded_chunks_.front();
+    if (compress_pool_ == nullptr) {
+      if (!WriteChunk(front.header, front.body)) {
+        AERROR << "Write chunk fail.";
+      }
+    } else {
+      // queue behind the chunks still being compressed to keep the order
+      std::promise<std::string> body;
+      body.set_value(std::move(front.body));
+      CompressedChunk compressed;
+      compressed.header = front.header;
+      compressed.body = body.get_future();
+      compressed_chunks_.emplace_back(std::move(compressed));
+    }
+    encoded_chunks_.pop_front();
+  }
+}
+
 void RecordFileWriter::Flush() {
   while (is_writing_) {
     std::unique_lock<std::mutex> flush_lock(flush_mutex_);
-    flush_cv_.wait(flush_lock,
-                   [this] { return !chunk_flush_->empty() || !is_writing_; });
+    flush_cv_.wait(flush_lock, [this] {
+      return !chunk_flush_->empty() || !encoded_chunks_.empty() ||
+             !is_writing_;
+    });
     if (!is_writing_) {
       break;
     }
-    if (chunk_flush_->empty()) {
+    // encoded chunks are only queued once the buffered messages before them
+    // are handed over, so they go first
+    WriteEncodedChunks();
+    if (compress_pool_ == nullptr) {
+      if (!chunk_flush_->empty()) {
+        if (!WriteChunk(chunk_flush_->header_,
+                        *(chunk_flush_->body_.get()))) {
+          AERROR << "Write chunk fail.";
+        }
+        chunk_flush_->clear();
+      }
       continue;
     }
-    if (!WriteChunk(chunk_flush_->header_, *(chunk_flush_->body_.get()))) {
-      AERROR << "Write chunk fail.";
+    // hand the chunk over to the compress workers and release the flush
+    // buffer at once, chunks are written back in order as they complete
+    if (!chunk_flush_->empty()) {
+      CompressChunk(chunk_flush_.get());
     }
-    chunk_flush_->clear();
+    flush_lock.unlock();
+    WriteCompressedChunks(false);
   }
+  WriteCompressedChunks(true);
 }
 
 uint64_t RecordFileWriter::GetMessageNumber(
@@ -18,7 +18,9 @@
 #define CYBER_RECORD_FILE_RECORD_FILE_WRITER_H_
 
 #include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
@@ -30,7 +32,9 @@
 #include "google/protobuf/message.h"
 #include "google/protobuf/text_format.h"
 
+#include "cyber/base/thread_pool.h"
 #include "cyber/common/log.h"
+#include "cyber/record/file/chunk_codec.h"
 #include "cyber/record/file/record_file_base.h"
 #include "cyber/record/file/section.h"
 #include "cyber/time/time.h"
@@ -83,14 +87,40 @@ class RecordFileWriter : public RecordFileBase {
   bool WriteHeader(const proto::Header& header);
   bool WriteChannel(const proto::Channel& channel);
   bool WriteMessage(const proto::SingleMessage& message);
+  /**
+   * @brief Write a chunk that is already encoded with the compress type of
+   * this file, e.g. copied as is from another record. Messages buffered by
+   * WriteMessage are flushed first so the file stays in time order.
+   */
+  bool WriteEncodedChunk(
+      const proto::ChunkHeader& chunk_header, const std::string& body,
+      const std::unordered_map<std::string, uint64_t>& channel_message_number);
   uint64_t GetMessageNumber(const std::string& channel_name) const;
 
  private:
+  struct CompressedChunk {
+    proto::ChunkHeader header;
+    std::future<std::string> body;
+  };
+
+  struct EncodedChunk {
+    proto::ChunkHeader header;
+    std::string body;
+  };
+
   bool WriteChunk(const proto::ChunkHeader& chunk_header,
                   const proto::ChunkBody& chunk_body);
+  bool WriteChunk(const proto::ChunkHeader& chunk_header,
+                  const std::string& compressed_body);
+  bool WriteChunkHeader(const proto::ChunkHeader& chunk_header);
+  void IndexChunkBody(const proto::ChunkHeader& chunk_header, uint64_t pos);
   template <typename T>
   bool WriteSection(const T& message);
+  bool WriteCompressedSection(const std::string& body);
   bool WriteIndex();
+  void CompressChunk(Chunk* chunk);
+  void WriteCompressedChunks(bool wait_all);
+  void WriteEncodedChunks();
   void Flush();
   std::atomic_bool is_writing_;
   std::unique_ptr<Chunk> chunk_active_ = nullptr;
@@ -99,6 +129,10 @@ class RecordFileWriter : public RecordFileBase {
   std::mutex flush_mutex_;
   std::condition_variable flush_cv_;
   std::unordered_map<std::string, uint64_t> channel_message_number_map_;
+  std::unique_ptr<base::ThreadPool> compress_pool_ = nullptr;
+  std::deque<CompressedChunk> compressed_chunks_;
+  std::deque<EncodedChunk> encoded_chunks_;
+  size_t compress_thread_num_ = 0;
 };
 
 template <typename T>
@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/parallel_record_viewer.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+ParallelRecordViewer::ParallelRecordViewer(
+    const std::vector<std::string>& files, uint64_t begin_time,
+    uint64_t end_time, const std::set<std::string>& channels,
+    size_t thread_num)
+    : channels_(channels) {
+  if (thread_num == 0) {
+    thread_num = std::max(1U, std::thread::hardware_concurrency());
+  }
+  pool_.reset(new base::ThreadPool(std::min(thread_num, files.size() + 1)));
+
+  // opening reads the whole index, so do that in parallel as well
+  std::vector<std::future<std::shared_ptr<RecordReader>>> opened;
+  for (const auto& file : files) {
+    opened.emplace_back(pool_->Enqueue(
+        [file]() { return std::make_shared<RecordReader>(file); }));
+  }
+
+  uint64_t min_begin_time = std::numeric_limits<uint64_t>::max();
+  uint64_t max_end_time = 0;
+  for (size_t i = 0; i < opened.size(); ++i) {
+    auto reader = opened[i].get();
+    if (!reader->IsValid()) {
+      AERROR << "Skip invalid record file: " << files[i];
+      continue;
+    }
+    min_begin_time = std::min(min_begin_time, reader->GetHeader().begin_time());
+    max_end_time = std::max(max_end_time, reader->GetHeader().end_time());
+    for (const auto& channel : reader->GetChannelList()) {
+      if (channels_.empty() || channels_.count(channel) == 1) {
+        channel_list_.insert(channel);
+      }
+    }
+    std::unique_ptr<Source> source(new Source());
+    source->reader = reader;
+    sources_.emplace_back(std::move(source));
+  }
+
+  begin_time_ = std::max(begin_time, min_begin_time);
+  end_time_ = std::min(end_time, max_end_time);
+  for (auto& source : sources_) {
+    source->viewer.reset(
+        new RecordViewer(source->reader, begin_time_, end_time_, channels_));
+  }
+}
+
+ParallelRecordViewer::~ParallelRecordViewer() {
+  Stop();
+  pool_.reset();
+}
+
+bool ParallelRecordViewer::IsValid() const {
+  if (sources_.empty()) {
+    AERROR << "No readable record file.";
+    return false;
+  }
+  if (begin_time_ > end_time_) {
+    AERROR << "Begin time must be earlier than end time"
+           << ", begin_time=" << begin_time_ << ", end_time=" << end_time_;
+    return false;
+  }
+  return true;
+}
+
+bool ParallelRecordViewer::ReadMessage(RecordMessage* message) {
+  if (!started_) {
+    Start();
+  }
+  if (heap_.empty()) {
+    return false;
+  }
+  size_t index = heap_.top().second;
+  heap_.pop();
+  auto& source = sources_[index];
+  *message = std::move(source->batch[source->batch_index++]);
+  if (Advance(source.get())) {
+    heap_.emplace(source->batch[source->batch_index].time, index);
+  }
+  return true;
+}
+
+void ParallelRecordViewer::Reset() {
+  Stop();
+  for (auto& source : sources_) {
+    source->started = false;
+    source->exhausted = false;
+    source->batch.clear();
+    source->batch_index = 0;
+  }
+}
+
+void ParallelRecordViewer::Start() {
+  started_ = true;
+  if (!IsValid()) {
+    return;
+  }
+  // kick off every file before waiting on any of them
+  for (auto& source : sources_) {
+    Prefetch(source.get());
+  }
+  for (size_t i = 0; i < sources_.size(); ++i) {
+    auto& source = sources_[i];
+    if (Advance(source.get())) {
+      heap_.emplace(source->batch[source->batch_index].time, i);
+    }
+  }
+}
+
+void ParallelRecordViewer::Stop() {
+  for (auto& source : sources_) {
+    if (source->prefetch.valid()) {
+      source->prefetch.wait();
+      source->prefetch = std::future<Batch>();
+    }
+  }
+  heap_ = decltype(heap_)();
+  started_ = false;
+}
+
+void ParallelRecordViewer::Prefetch(Source* source) {
+  source->prefetch = pool_->Enqueue(&ParallelRecordViewer::Decode, source);
+}
+
+bool ParallelRecordViewer::Advance(Source* source) {
+  if (source->batch_index < source->batch.size()) {
+    return true;
+  }
+  if (source->exhausted || !source->prefetch.valid()) {
+    return false;
+  }
+  source->batch = source->prefetch.get();
+  source->batch_index = 0;
+  if (source->batch.size() < kBatchSize) {
+    source->exhausted = true;
+  } else {
+    Prefetch(source);
+  }
+  return !source->batch.empty();
+}
+
+ParallelRecordViewer::Batch ParallelRecordViewer::Decode(Source* source) {
+  Batch batch;
+  batch.reserve(kBatchSize);
+  if (!source->started) {
+    source->started = true;
+    source->iter = source->viewer->begin();
+  } else {
+    ++source->iter;
+  }
+  auto end = source->viewer->end();
+  while (source->iter != end) {
+    batch.emplace_back(*source->iter);
+    if (batch.size() == kBatchSize) {
+      break;
+    }
+    ++source->iter;
+  }
+  return batch;
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_RECORD_PARALLEL_RECORD_VIEWER_H_
+#define CYBER_RECORD_PARALLEL_RECORD_VIEWER_H_
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cyber/base/thread_pool.h"
+#include "cyber/record/record_message.h"
+#include "cyber/record/record_reader.h"
+#include "cyber/record/record_viewer.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+/**
+ * @brief View messages of many record files in timestamp order.
+ *
+ * Every file is decoded by its own RecordViewer on a shared thread pool, one
+ * batch ahead of the consumer, and the per file streams are merged on the
+ * calling thread. Memory stays bounded by two batches per file.
+ */
+class ParallelRecordViewer {
+ public:
+  /**
+   * @brief The constructor with record files.
+   *
+   * @param files
+   * @param begin_time
+   * @param end_time
+   * @param channels only view these channels, all channels if empty
+   * @param thread_num decode threads, hardware concurrency if zero
+   */
+  explicit ParallelRecordViewer(
+      const std::vector<std::string>& files, uint64_t begin_time = 0,
+      uint64_t end_time = std::numeric_limits<uint64_t>::max(),
+      const std::set<std::string>& channels = {}, size_t thread_num = 0);
+
+  virtual ~ParallelRecordViewer();
+
+  /**
+   * @brief Is this viewer valid.
+   *
+   * @return True if at least one file is readable and the time range is
+   * valid.
+   */
+  bool IsValid() const;
+
+  uint64_t begin_time() const { return begin_time_; }
+
+  uint64_t end_time() const { return end_time_; }
+
+  /**
+   * @brief Get channel list.
+   *
+   * @return Channels of all readable files, limited to the requested ones.
+   */
+  std::set<std::string> GetChannelList() const { return channel_list_; }
+
+  /**
+   * @brief Read the next message in timestamp order.
+   *
+   * @param message
+   *
+   * @return False once every file is exhausted.
+   */
+  bool ReadMessage(RecordMessage* message);
+
+  /**
+   * @brief Rewind all files to the begin time.
+   */
+  void Reset();
+
+ private:
+  using Batch = std::vector<RecordMessage>;
+
+  struct Source {
+    std::shared_ptr<RecordReader> reader;
+    std::unique_ptr<RecordViewer> viewer;
+    RecordViewer::Iterator iter;
+    bool started = false;
+    bool exhausted = false;
+    Batch batch;
+    size_t batch_index = 0;
+    std::future<Batch> prefetch;
+  };
+
+  using HeapItem = std::pair<uint64_t, size_t>;
+
+  void Start();
+  void Stop();
+  void Prefetch(Source* source);
+  bool Advance(Source* source);
+  static Batch Decode(Source* source);
+
+  uint64_t begin_time_ = 0;
+  uint64_t end_time_ = std::numeric_limits<uint64_t>::max();
+  std::set<std::string> channels_;
+  std::set<std::string> channel_list_;
+  std::vector<std::unique_ptr<Source>> sources_;
+  std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>>
+      heap_;
+  bool started_ = false;
+  // declared last so that workers are joined before the sources go away
+  std::unique_ptr<base::ThreadPool> pool_;
+
+  static constexpr size_t kBatchSize = 256;
+};
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_RECORD_PARALLEL_RECORD_VIEWER_H_
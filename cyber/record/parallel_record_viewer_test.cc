@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/record/parallel_record_viewer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/record/record_writer.h"
+
+namespace apollo {
+namespace cyber {
+namespace record {
+
+using apollo::cyber::message::RawMessage;
+
+constexpr char kChannelName1[] = "/test/channel1";
+constexpr char kChannelName2[] = "/test/channel2";
+constexpr char kMessageType1[] = "apollo.cyber.proto.Test";
+constexpr char kProtoDesc1[] = "1234567890";
+constexpr uint64_t kFileNum = 3;
+constexpr uint64_t kMessageNum = 1000;
+constexpr uint64_t kStepTime = 10000000;  // 10ms
+
+// file k holds the k-th of every kFileNum messages, alternating channels
+static std::vector<std::string> ConstructRecords() {
+  std::vector<std::string> files;
+  for (uint64_t k = 0; k < kFileNum; ++k) {
+    std::string file = "parallel_viewer_test_" + std::to_string(k) + ".record";
+    RecordWriter writer;
+    writer.SetSizeOfFileSegmentation(0);
+    writer.SetIntervalOfFileSegmentation(0);
+    writer.Open(file);
+    writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc1);
+    writer.WriteChannel(kChannelName2, kMessageType1, kProtoDesc1);
+    for (uint64_t i = k; i < kMessageNum; i += kFileNum) {
+      auto msg = std::make_shared<RawMessage>(std::to_string(i));
+      writer.WriteMessage(i % 2 ? kChannelName2 : kChannelName1, msg,
+                          kStepTime * (i + 1));
+    }
+    writer.Close();
+    files.push_back(file);
+  }
+  return files;
+}
+
+static void RemoveRecords(const std::vector<std::string>& files) {
+  for (const auto& file : files) {
+    ASSERT_FALSE(remove(file.c_str()));
+  }
+}
+
+TEST(ParallelRecordViewerTest, merge_in_time_order) {
+  auto files = ConstructRecords();
+  ParallelRecordViewer viewer(files, 0, std::numeric_limits<uint64_t>::max(),
+                              {}, 2);
+  ASSERT_TRUE(viewer.IsValid());
+  EXPECT_EQ(kStepTime, viewer.begin_time());
+  EXPECT_EQ(kStepTime * kMessageNum, viewer.end_time());
+  EXPECT_EQ(2, viewer.GetChannelList().size());
+
+  RecordMessage msg;
+  for (uint64_t i = 0; i < kMessageNum; ++i) {
+    ASSERT_TRUE(viewer.ReadMessage(&msg));
+    ASSERT_EQ(kStepTime * (i + 1), msg.time);
+    ASSERT_EQ(std::to_string(i), msg.content);
+  }
+  EXPECT_FALSE(viewer.ReadMessage(&msg));
+
+  // read again after reset
+  viewer.Reset();
+  ASSERT_TRUE(viewer.ReadMessage(&msg));
+  EXPECT_EQ(kStepTime, msg.time);
+  RemoveRecords(files);
+}
+
+TEST(ParallelRecordViewerTest, filter) {
+  auto files = ConstructRecords();
+  const uint64_t begin_time = kStepTime * 100;
+  const uint64_t end_time = kStepTime * 200;
+  ParallelRecordViewer viewer(files, begin_time, end_time, {kChannelName2});
+  ASSERT_TRUE(viewer.IsValid());
+  EXPECT_EQ(1, viewer.GetChannelList().size());
+
+  RecordMessage msg;
+  uint64_t count = 0;
+  uint64_t last_time = 0;
+  while (viewer.ReadMessage(&msg)) {
+    EXPECT_EQ(kChannelName2, msg.channel_name);
+    EXPECT_GE(msg.time, begin_time);
+    EXPECT_LE(msg.time, end_time);
+    EXPECT_GE(msg.time, last_time);
+    last_time = msg.time;
+    ++count;
+  }
+  // odd indexes 99..199 hold channel2
+  EXPECT_EQ(51, count);
+  RemoveRecords(files);
+}
+
+TEST(ParallelRecordViewerTest, invalid_file) {
+  ParallelRecordViewer viewer({"not_exist.record"});
+  EXPECT_FALSE(viewer.IsValid());
+  RecordMessage msg;
+  EXPECT_FALSE(viewer.ReadMessage(&msg));
+}
+
+}  // namespace record
+}  // namespace cyber
+}  // namespace apollo
@@ -25,6 +25,7 @@ namespace record {
 using apollo::cyber::proto::Channel;
 using apollo::cyber::proto::ChunkBody;
 using apollo::cyber::proto::ChunkHeader;
+using apollo::cyber::proto::ChunkHeaderCache;
 using apollo::cyber::proto::SectionType;
 
 RecordReader::~RecordReader() {}
@@ -53,17 +54,48 @@ RecordReader::RecordReader(const std::string& file) {
       channel_info_.insert(
           std::make_pair(channel_cache->name(), *channel_cache));
     }
+    InitChunkPositions();
   }
   file_reader_->Reset();
 }
 
+void RecordReader::InitChunkPositions() {
+  // the writer always indexes a chunk header right before its body
+  const ChunkHeaderCache* header_cache = nullptr;
+  for (const auto& single_idx : index_.indexes()) {
+    if (single_idx.type() == SectionType::SECTION_CHUNK_HEADER &&
+        single_idx.has_chunk_header_cache()) {
+      header_cache = &single_idx.chunk_header_cache();
+    } else if (single_idx.type() == SectionType::SECTION_CHUNK_BODY &&
+               header_cache != nullptr) {
+      chunk_positions_.push_back({header_cache->begin_time(),
+                                  header_cache->end_time(),
+                                  static_cast<int64_t>(single_idx.position())});
+      header_cache = nullptr;
+    }
+  }
+}
+
 void RecordReader::Reset() {
   file_reader_->Reset();
   reach_end_ = false;
   message_index_ = 0;
+  chunk_cursor_ = 0;
   chunk_.reset(new ChunkBody());
 }
 
+void RecordReader::SetChannelFilter(const std::set<std::string>& channels) {
+  channel_filter_ = channels;
+  // without an index the channels of the file are unknown
+  skip_all_chunks_ = !channel_filter_.empty() && !channel_info_.empty();
+  for (const auto& channel : channel_filter_) {
+    if (channel_info_.count(channel) > 0) {
+      skip_all_chunks_ = false;
+      break;
+    }
+  }
+}
+
 std::set<std::string> RecordReader::GetChannelList() const {
   std::set<std::string> channel_list;
   for (auto& item : channel_info_) {
@@ -92,6 +124,10 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
     if (time < begin_time) {
       continue;
     }
+    if (!channel_filter_.empty() &&
+        channel_filter_.count(next_message.channel_name()) == 0) {
+      continue;
+    }
 
     message->channel_name = next_message.channel_name();
     message->content = next_message.content();
@@ -109,7 +145,38 @@ bool RecordReader::ReadMessage(RecordMessage* message, uint64_t begin_time,
   return false;
 }
 
+bool RecordReader::ReadNextIndexedChunk(uint64_t begin_time,
+                                        uint64_t end_time) {
+  while (chunk_cursor_ < chunk_positions_.size()) {
+    const auto& chunk = chunk_positions_[chunk_cursor_];
+    if (chunk.begin_time > end_time) {
+      return false;
+    }
+    ++chunk_cursor_;
+    if (chunk.end_time < begin_time) {
+      continue;
+    }
+    chunk_.reset(new ChunkBody());
+    if (!file_reader_->ReadSectionAt<ChunkBody>(
+            chunk.body_position, SectionType::SECTION_CHUNK_BODY,
+            chunk_.get())) {
+      AERROR << "Failed to read chunk body section at position "
+             << chunk.body_position;
+      return false;
+    }
+    return true;
+  }
+  reach_end_ = true;
+  return false;
+}
+
 bool RecordReader::ReadNextChunk(uint64_t begin_time, uint64_t end_time) {
+  if (skip_all_chunks_) {
+    return false;
+  }
+  if (!chunk_positions_.empty()) {
+    return ReadNextIndexedChunk(begin_time, end_time);
+  }
   bool skip_next_chunk_body = false;
   while (!reach_end_) {
     Section section;
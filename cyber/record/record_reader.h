@@ -22,6 +22,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "cyber/proto/record.pb.h"
 
@@ -77,6 +78,15 @@ class RecordReader : public RecordBase {
    */
   void Reset();
 
+  /**
+   * @brief Only read the messages of these channels, all of them if empty.
+   * The contents of the other messages are not copied, and no chunk is read
+   * at all if the index lists none of these channels.
+   *
+   * @param channels
+   */
+  void SetChannelFilter(const std::set<std::string>& channels);
+
   /**
    * @brief Get message number by channel name.
    *
@@ -114,7 +124,15 @@ class RecordReader : public RecordBase {
   std::set<std::string> GetChannelList() const override;
 
  private:
+  struct ChunkPosition {
+    uint64_t begin_time;
+    uint64_t end_time;
+    int64_t body_position;
+  };
+
+  void InitChunkPositions();
   bool ReadNextChunk(uint64_t begin_time, uint64_t end_time);
+  bool ReadNextIndexedChunk(uint64_t begin_time, uint64_t end_time);
 
   bool is_valid_ = false;
   bool reach_end_ = false;
@@ -122,6 +140,10 @@ class RecordReader : public RecordBase {
   proto::Index index_;
   int message_index_ = 0;
   ChannelInfoMap channel_info_;
+  std::vector<ChunkPosition> chunk_positions_;
+  size_t chunk_cursor_ = 0;
+  std::set<std::string> channel_filter_;
+  bool skip_all_chunks_ = false;
   FileReaderPtr file_reader_;
 };
 
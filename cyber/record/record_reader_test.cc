@@ -16,7 +16,9 @@
 
 #include "cyber/record/record_reader.h"
 
+#include <chrono>
 #include <string>
+#include <thread>
 
 #include "gtest/gtest.h"
 
@@ -122,6 +124,44 @@ TEST(RecordTest, TestReaderOrder) {
   ASSERT_FALSE(remove(kTestFile));
 }
 
+TEST(RecordTest, TestIndexedSeek) {
+  auto header = HeaderBuilder::GetHeaderWithChunkParams(9, 0);
+  header.set_segment_interval(0);
+  header.set_segment_raw_size(0);
+  RecordWriter writer(header);
+  writer.Open(kTestFile);
+  writer.WriteChannel(kChannelName1, kMessageType1, kProtoDesc);
+  for (uint32_t i = 0; i < 10 * kMessageNum; ++i) {
+    auto msg = std::make_shared<RawMessage>(std::to_string(i));
+    writer.WriteMessage(kChannelName1, msg, i);
+    if (i % 10 == 0) {
+      // let the flush thread drain the chunk so each one stays separate
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  writer.Close();
+
+  RecordReader reader(kTestFile);
+  ASSERT_TRUE(reader.IsValid());
+  ASSERT_GT(reader.GetHeader().chunk_number(), 1);
+
+  RecordMessage message;
+  const uint64_t begin_time = 5 * kMessageNum + 3;
+  const uint64_t end_time = 7 * kMessageNum + 5;
+  for (uint64_t t = begin_time; t <= end_time; ++t) {
+    ASSERT_TRUE(reader.ReadMessage(&message, begin_time, end_time));
+    ASSERT_EQ(t, message.time);
+    ASSERT_EQ(std::to_string(t), message.content);
+  }
+  ASSERT_FALSE(reader.ReadMessage(&message, begin_time, end_time));
+
+  // the window after a reset starts from the first matching chunk again
+  reader.Reset();
+  ASSERT_TRUE(reader.ReadMessage(&message, end_time, end_time));
+  ASSERT_EQ(end_time, message.time);
+  ASSERT_FALSE(remove(kTestFile));
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
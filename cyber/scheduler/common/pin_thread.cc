@@ -19,6 +19,11 @@
 #include <sched.h>
 #include <sys/resource.h>
 
+#include <map>
+#include <set>
+
+#include "cyber/common/numa.h"
+
 namespace apollo {
 namespace cyber {
 namespace scheduler {
@@ -94,6 +99,60 @@ void SetSchedPolicy(std::thread* thread, std::string spolicy,
   }
 }
 
+int NumaNodeOfAffinity(const std::vector<int>& cpus,
+                       const std::string& affinity, int cpu_id) {
+  if (cpus.empty() || common::NumaNodeNum() <= 1) {
+    return -1;
+  }
+  if (!affinity.compare("1to1")) {
+    if (cpu_id < 0 || static_cast<uint32_t>(cpu_id) >= cpus.size()) {
+      return -1;
+    }
+    return common::NumaNodeOfCpu(cpus[cpu_id]);
+  }
+  return common::NumaNodeOfCpus(cpus);
+}
+
+void ReportPlacement(const std::string& group_name,
+                     const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    AINFO << "sched group " << group_name << " is not pinned, "
+          << common::NumaNodeNum() << " numa node(s).";
+    return;
+  }
+
+  // key: numa node, value: cpus
+  std::map<int, std::vector<int>> nodes;
+  std::set<std::string> caches;
+  for (auto cpu : cpus) {
+    nodes[common::NumaNodeOfCpu(cpu)].push_back(cpu);
+    auto cache = common::SharedCacheOfCpu(cpu);
+    if (!cache.empty()) {
+      caches.insert(cache);
+    }
+  }
+
+  std::string placement;
+  for (auto& node : nodes) {
+    placement += " node " + std::to_string(node.first) + ": cpus";
+    for (auto cpu : node.second) {
+      placement += " " + std::to_string(cpu);
+    }
+    placement += ";";
+  }
+  std::string shared;
+  for (auto& cache : caches) {
+    shared += " [" + cache + "]";
+  }
+  AINFO << "sched group " << group_name << " placement:" << placement
+        << " last level caches:" << shared;
+  if (nodes.size() > 1) {
+    AWARN << "cpuset of sched group " << group_name << " spans "
+          << nodes.size()
+          << " numa nodes, its memory is not bound to any of them.";
+  }
+}
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
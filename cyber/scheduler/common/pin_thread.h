@@ -35,6 +35,15 @@ void SetSchedAffinity(std::thread* thread, const std::vector<int>& cpus,
 void SetSchedPolicy(std::thread* thread, std::string spolicy,
                     int sched_priority, pid_t tid = -1);
 
+// The NUMA node the processor cpu_id of a group runs on, which is where its
+// memory should come from, -1 if its cpus span several nodes.
+int NumaNodeOfAffinity(const std::vector<int>& cpus,
+                       const std::string& affinity, int cpu_id = -1);
+
+// Logs the NUMA nodes and shared caches the cpus of a group are on.
+void ReportPlacement(const std::string& group_name,
+                     const std::vector<int>& cpus);
+
 }  // namespace scheduler
 }  // namespace cyber
 }  // namespace apollo
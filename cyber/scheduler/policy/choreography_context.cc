@@ -16,6 +16,7 @@
 
 #include "cyber/scheduler/policy/choreography_context.h"
 
+#include <chrono>
 #include <limits>
 #include <unordered_map>
 #include <utility>
@@ -32,12 +33,71 @@ using apollo::cyber::base::WriteLockGuard;
 
 using apollo::cyber::croutine::RoutineState;
 
+namespace {
+
+uint64_t SteadyNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
 std::shared_ptr<CRoutine> ChoreographyContext::NextRoutine() {
   if (cyber_unlikely(stop_.load())) {
     return nullptr;
   }
 
   ReadLockGuard<AtomicRWLock> lock(rq_lk_);
+  if (!deadline_queue_.empty()) {
+    uint64_t now_ns = SteadyNow();
+    // the croutine handed out last time is back, its job is done unless it
+    // only yielded
+    if (last_deadline_task_ != nullptr) {
+      if (last_deadline_task_->cr->state() != RoutineState::READY) {
+        FinishJob(last_deadline_task_.get(), now_ns);
+      }
+      last_deadline_task_ = nullptr;
+    }
+
+    DeadlineTask* earliest = nullptr;
+    for (auto& task : deadline_queue_) {
+      auto& cr = task->cr;
+      if (!cr->Acquire()) {
+        continue;
+      }
+      if (cr->UpdateState() != RoutineState::READY) {
+        cr->Release();
+        continue;
+      }
+      if (task->job_deadline_ns == 0) {
+        uint64_t release_ns = cr->notify_time();
+        if (release_ns == 0 || release_ns > now_ns) {
+          release_ns = now_ns;
+        }
+        task->job_deadline_ns = release_ns + task->deadline_ns;
+      }
+      if (earliest == nullptr ||
+          task->job_deadline_ns < earliest->job_deadline_ns) {
+        if (earliest != nullptr) {
+          earliest->cr->Release();
+        }
+        earliest = task.get();
+      } else {
+        cr->Release();
+      }
+    }
+    if (earliest != nullptr) {
+      for (auto& task : deadline_queue_) {
+        if (task.get() == earliest) {
+          last_deadline_task_ = task;
+          break;
+        }
+      }
+      return earliest->cr;
+    }
+  }
+
   for (auto it : cr_queue_) {
     auto cr = it.second;
     if (!cr->Acquire()) {
@@ -58,6 +118,43 @@ bool ChoreographyContext::Enqueue(const std::shared_ptr<CRoutine>& cr) {
   return true;
 }
 
+bool ChoreographyContext::Enqueue(const std::shared_ptr<CRoutine>& cr,
+                                  uint64_t period_us, uint64_t deadline_us) {
+  if (deadline_us == 0) {
+    deadline_us = period_us;
+  }
+  if (deadline_us == 0) {
+    return Enqueue(cr);
+  }
+
+  auto task = std::make_shared<DeadlineTask>();
+  task->cr = cr;
+  task->deadline_ns = deadline_us * 1000;
+  WriteLockGuard<AtomicRWLock> lock(rq_lk_);
+  deadline_queue_.emplace_back(std::move(task));
+  return true;
+}
+
+uint64_t ChoreographyContext::DeadlineMisses(uint64_t crid) {
+  ReadLockGuard<AtomicRWLock> lock(rq_lk_);
+  for (auto& task : deadline_queue_) {
+    if (task->cr->id() == crid) {
+      return task->misses.load();
+    }
+  }
+  return 0;
+}
+
+void ChoreographyContext::FinishJob(DeadlineTask* task, uint64_t now_ns) {
+  if (task->job_deadline_ns != 0 && now_ns > task->job_deadline_ns) {
+    task->misses.fetch_add(1);
+    AWARN_EVERY(100) << task->cr->name() << " missed its deadline by "
+                     << (now_ns - task->job_deadline_ns) / 1000 << " us, "
+                     << task->misses.load() << " misses so far";
+  }
+  task->job_deadline_ns = 0;
+}
+
 void ChoreographyContext::Notify() {
   mtx_wq_.lock();
   notify++;
@@ -84,6 +181,23 @@ void ChoreographyContext::Shutdown() {
 
 bool ChoreographyContext::RemoveCRoutine(uint64_t crid) {
   WriteLockGuard<AtomicRWLock> lock(rq_lk_);
+  for (auto it = deadline_queue_.begin(); it != deadline_queue_.end(); ++it) {
+    auto cr = (*it)->cr;
+    if (cr->id() == crid) {
+      cr->Stop();
+      while (!cr->Acquire()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        AINFO_EVERY(1000) << "waiting for task " << cr->name() << " completion";
+      }
+      if (last_deadline_task_ == *it) {
+        last_deadline_task_ = nullptr;
+      }
+      deadline_queue_.erase(it);
+      cr->Release();
+      return true;
+    }
+  }
+
   for (auto it = cr_queue_.begin(); it != cr_queue_.end();) {
     auto cr = it->second;
     if (cr->id() == crid) {
@@ -17,12 +17,14 @@
 #ifndef CYBER_SCHEDULER_POLICY_CHOREOGRAPHY_CONTEXT_H_
 #define CYBER_SCHEDULER_POLICY_CHOREOGRAPHY_CONTEXT_H_
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/croutine/croutine.h"
@@ -41,11 +43,27 @@ class ChoreographyContext : public ProcessorContext {
   std::shared_ptr<CRoutine> NextRoutine() override;
 
   bool Enqueue(const std::shared_ptr<CRoutine>&);
+  // Ready croutines enqueued with a deadline run before the priority queue,
+  // earliest absolute deadline first. A job is released when the croutine
+  // is notified and missed when it is still running at release + deadline.
+  bool Enqueue(const std::shared_ptr<CRoutine>& cr, uint64_t period_us,
+               uint64_t deadline_us);
+  uint64_t DeadlineMisses(uint64_t crid);
   void Notify();
   void Wait() override;
   void Shutdown() override;
 
  private:
+  // the job fields are only touched by the processor thread
+  struct DeadlineTask {
+    std::shared_ptr<CRoutine> cr;
+    uint64_t deadline_ns = 0;
+    uint64_t job_deadline_ns = 0;
+    std::atomic<uint64_t> misses = {0};
+  };
+
+  void FinishJob(DeadlineTask* task, uint64_t now_ns);
+
   std::mutex mtx_wq_;
   std::condition_variable cv_wq_;
   int notify = 0;
@@ -53,6 +71,8 @@ class ChoreographyContext : public ProcessorContext {
   AtomicRWLock rq_lk_;
   std::multimap<uint32_t, std::shared_ptr<CRoutine>, std::greater<uint32_t>>
       cr_queue_;
+  std::vector<std::shared_ptr<DeadlineTask>> deadline_queue_;
+  std::shared_ptr<DeadlineTask> last_deadline_task_;
 };
 
 }  // namespace scheduler
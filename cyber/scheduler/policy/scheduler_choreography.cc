@@ -79,6 +79,18 @@ SchedulerChoreography::SchedulerChoreography()
     }
   }
 
+  std::string deadline_conf("conf/");
+  deadline_conf.append(GlobalData::Instance()->ProcessGroup())
+      .append(".deadline.conf");
+  auto deadline_file = GetAbsolutePath(WorkRoot(), deadline_conf);
+  apollo::cyber::proto::DeadlineConf deadline_cfg;
+  if (PathExists(deadline_file) &&
+      GetProtoFromFile(deadline_file, &deadline_cfg)) {
+    for (const auto& task : deadline_cfg.task()) {
+      deadline_confs_[task.name()] = task;
+    }
+  }
+
   if (proc_num_ == 0) {
     auto& global_conf = GlobalData::Instance()->Config();
     if (global_conf.has_scheduler_conf() &&
@@ -94,10 +106,15 @@ SchedulerChoreography::SchedulerChoreography()
 }
 
 void SchedulerChoreography::CreateProcessor() {
+  ReportPlacement("choreography", choreography_cpuset_);
+  ReportPlacement("pool", pool_cpuset_);
+
   for (uint32_t i = 0; i < proc_num_; i++) {
     auto proc = std::make_shared<Processor>();
     auto ctx = std::make_shared<ChoreographyContext>();
 
+    proc->set_numa_node(
+        NumaNodeOfAffinity(choreography_cpuset_, choreography_affinity_, i));
     proc->BindContext(ctx);
     SetSchedAffinity(proc->Thread(), choreography_cpuset_,
                      choreography_affinity_, i);
@@ -111,6 +128,7 @@ void SchedulerChoreography::CreateProcessor() {
     auto proc = std::make_shared<Processor>();
     auto ctx = std::make_shared<ClassicContext>();
 
+    proc->set_numa_node(NumaNodeOfAffinity(pool_cpuset_, pool_affinity_, i));
     proc->BindContext(ctx);
     SetSchedAffinity(proc->Thread(), pool_cpuset_, pool_affinity_, i);
     SetSchedPolicy(proc->Thread(), pool_processor_policy_, pool_processor_prio_,
@@ -155,10 +173,21 @@ bool SchedulerChoreography::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
 
   // Enqueue task.
   uint32_t pid = cr->processor_id();
+  auto deadline = deadline_confs_.find(cr->name());
   if (pid < proc_num_) {
     // Enqueue task to Choreo Policy.
-    static_cast<ChoreographyContext*>(pctxs_[pid].get())->Enqueue(cr);
+    auto ctx = static_cast<ChoreographyContext*>(pctxs_[pid].get());
+    if (deadline != deadline_confs_.end()) {
+      ctx->Enqueue(cr, deadline->second.period_us(),
+                   deadline->second.deadline_us());
+    } else {
+      ctx->Enqueue(cr);
+    }
   } else {
+    if (deadline != deadline_confs_.end()) {
+      AWARN << cr->name() << " has a deadline but no choreography processor,"
+            << " it runs by priority in the pool.";
+    }
     // Check if task prio is reasonable.
     if (cr->priority() >= MAX_PRIO) {
       AWARN << cr->name() << " prio great than MAX_PRIO.";
@@ -227,6 +256,26 @@ bool SchedulerChoreography::RemoveCRoutine(uint64_t crid) {
   }
 }
 
+uint64_t SchedulerChoreography::DeadlineMisses(const std::string& name) {
+  auto crid = GlobalData::GenerateHashId(name);
+  std::shared_ptr<CRoutine> cr = nullptr;
+  {
+    ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+    auto it = id_cr_.find(crid);
+    if (it == id_cr_.end()) {
+      return 0;
+    }
+    cr = it->second;
+  }
+
+  uint32_t pid = cr->processor_id();
+  if (pid >= proc_num_) {
+    return 0;
+  }
+  return static_cast<ChoreographyContext*>(pctxs_[pid].get())
+      ->DeadlineMisses(crid);
+}
+
 bool SchedulerChoreography::NotifyProcessor(uint64_t crid) {
   if (cyber_unlikely(stop_)) {
     return true;
@@ -24,6 +24,7 @@
 
 #include "cyber/croutine/croutine.h"
 #include "cyber/proto/choreography_conf.pb.h"
+#include "cyber/proto/deadline_conf.pb.h"
 #include "cyber/scheduler/scheduler.h"
 
 namespace apollo {
@@ -32,6 +33,7 @@ namespace scheduler {
 
 using apollo::cyber::croutine::CRoutine;
 using apollo::cyber::proto::ChoreographyTask;
+using apollo::cyber::proto::TaskDeadline;
 
 class SchedulerChoreography : public Scheduler {
  public:
@@ -39,6 +41,9 @@ class SchedulerChoreography : public Scheduler {
   bool RemoveTask(const std::string& name) override;
   bool DispatchTask(const std::shared_ptr<CRoutine>&) override;
 
+  // jobs of a deadline task that finished late, see ChoreographyContext
+  uint64_t DeadlineMisses(const std::string& name);
+
  private:
   friend Scheduler* Instance();
   SchedulerChoreography();
@@ -47,6 +52,7 @@ class SchedulerChoreography : public Scheduler {
   bool NotifyProcessor(uint64_t crid) override;
 
   std::unordered_map<std::string, ChoreographyTask> cr_confs_;
+  std::unordered_map<std::string, TaskDeadline> deadline_confs_;
 
   int32_t choreography_processor_prio_;
   int32_t pool_processor_prio_;
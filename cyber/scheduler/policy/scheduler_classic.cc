@@ -22,6 +22,7 @@
 
 #include "cyber/common/environment.h"
 #include "cyber/common/file.h"
+#include "cyber/common/numa.h"
 #include "cyber/scheduler/policy/classic_context.h"
 #include "cyber/scheduler/processor.h"
 
@@ -94,12 +95,17 @@ void SchedulerClassic::CreateProcessor() {
     auto processor_prio = group.processor_prio();
     std::vector<int> cpuset;
     ParseCpuset(group.cpuset(), &cpuset);
+    ReportPlacement(group_name, cpuset);
+    // routines of a group run on any of its processors, so their stacks are
+    // only bound when the whole cpuset is on one node.
+    group_numa_nodes_[group_name] = NumaNodeOfAffinity(cpuset, "range");
 
     for (uint32_t i = 0; i < proc_num; i++) {
       auto ctx = std::make_shared<ClassicContext>(group_name);
       pctxs_.emplace_back(ctx);
 
       auto proc = std::make_shared<Processor>();
+      proc->set_numa_node(NumaNodeOfAffinity(cpuset, affinity, i));
       proc->BindContext(ctx);
       SetSchedAffinity(proc->Thread(), cpuset, affinity, i);
       SetSchedPolicy(proc->Thread(), processor_policy, processor_prio,
@@ -147,6 +153,13 @@ bool SchedulerClassic::DispatchTask(const std::shared_ptr<CRoutine>& cr) {
     cr->set_priority(MAX_PRIO - 1);
   }
 
+  auto node = group_numa_nodes_.find(cr->group_name());
+  if (node != group_numa_nodes_.end() && node->second >= 0 &&
+      cr->GetContext() != nullptr) {
+    common::BindToNumaNode(cr->GetContext()->stack,
+                           cr->GetContext()->stack_size, node->second);
+  }
+
   // Enqueue task.
   {
     WriteLockGuard<AtomicRWLock> lk(
@@ -48,6 +48,8 @@ class SchedulerClassic : public Scheduler {
   bool NotifyProcessor(uint64_t crid) override;
 
   std::unordered_map<std::string, ClassicTask> cr_confs_;
+  // numa node of every group, -1 if its cpus span several
+  std::unordered_map<std::string, int> group_numa_nodes_;
 
   ClassicConf classic_conf_;
 };
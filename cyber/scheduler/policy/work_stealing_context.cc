@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/work_stealing_context.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+using apollo::cyber::base::AtomicRWLock;
+using apollo::cyber::base::ReadLockGuard;
+using apollo::cyber::base::WriteLockGuard;
+using apollo::cyber::croutine::RoutineState;
+
+std::shared_ptr<CRoutine> WorkStealingContext::NextRoutine() {
+  if (cyber_unlikely(stop_.load())) {
+    return nullptr;
+  }
+
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    auto cr = NextReadyRoutine(i);
+    if (cr) {
+      return cr;
+    }
+  }
+  return StealRoutine();
+}
+
+std::shared_ptr<CRoutine> WorkStealingContext::NextReadyRoutine(
+    uint32_t prio) {
+  ReadLockGuard<AtomicRWLock> lk(lq_.at(prio));
+  for (auto& cr : multi_pri_rq_.at(prio)) {
+    if (!cr->Acquire()) {
+      continue;
+    }
+
+    if (cr->UpdateState() == RoutineState::READY) {
+      return cr;
+    }
+
+    cr->Release();
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CRoutine> WorkStealingContext::StealRoutine() {
+  for (int i = MAX_PRIO - 1; i >= 0; --i) {
+    for (auto peer : peers_) {
+      if (peer->CRoutineNum() == 0) {
+        continue;
+      }
+      auto cr = peer->NextReadyRoutine(i);
+      if (cr) {
+        return cr;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingContext::SetPeers(
+    const std::vector<WorkStealingContext*>& peers) {
+  // start right after ourselves so that thieves spread over the group
+  peers_.clear();
+  auto self = std::find(peers.begin(), peers.end(), this);
+  if (self == peers.end()) {
+    peers_ = peers;
+    return;
+  }
+  peers_.insert(peers_.end(), self + 1, peers.end());
+  peers_.insert(peers_.end(), peers.begin(), self);
+}
+
+bool WorkStealingContext::Enqueue(const std::shared_ptr<CRoutine>& cr) {
+  WriteLockGuard<AtomicRWLock> lk(lq_.at(cr->priority()));
+  multi_pri_rq_.at(cr->priority()).emplace_back(cr);
+  cr_num_.fetch_add(1);
+  return true;
+}
+
+bool WorkStealingContext::RemoveCRoutine(const std::shared_ptr<CRoutine>& cr) {
+  auto prio = cr->priority();
+  auto crid = cr->id();
+  WriteLockGuard<AtomicRWLock> lk(lq_.at(prio));
+  auto& croutines = multi_pri_rq_.at(prio);
+  for (auto it = croutines.begin(); it != croutines.end(); ++it) {
+    if ((*it)->id() == crid) {
+      auto cr = *it;
+      cr->Stop();
+      while (!cr->Acquire()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1));
+        AINFO_EVERY(1000) << "waiting for task " << cr->name() << " completion";
+      }
+      croutines.erase(it);
+      cr_num_.fetch_sub(1);
+      cr->Release();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingContext::NotifyRoutine() {
+  Notify();
+  if (Idle()) {
+    return;
+  }
+  for (auto peer : peers_) {
+    if (peer->Idle()) {
+      peer->Notify();
+      return;
+    }
+  }
+}
+
+void WorkStealingContext::Notify() {
+  mtx_wq_.lock();
+  notify_++;
+  mtx_wq_.unlock();
+  cv_wq_.notify_one();
+}
+
+void WorkStealingContext::Wait() {
+  std::unique_lock<std::mutex> lk(mtx_wq_);
+  idle_.store(true);
+  cv_wq_.wait_for(lk, std::chrono::milliseconds(1000),
+                  [&]() { return notify_ > 0; });
+  idle_.store(false);
+  if (notify_ > 0) {
+    notify_--;
+  }
+}
+
+void WorkStealingContext::Shutdown() {
+  stop_.store(true);
+  mtx_wq_.lock();
+  notify_ = std::numeric_limits<unsigned char>::max();
+  mtx_wq_.unlock();
+  cv_wq_.notify_all();
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
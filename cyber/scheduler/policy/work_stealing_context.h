@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
+#define CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/croutine/croutine.h"
+#include "cyber/scheduler/policy/classic_context.h"
+#include "cyber/scheduler/processor_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+// Each processor owns its multi-priority run queue, so picking the next
+// croutine only touches locks shared with the scheduler and not with the
+// other processors. A processor that finds nothing ready locally steals a
+// ready croutine from the peers of its group, highest priority first.
+class WorkStealingContext : public ProcessorContext {
+ public:
+  WorkStealingContext() = default;
+
+  std::shared_ptr<CRoutine> NextRoutine() override;
+  void Wait() override;
+  void Shutdown() override;
+
+  // Must be set before the context is bound to a processor.
+  void SetPeers(const std::vector<WorkStealingContext*>& peers);
+
+  bool Enqueue(const std::shared_ptr<CRoutine>& cr);
+  bool RemoveCRoutine(const std::shared_ptr<CRoutine>& cr);
+
+  // Wakes this context, and when it is busy also an idle peer that can
+  // steal the croutine.
+  void NotifyRoutine();
+
+  uint32_t CRoutineNum() const { return cr_num_.load(); }
+  bool Idle() const { return idle_.load(); }
+
+ private:
+  void Notify();
+  std::shared_ptr<CRoutine> NextReadyRoutine(uint32_t prio);
+  std::shared_ptr<CRoutine> StealRoutine();
+
+  alignas(CACHELINE_SIZE) MULTI_PRIO_QUEUE multi_pri_rq_;
+  alignas(CACHELINE_SIZE) LOCK_QUEUE lq_;
+
+  std::mutex mtx_wq_;
+  std::condition_variable cv_wq_;
+  int notify_ = 0;
+
+  std::atomic<bool> idle_ = {false};
+  std::atomic<uint32_t> cr_num_ = {0};
+
+  // peers of the same group without this context, in stealing order
+  std::vector<WorkStealingContext*> peers_;
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_POLICY_WORK_STEALING_CONTEXT_H_
@@ -24,6 +24,7 @@
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
+#include "cyber/common/numa.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/time/time.h"
 
@@ -33,6 +34,14 @@ namespace scheduler {
 
 using apollo::cyber::common::GlobalData;
 
+namespace {
+uint64_t SteadyNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
 Processor::Processor() { running_.store(true); }
 
 Processor::~Processor() { Stop(); }
@@ -41,6 +50,9 @@ void Processor::Run() {
   tid_.store(static_cast<int>(syscall(SYS_gettid)));
   AINFO << "processor_tid: " << tid_;
   snap_shot_->processor_id.store(tid_);
+  if (numa_node_ >= 0) {
+    common::SetThreadNumaNode(numa_node_);
+  }
 
   while (cyber_likely(running_.load())) {
     if (cyber_likely(context_ != nullptr)) {
@@ -48,7 +60,19 @@ void Processor::Run() {
       if (croutine) {
         snap_shot_->execute_start_time.store(cyber::Time::Now().ToNanosecond());
         snap_shot_->routine_name = croutine->name();
+        auto start = SteadyNow();
+        snap_shot_->routine_id.store(croutine->id());
+        snap_shot_->run_start_ns.store(start);
+        auto notify_time = croutine->TakeNotifyTime();
         croutine->Resume();
+        auto end = SteadyNow();
+        snap_shot_->run_start_ns.store(0);
+        if (notify_time != 0 && start > notify_time) {
+          croutine->wake_to_run()->Record(start - notify_time);
+          snap_shot_->wake_to_run.Record(start - notify_time);
+        }
+        croutine->run_time()->Record(end - start);
+        snap_shot_->run_time.Record(end - start);
         croutine->Release();
       } else {
         snap_shot_->execute_start_time.store(0);
@@ -27,6 +27,7 @@
 
 #include "cyber/proto/scheduler_conf.pb.h"
 
+#include "cyber/base/latency_histogram.h"
 #include "cyber/croutine/croutine.h"
 #include "cyber/scheduler/processor_context.h"
 
@@ -38,8 +39,13 @@ using croutine::CRoutine;
 
 struct Snapshot {
   std::atomic<uint64_t> execute_start_time = {0};
+  // steady clock start of the current run and its croutine, 0 between runs
+  std::atomic<uint64_t> run_start_ns = {0};
+  std::atomic<uint64_t> routine_id = {0};
   std::atomic<pid_t> processor_id = {0};
   std::string routine_name;
+  base::LatencyHistogram wake_to_run;
+  base::LatencyHistogram run_time;
 };
 
 class Processor {
@@ -53,6 +59,10 @@ class Processor {
   std::thread* Thread() { return &thread_; }
   std::atomic<pid_t>& Tid();
 
+  // The numa node memory touched by this processor comes from, takes effect
+  // when set before BindContext.
+  void set_numa_node(int node) { numa_node_ = node; }
+
   std::shared_ptr<Snapshot> ProcSnapshot() { return snap_shot_; }
 
  private:
@@ -65,6 +75,7 @@ class Processor {
 
   std::atomic<pid_t> tid_{-1};
   std::atomic<bool> running_{false};
+  int numa_node_ = -1;
 
   std::shared_ptr<Snapshot> snap_shot_ = std::make_shared<Snapshot>();
 };
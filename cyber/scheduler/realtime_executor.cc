@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/realtime_executor.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/log.h"
+#include "cyber/scheduler/common/pin_thread.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+namespace {
+
+// stack the task may use without faulting once the memory is locked
+constexpr size_t kStackPrefaultBytes = 64 * 1024;
+
+uint64_t MonoNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+void SleepUntil(uint64_t deadline_ns) {
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(deadline_ns / 1000000000ULL);
+  ts.tv_nsec = static_cast<long>(deadline_ns % 1000000000ULL);  // NOLINT
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+         EINTR) {
+  }
+}
+
+void PrefaultStack() {
+  char stack[kStackPrefaultBytes];
+  std::memset(stack, 0, sizeof(stack));
+  // keep the stores from being optimized away
+  asm volatile("" : : "r"(stack) : "memory");
+}
+
+}  // namespace
+
+RealtimeExecutor::RealtimeExecutor(const RealtimeOption& option)
+    : option_(option) {}
+
+RealtimeExecutor::~RealtimeExecutor() { Stop(); }
+
+bool RealtimeExecutor::Start(std::function<void()> task) {
+  if (running_.exchange(true)) {
+    return false;
+  }
+  if (option_.period_ms == 0) {
+    AERROR << "realtime executor " << option_.name << " needs a period.";
+    running_ = false;
+    return false;
+  }
+  task_ = std::move(task);
+  LockMemory();
+  thread_ = std::thread(&RealtimeExecutor::Run, this);
+  return true;
+}
+
+void RealtimeExecutor::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  AINFO << "realtime executor " << option_.name
+        << " max wakeup latency: " << wakeup_latency_.Max() / 1000
+        << "us, p99: " << wakeup_latency_.Percentile(0.99)
+        << "us, overruns: " << overruns();
+}
+
+bool RealtimeExecutor::LockMemory() {
+  static std::once_flag flag;
+  static bool locked = false;
+  std::call_once(flag, []() {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      AWARN << "mlockall failed: " << std::strerror(errno)
+            << ", realtime tasks may page fault.";
+      return;
+    }
+    locked = true;
+  });
+  return locked;
+}
+
+bool RealtimeExecutor::GetOption(const std::string& name,
+                                 RealtimeOption* option) {
+  std::stringstream names(common::GetEnv("CYBER_REALTIME_COMPONENTS"));
+  std::string item;
+  bool found = false;
+  while (std::getline(names, item, ',')) {
+    if (item == name) {
+      found = true;
+      break;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  option->name = name;
+  auto priority = common::GetEnv("CYBER_REALTIME_PRIORITY");
+  if (!priority.empty()) {
+    option->priority =
+        static_cast<int>(std::strtol(priority.c_str(), nullptr, 10));
+  }
+  option->cpus.clear();
+  auto cpus = common::GetEnv("CYBER_REALTIME_CPUS");
+  if (!cpus.empty()) {
+    ParseCpuset(cpus, &option->cpus);
+  }
+  return true;
+}
+
+void RealtimeExecutor::Run() {
+  struct sched_param sp;
+  std::memset(&sp, 0, sizeof(sp));
+  sp.sched_priority = option_.priority;
+  int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+  if (ret != 0) {
+    AWARN << "realtime executor " << option_.name
+          << " failed to set SCHED_FIFO: " << std::strerror(ret)
+          << ", running with the default policy.";
+  }
+  if (!option_.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : option_.cpus) {
+      CPU_SET(cpu, &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+  PrefaultStack();
+  AINFO << "realtime executor " << option_.name << " period "
+        << option_.period_ms << "ms, priority " << option_.priority;
+
+  const uint64_t period_ns = option_.period_ms * 1000000ULL;
+  uint64_t deadline_ns = MonoNs();
+  while (running_.load(std::memory_order_relaxed)) {
+    deadline_ns += period_ns;
+    SleepUntil(deadline_ns);
+    if (!running_.load(std::memory_order_relaxed)) {
+      break;
+    }
+    uint64_t now_ns = MonoNs();
+    wakeup_latency_.Record(now_ns > deadline_ns ? now_ns - deadline_ns : 0);
+    task_();
+
+    now_ns = MonoNs();
+    if (now_ns >= deadline_ns + period_ns) {
+      overruns_.fetch_add(1, std::memory_order_relaxed);
+      deadline_ns += (now_ns - deadline_ns) / period_ns * period_ns;
+    }
+  }
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
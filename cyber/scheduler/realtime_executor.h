@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SCHEDULER_REALTIME_EXECUTOR_H_
+#define CYBER_SCHEDULER_REALTIME_EXECUTOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/base/latency_histogram.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+struct RealtimeOption {
+  std::string name;
+  // SCHED_FIFO priority, 1 (lowest) to 99
+  int priority = 80;
+  // cpus the thread may run on, empty for no pinning
+  std::vector<int> cpus;
+  uint32_t period_ms = 10;
+};
+
+// Runs a periodic task on its own SCHED_FIFO thread, away from the croutine
+// scheduler, so a task on the safety path keeps its period when the rest of
+// the process saturates the cpus. Periods are kept on absolute deadlines, a
+// task that overruns skips the periods it missed instead of bursting.
+class RealtimeExecutor {
+ public:
+  explicit RealtimeExecutor(const RealtimeOption& option);
+  ~RealtimeExecutor();
+
+  bool Start(std::function<void()> task);
+  void Stop();
+
+  // Locks the current and future pages of the process in memory, once per
+  // process, so the task never waits for a page fault.
+  static bool LockMemory();
+
+  // Fills option from CYBER_REALTIME_COMPONENTS, a comma separated list of
+  // the components to run on an executor, CYBER_REALTIME_PRIORITY and
+  // CYBER_REALTIME_CPUS. Returns false when name is not in the list.
+  static bool GetOption(const std::string& name, RealtimeOption* option);
+
+  // how late the task woke up against its deadline
+  const base::LatencyHistogram& wakeup_latency() const {
+    return wakeup_latency_;
+  }
+  uint64_t overruns() const {
+    return overruns_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void Run();
+
+  RealtimeOption option_;
+  std::function<void()> task_;
+  std::thread thread_;
+  std::atomic<bool> running_ = {false};
+  base::LatencyHistogram wakeup_latency_;
+  std::atomic<uint64_t> overruns_ = {0};
+};
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SCHEDULER_REALTIME_EXECUTOR_H_
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/realtime_executor.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+TEST(RealtimeExecutorTest, periodic) {
+  RealtimeOption option;
+  option.name = "periodic";
+  option.period_ms = 5;
+  RealtimeExecutor executor(option);
+  std::atomic<int> runs = {0};
+  EXPECT_TRUE(executor.Start([&runs]() { ++runs; }));
+  EXPECT_FALSE(executor.Start([]() {}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  executor.Stop();
+  int stopped_runs = runs.load();
+  EXPECT_GT(stopped_runs, 5);
+  EXPECT_LE(stopped_runs, 21);
+  EXPECT_EQ(executor.wakeup_latency().Count(),
+            static_cast<uint64_t>(stopped_runs));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(stopped_runs, runs.load());
+}
+
+TEST(RealtimeExecutorTest, overrun) {
+  RealtimeOption option;
+  option.name = "overrun";
+  option.period_ms = 2;
+  RealtimeExecutor executor(option);
+  std::atomic<int> runs = {0};
+  EXPECT_TRUE(executor.Start([&runs]() {
+    if (++runs == 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  executor.Stop();
+  EXPECT_EQ(1u, executor.overruns());
+  // the missed periods are skipped, not run back to back
+  EXPECT_LE(runs.load(), 12);
+}
+
+TEST(RealtimeExecutorTest, get_option) {
+  RealtimeOption option;
+  unsetenv("CYBER_REALTIME_COMPONENTS");
+  EXPECT_FALSE(RealtimeExecutor::GetOption("guardian", &option));
+
+  setenv("CYBER_REALTIME_COMPONENTS", "control,guardian", 1);
+  setenv("CYBER_REALTIME_PRIORITY", "90", 1);
+  setenv("CYBER_REALTIME_CPUS", "2-3", 1);
+  EXPECT_FALSE(RealtimeExecutor::GetOption("guard", &option));
+  EXPECT_TRUE(RealtimeExecutor::GetOption("guardian", &option));
+  EXPECT_EQ("guardian", option.name);
+  EXPECT_EQ(90, option.priority);
+  ASSERT_EQ(2u, option.cpus.size());
+  EXPECT_EQ(2, option.cpus[0]);
+  EXPECT_EQ(3, option.cpus[1]);
+  unsetenv("CYBER_REALTIME_COMPONENTS");
+  unsetenv("CYBER_REALTIME_PRIORITY");
+  unsetenv("CYBER_REALTIME_CPUS");
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
@@ -32,8 +32,23 @@ namespace apollo {
 namespace cyber {
 namespace scheduler {
 
+using apollo::cyber::base::LatencyHistogram;
 using apollo::cyber::common::GlobalData;
 
+namespace {
+void FillHistogram(const LatencyHistogram& hist,
+                   proto::LatencyHistogram* msg) {
+  msg->set_count(hist.Count());
+  msg->set_sum_ns(hist.Sum());
+  msg->set_max_ns(hist.Max());
+  msg->set_p50_us(hist.Percentile(0.5));
+  msg->set_p99_us(hist.Percentile(0.99));
+  for (uint32_t i = 0; i < LatencyHistogram::kBucketNum; ++i) {
+    msg->add_bucket(hist.Bucket(i));
+  }
+}
+}  // namespace
+
 bool Scheduler::CreateTask(const RoutineFactory& factory,
                            const std::string& name) {
   return CreateTask(factory.create_routine(), name, factory.GetDataVisitor());
@@ -122,6 +137,44 @@ void Scheduler::CheckSchedStatus() {
   snap_info.clear();
 }
 
+void Scheduler::GetSchedLatency(proto::SchedLatency* latency) {
+  latency->set_timestamp(Time::Now().ToNanosecond());
+  for (auto processor : processors_) {
+    auto snap = processor->ProcSnapshot();
+    auto proc = latency->add_processor();
+    proc->set_tid(snap->processor_id.load());
+    FillHistogram(snap->wake_to_run, proc->mutable_wake_to_run());
+    FillHistogram(snap->run_time, proc->mutable_run_time());
+  }
+
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  for (auto& cr : id_cr_) {
+    auto routine = latency->add_routine();
+    routine->set_id(cr.second->id());
+    routine->set_name(cr.second->name());
+    FillHistogram(*cr.second->wake_to_run(), routine->mutable_wake_to_run());
+    FillHistogram(*cr.second->run_time(), routine->mutable_run_time());
+  }
+}
+
+std::vector<std::shared_ptr<Snapshot>> Scheduler::ProcessorSnapshots() {
+  std::vector<std::shared_ptr<Snapshot>> snapshots;
+  for (auto processor : processors_) {
+    snapshots.emplace_back(processor->ProcSnapshot());
+  }
+  return snapshots;
+}
+
+bool Scheduler::GetRoutineName(uint64_t crid, std::string* name) {
+  ReadLockGuard<AtomicRWLock> lk(id_cr_lock_);
+  auto iter = id_cr_.find(crid);
+  if (iter == id_cr_.end()) {
+    return false;
+  }
+  *name = iter->second->name();
+  return true;
+}
+
 void Scheduler::Shutdown() {
   if (cyber_unlikely(stop_.exchange(true))) {
     return;
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "cyber/proto/choreography_conf.pb.h"
+#include "cyber/proto/sched_latency.pb.h"
 
 #include "cyber/base/atomic_hash_map.h"
 #include "cyber/base/atomic_rw_lock.h"
@@ -54,6 +55,7 @@ using apollo::cyber::proto::InnerThread;
 
 class Processor;
 class ProcessorContext;
+struct Snapshot;
 
 class Scheduler {
  public:
@@ -78,6 +80,11 @@ class Scheduler {
   virtual bool RemoveCRoutine(uint64_t crid) = 0;
 
   void CheckSchedStatus();
+  void GetSchedLatency(proto::SchedLatency* latency);
+  // the snapshots of the processors, in the order of the processors
+  std::vector<std::shared_ptr<Snapshot>> ProcessorSnapshots();
+  // false if no croutine has the id
+  bool GetRoutineName(uint64_t crid, std::string* name);
 
   void SetInnerThreadConfs(
       const std::unordered_map<std::string, InnerThread>& confs) {
@@ -15,6 +15,8 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 #include "gtest/gtest.h"
 
@@ -30,6 +32,8 @@ namespace apollo {
 namespace cyber {
 namespace scheduler {
 
+using apollo::cyber::croutine::RoutineState;
+
 void func() {}
 
 TEST(SchedulerChoreoTest, choreo) {
@@ -44,6 +48,46 @@ TEST(SchedulerChoreoTest, choreo) {
   ctx->Shutdown();
 }
 
+TEST(SchedulerChoreoTest, deadline) {
+  auto ctx = std::make_shared<ChoreographyContext>();
+
+  auto planning = std::make_shared<CRoutine>(func);
+  planning->set_id(GlobalData::RegisterTaskName("deadline_planning"));
+  planning->set_name("deadline_planning");
+  auto prediction = std::make_shared<CRoutine>(func);
+  prediction->set_id(GlobalData::RegisterTaskName("deadline_prediction"));
+  prediction->set_name("deadline_prediction");
+  prediction->set_priority(10);
+  auto other = std::make_shared<CRoutine>(func);
+  other->set_id(GlobalData::RegisterTaskName("deadline_other"));
+  other->set_priority(20);
+  EXPECT_TRUE(ctx->Enqueue(other));
+  EXPECT_TRUE(ctx->Enqueue(prediction, 100000, 0));
+  EXPECT_TRUE(ctx->Enqueue(planning, 100000, 1));
+
+  // earliest deadline first, ahead of any priority
+  auto cr = ctx->NextRoutine();
+  ASSERT_EQ(cr, planning);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  cr->set_state(RoutineState::DATA_WAIT);
+  cr->Release();
+
+  cr = ctx->NextRoutine();
+  ASSERT_EQ(cr, prediction);
+  EXPECT_EQ(ctx->DeadlineMisses(planning->id()), 1);
+  cr->set_state(RoutineState::DATA_WAIT);
+  cr->Release();
+
+  cr = ctx->NextRoutine();
+  ASSERT_EQ(cr, other);
+  EXPECT_EQ(ctx->DeadlineMisses(prediction->id()), 0);
+  cr->Release();
+
+  EXPECT_TRUE(ctx->RemoveCRoutine(planning->id()));
+  EXPECT_EQ(ctx->DeadlineMisses(planning->id()), 0);
+  ctx->Shutdown();
+}
+
 TEST(SchedulerChoreoTest, sched_choreo) {
   GlobalData::Instance()->SetProcessGroup("example_sched_choreography");
   auto sched = dynamic_cast<SchedulerChoreography*>(scheduler::Instance());
@@ -68,6 +68,29 @@ TEST(SchedulerTest, notify_task) {
   EXPECT_TRUE(sched->NotifyTask(id));
 }
 
+TEST(SchedulerTest, sched_latency) {
+  auto sched = Instance();
+  cyber::Init("scheduler_test");
+  std::string name = "latency_croutine";
+  EXPECT_TRUE(sched->CreateTask(&proc, name));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  proto::SchedLatency latency;
+  sched->GetSchedLatency(&latency);
+  EXPECT_GT(latency.processor_size(), 0);
+  bool found = false;
+  for (auto& routine : latency.routine()) {
+    if (routine.name() == name) {
+      found = true;
+      EXPECT_EQ(routine.run_time().count(), 1);
+      EXPECT_EQ(routine.run_time().bucket_size(),
+                base::LatencyHistogram::kBucketNum);
+    }
+  }
+  EXPECT_TRUE(found);
+  EXPECT_TRUE(sched->RemoveTask(name));
+}
+
 TEST(SchedulerTest, set_inner_thread_attr) {
   auto sched = Instance();
   cyber::Init("scheduler_test");
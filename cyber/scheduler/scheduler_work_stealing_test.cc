@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/scheduler/policy/scheduler_work_stealing.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/global_data.h"
+#include "cyber/cyber.h"
+#include "cyber/scheduler/policy/work_stealing_context.h"
+
+namespace apollo {
+namespace cyber {
+namespace scheduler {
+
+void func() {}
+
+std::shared_ptr<CRoutine> MakeCRoutine(const std::string& name,
+                                       uint32_t prio) {
+  auto cr = std::make_shared<CRoutine>(func);
+  cr->set_id(common::GlobalData::RegisterTaskName(name));
+  cr->set_name(name);
+  cr->set_priority(prio);
+  return cr;
+}
+
+TEST(WorkStealingContextTest, local_first_then_steal) {
+  WorkStealingContext home;
+  WorkStealingContext thief;
+  std::vector<WorkStealingContext*> peers = {&home, &thief};
+  home.SetPeers(peers);
+  thief.SetPeers(peers);
+
+  auto low = MakeCRoutine("ws_low", 1);
+  auto high = MakeCRoutine("ws_high", 10);
+  EXPECT_TRUE(home.Enqueue(low));
+  EXPECT_TRUE(home.Enqueue(high));
+  EXPECT_EQ(home.CRoutineNum(), 2);
+  EXPECT_EQ(thief.CRoutineNum(), 0);
+
+  // home runs its highest priority croutine
+  auto cr = home.NextRoutine();
+  ASSERT_NE(cr, nullptr);
+  EXPECT_EQ(cr->id(), high->id());
+
+  // while home is busy with it, the thief takes the next ready one
+  auto stolen = thief.NextRoutine();
+  ASSERT_NE(stolen, nullptr);
+  EXPECT_EQ(stolen->id(), low->id());
+  EXPECT_EQ(thief.NextRoutine(), nullptr);
+  stolen->Release();
+  cr->Release();
+
+  EXPECT_TRUE(home.RemoveCRoutine(low));
+  EXPECT_FALSE(home.RemoveCRoutine(low));
+  EXPECT_TRUE(home.RemoveCRoutine(high));
+  EXPECT_EQ(home.CRoutineNum(), 0);
+  EXPECT_EQ(thief.NextRoutine(), nullptr);
+}
+
+TEST(WorkStealingContextTest, notify_idle_peer) {
+  WorkStealingContext home;
+  WorkStealingContext thief;
+  std::vector<WorkStealingContext*> peers = {&home, &thief};
+  home.SetPeers(peers);
+  thief.SetPeers(peers);
+
+  std::thread waiter([&thief]() { thief.Wait(); });
+  while (!thief.Idle()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // home is not waiting, so its notification goes to the idle thief too
+  auto start = std::chrono::steady_clock::now();
+  home.NotifyRoutine();
+  waiter.join();
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(500));
+
+  home.Shutdown();
+  thief.Shutdown();
+  EXPECT_EQ(home.NextRoutine(), nullptr);
+}
+
+}  // namespace scheduler
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  apollo::cyber::Init(argv[0]);
+  auto res = RUN_ALL_TESTS();
+  apollo::cyber::Clear();
+  return res;
+}
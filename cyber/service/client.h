@@ -17,6 +17,8 @@
 #ifndef CYBER_SERVICE_CLIENT_H_
 #define CYBER_SERVICE_CLIENT_H_
 
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <map>
 #include <memory>
@@ -26,10 +28,13 @@
 #include <unordered_map>
 #include <utility>
 
+#include "cyber/base/latency_histogram.h"
 #include "cyber/common/log.h"
 #include "cyber/common/types.h"
+#include "cyber/croutine/croutine.h"
 #include "cyber/node/node_channel_impl.h"
 #include "cyber/service/client_base.h"
+#include "cyber/service/service_transport.h"
 
 namespace apollo {
 namespace cyber {
@@ -41,6 +46,10 @@ namespace cyber {
  * @tparam Request the `Service` request type
  * @tparam Response the `Service` response type
  *
+ * Any number of requests may be outstanding, responses are matched to them
+ * by sequence number. The transports are rtps unless the service is listed
+ * in CYBER_SERVICE_HYBRID_SERVICES, see ServiceTransportMode.
+ *
  * @warning One Client can only request one Service
  */
 template <typename Request, typename Response>
@@ -84,6 +93,10 @@ class Client : public ClientBase {
   /**
    * @brief Request the Service with a shared ptr Request type
    *
+   * Called in a croutine, the croutine sleeps and lets the others of its
+   * processor run until the response or the timeout instead of blocking the
+   * processor thread.
+   *
    * @param request shared ptr of Request type
    * @param timeout_s request timeout, if timeout, response will be empty
    * @return SharedResponse result of this request
@@ -128,6 +141,20 @@ class Client : public ClientBase {
    */
   bool ServiceIsReady() const;
 
+  /**
+   * @brief Round trip times, from sending a request to handling its response
+   */
+  const base::LatencyHistogram& RoundTripLatency() const {
+    return round_trip_latency_;
+  }
+
+  /**
+   * @brief Number of SendRequest calls which timed out
+   */
+  uint64_t TimeoutCount() const {
+    return timeout_count_.load(std::memory_order_relaxed);
+  }
+
   /**
    * @brief destroy this Client
    */
@@ -149,9 +176,18 @@ class Client : public ClientBase {
   }
 
  private:
+  SharedFuture AsyncSendRequest(SharedRequest request, CallbackType&& cb,
+                                uint64_t* sequence_number);
+
   void HandleResponse(const std::shared_ptr<Response>& response,
                       const transport::MessageInfo& request_info);
 
+  static uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
   bool IsInit(void) const { return response_receiver_ != nullptr; }
 
   std::string node_name_;
@@ -160,10 +196,14 @@ class Client : public ClientBase {
                      const transport::MessageInfo&)>
       response_callback_;
 
-  std::unordered_map<uint64_t,
-                     std::tuple<SharedPromise, CallbackType, SharedFuture>>
+  // the last element is the send time in ns
+  std::unordered_map<uint64_t, std::tuple<SharedPromise, CallbackType,
+                                          SharedFuture, uint64_t>>
       pending_requests_;
   std::mutex pending_requests_mutex_;
+  // recorded under pending_requests_mutex_
+  base::LatencyHistogram round_trip_latency_;
+  std::atomic<uint64_t> timeout_count_ = {0};
 
   std::shared_ptr<transport::Transmitter<Request>> request_transmitter_;
   std::shared_ptr<transport::Receiver<Response>> response_receiver_;
@@ -172,10 +212,15 @@ class Client : public ClientBase {
 
   transport::Identity writer_id_;
   uint64_t sequence_number_;
+
+  // last, so that it leaves before the transports go
+  service::ServiceTopology topology_;
 };
 
 template <typename Request, typename Response>
-void Client<Request, Response>::Destroy() {}
+void Client<Request, Response>::Destroy() {
+  topology_.Leave();
+}
 
 template <typename Request, typename Response>
 bool Client<Request, Response>::Init() {
@@ -186,14 +231,19 @@ bool Client<Request, Response>::Init() {
   role.set_channel_id(channel_id);
   role.mutable_qos_profile()->CopyFrom(
       transport::QosProfileConf::QOS_PROFILE_SERVICES_DEFAULT);
+  const auto mode = service::ServiceTransportMode(service_name_);
+  if (mode == proto::OptionalMode::HYBRID) {
+    service::FillProcessAttributes(&role);
+  }
   auto transport = transport::Transport::Instance();
-  request_transmitter_ =
-      transport->CreateTransmitter<Request>(role, proto::OptionalMode::RTPS);
+  request_transmitter_ = transport->CreateTransmitter<Request>(role, mode);
   if (request_transmitter_ == nullptr) {
     AERROR << "Create request pub failed.";
     return false;
   }
   writer_id_ = request_transmitter_->id();
+  proto::RoleAttributes request_attr(role);
+  request_attr.set_id(writer_id_.HashValue());
 
   response_callback_ =
       std::bind(&Client<Request, Response>::HandleResponse, this,
@@ -211,12 +261,33 @@ bool Client<Request, Response>::Init() {
         (void)reader_attr;
         response_callback_(response, message_info);
       },
-      proto::OptionalMode::RTPS);
+      mode);
   if (response_receiver_ == nullptr) {
     AERROR << "Create response sub failed.";
     request_transmitter_.reset();
     return false;
   }
+
+  if (mode == proto::OptionalMode::HYBRID) {
+    role.set_id(response_receiver_->id().HashValue());
+    topology_.Join(
+        request_attr,
+        [this](const proto::RoleAttributes& peer, bool enable) {
+          if (enable) {
+            request_transmitter_->Enable(peer);
+          } else {
+            request_transmitter_->Disable(peer);
+          }
+        },
+        role,
+        [this](const proto::RoleAttributes& peer, bool enable) {
+          if (enable) {
+            response_receiver_->Enable(peer);
+          } else {
+            response_receiver_->Disable(peer);
+          }
+        });
+  }
   return true;
 }
 
@@ -227,16 +298,40 @@ Client<Request, Response>::SendRequest(SharedRequest request,
   if (!IsInit()) {
     return nullptr;
   }
-  auto future = AsyncSendRequest(request);
+  uint64_t sequence_number = 0;
+  auto future =
+      AsyncSendRequest(request, [](SharedFuture) {}, &sequence_number);
   if (!future.valid()) {
     return nullptr;
   }
-  auto status = future.wait_for(timeout_s);
-  if (status == std::future_status::ready) {
-    return future.get();
+
+  bool ready = false;
+  auto routine = croutine::CRoutine::GetCurrentRoutine();
+  if (routine == nullptr) {
+    ready = future.wait_for(timeout_s) == std::future_status::ready;
   } else {
-    return nullptr;
+    // poll interval of a croutine waiting for the response
+    const croutine::Duration wait_interval(200);
+    const auto deadline = std::chrono::steady_clock::now() + timeout_s;
+    while (true) {
+      ready = future.wait_for(std::chrono::seconds(0)) ==
+              std::future_status::ready;
+      if (ready || std::chrono::steady_clock::now() >= deadline) {
+        break;
+      }
+      routine->Sleep(wait_interval);
+    }
+  }
+  if (ready) {
+    return future.get();
   }
+
+  {
+    std::lock_guard<std::mutex> lock(pending_requests_mutex_);
+    pending_requests_.erase(sequence_number);
+  }
+  timeout_count_.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
 }
 
 template <typename Request, typename Response>
@@ -267,15 +362,29 @@ template <typename Request, typename Response>
 typename Client<Request, Response>::SharedFuture
 Client<Request, Response>::AsyncSendRequest(SharedRequest request,
                                             CallbackType&& cb) {
+  return AsyncSendRequest(request, std::forward<CallbackType>(cb), nullptr);
+}
+
+template <typename Request, typename Response>
+typename Client<Request, Response>::SharedFuture
+Client<Request, Response>::AsyncSendRequest(SharedRequest request,
+                                            CallbackType&& cb,
+                                            uint64_t* sequence_number) {
   if (IsInit()) {
     std::lock_guard<std::mutex> lock(pending_requests_mutex_);
     sequence_number_++;
     transport::MessageInfo info(writer_id_, sequence_number_, writer_id_);
+    // a response can not be handled before the pending request is in, the
+    // lock is held
+    const uint64_t send_ns = NowNs();
     request_transmitter_->Transmit(request, info);
     SharedPromise call_promise = std::make_shared<Promise>();
     SharedFuture f(call_promise->get_future());
-    pending_requests_[info.seq_num()] =
-        std::make_tuple(call_promise, std::forward<CallbackType>(cb), f);
+    pending_requests_[info.seq_num()] = std::make_tuple(
+        call_promise, std::forward<CallbackType>(cb), f, send_ns);
+    if (sequence_number != nullptr) {
+      *sequence_number = info.seq_num();
+    }
     return f;
   } else {
     return std::shared_future<std::shared_ptr<Response>>();
@@ -304,6 +413,7 @@ void Client<Request, Response>::HandleResponse(
   auto call_promise = std::get<0>(tuple);
   auto callback = std::get<1>(tuple);
   auto future = std::get<2>(tuple);
+  round_trip_latency_.Record(NowNs() - std::get<3>(tuple));
   this->pending_requests_.erase(sequence_number);
   call_promise->set_value(response);
   callback(future);
@@ -17,15 +17,18 @@
 #ifndef CYBER_SERVICE_SERVICE_H_
 #define CYBER_SERVICE_SERVICE_H_
 
+#include <chrono>
 #include <list>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "cyber/base/latency_histogram.h"
 #include "cyber/common/types.h"
 #include "cyber/node/node_channel_impl.h"
 #include "cyber/scheduler/scheduler.h"
 #include "cyber/service/service_base.h"
+#include "cyber/service/service_transport.h"
 
 namespace apollo {
 namespace cyber {
@@ -90,6 +93,13 @@ class Service : public ServiceBase {
    */
   void destroy();
 
+  /**
+   * @brief Times the service callback took to handle the requests
+   */
+  const base::LatencyHistogram& HandleLatency() const {
+    return handle_latency_;
+  }
+
  private:
   void HandleRequest(const std::shared_ptr<Request>& request,
                      const transport::MessageInfo& message_info);
@@ -110,6 +120,8 @@ class Service : public ServiceBase {
   std::string request_channel_;
   std::string response_channel_;
   std::mutex service_handle_request_mutex_;
+  // recorded under service_handle_request_mutex_
+  base::LatencyHistogram handle_latency_;
 
   volatile bool inited_ = false;
   void Enqueue(std::function<void()>&& task);
@@ -118,10 +130,14 @@ class Service : public ServiceBase {
   std::mutex queue_mutex_;
   std::condition_variable condition_;
   std::list<std::function<void()>> tasks_;
+
+  // last, so that it leaves before the transports go
+  service::ServiceTopology topology_;
 };
 
 template <typename Request, typename Response>
 void Service<Request, Response>::destroy() {
+  topology_.Leave();
   inited_ = false;
   {
     std::lock_guard<std::mutex> lg(queue_mutex_);
@@ -169,13 +185,18 @@ bool Service<Request, Response>::Init() {
   role.set_channel_id(channel_id);
   role.mutable_qos_profile()->CopyFrom(
       transport::QosProfileConf::QOS_PROFILE_SERVICES_DEFAULT);
+  const auto mode = service::ServiceTransportMode(service_name_);
+  if (mode == proto::OptionalMode::HYBRID) {
+    service::FillProcessAttributes(&role);
+  }
   auto transport = transport::Transport::Instance();
-  response_transmitter_ =
-      transport->CreateTransmitter<Response>(role, proto::OptionalMode::RTPS);
+  response_transmitter_ = transport->CreateTransmitter<Response>(role, mode);
   if (response_transmitter_ == nullptr) {
     AERROR << " Create response pub failed.";
     return false;
   }
+  proto::RoleAttributes response_attr(role);
+  response_attr.set_id(response_transmitter_->id().HashValue());
 
   request_callback_ =
       std::bind(&Service<Request, Response>::HandleRequest, this,
@@ -195,7 +216,7 @@ bool Service<Request, Response>::Init() {
         };
         Enqueue(std::move(task));
       },
-      proto::OptionalMode::RTPS);
+      mode);
   inited_ = true;
   thread_ = std::thread(&Service<Request, Response>::Process, this);
   if (request_receiver_ == nullptr) {
@@ -203,6 +224,27 @@ bool Service<Request, Response>::Init() {
     response_transmitter_.reset();
     return false;
   }
+
+  if (mode == proto::OptionalMode::HYBRID) {
+    role.set_id(request_receiver_->id().HashValue());
+    topology_.Join(
+        response_attr,
+        [this](const proto::RoleAttributes& peer, bool enable) {
+          if (enable) {
+            response_transmitter_->Enable(peer);
+          } else {
+            response_transmitter_->Disable(peer);
+          }
+        },
+        role,
+        [this](const proto::RoleAttributes& peer, bool enable) {
+          if (enable) {
+            request_receiver_->Enable(peer);
+          } else {
+            request_receiver_->Disable(peer);
+          }
+        });
+  }
   return true;
 }
 
@@ -217,7 +259,11 @@ void Service<Request, Response>::HandleRequest(
   ADEBUG << "handling request:" << request_channel_;
   std::lock_guard<std::mutex> lk(service_handle_request_mutex_);
   auto response = std::make_shared<Response>();
+  const auto start = std::chrono::steady_clock::now();
   service_callback_(request, response);
+  handle_latency_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count());
   transport::MessageInfo msg_info(message_info);
   msg_info.set_sender_id(response_transmitter_->id());
   SendResponse(msg_info, response);
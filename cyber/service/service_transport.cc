@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/service/service_transport.h"
+
+#include <sstream>
+#include <vector>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace service {
+
+using common::GlobalData;
+using proto::OptionalMode;
+using proto::RoleAttributes;
+using proto::RoleType;
+
+OptionalMode ServiceTransportMode(const std::string& service_name) {
+  std::stringstream services(common::GetEnv("CYBER_SERVICE_HYBRID_SERVICES"));
+  std::string service;
+  while (std::getline(services, service, ',')) {
+    if (service == "*" || service == service_name) {
+      return OptionalMode::HYBRID;
+    }
+  }
+  return OptionalMode::RTPS;
+}
+
+void FillProcessAttributes(RoleAttributes* attr) {
+  attr->set_host_name(GlobalData::Instance()->HostName());
+  attr->set_host_ip(GlobalData::Instance()->HostIp());
+  attr->set_process_id(GlobalData::Instance()->ProcessId());
+}
+
+void ServiceTopology::Join(const RoleAttributes& writer_attr,
+                           const EnableFunc& on_reader,
+                           const RoleAttributes& reader_attr,
+                           const EnableFunc& on_writer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (joined_) {
+    return;
+  }
+  writer_attr_ = writer_attr;
+  reader_attr_ = reader_attr;
+  on_reader_ = on_reader;
+  on_writer_ = on_writer;
+  channel_manager_ =
+      service_discovery::TopologyManager::Instance()->channel_manager();
+  // enabling a peer twice is harmless, missing the change of one is not
+  joined_ = true;
+  change_conn_ = channel_manager_->AddChangeListener(std::bind(
+      &ServiceTopology::OnChannelChange, this, std::placeholders::_1));
+
+  std::vector<RoleAttributes> peers;
+  channel_manager_->GetReadersOfChannel(writer_attr_.channel_name(), &peers);
+  for (auto& peer : peers) {
+    on_reader_(peer, true);
+  }
+  peers.clear();
+  channel_manager_->GetWritersOfChannel(reader_attr_.channel_name(), &peers);
+  for (auto& peer : peers) {
+    on_writer_(peer, true);
+  }
+
+  channel_manager_->Join(writer_attr_, RoleType::ROLE_WRITER);
+  channel_manager_->Join(reader_attr_, RoleType::ROLE_READER);
+  ADEBUG << "service channels " << writer_attr_.channel_name() << " and "
+         << reader_attr_.channel_name() << " joined the topology.";
+}
+
+void ServiceTopology::Leave() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!joined_) {
+    return;
+  }
+  joined_ = false;
+  channel_manager_->RemoveChangeListener(change_conn_);
+  channel_manager_->Leave(writer_attr_, RoleType::ROLE_WRITER);
+  channel_manager_->Leave(reader_attr_, RoleType::ROLE_READER);
+  channel_manager_ = nullptr;
+}
+
+void ServiceTopology::OnChannelChange(const proto::ChangeMsg& change_msg) {
+  if (!joined_) {
+    return;
+  }
+  auto& peer_attr = change_msg.role_attr();
+  const bool enable =
+      change_msg.operate_type() == proto::OperateType::OPT_JOIN;
+  if (change_msg.role_type() == RoleType::ROLE_READER &&
+      peer_attr.channel_name() == writer_attr_.channel_name()) {
+    on_reader_(peer_attr, enable);
+  } else if (change_msg.role_type() == RoleType::ROLE_WRITER &&
+             peer_attr.channel_name() == reader_attr_.channel_name()) {
+    on_writer_(peer_attr, enable);
+  }
+}
+
+}  // namespace service
+}  // namespace cyber
+}  // namespace apollo
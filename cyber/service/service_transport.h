@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SERVICE_SERVICE_TRANSPORT_H_
+#define CYBER_SERVICE_SERVICE_TRANSPORT_H_
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "cyber/proto/role_attributes.pb.h"
+
+#include "cyber/common/macros.h"
+#include "cyber/service_discovery/topology_manager.h"
+
+namespace apollo {
+namespace cyber {
+namespace service {
+
+// The mode of the request and response transports of a service. A service
+// listed in CYBER_SERVICE_HYBRID_SERVICES (comma separated, "*" for all)
+// uses the hybrid transports, that is intra in the same process, shm on the
+// same host and rtps otherwise. The others stay on rtps. The service and its
+// clients must agree, so set it the same for all processes.
+proto::OptionalMode ServiceTransportMode(const std::string& service_name);
+
+// Fills the host and process of a role like the node does for its writers
+// and readers, the hybrid transports pick the transport from them.
+void FillProcessAttributes(proto::RoleAttributes* attr);
+
+// Keeps the transmitter and the receiver of a service or a client in the
+// channel topology, as Writer and Reader do, so that hybrid ones are enabled
+// for their peers. The rtps transports find their peers by themselves and do
+// not need it.
+class ServiceTopology {
+ public:
+  using EnableFunc =
+      std::function<void(const proto::RoleAttributes& peer, bool enable)>;
+
+  ServiceTopology() = default;
+  ~ServiceTopology() { Leave(); }
+
+  // on_reader is called for the readers of the channel of writer_attr,
+  // on_writer for the writers of the channel of reader_attr
+  void Join(const proto::RoleAttributes& writer_attr,
+            const EnableFunc& on_reader,
+            const proto::RoleAttributes& reader_attr,
+            const EnableFunc& on_writer);
+  void Leave();
+
+ private:
+  void OnChannelChange(const proto::ChangeMsg& change_msg);
+
+  // Join and Leave notify the listeners, OnChannelChange included, in the
+  // calling thread, so it does not take the mutex
+  std::mutex mutex_;
+  std::atomic<bool> joined_ = {false};
+  proto::RoleAttributes writer_attr_;
+  proto::RoleAttributes reader_attr_;
+  EnableFunc on_reader_;
+  EnableFunc on_writer_;
+  service_discovery::ChannelManagerPtr channel_manager_ = nullptr;
+  service_discovery::Manager::ChangeConnection change_conn_;
+
+  DISALLOW_COPY_AND_ASSIGN(ServiceTopology)
+};
+
+}  // namespace service
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SERVICE_SERVICE_TRANSPORT_H_
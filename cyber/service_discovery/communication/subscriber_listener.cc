@@ -41,7 +41,7 @@ void SubscriberListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
   RETURN_IF(!sub->takeNextData(reinterpret_cast<void*>(&m), &m_info));
   RETURN_IF(m_info.sampleKind != eprosima::fastrtps::ALIVE);
 
-  callback_(m.data());
+  callback_(m.data(), m.datatype());
 }
 
 void SubscriberListener::onSubscriptionMatched(
@@ -32,7 +32,9 @@ namespace service_discovery {
 
 class SubscriberListener : public eprosima::fastrtps::SubscriberListener {
  public:
-  using NewMsgCallback = std::function<void(const std::string&)>;
+  // called with the payload and the datatype it was published with
+  using NewMsgCallback =
+      std::function<void(const std::string&, const std::string&)>;
 
   explicit SubscriberListener(const NewMsgCallback& callback);
   virtual ~SubscriberListener();
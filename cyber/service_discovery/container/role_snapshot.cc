@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/service_discovery/container/role_snapshot.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+using proto::ChangeMsg;
+using proto::OperateType;
+using proto::RoleType;
+using proto::TopologyUpdate;
+
+RoleSnapshot::Key RoleSnapshot::KeyOf(const ChangeMsg& msg) {
+  auto& attr = msg.role_attr();
+  if (attr.has_id()) {
+    return Key(msg.role_type(), attr.id());
+  }
+  if (msg.role_type() == RoleType::ROLE_NODE) {
+    return Key(msg.role_type(), attr.node_id());
+  }
+  return Key(msg.role_type(), attr.service_id());
+}
+
+bool RoleSnapshot::Update(const ChangeMsg& msg) {
+  auto key = KeyOf(msg);
+  if (msg.operate_type() == OperateType::OPT_JOIN) {
+    roles_[key] = msg;
+    return true;
+  }
+  return roles_.erase(key) > 0;
+}
+
+uint64_t RoleSnapshot::Record(const ChangeMsg& msg) {
+  Update(msg);
+  return ++version_;
+}
+
+void RoleSnapshot::Fill(TopologyUpdate* update) const {
+  update->set_version(version_);
+  update->set_snapshot(true);
+  update->clear_change();
+  for (auto& item : roles_) {
+    update->add_change()->CopyFrom(item.second);
+  }
+}
+
+bool RoleSnapshot::ApplyDelta(const TopologyUpdate& update,
+                              std::vector<ChangeMsg>* changes) {
+  if (update.version() <= version_) {
+    return true;
+  }
+  if (update.version() != version_ + 1) {
+    return false;
+  }
+  for (auto& change : update.change()) {
+    Update(change);
+    changes->emplace_back(change);
+  }
+  version_ = update.version();
+  return true;
+}
+
+void RoleSnapshot::ApplySnapshot(const TopologyUpdate& update,
+                                 std::vector<ChangeMsg>* changes) {
+  if (update.version() <= version_) {
+    return;
+  }
+
+  std::map<Key, ChangeMsg> roles;
+  for (auto& change : update.change()) {
+    roles[KeyOf(change)] = change;
+  }
+  for (auto& item : roles_) {
+    if (roles.count(item.first) == 0) {
+      ChangeMsg leave(item.second);
+      leave.set_operate_type(OperateType::OPT_LEAVE);
+      changes->emplace_back(std::move(leave));
+    }
+  }
+  for (auto& item : roles) {
+    if (roles_.count(item.first) == 0) {
+      changes->emplace_back(item.second);
+    }
+  }
+  roles_.swap(roles);
+  version_ = update.version();
+}
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
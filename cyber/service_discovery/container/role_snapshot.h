@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SERVICE_DISCOVERY_CONTAINER_ROLE_SNAPSHOT_H_
+#define CYBER_SERVICE_DISCOVERY_CONTAINER_ROLE_SNAPSHOT_H_
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "cyber/proto/topology_change.pb.h"
+#include "cyber/proto/topology_update.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+/**
+ * @class RoleSnapshot
+ * @brief The roles alive in one process and the version they are at.
+ * The publishing side records its own changes, the receiving side follows
+ * the deltas and snapshots of a remote process and works out which joins
+ * and leaves it has to dispose. Not thread safe.
+ */
+class RoleSnapshot {
+ public:
+  using Key = std::pair<int, uint64_t>;
+
+  RoleSnapshot() {}
+
+  static Key KeyOf(const proto::ChangeMsg& msg);
+
+  /**
+   * @brief Record a local change
+   * @return the version after the change
+   */
+  uint64_t Record(const proto::ChangeMsg& msg);
+
+  /**
+   * @brief Fill update with all the roles at the current version
+   */
+  void Fill(proto::TopologyUpdate* update) const;
+
+  /**
+   * @brief Follow a delta of the remote process
+   * @param changes the changes to dispose are appended, none if the delta
+   * has been seen already
+   * @return false if versions are missing before this delta, it has to wait
+   * for the next snapshot then
+   */
+  bool ApplyDelta(const proto::TopologyUpdate& update,
+                  std::vector<proto::ChangeMsg>* changes);
+
+  /**
+   * @brief Move to the snapshot of the remote process
+   * @param changes the joins of roles not known so far and the leaves of
+   * roles gone are appended, roles already known are left alone
+   */
+  void ApplySnapshot(const proto::TopologyUpdate& update,
+                     std::vector<proto::ChangeMsg>* changes);
+
+  uint64_t version() const { return version_; }
+  std::size_t size() const { return roles_.size(); }
+
+ private:
+  bool Update(const proto::ChangeMsg& msg);
+
+  uint64_t version_ = 0;
+  // joins of the roles alive
+  std::map<Key, proto::ChangeMsg> roles_;
+};
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SERVICE_DISCOVERY_CONTAINER_ROLE_SNAPSHOT_H_
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/service_discovery/container/role_snapshot.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+using proto::ChangeMsg;
+using proto::OperateType;
+using proto::RoleType;
+using proto::TopologyUpdate;
+
+namespace {
+ChangeMsg MakeChange(RoleType role, uint64_t id, OperateType opt) {
+  ChangeMsg msg;
+  msg.set_change_type(proto::ChangeType::CHANGE_CHANNEL);
+  msg.set_operate_type(opt);
+  msg.set_role_type(role);
+  msg.mutable_role_attr()->set_channel_name("channel");
+  msg.mutable_role_attr()->set_id(id);
+  return msg;
+}
+
+TopologyUpdate MakeDelta(uint64_t version, const ChangeMsg& msg) {
+  TopologyUpdate update;
+  update.set_version(version);
+  update.add_change()->CopyFrom(msg);
+  return update;
+}
+}  // namespace
+
+TEST(RoleSnapshotTest, key_of) {
+  ChangeMsg writer =
+      MakeChange(RoleType::ROLE_WRITER, 1, OperateType::OPT_JOIN);
+  ChangeMsg reader =
+      MakeChange(RoleType::ROLE_READER, 1, OperateType::OPT_JOIN);
+  EXPECT_NE(RoleSnapshot::KeyOf(writer), RoleSnapshot::KeyOf(reader));
+
+  ChangeMsg node;
+  node.set_role_type(RoleType::ROLE_NODE);
+  node.mutable_role_attr()->set_node_id(7);
+  EXPECT_EQ(RoleSnapshot::KeyOf(node).second, 7);
+}
+
+TEST(RoleSnapshotTest, record_and_fill) {
+  RoleSnapshot local;
+  EXPECT_EQ(local.Record(
+                MakeChange(RoleType::ROLE_WRITER, 1, OperateType::OPT_JOIN)),
+            1);
+  EXPECT_EQ(local.Record(
+                MakeChange(RoleType::ROLE_READER, 2, OperateType::OPT_JOIN)),
+            2);
+  EXPECT_EQ(local.Record(
+                MakeChange(RoleType::ROLE_WRITER, 1, OperateType::OPT_LEAVE)),
+            3);
+  EXPECT_EQ(local.size(), 1);
+
+  TopologyUpdate update;
+  local.Fill(&update);
+  EXPECT_TRUE(update.snapshot());
+  EXPECT_EQ(update.version(), 3);
+  ASSERT_EQ(update.change_size(), 1);
+  EXPECT_EQ(update.change(0).role_attr().id(), 2);
+}
+
+TEST(RoleSnapshotTest, apply_delta) {
+  RoleSnapshot remote;
+  std::vector<ChangeMsg> changes;
+  auto join = MakeChange(RoleType::ROLE_WRITER, 1, OperateType::OPT_JOIN);
+  EXPECT_TRUE(remote.ApplyDelta(MakeDelta(1, join), &changes));
+  EXPECT_EQ(changes.size(), 1);
+  EXPECT_EQ(remote.version(), 1);
+
+  // already seen
+  changes.clear();
+  EXPECT_TRUE(remote.ApplyDelta(MakeDelta(1, join), &changes));
+  EXPECT_TRUE(changes.empty());
+
+  // version 2 is missing
+  auto leave = MakeChange(RoleType::ROLE_WRITER, 1, OperateType::OPT_LEAVE);
+  EXPECT_FALSE(remote.ApplyDelta(MakeDelta(3, leave), &changes));
+  EXPECT_TRUE(changes.empty());
+  EXPECT_EQ(remote.version(), 1);
+  EXPECT_EQ(remote.size(), 1);
+}
+
+TEST(RoleSnapshotTest, apply_snapshot) {
+  RoleSnapshot local;
+  RoleSnapshot remote;
+  std::vector<ChangeMsg> changes;
+  auto w1 = MakeChange(RoleType::ROLE_WRITER, 1, OperateType::OPT_JOIN);
+  auto r2 = MakeChange(RoleType::ROLE_READER, 2, OperateType::OPT_JOIN);
+  auto r3 = MakeChange(RoleType::ROLE_READER, 3, OperateType::OPT_JOIN);
+  local.Record(w1);
+  EXPECT_TRUE(remote.ApplyDelta(MakeDelta(1, w1), &changes));
+  local.Record(r2);
+  EXPECT_TRUE(remote.ApplyDelta(MakeDelta(2, r2), &changes));
+
+  // the remote misses the leave of w1 and the join of r3
+  local.Record(MakeChange(RoleType::ROLE_WRITER, 1, OperateType::OPT_LEAVE));
+  local.Record(r3);
+  TopologyUpdate snapshot;
+  local.Fill(&snapshot);
+
+  changes.clear();
+  remote.ApplySnapshot(snapshot, &changes);
+  ASSERT_EQ(changes.size(), 2);
+  EXPECT_EQ(changes[0].operate_type(), OperateType::OPT_LEAVE);
+  EXPECT_EQ(changes[0].role_attr().id(), 1);
+  EXPECT_EQ(changes[1].operate_type(), OperateType::OPT_JOIN);
+  EXPECT_EQ(changes[1].role_attr().id(), 3);
+  EXPECT_EQ(remote.version(), 4);
+  EXPECT_EQ(remote.size(), 2);
+
+  // an older snapshot changes nothing
+  changes.clear();
+  snapshot.set_version(3);
+  remote.ApplySnapshot(snapshot, &changes);
+  EXPECT_TRUE(changes.empty());
+
+  // deltas after the snapshot go on from its version
+  auto leave = MakeChange(RoleType::ROLE_READER, 2, OperateType::OPT_LEAVE);
+  EXPECT_TRUE(remote.ApplyDelta(MakeDelta(5, leave), &changes));
+  EXPECT_EQ(remote.size(), 1);
+}
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "cyber/service_discovery/specific_manager/manager.h"
 
+#include <vector>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
@@ -29,9 +31,24 @@ namespace apollo {
 namespace cyber {
 namespace service_discovery {
 
+using proto::TopologyUpdate;
 using transport::AttributesFiller;
 using transport::QosProfileConf;
 
+namespace {
+// datatype of the samples carrying a TopologyUpdate, plain ChangeMsg from
+// older processes come without one
+const char kTopologyUpdateType[] = "cyber.topo_update";
+// a snapshot follows every this many deltas, which has to stay below the
+// history depth of QOS_PROFILE_TOPO_CHANGE so that a late joiner always
+// finds one
+const uint64_t kSnapshotInterval = 8;
+
+std::string ProcessKey(const std::string& host_name, int process_id) {
+  return host_name + "+" + std::to_string(process_id);
+}
+}  // namespace
+
 Manager::Manager()
     : is_shutdown_(false),
       is_discovery_started_(false),
@@ -154,8 +171,9 @@ bool Manager::CreateSubscriber(RtpsParticipant* participant) {
       !AttributesFiller::FillInSubAttr(
           channel_name_, QosProfileConf::QOS_PROFILE_TOPO_CHANGE, &sub_attr),
       false);
-  listener_ = new SubscriberListener(
-      std::bind(&Manager::OnRemoteChange, this, std::placeholders::_1));
+  listener_ = new SubscriberListener(std::bind(&Manager::OnRemoteChange, this,
+                                               std::placeholders::_1,
+                                               std::placeholders::_2));
 
   subscriber_ = eprosima::fastrtps::Domain::createSubscriber(
       participant, sub_attr, listener_);
@@ -185,12 +203,18 @@ void Manager::Convert(const RoleAttributes& attr, RoleType role,
 
 void Manager::Notify(const ChangeMsg& msg) { signal_(msg); }
 
-void Manager::OnRemoteChange(const std::string& msg_str) {
+void Manager::OnRemoteChange(const std::string& msg_str,
+                             const std::string& datatype) {
   if (is_shutdown_.load()) {
     ADEBUG << "the manager has been shut down.";
     return;
   }
 
+  if (datatype == kTopologyUpdateType) {
+    OnRemoteUpdate(msg_str);
+    return;
+  }
+
   ChangeMsg msg;
   RETURN_IF(!message::ParseFromString(msg_str, &msg));
   if (IsFromSameProcess(msg)) {
@@ -200,23 +224,74 @@ void Manager::OnRemoteChange(const std::string& msg_str) {
   Dispose(msg);
 }
 
+void Manager::OnRemoteUpdate(const std::string& msg_str) {
+  TopologyUpdate update;
+  RETURN_IF(!message::ParseFromString(msg_str, &update));
+  if (update.process_id() == process_id_ &&
+      update.host_name() == host_name_) {
+    return;
+  }
+
+  std::vector<ChangeMsg> changes;
+  {
+    std::lock_guard<std::mutex> lg(remote_lock_);
+    auto& roles =
+        remote_roles_[ProcessKey(update.host_name(), update.process_id())];
+    if (update.snapshot()) {
+      roles.ApplySnapshot(update, &changes);
+    } else if (!roles.ApplyDelta(update, &changes)) {
+      ADEBUG << "topology of " << update.host_name() << "+"
+             << update.process_id() << " at version " << roles.version()
+             << " missed deltas before " << update.version()
+             << ", wait for a snapshot.";
+      return;
+    }
+  }
+
+  for (auto& change : changes) {
+    if (!Check(change.role_attr())) {
+      continue;
+    }
+    Dispose(change);
+  }
+}
+
+void Manager::ForgetProcess(const std::string& host_name, int process_id) {
+  std::lock_guard<std::mutex> lg(remote_lock_);
+  remote_roles_.erase(ProcessKey(host_name, process_id));
+}
+
 bool Manager::Publish(const ChangeMsg& msg) {
+  std::lock_guard<std::mutex> lg(lock_);
+  TopologyUpdate update;
+  update.set_host_name(host_name_);
+  update.set_process_id(process_id_);
+  update.set_version(local_roles_.Record(msg));
+  update.add_change()->CopyFrom(msg);
+
   if (!is_discovery_started_.load()) {
     ADEBUG << "discovery is not started.";
     return false;
   }
 
-  apollo::cyber::transport::UnderlayMessage m;
-  RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
-  {
-    std::lock_guard<std::mutex> lg(lock_);
-    if (publisher_ != nullptr) {
-      return publisher_->write(reinterpret_cast<void*>(&m));
-    }
+  RETURN_VAL_IF(!Write(update), false);
+  if (update.version() % kSnapshotInterval == 0) {
+    local_roles_.Fill(&update);
+    RETURN_VAL_IF(!Write(update), false);
   }
   return true;
 }
 
+bool Manager::Write(const TopologyUpdate& update) {
+  if (publisher_ == nullptr) {
+    return true;
+  }
+  apollo::cyber::transport::UnderlayMessage m;
+  RETURN_VAL_IF(!message::SerializeToString(update, &m.data()), false);
+  m.datatype() = kTopologyUpdateType;
+  return publisher_->write(reinterpret_cast<void*>(&m));
+}
+
 bool Manager::IsFromSameProcess(const ChangeMsg& msg) {
   auto& host_name = msg.role_attr().host_name();
   int process_id = msg.role_attr().process_id();
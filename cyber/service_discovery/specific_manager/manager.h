@@ -21,6 +21,7 @@
 #include <functional>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/PublisherAttributes.h"
@@ -31,7 +32,9 @@
 
 #include "cyber/base/signal.h"
 #include "cyber/proto/topology_change.pb.h"
+#include "cyber/proto/topology_update.pb.h"
 #include "cyber/service_discovery/communication/subscriber_listener.h"
+#include "cyber/service_discovery/container/role_snapshot.h"
 
 namespace apollo {
 namespace cyber {
@@ -148,8 +151,13 @@ class Manager {
 
   void Notify(const ChangeMsg& msg);
   bool Publish(const ChangeMsg& msg);
-  void OnRemoteChange(const std::string& msg_str);
+  bool Write(const proto::TopologyUpdate& update);
+  void OnRemoteChange(const std::string& msg_str,
+                      const std::string& datatype);
+  void OnRemoteUpdate(const std::string& msg_str);
   bool IsFromSameProcess(const ChangeMsg& msg);
+  // drops what is known about the roles of a process that has gone
+  void ForgetProcess(const std::string& host_name, int process_id);
 
   std::atomic<bool> is_shutdown_;
   std::atomic<bool> is_discovery_started_;
@@ -163,6 +171,12 @@ class Manager {
   eprosima::fastrtps::Subscriber* subscriber_;
   SubscriberListener* listener_;
 
+  // roles of this process, guarded by lock_
+  RoleSnapshot local_roles_;
+  // key: host_name + process_id
+  std::unordered_map<std::string, RoleSnapshot> remote_roles_;
+  std::mutex remote_lock_;
+
   ChangeSignal signal_;
 };
 
@@ -60,6 +60,7 @@ void NodeManager::Dispose(const ChangeMsg& msg) {
 void NodeManager::OnTopoModuleLeave(const std::string& host_name,
                                     int process_id) {
   RETURN_IF(!is_discovery_started_.load());
+  ForgetProcess(host_name, process_id);
 
   RoleAttributes attr;
   attr.set_host_name(host_name);
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/stack_sampler.h"
+
+#include <cxxabi.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+// the frames of the handler itself and of the signal trampoline
+const int kSkippedFrames = 2;
+
+std::atomic<pid_t> target_tid = {0};
+std::atomic<int> sampled_depth = {-1};
+void* sampled_frames[StackSampler::kMaxFrames + kSkippedFrames];
+
+void OnSampleSignal(int, siginfo_t*, void*) {
+  const int saved_errno = errno;
+  if (static_cast<pid_t>(syscall(SYS_gettid)) == target_tid.load()) {
+    int depth = backtrace(sampled_frames,
+                          StackSampler::kMaxFrames + kSkippedFrames);
+    sampled_depth.store(depth);
+  }
+  errno = saved_errno;
+}
+
+// "binary(mangled+0x10) [0x...]" to "binary(demangled+0x10) [0x...]"
+std::string Demangle(const char* symbol) {
+  std::string frame(symbol);
+  const auto begin = frame.find('(');
+  const auto end = frame.find('+', begin);
+  if (begin == std::string::npos || end == std::string::npos ||
+      end == begin + 1) {
+    return frame;
+  }
+  const std::string mangled = frame.substr(begin + 1, end - begin - 1);
+  int status = 0;
+  char* demangled =
+      abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+  if (status != 0 || demangled == nullptr) {
+    return frame;
+  }
+  frame.replace(begin + 1, mangled.size(), demangled);
+  std::free(demangled);
+  return frame;
+}
+
+}  // namespace
+
+int StackSampler::Signal() { return SIGRTMIN + 4; }
+
+bool StackSampler::Init() {
+  if (inited_) {
+    return true;
+  }
+  struct sigaction old_action;
+  if (sigaction(Signal(), nullptr, &old_action) != 0) {
+    AERROR << "query the sampling signal failed: " << std::strerror(errno);
+    return false;
+  }
+  if ((old_action.sa_flags & SA_SIGINFO) != 0 ||
+      old_action.sa_handler != SIG_DFL) {
+    AERROR << "signal " << Signal() << " is already handled, no stack samples.";
+    return false;
+  }
+
+  // the first backtrace loads the unwinder, which may allocate, so it must
+  // not happen in the handler
+  void* frame = nullptr;
+  backtrace(&frame, 1);
+
+  struct sigaction action;
+  std::memset(&action, 0, sizeof(action));
+  action.sa_sigaction = OnSampleSignal;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(Signal(), &action, nullptr) != 0) {
+    AERROR << "install the sampling handler failed: " << std::strerror(errno);
+    return false;
+  }
+  inited_ = true;
+  return true;
+}
+
+bool StackSampler::Sample(pid_t tid, std::vector<std::string>* frames) {
+  frames->clear();
+  if (!inited_) {
+    return false;
+  }
+  sampled_depth.store(-1);
+  target_tid.store(tid);
+  if (syscall(SYS_tgkill, getpid(), tid, Signal()) != 0) {
+    target_tid.store(0);
+    return false;
+  }
+
+  // a running thread takes the signal right away, a blocked one on wake up
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+  int depth = -1;
+  while ((depth = sampled_depth.load()) < 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  target_tid.store(0);
+  if (depth < 0) {
+    return false;
+  }
+
+  char** symbols = backtrace_symbols(sampled_frames, depth);
+  if (symbols == nullptr) {
+    return false;
+  }
+  for (int i = kSkippedFrames; i < depth; ++i) {
+    frames->emplace_back(Demangle(symbols[i]));
+  }
+  std::free(symbols);
+  return true;
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SYSMO_STACK_SAMPLER_H_
+#define CYBER_SYSMO_STACK_SAMPLER_H_
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+
+// Samples the stack of another thread of the process: the thread is sent
+// SIGRTMIN + 4 and records its own backtrace in the handler, which is what it
+// was running, croutine stack included. One sample at a time, from one
+// thread.
+class StackSampler {
+ public:
+  static const int kMaxFrames = 64;
+
+  // installs the handler, false if the signal is already handled
+  bool Init();
+
+  // the frames of tid, innermost first, false if it did not answer in time
+  bool Sample(pid_t tid, std::vector<std::string>* frames);
+
+  static int Signal();
+
+ private:
+  bool inited_ = false;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SYSMO_STACK_SAMPLER_H_
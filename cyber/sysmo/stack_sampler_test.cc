@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/sysmo/stack_sampler.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+std::atomic<bool> spinning = {true};
+
+__attribute__((noinline)) void SpinForSample() {
+  while (spinning.load()) {
+    asm volatile("");
+  }
+}
+
+TEST(StackSamplerTest, sample) {
+  std::atomic<pid_t> tid = {0};
+  std::thread spinner([&tid]() {
+    tid.store(static_cast<pid_t>(syscall(SYS_gettid)));
+    SpinForSample();
+  });
+  while (tid.load() == 0) {
+    std::this_thread::yield();
+  }
+
+  StackSampler sampler;
+  std::vector<std::string> frames;
+  EXPECT_FALSE(sampler.Sample(tid.load(), &frames));
+  ASSERT_TRUE(sampler.Init());
+  ASSERT_TRUE(sampler.Sample(tid.load(), &frames));
+  bool found = false;
+  for (auto& frame : frames) {
+    found = found || frame.find("SpinForSample") != std::string::npos;
+  }
+  EXPECT_TRUE(found);
+
+  spinning.store(false);
+  spinner.join();
+  // the thread is gone
+  EXPECT_FALSE(sampler.Sample(tid.load(), &frames));
+}
+
+}  // namespace cyber
+}  // namespace apollo
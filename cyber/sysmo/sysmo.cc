@@ -16,18 +16,61 @@
 
 #include "cyber/sysmo/sysmo.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "cyber/binary.h"
 #include "cyber/common/environment.h"
+#include "cyber/scheduler/processor.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/common/transport_stats.h"
 
 namespace apollo {
 namespace cyber {
 
 using apollo::cyber::common::GetEnv;
 
+namespace {
+const char kSchedLatencyChannel[] = "/apollo/cyber/sched_latency";
+const char kSchedLatencyNode[] = "sched_latency";
+const char kTransportStatsChannel[] = "/apollo/cyber/transport_stats";
+const char kSchedStallChannel[] = "/apollo/cyber/sched_stall";
+
+uint64_t SteadyNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+}  // namespace
+
 SysMo::SysMo() { Start(); }
 
 void SysMo::Start() {
   auto sysmo_start = GetEnv("sysmo_start");
   if (sysmo_start != "" && std::stoi(sysmo_start)) {
+    check_sched_status_ = true;
+  }
+  auto sched_latency_start = GetEnv("sched_latency_start");
+  if (sched_latency_start != "" && std::stoi(sched_latency_start)) {
+    publish_sched_latency_ = true;
+  }
+  auto transport_stats_start = GetEnv("transport_stats_start");
+  if (transport_stats_start != "" && std::stoi(transport_stats_start)) {
+    publish_transport_stats_ = true;
+  }
+  auto sched_stall_ms = GetEnv("sched_stall_ms");
+  if (sched_stall_ms != "" && std::stoi(sched_stall_ms) > 0) {
+    stall_threshold_ms_ = std::stoi(sched_stall_ms);
+    auto sched_stall_stack = GetEnv("sched_stall_stack");
+    if (sched_stall_stack != "" && std::stoi(sched_stall_stack)) {
+      sample_stall_stack_ = stack_sampler_.Init();
+    }
+    last_stall_report_ns_ = SteadyNow();
+  }
+  if (check_sched_status_ || publish_sched_latency_ ||
+      publish_transport_stats_ || stall_threshold_ms_ > 0) {
     start_ = true;
     sysmo_ = std::thread(&SysMo::Checker, this);
   }
@@ -42,15 +85,168 @@ void SysMo::Shutdown() {
   if (sysmo_.joinable()) {
     sysmo_.join();
   }
+  latency_writer_ = nullptr;
+  stats_writer_ = nullptr;
+  stall_writer_ = nullptr;
+  node_ = nullptr;
 }
 
 void SysMo::Checker() {
+  auto next_publish = std::chrono::steady_clock::now();
   while (cyber_unlikely(!shut_down_.load())) {
-    scheduler::Instance()->CheckSchedStatus();
+    if (check_sched_status_) {
+      scheduler::Instance()->CheckSchedStatus();
+    }
+    if (stall_threshold_ms_ > 0) {
+      CheckStalls();
+    }
+    if ((publish_sched_latency_ || publish_transport_stats_ ||
+         stall_threshold_ms_ > 0) &&
+        std::chrono::steady_clock::now() >= next_publish) {
+      if (publish_sched_latency_) {
+        PublishSchedLatency();
+      }
+      if (publish_transport_stats_) {
+        PublishTransportStats();
+      }
+      if (stall_threshold_ms_ > 0) {
+        PublishSchedStall();
+      }
+      next_publish += std::chrono::milliseconds(sched_latency_interval_ms_);
+    }
     std::unique_lock<std::mutex> lk(lk_);
     cv_.wait_for(lk, std::chrono::milliseconds(sysmo_interval_ms_));
   }
 }
 
+Node* SysMo::GetNode() {
+  if (node_ == nullptr) {
+    node_.reset(new Node(kSchedLatencyNode + std::to_string(getpid())));
+  }
+  return node_.get();
+}
+
+void SysMo::PublishSchedLatency() {
+  if (latency_writer_ == nullptr) {
+    latency_writer_ =
+        GetNode()->CreateWriter<proto::SchedLatency>(kSchedLatencyChannel);
+    if (latency_writer_ == nullptr) {
+      AERROR << "create sched latency writer failed.";
+      publish_sched_latency_ = false;
+      return;
+    }
+  }
+
+  auto latency = std::make_shared<proto::SchedLatency>();
+  latency->set_process_name(binary::GetName());
+  latency->set_pid(getpid());
+  scheduler::Instance()->GetSchedLatency(latency.get());
+  latency_writer_->Write(latency);
+}
+
+void SysMo::PublishTransportStats() {
+  if (stats_writer_ == nullptr) {
+    stats_writer_ =
+        GetNode()->CreateWriter<proto::TransportStats>(kTransportStatsChannel);
+    if (stats_writer_ == nullptr) {
+      AERROR << "create transport stats writer failed.";
+      publish_transport_stats_ = false;
+      return;
+    }
+  }
+
+  auto stats = std::make_shared<proto::TransportStats>();
+  stats->set_process_name(binary::GetName());
+  stats->set_pid(getpid());
+  transport::TransportStats::Instance()->Collect(stats.get());
+  stats_writer_->Write(stats);
+}
+
+void SysMo::CheckStalls() {
+  const uint64_t threshold_ns = stall_threshold_ms_ * 1000000;
+  for (auto& snap : scheduler::Instance()->ProcessorSnapshots()) {
+    const uint64_t run_start = snap->run_start_ns.load();
+    const uint64_t routine_id = snap->routine_id.load();
+    const uint64_t now = SteadyNow();
+    if (run_start == 0 || now < run_start + threshold_ns) {
+      continue;
+    }
+    const pid_t tid = snap->processor_id.load();
+    // once per run
+    if (reported_runs_[tid] == run_start) {
+      continue;
+    }
+    reported_runs_[tid] = run_start;
+
+    auto stall = stall_report_.add_stall();
+    stall->set_tid(tid);
+    stall->set_routine_id(routine_id);
+    std::string name;
+    if (scheduler::Instance()->GetRoutineName(routine_id, &name)) {
+      stall->set_routine_name(name);
+    }
+    stall->set_run_ms((now - run_start) / 1000000);
+    std::vector<std::string> frames;
+    // the run may have ended meanwhile, then the frames are of another one
+    if (sample_stall_stack_ && stack_sampler_.Sample(tid, &frames) &&
+        snap->run_start_ns.load() == run_start) {
+      for (auto& frame : frames) {
+        stall->add_frame(frame);
+      }
+    }
+
+    std::string stack;
+    for (auto& frame : stall->frame()) {
+      stack.append("\n    ").append(frame);
+    }
+    AWARN << "croutine " << stall->routine_name() << " has been running for "
+          << stall->run_ms() << "ms on processor " << tid << stack;
+  }
+}
+
+void SysMo::PublishSchedStall() {
+  if (stall_writer_ == nullptr) {
+    stall_writer_ =
+        GetNode()->CreateWriter<proto::SchedStall>(kSchedStallChannel);
+    if (stall_writer_ == nullptr) {
+      AERROR << "create sched stall writer failed.";
+      stall_threshold_ms_ = 0;
+      return;
+    }
+  }
+
+  const uint64_t now = SteadyNow();
+  const uint64_t period = std::max<uint64_t>(now - last_stall_report_ns_, 1);
+  last_stall_report_ns_ = now;
+
+  auto report = std::make_shared<proto::SchedStall>();
+  report->Swap(&stall_report_);
+  report->set_timestamp(Time::Now().ToNanosecond());
+  report->set_process_name(binary::GetName());
+  report->set_pid(getpid());
+  report->set_threshold_ms(stall_threshold_ms_);
+  for (auto& snap : scheduler::Instance()->ProcessorSnapshots()) {
+    const pid_t tid = snap->processor_id.load();
+    auto processor = report->add_processor();
+    processor->set_tid(tid);
+    const uint64_t run_time = snap->run_time.Sum();
+    processor->set_load(
+        std::min(1.0, static_cast<double>(run_time - reported_run_time_[tid]) /
+                          static_cast<double>(period)));
+    reported_run_time_[tid] = run_time;
+
+    const uint64_t run_start = snap->run_start_ns.load();
+    if (run_start != 0 && now > run_start) {
+      processor->set_running_ms((now - run_start) / 1000000);
+      std::string name;
+      if (scheduler::Instance()->GetRoutineName(snap->routine_id.load(),
+                                                &name)) {
+        processor->set_running_routine(name);
+      }
+    }
+  }
+  stall_writer_->Write(report);
+}
+
 }  // namespace cyber
 }  // namespace apollo
@@ -20,11 +20,18 @@
 #include <chrono>
 #include <condition_variable>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
+#include "cyber/proto/sched_latency.pb.h"
+#include "cyber/proto/transport_stats.pb.h"
+
+#include "cyber/node/node.h"
 #include "cyber/scheduler/scheduler_factory.h"
+#include "cyber/sysmo/stack_sampler.h"
 
 namespace apollo {
 namespace cyber {
@@ -38,11 +45,36 @@ class SysMo {
 
  private:
   void Checker();
+  Node* GetNode();
+  void PublishSchedLatency();
+  void PublishTransportStats();
+  // catches the croutines running longer than stall_threshold_ms_, checked
+  // every sysmo_interval_ms_
+  void CheckStalls();
+  void PublishSchedStall();
 
   std::atomic<bool> shut_down_{false};
   bool start_ = false;
+  bool check_sched_status_ = false;
+  bool publish_sched_latency_ = false;
+  bool publish_transport_stats_ = false;
+  uint64_t stall_threshold_ms_ = 0;
+  bool sample_stall_stack_ = false;
 
   int sysmo_interval_ms_ = 100;
+  int sched_latency_interval_ms_ = 1000;
+  std::unique_ptr<Node> node_;
+  std::shared_ptr<Writer<proto::SchedLatency>> latency_writer_;
+  std::shared_ptr<Writer<proto::TransportStats>> stats_writer_;
+  std::shared_ptr<Writer<proto::SchedStall>> stall_writer_;
+  StackSampler stack_sampler_;
+  // the stalls since the last report
+  proto::SchedStall stall_report_;
+  // key: processor tid, value: run_start_ns of the run reported last
+  std::unordered_map<pid_t, uint64_t> reported_runs_;
+  // key: processor tid, value: run time sum at the last report
+  std::unordered_map<pid_t, uint64_t> reported_run_time_;
+  uint64_t last_stall_report_ns_ = 0;
   std::condition_variable cv_;
   std::mutex lk_;
   std::thread sysmo_;
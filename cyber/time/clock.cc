@@ -25,30 +25,25 @@ namespace cyber {
 
 using GlobalData = ::apollo::cyber::common::GlobalData;
 
-using AtomicRWLock = ::apollo::cyber::base::AtomicRWLock;
-using AtomicWriteLockGuard =
-    ::apollo::cyber::base::WriteLockGuard<AtomicRWLock>;
-using AtomicReadLockGuard = ::apollo::cyber::base::ReadLockGuard<AtomicRWLock>;
-
 Clock::Clock() {
   const auto& cyber_config = GlobalData::Instance()->Config();
   const auto& clock_mode = cyber_config.run_mode_conf().clock_mode();
-  mode_ = clock_mode;
-  mock_now_ = Time(0);
+  mode_.store(clock_mode);
+  mock_now_ns_.store(0);
 }
 
 Time Clock::Now() {
   auto clock = Instance();
 
-  AtomicReadLockGuard lg(clock->rwlock_);
-  switch (clock->mode_) {
+  auto mode = clock->mode_.load(std::memory_order_acquire);
+  switch (mode) {
     case ClockMode::MODE_CYBER:
       return Time::Now();
     case ClockMode::MODE_MOCK:
-      return clock->mock_now_;
+      return Time(clock->mock_now_ns_.load(std::memory_order_acquire));
     default:
       AFATAL << "Unsupported clock mode: "
-             << apollo::cyber::common::ToInt(clock->mode_);
+             << apollo::cyber::common::ToInt(mode);
   }
   return Time::Now();
 }
@@ -57,36 +52,32 @@ double Clock::NowInSeconds() { return Now().ToSecond(); }
 
 void Clock::SetMode(ClockMode mode) {
   auto clock = Instance();
-  AtomicWriteLockGuard lg(clock->rwlock_);
   switch (mode) {
     case ClockMode::MODE_MOCK: {
-      clock->mode_ = mode;
+      clock->mode_.store(mode, std::memory_order_release);
       break;
     }
     case ClockMode::MODE_CYBER: {
-      clock->mode_ = mode;
+      clock->mode_.store(mode, std::memory_order_release);
       break;
     }
     default:
       AERROR << "Unknown ClockMode: " << mode;
   }
-  clock->mock_now_ = Time(0);
+  clock->mock_now_ns_.store(0, std::memory_order_release);
 }
 
 ClockMode Clock::mode() {
-  auto clock = Instance();
-  AtomicReadLockGuard lg(clock->rwlock_);
-  return clock->mode_;
+  return Instance()->mode_.load(std::memory_order_acquire);
 }
 
 void Clock::SetNow(const Time& now) {
   auto clock = Instance();
-  AtomicWriteLockGuard lg(clock->rwlock_);
-  if (clock->mode_ != ClockMode::MODE_MOCK) {
+  if (clock->mode_.load(std::memory_order_acquire) != ClockMode::MODE_MOCK) {
     AERROR << "SetSimNow only works for ClockMode::MOCK";
     return;
   }
-  clock->mock_now_ = now;
+  clock->mock_now_ns_.store(now.ToNanosecond(), std::memory_order_release);
 }
 
 }  // namespace cyber
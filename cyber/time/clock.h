@@ -17,11 +17,10 @@
 #ifndef CYBER_TIME_CLOCK_H_
 #define CYBER_TIME_CLOCK_H_
 
-#include <mutex>
+#include <atomic>
 
 #include "cyber/proto/run_mode_conf.pb.h"
 
-#include "cyber/base/atomic_rw_lock.h"
 #include "cyber/common/macros.h"
 #include "cyber/time/time.h"
 
@@ -34,7 +33,8 @@ using ::apollo::cyber::proto::ClockMode;
  * @class Clock
  * @brief a singleton clock that can be used to get the current
  * timestamp. The source can be either system(cyber) clock or a mock clock.
- * Mock clock is for testing purpose mainly.
+ * Mock clock is for testing purpose mainly. Now() takes no lock, the mode
+ * and the mock time are plain atomics.
  */
 class Clock {
  public:
@@ -86,9 +86,8 @@ class Clock {
   }
 
  private:
-  ClockMode mode_;
-  Time mock_now_;
-  ::apollo::cyber::base::AtomicRWLock rwlock_;
+  std::atomic<ClockMode> mode_;
+  std::atomic<uint64_t> mock_now_ns_;
 
   DECLARE_SINGLETON(Clock)
 };
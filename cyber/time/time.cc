@@ -16,6 +16,8 @@
 
 #include "cyber/time/time.h"
 
+#include <time.h>
+
 #include <chrono>
 #include <ctime>
 #include <iomanip>
@@ -23,11 +25,11 @@
 #include <sstream>
 #include <thread>
 
+#include "cyber/time/tsc_clock.h"
+
 namespace apollo {
 namespace cyber {
 
-using std::chrono::high_resolution_clock;
-using std::chrono::steady_clock;
 using std::chrono::system_clock;
 
 const Time Time::MAX = Time(std::numeric_limits<uint64_t>::max());
@@ -55,23 +57,22 @@ Time& Time::operator=(const Time& other) {
 }
 
 Time Time::Now() {
-  auto now = high_resolution_clock::now();
-  auto nano_time_point =
-      std::chrono::time_point_cast<std::chrono::nanoseconds>(now);
-  auto epoch = nano_time_point.time_since_epoch();
-  uint64_t now_nano =
-      std::chrono::duration_cast<std::chrono::nanoseconds>(epoch).count();
-  return Time(now_nano);
+  auto tsc_clock = TscClock::Global();
+  if (tsc_clock != nullptr) {
+    return Time(tsc_clock->Now());
+  }
+  // served from the vdso, without going through std::chrono
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return Time(static_cast<uint64_t>(ts.tv_sec) * 1000000000UL +
+              static_cast<uint64_t>(ts.tv_nsec));
 }
 
 Time Time::MonoTime() {
-  auto now = steady_clock::now();
-  auto nano_time_point =
-      std::chrono::time_point_cast<std::chrono::nanoseconds>(now);
-  auto epoch = nano_time_point.time_since_epoch();
-  uint64_t now_nano =
-      std::chrono::duration_cast<std::chrono::nanoseconds>(epoch).count();
-  return Time(now_nano);
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return Time(static_cast<uint64_t>(ts.tv_sec) * 1000000000UL +
+              static_cast<uint64_t>(ts.tv_nsec));
 }
 
 double Time::ToSecond() const {
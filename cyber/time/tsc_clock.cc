@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/time/tsc_clock.h"
+
+#include <time.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+uint64_t ClockNs(clockid_t clock_id) {
+  struct timespec ts;
+  clock_gettime(clock_id, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000UL +
+         static_cast<uint64_t>(ts.tv_nsec);
+}
+
+}  // namespace
+
+constexpr uint64_t TscClock::kCalibrationNs;
+constexpr uint64_t TscClock::kResyncNs;
+
+uint64_t TscClock::ReadTsc() {
+#if defined(__x86_64__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+bool TscClock::HasInvariantTsc() {
+#if defined(__x86_64__)
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  // advanced power management leaf, bit 8 of edx is the invariant TSC
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (edx & (1U << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+void TscClock::Sample(uint64_t* tsc, uint64_t* mono_ns) {
+  uint64_t before = ReadTsc();
+  *mono_ns = ClockNs(CLOCK_MONOTONIC);
+  uint64_t after = ReadTsc();
+  *tsc = before + (after - before) / 2;
+}
+
+bool TscClock::Init() {
+  if (valid_) {
+    return true;
+  }
+  if (!HasInvariantTsc()) {
+    return false;
+  }
+
+  // the first clock_gettime may fault in the vdso data page
+  ClockNs(CLOCK_MONOTONIC);
+  Sample(&base_tsc_, &base_mono_ns_);
+  uint64_t tsc = base_tsc_;
+  uint64_t mono_ns = base_mono_ns_;
+  while (mono_ns - base_mono_ns_ < kCalibrationNs) {
+    Sample(&tsc, &mono_ns);
+  }
+
+  uint64_t cycles = tsc - base_tsc_;
+  uint64_t ns = mono_ns - base_mono_ns_;
+  // anything outside 0.1GHz ~ 10GHz is not a clock we want to trust
+  if (cycles < ns / 10 || cycles > ns * 10) {
+    return false;
+  }
+
+  resync_cycles_ = cycles * (kResyncNs / kCalibrationNs);
+  mult_.store((ns << 32) / cycles, std::memory_order_relaxed);
+  Resync();
+  valid_ = true;
+  return true;
+}
+
+void TscClock::Resync() {
+  uint64_t before = ReadTsc();
+  uint64_t real_ns = ClockNs(CLOCK_REALTIME);
+  uint64_t mono_ns = ClockNs(CLOCK_MONOTONIC);
+  uint64_t after = ReadTsc();
+  uint64_t tsc = before + (after - before) / 2;
+
+  uint64_t mult = mult_.load(std::memory_order_relaxed);
+  if (tsc > base_tsc_ && mono_ns > base_mono_ns_) {
+    mult = static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(mono_ns - base_mono_ns_) << 32) /
+        (tsc - base_tsc_));
+  }
+
+  uint64_t seq = seq_.load(std::memory_order_relaxed);
+  seq_.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  anchor_tsc_.store(tsc, std::memory_order_relaxed);
+  anchor_ns_.store(real_ns, std::memory_order_relaxed);
+  mult_.store(mult, std::memory_order_relaxed);
+  seq_.store(seq + 2, std::memory_order_release);
+}
+
+uint64_t TscClock::Now() {
+  uint64_t seq = 0;
+  uint64_t anchor_tsc = 0;
+  uint64_t anchor_ns = 0;
+  uint64_t mult = 0;
+  do {
+    seq = seq_.load(std::memory_order_acquire);
+    anchor_tsc = anchor_tsc_.load(std::memory_order_relaxed);
+    anchor_ns = anchor_ns_.load(std::memory_order_relaxed);
+    mult = mult_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((seq & 1) || seq != seq_.load(std::memory_order_relaxed));
+
+  uint64_t tsc = ReadTsc();
+  uint64_t cycles = tsc > anchor_tsc ? tsc - anchor_tsc : 0;
+  if (cycles >= resync_cycles_ &&
+      !resyncing_.test_and_set(std::memory_order_acquire)) {
+    Resync();
+    resyncing_.clear(std::memory_order_release);
+  }
+  return anchor_ns + static_cast<uint64_t>(
+                         (static_cast<unsigned __int128>(cycles) * mult) >> 32);
+}
+
+TscClock* TscClock::Global() {
+  static TscClock* global = []() -> TscClock* {
+    const char* source = ::getenv("CYBER_CLOCK_SOURCE");
+    if (source == nullptr || std::strcmp(source, "tsc") != 0) {
+      return nullptr;
+    }
+    auto clock = new TscClock();
+    if (!clock->Init()) {
+      delete clock;
+      return nullptr;
+    }
+    return clock;
+  }();
+  return global;
+}
+
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TIME_TSC_CLOCK_H_
+#define CYBER_TIME_TSC_CLOCK_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace apollo {
+namespace cyber {
+
+/**
+ * @class TscClock
+ * @brief Wall clock read from the invariant TSC of x86_64 cpus. The cycle
+ * rate is measured against clock_gettime at Init(), then the anchor is
+ * taken again from CLOCK_REALTIME once per resync interval, so steps of
+ * the system clock show up within that interval and the rate estimate
+ * improves with the length of the baseline.
+ */
+class TscClock {
+ public:
+  TscClock() = default;
+
+  /**
+   * @brief check the cpu and calibrate the cycle rate, which spins for
+   * about kCalibrationNs.
+   * @return false if there is no invariant TSC or its rate does not look
+   * sane, the caller should stay on clock_gettime then.
+   */
+  bool Init();
+
+  bool IsValid() const { return valid_; }
+
+  /**
+   * @brief nanoseconds since the unix epoch, only valid after a successful
+   * Init().
+   */
+  uint64_t Now();
+
+  /**
+   * @brief the process wide instance used by Time::Now(), which is enabled
+   * by CYBER_CLOCK_SOURCE=tsc and nullptr otherwise or when Init() failed.
+   */
+  static TscClock* Global();
+
+  static constexpr uint64_t kCalibrationNs = 5000000;
+  static constexpr uint64_t kResyncNs = 1000000000;
+
+ private:
+  static uint64_t ReadTsc();
+  static bool HasInvariantTsc();
+  // a tsc reading paired with CLOCK_MONOTONIC taken in the middle of it
+  static void Sample(uint64_t* tsc, uint64_t* mono_ns);
+  void Resync();
+
+  bool valid_ = false;
+  // first calibration point, the rate of every resync is measured from it
+  uint64_t base_tsc_ = 0;
+  uint64_t base_mono_ns_ = 0;
+  uint64_t resync_cycles_ = 0;
+
+  // anchor published under a seqlock, odd seq_ means it is being written
+  std::atomic<uint64_t> seq_{0};
+  std::atomic<uint64_t> anchor_tsc_{0};
+  std::atomic<uint64_t> anchor_ns_{0};
+  // nanoseconds per cycle in 32.32 fixed point
+  std::atomic<uint64_t> mult_{0};
+  std::atomic_flag resyncing_ = ATOMIC_FLAG_INIT;
+};
+
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TIME_TSC_CLOCK_H_
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/time/tsc_clock.h"
+
+#include <time.h>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+
+namespace {
+
+uint64_t RealtimeNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000UL +
+         static_cast<uint64_t>(ts.tv_nsec);
+}
+
+}  // namespace
+
+TEST(TscClockTest, now) {
+  TscClock clock;
+  EXPECT_FALSE(clock.IsValid());
+  if (!clock.Init()) {
+    // no invariant tsc on this machine, Time::Now stays on clock_gettime
+    return;
+  }
+  EXPECT_TRUE(clock.IsValid());
+
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t before = RealtimeNs();
+    uint64_t now = clock.Now();
+    uint64_t after = RealtimeNs();
+    // the rate of a 5ms calibration is good to well below 1ms per second
+    EXPECT_GT(now + 1000000, before);
+    EXPECT_LT(now, after + 1000000);
+  }
+}
+
+TEST(TscClockTest, global) {
+  // CYBER_CLOCK_SOURCE is not set for tests
+  EXPECT_EQ(nullptr, TscClock::Global());
+}
+
+}  // namespace cyber
+}  // namespace apollo
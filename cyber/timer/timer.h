@@ -48,7 +48,7 @@ struct TimerOption {
 
   /**
    * @brief The period of the timer, unit is ms
-   * max: 512 * 64
+   * max: TIMER_MAX_INTERVAL_MS
    * min: 1
    */
   uint32_t period = 0;
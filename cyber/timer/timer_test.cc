@@ -48,6 +48,19 @@ TEST(TimerTest, one_shot) {
   timer.Stop();
 }
 
+TEST(TimerTest, one_shot_cascade) {
+  // longer than a turn of the work wheel, fired after cascading down
+  int count = 0;
+  Timer timer(
+      1500, [&count] { count = 1500; }, true);
+  timer.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(1400));
+  EXPECT_EQ(0, count);
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  EXPECT_EQ(1500, count);
+  timer.Stop();
+}
+
 TEST(TimerTest, cycle) {
   using TimerPtr = std::shared_ptr<Timer>;
   int count = 0;
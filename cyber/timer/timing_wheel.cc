@@ -1,5 +1,5 @@
 /******************************************************************************
- * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,13 +16,23 @@
 
 #include "cyber/timer/timing_wheel.h"
 
-#include <cmath>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 
 #include "cyber/task/task.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 
+namespace {
+const uint64_t kResolutionNs = TIMER_RESOLUTION_US * 1000;
+}  // namespace
+
 void TimingWheel::Start() {
   std::lock_guard<std::mutex> lock(running_mutex_);
   if (!running_) {
@@ -36,112 +46,193 @@ void TimingWheel::Start() {
 void TimingWheel::Shutdown() {
   std::lock_guard<std::mutex> lock(running_mutex_);
   if (running_) {
-    running_ = false;
+    {
+      // fire right away so that the tick thread sees running_
+      std::lock_guard<std::mutex> lg(wheel_mutex_);
+      running_ = false;
+      struct itimerspec its = {};
+      its.it_value.tv_nsec = 1;
+      timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &its, nullptr);
+      armed_tick_ = 0;
+    }
     if (tick_thread_.joinable()) {
       tick_thread_.join();
     }
   }
 }
 
-void TimingWheel::Tick() {
-  auto& bucket = work_wheel_[current_work_wheel_index_];
-  {
-    std::lock_guard<std::mutex> lock(bucket.mutex());
-    auto ite = bucket.task_list().begin();
-    while (ite != bucket.task_list().end()) {
-      auto task = ite->lock();
-      if (task) {
-        ADEBUG << "index: " << current_work_wheel_index_
-               << " timer id: " << task->timer_id_;
-        auto* callback =
-            reinterpret_cast<std::function<void()>*>(&(task->callback));
-        cyber::Async([this, callback] {
-          if (this->running_) {
-            (*callback)();
-          }
-        });
-      }
-      ite = bucket.task_list().erase(ite);
-    }
+void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task) {
+  if (!running_) {
+    Start();
+  }
+  std::lock_guard<std::mutex> lg(wheel_mutex_);
+  if (task_num_ == 0) {
+    // nothing to cascade, catch up with the clock without walking the ticks
+    current_tick_ = std::max(current_tick_, NowTick());
+  }
+  auto tick = Place(task);
+  ADEBUG << "add task [" << task->timer_id_ << "] wake up at tick " << tick;
+  if (armed_tick_ == 0 || tick < armed_tick_) {
+    Arm(tick);
   }
 }
 
-void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task) {
-  AddTask(task, current_work_wheel_index_);
+uint64_t TimingWheel::Place(const std::shared_ptr<TimerTask>& task) {
+  auto tick = std::max(DeadlineTick(task->deadline_ns), current_tick_ + 1);
+  auto delta = std::min(tick - current_tick_, TIMER_MAX_TICKS - 1);
+  tick = current_tick_ + delta;
+
+  uint64_t level = 0;
+  while (delta >> (LevelShift(level) + LevelBits(level))) {
+    ++level;
+  }
+  Bucket(level, tick).task_list().push_back(task);
+  ++task_num_;
+  // a higher level slot has to be cascaded when its turn begins
+  return tick >> LevelShift(level) << LevelShift(level);
 }
 
-void TimingWheel::AddTask(const std::shared_ptr<TimerTask>& task,
-                          const uint64_t current_work_wheel_index) {
-  if (!running_) {
-    Start();
+void TimingWheel::Cascade(uint64_t level) {
+  auto& bucket = Bucket(level, current_tick_);
+  std::list<std::weak_ptr<TimerTask>> task_list;
+  task_list.swap(bucket.task_list());
+  task_num_ -= task_list.size();
+  for (auto& item : task_list) {
+    auto task = item.lock();
+    if (task) {
+      Place(task);
+    }
   }
-  auto work_wheel_index = current_work_wheel_index +
-                          static_cast<uint64_t>(std::ceil(
-                              static_cast<double>(task->next_fire_duration_ms) /
-                              TIMER_RESOLUTION_MS));
-  if (work_wheel_index >= WORK_WHEEL_SIZE) {
-    auto real_work_wheel_index = GetWorkWheelIndex(work_wheel_index);
-    task->remainder_interval_ms = real_work_wheel_index;
-    auto assistant_ticks = work_wheel_index / WORK_WHEEL_SIZE;
-    if (assistant_ticks == 1 &&
-        real_work_wheel_index < current_work_wheel_index_) {
-      work_wheel_[real_work_wheel_index].AddTask(task);
-      ADEBUG << "add task to work wheel. index :" << real_work_wheel_index;
-    } else {
-      auto assistant_wheel_index = 0;
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        assistant_wheel_index = GetAssistantWheelIndex(
-            current_assistant_wheel_index_ + assistant_ticks);
-        assistant_wheel_[assistant_wheel_index].AddTask(task);
+}
+
+void TimingWheel::Advance(uint64_t tick,
+                          std::vector<std::shared_ptr<TimerTask>>* tasks) {
+  while (current_tick_ < tick) {
+    ++current_tick_;
+    for (uint64_t level = 1; level < WHEEL_LEVEL_NUM; ++level) {
+      if (current_tick_ & ((1ULL << LevelShift(level)) - 1)) {
+        break;
+      }
+      Cascade(level);
+    }
+
+    auto& task_list = Bucket(0, current_tick_).task_list();
+    auto ite = task_list.begin();
+    while (ite != task_list.end()) {
+      auto task = ite->lock();
+      ite = task_list.erase(ite);
+      --task_num_;
+      if (!task) {
+        continue;
+      }
+      if (DeadlineTick(task->deadline_ns) > current_tick_) {
+        // was clamped to the span of the wheel
+        Place(task);
+        continue;
       }
-      ADEBUG << "add task to assistant wheel. index : "
-             << assistant_wheel_index;
+      tasks->emplace_back(task);
     }
-  } else {
-    work_wheel_[work_wheel_index].AddTask(task);
-    ADEBUG << "add task [" << task->timer_id_
-           << "] to work wheel. index :" << work_wheel_index;
   }
 }
 
-void TimingWheel::Cascade(const uint64_t assistant_wheel_index) {
-  auto& bucket = assistant_wheel_[assistant_wheel_index];
-  std::lock_guard<std::mutex> lock(bucket.mutex());
-  auto ite = bucket.task_list().begin();
-  while (ite != bucket.task_list().end()) {
-    auto task = ite->lock();
-    if (task) {
-      work_wheel_[task->remainder_interval_ms].AddTask(task);
+uint64_t TimingWheel::NextExpiryTick() {
+  if (task_num_ == 0) {
+    return 0;
+  }
+  for (uint64_t i = 1; i < WORK_WHEEL_SIZE; ++i) {
+    if (!Bucket(0, current_tick_ + i).task_list().empty()) {
+      return current_tick_ + i;
     }
-    ite = bucket.task_list().erase(ite);
   }
+  for (uint64_t level = 1; level < WHEEL_LEVEL_NUM; ++level) {
+    auto shift = LevelShift(level);
+    for (uint64_t i = 1; i <= ASSISTANT_WHEEL_SIZE; ++i) {
+      auto tick = ((current_tick_ >> shift) + i) << shift;
+      if (!Bucket(level, tick).task_list().empty()) {
+        return tick;
+      }
+    }
+  }
+  return current_tick_ + WORK_WHEEL_SIZE;
+}
+
+void TimingWheel::Arm(uint64_t tick) {
+  struct itimerspec its = {};
+  if (tick != 0) {
+    auto ns = start_ns_ + tick * kResolutionNs;
+    its.it_value.tv_sec = static_cast<time_t>(ns / 1000000000);
+    its.it_value.tv_nsec =
+        static_cast<decltype(its.it_value.tv_nsec)>(ns % 1000000000);
+  }
+  if (timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &its, nullptr) != 0) {
+    AERROR << "arm timer failed: " << strerror(errno);
+    return;
+  }
+  armed_tick_ = tick;
 }
 
 void TimingWheel::TickFunc() {
-  Rate rate(TIMER_RESOLUTION_MS * 1000000);  // ms to ns
+  std::vector<std::shared_ptr<TimerTask>> tasks;
   while (running_) {
-    Tick();
-    // AINFO_EVERY(1000) << "Tick " << TickCount();
-    tick_count_++;
-    rate.Sleep();
-    {
-      std::lock_guard<std::mutex> lock(current_work_wheel_index_mutex_);
-      current_work_wheel_index_ =
-          GetWorkWheelIndex(current_work_wheel_index_ + 1);
+    uint64_t expirations = 0;
+    if (read(timer_fd_, &expirations, sizeof(expirations)) < 0 &&
+        errno != EINTR) {
+      AERROR << "wait timer failed: " << strerror(errno);
+      break;
     }
-    if (current_work_wheel_index_ == 0) {
-      {
-        std::lock_guard<std::mutex> lock(current_assistant_wheel_index_mutex_);
-        current_assistant_wheel_index_ =
-            GetAssistantWheelIndex(current_assistant_wheel_index_ + 1);
+
+    {
+      std::lock_guard<std::mutex> lg(wheel_mutex_);
+      if (!running_) {
+        break;
       }
-      Cascade(current_assistant_wheel_index_);
+      armed_tick_ = 0;
+      Advance(NowTick(), &tasks);
+      Arm(NextExpiryTick());
+    }
+
+    for (auto& task : tasks) {
+      ADEBUG << "fire timer id: " << task->timer_id_;
+      auto* callback =
+          reinterpret_cast<std::function<void()>*>(&(task->callback));
+      cyber::Async([this, callback] {
+        if (this->running_) {
+          (*callback)();
+        }
+      });
     }
+    tasks.clear();
   }
 }
 
-TimingWheel::TimingWheel() {}
+uint64_t TimingWheel::NowTick() const {
+  auto now = Time::MonoTime().ToNanosecond();
+  return now > start_ns_ ? (now - start_ns_) / kResolutionNs : 0;
+}
+
+uint64_t TimingWheel::DeadlineTick(uint64_t deadline_ns) const {
+  if (deadline_ns <= start_ns_) {
+    return 0;
+  }
+  return (deadline_ns - start_ns_ + kResolutionNs - 1) / kResolutionNs;
+}
+
+TimingWheel::~TimingWheel() {
+  if (running_) {
+    Shutdown();
+  }
+  if (timer_fd_ >= 0) {
+    close(timer_fd_);
+  }
+}
+
+TimingWheel::TimingWheel() {
+  start_ns_ = Time::MonoTime().ToNanosecond();
+  timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+  if (timer_fd_ < 0) {
+    AFATAL << "create timerfd failed: " << strerror(errno);
+  }
+}
 
 }  // namespace cyber
 }  // namespace apollo
@@ -1,5 +1,5 @@
 /******************************************************************************
- * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,15 +17,17 @@
 #ifndef CYBER_TIMER_TIMING_WHEEL_H_
 #define CYBER_TIMER_TIMING_WHEEL_H_
 
+#include <atomic>
 #include <future>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
 #include "cyber/scheduler/scheduler_factory.h"
-#include "cyber/time/rate.h"
 #include "cyber/timer/timer_bucket.h"
 
 namespace apollo {
@@ -33,55 +35,80 @@ namespace cyber {
 
 struct TimerTask;
 
-static const uint64_t WORK_WHEEL_SIZE = 512;
-static const uint64_t ASSISTANT_WHEEL_SIZE = 64;
-static const uint64_t TIMER_RESOLUTION_MS = 2;
+// Level 0 has 256 slots of one tick, every further level 64 slots that each
+// span a whole turn of the level below.
+static const uint64_t TIMER_RESOLUTION_US = 100;
+static const uint64_t WHEEL_LEVEL_NUM = 4;
+static const uint64_t WORK_WHEEL_BITS = 8;
+static const uint64_t ASSISTANT_WHEEL_BITS = 6;
+static const uint64_t WORK_WHEEL_SIZE = 1ULL << WORK_WHEEL_BITS;
+static const uint64_t ASSISTANT_WHEEL_SIZE = 1ULL << ASSISTANT_WHEEL_BITS;
+static const uint64_t TIMER_MAX_TICKS =
+    1ULL << (WORK_WHEEL_BITS + (WHEEL_LEVEL_NUM - 1) * ASSISTANT_WHEEL_BITS);
 static const uint64_t TIMER_MAX_INTERVAL_MS =
-    WORK_WHEEL_SIZE * ASSISTANT_WHEEL_SIZE * TIMER_RESOLUTION_MS;
-
+    TIMER_MAX_TICKS * TIMER_RESOLUTION_US / 1000;
+
+/**
+ * @class TimingWheel
+ * @brief Hierarchical timing wheel that fires TimerTasks at their
+ * deadline_ns (monotonic clock). The tick thread sleeps on a timerfd armed
+ * for the next occupied slot instead of waking up every tick, and does not
+ * wake up at all while no timer is pending.
+ */
 class TimingWheel {
  public:
-  ~TimingWheel() {
-    if (running_) {
-      Shutdown();
-    }
-  }
+  ~TimingWheel();
 
   void Start();
 
   void Shutdown();
 
-  void Tick();
-
   void AddTask(const std::shared_ptr<TimerTask>& task);
 
-  void AddTask(const std::shared_ptr<TimerTask>& task,
-               const uint64_t current_work_wheel_index);
-
-  void Cascade(const uint64_t assistant_wheel_index);
-
-  void TickFunc();
-
-  inline uint64_t TickCount() const { return tick_count_; }
+  inline uint64_t TickCount() const { return current_tick_; }
 
  private:
-  inline uint64_t GetWorkWheelIndex(const uint64_t index) {
-    return index & (WORK_WHEEL_SIZE - 1);
+  void TickFunc();
+  // must be called with wheel_mutex_ held
+  void Advance(uint64_t tick, std::vector<std::shared_ptr<TimerTask>>* tasks);
+  // returns the tick the wheel has to wake up at for the task
+  uint64_t Place(const std::shared_ptr<TimerTask>& task);
+  void Cascade(uint64_t level);
+  uint64_t NextExpiryTick();
+  void Arm(uint64_t tick);
+
+  uint64_t NowTick() const;
+  uint64_t DeadlineTick(uint64_t deadline_ns) const;
+
+  inline uint64_t LevelShift(uint64_t level) const {
+    return level == 0 ? 0
+                      : WORK_WHEEL_BITS + (level - 1) * ASSISTANT_WHEEL_BITS;
+  }
+  inline uint64_t LevelBits(uint64_t level) const {
+    return level == 0 ? WORK_WHEEL_BITS : ASSISTANT_WHEEL_BITS;
+  }
+  inline uint64_t LevelSize(uint64_t level) const {
+    return 1ULL << LevelBits(level);
   }
-  inline uint64_t GetAssistantWheelIndex(const uint64_t index) {
-    return index & (ASSISTANT_WHEEL_SIZE - 1);
+  inline TimerBucket& Bucket(uint64_t level, uint64_t tick) {
+    auto index = (tick >> LevelShift(level)) & (LevelSize(level) - 1);
+    return level == 0 ? work_wheel_[index]
+                      : assistant_wheel_[level - 1][index];
   }
 
-  bool running_ = false;
-  uint64_t tick_count_ = 0;
+  std::atomic<bool> running_ = {false};
   std::mutex running_mutex_;
-  TimerBucket work_wheel_[WORK_WHEEL_SIZE];
-  TimerBucket assistant_wheel_[ASSISTANT_WHEEL_SIZE];
-  uint64_t current_work_wheel_index_ = 0;
-  std::mutex current_work_wheel_index_mutex_;
-  uint64_t current_assistant_wheel_index_ = 0;
-  std::mutex current_assistant_wheel_index_mutex_;
   std::thread tick_thread_;
+  int timer_fd_ = -1;
+
+  std::mutex wheel_mutex_;
+  TimerBucket work_wheel_[WORK_WHEEL_SIZE];
+  TimerBucket assistant_wheel_[WHEEL_LEVEL_NUM - 1][ASSISTANT_WHEEL_SIZE];
+  uint64_t start_ns_ = 0;
+  uint64_t current_tick_ = 0;
+  // tick the timerfd is armed for, 0 when disarmed
+  uint64_t armed_tick_ = 0;
+  uint64_t task_num_ = 0;
 
   DECLARE_SINGLETON(TimingWheel)
 };
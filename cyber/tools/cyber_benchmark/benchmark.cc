@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/tools/cyber_benchmark/benchmark.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+namespace {
+
+double Percentile(const std::vector<uint64_t>& sorted, double ratio) {
+  auto index = static_cast<size_t>(ratio * static_cast<double>(sorted.size()));
+  index = std::min(index, sorted.size() - 1);
+  return static_cast<double>(sorted[index]) / 1000.0;
+}
+
+}  // namespace
+
+LatencySummary Summarize(std::vector<uint64_t>* latencies) {
+  LatencySummary summary;
+  if (latencies->empty()) {
+    return summary;
+  }
+  std::sort(latencies->begin(), latencies->end());
+  double sum = 0.0;
+  for (auto latency : *latencies) {
+    sum += static_cast<double>(latency);
+  }
+  summary.count = latencies->size();
+  summary.mean_us = sum / static_cast<double>(latencies->size()) / 1000.0;
+  summary.p50_us = Percentile(*latencies, 0.5);
+  summary.p90_us = Percentile(*latencies, 0.9);
+  summary.p99_us = Percentile(*latencies, 0.99);
+  summary.p999_us = Percentile(*latencies, 0.999);
+  summary.max_us = static_cast<double>(latencies->back()) / 1000.0;
+  return summary;
+}
+
+Record::Record(const std::string& suite, const std::string& name) {
+  line_ << std::fixed << std::setprecision(3) << "{";
+  Add("suite", suite);
+  Add("name", name);
+}
+
+void Record::Key(const std::string& key) {
+  if (line_.tellp() > 1) {
+    line_ << ",";
+  }
+  line_ << "\"" << key << "\":";
+}
+
+Record& Record::Add(const std::string& key, const std::string& value) {
+  Key(key);
+  line_ << "\"" << value << "\"";
+  return *this;
+}
+
+Record& Record::Add(const std::string& key, uint64_t value) {
+  Key(key);
+  line_ << value;
+  return *this;
+}
+
+Record& Record::Add(const std::string& key, double value) {
+  Key(key);
+  line_ << value;
+  return *this;
+}
+
+Record& Record::Add(const LatencySummary& summary) {
+  return Add("samples", summary.count)
+      .Add("mean_us", summary.mean_us)
+      .Add("p50_us", summary.p50_us)
+      .Add("p90_us", summary.p90_us)
+      .Add("p99_us", summary.p99_us)
+      .Add("p999_us", summary.p999_us)
+      .Add("max_us", summary.max_us);
+}
+
+void Record::Emit(std::ostream* out) const {
+  *out << line_.str() << "}" << std::endl;
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
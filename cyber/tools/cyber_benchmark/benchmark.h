@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TOOLS_CYBER_BENCHMARK_BENCHMARK_H_
+#define CYBER_TOOLS_CYBER_BENCHMARK_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+struct BenchmarkParam {
+  // transports to run, any of intra, shm, rtps and hybrid
+  std::vector<std::string> modes = {"intra", "shm", "rtps", "hybrid"};
+  // message sizes in bytes, also used as service request sizes
+  std::vector<uint32_t> sizes = {64, 4096, 65536, 1048576};
+  // number of busy croutines the scheduler is probed under
+  std::vector<uint32_t> loads = {0, 4};
+  // samples taken by every case
+  uint32_t count = 1000;
+  // pause between two samples of the latency cases
+  uint32_t interval_us = 1000;
+};
+
+inline uint64_t SteadyNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+struct LatencySummary {
+  uint64_t count = 0;
+  double mean_us = 0.0;
+  double p50_us = 0.0;
+  double p90_us = 0.0;
+  double p99_us = 0.0;
+  double p999_us = 0.0;
+  double max_us = 0.0;
+};
+
+// Summarizes the samples in nanoseconds, which are sorted in place.
+LatencySummary Summarize(std::vector<uint64_t>* latencies);
+
+// One result as a single line json object, so that runs can be compared by
+// scripts.
+class Record {
+ public:
+  Record(const std::string& suite, const std::string& name);
+
+  Record& Add(const std::string& key, const std::string& value);
+  Record& Add(const std::string& key, uint64_t value);
+  Record& Add(const std::string& key, double value);
+  Record& Add(const LatencySummary& summary);
+
+  void Emit(std::ostream* out) const;
+
+ private:
+  void Key(const std::string& key);
+
+  std::ostringstream line_;
+};
+
+void RunTransportBenchmark(const BenchmarkParam& param, std::ostream* out);
+void RunServiceBenchmark(const BenchmarkParam& param, std::ostream* out);
+void RunSchedulerBenchmark(const BenchmarkParam& param, std::ostream* out);
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TOOLS_CYBER_BENCHMARK_BENCHMARK_H_
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <getopt.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cyber/init.h"
+#include "cyber/tools/cyber_benchmark/benchmark.h"
+
+using apollo::cyber::benchmark::BenchmarkParam;
+using apollo::cyber::benchmark::RunSchedulerBenchmark;
+using apollo::cyber::benchmark::RunServiceBenchmark;
+using apollo::cyber::benchmark::RunTransportBenchmark;
+
+namespace {
+
+std::vector<std::string> Split(const std::string& str) {
+  std::vector<std::string> items;
+  std::stringstream ss(str);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+std::vector<uint32_t> SplitNumbers(const std::string& str) {
+  std::vector<uint32_t> numbers;
+  for (auto& item : Split(str)) {
+    numbers.push_back(static_cast<uint32_t>(std::strtoul(item.c_str(), 0, 10)));
+  }
+  return numbers;
+}
+
+void DisplayUsage(const std::string& binary) {
+  std::cout << "usage: " << binary << " [options]\n"
+            << "Runs the cyber benchmarks, every result is printed as one "
+               "json object per line.\n"
+            << "options:\n"
+            << "\t-s, --suites=transport,service,scheduler\tsuites to run\n"
+            << "\t-m, --modes=intra,shm,rtps,hybrid\ttransports to run\n"
+            << "\t-b, --sizes=64,4096,65536,1048576\tmessage sizes in bytes\n"
+            << "\t-l, --loads=0,4\tbusy croutines the scheduler is probed "
+               "under\n"
+            << "\t-n, --count=1000\tsamples of every case\n"
+            << "\t-i, --interval=1000\tpause between samples in us\n"
+            << "\t-o, --output=<file>\twrite results to file instead of "
+               "stdout\n"
+            << "\t-h, --help\tshow this message" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string binary = argv[0];
+  std::vector<std::string> suites = {"transport", "service", "scheduler"};
+  std::string output;
+  BenchmarkParam param;
+
+  const struct option long_options[] = {
+      {"suites", required_argument, nullptr, 's'},
+      {"modes", required_argument, nullptr, 'm'},
+      {"sizes", required_argument, nullptr, 'b'},
+      {"loads", required_argument, nullptr, 'l'},
+      {"count", required_argument, nullptr, 'n'},
+      {"interval", required_argument, nullptr, 'i'},
+      {"output", required_argument, nullptr, 'o'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0}};
+  int opt = 0;
+  while ((opt = getopt_long(argc, argv, "s:m:b:l:n:i:o:h", long_options,
+                            nullptr)) != -1) {
+    switch (opt) {
+      case 's':
+        suites = Split(optarg);
+        break;
+      case 'm':
+        param.modes = Split(optarg);
+        break;
+      case 'b':
+        param.sizes = SplitNumbers(optarg);
+        break;
+      case 'l':
+        param.loads = SplitNumbers(optarg);
+        break;
+      case 'n':
+        param.count = static_cast<uint32_t>(std::strtoul(optarg, 0, 10));
+        break;
+      case 'i':
+        param.interval_us = static_cast<uint32_t>(std::strtoul(optarg, 0, 10));
+        break;
+      case 'o':
+        output = optarg;
+        break;
+      case 'h':
+      default:
+        DisplayUsage(binary);
+        return opt == 'h' ? 0 : -1;
+    }
+  }
+  if (param.count == 0) {
+    std::cout << "count must be greater than 0." << std::endl;
+    return -1;
+  }
+
+  std::ofstream file;
+  std::ostream* out = &std::cout;
+  if (!output.empty()) {
+    file.open(output);
+    if (!file.is_open()) {
+      std::cout << "can not open " << output << std::endl;
+      return -1;
+    }
+    out = &file;
+  }
+
+  apollo::cyber::Init(argv[0]);
+  for (auto& suite : suites) {
+    if (suite == "transport") {
+      RunTransportBenchmark(param, out);
+    } else if (suite == "service") {
+      RunServiceBenchmark(param, out);
+    } else if (suite == "scheduler") {
+      RunSchedulerBenchmark(param, out);
+    } else {
+      std::cout << "unknown suite: " << suite << std::endl;
+    }
+  }
+  apollo::cyber::Clear();
+  return 0;
+}
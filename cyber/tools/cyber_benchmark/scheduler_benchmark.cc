@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+#include "cyber/tools/cyber_benchmark/benchmark.h"
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+namespace {
+
+// busy time of a load routine between two yields
+const uint64_t kLoadSliceNs = 100000;
+
+void RunCase(uint32_t load, uint32_t count, uint32_t interval_us,
+             std::ostream* out) {
+  std::atomic<bool> stop = {false};
+  std::vector<std::future<void>> loads;
+  for (uint32_t i = 0; i < load; ++i) {
+    loads.emplace_back(cyber::Async([&stop]() {
+      while (!stop.load()) {
+        auto until = SteadyNow() + kLoadSliceNs;
+        while (SteadyNow() < until) {
+          cpu_relax();
+        }
+        cyber::Yield();
+      }
+    }));
+  }
+
+  // the time from handing a task over until it starts running
+  std::vector<uint64_t> latencies;
+  latencies.reserve(count);
+  uint64_t missed = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    auto submit = SteadyNow();
+    auto probe = cyber::Async([submit]() { return SteadyNow() - submit; });
+    if (probe.wait_for(std::chrono::seconds(1)) != std::future_status::ready) {
+      ++missed;
+    } else {
+      latencies.push_back(probe.get());
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+  }
+
+  stop.store(true);
+  for (auto& f : loads) {
+    f.wait();
+  }
+
+  auto summary = Summarize(&latencies);
+  Record("scheduler", "wake_up")
+      .Add("load", static_cast<uint64_t>(load))
+      .Add("sent", static_cast<uint64_t>(count))
+      .Add("missed", missed)
+      .Add(summary)
+      .Emit(out);
+}
+
+}  // namespace
+
+void RunSchedulerBenchmark(const BenchmarkParam& param, std::ostream* out) {
+  for (auto load : param.loads) {
+    AINFO << "benchmark scheduler wake up, load " << load;
+    RunCase(load, param.count, param.interval_us, out);
+  }
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/tools/cyber_benchmark/benchmark.h"
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+using apollo::cyber::message::RawMessage;
+
+namespace {
+
+void RunCase(const std::shared_ptr<Node>& node, uint32_t size, uint32_t count,
+             std::ostream* out) {
+  const std::string service_name =
+      "/apollo/cyber/benchmark/service/" + std::to_string(size);
+  auto server = node->CreateService<RawMessage, RawMessage>(
+      service_name, [](const std::shared_ptr<RawMessage>& request,
+                       std::shared_ptr<RawMessage>& response) {
+        response->message = request->message;
+      });
+  auto client = node->CreateClient<RawMessage, RawMessage>(service_name);
+  Record record("service", "round_trip");
+  record.Add("size", static_cast<uint64_t>(size));
+  if (server == nullptr || client == nullptr) {
+    record.Add("error", "service unavailable").Emit(out);
+    return;
+  }
+  if (!client->WaitForService(std::chrono::seconds(3))) {
+    record.Add("error", "service not ready").Emit(out);
+    return;
+  }
+
+  auto request = std::make_shared<RawMessage>(std::string(size, 'c'));
+  for (int i = 0; i < 10; ++i) {
+    client->SendRequest(request, std::chrono::seconds(1));
+  }
+
+  std::vector<uint64_t> latencies;
+  latencies.reserve(count);
+  uint64_t failed = 0;
+  auto start = SteadyNow();
+  for (uint32_t i = 0; i < count; ++i) {
+    auto sent = SteadyNow();
+    auto response = client->SendRequest(request, std::chrono::seconds(1));
+    if (response == nullptr || response->message.size() != size) {
+      ++failed;
+      continue;
+    }
+    latencies.push_back(SteadyNow() - sent);
+  }
+  double elapsed_s = static_cast<double>(SteadyNow() - start) / 1e9;
+
+  auto summary = Summarize(&latencies);
+  record.Add("sent", static_cast<uint64_t>(count))
+      .Add("failed", failed)
+      .Add(summary)
+      .Add("calls_per_s",
+           elapsed_s > 0 ? static_cast<double>(summary.count) / elapsed_s
+                         : 0.0)
+      .Emit(out);
+}
+
+}  // namespace
+
+void RunServiceBenchmark(const BenchmarkParam& param, std::ostream* out) {
+  std::shared_ptr<Node> node(CreateNode("cyber_benchmark_service"));
+  if (node == nullptr) {
+    AERROR << "create node failed.";
+    return;
+  }
+  for (auto size : param.sizes) {
+    AINFO << "benchmark service, size " << size;
+    RunCase(node, size, param.count, out);
+  }
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,240 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/tools/cyber_benchmark/benchmark.h"
+#include "cyber/transport/qos/qos_profile_conf.h"
+#include "cyber/transport/transport.h"
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+using apollo::cyber::common::GlobalData;
+using apollo::cyber::message::RawMessage;
+using apollo::cyber::proto::OptionalMode;
+using apollo::cyber::proto::RoleAttributes;
+using apollo::cyber::transport::MessageInfo;
+using apollo::cyber::transport::QosProfileConf;
+using apollo::cyber::transport::Transport;
+
+namespace {
+
+// every message starts with its sequence and the time it was sent
+const size_t kStampSize = 2 * sizeof(uint64_t);
+const uint64_t kWarmUpSeq = std::numeric_limits<uint64_t>::max();
+const uint64_t kMissing = std::numeric_limits<uint64_t>::max();
+
+class Probe {
+ public:
+  explicit Probe(uint32_t count) : latencies_(count, kMissing) {}
+
+  void OnMessage(const std::shared_ptr<RawMessage>& msg) {
+    auto now = SteadyNow();
+    if (msg->message.size() < kStampSize) {
+      return;
+    }
+    uint64_t seq = 0;
+    uint64_t stamp = 0;
+    memcpy(&seq, msg->message.data(), sizeof(seq));
+    memcpy(&stamp, msg->message.data() + sizeof(seq), sizeof(stamp));
+    warm_.store(true);
+    if (seq >= latencies_.size()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lg(mutex_);
+    if (latencies_[seq] == kMissing) {
+      latencies_[seq] = now - stamp;
+      last_receive_ns_ = now;
+      received_.fetch_add(1);
+    }
+  }
+
+  bool warm() const { return warm_.load(); }
+  uint32_t received() const { return received_.load(); }
+
+  // the received samples and the time the last one arrived
+  std::vector<uint64_t> Take(uint64_t* last_receive_ns) {
+    std::lock_guard<std::mutex> lg(mutex_);
+    std::vector<uint64_t> samples;
+    samples.reserve(received_.load());
+    for (auto latency : latencies_) {
+      if (latency != kMissing) {
+        samples.push_back(latency);
+      }
+    }
+    *last_receive_ns = last_receive_ns_;
+    return samples;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint64_t> latencies_;
+  uint64_t last_receive_ns_ = 0;
+  std::atomic<uint32_t> received_ = {0};
+  std::atomic<bool> warm_ = {false};
+};
+
+bool ParseMode(const std::string& name, OptionalMode* mode) {
+  if (name == "intra") {
+    *mode = OptionalMode::INTRA;
+  } else if (name == "shm") {
+    *mode = OptionalMode::SHM;
+  } else if (name == "rtps") {
+    *mode = OptionalMode::RTPS;
+  } else if (name == "hybrid") {
+    *mode = OptionalMode::HYBRID;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::shared_ptr<RawMessage> StampedMessage(uint32_t size, uint64_t seq) {
+  auto msg = std::make_shared<RawMessage>(
+      std::string(std::max<size_t>(size, kStampSize), 'c'));
+  auto now = SteadyNow();
+  memcpy(&msg->message[0], &seq, sizeof(seq));
+  memcpy(&msg->message[sizeof(seq)], &now, sizeof(now));
+  return msg;
+}
+
+// Sends count messages of size, paced by interval_us unless it is 0, and
+// reports what the reader got.
+void RunCase(const std::string& mode_name, OptionalMode mode, uint32_t size,
+             uint32_t count, uint32_t interval_us, std::ostream* out) {
+  const std::string phase = interval_us > 0 ? "latency" : "throughput";
+  const std::string channel = "/apollo/cyber/benchmark/" + mode_name + "/" +
+                              std::to_string(size) + "/" + phase;
+  auto global_data = GlobalData::Instance();
+  RoleAttributes attr;
+  attr.set_host_name(global_data->HostName());
+  attr.set_host_ip(global_data->HostIp());
+  attr.set_process_id(global_data->ProcessId());
+  attr.set_channel_name(channel);
+  attr.set_channel_id(GlobalData::RegisterChannel(channel));
+  auto qos = attr.mutable_qos_profile();
+  qos->CopyFrom(QosProfileConf::QOS_PROFILE_DEFAULT);
+  qos->set_depth(std::min<uint32_t>(count, 1000));
+
+  // callbacks in flight may outlive the case
+  auto probe = std::make_shared<Probe>(count);
+  auto transport = Transport::Instance();
+  auto transmitter = transport->CreateTransmitter<RawMessage>(attr, mode);
+  auto receiver = transport->CreateReceiver<RawMessage>(
+      attr,
+      [probe](const std::shared_ptr<RawMessage>& msg, const MessageInfo&,
+              const RoleAttributes&) { probe->OnMessage(msg); },
+      mode);
+  Record record("transport", mode_name + "/" + phase);
+  record.Add("mode", mode_name).Add("phase", phase).Add(
+      "size", static_cast<uint64_t>(size));
+  if (transmitter == nullptr || receiver == nullptr) {
+    record.Add("error", "transport unavailable").Emit(out);
+    return;
+  }
+  if (mode == OptionalMode::HYBRID) {
+    transmitter->Enable(receiver->attributes());
+    receiver->Enable(transmitter->attributes());
+  }
+
+  // rtps needs the reader matched before anything arrives
+  auto deadline = SteadyNow() + 3000000000ULL;
+  while (!probe->warm() && SteadyNow() < deadline) {
+    transmitter->Transmit(StampedMessage(size, kWarmUpSeq));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  if (!probe->warm()) {
+    record.Add("error", "no message arrived").Emit(out);
+    return;
+  }
+
+  auto start = SteadyNow();
+  auto next = std::chrono::steady_clock::now();
+  for (uint32_t seq = 0; seq < count; ++seq) {
+    transmitter->Transmit(StampedMessage(size, seq));
+    if (interval_us > 0) {
+      next += std::chrono::microseconds(interval_us);
+      std::this_thread::sleep_until(next);
+    }
+  }
+  auto sent = SteadyNow();
+
+  // wait until all arrived or nothing has for a while
+  uint32_t received = 0;
+  for (int idle = 0; idle < 100 && received < count; ++idle) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (probe->received() != received) {
+      received = probe->received();
+      idle = 0;
+    }
+  }
+
+  if (mode == OptionalMode::HYBRID) {
+    receiver->Disable(transmitter->attributes());
+    transmitter->Disable(receiver->attributes());
+  } else {
+    receiver->Disable();
+    transmitter->Disable();
+  }
+
+  uint64_t last_receive = 0;
+  auto samples = probe->Take(&last_receive);
+  auto summary = Summarize(&samples);
+  double elapsed_s =
+      static_cast<double>(std::max(last_receive, sent) - start) / 1e9;
+  double msgs_per_s =
+      elapsed_s > 0 ? static_cast<double>(summary.count) / elapsed_s : 0.0;
+  record.Add("sent", static_cast<uint64_t>(count))
+      .Add("lost", static_cast<uint64_t>(count - summary.count))
+      .Add(summary)
+      .Add("msgs_per_s", msgs_per_s)
+      .Add("mb_per_s", msgs_per_s * size / 1e6)
+      .Emit(out);
+}
+
+}  // namespace
+
+void RunTransportBenchmark(const BenchmarkParam& param, std::ostream* out) {
+  for (auto& mode_name : param.modes) {
+    OptionalMode mode;
+    if (!ParseMode(mode_name, &mode)) {
+      AERROR << "unknown transport mode: " << mode_name;
+      continue;
+    }
+    for (auto size : param.sizes) {
+      AINFO << "benchmark " << mode_name << " transport, size " << size;
+      RunCase(mode_name, mode, size, param.count, param.interval_us, out);
+      RunCase(mode_name, mode, size, param.count, 0, out);
+    }
+  }
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
@@ -185,6 +185,11 @@ void CyberTopologyMessage::ChangeState(const Screen* s, int key) {
       second_column_ = SecondColumnType::MessageType;
       break;
 
+    case 'b':
+    case 'B':
+      second_column_ = SecondColumnType::MessageBandwidth;
+      break;
+
     case ' ': {
       auto iter = FindChild(*line_no());
       if (!GeneralChannelMessage::IsErrorCode(iter->second)) {
@@ -214,6 +219,13 @@ int CyberTopologyMessage::Render(const Screen* s, int key) {
   ChangeState(s, key);
   SplitPages(key);
 
+  // no channel is on the screen, only count their messages
+  for (auto& item : all_channels_map_) {
+    if (!GeneralChannelMessage::IsErrorCode(item.second)) {
+      item.second->DisableMessage();
+    }
+  }
+
   s->AddStr(0, 0, Screen::WHITE_BLACK, "Channels");
   switch (second_column_) {
     case SecondColumnType::MessageType:
@@ -224,6 +236,10 @@ int CyberTopologyMessage::Render(const Screen* s, int key) {
       s->AddStr(col1_width_ + SecondColumnOffset, 0, Screen::WHITE_BLACK,
                 "FrameRatio");
       break;
+    case SecondColumnType::MessageBandwidth:
+      s->AddStr(col1_width_ + SecondColumnOffset, 0, Screen::WHITE_BLACK,
+                "Bandwidth");
+      break;
   }
 
   auto iter = all_channels_map_.cbegin();
@@ -268,6 +284,12 @@ int CyberTopologyMessage::Render(const Screen* s, int key) {
           s->AddStr(col1_width_ + SecondColumnOffset, line,
                     out_str.str().c_str());
         } break;
+        case SecondColumnType::MessageBandwidth:
+          s->AddStr(col1_width_ + SecondColumnOffset, line,
+                    GeneralChannelMessage::BandwidthString(
+                        iter->second->bandwidth())
+                        .c_str());
+          break;
       }
     } else {
       GeneralChannelMessage::ErrorCode errcode =
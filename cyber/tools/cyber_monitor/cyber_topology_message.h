@@ -56,7 +56,11 @@ class CyberTopologyMessage : public RenderableMessage {
   std::map<std::string, GeneralChannelMessage*>::const_iterator FindChild(
       int index) const;
 
-  enum class SecondColumnType { MessageType, MessageFrameRatio };
+  enum class SecondColumnType {
+    MessageType,
+    MessageFrameRatio,
+    MessageBandwidth
+  };
   SecondColumnType second_column_;
 
   int pid_;
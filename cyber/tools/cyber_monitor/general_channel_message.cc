@@ -94,18 +94,43 @@ double GeneralChannelMessage::frame_ratio(void) {
     int old = frame_counter_;
     while (!frame_counter_.compare_exchange_strong(old, 0)) {
     }
+    uint64_t bytes = byte_counter_.exchange(0);
     if (old == 0) {
+      bandwidth_ = 0.0;
       return 0.0;
     }
     auto curMsgTime = msg_time_;
     auto deltaTime = curMsgTime - last_time_;
     frame_ratio_ = old / deltaTime.ToSecond();
+    bandwidth_ = static_cast<double>(bytes) / deltaTime.ToSecond();
     last_time_ = curMsgTime;
     time_last_calc_ = time_now;
   }
   return frame_ratio_;
 }
 
+double GeneralChannelMessage::bandwidth(void) {
+  if (frame_ratio() == 0.0) {
+    return 0.0;
+  }
+  return bandwidth_;
+}
+
+std::string GeneralChannelMessage::BandwidthString(double bytes_per_second) {
+  std::ostringstream out_str;
+  out_str << std::fixed << std::setprecision(FrameRatio_Precision);
+  if (bytes_per_second >= kGB) {
+    out_str << bytes_per_second / kGB << " GB/s";
+  } else if (bytes_per_second >= kMB) {
+    out_str << bytes_per_second / kMB << " MB/s";
+  } else if (bytes_per_second >= kKB) {
+    out_str << bytes_per_second / kKB << " KB/s";
+  } else {
+    out_str << bytes_per_second << " B/s";
+  }
+  return out_str.str();
+}
+
 GeneralChannelMessage* GeneralChannelMessage::OpenChannel(
     const std::string& channel_name) {
   if (channel_name.empty() || node_name_.empty()) {
@@ -120,15 +145,12 @@ GeneralChannelMessage* GeneralChannelMessage::OpenChannel(
     return CastErrorCode2Ptr(ErrorCode::CreateNodeFailed);
   }
 
-  auto callback =
-      [this](
-          const std::shared_ptr<apollo::cyber::message::RawMessage>& raw_msg) {
-        UpdateRawMessage(raw_msg);
-      };
+  auto callback = [this](const std::shared_ptr<ChannelMessageSize>& msg) {
+    UpdateMessageSize(msg);
+  };
 
   channel_reader_ =
-      channel_node_->CreateReader<apollo::cyber::message::RawMessage>(
-          channel_name, callback);
+      channel_node_->CreateReader<ChannelMessageSize>(channel_name, callback);
   if (channel_reader_ == nullptr) {
     channel_node_.reset();
     return CastErrorCode2Ptr(ErrorCode::CreateReaderFailed);
@@ -136,6 +158,41 @@ GeneralChannelMessage* GeneralChannelMessage::OpenChannel(
   return this;
 }
 
+void GeneralChannelMessage::EnableMessage(void) {
+  if (!is_enabled() || message_reader_ != nullptr) {
+    return;
+  }
+
+  message_node_ = apollo::cyber::CreateNode(node_name_ + "-message");
+  if (message_node_ == nullptr) {
+    return;
+  }
+
+  auto callback =
+      [this](
+          const std::shared_ptr<apollo::cyber::message::RawMessage>& raw_msg) {
+        UpdateRawMessage(raw_msg);
+      };
+
+  message_reader_ =
+      message_node_->CreateReader<apollo::cyber::message::RawMessage>(
+          channel_reader_->GetChannelName(), callback);
+  if (message_reader_ == nullptr) {
+    message_node_.reset();
+  }
+}
+
+void GeneralChannelMessage::DisableMessage(void) {
+  if (message_reader_ == nullptr) {
+    return;
+  }
+  message_reader_.reset();
+  message_node_.reset();
+
+  std::lock_guard<std::mutex> g(inner_lock_);
+  channel_message_.reset();
+}
+
 int GeneralChannelMessage::Render(const Screen* s, int key) {
   switch (key) {
     case 'b':
@@ -153,6 +210,7 @@ int GeneralChannelMessage::Render(const Screen* s, int key) {
   }
 
   clear();
+  EnableMessage();
 
   int line_no = 0;
 
@@ -243,9 +301,14 @@ void GeneralChannelMessage::RenderDebugString(const Screen* s, int key,
               << frame_ratio();
       s->AddStr(out_str.str().c_str());
 
+      s->AddStr(0, (*line_no)++, "Bandwidth: ");
+      s->AddStr(BandwidthString(bandwidth()).c_str());
+
       decltype(channel_message_) channel_msg = CopyMsgPtr();
 
-      if (channel_msg->message.size()) {
+      if (channel_msg == nullptr) {
+        s->AddStr(0, (*line_no)++, "Waiting for the next message");
+      } else if (channel_msg->message.size()) {
         s->AddStr(0, (*line_no)++, "RawMessage Size: ");
         out_str.str("");
         out_str << channel_msg->message.size() << " Bytes";
@@ -18,6 +18,7 @@
 #define TOOLS_CVT_MONITOR_GENERAL_CHANNEL_MESSAGE_H_
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,6 +30,49 @@
 class CyberTopologyMessage;
 class GeneralMessage;
 
+// Only records how many bytes came in, so counting the rate of a channel
+// neither copies nor parses the message. It registers as a RawMessage
+// reader, like the message reader of the channel shown on the screen.
+class ChannelMessageSize {
+ public:
+  ChannelMessageSize() : size_(0) {}
+  ChannelMessageSize(const ChannelMessageSize& other) : size_(other.size_) {}
+  ChannelMessageSize& operator=(const ChannelMessageSize& other) {
+    size_ = other.size_;
+    return *this;
+  }
+
+  static void GetDescriptorString(const std::string& type,
+                                  std::string* desc_str) {
+    apollo::cyber::message::RawMessage::GetDescriptorString(type, desc_str);
+  }
+
+  static std::string TypeName() {
+    return apollo::cyber::message::RawMessage::TypeName();
+  }
+
+  bool SerializeToArray(void* data, int size) const { return false; }
+  bool SerializeToString(std::string* str) const { return false; }
+
+  bool ParseFromArray(const void* data, int size) {
+    if (data == nullptr || size <= 0) {
+      return false;
+    }
+    size_ = static_cast<std::size_t>(size);
+    return true;
+  }
+
+  bool ParseFromString(const std::string& str) {
+    size_ = str.size();
+    return true;
+  }
+
+  std::size_t ByteSizeLong() const { return size_; }
+
+ private:
+  std::size_t size_;
+};
+
 class GeneralChannelMessage : public GeneralMessageBase {
  public:
   enum class ErrorCode {
@@ -53,8 +97,10 @@ class GeneralChannelMessage : public GeneralMessageBase {
   }
 
   ~GeneralChannelMessage() {
-    channel_node_.reset();
     channel_reader_.reset();
+    channel_node_.reset();
+    message_reader_.reset();
+    message_node_.reset();
     channel_message_.reset();
     if (raw_msg_class_) {
       delete raw_msg_class_;
@@ -75,6 +121,10 @@ class GeneralChannelMessage : public GeneralMessageBase {
   bool has_message_come(void) const { return has_message_come_; }
 
   double frame_ratio(void) override;
+  // bytes per second over the same window as frame_ratio
+  double bandwidth(void);
+
+  static std::string BandwidthString(double bytes_per_second);
 
   const std::string& NodeName(void) const { return node_name_; }
 
@@ -92,6 +142,8 @@ class GeneralChannelMessage : public GeneralMessageBase {
   int Render(const Screen* s, int key) override;
 
   void CloseChannel(void) {
+    DisableMessage();
+
     if (channel_reader_ != nullptr) {
       channel_reader_.reset();
     }
@@ -101,6 +153,11 @@ class GeneralChannelMessage : public GeneralMessageBase {
     }
   }
 
+  // The whole message is only received while the channel is on the screen,
+  // the topology view lives on the counting reader alone.
+  void EnableMessage(void);
+  void DisableMessage(void);
+
  private:
   explicit GeneralChannelMessage(const std::string& node_name,
                                  RenderableMessage* parent = nullptr)
@@ -109,6 +166,8 @@ class GeneralChannelMessage : public GeneralMessageBase {
         has_message_come_(false),
         message_type_(),
         frame_counter_(0),
+        byte_counter_(0),
+        bandwidth_(0.0),
         last_time_(apollo::cyber::Time::MonoTime()),
         msg_time_(last_time_.ToNanosecond() + 1),
         channel_node_(nullptr),
@@ -117,6 +176,8 @@ class GeneralChannelMessage : public GeneralMessageBase {
         writers_(),
         channel_message_(nullptr),
         channel_reader_(nullptr),
+        message_node_(nullptr),
+        message_reader_(nullptr),
         inner_lock_(),
         raw_msg_class_(nullptr) {}
 
@@ -142,11 +203,15 @@ class GeneralChannelMessage : public GeneralMessageBase {
     vec->emplace_back(str);
   }
 
-  void UpdateRawMessage(
-      const std::shared_ptr<apollo::cyber::message::RawMessage>& raw_msg) {
+  void UpdateMessageSize(const std::shared_ptr<ChannelMessageSize>& msg) {
     set_has_message_come(true);
     msg_time_ = apollo::cyber::Time::MonoTime();
+    byte_counter_ += msg->ByteSizeLong();
     ++frame_counter_;
+  }
+
+  void UpdateRawMessage(
+      const std::shared_ptr<apollo::cyber::message::RawMessage>& raw_msg) {
     std::lock_guard<std::mutex> _g(inner_lock_);
     channel_message_.reset();
     channel_message_ = raw_msg;
@@ -173,6 +238,8 @@ class GeneralChannelMessage : public GeneralMessageBase {
   bool has_message_come_;
   std::string message_type_;
   std::atomic<int> frame_counter_;
+  std::atomic<uint64_t> byte_counter_;
+  double bandwidth_;
   apollo::cyber::Time last_time_;
   apollo::cyber::Time msg_time_;
   apollo::cyber::Time time_last_calc_ = apollo::cyber::Time::MonoTime();
@@ -185,8 +252,11 @@ class GeneralChannelMessage : public GeneralMessageBase {
   std::vector<std::string> writers_;
 
   std::shared_ptr<apollo::cyber::message::RawMessage> channel_message_;
+  std::shared_ptr<apollo::cyber::Reader<ChannelMessageSize>> channel_reader_;
+
+  std::unique_ptr<apollo::cyber::Node> message_node_;
   std::shared_ptr<apollo::cyber::Reader<apollo::cyber::message::RawMessage>>
-      channel_reader_;
+      message_reader_;
   mutable std::mutex inner_lock_;
 
   google::protobuf::Message* raw_msg_class_;
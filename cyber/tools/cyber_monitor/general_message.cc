@@ -107,7 +107,12 @@ int GeneralMessage::Render(const Screen* s, int key) {
 
     clear();
 
+    channel_msg_ptr->EnableMessage();
     auto channel_msg = channel_msg_ptr->CopyMsgPtr();
+    if (channel_msg == nullptr) {
+      s->AddStr(0, line_no++, "Waiting for the next message");
+      return line_no;
+    }
     if (!channel_msg_ptr->raw_msg_class_->ParseFromString(
             channel_msg->message)) {
       s->AddStr(0, line_no++,
@@ -63,6 +63,7 @@ const char Screen::InteractiveCmdStr[] =
     "Commands for Topology message:\n"
     "   f | F -- show frame ratio for all channel messages\n"
     "   t | T -- show channel message type\n"
+    "   b | B -- show bandwidth for all channel messages\n"
     "\n"
     "   Space -- Enable|Disable channel Message\n"
     "\n"
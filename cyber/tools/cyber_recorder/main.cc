@@ -15,15 +15,20 @@
  *****************************************************************************/
 
 #include <getopt.h>
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "cyber/common/file.h"
 #include "cyber/common/time_conversion.h"
 #include "cyber/init.h"
+#include "cyber/record/file/chunk_codec.h"
 #include "cyber/tools/cyber_recorder/info.h"
 #include "cyber/tools/cyber_recorder/player/player.h"
 #include "cyber/tools/cyber_recorder/recorder.h"
@@ -33,6 +38,7 @@
 using apollo::cyber::common::GetFileName;
 using apollo::cyber::common::StringToUnixSeconds;
 using apollo::cyber::common::UnixSecondsToString;
+using apollo::cyber::record::ChunkCodec;
 using apollo::cyber::record::HeaderBuilder;
 using apollo::cyber::record::Info;
 using apollo::cyber::record::Player;
@@ -42,8 +48,8 @@ using apollo::cyber::record::Recoverer;
 using apollo::cyber::record::Spliter;
 
 const char INFO_OPTIONS[] = "h";
-const char RECORD_OPTIONS[] = "o:ac:k:i:m:h";
-const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:h";
+const char RECORD_OPTIONS[] = "o:ac:k:i:m:z:h";
+const char PLAY_OPTIONS[] = "f:ac:k:lr:b:e:s:d:p:t:h";
 const char SPLIT_OPTIONS[] = "f:o:c:k:b:e:h";
 const char RECOVER_OPTIONS[] = "f:o:h";
 
@@ -137,6 +143,11 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-p, --preload <seconds>\t\t\t" << command
                   << " after trying to preload n second(s)" << std::endl;
         break;
+      case 't':
+        std::cout << "\t-t, --prefetch <threads>\t\t" << command
+                  << " with n decode thread(s) and precise timing"
+                  << std::endl;
+        break;
       case 'i':
         std::cout << "\t-i, --segment-interval <seconds>\t" << command
                   << " segmented every n second(s)" << std::endl;
@@ -145,6 +156,10 @@ void DisplayUsage(const std::string& binary, const std::string& command,
         std::cout << "\t-m, --segment-size <MB>\t\t\t" << command
                   << " segmented every n megabyte(s)" << std::endl;
         break;
+      case 'z':
+        std::cout << "\t-z, --compress <none|lz4|bz2>\t\t" << command
+                  << " chunks compressed by codec" << std::endl;
+        break;
       case 'h':
         std::cout << "\t-h, --help\t\t\t\tshow help message" << std::endl;
         break;
@@ -170,7 +185,7 @@ int main(int argc, char** argv) {
   }
 
   int long_index = 0;
-  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:i:m:h";
+  const std::string short_opts = "f:c:k:o:alr:b:e:s:d:p:t:i:m:z:h";
   static const struct option long_opts[] = {
       {"files", required_argument, nullptr, 'f'},
       {"white-channel", required_argument, nullptr, 'c'},
@@ -184,8 +199,10 @@ int main(int argc, char** argv) {
       {"start", required_argument, nullptr, 's'},
       {"delay", required_argument, nullptr, 'd'},
       {"preload", required_argument, nullptr, 'p'},
+      {"prefetch", required_argument, nullptr, 't'},
       {"segment-interval", required_argument, nullptr, 'i'},
       {"segment-size", required_argument, nullptr, 'm'},
+      {"compress", required_argument, nullptr, 'z'},
       {"help", no_argument, nullptr, 'h'}};
 
   std::vector<std::string> opt_file_vec;
@@ -200,6 +217,7 @@ int main(int argc, char** argv) {
   uint64_t opt_start = 0;
   uint64_t opt_delay = 0;
   uint32_t opt_preload = 3;
+  uint32_t opt_prefetch = 0;
   auto opt_header = HeaderBuilder::GetHeader();
 
   do {
@@ -308,6 +326,25 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 't':
+        try {
+          int threads = std::stoi(optarg);
+          if (threads < 0) {
+            std::cout << "Argument is less than zero: -t/--prefetch "
+                      << std::string(optarg) << std::endl;
+            return -1;
+          }
+          opt_prefetch = threads;
+        } catch (std::invalid_argument& ia) {
+          std::cout << "Invalid argument: -t/--prefetch " << std::string(optarg)
+                    << std::endl;
+          return -1;
+        } catch (const std::out_of_range& e) {
+          std::cout << "Argument is out of range: -t/--prefetch "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        break;
       case 'i':
         try {
           int interval_s = std::stoi(optarg);
@@ -346,6 +383,16 @@ int main(int argc, char** argv) {
           return -1;
         }
         break;
+      case 'z': {
+        apollo::cyber::proto::CompressType compress_type;
+        if (!ChunkCodec::ParseName(std::string(optarg), &compress_type)) {
+          std::cout << "Invalid argument: -z/--compress "
+                    << std::string(optarg) << std::endl;
+          return -1;
+        }
+        opt_header.set_compress(compress_type);
+        break;
+      }
       case 'h':
         DisplayUsage(binary, command);
         return 0;
@@ -355,6 +402,29 @@ int main(int argc, char** argv) {
   } while (true);
 
   // cyber_recorder info
+  // files are independent of each other, split or recover them in parallel
+  auto process_files = [](size_t file_num,
+                          const std::function<bool(size_t)>& proc) {
+    const size_t thread_num = std::min<size_t>(
+        file_num, std::max(1u, std::thread::hardware_concurrency()));
+    std::atomic<size_t> next_file(0);
+    std::atomic<bool> result(true);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back([&]() {
+        for (size_t file = next_file++; file < file_num; file = next_file++) {
+          if (!proc(file)) {
+            result = false;
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return result.load();
+  };
+
   if (command == "info") {
     if (file_path.empty()) {
       std::cout << "usage: cyber_recorder info file" << std::endl;
@@ -369,17 +439,22 @@ int main(int argc, char** argv) {
       std::cout << "MUST specify file option (-f)." << std::endl;
       return -1;
     }
-    if (opt_file_vec.size() > 1 || opt_output_vec.size() > 1) {
-      std::cout << "TOO many input/output file option (-f/-o)." << std::endl;
+    if (!opt_output_vec.empty() &&
+        opt_output_vec.size() != opt_file_vec.size()) {
+      std::cout << "MUST specify one output file option (-o) per input file."
+                << std::endl;
       return -1;
     }
     if (opt_output_vec.empty()) {
-      std::string default_output_file = opt_file_vec[0] + ".recover";
-      opt_output_vec.push_back(default_output_file);
+      for (const auto& file : opt_file_vec) {
+        opt_output_vec.push_back(file + ".recover");
+      }
     }
     ::apollo::cyber::Init(argv[0]);
-    Recoverer recoverer(opt_file_vec[0], opt_output_vec[0]);
-    bool recover_result = recoverer.Proc();
+    bool recover_result = process_files(opt_file_vec.size(), [&](size_t i) {
+      Recoverer recoverer(opt_file_vec[i], opt_output_vec[i]);
+      return recoverer.Proc();
+    });
     return recover_result ? 0 : -1;
   }
 
@@ -398,6 +473,7 @@ int main(int argc, char** argv) {
     play_param.start_time_s = opt_start;
     play_param.delay_time_s = opt_delay;
     play_param.preload_time_s = opt_preload;
+    play_param.prefetch_threads = opt_prefetch;
     play_param.files_to_play.insert(opt_file_vec.begin(), opt_file_vec.end());
     play_param.black_channels.insert(opt_black_channels.begin(),
                                      opt_black_channels.end());
@@ -439,18 +515,23 @@ int main(int argc, char** argv) {
       std::cout << "Must specify file option (-f)." << std::endl;
       return -1;
     }
-    if (opt_file_vec.size() > 1 || opt_output_vec.size() > 1) {
-      std::cout << "Too many input/output file option (-f/-o)." << std::endl;
+    if (!opt_output_vec.empty() &&
+        opt_output_vec.size() != opt_file_vec.size()) {
+      std::cout << "Must specify one output file option (-o) per input file."
+                << std::endl;
       return -1;
     }
     if (opt_output_vec.empty()) {
-      std::string default_output_file = opt_file_vec[0] + ".split";
-      opt_output_vec.push_back(default_output_file);
+      for (const auto& file : opt_file_vec) {
+        opt_output_vec.push_back(file + ".split");
+      }
     }
     ::apollo::cyber::Init(argv[0]);
-    Spliter spliter(opt_file_vec[0], opt_output_vec[0], opt_white_channels,
-                    opt_black_channels, opt_begin, opt_end);
-    bool split_result = spliter.Proc();
+    bool split_result = process_files(opt_file_vec.size(), [&](size_t i) {
+      Spliter spliter(opt_file_vec[i], opt_output_vec[i], opt_white_channels,
+                      opt_black_channels, opt_begin, opt_end);
+      return spliter.Proc();
+    });
     return split_result ? 0 : -1;
   }
 
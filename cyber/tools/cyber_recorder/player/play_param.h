@@ -35,6 +35,8 @@ struct PlayParam {
   uint64_t start_time_s = 0;
   uint64_t delay_time_s = 0;
   uint32_t preload_time_s = 3;
+  // decode threads of the prefetch pipeline, zero keeps the plain viewer
+  uint32_t prefetch_threads = 0;
   std::set<std::string> files_to_play;
   std::set<std::string> channels_to_play;
   std::set<std::string> black_channels;
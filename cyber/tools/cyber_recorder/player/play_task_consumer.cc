@@ -26,10 +26,12 @@ namespace record {
 const uint64_t PlayTaskConsumer::kPauseSleepNanoSec = 100000000UL;
 const uint64_t PlayTaskConsumer::kWaitProduceSleepNanoSec = 5000000UL;
 const uint64_t PlayTaskConsumer::MIN_SLEEP_DURATION_NS = 200000000UL;
+const uint64_t PlayTaskConsumer::kSpinNanoSec = 2000000UL;
 
 PlayTaskConsumer::PlayTaskConsumer(const TaskBufferPtr& task_buffer,
-                                   double play_rate)
+                                   double play_rate, bool spin_wait)
     : play_rate_(play_rate),
+      spin_wait_(spin_wait),
       consume_th_(nullptr),
       task_buffer_(task_buffer),
       is_stopped_(true),
@@ -37,7 +39,10 @@ PlayTaskConsumer::PlayTaskConsumer(const TaskBufferPtr& task_buffer,
       is_playonce_(false),
       base_msg_play_time_ns_(0),
       base_msg_real_time_ns_(0),
-      last_played_msg_real_time_ns_(0) {
+      last_played_msg_real_time_ns_(0),
+      played_span_ns_(0),
+      elapsed_ns_(0),
+      max_lag_ns_(0) {
   if (play_rate_ <= 0) {
     AERROR << "invalid play rate: " << play_rate_
            << " , we will use default value(1.0).";
@@ -111,11 +116,16 @@ void PlayTaskConsumer::ThreadFunc() {
                                      accumulated_pause_time_ns;
     if (task_interval_ns > real_time_interval_ns) {
       sleep_ns = task_interval_ns - real_time_interval_ns;
-      std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+      Wait(sleep_ns);
+    } else if (real_time_interval_ns - task_interval_ns > max_lag_ns_.load()) {
+      max_lag_ns_.store(real_time_interval_ns - task_interval_ns);
     }
 
     task->Play();
     is_playonce_.store(false);
+    played_span_ns_.store(task->msg_play_time_ns() - base_msg_play_time_ns_);
+    elapsed_ns_.store(Time::Now().ToNanosecond() - base_real_time_ns -
+                      accumulated_pause_time_ns);
 
     last_played_msg_real_time_ns_ = task->msg_real_time_ns();
     while (is_paused_.load() && !is_stopped_.load()) {
@@ -129,6 +139,23 @@ void PlayTaskConsumer::ThreadFunc() {
   }
 }
 
+void PlayTaskConsumer::Wait(uint64_t sleep_ns) {
+  if (!spin_wait_) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_ns));
+    return;
+  }
+  // sleep coarsely and spin out the rest, a plain sleep overshoots by the
+  // timer slack which adds up to visible drift at high play rates
+  uint64_t deadline_ns = Time::Now().ToNanosecond() + sleep_ns;
+  if (sleep_ns > kSpinNanoSec) {
+    std::this_thread::sleep_for(
+        std::chrono::nanoseconds(sleep_ns - kSpinNanoSec));
+  }
+  while (Time::Now().ToNanosecond() < deadline_ns && !is_stopped_.load()) {
+    std::this_thread::yield();
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
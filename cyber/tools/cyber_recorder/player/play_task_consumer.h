@@ -34,7 +34,7 @@ class PlayTaskConsumer {
   using TaskBufferPtr = std::shared_ptr<PlayTaskBuffer>;
 
   explicit PlayTaskConsumer(const TaskBufferPtr& task_buffer,
-                            double play_rate = 1.0);
+                            double play_rate = 1.0, bool spin_wait = false);
   virtual ~PlayTaskConsumer();
 
   void Start(uint64_t begin_time_ns);
@@ -49,10 +49,22 @@ class PlayTaskConsumer {
     return last_played_msg_real_time_ns_;
   }
 
+  // record time played per wall time, the requested rate when on schedule
+  double achieved_rate() const {
+    uint64_t elapsed_ns = elapsed_ns_.load();
+    return elapsed_ns == 0 ? 0.0
+                           : static_cast<double>(played_span_ns_.load()) /
+                                 static_cast<double>(elapsed_ns);
+  }
+  // worst delay of a message behind its scheduled publish time
+  uint64_t max_lag_ns() const { return max_lag_ns_.load(); }
+
  private:
   void ThreadFunc();
+  void Wait(uint64_t sleep_ns);
 
   double play_rate_;
+  bool spin_wait_;
   ThreadPtr consume_th_;
   TaskBufferPtr task_buffer_;
   std::atomic<bool> is_stopped_;
@@ -62,9 +74,13 @@ class PlayTaskConsumer {
   uint64_t base_msg_play_time_ns_;
   uint64_t base_msg_real_time_ns_;
   uint64_t last_played_msg_real_time_ns_;
+  std::atomic<uint64_t> played_span_ns_;
+  std::atomic<uint64_t> elapsed_ns_;
+  std::atomic<uint64_t> max_lag_ns_;
   static const uint64_t kPauseSleepNanoSec;
   static const uint64_t kWaitProduceSleepNanoSec;
   static const uint64_t MIN_SLEEP_DURATION_NS;
+  static const uint64_t kSpinNanoSec;
 };
 
 }  // namespace record
@@ -23,6 +23,7 @@
 #include "cyber/common/time_conversion.h"
 #include "cyber/cyber.h"
 #include "cyber/message/protobuf_factory.h"
+#include "cyber/record/parallel_record_viewer.h"
 #include "cyber/record/record_viewer.h"
 
 namespace apollo {
@@ -105,6 +106,7 @@ bool PlayTaskProducer::ReadRecordInfo() {
     }
 
     record_readers_.emplace_back(record_reader);
+    record_files_.emplace_back(file);
 
     auto channel_list = record_reader->GetChannelList();
     // loop each channel info
@@ -237,6 +239,11 @@ void PlayTaskProducer::ThreadFunc() {
     preload_size = kMinTaskBufferSize;
   }
 
+  if (play_param_.prefetch_threads > 0) {
+    ProducePrefetched(preload_size, avg_interval_time_ns, loop_time_ns);
+    return;
+  }
+
   auto record_viewer = std::make_shared<RecordViewer>(
       record_readers_, play_param_.begin_time_ns, play_param_.end_time_ns,
       play_param_.channels_to_play);
@@ -277,6 +284,51 @@ void PlayTaskProducer::ThreadFunc() {
   }
 }
 
+void PlayTaskProducer::ProducePrefetched(uint32_t preload_size,
+                                         uint64_t avg_interval_time_ns,
+                                         uint64_t loop_time_ns) {
+  // buffers stay with the pool and keep their capacity, so dense lidar bags
+  // do not pay for a fresh allocation and page faults on every message
+  msg_pool_.reset(new base::CCObjectPool<message::RawMessage>(
+      preload_size + kMinTaskBufferSize));
+  msg_pool_->ConstructAll();
+
+  ParallelRecordViewer viewer(record_files_, play_param_.begin_time_ns,
+                              play_param_.end_time_ns,
+                              play_param_.channels_to_play,
+                              play_param_.prefetch_threads);
+  RecordMessage msg;
+  uint32_t loop_num = 0;
+  while (!is_stopped_.load()) {
+    uint64_t plus_time_ns = loop_num * loop_time_ns;
+    while (!is_stopped_.load() && viewer.ReadMessage(&msg)) {
+      auto search = writers_.find(msg.channel_name);
+      if (search == writers_.end()) {
+        continue;
+      }
+      while (!is_stopped_.load() && task_buffer_->Size() > preload_size) {
+        std::this_thread::sleep_for(
+            std::chrono::nanoseconds(avg_interval_time_ns));
+      }
+      auto raw_msg = msg_pool_->GetObject();
+      if (raw_msg == nullptr) {
+        raw_msg = std::make_shared<message::RawMessage>();
+      }
+      raw_msg->message.assign(msg.content);
+      auto task = std::make_shared<PlayTask>(
+          raw_msg, search->second, msg.time, msg.time + plus_time_ns);
+      task_buffer_->Push(task);
+    }
+
+    if (!play_param_.is_loop_playback) {
+      is_stopped_.store(true);
+      break;
+    }
+    viewer.Reset();
+    ++loop_num;
+  }
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
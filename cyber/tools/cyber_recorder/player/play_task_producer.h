@@ -27,6 +27,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/message/raw_message.h"
 #include "cyber/node/node.h"
 #include "cyber/node/writer.h"
@@ -47,6 +48,8 @@ class PlayTaskProducer {
   using WriterPtr = std::shared_ptr<Writer<message::RawMessage>>;
   using WriterMap = std::unordered_map<std::string, WriterPtr>;
   using MessageTypeMap = std::unordered_map<std::string, std::string>;
+  using MessagePoolPtr =
+      std::shared_ptr<base::CCObjectPool<message::RawMessage>>;
 
   PlayTaskProducer(const TaskBufferPtr& task_buffer,
                    const PlayParam& play_param);
@@ -64,6 +67,8 @@ class PlayTaskProducer {
   bool UpdatePlayParam();
   bool CreateWriters();
   void ThreadFunc();
+  void ProducePrefetched(uint32_t preload_size, uint64_t avg_interval_time_ns,
+                         uint64_t loop_time_ns);
 
   PlayParam play_param_;
   TaskBufferPtr task_buffer_;
@@ -76,6 +81,8 @@ class PlayTaskProducer {
   WriterMap writers_;
   MessageTypeMap msg_types_;
   std::vector<RecordReaderPtr> record_readers_;
+  std::vector<std::string> record_files_;
+  MessagePoolPtr msg_pool_;
 
   uint64_t earliest_begin_time_;
   uint64_t latest_end_time_;
@@ -33,7 +33,8 @@ Player::Player(const PlayParam& play_param)
       producer_(nullptr),
       task_buffer_(nullptr) {
   task_buffer_ = std::make_shared<PlayTaskBuffer>();
-  consumer_.reset(new PlayTaskConsumer(task_buffer_, play_param.play_rate));
+  consumer_.reset(new PlayTaskConsumer(task_buffer_, play_param.play_rate,
+                                       play_param.prefetch_threads > 0));
   producer_.reset(new PlayTaskProducer(task_buffer_, play_param));
 }
 
@@ -163,7 +164,8 @@ bool Player::Start() {
 
     std::cout << std::setprecision(3) << last_played_msg_real_time_s
               << "    Progress: " << progress_time_s << " / "
-              << total_progress_time_s;
+              << total_progress_time_s << "    Rate: " << std::setprecision(2)
+              << consumer_->achieved_rate() << " / " << play_param.play_rate;
     std::cout.flush();
 
     if (producer_->is_stopped() && task_buffer_->Empty()) {
@@ -174,7 +176,11 @@ bool Player::Start() {
         std::chrono::milliseconds(kSleepIntervalMiliSec));
   }
 
-  std::cout << "\nplay finished." << std::endl;
+  std::cout << "\nplay finished, achieved rate: " << std::setprecision(3)
+            << consumer_->achieved_rate()
+            << ", requested rate: " << play_param.play_rate << ", max lag: "
+            << static_cast<double>(consumer_->max_lag_ns()) / 1e6 << " ms."
+            << std::endl;
   std::cout.flags(before);
   return true;
 }
@@ -71,7 +71,13 @@ bool Recoverer::Proc() {
     }
   }
 
+  // intact chunks stored with the compress type of the output are copied
+  // as they are
+  copy_chunks_ = reader_.GetHeader().compress() == new_hdr.compress();
+
   // read through record file
+  ChunkHeader chdr;
+  bool chunk_header_valid = false;
   reader_.Reset();
   while (!reader_.EndOfFile()) {
     Section section;
@@ -97,15 +103,29 @@ bool Recoverer::Proc() {
         break;
       }
       case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
-        if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
+        chunk_header_valid =
+            reader_.ReadSection<ChunkHeader>(section.size, &chdr);
+        if (!chunk_header_valid) {
           AINFO << "one chunk header section broken, skip it.";
         }
         break;
       }
       case SectionType::SECTION_CHUNK_BODY: {
+        // the header only describes the body right behind it
+        const bool copy_chunk = chunk_header_valid;
+        chunk_header_valid = false;
+        std::string data;
+        std::string serialized;
+        if (!reader_.ReadRawSection(section.size, &data) ||
+            !reader_.DecodeChunkBody(data, &serialized)) {
+          AINFO << "one chunk body section broken, skip it";
+          break;
+        }
+        if (copy_chunk && CopyChunk(chdr, data, serialized)) {
+          break;
+        }
         ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
+        if (!cbd.ParseFromString(serialized)) {
           AINFO << "one chunk body section broken, skip it";
           break;
         }
@@ -128,6 +148,27 @@ bool Recoverer::Proc() {
   return true;
 }  // end for Proc()
 
+bool Recoverer::CopyChunk(const ChunkHeader& chunk_header,
+                          const std::string& data,
+                          const std::string& serialized) {
+  if (!copy_chunks_) {
+    return false;
+  }
+  std::unordered_map<std::string, uint64_t> channel_message_number;
+  if (!RecordFileReader::CountChunkMessages(serialized,
+                                            &channel_message_number)) {
+    return false;
+  }
+  uint64_t message_number = 0;
+  for (const auto& item : channel_message_number) {
+    message_number += item.second;
+  }
+  if (message_number != chunk_header.message_number()) {
+    return false;
+  }
+  return writer_.WriteEncodedChunk(chunk_header, data, channel_message_number);
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
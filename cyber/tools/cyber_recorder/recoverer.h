@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -43,11 +44,15 @@ class Recoverer {
   bool Proc();
 
  private:
+  bool CopyChunk(const ChunkHeader& chunk_header, const std::string& data,
+                 const std::string& serialized);
+
   RecordFileReader reader_;
   RecordFileWriter writer_;
   std::string input_file_;
   std::string output_file_;
   std::vector<std::string> channel_vec_;
+  bool copy_chunks_ = false;
 };
 
 }  // namespace record
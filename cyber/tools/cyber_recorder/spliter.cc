@@ -77,8 +77,13 @@ bool Spliter::Proc() {
     return false;
   }
 
+  // chunks stored with the compress type of the output are copied as they
+  // are when all of their messages are kept
+  copy_chunks_ = header.compress() == new_hdr.compress();
+
   // read through record file
   bool skip_next_chunk_body(false);
+  ChunkHeader chdr;
   reader_.Reset();
   while (!reader_.EndOfFile()) {
     Section section;
@@ -96,18 +101,12 @@ bool Spliter::Proc() {
           AERROR << "read channel section fail.";
           return false;
         }
-        if (white_channels_.empty() ||
-            std::find(white_channels_.begin(), white_channels_.end(),
-                      chan.name()) != white_channels_.end()) {
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        chan.name()) == black_channels_.end()) {
-            writer_.WriteChannel(chan);
-          }
+        if (IsSelected(chan.name())) {
+          writer_.WriteChannel(chan);
         }
         break;
       }
       case SectionType::SECTION_CHUNK_HEADER: {
-        ChunkHeader chdr;
         if (!reader_.ReadSection<ChunkHeader>(section.size, &chdr)) {
           AERROR << "read chunk header section fail.";
           return false;
@@ -123,21 +122,23 @@ bool Spliter::Proc() {
           skip_next_chunk_body = false;
           break;
         }
-        ChunkBody cbd;
-        if (!reader_.ReadSection<ChunkBody>(section.size, &cbd)) {
+        std::string data;
+        std::string serialized;
+        if (!reader_.ReadRawSection(section.size, &data) ||
+            !reader_.DecodeChunkBody(data, &serialized)) {
           AERROR << "read chunk body section fail.";
           return false;
         }
+        if (CopyChunk(chdr, data, serialized)) {
+          break;
+        }
+        ChunkBody cbd;
+        if (!cbd.ParseFromString(serialized)) {
+          AERROR << "parse chunk body section fail.";
+          return false;
+        }
         for (int idx = 0; idx < cbd.messages_size(); ++idx) {
-          if (!white_channels_.empty() &&
-              std::find(white_channels_.begin(), white_channels_.end(),
-                        cbd.messages(idx).channel_name()) ==
-                  white_channels_.end()) {
-            continue;
-          }
-          if (std::find(black_channels_.begin(), black_channels_.end(),
-                        cbd.messages(idx).channel_name()) !=
-              black_channels_.end()) {
+          if (!IsSelected(cbd.messages(idx).channel_name())) {
             continue;
           }
           if (cbd.messages(idx).time() < begin_time_ ||
@@ -162,6 +163,42 @@ bool Spliter::Proc() {
   return true;
 }  // end for Proc()
 
+bool Spliter::IsSelected(const std::string& channel_name) const {
+  if (!white_channels_.empty() &&
+      std::find(white_channels_.begin(), white_channels_.end(),
+                channel_name) == white_channels_.end()) {
+    return false;
+  }
+  return std::find(black_channels_.begin(), black_channels_.end(),
+                   channel_name) == black_channels_.end();
+}
+
+bool Spliter::CopyChunk(const ChunkHeader& chunk_header,
+                        const std::string& data,
+                        const std::string& serialized) {
+  if (!copy_chunks_ || chunk_header.begin_time() < begin_time_ ||
+      chunk_header.end_time() > end_time_) {
+    return false;
+  }
+  std::unordered_map<std::string, uint64_t> channel_message_number;
+  if (!RecordFileReader::CountChunkMessages(serialized,
+                                            &channel_message_number)) {
+    return false;
+  }
+  uint64_t message_number = 0;
+  for (const auto& item : channel_message_number) {
+    if (!IsSelected(item.first)) {
+      return false;
+    }
+    message_number += item.second;
+  }
+  // a header that does not match its body is rewritten message by message
+  if (message_number != chunk_header.message_number()) {
+    return false;
+  }
+  return writer_.WriteEncodedChunk(chunk_header, data, channel_message_number);
+}
+
 }  // namespace record
 }  // namespace cyber
 }  // namespace apollo
@@ -21,6 +21,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cyber/common/log.h"
@@ -49,6 +50,10 @@ class Spliter {
   bool Proc();
 
  private:
+  bool IsSelected(const std::string& channel_name) const;
+  bool CopyChunk(const ChunkHeader& chunk_header, const std::string& data,
+                 const std::string& serialized);
+
   RecordFileReader reader_;
   RecordFileWriter writer_;
   std::string input_file_;
@@ -58,6 +63,7 @@ class Spliter {
   bool all_channels_;
   uint64_t begin_time_;
   uint64_t end_time_;
+  bool copy_chunks_ = false;
 };
 
 }  // namespace record
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/common/transport_stats.h"
+
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using apollo::cyber::base::LatencyHistogram;
+
+namespace {
+void FillHistogram(const LatencyHistogram& hist,
+                   proto::LatencyHistogram* msg) {
+  msg->set_count(hist.Count());
+  msg->set_sum_ns(hist.Sum());
+  msg->set_max_ns(hist.Max());
+  msg->set_p50_us(hist.Percentile(0.5));
+  msg->set_p99_us(hist.Percentile(0.99));
+  for (uint32_t i = 0; i < LatencyHistogram::kBucketNum; ++i) {
+    msg->add_bucket(hist.Bucket(i));
+  }
+}
+}  // namespace
+
+ChannelStats::ChannelStats(const std::string& channel_name,
+                           const std::string& role, const std::string& mode)
+    : channel_name_(channel_name),
+      role_(role),
+      mode_(mode),
+      collected_ns_(Time::Now().ToNanosecond()) {}
+
+void ChannelStats::OnTransmit(uint64_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++messages_;
+  bytes_ += bytes;
+}
+
+void ChannelStats::OnReceive(const MessageInfo& msg_info) {
+  uint64_t now = Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++messages_;
+  // clocks of other hosts may run ahead
+  if (msg_info.send_time() != 0 && now >= msg_info.send_time()) {
+    publish_to_notify_.Record(now - msg_info.send_time());
+  }
+
+  auto& last_seq = last_seqs_[msg_info.sender_id().HashValue()];
+  if (last_seq != 0 && msg_info.seq_num() > last_seq + 1) {
+    seq_gaps_ += msg_info.seq_num() - last_seq - 1;
+  }
+  last_seq = msg_info.seq_num();
+}
+
+void ChannelStats::OnNotify() {
+  notify_ns_.store(Time::Now().ToNanosecond(), std::memory_order_relaxed);
+}
+
+void ChannelStats::OnCallback(uint64_t* last_notify_ns) {
+  uint64_t notify_ns = notify_ns_.load(std::memory_order_relaxed);
+  if (notify_ns == 0 || notify_ns == *last_notify_ns) {
+    return;
+  }
+  *last_notify_ns = notify_ns;
+  uint64_t now = Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++messages_;
+  if (now >= notify_ns) {
+    notify_to_callback_.Record(now - notify_ns);
+  }
+}
+
+void ChannelStats::Collect(proto::ChannelTransportStats* stats) {
+  uint64_t now = Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats->set_channel_name(channel_name_);
+  stats->set_role(role_);
+  stats->set_mode(mode_);
+  stats->set_messages(messages_);
+  stats->set_bytes(bytes_);
+  stats->set_seq_gaps(seq_gaps_);
+  if (now > collected_ns_) {
+    stats->set_bytes_per_sec(static_cast<double>(bytes_ - collected_bytes_) *
+                             1e9 / static_cast<double>(now - collected_ns_));
+  }
+  collected_bytes_ = bytes_;
+  collected_ns_ = now;
+  FillHistogram(publish_to_notify_, stats->mutable_publish_to_notify());
+  FillHistogram(notify_to_callback_, stats->mutable_notify_to_callback());
+}
+
+TransportStats::TransportStats() {}
+
+std::shared_ptr<ChannelStats> TransportStats::Get(
+    const std::string& channel_name, const std::string& role,
+    const std::string& mode) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& stats = stats_[Key(channel_name, role, mode)];
+  if (stats == nullptr) {
+    stats = std::make_shared<ChannelStats>(channel_name, role, mode);
+  }
+  return stats;
+}
+
+void TransportStats::Collect(proto::TransportStats* stats) {
+  stats->set_timestamp(Time::Now().ToNanosecond());
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& item : stats_) {
+    item.second->Collect(stats->add_channel());
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
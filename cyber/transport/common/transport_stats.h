@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_COMMON_TRANSPORT_STATS_H_
+#define CYBER_TRANSPORT_COMMON_TRANSPORT_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "cyber/proto/transport_stats.pb.h"
+
+#include "cyber/base/latency_histogram.h"
+#include "cyber/common/macros.h"
+#include "cyber/transport/message/message_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Always-on counters of one channel seen by one role and transport.
+class ChannelStats {
+ public:
+  ChannelStats(const std::string& channel_name, const std::string& role,
+               const std::string& mode);
+
+  // a writer handed a message of the given serialized size to its transport
+  void OnTransmit(uint64_t bytes);
+  // a receiver got a message, sent at msg_info.send_time()
+  void OnReceive(const MessageInfo& msg_info);
+  // the readers have been notified of a new message
+  void OnNotify();
+  // a reader callback runs, last_notify_ns is the notification the calling
+  // reader saw before so that each notification is counted once per reader
+  void OnCallback(uint64_t* last_notify_ns);
+
+  void Collect(proto::ChannelTransportStats* stats);
+
+ private:
+  std::string channel_name_;
+  std::string role_;
+  std::string mode_;
+
+  std::mutex mutex_;
+  uint64_t messages_ = 0;
+  uint64_t bytes_ = 0;
+  uint64_t seq_gaps_ = 0;
+  // key: sender id hash, value: last seq_num
+  std::unordered_map<uint64_t, uint64_t> last_seqs_;
+  base::LatencyHistogram publish_to_notify_;
+  base::LatencyHistogram notify_to_callback_;
+  std::atomic<uint64_t> notify_ns_ = {0};
+
+  uint64_t collected_bytes_ = 0;
+  uint64_t collected_ns_ = 0;
+};
+
+class TransportStats {
+ public:
+  std::shared_ptr<ChannelStats> Get(const std::string& channel_name,
+                                    const std::string& role,
+                                    const std::string& mode);
+
+  void Collect(proto::TransportStats* stats);
+
+ private:
+  using Key = std::tuple<std::string, std::string, std::string>;
+
+  std::mutex mutex_;
+  std::map<Key, std::shared_ptr<ChannelStats>> stats_;
+
+  DECLARE_SINGLETON(TransportStats)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_COMMON_TRANSPORT_STATS_H_
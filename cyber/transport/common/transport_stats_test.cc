@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/common/transport_stats.h"
+
+#include "gtest/gtest.h"
+
+#include "cyber/time/time.h"
+#include "cyber/transport/common/identity.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(TransportStatsTest, receive) {
+  ChannelStats stats("receive", "receiver", "shm");
+  Identity sender;
+  MessageInfo msg_info(sender, 1);
+  msg_info.set_send_time(Time::Now().ToNanosecond() - 2000000);
+  stats.OnReceive(msg_info);
+  msg_info.set_seq_num(2);
+  stats.OnReceive(msg_info);
+  msg_info.set_seq_num(5);
+  stats.OnReceive(msg_info);
+
+  // an unstamped message from another sender starts its own sequence
+  Identity other;
+  MessageInfo other_info(other, 10);
+  stats.OnReceive(other_info);
+
+  proto::ChannelTransportStats msg;
+  stats.Collect(&msg);
+  EXPECT_EQ(msg.channel_name(), "receive");
+  EXPECT_EQ(msg.role(), "receiver");
+  EXPECT_EQ(msg.mode(), "shm");
+  EXPECT_EQ(msg.messages(), 4);
+  EXPECT_EQ(msg.seq_gaps(), 2);
+  EXPECT_EQ(msg.publish_to_notify().count(), 3);
+  EXPECT_GE(msg.publish_to_notify().max_ns(), 2000000);
+  EXPECT_EQ(msg.notify_to_callback().count(), 0);
+}
+
+TEST(TransportStatsTest, transmit) {
+  ChannelStats stats("transmit", "writer", "rtps");
+  stats.OnTransmit(100);
+  stats.OnTransmit(300);
+
+  proto::ChannelTransportStats msg;
+  stats.Collect(&msg);
+  EXPECT_EQ(msg.messages(), 2);
+  EXPECT_EQ(msg.bytes(), 400);
+  EXPECT_GT(msg.bytes_per_sec(), 0.0);
+
+  // the rate only covers what was sent since the last collection
+  msg.Clear();
+  stats.Collect(&msg);
+  EXPECT_EQ(msg.bytes(), 400);
+  EXPECT_EQ(msg.bytes_per_sec(), 0.0);
+}
+
+TEST(TransportStatsTest, callback) {
+  ChannelStats stats("callback", "reader", "");
+  uint64_t last_a = 0;
+  uint64_t last_b = 0;
+
+  // no notification yet
+  stats.OnCallback(&last_a);
+  stats.OnNotify();
+  stats.OnCallback(&last_a);
+  stats.OnCallback(&last_b);
+  // the same notification is not timed twice by one reader
+  stats.OnCallback(&last_a);
+
+  proto::ChannelTransportStats msg;
+  stats.Collect(&msg);
+  EXPECT_EQ(msg.notify_to_callback().count(), 2);
+  EXPECT_NE(last_a, 0);
+  EXPECT_EQ(last_a, last_b);
+}
+
+TEST(TransportStatsTest, collect) {
+  auto stats = TransportStats::Instance();
+  auto writer = stats->Get("collect", "writer", "intra");
+  EXPECT_EQ(writer, stats->Get("collect", "writer", "intra"));
+  EXPECT_NE(writer, stats->Get("collect", "writer", "shm"));
+  writer->OnTransmit(0);
+
+  proto::TransportStats msg;
+  stats->Collect(&msg);
+  EXPECT_GT(msg.timestamp(), 0);
+  bool found = false;
+  for (auto& channel : msg.channel()) {
+    if (channel.channel_name() == "collect" && channel.mode() == "intra") {
+      EXPECT_EQ(channel.messages(), 1);
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -60,14 +60,22 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
   ADEBUG << "Reading sharedmem message: "
          << GlobalData::GetChannelById(channel_id)
          << " from block: " << block_index;
-  auto rb = std::make_shared<ReadableBlock>();
-  rb->index = block_index;
-  if (!segments_[channel_id]->AcquireBlockToRead(rb.get())) {
+  auto segment = segments_[channel_id];
+  ReadableBlock block;
+  block.index = block_index;
+  if (!segment->AcquireBlockToRead(&block)) {
     AWARN << "fail to acquire block, channel: "
           << GlobalData::GetChannelById(channel_id)
           << " index: " << block_index;
     return;
   }
+  // listeners of loanable messages may keep the block beyond this call, so
+  // the read lock goes with the last reference.
+  std::shared_ptr<ReadableBlock> rb(
+      new ReadableBlock(block), [segment](ReadableBlock* rb) {
+        segment->ReleaseReadBlock(*rb);
+        delete rb;
+      });
 
   MessageInfo msg_info;
   const char* msg_info_addr =
@@ -79,7 +87,6 @@ void ShmDispatcher::ReadMessage(uint64_t channel_id, uint32_t block_index) {
     AERROR << "error msg info of channel:"
            << GlobalData::GetChannelById(channel_id);
   }
-  segments_[channel_id]->ReleaseReadBlock(*rb);
 }
 
 void ShmDispatcher::OnMessage(uint64_t channel_id,
@@ -21,12 +21,14 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
 
 #include "cyber/base/atomic_rw_lock.h"
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/common/macros.h"
+#include "cyber/message/arena_pool.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/transport/dispatcher/dispatcher.h"
 #include "cyber/transport/shm/notifier_factory.h"
@@ -61,6 +63,16 @@ class ShmDispatcher : public Dispatcher {
                    const MessageListener<MessageT>& listener);
 
  private:
+  template <typename MessageT>
+  MessageListener<ReadableBlock> CreateListenerAdapter(
+      const RoleAttributes& self_attr,
+      const MessageListener<MessageT>& listener, std::true_type);
+
+  template <typename MessageT>
+  MessageListener<ReadableBlock> CreateListenerAdapter(
+      const RoleAttributes& self_attr,
+      const MessageListener<MessageT>& listener, std::false_type);
+
   void AddSegment(const RoleAttributes& self_attr);
   void ReadMessage(uint64_t channel_id, uint32_t block_index);
   void OnMessage(uint64_t channel_id, const std::shared_ptr<ReadableBlock>& rb,
@@ -79,16 +91,41 @@ class ShmDispatcher : public Dispatcher {
 };
 
 template <typename MessageT>
-void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
-                                const MessageListener<MessageT>& listener) {
-  // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
+MessageListener<ReadableBlock> ShmDispatcher::CreateListenerAdapter(
+    const RoleAttributes& self_attr, const MessageListener<MessageT>& listener,
+    std::true_type) {
+  (void)self_attr;
+  // hand out a view of the block instead of a parsed copy, the read lock is
+  // held until the last reference to the message is gone.
+  return [listener](const std::shared_ptr<ReadableBlock>& rb,
+                    const MessageInfo& msg_info) {
+    RETURN_IF(rb->block->msg_size() != sizeof(MessageT));
+    auto msg = std::shared_ptr<MessageT>(
+        rb, reinterpret_cast<MessageT*>(rb->buf));
+    listener(msg, msg_info);
+  };
+}
+
+template <typename MessageT>
+MessageListener<ReadableBlock> ShmDispatcher::CreateListenerAdapter(
+    const RoleAttributes& self_attr, const MessageListener<MessageT>& listener,
+    std::false_type) {
+  auto arena_pool = message::ArenaPool::Get(self_attr.channel_id());
+  return [listener, arena_pool](const std::shared_ptr<ReadableBlock>& rb,
+                                const MessageInfo& msg_info) {
+    auto msg = message::ArenaPool::NewMessage<MessageT>(arena_pool);
     RETURN_IF(!message::ParseFromArray(
         rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
     listener(msg, msg_info);
   };
+}
+
+template <typename MessageT>
+void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
+                                const MessageListener<MessageT>& listener) {
+  auto listener_adapter = CreateListenerAdapter<MessageT>(
+      self_attr, listener,
+      std::integral_constant<bool, message::IsLoanable<MessageT>::value>());
 
   Dispatcher::AddListener<ReadableBlock>(self_attr, listener_adapter);
   AddSegment(self_attr);
@@ -98,14 +135,9 @@ template <typename MessageT>
 void ShmDispatcher::AddListener(const RoleAttributes& self_attr,
                                 const RoleAttributes& opposite_attr,
                                 const MessageListener<MessageT>& listener) {
-  // FIXME: make it more clean
-  auto listener_adapter = [listener](const std::shared_ptr<ReadableBlock>& rb,
-                                     const MessageInfo& msg_info) {
-    auto msg = std::make_shared<MessageT>();
-    RETURN_IF(!message::ParseFromArray(
-        rb->buf, static_cast<int>(rb->block->msg_size()), msg.get()));
-    listener(msg, msg_info);
-  };
+  auto listener_adapter = CreateListenerAdapter<MessageT>(
+      self_attr, listener,
+      std::integral_constant<bool, message::IsLoanable<MessageT>::value>());
 
   Dispatcher::AddListener<ReadableBlock>(self_attr, opposite_attr,
                                          listener_adapter);
@@ -32,6 +32,11 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+struct FlatMessage {
+  uint64_t seq;
+  uint8_t payload[128 * 1024];
+};
+
 TEST(ShmDispatcherTest, add_listener) {
   auto dispatcher = ShmDispatcher::Instance();
   RoleAttributes self_attr;
@@ -95,6 +100,55 @@ TEST(ShmDispatcherTest, on_message) {
   EXPECT_EQ(recv_msg->message, send_msg->message);
 }
 
+TEST(ShmDispatcherTest, on_loaned_message) {
+  auto dispatcher = ShmDispatcher::Instance();
+
+  RoleAttributes oppo_attr;
+  oppo_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  oppo_attr.set_host_ip(common::GlobalData::Instance()->HostIp());
+  oppo_attr.set_channel_name("on_loaned_message");
+  oppo_attr.set_channel_id(common::Hash("on_loaned_message"));
+  Identity oppo_id;
+  oppo_attr.set_id(oppo_id.HashValue());
+
+  auto transmitter = Transport::Instance()->CreateTransmitter<FlatMessage>(
+      oppo_attr, proto::OptionalMode::SHM);
+  EXPECT_NE(transmitter, nullptr);
+
+  RoleAttributes self_attr;
+  self_attr.set_channel_name("on_loaned_message");
+  self_attr.set_channel_id(common::Hash("on_loaned_message"));
+  Identity self_id;
+  self_attr.set_id(self_id.HashValue());
+
+  std::shared_ptr<FlatMessage> recv_msg = nullptr;
+  dispatcher->AddListener<FlatMessage>(
+      self_attr, [&recv_msg](const std::shared_ptr<FlatMessage>& msg,
+                             const MessageInfo& msg_info) {
+        (void)msg_info;
+        recv_msg = msg;
+      });
+
+  auto loan = transmitter->Loan();
+  ASSERT_NE(loan, nullptr);
+  loan->seq = 7;
+  loan->payload[sizeof(loan->payload) - 1] = 42;
+  EXPECT_TRUE(transmitter->Transmit(loan));
+  loan.reset();
+
+  sleep(1);
+  ASSERT_NE(recv_msg, nullptr);
+  EXPECT_EQ(recv_msg->seq, 7);
+  EXPECT_EQ(recv_msg->payload[sizeof(recv_msg->payload) - 1], 42);
+
+  // a message not obtained from Loan is copied flat into a block
+  auto send_msg = std::make_shared<FlatMessage>();
+  send_msg->seq = 8;
+  EXPECT_TRUE(transmitter->Transmit(send_msg));
+  sleep(1);
+  EXPECT_EQ(recv_msg->seq, 8);
+}
+
 TEST(ShmDispatcherTest, shutdown) {
   auto dispatcher = ShmDispatcher::Instance();
   dispatcher->Shutdown();
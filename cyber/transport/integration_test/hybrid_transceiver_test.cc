@@ -23,7 +23,9 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/util.h"
 #include "cyber/init.h"
+#include "cyber/proto/transport_stats.pb.h"
 #include "cyber/proto/unit_test.pb.h"
+#include "cyber/transport/common/transport_stats.h"
 #include "cyber/transport/qos/qos_profile_conf.h"
 #include "cyber/transport/receiver/hybrid_receiver.h"
 #include "cyber/transport/transmitter/hybrid_transmitter.h"
@@ -208,6 +210,59 @@ TEST_F(HybridTransceiverTest, enable_and_disable_with_param_same_process) {
   EXPECT_EQ(msgs.size(), 0);
 }
 
+TEST_F(HybridTransceiverTest, same_process_shares_message) {
+  RoleAttributes attr;
+  attr.set_host_name(common::GlobalData::Instance()->HostName());
+  attr.set_host_ip(common::GlobalData::Instance()->HostIp());
+  attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  attr.mutable_qos_profile()->CopyFrom(QosProfileConf::QOS_PROFILE_DEFAULT);
+  attr.set_channel_name(channel_name_);
+  attr.set_channel_id(common::Hash(channel_name_));
+
+  std::mutex mtx;
+  std::vector<std::shared_ptr<proto::UnitTest>> msgs;
+  ReceiverPtr receiver = std::make_shared<HybridReceiver<proto::UnitTest>>(
+      attr,
+      [&](const std::shared_ptr<proto::UnitTest>& msg,
+          const MessageInfo& msg_info, const RoleAttributes& attr) {
+        (void)msg_info;
+        (void)attr;
+        std::lock_guard<std::mutex> lock(mtx);
+        msgs.emplace_back(msg);
+      },
+      Transport::Instance()->participant());
+
+  auto serialized_messages = [this](const std::string& mode) {
+    proto::ChannelTransportStats stats;
+    TransportStats::Instance()->Get(channel_name_, "writer", mode)->Collect(
+        &stats);
+    return stats.messages();
+  };
+  auto shm_messages = serialized_messages("shm");
+  auto rtps_messages = serialized_messages("rtps");
+
+  transmitter_a_->Enable(receiver->attributes());
+  receiver->Enable(transmitter_a_->attributes());
+
+  auto msg = std::make_shared<proto::UnitTest>();
+  msg->set_class_name("HybridTransceiverTest");
+  msg->set_case_name("same_process_shares_message");
+  transmitter_a_->Transmit(msg);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    ASSERT_EQ(msgs.size(), 1);
+    EXPECT_EQ(msgs[0].get(), msg.get());
+  }
+  // nobody outside the process listens, so nothing is serialized
+  EXPECT_EQ(serialized_messages("shm"), shm_messages);
+  EXPECT_EQ(serialized_messages("rtps"), rtps_messages);
+
+  transmitter_a_->Disable(receiver->attributes());
+  receiver->Disable(transmitter_a_->attributes());
+}
+
 TEST_F(HybridTransceiverTest,
        enable_and_disable_with_param_same_host_diff_proc) {
   RoleAttributes attr;
@@ -24,7 +24,12 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
-const std::size_t MessageInfo::kSize = 2 * ID_SIZE + sizeof(uint64_t);
+const std::size_t MessageInfo::kSize = 2 * ID_SIZE + 2 * sizeof(uint64_t);
+
+namespace {
+// layout of senders that do not stamp send_time
+const std::size_t kSizeWithoutSendTime = 2 * ID_SIZE + sizeof(uint64_t);
+}  // namespace
 
 MessageInfo::MessageInfo() : sender_id_(false), spare_id_(false) {}
 
@@ -39,7 +44,8 @@ MessageInfo::MessageInfo(const MessageInfo& another)
     : sender_id_(another.sender_id_),
       channel_id_(another.channel_id_),
       seq_num_(another.seq_num_),
-      spare_id_(another.spare_id_) {}
+      spare_id_(another.spare_id_),
+      send_time_(another.send_time_) {}
 
 MessageInfo::~MessageInfo() {}
 
@@ -49,6 +55,7 @@ MessageInfo& MessageInfo::operator=(const MessageInfo& another) {
     channel_id_ = another.channel_id_;
     seq_num_ = another.seq_num_;
     spare_id_ = another.spare_id_;
+    send_time_ = another.send_time_;
   }
   return *this;
 }
@@ -69,6 +76,7 @@ bool MessageInfo::SerializeTo(std::string* dst) const {
   dst->assign(sender_id_.data(), ID_SIZE);
   dst->append(reinterpret_cast<const char*>(&seq_num_), sizeof(seq_num_));
   dst->append(spare_id_.data(), ID_SIZE);
+  dst->append(reinterpret_cast<const char*>(&send_time_), sizeof(send_time_));
 
   return true;
 }
@@ -84,6 +92,9 @@ bool MessageInfo::SerializeTo(char* dst, std::size_t len) const {
   std::memcpy(ptr, reinterpret_cast<const char*>(&seq_num_), sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   std::memcpy(ptr, spare_id_.data(), ID_SIZE);
+  ptr += ID_SIZE;
+  std::memcpy(ptr, reinterpret_cast<const char*>(&send_time_),
+              sizeof(send_time_));
 
   return true;
 }
@@ -94,7 +105,7 @@ bool MessageInfo::DeserializeFrom(const std::string& src) {
 
 bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   RETURN_VAL_IF_NULL(src, false);
-  if (len != kSize) {
+  if (len != kSize && len != kSizeWithoutSendTime) {
     AWARN << "src size mismatch, given[" << len << "] target[" << kSize << "]";
     return false;
   }
@@ -105,6 +116,12 @@ bool MessageInfo::DeserializeFrom(const char* src, std::size_t len) {
   std::memcpy(reinterpret_cast<char*>(&seq_num_), ptr, sizeof(seq_num_));
   ptr += sizeof(seq_num_);
   spare_id_.set_data(ptr);
+  send_time_ = 0;
+  if (len == kSize) {
+    ptr += ID_SIZE;
+    std::memcpy(reinterpret_cast<char*>(&send_time_), ptr,
+                sizeof(send_time_));
+  }
 
   return true;
 }
@@ -58,6 +58,11 @@ class MessageInfo {
   const Identity& spare_id() const { return spare_id_; }
   void set_spare_id(const Identity& spare_id) { spare_id_ = spare_id; }
 
+  // wall clock nanoseconds at which the writer transmitted the message, 0
+  // when the sender did not stamp it
+  uint64_t send_time() const { return send_time_; }
+  void set_send_time(uint64_t send_time) { send_time_ = send_time; }
+
   static const std::size_t kSize;
 
  private:
@@ -65,6 +70,7 @@ class MessageInfo {
   uint64_t channel_id_ = 0;
   uint64_t seq_num_ = 0;
   Identity spare_id_;
+  uint64_t send_time_ = 0;
 };
 
 }  // namespace transport
@@ -77,8 +77,10 @@ const QosProfile QosProfileConf::QOS_PROFILE_TF_STATIC = CreateQosProfile(
     QosReliabilityPolicy::RELIABILITY_RELIABLE,
     QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL);
 
+// late joiners get the last snapshot and the deltas after it from the
+// history instead of every change since the start
 const QosProfile QosProfileConf::QOS_PROFILE_TOPO_CHANGE = CreateQosProfile(
-    QosHistoryPolicy::HISTORY_KEEP_ALL, 10, QOS_MPS_SYSTEM_DEFAULT,
+    QosHistoryPolicy::HISTORY_KEEP_LAST, 10, QOS_MPS_SYSTEM_DEFAULT,
     QosReliabilityPolicy::RELIABILITY_RELIABLE,
     QosDurabilityPolicy::DURABILITY_TRANSIENT_LOCAL);
 
@@ -177,6 +177,8 @@ void HybridReceiver<M>::ObtainConfig() {
     return;
   }
   mode_->CopyFrom(global_conf.transport_conf().communication_mode());
+  // must match HybridTransmitter, which always shares within the process
+  mode_->set_same_proc(OptionalMode::INTRA);
 
   mapping_table_[SAME_PROC] = mode_->same_proc();
   mapping_table_[DIFF_PROC] = mode_->diff_proc();
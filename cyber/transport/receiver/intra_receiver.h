@@ -48,6 +48,8 @@ IntraReceiver<M>::IntraReceiver(
     const typename Receiver<M>::MessageListener& msg_listener)
     : Receiver<M>(attr, msg_listener) {
   dispatcher_ = IntraDispatcher::Instance();
+  this->stats_ =
+      TransportStats::Instance()->Get(attr.channel_name(), "receiver", "intra");
 }
 
 template <typename M>
@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "cyber/transport/common/endpoint.h"
+#include "cyber/transport/common/transport_stats.h"
 #include "cyber/transport/message/history.h"
 #include "cyber/transport/message/message_info.h"
 
@@ -47,6 +48,8 @@ class Receiver : public Endpoint {
   void OnNewMessage(const MessagePtr& msg, const MessageInfo& msg_info);
 
   MessageListener msg_listener_;
+  // set by the receivers that are attached to a transport
+  std::shared_ptr<ChannelStats> stats_;
 };
 
 template <typename M>
@@ -60,6 +63,9 @@ Receiver<M>::~Receiver() {}
 template <typename M>
 void Receiver<M>::OnNewMessage(const MessagePtr& msg,
                                const MessageInfo& msg_info) {
+  if (stats_ != nullptr) {
+    stats_->OnReceive(msg_info);
+  }
   if (msg_listener_ != nullptr) {
     msg_listener_(msg, msg_info, attr_);
   }
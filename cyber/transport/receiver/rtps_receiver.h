@@ -48,6 +48,8 @@ RtpsReceiver<M>::RtpsReceiver(
     const typename Receiver<M>::MessageListener& msg_listener)
     : Receiver<M>(attr, msg_listener) {
   dispatcher_ = RtpsDispatcher::Instance();
+  this->stats_ =
+      TransportStats::Instance()->Get(attr.channel_name(), "receiver", "rtps");
 }
 
 template <typename M>
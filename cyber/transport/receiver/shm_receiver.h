@@ -50,6 +50,8 @@ ShmReceiver<M>::ShmReceiver(
     const typename Receiver<M>::MessageListener& msg_listener)
     : Receiver<M>(attr, msg_listener) {
   dispatcher_ = ShmDispatcher::Instance();
+  this->stats_ =
+      TransportStats::Instance()->Get(attr.channel_name(), "receiver", "shm");
 }
 
 template <typename M>
@@ -20,6 +20,7 @@
 
 #include "cyber/common/log.h"
 #include "cyber/transport/qos/qos_profile_conf.h"
+#include "cyber/transport/rtps/batcher.h"
 
 namespace apollo {
 namespace cyber {
@@ -113,6 +114,14 @@ bool AttributesFiller::FillInPubAttr(
       eprosima::fastrtps::DYNAMIC_RESERVE_MEMORY_MODE;
   pub_attr->topic.resourceLimitsQos.max_samples = 10000;
 
+  // pace large messages instead of bursting all their fragments at once
+  auto flow_conf = RtpsFlowConf::Load(channel_name);
+  if (flow_conf.flow_bytes_per_period > 0) {
+    pub_attr->throughputController.bytesPerPeriod =
+        flow_conf.flow_bytes_per_period;
+    pub_attr->throughputController.periodMillisecs = flow_conf.flow_period_ms;
+  }
+
   return true;
 }
 
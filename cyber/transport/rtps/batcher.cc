@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rtps/batcher.h"
+
+#include <cstring>
+#include <sstream>
+
+#include "cyber/common/environment.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+uint64_t EnvNumber(const std::string& name, uint64_t default_value) {
+  auto value = common::GetEnv(name);
+  if (value.empty()) {
+    return default_value;
+  }
+  try {
+    return std::stoull(value);
+  } catch (const std::exception& e) {
+    AERROR << "invalid " << name << ": " << value;
+    return default_value;
+  }
+}
+
+bool BatchChannel(const std::string& channel_name) {
+  std::stringstream channels(common::GetEnv("CYBER_RTPS_BATCH_CHANNELS"));
+  std::string channel;
+  while (std::getline(channels, channel, ',')) {
+    if (channel == "*" || channel == channel_name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// each entry is the seq_num, the data size and the data
+const size_t kEntryHeadSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+}  // namespace
+
+RtpsFlowConf RtpsFlowConf::Load(const std::string& channel_name) {
+  RtpsFlowConf conf;
+  if (BatchChannel(channel_name)) {
+    conf.batch_window_us = EnvNumber("CYBER_RTPS_BATCH_US", 1000);
+  }
+  conf.max_batch_bytes = static_cast<uint32_t>(
+      EnvNumber("CYBER_RTPS_BATCH_BYTES", conf.max_batch_bytes));
+  conf.fragment_size =
+      static_cast<uint32_t>(EnvNumber("CYBER_RTPS_FRAGMENT_SIZE", 0));
+  conf.flow_bytes_per_period =
+      static_cast<uint32_t>(EnvNumber("CYBER_RTPS_FLOW_BYTES", 0));
+  conf.flow_period_ms = static_cast<uint32_t>(
+      EnvNumber("CYBER_RTPS_FLOW_PERIOD_MS", conf.flow_period_ms));
+  return conf;
+}
+
+const char Batcher::kDataType[] = "cyber.batch";
+
+Batcher::Batcher(const RtpsFlowConf& conf, const FlushFunc& flush)
+    : window_us_(conf.batch_window_us),
+      max_bytes_(conf.max_batch_bytes),
+      flush_(flush) {
+  pending_.reserve(max_bytes_);
+  thread_ = std::thread(&Batcher::ThreadFunc, this);
+}
+
+Batcher::~Batcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void Batcher::Add(const std::string& data, const MessageInfo& msg_info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_.empty()) {
+    deadline_ = std::chrono::steady_clock::now() +
+                std::chrono::microseconds(window_us_);
+    cv_.notify_one();
+  }
+
+  char head[kEntryHeadSize];
+  uint64_t seq_num = msg_info.seq_num();
+  uint32_t size = static_cast<uint32_t>(data.size());
+  std::memcpy(head, &seq_num, sizeof(seq_num));
+  std::memcpy(head + sizeof(seq_num), &size, sizeof(size));
+  pending_.append(head, kEntryHeadSize);
+  pending_.append(data);
+  pending_info_ = msg_info;
+
+  if (pending_.size() >= max_bytes_) {
+    Flush();
+  }
+}
+
+bool Batcher::Split(const std::string& batch, Entries* entries) {
+  RETURN_VAL_IF_NULL(entries, false);
+  size_t offset = 0;
+  while (offset < batch.size()) {
+    if (batch.size() - offset < kEntryHeadSize) {
+      return false;
+    }
+    uint64_t seq_num = 0;
+    uint32_t size = 0;
+    std::memcpy(&seq_num, batch.data() + offset, sizeof(seq_num));
+    std::memcpy(&size, batch.data() + offset + sizeof(seq_num), sizeof(size));
+    offset += kEntryHeadSize;
+    if (batch.size() - offset < size) {
+      return false;
+    }
+    entries->emplace_back(seq_num, batch.substr(offset, size));
+    offset += size;
+  }
+  return true;
+}
+
+void Batcher::Flush() {
+  if (pending_.empty()) {
+    return;
+  }
+  flush_(pending_, pending_info_);
+  pending_.clear();
+}
+
+void Batcher::ThreadFunc() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    if (pending_.empty()) {
+      cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+      continue;
+    }
+    cv_.wait_until(lock, deadline_);
+    if (std::chrono::steady_clock::now() >= deadline_) {
+      Flush();
+    }
+  }
+  Flush();
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_RTPS_BATCHER_H_
+#define CYBER_TRANSPORT_RTPS_BATCHER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cyber/transport/message/message_info.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Inter-host publishing knobs of one channel, read from the environment:
+//   CYBER_RTPS_BATCH_CHANNELS   comma separated channels to batch, * for all
+//   CYBER_RTPS_BATCH_US         time budget of a batch, 0 disables batching
+//   CYBER_RTPS_BATCH_BYTES      a batch is sent once it reaches this size
+//   CYBER_RTPS_FRAGMENT_SIZE    udp message size rtps fragments into
+//   CYBER_RTPS_FLOW_BYTES       bytes a publisher may send per flow period
+//   CYBER_RTPS_FLOW_PERIOD_MS   flow control period
+struct RtpsFlowConf {
+  uint64_t batch_window_us = 0;
+  uint32_t max_batch_bytes = 60000;
+  uint32_t fragment_size = 0;
+  uint32_t flow_bytes_per_period = 0;
+  uint32_t flow_period_ms = 100;
+
+  static RtpsFlowConf Load(const std::string& channel_name);
+};
+
+// Coalesces the serialized messages handed to Add() into one underlay
+// message, sent through the flush function when it holds max_batch_bytes
+// or when the oldest message has waited batch_window_us.
+class Batcher {
+ public:
+  using FlushFunc =
+      std::function<void(const std::string& batch, const MessageInfo& info)>;
+  using Entries = std::vector<std::pair<uint64_t, std::string>>;
+
+  // marks an underlay message whose data was produced by a Batcher
+  static const char kDataType[];
+
+  Batcher(const RtpsFlowConf& conf, const FlushFunc& flush);
+  virtual ~Batcher();
+
+  void Add(const std::string& data, const MessageInfo& msg_info);
+
+  // Splits a batch back into (seq_num, serialized message) entries.
+  static bool Split(const std::string& batch, Entries* entries);
+
+ private:
+  void Flush();
+  void ThreadFunc();
+
+  uint64_t window_us_;
+  uint32_t max_bytes_;
+  FlushFunc flush_;
+
+  std::string pending_;
+  MessageInfo pending_info_;
+  std::chrono::steady_clock::time_point deadline_;
+  bool stop_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_RTPS_BATCHER_H_
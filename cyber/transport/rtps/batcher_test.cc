@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/rtps/batcher.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+TEST(BatcherTest, flow_conf) {
+  unsetenv("CYBER_RTPS_BATCH_CHANNELS");
+  EXPECT_EQ(0, RtpsFlowConf::Load("/a").batch_window_us);
+
+  setenv("CYBER_RTPS_BATCH_CHANNELS", "/a,/b", 1);
+  setenv("CYBER_RTPS_BATCH_US", "500", 1);
+  setenv("CYBER_RTPS_FLOW_BYTES", "65536", 1);
+  auto conf = RtpsFlowConf::Load("/b");
+  EXPECT_EQ(500, conf.batch_window_us);
+  EXPECT_EQ(65536, conf.flow_bytes_per_period);
+  EXPECT_EQ(0, RtpsFlowConf::Load("/c").batch_window_us);
+
+  setenv("CYBER_RTPS_BATCH_CHANNELS", "*", 1);
+  EXPECT_EQ(500, RtpsFlowConf::Load("/c").batch_window_us);
+  unsetenv("CYBER_RTPS_BATCH_CHANNELS");
+  unsetenv("CYBER_RTPS_BATCH_US");
+  unsetenv("CYBER_RTPS_FLOW_BYTES");
+}
+
+TEST(BatcherTest, flush_on_size_and_time) {
+  RtpsFlowConf conf;
+  conf.batch_window_us = 20000;
+  conf.max_batch_bytes = 64;
+  std::vector<std::string> batches;
+  std::vector<uint64_t> last_seqs;
+  {
+    Batcher batcher(conf, [&](const std::string& batch,
+                              const MessageInfo& info) {
+      batches.push_back(batch);
+      last_seqs.push_back(info.seq_num());
+    });
+    MessageInfo info;
+    for (uint64_t seq = 1; seq <= 3; ++seq) {
+      info.set_seq_num(seq);
+      batcher.Add(std::string(20, 'a' + static_cast<char>(seq)), info);
+    }
+    // three entries of 32 bytes passed the size limit after the second
+    ASSERT_EQ(1, batches.size());
+    EXPECT_EQ(2, last_seqs[0]);
+
+    usleep(100000);
+    ASSERT_EQ(2, batches.size());
+    EXPECT_EQ(3, last_seqs[1]);
+
+    info.set_seq_num(4);
+    batcher.Add("tail", info);
+  }
+  // destruction flushes what is left
+  ASSERT_EQ(3, batches.size());
+
+  Batcher::Entries entries;
+  EXPECT_TRUE(Batcher::Split(batches[0], &entries));
+  ASSERT_EQ(2, entries.size());
+  EXPECT_EQ(1, entries[0].first);
+  EXPECT_EQ(std::string(20, 'b'), entries[0].second);
+  EXPECT_EQ(2, entries[1].first);
+  EXPECT_EQ(std::string(20, 'c'), entries[1].second);
+
+  entries.clear();
+  EXPECT_TRUE(Batcher::Split(batches[2], &entries));
+  ASSERT_EQ(1, entries.size());
+  EXPECT_EQ("tail", entries[0].second);
+
+  entries.clear();
+  EXPECT_FALSE(Batcher::Split(batches[0].substr(0, 40), &entries));
+  EXPECT_EQ(1, entries.size());
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
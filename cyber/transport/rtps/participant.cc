@@ -19,6 +19,8 @@
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/proto/transport_conf.pb.h"
+#include "cyber/transport/rtps/batcher.h"
+#include "fastrtps/transport/UDPv4TransportDescriptor.h"
 
 namespace apollo {
 namespace cyber {
@@ -133,6 +135,16 @@ void Participant::CreateFastRtpsParticipant(
   locator.set_IP4_address(239, 255, 0, 1);
   attr.rtps.builtin.metatrafficMulticastLocatorList.push_back(locator);
 
+  // messages above the udp message size are fragmented by rtps
+  auto flow_conf = RtpsFlowConf::Load(name);
+  if (flow_conf.fragment_size > 0) {
+    auto udp_transport = std::make_shared<
+        eprosima::fastrtps::rtps::UDPv4TransportDescriptor>();
+    udp_transport->maxMessageSize = flow_conf.fragment_size;
+    attr.rtps.userTransports.push_back(udp_transport);
+    attr.rtps.useBuiltinTransports = false;
+  }
+
   fastrtps_participant_ =
       eprosima::fastrtps::Domain::createParticipant(attr, listener);
   RETURN_IF_NULL(fastrtps_participant_);
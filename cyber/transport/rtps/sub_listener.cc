@@ -16,8 +16,12 @@
 
 #include "cyber/transport/rtps/sub_listener.h"
 
+#include <utility>
+
 #include "cyber/common/log.h"
 #include "cyber/common/util.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/rtps/batcher.h"
 
 namespace apollo {
 namespace cyber {
@@ -57,6 +61,30 @@ void SubListener::onNewDataMessage(eprosima::fastrtps::Subscriber* sub) {
       m_info.related_sample_identity.sequence_number().low;
   msg_info_.set_seq_num(seq_num);
 
+  uint32_t send_us = static_cast<uint32_t>(m.timestamp());
+  if (send_us != 0) {
+    uint64_t now_us = Time::Now().ToMicrosecond();
+    uint32_t elapsed_us = static_cast<uint32_t>(now_us) - send_us;
+    msg_info_.set_send_time((now_us - elapsed_us) * 1000);
+  } else {
+    msg_info_.set_send_time(0);
+  }
+
+  if (m.datatype() == Batcher::kDataType) {
+    Batcher::Entries entries;
+    if (!Batcher::Split(m.data(), &entries)) {
+      AERROR << "drop the malformed tail of a batch on channel "
+             << sub->getAttributes().topic.getTopicName();
+    }
+    for (auto& entry : entries) {
+      msg_info_.set_seq_num(entry.first);
+      callback_(channel_id,
+                std::make_shared<std::string>(std::move(entry.second)),
+                msg_info_);
+    }
+    return;
+  }
+
   // fetch message string
   std::shared_ptr<std::string> msg_str =
       std::make_shared<std::string>(m.data());
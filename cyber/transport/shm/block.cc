@@ -72,6 +72,8 @@ void Block::ReleaseWriteLock() { lock_num_.fetch_add(1); }
 
 void Block::ReleaseReadLock() { lock_num_.fetch_sub(1); }
 
+void Block::DowngradeWriteLock() { lock_num_.fetch_add(1 - kWriteExclusive); }
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -48,6 +48,9 @@ class Block {
   bool TryLockForRead();
   void ReleaseWriteLock();
   void ReleaseReadLock();
+  // Turns the exclusive write lock into a single read lock without letting
+  // another writer in between.
+  void DowngradeWriteLock();
 
   std::atomic<int32_t> lock_num_ = {0};
 
@@ -0,0 +1,309 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/futex_notifier.h"
+
+#include <linux/futex.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+#include "cyber/base/macros.h"
+#include "cyber/common/environment.h"
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::Hash;
+
+namespace {
+
+int FutexWait(std::atomic<uint32_t>* addr, uint32_t expected,
+              const struct timespec* timeout) {
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr),
+                                  FUTEX_WAIT, expected, timeout, nullptr, 0));
+}
+
+int FutexWake(std::atomic<uint32_t>* addr) {
+  return static_cast<int>(syscall(SYS_futex, reinterpret_cast<uint32_t*>(addr),
+                                  FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0));
+}
+
+}  // namespace
+
+FutexNotifier::FutexNotifier() {
+  key_ = static_cast<key_t>(Hash("/apollo/cyber/transport/shm/futex_notifier"));
+  ADEBUG << "futex notifier key: " << key_;
+  shm_size_ = sizeof(Indicator);
+
+  if (!Init()) {
+    AERROR << "fail to init futex notifier.";
+    is_shutdown_.store(true);
+    return;
+  }
+  next_seq_ = indicator_->next_seq.load();
+  ADEBUG << "next_seq: " << next_seq_;
+  InitBusyPoll();
+}
+
+FutexNotifier::~FutexNotifier() { Shutdown(); }
+
+void FutexNotifier::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  // waiters block at most for their timeout, give them time to leave
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Reset();
+}
+
+bool FutexNotifier::Notify(const ReadableInfo& info) {
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  uint64_t seq = indicator_->next_seq.fetch_add(1);
+  uint64_t idx = seq % kBufLength;
+  indicator_->infos[idx] = info;
+  indicator_->seqs[idx].store(seq, std::memory_order_release);
+
+  indicator_->futex.fetch_add(1);
+  if (indicator_->waiters.load() > 0) {
+    FutexWake(&indicator_->futex);
+  }
+  return true;
+}
+
+bool FutexNotifier::Listen(int timeout_ms, ReadableInfo* info) {
+  if (info == nullptr) {
+    AERROR << "info nullptr.";
+    return false;
+  }
+
+  if (is_shutdown_.load()) {
+    ADEBUG << "notifier is shutdown.";
+    return false;
+  }
+
+  if (busy_poll_armed_ && BusyPoll(info)) {
+    return true;
+  }
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(timeout_ms);
+  while (!is_shutdown_.load()) {
+    // read the futex word before checking the ring, a Notify in between
+    // changes it and makes the wait below return at once.
+    uint32_t futex = indicator_->futex.load();
+    if (TryRead(info)) {
+      return true;
+    }
+
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (remaining <= std::chrono::nanoseconds(0)) {
+      return false;
+    }
+    auto remaining_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(remaining)
+            .count();
+    struct timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(remaining_ns / 1000000000);
+    timeout.tv_nsec = static_cast<long>(remaining_ns % 1000000000);  // NOLINT
+
+    indicator_->waiters.fetch_add(1);
+    FutexWait(&indicator_->futex, futex, &timeout);
+    indicator_->waiters.fetch_sub(1);
+  }
+  return false;
+}
+
+bool FutexNotifier::TryRead(ReadableInfo* info) {
+  uint64_t seq = indicator_->next_seq.load();
+  if (seq == next_seq_) {
+    return false;
+  }
+
+  auto idx = next_seq_ % kBufLength;
+  auto actual_seq = indicator_->seqs[idx].load(std::memory_order_acquire);
+  if (actual_seq < next_seq_) {
+    ADEBUG << "seq[" << next_seq_ << "] is writing, can not read now.";
+    return false;
+  }
+
+  next_seq_ = actual_seq;
+  *info = indicator_->infos[idx];
+  ++next_seq_;
+  busy_poll_armed_ =
+      busy_poll_us_ > 0 &&
+      (busy_poll_channels_.empty() ||
+       busy_poll_channels_.count(info->channel_id()) > 0);
+  return true;
+}
+
+bool FutexNotifier::BusyPoll(ReadableInfo* info) {
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::microseconds(busy_poll_us_);
+  while (!is_shutdown_.load()) {
+    if (TryRead(info)) {
+      return true;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+    cpu_relax();
+  }
+  busy_poll_armed_ = false;
+  return false;
+}
+
+void FutexNotifier::InitBusyPoll() {
+  std::string busy_poll_us = common::GetEnv("CYBER_SHM_BUSY_POLL_US", "0");
+  busy_poll_us_ = std::strtoull(busy_poll_us.c_str(), nullptr, 10);
+  if (busy_poll_us_ == 0) {
+    return;
+  }
+
+  std::string channels = common::GetEnv("CYBER_SHM_BUSY_POLL_CHANNELS");
+  std::string::size_type begin = 0;
+  while (begin < channels.size()) {
+    auto end = channels.find(',', begin);
+    if (end == std::string::npos) {
+      end = channels.size();
+    }
+    if (end > begin) {
+      busy_poll_channels_.insert(Hash(channels.substr(begin, end - begin)));
+    }
+    begin = end + 1;
+  }
+  AINFO << "shm busy poll window: " << busy_poll_us_
+        << "us, channels: " << (channels.empty() ? "all" : channels);
+}
+
+bool FutexNotifier::Init() { return OpenOrCreate(); }
+
+bool FutexNotifier::OpenOrCreate() {
+  // create managed_shm_
+  int retry = 0;
+  int shmid = 0;
+  while (retry < 2) {
+    shmid = shmget(key_, shm_size_, 0644 | IPC_CREAT | IPC_EXCL);
+    if (shmid != -1) {
+      break;
+    }
+
+    if (EINVAL == errno) {
+      AINFO << "need larger space, recreate.";
+      Reset();
+      Remove();
+      ++retry;
+    } else if (EEXIST == errno) {
+      ADEBUG << "shm already exist, open only.";
+      return OpenOnly();
+    } else {
+      break;
+    }
+  }
+
+  if (shmid == -1) {
+    AERROR << "create shm failed, error code: " << strerror(errno);
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed.";
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  // create indicator_
+  indicator_ = new (managed_shm_) Indicator();
+  if (indicator_ == nullptr) {
+    AERROR << "create indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    shmctl(shmid, IPC_RMID, 0);
+    return false;
+  }
+
+  ADEBUG << "open or create true.";
+  return true;
+}
+
+bool FutexNotifier::OpenOnly() {
+  // get managed_shm_
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1) {
+    AERROR << "get shm failed, error: " << strerror(errno);
+    return false;
+  }
+
+  // attach managed_shm_
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed, error: " << strerror(errno);
+    return false;
+  }
+
+  // get indicator_
+  indicator_ = reinterpret_cast<Indicator*>(managed_shm_);
+  if (indicator_ == nullptr) {
+    AERROR << "get indicator failed.";
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+    return false;
+  }
+
+  ADEBUG << "open true.";
+  return true;
+}
+
+bool FutexNotifier::Remove() {
+  int shmid = shmget(key_, 0, 0644);
+  if (shmid == -1 || shmctl(shmid, IPC_RMID, 0) == -1) {
+    AERROR << "remove shm failed, error code: " << strerror(errno);
+    return false;
+  }
+  ADEBUG << "remove success.";
+
+  return true;
+}
+
+void FutexNotifier::Reset() {
+  indicator_ = nullptr;
+  if (managed_shm_ != nullptr) {
+    shmdt(managed_shm_);
+    managed_shm_ = nullptr;
+  }
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
+#define CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
+
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+#include <unordered_set>
+
+#include "cyber/common/macros.h"
+#include "cyber/transport/shm/notifier_base.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+// Shares the ring layout of ConditionNotifier, but listeners block on a
+// futex word bumped by every Notify instead of sleeping and polling, so they
+// wake as soon as a block is readable. An optional busy-poll window, armed by
+// messages of latency-critical channels, spins before going to sleep.
+//
+// Busy polling is configured through the environment:
+//   CYBER_SHM_BUSY_POLL_US        spin window in microseconds, 0 disables it
+//   CYBER_SHM_BUSY_POLL_CHANNELS  comma separated channel names that arm the
+//                                 window, all channels when empty
+class FutexNotifier : public NotifierBase {
+  static const uint32_t kBufLength = 4096;
+
+  struct Indicator {
+    std::atomic<uint64_t> next_seq = {0};
+    std::atomic<uint32_t> futex = {0};
+    std::atomic<uint32_t> waiters = {0};
+    ReadableInfo infos[kBufLength];
+    std::atomic<uint64_t> seqs[kBufLength] = {};
+  };
+
+ public:
+  virtual ~FutexNotifier();
+
+  void Shutdown() override;
+  bool Notify(const ReadableInfo& info) override;
+  bool Listen(int timeout_ms, ReadableInfo* info) override;
+
+  static const char* Type() { return "futex"; }
+
+ private:
+  bool Init();
+  bool OpenOrCreate();
+  bool OpenOnly();
+  bool Remove();
+  void Reset();
+  void InitBusyPoll();
+  bool TryRead(ReadableInfo* info);
+  bool BusyPoll(ReadableInfo* info);
+
+  key_t key_ = 0;
+  void* managed_shm_ = nullptr;
+  size_t shm_size_ = 0;
+  Indicator* indicator_ = nullptr;
+  uint64_t next_seq_ = 0;
+  std::atomic<bool> is_shutdown_ = {false};
+
+  uint64_t busy_poll_us_ = 0;
+  bool busy_poll_armed_ = false;
+  std::unordered_set<uint64_t> busy_poll_channels_;
+
+  DECLARE_SINGLETON(FutexNotifier)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_SHM_FUTEX_NOTIFIER_H_
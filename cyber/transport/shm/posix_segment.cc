@@ -21,6 +21,7 @@
 #include <sys/stat.h>
 
 #include "cyber/common/log.h"
+#include "cyber/common/numa.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/block.h"
 #include "cyber/transport/shm/segment.h"
@@ -71,6 +72,10 @@ bool PosixSegment::OpenOrCreate() {
 
   close(fd);
 
+  // keep the blocks next to the writer when it runs on a numa node
+  common::BindToNumaNode(managed_shm_, conf_.managed_shm_size(),
+                         common::ThreadNumaNode());
+
   // create field state_
   state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
   if (state_ == nullptr) {
@@ -237,6 +242,10 @@ void PosixSegment::Reset() {
   }
 }
 
+SegmentPtr PosixSegment::NewArena(uint64_t arena_id) {
+  return std::make_shared<PosixSegment>(arena_id);
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
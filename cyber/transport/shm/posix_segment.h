@@ -37,6 +37,7 @@ class PosixSegment : public Segment {
   bool Remove() override;
   bool OpenOnly() override;
   bool OpenOrCreate() override;
+  SegmentPtr NewArena(uint64_t arena_id) override;
 
   std::string shm_name_;
 };
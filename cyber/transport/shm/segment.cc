@@ -24,6 +24,10 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+const uint32_t Segment::kArenaShift = 24;
+const uint32_t Segment::kBlockIndexMask = (1u << Segment::kArenaShift) - 1;
+const uint32_t Segment::kMaxArenaNum = 8;
+
 Segment::Segment(uint64_t channel_id)
     : init_(false),
       conf_(),
@@ -42,21 +46,16 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
     return false;
   }
 
-  bool result = true;
-  if (state_->need_remap()) {
-    result = Remap();
-  }
-
   if (msg_size > conf_.ceiling_msg_size()) {
-    AINFO << "msg_size: " << msg_size
-          << " larger than current shm_buffer_size: "
-          << conf_.ceiling_msg_size() << " , need recreate.";
-    result = Recreate(msg_size);
-  }
-
-  if (!result) {
-    AERROR << "segment update failed.";
-    return false;
+    uint32_t arena_index = 0;
+    auto arena = GetArenaToWrite(msg_size, &arena_index);
+    if (arena == nullptr || !arena->AcquireBlockToWrite(msg_size,
+                                                        writable_block)) {
+      AERROR << "no arena can hold msg_size: " << msg_size;
+      return false;
+    }
+    writable_block->index |= arena_index << kArenaShift;
+    return true;
   }
 
   uint32_t index = GetNextWritableBlockIndex();
@@ -67,6 +66,17 @@ bool Segment::AcquireBlockToWrite(std::size_t msg_size,
 }
 
 void Segment::ReleaseWrittenBlock(const WritableBlock& writable_block) {
+  auto arena = GetArena(writable_block.index);
+  if (arena == nullptr) {
+    return;
+  }
+  if (arena != this) {
+    WritableBlock arena_block = writable_block;
+    arena_block.index &= kBlockIndexMask;
+    arena->ReleaseWrittenBlock(arena_block);
+    return;
+  }
+
   auto index = writable_block.index;
   if (index >= conf_.block_num()) {
     return;
@@ -74,6 +84,25 @@ void Segment::ReleaseWrittenBlock(const WritableBlock& writable_block) {
   blocks_[index].ReleaseWriteLock();
 }
 
+void Segment::ReleaseWrittenBlockForRead(const WritableBlock& writable_block) {
+  auto arena = GetArena(writable_block.index);
+  if (arena == nullptr) {
+    return;
+  }
+  if (arena != this) {
+    WritableBlock arena_block = writable_block;
+    arena_block.index &= kBlockIndexMask;
+    arena->ReleaseWrittenBlockForRead(arena_block);
+    return;
+  }
+
+  auto index = writable_block.index;
+  if (index >= conf_.block_num()) {
+    return;
+  }
+  blocks_[index].DowngradeWriteLock();
+}
+
 bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
   RETURN_VAL_IF_NULL(readable_block, false);
   if (!init_ && !OpenOnly()) {
@@ -81,19 +110,26 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
     return false;
   }
 
-  auto index = readable_block->index;
-  if (index >= conf_.block_num()) {
-    AERROR << "invalid block_index[" << index << "].";
+  auto arena = GetArena(readable_block->index);
+  if (arena == nullptr) {
+    AERROR << "failed to open arena of block_index[" << readable_block->index
+           << "].";
     return false;
   }
-
-  bool result = true;
-  if (state_->need_remap()) {
-    result = Remap();
+  if (arena != this) {
+    ReadableBlock arena_block = *readable_block;
+    arena_block.index &= kBlockIndexMask;
+    if (!arena->AcquireBlockToRead(&arena_block)) {
+      return false;
+    }
+    readable_block->block = arena_block.block;
+    readable_block->buf = arena_block.buf;
+    return true;
   }
 
-  if (!result) {
-    AERROR << "segment update failed.";
+  auto index = readable_block->index;
+  if (index >= conf_.block_num()) {
+    AERROR << "invalid block_index[" << index << "].";
     return false;
   }
 
@@ -106,6 +142,17 @@ bool Segment::AcquireBlockToRead(ReadableBlock* readable_block) {
 }
 
 void Segment::ReleaseReadBlock(const ReadableBlock& readable_block) {
+  auto arena = GetArena(readable_block.index);
+  if (arena == nullptr) {
+    return;
+  }
+  if (arena != this) {
+    ReadableBlock arena_block = readable_block;
+    arena_block.index &= kBlockIndexMask;
+    arena->ReleaseReadBlock(arena_block);
+    return;
+  }
+
   auto index = readable_block.index;
   if (index >= conf_.block_num()) {
     return;
@@ -119,6 +166,11 @@ bool Segment::Destroy() {
   }
   init_ = false;
 
+  {
+    std::lock_guard<std::mutex> lg(arenas_lock_);
+    arenas_.clear();
+  }
+
   try {
     state_->DecreaseReferenceCounts();
     uint32_t reference_counts = state_->reference_counts();
@@ -133,21 +185,75 @@ bool Segment::Destroy() {
   return true;
 }
 
-bool Segment::Remap() {
-  init_ = false;
-  ADEBUG << "before reset.";
-  Reset();
-  ADEBUG << "after reset.";
-  return OpenOnly();
+uint64_t Segment::ArenaId(uint32_t arena_index) const {
+  return common::Hash(std::to_string(channel_id_) + "/arena/" +
+                      std::to_string(arena_index));
 }
 
-bool Segment::Recreate(const uint64_t& msg_size) {
-  init_ = false;
-  state_->set_need_remap(true);
-  Reset();
-  Remove();
-  conf_.Update(msg_size);
-  return OpenOrCreate();
+bool Segment::SyncArenas() {
+  // arenas_lock_ is held by the caller
+  uint32_t arena_num = state_->arena_num();
+  while (arenas_.size() < arena_num) {
+    auto arena_index = static_cast<uint32_t>(arenas_.size()) + 1;
+    auto arena = NewArena(ArenaId(arena_index));
+    if (!arena->OpenOnly()) {
+      ADEBUG << "arena " << arena_index << " is not ready yet.";
+      return false;
+    }
+    arenas_.emplace_back(arena);
+  }
+  return true;
+}
+
+Segment* Segment::GetArena(uint32_t block_index) {
+  uint32_t arena_index = block_index >> kArenaShift;
+  if (arena_index == 0) {
+    return this;
+  }
+
+  std::lock_guard<std::mutex> lg(arenas_lock_);
+  if (arena_index > arenas_.size()) {
+    SyncArenas();
+  }
+  if (arena_index > arenas_.size()) {
+    return nullptr;
+  }
+  return arenas_[arena_index - 1].get();
+}
+
+Segment* Segment::GetArenaToWrite(std::size_t msg_size,
+                                  uint32_t* arena_index) {
+  std::lock_guard<std::mutex> lg(arenas_lock_);
+  SyncArenas();
+  for (std::size_t i = 0; i < arenas_.size(); ++i) {
+    if (msg_size <= arenas_[i]->conf_.ceiling_msg_size()) {
+      *arena_index = static_cast<uint32_t>(i) + 1;
+      return arenas_[i].get();
+    }
+  }
+
+  // none is large enough, grow by one arena of the message's size class
+  auto arena_num = static_cast<uint32_t>(arenas_.size());
+  if (arena_num >= kMaxArenaNum) {
+    AERROR << "arena number reaches the limit: " << kMaxArenaNum;
+    return nullptr;
+  }
+  if (!state_->ClaimArena(arena_num)) {
+    ADEBUG << "arena " << arena_num + 1 << " is being added by other writer.";
+    return nullptr;
+  }
+
+  auto arena = NewArena(ArenaId(arena_num + 1));
+  arena->conf_.Update(msg_size);
+  if (!arena->OpenOrCreate() || msg_size > arena->conf_.ceiling_msg_size()) {
+    AERROR << "create arena " << arena_num + 1 << " failed.";
+    return nullptr;
+  }
+  AINFO << "channel[" << channel_id_ << "] add arena " << arena_num + 1
+        << " of ceiling_msg_size: " << arena->conf_.ceiling_msg_size();
+  arenas_.emplace_back(arena);
+  *arena_index = arena_num + 1;
+  return arena.get();
 }
 
 uint32_t Segment::GetNextWritableBlockIndex() {
@@ -21,6 +21,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "cyber/transport/shm/block.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -40,6 +41,11 @@ struct WritableBlock {
 };
 using ReadableBlock = WritableBlock;
 
+// A segment starts with one set of blocks sized by ShmConf. Messages that
+// outgrow it go to arenas, child segments of a larger size class that are
+// added on demand and kept mapped for the lifetime of the segment, so blocks
+// in flight stay valid while the channel grows. The arena of a block is
+// carried in the high bits of its index.
 class Segment {
  public:
   explicit Segment(uint64_t channel_id);
@@ -47,16 +53,25 @@ class Segment {
 
   bool AcquireBlockToWrite(std::size_t msg_size, WritableBlock* writable_block);
   void ReleaseWrittenBlock(const WritableBlock& writable_block);
+  // Publishes a written block while keeping it read-locked by the writer, so
+  // the buffer stays valid for zero-copy holders until ReleaseReadBlock.
+  void ReleaseWrittenBlockForRead(const WritableBlock& writable_block);
 
   bool AcquireBlockToRead(ReadableBlock* readable_block);
   void ReleaseReadBlock(const ReadableBlock& readable_block);
 
+  static const uint32_t kArenaShift;
+  static const uint32_t kBlockIndexMask;
+  static const uint32_t kMaxArenaNum;
+
  protected:
   virtual bool Destroy();
   virtual void Reset() = 0;
   virtual bool Remove() = 0;
   virtual bool OpenOnly() = 0;
   virtual bool OpenOrCreate() = 0;
+  // Creates an unopened segment of the same kind for an arena.
+  virtual SegmentPtr NewArena(uint64_t arena_id) = 0;
 
   bool init_;
   ShmConf conf_;
@@ -69,9 +84,14 @@ class Segment {
   std::unordered_map<uint32_t, uint8_t*> block_buf_addrs_;
 
  private:
-  bool Remap();
-  bool Recreate(const uint64_t& msg_size);
+  uint64_t ArenaId(uint32_t arena_index) const;
+  bool SyncArenas();
+  Segment* GetArena(uint32_t block_index);
+  Segment* GetArenaToWrite(std::size_t msg_size, uint32_t* arena_index);
   uint32_t GetNextWritableBlockIndex();
+
+  std::mutex arenas_lock_;
+  std::vector<SegmentPtr> arenas_;
 };
 
 }  // namespace transport
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/shm/segment.h"
+
+#include <cstring>
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/util.h"
+#include "cyber/transport/shm/posix_segment.h"
+#include "cyber/transport/shm/xsi_segment.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+template <typename SegmentT>
+void GrowWithArenas(const std::string& channel_name) {
+  uint64_t channel_id = common::Hash(channel_name);
+  auto writer = std::make_shared<SegmentT>(channel_id);
+  auto reader = std::make_shared<SegmentT>(channel_id);
+
+  WritableBlock small_wb;
+  ASSERT_TRUE(writer->AcquireBlockToWrite(1024, &small_wb));
+  EXPECT_EQ(small_wb.index >> Segment::kArenaShift, 0);
+  std::memcpy(small_wb.buf, "small", 6);
+  small_wb.block->set_msg_size(6);
+  writer->ReleaseWrittenBlock(small_wb);
+
+  // a reader keeps the small block while the segment grows
+  ReadableBlock small_rb;
+  small_rb.index = small_wb.index;
+  ASSERT_TRUE(reader->AcquireBlockToRead(&small_rb));
+
+  WritableBlock large_wb;
+  const std::size_t large_size = 2 * 1024 * 1024;
+  ASSERT_TRUE(writer->AcquireBlockToWrite(large_size, &large_wb));
+  EXPECT_EQ(large_wb.index >> Segment::kArenaShift, 1);
+  std::memset(large_wb.buf, 'x', large_size);
+  large_wb.block->set_msg_size(large_size);
+  writer->ReleaseWrittenBlock(large_wb);
+
+  EXPECT_STREQ(reinterpret_cast<char*>(small_rb.buf), "small");
+  reader->ReleaseReadBlock(small_rb);
+
+  ReadableBlock large_rb;
+  large_rb.index = large_wb.index;
+  ASSERT_TRUE(reader->AcquireBlockToRead(&large_rb));
+  EXPECT_EQ(large_rb.block->msg_size(), large_size);
+  EXPECT_EQ(large_rb.buf[large_size - 1], 'x');
+  reader->ReleaseReadBlock(large_rb);
+
+  // the same size class reuses the arena
+  WritableBlock other_wb;
+  ASSERT_TRUE(writer->AcquireBlockToWrite(large_size / 2, &other_wb));
+  EXPECT_EQ(other_wb.index >> Segment::kArenaShift, 1);
+  writer->ReleaseWrittenBlock(other_wb);
+}
+
+TEST(SegmentTest, xsi_grow_with_arenas) {
+  GrowWithArenas<XsiSegment>("/segment_test/xsi");
+}
+
+TEST(SegmentTest, posix_grow_with_arenas) {
+  GrowWithArenas<PosixSegment>("/segment_test/posix");
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -52,10 +52,16 @@ class State {
   uint64_t ceiling_msg_size() { return ceiling_msg_size_.load(); }
   uint32_t reference_counts() { return reference_count_.load(); }
 
+  uint32_t arena_num() { return arena_num_.load(); }
+  bool ClaimArena(uint32_t arena_num) {
+    return arena_num_.compare_exchange_strong(arena_num, arena_num + 1);
+  }
+
  private:
   std::atomic<bool> need_remap_ = {false};
   std::atomic<uint32_t> seq_ = {0};
   std::atomic<uint32_t> reference_count_ = {0};
+  std::atomic<uint32_t> arena_num_ = {0};
   std::atomic<uint64_t> ceiling_msg_size_;
 };
 
@@ -21,6 +21,7 @@
 #include <sys/types.h>
 
 #include "cyber/common/log.h"
+#include "cyber/common/numa.h"
 #include "cyber/common/util.h"
 #include "cyber/transport/shm/segment.h"
 #include "cyber/transport/shm/shm_conf.h"
@@ -75,6 +76,10 @@ bool XsiSegment::OpenOrCreate() {
     return false;
   }
 
+  // keep the blocks next to the writer when it runs on a numa node
+  common::BindToNumaNode(managed_shm_, conf_.managed_shm_size(),
+                         common::ThreadNumaNode());
+
   // create field state_
   state_ = new (managed_shm_) State(conf_.ceiling_msg_size());
   if (state_ == nullptr) {
@@ -233,6 +238,10 @@ void XsiSegment::Reset() {
   }
 }
 
+SegmentPtr XsiSegment::NewArena(uint64_t arena_id) {
+  return std::make_shared<XsiSegment>(arena_id);
+}
+
 }  // namespace transport
 }  // namespace cyber
 }  // namespace apollo
@@ -35,6 +35,7 @@ class XsiSegment : public Segment {
   bool Remove() override;
   bool OpenOnly() override;
   bool OpenOrCreate() override;
+  SegmentPtr NewArena(uint64_t arena_id) override;
 
   key_t key_;
 };
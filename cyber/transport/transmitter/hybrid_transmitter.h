@@ -69,6 +69,8 @@ class HybridTransmitter : public Transmitter<M> {
   void Enable(const RoleAttributes& opposite_attr) override;
   void Disable(const RoleAttributes& opposite_attr) override;
 
+  MessagePtr Loan() override;
+
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
  private:
@@ -160,12 +162,34 @@ void HybridTransmitter<M>::Disable(const RoleAttributes& opposite_attr) {
   }
 }
 
+template <typename M>
+typename HybridTransmitter<M>::MessagePtr HybridTransmitter<M>::Loan() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // only worth borrowing from shm when other processes are listening,
+  // intra readers share the pointer anyway.
+  auto shm_receivers = receivers_.find(OptionalMode::SHM);
+  if (shm_receivers == receivers_.end() || shm_receivers->second.empty()) {
+    return Transmitter<M>::Loan();
+  }
+  return transmitters_[OptionalMode::SHM]->Loan();
+}
+
 template <typename M>
 bool HybridTransmitter<M>::Transmit(const MessagePtr& msg,
                                     const MessageInfo& msg_info) {
   std::lock_guard<std::mutex> lock(mutex_);
   history_->Add(msg, msg_info);
+  // same process readers get msg itself before anything is serialized, the
+  // other transports only serialize when they have a reader
+  auto intra = transmitters_.find(OptionalMode::INTRA);
+  if (intra != transmitters_.end() &&
+      !receivers_[OptionalMode::INTRA].empty()) {
+    intra->second->Transmit(msg, msg_info);
+  }
   for (auto& item : transmitters_) {
+    if (item.first == OptionalMode::INTRA || receivers_[item.first].empty()) {
+      continue;
+    }
     item.second->Transmit(msg, msg_info);
   }
   return true;
@@ -189,6 +213,11 @@ void HybridTransmitter<M>::ObtainConfig() {
     return;
   }
   mode_->CopyFrom(global_conf.transport_conf().communication_mode());
+  if (mode_->same_proc() != OptionalMode::INTRA) {
+    AWARN << "same process readers always share the message, ignore "
+          << proto::OptionalMode_Name(mode_->same_proc()) << " for same_proc.";
+    mode_->set_same_proc(OptionalMode::INTRA);
+  }
 
   mapping_table_[SAME_PROC] = mode_->same_proc();
   mapping_table_[DIFF_PROC] = mode_->diff_proc();
@@ -50,7 +50,10 @@ template <typename M>
 IntraTransmitter<M>::IntraTransmitter(const RoleAttributes& attr)
     : Transmitter<M>(attr),
       channel_id_(attr.channel_id()),
-      dispatcher_(nullptr) {}
+      dispatcher_(nullptr) {
+  this->stats_ = TransportStats::Instance()->Get(attr.channel_name(),
+                                                 "writer", "intra");
+}
 
 template <typename M>
 IntraTransmitter<M>::~IntraTransmitter() {
@@ -81,6 +84,8 @@ bool IntraTransmitter<M>::Transmit(const MessagePtr& msg,
     return false;
   }
 
+  // the pointer is shared, there are no bytes on the wire
+  this->stats_->OnTransmit(0);
   dispatcher_->OnMessage(channel_id_, msg, msg_info);
   return true;
 }
@@ -23,6 +23,7 @@
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
 #include "cyber/transport/rtps/attributes_filler.h"
+#include "cyber/transport/rtps/batcher.h"
 #include "cyber/transport/rtps/participant.h"
 #include "cyber/transport/transmitter/transmitter.h"
 #include "fastrtps/Domain.h"
@@ -50,15 +51,20 @@ class RtpsTransmitter : public Transmitter<M> {
 
  private:
   bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool Write(UnderlayMessage* m, const MessageInfo& msg_info);
 
   ParticipantPtr participant_;
   eprosima::fastrtps::Publisher* publisher_;
+  std::unique_ptr<Batcher> batcher_;
 };
 
 template <typename M>
 RtpsTransmitter<M>::RtpsTransmitter(const RoleAttributes& attr,
                                     const ParticipantPtr& participant)
-    : Transmitter<M>(attr), participant_(participant), publisher_(nullptr) {}
+    : Transmitter<M>(attr), participant_(participant), publisher_(nullptr) {
+  this->stats_ =
+      TransportStats::Instance()->Get(attr.channel_name(), "writer", "rtps");
+}
 
 template <typename M>
 RtpsTransmitter<M>::~RtpsTransmitter() {
@@ -79,12 +85,25 @@ void RtpsTransmitter<M>::Enable() {
   publisher_ = eprosima::fastrtps::Domain::createPublisher(
       participant_->fastrtps_participant(), pub_attr);
   RETURN_IF_NULL(publisher_);
+
+  auto conf = RtpsFlowConf::Load(this->attr_.channel_name());
+  if (conf.batch_window_us > 0) {
+    batcher_.reset(new Batcher(
+        conf, [this](const std::string& batch, const MessageInfo& msg_info) {
+          UnderlayMessage m;
+          m.data() = batch;
+          m.datatype() = Batcher::kDataType;
+          Write(&m, msg_info);
+        }));
+  }
   this->enabled_ = true;
 }
 
 template <typename M>
 void RtpsTransmitter<M>::Disable() {
   if (this->enabled_) {
+    // sends whatever is still batched
+    batcher_.reset();
     publisher_ = nullptr;
     this->enabled_ = false;
   }
@@ -105,7 +124,17 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
 
   UnderlayMessage m;
   RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
+  this->stats_->OnTransmit(m.data().size());
+  if (batcher_ != nullptr) {
+    batcher_->Add(m.data(), msg_info);
+    return true;
+  }
+  return Write(&m, msg_info);
+}
 
+template <typename M>
+bool RtpsTransmitter<M>::Write(UnderlayMessage* m,
+                               const MessageInfo& msg_info) {
   eprosima::fastrtps::rtps::WriteParams wparams;
 
   char* ptr =
@@ -118,11 +147,14 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
       (int32_t)((msg_info.seq_num() & 0xFFFFFFFF00000000) >> 32);
   wparams.related_sample_identity().sequence_number().low =
       (int32_t)(msg_info.seq_num() & 0xFFFFFFFF);
+  // low 32 bits of the send time in us, the reader restores the rest from
+  // its own clock
+  m->timestamp() = static_cast<int32_t>(msg_info.send_time() / 1000);
 
   if (participant_->is_shutdown()) {
     return false;
   }
-  return publisher_->write(reinterpret_cast<void*>(&m), wparams);
+  return publisher_->write(reinterpret_cast<void*>(m), wparams);
 }
 
 }  // namespace transport
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <type_traits>
 
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
@@ -35,6 +36,23 @@ namespace apollo {
 namespace cyber {
 namespace transport {
 
+// Owns the block behind a loaned message. The block stays write-locked until
+// the message is transmitted, and read-locked afterwards until the last
+// holder of the loan goes away.
+struct LoanedBlock {
+  SegmentPtr segment;
+  WritableBlock block;
+  bool transmitted = false;
+
+  void operator()(void*) {
+    if (transmitted) {
+      segment->ReleaseReadBlock(block);
+    } else {
+      segment->ReleaseWrittenBlock(block);
+    }
+  }
+};
+
 template <typename M>
 class ShmTransmitter : public Transmitter<M> {
  public:
@@ -46,10 +64,23 @@ class ShmTransmitter : public Transmitter<M> {
   void Enable() override;
   void Disable() override;
 
+  // For loanable types the message is constructed in a shm block, so
+  // transmitting it only publishes the block index.
+  MessagePtr Loan() override;
+
   bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) override;
 
  private:
+  using Loanable = std::integral_constant<bool, message::IsLoanable<M>::value>;
+
+  MessagePtr Loan(std::true_type);
+  MessagePtr Loan(std::false_type);
+  bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info,
+                std::true_type);
+  bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info,
+                std::false_type);
   bool Transmit(const M& msg, const MessageInfo& msg_info);
+  bool WriteMessageInfo(const MessageInfo& msg_info, WritableBlock* wb);
 
   SegmentPtr segment_;
   uint64_t channel_id_;
@@ -64,6 +95,8 @@ ShmTransmitter<M>::ShmTransmitter(const RoleAttributes& attr)
       channel_id_(attr.channel_id()),
       notifier_(nullptr) {
   host_id_ = common::Hash(attr.host_ip());
+  this->stats_ =
+      TransportStats::Instance()->Get(attr.channel_name(), "writer", "shm");
 }
 
 template <typename M>
@@ -91,12 +124,107 @@ void ShmTransmitter<M>::Disable() {
   }
 }
 
+template <typename M>
+typename ShmTransmitter<M>::MessagePtr ShmTransmitter<M>::Loan() {
+  return Loan(Loanable());
+}
+
+template <typename M>
+typename ShmTransmitter<M>::MessagePtr ShmTransmitter<M>::Loan(
+    std::true_type) {
+  static_assert(alignof(M) <= alignof(uint64_t),
+                "loanable message is over-aligned for shm blocks.");
+  if (!this->enabled_) {
+    return Transmitter<M>::Loan();
+  }
+
+  LoanedBlock loan;
+  if (!segment_->AcquireBlockToWrite(sizeof(M), &loan.block)) {
+    AERROR << "acquire block for loan failed.";
+    return Transmitter<M>::Loan();
+  }
+  loan.segment = segment_;
+  M* msg = new (loan.block.buf) M();
+  return MessagePtr(msg, loan);
+}
+
+template <typename M>
+typename ShmTransmitter<M>::MessagePtr ShmTransmitter<M>::Loan(
+    std::false_type) {
+  return Transmitter<M>::Loan();
+}
+
 template <typename M>
 bool ShmTransmitter<M>::Transmit(const MessagePtr& msg,
                                  const MessageInfo& msg_info) {
+  return Transmit(msg, msg_info, Loanable());
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Transmit(const MessagePtr& msg,
+                                 const MessageInfo& msg_info, std::true_type) {
+  if (!this->enabled_) {
+    ADEBUG << "not enable.";
+    return false;
+  }
+
+  auto loan = std::get_deleter<LoanedBlock>(msg);
+  if (loan == nullptr || loan->segment != segment_ || loan->transmitted) {
+    // not backed by our segment, a flat copy is still cheaper than
+    // serialization.
+    WritableBlock wb;
+    if (!segment_->AcquireBlockToWrite(sizeof(M), &wb)) {
+      AERROR << "acquire block failed.";
+      return false;
+    }
+    std::memcpy(wb.buf, msg.get(), sizeof(M));
+    wb.block->set_msg_size(sizeof(M));
+    if (!WriteMessageInfo(msg_info, &wb)) {
+      segment_->ReleaseWrittenBlock(wb);
+      return false;
+    }
+    segment_->ReleaseWrittenBlock(wb);
+    this->stats_->OnTransmit(sizeof(M));
+    ReadableInfo readable_info(host_id_, wb.index, channel_id_);
+    return notifier_->Notify(readable_info);
+  }
+
+  WritableBlock& wb = loan->block;
+  wb.block->set_msg_size(sizeof(M));
+  if (!WriteMessageInfo(msg_info, &wb)) {
+    return false;
+  }
+  segment_->ReleaseWrittenBlockForRead(wb);
+  loan->transmitted = true;
+  this->stats_->OnTransmit(sizeof(M));
+
+  ReadableInfo readable_info(host_id_, wb.index, channel_id_);
+  ADEBUG << "Writing loaned sharedmem message: "
+         << common::GlobalData::GetChannelById(channel_id_)
+         << " to block: " << wb.index;
+  return notifier_->Notify(readable_info);
+}
+
+template <typename M>
+bool ShmTransmitter<M>::Transmit(const MessagePtr& msg,
+                                 const MessageInfo& msg_info,
+                                 std::false_type) {
   return Transmit(*msg, msg_info);
 }
 
+template <typename M>
+bool ShmTransmitter<M>::WriteMessageInfo(const MessageInfo& msg_info,
+                                         WritableBlock* wb) {
+  char* msg_info_addr =
+      reinterpret_cast<char*>(wb->buf) + wb->block->msg_size();
+  if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
+    AERROR << "serialize message info failed.";
+    return false;
+  }
+  wb->block->set_msg_info_size(MessageInfo::kSize);
+  return true;
+}
+
 template <typename M>
 bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   if (!this->enabled_) {
@@ -119,14 +247,12 @@ bool ShmTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   }
   wb.block->set_msg_size(msg_size);
 
-  char* msg_info_addr = reinterpret_cast<char*>(wb.buf) + msg_size;
-  if (!msg_info.SerializeTo(msg_info_addr, MessageInfo::kSize)) {
-    AERROR << "serialize message info failed.";
+  if (!WriteMessageInfo(msg_info, &wb)) {
     segment_->ReleaseWrittenBlock(wb);
     return false;
   }
-  wb.block->set_msg_info_size(MessageInfo::kSize);
   segment_->ReleaseWrittenBlock(wb);
+  this->stats_->OnTransmit(msg_size);
 
   ReadableInfo readable_info(host_id_, wb.index, channel_id_);
 
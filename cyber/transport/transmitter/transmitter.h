@@ -22,7 +22,9 @@
 #include <string>
 
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/time/time.h"
 #include "cyber/transport/common/endpoint.h"
+#include "cyber/transport/common/transport_stats.h"
 #include "cyber/transport/message/message_info.h"
 
 namespace apollo {
@@ -46,6 +48,11 @@ class Transmitter : public Endpoint {
   virtual void Enable(const RoleAttributes& opposite_attr);
   virtual void Disable(const RoleAttributes& opposite_attr);
 
+  // Returns a message to be filled in place and handed back to Transmit.
+  // Transports that can back it by their own buffers avoid the copy and
+  // serialization Transmit would otherwise do; by default it is on the heap.
+  virtual MessagePtr Loan();
+
   virtual bool Transmit(const MessagePtr& msg);
   virtual bool Transmit(const MessagePtr& msg, const MessageInfo& msg_info) = 0;
 
@@ -56,6 +63,8 @@ class Transmitter : public Endpoint {
  protected:
   uint64_t seq_num_;
   MessageInfo msg_info_;
+  // set by the transmitters that actually move bytes
+  std::shared_ptr<ChannelStats> stats_;
 };
 
 template <typename M>
@@ -68,9 +77,15 @@ Transmitter<M>::Transmitter(const RoleAttributes& attr)
 template <typename M>
 Transmitter<M>::~Transmitter() {}
 
+template <typename M>
+typename Transmitter<M>::MessagePtr Transmitter<M>::Loan() {
+  return std::make_shared<M>();
+}
+
 template <typename M>
 bool Transmitter<M>::Transmit(const MessagePtr& msg) {
   msg_info_.set_seq_num(NextSeqNum());
+  msg_info_.set_send_time(Time::Now().ToNanosecond());
   PerfEventCache::Instance()->AddTransportEvent(
       TransPerf::TRANSMIT_BEGIN, attr_.channel_id(), msg_info_.seq_num());
   return Transmit(msg, msg_info_);
@@ -42,34 +42,88 @@ void AudioInfo::InsertChannelData(const std::size_t index,
                                   const ChannelData& channel_data,
                                   const MicrophoneConfig& microphone_config) {
   while (index >= signals_.size()) {
-    signals_.push_back(std::deque<double>());
+    signals_.push_back(SignalRing());
+  }
+  SignalRing& ring = signals_[index];
+  std::size_t max_signal_length = static_cast<std::size_t>(
+      FLAGS_cache_signal_time * microphone_config.sample_rate());
+  SetCapacity(max_signal_length, &ring);
+  if (max_signal_length == 0) {
+    return;
   }
   int width = microphone_config.sample_width();
   const std::string& data = channel_data.data();
   for (std::size_t i = 0; i < data.length(); i += width) {
     int16_t signal = ((int16_t(data[i + 1])) << 8) | (0x00ff & data[i]);
-    signals_[index].push_back(static_cast<double>(signal));
+    if (ring.size < max_signal_length) {
+      std::size_t end = ring.start + ring.size;
+      if (end >= max_signal_length) {
+        end -= max_signal_length;
+      }
+      ring.samples[end] = static_cast<double>(signal);
+      ++ring.size;
+    } else {
+      // drop the oldest sample
+      ring.samples[ring.start] = static_cast<double>(signal);
+      if (++ring.start == max_signal_length) {
+        ring.start = 0;
+      }
+    }
   }
-  std::size_t max_signal_length = static_cast<std::size_t>(
-      FLAGS_cache_signal_time * microphone_config.sample_rate());
-  while (signals_[index].size() > max_signal_length) {
-    signals_[index].pop_front();
+}
+
+void AudioInfo::SetCapacity(const std::size_t capacity, SignalRing* ring) {
+  if (ring->samples.size() == capacity) {
+    return;
   }
+  // keep the latest samples which still fit
+  std::vector<double> samples;
+  CopySignal(*ring, static_cast<int>(capacity), &samples);
+  ring->size = samples.size();
+  ring->start = 0;
+  samples.resize(capacity);
+  ring->samples.swap(samples);
+}
+
+void AudioInfo::CopySignal(const SignalRing& ring, const int signal_length,
+                           std::vector<double>* signal) const {
+  int start_index = static_cast<int>(ring.size) - signal_length;
+  start_index = std::min(std::max(0, start_index), static_cast<int>(ring.size));
+  signal->resize(ring.size - start_index);
+  if (signal->empty()) {
+    return;
+  }
+  // the samples from start_index on are at most two runs of the ring
+  std::size_t begin = ring.start + start_index;
+  if (begin >= ring.samples.size()) {
+    begin -= ring.samples.size();
+  }
+  const std::size_t first_run =
+      std::min(signal->size(), ring.samples.size() - begin);
+  std::copy(ring.samples.begin() + begin,
+            ring.samples.begin() + begin + first_run, signal->begin());
+  std::copy(ring.samples.begin(),
+            ring.samples.begin() + (signal->size() - first_run),
+            signal->begin() + first_run);
 }
 
 std::vector<std::vector<double>> AudioInfo::GetSignals(
     const int signal_length) {
-  std::vector<std::vector<double>> signals;
+  std::vector<std::vector<double>> signals(signals_.size());
   for (std::size_t i = 0; i < signals_.size(); ++i) {
-    int start_index = static_cast<int>(signals_[i].size()) - signal_length;
-    start_index = std::max(0, start_index);
-    std::deque<double>::iterator iter = signals_[i].begin();
-    iter += start_index;
-    std::vector<double> signal(iter, signals_[i].end());
-    signals.push_back(signal);
+    CopySignal(signals_[i], signal_length, &signals[i]);
   }
   return signals;
 }
 
+const std::vector<std::vector<double>>& AudioInfo::GetSignalsInPlace(
+    const int signal_length) {
+  signals_in_place_.resize(signals_.size());
+  for (std::size_t i = 0; i < signals_.size(); ++i) {
+    CopySignal(signals_[i], signal_length, &signals_in_place_[i]);
+  }
+  return signals_in_place_;
+}
+
 }  // namespace audio
 }  // namespace apollo
@@ -14,7 +14,6 @@
  * limitations under the License.
  *****************************************************************************/
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -34,14 +33,32 @@ class AudioInfo {
 
   std::vector<std::vector<double>> GetSignals(const int signal_length);
 
+  // same signals as GetSignals, kept in buffers reused from call to call.
+  // they stay valid until the next call.
+  const std::vector<std::vector<double>>& GetSignalsInPlace(
+      const int signal_length);
+
  private:
+  // the last samples of a channel, oldest at start
+  struct SignalRing {
+    std::vector<double> samples;
+    std::size_t start = 0;
+    std::size_t size = 0;
+  };
+
+  void SetCapacity(const std::size_t capacity, SignalRing* ring);
+
+  void CopySignal(const SignalRing& ring, const int signal_length,
+                  std::vector<double>* signal) const;
+
   void InsertChannelData(
       const std::size_t index,
       const apollo::drivers::microphone::config::ChannelData& channel_data,
       const apollo::drivers::microphone::config::MicrophoneConfig&
           microphone_config);
 
-  std::vector<std::deque<double>> signals_;
+  std::vector<SignalRing> signals_;
+  std::vector<std::vector<double>> signals_in_place_;
 };
 
 }  // namespace audio
@@ -16,6 +16,8 @@
 
 #include "modules/audio/common/message_process.h"
 
+#include <utility>
+
 namespace apollo {
 namespace audio {
 
@@ -30,21 +32,25 @@ void MessageProcess::OnMicrophone(
     SirenDetection* siren_detection,
     AudioDetection* audio_detection) {
   audio_info->Insert(audio_data);
+  // the latest chunk is shared by the moving and the direction detection,
+  // the latter takes it over last
+  auto signals =
+      audio_info->GetSignals(audio_data.microphone_config().chunk());
+  MovingResult moving_result = moving_detection->Detect(signals);
+  audio_detection->set_moving_result(moving_result);
+
   auto direction_result =
       direction_detection->EstimateSoundSource(
-          audio_info->GetSignals(audio_data.microphone_config().chunk()),
+          std::move(signals),
           respeaker_extrinsics_file,
           audio_data.microphone_config().sample_rate(),
           audio_data.microphone_config().mic_distance());
   *(audio_detection->mutable_position()) = direction_result.first;
   audio_detection->set_source_degree(direction_result.second);
 
-  bool is_siren = siren_detection->Evaluate(audio_info->GetSignals(72000));
+  bool is_siren =
+      siren_detection->Evaluate(audio_info->GetSignalsInPlace(72000));
   audio_detection->set_is_siren(is_siren);
-  auto signals =
-      audio_info->GetSignals(audio_data.microphone_config().chunk());
-  MovingResult moving_result = moving_detection->Detect(signals);
-  audio_detection->set_moving_result(moving_result);
 }
 
 }  // namespace audio
@@ -16,11 +16,17 @@
 
 #include "modules/audio/inference/moving_detection.h"
 
-#include <fftw3.h>
-
 namespace apollo {
 namespace audio {
 
+MovingDetection::~MovingDetection() {
+  if (fft_plan_ != nullptr) {
+    fftw_destroy_plan(fft_plan_);
+  }
+  fftw_free(fft_in_);
+  fftw_free(fft_out_);
+}
+
 MovingResult MovingDetection::Detect(
     const std::vector<std::vector<double>>& signals) {
   int approaching_count = 0;
@@ -105,20 +111,33 @@ MovingResult MovingDetection::AnalyzeTopFrequence(
 std::vector<std::complex<double>> MovingDetection::fft1d(
     const std::vector<double>& signal) {
   int n = static_cast<int>(signal.size());
-  fftw_complex in[n];  // NOLINT
-  fftw_complex out[n];  // NOLINT
+  if (n == 0) {
+    return {};
+  }
+  if (n != fft_size_) {
+    if (fft_plan_ != nullptr) {
+      fftw_destroy_plan(fft_plan_);
+    }
+    fftw_free(fft_in_);
+    fftw_free(fft_out_);
+    fft_in_ = static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * n));
+    fft_out_ =
+        static_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * n));
+    fft_plan_ = fftw_plan_dft_1d(n, fft_in_, fft_out_, FFTW_FORWARD,
+                                 FFTW_ESTIMATE);
+    fft_size_ = n;
+  }
   for (int i = 0; i < n; ++i) {
-    in[i][0] = signal[i];
-    in[i][1] = 0.0;
+    fft_in_[i][0] = signal[i];
+    fft_in_[i][1] = 0.0;
   }
 
-  fftw_plan p = fftw_plan_dft_1d(n, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
-  fftw_execute(p);
+  fftw_execute(fft_plan_);
 
   std::vector<std::complex<double>> output;
   output.reserve(n);
   for (int i = 0; i < n; ++i) {
-    output.emplace_back(out[i][0], out[i][1]);
+    output.emplace_back(fft_out_[i][0], fft_out_[i][1]);
   }
   return output;
 }
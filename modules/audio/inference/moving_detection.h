@@ -18,6 +18,8 @@
 #include <vector>
 #include <complex>
 
+#include <fftw3.h>
+
 #include "modules/audio/proto/audio.pb.h"
 
 namespace apollo {
@@ -32,6 +34,11 @@ class MovingDetection {
  public:
   MovingDetection() = default;
 
+  ~MovingDetection();
+
+  MovingDetection(const MovingDetection&) = delete;
+  MovingDetection& operator=(const MovingDetection&) = delete;
+
   std::vector<std::complex<double>> fft1d(const std::vector<double>& signals);
 
   MovingResult Detect(const std::vector<std::vector<double>>& signals);
@@ -60,6 +67,12 @@ class MovingDetection {
   MovingResult AnalyzeTopFrequence(const std::deque<SignalStat>& signal_stats);
 
   std::vector<std::deque<SignalStat>> signal_stats_;
+
+  // plan and buffers of the last fft size, every chunk has the same size
+  int fft_size_ = 0;
+  fftw_complex* fft_in_ = nullptr;
+  fftw_complex* fft_out_ = nullptr;
+  fftw_plan fft_plan_ = nullptr;
 };
 
 }  // namespace audio
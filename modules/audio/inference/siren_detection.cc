@@ -42,12 +42,19 @@ bool SirenDetection::Evaluate(const std::vector<std::vector<double>>& signals) {
     AERROR << "Got no signal in channel 0!";
     return false;
   }
-  if (signals[0].size() != 72000) {
-    AERROR << "signals[0].size() = " << signals[0].size() << ", skiping!";
-    return false;
+  for (const auto& channel : signals) {
+    if (channel.size() != 72000) {
+      AERROR << "channel.size() = " << channel.size() << ", skiping!";
+      return false;
+    }
   }
-  torch::Tensor audio_tensor = torch::empty(4 * 1 * 72000);
-  float* data = audio_tensor.data_ptr<float>();
+  // all the channels go through the model as one batch, in a tensor which
+  // is only allocated again when the number of channels changes
+  const int64_t num_channels = static_cast<int64_t>(signals.size());
+  if (!input_tensor_.defined() || input_tensor_.size(0) != num_channels) {
+    input_tensor_ = torch::empty({num_channels, 1, 72000});
+  }
+  float* data = input_tensor_.data_ptr<float>();
 
   for (const auto& channel : signals) {
     for (const auto& i : channel) {
@@ -55,10 +62,8 @@ bool SirenDetection::Evaluate(const std::vector<std::vector<double>>& signals) {
     }
   }
 
-  torch::Tensor torch_input = torch::from_blob(audio_tensor.data_ptr<float>(),
-                                               {4, 1, 72000});
   std::vector<torch::jit::IValue> torch_inputs;
-  torch_inputs.push_back(torch_input.to(device_));
+  torch_inputs.push_back(input_tensor_.to(device_));
 
   auto start_time = std::chrono::system_clock::now();
   at::Tensor torch_output_tensor = torch_model_.forward(torch_inputs).toTensor()
@@ -69,11 +74,13 @@ bool SirenDetection::Evaluate(const std::vector<std::vector<double>>& signals) {
   AINFO << "SirenDetection used time: " << diff.count() * 1000 << " ms.";
   auto torch_output = torch_output_tensor.accessor<float, 2>();
 
-  // majority vote with 4 channels
-  float neg_score = torch_output[0][0] + torch_output[1][0] +
-                    torch_output[2][0] + torch_output[3][0];
-  float pos_score = torch_output[0][1] + torch_output[1][1] +
-                    torch_output[2][1] + torch_output[3][1];
+  // majority vote with all the channels
+  float neg_score = 0.0f;
+  float pos_score = 0.0f;
+  for (int64_t i = 0; i < num_channels; ++i) {
+    neg_score += torch_output[i][0];
+    pos_score += torch_output[i][1];
+  }
   ADEBUG << "neg_score = " << neg_score << ", pos_score = " << pos_score;
   if (neg_score < pos_score) {
     return true;
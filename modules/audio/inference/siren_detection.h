@@ -43,6 +43,7 @@ class SirenDetection {
  private:
   torch::jit::script::Module torch_model_;
   torch::Device device_;
+  torch::Tensor input_tensor_;
 };
 
 }  // namespace audio
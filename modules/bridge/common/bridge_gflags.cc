@@ -18,3 +18,10 @@
 
 DEFINE_string(bridge_module_name, "Bridge", "Bridge module name");
 DEFINE_double(timeout, 1.0, "receive/send proto msg time out");
+DEFINE_bool(bridge_batched_io, false,
+            "send the frames of a msg with one sendmmsg on a kept socket, "
+            "receive with recvmmsg until the socket is drained");
+DEFINE_bool(bridge_lz4_compression, false,
+            "lz4 compress the sent msgs, needs receivers built with lz4");
+DEFINE_bool(bridge_record_latency, false,
+            "record the latency of the received msgs per msg name");
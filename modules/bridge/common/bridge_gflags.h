@@ -20,3 +20,6 @@
 
 DECLARE_string(bridge_module_name);
 DECLARE_double(timeout);
+DECLARE_bool(bridge_batched_io);
+DECLARE_bool(bridge_lz4_compression);
+DECLARE_bool(bridge_record_latency);
@@ -28,6 +28,8 @@ typedef uint32_t hsize;
 
 constexpr char BRIDGE_HEADER_FLAG[] = "ApolloBridgeHeader";
 constexpr size_t HEADER_FLAG_SIZE = sizeof(BRIDGE_HEADER_FLAG);
+// the payload is a uint32 raw size followed by a lz4 block.
+constexpr uint32_t BRIDGE_HEADER_VER_LZ4 = 1;
 constexpr size_t Item_Header_Size = sizeof(HType) + sizeof(bsize) + 2;
 
 class BridgeHeader {
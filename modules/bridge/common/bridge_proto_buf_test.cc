@@ -93,5 +93,50 @@ TEST(BridgeProtoBufTest, Simple) {
   }
 }
 
+TEST(BridgeProtoBufTest, CompressedFrames) {
+  BridgeProtoSerializedBuf<planning::ADCTrajectory> proto_buf;
+  BridgeProtoDiserializedBuf<planning::ADCTrajectory> proto_recv_buf;
+
+  for (int round = 0; round < 2; ++round) {
+    auto adc_trajectory = std::make_shared<planning::ADCTrajectory>();
+    for (size_t i = 0; i < 200; ++i) {
+      auto *point = adc_trajectory->add_trajectory_point();
+      point->mutable_path_point()->set_x(0.1 * static_cast<double>(i));
+      point->mutable_path_point()->set_y(1.0);
+    }
+    adc_trajectory->mutable_header()->set_sequence_num(123 + round);
+    EXPECT_TRUE(proto_buf.SerializeFrames(adc_trajectory,
+                                          "planning::ADCTrajectory", true));
+
+    proto_recv_buf.Reset();
+    std::string frame;
+    for (size_t i = 0; i < proto_buf.GetFrameCount(); ++i) {
+      const struct iovec *iov = proto_buf.GetFrameIov(i);
+      frame.assign(static_cast<const char *>(iov[0].iov_base), iov[0].iov_len);
+      frame.append(static_cast<const char *>(iov[1].iov_base), iov[1].iov_len);
+
+      bsize offset = static_cast<bsize>(sizeof(BRIDGE_HEADER_FLAG) + 1);
+      hsize header_size = 0;
+      memcpy(&header_size, frame.data() + offset, sizeof(hsize));
+      offset += static_cast<bsize>(sizeof(hsize) + 1);
+      BridgeHeader header;
+      EXPECT_TRUE(
+          header.Diserialize(frame.data() + offset, header_size - offset));
+      EXPECT_EQ(header.GetHeaderVer(), BRIDGE_HEADER_VER_LZ4);
+
+      proto_recv_buf.Initialize(header);
+      EXPECT_TRUE(proto_recv_buf.IsTheProto(header));
+      memcpy(proto_recv_buf.GetBuf(header.GetFramePos()),
+             frame.data() + header_size, header.GetFrameSize());
+      proto_recv_buf.UpdateStatus(header.GetIndex());
+    }
+    EXPECT_TRUE(proto_recv_buf.IsReadyDiserialize());
+
+    auto pb_msg = std::make_shared<planning::ADCTrajectory>();
+    EXPECT_TRUE(proto_recv_buf.Diserialized(pb_msg));
+    EXPECT_EQ(pb_msg->SerializeAsString(), adc_trajectory->SerializeAsString());
+  }
+}
+
 }  // namespace bridge
 }  // namespace apollo
@@ -20,6 +20,8 @@
 #include <string>
 #include <vector>
 
+#include "lz4.h"
+
 #include "cyber/cyber.h"
 #include "modules/bridge/common/bridge_header.h"
 #include "modules/bridge/common/macro.h"
@@ -44,6 +46,9 @@ class ProtoDiserializedBufBase {
   virtual uint32_t GetMsgID() const = 0;
   virtual std::string GetMsgName() const = 0;
   virtual char *GetBuf(size_t offset) = 0;
+  virtual size_t GetBufSize() const = 0;
+  // clears the frames so a pool can hand the buffer to the next message.
+  virtual void Reset() = 0;
 };
 
 template <typename T>
@@ -65,15 +70,20 @@ class BridgeProtoDiserializedBuf : public ProtoDiserializedBufBase {
   bool Initialize(const BridgeHeader &header);
   bool Diserialized(std::shared_ptr<T> proto);
   virtual char *GetBuf(size_t offset) { return proto_buf_ + offset; }
+  virtual size_t GetBufSize() const { return total_size_; }
   virtual uint32_t GetMsgID() const { return sequence_num_; }
   virtual std::string GetMsgName() const { return proto_name_; }
+  virtual void Reset();
 
  private:
   size_t total_frames_ = 0;
   size_t total_size_ = 0;
+  uint32_t header_ver_ = 0;
   std::string proto_name_ = "";
   std::vector<uint32_t> status_list_;
   char *proto_buf_ = nullptr;
+  size_t buf_capacity_ = 0;
+  std::string raw_buf_;
   bool is_ready_diser = false;
   uint32_t sequence_num_ = 0;
   std::shared_ptr<cyber::Writer<T>> writer_;
@@ -90,8 +100,33 @@ bool BridgeProtoDiserializedBuf<T>::Diserialized(std::shared_ptr<T> proto) {
   if (!proto_buf_ || !proto) {
     return false;
   }
-  proto->ParseFromArray(proto_buf_, static_cast<int>(total_size_));
-  return true;
+  if (header_ver_ != BRIDGE_HEADER_VER_LZ4) {
+    proto->ParseFromArray(proto_buf_, static_cast<int>(total_size_));
+    return true;
+  }
+  uint32_t raw_size = 0;
+  if (total_size_ < sizeof(raw_size)) {
+    return false;
+  }
+  memcpy(&raw_size, proto_buf_, sizeof(raw_size));
+  raw_buf_.resize(raw_size);
+  const int size = LZ4_decompress_safe(
+      proto_buf_ + sizeof(raw_size), &raw_buf_[0],
+      static_cast<int>(total_size_ - sizeof(raw_size)),
+      static_cast<int>(raw_size));
+  if (size != static_cast<int>(raw_size)) {
+    AERROR << "lz4 decompress " << proto_name_ << " failed.";
+    return false;
+  }
+  return proto->ParseFromString(raw_buf_);
+}
+
+template <typename T>
+void BridgeProtoDiserializedBuf<T>::Reset() {
+  total_frames_ = 0;
+  total_size_ = 0;
+  status_list_.clear();
+  is_ready_diser = false;
 }
 
 template <typename T>
@@ -137,6 +172,9 @@ template <typename T>
 bool BridgeProtoDiserializedBuf<T>::Initialize(const BridgeHeader &header) {
   total_size_ = header.GetMsgSize();
   total_frames_ = header.GetTotalFrames();
+  header_ver_ = header.GetHeaderVer();
+  proto_name_ = header.GetMsgName();
+  sequence_num_ = header.GetMsgID();
   if (total_frames_ == 0) {
     return false;
   }
@@ -148,8 +186,10 @@ bool BridgeProtoDiserializedBuf<T>::Initialize(const BridgeHeader &header) {
     }
   }
 
-  if (!proto_buf_) {
+  if (!proto_buf_ || buf_capacity_ < total_size_) {
+    FREE_ARRY(proto_buf_);
     proto_buf_ = new char[total_size_];
+    buf_capacity_ = total_size_;
   }
   return true;
 }
@@ -157,7 +197,9 @@ bool BridgeProtoDiserializedBuf<T>::Initialize(const BridgeHeader &header) {
 template <typename T>
 bool BridgeProtoDiserializedBuf<T>::Initialize(
     const BridgeHeader &header, std::shared_ptr<cyber::Node> node) {
-  writer_ = node->CreateWriter<T>(topic_name_.c_str());
+  if (writer_ == nullptr) {
+    writer_ = node->CreateWriter<T>(topic_name_.c_str());
+  }
   return Initialize(header);
 }
 
@@ -16,10 +16,14 @@
 
 #pragma once
 
+#include <sys/uio.h>
+
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "lz4.h"
+
 #include "modules/bridge/common/bridge_header.h"
 #include "modules/bridge/common/macro.h"
 
@@ -43,6 +47,20 @@ class BridgeProtoSerializedBuf {
     return frames_[index].buf_len_;
   }
 
+  /**
+   * @brief serializes the proto once, each frame is then its header followed
+   *   by a slice of that payload, with no copy into per frame buffers. all
+   *   the buffers are kept for the next message.
+   * @param compress whether the payload is lz4 compressed, the header version
+   *   is then BRIDGE_HEADER_VER_LZ4.
+   */
+  bool SerializeFrames(const std::shared_ptr<T> &proto,
+                       const std::string &msg_name, bool compress);
+
+  size_t GetFrameCount() const { return iovs_.size() / 2; }
+  // two iovecs per frame, the header and the payload slice.
+  struct iovec *GetFrameIov(size_t index) { return &iovs_[2 * index]; }
+
  private:
   struct Buf {
     char *buf_;
@@ -51,6 +69,11 @@ class BridgeProtoSerializedBuf {
 
  private:
   std::vector<Buf> frames_;
+
+  std::string payload_;
+  std::string compressed_;
+  std::vector<char> headers_;
+  std::vector<struct iovec> iovs_;
 };
 
 template <typename T>
@@ -102,5 +125,69 @@ bool BridgeProtoSerializedBuf<T>::Serialize(const std::shared_ptr<T> &proto,
   return true;
 }
 
+template <typename T>
+bool BridgeProtoSerializedBuf<T>::SerializeFrames(
+    const std::shared_ptr<T> &proto, const std::string &msg_name,
+    bool compress) {
+  iovs_.clear();
+  if (!proto->SerializeToString(&payload_)) {
+    return false;
+  }
+  const std::string *body = &payload_;
+  if (compress) {
+    // the raw size goes first so the receiver can size the output.
+    const uint32_t raw_size = static_cast<uint32_t>(payload_.size());
+    const int bound = LZ4_compressBound(static_cast<int>(payload_.size()));
+    compressed_.resize(sizeof(raw_size) + bound);
+    memcpy(&compressed_[0], &raw_size, sizeof(raw_size));
+    const int compressed_size = LZ4_compress_default(
+        payload_.data(), &compressed_[sizeof(raw_size)],
+        static_cast<int>(payload_.size()), bound);
+    if (compressed_size <= 0) {
+      return false;
+    }
+    compressed_.resize(sizeof(raw_size) + compressed_size);
+    body = &compressed_;
+  }
+
+  const bsize msg_len = static_cast<bsize>(body->size());
+  const uint32_t total_frames = static_cast<uint32_t>(
+      msg_len / FRAME_SIZE + (msg_len % FRAME_SIZE ? 1 : 0));
+  hsize header_size = 0;
+  for (uint32_t frame_index = 0; frame_index < total_frames; ++frame_index) {
+    const bsize pos = frame_index * FRAME_SIZE;
+    const bsize left = msg_len - pos;
+    const bsize cpy_size = (left > FRAME_SIZE) ? FRAME_SIZE : left;
+
+    BridgeHeader header;
+    header.SetHeaderVer(compress ? BRIDGE_HEADER_VER_LZ4 : 0);
+    header.SetMsgName(msg_name);
+    header.SetMsgID(proto->header().sequence_num());
+    header.SetTimeStamp(proto->header().timestamp_sec());
+    header.SetMsgSize(msg_len);
+    header.SetTotalFrames(total_frames);
+    header.SetFrameSize(cpy_size);
+    header.SetIndex(frame_index);
+    header.SetFramePos(pos);
+    if (frame_index == 0) {
+      // the items are fixed size, only the name varies per message.
+      header_size = header.GetHeaderSize();
+      headers_.resize(static_cast<size_t>(header_size) * total_frames);
+    }
+    char *header_buf =
+        &headers_[static_cast<size_t>(header_size) * frame_index];
+    header.Serialize(header_buf, header_size);
+
+    struct iovec iov;
+    iov.iov_base = header_buf;
+    iov.iov_len = header_size;
+    iovs_.push_back(iov);
+    iov.iov_base = const_cast<char *>(body->data()) + pos;
+    iov.iov_len = cpy_size;
+    iovs_.push_back(iov);
+  }
+  return true;
+}
+
 }  // namespace bridge
 }  // namespace apollo
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/bridge/common/util.h"
 
+#include "cyber/time/clock.h"
+
 namespace apollo {
 namespace bridge {
 
@@ -28,5 +30,16 @@ int GetProtoSize(const char *buf, size_t size) {
   return proto_size;
 }
 
+void MsgLatencyRecorder::Record(const std::string &msg_name, uint32_t msg_id,
+                                double time_stamp) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &recorder = recorders_[msg_name];
+  if (recorder == nullptr) {
+    recorder.reset(new common::LatencyRecorder("bridge/" + msg_name));
+  }
+  recorder->AppendLatencyRecord(msg_id, cyber::Time(time_stamp),
+                                cyber::Clock::Now());
+}
+
 }  // namespace bridge
 }  // namespace apollo
@@ -16,13 +16,19 @@
 
 #pragma once
 
+#include <sys/socket.h>
+
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/bridge/common/bridge_buffer.h"
+#include "modules/bridge/common/bridge_header.h"
 #include "modules/bridge/common/macro.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
 
 namespace apollo {
 namespace bridge {
@@ -79,5 +85,55 @@ bool RemoveItem(std::vector<std::shared_ptr<T>> *list, std::shared_ptr<T> t) {
 
 int GetProtoSize(const char *buf, size_t size);
 
+constexpr int RECV_BATCH_SIZE = 16;
+
+/**
+ * @brief drains the socket with recvmmsg, one syscall per RECV_BATCH_SIZE
+ *   frames, and calls handle(buf, bytes) on each frame.
+ */
+template <typename F>
+void RecvFrames(int fd, const F &handle) {
+  char bufs[RECV_BATCH_SIZE][2 * FRAME_SIZE];
+  struct iovec iovs[RECV_BATCH_SIZE];
+  struct mmsghdr msgs[RECV_BATCH_SIZE];
+  memset(msgs, 0, sizeof(msgs));
+  for (int i = 0; i < RECV_BATCH_SIZE; ++i) {
+    iovs[i].iov_base = bufs[i];
+    iovs[i].iov_len = sizeof(bufs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  while (true) {
+    int count = recvmmsg(fd, msgs, RECV_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (count <= 0) {
+      return;
+    }
+    for (int i = 0; i < count; ++i) {
+      if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+        continue;
+      }
+      handle(bufs[i], static_cast<int>(msgs[i].msg_len));
+    }
+    if (count < RECV_BATCH_SIZE) {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief records the latency from the header timestamp to the time a message
+ *   is published, with one recorder per message name.
+ */
+class MsgLatencyRecorder {
+ public:
+  void Record(const std::string &msg_name, uint32_t msg_id,
+              double time_stamp);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<common::LatencyRecorder>>
+      recorders_;
+};
+
 }  // namespace bridge
 }  // namespace apollo
@@ -64,6 +64,7 @@ UDPBridgeMultiReceiverComponent::CreateBridgeProtoBuf(
         proto_list_.begin();
     for (; itor != proto_list_.end();) {
       if ((*itor)->IsTheProto(header)) {
+        ReleaseBuf(*itor);
         itor = proto_list_.erase(itor);
         break;
       }
@@ -78,7 +79,13 @@ UDPBridgeMultiReceiverComponent::CreateBridgeProtoBuf(
     }
   }
 
-  proto_buf = ProtoDiserializedBufBaseFactory::CreateObj(header);
+  auto &free_bufs = free_bufs_[header.GetMsgName()];
+  if (free_bufs.empty()) {
+    proto_buf = ProtoDiserializedBufBaseFactory::CreateObj(header);
+  } else {
+    proto_buf = free_bufs.back();
+    free_bufs.pop_back();
+  }
   if (!proto_buf) {
     return proto_buf;
   }
@@ -111,6 +118,12 @@ bool UDPBridgeMultiReceiverComponent::IsTimeout(double time_stamp) {
 }
 
 bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
+  if (FLAGS_bridge_batched_io) {
+    RecvFrames(fd, [this](const char *buf, int bytes) {
+      HandleFrame(buf, bytes);
+    });
+    return true;
+  }
   struct sockaddr_in client_addr;
   socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
   int bytes = 0;
@@ -123,6 +136,14 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
   if (bytes <= 0 || bytes > total_recv) {
     return false;
   }
+  return HandleFrame(total_buf, bytes);
+}
+
+bool UDPBridgeMultiReceiverComponent::HandleFrame(const char *total_buf,
+                                                  int bytes) {
+  if (bytes < static_cast<int>(HEADER_FLAG_SIZE + sizeof(hsize) + 2)) {
+    return false;
+  }
   char header_flag[sizeof(BRIDGE_HEADER_FLAG) + 1] = {0};
   size_t offset = 0;
   memcpy(header_flag, total_buf, HEADER_FLAG_SIZE);
@@ -140,6 +161,11 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
     AINFO << "header size is more than FRAME_SIZE!";
     return false;
   }
+  if (header_size > static_cast<hsize>(bytes) ||
+      header_size < offset + sizeof(hsize) + 1) {
+    AINFO << "header size does not match the frame!";
+    return false;
+  }
   offset += sizeof(hsize) + 1;
 
   BridgeHeader header;
@@ -162,18 +188,34 @@ bool UDPBridgeMultiReceiverComponent::MsgHandle(int fd) {
     return false;
   }
 
+  if (header_size + header.GetFrameSize() > static_cast<size_t>(bytes) ||
+      header.GetFramePos() + header.GetFrameSize() > proto_buf->GetBufSize() ||
+      header.GetIndex() >= header.GetTotalFrames()) {
+    AINFO << "frame is out of the msg!";
+    return false;
+  }
   cursor = total_buf + header_size;
   char *buf = proto_buf->GetBuf(header.GetFramePos());
   memcpy(buf, cursor, header.GetFrameSize());
   proto_buf->UpdateStatus(header.GetIndex());
   if (proto_buf->IsReadyDiserialize()) {
-    proto_buf->DiserializedAndPub();
+    if (proto_buf->DiserializedAndPub() && FLAGS_bridge_record_latency) {
+      latency_recorder_.Record(header.GetMsgName(), header.GetMsgID(),
+                               header.GetTimeStamp());
+    }
     RemoveInvalidBuf(proto_buf->GetMsgID(), proto_buf->GetMsgName());
     RemoveItem(&proto_list_, proto_buf);
+    ReleaseBuf(proto_buf);
   }
   return true;
 }
 
+void UDPBridgeMultiReceiverComponent::ReleaseBuf(
+    const std::shared_ptr<ProtoDiserializedBufBase> &proto_buf) {
+  proto_buf->Reset();
+  free_bufs_[proto_buf->GetMsgName()].push_back(proto_buf);
+}
+
 bool UDPBridgeMultiReceiverComponent::RemoveInvalidBuf(
     uint32_t msg_id, const std::string &msg_name) {
   if (msg_id == 0) {
@@ -184,6 +226,7 @@ bool UDPBridgeMultiReceiverComponent::RemoveInvalidBuf(
   for (; itor != proto_list_.end();) {
     if ((*itor)->GetMsgID() < msg_id &&
         strcmp((*itor)->GetMsgName().c_str(), msg_name.c_str()) == 0) {
+      ReleaseBuf(*itor);
       itor = proto_list_.erase(itor);
       continue;
     }
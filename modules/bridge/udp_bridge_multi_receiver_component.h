@@ -22,6 +22,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/bridge/proto/udp_bridge_remote_info.pb.h"
@@ -36,6 +37,7 @@
 #include "modules/bridge/common/bridge_header.h"
 #include "modules/bridge/common/bridge_proto_diserialized_buf.h"
 #include "modules/bridge/common/udp_listener.h"
+#include "modules/bridge/common/util.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 
 namespace apollo {
@@ -57,6 +59,8 @@ class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
 
  private:
   bool RemoveInvalidBuf(uint32_t msg_id, const std::string &msg_name);
+  bool HandleFrame(const char *total_buf, int bytes);
+  void ReleaseBuf(const std::shared_ptr<ProtoDiserializedBufBase> &proto_buf);
 
  private:
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
@@ -66,6 +70,12 @@ class UDPBridgeMultiReceiverComponent final : public cyber::Component<> {
   bool enable_timeout_ = true;
   std::mutex mutex_;
   std::vector<std::shared_ptr<ProtoDiserializedBufBase>> proto_list_;
+  // the buffers of finished msgs by msg name, handed to the next msgs with
+  // their writers.
+  std::unordered_map<std::string,
+                     std::vector<std::shared_ptr<ProtoDiserializedBufBase>>>
+      free_bufs_;
+  MsgLatencyRecorder latency_recorder_;
 };
 
 }  // namespace bridge
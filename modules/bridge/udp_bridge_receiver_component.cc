@@ -16,6 +16,8 @@
 
 #include "modules/bridge/udp_bridge_receiver_component.h"
 
+#include <algorithm>
+
 #include "cyber/time/clock.h"
 #include "modules/bridge/common/macro.h"
 #include "modules/bridge/common/util.h"
@@ -35,6 +37,9 @@ UDPBridgeReceiverComponent<T>::~UDPBridgeReceiverComponent() {
   for (auto proto : proto_list_) {
     FREE_POINTER(proto);
   }
+  for (auto proto : free_list_) {
+    FREE_POINTER(proto);
+  }
 }
 
 template <typename T>
@@ -82,8 +87,7 @@ BridgeProtoDiserializedBuf<T>
         proto_list_.begin();
     for (; itor != proto_list_.end();) {
       if ((*itor)->IsTheProto(header)) {
-        BridgeProtoDiserializedBuf<T> *tmp = *itor;
-        FREE_POINTER(tmp);
+        ReleaseBuf(*itor);
         itor = proto_list_.erase(itor);
         break;
       }
@@ -97,7 +101,13 @@ BridgeProtoDiserializedBuf<T>
       return proto;
     }
   }
-  BridgeProtoDiserializedBuf<T> *proto_buf = new BridgeProtoDiserializedBuf<T>;
+  BridgeProtoDiserializedBuf<T> *proto_buf = nullptr;
+  if (free_list_.empty()) {
+    proto_buf = new BridgeProtoDiserializedBuf<T>;
+  } else {
+    proto_buf = free_list_.back();
+    free_list_.pop_back();
+  }
   if (!proto_buf) {
     return nullptr;
   }
@@ -133,6 +143,12 @@ bool UDPBridgeReceiverComponent<T>::IsTimeout(double time_stamp) {
 
 template <typename T>
 bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
+  if (FLAGS_bridge_batched_io) {
+    RecvFrames(fd, [this](const char *buf, int bytes) {
+      HandleFrame(buf, bytes);
+    });
+    return true;
+  }
   struct sockaddr_in client_addr;
   socklen_t sock_len = static_cast<socklen_t>(sizeof(client_addr));
   int bytes = 0;
@@ -145,6 +161,15 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
   if (bytes <= 0 || bytes > total_recv) {
     return false;
   }
+  return HandleFrame(total_buf, bytes);
+}
+
+template <typename T>
+bool UDPBridgeReceiverComponent<T>::HandleFrame(const char *total_buf,
+                                                int bytes) {
+  if (bytes < static_cast<int>(HEADER_FLAG_SIZE + sizeof(hsize) + 2)) {
+    return false;
+  }
   char header_flag[sizeof(BRIDGE_HEADER_FLAG) + 1] = {0};
   size_t offset = 0;
   memcpy(header_flag, total_buf, HEADER_FLAG_SIZE);
@@ -162,6 +187,11 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
     AINFO << "header size is more than FRAME_SIZE!";
     return false;
   }
+  if (header_size > static_cast<hsize>(bytes) ||
+      header_size < offset + sizeof(hsize) + 1) {
+    AINFO << "header size does not match the frame!";
+    return false;
+  }
   offset += sizeof(hsize) + 1;
 
   BridgeHeader header;
@@ -183,20 +213,42 @@ bool UDPBridgeReceiverComponent<T>::MsgHandle(int fd) {
     return false;
   }
 
+  if (header_size + header.GetFrameSize() > static_cast<size_t>(bytes) ||
+      header.GetFramePos() + header.GetFrameSize() > proto_buf->GetBufSize() ||
+      header.GetIndex() >= header.GetTotalFrames()) {
+    AINFO << "frame is out of the msg!";
+    return false;
+  }
   cursor = total_buf + header_size;
   char *buf = proto_buf->GetBuf(header.GetFramePos());
   memcpy(buf, cursor, header.GetFrameSize());
   proto_buf->UpdateStatus(header.GetIndex());
   if (proto_buf->IsReadyDiserialize()) {
     auto pb_msg = std::make_shared<T>();
-    proto_buf->Diserialized(pb_msg);
-    writer_->Write(pb_msg);
+    if (proto_buf->Diserialized(pb_msg)) {
+      writer_->Write(pb_msg);
+      if (FLAGS_bridge_record_latency) {
+        latency_recorder_.Record(header.GetMsgName(), header.GetMsgID(),
+                                 header.GetTimeStamp());
+      }
+    }
     RemoveInvalidBuf(proto_buf->GetMsgID());
-    RemoveItem(&proto_list_, proto_buf);
+    auto itor = std::find(proto_list_.begin(), proto_list_.end(), proto_buf);
+    if (itor != proto_list_.end()) {
+      proto_list_.erase(itor);
+    }
+    ReleaseBuf(proto_buf);
   }
   return true;
 }
 
+template <typename T>
+void UDPBridgeReceiverComponent<T>::ReleaseBuf(
+    BridgeProtoDiserializedBuf<T> *proto_buf) {
+  proto_buf->Reset();
+  free_list_.push_back(proto_buf);
+}
+
 template <typename T>
 bool UDPBridgeReceiverComponent<T>::RemoveInvalidBuf(uint32_t msg_id) {
   if (msg_id == 0) {
@@ -206,8 +258,7 @@ bool UDPBridgeReceiverComponent<T>::RemoveInvalidBuf(uint32_t msg_id) {
       proto_list_.begin();
   for (; itor != proto_list_.end();) {
     if ((*itor)->GetMsgID() < msg_id) {
-      BridgeProtoDiserializedBuf<T> *tmp = *itor;
-      FREE_POINTER(tmp);
+      ReleaseBuf(*itor);
       itor = proto_list_.erase(itor);
       continue;
     }
@@ -36,6 +36,7 @@
 #include "modules/bridge/common/bridge_header.h"
 #include "modules/bridge/common/bridge_proto_diserialized_buf.h"
 #include "modules/bridge/common/udp_listener.h"
+#include "modules/bridge/common/util.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 
 namespace apollo {
@@ -56,6 +57,8 @@ class UDPBridgeReceiverComponent final : public cyber::Component<> {
   bool MsgHandle(int fd);
 
  private:
+  bool HandleFrame(const char *total_buf, int bytes);
+  void ReleaseBuf(BridgeProtoDiserializedBuf<T> *proto_buf);
   bool InitSession(uint16_t port);
   void MsgDispatcher();
   bool IsProtoExist(const BridgeHeader &header);
@@ -77,6 +80,9 @@ class UDPBridgeReceiverComponent final : public cyber::Component<> {
       std::make_shared<UDPListener<UDPBridgeReceiverComponent<T>>>();
 
   std::vector<BridgeProtoDiserializedBuf<T> *> proto_list_;
+  // the buffers of finished msgs, handed to the next msgs.
+  std::vector<BridgeProtoDiserializedBuf<T> *> free_list_;
+  MsgLatencyRecorder latency_recorder_;
 };
 
 RECEIVER_BRIDGE_COMPONENT_REGISTER(canbus::Chassis)
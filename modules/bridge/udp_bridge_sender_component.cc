@@ -16,7 +16,6 @@
 
 #include "modules/bridge/udp_bridge_sender_component.h"
 
-#include "modules/bridge/common/bridge_proto_serialized_buf.h"
 #include "modules/bridge/common/macro.h"
 #include "modules/bridge/common/util.h"
 
@@ -29,6 +28,13 @@ using apollo::bridge::UDPBridgeSenderRemoteInfo;
 using apollo::cyber::io::Session;
 using apollo::localization::LocalizationEstimate;
 
+template <typename T>
+UDPBridgeSenderComponent<T>::~UDPBridgeSenderComponent() {
+  if (sock_fd_ >= 0) {
+    close(sock_fd_);
+  }
+}
+
 template <typename T>
 bool UDPBridgeSenderComponent<T>::Init() {
   AINFO << "UDP bridge sender init, startin...";
@@ -58,6 +64,10 @@ bool UDPBridgeSenderComponent<T>::Proc(const std::shared_ptr<T> &pb_msg) {
     return false;
   }
 
+  if (FLAGS_bridge_batched_io || FLAGS_bridge_lz4_compression) {
+    return SendBatched(pb_msg);
+  }
+
   struct sockaddr_in server_addr;
   server_addr.sin_addr.s_addr = inet_addr(remote_ip_.c_str());
   server_addr.sin_family = AF_INET;
@@ -85,6 +95,63 @@ bool UDPBridgeSenderComponent<T>::Proc(const std::shared_ptr<T> &pb_msg) {
   return true;
 }
 
+template <typename T>
+bool UDPBridgeSenderComponent<T>::Connect() {
+  struct sockaddr_in server_addr;
+  server_addr.sin_addr.s_addr = inet_addr(remote_ip_.c_str());
+  server_addr.sin_family = AF_INET;
+  server_addr.sin_port = htons(static_cast<uint16_t>(remote_port_));
+  sock_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+  if (sock_fd_ < 0) {
+    AERROR << "create socket failed: " << strerror(errno);
+    return false;
+  }
+  if (connect(sock_fd_, (struct sockaddr *)&server_addr,
+              sizeof(server_addr)) < 0) {
+    AERROR << "connect to " << remote_ip_ << ":" << remote_port_
+           << " failed: " << strerror(errno);
+    close(sock_fd_);
+    sock_fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool UDPBridgeSenderComponent<T>::SendBatched(
+    const std::shared_ptr<T> &pb_msg) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (sock_fd_ < 0 && !Connect()) {
+    return false;
+  }
+  if (!proto_buf_.SerializeFrames(pb_msg, proto_name_,
+                                  FLAGS_bridge_lz4_compression)) {
+    AERROR << "serialize " << proto_name_ << " failed.";
+    return false;
+  }
+
+  const size_t frame_count = proto_buf_.GetFrameCount();
+  msgs_.resize(frame_count);
+  for (size_t i = 0; i < frame_count; ++i) {
+    memset(&msgs_[i], 0, sizeof(msgs_[i]));
+    msgs_[i].msg_hdr.msg_iov = proto_buf_.GetFrameIov(i);
+    msgs_[i].msg_hdr.msg_iovlen = 2;
+  }
+  // the socket is blocking, sendmmsg only returns short when a frame fails.
+  size_t sent = 0;
+  while (sent < frame_count) {
+    int count = sendmmsg(sock_fd_, &msgs_[sent],
+                         static_cast<unsigned int>(frame_count - sent), 0);
+    if (count <= 0) {
+      AERROR << "send " << proto_name_ << " failed at frame " << sent << ": "
+             << strerror(errno);
+      return false;
+    }
+    sent += count;
+  }
+  return true;
+}
+
 BRIDGE_IMPL(LocalizationEstimate);
 BRIDGE_IMPL(planning::ADCTrajectory);
 
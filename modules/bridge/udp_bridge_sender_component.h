@@ -35,6 +35,7 @@
 #include "cyber/io/session.h"
 #include "cyber/scheduler/scheduler_factory.h"
 #include "modules/bridge/common/bridge_gflags.h"
+#include "modules/bridge/common/bridge_proto_serialized_buf.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/util/util.h"
 
@@ -49,6 +50,7 @@ class UDPBridgeSenderComponent final : public cyber::Component<T> {
  public:
   UDPBridgeSenderComponent()
       : monitor_logger_buffer_(common::monitor::MonitorMessageItem::CONTROL) {}
+  ~UDPBridgeSenderComponent();
 
   bool Init() override;
   bool Proc(const std::shared_ptr<T> &pb_msg) override;
@@ -56,11 +58,19 @@ class UDPBridgeSenderComponent final : public cyber::Component<T> {
   std::string Name() const { return FLAGS_bridge_module_name; }
 
  private:
+  bool SendBatched(const std::shared_ptr<T> &pb_msg);
+  bool Connect();
+
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
   unsigned int remote_port_ = 0;
   std::string remote_ip_ = "";
   std::string proto_name_ = "";
   std::mutex mutex_;
+
+  // kept from msg to msg by the batched sender.
+  int sock_fd_ = -1;
+  BridgeProtoSerializedBuf<T> proto_buf_;
+  std::vector<struct mmsghdr> msgs_;
 };
 
 BRIDGE_COMPONENT_REGISTER(planning::ADCTrajectory)
@@ -17,14 +17,14 @@
 #include "modules/canbus/vehicle/devkit/protocol/steering_report_502.h"
 
 #include "glog/logging.h"
-#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/can_signal.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace devkit {
 
-using ::apollo::drivers::canbus::Byte;
+using ::apollo::drivers::canbus::CanSignal;
 
 Steeringreport502::Steeringreport502() {}
 const int32_t Steeringreport502::ID = 0x502;
@@ -53,10 +53,7 @@ void Steeringreport502::Parse(const std::uint8_t* bytes, int32_t length,
 // 'deg/s'}
 int Steeringreport502::steer_angle_spd_actual(const std::uint8_t* bytes,
                                               int32_t length) const {
-  Byte t0(bytes + 6);
-  int32_t x = t0.get_byte(0, 8);
-
-  int ret = x;
+  int ret = static_cast<int>(CanSignal<55, 8>::Raw(bytes));
   return ret;
 }
 
@@ -67,8 +64,7 @@ int Steeringreport502::steer_angle_spd_actual(const std::uint8_t* bytes,
 // 'motorola', 'physical_unit': ''}
 Steering_report_502::Steer_flt2Type Steeringreport502::steer_flt2(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 2);
-  int32_t x = t0.get_byte(0, 8);
+  const int64_t x = CanSignal<23, 8>::Raw(bytes);
 
   Steering_report_502::Steer_flt2Type ret =
       static_cast<Steering_report_502::Steer_flt2Type>(x);
@@ -82,8 +78,7 @@ Steering_report_502::Steer_flt2Type Steeringreport502::steer_flt2(
 // 'motorola', 'physical_unit': ''}
 Steering_report_502::Steer_flt1Type Steeringreport502::steer_flt1(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 1);
-  int32_t x = t0.get_byte(0, 8);
+  const int64_t x = CanSignal<15, 8>::Raw(bytes);
 
   Steering_report_502::Steer_flt1Type ret =
       static_cast<Steering_report_502::Steer_flt1Type>(x);
@@ -97,8 +92,7 @@ Steering_report_502::Steer_flt1Type Steeringreport502::steer_flt1(
 // 'bit': 1, 'type': 'enum', 'order': 'motorola', 'physical_unit': ''}
 Steering_report_502::Steer_en_stateType Steeringreport502::steer_en_state(
     const std::uint8_t* bytes, int32_t length) const {
-  Byte t0(bytes + 0);
-  int32_t x = t0.get_byte(0, 2);
+  const int64_t x = CanSignal<1, 2>::Raw(bytes);
 
   Steering_report_502::Steer_en_stateType ret =
       static_cast<Steering_report_502::Steer_en_stateType>(x);
@@ -110,15 +104,7 @@ Steering_report_502::Steer_en_stateType Steeringreport502::steer_en_state(
 // 'bit': 31, 'type': 'double', 'order': 'motorola', 'physical_unit': 'deg'}
 double Steeringreport502::steer_angle_actual(const std::uint8_t* bytes,
                                              int32_t length) const {
-  Byte t0(bytes + 3);
-  int32_t x = t0.get_byte(0, 8);
-
-  Byte t1(bytes + 4);
-  int32_t t = t1.get_byte(0, 8);
-  x <<= 8;
-  x |= t;
-
-  double ret = x * 0.100000 + -500.000000;
+  double ret = CanSignal<31, 16>::Physical(bytes, 0.100000, -500.000000);
   return ret;
 }
 }  // namespace devkit
@@ -130,3 +130,5 @@ DECLARE_string(recorder_status_topic);
 DECLARE_string(latency_recording_topic);
 // Latency reporting topic
 DECLARE_string(latency_reporting_topic);
+// Latency histogram topic
+DECLARE_string(latency_histogram_topic);
@@ -33,6 +33,13 @@ DEFINE_string(end_way_point_filename, "default_end_way_point.txt",
               "End way point of the map, will be sent in RoutingRequest.");
 DEFINE_string(speed_control_filename, "speed_control.pb.txt",
               "The speed control region in a map.");
+DEFINE_int32(map_loading_threads, 1,
+             "Number of threads building the lookup tables and indices of a "
+             "loaded map, 1 to build them on the loading thread.");
+DEFINE_double(lane_lookup_table_resolution, 0.0,
+              "Spacing in meters of the heading, curvature and width tables "
+              "resampled along each lane at map loading, non-positive to "
+              "look them up from the lane points instead.");
 
 DEFINE_string(vehicle_config_path,
               "/apollo/modules/common/data/vehicle_param.pb.txt",
@@ -77,3 +84,12 @@ DEFINE_bool(state_transform_to_com_drive, true,
             "rear-axis to center of mass, during forward driving");
 DEFINE_bool(multithread_run, false,
             "multi-thread run flag mainly used by simulation");
+
+DEFINE_string(profiler_modules, "",
+              "comma separated modules whose PROFILE_ZONEs are recorded, "
+              "e.g. perception,planning, or all");
+DEFINE_string(profiler_trace_file, "/tmp/apollo_profile",
+              "Chrome trace the profiled zones are appended to, the process "
+              "id and .json are appended to the name");
+DEFINE_int32(profiler_flush_interval_ms, 1000,
+             "period of moving the profiled zones to the trace file");
@@ -29,6 +29,8 @@ DECLARE_string(sim_map_filename);
 DECLARE_string(routing_map_filename);
 DECLARE_string(end_way_point_filename);
 DECLARE_string(speed_control_filename);
+DECLARE_int32(map_loading_threads);
+DECLARE_double(lane_lookup_table_resolution);
 
 DECLARE_double(look_forward_time_sec);
 
@@ -51,3 +53,7 @@ DECLARE_bool(reverse_heading_vehicle_state);
 DECLARE_bool(state_transform_to_com_reverse);
 DECLARE_bool(state_transform_to_com_drive);
 DECLARE_bool(multithread_run);
+
+DECLARE_string(profiler_modules);
+DECLARE_string(profiler_trace_file);
+DECLARE_int32(profiler_flush_interval_ms);
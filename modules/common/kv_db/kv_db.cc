@@ -17,6 +17,12 @@
 
 #include <sqlite3.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 #include "gflags/gflags.h"
 
 #include "absl/strings/str_cat.h"
@@ -25,22 +31,86 @@
 
 DEFINE_string(kv_db_path, "/apollo/data/kv_db.sqlite",
               "Path to Key-value DB file.");
+DEFINE_bool(kv_db_async_write, false,
+            "Whether Put and Delete return at once and are committed by a "
+            "background thread in batches. Values read or written by this "
+            "process are then cached, so writes of other processes to the "
+            "same keys are not seen.");
+DEFINE_int32(kv_db_flush_interval_ms, 100,
+             "Max delay of the async writes before they are committed.");
 
 namespace apollo {
 namespace common {
 namespace {
 
-// Self-maintained sqlite instance.
+// Self-maintained sqlite instance, one connection with prepared statements
+// for the whole process.
 class SqliteWraper {
  public:
-  static int Callback(void *data, int argc, char **argv, char **col_name) {
-    if (data != nullptr) {
-      std::string *data_str = static_cast<std::string *>(data);
-      *data_str = argc > 0 ? argv[0] : "";
+  static SqliteWraper *Instance() {
+    // destroyed at exit, which commits the queued writes
+    static SqliteWraper sqlite;
+    return &sqlite;
+  }
+
+  ~SqliteWraper() {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      stop_writer_ = true;
+    }
+    queue_cv_.notify_all();
+    if (writer_.joinable()) {
+      writer_.join();
     }
-    return 0;
+    Commit();
+    Release();
   }
 
+  bool Put(std::string_view key, std::string_view value) {
+    if (FLAGS_kv_db_async_write) {
+      Enqueue(std::string(key), std::string(value));
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    return Write(key, std::string(value));
+  }
+
+  bool Delete(std::string_view key) {
+    if (FLAGS_kv_db_async_write) {
+      Enqueue(std::string(key), {});
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    return Write(key, {});
+  }
+
+  std::optional<std::string> Get(std::string_view key) {
+    if (FLAGS_kv_db_async_write) {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      auto it = cache_.find(std::string(key));
+      if (it != cache_.end()) {
+        return it->second;
+      }
+    }
+    std::optional<std::string> value;
+    {
+      std::lock_guard<std::mutex> lock(db_mutex_);
+      if (!Read(key, &value)) {
+        return {};
+      }
+    }
+    if (FLAGS_kv_db_async_write) {
+      // a write queued meanwhile is newer than what was read
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      auto it = cache_.emplace(std::string(key), value).first;
+      return it->second;
+    }
+    return value;
+  }
+
+  bool Flush() { return Commit(); }
+
+ private:
   SqliteWraper() {
     // Open DB.
     if (sqlite3_open(FLAGS_kv_db_path.c_str(), &db_) != 0) {
@@ -48,27 +118,37 @@ class SqliteWraper {
       Release();
       return;
     }
+    // other processes share the file, wait for their writes instead of
+    // failing
+    sqlite3_busy_timeout(db_, 1000);
 
-    // Create table if it doesn't exist.
-    static const char *kCreateTableSql =
+    // Create table if it doesn't exist. The write ahead log lets readers
+    // run alongside a writer and a commit only syncs at checkpoints.
+    static const char *kInitSql =
+        "PRAGMA journal_mode=WAL;"
+        "PRAGMA synchronous=NORMAL;"
         "CREATE TABLE IF NOT EXISTS key_value "
         "(key VARCHAR(128) PRIMARY KEY NOT NULL, value TEXT);";
-    if (!SQL(kCreateTableSql)) {
+    if (!SQL(kInitSql) ||
+        !Prepare("INSERT OR REPLACE INTO key_value (key, value) "
+                 "VALUES (?, ?);",
+                 &put_stmt_) ||
+        !Prepare("DELETE FROM key_value WHERE key=?;", &delete_stmt_) ||
+        !Prepare("SELECT value FROM key_value WHERE key=?;", &get_stmt_)) {
       Release();
     }
   }
 
-  ~SqliteWraper() { Release(); }
-
-  bool SQL(std::string_view sql, std::string *value = nullptr) {
-    AINFO << "Executing SQL: " << sql;
+  bool SQL(std::string_view sql) {
+    ADEBUG << "Executing SQL: " << sql;
     if (db_ == nullptr) {
       AERROR << "DB is not open properly.";
       return false;
     }
 
     char *error = nullptr;
-    if (sqlite3_exec(db_, sql.data(), Callback, value, &error) != SQLITE_OK) {
+    if (sqlite3_exec(db_, sql.data(), nullptr, nullptr, &error) !=
+        SQLITE_OK) {
       AERROR << "Failed to execute SQL: " << error;
       sqlite3_free(error);
       return false;
@@ -76,43 +156,152 @@ class SqliteWraper {
     return true;
   }
 
- private:
+  bool Prepare(const char *sql, sqlite3_stmt **stmt) {
+    if (sqlite3_prepare_v2(db_, sql, -1, stmt, nullptr) != SQLITE_OK) {
+      AERROR << "Failed to prepare SQL " << sql << ": " << sqlite3_errmsg(db_);
+      return false;
+    }
+    return true;
+  }
+
+  // Puts value, or deletes key if there is no value, with db_mutex_ held.
+  bool Write(std::string_view key, const std::optional<std::string> &value) {
+    if (db_ == nullptr) {
+      AERROR << "DB is not open properly.";
+      return false;
+    }
+    sqlite3_stmt *stmt = value.has_value() ? put_stmt_ : delete_stmt_;
+    sqlite3_bind_text(stmt, 1, key.data(), static_cast<int>(key.size()),
+                      SQLITE_TRANSIENT);
+    if (value.has_value()) {
+      sqlite3_bind_text(stmt, 2, value->data(),
+                        static_cast<int>(value->size()), SQLITE_TRANSIENT);
+    }
+    const bool ret = sqlite3_step(stmt) == SQLITE_DONE;
+    if (!ret) {
+      AERROR << "Failed to write key " << key << ": " << sqlite3_errmsg(db_);
+    }
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return ret;
+  }
+
+  // Reads the value of key, with db_mutex_ held.
+  bool Read(std::string_view key, std::optional<std::string> *value) {
+    if (db_ == nullptr) {
+      AERROR << "DB is not open properly.";
+      return false;
+    }
+    sqlite3_bind_text(get_stmt_, 1, key.data(), static_cast<int>(key.size()),
+                      SQLITE_TRANSIENT);
+    const int step = sqlite3_step(get_stmt_);
+    if (step == SQLITE_ROW) {
+      const auto *text = sqlite3_column_text(get_stmt_, 0);
+      if (text != nullptr) {
+        value->emplace(reinterpret_cast<const char *>(text),
+                       sqlite3_column_bytes(get_stmt_, 0));
+      }
+    } else if (step != SQLITE_DONE) {
+      AERROR << "Failed to read key " << key << ": " << sqlite3_errmsg(db_);
+    }
+    sqlite3_reset(get_stmt_);
+    sqlite3_clear_bindings(get_stmt_);
+    return step == SQLITE_ROW || step == SQLITE_DONE;
+  }
+
+  void Enqueue(std::string &&key, std::optional<std::string> &&value) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    cache_[key] = value;
+    // later writes of the same key replace the queued one
+    queue_[std::move(key)] = std::move(value);
+    if (!writer_.joinable() && !stop_writer_) {
+      writer_ = std::thread(&SqliteWraper::WriterThread, this);
+    }
+  }
+
+  void WriterThread() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    while (!stop_writer_) {
+      queue_cv_.wait_for(
+          lock, std::chrono::milliseconds(FLAGS_kv_db_flush_interval_ms));
+      lock.unlock();
+      Commit();
+      lock.lock();
+    }
+  }
+
+  // Commits the queued writes in one transaction.
+  bool Commit() {
+    std::lock_guard<std::mutex> commit_lock(commit_mutex_);
+    std::unordered_map<std::string, std::optional<std::string>> queue;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      queue.swap(queue_);
+    }
+    if (queue.empty()) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    if (!SQL("BEGIN TRANSACTION;")) {
+      return false;
+    }
+    bool ret = true;
+    for (const auto &write : queue) {
+      ret = Write(write.first, write.second) && ret;
+    }
+    return SQL("COMMIT;") && ret;
+  }
+
   void Release() {
+    for (auto *stmt : {put_stmt_, delete_stmt_, get_stmt_}) {
+      sqlite3_finalize(stmt);
+    }
+    put_stmt_ = delete_stmt_ = get_stmt_ = nullptr;
     if (db_ != nullptr) {
       sqlite3_close(db_);
       db_ = nullptr;
     }
   }
 
+  // the connection and its statements
+  std::mutex db_mutex_;
   sqlite3 *db_ = nullptr;
+  sqlite3_stmt *put_stmt_ = nullptr;
+  sqlite3_stmt *delete_stmt_ = nullptr;
+  sqlite3_stmt *get_stmt_ = nullptr;
+
+  // the writes not committed yet and the values known to this process, a
+  // deleted key has no value
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::unordered_map<std::string, std::optional<std::string>> queue_;
+  std::unordered_map<std::string, std::optional<std::string>> cache_;
+  std::thread writer_;
+  bool stop_writer_ = false;
+
+  // keeps the commits in order
+  std::mutex commit_mutex_;
 };
 
 }  // namespace
 
 bool KVDB::Put(std::string_view key, std::string_view value) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(
-      absl::StrCat("INSERT OR REPLACE INTO key_value (key, value) VALUES ('",
-                   key, "', '", value, "');"));
+  return SqliteWraper::Instance()->Put(key, value);
 }
 
 bool KVDB::Delete(std::string_view key) {
-  SqliteWraper sqlite;
-  return sqlite.SQL(
-      absl::StrCat("DELETE FROM key_value WHERE key='", key, "';"));
+  return SqliteWraper::Instance()->Delete(key);
 }
 
 std::optional<std::string> KVDB::Get(std::string_view key) {
-  SqliteWraper sqlite;
-  std::string value;
-  const bool ret = sqlite.SQL(
-      absl::StrCat("SELECT value FROM key_value WHERE key='", key, "';"),
-      &value);
-  if (ret && !value.empty()) {
+  auto value = SqliteWraper::Instance()->Get(key);
+  if (value.has_value() && !value->empty()) {
     return value;
   }
   return {};
 }
 
+bool KVDB::Flush() { return SqliteWraper::Instance()->Flush(); }
+
 }  // namespace common
 }  // namespace apollo
@@ -55,6 +55,14 @@ class KVDB {
    *     Use `value_or("")` to get existing value or fallback to default.
    */
   static std::optional<std::string> Get(std::string_view key);
+
+  /**
+   * @brief Commit the writes queued with --kv_db_async_write, blocking until
+   *        they are on disk. They are also committed periodically and at
+   *        exit.
+   * @return Success or not.
+   */
+  static bool Flush();
 };
 
 }  // namespace common
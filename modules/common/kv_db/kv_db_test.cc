@@ -17,8 +17,12 @@
 
 #include <thread>
 
+#include "gflags/gflags.h"
 #include "gtest/gtest.h"
 
+DECLARE_bool(kv_db_async_write);
+DECLARE_int32(kv_db_flush_interval_ms);
+
 namespace apollo {
 namespace common {
 
@@ -56,5 +60,25 @@ TEST(KVDBTest, MultiThreads) {
   }
 }
 
+TEST(KVDBTest, AsyncWrite) {
+  FLAGS_kv_db_async_write = true;
+  EXPECT_TRUE(KVDB::Put("test_async_key", "val0"));
+  EXPECT_TRUE(KVDB::Put("test_async_key", "val1"));
+  // served from the cache before the commit
+  EXPECT_EQ("val1", KVDB::Get("test_async_key").value());
+  EXPECT_TRUE(KVDB::Flush());
+
+  EXPECT_TRUE(KVDB::Delete("test_async_key"));
+  EXPECT_FALSE(KVDB::Get("test_async_key").has_value());
+  EXPECT_TRUE(KVDB::Put("test_async_key", "val2"));
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(3 * FLAGS_kv_db_flush_interval_ms));
+
+  // committed by the writer thread
+  FLAGS_kv_db_async_write = false;
+  EXPECT_EQ("val2", KVDB::Get("test_async_key").value());
+  EXPECT_TRUE(KVDB::Delete("test_async_key"));
+}
+
 }  // namespace common
 }  // namespace apollo
@@ -16,15 +16,79 @@
 
 #include "modules/common/latency_recorder/latency_recorder.h"
 
+#include <algorithm>
+
+#include "cyber/base/latency_histogram.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/util/message_util.h"
 
+DEFINE_bool(latency_recorder_histogram, false,
+            "Whether to publish the latencies as histograms per module "
+            "instead of one record per message.");
+DEFINE_double(latency_recorder_flush_interval, 3.0,
+              "Seconds between two publishes of the latency histograms.");
+
 using apollo::cyber::Clock;
 using apollo::cyber::Time;
+using apollo::cyber::base::LatencyHistogram;
 
 namespace apollo {
 namespace common {
 
+namespace {
+
+// A message id is taken as a sensor timestamp when it is at most this long
+// before the end time.
+constexpr uint64_t kMaxE2ELatencyNs = 60ULL * 1000000000ULL;
+
+void FillHistogram(const std::vector<const LatencyHistogram*>& histograms,
+                   apollo::cyber::proto::LatencyHistogram* msg) {
+  uint64_t buckets[LatencyHistogram::kBucketNum] = {};
+  uint64_t count = 0, sum = 0, max = 0;
+  for (const auto* histogram : histograms) {
+    for (uint32_t i = 0; i < LatencyHistogram::kBucketNum; ++i) {
+      buckets[i] += histogram->Bucket(i);
+    }
+    count += histogram->Count();
+    sum += histogram->Sum();
+    max = std::max(max, histogram->Max());
+  }
+  msg->set_count(count);
+  msg->set_sum_ns(sum);
+  msg->set_max_ns(max);
+
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < LatencyHistogram::kBucketNum; ++i) {
+    total += buckets[i];
+    msg->add_bucket(buckets[i]);
+  }
+  // Upper bound in us of the bucket the fraction of samples fall in.
+  const auto percentile = [&buckets, total](double fraction) -> uint64_t {
+    const auto rank = static_cast<uint64_t>(fraction * total);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LatencyHistogram::kBucketNum; ++i) {
+      seen += buckets[i];
+      if (seen > rank) {
+        return 1ULL << i;
+      }
+    }
+    return 1ULL << (LatencyHistogram::kBucketNum - 1);
+  };
+  if (total > 0) {
+    msg->set_p50_us(percentile(0.5));
+    msg->set_p99_us(percentile(0.99));
+  }
+}
+
+}  // namespace
+
+struct LatencyRecorder::ThreadHistograms {
+  LatencyHistogram module_latency;
+  LatencyHistogram e2e_latency;
+};
+
+std::atomic<uint64_t> LatencyRecorder::next_id_ = {1};
+
 LatencyRecorder::LatencyRecorder(const std::string& module_name)
     : module_name_(module_name) {
   records_.reset(new LatencyRecordMap);
@@ -52,6 +116,11 @@ void LatencyRecorder::AppendLatencyRecord(const uint64_t message_id,
     return;
   }
 
+  if (FLAGS_latency_recorder_histogram) {
+    RecordHistogram(message_id, begin_time, end_time);
+    return;
+  }
+
   static auto writer = CreateWriter();
   if (writer == nullptr || message_id == 0) {
     return;
@@ -72,12 +141,87 @@ void LatencyRecorder::AppendLatencyRecord(const uint64_t message_id,
   }
 }
 
-std::shared_ptr<apollo::cyber::Writer<LatencyRecordMap>>
-LatencyRecorder::CreateWriter() {
+void LatencyRecorder::RecordHistogram(const uint64_t message_id,
+                                      const Time& begin_time,
+                                      const Time& end_time) {
+  auto* histograms = GetThreadHistograms();
+  const uint64_t end_ns = end_time.ToNanosecond();
+  histograms->module_latency.Record(end_ns - begin_time.ToNanosecond());
+  if (message_id != 0 && message_id <= end_ns &&
+      end_ns - message_id < kMaxE2ELatencyNs) {
+    histograms->e2e_latency.Record(end_ns - message_id);
+  }
+
+  // Whichever thread is first past the interval publishes.
+  const uint64_t now_ns = Clock::Now().ToNanosecond();
+  uint64_t next_flush_ns = next_flush_ns_.load(std::memory_order_relaxed);
+  if (now_ns >= next_flush_ns &&
+      next_flush_ns_.compare_exchange_strong(
+          next_flush_ns,
+          now_ns + static_cast<uint64_t>(FLAGS_latency_recorder_flush_interval *
+                                         1e9))) {
+    PublishHistograms(now_ns);
+  }
+}
+
+LatencyRecorder::ThreadHistograms* LatencyRecorder::GetThreadHistograms() {
+  // Most threads only ever record into one recorder.
+  thread_local uint64_t cached_id = 0;
+  thread_local ThreadHistograms* cached_histograms = nullptr;
+  if (cached_id == id_) {
+    return cached_histograms;
+  }
+
+  thread_local std::unordered_map<uint64_t, std::shared_ptr<ThreadHistograms>>
+      local_histograms;
+  auto& histograms = local_histograms[id_];
+  if (histograms == nullptr) {
+    histograms = std::make_shared<ThreadHistograms>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_histograms_.push_back(histograms);
+    if (next_flush_ns_.load() == 0) {
+      next_flush_ns_ =
+          Clock::Now().ToNanosecond() +
+          static_cast<uint64_t>(FLAGS_latency_recorder_flush_interval * 1e9);
+    }
+  }
+  cached_id = id_;
+  cached_histograms = histograms.get();
+  return cached_histograms;
+}
+
+void LatencyRecorder::PublishHistograms(const uint64_t now_ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (histogram_writer_ == nullptr) {
+    if (!InitNode()) {
+      return;
+    }
+    histogram_writer_ = node_->CreateWriter<LatencyHistogramMap>(
+        FLAGS_latency_histogram_topic);
+    if (histogram_writer_ == nullptr) {
+      return;
+    }
+  }
+
+  std::vector<const LatencyHistogram*> module_latencies;
+  std::vector<const LatencyHistogram*> e2e_latencies;
+  for (const auto& histograms : thread_histograms_) {
+    module_latencies.push_back(&histograms->module_latency);
+    e2e_latencies.push_back(&histograms->e2e_latency);
+  }
+  histograms_.Clear();
+  histograms_.set_module_name(module_name_);
+  FillHistogram(module_latencies, histograms_.mutable_module_latency());
+  FillHistogram(e2e_latencies, histograms_.mutable_e2e_latency());
+  apollo::common::util::FillHeader("LatencyHistogramMap", &histograms_);
+  histogram_writer_->Write(histograms_);
+}
+
+bool LatencyRecorder::InitNode() {
   const std::string node_name_prefix = "latency_recorder";
   if (module_name_.empty()) {
     AERROR << "missing module name for sending latency records";
-    return nullptr;
+    return false;
   }
   if (node_ == nullptr) {
     current_time_ = Clock::Now();
@@ -86,9 +230,17 @@ LatencyRecorder::CreateWriter() {
         node_name_prefix, module_name_, current_time_.ToNanosecond()));
     if (node_ == nullptr) {
       AERROR << "unable to create node for latency recording";
-      return nullptr;
+      return false;
     }
   }
+  return true;
+}
+
+std::shared_ptr<apollo::cyber::Writer<LatencyRecordMap>>
+LatencyRecorder::CreateWriter() {
+  if (!InitNode()) {
+    return nullptr;
+  }
   return node_->CreateWriter<LatencyRecordMap>(FLAGS_latency_recording_topic);
 }
 
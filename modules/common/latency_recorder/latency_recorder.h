@@ -16,14 +16,22 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "cyber/cyber.h"
+#include "gflags/gflags.h"
 
+#include "modules/common/latency_recorder/proto/latency_histogram.pb.h"
 #include "modules/common/latency_recorder/proto/latency_record.pb.h"
 
+DECLARE_bool(latency_recorder_histogram);
+DECLARE_double(latency_recorder_flush_interval);
+
 namespace apollo {
 namespace common {
 
@@ -36,16 +44,36 @@ class LatencyRecorder {
                            const apollo::cyber::Time& end_time);
 
  private:
+  // Histograms of the records of one thread, only that thread records into
+  // them so recording takes no lock.
+  struct ThreadHistograms;
+
   LatencyRecorder() = default;
   std::shared_ptr<apollo::cyber::Writer<LatencyRecordMap>> CreateWriter();
   void PublishLatencyRecords(
       const std::shared_ptr<apollo::cyber::Writer<LatencyRecordMap>>& writer);
 
+  void RecordHistogram(const uint64_t message_id,
+                       const apollo::cyber::Time& begin_time,
+                       const apollo::cyber::Time& end_time);
+  ThreadHistograms* GetThreadHistograms();
+  void PublishHistograms(const uint64_t now_ns);
+  bool InitNode();
+
   std::string module_name_;
   std::mutex mutex_;
   std::unique_ptr<LatencyRecordMap> records_;
   apollo::cyber::Time current_time_;
   std::shared_ptr<apollo::cyber::Node> node_;
+
+  // Keys the thread local histograms, an address may be reused.
+  const uint64_t id_ = next_id_.fetch_add(1);
+  static std::atomic<uint64_t> next_id_;
+  std::vector<std::shared_ptr<ThreadHistograms>> thread_histograms_;
+  std::atomic<uint64_t> next_flush_ns_ = {0};
+  std::shared_ptr<apollo::cyber::Writer<LatencyHistogramMap>>
+      histogram_writer_;
+  LatencyHistogramMap histograms_;
 };
 
 }  // namespace common
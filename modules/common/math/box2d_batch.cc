@@ -0,0 +1,328 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/box2d_batch.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace apollo {
+namespace common {
+namespace math {
+
+Box2dBatch::Box2dBatch(const std::vector<Box2d> &boxes) {
+  Reserve(boxes.size());
+  for (const auto &box : boxes) {
+    Add(box);
+  }
+}
+
+void Box2dBatch::Add(const Box2d &box) {
+  center_x_.push_back(box.center_x());
+  center_y_.push_back(box.center_y());
+  cos_heading_.push_back(box.cos_heading());
+  sin_heading_.push_back(box.sin_heading());
+  half_length_.push_back(box.half_length());
+  half_width_.push_back(box.half_width());
+  dx_length_.push_back(box.cos_heading() * box.half_length());
+  dy_length_.push_back(box.sin_heading() * box.half_length());
+  dx_width_.push_back(box.sin_heading() * box.half_width());
+  dy_width_.push_back(-box.cos_heading() * box.half_width());
+  min_x_.push_back(box.min_x());
+  max_x_.push_back(box.max_x());
+  min_y_.push_back(box.min_y());
+  max_y_.push_back(box.max_y());
+}
+
+void Box2dBatch::Clear() {
+  center_x_.clear();
+  center_y_.clear();
+  cos_heading_.clear();
+  sin_heading_.clear();
+  half_length_.clear();
+  half_width_.clear();
+  dx_length_.clear();
+  dy_length_.clear();
+  dx_width_.clear();
+  dy_width_.clear();
+  min_x_.clear();
+  max_x_.clear();
+  min_y_.clear();
+  max_y_.clear();
+}
+
+void Box2dBatch::Reserve(const size_t size) {
+  center_x_.reserve(size);
+  center_y_.reserve(size);
+  cos_heading_.reserve(size);
+  sin_heading_.reserve(size);
+  half_length_.reserve(size);
+  half_width_.reserve(size);
+  dx_length_.reserve(size);
+  dy_length_.reserve(size);
+  dx_width_.reserve(size);
+  dy_width_.reserve(size);
+  min_x_.reserve(size);
+  max_x_.reserve(size);
+  min_y_.reserve(size);
+  max_y_.reserve(size);
+}
+
+bool Box2dBatch::HasOverlapAt(const Box2d &box, const size_t i) const {
+  if (max_x_[i] < box.min_x() || min_x_[i] > box.max_x() ||
+      max_y_[i] < box.min_y() || min_y_[i] > box.max_y()) {
+    return false;
+  }
+
+  const double shift_x = center_x_[i] - box.center_x();
+  const double shift_y = center_y_[i] - box.center_y();
+
+  const double cos_heading = box.cos_heading();
+  const double sin_heading = box.sin_heading();
+  const double dx1 = cos_heading * box.half_length();
+  const double dy1 = sin_heading * box.half_length();
+  const double dx2 = sin_heading * box.half_width();
+  const double dy2 = -cos_heading * box.half_width();
+
+  return std::abs(shift_x * cos_heading + shift_y * sin_heading) <=
+             std::abs(dx_length_[i] * cos_heading +
+                      dy_length_[i] * sin_heading) +
+                 std::abs(dx_width_[i] * cos_heading +
+                          dy_width_[i] * sin_heading) +
+                 box.half_length() &&
+         std::abs(shift_x * sin_heading - shift_y * cos_heading) <=
+             std::abs(dx_length_[i] * sin_heading -
+                      dy_length_[i] * cos_heading) +
+                 std::abs(dx_width_[i] * sin_heading -
+                          dy_width_[i] * cos_heading) +
+                 box.half_width() &&
+         std::abs(shift_x * cos_heading_[i] + shift_y * sin_heading_[i]) <=
+             std::abs(dx1 * cos_heading_[i] + dy1 * sin_heading_[i]) +
+                 std::abs(dx2 * cos_heading_[i] + dy2 * sin_heading_[i]) +
+                 half_length_[i] &&
+         std::abs(shift_x * sin_heading_[i] - shift_y * cos_heading_[i]) <=
+             std::abs(dx1 * sin_heading_[i] - dy1 * cos_heading_[i]) +
+                 std::abs(dx2 * sin_heading_[i] - dy2 * cos_heading_[i]) +
+                 half_width_[i];
+}
+
+bool Box2dBatch::HasOverlapWithAny(const Box2d &box) const {
+  const size_t num_boxes = size();
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  const __m256d sign_mask = _mm256_set1_pd(-0.0);
+  const __m256d min_x = _mm256_set1_pd(box.min_x());
+  const __m256d max_x = _mm256_set1_pd(box.max_x());
+  const __m256d min_y = _mm256_set1_pd(box.min_y());
+  const __m256d max_y = _mm256_set1_pd(box.max_y());
+  const __m256d center_x = _mm256_set1_pd(box.center_x());
+  const __m256d center_y = _mm256_set1_pd(box.center_y());
+  const __m256d cos_heading = _mm256_set1_pd(box.cos_heading());
+  const __m256d sin_heading = _mm256_set1_pd(box.sin_heading());
+  const __m256d half_length = _mm256_set1_pd(box.half_length());
+  const __m256d half_width = _mm256_set1_pd(box.half_width());
+  const __m256d dx1 = _mm256_set1_pd(box.cos_heading() * box.half_length());
+  const __m256d dy1 = _mm256_set1_pd(box.sin_heading() * box.half_length());
+  const __m256d dx2 = _mm256_set1_pd(box.sin_heading() * box.half_width());
+  const __m256d dy2 = _mm256_set1_pd(-box.cos_heading() * box.half_width());
+
+  for (; i + 4 <= num_boxes; i += 4) {
+    // Axes-aligned bounding boxes first, as Box2d::HasOverlap does.
+    __m256d mask = _mm256_and_pd(
+        _mm256_and_pd(
+            _mm256_cmp_pd(_mm256_loadu_pd(&max_x_[i]), min_x, _CMP_GE_OQ),
+            _mm256_cmp_pd(_mm256_loadu_pd(&min_x_[i]), max_x, _CMP_LE_OQ)),
+        _mm256_and_pd(
+            _mm256_cmp_pd(_mm256_loadu_pd(&max_y_[i]), min_y, _CMP_GE_OQ),
+            _mm256_cmp_pd(_mm256_loadu_pd(&min_y_[i]), max_y, _CMP_LE_OQ)));
+    if (_mm256_movemask_pd(mask) == 0) {
+      continue;
+    }
+
+    const __m256d shift_x =
+        _mm256_sub_pd(_mm256_loadu_pd(&center_x_[i]), center_x);
+    const __m256d shift_y =
+        _mm256_sub_pd(_mm256_loadu_pd(&center_y_[i]), center_y);
+    const __m256d cos_i = _mm256_loadu_pd(&cos_heading_[i]);
+    const __m256d sin_i = _mm256_loadu_pd(&sin_heading_[i]);
+    const __m256d dx3 = _mm256_loadu_pd(&dx_length_[i]);
+    const __m256d dy3 = _mm256_loadu_pd(&dy_length_[i]);
+    const __m256d dx4 = _mm256_loadu_pd(&dx_width_[i]);
+    const __m256d dy4 = _mm256_loadu_pd(&dy_width_[i]);
+
+    // Projections on the heading-axis and the width axis of the given box.
+    __m256d lhs = _mm256_andnot_pd(
+        sign_mask, _mm256_add_pd(_mm256_mul_pd(shift_x, cos_heading),
+                                 _mm256_mul_pd(shift_y, sin_heading)));
+    __m256d rhs = _mm256_add_pd(
+        _mm256_add_pd(
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_add_pd(_mm256_mul_pd(dx3, cos_heading),
+                                           _mm256_mul_pd(dy3, sin_heading))),
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_add_pd(_mm256_mul_pd(dx4, cos_heading),
+                                           _mm256_mul_pd(dy4, sin_heading)))),
+        half_length);
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(lhs, rhs, _CMP_LE_OQ));
+
+    lhs = _mm256_andnot_pd(
+        sign_mask, _mm256_sub_pd(_mm256_mul_pd(shift_x, sin_heading),
+                                 _mm256_mul_pd(shift_y, cos_heading)));
+    rhs = _mm256_add_pd(
+        _mm256_add_pd(
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_sub_pd(_mm256_mul_pd(dx3, sin_heading),
+                                           _mm256_mul_pd(dy3, cos_heading))),
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_sub_pd(_mm256_mul_pd(dx4, sin_heading),
+                                           _mm256_mul_pd(dy4, cos_heading)))),
+        half_width);
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(lhs, rhs, _CMP_LE_OQ));
+
+    // Projections on the heading-axis and the width axis of the batch boxes.
+    lhs = _mm256_andnot_pd(sign_mask,
+                           _mm256_add_pd(_mm256_mul_pd(shift_x, cos_i),
+                                         _mm256_mul_pd(shift_y, sin_i)));
+    rhs = _mm256_add_pd(
+        _mm256_add_pd(
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_add_pd(_mm256_mul_pd(dx1, cos_i),
+                                           _mm256_mul_pd(dy1, sin_i))),
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_add_pd(_mm256_mul_pd(dx2, cos_i),
+                                           _mm256_mul_pd(dy2, sin_i)))),
+        _mm256_loadu_pd(&half_length_[i]));
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(lhs, rhs, _CMP_LE_OQ));
+
+    lhs = _mm256_andnot_pd(sign_mask,
+                           _mm256_sub_pd(_mm256_mul_pd(shift_x, sin_i),
+                                         _mm256_mul_pd(shift_y, cos_i)));
+    rhs = _mm256_add_pd(
+        _mm256_add_pd(
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_sub_pd(_mm256_mul_pd(dx1, sin_i),
+                                           _mm256_mul_pd(dy1, cos_i))),
+            _mm256_andnot_pd(sign_mask,
+                             _mm256_sub_pd(_mm256_mul_pd(dx2, sin_i),
+                                           _mm256_mul_pd(dy2, cos_i)))),
+        _mm256_loadu_pd(&half_width_[i]));
+    mask = _mm256_and_pd(mask, _mm256_cmp_pd(lhs, rhs, _CMP_LE_OQ));
+
+    if (_mm256_movemask_pd(mask) != 0) {
+      return true;
+    }
+  }
+#elif defined(__aarch64__)
+  const float64x2_t min_x = vdupq_n_f64(box.min_x());
+  const float64x2_t max_x = vdupq_n_f64(box.max_x());
+  const float64x2_t min_y = vdupq_n_f64(box.min_y());
+  const float64x2_t max_y = vdupq_n_f64(box.max_y());
+  const float64x2_t center_x = vdupq_n_f64(box.center_x());
+  const float64x2_t center_y = vdupq_n_f64(box.center_y());
+  const float64x2_t cos_heading = vdupq_n_f64(box.cos_heading());
+  const float64x2_t sin_heading = vdupq_n_f64(box.sin_heading());
+  const float64x2_t half_length = vdupq_n_f64(box.half_length());
+  const float64x2_t half_width = vdupq_n_f64(box.half_width());
+  const float64x2_t dx1 = vdupq_n_f64(box.cos_heading() * box.half_length());
+  const float64x2_t dy1 = vdupq_n_f64(box.sin_heading() * box.half_length());
+  const float64x2_t dx2 = vdupq_n_f64(box.sin_heading() * box.half_width());
+  const float64x2_t dy2 = vdupq_n_f64(-box.cos_heading() * box.half_width());
+
+  for (; i + 2 <= num_boxes; i += 2) {
+    // Axes-aligned bounding boxes first, as Box2d::HasOverlap does.
+    uint64x2_t mask =
+        vandq_u64(vandq_u64(vcgeq_f64(vld1q_f64(&max_x_[i]), min_x),
+                            vcleq_f64(vld1q_f64(&min_x_[i]), max_x)),
+                  vandq_u64(vcgeq_f64(vld1q_f64(&max_y_[i]), min_y),
+                            vcleq_f64(vld1q_f64(&min_y_[i]), max_y)));
+    if ((vgetq_lane_u64(mask, 0) | vgetq_lane_u64(mask, 1)) == 0) {
+      continue;
+    }
+
+    const float64x2_t shift_x = vsubq_f64(vld1q_f64(&center_x_[i]), center_x);
+    const float64x2_t shift_y = vsubq_f64(vld1q_f64(&center_y_[i]), center_y);
+    const float64x2_t cos_i = vld1q_f64(&cos_heading_[i]);
+    const float64x2_t sin_i = vld1q_f64(&sin_heading_[i]);
+    const float64x2_t dx3 = vld1q_f64(&dx_length_[i]);
+    const float64x2_t dy3 = vld1q_f64(&dy_length_[i]);
+    const float64x2_t dx4 = vld1q_f64(&dx_width_[i]);
+    const float64x2_t dy4 = vld1q_f64(&dy_width_[i]);
+
+    // Projections on the heading-axis and the width axis of the given box.
+    float64x2_t lhs = vabsq_f64(vaddq_f64(vmulq_f64(shift_x, cos_heading),
+                                          vmulq_f64(shift_y, sin_heading)));
+    float64x2_t rhs = vaddq_f64(
+        vaddq_f64(vabsq_f64(vaddq_f64(vmulq_f64(dx3, cos_heading),
+                                      vmulq_f64(dy3, sin_heading))),
+                  vabsq_f64(vaddq_f64(vmulq_f64(dx4, cos_heading),
+                                      vmulq_f64(dy4, sin_heading)))),
+        half_length);
+    mask = vandq_u64(mask, vcleq_f64(lhs, rhs));
+
+    lhs = vabsq_f64(vsubq_f64(vmulq_f64(shift_x, sin_heading),
+                              vmulq_f64(shift_y, cos_heading)));
+    rhs = vaddq_f64(
+        vaddq_f64(vabsq_f64(vsubq_f64(vmulq_f64(dx3, sin_heading),
+                                      vmulq_f64(dy3, cos_heading))),
+                  vabsq_f64(vsubq_f64(vmulq_f64(dx4, sin_heading),
+                                      vmulq_f64(dy4, cos_heading)))),
+        half_width);
+    mask = vandq_u64(mask, vcleq_f64(lhs, rhs));
+
+    // Projections on the heading-axis and the width axis of the batch boxes.
+    lhs = vabsq_f64(
+        vaddq_f64(vmulq_f64(shift_x, cos_i), vmulq_f64(shift_y, sin_i)));
+    rhs = vaddq_f64(
+        vaddq_f64(vabsq_f64(vaddq_f64(vmulq_f64(dx1, cos_i),
+                                      vmulq_f64(dy1, sin_i))),
+                  vabsq_f64(vaddq_f64(vmulq_f64(dx2, cos_i),
+                                      vmulq_f64(dy2, sin_i)))),
+        vld1q_f64(&half_length_[i]));
+    mask = vandq_u64(mask, vcleq_f64(lhs, rhs));
+
+    lhs = vabsq_f64(
+        vsubq_f64(vmulq_f64(shift_x, sin_i), vmulq_f64(shift_y, cos_i)));
+    rhs = vaddq_f64(
+        vaddq_f64(vabsq_f64(vsubq_f64(vmulq_f64(dx1, sin_i),
+                                      vmulq_f64(dy1, cos_i))),
+                  vabsq_f64(vsubq_f64(vmulq_f64(dx2, sin_i),
+                                      vmulq_f64(dy2, cos_i)))),
+        vld1q_f64(&half_width_[i]));
+    mask = vandq_u64(mask, vcleq_f64(lhs, rhs));
+
+    if ((vgetq_lane_u64(mask, 0) | vgetq_lane_u64(mask, 1)) != 0) {
+      return true;
+    }
+  }
+#endif
+
+  for (; i < num_boxes; ++i) {
+    if (HasOverlapAt(box, i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The class of Box2dBatch, a set of boxes laid out for testing one box
+ *        against all of them at once.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class Box2dBatch
+ * @brief A set of Box2d stored as structure of arrays.
+ *
+ * The overlap test against the batch evaluates the same separating axis test
+ * as Box2d::HasOverlap, with AVX2 on x86 and NEON on aarch64 handling several
+ * boxes per instruction.
+ */
+class Box2dBatch {
+ public:
+  Box2dBatch() = default;
+
+  /**
+   * @brief Constructor which takes the boxes of the batch.
+   * @param boxes The boxes of the batch.
+   */
+  explicit Box2dBatch(const std::vector<Box2d> &boxes);
+
+  /**
+   * @brief Append a box to the batch.
+   * @param box The box to append.
+   */
+  void Add(const Box2d &box);
+
+  /**
+   * @brief Remove all the boxes from the batch.
+   */
+  void Clear();
+
+  /**
+   * @brief Reserve space for boxes.
+   * @param size The number of boxes to reserve space for.
+   */
+  void Reserve(const size_t size);
+
+  /**
+   * @brief Getter of the number of boxes in the batch.
+   * @return The number of boxes in the batch.
+   */
+  size_t size() const { return center_x_.size(); }
+
+  /**
+   * @brief Check if the batch has no box.
+   * @return True if the batch has no box.
+   */
+  bool empty() const { return center_x_.empty(); }
+
+  /**
+   * @brief Determines whether a box overlaps with any box of the batch.
+   * @param box The box to check.
+   * @return True if the box overlaps with at least one box of the batch,
+   *         with the same result as Box2d::HasOverlap on each of them.
+   */
+  bool HasOverlapWithAny(const Box2d &box) const;
+
+ private:
+  bool HasOverlapAt(const Box2d &box, const size_t index) const;
+
+  std::vector<double> center_x_;
+  std::vector<double> center_y_;
+  std::vector<double> cos_heading_;
+  std::vector<double> sin_heading_;
+  std::vector<double> half_length_;
+  std::vector<double> half_width_;
+  // The half axis vectors of the boxes.
+  std::vector<double> dx_length_;
+  std::vector<double> dy_length_;
+  std::vector<double> dx_width_;
+  std::vector<double> dy_width_;
+  std::vector<double> min_x_;
+  std::vector<double> max_x_;
+  std::vector<double> min_y_;
+  std::vector<double> max_y_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/box2d_batch.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(Box2dBatchTest, Empty) {
+  Box2dBatch batch;
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0, batch.size());
+  EXPECT_FALSE(batch.HasOverlapWithAny({{0, 0}, 0, 4, 2}));
+}
+
+TEST(Box2dBatchTest, HasOverlapWithAny) {
+  Box2dBatch batch({Box2d({10, 0}, 0, 4, 2), Box2d({0, 10}, M_PI_4, 4, 2),
+                    Box2d({-10, 0}, 0, 4, 2)});
+  EXPECT_EQ(3, batch.size());
+  EXPECT_FALSE(batch.HasOverlapWithAny({{0, 0}, 0, 4, 2}));
+  EXPECT_TRUE(batch.HasOverlapWithAny({{-7, 0}, 0, 4, 2}));
+  EXPECT_TRUE(batch.HasOverlapWithAny({{0, 7}, M_PI_2, 4, 2}));
+  EXPECT_FALSE(batch.HasOverlapWithAny({{3, 3}, M_PI_4, 4, 2}));
+
+  batch.Clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_FALSE(batch.HasOverlapWithAny({{-7, 0}, 0, 4, 2}));
+}
+
+TEST(Box2dBatchTest, SameAsBox2d) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> position(-20.0, 20.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 6.0);
+  for (int i = 0; i < 2000; ++i) {
+    std::vector<Box2d> boxes;
+    const int num_boxes = i % 13;
+    for (int j = 0; j < num_boxes; ++j) {
+      boxes.emplace_back(Vec2d(position(generator), position(generator)),
+                         heading(generator), size(generator), size(generator));
+    }
+    const Box2d box({position(generator) * 0.5, position(generator) * 0.5},
+                    heading(generator), size(generator), size(generator));
+    bool has_overlap = false;
+    for (const auto &other : boxes) {
+      has_overlap = has_overlap || box.HasOverlap(other);
+    }
+    EXPECT_EQ(has_overlap, Box2dBatch(boxes).HasOverlapWithAny(box));
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
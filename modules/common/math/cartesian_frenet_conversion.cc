@@ -17,13 +17,49 @@
 #include "modules/common/math/cartesian_frenet_conversion.h"
 
 #include <cmath>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/math_utils.h"
+#include "modules/common/math/sin_cos_batch.h"
 
 namespace apollo {
 namespace common {
 namespace math {
+namespace {
+
+// Fills the sines and cosines of the reference headings of the points. They
+// are evaluated per reference point if the points outnumber them, so that
+// points sharing a reference point share its trigonometry, per point
+// otherwise.
+void ReferenceSinCos(const ReferencePointArrays& refs, const size_t* ref_index,
+                     const size_t num_points, std::vector<double>* const sines,
+                     std::vector<double>* const cosines) {
+  sines->resize(num_points);
+  cosines->resize(num_points);
+  if (ref_index == nullptr) {
+    ACHECK(num_points <= refs.size);
+    SinCosBatch(refs.theta, num_points, sines->data(), cosines->data());
+    return;
+  }
+  if (num_points >= refs.size) {
+    std::vector<double> ref_sines(refs.size);
+    std::vector<double> ref_cosines(refs.size);
+    SinCosBatch(refs.theta, refs.size, ref_sines.data(), ref_cosines.data());
+    for (size_t i = 0; i < num_points; ++i) {
+      (*sines)[i] = ref_sines[ref_index[i]];
+      (*cosines)[i] = ref_cosines[ref_index[i]];
+    }
+    return;
+  }
+  std::vector<double> thetas(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    thetas[i] = refs.theta[ref_index[i]];
+  }
+  SinCosBatch(thetas.data(), num_points, sines->data(), cosines->data());
+}
+
+}  // namespace
 
 void CartesianFrenetConverter::cartesian_to_frenet(
     const double rs, const double rx, const double ry, const double rtheta,
@@ -128,6 +164,131 @@ void CartesianFrenetConverter::frenet_to_cartesian(
                (d_condition[1] * delta_theta_prime - kappa_r_d_prime);
 }
 
+void CartesianFrenetConverter::cartesian_to_frenet(
+    const ReferencePointArrays& refs, const size_t* ref_index,
+    const size_t num_points, const double* x, const double* y,
+    double* const ptr_s, double* const ptr_d) {
+  std::vector<double> sin_theta_r;
+  std::vector<double> cos_theta_r;
+  ReferenceSinCos(refs, ref_index, num_points, &sin_theta_r, &cos_theta_r);
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t r = ref_index == nullptr ? i : ref_index[i];
+    const double dx = x[i] - refs.x[r];
+    const double dy = y[i] - refs.y[r];
+    const double cross_rd_nd = cos_theta_r[i] * dy - sin_theta_r[i] * dx;
+    ptr_d[i] = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
+    ptr_s[i] = refs.s[r];
+  }
+}
+
+void CartesianFrenetConverter::cartesian_to_frenet(
+    const ReferencePointArrays& refs, const size_t* ref_index,
+    const size_t num_points, const double* x, const double* y,
+    const double* v, const double* a, const double* theta,
+    const double* kappa, std::array<double, 3>* const ptr_s_conditions,
+    std::array<double, 3>* const ptr_d_conditions) {
+  std::vector<double> sin_theta_r;
+  std::vector<double> cos_theta_r;
+  ReferenceSinCos(refs, ref_index, num_points, &sin_theta_r, &cos_theta_r);
+  std::vector<double> delta_theta(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    delta_theta[i] =
+        theta[i] - refs.theta[ref_index == nullptr ? i : ref_index[i]];
+  }
+  std::vector<double> sin_delta_theta(num_points);
+  std::vector<double> cos_delta_theta(num_points);
+  SinCosBatch(delta_theta.data(), num_points, sin_delta_theta.data(),
+              cos_delta_theta.data());
+
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t r = ref_index == nullptr ? i : ref_index[i];
+    const double rkappa = refs.kappa[r];
+    const double dx = x[i] - refs.x[r];
+    const double dy = y[i] - refs.y[r];
+    std::array<double, 3>& s_condition = ptr_s_conditions[i];
+    std::array<double, 3>& d_condition = ptr_d_conditions[i];
+
+    const double cross_rd_nd = cos_theta_r[i] * dy - sin_theta_r[i] * dx;
+    d_condition[0] = std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
+
+    const double tan_delta_theta = sin_delta_theta[i] / cos_delta_theta[i];
+    const double one_minus_kappa_r_d = 1 - rkappa * d_condition[0];
+    d_condition[1] = one_minus_kappa_r_d * tan_delta_theta;
+
+    const double kappa_r_d_prime =
+        refs.dkappa[r] * d_condition[0] + rkappa * d_condition[1];
+
+    d_condition[2] =
+        -kappa_r_d_prime * tan_delta_theta +
+        one_minus_kappa_r_d / cos_delta_theta[i] / cos_delta_theta[i] *
+            (kappa[i] * one_minus_kappa_r_d / cos_delta_theta[i] - rkappa);
+
+    s_condition[0] = refs.s[r];
+
+    s_condition[1] = v[i] * cos_delta_theta[i] / one_minus_kappa_r_d;
+
+    const double delta_theta_prime =
+        one_minus_kappa_r_d / cos_delta_theta[i] * kappa[i] - rkappa;
+    s_condition[2] =
+        (a[i] * cos_delta_theta[i] -
+         s_condition[1] * s_condition[1] *
+             (d_condition[1] * delta_theta_prime - kappa_r_d_prime)) /
+        one_minus_kappa_r_d;
+  }
+}
+
+void CartesianFrenetConverter::frenet_to_cartesian(
+    const ReferencePointArrays& refs, const size_t* ref_index,
+    const size_t num_points, const std::array<double, 3>* s_conditions,
+    const std::array<double, 3>* d_conditions, double* const ptr_x,
+    double* const ptr_y, double* const ptr_theta, double* const ptr_kappa,
+    double* const ptr_v, double* const ptr_a) {
+  std::vector<double> sin_theta_r;
+  std::vector<double> cos_theta_r;
+  ReferenceSinCos(refs, ref_index, num_points, &sin_theta_r, &cos_theta_r);
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t r = ref_index == nullptr ? i : ref_index[i];
+    const std::array<double, 3>& s_condition = s_conditions[i];
+    const std::array<double, 3>& d_condition = d_conditions[i];
+    ACHECK(std::abs(refs.s[r] - s_condition[0]) < 1.0e-6)
+        << "The reference point s and s_condition[0] don't match";
+    const double rkappa = refs.kappa[r];
+
+    ptr_x[i] = refs.x[r] - sin_theta_r[i] * d_condition[0];
+    ptr_y[i] = refs.y[r] + cos_theta_r[i] * d_condition[0];
+
+    const double one_minus_kappa_r_d = 1 - rkappa * d_condition[0];
+
+    const double tan_delta_theta = d_condition[1] / one_minus_kappa_r_d;
+    const double delta_theta = std::atan2(d_condition[1], one_minus_kappa_r_d);
+    // cos(atan2(y, x)) without another trigonometric call
+    const double cos_delta_theta =
+        one_minus_kappa_r_d / std::hypot(d_condition[1], one_minus_kappa_r_d);
+
+    ptr_theta[i] = NormalizeAngle(delta_theta + refs.theta[r]);
+
+    const double kappa_r_d_prime =
+        refs.dkappa[r] * d_condition[0] + rkappa * d_condition[1];
+    ptr_kappa[i] = (((d_condition[2] + kappa_r_d_prime * tan_delta_theta) *
+                     cos_delta_theta * cos_delta_theta) /
+                        (one_minus_kappa_r_d) +
+                    rkappa) *
+                   cos_delta_theta / (one_minus_kappa_r_d);
+
+    const double d_dot = d_condition[1] * s_condition[1];
+    ptr_v[i] = std::sqrt(one_minus_kappa_r_d * one_minus_kappa_r_d *
+                             s_condition[1] * s_condition[1] +
+                         d_dot * d_dot);
+
+    const double delta_theta_prime =
+        one_minus_kappa_r_d / cos_delta_theta * ptr_kappa[i] - rkappa;
+
+    ptr_a[i] = s_condition[2] * one_minus_kappa_r_d / cos_delta_theta +
+               s_condition[1] * s_condition[1] / cos_delta_theta *
+                   (d_condition[1] * delta_theta_prime - kappa_r_d_prime);
+  }
+}
+
 double CartesianFrenetConverter::CalculateTheta(const double rtheta,
                                                 const double rkappa,
                                                 const double l,
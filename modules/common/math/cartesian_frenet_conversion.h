@@ -21,6 +21,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 
 #include "modules/common/math/vec2d.h"
 
@@ -38,6 +39,19 @@ namespace math {
 // d_prime: dd / ds
 // d_pprime: d(d_prime) / ds
 // l: the same as d.
+
+// Reference points laid out as structure of arrays for the batch conversions.
+// kappa and dkappa are only read by the full state conversions.
+struct ReferencePointArrays {
+  size_t size = 0;
+  const double* s = nullptr;
+  const double* x = nullptr;
+  const double* y = nullptr;
+  const double* theta = nullptr;
+  const double* kappa = nullptr;
+  const double* dkappa = nullptr;
+};
+
 class CartesianFrenetConverter {
  public:
   CartesianFrenetConverter() = delete;
@@ -76,6 +90,31 @@ class CartesianFrenetConverter {
                                   double* const ptr_kappa, double* const ptr_v,
                                   double* const ptr_a);
 
+  // Batch versions of the conversions above over contiguous arrays of
+  // num_points points. Point i is converted against the reference point
+  // ref_index[i], or against the reference point i if ref_index is nullptr.
+  // The sines and cosines are evaluated vectorized by SinCosBatch, once per
+  // reference point when the points share them.
+  static void cartesian_to_frenet(const ReferencePointArrays& refs,
+                                  const size_t* ref_index,
+                                  const size_t num_points, const double* x,
+                                  const double* y, double* const ptr_s,
+                                  double* const ptr_d);
+
+  static void cartesian_to_frenet(
+      const ReferencePointArrays& refs, const size_t* ref_index,
+      const size_t num_points, const double* x, const double* y,
+      const double* v, const double* a, const double* theta,
+      const double* kappa, std::array<double, 3>* const ptr_s_conditions,
+      std::array<double, 3>* const ptr_d_conditions);
+
+  static void frenet_to_cartesian(
+      const ReferencePointArrays& refs, const size_t* ref_index,
+      const size_t num_points, const std::array<double, 3>* s_conditions,
+      const std::array<double, 3>* d_conditions, double* const ptr_x,
+      double* const ptr_y, double* const ptr_theta, double* const ptr_kappa,
+      double* const ptr_v, double* const ptr_a);
+
   // given sl point extract x, y, theta, kappa
   static double CalculateTheta(const double rtheta, const double rkappa,
                                const double l, const double dl);
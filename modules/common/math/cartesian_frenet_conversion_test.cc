@@ -18,6 +18,7 @@
 
 #include <array>
 #include <cmath>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -65,6 +66,103 @@ TEST(TestCartesianFrenetConversion, cartesian_to_frenet_test) {
   EXPECT_NEAR(a, a_out, 1.0e-6);
 }
 
+TEST(TestCartesianFrenetConversion, batch_conversion_test) {
+  // a circle of radius 20 as reference line
+  std::vector<double> rs;
+  std::vector<double> rx;
+  std::vector<double> ry;
+  std::vector<double> rtheta;
+  std::vector<double> rkappa;
+  std::vector<double> rdkappa;
+  for (int i = 0; i < 50; ++i) {
+    const double angle = 0.05 * i;
+    rs.push_back(20.0 * angle);
+    rx.push_back(20.0 * std::sin(angle));
+    ry.push_back(20.0 - 20.0 * std::cos(angle));
+    rtheta.push_back(angle);
+    rkappa.push_back(0.05);
+    rdkappa.push_back(0.001);
+  }
+  ReferencePointArrays refs;
+  refs.size = rs.size();
+  refs.s = rs.data();
+  refs.x = rx.data();
+  refs.y = ry.data();
+  refs.theta = rtheta.data();
+  refs.kappa = rkappa.data();
+  refs.dkappa = rdkappa.data();
+
+  std::vector<size_t> ref_index;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> v;
+  std::vector<double> a;
+  std::vector<double> theta;
+  std::vector<double> kappa;
+  for (int i = 0; i < 203; ++i) {
+    const size_t r = (i * 7) % rs.size();
+    const double l = 0.02 * (i % 50) - 0.5;
+    ref_index.push_back(r);
+    x.push_back(rx[r] - l * std::sin(rtheta[r]));
+    y.push_back(ry[r] + l * std::cos(rtheta[r]));
+    v.push_back(1.0 + 0.01 * i);
+    a.push_back(0.1 * (i % 5));
+    theta.push_back(rtheta[r] + 0.001 * (i % 30));
+    kappa.push_back(0.05 + 0.0001 * i);
+  }
+  const size_t num_points = x.size();
+
+  std::vector<double> s_out(num_points);
+  std::vector<double> d_out(num_points);
+  CartesianFrenetConverter::cartesian_to_frenet(
+      refs, ref_index.data(), num_points, x.data(), y.data(), s_out.data(),
+      d_out.data());
+  std::vector<std::array<double, 3>> s_conditions(num_points);
+  std::vector<std::array<double, 3>> d_conditions(num_points);
+  CartesianFrenetConverter::cartesian_to_frenet(
+      refs, ref_index.data(), num_points, x.data(), y.data(), v.data(),
+      a.data(), theta.data(), kappa.data(), s_conditions.data(),
+      d_conditions.data());
+  std::vector<double> x_out(num_points);
+  std::vector<double> y_out(num_points);
+  std::vector<double> theta_out(num_points);
+  std::vector<double> kappa_out(num_points);
+  std::vector<double> v_out(num_points);
+  std::vector<double> a_out(num_points);
+  CartesianFrenetConverter::frenet_to_cartesian(
+      refs, ref_index.data(), num_points, s_conditions.data(),
+      d_conditions.data(), x_out.data(), y_out.data(), theta_out.data(),
+      kappa_out.data(), v_out.data(), a_out.data());
+
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t r = ref_index[i];
+    double s = 0.0;
+    double d = 0.0;
+    CartesianFrenetConverter::cartesian_to_frenet(rs[r], rx[r], ry[r],
+                                                  rtheta[r], x[i], y[i], &s,
+                                                  &d);
+    EXPECT_DOUBLE_EQ(s, s_out[i]);
+    EXPECT_NEAR(d, d_out[i], 1.0e-12);
+
+    std::array<double, 3> s_condition;
+    std::array<double, 3> d_condition;
+    CartesianFrenetConverter::cartesian_to_frenet(
+        rs[r], rx[r], ry[r], rtheta[r], rkappa[r], rdkappa[r], x[i], y[i],
+        v[i], a[i], theta[i], kappa[i], &s_condition, &d_condition);
+    for (size_t k = 0; k < 3; ++k) {
+      EXPECT_NEAR(s_condition[k], s_conditions[i][k], 1.0e-9);
+      EXPECT_NEAR(d_condition[k], d_conditions[i][k], 1.0e-9);
+    }
+
+    EXPECT_NEAR(x[i], x_out[i], 1.0e-6);
+    EXPECT_NEAR(y[i], y_out[i], 1.0e-6);
+    EXPECT_NEAR(theta[i], theta_out[i], 1.0e-6);
+    EXPECT_NEAR(kappa[i], kappa_out[i], 1.0e-6);
+    EXPECT_NEAR(v[i], v_out[i], 1.0e-6);
+    EXPECT_NEAR(a[i], a_out[i], 1.0e-6);
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
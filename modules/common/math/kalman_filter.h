@@ -189,6 +189,21 @@ class KalmanFilter {
    */
   void Correct(const Eigen::Matrix<T, ZN, 1> &z);
 
+  /**
+   * @brief Updates the state belief distribution in information form, given
+   * an observation with its own observation model. Cheaper than Correct when
+   * the observation has more dimensions than the state, and does not touch
+   * the observation model of the filter.
+   *
+   * @param z Observation
+   * @param H Observation matrix of z
+   * @param R Covariance matrix of the noise of z
+   */
+  template <int MN>
+  void CorrectInformation(const Eigen::Matrix<T, MN, 1> &z,
+                          const Eigen::Matrix<T, MN, XN> &H,
+                          const Eigen::Matrix<T, MN, MN> &R);
+
   /**
    * @brief Gets mean of our current state belief distribution
    *
@@ -278,6 +293,22 @@ inline void KalmanFilter<T, XN, ZN, UN>::Correct(
       (Eigen::Matrix<T, XN, XN>::Identity() - K_ * H_) * P_);
 }
 
+template <typename T, unsigned int XN, unsigned int ZN, unsigned int UN>
+template <int MN>
+inline void KalmanFilter<T, XN, ZN, UN>::CorrectInformation(
+    const Eigen::Matrix<T, MN, 1> &z, const Eigen::Matrix<T, MN, XN> &H,
+    const Eigen::Matrix<T, MN, MN> &R) {
+  ACHECK(is_initialized_);
+  const Eigen::Matrix<T, XN, MN> Ht_R_inv = H.transpose() * R.inverse();
+
+  // information matrix and vector, Y = P^-1 and y = Y * x
+  const Eigen::Matrix<T, XN, XN> information = P_.inverse();
+  const Eigen::Matrix<T, XN, 1> information_state = information * x_;
+  P_ = static_cast<Eigen::Matrix<T, XN, XN>>(
+      (information + Ht_R_inv * H).inverse());
+  x_ = P_ * (information_state + Ht_R_inv * z);
+}
+
 template <typename T, unsigned int XN, unsigned int ZN, unsigned int UN>
 inline std::string KalmanFilter<T, XN, ZN, UN>::DebugString() const {
   Eigen::IOFormat clean_fmt(4, 0, ", ", " ", "[", "]");
@@ -0,0 +1,397 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the templated KalmanFilterBatch class.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Eigen/Core"
+
+#include "cyber/common/log.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class KalmanFilterBatch
+ *
+ * @brief Runs the same linear Kalman filter over many tracks at once.
+ *
+ * Every entry of the states and covariances is stored as one array over the
+ * tracks, so a predict or a correction is a sequence of array operations
+ * which Eigen vectorizes across tracks. The tracks share the transition and
+ * observation models, each track has its own observation and observation
+ * noise. Nothing is allocated unless the number of tracks changes.
+ *
+ * @param XN dimension of state
+ * @param ZN dimension of observations
+ */
+template <typename T, unsigned int XN, unsigned int ZN>
+class KalmanFilterBatch {
+ public:
+  using Lanes = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+  KalmanFilterBatch() { H_.setIdentity(); }
+
+  /**
+   * @brief Changes the number of tracks, new tracks start with zero state
+   *        and covariance.
+   * @param num_tracks The number of tracks.
+   */
+  void Resize(const size_t num_tracks);
+
+  /**
+   * @brief Getter of the number of tracks.
+   * @return The number of tracks.
+   */
+  size_t size() const { return num_tracks_; }
+
+  /**
+   * @brief Changes the observation matrix shared by all tracks.
+   *
+   * @param H New observation matrix
+   */
+  void SetObservationMatrix(const Eigen::Matrix<T, ZN, XN> &H) { H_ = H; }
+
+  /**
+   * @brief Sets the state belief distribution of one track.
+   *
+   * @param index Index of the track
+   * @param x Mean of the state belief distribution
+   * @param P Covariance of the state belief distribution
+   */
+  void SetStateEstimate(const size_t index, const Eigen::Matrix<T, XN, 1> &x,
+                        const Eigen::Matrix<T, XN, XN> &P);
+
+  /**
+   * @brief Gets mean of the state belief distribution of one track.
+   *
+   * @param index Index of the track
+   * @return State vector
+   */
+  Eigen::Matrix<T, XN, 1> GetStateEstimate(const size_t index) const;
+
+  /**
+   * @brief Gets covariance of the state belief distribution of one track.
+   *
+   * @param index Index of the track
+   * @return Covariance matrix
+   */
+  Eigen::Matrix<T, XN, XN> GetStateCovariance(const size_t index) const;
+
+  /**
+   * @brief Updates the state belief distributions of all tracks.
+   *
+   * @param F Transition matrix
+   * @param Q Covariance matrix of the transition noise
+   */
+  void Predict(const Eigen::Matrix<T, XN, XN> &F,
+               const Eigen::Matrix<T, XN, XN> &Q);
+
+  /**
+   * @brief Queues an observation of one track for the next Correct.
+   *
+   * @param index Index of the track
+   * @param z Observation
+   * @param R Covariance matrix of the observation noise
+   */
+  void SetObservation(const size_t index, const Eigen::Matrix<T, ZN, 1> &z,
+                      const Eigen::Matrix<T, ZN, ZN> &R);
+
+  /**
+   * @brief Updates the state belief distributions of the tracks with a queued
+   *        observation, and clears the queue.
+   */
+  void Correct();
+
+ private:
+  static constexpr unsigned int Index(const unsigned int row,
+                                      const unsigned int col,
+                                      const unsigned int cols) {
+    return row * cols + col;
+  }
+
+  size_t num_tracks_ = 0;
+
+  Eigen::Matrix<T, ZN, XN> H_;
+
+  // Mean and covariance of the state belief distributions
+  std::array<Lanes, XN> x_;
+  std::array<Lanes, XN * XN> P_;
+
+  // Queued observations, tracks without one have unit noise and zero mask so
+  // the innovation covariance stays invertible and the gain is zero.
+  std::array<Lanes, ZN> z_;
+  std::array<Lanes, ZN * ZN> R_;
+  Lanes mask_;
+
+  // Workspace; marked as member to prevent memory re-allocation.
+  std::array<Lanes, XN * XN> FP_;
+  std::array<Lanes, XN> tmp_x_;
+  std::array<Lanes, ZN> y_;
+  std::array<Lanes, ZN * XN> HP_;
+  std::array<Lanes, ZN * ZN> L_;
+  std::array<Lanes, ZN * XN> Kt_;
+};
+
+template <typename T, unsigned int XN, unsigned int ZN>
+void KalmanFilterBatch<T, XN, ZN>::Resize(const size_t num_tracks) {
+  if (num_tracks == num_tracks_) {
+    return;
+  }
+  const auto grow = [num_tracks](Lanes *lanes, const T value) {
+    const Eigen::Index old_size = lanes->size();
+    lanes->conservativeResize(num_tracks);
+    if (lanes->size() > old_size) {
+      lanes->tail(lanes->size() - old_size).setConstant(value);
+    }
+  };
+  for (auto &lanes : x_) {
+    grow(&lanes, 0);
+  }
+  for (auto &lanes : P_) {
+    grow(&lanes, 0);
+  }
+  for (auto &lanes : z_) {
+    grow(&lanes, 0);
+  }
+  for (unsigned int i = 0; i < ZN; ++i) {
+    for (unsigned int j = 0; j < ZN; ++j) {
+      grow(&R_[Index(i, j, ZN)], i == j ? 1 : 0);
+    }
+  }
+  grow(&mask_, 0);
+
+  for (auto &lanes : FP_) {
+    lanes.resize(num_tracks);
+  }
+  for (auto &lanes : tmp_x_) {
+    lanes.resize(num_tracks);
+  }
+  for (auto &lanes : y_) {
+    lanes.resize(num_tracks);
+  }
+  for (auto &lanes : HP_) {
+    lanes.resize(num_tracks);
+  }
+  for (auto &lanes : L_) {
+    lanes.resize(num_tracks);
+  }
+  for (auto &lanes : Kt_) {
+    lanes.resize(num_tracks);
+  }
+  num_tracks_ = num_tracks;
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+void KalmanFilterBatch<T, XN, ZN>::SetStateEstimate(
+    const size_t index, const Eigen::Matrix<T, XN, 1> &x,
+    const Eigen::Matrix<T, XN, XN> &P) {
+  ACHECK(index < num_tracks_);
+  for (unsigned int i = 0; i < XN; ++i) {
+    x_[i](index) = x(i);
+    for (unsigned int j = 0; j < XN; ++j) {
+      P_[Index(i, j, XN)](index) = P(i, j);
+    }
+  }
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+Eigen::Matrix<T, XN, 1> KalmanFilterBatch<T, XN, ZN>::GetStateEstimate(
+    const size_t index) const {
+  ACHECK(index < num_tracks_);
+  Eigen::Matrix<T, XN, 1> x;
+  for (unsigned int i = 0; i < XN; ++i) {
+    x(i) = x_[i](index);
+  }
+  return x;
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+Eigen::Matrix<T, XN, XN> KalmanFilterBatch<T, XN, ZN>::GetStateCovariance(
+    const size_t index) const {
+  ACHECK(index < num_tracks_);
+  Eigen::Matrix<T, XN, XN> P;
+  for (unsigned int i = 0; i < XN; ++i) {
+    for (unsigned int j = 0; j < XN; ++j) {
+      P(i, j) = P_[Index(i, j, XN)](index);
+    }
+  }
+  return P;
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+void KalmanFilterBatch<T, XN, ZN>::Predict(const Eigen::Matrix<T, XN, XN> &F,
+                                           const Eigen::Matrix<T, XN, XN> &Q) {
+  // the models are sparse, skipping the zeros of F saves most of the work
+  for (unsigned int i = 0; i < XN; ++i) {
+    tmp_x_[i].setZero();
+    for (unsigned int j = 0; j < XN; ++j) {
+      if (F(i, j) != 0) {
+        tmp_x_[i] += F(i, j) * x_[j];
+      }
+    }
+  }
+  for (unsigned int i = 0; i < XN; ++i) {
+    x_[i].swap(tmp_x_[i]);
+  }
+
+  // F * P
+  for (unsigned int i = 0; i < XN; ++i) {
+    for (unsigned int c = 0; c < XN; ++c) {
+      Lanes &fp = FP_[Index(i, c, XN)];
+      fp.setZero();
+      for (unsigned int j = 0; j < XN; ++j) {
+        if (F(i, j) != 0) {
+          fp += F(i, j) * P_[Index(j, c, XN)];
+        }
+      }
+    }
+  }
+  // F * P * F^T + Q, filled symmetrically from the upper triangle
+  for (unsigned int i = 0; i < XN; ++i) {
+    for (unsigned int c = i; c < XN; ++c) {
+      Lanes &p = P_[Index(i, c, XN)];
+      p.setConstant(Q(i, c));
+      for (unsigned int j = 0; j < XN; ++j) {
+        if (F(c, j) != 0) {
+          p += F(c, j) * FP_[Index(i, j, XN)];
+        }
+      }
+      if (c != i) {
+        P_[Index(c, i, XN)] = p;
+      }
+    }
+  }
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+void KalmanFilterBatch<T, XN, ZN>::SetObservation(
+    const size_t index, const Eigen::Matrix<T, ZN, 1> &z,
+    const Eigen::Matrix<T, ZN, ZN> &R) {
+  ACHECK(index < num_tracks_);
+  for (unsigned int i = 0; i < ZN; ++i) {
+    z_[i](index) = z(i);
+    for (unsigned int j = 0; j < ZN; ++j) {
+      R_[Index(i, j, ZN)](index) = R(i, j);
+    }
+  }
+  mask_(index) = 1;
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+void KalmanFilterBatch<T, XN, ZN>::Correct() {
+  // innovation y = z - H * x and H * P
+  for (unsigned int i = 0; i < ZN; ++i) {
+    y_[i] = z_[i];
+    for (unsigned int j = 0; j < XN; ++j) {
+      if (H_(i, j) != 0) {
+        y_[i] -= H_(i, j) * x_[j];
+      }
+    }
+    for (unsigned int c = 0; c < XN; ++c) {
+      Lanes &hp = HP_[Index(i, c, XN)];
+      hp.setZero();
+      for (unsigned int j = 0; j < XN; ++j) {
+        if (H_(i, j) != 0) {
+          hp += H_(i, j) * P_[Index(j, c, XN)];
+        }
+      }
+    }
+  }
+
+  // Cholesky factor L of S = H * P * H^T + R, lower triangle only
+  for (unsigned int j = 0; j < ZN; ++j) {
+    for (unsigned int i = j; i < ZN; ++i) {
+      Lanes &l = L_[Index(i, j, ZN)];
+      l = R_[Index(i, j, ZN)];
+      for (unsigned int k = 0; k < XN; ++k) {
+        if (H_(j, k) != 0) {
+          l += H_(j, k) * HP_[Index(i, k, XN)];
+        }
+      }
+      for (unsigned int k = 0; k < j; ++k) {
+        l -= L_[Index(i, k, ZN)] * L_[Index(j, k, ZN)];
+      }
+      if (i == j) {
+        l = l.sqrt();
+      } else {
+        l /= L_[Index(j, j, ZN)];
+      }
+    }
+  }
+
+  // K^T = S^-1 * H * P, column by column through L and L^T
+  for (unsigned int c = 0; c < XN; ++c) {
+    for (unsigned int i = 0; i < ZN; ++i) {
+      Lanes &kt = Kt_[Index(i, c, XN)];
+      kt = HP_[Index(i, c, XN)];
+      for (unsigned int k = 0; k < i; ++k) {
+        kt -= L_[Index(i, k, ZN)] * Kt_[Index(k, c, XN)];
+      }
+      kt /= L_[Index(i, i, ZN)];
+    }
+    for (unsigned int i = ZN; i-- > 0;) {
+      Lanes &kt = Kt_[Index(i, c, XN)];
+      for (unsigned int k = i + 1; k < ZN; ++k) {
+        kt -= L_[Index(k, i, ZN)] * Kt_[Index(k, c, XN)];
+      }
+      kt /= L_[Index(i, i, ZN)];
+    }
+    for (unsigned int i = 0; i < ZN; ++i) {
+      Kt_[Index(i, c, XN)] *= mask_;
+    }
+  }
+
+  // x = x + K * y, P = P - K * H * P
+  for (unsigned int r = 0; r < XN; ++r) {
+    for (unsigned int i = 0; i < ZN; ++i) {
+      x_[r] += Kt_[Index(i, r, XN)] * y_[i];
+    }
+    for (unsigned int c = r; c < XN; ++c) {
+      Lanes &p = P_[Index(r, c, XN)];
+      for (unsigned int i = 0; i < ZN; ++i) {
+        p -= Kt_[Index(i, r, XN)] * HP_[Index(i, c, XN)];
+      }
+      if (c != r) {
+        P_[Index(c, r, XN)] = p;
+      }
+    }
+  }
+
+  // clear the queue
+  for (unsigned int i = 0; i < ZN; ++i) {
+    for (unsigned int j = 0; j < ZN; ++j) {
+      R_[Index(i, j, ZN)].setConstant(i == j ? 1 : 0);
+    }
+  }
+  mask_.setZero();
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
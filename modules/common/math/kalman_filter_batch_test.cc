@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/kalman_filter_batch.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/kalman_filter.h"
+#include "modules/common/math/kalman_filter_models.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(KalmanFilterBatchTest, MatchesKalmanFilter) {
+  constexpr size_t kNumTracks = 37;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> uniform(-10.0, 10.0);
+
+  Eigen::Matrix<double, 2, 4> H;
+  H.setZero();
+  H(0, 0) = 1.0;
+  H(1, 1) = 1.0;
+  Eigen::Matrix<double, 4, 4> F;
+  ConstantVelocityTransition(0.1, &F);
+  Eigen::Matrix<double, 4, 4> Q;
+  ConstantVelocityNoise(0.1, 2.0, &Q);
+
+  std::vector<KalmanFilter<double, 4, 2, 1>,
+              Eigen::aligned_allocator<KalmanFilter<double, 4, 2, 1>>>
+      filters(kNumTracks);
+  KalmanFilterBatch<double, 4, 2> batch;
+  batch.Resize(kNumTracks);
+  batch.SetObservationMatrix(H);
+  for (size_t i = 0; i < kNumTracks; ++i) {
+    Eigen::Matrix<double, 4, 1> x;
+    x << uniform(rng), uniform(rng), uniform(rng), uniform(rng);
+    Eigen::Matrix<double, 4, 4> P = Eigen::Matrix<double, 4, 4>::Identity();
+    P(0, 1) = P(1, 0) = 0.2;
+    filters[i].SetStateEstimate(x, P);
+    filters[i].SetTransitionMatrix(F);
+    filters[i].SetTransitionNoise(Q);
+    filters[i].SetObservationMatrix(H);
+    batch.SetStateEstimate(i, x, P);
+  }
+
+  for (int step = 0; step < 10; ++step) {
+    batch.Predict(F, Q);
+    for (size_t i = 0; i < kNumTracks; ++i) {
+      filters[i].Predict();
+      // every third track misses its observation
+      if ((i + step) % 3 == 0) {
+        continue;
+      }
+      Eigen::Matrix<double, 2, 1> z;
+      z << uniform(rng), uniform(rng);
+      Eigen::Matrix<double, 2, 2> R;
+      R << 0.5, 0.1, 0.1, 0.3 + 0.01 * static_cast<double>(i);
+      filters[i].SetObservationNoise(R);
+      filters[i].Correct(z);
+      batch.SetObservation(i, z, R);
+    }
+    batch.Correct();
+
+    for (size_t i = 0; i < kNumTracks; ++i) {
+      const Eigen::Matrix<double, 4, 1> x = batch.GetStateEstimate(i);
+      const Eigen::Matrix<double, 4, 4> P = batch.GetStateCovariance(i);
+      for (int r = 0; r < 4; ++r) {
+        EXPECT_NEAR(filters[i].GetStateEstimate()(r), x(r), 1e-9);
+        for (int c = 0; c < 4; ++c) {
+          EXPECT_NEAR(filters[i].GetStateCovariance()(r, c), P(r, c), 1e-9);
+        }
+      }
+    }
+  }
+}
+
+TEST(KalmanFilterBatchTest, Resize) {
+  KalmanFilterBatch<double, 4, 2> batch;
+  batch.Resize(2);
+  Eigen::Matrix<double, 4, 1> x(1.0, 2.0, 3.0, 4.0);
+  batch.SetStateEstimate(1, x, Eigen::Matrix<double, 4, 4>::Identity());
+  batch.Resize(5);
+  EXPECT_EQ(5, batch.size());
+  EXPECT_DOUBLE_EQ(3.0, batch.GetStateEstimate(1)(2));
+  EXPECT_DOUBLE_EQ(0.0, batch.GetStateEstimate(4)(2));
+  EXPECT_DOUBLE_EQ(0.0, batch.GetStateCovariance(4)(0, 0));
+
+  // tracks without observation are left untouched by a correction
+  batch.Correct();
+  EXPECT_DOUBLE_EQ(1.0, batch.GetStateEstimate(1)(0));
+  EXPECT_DOUBLE_EQ(1.0, batch.GetStateCovariance(1)(0, 0));
+}
+
+TEST(KalmanFilterModelsTest, ConstantTurnRateJacobian) {
+  for (const double yaw_rate : {0.0, 1e-5, 0.3, -0.8}) {
+    Eigen::Matrix<double, 5, 1> x(1.0, -2.0, 5.0, 0.7, yaw_rate);
+    Eigen::Matrix<double, 5, 1> predicted = x;
+    Eigen::Matrix<double, 5, 5> F;
+    ConstantTurnRatePredict(0.2, &predicted, &F);
+    for (int j = 0; j < 5; ++j) {
+      Eigen::Matrix<double, 5, 1> perturbed = x;
+      perturbed(j) += 1e-6;
+      ConstantTurnRatePredict(0.2, &perturbed,
+                              static_cast<Eigen::Matrix<double, 5, 5> *>(
+                                  nullptr));
+      for (int i = 0; i < 5; ++i) {
+        EXPECT_NEAR((perturbed(i) - predicted(i)) / 1e-6, F(i, j), 1e-4);
+      }
+    }
+  }
+
+  // a full circle brings the object back
+  Eigen::Matrix<double, 5, 1> x(1.0, -2.0, 5.0, 0.7, M_PI);
+  ConstantTurnRatePredict(2.0, &x,
+                          static_cast<Eigen::Matrix<double, 5, 5> *>(nullptr));
+  EXPECT_NEAR(1.0, x(0), 1e-9);
+  EXPECT_NEAR(-2.0, x(1), 1e-9);
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Fixed-size motion models for the Kalman filters.
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "Eigen/Core"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @brief Fills the transition matrix of the constant velocity model, with
+ *        the state (x, y, vx, vy).
+ * @param dt The time step.
+ * @param F The transition matrix to fill.
+ */
+template <typename T>
+void ConstantVelocityTransition(const T dt, Eigen::Matrix<T, 4, 4> *F) {
+  F->setIdentity();
+  (*F)(0, 2) = dt;
+  (*F)(1, 3) = dt;
+}
+
+/**
+ * @brief Fills the transition noise of the constant velocity model, driven
+ *        by white noise acceleration.
+ * @param dt The time step.
+ * @param acceleration_variance Variance of the acceleration noise.
+ * @param Q The transition noise covariance to fill.
+ */
+template <typename T>
+void ConstantVelocityNoise(const T dt, const T acceleration_variance,
+                           Eigen::Matrix<T, 4, 4> *Q) {
+  const T dt2 = dt * dt;
+  const T q_pp = dt2 * dt2 / 4 * acceleration_variance;
+  const T q_pv = dt2 * dt / 2 * acceleration_variance;
+  const T q_vv = dt2 * acceleration_variance;
+  Q->setZero();
+  (*Q)(0, 0) = (*Q)(1, 1) = q_pp;
+  (*Q)(0, 2) = (*Q)(2, 0) = (*Q)(1, 3) = (*Q)(3, 1) = q_pv;
+  (*Q)(2, 2) = (*Q)(3, 3) = q_vv;
+}
+
+/**
+ * @brief Fills the transition matrix of the constant acceleration model, with
+ *        the state (x, y, vx, vy, ax, ay).
+ * @param dt The time step.
+ * @param F The transition matrix to fill.
+ */
+template <typename T>
+void ConstantAccelerationTransition(const T dt, Eigen::Matrix<T, 6, 6> *F) {
+  F->setIdentity();
+  (*F)(0, 2) = (*F)(1, 3) = (*F)(2, 4) = (*F)(3, 5) = dt;
+  (*F)(0, 4) = (*F)(1, 5) = dt * dt / 2;
+}
+
+/**
+ * @brief Fills the transition noise of the constant acceleration model,
+ *        driven by white noise jerk.
+ * @param dt The time step.
+ * @param jerk_variance Variance of the jerk noise.
+ * @param Q The transition noise covariance to fill.
+ */
+template <typename T>
+void ConstantAccelerationNoise(const T dt, const T jerk_variance,
+                               Eigen::Matrix<T, 6, 6> *Q) {
+  // noise gain of one axis, (dt^3 / 6, dt^2 / 2, dt)
+  const T g[3] = {dt * dt * dt / 6, dt * dt / 2, dt};
+  Q->setZero();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      (*Q)(2 * i, 2 * j) = (*Q)(2 * i + 1, 2 * j + 1) =
+          g[i] * g[j] * jerk_variance;
+    }
+  }
+}
+
+/**
+ * @brief Propagates the constant turn rate and velocity model, with the state
+ *        (x, y, v, yaw, yaw_rate), and fills its Jacobian.
+ * @param dt The time step.
+ * @param x The state to propagate in place.
+ * @param F The Jacobian of the transition at the state before propagation,
+ *        can be nullptr.
+ */
+template <typename T>
+void ConstantTurnRatePredict(const T dt, Eigen::Matrix<T, 5, 1> *x,
+                             Eigen::Matrix<T, 5, 5> *F) {
+  const T v = (*x)(2);
+  const T yaw = (*x)(3);
+  const T yaw_rate = (*x)(4);
+  const T sin_yaw = std::sin(yaw);
+  const T cos_yaw = std::cos(yaw);
+  const T yaw_end = yaw + yaw_rate * dt;
+  const T sin_end = std::sin(yaw_end);
+  const T cos_end = std::cos(yaw_end);
+
+  if (F != nullptr) {
+    F->setIdentity();
+  }
+  // below this turn rate the 1 / yaw_rate terms lose all precision, use
+  // their first order expansion in yaw_rate
+  if (std::abs(yaw_rate) < static_cast<T>(1e-4)) {
+    (*x)(0) += v * dt * (cos_yaw - sin_yaw * yaw_rate * dt / 2);
+    (*x)(1) += v * dt * (sin_yaw + cos_yaw * yaw_rate * dt / 2);
+    if (F != nullptr) {
+      (*F)(0, 2) = dt * (cos_yaw - sin_yaw * yaw_rate * dt / 2);
+      (*F)(0, 3) = -v * dt * (sin_yaw + cos_yaw * yaw_rate * dt / 2);
+      (*F)(0, 4) = -v * sin_yaw * dt * dt / 2;
+      (*F)(1, 2) = dt * (sin_yaw + cos_yaw * yaw_rate * dt / 2);
+      (*F)(1, 3) = v * dt * (cos_yaw - sin_yaw * yaw_rate * dt / 2);
+      (*F)(1, 4) = v * cos_yaw * dt * dt / 2;
+    }
+  } else {
+    const T radius = v / yaw_rate;
+    (*x)(0) += radius * (sin_end - sin_yaw);
+    (*x)(1) += radius * (cos_yaw - cos_end);
+    if (F != nullptr) {
+      (*F)(0, 2) = (sin_end - sin_yaw) / yaw_rate;
+      (*F)(0, 3) = radius * (cos_end - cos_yaw);
+      (*F)(0, 4) = radius * dt * cos_end -
+                   radius / yaw_rate * (sin_end - sin_yaw);
+      (*F)(1, 2) = (cos_yaw - cos_end) / yaw_rate;
+      (*F)(1, 3) = radius * (sin_end - sin_yaw);
+      (*F)(1, 4) = radius * dt * sin_end -
+                   radius / yaw_rate * (cos_yaw - cos_end);
+    }
+  }
+  (*x)(3) = yaw_end;
+  if (F != nullptr) {
+    (*F)(3, 4) = dt;
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
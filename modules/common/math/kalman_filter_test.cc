@@ -101,6 +101,27 @@ TEST_F(KalmanFilterTest, SyntheticTrackingTest) {
   EXPECT_NEAR(0.08826, state_cov(1, 1), 0.001);
 }
 
+TEST_F(KalmanFilterTest, InformationCorrectTest) {
+  KalmanFilter<double, 2, 1, 1> kf = kf_;
+  kf_.Predict();
+  kf.Predict();
+
+  Eigen::Matrix<double, 1, 1> z;
+  z(0, 0) = 1.3;
+  kf_.Correct(z);
+  kf.CorrectInformation(z, kf.GetObservationMatrix(),
+                        kf.GetObservationNoise());
+
+  const Eigen::Matrix<double, 2, 1> state = kf.GetStateEstimate();
+  const Eigen::Matrix<double, 2, 2> state_cov = kf.GetStateCovariance();
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_NEAR(kf_.GetStateEstimate()(i), state(i), 1e-9);
+    for (int j = 0; j < 2; ++j) {
+      EXPECT_NEAR(kf_.GetStateCovariance()(i, j), state_cov(i, j), 1e-9);
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
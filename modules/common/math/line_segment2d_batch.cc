@@ -0,0 +1,223 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/line_segment2d_batch.h"
+
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// Picks the nearest of the per lane results, the smallest index on ties.
+void ReduceLanes(const double *distance_square, const double *index,
+                 const int num_lanes, double *const min_distance_square,
+                 int *const min_index) {
+  for (int lane = 0; lane < num_lanes; ++lane) {
+    if (index[lane] < 0.0) {
+      continue;
+    }
+    const int lane_index = static_cast<int>(index[lane]);
+    if (*min_index < 0 || distance_square[lane] < *min_distance_square ||
+        (distance_square[lane] == *min_distance_square &&
+         lane_index < *min_index)) {
+      *min_distance_square = distance_square[lane];
+      *min_index = lane_index;
+    }
+  }
+}
+
+}  // namespace
+
+LineSegment2dBatch::LineSegment2dBatch(
+    const std::vector<LineSegment2d> &segments) {
+  Reserve(segments.size());
+  for (const auto &segment : segments) {
+    Add(segment);
+  }
+}
+
+void LineSegment2dBatch::Add(const LineSegment2d &segment) {
+  start_x_.push_back(segment.start().x());
+  start_y_.push_back(segment.start().y());
+  end_x_.push_back(segment.end().x());
+  end_y_.push_back(segment.end().y());
+  const bool degenerated = segment.length() <= kMathEpsilon;
+  unit_x_.push_back(degenerated ? 0.0 : segment.unit_direction().x());
+  unit_y_.push_back(degenerated ? 0.0 : segment.unit_direction().y());
+  length_.push_back(segment.length());
+}
+
+void LineSegment2dBatch::Clear() {
+  start_x_.clear();
+  start_y_.clear();
+  end_x_.clear();
+  end_y_.clear();
+  unit_x_.clear();
+  unit_y_.clear();
+  length_.clear();
+}
+
+void LineSegment2dBatch::Reserve(const size_t size) {
+  start_x_.reserve(size);
+  start_y_.reserve(size);
+  end_x_.reserve(size);
+  end_y_.reserve(size);
+  unit_x_.reserve(size);
+  unit_y_.reserve(size);
+  length_.reserve(size);
+}
+
+double LineSegment2dBatch::DistanceSquareAt(const Vec2d &point,
+                                            const size_t i) const {
+  const double x0 = point.x() - start_x_[i];
+  const double y0 = point.y() - start_y_[i];
+  const double proj = x0 * unit_x_[i] + y0 * unit_y_[i];
+  if (proj <= 0.0) {
+    return x0 * x0 + y0 * y0;
+  }
+  if (proj >= length_[i]) {
+    const double x1 = point.x() - end_x_[i];
+    const double y1 = point.y() - end_y_[i];
+    return x1 * x1 + y1 * y1;
+  }
+  const double cross = x0 * unit_y_[i] - y0 * unit_x_[i];
+  return cross * cross;
+}
+
+int LineSegment2dBatch::NearestSegment(
+    const Vec2d &point, double *const min_distance_square) const {
+  const size_t num_segments = size();
+  double min_distance = std::numeric_limits<double>::infinity();
+  int min_index = -1;
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  if (num_segments >= 4) {
+    const __m256d px = _mm256_set1_pd(point.x());
+    const __m256d py = _mm256_set1_pd(point.y());
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d step = _mm256_set1_pd(4.0);
+    __m256d index = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    __m256d best_distance =
+        _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d best_index = _mm256_set1_pd(-1.0);
+
+    for (; i + 4 <= num_segments; i += 4) {
+      const __m256d x0 = _mm256_sub_pd(px, _mm256_loadu_pd(&start_x_[i]));
+      const __m256d y0 = _mm256_sub_pd(py, _mm256_loadu_pd(&start_y_[i]));
+      const __m256d x1 = _mm256_sub_pd(px, _mm256_loadu_pd(&end_x_[i]));
+      const __m256d y1 = _mm256_sub_pd(py, _mm256_loadu_pd(&end_y_[i]));
+      const __m256d ux = _mm256_loadu_pd(&unit_x_[i]);
+      const __m256d uy = _mm256_loadu_pd(&unit_y_[i]);
+      const __m256d proj =
+          _mm256_add_pd(_mm256_mul_pd(x0, ux), _mm256_mul_pd(y0, uy));
+      const __m256d cross =
+          _mm256_sub_pd(_mm256_mul_pd(x0, uy), _mm256_mul_pd(y0, ux));
+
+      // Same branches as DistanceSquareTo, the start point wins over the end.
+      __m256d distance = _mm256_mul_pd(cross, cross);
+      distance = _mm256_blendv_pd(
+          distance,
+          _mm256_add_pd(_mm256_mul_pd(x1, x1), _mm256_mul_pd(y1, y1)),
+          _mm256_cmp_pd(proj, _mm256_loadu_pd(&length_[i]), _CMP_GE_OQ));
+      distance = _mm256_blendv_pd(
+          distance,
+          _mm256_add_pd(_mm256_mul_pd(x0, x0), _mm256_mul_pd(y0, y0)),
+          _mm256_cmp_pd(proj, zero, _CMP_LE_OQ));
+
+      const __m256d closer = _mm256_cmp_pd(distance, best_distance, _CMP_LT_OQ);
+      best_distance = _mm256_blendv_pd(best_distance, distance, closer);
+      best_index = _mm256_blendv_pd(best_index, index, closer);
+      index = _mm256_add_pd(index, step);
+    }
+
+    double lane_distance[4];
+    double lane_index[4];
+    _mm256_storeu_pd(lane_distance, best_distance);
+    _mm256_storeu_pd(lane_index, best_index);
+    ReduceLanes(lane_distance, lane_index, 4, &min_distance, &min_index);
+  }
+#elif defined(__aarch64__)
+  if (num_segments >= 2) {
+    const float64x2_t px = vdupq_n_f64(point.x());
+    const float64x2_t py = vdupq_n_f64(point.y());
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t step = vdupq_n_f64(2.0);
+    const double first_index[2] = {0.0, 1.0};
+    float64x2_t index = vld1q_f64(first_index);
+    float64x2_t best_distance =
+        vdupq_n_f64(std::numeric_limits<double>::infinity());
+    float64x2_t best_index = vdupq_n_f64(-1.0);
+
+    for (; i + 2 <= num_segments; i += 2) {
+      const float64x2_t x0 = vsubq_f64(px, vld1q_f64(&start_x_[i]));
+      const float64x2_t y0 = vsubq_f64(py, vld1q_f64(&start_y_[i]));
+      const float64x2_t x1 = vsubq_f64(px, vld1q_f64(&end_x_[i]));
+      const float64x2_t y1 = vsubq_f64(py, vld1q_f64(&end_y_[i]));
+      const float64x2_t ux = vld1q_f64(&unit_x_[i]);
+      const float64x2_t uy = vld1q_f64(&unit_y_[i]);
+      const float64x2_t proj =
+          vaddq_f64(vmulq_f64(x0, ux), vmulq_f64(y0, uy));
+      const float64x2_t cross =
+          vsubq_f64(vmulq_f64(x0, uy), vmulq_f64(y0, ux));
+
+      // Same branches as DistanceSquareTo, the start point wins over the end.
+      float64x2_t distance = vmulq_f64(cross, cross);
+      distance = vbslq_f64(vcgeq_f64(proj, vld1q_f64(&length_[i])),
+                           vaddq_f64(vmulq_f64(x1, x1), vmulq_f64(y1, y1)),
+                           distance);
+      distance = vbslq_f64(vcleq_f64(proj, zero),
+                           vaddq_f64(vmulq_f64(x0, x0), vmulq_f64(y0, y0)),
+                           distance);
+
+      const uint64x2_t closer = vcltq_f64(distance, best_distance);
+      best_distance = vbslq_f64(closer, distance, best_distance);
+      best_index = vbslq_f64(closer, index, best_index);
+      index = vaddq_f64(index, step);
+    }
+
+    double lane_distance[2];
+    double lane_index[2];
+    vst1q_f64(lane_distance, best_distance);
+    vst1q_f64(lane_index, best_index);
+    ReduceLanes(lane_distance, lane_index, 2, &min_distance, &min_index);
+  }
+#endif
+
+  for (; i < num_segments; ++i) {
+    const double distance = DistanceSquareAt(point, i);
+    if (min_index < 0 || distance < min_distance) {
+      min_distance = distance;
+      min_index = static_cast<int>(i);
+    }
+  }
+  if (min_distance_square != nullptr) {
+    *min_distance_square = min_distance;
+  }
+  return min_index;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
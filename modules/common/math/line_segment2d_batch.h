@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The class of LineSegment2dBatch, a set of line segments laid out for
+ *        finding the nearest one to a point.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/vec2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class LineSegment2dBatch
+ * @brief A set of LineSegment2d stored as structure of arrays.
+ *
+ * The nearest segment search evaluates the same distance as
+ * LineSegment2d::DistanceSquareTo, with AVX2 on x86 and NEON on aarch64
+ * handling several segments per instruction.
+ */
+class LineSegment2dBatch {
+ public:
+  LineSegment2dBatch() = default;
+
+  /**
+   * @brief Constructor which takes the segments of the batch.
+   * @param segments The segments of the batch.
+   */
+  explicit LineSegment2dBatch(const std::vector<LineSegment2d> &segments);
+
+  /**
+   * @brief Append a segment to the batch.
+   * @param segment The segment to append.
+   */
+  void Add(const LineSegment2d &segment);
+
+  /**
+   * @brief Remove all the segments from the batch.
+   */
+  void Clear();
+
+  /**
+   * @brief Reserve space for segments.
+   * @param size The number of segments to reserve space for.
+   */
+  void Reserve(const size_t size);
+
+  /**
+   * @brief Getter of the number of segments in the batch.
+   * @return The number of segments in the batch.
+   */
+  size_t size() const { return start_x_.size(); }
+
+  /**
+   * @brief Check if the batch has no segment.
+   * @return True if the batch has no segment.
+   */
+  bool empty() const { return start_x_.empty(); }
+
+  /**
+   * @brief Find the segment of the batch nearest to a point.
+   * @param point The point to search with.
+   * @param min_distance_square The squared distance from the point to the
+   *        nearest segment, if not nullptr.
+   * @return The index of the nearest segment, the smallest one on ties, or -1
+   *         if the batch is empty.
+   */
+  int NearestSegment(const Vec2d &point,
+                     double *const min_distance_square) const;
+
+ private:
+  double DistanceSquareAt(const Vec2d &point, const size_t index) const;
+
+  std::vector<double> start_x_;
+  std::vector<double> start_y_;
+  std::vector<double> end_x_;
+  std::vector<double> end_y_;
+  // The unit directions are zero for degenerated segments, so that their
+  // projection always falls on the start point.
+  std::vector<double> unit_x_;
+  std::vector<double> unit_y_;
+  std::vector<double> length_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
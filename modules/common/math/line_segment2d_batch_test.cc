@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/line_segment2d_batch.h"
+
+#include <random>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(LineSegment2dBatchTest, Empty) {
+  LineSegment2dBatch batch;
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0, batch.size());
+  EXPECT_EQ(-1, batch.NearestSegment({0, 0}, nullptr));
+}
+
+TEST(LineSegment2dBatchTest, NearestSegment) {
+  LineSegment2dBatch batch(
+      {LineSegment2d({0, 0}, {10, 0}), LineSegment2d({10, 0}, {10, 10}),
+       LineSegment2d({10, 10}, {0, 10}), LineSegment2d({0, 10}, {0, 0}),
+       LineSegment2d({5, 5}, {5, 5})});
+  EXPECT_EQ(5, batch.size());
+  double distance_square = 0.0;
+  EXPECT_EQ(0, batch.NearestSegment({3, -1}, &distance_square));
+  EXPECT_NEAR(1.0, distance_square, 1e-9);
+  EXPECT_EQ(1, batch.NearestSegment({12, 4}, &distance_square));
+  EXPECT_NEAR(4.0, distance_square, 1e-9);
+  EXPECT_EQ(2, batch.NearestSegment({6, 9}, &distance_square));
+  EXPECT_NEAR(1.0, distance_square, 1e-9);
+  EXPECT_EQ(4, batch.NearestSegment({5, 4.5}, &distance_square));
+  EXPECT_NEAR(0.25, distance_square, 1e-9);
+  // The corner is as far from both segments, the first one is picked.
+  EXPECT_EQ(0, batch.NearestSegment({-1, -1}, &distance_square));
+  EXPECT_NEAR(2.0, distance_square, 1e-9);
+
+  batch.Clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(-1, batch.NearestSegment({3, -1}, &distance_square));
+}
+
+TEST(LineSegment2dBatchTest, SameAsLineSegment2d) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> position(-20.0, 20.0);
+  for (int i = 0; i < 2000; ++i) {
+    std::vector<LineSegment2d> segments;
+    const int num_segments = 1 + i % 13;
+    Vec2d start(position(generator), position(generator));
+    for (int j = 0; j < num_segments; ++j) {
+      // Repeat some points to get degenerated segments.
+      const Vec2d end = (j % 5 == 4)
+                            ? start
+                            : Vec2d(position(generator), position(generator));
+      segments.emplace_back(start, end);
+      start = end;
+    }
+    const Vec2d point(position(generator), position(generator));
+
+    int expected_index = -1;
+    double expected_distance = 0.0;
+    for (int j = 0; j < num_segments; ++j) {
+      const double distance = segments[j].DistanceSquareTo(point);
+      if (expected_index < 0 || distance < expected_distance) {
+        expected_index = j;
+        expected_distance = distance;
+      }
+    }
+    LineSegment2dBatch batch(segments);
+    double distance_square = 0.0;
+    EXPECT_EQ(expected_index, batch.NearestSegment(point, &distance_square));
+    EXPECT_DOUBLE_EQ(expected_distance, distance_square);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
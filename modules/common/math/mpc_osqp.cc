@@ -50,6 +50,50 @@ MpcOsqp::MpcOsqp(const Eigen::MatrixXd &matrix_a,
   num_param_ = state_dim_ * (horizon_ + 1) + control_dim_ * horizon_;
 }
 
+MpcOsqp::~MpcOsqp() { CleanupWorkspace(); }
+
+void MpcOsqp::UpdateProblem(const Eigen::MatrixXd &matrix_a,
+                            const Eigen::MatrixXd &matrix_b,
+                            const Eigen::MatrixXd &matrix_q,
+                            const Eigen::MatrixXd &matrix_r,
+                            const Eigen::MatrixXd &matrix_initial_x,
+                            const Eigen::MatrixXd &matrix_u_lower,
+                            const Eigen::MatrixXd &matrix_u_upper,
+                            const Eigen::MatrixXd &matrix_x_lower,
+                            const Eigen::MatrixXd &matrix_x_upper,
+                            const Eigen::MatrixXd &matrix_x_ref) {
+  CHECK_EQ(static_cast<size_t>(matrix_b.rows()), state_dim_);
+  CHECK_EQ(static_cast<size_t>(matrix_b.cols()), control_dim_);
+  matrix_a_ = matrix_a;
+  matrix_b_ = matrix_b;
+  matrix_q_ = matrix_q;
+  matrix_r_ = matrix_r;
+  matrix_initial_x_ = matrix_initial_x;
+  matrix_u_lower_ = matrix_u_lower;
+  matrix_u_upper_ = matrix_u_upper;
+  matrix_x_lower_ = matrix_x_lower;
+  matrix_x_upper_ = matrix_x_upper;
+  matrix_x_ref_ = matrix_x_ref;
+}
+
+void MpcOsqp::EnablePersistentWorkspace(const bool enable) {
+  persistent_workspace_ = enable;
+  if (!enable) {
+    CleanupWorkspace();
+  }
+}
+
+void MpcOsqp::CleanupWorkspace() {
+  if (workspace_ != nullptr) {
+    osqp_cleanup(workspace_);
+    workspace_ = nullptr;
+  }
+  P_indices_.clear();
+  P_indptr_.clear();
+  A_indices_.clear();
+  A_indptr_.clear();
+}
+
 void MpcOsqp::CalculateKernel(std::vector<c_float> *P_data,
                               std::vector<c_int> *P_indices,
                               std::vector<c_int> *P_indptr) {
@@ -284,6 +328,9 @@ bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
   ADEBUG << "After Calc Gradient";
   CalculateConstraintVectors();
   ADEBUG << "MPC2Matrix";
+  if (persistent_workspace_) {
+    return SolveWithPersistentWorkspace(control_cmd);
+  }
 
   OSQPData *data = Data();
   ADEBUG << "OSQP data done";
@@ -339,6 +386,89 @@ bool MpcOsqp::Solve(std::vector<double> *control_cmd) {
   return true;
 }
 
+bool MpcOsqp::SolveWithPersistentWorkspace(std::vector<double> *control_cmd) {
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  CalculateEqualityConstraint(&A_data, &A_indices, &A_indptr);
+
+  // The matrix values can only be updated in place while the entries of A,B
+  // that are zero stay the same.
+  if (workspace_ != nullptr && P_indices == P_indices_ &&
+      P_indptr == P_indptr_ && A_indices == A_indices_ &&
+      A_indptr == A_indptr_) {
+    osqp_update_lin_cost(workspace_, gradient_.data());
+    osqp_update_bounds(workspace_, lowerBound_.data(), upperBound_.data());
+    osqp_update_P_A(workspace_, P_data.data(), OSQP_NULL,
+                    static_cast<c_int>(P_data.size()), A_data.data(),
+                    OSQP_NULL, static_cast<c_int>(A_data.size()));
+    WarmStartFromShiftedSolution();
+  } else {
+    CleanupWorkspace();
+    OSQPData *data = Data();
+    OSQPSettings *settings = Settings();
+    // The workspace keeps its own copy of the data.
+    workspace_ = osqp_setup(data, settings);
+    FreeData(data);
+    c_free(settings);
+    if (workspace_ == nullptr) {
+      AERROR << "Failed to set up the OSQP workspace";
+      return false;
+    }
+    P_indices_ = std::move(P_indices);
+    P_indptr_ = std::move(P_indptr);
+    A_indices_ = std::move(A_indices);
+    A_indptr_ = std::move(A_indptr);
+  }
+  osqp_solve(workspace_);
+
+  auto status = workspace_->info->status_val;
+  ADEBUG << "status:" << status;
+  if (status < 0 || (status != 1 && status != 2)) {
+    AERROR << "failed optimization status:\t" << workspace_->info->status;
+    // Do not warm start the next problem from a failed solution.
+    CleanupWorkspace();
+    return false;
+  } else if (workspace_->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    CleanupWorkspace();
+    return false;
+  }
+
+  size_t first_control = state_dim_ * (horizon_ + 1);
+  for (size_t i = 0; i < control_dim_; ++i) {
+    control_cmd->at(i) = workspace_->solution->x[i + first_control];
+    ADEBUG << "control_cmd:" << i << ":" << control_cmd->at(i);
+  }
+  return true;
+}
+
+void MpcOsqp::WarmStartFromShiftedSolution() {
+  // The previous plan one step later: every state and control moves one step
+  // earlier and the last ones are repeated, the first state is the new
+  // initial state.
+  const c_float *x = workspace_->solution->x;
+  std::vector<c_float> shifted(x, x + num_param_);
+  for (size_t i = 0; i < horizon_; ++i) {
+    std::copy(x + (i + 1) * state_dim_, x + (i + 2) * state_dim_,
+              shifted.begin() + i * state_dim_);
+  }
+  for (size_t j = 0; j < state_dim_; ++j) {
+    shifted[j] = matrix_initial_x_(j, 0);
+  }
+  const size_t first_control = state_dim_ * (horizon_ + 1);
+  for (size_t i = 0; i + 1 < horizon_; ++i) {
+    std::copy(x + first_control + (i + 1) * control_dim_,
+              x + first_control + (i + 2) * control_dim_,
+              shifted.begin() + first_control + i * control_dim_);
+  }
+  osqp_warm_start_x(workspace_, shifted.data());
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
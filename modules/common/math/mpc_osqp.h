@@ -52,6 +52,33 @@ class MpcOsqp {
           const Eigen::MatrixXd &matrix_x_ref, const int max_iter,
           const int horizon, const double eps_abs);
 
+  ~MpcOsqp();
+
+  MpcOsqp(const MpcOsqp &) = delete;
+  MpcOsqp &operator=(const MpcOsqp &) = delete;
+
+  /**
+   * @brief Replace the problem of the next Solve, the state and control
+   *        dimensions stay the ones of the constructor.
+   */
+  void UpdateProblem(const Eigen::MatrixXd &matrix_a,
+                     const Eigen::MatrixXd &matrix_b,
+                     const Eigen::MatrixXd &matrix_q,
+                     const Eigen::MatrixXd &matrix_r,
+                     const Eigen::MatrixXd &matrix_initial_x,
+                     const Eigen::MatrixXd &matrix_u_lower,
+                     const Eigen::MatrixXd &matrix_u_upper,
+                     const Eigen::MatrixXd &matrix_x_lower,
+                     const Eigen::MatrixXd &matrix_x_upper,
+                     const Eigen::MatrixXd &matrix_x_ref);
+
+  /**
+   * @brief Keep the OSQP workspace between Solve calls. The next calls only
+   *        update the vectors and matrix values of the workspace and warm
+   *        start from the previous solution shifted by one step.
+   */
+  void EnablePersistentWorkspace(const bool enable);
+
   // control vector
   bool Solve(std::vector<double> *control_cmd);
 
@@ -67,6 +94,9 @@ class MpcOsqp {
   OSQPSettings *Settings();
   OSQPData *Data();
   void FreeData(OSQPData *data);
+  bool SolveWithPersistentWorkspace(std::vector<double> *control_cmd);
+  void WarmStartFromShiftedSolution();
+  void CleanupWorkspace();
 
   template <typename T>
   T *CopyData(const std::vector<T> &vec) {
@@ -81,11 +111,11 @@ class MpcOsqp {
   Eigen::MatrixXd matrix_q_;
   Eigen::MatrixXd matrix_r_;
   Eigen::MatrixXd matrix_initial_x_;
-  const Eigen::MatrixXd matrix_u_lower_;
-  const Eigen::MatrixXd matrix_u_upper_;
-  const Eigen::MatrixXd matrix_x_lower_;
-  const Eigen::MatrixXd matrix_x_upper_;
-  const Eigen::MatrixXd matrix_x_ref_;
+  Eigen::MatrixXd matrix_u_lower_;
+  Eigen::MatrixXd matrix_u_upper_;
+  Eigen::MatrixXd matrix_x_lower_;
+  Eigen::MatrixXd matrix_x_upper_;
+  Eigen::MatrixXd matrix_x_ref_;
   int max_iteration_;
   size_t horizon_;
   double eps_abs_;
@@ -96,6 +126,14 @@ class MpcOsqp {
   Eigen::VectorXd gradient_;
   Eigen::VectorXd lowerBound_;
   Eigen::VectorXd upperBound_;
+
+  bool persistent_workspace_ = false;
+  OSQPWorkspace *workspace_ = nullptr;
+  // Sparsity patterns of the kernel and constraint matrices in workspace_.
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
 };
 }  // namespace math
 }  // namespace common
@@ -174,6 +174,67 @@ TEST(MPCOSQPSolverTest, NullMatrix) {
   EXPECT_NEAR(0.0, control_cmd[0], 1e-7);
 }
 
+TEST(MPCOSQPSolverTest, PersistentWorkspace) {
+  const int states = 2;
+  const int controls = 1;
+  const int horizon = 10;
+  const int max_iter = 1000;
+  const double eps = 0.0001;
+  const double max = std::numeric_limits<double>::max();
+
+  Eigen::MatrixXd A(states, states);
+  A << 1, 0.1, 0, 1;
+
+  Eigen::MatrixXd B(states, controls);
+  B << 0.005, 0.1;
+
+  Eigen::MatrixXd Q(states, states);
+  Q << 10, 0, 0, 1;
+
+  Eigen::MatrixXd R(controls, controls);
+  R << 0.1;
+
+  Eigen::MatrixXd lower_bound(controls, 1);
+  lower_bound << -2;
+
+  Eigen::MatrixXd upper_bound(controls, 1);
+  upper_bound << 2;
+
+  Eigen::MatrixXd reference_state(states, 1);
+  reference_state << 0, 0;
+
+  Eigen::MatrixXd state_lower_bound(states, 1);
+  state_lower_bound << -max, -max;
+
+  Eigen::MatrixXd state_upper_bound(states, 1);
+  state_upper_bound << max, max;
+
+  Eigen::MatrixXd initial_state(states, 1);
+  initial_state << 1, 0;
+
+  MpcOsqp persistent_solver(A, B, Q, R, initial_state, lower_bound,
+                            upper_bound, state_lower_bound, state_upper_bound,
+                            reference_state, max_iter, horizon, eps);
+  persistent_solver.EnablePersistentWorkspace(true);
+  for (int cycle = 0; cycle < 5; ++cycle) {
+    // The same problem as the controller sees it a few cycles later.
+    initial_state << 1.0 - 0.1 * cycle, 0.2 * cycle;
+    A(0, 1) = 0.1 + 0.01 * cycle;
+    persistent_solver.UpdateProblem(A, B, Q, R, initial_state, lower_bound,
+                                    upper_bound, state_lower_bound,
+                                    state_upper_bound, reference_state);
+    std::vector<double> persistent_cmd(controls, 0);
+    EXPECT_TRUE(persistent_solver.Solve(&persistent_cmd));
+
+    MpcOsqp fresh_solver(A, B, Q, R, initial_state, lower_bound, upper_bound,
+                         state_lower_bound, state_upper_bound,
+                         reference_state, max_iter, horizon, eps);
+    std::vector<double> fresh_cmd(controls, 0);
+    EXPECT_TRUE(fresh_solver.Solve(&fresh_cmd));
+    EXPECT_NEAR(fresh_cmd[0], persistent_cmd[0], 1e-2);
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
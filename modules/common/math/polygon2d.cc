@@ -42,6 +42,9 @@ Polygon2d::Polygon2d(std::vector<Vec2d> points) : points_(std::move(points)) {
 
 double Polygon2d::DistanceTo(const Vec2d &point) const {
   CHECK_GE(points_.size(), 3);
+  if (!vertices_.has_degenerated_edge()) {
+    return std::sqrt(vertices_.DistanceSquareTo(point));
+  }
   if (IsPointIn(point)) {
     return 0.0;
   }
@@ -54,6 +57,9 @@ double Polygon2d::DistanceTo(const Vec2d &point) const {
 
 double Polygon2d::DistanceSquareTo(const Vec2d &point) const {
   CHECK_GE(points_.size(), 3);
+  if (!vertices_.has_degenerated_edge()) {
+    return vertices_.DistanceSquareTo(point);
+  }
   if (IsPointIn(point)) {
     return 0.0;
   }
@@ -111,11 +117,7 @@ double Polygon2d::DistanceTo(const Polygon2d &polygon) const {
 }
 
 double Polygon2d::DistanceToBoundary(const Vec2d &point) const {
-  double distance = std::numeric_limits<double>::infinity();
-  for (int i = 0; i < num_points_; ++i) {
-    distance = std::min(distance, line_segments_[i].DistanceTo(point));
-  }
-  return distance;
+  return std::sqrt(vertices_.DistanceSquareToBoundary(point));
 }
 
 bool Polygon2d::IsPointOnBoundary(const Vec2d &point) const {
@@ -127,6 +129,9 @@ bool Polygon2d::IsPointOnBoundary(const Vec2d &point) const {
 
 bool Polygon2d::IsPointIn(const Vec2d &point) const {
   CHECK_GE(points_.size(), 3);
+  if (!vertices_.has_degenerated_edge()) {
+    return vertices_.IsPointIn(point);
+  }
   if (IsPointOnBoundary(point)) {
     return true;
   }
@@ -144,12 +149,64 @@ bool Polygon2d::IsPointIn(const Vec2d &point) const {
   return c & 1;
 }
 
+void Polygon2d::IsPointIn(const std::vector<Vec2d> &points,
+                          std::vector<bool> *const inside) const {
+  CHECK_GE(points_.size(), 3);
+  CHECK_NOTNULL(inside);
+  if (vertices_.has_degenerated_edge()) {
+    inside->resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      (*inside)[i] = IsPointIn(points[i]);
+    }
+    return;
+  }
+  std::vector<unsigned char> is_in;
+  vertices_.IsPointIn(points, &is_in);
+  inside->assign(is_in.begin(), is_in.end());
+}
+
+void Polygon2d::DistanceTo(const std::vector<Vec2d> &points,
+                           std::vector<double> *const distances) const {
+  CHECK_GE(points_.size(), 3);
+  CHECK_NOTNULL(distances);
+  if (vertices_.has_degenerated_edge()) {
+    distances->resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      (*distances)[i] = DistanceTo(points[i]);
+    }
+    return;
+  }
+  vertices_.DistanceSquareTo(points, distances);
+  for (double &distance : *distances) {
+    distance = std::sqrt(distance);
+  }
+}
+
 bool Polygon2d::HasOverlap(const Polygon2d &polygon) const {
   CHECK_GE(points_.size(), 3);
   if (polygon.max_x() < min_x() || polygon.min_x() > max_x() ||
       polygon.max_y() < min_y() || polygon.min_y() > max_y()) {
     return false;
   }
+  if (is_convex_ && polygon.is_convex()) {
+    // Separating axis test on the edge normals, the distance below only
+    // decides the touching cases.
+    double separation = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < num_points_; ++i) {
+      separation =
+          std::max(separation, vertices_.SeparationAlong(i, polygon.vertices_));
+    }
+    for (int i = 0; i < polygon.num_points(); ++i) {
+      separation =
+          std::max(separation, polygon.vertices_.SeparationAlong(i, vertices_));
+    }
+    if (separation > kMathEpsilon) {
+      return false;
+    }
+    if (separation < 0.0) {
+      return true;
+    }
+  }
   return DistanceTo(polygon) <= kMathEpsilon;
 }
 
@@ -237,6 +294,8 @@ void Polygon2d::BuildFromPoints() {
     min_y_ = std::min(min_y_, point.y());
     max_y_ = std::max(max_y_, point.y());
   }
+
+  vertices_.Build(points_);
 }
 
 bool Polygon2d::ComputeConvexHull(const std::vector<Vec2d> &points,
@@ -336,6 +395,15 @@ bool Polygon2d::ComputeOverlap(const Polygon2d &other_polygon,
   CHECK_GE(points_.size(), 3);
   CHECK_NOTNULL(overlap_polygon);
   ACHECK(is_convex_ && other_polygon.is_convex());
+  // Clipping by an edge with all the other vertices outside of it beyond
+  // the tolerance of ClipConvexHull leaves nothing.
+  for (int i = 0; i < num_points_; ++i) {
+    if (vertices_.SeparationAlong(i, other_polygon.vertices_) *
+            vertices_.length(i) >
+        kMathEpsilon) {
+      return false;
+    }
+  }
   std::vector<Vec2d> points = other_polygon.points();
   for (int i = 0; i < num_points_; ++i) {
     if (!ClipConvexHull(line_segments_[i], &points)) {
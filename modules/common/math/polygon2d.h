@@ -26,6 +26,7 @@
 
 #include "modules/common/math/box2d.h"
 #include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/polygon2d_vertices.h"
 #include "modules/common/math/vec2d.h"
 
 /**
@@ -160,6 +161,24 @@ class Polygon2d {
    */
   bool IsPointIn(const Vec2d &point) const;
 
+  /**
+   * @brief Check which of many points are within the polygon, with the same
+   *        result as IsPointIn on each of them.
+   * @param points The target points.
+   * @param inside Whether each point is within the polygon or not.
+   */
+  void IsPointIn(const std::vector<Vec2d> &points,
+                 std::vector<bool> *const inside) const;
+
+  /**
+   * @brief Compute the distances from many points to the polygon, with the
+   *        same result as DistanceTo on each of them.
+   * @param points The points to compute whose distances to the polygon.
+   * @param distances The distances from the points to the polygon.
+   */
+  void DistanceTo(const std::vector<Vec2d> &points,
+                  std::vector<double> *const distances) const;
+
   /**
    * @brief Check if a point is on the boundary of the polygon.
    * @param point The target point. To check if it is on the boundary
@@ -334,6 +353,8 @@ class Polygon2d {
   double max_x_ = 0.0;
   double min_y_ = 0.0;
   double max_y_ = 0.0;
+  // The vertices laid out for the vectorized queries.
+  Polygon2dVertices vertices_;
 };
 
 }  // namespace math
@@ -17,6 +17,7 @@
 #include "modules/common/math/polygon2d.h"
 
 #include <algorithm>
+#include <random>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -197,6 +198,25 @@ TEST(Polygon2dTest, DistanceToPoint) {
   EXPECT_NEAR(poly3.DistanceTo({4.5, 1.0}), 0.5, 1e-5);
 }
 
+TEST(Polygon2dTest, BatchPointQueries) {
+  const Polygon2d poly({{0, 0}, {4, 0}, {4, 4}, {2, 1}, {0, 4}});
+  const std::vector<Vec2d> points{{1, 1},  {2, 1},  {2, 2}, {5, 5},
+                                  {-1, 2}, {3, 0.5}, {4, 2}, {2, -3}};
+  std::vector<bool> inside;
+  std::vector<double> distances;
+  poly.IsPointIn(points, &inside);
+  poly.DistanceTo(points, &distances);
+  ASSERT_EQ(points.size(), inside.size());
+  ASSERT_EQ(points.size(), distances.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(poly.IsPointIn(points[i]), inside[i]);
+    EXPECT_DOUBLE_EQ(poly.DistanceTo(points[i]), distances[i]);
+  }
+  EXPECT_TRUE(inside[1]);
+  EXPECT_FALSE(inside[2]);
+  EXPECT_NEAR(distances[7], 3.0, 1e-5);
+}
+
 TEST(Polygon2dTest, DistanceToLineSegment) {
   const Polygon2d poly1(Box2d::CreateAABox({0, 0}, {1, 1}));
   EXPECT_NEAR(poly1.DistanceTo({{0.5, 0.5}, {1.0, 1.0}}), 0.0, 1e-5);
@@ -595,6 +615,30 @@ TEST(Polygon2dTest, Overlap) {
   }
 }
 
+TEST(Polygon2dTest, ConvexOverlapMatchesDistance) {
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> coordinate(-8.0, 8.0);
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 5.0);
+  for (int i = 0; i < 500; ++i) {
+    const Polygon2d poly1(Box2d({coordinate(rng), coordinate(rng)},
+                                heading(rng), size(rng), size(rng)));
+    const Polygon2d poly2(Box2d({coordinate(rng), coordinate(rng)},
+                                heading(rng), size(rng), size(rng)));
+    const bool overlap = poly1.DistanceTo(poly2) <= kMathEpsilon;
+    EXPECT_EQ(overlap, poly1.HasOverlap(poly2));
+    EXPECT_EQ(overlap, poly2.HasOverlap(poly1));
+    Polygon2d overlap_polygon;
+    if (!overlap) {
+      EXPECT_FALSE(poly1.ComputeOverlap(poly2, &overlap_polygon));
+    }
+  }
+  // touching boxes still overlap
+  const Polygon2d box1(Box2d({0, 0}, 0, 2, 2));
+  const Polygon2d box2(Box2d({2, 1}, 0, 2, 2));
+  EXPECT_TRUE(box1.HasOverlap(box2));
+}
+
 TEST(Polygon2dTest, BoundingBox) {
   Polygon2d poly1(Box2d::CreateAABox({0, 0}, {2, 2}));
   Box2d box = poly1.BoundingBoxWithHeading(0.0);
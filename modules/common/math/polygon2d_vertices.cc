@@ -0,0 +1,537 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/polygon2d_vertices.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "modules/common/math/math_utils.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// Same as the bounds check of LineSegment2d::IsPointIn.
+bool IsWithin(double val, double bound1, double bound2) {
+  if (bound1 > bound2) {
+    std::swap(bound1, bound2);
+  }
+  return val >= bound1 - kMathEpsilon && val <= bound2 + kMathEpsilon;
+}
+
+}  // namespace
+
+void Polygon2dVertices::Build(const std::vector<Vec2d> &points) {
+  const size_t num_points = points.size();
+  x_.resize(num_points + 1);
+  y_.resize(num_points + 1);
+  unit_x_.resize(num_points);
+  unit_y_.resize(num_points);
+  length_.resize(num_points);
+  has_degenerated_edge_ = false;
+  for (size_t i = 0; i < num_points; ++i) {
+    x_[i] = points[i].x();
+    y_[i] = points[i].y();
+  }
+  if (num_points == 0) {
+    return;
+  }
+  x_[num_points] = x_[0];
+  y_[num_points] = y_[0];
+  for (size_t i = 0; i < num_points; ++i) {
+    // Same as the LineSegment2d constructor.
+    const double dx = x_[i + 1] - x_[i];
+    const double dy = y_[i + 1] - y_[i];
+    length_[i] = hypot(dx, dy);
+    if (length_[i] <= kMathEpsilon) {
+      unit_x_[i] = 0.0;
+      unit_y_[i] = 0.0;
+      has_degenerated_edge_ = true;
+    } else {
+      unit_x_[i] = dx / length_[i];
+      unit_y_[i] = dy / length_[i];
+    }
+  }
+}
+
+void Polygon2dVertices::QueryEdge(const double x, const double y,
+                                  const size_t i, bool *const on_boundary,
+                                  int *const crossings,
+                                  double *const distance_square) const {
+  const double x0 = x - x_[i];
+  const double y0 = y - y_[i];
+  const double x1 = x - x_[i + 1];
+  const double y1 = y - y_[i + 1];
+  // CrossProd(point, start, end), bitwise the same value.
+  const double prod = x0 * y1 - y0 * x1;
+  if (std::abs(prod) <= kMathEpsilon && IsWithin(x, x_[i], x_[i + 1]) &&
+      IsWithin(y, y_[i], y_[i + 1])) {
+    *on_boundary = true;
+  }
+  if ((y_[i + 1] > y) != (y_[i] > y) &&
+      (y_[i + 1] < y_[i] ? prod < 0.0 : prod > 0.0)) {
+    ++*crossings;
+  }
+  const double proj = x0 * unit_x_[i] + y0 * unit_y_[i];
+  double distance = 0.0;
+  if (proj <= 0.0) {
+    distance = x0 * x0 + y0 * y0;
+  } else if (proj >= length_[i]) {
+    distance = x1 * x1 + y1 * y1;
+  } else {
+    const double cross = x0 * unit_y_[i] - y0 * unit_x_[i];
+    distance = cross * cross;
+  }
+  *distance_square = std::min(*distance_square, distance);
+}
+
+void Polygon2dVertices::Query(const Vec2d &point, bool *const on_boundary,
+                              int *const crossings,
+                              double *const distance_square) const {
+  const size_t num_edges = size();
+  *on_boundary = false;
+  *crossings = 0;
+  *distance_square = std::numeric_limits<double>::infinity();
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  if (num_edges >= 4) {
+    const __m256d px = _mm256_set1_pd(point.x());
+    const __m256d py = _mm256_set1_pd(point.y());
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d epsilon = _mm256_set1_pd(kMathEpsilon);
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    __m256d boundary = _mm256_setzero_pd();
+    __m256d best_distance =
+        _mm256_set1_pd(std::numeric_limits<double>::infinity());
+
+    for (; i + 4 <= num_edges; i += 4) {
+      const __m256d sx = _mm256_loadu_pd(&x_[i]);
+      const __m256d sy = _mm256_loadu_pd(&y_[i]);
+      const __m256d ex = _mm256_loadu_pd(&x_[i + 1]);
+      const __m256d ey = _mm256_loadu_pd(&y_[i + 1]);
+      const __m256d x0 = _mm256_sub_pd(px, sx);
+      const __m256d y0 = _mm256_sub_pd(py, sy);
+      const __m256d x1 = _mm256_sub_pd(px, ex);
+      const __m256d y1 = _mm256_sub_pd(py, ey);
+      const __m256d prod =
+          _mm256_sub_pd(_mm256_mul_pd(x0, y1), _mm256_mul_pd(y0, x1));
+
+      // Same checks as LineSegment2d::IsPointIn.
+      __m256d on_edge = _mm256_cmp_pd(_mm256_andnot_pd(sign_mask, prod),
+                                      epsilon, _CMP_LE_OQ);
+      on_edge = _mm256_and_pd(
+          on_edge,
+          _mm256_cmp_pd(px, _mm256_sub_pd(_mm256_min_pd(sx, ex), epsilon),
+                        _CMP_GE_OQ));
+      on_edge = _mm256_and_pd(
+          on_edge,
+          _mm256_cmp_pd(px, _mm256_add_pd(_mm256_max_pd(sx, ex), epsilon),
+                        _CMP_LE_OQ));
+      on_edge = _mm256_and_pd(
+          on_edge,
+          _mm256_cmp_pd(py, _mm256_sub_pd(_mm256_min_pd(sy, ey), epsilon),
+                        _CMP_GE_OQ));
+      on_edge = _mm256_and_pd(
+          on_edge,
+          _mm256_cmp_pd(py, _mm256_add_pd(_mm256_max_pd(sy, ey), epsilon),
+                        _CMP_LE_OQ));
+      boundary = _mm256_or_pd(boundary, on_edge);
+
+      // Same crossing rule as Polygon2d::IsPointIn.
+      const __m256d straddle =
+          _mm256_xor_pd(_mm256_cmp_pd(ey, py, _CMP_GT_OQ),
+                        _mm256_cmp_pd(sy, py, _CMP_GT_OQ));
+      const __m256d side =
+          _mm256_blendv_pd(_mm256_cmp_pd(prod, zero, _CMP_GT_OQ),
+                           _mm256_cmp_pd(prod, zero, _CMP_LT_OQ),
+                           _mm256_cmp_pd(ey, sy, _CMP_LT_OQ));
+      *crossings += __builtin_popcount(
+          _mm256_movemask_pd(_mm256_and_pd(straddle, side)));
+
+      // Same branches as LineSegment2d::DistanceSquareTo.
+      const __m256d ux = _mm256_loadu_pd(&unit_x_[i]);
+      const __m256d uy = _mm256_loadu_pd(&unit_y_[i]);
+      const __m256d proj =
+          _mm256_add_pd(_mm256_mul_pd(x0, ux), _mm256_mul_pd(y0, uy));
+      const __m256d cross =
+          _mm256_sub_pd(_mm256_mul_pd(x0, uy), _mm256_mul_pd(y0, ux));
+      __m256d distance = _mm256_mul_pd(cross, cross);
+      distance = _mm256_blendv_pd(
+          distance,
+          _mm256_add_pd(_mm256_mul_pd(x1, x1), _mm256_mul_pd(y1, y1)),
+          _mm256_cmp_pd(proj, _mm256_loadu_pd(&length_[i]), _CMP_GE_OQ));
+      distance = _mm256_blendv_pd(
+          distance,
+          _mm256_add_pd(_mm256_mul_pd(x0, x0), _mm256_mul_pd(y0, y0)),
+          _mm256_cmp_pd(proj, zero, _CMP_LE_OQ));
+      best_distance = _mm256_min_pd(best_distance, distance);
+    }
+
+    double lane_distance[4];
+    _mm256_storeu_pd(lane_distance, best_distance);
+    for (const double distance : lane_distance) {
+      *distance_square = std::min(*distance_square, distance);
+    }
+    *on_boundary = _mm256_movemask_pd(boundary) != 0;
+  }
+#elif defined(__aarch64__)
+  if (num_edges >= 2) {
+    const float64x2_t px = vdupq_n_f64(point.x());
+    const float64x2_t py = vdupq_n_f64(point.y());
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t epsilon = vdupq_n_f64(kMathEpsilon);
+    uint64x2_t boundary = vdupq_n_u64(0);
+    float64x2_t best_distance =
+        vdupq_n_f64(std::numeric_limits<double>::infinity());
+
+    for (; i + 2 <= num_edges; i += 2) {
+      const float64x2_t sx = vld1q_f64(&x_[i]);
+      const float64x2_t sy = vld1q_f64(&y_[i]);
+      const float64x2_t ex = vld1q_f64(&x_[i + 1]);
+      const float64x2_t ey = vld1q_f64(&y_[i + 1]);
+      const float64x2_t x0 = vsubq_f64(px, sx);
+      const float64x2_t y0 = vsubq_f64(py, sy);
+      const float64x2_t x1 = vsubq_f64(px, ex);
+      const float64x2_t y1 = vsubq_f64(py, ey);
+      const float64x2_t prod =
+          vsubq_f64(vmulq_f64(x0, y1), vmulq_f64(y0, x1));
+
+      // Same checks as LineSegment2d::IsPointIn.
+      uint64x2_t on_edge = vcleq_f64(vabsq_f64(prod), epsilon);
+      on_edge = vandq_u64(
+          on_edge, vcgeq_f64(px, vsubq_f64(vminq_f64(sx, ex), epsilon)));
+      on_edge = vandq_u64(
+          on_edge, vcleq_f64(px, vaddq_f64(vmaxq_f64(sx, ex), epsilon)));
+      on_edge = vandq_u64(
+          on_edge, vcgeq_f64(py, vsubq_f64(vminq_f64(sy, ey), epsilon)));
+      on_edge = vandq_u64(
+          on_edge, vcleq_f64(py, vaddq_f64(vmaxq_f64(sy, ey), epsilon)));
+      boundary = vorrq_u64(boundary, on_edge);
+
+      // Same crossing rule as Polygon2d::IsPointIn.
+      const uint64x2_t straddle =
+          veorq_u64(vcgtq_f64(ey, py), vcgtq_f64(sy, py));
+      const uint64x2_t side =
+          vbslq_u64(vcltq_f64(ey, sy), vcltq_f64(prod, zero),
+                    vcgtq_f64(prod, zero));
+      const uint64x2_t crossing = vandq_u64(straddle, side);
+      *crossings += static_cast<int>((vgetq_lane_u64(crossing, 0) & 1) +
+                                     (vgetq_lane_u64(crossing, 1) & 1));
+
+      // Same branches as LineSegment2d::DistanceSquareTo.
+      const float64x2_t ux = vld1q_f64(&unit_x_[i]);
+      const float64x2_t uy = vld1q_f64(&unit_y_[i]);
+      const float64x2_t proj = vaddq_f64(vmulq_f64(x0, ux), vmulq_f64(y0, uy));
+      const float64x2_t cross =
+          vsubq_f64(vmulq_f64(x0, uy), vmulq_f64(y0, ux));
+      float64x2_t distance = vmulq_f64(cross, cross);
+      distance = vbslq_f64(vcgeq_f64(proj, vld1q_f64(&length_[i])),
+                           vaddq_f64(vmulq_f64(x1, x1), vmulq_f64(y1, y1)),
+                           distance);
+      distance = vbslq_f64(vcleq_f64(proj, zero),
+                           vaddq_f64(vmulq_f64(x0, x0), vmulq_f64(y0, y0)),
+                           distance);
+      best_distance = vminq_f64(best_distance, distance);
+    }
+
+    *distance_square = std::min(vgetq_lane_f64(best_distance, 0),
+                                vgetq_lane_f64(best_distance, 1));
+    *on_boundary =
+        (vgetq_lane_u64(boundary, 0) | vgetq_lane_u64(boundary, 1)) != 0;
+  }
+#endif
+
+  for (; i < num_edges; ++i) {
+    QueryEdge(point.x(), point.y(), i, on_boundary, crossings, distance_square);
+  }
+}
+
+void Polygon2dVertices::Query(const std::vector<Vec2d> &points,
+                              unsigned char *const inside,
+                              double *const distance_squares) const {
+  const size_t num_points = points.size();
+  const size_t num_edges = size();
+  size_t j = 0;
+
+#if defined(__AVX2__)
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d epsilon = _mm256_set1_pd(kMathEpsilon);
+  const __m256d sign_mask = _mm256_set1_pd(-0.0);
+  for (; j + 4 <= num_points; j += 4) {
+    const __m256d px = _mm256_set_pd(points[j + 3].x(), points[j + 2].x(),
+                                     points[j + 1].x(), points[j].x());
+    const __m256d py = _mm256_set_pd(points[j + 3].y(), points[j + 2].y(),
+                                     points[j + 1].y(), points[j].y());
+    __m256d boundary = _mm256_setzero_pd();
+    __m256d crossings = _mm256_setzero_pd();
+    __m256d best_distance =
+        _mm256_set1_pd(std::numeric_limits<double>::infinity());
+
+    for (size_t i = 0; i < num_edges; ++i) {
+      const __m256d sx = _mm256_set1_pd(x_[i]);
+      const __m256d sy = _mm256_set1_pd(y_[i]);
+      const __m256d ex = _mm256_set1_pd(x_[i + 1]);
+      const __m256d ey = _mm256_set1_pd(y_[i + 1]);
+      const __m256d x0 = _mm256_sub_pd(px, sx);
+      const __m256d y0 = _mm256_sub_pd(py, sy);
+      const __m256d x1 = _mm256_sub_pd(px, ex);
+      const __m256d y1 = _mm256_sub_pd(py, ey);
+      const __m256d prod =
+          _mm256_sub_pd(_mm256_mul_pd(x0, y1), _mm256_mul_pd(y0, x1));
+
+      const __m256d min_x =
+          _mm256_set1_pd(std::min(x_[i], x_[i + 1]) - kMathEpsilon);
+      const __m256d max_x =
+          _mm256_set1_pd(std::max(x_[i], x_[i + 1]) + kMathEpsilon);
+      const __m256d min_y =
+          _mm256_set1_pd(std::min(y_[i], y_[i + 1]) - kMathEpsilon);
+      const __m256d max_y =
+          _mm256_set1_pd(std::max(y_[i], y_[i + 1]) + kMathEpsilon);
+      __m256d on_edge = _mm256_cmp_pd(_mm256_andnot_pd(sign_mask, prod),
+                                      epsilon, _CMP_LE_OQ);
+      on_edge = _mm256_and_pd(on_edge, _mm256_cmp_pd(px, min_x, _CMP_GE_OQ));
+      on_edge = _mm256_and_pd(on_edge, _mm256_cmp_pd(px, max_x, _CMP_LE_OQ));
+      on_edge = _mm256_and_pd(on_edge, _mm256_cmp_pd(py, min_y, _CMP_GE_OQ));
+      on_edge = _mm256_and_pd(on_edge, _mm256_cmp_pd(py, max_y, _CMP_LE_OQ));
+      boundary = _mm256_or_pd(boundary, on_edge);
+
+      const __m256d straddle =
+          _mm256_xor_pd(_mm256_cmp_pd(ey, py, _CMP_GT_OQ),
+                        _mm256_cmp_pd(sy, py, _CMP_GT_OQ));
+      const __m256d side = y_[i + 1] < y_[i]
+                               ? _mm256_cmp_pd(prod, zero, _CMP_LT_OQ)
+                               : _mm256_cmp_pd(prod, zero, _CMP_GT_OQ);
+      crossings = _mm256_add_pd(
+          crossings, _mm256_and_pd(_mm256_and_pd(straddle, side), one));
+
+      const __m256d ux = _mm256_set1_pd(unit_x_[i]);
+      const __m256d uy = _mm256_set1_pd(unit_y_[i]);
+      const __m256d proj =
+          _mm256_add_pd(_mm256_mul_pd(x0, ux), _mm256_mul_pd(y0, uy));
+      const __m256d cross =
+          _mm256_sub_pd(_mm256_mul_pd(x0, uy), _mm256_mul_pd(y0, ux));
+      __m256d distance = _mm256_mul_pd(cross, cross);
+      distance = _mm256_blendv_pd(
+          distance,
+          _mm256_add_pd(_mm256_mul_pd(x1, x1), _mm256_mul_pd(y1, y1)),
+          _mm256_cmp_pd(proj, _mm256_set1_pd(length_[i]), _CMP_GE_OQ));
+      distance = _mm256_blendv_pd(
+          distance,
+          _mm256_add_pd(_mm256_mul_pd(x0, x0), _mm256_mul_pd(y0, y0)),
+          _mm256_cmp_pd(proj, zero, _CMP_LE_OQ));
+      best_distance = _mm256_min_pd(best_distance, distance);
+    }
+
+    double lane_crossings[4];
+    _mm256_storeu_pd(lane_crossings, crossings);
+    const int boundary_mask = _mm256_movemask_pd(boundary);
+    for (int lane = 0; lane < 4; ++lane) {
+      inside[j + lane] = ((boundary_mask >> lane) & 1) ||
+                         (static_cast<int>(lane_crossings[lane]) & 1);
+    }
+    _mm256_storeu_pd(&distance_squares[j], best_distance);
+  }
+#elif defined(__aarch64__)
+  const float64x2_t zero = vdupq_n_f64(0.0);
+  const float64x2_t epsilon = vdupq_n_f64(kMathEpsilon);
+  for (; j + 2 <= num_points; j += 2) {
+    const double lane_x[2] = {points[j].x(), points[j + 1].x()};
+    const double lane_y[2] = {points[j].y(), points[j + 1].y()};
+    const float64x2_t px = vld1q_f64(lane_x);
+    const float64x2_t py = vld1q_f64(lane_y);
+    uint64x2_t boundary = vdupq_n_u64(0);
+    uint64x2_t crossings = vdupq_n_u64(0);
+    float64x2_t best_distance =
+        vdupq_n_f64(std::numeric_limits<double>::infinity());
+
+    for (size_t i = 0; i < num_edges; ++i) {
+      const float64x2_t sx = vdupq_n_f64(x_[i]);
+      const float64x2_t sy = vdupq_n_f64(y_[i]);
+      const float64x2_t ex = vdupq_n_f64(x_[i + 1]);
+      const float64x2_t ey = vdupq_n_f64(y_[i + 1]);
+      const float64x2_t x0 = vsubq_f64(px, sx);
+      const float64x2_t y0 = vsubq_f64(py, sy);
+      const float64x2_t x1 = vsubq_f64(px, ex);
+      const float64x2_t y1 = vsubq_f64(py, ey);
+      const float64x2_t prod =
+          vsubq_f64(vmulq_f64(x0, y1), vmulq_f64(y0, x1));
+
+      uint64x2_t on_edge = vcleq_f64(vabsq_f64(prod), epsilon);
+      on_edge = vandq_u64(
+          on_edge, vcgeq_f64(px, vsubq_f64(vminq_f64(sx, ex), epsilon)));
+      on_edge = vandq_u64(
+          on_edge, vcleq_f64(px, vaddq_f64(vmaxq_f64(sx, ex), epsilon)));
+      on_edge = vandq_u64(
+          on_edge, vcgeq_f64(py, vsubq_f64(vminq_f64(sy, ey), epsilon)));
+      on_edge = vandq_u64(
+          on_edge, vcleq_f64(py, vaddq_f64(vmaxq_f64(sy, ey), epsilon)));
+      boundary = vorrq_u64(boundary, on_edge);
+
+      const uint64x2_t straddle =
+          veorq_u64(vcgtq_f64(ey, py), vcgtq_f64(sy, py));
+      const uint64x2_t side = y_[i + 1] < y_[i] ? vcltq_f64(prod, zero)
+                                                : vcgtq_f64(prod, zero);
+      crossings = vsubq_u64(crossings, vandq_u64(straddle, side));
+
+      const float64x2_t ux = vdupq_n_f64(unit_x_[i]);
+      const float64x2_t uy = vdupq_n_f64(unit_y_[i]);
+      const float64x2_t proj = vaddq_f64(vmulq_f64(x0, ux), vmulq_f64(y0, uy));
+      const float64x2_t cross =
+          vsubq_f64(vmulq_f64(x0, uy), vmulq_f64(y0, ux));
+      float64x2_t distance = vmulq_f64(cross, cross);
+      distance = vbslq_f64(vcgeq_f64(proj, vdupq_n_f64(length_[i])),
+                           vaddq_f64(vmulq_f64(x1, x1), vmulq_f64(y1, y1)),
+                           distance);
+      distance = vbslq_f64(vcleq_f64(proj, zero),
+                           vaddq_f64(vmulq_f64(x0, x0), vmulq_f64(y0, y0)),
+                           distance);
+      best_distance = vminq_f64(best_distance, distance);
+    }
+
+    // each crossing subtracted an all ones mask, i.e. added one
+    inside[j] = vgetq_lane_u64(boundary, 0) != 0 ||
+                (vgetq_lane_u64(crossings, 0) & 1);
+    inside[j + 1] = vgetq_lane_u64(boundary, 1) != 0 ||
+                    (vgetq_lane_u64(crossings, 1) & 1);
+    vst1q_f64(&distance_squares[j], best_distance);
+  }
+#endif
+
+  for (; j < num_points; ++j) {
+    bool on_boundary = false;
+    int crossings = 0;
+    double distance_square = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < num_edges; ++i) {
+      QueryEdge(points[j].x(), points[j].y(), i, &on_boundary, &crossings,
+                &distance_square);
+    }
+    inside[j] = on_boundary || (crossings & 1);
+    distance_squares[j] = distance_square;
+  }
+}
+
+bool Polygon2dVertices::IsPointIn(const Vec2d &point) const {
+  bool on_boundary = false;
+  int crossings = 0;
+  double distance_square = 0.0;
+  Query(point, &on_boundary, &crossings, &distance_square);
+  return on_boundary || (crossings & 1);
+}
+
+double Polygon2dVertices::DistanceSquareTo(const Vec2d &point) const {
+  bool on_boundary = false;
+  int crossings = 0;
+  double distance_square = 0.0;
+  Query(point, &on_boundary, &crossings, &distance_square);
+  return on_boundary || (crossings & 1) ? 0.0 : distance_square;
+}
+
+double Polygon2dVertices::DistanceSquareToBoundary(const Vec2d &point) const {
+  bool on_boundary = false;
+  int crossings = 0;
+  double distance_square = 0.0;
+  Query(point, &on_boundary, &crossings, &distance_square);
+  return distance_square;
+}
+
+void Polygon2dVertices::IsPointIn(
+    const std::vector<Vec2d> &points,
+    std::vector<unsigned char> *const inside) const {
+  std::vector<double> distance_squares(points.size());
+  inside->resize(points.size());
+  Query(points, inside->data(), distance_squares.data());
+}
+
+void Polygon2dVertices::DistanceSquareTo(
+    const std::vector<Vec2d> &points,
+    std::vector<double> *const distance_squares) const {
+  std::vector<unsigned char> inside(points.size());
+  distance_squares->resize(points.size());
+  Query(points, inside.data(), distance_squares->data());
+  for (size_t j = 0; j < points.size(); ++j) {
+    if (inside[j]) {
+      (*distance_squares)[j] = 0.0;
+    }
+  }
+}
+
+double Polygon2dVertices::SeparationAlong(
+    const size_t edge, const Polygon2dVertices &other) const {
+  const double sx = x_[edge];
+  const double sy = y_[edge];
+  const double ux = unit_x_[edge];
+  const double uy = unit_y_[edge];
+  const size_t num_points = other.size();
+  double separation = std::numeric_limits<double>::infinity();
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  if (num_points >= 4) {
+    const __m256d vsx = _mm256_set1_pd(sx);
+    const __m256d vsy = _mm256_set1_pd(sy);
+    const __m256d vux = _mm256_set1_pd(ux);
+    const __m256d vuy = _mm256_set1_pd(uy);
+    __m256d best = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    for (; i + 4 <= num_points; i += 4) {
+      const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(&other.x_[i]), vsx);
+      const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(&other.y_[i]), vsy);
+      best = _mm256_min_pd(best, _mm256_sub_pd(_mm256_mul_pd(dx, vuy),
+                                               _mm256_mul_pd(dy, vux)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, best);
+    for (const double lane : lanes) {
+      separation = std::min(separation, lane);
+    }
+  }
+#elif defined(__aarch64__)
+  if (num_points >= 2) {
+    const float64x2_t vsx = vdupq_n_f64(sx);
+    const float64x2_t vsy = vdupq_n_f64(sy);
+    const float64x2_t vux = vdupq_n_f64(ux);
+    const float64x2_t vuy = vdupq_n_f64(uy);
+    float64x2_t best = vdupq_n_f64(std::numeric_limits<double>::infinity());
+    for (; i + 2 <= num_points; i += 2) {
+      const float64x2_t dx = vsubq_f64(vld1q_f64(&other.x_[i]), vsx);
+      const float64x2_t dy = vsubq_f64(vld1q_f64(&other.y_[i]), vsy);
+      best = vminq_f64(best,
+                       vsubq_f64(vmulq_f64(dx, vuy), vmulq_f64(dy, vux)));
+    }
+    separation = std::min(vgetq_lane_f64(best, 0), vgetq_lane_f64(best, 1));
+  }
+#endif
+
+  for (; i < num_points; ++i) {
+    separation = std::min(
+        separation, (other.x_[i] - sx) * uy - (other.y_[i] - sy) * ux);
+  }
+  return separation;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The class of Polygon2dVertices, the structure of arrays layout of a
+ *        polygon used by the vectorized Polygon2d queries.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class Polygon2dVertices
+ * @brief The vertices and edges of a polygon stored as structure of arrays.
+ *
+ * The queries evaluate the same formulas as LineSegment2d and Polygon2d, with
+ * AVX2 on x86 and NEON on aarch64 handling several edges, or several query
+ * points in the batch variants, per instruction. Distances are squared, the
+ * degenerated edges are only supported by the distance queries.
+ */
+class Polygon2dVertices {
+ public:
+  Polygon2dVertices() = default;
+
+  /**
+   * @brief Rebuild from the vertices of a polygon.
+   * @param points The vertices of the polygon, in ccw order.
+   */
+  void Build(const std::vector<Vec2d> &points);
+
+  /**
+   * @brief Getter of the number of vertices.
+   * @return The number of vertices, which is also the number of edges.
+   */
+  size_t size() const { return length_.size(); }
+
+  /**
+   * @brief Check if an edge is shorter than kMathEpsilon.
+   * @return True if at least one edge is degenerated.
+   */
+  bool has_degenerated_edge() const { return has_degenerated_edge_; }
+
+  /**
+   * @brief Check if a point is inside the polygon or on its boundary, as
+   *        Polygon2d::IsPointIn does.
+   * @param point The point to check.
+   * @return True if the point is inside the polygon or on its boundary.
+   */
+  bool IsPointIn(const Vec2d &point) const;
+
+  /**
+   * @brief Compute the squared distance from a point to the polygon, zero if
+   *        the point is within it.
+   * @param point The point to compute the squared distance to.
+   * @return The squared distance from the point to the polygon.
+   */
+  double DistanceSquareTo(const Vec2d &point) const;
+
+  /**
+   * @brief Compute the squared distance from a point to the boundary.
+   * @param point The point to compute the squared distance to.
+   * @return The squared distance from the point to the nearest edge.
+   */
+  double DistanceSquareToBoundary(const Vec2d &point) const;
+
+  /**
+   * @brief Check which of many points are inside the polygon or on its
+   *        boundary.
+   * @param points The points to check.
+   * @param inside Set to 1 for the points within the polygon, 0 otherwise.
+   */
+  void IsPointIn(const std::vector<Vec2d> &points,
+                 std::vector<unsigned char> *const inside) const;
+
+  /**
+   * @brief Compute the squared distances from many points to the polygon.
+   * @param points The points to compute the squared distances to.
+   * @param distance_squares The squared distances, zero for the points
+   *        within the polygon.
+   */
+  void DistanceSquareTo(const std::vector<Vec2d> &points,
+                        std::vector<double> *const distance_squares) const;
+
+  /**
+   * @brief Compute how far the vertices of a polygon lie outside of an edge,
+   *        i.e. the separation of the polygons along the outward normal of
+   *        the edge.
+   * @param edge The index of the edge of this polygon.
+   * @param other The vertices of the other polygon.
+   * @return The smallest signed distance of the vertices of the other polygon
+   *         to the line of the edge, positive outside.
+   */
+  double SeparationAlong(const size_t edge,
+                         const Polygon2dVertices &other) const;
+
+  /**
+   * @brief Getter of the length of an edge.
+   * @param edge The index of the edge.
+   * @return The length of the edge.
+   */
+  double length(const size_t edge) const { return length_[edge]; }
+
+ private:
+  // The query of one point against edge i, see Query.
+  void QueryEdge(const double x, const double y, const size_t i,
+                 bool *const on_boundary, int *const crossings,
+                 double *const distance_square) const;
+  // Finds if the point lies on an edge, counts the edges crossed by a ray
+  // from it and tracks the squared distance to the nearest edge.
+  void Query(const Vec2d &point, bool *const on_boundary, int *const crossings,
+             double *const distance_square) const;
+  // The same over many points at a time. The results are 1 for points within
+  // the polygon, and the squared distances.
+  void Query(const std::vector<Vec2d> &points, unsigned char *const inside,
+             double *const distance_squares) const;
+
+  // The vertices, with the first one repeated at the end so that the edge i
+  // goes from vertex i to vertex i + 1.
+  std::vector<double> x_;
+  std::vector<double> y_;
+  // The unit directions are zero for degenerated edges, so that their
+  // projection always falls on the start point.
+  std::vector<double> unit_x_;
+  std::vector<double> unit_y_;
+  std::vector<double> length_;
+  bool has_degenerated_edge_ = false;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/polygon2d_vertices.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// The scalar Polygon2d::IsPointIn.
+bool IsPointInPolygon(const std::vector<Vec2d> &points, const Vec2d &point) {
+  const int n = static_cast<int>(points.size());
+  for (int i = 0; i < n; ++i) {
+    if (LineSegment2d(points[i], points[(i + 1) % n]).IsPointIn(point)) {
+      return true;
+    }
+  }
+  int j = n - 1;
+  int c = 0;
+  for (int i = 0; i < n; ++i) {
+    if ((points[i].y() > point.y()) != (points[j].y() > point.y())) {
+      const double side = CrossProd(point, points[i], points[j]);
+      if (points[i].y() < points[j].y() ? side > 0.0 : side < 0.0) {
+        ++c;
+      }
+    }
+    j = i;
+  }
+  return c & 1;
+}
+
+double DistanceSquareToBoundary(const std::vector<Vec2d> &points,
+                                const Vec2d &point) {
+  const size_t n = points.size();
+  double distance = std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < n; ++i) {
+    distance = std::min(distance, LineSegment2d(points[i], points[(i + 1) % n])
+                                      .DistanceSquareTo(point));
+  }
+  return distance;
+}
+
+std::vector<Vec2d> StarPolygon(const int num_points, std::mt19937 *rng) {
+  std::uniform_real_distribution<double> radius(1.0, 5.0);
+  std::vector<Vec2d> points;
+  for (int i = 0; i < num_points; ++i) {
+    const double angle = 2.0 * M_PI * i / num_points;
+    const double r = radius(*rng);
+    points.emplace_back(r * std::cos(angle), r * std::sin(angle));
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(Polygon2dVerticesTest, PointQueries) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> coordinate(-6.0, 6.0);
+  for (const int num_points : {3, 4, 5, 8, 13, 32}) {
+    const std::vector<Vec2d> points = StarPolygon(num_points, &rng);
+    Polygon2dVertices vertices;
+    vertices.Build(points);
+    EXPECT_EQ(num_points, vertices.size());
+    EXPECT_FALSE(vertices.has_degenerated_edge());
+
+    std::vector<Vec2d> queries(points);
+    for (int i = 0; i < num_points; ++i) {
+      queries.push_back((points[i] + points[(i + 1) % num_points]) / 2.0);
+    }
+    for (int i = 0; i < 200; ++i) {
+      queries.emplace_back(coordinate(rng), coordinate(rng));
+    }
+    std::vector<unsigned char> inside;
+    std::vector<double> distance_squares;
+    vertices.IsPointIn(queries, &inside);
+    vertices.DistanceSquareTo(queries, &distance_squares);
+    ASSERT_EQ(queries.size(), inside.size());
+    ASSERT_EQ(queries.size(), distance_squares.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+      const bool expected_in = IsPointInPolygon(points, queries[i]);
+      const double expected_distance =
+          expected_in ? 0.0 : DistanceSquareToBoundary(points, queries[i]);
+      EXPECT_EQ(expected_in, vertices.IsPointIn(queries[i]));
+      EXPECT_EQ(expected_in, inside[i] != 0);
+      EXPECT_DOUBLE_EQ(expected_distance,
+                       vertices.DistanceSquareTo(queries[i]));
+      EXPECT_DOUBLE_EQ(expected_distance, distance_squares[i]);
+      EXPECT_DOUBLE_EQ(DistanceSquareToBoundary(points, queries[i]),
+                       vertices.DistanceSquareToBoundary(queries[i]));
+    }
+  }
+}
+
+TEST(Polygon2dVerticesTest, SeparationAlong) {
+  Polygon2dVertices square;
+  square.Build({{0, 0}, {2, 0}, {2, 2}, {0, 2}});
+  Polygon2dVertices triangle;
+  triangle.Build({{3, 1}, {5, 0}, {5, 2}});
+  // edge 1 goes from (2, 0) to (2, 2), facing +x
+  EXPECT_DOUBLE_EQ(1.0, square.SeparationAlong(1, triangle));
+  EXPECT_DOUBLE_EQ(-5.0, square.SeparationAlong(3, triangle));
+  EXPECT_DOUBLE_EQ(2.0, square.length(1));
+
+  Polygon2dVertices degenerated;
+  degenerated.Build({{0, 0}, {1, 0}, {1, 0}, {0, 1}});
+  EXPECT_TRUE(degenerated.has_degenerated_edge());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/sin_cos_batch.h"
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// Beyond this the three part reduction below loses precision, the angles
+// go through std::sin and std::cos instead.
+constexpr double kMaxReducedAngle = 1.0e5;
+
+constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+// pi / 2 split in three parts, the first two with trailing zero bits so that
+// their products with the quadrant are exact.
+constexpr double kPiOverTwo1 = 1.57079632673412561417e+00;
+constexpr double kPiOverTwo2 = 6.07710050630396597660e-11;
+constexpr double kPiOverTwo3 = 2.02226624871116645580e-21;
+
+// The cephes minimax polynomials on [-pi / 4, pi / 4].
+constexpr double kSin0 = 1.58962301576546568060e-10;
+constexpr double kSin1 = -2.50507477628578072866e-8;
+constexpr double kSin2 = 2.75573136213857245213e-6;
+constexpr double kSin3 = -1.98412698295895385996e-4;
+constexpr double kSin4 = 8.33333333332211858878e-3;
+constexpr double kSin5 = -1.66666666666666307295e-1;
+constexpr double kCos0 = -1.13585365213876817300e-11;
+constexpr double kCos1 = 2.08757008419747316778e-9;
+constexpr double kCos2 = -2.75573141792967388112e-7;
+constexpr double kCos3 = 2.48015872888517045348e-5;
+constexpr double kCos4 = -1.38888888888730564116e-3;
+constexpr double kCos5 = 4.16666666666665929218e-2;
+
+// The scalar version of the vector code, with the same operations in the
+// same order so that every path gives the same results.
+void SinCos(const double angle, double *const sine, double *const cosine) {
+  if (!(std::abs(angle) <= kMaxReducedAngle)) {
+    *sine = std::sin(angle);
+    *cosine = std::cos(angle);
+    return;
+  }
+  const double quadrant = std::nearbyint(angle * kTwoOverPi);
+  const double r = ((angle - quadrant * kPiOverTwo1) - quadrant * kPiOverTwo2) -
+                   quadrant * kPiOverTwo3;
+  const double z = r * r;
+  const double s =
+      r + r * z *
+              (((((kSin0 * z + kSin1) * z + kSin2) * z + kSin3) * z + kSin4) *
+                   z +
+               kSin5);
+  const double c =
+      (1.0 - 0.5 * z) +
+      z * z *
+          (((((kCos0 * z + kCos1) * z + kCos2) * z + kCos3) * z + kCos4) * z +
+           kCos5);
+  switch (static_cast<int64_t>(quadrant) & 3) {
+    case 0:
+      *sine = s;
+      *cosine = c;
+      break;
+    case 1:
+      *sine = c;
+      *cosine = -s;
+      break;
+    case 2:
+      *sine = -s;
+      *cosine = -c;
+      break;
+    default:
+      *sine = -c;
+      *cosine = s;
+      break;
+  }
+}
+
+}  // namespace
+
+void SinCosBatch(const double *angles, const size_t num_angles,
+                 double *const sines, double *const cosines) {
+  double sine = 0.0;
+  double cosine = 0.0;
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  const __m256d sign_mask = _mm256_set1_pd(-0.0);
+  const __m256d max_angle = _mm256_set1_pd(kMaxReducedAngle);
+  const __m256d two_over_pi = _mm256_set1_pd(kTwoOverPi);
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d half = _mm256_set1_pd(0.5);
+  const __m256i one_bit = _mm256_set1_epi64x(1);
+  const __m256i two_bit = _mm256_set1_epi64x(2);
+  for (; i + 4 <= num_angles; i += 4) {
+    const __m256d angle = _mm256_loadu_pd(&angles[i]);
+    if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign_mask, angle),
+                                         max_angle, _CMP_LE_OQ)) != 0xf) {
+      break;
+    }
+    const __m256d quadrant = _mm256_round_pd(
+        _mm256_mul_pd(angle, two_over_pi),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    const __m256d r = _mm256_sub_pd(
+        _mm256_sub_pd(
+            _mm256_sub_pd(angle,
+                          _mm256_mul_pd(quadrant, _mm256_set1_pd(kPiOverTwo1))),
+            _mm256_mul_pd(quadrant, _mm256_set1_pd(kPiOverTwo2))),
+        _mm256_mul_pd(quadrant, _mm256_set1_pd(kPiOverTwo3)));
+    const __m256d z = _mm256_mul_pd(r, r);
+
+    __m256d p = _mm256_set1_pd(kSin0);
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(kSin1));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(kSin2));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(kSin3));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(kSin4));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(kSin5));
+    const __m256d s = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, z), p));
+
+    __m256d q = _mm256_set1_pd(kCos0);
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(kCos1));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(kCos2));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(kCos3));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(kCos4));
+    q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(kCos5));
+    const __m256d c =
+        _mm256_add_pd(_mm256_sub_pd(one, _mm256_mul_pd(half, z)),
+                      _mm256_mul_pd(_mm256_mul_pd(z, z), q));
+
+    // Odd quadrants swap sine and cosine, the sign of the sine flips in
+    // quadrants 2 and 3, the one of the cosine in quadrants 1 and 2.
+    const __m128i quadrant32 = _mm256_cvtpd_epi32(quadrant);
+    const __m256i quadrant64 = _mm256_cvtepi32_epi64(quadrant32);
+    const __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(
+        _mm256_and_si256(quadrant64, one_bit), one_bit));
+    const __m256d sin_sign = _mm256_castsi256_pd(_mm256_slli_epi64(
+        _mm256_and_si256(quadrant64, two_bit), 62));
+    const __m256d cos_sign = _mm256_castsi256_pd(_mm256_slli_epi64(
+        _mm256_and_si256(_mm256_add_epi64(quadrant64, one_bit), two_bit), 62));
+    if (sines != nullptr) {
+      _mm256_storeu_pd(&sines[i],
+                       _mm256_xor_pd(_mm256_blendv_pd(s, c, swap), sin_sign));
+    }
+    if (cosines != nullptr) {
+      _mm256_storeu_pd(&cosines[i],
+                       _mm256_xor_pd(_mm256_blendv_pd(c, s, swap), cos_sign));
+    }
+  }
+#elif defined(__aarch64__)
+  const float64x2_t max_angle = vdupq_n_f64(kMaxReducedAngle);
+  const float64x2_t two_over_pi = vdupq_n_f64(kTwoOverPi);
+  const float64x2_t one = vdupq_n_f64(1.0);
+  const float64x2_t half = vdupq_n_f64(0.5);
+  const int64x2_t one_bit = vdupq_n_s64(1);
+  const int64x2_t two_bit = vdupq_n_s64(2);
+  for (; i + 2 <= num_angles; i += 2) {
+    const float64x2_t angle = vld1q_f64(&angles[i]);
+    const uint64x2_t in_range = vcleq_f64(vabsq_f64(angle), max_angle);
+    if ((vgetq_lane_u64(in_range, 0) & vgetq_lane_u64(in_range, 1)) == 0) {
+      break;
+    }
+    const float64x2_t quadrant = vrndnq_f64(vmulq_f64(angle, two_over_pi));
+    const float64x2_t r = vsubq_f64(
+        vsubq_f64(vsubq_f64(angle,
+                            vmulq_f64(quadrant, vdupq_n_f64(kPiOverTwo1))),
+                  vmulq_f64(quadrant, vdupq_n_f64(kPiOverTwo2))),
+        vmulq_f64(quadrant, vdupq_n_f64(kPiOverTwo3)));
+    const float64x2_t z = vmulq_f64(r, r);
+
+    float64x2_t p = vdupq_n_f64(kSin0);
+    p = vaddq_f64(vmulq_f64(p, z), vdupq_n_f64(kSin1));
+    p = vaddq_f64(vmulq_f64(p, z), vdupq_n_f64(kSin2));
+    p = vaddq_f64(vmulq_f64(p, z), vdupq_n_f64(kSin3));
+    p = vaddq_f64(vmulq_f64(p, z), vdupq_n_f64(kSin4));
+    p = vaddq_f64(vmulq_f64(p, z), vdupq_n_f64(kSin5));
+    const float64x2_t s = vaddq_f64(r, vmulq_f64(vmulq_f64(r, z), p));
+
+    float64x2_t q = vdupq_n_f64(kCos0);
+    q = vaddq_f64(vmulq_f64(q, z), vdupq_n_f64(kCos1));
+    q = vaddq_f64(vmulq_f64(q, z), vdupq_n_f64(kCos2));
+    q = vaddq_f64(vmulq_f64(q, z), vdupq_n_f64(kCos3));
+    q = vaddq_f64(vmulq_f64(q, z), vdupq_n_f64(kCos4));
+    q = vaddq_f64(vmulq_f64(q, z), vdupq_n_f64(kCos5));
+    const float64x2_t c = vaddq_f64(vsubq_f64(one, vmulq_f64(half, z)),
+                                    vmulq_f64(vmulq_f64(z, z), q));
+
+    // Odd quadrants swap sine and cosine, the sign of the sine flips in
+    // quadrants 2 and 3, the one of the cosine in quadrants 1 and 2.
+    const int64x2_t quadrant64 = vcvtq_s64_f64(quadrant);
+    const uint64x2_t swap = vceqq_s64(vandq_s64(quadrant64, one_bit), one_bit);
+    const uint64x2_t sin_sign =
+        vreinterpretq_u64_s64(vshlq_n_s64(vandq_s64(quadrant64, two_bit), 62));
+    const uint64x2_t cos_sign = vreinterpretq_u64_s64(vshlq_n_s64(
+        vandq_s64(vaddq_s64(quadrant64, one_bit), two_bit), 62));
+    if (sines != nullptr) {
+      vst1q_f64(&sines[i], vreinterpretq_f64_u64(veorq_u64(
+                               vreinterpretq_u64_f64(vbslq_f64(swap, c, s)),
+                               sin_sign)));
+    }
+    if (cosines != nullptr) {
+      vst1q_f64(&cosines[i], vreinterpretq_f64_u64(veorq_u64(
+                                 vreinterpretq_u64_f64(vbslq_f64(swap, s, c)),
+                                 cos_sign)));
+    }
+  }
+#endif
+
+  for (; i < num_angles; ++i) {
+    SinCos(angles[i], &sine, &cosine);
+    if (sines != nullptr) {
+      sines[i] = sine;
+    }
+    if (cosines != nullptr) {
+      cosines[i] = cosine;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Vectorized sine and cosine of many angles at once.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @brief Compute the sine and cosine of many angles. Unlike the SIN_TABLE
+ *        lookups of the Angle class this keeps double precision, the results
+ *        are within a few ulps of std::sin and std::cos. AVX2 on x86 and NEON
+ *        on aarch64 handle several angles per instruction.
+ * @param angles The angles in radian.
+ * @param num_angles The number of angles.
+ * @param sines The sines of the angles, may be nullptr.
+ * @param cosines The cosines of the angles, may be nullptr.
+ */
+void SinCosBatch(const double *angles, const size_t num_angles,
+                 double *const sines, double *const cosines);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
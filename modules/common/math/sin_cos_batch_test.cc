@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/sin_cos_batch.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+TEST(SinCosBatchTest, MatchesStd) {
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<double> angle(-100.0, 100.0);
+  std::vector<double> angles{0.0,      -0.0,     M_PI_4, M_PI_2, M_PI,
+                             -M_PI_2, 3 * M_PI, 1.0e6,  -1.0e9};
+  for (int i = 0; i < 10000; ++i) {
+    angles.push_back(angle(rng));
+  }
+  std::vector<double> sines(angles.size());
+  std::vector<double> cosines(angles.size());
+  SinCosBatch(angles.data(), angles.size(), sines.data(), cosines.data());
+  for (size_t i = 0; i < angles.size(); ++i) {
+    EXPECT_NEAR(std::sin(angles[i]), sines[i], 1.0e-15);
+    EXPECT_NEAR(std::cos(angles[i]), cosines[i], 1.0e-15);
+    // the scalar tail gives the same bits as the vectorized body
+    double sine = 0.0;
+    SinCosBatch(&angles[i], 1, &sine, nullptr);
+    EXPECT_EQ(sines[i], sine);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
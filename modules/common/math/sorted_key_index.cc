@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/common/math/sorted_key_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// Relative to the spacing, how far a key may be from the uniform grid.
+constexpr double kUniformTolerance = 1.0e-6;
+
+}  // namespace
+
+SortedKeyIndex::SortedKeyIndex(std::vector<double> keys) {
+  Reset(std::move(keys));
+}
+
+bool SortedKeyIndex::Reset(std::vector<double> keys) {
+  keys_ = std::move(keys);
+  if (!std::is_sorted(keys_.begin(), keys_.end())) {
+    Clear();
+    return false;
+  }
+  UpdateUniform();
+  return true;
+}
+
+bool SortedKeyIndex::Append(const double key) {
+  if (!keys_.empty() && !(key >= keys_.back())) {
+    Clear();
+    return false;
+  }
+  keys_.push_back(key);
+  if (keys_.size() <= 2) {
+    UpdateUniform();
+    return true;
+  }
+  if (uniform_) {
+    const double expected =
+        start_ + static_cast<double>(keys_.size() - 1) * step_;
+    uniform_ = std::fabs(key - expected) <= kUniformTolerance * step_;
+  }
+  return true;
+}
+
+void SortedKeyIndex::Clear() {
+  keys_.clear();
+  uniform_ = false;
+}
+
+void SortedKeyIndex::UpdateUniform() {
+  uniform_ = false;
+  if (keys_.size() < 2) {
+    return;
+  }
+  start_ = keys_.front();
+  step_ = (keys_.back() - keys_.front()) /
+          static_cast<double>(keys_.size() - 1);
+  if (!(step_ > 0.0)) {
+    return;
+  }
+  inv_step_ = 1.0 / step_;
+  for (size_t i = 1; i + 1 < keys_.size(); ++i) {
+    const double expected = start_ + static_cast<double>(i) * step_;
+    if (std::fabs(keys_[i] - expected) > kUniformTolerance * step_) {
+      return;
+    }
+  }
+  uniform_ = true;
+}
+
+size_t SortedKeyIndex::GuessIndex(const double key) const {
+  if (!(key > start_)) {
+    return 0;
+  }
+  const double index = std::ceil((key - start_) * inv_step_);
+  if (index >= static_cast<double>(keys_.size())) {
+    return keys_.size();
+  }
+  return static_cast<size_t>(index);
+}
+
+size_t SortedKeyIndex::LowerBound(const double key) const {
+  if (!uniform_) {
+    return std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin();
+  }
+  // the guess is at most one off, step to the exact bound
+  size_t index = GuessIndex(key);
+  while (index > 0 && keys_[index - 1] >= key) {
+    --index;
+  }
+  while (index < keys_.size() && keys_[index] < key) {
+    ++index;
+  }
+  return index;
+}
+
+size_t SortedKeyIndex::LowerBound(const double key, size_t *hint) const {
+  if (hint == nullptr || uniform_ || *hint >= keys_.size()) {
+    const size_t index = LowerBound(key);
+    if (hint != nullptr) {
+      *hint = index;
+    }
+    return index;
+  }
+  // gallop away from the hint until the bound is bracketed, then bisect
+  const auto begin = keys_.begin();
+  size_t lower = 0;
+  size_t upper = 0;
+  size_t step = 1;
+  if (keys_[*hint] < key) {
+    lower = *hint + 1;
+    upper = std::min(lower + step, keys_.size());
+    while (upper < keys_.size() && keys_[upper] < key) {
+      lower = upper + 1;
+      step *= 2;
+      upper = std::min(lower + step, keys_.size());
+    }
+  } else {
+    upper = *hint;
+    lower = upper > step ? upper - step : 0;
+    while (lower > 0 && keys_[lower - 1] >= key) {
+      upper = lower - 1;
+      step *= 2;
+      lower = upper > step ? upper - step : 0;
+    }
+  }
+  *hint = std::lower_bound(begin + lower, begin + upper, key) - begin;
+  return *hint;
+}
+
+size_t SortedKeyIndex::UpperBound(const double key) const {
+  if (!uniform_) {
+    return std::upper_bound(keys_.begin(), keys_.end(), key) - keys_.begin();
+  }
+  size_t index = GuessIndex(key);
+  while (index > 0 && keys_[index - 1] > key) {
+    --index;
+  }
+  while (index < keys_.size() && keys_[index] <= key) {
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The class of SortedKeyIndex, the sorted keys of a sequence of points
+ *        packed for lookups that do not touch the points.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class SortedKeyIndex
+ * @brief Non-decreasing keys, such as the relative times of a trajectory or
+ *        the s of a path, stored contiguously.
+ *
+ * The lookups return the same indices as std::lower_bound and
+ * std::upper_bound over the points. Keys which are uniformly spaced are
+ * looked up in constant time, others by binary search or, given a hint,
+ * by galloping from the hint.
+ */
+class SortedKeyIndex {
+ public:
+  SortedKeyIndex() = default;
+
+  /**
+   * @brief Constructor which takes the keys of the index, the index is left
+   *        empty if they are not non-decreasing.
+   * @param keys The non-decreasing keys.
+   */
+  explicit SortedKeyIndex(std::vector<double> keys);
+
+  /**
+   * @brief Replace the keys of the index.
+   * @param keys The non-decreasing keys.
+   * @return False, leaving the index empty, if the keys decrease somewhere.
+   */
+  bool Reset(std::vector<double> keys);
+
+  /**
+   * @brief Append a key which is not less than the last key.
+   * @param key The key to append.
+   * @return False, leaving the index empty, if key is less than the last key.
+   */
+  bool Append(const double key);
+
+  /**
+   * @brief Remove all the keys.
+   */
+  void Clear();
+
+  size_t size() const { return keys_.size(); }
+
+  bool empty() const { return keys_.empty(); }
+
+  double key(const size_t index) const { return keys_[index]; }
+
+  /**
+   * @brief Check if the keys are uniformly spaced, in which case the lookups
+   *        take constant time.
+   * @return True if the keys are uniformly spaced.
+   */
+  bool uniform() const { return uniform_; }
+
+  /**
+   * @brief Find the first key which is not less than the given key.
+   * @param key The key to look up.
+   * @return The index of the first key not less than key, size() if none.
+   */
+  size_t LowerBound(const double key) const;
+
+  /**
+   * @brief Find the first key which is not less than the given key, starting
+   *        from the result of a previous lookup.
+   * @param key The key to look up.
+   * @param hint The index to start from, updated to the result.
+   * @return The index of the first key not less than key, size() if none.
+   */
+  size_t LowerBound(const double key, size_t *hint) const;
+
+  /**
+   * @brief Find the first key which is greater than the given key.
+   * @param key The key to look up.
+   * @return The index of the first key greater than key, size() if none.
+   */
+  size_t UpperBound(const double key) const;
+
+ private:
+  void UpdateUniform();
+
+  size_t GuessIndex(const double key) const;
+
+  std::vector<double> keys_;
+  bool uniform_ = false;
+  double start_ = 0.0;
+  double step_ = 0.0;
+  double inv_step_ = 0.0;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/sorted_key_index.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+void ExpectSameAsStd(const std::vector<double> &keys,
+                     const SortedKeyIndex &index) {
+  size_t hint = 0;
+  for (double key = keys.front() - 1.0; key < keys.back() + 1.0;
+       key += 0.037) {
+    const size_t lower =
+        std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+    const size_t upper =
+        std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+    EXPECT_EQ(lower, index.LowerBound(key));
+    EXPECT_EQ(upper, index.UpperBound(key));
+    EXPECT_EQ(lower, index.LowerBound(key, &hint));
+    EXPECT_EQ(lower, hint);
+  }
+  for (const double key : keys) {
+    const size_t lower =
+        std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+    const size_t upper =
+        std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+    EXPECT_EQ(lower, index.LowerBound(key));
+    EXPECT_EQ(upper, index.UpperBound(key));
+    // jump the hint around to gallop in both directions
+    hint = (hint * 7 + 3) % keys.size();
+    EXPECT_EQ(lower, index.LowerBound(key, &hint));
+  }
+}
+
+}  // namespace
+
+TEST(SortedKeyIndexTest, UniformKeys) {
+  std::vector<double> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(0.1 * i);
+  }
+  SortedKeyIndex index(keys);
+  EXPECT_TRUE(index.uniform());
+  EXPECT_EQ(100, index.size());
+  ExpectSameAsStd(keys, index);
+
+  SortedKeyIndex appended;
+  for (const double key : keys) {
+    appended.Append(key);
+  }
+  EXPECT_TRUE(appended.uniform());
+  ExpectSameAsStd(keys, appended);
+
+  appended.Append(100.0);
+  EXPECT_FALSE(appended.uniform());
+  keys.push_back(100.0);
+  ExpectSameAsStd(keys, appended);
+}
+
+TEST(SortedKeyIndexTest, NonUniformKeys) {
+  std::vector<double> keys;
+  double key = -3.0;
+  for (int i = 0; i < 200; ++i) {
+    keys.push_back(key);
+    // repeated keys every now and then
+    if (i % 11 != 0) {
+      key += 0.01 * (i % 7 + 1);
+    }
+  }
+  SortedKeyIndex index(keys);
+  EXPECT_FALSE(index.uniform());
+  ExpectSameAsStd(keys, index);
+}
+
+TEST(SortedKeyIndexTest, Degenerate) {
+  SortedKeyIndex index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(0, index.LowerBound(1.0));
+  EXPECT_EQ(0, index.UpperBound(1.0));
+  size_t hint = 5;
+  EXPECT_EQ(0, index.LowerBound(1.0, &hint));
+  EXPECT_EQ(0, hint);
+
+  index.Reset({2.0});
+  EXPECT_FALSE(index.uniform());
+  EXPECT_EQ(0, index.LowerBound(1.0));
+  EXPECT_EQ(0, index.LowerBound(2.0));
+  EXPECT_EQ(1, index.UpperBound(2.0));
+  EXPECT_EQ(1, index.LowerBound(3.0));
+
+  index.Reset({2.0, 2.0, 2.0});
+  EXPECT_FALSE(index.uniform());
+  EXPECT_EQ(0, index.LowerBound(2.0));
+  EXPECT_EQ(3, index.UpperBound(2.0));
+
+  EXPECT_FALSE(index.Reset({1.0, 3.0, 2.0}));
+  EXPECT_TRUE(index.empty());
+  EXPECT_TRUE(index.Append(1.0));
+  EXPECT_FALSE(index.Append(0.5));
+  EXPECT_TRUE(index.empty());
+
+  index.Reset({1.0, 2.0});
+  index.Clear();
+  EXPECT_TRUE(index.empty());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,313 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/voxel_grid.h"
+
+#include <algorithm>
+#include <future>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+// A key has the linear voxel index in its high 32 bits and the point index in
+// the low 32 bits, the grid is limited to 2^31 voxels like pcl::VoxelGrid so
+// that the indices also fit the signed simd lanes.
+constexpr int kIndexBits = 32;
+constexpr uint64_t kMaxVoxels = uint64_t(1) << 31;
+// Clouds smaller than this per thread are processed serially.
+constexpr size_t kMinPointsPerThread = 16384;
+
+}  // namespace
+
+VoxelGrid::VoxelGrid(const float leaf_x, const float leaf_y,
+                     const float leaf_z)
+    : inv_leaf_x_(leaf_x > 0.0f ? 1.0f / leaf_x : 0.0f),
+      inv_leaf_y_(leaf_y > 0.0f ? 1.0f / leaf_y : 0.0f),
+      inv_leaf_z_(leaf_z > 0.0f ? 1.0f / leaf_z : 0.0f) {}
+
+int VoxelGrid::NumChunks(const size_t size) const {
+  const size_t max_chunks = std::max<size_t>(size / kMinPointsPerThread, 1);
+  return static_cast<int>(
+      std::min<size_t>(std::max(num_threads_, 1), max_chunks));
+}
+
+bool VoxelGrid::Build(const std::vector<float> &x, const std::vector<float> &y,
+                      const std::vector<float> &z) {
+  keys_.clear();
+  order_.clear();
+  voxel_begin_.clear();
+  if (inv_leaf_x_ <= 0.0f || inv_leaf_y_ <= 0.0f || inv_leaf_z_ <= 0.0f) {
+    AERROR << "Voxel grid leaf size must be positive.";
+    return false;
+  }
+  const size_t size = x.size();
+  if (size == 0) {
+    return true;
+  }
+  if (y.size() != size || z.size() != size ||
+      size > std::numeric_limits<uint32_t>::max()) {
+    AERROR << "Voxel grid input size mismatch.";
+    return false;
+  }
+
+  const auto x_range = std::minmax_element(x.begin(), x.end());
+  const auto y_range = std::minmax_element(y.begin(), y.end());
+  const auto z_range = std::minmax_element(z.begin(), z.end());
+  min_x_ = *x_range.first;
+  min_y_ = *y_range.first;
+  min_z_ = *z_range.first;
+  const double nx =
+      std::floor((*x_range.second - min_x_) * inv_leaf_x_) + 1.0;
+  const double ny =
+      std::floor((*y_range.second - min_y_) * inv_leaf_y_) + 1.0;
+  const double nz =
+      std::floor((*z_range.second - min_z_) * inv_leaf_z_) + 1.0;
+  if (nx * ny * nz >= static_cast<double>(kMaxVoxels)) {
+    AERROR << "Leaf size is too small for the input cloud, voxel indices "
+           << "would overflow.";
+    return false;
+  }
+  max_ix_ = static_cast<uint32_t>(nx) - 1;
+  max_iy_ = static_cast<uint32_t>(ny) - 1;
+  max_iz_ = static_cast<uint32_t>(nz) - 1;
+  stride_y_ = static_cast<uint32_t>(nx);
+  stride_z_ = static_cast<uint32_t>(nx * ny);
+
+  keys_.resize(size);
+  const int num_chunks = NumChunks(size);
+  if (num_chunks <= 1) {
+    ComputeKeys(x, y, z, 0, size);
+  } else {
+    std::vector<std::future<void>> results;
+    const size_t chunk = (size + num_chunks - 1) / num_chunks;
+    for (size_t begin = 0; begin < size; begin += chunk) {
+      const size_t end = std::min(begin + chunk, size);
+      results.push_back(cyber::Async([this, &x, &y, &z, begin, end]() {
+        ComputeKeys(x, y, z, begin, end);
+      }));
+    }
+    for (auto &result : results) {
+      result.wait();
+    }
+  }
+  SortKeys();
+
+  order_.resize(size);
+  voxel_begin_.reserve(size + 1);
+  const uint64_t index_mask = (uint64_t(1) << kIndexBits) - 1;
+  for (size_t i = 0; i < size; ++i) {
+    order_[i] = static_cast<uint32_t>(keys_[i] & index_mask);
+    if (i == 0 || (keys_[i] >> kIndexBits) != (keys_[i - 1] >> kIndexBits)) {
+      voxel_begin_.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  voxel_begin_.push_back(static_cast<uint32_t>(size));
+  return true;
+}
+
+void VoxelGrid::ComputeKeys(const std::vector<float> &x,
+                            const std::vector<float> &y,
+                            const std::vector<float> &z, const size_t begin,
+                            const size_t end) {
+  size_t i = begin;
+
+  // The offsets from the minimum are not negative, so truncation is floor,
+  // the clamp catches the maximum rounding up to the next voxel.
+#if defined(__AVX2__)
+  const __m256 min_x = _mm256_set1_ps(min_x_);
+  const __m256 min_y = _mm256_set1_ps(min_y_);
+  const __m256 min_z = _mm256_set1_ps(min_z_);
+  const __m256 inv_x = _mm256_set1_ps(inv_leaf_x_);
+  const __m256 inv_y = _mm256_set1_ps(inv_leaf_y_);
+  const __m256 inv_z = _mm256_set1_ps(inv_leaf_z_);
+  const __m256i max_ix = _mm256_set1_epi32(static_cast<int>(max_ix_));
+  const __m256i max_iy = _mm256_set1_epi32(static_cast<int>(max_iy_));
+  const __m256i max_iz = _mm256_set1_epi32(static_cast<int>(max_iz_));
+  const __m256i stride_y = _mm256_set1_epi32(static_cast<int>(stride_y_));
+  const __m256i stride_z = _mm256_set1_epi32(static_cast<int>(stride_z_));
+  const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  for (; i + 8 <= end; i += 8) {
+    const __m256i ix = _mm256_min_epi32(
+        _mm256_cvttps_epi32(_mm256_mul_ps(
+            _mm256_sub_ps(_mm256_loadu_ps(&x[i]), min_x), inv_x)),
+        max_ix);
+    const __m256i iy = _mm256_min_epi32(
+        _mm256_cvttps_epi32(_mm256_mul_ps(
+            _mm256_sub_ps(_mm256_loadu_ps(&y[i]), min_y), inv_y)),
+        max_iy);
+    const __m256i iz = _mm256_min_epi32(
+        _mm256_cvttps_epi32(_mm256_mul_ps(
+            _mm256_sub_ps(_mm256_loadu_ps(&z[i]), min_z), inv_z)),
+        max_iz);
+    // the low 32 bits of the products are exact as the index fits uint32
+    const __m256i voxel = _mm256_add_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi32(iz, stride_z),
+                         _mm256_mullo_epi32(iy, stride_y)),
+        ix);
+    const __m256i index = _mm256_add_epi32(
+        _mm256_set1_epi32(static_cast<int>(i)), lane);
+    const __m256i lo = _mm256_unpacklo_epi32(index, voxel);
+    const __m256i hi = _mm256_unpackhi_epi32(index, voxel);
+    // unpack works within 128 bit lanes, put the keys back in point order
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(&keys_[i]),
+                        _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(&keys_[i + 4]),
+                        _mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+#elif defined(__aarch64__)
+  const float32x4_t min_x = vdupq_n_f32(min_x_);
+  const float32x4_t min_y = vdupq_n_f32(min_y_);
+  const float32x4_t min_z = vdupq_n_f32(min_z_);
+  const float32x4_t inv_x = vdupq_n_f32(inv_leaf_x_);
+  const float32x4_t inv_y = vdupq_n_f32(inv_leaf_y_);
+  const float32x4_t inv_z = vdupq_n_f32(inv_leaf_z_);
+  const uint32x4_t max_ix = vdupq_n_u32(max_ix_);
+  const uint32x4_t max_iy = vdupq_n_u32(max_iy_);
+  const uint32x4_t max_iz = vdupq_n_u32(max_iz_);
+  const uint32x4_t stride_y = vdupq_n_u32(stride_y_);
+  const uint32x4_t stride_z = vdupq_n_u32(stride_z_);
+  const uint32_t lane_init[4] = {0, 1, 2, 3};
+  const uint32x4_t lane = vld1q_u32(lane_init);
+  for (; i + 4 <= end; i += 4) {
+    const uint32x4_t ix = vminq_u32(
+        vcvtq_u32_f32(vmulq_f32(vsubq_f32(vld1q_f32(&x[i]), min_x), inv_x)),
+        max_ix);
+    const uint32x4_t iy = vminq_u32(
+        vcvtq_u32_f32(vmulq_f32(vsubq_f32(vld1q_f32(&y[i]), min_y), inv_y)),
+        max_iy);
+    const uint32x4_t iz = vminq_u32(
+        vcvtq_u32_f32(vmulq_f32(vsubq_f32(vld1q_f32(&z[i]), min_z), inv_z)),
+        max_iz);
+    const uint32x4_t voxel =
+        vmlaq_u32(vmlaq_u32(ix, iy, stride_y), iz, stride_z);
+    const uint32x4_t index =
+        vaddq_u32(vdupq_n_u32(static_cast<uint32_t>(i)), lane);
+    // interleave to little endian (index, voxel) pairs
+    uint32x4x2_t pairs;
+    pairs.val[0] = index;
+    pairs.val[1] = voxel;
+    vst2q_u32(reinterpret_cast<uint32_t *>(&keys_[i]), pairs);
+  }
+#endif
+
+  for (; i < end; ++i) {
+    const uint32_t ix = std::min(
+        static_cast<uint32_t>((x[i] - min_x_) * inv_leaf_x_), max_ix_);
+    const uint32_t iy = std::min(
+        static_cast<uint32_t>((y[i] - min_y_) * inv_leaf_y_), max_iy_);
+    const uint32_t iz = std::min(
+        static_cast<uint32_t>((z[i] - min_z_) * inv_leaf_z_), max_iz_);
+    const uint64_t voxel = iz * stride_z_ + iy * stride_y_ + ix;
+    keys_[i] = (voxel << kIndexBits) | static_cast<uint64_t>(i);
+  }
+}
+
+void VoxelGrid::SortKeys() {
+  const int num_chunks = NumChunks(keys_.size());
+  if (num_chunks <= 1) {
+    std::sort(keys_.begin(), keys_.end());
+    return;
+  }
+  std::vector<size_t> bounds;
+  const size_t chunk = (keys_.size() + num_chunks - 1) / num_chunks;
+  for (size_t begin = 0; begin < keys_.size(); begin += chunk) {
+    bounds.push_back(begin);
+  }
+  bounds.push_back(keys_.size());
+  std::vector<std::future<void>> results;
+  for (size_t c = 0; c + 1 < bounds.size(); ++c) {
+    results.push_back(cyber::Async([this, &bounds, c]() {
+      std::sort(keys_.begin() + bounds[c], keys_.begin() + bounds[c + 1]);
+    }));
+  }
+  for (auto &result : results) {
+    result.wait();
+  }
+  for (size_t c = 1; c + 1 < bounds.size(); ++c) {
+    std::inplace_merge(keys_.begin(), keys_.begin() + bounds[c],
+                       keys_.begin() + bounds[c + 1]);
+  }
+}
+
+void VoxelGrid::Centroids(const std::vector<float> &x,
+                          const std::vector<float> &y,
+                          const std::vector<float> &z,
+                          std::vector<float> *centroid_x,
+                          std::vector<float> *centroid_y,
+                          std::vector<float> *centroid_z) const {
+  const size_t num = num_voxels();
+  centroid_x->resize(num);
+  centroid_y->resize(num);
+  centroid_z->resize(num);
+  const int num_chunks = NumChunks(order_.size());
+  if (num_chunks <= 1) {
+    CentroidsInRange(x, y, z, 0, num, centroid_x, centroid_y, centroid_z);
+    return;
+  }
+  std::vector<std::future<void>> results;
+  const size_t chunk = (num + num_chunks - 1) / num_chunks;
+  for (size_t begin = 0; begin < num; begin += chunk) {
+    const size_t end = std::min(begin + chunk, num);
+    results.push_back(cyber::Async([&, begin, end]() {
+      CentroidsInRange(x, y, z, begin, end, centroid_x, centroid_y,
+                       centroid_z);
+    }));
+  }
+  for (auto &result : results) {
+    result.wait();
+  }
+}
+
+void VoxelGrid::CentroidsInRange(const std::vector<float> &x,
+                                 const std::vector<float> &y,
+                                 const std::vector<float> &z,
+                                 const size_t begin, const size_t end,
+                                 std::vector<float> *centroid_x,
+                                 std::vector<float> *centroid_y,
+                                 std::vector<float> *centroid_z) const {
+  for (size_t v = begin; v < end; ++v) {
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_z = 0.0;
+    for (uint32_t k = voxel_begin_[v]; k < voxel_begin_[v + 1]; ++k) {
+      sum_x += x[order_[k]];
+      sum_y += y[order_[k]];
+      sum_z += z[order_[k]];
+    }
+    const double count = static_cast<double>(voxel_begin_[v + 1] -
+                                             voxel_begin_[v]);
+    (*centroid_x)[v] = static_cast<float>(sum_x / count);
+    (*centroid_y)[v] = static_cast<float>(sum_y / count);
+    (*centroid_z)[v] = static_cast<float>(sum_z / count);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
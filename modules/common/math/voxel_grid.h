@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The class of VoxelGrid, and voxel grid downsampling of point clouds.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class VoxelGrid
+ * @brief Groups points by the axis aligned voxel they fall in.
+ *
+ * The voxel keys are computed with AVX2 on x86 and NEON on aarch64, and large
+ * clouds are split over several threads.
+ */
+class VoxelGrid {
+ public:
+  /**
+   * @brief Constructor which takes the voxel size along each axis.
+   */
+  VoxelGrid(const float leaf_x, const float leaf_y, const float leaf_z);
+
+  /**
+   * @brief Set the number of threads used for clouds with many points.
+   * @param num_threads The number of threads, 1 means serial.
+   */
+  void set_num_threads(const int num_threads) { num_threads_ = num_threads; }
+
+  /**
+   * @brief Sort the points into voxels.
+   * @param x The x coordinates of the points, all finite.
+   * @param y The y coordinates of the points, all finite.
+   * @param z The z coordinates of the points, all finite.
+   * @return False if the leaf size is not positive or the cloud spans too
+   *         many voxels along an axis.
+   */
+  bool Build(const std::vector<float> &x, const std::vector<float> &y,
+             const std::vector<float> &z);
+
+  /**
+   * @brief Getter of the number of occupied voxels of the last Build.
+   */
+  size_t num_voxels() const {
+    return voxel_begin_.empty() ? 0 : voxel_begin_.size() - 1;
+  }
+
+  /**
+   * @brief Point indices grouped by voxel, the points of voxel v are
+   *        order()[voxel_begin()[v]] to order()[voxel_begin()[v + 1] - 1].
+   */
+  const std::vector<uint32_t> &order() const { return order_; }
+  const std::vector<uint32_t> &voxel_begin() const { return voxel_begin_; }
+
+  /**
+   * @brief Compute the centroid of the points of every voxel.
+   * @param x The x coordinates passed to Build.
+   * @param y The y coordinates passed to Build.
+   * @param z The z coordinates passed to Build.
+   */
+  void Centroids(const std::vector<float> &x, const std::vector<float> &y,
+                 const std::vector<float> &z, std::vector<float> *centroid_x,
+                 std::vector<float> *centroid_y,
+                 std::vector<float> *centroid_z) const;
+
+ private:
+  void ComputeKeys(const std::vector<float> &x, const std::vector<float> &y,
+                   const std::vector<float> &z, const size_t begin,
+                   const size_t end);
+  void SortKeys();
+  void CentroidsInRange(const std::vector<float> &x,
+                        const std::vector<float> &y,
+                        const std::vector<float> &z, const size_t begin,
+                        const size_t end, std::vector<float> *centroid_x,
+                        std::vector<float> *centroid_y,
+                        std::vector<float> *centroid_z) const;
+  int NumChunks(const size_t size) const;
+
+  float inv_leaf_x_ = 0.0f;
+  float inv_leaf_y_ = 0.0f;
+  float inv_leaf_z_ = 0.0f;
+  float min_x_ = 0.0f;
+  float min_y_ = 0.0f;
+  float min_z_ = 0.0f;
+  uint32_t max_ix_ = 0;
+  uint32_t max_iy_ = 0;
+  uint32_t max_iz_ = 0;
+  uint32_t stride_y_ = 0;
+  uint32_t stride_z_ = 0;
+  int num_threads_ = 1;
+
+  // The voxel key of each point in its high bits and the point index in the
+  // low 32 bits, so that one sort groups the points by voxel.
+  std::vector<uint64_t> keys_;
+  std::vector<uint32_t> order_;
+  std::vector<uint32_t> voxel_begin_;
+};
+
+/**
+ * @brief Replace the points of each voxel with their centroid, as
+ *        pcl::VoxelGrid does. Fields other than x, y and z are taken from the
+ *        first point of the voxel, and non finite points are dropped.
+ * @param cloud The input cloud, indexable with points having x, y and z.
+ * @param leaf_x The voxel size along x.
+ * @param leaf_y The voxel size along y.
+ * @param leaf_z The voxel size along z.
+ * @param out_cloud The output cloud, it must have push_back.
+ * @param num_threads The number of threads for large clouds.
+ * @return False if the cloud can not be gridded, out_cloud then has all the
+ *         finite points of the input.
+ */
+template <typename CloudT, typename OutCloudT>
+bool VoxelGridDownsample(const CloudT &cloud, const float leaf_x,
+                         const float leaf_y, const float leaf_z,
+                         OutCloudT *out_cloud, const int num_threads = 1) {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+  std::vector<uint32_t> indices;
+  const size_t size = cloud.size();
+  x.reserve(size);
+  y.reserve(size);
+  z.reserve(size);
+  indices.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    const auto &point = cloud[i];
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) ||
+        !std::isfinite(point.z)) {
+      continue;
+    }
+    x.push_back(point.x);
+    y.push_back(point.y);
+    z.push_back(point.z);
+    indices.push_back(static_cast<uint32_t>(i));
+  }
+
+  VoxelGrid grid(leaf_x, leaf_y, leaf_z);
+  grid.set_num_threads(num_threads);
+  if (!grid.Build(x, y, z)) {
+    for (const uint32_t index : indices) {
+      out_cloud->push_back(cloud[index]);
+    }
+    return false;
+  }
+  std::vector<float> centroid_x;
+  std::vector<float> centroid_y;
+  std::vector<float> centroid_z;
+  grid.Centroids(x, y, z, &centroid_x, &centroid_y, &centroid_z);
+  for (size_t v = 0; v < grid.num_voxels(); ++v) {
+    auto point = cloud[indices[grid.order()[grid.voxel_begin()[v]]]];
+    point.x = centroid_x[v];
+    point.y = centroid_y[v];
+    point.z = centroid_z[v];
+    out_cloud->push_back(point);
+  }
+  return true;
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
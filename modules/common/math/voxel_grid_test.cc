@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/voxel_grid.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <tuple>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+struct TestPoint {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+  int id = 0;
+};
+
+using VoxelIndex = std::tuple<int, int, int>;
+
+VoxelIndex VoxelOf(const TestPoint &point, const TestPoint &min_point,
+                   const float leaf) {
+  return VoxelIndex(static_cast<int>((point.x - min_point.x) * (1.0f / leaf)),
+                    static_cast<int>((point.y - min_point.y) * (1.0f / leaf)),
+                    static_cast<int>((point.z - min_point.z) * (1.0f / leaf)));
+}
+
+std::vector<TestPoint> RandomCloud(const size_t size) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> xy(-60.0f, 60.0f);
+  std::uniform_real_distribution<float> z(-2.0f, 3.0f);
+  std::vector<TestPoint> cloud(size);
+  for (size_t i = 0; i < size; ++i) {
+    cloud[i].x = xy(gen);
+    cloud[i].y = xy(gen);
+    cloud[i].z = z(gen);
+    cloud[i].id = static_cast<int>(i);
+  }
+  return cloud;
+}
+
+void ExpectSameAsBruteForce(const int num_threads) {
+  const float leaf = 0.5f;
+  const auto cloud = RandomCloud(100000);
+  std::vector<TestPoint> out;
+  EXPECT_TRUE(VoxelGridDownsample(cloud, leaf, leaf, leaf, &out, num_threads));
+
+  // centroids of the voxels computed one point at a time
+  TestPoint min_point = cloud[0];
+  for (const auto &point : cloud) {
+    min_point.x = std::min(min_point.x, point.x);
+    min_point.y = std::min(min_point.y, point.y);
+    min_point.z = std::min(min_point.z, point.z);
+  }
+  std::map<VoxelIndex, std::vector<double>> voxels;
+  std::map<int, VoxelIndex> voxel_of_id;
+  for (const auto &point : cloud) {
+    const VoxelIndex index = VoxelOf(point, min_point, leaf);
+    auto &sum = voxels[index];
+    sum.resize(4, 0.0);
+    sum[0] += point.x;
+    sum[1] += point.y;
+    sum[2] += point.z;
+    sum[3] += 1.0;
+    voxel_of_id[point.id] = index;
+  }
+  ASSERT_EQ(out.size(), voxels.size());
+
+  // the fields other than x, y and z tell which voxel a centroid is of
+  std::set<VoxelIndex> seen;
+  for (const auto &point : out) {
+    const VoxelIndex index = voxel_of_id[point.id];
+    EXPECT_TRUE(seen.insert(index).second);
+    const auto &sum = voxels[index];
+    EXPECT_NEAR(point.x, sum[0] / sum[3], 1e-4);
+    EXPECT_NEAR(point.y, sum[1] / sum[3], 1e-4);
+    EXPECT_NEAR(point.z, sum[2] / sum[3], 1e-4);
+  }
+}
+
+}  // namespace
+
+TEST(VoxelGridTest, serial) { ExpectSameAsBruteForce(1); }
+
+TEST(VoxelGridTest, parallel) { ExpectSameAsBruteForce(4); }
+
+TEST(VoxelGridTest, small_cloud) {
+  std::vector<TestPoint> cloud(5);
+  cloud[0].x = 0.1f;
+  cloud[1].x = 0.3f;
+  cloud[2].x = 1.2f;
+  cloud[3].x = std::numeric_limits<float>::quiet_NaN();
+  cloud[4].x = 1.4f;
+  for (int i = 0; i < 5; ++i) {
+    cloud[i].id = i;
+  }
+  std::vector<TestPoint> out;
+  EXPECT_TRUE(VoxelGridDownsample(cloud, 1.0f, 1.0f, 1.0f, &out));
+  ASSERT_EQ(out.size(), 2);
+  EXPECT_FLOAT_EQ(out[0].x, 0.2f);
+  EXPECT_EQ(out[0].id, 0);
+  EXPECT_FLOAT_EQ(out[1].x, 1.3f);
+  EXPECT_EQ(out[1].id, 2);
+
+  VoxelGrid grid(1.0f, 1.0f, 1.0f);
+  EXPECT_TRUE(grid.Build({0.0f, 0.5f, 2.0f}, {0.0f, 0.0f, 0.0f},
+                         {0.0f, 0.0f, 0.0f}));
+  EXPECT_EQ(grid.num_voxels(), 2);
+  EXPECT_EQ(grid.voxel_begin()[1], 2);
+}
+
+TEST(VoxelGridTest, invalid) {
+  std::vector<TestPoint> cloud(2);
+  cloud[1].x = 1.0e6f;
+  cloud[1].y = 1.0e6f;
+  std::vector<TestPoint> out;
+  EXPECT_FALSE(VoxelGridDownsample(cloud, 0.01f, 0.01f, 0.01f, &out));
+  EXPECT_EQ(out.size(), 2);
+
+  out.clear();
+  EXPECT_FALSE(VoxelGridDownsample(cloud, 0.0f, 1.0f, 1.0f, &out));
+  EXPECT_EQ(out.size(), 2);
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
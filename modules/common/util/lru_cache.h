@@ -179,6 +179,7 @@ class LRUCache {
     }
     auto* node = &map_[key];
     Detach(node);
+    map_.erase(key);
     return true;
   }
 
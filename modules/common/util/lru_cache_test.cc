@@ -84,6 +84,27 @@ TEST(LRUCache, UAF) {
   cache.Clear();
 }
 
+TEST(LRUCache, Remove) {
+  LRUCache<int, int> cache(CAPACITY);
+  for (int i = 0; i < CAPACITY; ++i) {
+    cache.Put(i, i * 2);
+  }
+  EXPECT_TRUE(cache.Remove(1));
+  EXPECT_FALSE(cache.Remove(1));
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_EQ(CAPACITY - 1, cache.size());
+
+  // the removed element leaves room, nothing is obsolete
+  int obsolete = -1;
+  int val = 8;
+  cache.PutAndGetObsolete(4, &val, &obsolete);
+  EXPECT_EQ(-1, obsolete);
+  EXPECT_EQ(CAPACITY, cache.size());
+  EXPECT_EQ(4, cache.First()->key);
+  EXPECT_EQ(0, cache.Last()->key);
+}
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
@@ -21,6 +21,7 @@
 
 #include "cyber/common/macros.h"
 #include "cyber/time/time.h"
+#include "modules/common/util/profiler.h"
 
 #if defined(__GNUC__) || defined(__GNUG__)
 #define AFUNC __PRETTY_FUNCTION__
@@ -31,17 +32,13 @@
 #endif
 
 // How to Use:
-// 1)  Use PERF_FUNCTION to compute time cost of function execution as follows:
+// 1)  Use PERF_FUNCTION to profile function execution as follows:
 //      void MyFunc() {
 //          PERF_FUNCION();
 //          // do somethings.
 //      }
-//  Console log:
-//  >>>>>>>>>>>>>>>>>>
-//  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER MyFunc elapsed time: 100 ms
-//  >>>>>>>>>>>>>>>>>>
 //
-//  2) Use PERF_BLOCK_START/END to compute time cost of block execution.
+//  2) Use PERF_BLOCK_START/END to profile consecutive blocks.
 //      void MyFunc() {
 //          // xxx1
 //          PERF_BLOCK_START();
@@ -55,11 +52,8 @@
 //          PERF_BLOCK_END("xx3");
 //      }
 //
-//  Console log:
-//  >>>>>>>>>>>>>>>
-//  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx2 elapsed time: 100 ms
-//  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx3 elapsed time: 200 ms
-//  >>>>>>>>>>>>>>>
+//  Both record zones of the profiler, see profiler.h for enabling them per
+//  module at run time with --profiler_modules.
 namespace apollo {
 namespace common {
 namespace util {
@@ -104,30 +98,24 @@ class TimerWrapper {
 }  // namespace common
 }  // namespace apollo
 
-#if defined(ENABLE_PERF)
-#define PERF_FUNCTION()                               \
-  apollo::common::util::TimerWrapper _timer_wrapper_( \
-      apollo::common::util::function_signature(AFUNC))
-#define PERF_FUNCTION_WITH_NAME(func_name) \
-  apollo::common::util::TimerWrapper _timer_wrapper_(func_name)
-#define PERF_FUNCTION_WITH_INDICATOR(indicator)       \
-  apollo::common::util::TimerWrapper _timer_wrapper_( \
+#define PERF_FUNCTION() \
+  PROFILE_ZONE(apollo::common::util::function_signature(AFUNC))
+#define PERF_FUNCTION_WITH_NAME(func_name) PROFILE_DYNAMIC_ZONE(func_name)
+#define PERF_FUNCTION_WITH_INDICATOR(indicator) \
+  PROFILE_DYNAMIC_ZONE(                         \
       apollo::common::util::function_signature(AFUNC, indicator))
-#define PERF_BLOCK_START()             \
-  apollo::common::util::Timer _timer_; \
-  _timer_.Start()
-#define PERF_BLOCK_END(msg) _timer_.End(msg)
-#define PERF_BLOCK_END_WITH_INDICATOR(indicator, msg) \
-  _timer_.End(absl::StrCat(indicator, "_", msg))
-#else
-#define PERF_FUNCTION()
-#define PERF_FUNCTION_WITH_NAME(func_name) UNUSED(func_name);
-#define PERF_FUNCTION_WITH_INDICATOR(indicator) UNUSED(indicator);
-#define PERF_BLOCK_START()
-#define PERF_BLOCK_END(msg) UNUSED(msg);
-#define PERF_BLOCK_END_WITH_INDICATOR(indicator, msg) \
-  {                                                   \
-    UNUSED(indicator);                                \
-    UNUSED(msg);                                      \
-  }
-#endif  // ENABLE_PERF
+#define PERF_BLOCK_START()                                                 \
+  static const apollo::common::util::ProfileModule _perf_module_(__FILE__); \
+  apollo::common::util::ProfileBlock _perf_block_(_perf_module_)
+#define PERF_BLOCK_END(msg)         \
+  do {                              \
+    if (_perf_module_.enabled()) {  \
+      _perf_block_.End(msg);        \
+    }                               \
+  } while (0)
+#define PERF_BLOCK_END_WITH_INDICATOR(indicator, msg)    \
+  do {                                                   \
+    if (_perf_module_.enabled()) {                       \
+      _perf_block_.End(absl::StrCat(indicator, "_", msg)); \
+    }                                                    \
+  } while (0)
@@ -0,0 +1,324 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/profiler.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+
+#include "cyber/common/log.h"
+#include "modules/common/configs/config_gflags.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class ThreadEventBuffer
+ * @brief Single producer single consumer ring of the events of one thread.
+ */
+class ThreadEventBuffer {
+ public:
+  explicit ThreadEventBuffer(const uint32_t thread_id)
+      : thread_id_(thread_id) {}
+
+  bool Push(const uint32_t zone_id, const int64_t start_ns,
+            const int64_t end_ns) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= events_.size()) {
+      return false;
+    }
+    auto& event = events_[head % events_.size()];
+    event.zone_id = zone_id;
+    event.thread_id = thread_id_;
+    event.start_ns = start_ns;
+    event.end_ns = end_ns;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  void Drain(std::vector<Profiler::Event>* events) {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    for (; tail != head; ++tail) {
+      events->push_back(events_[tail % events_.size()]);
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) ==
+           tail_.load(std::memory_order_acquire);
+  }
+
+  std::atomic<bool> thread_alive{true};
+
+ private:
+  const uint32_t thread_id_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
+  std::array<Profiler::Event, Profiler::kThreadBufferSize> events_;
+};
+
+namespace {
+
+// keeps the buffer of the thread and tells the collector when the thread
+// is gone, so the buffer is dropped once drained
+struct ThreadBufferHolder {
+  ~ThreadBufferHolder() {
+    if (buffer != nullptr) {
+      buffer->thread_alive = false;
+    }
+  }
+  std::shared_ptr<ThreadEventBuffer> buffer;
+};
+
+thread_local ThreadBufferHolder thread_buffer;
+
+std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+}  // namespace
+
+Profiler::Profiler() { SetEnabledModules(FLAGS_profiler_modules); }
+
+Profiler::~Profiler() { Shutdown(); }
+
+std::string Profiler::ModuleOfFile(const std::string& file) {
+  constexpr char kModules[] = "modules/";
+  const auto begin = file.rfind(kModules);
+  if (begin != std::string::npos) {
+    const auto name_begin = begin + sizeof(kModules) - 1;
+    return file.substr(name_begin, file.find('/', name_begin) - name_begin);
+  }
+  if (file.find("cyber/") != std::string::npos) {
+    return "cyber";
+  }
+  return "unknown";
+}
+
+int64_t Profiler::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint32_t Profiler::RegisterModule(const std::string& module) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  auto it = module_indices_.find(module);
+  if (it != module_indices_.end()) {
+    return it->second;
+  }
+  if (modules_.size() >= kMaxModules) {
+    AWARN << "Too many profiled modules, " << module << " shares the bit of "
+          << modules_.back();
+    return kMaxModules - 1;
+  }
+  const uint32_t index = static_cast<uint32_t>(modules_.size());
+  modules_.push_back(module);
+  module_indices_.emplace(module, index);
+  if (all_modules_ || std::find(enabled_modules_.begin(),
+                                enabled_modules_.end(),
+                                module) != enabled_modules_.end()) {
+    enabled_mask_.fetch_or(uint64_t{1} << index);
+  }
+  return index;
+}
+
+uint32_t Profiler::RegisterZone(const uint32_t module,
+                                const std::string& name) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  const std::string key = absl::StrCat(module, "/", name);
+  auto it = zone_ids_.find(key);
+  if (it != zone_ids_.end()) {
+    return it->second;
+  }
+  const uint32_t id = static_cast<uint32_t>(zones_.size());
+  zones_.push_back({module, name});
+  zone_ids_.emplace(key, id);
+  return id;
+}
+
+void Profiler::SetEnabledModules(const std::string& modules) {
+  uint64_t mask = 0;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    enabled_modules_ = absl::StrSplit(modules, ',', absl::SkipWhitespace());
+    all_modules_ = std::find(enabled_modules_.begin(), enabled_modules_.end(),
+                             "all") != enabled_modules_.end();
+    for (size_t i = 0; i < modules_.size(); ++i) {
+      if (all_modules_ ||
+          std::find(enabled_modules_.begin(), enabled_modules_.end(),
+                    modules_[i]) != enabled_modules_.end()) {
+        mask |= uint64_t{1} << i;
+      }
+    }
+  }
+  enabled_mask_ = mask;
+
+  const bool enabled = all_modules_ || !enabled_modules_.empty();
+  if (enabled && !FLAGS_profiler_trace_file.empty()) {
+    std::lock_guard<std::mutex> lock(collector_mutex_);
+    if (!collector_.joinable() && !stop_collector_) {
+      collector_ = std::thread(&Profiler::CollectorThread, this);
+    }
+  }
+}
+
+ThreadEventBuffer* Profiler::CurrentThreadBuffer() {
+  if (thread_buffer.buffer == nullptr) {
+    static std::atomic<uint32_t> next_thread_id{0};
+    thread_buffer.buffer =
+        std::make_shared<ThreadEventBuffer>(next_thread_id++);
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    buffers_.push_back(thread_buffer.buffer);
+  }
+  return thread_buffer.buffer.get();
+}
+
+void Profiler::Record(const uint32_t zone_id, const int64_t start_ns,
+                      const int64_t end_ns) {
+  if (!CurrentThreadBuffer()->Push(zone_id, start_ns, end_ns)) {
+    dropped_events_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Profiler::Collect(std::vector<Event>* events) {
+  std::lock_guard<std::mutex> lock(buffers_mutex_);
+  for (auto& buffer : buffers_) {
+    buffer->Drain(events);
+  }
+  buffers_.erase(
+      std::remove_if(buffers_.begin(), buffers_.end(),
+                     [](const std::shared_ptr<ThreadEventBuffer>& buffer) {
+                       return !buffer->thread_alive && buffer->empty();
+                     }),
+      buffers_.end());
+}
+
+std::string Profiler::ToChromeTraceEvents(
+    const std::vector<Event>& events) const {
+  const int pid = static_cast<int>(getpid());
+  std::vector<Zone> zones;
+  std::vector<std::string> modules;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    zones = zones_;
+    modules = modules_;
+  }
+  std::string trace;
+  for (const auto& event : events) {
+    if (event.zone_id >= zones.size()) {
+      continue;
+    }
+    const Zone& zone = zones[event.zone_id];
+    if (!trace.empty()) {
+      trace.append(",\n");
+    }
+    // the viewers take microseconds, keep the nanoseconds as decimals
+    absl::StrAppend(&trace, "{\"name\":\"", EscapeJson(zone.name),
+                    "\",\"cat\":\"", modules[zone.module],
+                    "\",\"ph\":\"X\",\"ts\":", event.start_ns / 1000, ".",
+                    absl::Dec(event.start_ns % 1000, absl::kZeroPad3),
+                    ",\"dur\":", (event.end_ns - event.start_ns) / 1000, ".",
+                    absl::Dec((event.end_ns - event.start_ns) % 1000,
+                              absl::kZeroPad3),
+                    ",\"pid\":", pid, ",\"tid\":", event.thread_id, "}");
+  }
+  return trace;
+}
+
+void Profiler::Flush() {
+  std::vector<Event> events;
+  Collect(&events);
+  if (events.empty() || FLAGS_profiler_trace_file.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(flush_mutex_);
+  if (!trace_file_.is_open()) {
+    // one trace per process, the viewers merge them by pid
+    const std::string file_name =
+        absl::StrCat(FLAGS_profiler_trace_file, ".", getpid(), ".json");
+    trace_file_.open(file_name, std::ios::out | std::ios::trunc);
+    if (!trace_file_.is_open()) {
+      AERROR << "Failed to open profiler trace file " << file_name;
+      return;
+    }
+    trace_file_ << "[\n";
+  }
+  trace_file_ << ToChromeTraceEvents(events) << ",\n";
+  trace_file_.flush();
+}
+
+void Profiler::CollectorThread() {
+  std::unique_lock<std::mutex> lock(collector_mutex_);
+  while (!stop_collector_) {
+    collector_cv_.wait_for(
+        lock, std::chrono::milliseconds(FLAGS_profiler_flush_interval_ms));
+    lock.unlock();
+    Flush();
+    const uint64_t dropped = dropped_events_.exchange(0);
+    if (dropped > 0) {
+      AWARN << "Profiler dropped " << dropped
+            << " events, flush more often or profile fewer modules";
+    }
+    lock.lock();
+  }
+}
+
+void Profiler::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(collector_mutex_);
+    stop_collector_ = true;
+  }
+  collector_cv_.notify_all();
+  if (collector_.joinable()) {
+    collector_.join();
+  }
+  Flush();
+}
+
+void ProfileBlock::End(const std::string& name) {
+  if (!module_.enabled()) {
+    return;
+  }
+  const int64_t now = Profiler::NowNs();
+  // the block started while the module was disabled
+  if (start_ns_ != 0) {
+    auto* profiler = Profiler::Instance();
+    profiler->Record(profiler->RegisterZone(module_.index(), name), start_ns_,
+                     now);
+  }
+  start_ns_ = now;
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
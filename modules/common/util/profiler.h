@@ -0,0 +1,285 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Low overhead scoped zone profiler for the hot paths of all modules.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+// How to Use:
+//   void MyFunc() {
+//     PROFILE_ZONE("MyFunc");
+//     // do somethings.
+//   }
+//
+// The zone belongs to the module of the file it is in, e.g. "perception" for
+// modules/perception/..., and is only recorded while that module is enabled:
+//   --profiler_modules=perception,planning (or "all")
+// The events land in a ring buffer of the recording thread and the collector
+// appends them to --profiler_trace_file.<pid>.json as Chrome trace events,
+// which chrome://tracing and the Perfetto UI load. While a module is disabled
+// a zone costs one relaxed atomic load.
+
+namespace apollo {
+namespace common {
+namespace util {
+
+class ThreadEventBuffer;
+
+/**
+ * @class Profiler
+ * @brief Registry of the zones and collector of the events of all threads.
+ */
+class Profiler {
+ public:
+  struct Event {
+    uint32_t zone_id = 0;
+    uint32_t thread_id = 0;
+    int64_t start_ns = 0;
+    int64_t end_ns = 0;
+  };
+
+  // modules beyond this share the last bit
+  static constexpr uint32_t kMaxModules = 64;
+  // events a thread can record between two collections
+  static constexpr size_t kThreadBufferSize = 16384;
+
+  ~Profiler();
+
+  /**
+   * @brief the module of a source file, the directory below modules/, or
+   * "cyber" for the files of cyber
+   */
+  static std::string ModuleOfFile(const std::string& file);
+
+  static int64_t NowNs();
+
+  /**
+   * @brief index of the module, the same name always gives the same index
+   */
+  uint32_t RegisterModule(const std::string& module);
+
+  /**
+   * @brief id of the zone, the same module and name always give the same id
+   */
+  uint32_t RegisterZone(const uint32_t module, const std::string& name);
+
+  /**
+   * @brief replaces the enabled modules with a comma separated list of module
+   * names, "all" enables every module and an empty list disables profiling
+   */
+  void SetEnabledModules(const std::string& modules);
+
+  bool IsModuleEnabled(const uint32_t module) const {
+    return (enabled_mask_.load(std::memory_order_relaxed) >> module) & 1;
+  }
+
+  /**
+   * @brief records one event in the ring buffer of the calling thread, drops
+   * it if the buffer is full
+   */
+  void Record(const uint32_t zone_id, const int64_t start_ns,
+              const int64_t end_ns);
+
+  /**
+   * @brief moves the events recorded so far by all threads to events
+   */
+  void Collect(std::vector<Event>* events);
+
+  /**
+   * @brief the events as Chrome trace "complete" events, separated by ",\n"
+   */
+  std::string ToChromeTraceEvents(const std::vector<Event>& events) const;
+
+  /**
+   * @brief collects the events and appends them to FLAGS_profiler_trace_file
+   */
+  void Flush();
+
+  /**
+   * @brief number of events dropped because a ring buffer was full
+   */
+  uint64_t dropped_events() const { return dropped_events_.load(); }
+
+  void Shutdown();
+
+ private:
+  struct Zone {
+    uint32_t module = 0;
+    std::string name;
+  };
+
+  ThreadEventBuffer* CurrentThreadBuffer();
+  void CollectorThread();
+
+  std::atomic<uint64_t> enabled_mask_{0};
+  std::atomic<uint64_t> dropped_events_{0};
+
+  mutable std::mutex registry_mutex_;
+  std::vector<std::string> modules_;
+  std::unordered_map<std::string, uint32_t> module_indices_;
+  std::vector<Zone> zones_;
+  std::unordered_map<std::string, uint32_t> zone_ids_;
+  // what SetEnabledModules asked for, modules registered later are checked
+  // against it
+  bool all_modules_ = false;
+  std::vector<std::string> enabled_modules_;
+
+  std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<ThreadEventBuffer>> buffers_;
+
+  // the trace file has no closing ']', which the trace viewers accept
+  std::mutex flush_mutex_;
+  std::ofstream trace_file_;
+
+  std::mutex collector_mutex_;
+  std::condition_variable collector_cv_;
+  std::thread collector_;
+  bool stop_collector_ = false;
+
+  DECLARE_SINGLETON(Profiler)
+};
+
+/**
+ * @class ProfileModule
+ * @brief The module of a call site, resolved once.
+ */
+class ProfileModule {
+ public:
+  explicit ProfileModule(const char* file)
+      : index_(Profiler::Instance()->RegisterModule(
+            Profiler::ModuleOfFile(file))) {}
+
+  uint32_t index() const { return index_; }
+  bool enabled() const { return Profiler::Instance()->IsModuleEnabled(index_); }
+
+ private:
+  const uint32_t index_;
+};
+
+/**
+ * @class ProfileZone
+ * @brief A named zone of a call site, registered once.
+ */
+class ProfileZone {
+ public:
+  ProfileZone(const char* file, const std::string& name)
+      : module_(file),
+        id_(Profiler::Instance()->RegisterZone(module_.index(), name)) {}
+
+  uint32_t id() const { return id_; }
+  bool enabled() const { return module_.enabled(); }
+
+ private:
+  const ProfileModule module_;
+  const uint32_t id_;
+};
+
+/**
+ * @class ScopedProfile
+ * @brief Records its own lifetime as an event of the zone.
+ */
+class ScopedProfile {
+ public:
+  explicit ScopedProfile(const ProfileZone& zone)
+      : zone_id_(zone.id()), active_(zone.enabled()) {
+    if (active_) {
+      start_ns_ = Profiler::NowNs();
+    }
+  }
+
+  // for names only known at run time, registered on each use while enabled
+  ScopedProfile(const ProfileModule& module, const std::string& name)
+      : active_(module.enabled()) {
+    if (active_) {
+      zone_id_ = Profiler::Instance()->RegisterZone(module.index(), name);
+      start_ns_ = Profiler::NowNs();
+    }
+  }
+
+  ~ScopedProfile() {
+    if (active_) {
+      Profiler::Instance()->Record(zone_id_, start_ns_, Profiler::NowNs());
+    }
+  }
+
+ private:
+  uint32_t zone_id_ = 0;
+  bool active_ = false;
+  int64_t start_ns_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedProfile);
+};
+
+/**
+ * @class ProfileBlock
+ * @brief Records consecutive blocks, each from the previous End (or the
+ * construction) to the next End.
+ */
+class ProfileBlock {
+ public:
+  explicit ProfileBlock(const ProfileModule& module)
+      : module_(module), start_ns_(module.enabled() ? Profiler::NowNs() : 0) {}
+
+  void End(const std::string& name);
+
+ private:
+  const ProfileModule& module_;
+  int64_t start_ns_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileBlock);
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#define PROFILE_ZONE(name)                                               \
+  static const apollo::common::util::ProfileZone PROFILE_CONCAT(         \
+      _profile_zone_, __LINE__)(__FILE__, name);                         \
+  apollo::common::util::ScopedProfile PROFILE_CONCAT(_profile_scope_,    \
+                                                     __LINE__)(          \
+      PROFILE_CONCAT(_profile_zone_, __LINE__))
+
+// the name is only evaluated while the module is enabled
+#define PROFILE_DYNAMIC_ZONE(name)                                       \
+  static const apollo::common::util::ProfileModule PROFILE_CONCAT(       \
+      _profile_module_, __LINE__)(__FILE__);                             \
+  apollo::common::util::ScopedProfile PROFILE_CONCAT(_profile_scope_,    \
+                                                     __LINE__)(          \
+      PROFILE_CONCAT(_profile_module_, __LINE__),                        \
+      PROFILE_CONCAT(_profile_module_, __LINE__).enabled()               \
+          ? std::string(name)                                            \
+          : std::string())
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/profiler.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/config_gflags.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+namespace {
+
+void ProfiledFunction() { PROFILE_ZONE("ProfiledFunction"); }
+
+}  // namespace
+
+class ProfilerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    // the tests collect the events themselves, keep the collector off
+    FLAGS_profiler_trace_file.clear();
+  }
+};
+
+TEST_F(ProfilerTest, ModuleOfFile) {
+  EXPECT_EQ("perception", Profiler::ModuleOfFile(
+                              "modules/perception/lidar/app/detection.cc"));
+  EXPECT_EQ("planning",
+            Profiler::ModuleOfFile("/apollo/modules/planning/planning.cc"));
+  EXPECT_EQ("cyber", Profiler::ModuleOfFile("cyber/node/node.h"));
+  EXPECT_EQ("unknown", Profiler::ModuleOfFile("foo.cc"));
+}
+
+TEST_F(ProfilerTest, RecordsEnabledModules) {
+  auto* profiler = Profiler::Instance();
+  std::vector<Profiler::Event> events;
+  profiler->SetEnabledModules("");
+  profiler->Collect(&events);
+  events.clear();
+
+  ProfiledFunction();
+  profiler->Collect(&events);
+  EXPECT_TRUE(events.empty());
+
+  profiler->SetEnabledModules("planning,common");
+  std::thread worker([] {
+    for (int i = 0; i < 3; ++i) {
+      ProfiledFunction();
+    }
+  });
+  worker.join();
+  ProfiledFunction();
+  {
+    PROFILE_DYNAMIC_ZONE(std::string("Dynamic") + "Zone");
+  }
+  profiler->Collect(&events);
+  ASSERT_EQ(5, events.size());
+  for (const auto& event : events) {
+    EXPECT_LE(event.start_ns, event.end_ns);
+  }
+  EXPECT_EQ(events[0].zone_id, events[4 - 1].zone_id);
+  EXPECT_NE(events[0].zone_id, events[4].zone_id);
+  EXPECT_NE(events[0].thread_id, events[3].thread_id);
+
+  const std::string trace = profiler->ToChromeTraceEvents(events);
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"ProfiledFunction\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"DynamicZone\""));
+  EXPECT_NE(std::string::npos, trace.find("\"cat\":\"common\""));
+  EXPECT_NE(std::string::npos, trace.find("\"ph\":\"X\""));
+
+  events.clear();
+  profiler->SetEnabledModules("");
+  ProfiledFunction();
+  profiler->Collect(&events);
+  EXPECT_TRUE(events.empty());
+}
+
+TEST_F(ProfilerTest, Block) {
+  auto* profiler = Profiler::Instance();
+  profiler->SetEnabledModules("all");
+  std::vector<Profiler::Event> events;
+  profiler->Collect(&events);
+  events.clear();
+
+  static const ProfileModule module(__FILE__);
+  ProfileBlock block(module);
+  block.End("first");
+  block.End("second");
+  profiler->Collect(&events);
+  ASSERT_EQ(2, events.size());
+  EXPECT_EQ(events[0].end_ns, events[1].start_ns);
+  profiler->SetEnabledModules("");
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,312 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Thread safe sharded cache with CLOCK eviction.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/base/rw_lock_guard.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class ShardedLRUCache
+ * @brief A cache shared by many threads.
+ *
+ * The keys are spread over shards with their own lock, so threads touching
+ * different shards never wait for each other. Eviction is CLOCK, an
+ * approximation of LRU where a hit only sets the reference bit of the entry,
+ * so lookups only take the read side of the atomic lock of the shard and
+ * never wait for each other. Each entry is charged against the capacity,
+ * by 1 unless its size in bytes or other unit is given. Values are handed
+ * out as shared pointers which stay valid after eviction.
+ */
+template <class K, class V, class Hash = std::hash<K>>
+class ShardedLRUCache {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;
+    size_t size = 0;
+    size_t charge = 0;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param capacity The total charge the cache holds, split evenly over the
+   *        shards.
+   * @param num_shards The number of shards, rounded down to a power of two
+   *        and to at most capacity.
+   */
+  explicit ShardedLRUCache(const size_t capacity,
+                           const size_t num_shards = kDefaultNumShards);
+
+  /**
+   * @brief Looks up a value and marks it as recently used.
+   * @return The value, nullptr if not cached.
+   */
+  std::shared_ptr<V> Get(const K& key);
+
+  /**
+   * @brief Copies a value and marks it as recently used.
+   * @return True if the value is cached.
+   */
+  bool GetCopy(const K& key, V* const val);
+
+  /**
+   * @brief Adds or replaces a value, evicting other entries of its shard
+   *        until the charge fits.
+   * @param charge The charge of the entry against the capacity.
+   * @return The value as cached, which is not kept when the charge alone
+   *         exceeds the capacity of a shard.
+   */
+  std::shared_ptr<V> Put(const K& key, V val, const size_t charge = 1);
+
+  /**
+   * @brief Removes a value.
+   * @return True if the value was cached.
+   */
+  bool Remove(const K& key);
+
+  void Clear();
+
+  size_t capacity() const { return capacity_; }
+
+  size_t num_shards() const { return num_shards_; }
+
+  /**
+   * @brief The counters and the current size and charge summed over the
+   *        shards.
+   */
+  Stats GetStats() const;
+
+ private:
+  static constexpr size_t kDefaultNumShards = 16;
+
+  struct Entry {
+    std::shared_ptr<V> value;
+    size_t charge = 0;
+    std::atomic<bool> referenced{false};
+    typename std::list<K>::iterator clock_it;
+  };
+
+  struct Shard {
+    mutable cyber::base::AtomicRWLock lock;
+    std::unordered_map<K, Entry, Hash> entries;
+    // the CLOCK ring, hand points to the next entry to consider for eviction
+    std::list<K> clock;
+    typename std::list<K>::iterator hand = clock.end();
+    size_t charge = 0;
+    size_t capacity = 0;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> inserts{0};
+    std::atomic<uint64_t> evictions{0};
+  };
+
+  Shard& ShardOf(const K& key) {
+    if (shard_bits_ == 0) {
+      return shards_[0];
+    }
+    // fibonacci hashing, the identity hash of integers would only use the
+    // lowest bits
+    const uint64_t hash =
+        static_cast<uint64_t>(hasher_(key)) * 0x9E3779B97F4A7C15ull;
+    return shards_[hash >> (64 - shard_bits_)];
+  }
+
+  // erases the entry under the write lock of the shard
+  void Erase(Shard* shard,
+             typename std::unordered_map<K, Entry, Hash>::iterator it);
+
+  // runs the CLOCK hand until charge more fits in the shard
+  void EvictFor(Shard* shard, const size_t charge);
+
+  const size_t capacity_;
+  size_t num_shards_ = 1;
+  uint32_t shard_bits_ = 0;
+  std::unique_ptr<Shard[]> shards_;
+  Hash hasher_;
+};
+
+template <class K, class V, class Hash>
+ShardedLRUCache<K, V, Hash>::ShardedLRUCache(const size_t capacity,
+                                             const size_t num_shards)
+    : capacity_(capacity) {
+  const size_t max_shards = std::max<size_t>(
+      1, std::min(num_shards, capacity));
+  while (num_shards_ * 2 <= max_shards) {
+    num_shards_ *= 2;
+    ++shard_bits_;
+  }
+  shards_.reset(new Shard[num_shards_]);
+  for (size_t i = 0; i < num_shards_; ++i) {
+    shards_[i].capacity = (capacity + num_shards_ - 1) / num_shards_;
+  }
+}
+
+template <class K, class V, class Hash>
+std::shared_ptr<V> ShardedLRUCache<K, V, Hash>::Get(const K& key) {
+  Shard& shard = ShardOf(key);
+  cyber::base::ReadLockGuard<cyber::base::AtomicRWLock> lock(shard.lock);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) {
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  // only write the bit when it changes, hot entries stay in shared cache
+  // lines
+  if (!it->second.referenced.load(std::memory_order_relaxed)) {
+    it->second.referenced.store(true, std::memory_order_relaxed);
+  }
+  shard.hits.fetch_add(1, std::memory_order_relaxed);
+  return it->second.value;
+}
+
+template <class K, class V, class Hash>
+bool ShardedLRUCache<K, V, Hash>::GetCopy(const K& key, V* const val) {
+  Shard& shard = ShardOf(key);
+  cyber::base::ReadLockGuard<cyber::base::AtomicRWLock> lock(shard.lock);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) {
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (!it->second.referenced.load(std::memory_order_relaxed)) {
+    it->second.referenced.store(true, std::memory_order_relaxed);
+  }
+  shard.hits.fetch_add(1, std::memory_order_relaxed);
+  *val = *it->second.value;
+  return true;
+}
+
+template <class K, class V, class Hash>
+std::shared_ptr<V> ShardedLRUCache<K, V, Hash>::Put(const K& key, V val,
+                                                    const size_t charge) {
+  auto value = std::make_shared<V>(std::move(val));
+  Shard& shard = ShardOf(key);
+  cyber::base::WriteLockGuard<cyber::base::AtomicRWLock> lock(shard.lock);
+  auto it = shard.entries.find(key);
+  if (it != shard.entries.end()) {
+    Erase(&shard, it);
+  }
+  if (charge > shard.capacity) {
+    return value;
+  }
+  EvictFor(&shard, charge);
+
+  // new entries go right behind the hand, the last place it looks at
+  auto clock_it = shard.clock.insert(shard.hand, key);
+  Entry& entry = shard.entries[key];
+  entry.value = value;
+  entry.charge = charge;
+  entry.referenced.store(false, std::memory_order_relaxed);
+  entry.clock_it = clock_it;
+  shard.charge += charge;
+  shard.inserts.fetch_add(1, std::memory_order_relaxed);
+  return value;
+}
+
+template <class K, class V, class Hash>
+bool ShardedLRUCache<K, V, Hash>::Remove(const K& key) {
+  Shard& shard = ShardOf(key);
+  cyber::base::WriteLockGuard<cyber::base::AtomicRWLock> lock(shard.lock);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) {
+    return false;
+  }
+  Erase(&shard, it);
+  return true;
+}
+
+template <class K, class V, class Hash>
+void ShardedLRUCache<K, V, Hash>::Clear() {
+  for (size_t i = 0; i < num_shards_; ++i) {
+    Shard& shard = shards_[i];
+    cyber::base::WriteLockGuard<cyber::base::AtomicRWLock> lock(shard.lock);
+    shard.entries.clear();
+    shard.clock.clear();
+    shard.hand = shard.clock.end();
+    shard.charge = 0;
+  }
+}
+
+template <class K, class V, class Hash>
+typename ShardedLRUCache<K, V, Hash>::Stats
+ShardedLRUCache<K, V, Hash>::GetStats() const {
+  Stats stats;
+  for (size_t i = 0; i < num_shards_; ++i) {
+    const Shard& shard = shards_[i];
+    stats.hits += shard.hits.load(std::memory_order_relaxed);
+    stats.misses += shard.misses.load(std::memory_order_relaxed);
+    stats.inserts += shard.inserts.load(std::memory_order_relaxed);
+    stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+    cyber::base::ReadLockGuard<cyber::base::AtomicRWLock> lock(shard.lock);
+    stats.size += shard.entries.size();
+    stats.charge += shard.charge;
+  }
+  return stats;
+}
+
+template <class K, class V, class Hash>
+void ShardedLRUCache<K, V, Hash>::Erase(
+    Shard* shard, typename std::unordered_map<K, Entry, Hash>::iterator it) {
+  if (shard->hand == it->second.clock_it) {
+    shard->hand = shard->clock.erase(it->second.clock_it);
+  } else {
+    shard->clock.erase(it->second.clock_it);
+  }
+  shard->charge -= it->second.charge;
+  shard->entries.erase(it);
+}
+
+template <class K, class V, class Hash>
+void ShardedLRUCache<K, V, Hash>::EvictFor(Shard* shard, const size_t charge) {
+  while (shard->charge + charge > shard->capacity && !shard->clock.empty()) {
+    if (shard->hand == shard->clock.end()) {
+      shard->hand = shard->clock.begin();
+    }
+    auto it = shard->entries.find(*shard->hand);
+    if (it->second.referenced.exchange(false, std::memory_order_relaxed)) {
+      ++shard->hand;
+      continue;
+    }
+    Erase(shard, it);
+    shard->evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/sharded_lru_cache.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ShardedLRUCacheTest, GetPutRemove) {
+  ShardedLRUCache<int, std::string> cache(4, 1);
+  EXPECT_EQ(1, cache.num_shards());
+  EXPECT_EQ(nullptr, cache.Get(1));
+  cache.Put(1, "one");
+  cache.Put(2, "two");
+  ASSERT_NE(nullptr, cache.Get(1));
+  EXPECT_EQ("one", *cache.Get(1));
+  std::string value;
+  EXPECT_TRUE(cache.GetCopy(2, &value));
+  EXPECT_EQ("two", value);
+
+  cache.Put(2, "deux");
+  EXPECT_EQ("deux", *cache.Get(2));
+  EXPECT_TRUE(cache.Remove(2));
+  EXPECT_FALSE(cache.Remove(2));
+  EXPECT_FALSE(cache.GetCopy(2, &value));
+
+  const auto stats = cache.GetStats();
+  EXPECT_EQ(1, stats.size);
+  EXPECT_EQ(4, stats.hits);
+  EXPECT_EQ(2, stats.misses);
+  EXPECT_EQ(3, stats.inserts);
+}
+
+TEST(ShardedLRUCacheTest, ClockEviction) {
+  ShardedLRUCache<int, int> cache(3, 1);
+  cache.Put(0, 0);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  // 0 is recently used, the hand passes it and evicts 1
+  EXPECT_NE(nullptr, cache.Get(0));
+  cache.Put(3, 3);
+  EXPECT_NE(nullptr, cache.Get(0));
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_NE(nullptr, cache.Get(2));
+  EXPECT_NE(nullptr, cache.Get(3));
+  EXPECT_EQ(1, cache.GetStats().evictions);
+
+  // values handed out survive their eviction
+  auto value = cache.Get(2);
+  cache.Clear();
+  EXPECT_EQ(nullptr, cache.Get(2));
+  EXPECT_EQ(2, *value);
+}
+
+TEST(ShardedLRUCacheTest, Charge) {
+  ShardedLRUCache<int, std::string> cache(10, 1);
+  cache.Put(0, "abcd", 4);
+  cache.Put(1, "efgh", 4);
+  EXPECT_EQ(8, cache.GetStats().charge);
+  cache.Put(2, "ijkl", 4);
+  EXPECT_EQ(2, cache.GetStats().size);
+  EXPECT_EQ(8, cache.GetStats().charge);
+  // too large to cache at all
+  EXPECT_EQ("x", *cache.Put(3, "x", 11));
+  EXPECT_EQ(nullptr, cache.Get(3));
+}
+
+TEST(ShardedLRUCacheTest, Concurrent) {
+  ShardedLRUCache<int, int> cache(256);
+  EXPECT_EQ(16, cache.num_shards());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t] {
+      for (int i = 0; i < 20000; ++i) {
+        const int key = (i * 7 + t) % 512;
+        auto value = cache.Get(key);
+        if (value == nullptr) {
+          cache.Put(key, key);
+        } else {
+          EXPECT_EQ(key, *value);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto stats = cache.GetStats();
+  EXPECT_LE(stats.charge, 256);
+  EXPECT_EQ(80000, stats.hits + stats.misses);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -58,6 +58,9 @@ DEFINE_string(preprocessor_submodule_name, "PreprocessorSubmodule",
 DEFINE_string(postprocessor_submodule_name, "PostprocessorSubmodule",
               "postprocessor submodule name in proto");
 
+DEFINE_string(fused_control_submodule_name, "FusedControlSubmodule",
+              "fused control submodule name in proto");
+
 DEFINE_bool(is_control_test_mode, false, "True to run control in test mode");
 DEFINE_bool(use_preview_speed_for_table, false,
             "True to use preview speed for table lookup");
@@ -116,3 +119,22 @@ DEFINE_bool(
 
 DEFINE_bool(use_control_submodules, false,
             "use control submodules instead of controller agent");
+
+DEFINE_bool(fused_control_use_mpc_controller, false,
+            "use the MPC controller instead of the lat+lon controllers in "
+            "the fused control submodule");
+
+DEFINE_bool(enable_mpc_persistent_workspace, false,
+            "Keep the MPC OSQP workspace across control cycles and warm "
+            "start it from the previous solution");
+
+DEFINE_bool(enable_lqr_gain_table, false,
+            "Interpolate the lateral LQR gain in a table over the speed "
+            "built at init instead of solving it every cycle");
+
+DEFINE_double(lqr_gain_table_max_speed, 30.0,
+              "The speed range of the lateral LQR gain table, m/s; the gain "
+              "is solved every cycle beyond it");
+
+DEFINE_double(lqr_gain_table_step, 0.2,
+              "The speed step of the lateral LQR gain table, m/s");
@@ -44,6 +44,7 @@ DECLARE_string(preprocessor_submodule_name);
 DECLARE_string(mpc_controller_submodule_name);
 DECLARE_string(postprocessor_submodule_name);
 DECLARE_string(lat_lon_controller_submodule_name);
+DECLARE_string(fused_control_submodule_name);
 
 DECLARE_bool(is_control_test_mode);
 DECLARE_bool(use_preview_speed_for_table);
@@ -78,3 +79,10 @@ DECLARE_bool(enable_feedback_augment_on_high_speed);
 DECLARE_bool(enable_gear_drive_negative_speed_protection);
 
 DECLARE_bool(use_control_submodules);
+DECLARE_bool(fused_control_use_mpc_controller);
+
+DECLARE_bool(enable_mpc_persistent_workspace);
+
+DECLARE_bool(enable_lqr_gain_table);
+DECLARE_double(lqr_gain_table_max_speed);
+DECLARE_double(lqr_gain_table_step);
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/control/common/lqr_gain_table.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace control {
+
+bool LqrGainTable::Build(const double min_speed, const double max_speed,
+                         const double step, const GainSolver &solver) {
+  gains_.clear();
+  if (step <= 0.0 || max_speed < min_speed) {
+    AERROR << "Invalid LQR gain table range [" << min_speed << ", "
+           << max_speed << "] with step " << step;
+    return false;
+  }
+  min_speed_ = min_speed;
+  step_ = step;
+  const int size =
+      static_cast<int>(std::floor((max_speed - min_speed) / step + 1e-9)) + 1;
+  gains_.resize(size);
+  for (int i = 0; i < size; ++i) {
+    solver(min_speed + i * step, &gains_[i]);
+  }
+  return true;
+}
+
+bool LqrGainTable::Interpolate(const double speed,
+                               Eigen::MatrixXd *gain) const {
+  if (gains_.empty()) {
+    return false;
+  }
+  const double position = (speed - min_speed_) / step_;
+  const int last = static_cast<int>(gains_.size()) - 1;
+  if (position < 0.0 || position > last) {
+    return false;
+  }
+  const int index = std::min(static_cast<int>(position), last);
+  if (index == last) {
+    *gain = gains_[last];
+    return true;
+  }
+  const double ratio = position - index;
+  *gain = (1.0 - ratio) * gains_[index] + ratio * gains_[index + 1];
+  return true;
+}
+
+}  // namespace control
+}  // namespace apollo
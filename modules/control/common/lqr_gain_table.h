@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the LqrGainTable class.
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "Eigen/Core"
+
+/**
+ * @namespace apollo::control
+ * @brief apollo::control
+ */
+namespace apollo {
+namespace control {
+
+/**
+ * @class LqrGainTable
+ * @brief LQR feedback gains tabulated over the vehicle speed, so that a
+ * controller whose model only depends on the speed interpolates its gain
+ * instead of solving the Riccati equation every cycle.
+ */
+class LqrGainTable {
+ public:
+  using GainSolver =
+      std::function<void(const double speed, Eigen::MatrixXd *gain)>;
+
+  /**
+   * @brief Tabulate the gains of solver at min_speed, min_speed + step, ...
+   * up to max_speed.
+   * @return False if the range or the step is invalid.
+   */
+  bool Build(const double min_speed, const double max_speed,
+             const double step, const GainSolver &solver);
+
+  /**
+   * @brief Linearly interpolate the gain at speed.
+   * @return False if the speed is outside of the table.
+   */
+  bool Interpolate(const double speed, Eigen::MatrixXd *gain) const;
+
+  bool empty() const { return gains_.empty(); }
+
+ private:
+  double min_speed_ = 0.0;
+  double step_ = 0.0;
+  std::vector<Eigen::MatrixXd> gains_;
+};
+
+}  // namespace control
+}  // namespace apollo
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/control/common/lqr_gain_table.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace control {
+
+TEST(LqrGainTableTest, Interpolate) {
+  LqrGainTable table;
+  Eigen::MatrixXd gain;
+  EXPECT_TRUE(table.empty());
+  EXPECT_FALSE(table.Interpolate(1.0, &gain));
+
+  int num_solves = 0;
+  EXPECT_TRUE(table.Build(-1.0, 2.0, 0.5,
+                          [&num_solves](const double speed,
+                                        Eigen::MatrixXd *gain) {
+                            *gain = Eigen::MatrixXd::Constant(1, 2, speed);
+                            (*gain)(0, 1) = speed * speed;
+                            ++num_solves;
+                          }));
+  EXPECT_EQ(7, num_solves);
+
+  ASSERT_TRUE(table.Interpolate(-1.0, &gain));
+  EXPECT_DOUBLE_EQ(-1.0, gain(0, 0));
+  ASSERT_TRUE(table.Interpolate(0.75, &gain));
+  EXPECT_DOUBLE_EQ(0.75, gain(0, 0));
+  EXPECT_DOUBLE_EQ(0.625, gain(0, 1));
+  ASSERT_TRUE(table.Interpolate(2.0, &gain));
+  EXPECT_DOUBLE_EQ(4.0, gain(0, 1));
+  EXPECT_FALSE(table.Interpolate(-1.1, &gain));
+  EXPECT_FALSE(table.Interpolate(2.1, &gain));
+
+  EXPECT_FALSE(table.Build(1.0, 0.0, 0.5, nullptr));
+  EXPECT_TRUE(table.empty());
+}
+
+}  // namespace control
+}  // namespace apollo
@@ -275,6 +275,10 @@ Status LatController::Init(std::shared_ptr<DependencyInjector> injector,
   enable_look_ahead_back_control_ =
       control_conf_->lat_controller_conf().enable_look_ahead_back_control();
 
+  if (FLAGS_enable_lqr_gain_table) {
+    BuildLqrGainTables();
+  }
+
   return Status::OK();
 }
 
@@ -399,51 +403,9 @@ Status LatController::ComputeControlCommand(
     trajectory_analyzer_.TrajectoryTransformToCOM(lr_);
   }
 
-  // Re-build the vehicle dynamic models at reverse driving (in particular,
-  // replace the lateral translational motion dynamics with the corresponding
-  // kinematic models)
-  if (vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE) {
-    /*
-    A matrix (Gear Reverse)
-    [0.0, 0.0, 1.0 * v 0.0;
-     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
-     (l_r * c_r - l_f * c_f) / m / v;
-     0.0, 0.0, 0.0, 1.0;
-     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
-     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
-    */
-    cf_ = -control_conf_->lat_controller_conf().cf();
-    cr_ = -control_conf_->lat_controller_conf().cr();
-    matrix_a_(0, 1) = 0.0;
-    matrix_a_coeff_(0, 2) = 1.0;
-  } else {
-    /*
-    A matrix (Gear Drive)
-    [0.0, 1.0, 0.0, 0.0;
-     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
-     (l_r * c_r - l_f * c_f) / m / v;
-     0.0, 0.0, 0.0, 1.0;
-     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
-     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
-    */
-    cf_ = control_conf_->lat_controller_conf().cf();
-    cr_ = control_conf_->lat_controller_conf().cr();
-    matrix_a_(0, 1) = 1.0;
-    matrix_a_coeff_(0, 2) = 0.0;
-  }
-  matrix_a_(1, 2) = (cf_ + cr_) / mass_;
-  matrix_a_(3, 2) = (lf_ * cf_ - lr_ * cr_) / iz_;
-  matrix_a_coeff_(1, 1) = -(cf_ + cr_) / mass_;
-  matrix_a_coeff_(1, 3) = (lr_ * cr_ - lf_ * cf_) / mass_;
-  matrix_a_coeff_(3, 1) = (lr_ * cr_ - lf_ * cf_) / iz_;
-  matrix_a_coeff_(3, 3) = -1.0 * (lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / iz_;
-
-  /*
-  b = [0.0, c_f / m, 0.0, l_f * c_f / i_z]^T
-  */
-  matrix_b_(1, 0) = cf_ / mass_;
-  matrix_b_(3, 0) = lf_ * cf_ / iz_;
-  matrix_bd_ = matrix_b_ * ts_;
+  const bool reverse =
+      vehicle_state->gear() == canbus::Chassis::GEAR_REVERSE;
+  UpdateGearMatrix(reverse);
 
   UpdateDrivingOrientation();
 
@@ -459,36 +421,11 @@ Status LatController::ComputeControlCommand(
   // Compound discrete matrix with road preview model
   UpdateMatrixCompound();
 
-  // Adjust matrix_q_updated when in reverse gear
-  int q_param_size = control_conf_->lat_controller_conf().matrix_q_size();
-  int reverse_q_param_size =
-      control_conf_->lat_controller_conf().reverse_matrix_q_size();
-  if (injector_->vehicle_state()->gear() == canbus::Chassis::GEAR_REVERSE) {
-    for (int i = 0; i < reverse_q_param_size; ++i) {
-      matrix_q_(i, i) =
-          control_conf_->lat_controller_conf().reverse_matrix_q(i);
-    }
-  } else {
-    for (int i = 0; i < q_param_size; ++i) {
-      matrix_q_(i, i) = control_conf_->lat_controller_conf().matrix_q(i);
-    }
-  }
-
-  // Add gain scheduler for higher speed steering
-  if (FLAGS_enable_gain_scheduler) {
-    matrix_q_updated_(0, 0) =
-        matrix_q_(0, 0) * lat_err_interpolation_->Interpolate(
-                              std::fabs(vehicle_state->linear_velocity()));
-    matrix_q_updated_(2, 2) =
-        matrix_q_(2, 2) * heading_err_interpolation_->Interpolate(
-                              std::fabs(vehicle_state->linear_velocity()));
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
-  } else {
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+  const LqrGainTable &gain_table =
+      reverse ? reverse_gain_table_ : drive_gain_table_;
+  if (!FLAGS_enable_lqr_gain_table ||
+      !gain_table.Interpolate(vehicle_state->linear_velocity(), &matrix_k_)) {
+    SolveLqrGain(vehicle_state->linear_velocity());
   }
 
   // feedback = - K * state
@@ -706,17 +643,84 @@ void LatController::UpdateState(SimpleLateralDebug *debug) {
   }
 }
 
+void LatController::UpdateGearMatrix(const bool reverse) {
+  // Re-build the vehicle dynamic models at reverse driving (in particular,
+  // replace the lateral translational motion dynamics with the corresponding
+  // kinematic models)
+  if (reverse) {
+    /*
+    A matrix (Gear Reverse)
+    [0.0, 0.0, 1.0 * v 0.0;
+     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
+     (l_r * c_r - l_f * c_f) / m / v;
+     0.0, 0.0, 0.0, 1.0;
+     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
+     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
+    */
+    cf_ = -control_conf_->lat_controller_conf().cf();
+    cr_ = -control_conf_->lat_controller_conf().cr();
+    matrix_a_(0, 1) = 0.0;
+    matrix_a_coeff_(0, 2) = 1.0;
+  } else {
+    /*
+    A matrix (Gear Drive)
+    [0.0, 1.0, 0.0, 0.0;
+     0.0, (-(c_f + c_r) / m) / v, (c_f + c_r) / m,
+     (l_r * c_r - l_f * c_f) / m / v;
+     0.0, 0.0, 0.0, 1.0;
+     0.0, ((lr * cr - lf * cf) / i_z) / v, (l_f * c_f - l_r * c_r) / i_z,
+     (-1.0 * (l_f^2 * c_f + l_r^2 * c_r) / i_z) / v;]
+    */
+    cf_ = control_conf_->lat_controller_conf().cf();
+    cr_ = control_conf_->lat_controller_conf().cr();
+    matrix_a_(0, 1) = 1.0;
+    matrix_a_coeff_(0, 2) = 0.0;
+  }
+  matrix_a_(1, 2) = (cf_ + cr_) / mass_;
+  matrix_a_(3, 2) = (lf_ * cf_ - lr_ * cr_) / iz_;
+  matrix_a_coeff_(1, 1) = -(cf_ + cr_) / mass_;
+  matrix_a_coeff_(1, 3) = (lr_ * cr_ - lf_ * cf_) / mass_;
+  matrix_a_coeff_(3, 1) = (lr_ * cr_ - lf_ * cf_) / iz_;
+  matrix_a_coeff_(3, 3) = -1.0 * (lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / iz_;
+
+  /*
+  b = [0.0, c_f / m, 0.0, l_f * c_f / i_z]^T
+  */
+  matrix_b_(1, 0) = cf_ / mass_;
+  matrix_b_(3, 0) = lf_ * cf_ / iz_;
+  matrix_bd_ = matrix_b_ * ts_;
+
+  // Adjust matrix_q_updated when in reverse gear
+  int q_param_size = control_conf_->lat_controller_conf().matrix_q_size();
+  int reverse_q_param_size =
+      control_conf_->lat_controller_conf().reverse_matrix_q_size();
+  if (reverse) {
+    for (int i = 0; i < reverse_q_param_size; ++i) {
+      matrix_q_(i, i) =
+          control_conf_->lat_controller_conf().reverse_matrix_q(i);
+    }
+  } else {
+    for (int i = 0; i < q_param_size; ++i) {
+      matrix_q_(i, i) = control_conf_->lat_controller_conf().matrix_q(i);
+    }
+  }
+}
+
 void LatController::UpdateMatrix() {
+  UpdateMatrix(injector_->vehicle_state()->gear() ==
+                   canbus::Chassis::GEAR_REVERSE,
+               injector_->vehicle_state()->linear_velocity());
+}
+
+void LatController::UpdateMatrix(const bool reverse, const double speed) {
   double v;
   // At reverse driving, replace the lateral translational motion dynamics with
   // the corresponding kinematic models
-  if (injector_->vehicle_state()->gear() == canbus::Chassis::GEAR_REVERSE) {
-    v = std::min(injector_->vehicle_state()->linear_velocity(),
-                 -minimum_speed_protection_);
+  if (reverse) {
+    v = std::min(speed, -minimum_speed_protection_);
     matrix_a_(0, 2) = matrix_a_coeff_(0, 2) * v;
   } else {
-    v = std::max(injector_->vehicle_state()->linear_velocity(),
-                 minimum_speed_protection_);
+    v = std::max(speed, minimum_speed_protection_);
     matrix_a_(0, 2) = 0.0;
   }
   matrix_a_(1, 1) = matrix_a_coeff_(1, 1) / v;
@@ -728,6 +732,42 @@ void LatController::UpdateMatrix() {
                (matrix_i + ts_ * 0.5 * matrix_a_);
 }
 
+void LatController::SolveLqrGain(const double speed) {
+  // Add gain scheduler for higher speed steering
+  if (FLAGS_enable_gain_scheduler) {
+    matrix_q_updated_(0, 0) =
+        matrix_q_(0, 0) * lat_err_interpolation_->Interpolate(
+                              std::fabs(speed));
+    matrix_q_updated_(2, 2) =
+        matrix_q_(2, 2) * heading_err_interpolation_->Interpolate(
+                              std::fabs(speed));
+    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
+                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
+                                  &matrix_k_);
+  } else {
+    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
+                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
+                                  &matrix_k_);
+  }
+}
+
+void LatController::BuildLqrGainTables() {
+  for (const bool reverse : {false, true}) {
+    UpdateGearMatrix(reverse);
+    LqrGainTable *table = reverse ? &reverse_gain_table_ : &drive_gain_table_;
+    table->Build(-FLAGS_lqr_gain_table_max_speed,
+                 FLAGS_lqr_gain_table_max_speed, FLAGS_lqr_gain_table_step,
+                 [this, reverse](const double speed, Matrix *gain) {
+                   UpdateMatrix(reverse, speed);
+                   UpdateMatrixCompound();
+                   SolveLqrGain(speed);
+                   *gain = matrix_k_;
+                 });
+  }
+  AINFO << "Built LQR gain tables every " << FLAGS_lqr_gain_table_step
+        << " m/s up to " << FLAGS_lqr_gain_table_max_speed << " m/s";
+}
+
 void LatController::UpdateMatrixCompound() {
   // Initialize preview matrix
   matrix_adc_.block(0, 0, basic_state_size_, basic_state_size_) = matrix_ad_;
@@ -32,6 +32,7 @@
 #include "modules/common/filters/mean_filter.h"
 #include "modules/control/common/interpolation_1d.h"
 #include "modules/control/common/leadlag_controller.h"
+#include "modules/control/common/lqr_gain_table.h"
 #include "modules/control/common/mrac_controller.h"
 #include "modules/control/common/trajectory_analyzer.h"
 #include "modules/control/controller/controller.h"
@@ -107,10 +108,21 @@ class LatController : public Controller {
   // logic for reverse driving mode
   void UpdateDrivingOrientation();
 
+  // Set the parts of the vehicle model and the state weights that only
+  // depend on the gear
+  void UpdateGearMatrix(const bool reverse);
+
   void UpdateMatrix();
 
+  void UpdateMatrix(const bool reverse, const double speed);
+
   void UpdateMatrixCompound();
 
+  // Solve the Riccati equation of the current model for matrix_k_
+  void SolveLqrGain(const double speed);
+
+  void BuildLqrGainTables();
+
   double ComputeFeedForward(double ref_curvature) const;
 
   void ComputeLateralErrors(const double x, const double y, const double theta,
@@ -205,6 +217,11 @@ class LatController : public Controller {
   // parameters for lqr solver; threshold for computation
   double lqr_eps_ = 0.0;
 
+  // The LQR gains over the speed, built at Init with
+  // FLAGS_enable_lqr_gain_table
+  LqrGainTable drive_gain_table_;
+  LqrGainTable reverse_gain_table_;
+
   common::DigitalFilter digital_filter_;
 
   std::unique_ptr<Interpolation1D> lat_err_interpolation_;
@@ -386,12 +386,31 @@ Status MPCController::ComputeControlCommand(
 
   std::vector<double> control_cmd(controls_, 0);
 
-  apollo::common::math::MpcOsqp mpc_osqp(
-      matrix_ad_, matrix_bd_, matrix_q_updated_, matrix_r_updated_,
-      matrix_state_, lower_bound, upper_bound, lower_state_bound,
-      upper_state_bound, reference_state, mpc_max_iteration_, horizon_,
-      mpc_eps_);
-  if (!mpc_osqp.Solve(&control_cmd)) {
+  bool solved = false;
+  if (FLAGS_enable_mpc_persistent_workspace) {
+    if (mpc_osqp_ == nullptr) {
+      mpc_osqp_.reset(new apollo::common::math::MpcOsqp(
+          matrix_ad_, matrix_bd_, matrix_q_updated_, matrix_r_updated_,
+          matrix_state_, lower_bound, upper_bound, lower_state_bound,
+          upper_state_bound, reference_state, mpc_max_iteration_, horizon_,
+          mpc_eps_));
+      mpc_osqp_->EnablePersistentWorkspace(true);
+    } else {
+      mpc_osqp_->UpdateProblem(matrix_ad_, matrix_bd_, matrix_q_updated_,
+                               matrix_r_updated_, matrix_state_, lower_bound,
+                               upper_bound, lower_state_bound,
+                               upper_state_bound, reference_state);
+    }
+    solved = mpc_osqp_->Solve(&control_cmd);
+  } else {
+    apollo::common::math::MpcOsqp mpc_osqp(
+        matrix_ad_, matrix_bd_, matrix_q_updated_, matrix_r_updated_,
+        matrix_state_, lower_bound, upper_bound, lower_state_bound,
+        upper_state_bound, reference_state, mpc_max_iteration_, horizon_,
+        mpc_eps_);
+    solved = mpc_osqp.Solve(&control_cmd);
+  }
+  if (!solved) {
     AERROR << "MPC OSQP solver failed";
   } else {
     ADEBUG << "MPC OSQP problem solved! ";
@@ -529,6 +548,7 @@ Status MPCController::ComputeControlCommand(
 Status MPCController::Reset() {
   previous_heading_error_ = 0.0;
   previous_lateral_error_ = 0.0;
+  mpc_osqp_.reset();
   return Status::OK();
 }
 
@@ -230,6 +230,9 @@ class MPCController : public Controller {
   // parameters for mpc solver; threshold for computation
   double mpc_eps_ = 0.0;
 
+  // The solver kept across cycles with FLAGS_enable_mpc_persistent_workspace
+  std::unique_ptr<common::math::MpcOsqp> mpc_osqp_;
+
   common::DigitalFilter digital_filter_;
 
   std::unique_ptr<Interpolation1D> lat_err_interpolation_;
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file fused_control_submodule.cc
+ */
+
+#include "modules/control/submodules/fused_control_submodule.h"
+
+#include "cyber/time/clock.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
+#include "modules/control/common/control_gflags.h"
+
+namespace apollo {
+namespace control {
+
+using apollo::common::Status;
+using apollo::cyber::Clock;
+
+std::string FusedControlSubmodule::Name() const {
+  return FLAGS_fused_control_submodule_name;
+}
+
+bool FusedControlSubmodule::Init() {
+  // one injector for all the stages, so the controllers see the vehicle
+  // state updated by the preprocessor
+  injector_ = std::make_shared<DependencyInjector>();
+  if (!preprocessor_.InitStage(injector_)) {
+    AERROR << "Failed to init preprocessor stage.";
+    return false;
+  }
+
+  if (FLAGS_fused_control_use_mpc_controller) {
+    mpc_controller_.reset(new MPCControllerSubmodule());
+    if (!mpc_controller_->InitStage(injector_)) {
+      AERROR << "Failed to init MPC controller stage.";
+      return false;
+    }
+  } else {
+    lat_lon_controller_.reset(new LatLonControllerSubmodule());
+    if (!lat_lon_controller_->InitStage(injector_)) {
+      AERROR << "Failed to init lat+lon controller stage.";
+      return false;
+    }
+  }
+
+  if (!postprocessor_.InitStage()) {
+    AERROR << "Failed to init postprocessor stage.";
+    return false;
+  }
+
+  control_command_writer_ =
+      node_->CreateWriter<ControlCommand>(FLAGS_control_command_topic);
+  ACHECK(control_command_writer_ != nullptr);
+  return true;
+}
+
+bool FusedControlSubmodule::Proc(const std::shared_ptr<LocalView>& local_view) {
+  const auto start_time = Clock::Now();
+
+  Preprocessor preprocessor_status;
+  preprocessor_.Process(*local_view, &preprocessor_status);
+  const auto preprocessor_end_time = Clock::Now();
+
+  ControlCommand control_core_command;
+  Status status =
+      ProduceControlCoreCommand(preprocessor_status, &control_core_command);
+  const auto controller_end_time = Clock::Now();
+
+  ControlCommand control_command;
+  postprocessor_.Process(control_core_command, &control_command);
+  const auto end_time = Clock::Now();
+
+  // stage timing in the order preprocessor, controller, postprocessor, and the
+  // latency from publishing the local view to the control command
+  auto* latency_stats = control_command.mutable_latency_stats();
+  latency_stats->clear_controller_time_ms();
+  latency_stats->add_controller_time_ms(
+      (preprocessor_end_time - start_time).ToSecond() * 1e3);
+  latency_stats->add_controller_time_ms(
+      (controller_end_time - preprocessor_end_time).ToSecond() * 1e3);
+  latency_stats->add_controller_time_ms(
+      (end_time - controller_end_time).ToSecond() * 1e3);
+  const double total_time_ms =
+      local_view->header().has_timestamp_sec()
+          ? (end_time.ToSecond() - local_view->header().timestamp_sec()) * 1e3
+          : (end_time - start_time).ToSecond() * 1e3;
+  latency_stats->set_total_time_ms(total_time_ms);
+  ADEBUG << "fused control time spend: " << total_time_ms << " ms.";
+
+  static apollo::common::LatencyRecorder latency_recorder(
+      FLAGS_control_command_topic);
+  latency_recorder.AppendLatencyRecord(
+      control_command.header().lidar_timestamp(), start_time, end_time);
+
+  control_command_writer_->Write(control_command);
+  return status.ok();
+}
+
+Status FusedControlSubmodule::ProduceControlCoreCommand(
+    const Preprocessor& preprocessor_status,
+    ControlCommand* control_core_command) {
+  if (mpc_controller_ != nullptr) {
+    return mpc_controller_->Process(preprocessor_status, control_core_command);
+  }
+  return lat_lon_controller_->Process(preprocessor_status,
+                                      control_core_command);
+}
+
+}  // namespace control
+}  // namespace apollo
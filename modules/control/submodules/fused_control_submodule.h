@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file fused_control_submodule.h
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "cyber/class_loader/class_loader.h"
+#include "cyber/component/component.h"
+#include "modules/control/common/dependency_injector.h"
+#include "modules/control/proto/control_cmd.pb.h"
+#include "modules/control/proto/preprocessor.pb.h"
+#include "modules/control/submodules/lat_lon_controller_submodule.h"
+#include "modules/control/submodules/mpc_controller_submodule.h"
+#include "modules/control/submodules/postprocessor_submodule.h"
+#include "modules/control/submodules/preprocessor_submodule.h"
+
+namespace apollo {
+namespace control {
+
+/**
+ * @class FusedControlSubmodule
+ *
+ * @brief Runs the preprocessor, controller and postprocessor submodules
+ * directly one after the other on each local view, without passing the
+ * intermediate messages through channels.
+ */
+class FusedControlSubmodule final : public cyber::Component<LocalView> {
+ public:
+  /**
+   * @brief Get name of the node
+   * @return Name of the node
+   */
+  std::string Name() const;
+
+  /**
+   * @brief Initialize the chained submodules
+   * @return If initialized
+   */
+  bool Init() override;
+
+  /**
+   * @brief generate control command from a local view
+   *
+   * @param local_view
+   * @return true control command is successfully generated
+   */
+  bool Proc(const std::shared_ptr<LocalView>& local_view) override;
+
+ private:
+  common::Status ProduceControlCoreCommand(
+      const Preprocessor& preprocessor_status,
+      ControlCommand* control_core_command);
+
+ private:
+  std::shared_ptr<DependencyInjector> injector_;
+
+  PreprocessorSubmodule preprocessor_;
+  std::unique_ptr<LatLonControllerSubmodule> lat_lon_controller_;
+  std::unique_ptr<MPCControllerSubmodule> mpc_controller_;
+  PostprocessorSubmodule postprocessor_;
+
+  std::shared_ptr<cyber::Writer<ControlCommand>> control_command_writer_;
+};
+
+CYBER_REGISTER_COMPONENT(FusedControlSubmodule)
+
+}  // namespace control
+}  // namespace apollo
@@ -41,7 +41,19 @@ std::string LatLonControllerSubmodule::Name() const {
 }
 
 bool LatLonControllerSubmodule::Init() {
-  injector_ = std::make_shared<DependencyInjector>();
+  if (!InitStage(std::make_shared<DependencyInjector>())) {
+    return false;
+  }
+
+  control_core_writer_ =
+      node_->CreateWriter<ControlCommand>(FLAGS_control_core_command_topic);
+  ACHECK(control_core_writer_ != nullptr);
+  return true;
+}
+
+bool LatLonControllerSubmodule::InitStage(
+    const std::shared_ptr<DependencyInjector>& injector) {
+  injector_ = injector;
   // lateral controller initialization
   ACHECK(cyber::common::GetProtoFromFile(FLAGS_lateral_controller_conf_file,
                                          &lateral_controller_conf_))
@@ -66,62 +78,68 @@ bool LatLonControllerSubmodule::Init() {
     return false;
   }
 
-  control_core_writer_ =
-      node_->CreateWriter<ControlCommand>(FLAGS_control_core_command_topic);
-
-  ACHECK(control_core_writer_ != nullptr);
-
   return true;
 }
 
 bool LatLonControllerSubmodule::Proc(
     const std::shared_ptr<Preprocessor>& preprocessor_status) {
   const auto start_time = Clock::Now();
+
   ControlCommand control_core_command;
+  Status status = Process(*preprocessor_status, &control_core_command);
+  // skip publishing control command when estop for Lat+Lon controller
+  if (preprocessor_status->header().status().error_code() != ErrorCode::OK) {
+    return false;
+  }
 
+  const auto end_time = Clock::Now();
+
+  static apollo::common::LatencyRecorder latency_recorder(
+      FLAGS_control_core_command_topic);
+  latency_recorder.AppendLatencyRecord(
+      control_core_command.header().lidar_timestamp(), start_time, end_time);
+
+  control_core_writer_->Write(control_core_command);
+  return status.ok();
+}
+
+Status LatLonControllerSubmodule::Process(
+    const Preprocessor& preprocessor_status,
+    ControlCommand* control_core_command) {
   // recording pad msg
-  if (preprocessor_status->received_pad_msg()) {
-    control_core_command.mutable_pad_msg()->CopyFrom(
-        preprocessor_status->local_view().pad_msg());
+  if (preprocessor_status.received_pad_msg()) {
+    control_core_command->mutable_pad_msg()->CopyFrom(
+        preprocessor_status.local_view().pad_msg());
   }
   ADEBUG << "Lat+Lon controller submodule started ....";
 
-  // skip produce control command when estop for lat+lon controller
-  StatusPb pre_status = preprocessor_status->header().status();
+  // skip produce control command when estop for Lat+Lon controller
+  StatusPb pre_status = preprocessor_status.header().status();
   if (pre_status.error_code() != ErrorCode::OK) {
-    control_core_command.mutable_header()->mutable_status()->CopyFrom(
+    control_core_command->mutable_header()->mutable_status()->CopyFrom(
         pre_status);
     AERROR << "Error in preprocessor submodule.";
-    return false;
+    return Status(pre_status.error_code(), pre_status.msg());
   }
 
-  Status status = ProduceControlCoreCommand(preprocessor_status->local_view(),
-                                            &control_core_command);
+  Status status = ProduceControlCoreCommand(preprocessor_status.local_view(),
+                                            control_core_command);
   AERROR_IF(!status.ok()) << "Failed to produce control command:"
                           << status.error_message();
 
-  control_core_command.mutable_header()->set_lidar_timestamp(
-      preprocessor_status->header().lidar_timestamp());
-  control_core_command.mutable_header()->set_camera_timestamp(
-      preprocessor_status->header().camera_timestamp());
-  control_core_command.mutable_header()->set_radar_timestamp(
-      preprocessor_status->header().radar_timestamp());
-  common::util::FillHeader(Name(), &control_core_command);
+  control_core_command->mutable_header()->set_lidar_timestamp(
+      preprocessor_status.header().lidar_timestamp());
+  control_core_command->mutable_header()->set_camera_timestamp(
+      preprocessor_status.header().camera_timestamp());
+  control_core_command->mutable_header()->set_radar_timestamp(
+      preprocessor_status.header().radar_timestamp());
+  common::util::FillHeader(Name(), control_core_command);
 
-  const auto end_time = Clock::Now();
-
-  static apollo::common::LatencyRecorder latency_recorder(
-      FLAGS_control_core_command_topic);
-  latency_recorder.AppendLatencyRecord(
-      control_core_command.header().lidar_timestamp(), start_time, end_time);
-
-  control_core_command.mutable_header()->mutable_status()->set_error_code(
+  control_core_command->mutable_header()->mutable_status()->set_error_code(
       status.code());
-  control_core_command.mutable_header()->mutable_status()->set_msg(
+  control_core_command->mutable_header()->mutable_status()->set_msg(
       status.error_message());
-
-  control_core_writer_->Write(control_core_command);
-  return status.ok();
+  return status;
 }
 
 Status LatLonControllerSubmodule::ProduceControlCoreCommand(
@@ -25,6 +25,7 @@
 #include "modules/canbus/proto/chassis.pb.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/util/util.h"
+#include "modules/control/common/dependency_injector.h"
 #include "modules/control/controller/controller.h"
 #include "modules/control/controller/lat_controller.h"
 #include "modules/control/controller/lon_controller.h"
@@ -61,6 +62,14 @@ class LatLonControllerSubmodule final : public cyber::Component<Preprocessor> {
    */
   bool Init() override;
 
+  /**
+   * @brief Initialize the controller without its channels, so that it can be
+   *        chained with the other submodules in one process path
+   * @param injector The dependency injector shared by the chained submodules
+   * @return If initialized
+   */
+  bool InitStage(const std::shared_ptr<DependencyInjector>& injector);
+
   /**
    * @brief generate control command
    *
@@ -69,6 +78,16 @@ class LatLonControllerSubmodule final : public cyber::Component<Preprocessor> {
    */
   bool Proc(const std::shared_ptr<Preprocessor>& preprocessor_status) override;
 
+  /**
+   * @brief generate control core command from a preprocessor status
+   *
+   * @param preprocessor_status
+   * @param control_core_command
+   * @return common::Status the error of the preprocessor status if it has one
+   */
+  common::Status Process(const Preprocessor& preprocessor_status,
+                         ControlCommand* control_core_command);
+
  private:
   common::Status ProduceControlCoreCommand(
       const LocalView& local_view, ControlCommand* control_core_command);
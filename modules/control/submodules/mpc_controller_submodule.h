@@ -62,6 +62,14 @@ class MPCControllerSubmodule final : public cyber::Component<Preprocessor> {
    */
   bool Init() override;
 
+  /**
+   * @brief Initialize the controller without its channels, so that it can be
+   *        chained with the other submodules in one process path
+   * @param injector The dependency injector shared by the chained submodules
+   * @return If initialized
+   */
+  bool InitStage(const std::shared_ptr<DependencyInjector>& injector);
+
   /**
    * @brief generate control command
    *
@@ -70,6 +78,16 @@ class MPCControllerSubmodule final : public cyber::Component<Preprocessor> {
    */
   bool Proc(const std::shared_ptr<Preprocessor>& preprocessor_status) override;
 
+  /**
+   * @brief generate control core command from a preprocessor status
+   *
+   * @param preprocessor_status
+   * @param control_core_command
+   * @return common::Status the error of the preprocessor status if it has one
+   */
+  common::Status Process(const Preprocessor& preprocessor_status,
+                         ControlCommand* control_core_command);
+
  private:
   common::Status ProduceControlCoreCommand(
       const LocalView& local_view, ControlCommand* control_core_command);
@@ -41,10 +41,9 @@ std::string PostprocessorSubmodule::Name() const {
 }
 
 bool PostprocessorSubmodule::Init() {
-  ACHECK(cyber::common::GetProtoFromFile(FLAGS_control_common_conf_file,
-                                         &control_common_conf_))
-      << "Unable to load control common conf file: "
-      << FLAGS_control_common_conf_file;
+  if (!InitStage()) {
+    return false;
+  }
 
   postprocessor_writer_ =
       node_->CreateWriter<ControlCommand>(FLAGS_control_command_topic);
@@ -52,31 +51,19 @@ bool PostprocessorSubmodule::Init() {
   return true;
 }
 
+bool PostprocessorSubmodule::InitStage() {
+  ACHECK(cyber::common::GetProtoFromFile(FLAGS_control_common_conf_file,
+                                         &control_common_conf_))
+      << "Unable to load control common conf file: "
+      << FLAGS_control_common_conf_file;
+  return true;
+}
+
 bool PostprocessorSubmodule::Proc(
     const std::shared_ptr<ControlCommand>& control_core_command) {
   const auto start_time = Clock::Instance()->Now();
   ControlCommand control_command;
-  // get all fields from control_core_command for now
-  control_command = *control_core_command;
-
-  // estop handling
-  if (control_core_command->header().status().error_code() != ErrorCode::OK) {
-    AWARN_EVERY(100) << "Estop triggered! No control core method executed!";
-    control_command.set_speed(0);
-    control_command.set_throttle(0);
-    control_command.set_brake(control_common_conf_.soft_estop_brake());
-    control_command.set_gear_location(Chassis::GEAR_DRIVE);
-  }
-
-  // set header
-  control_command.mutable_header()->set_lidar_timestamp(
-      control_core_command->header().lidar_timestamp());
-  control_command.mutable_header()->set_camera_timestamp(
-      control_core_command->header().camera_timestamp());
-  control_command.mutable_header()->set_radar_timestamp(
-      control_core_command->header().radar_timestamp());
-
-  common::util::FillHeader(Name(), &control_command);
+  Process(*control_core_command, &control_command);
   const auto end_time = Clock::Instance()->Now();
 
   // measure latency
@@ -90,5 +77,30 @@ bool PostprocessorSubmodule::Proc(
   return true;
 }
 
+void PostprocessorSubmodule::Process(const ControlCommand& control_core_command,
+                                     ControlCommand* control_command) {
+  // get all fields from control_core_command for now
+  *control_command = control_core_command;
+
+  // estop handling
+  if (control_core_command.header().status().error_code() != ErrorCode::OK) {
+    AWARN_EVERY(100) << "Estop triggered! No control core method executed!";
+    control_command->set_speed(0);
+    control_command->set_throttle(0);
+    control_command->set_brake(control_common_conf_.soft_estop_brake());
+    control_command->set_gear_location(Chassis::GEAR_DRIVE);
+  }
+
+  // set header
+  control_command->mutable_header()->set_lidar_timestamp(
+      control_core_command.header().lidar_timestamp());
+  control_command->mutable_header()->set_camera_timestamp(
+      control_core_command.header().camera_timestamp());
+  control_command->mutable_header()->set_radar_timestamp(
+      control_core_command.header().radar_timestamp());
+
+  common::util::FillHeader(Name(), control_command);
+}
+
 }  // namespace control
 }  // namespace apollo
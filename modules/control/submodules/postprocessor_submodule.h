@@ -52,6 +52,13 @@ class PostprocessorSubmodule final : public cyber::Component<ControlCommand> {
    */
   bool Init() override;
 
+  /**
+   * @brief Initialize the submodule without its channels, so that it can be
+   *        chained with the other submodules in one process path
+   * @return If initialized
+   */
+  bool InitStage();
+
   /**
    * @brief
    *
@@ -61,6 +68,15 @@ class PostprocessorSubmodule final : public cyber::Component<ControlCommand> {
    */
   bool Proc(const std::shared_ptr<ControlCommand>& control_command) override;
 
+  /**
+   * @brief produce the control command from a control core command
+   *
+   * @param control_core_command
+   * @param control_command
+   */
+  void Process(const ControlCommand& control_core_command,
+               ControlCommand* control_command);
+
  private:
   std::shared_ptr<cyber::Writer<ControlCommand>> postprocessor_writer_;
   ControlCommonConf control_common_conf_;
@@ -49,11 +49,9 @@ std::string PreprocessorSubmodule::Name() const {
 }
 
 bool PreprocessorSubmodule::Init() {
-  injector_ = std::make_shared<DependencyInjector>();
-  ACHECK(cyber::common::GetProtoFromFile(FLAGS_control_common_conf_file,
-                                         &control_common_conf_))
-      << "Unable to load control common conf file: "
-      << FLAGS_control_common_conf_file;
+  if (!InitStage(std::make_shared<DependencyInjector>())) {
+    return false;
+  }
 
   // Preprocessor writer
   preprocessor_writer_ =
@@ -63,18 +61,45 @@ bool PreprocessorSubmodule::Init() {
   return true;
 }
 
+bool PreprocessorSubmodule::InitStage(
+    const std::shared_ptr<DependencyInjector> &injector) {
+  injector_ = injector;
+  ACHECK(cyber::common::GetProtoFromFile(FLAGS_control_common_conf_file,
+                                         &control_common_conf_))
+      << "Unable to load control common conf file: "
+      << FLAGS_control_common_conf_file;
+  return true;
+}
+
 bool PreprocessorSubmodule::Proc(const std::shared_ptr<LocalView> &local_view) {
   ADEBUG << "Preprocessor started ....";
   const auto start_time = Clock::Now();
 
   Preprocessor control_preprocessor;
+  Process(*local_view, &control_preprocessor);
+
+  const auto end_time = Clock::Now();
+
+  static apollo::common::LatencyRecorder latency_recorder(
+      FLAGS_control_preprocessor_topic);
+  latency_recorder.AppendLatencyRecord(
+      control_preprocessor.header().lidar_timestamp(), start_time, end_time);
+
+  preprocessor_writer_->Write(control_preprocessor);
+  ADEBUG << "Preprocessor finished.";
+
+  return true;
+}
+
+void PreprocessorSubmodule::Process(const LocalView &local_view,
+                                    Preprocessor *control_preprocessor) {
   // handling estop
   auto *preprocessor_status =
-      control_preprocessor.mutable_header()->mutable_status();
+      control_preprocessor->mutable_header()->mutable_status();
 
-  control_preprocessor.mutable_local_view()->CopyFrom(*local_view);
+  control_preprocessor->mutable_local_view()->CopyFrom(local_view);
 
-  Status status = ProducePreprocessorStatus(&control_preprocessor);
+  Status status = ProducePreprocessorStatus(control_preprocessor);
   AERROR_IF(!status.ok()) << "Failed to produce control preprocessor:"
                           << status.error_message();
 
@@ -86,36 +111,24 @@ bool PreprocessorSubmodule::Proc(const std::shared_ptr<LocalView> &local_view) {
     preprocessor_status->set_msg(status.error_message());
   }
 
-  if (control_preprocessor.local_view().has_pad_msg()) {
-    const auto &pad_message = control_preprocessor.local_view().pad_msg();
+  if (control_preprocessor->local_view().has_pad_msg()) {
+    const auto &pad_message = control_preprocessor->local_view().pad_msg();
     if (pad_message.action() == DrivingAction::RESET) {
       AINFO << "Control received RESET action!";
       estop_ = false;
       preprocessor_status->set_error_code(ErrorCode::OK);
       preprocessor_status->set_msg("");
     }
-    control_preprocessor.set_received_pad_msg(true);
+    control_preprocessor->set_received_pad_msg(true);
   }
 
-  control_preprocessor.mutable_header()->set_lidar_timestamp(
-      local_view->header().lidar_timestamp());
-  control_preprocessor.mutable_header()->set_camera_timestamp(
-      local_view->trajectory().header().camera_timestamp());
-  control_preprocessor.mutable_header()->set_radar_timestamp(
-      local_view->trajectory().header().radar_timestamp());
-  common::util::FillHeader(Name(), &control_preprocessor);
-
-  const auto end_time = Clock::Now();
-
-  static apollo::common::LatencyRecorder latency_recorder(
-      FLAGS_control_preprocessor_topic);
-  latency_recorder.AppendLatencyRecord(
-      control_preprocessor.header().lidar_timestamp(), start_time, end_time);
-
-  preprocessor_writer_->Write(control_preprocessor);
-  ADEBUG << "Preprocessor finished.";
-
-  return true;
+  control_preprocessor->mutable_header()->set_lidar_timestamp(
+      local_view.header().lidar_timestamp());
+  control_preprocessor->mutable_header()->set_camera_timestamp(
+      local_view.trajectory().header().camera_timestamp());
+  control_preprocessor->mutable_header()->set_radar_timestamp(
+      local_view.trajectory().header().radar_timestamp());
+  common::util::FillHeader(Name(), control_preprocessor);
 }
 
 Status PreprocessorSubmodule::ProducePreprocessorStatus(
@@ -60,8 +60,25 @@ class PreprocessorSubmodule final : public cyber::Component<LocalView> {
    */
   bool Init() override;
 
+  /**
+   * @brief Initialize the submodule without its channels, so that it can be
+   *        chained with the other submodules in one process path
+   * @param injector The dependency injector shared by the chained submodules
+   * @return If initialized
+   */
+  bool InitStage(const std::shared_ptr<DependencyInjector> &injector);
+
   bool Proc(const std::shared_ptr<LocalView> &local_view) override;
 
+  /**
+   * @brief produce the preprocessor status of a local view
+   *
+   * @param local_view
+   * @param control_preprocessor
+   */
+  void Process(const LocalView &local_view,
+               Preprocessor *control_preprocessor);
+
  private:
   /**
    * @brief check controller submodule input (local_view)
@@ -0,0 +1,300 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/data/tools/smart_recorder/ring_buffer_record_processor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <set>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/init.h"
+#include "cyber/record/record_message.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/monitor/common/monitor_manager.h"
+
+#include "modules/data/tools/smart_recorder/channel_pool.h"
+#include "modules/data/tools/smart_recorder/smart_recorder_gflags.h"
+
+namespace apollo {
+namespace data {
+
+namespace {
+
+using apollo::common::Header;
+using apollo::cyber::Time;
+using apollo::monitor::MonitorManager;
+using cyber::CreateNode;
+using cyber::ReaderConfig;
+using cyber::common::EnsureDirectory;
+using cyber::common::GetFileName;
+using cyber::message::RawMessage;
+using cyber::proto::ChangeMsg;
+using cyber::proto::RoleAttributes;
+using cyber::record::RecordMessage;
+using cyber::service_discovery::TopologyManager;
+
+constexpr uint64_t kSecondsToNanoSeconds = 1000000000UL;
+
+}  // namespace
+
+RingBufferRecordProcessor::RingBufferRecordProcessor(
+    const std::string& source_record_dir,
+    const std::string& restored_output_dir)
+    : RecordProcessor(source_record_dir, restored_output_dir) {
+  default_output_filename_ = restored_output_dir_;
+  default_output_filename_.erase(
+      std::remove(default_output_filename_.begin(),
+                  default_output_filename_.end(), '-'),
+      default_output_filename_.end());
+  default_output_filename_ =
+      GetFileName(absl::StrCat(default_output_filename_, ".record"), false);
+}
+
+bool RingBufferRecordProcessor::Init(const SmartRecordTrigger& trigger_conf) {
+  // Nothing is recorded into the source dir, it only has to exist for base
+  if (!EnsureDirectory(source_record_dir_) ||
+      !EnsureDirectory(restored_output_dir_)) {
+    AERROR << "unable to init input/output dir: " << source_record_dir_ << "/"
+           << restored_output_dir_;
+    return false;
+  }
+  buffer_time_ =
+      static_cast<uint64_t>(FLAGS_ring_buffer_seconds * kSecondsToNanoSeconds);
+  for (const auto& item : absl::StrSplit(FLAGS_ring_buffer_downsample_channels,
+                                         ',', absl::SkipEmpty())) {
+    const std::vector<std::string> channel_rate = absl::StrSplit(item, ':');
+    double max_hz = 0.0;
+    if (channel_rate.size() != 2 ||
+        !absl::SimpleAtod(channel_rate[1], &max_hz) || max_hz <= 0.0) {
+      AERROR << "invalid downsample setting: " << item;
+      return false;
+    }
+    min_write_intervals_[channel_rate[0]] =
+        static_cast<uint64_t>(kSecondsToNanoSeconds / max_hz);
+  }
+
+  cyber::Init("smart_recorder");
+  smart_recorder_node_ = CreateNode(absl::StrCat("smart_recorder_", getpid()));
+  if (smart_recorder_node_ == nullptr) {
+    AERROR << "create smart recorder node failed: " << getpid();
+    return false;
+  }
+  recorder_status_writer_ =
+      smart_recorder_node_->CreateWriter<SmartRecorderStatus>(
+          FLAGS_recorder_status_topic);
+  // Init base
+  if (!RecordProcessor::Init(trigger_conf)) {
+    AERROR << "base init failed";
+    return false;
+  }
+  return true;
+}
+
+bool RingBufferRecordProcessor::Process() {
+  // Readers for the channels already there and the ones coming later
+  auto channel_manager = TopologyManager::Instance()->channel_manager();
+  change_conn_ = channel_manager->AddChangeListener(
+      [this](const ChangeMsg& change_message) {
+        if (change_message.role_type() == cyber::proto::ROLE_WRITER) {
+          FindNewChannel(change_message.role_attr());
+        }
+      });
+  std::vector<RoleAttributes> role_attr_vec;
+  channel_manager->GetWriters(&role_attr_vec);
+  for (const auto& role_attr : role_attr_vec) {
+    FindNewChannel(role_attr);
+  }
+  PublishStatus(RecordingState::RECORDING, "smart recorder started");
+  MonitorManager::Instance()->LogBuffer().INFO("SmartRecorder is recording...");
+
+  static constexpr int kCheckingFrequency = 100;
+  static constexpr int kPublishStatusFrequency = 30;
+  int status_counter = 0;
+  std::vector<BufferedMessage> messages;
+  while (!cyber::IsShutdown()) {
+    {
+      std::unique_lock<std::mutex> lock(incoming_mutex_);
+      incoming_cv_.wait_for(lock,
+                            std::chrono::milliseconds(kCheckingFrequency),
+                            [this]() { return !incoming_.empty(); });
+      messages.swap(incoming_);
+    }
+    for (auto& message : messages) {
+      Evaluate(&message);
+      ring_.push_back(std::move(message));
+    }
+    messages.clear();
+    if (!ring_.empty() && ring_.back().time > buffer_time_) {
+      Flush(ring_.back().time - buffer_time_);
+    }
+    if (++status_counter % kPublishStatusFrequency == 0) {
+      status_counter = 0;
+      PublishStatus(RecordingState::RECORDING, "smart recorder recording");
+    }
+  }
+
+  channel_manager->RemoveChangeListener(change_conn_);
+  {
+    std::lock_guard<std::mutex> lock(channel_mutex_);
+    readers_.clear();
+  }
+  // Write whatever of the buffer was triggered one last time
+  {
+    std::lock_guard<std::mutex> lock(incoming_mutex_);
+    messages.swap(incoming_);
+  }
+  for (auto& message : messages) {
+    Evaluate(&message);
+    ring_.push_back(std::move(message));
+  }
+  Flush(std::numeric_limits<uint64_t>::max());
+  PublishStatus(RecordingState::STOPPED, "smart recorder stopped");
+  MonitorManager::Instance()->LogBuffer().INFO("SmartRecorder is stopped");
+  return true;
+}
+
+void RingBufferRecordProcessor::FindNewChannel(
+    const RoleAttributes& role_attr) {
+  const std::string& channel_name = role_attr.channel_name();
+  const std::set<std::string>& all_channels =
+      ChannelPool::Instance()->GetAllChannels();
+  if (all_channels.find(channel_name) == all_channels.end() ||
+      role_attr.message_type().empty() || role_attr.proto_desc().empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  if (readers_.find(channel_name) != readers_.end()) {
+    return;
+  }
+  channel_types_[channel_name] =
+      std::make_pair(role_attr.message_type(), role_attr.proto_desc());
+  ReaderConfig config;
+  config.channel_name = channel_name;
+  config.pending_queue_size =
+      gflags::Int32FromEnv("CYBER_PENDING_QUEUE_SIZE", 50);
+  auto reader = smart_recorder_node_->CreateReader<RawMessage>(
+      config, [this, channel_name](const std::shared_ptr<RawMessage>& message) {
+        OnMessage(message, channel_name);
+      });
+  if (reader == nullptr) {
+    AERROR << "create reader failed for " << channel_name;
+    return;
+  }
+  readers_[channel_name] = reader;
+}
+
+void RingBufferRecordProcessor::OnMessage(
+    const std::shared_ptr<RawMessage>& message,
+    const std::string& channel_name) {
+  if (message == nullptr) {
+    return;
+  }
+  BufferedMessage buffered;
+  buffered.channel_name = channel_name;
+  buffered.message = message;
+  buffered.time = Time::Now().ToNanosecond();
+  {
+    std::lock_guard<std::mutex> lock(incoming_mutex_);
+    incoming_.push_back(std::move(buffered));
+  }
+  incoming_cv_.notify_one();
+}
+
+void RingBufferRecordProcessor::Evaluate(BufferedMessage* message) {
+  // Triggers only parse the small channels, the large ones are handed over
+  // by time only so their content is never copied
+  const std::set<std::string>& small_channels =
+      ChannelPool::Instance()->GetSmallChannels();
+  RecordMessage record(message->channel_name, "", message->time);
+  if (small_channels.find(message->channel_name) != small_channels.end()) {
+    record.content = message->message->message;
+  }
+  for (const auto& trigger : triggers_) {
+    trigger->Pull(record);
+  }
+  message->should_restore = ShouldRestore(record);
+  TrackInterval();
+}
+
+void RingBufferRecordProcessor::TrackInterval() {
+  const Interval interval = IntervalPool::Instance()->GetNextInterval();
+  if (interval.end_time == 0) {
+    return;
+  }
+  // The pool merges overlapping intervals into its latest one
+  if (!intervals_.empty() &&
+      interval.begin_time <= intervals_.back().end_time) {
+    intervals_.back().begin_time =
+        std::min(intervals_.back().begin_time, interval.begin_time);
+    intervals_.back().end_time =
+        std::max(intervals_.back().end_time, interval.end_time);
+    return;
+  }
+  intervals_.push_back(interval);
+}
+
+void RingBufferRecordProcessor::Flush(const uint64_t before_time) {
+  while (!ring_.empty() && ring_.front().time < before_time) {
+    const BufferedMessage& message = ring_.front();
+    while (!intervals_.empty() && intervals_.front().end_time < message.time) {
+      intervals_.pop_front();
+    }
+    const bool in_interval = !intervals_.empty() &&
+                             intervals_.front().begin_time <= message.time;
+    if (message.should_restore || in_interval) {
+      WriteMessage(message);
+    }
+    ring_.pop_front();
+  }
+}
+
+void RingBufferRecordProcessor::WriteMessage(const BufferedMessage& message) {
+  const auto min_interval = min_write_intervals_.find(message.channel_name);
+  if (min_interval != min_write_intervals_.end()) {
+    auto& last_write_time = last_write_times_[message.channel_name];
+    if (last_write_time != 0 &&
+        message.time - last_write_time < min_interval->second) {
+      return;
+    }
+    last_write_time = message.time;
+  }
+  if (writer_->IsNewChannel(message.channel_name)) {
+    std::lock_guard<std::mutex> lock(channel_mutex_);
+    const auto& channel_type = channel_types_[message.channel_name];
+    writer_->WriteChannel(message.channel_name, channel_type.first,
+                          channel_type.second);
+  }
+  writer_->WriteMessage(message.channel_name, message.message, message.time);
+}
+
+void RingBufferRecordProcessor::PublishStatus(
+    const RecordingState state, const std::string& message) const {
+  SmartRecorderStatus status;
+  Header* status_headerpb = status.mutable_header();
+  status_headerpb->set_timestamp_sec(Time::Now().ToSecond());
+  status.set_recording_state(state);
+  status.set_state_message(message);
+  AINFO << "send message with state " << state << ", " << message;
+  recorder_status_writer_->Write(status);
+}
+
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/base/signal.h"
+#include "cyber/cyber.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/topology_change.pb.h"
+
+#include "modules/data/tools/smart_recorder/interval_pool.h"
+#include "modules/data/tools/smart_recorder/proto/smart_recorder_status.pb.h"
+#include "modules/data/tools/smart_recorder/proto/smart_recorder_triggers.pb.h"
+#include "modules/data/tools/smart_recorder/record_processor.h"
+
+namespace apollo {
+namespace data {
+
+/**
+ * @class RingBufferRecordProcessor
+ * @brief Realtime processor that keeps the latest messages in memory and
+ * evaluates the triggers on the stream, so only the selected intervals are
+ * ever written to disk
+ */
+class RingBufferRecordProcessor : public RecordProcessor {
+ public:
+  RingBufferRecordProcessor(const std::string& source_record_dir,
+                            const std::string& restored_output_dir);
+  bool Init(const SmartRecordTrigger& trigger_conf) override;
+  bool Process() override;
+  std::string GetDefaultOutputFile() const override {
+    return absl::StrCat(restored_output_dir_, "/", default_output_filename_);
+  };
+  virtual ~RingBufferRecordProcessor() = default;
+
+ private:
+  struct BufferedMessage {
+    std::string channel_name;
+    std::shared_ptr<cyber::message::RawMessage> message;
+    uint64_t time = 0;
+    bool should_restore = false;
+  };
+
+  void FindNewChannel(const cyber::proto::RoleAttributes& role_attr);
+  void OnMessage(const std::shared_ptr<cyber::message::RawMessage>& message,
+                 const std::string& channel_name);
+  void Evaluate(BufferedMessage* message);
+  void TrackInterval();
+  void Flush(const uint64_t before_time);
+  void WriteMessage(const BufferedMessage& message);
+  void PublishStatus(const RecordingState state,
+                     const std::string& message) const;
+
+  std::shared_ptr<cyber::Node> smart_recorder_node_ = nullptr;
+  std::shared_ptr<cyber::Writer<SmartRecorderStatus>> recorder_status_writer_ =
+      nullptr;
+  cyber::base::Connection<const cyber::proto::ChangeMsg&> change_conn_;
+  std::string default_output_filename_;
+  uint64_t buffer_time_ = 0;
+
+  // Readers and the message type and proto desc of each channel, guarded by
+  // channel_mutex_ since topology changes come from another thread.
+  std::mutex channel_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<cyber::ReaderBase>>
+      readers_;
+  std::unordered_map<std::string, std::pair<std::string, std::string>>
+      channel_types_;
+
+  // Messages received but not evaluated yet.
+  std::mutex incoming_mutex_;
+  std::condition_variable incoming_cv_;
+  std::vector<BufferedMessage> incoming_;
+
+  // Evaluated messages of the last buffer_time_, oldest first, and the
+  // intervals they may fall in. Only the processing thread touches them.
+  std::deque<BufferedMessage> ring_;
+  std::deque<Interval> intervals_;
+
+  // Minimum time between two written messages of the downsampled channels,
+  // and the time of the last written one.
+  std::unordered_map<std::string, uint64_t> min_write_intervals_;
+  std::unordered_map<std::string, uint64_t> last_write_times_;
+};
+
+}  // namespace data
+}  // namespace apollo
@@ -23,3 +23,13 @@ DEFINE_string(smart_recorder_config_filename,
               "smart_recorder_config.pb.txt",
               "The config file.");
 DEFINE_bool(real_time_trigger, true, "Whether to use realtime trigger.");
+DEFINE_bool(ring_buffer_recording, false,
+            "Whether the realtime trigger keeps the messages in memory and "
+            "only writes the triggered intervals, instead of recording "
+            "everything to the source dir first.");
+DEFINE_double(ring_buffer_seconds, 30.0,
+              "Seconds of messages kept in memory, which should cover the "
+              "backward time of the triggers.");
+DEFINE_string(ring_buffer_downsample_channels, "",
+              "Comma separated channel:max_hz pairs limiting the rate at "
+              "which the channels are written in ring buffer recording.");
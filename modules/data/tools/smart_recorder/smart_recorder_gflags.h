@@ -22,3 +22,6 @@ DECLARE_string(source_records_dir);
 DECLARE_string(restored_output_dir);
 DECLARE_string(smart_recorder_config_filename);
 DECLARE_bool(real_time_trigger);
+DECLARE_bool(ring_buffer_recording);
+DECLARE_double(ring_buffer_seconds);
+DECLARE_string(ring_buffer_downsample_channels);
@@ -58,6 +58,23 @@ DEFINE_double(sim_map_radius, 200.0,
               "The radius within which Dreamview will find all the map "
               "elements around the car.");
 
+DEFINE_double(sim_map_tile_size, 0.0,
+              "If positive, map elements are collected around the center of "
+              "the square tile of this size the car is in, so that the map "
+              "stays the same while the car is in the tile.");
+
+DEFINE_int32(sim_map_cache_size, 0,
+             "The number of serialized map element payloads MapService keeps "
+             "for the frontend, 0 to serialize every request.");
+
+DEFINE_bool(enable_sim_world_delta, false,
+            "Whether to serve SimulationWorldDelta frames to the clients "
+            "which request the simulation world with delta.");
+
+DEFINE_double(sim_world_delta_resolution, 0.01,
+              "The object coordinates in SimulationWorldDelta frames are "
+              "rounded to this many meters.");
+
 DEFINE_bool(enable_update_size_check, true,
             "True to check if the update byte number is less than threshold");
 
@@ -76,6 +93,47 @@ DEFINE_double(voxel_filter_size, 0.3, "VoxelGrid pointcloud filter leaf size");
 DEFINE_double(voxel_filter_height, 0.2,
               "VoxelGrid pointcloud filter leaf height");
 
+DEFINE_bool(point_cloud_packed_frames, false,
+            "Send the pointcloud as packed frames of int16 coordinates, "
+            "encoded once per frame and level of detail off the reader "
+            "thread.");
+
+DEFINE_double(point_cloud_quantization, 0.01,
+              "Coordinate step of the packed pointcloud frames in meters.");
+
+DEFINE_string(camera_stream_codec, "",
+              "ffmpeg encoder of the shared camera stream, e.g. h264_nvenc, "
+              "hevc_nvenc or libx264. Empty sends a jpeg per request.");
+
+DEFINE_int32(camera_stream_bitrate, 1000000,
+             "Bitrate of the shared camera stream in bits per second.");
+
+DEFINE_int32(camera_stream_gop_size, 30,
+             "Frames between the key frames of the shared camera stream.");
+
+DEFINE_string(teleop_stream_channel, "",
+              "Compressed image channel streamed to the teleop console with "
+              "adaptive bitrate. Empty leaves the video to the teleop "
+              "daemons.");
+
+DEFINE_string(teleop_stream_codec, "h264_nvenc",
+              "ffmpeg encoder of the teleop stream, e.g. h264_nvenc, "
+              "hevc_nvenc or libx264.");
+
+DEFINE_int32(teleop_stream_min_bitrate, 250000,
+             "Lowest bitrate of the teleop stream in bits per second.");
+
+DEFINE_int32(teleop_stream_max_bitrate, 4000000,
+             "Highest bitrate of the teleop stream in bits per second.");
+
+DEFINE_int32(teleop_stream_max_latency_ms, 200,
+             "Teleop stream frames waiting longer than this are dropped "
+             "instead of sent, and the stream restarts on a key frame.");
+
+DEFINE_int32(teleop_stream_ping_interval_ms, 500,
+             "Interval of the round trip time probes sent to the teleop "
+             "console.");
+
 DEFINE_double(system_status_lifetime_seconds, 30,
               "Lifetime of a valid SystemStatus message. It's more like a "
               "replay message if the timestamp is old, where we should ignore "
@@ -38,6 +38,14 @@ DECLARE_string(ssl_certificate);
 
 DECLARE_double(sim_map_radius);
 
+DECLARE_double(sim_map_tile_size);
+
+DECLARE_int32(sim_map_cache_size);
+
+DECLARE_bool(enable_sim_world_delta);
+
+DECLARE_double(sim_world_delta_resolution);
+
 DECLARE_int32(dreamview_worker_num);
 
 DECLARE_bool(enable_update_size_check);
@@ -52,6 +60,28 @@ DECLARE_double(voxel_filter_size);
 
 DECLARE_double(voxel_filter_height);
 
+DECLARE_bool(point_cloud_packed_frames);
+
+DECLARE_double(point_cloud_quantization);
+
+DECLARE_string(camera_stream_codec);
+
+DECLARE_int32(camera_stream_bitrate);
+
+DECLARE_int32(camera_stream_gop_size);
+
+DECLARE_string(teleop_stream_channel);
+
+DECLARE_string(teleop_stream_codec);
+
+DECLARE_int32(teleop_stream_min_bitrate);
+
+DECLARE_int32(teleop_stream_max_bitrate);
+
+DECLARE_int32(teleop_stream_max_latency_ms);
+
+DECLARE_int32(teleop_stream_ping_interval_ms);
+
 DECLARE_double(system_status_lifetime_seconds);
 
 DECLARE_string(lidar_height_yaml);
@@ -58,6 +58,16 @@ void ImageHandler::OnImage(
     return;
   }
 
+  // A jpeg is already what the browser gets, pass it through instead of
+  // decoding and encoding it again.
+  if (compressed_image->format().find("jpeg") != std::string::npos) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    send_buffer_.assign(compressed_image->data().begin(),
+                        compressed_image->data().end());
+    cvar_.notify_all();
+    return;
+  }
+
   std::vector<uint8_t> compressed_raw_data(compressed_image->data().begin(),
                                            compressed_image->data().end());
   cv::Mat mat_image = cv::imdecode(compressed_raw_data, cv::IMREAD_COLOR);
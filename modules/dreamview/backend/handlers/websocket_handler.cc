@@ -61,7 +61,8 @@ void WebSocketHandler::handleClose(CivetServer *server,
         << ": Connection closed. Total connections: " << connections_.size();
 }
 
-bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
+bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable,
+                                     int op_code) {
   std::vector<Connection *> connections_to_send;
   {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -76,7 +77,7 @@ bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
 
   bool all_success = true;
   for (Connection *conn : connections_to_send) {
-    if (!SendData(conn, data, skippable)) {
+    if (!SendData(conn, data, skippable, op_code)) {
       all_success = false;
     }
   }
@@ -84,6 +85,11 @@ bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
   return all_success;
 }
 
+bool WebSocketHandler::BroadcastBinaryData(const std::string &data,
+                                           bool skippable) {
+  return BroadcastData(data, skippable, MG_WEBSOCKET_OPCODE_BINARY);
+}
+
 bool WebSocketHandler::SendBinaryData(Connection *conn, const std::string &data,
                                       bool skippable) {
   return SendData(conn, data, skippable, MG_WEBSOCKET_OPCODE_BINARY);
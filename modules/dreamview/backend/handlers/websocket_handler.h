@@ -116,7 +116,10 @@ class WebSocketHandler : public CivetWebSocketHandler {
    * @brief Sends the provided data to all the connected clients.
    * @param data The message string to be sent.
    */
-  bool BroadcastData(const std::string &data, bool skippable = false);
+  bool BroadcastData(const std::string &data, bool skippable = false,
+                     int op_code = MG_WEBSOCKET_OPCODE_TEXT);
+
+  bool BroadcastBinaryData(const std::string &data, bool skippable = false);
 
   /**
    * @brief Sends the provided data to a specific connected client.
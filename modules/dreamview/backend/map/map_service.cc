@@ -17,11 +17,13 @@
 #include "modules/dreamview/backend/map/map_service.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <utility>
 
 #include "modules/common/util/json_util.h"
 #include "modules/common/util/string_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
@@ -83,7 +85,9 @@ void ExtractRoadAndLaneIds(const std::vector<LaneInfoConstPtr> &lanes,
 
 const char MapService::kMetaFileName[] = "/metaInfo.json";
 
-MapService::MapService(bool use_sim_map) : use_sim_map_(use_sim_map) {
+MapService::MapService(bool use_sim_map)
+    : use_sim_map_(use_sim_map),
+      map_cache_(static_cast<size_t>(std::max(FLAGS_sim_map_cache_size, 1))) {
   ReloadMap(false);
 }
 
@@ -96,6 +100,7 @@ bool MapService::ReloadMap(bool force_reload) {
 
   // Update the x,y-offsets if present.
   UpdateOffsets();
+  map_cache_.Clear();
   return ret;
 }
 
@@ -162,63 +167,73 @@ void MapService::CollectMapElementIds(const PointENU &point, double radius,
   }
   boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
 
+  // With tiles every position in a tile collects the elements around the
+  // tile center, in a radius which still covers the circle around point.
+  PointENU center = point;
+  if (FLAGS_sim_map_tile_size > 0.0) {
+    const double tile_size = FLAGS_sim_map_tile_size;
+    center.set_x((std::floor(point.x() / tile_size) + 0.5) * tile_size);
+    center.set_y((std::floor(point.y() / tile_size) + 0.5) * tile_size);
+    radius += tile_size * M_SQRT1_2;
+  }
+
   std::vector<LaneInfoConstPtr> lanes;
-  if (SimMap()->GetLanes(point, radius, &lanes) != 0) {
+  if (SimMap()->GetLanes(center, radius, &lanes) != 0) {
     AERROR << "Fail to get lanes from sim_map.";
   }
   ExtractRoadAndLaneIds(lanes, ids->mutable_lane(), ids->mutable_road());
 
   std::vector<ClearAreaInfoConstPtr> clear_areas;
-  if (SimMap()->GetClearAreas(point, radius, &clear_areas) != 0) {
+  if (SimMap()->GetClearAreas(center, radius, &clear_areas) != 0) {
     AERROR << "Fail to get clear areas from sim_map.";
   }
   ExtractIds(clear_areas, ids->mutable_clear_area());
 
   std::vector<CrosswalkInfoConstPtr> crosswalks;
-  if (SimMap()->GetCrosswalks(point, radius, &crosswalks) != 0) {
+  if (SimMap()->GetCrosswalks(center, radius, &crosswalks) != 0) {
     AERROR << "Fail to get crosswalks from sim_map.";
   }
   ExtractIds(crosswalks, ids->mutable_crosswalk());
 
   std::vector<JunctionInfoConstPtr> junctions;
-  if (SimMap()->GetJunctions(point, radius, &junctions) != 0) {
+  if (SimMap()->GetJunctions(center, radius, &junctions) != 0) {
     AERROR << "Fail to get junctions from sim_map.";
   }
   ExtractIds(junctions, ids->mutable_junction());
 
   std::vector<PNCJunctionInfoConstPtr> pnc_junctions;
-  if (SimMap()->GetPNCJunctions(point, radius, &pnc_junctions) != 0) {
+  if (SimMap()->GetPNCJunctions(center, radius, &pnc_junctions) != 0) {
     AERROR << "Fail to get pnc junctions from sim_map.";
   }
   ExtractIds(pnc_junctions, ids->mutable_pnc_junction());
 
   std::vector<ParkingSpaceInfoConstPtr> parking_spaces;
-  if (SimMap()->GetParkingSpaces(point, radius, &parking_spaces) != 0) {
+  if (SimMap()->GetParkingSpaces(center, radius, &parking_spaces) != 0) {
     AERROR << "Fail to get parking space from sim_map.";
   }
   ExtractIds(parking_spaces, ids->mutable_parking_space());
 
   std::vector<SpeedBumpInfoConstPtr> speed_bumps;
-  if (SimMap()->GetSpeedBumps(point, radius, &speed_bumps) != 0) {
+  if (SimMap()->GetSpeedBumps(center, radius, &speed_bumps) != 0) {
     AERROR << "Fail to get speed bump from sim_map.";
   }
   ExtractIds(speed_bumps, ids->mutable_speed_bump());
 
   std::vector<SignalInfoConstPtr> signals;
-  if (SimMap()->GetSignals(point, radius, &signals) != 0) {
+  if (SimMap()->GetSignals(center, radius, &signals) != 0) {
     AERROR << "Failed to get signals from sim_map.";
   }
 
   ExtractIds(signals, ids->mutable_signal());
 
   std::vector<StopSignInfoConstPtr> stop_signs;
-  if (SimMap()->GetStopSigns(point, radius, &stop_signs) != 0) {
+  if (SimMap()->GetStopSigns(center, radius, &stop_signs) != 0) {
     AERROR << "Failed to get stop signs from sim_map.";
   }
   ExtractIds(stop_signs, ids->mutable_stop_sign());
 
   std::vector<YieldSignInfoConstPtr> yield_signs;
-  if (SimMap()->GetYieldSigns(point, radius, &yield_signs) != 0) {
+  if (SimMap()->GetYieldSigns(center, radius, &yield_signs) != 0) {
     AERROR << "Failed to get yield signs from sim_map.";
   }
   ExtractIds(yield_signs, ids->mutable_yield());
@@ -329,6 +344,24 @@ Map MapService::RetrieveMapElements(const MapElementIds &ids) const {
   return result;
 }
 
+std::string MapService::RetrieveSerializedMapElements(
+    const MapElementIds &ids) const {
+  std::string result;
+  if (FLAGS_sim_map_cache_size <= 0) {
+    RetrieveMapElements(ids).SerializeToString(&result);
+    return result;
+  }
+  // The ids are sorted when collected, so the same elements give the same
+  // key.
+  const std::string key = ids.SerializeAsString();
+  if (map_cache_.GetCopy(key, &result)) {
+    return result;
+  }
+  RetrieveMapElements(ids).SerializeToString(&result);
+  map_cache_.Put(key, result);
+  return result;
+}
+
 bool MapService::GetNearestLane(const double x, const double y,
                                 LaneInfoConstPtr *nearest_lane,
                                 double *nearest_s, double *nearest_l) const {
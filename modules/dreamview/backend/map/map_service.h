@@ -26,6 +26,7 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
+#include "modules/common/util/sharded_lru_cache.h"
 #include "modules/dreamview/proto/simulation_world.pb.h"
 #include "modules/map/pnc_map/pnc_map.h"
 #include "nlohmann/json.hpp"
@@ -55,6 +56,10 @@ class MapService {
   // javascript clients.
   hdmap::Map RetrieveMapElements(const MapElementIds &ids) const;
 
+  // The serialized RetrieveMapElements(ids), which is kept for the next
+  // requests of the same elements if FLAGS_sim_map_cache_size is positive.
+  std::string RetrieveSerializedMapElements(const MapElementIds &ids) const;
+
   bool GetPoseWithRegardToLane(const double x, const double y, double *theta,
                                double *s) const;
 
@@ -115,6 +120,10 @@ class MapService {
 
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
+
+  // Serialized map payloads keyed by the serialized MapElementIds, shared by
+  // the websocket threads without a common lock.
+  mutable common::util::ShardedLRUCache<std::string, std::string> map_cache_;
 };
 
 }  // namespace dreamview
@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 
 #include "modules/common/configs/config_gflags.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 
 using apollo::common::PointENU;
 using apollo::hdmap::Map;
@@ -62,6 +63,41 @@ TEST_F(MapServiceTest, RetrieveMapElements) {
   EXPECT_EQ("l1", map.lane(0).id().id());
 }
 
+TEST_F(MapServiceTest, RetrieveSerializedMapElements) {
+  FLAGS_sim_map_cache_size = 2;
+  MapService cached_map_service(false);
+  FLAGS_sim_map_cache_size = 0;
+
+  MapElementIds map_element_ids;
+  map_element_ids.add_lane("l1");
+  std::string expected;
+  map_service->RetrieveMapElements(map_element_ids)
+      .SerializeToString(&expected);
+  EXPECT_EQ(expected,
+            map_service->RetrieveSerializedMapElements(map_element_ids));
+  EXPECT_EQ(expected,
+            cached_map_service.RetrieveSerializedMapElements(map_element_ids));
+  EXPECT_EQ(expected,
+            cached_map_service.RetrieveSerializedMapElements(map_element_ids));
+}
+
+TEST_F(MapServiceTest, CollectMapElementIdsInTile) {
+  FLAGS_sim_map_tile_size = 1000.0;
+  PointENU p;
+  p.set_x(-1826.0);
+  p.set_y(-3027.0);
+  MapElementIds tile_ids;
+  map_service->CollectMapElementIds(p, 10.0, &tile_ids);
+  p.set_x(-1900.0);
+  MapElementIds other_ids;
+  map_service->CollectMapElementIds(p, 10.0, &other_ids);
+  FLAGS_sim_map_tile_size = 0.0;
+
+  // Both points are in the tile centered at (-1500, -3500).
+  EXPECT_EQ(1, tile_ids.lane_size());
+  EXPECT_EQ(tile_ids.DebugString(), other_ids.DebugString());
+}
+
 TEST_F(MapServiceTest, GetStartPoint) {
   PointENU start_point;
   EXPECT_TRUE(map_service->GetStartPoint(&start_point));
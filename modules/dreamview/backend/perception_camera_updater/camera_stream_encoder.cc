@@ -0,0 +1,201 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/perception_camera_updater/camera_stream_encoder.h"
+
+#include <algorithm>
+
+#include "cyber/common/log.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+// The encoders take 4:2:0 in either layout, software encoders mostly planar
+// and nvenc both.
+AVPixelFormat SelectPixelFormat(const AVCodec *codec) {
+  if (codec->pix_fmts == nullptr) {
+    return AV_PIX_FMT_YUV420P;
+  }
+  AVPixelFormat selected = AV_PIX_FMT_NONE;
+  for (const AVPixelFormat *format = codec->pix_fmts;
+       *format != AV_PIX_FMT_NONE; ++format) {
+    if (*format == AV_PIX_FMT_YUV420P) {
+      return *format;
+    }
+    if (*format == AV_PIX_FMT_NV12) {
+      selected = *format;
+    }
+  }
+  return selected;
+}
+
+// 4:2:0 needs even dimensions.
+int ScaleEven(int size, double scale) {
+  return std::max(2, static_cast<int>(size * scale) & ~1);
+}
+
+}  // namespace
+
+CameraStreamEncoder::~CameraStreamEncoder() { Close(); }
+
+bool CameraStreamEncoder::Init(const std::string &codec_name) {
+  codec_ = avcodec_find_encoder_by_name(codec_name.c_str());
+  if (codec_ == nullptr) {
+    AERROR << "Unknown camera stream encoder " << codec_name;
+    return false;
+  }
+  if (codec_->id != AV_CODEC_ID_H264 && codec_->id != AV_CODEC_ID_HEVC) {
+    AERROR << codec_name << " is neither a h264 nor a h265 encoder.";
+    codec_ = nullptr;
+    return false;
+  }
+  if (SelectPixelFormat(codec_) == AV_PIX_FMT_NONE) {
+    AERROR << codec_name << " takes no software 4:2:0 frames.";
+    codec_ = nullptr;
+    return false;
+  }
+  bitrate_ = FLAGS_camera_stream_bitrate;
+  return true;
+}
+
+bool CameraStreamEncoder::IsHevc() const {
+  return codec_ != nullptr && codec_->id == AV_CODEC_ID_HEVC;
+}
+
+void CameraStreamEncoder::SetBitrate(int bitrate) {
+  bitrate_ = bitrate;
+  if (context_ != nullptr) {
+    context_->bit_rate = bitrate;
+  }
+}
+
+bool CameraStreamEncoder::Open(int src_width, int src_height, double scale) {
+  Close();
+  const int width = ScaleEven(src_width, scale);
+  const int height = ScaleEven(src_height, scale);
+  const AVPixelFormat pixel_format = SelectPixelFormat(codec_);
+
+  context_ = avcodec_alloc_context3(codec_);
+  context_->width = width;
+  context_->height = height;
+  context_->pix_fmt = pixel_format;
+  // The frames carry no rate of their own, the clock only feeds the rate
+  // control.
+  context_->time_base = {1, 30};
+  context_->framerate = {30, 1};
+  context_->bit_rate = bitrate_;
+  context_->gop_size = FLAGS_camera_stream_gop_size;
+  context_->max_b_frames = 0;
+  context_->flags |= AV_CODEC_FLAG_LOW_DELAY;
+
+  // Options an encoder does not know are left in the dictionary.
+  AVDictionary *options = nullptr;
+  av_dict_set(&options, "tune", "zerolatency", 0);
+  av_dict_set(&options, "delay", "0", 0);
+  av_dict_set(&options, "zerolatency", "1", 0);
+  const int ret = avcodec_open2(context_, codec_, &options);
+  av_dict_free(&options);
+  if (ret < 0) {
+    AERROR << "Failed to open " << codec_->name << " for " << width << "x"
+           << height;
+    avcodec_free_context(&context_);
+    return false;
+  }
+
+  frame_ = av_frame_alloc();
+  frame_->format = pixel_format;
+  frame_->width = width;
+  frame_->height = height;
+  packet_ = av_packet_alloc();
+  if (av_frame_get_buffer(frame_, 0) < 0) {
+    AERROR << "Failed to allocate the camera stream frame.";
+    Close();
+    return false;
+  }
+  sws_ = sws_getContext(src_width, src_height, AV_PIX_FMT_RGB24, width, height,
+                        pixel_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
+  if (sws_ == nullptr) {
+    AERROR << "Failed to create the camera stream scaler.";
+    Close();
+    return false;
+  }
+  src_width_ = src_width;
+  src_height_ = src_height;
+  AINFO << "Camera stream " << codec_->name << " opened for " << width << "x"
+        << height;
+  return true;
+}
+
+void CameraStreamEncoder::Close() {
+  sws_freeContext(sws_);
+  sws_ = nullptr;
+  av_frame_free(&frame_);
+  av_packet_free(&packet_);
+  avcodec_free_context(&context_);
+  src_width_ = 0;
+  src_height_ = 0;
+}
+
+bool CameraStreamEncoder::Encode(const apollo::drivers::Image &image,
+                                 double scale, bool keyframe,
+                                 std::string *data, bool *is_keyframe) {
+  data->clear();
+  *is_keyframe = false;
+  if (codec_ == nullptr) {
+    return false;
+  }
+  const int src_width = static_cast<int>(image.width());
+  const int src_height = static_cast<int>(image.height());
+  if ((src_width != src_width_ || src_height != src_height_) &&
+      !Open(src_width, src_height, scale)) {
+    return false;
+  }
+
+  if (av_frame_make_writable(frame_) < 0) {
+    return false;
+  }
+  const uint8_t *src[1] = {
+      reinterpret_cast<const uint8_t *>(image.data().data())};
+  const int src_stride[1] = {static_cast<int>(image.step())};
+  sws_scale(sws_, src, src_stride, 0, src_height, frame_->data,
+            frame_->linesize);
+  frame_->pts = pts_++;
+  frame_->pict_type = keyframe ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+
+  if (avcodec_send_frame(context_, frame_) < 0) {
+    AERROR << "Failed to send the camera stream frame.";
+    return false;
+  }
+  while (true) {
+    const int ret = avcodec_receive_packet(context_, packet_);
+    if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+      return true;
+    }
+    if (ret < 0) {
+      AERROR << "Failed to encode the camera stream frame.";
+      return false;
+    }
+    data->append(reinterpret_cast<const char *>(packet_->data), packet_->size);
+    *is_keyframe |= (packet_->flags & AV_PKT_FLAG_KEY) != 0;
+    av_packet_unref(packet_);
+  }
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+}
+
+#include "modules/drivers/proto/sensor_image.pb.h"
+
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class CameraStreamEncoder
+ *
+ * @brief Encodes the camera images into one h264/h265 stream shared by all
+ * the camera websocket clients. The image is scaled and converted to yuv in
+ * one pass and every frame is pushed out right away, without b frames or
+ * lookahead, to keep the latency of a jpeg frame.
+ */
+class CameraStreamEncoder {
+ public:
+  ~CameraStreamEncoder();
+
+  /**
+   * @brief Looks up the ffmpeg encoder, e.g. "h264_nvenc", "hevc_nvenc" or
+   * "libx264". The encoder is opened on the first image.
+   */
+  bool Init(const std::string &codec_name);
+
+  /**
+   * @brief Encodes a decoded rgb8 image scaled by scale into an annex b
+   * access unit. The sps/pps are repeated in band before every key frame so
+   * a client can join on any key frame.
+   *
+   * @param keyframe Forces a key frame, e.g. when a client connected.
+   * @param data The access unit, empty when the encoder held the frame back.
+   * @param is_keyframe Whether data starts a new group of pictures.
+   */
+  bool Encode(const apollo::drivers::Image &image, double scale,
+              bool keyframe, std::string *data, bool *is_keyframe);
+
+  bool IsHevc() const;
+
+  /**
+   * @brief Changes the target bitrate in bits per second. An open encoder
+   * takes it from the next frame on, as far as the encoder supports
+   * reconfiguring, e.g. libx264 and nvenc.
+   */
+  void SetBitrate(int bitrate);
+
+ private:
+  bool Open(int src_width, int src_height, double scale);
+  void Close();
+
+  const AVCodec *codec_ = nullptr;
+  AVCodecContext *context_ = nullptr;
+  SwsContext *sws_ = nullptr;
+  AVFrame *frame_ = nullptr;
+  AVPacket *packet_ = nullptr;
+  int src_width_ = 0;
+  int src_height_ = 0;
+  int64_t pts_ = 0;
+  int bitrate_ = 0;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -16,12 +16,14 @@
 
 #include "modules/dreamview/backend/perception_camera_updater/perception_camera_updater.h"
 
+#include <cstring>
 #include <limits>
 #include <string>
 
 #include "cyber/common/file.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/proto/geometry.pb.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "opencv2/opencv.hpp"
 
 namespace apollo {
@@ -58,11 +60,33 @@ void ConstructTransformationMatrix(const Quaternion &quaternion,
   (*matrix)(2, 3) = translation.z();
   (*matrix)(3, 3) = 1;
 }
+constexpr char kStreamMagic[] = "CVS1";
+constexpr uint32_t kStreamKeyFrame = 1;
+constexpr uint32_t kStreamHevc = 2;
+
+template <typename T>
+void AppendRaw(const T &value, std::string *data) {
+  data->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
 }  // namespace
 
 PerceptionCameraUpdater::PerceptionCameraUpdater(WebSocketHandler *websocket)
     : websocket_(websocket),
       node_(cyber::CreateNode("perception_camera_updater")) {
+  if (!FLAGS_camera_stream_codec.empty()) {
+    stream_encoder_.reset(new CameraStreamEncoder());
+    if (stream_encoder_->Init(FLAGS_camera_stream_codec)) {
+      decoder_ =
+          apollo::drivers::camera::CreateJpegDecoder(FLAGS_camera_jpeg_backend);
+      websocket_->RegisterConnectionReadyHandler(
+          [this](WebSocketHandler::Connection *conn) {
+            force_keyframe_ = true;
+          });
+    } else {
+      AWARN << "Falling back to jpeg camera updates.";
+      stream_encoder_.reset();
+    }
+  }
   InitReaders();
 }
 
@@ -160,21 +184,6 @@ void PerceptionCameraUpdater::OnImage(
     return;
   }
 
-  std::vector<uint8_t> compressed_raw_data(compressed_image->data().begin(),
-                                           compressed_image->data().end());
-  cv::Mat mat_image = cv::imdecode(compressed_raw_data, cv::IMREAD_COLOR);
-  const int width = mat_image.cols;
-  const int height = mat_image.rows;
-
-  // Scale down image size properly to reduce data transfer latency through
-  // websocket and ensure image quality is acceptable meanwhile
-  cv::resize(mat_image, mat_image,
-             cv::Size(static_cast<int>(mat_image.cols * kImageScale),
-                      static_cast<int>(mat_image.rows * kImageScale)),
-             0, 0, cv::INTER_LINEAR);
-  std::vector<uint8_t> tmp_buffer;
-  cv::imencode(".jpg", mat_image, tmp_buffer, std::vector<int>() /* params */);
-
   double next_image_timestamp;
   if (compressed_image->has_measurement_time()) {
     next_image_timestamp = compressed_image->measurement_time();
@@ -182,6 +191,31 @@ void PerceptionCameraUpdater::OnImage(
     next_image_timestamp = compressed_image->header().timestamp_sec();
   }
 
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> tmp_buffer;
+  if (stream_encoder_ != nullptr) {
+    if (!StreamImage(*compressed_image, next_image_timestamp, &width,
+                     &height)) {
+      return;
+    }
+  } else {
+    std::vector<uint8_t> compressed_raw_data(compressed_image->data().begin(),
+                                             compressed_image->data().end());
+    cv::Mat mat_image = cv::imdecode(compressed_raw_data, cv::IMREAD_COLOR);
+    width = mat_image.cols;
+    height = mat_image.rows;
+
+    // Scale down image size properly to reduce data transfer latency through
+    // websocket and ensure image quality is acceptable meanwhile
+    cv::resize(mat_image, mat_image,
+               cv::Size(static_cast<int>(mat_image.cols * kImageScale),
+                        static_cast<int>(mat_image.rows * kImageScale)),
+               0, 0, cv::INTER_LINEAR);
+    cv::imencode(".jpg", mat_image, tmp_buffer,
+                 std::vector<int>() /* params */);
+  }
+
   std::lock_guard<std::mutex> lock(image_mutex_);
   if (next_image_timestamp < current_image_timestamp_) {
     // If replay different bags, the timestamp may jump to earlier time and
@@ -189,10 +223,56 @@ void PerceptionCameraUpdater::OnImage(
     localization_queue_.clear();
   }
   current_image_timestamp_ = next_image_timestamp;
-  camera_update_.set_image(&(tmp_buffer[0]), tmp_buffer.size());
+  if (tmp_buffer.empty()) {
+    camera_update_.clear_image();
+  } else {
+    camera_update_.set_image(&(tmp_buffer[0]), tmp_buffer.size());
+  }
   camera_update_.set_image_aspect_ratio(static_cast<double>(width) / height);
 }
 
+bool PerceptionCameraUpdater::StreamImage(
+    const CompressedImage &compressed_image, double timestamp, int *width,
+    int *height) {
+  if (!decoder_->Decode(compressed_image.data(), &decoded_image_)) {
+    AERROR << "Failed to decode camera image with format "
+           << compressed_image.format();
+    return false;
+  }
+  *width = static_cast<int>(decoded_image_.width());
+  *height = static_cast<int>(decoded_image_.height());
+
+  bool is_keyframe = false;
+  if (!stream_encoder_->Encode(decoded_image_, kImageScale,
+                               force_keyframe_.exchange(false), &stream_data_,
+                               &is_keyframe)) {
+    force_keyframe_ = true;
+    return true;
+  }
+  if (stream_data_.empty()) {
+    return true;
+  }
+
+  uint32_t flags = 0;
+  if (is_keyframe) {
+    flags |= kStreamKeyFrame;
+  }
+  if (stream_encoder_->IsHevc()) {
+    flags |= kStreamHevc;
+  }
+  const double aspect_ratio = static_cast<double>(*width) / *height;
+  stream_frame_.clear();
+  stream_frame_.append(kStreamMagic, std::strlen(kStreamMagic));
+  AppendRaw(flags, &stream_frame_);
+  AppendRaw(timestamp, &stream_frame_);
+  AppendRaw(aspect_ratio, &stream_frame_);
+  stream_frame_.append(stream_data_);
+  // Not skippable, a dropped access unit breaks the picture until the next
+  // key frame.
+  websocket_->BroadcastBinaryData(stream_frame_);
+  return true;
+}
+
 void PerceptionCameraUpdater::OnLocalization(
     const std::shared_ptr<LocalizationEstimate> &localization) {
   if (!enabled_) {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <string>
@@ -24,8 +25,10 @@
 #include "Eigen/Dense"
 
 #include "cyber/cyber.h"
+#include "modules/dreamview/backend/perception_camera_updater/camera_stream_encoder.h"
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
 #include "modules/dreamview/proto/camera_update.pb.h"
+#include "modules/drivers/camera/jpeg_codec.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 #include "modules/localization/proto/localization.pb.h"
 #include "modules/localization/proto/pose.pb.h"
@@ -43,6 +46,13 @@ class PerceptionCameraUpdater {
    * @brief A module that collects camera image and localization (by collecting
    * localization & static transforms) to adjust camera as its real position/
    * rotation in front-end camera view for projecting HDmap to camera image
+   *
+   * With --camera_stream_codec the images are encoded once into a h264/h265
+   * stream broadcast to all the camera websocket clients as binary messages:
+   * "CVS1", uint32 flags (bit 0 key frame, bit 1 h265), double image
+   * timestamp, double aspect ratio, all little endian, followed by the annex b
+   * access unit. The camera update then carries no image, only the
+   * localization and transforms to draw the overlays with.
    */
   explicit PerceptionCameraUpdater(WebSocketHandler *websocket);
 
@@ -68,6 +78,13 @@ class PerceptionCameraUpdater {
    */
   void GetImageLocalization(std::vector<double> *localization);
 
+  /**
+   * @brief Encodes the image into the shared stream and broadcasts it.
+   * Returns false when the image could not be decoded.
+   */
+  bool StreamImage(const apollo::drivers::CompressedImage &compressed_image,
+                   double timestamp, int *width, int *height);
+
   apollo::transform::Buffer *tf_buffer_ = apollo::transform::Buffer::Instance();
   bool QueryStaticTF(const std::string &frame_id,
                      const std::string &child_frame_id,
@@ -87,6 +104,14 @@ class PerceptionCameraUpdater {
   std::vector<uint8_t> image_buffer_;
   std::vector<double> tf_static_;
 
+  std::unique_ptr<CameraStreamEncoder> stream_encoder_;
+  std::unique_ptr<apollo::drivers::camera::JpegDecoder> decoder_;
+  apollo::drivers::Image decoded_image_;
+  std::string stream_data_;
+  std::string stream_frame_;
+  // Set when a client connects so it does not wait a whole gop to start.
+  std::atomic<bool> force_keyframe_{true};
+
   std::mutex image_mutex_;
   std::mutex localization_mutex_;
 };
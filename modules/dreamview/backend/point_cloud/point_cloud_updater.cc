@@ -16,6 +16,10 @@
 
 #include "modules/dreamview/backend/point_cloud/point_cloud_updater.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <utility>
 
 #include "cyber/common/file.h"
@@ -85,6 +89,10 @@ void PointCloudUpdater::RegisterMessageHandlers() {
   websocket_->RegisterMessageHandler(
       "RequestPointCloud",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
+        if (FLAGS_point_cloud_packed_frames) {
+          SendPackedPointCloud(json, conn);
+          return;
+        }
         std::string to_send;
         // If there is no point_cloud data for more than 2 seconds, reset.
         if (point_cloud_str_ != "" &&
@@ -176,6 +184,15 @@ void PointCloudUpdater::UpdatePointCloud(
     return;
   }
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr;
+  if (FLAGS_point_cloud_packed_frames) {
+    // Frames arriving while the previous one is encoded are dropped.
+    if (future_ready_) {
+      future_ready_ = false;
+      async_future_ = cyber::Async(&PointCloudUpdater::EncodePackedPointCloud,
+                                   this, point_cloud);
+    }
+    return;
+  }
   // Check if last filter process has finished before processing new data.
   if (enable_voxel_filter_) {
     if (future_ready_) {
@@ -234,6 +251,108 @@ void PointCloudUpdater::FilterPointCloud(
   }
 }
 
+void PointCloudUpdater::EncodePackedPointCloud(
+    const std::shared_ptr<drivers::PointCloud> &point_cloud) {
+  float z_offset;
+  {
+    boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+    z_offset = lidar_height_;
+  }
+  const float step = static_cast<float>(FLAGS_point_cloud_quantization);
+  const float scale = 1.0f / step;
+  const float limit = static_cast<float>(std::numeric_limits<int16_t>::max());
+
+  std::array<std::shared_ptr<std::string>, kNumLevelsOfDetail> frames;
+  std::array<uint32_t, kNumLevelsOfDetail> sizes;
+  sizes.fill(0);
+  for (int level = 0; level < kNumLevelsOfDetail; ++level) {
+    frames[level] = std::make_shared<std::string>();
+    frames[level]->reserve(3 * sizeof(uint32_t) +
+                           3 * sizeof(int16_t) *
+                               (point_cloud->point_size() >> level));
+    frames[level]->resize(3 * sizeof(uint32_t));
+  }
+  uint32_t index = 0;
+  auto append = [&](float x, float y, float z) {
+    if (std::isnan(x) || std::isnan(y) || std::isnan(z)) {
+      return;
+    }
+    const float steps[3] = {x * scale, y * scale, (z + z_offset) * scale};
+    int16_t packed[3];
+    for (int i = 0; i < 3; ++i) {
+      if (std::fabs(steps[i]) > limit) {
+        return;
+      }
+      packed[i] = static_cast<int16_t>(std::lround(steps[i]));
+    }
+    for (int level = 0; level < kNumLevelsOfDetail; ++level) {
+      if ((index & ((1u << level) - 1)) != 0) {
+        break;
+      }
+      frames[level]->append(reinterpret_cast<const char *>(packed),
+                            sizeof(packed));
+      ++sizes[level];
+    }
+    ++index;
+  };
+
+  if (enable_voxel_filter_) {
+    pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr =
+        ConvertPCLPointCloud(point_cloud);
+    pcl::PointCloud<pcl::PointXYZ> pcl_filtered;
+    pcl::VoxelGrid<pcl::PointXYZ> voxel_grid;
+    voxel_grid.setInputCloud(pcl_ptr);
+    voxel_grid.setLeafSize(static_cast<float>(FLAGS_voxel_filter_size),
+                           static_cast<float>(FLAGS_voxel_filter_size),
+                           static_cast<float>(FLAGS_voxel_filter_height));
+    voxel_grid.filter(pcl_filtered);
+    for (const auto &pt : pcl_filtered.points) {
+      append(pt.x, pt.y, pt.z);
+    }
+  } else {
+    for (const auto &pt : point_cloud->point()) {
+      append(pt.x(), pt.y(), pt.z());
+    }
+  }
+
+  static const uint32_t kMagic = 0x31514350;  // "PCQ1"
+  std::array<std::shared_ptr<const std::string>, kNumLevelsOfDetail> encoded;
+  for (int level = 0; level < kNumLevelsOfDetail; ++level) {
+    char *header = &(*frames[level])[0];
+    std::memcpy(header, &kMagic, sizeof(uint32_t));
+    std::memcpy(header + sizeof(uint32_t), &sizes[level], sizeof(uint32_t));
+    std::memcpy(header + 2 * sizeof(uint32_t), &step, sizeof(float));
+    encoded[level] = std::move(frames[level]);
+  }
+  {
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    packed_frames_.swap(encoded);
+    future_ready_ = true;
+  }
+}
+
+void PointCloudUpdater::SendPackedPointCloud(
+    const Json &json, WebSocketHandler::Connection *conn) {
+  int level = 0;
+  auto lod = json.find("lod");
+  if (lod != json.end() && lod->is_number_integer()) {
+    level = std::max(0, std::min(kNumLevelsOfDetail - 1, lod->get<int>()));
+  }
+  std::shared_ptr<const std::string> frame;
+  // If there is no point_cloud data for more than 2 seconds, reset.
+  if (std::fabs(last_localization_time_ - last_point_cloud_time_) > 2.0) {
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    packed_frames_.fill(nullptr);
+  } else {
+    boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+    frame = packed_frames_[level];
+  }
+  // The frame is shared with the other clients, it is sent without a copy.
+  static const std::string kEmptyFrame;
+  websocket_->SendBinaryData(conn, frame == nullptr ? kEmptyFrame : *frame,
+                             true);
+}
+
 void PointCloudUpdater::UpdateLocalizationTime(
     const std::shared_ptr<LocalizationEstimate> &localization) {
   last_localization_time_ = localization->header().timestamp_sec();
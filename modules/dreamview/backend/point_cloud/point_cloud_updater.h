@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 
@@ -84,6 +85,18 @@ class PointCloudUpdater {
 
   void FilterPointCloud(pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_ptr);
 
+  /**
+   * @brief Encodes the point cloud once into the packed frames of all the
+   * levels of detail. A packed frame is little endian: uint32 magic "PCQ1",
+   * uint32 number of points, float coordinate step in meters, then the x, y,
+   * z of every point as int16 steps, z including the lidar height.
+   */
+  void EncodePackedPointCloud(
+      const std::shared_ptr<drivers::PointCloud> &point_cloud);
+
+  void SendPackedPointCloud(const WebSocketHandler::Json &json,
+                            WebSocketHandler::Connection *conn);
+
   void UpdateLocalizationTime(
       const std::shared_ptr<apollo::localization::LocalizationEstimate>
           &localization);
@@ -92,6 +105,10 @@ class PointCloudUpdater {
 
   constexpr static float kDefaultLidarHeight = 1.91f;
 
+  // Level of detail l keeps every 2^l-th point, the frontend asks for a
+  // coarser level when the cloud covers a small part of the viewport.
+  constexpr static int kNumLevelsOfDetail = 4;
+
   std::unique_ptr<cyber::Node> node_;
 
   WebSocketHandler *websocket_;
@@ -101,6 +118,10 @@ class PointCloudUpdater {
   // The PointCloud to be pushed to frontend.
   std::string point_cloud_str_;
 
+  // The packed frames to be pushed to frontend, shared by all the clients.
+  std::array<std::shared_ptr<const std::string>, kNumLevelsOfDetail>
+      packed_frames_;
+
   std::future<void> async_future_;
   std::atomic<bool> future_ready_;
 
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta.h"
+
+#include <cmath>
+#include <utility>
+
+namespace apollo {
+namespace dreamview {
+
+using google::protobuf::RepeatedPtrField;
+
+SimulationWorldDeltaEncoder::SimulationWorldDeltaEncoder(
+    const double resolution)
+    : resolution_(resolution) {}
+
+void SimulationWorldDeltaEncoder::Quantize(Object *object) const {
+  if (resolution_ <= 0.0) {
+    return;
+  }
+  auto round = [this](const double value) {
+    return std::round(value / resolution_) * resolution_;
+  };
+  object->set_position_x(round(object->position_x()));
+  object->set_position_y(round(object->position_y()));
+  for (auto &point : *object->mutable_polygon_point()) {
+    point.set_x(round(point.x()));
+    point.set_y(round(point.y()));
+  }
+}
+
+void SimulationWorldDeltaEncoder::Update(const SimulationWorld &world) {
+  ++sequence_num_;
+  SimulationWorldDelta key_frame;
+  key_frame.set_sequence_num(sequence_num_);
+  SimulationWorld *key_world = key_frame.mutable_world();
+  *key_world = world;
+
+  // The delta world is the key world without the unchanged objects.
+  SimulationWorldDelta delta_frame;
+  delta_frame.set_sequence_num(sequence_num_);
+  delta_frame.set_base_sequence_num(sequence_num_ - 1);
+  RepeatedPtrField<Object> objects;
+  objects.Swap(key_world->mutable_object());
+  *delta_frame.mutable_world() = *key_world;
+  key_world->mutable_object()->Swap(&objects);
+
+  std::unordered_map<std::string, std::string> serialized_objects;
+  serialized_objects.reserve(key_world->object_size());
+  for (auto &object : *key_world->mutable_object()) {
+    Quantize(&object);
+    // A new obstacle timestamp alone is not worth resending the object.
+    const double timestamp_sec = object.timestamp_sec();
+    object.clear_timestamp_sec();
+    std::string serialized = object.SerializeAsString();
+    object.set_timestamp_sec(timestamp_sec);
+    const auto iter = objects_.find(object.id());
+    if (iter == objects_.end() || iter->second != serialized) {
+      *delta_frame.mutable_world()->add_object() = object;
+    }
+    serialized_objects.emplace(object.id(), std::move(serialized));
+  }
+  for (const auto &object : objects_) {
+    if (serialized_objects.count(object.first) == 0) {
+      delta_frame.add_removed_object_id(object.first);
+    }
+  }
+  objects_ = std::move(serialized_objects);
+
+  key_frame_ =
+      std::make_shared<const std::string>(key_frame.SerializeAsString());
+  delta_frame_ =
+      std::make_shared<const std::string>(delta_frame.SerializeAsString());
+}
+
+SimulationWorldDeltaEncoder::Frame SimulationWorldDeltaEncoder::FrameFor(
+    const uint64_t last_sequence_num) const {
+  if (last_sequence_num == sequence_num_) {
+    return nullptr;
+  }
+  if (last_sequence_num > 0 && last_sequence_num + 1 == sequence_num_) {
+    return delta_frame_;
+  }
+  return key_frame_;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
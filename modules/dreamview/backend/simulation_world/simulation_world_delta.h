@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+#include "modules/dreamview/proto/simulation_world_delta.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldDeltaEncoder
+ * @brief Encodes every SimulationWorld update into a serialized key frame and
+ * a serialized delta frame against the previous update, once for all the
+ * websocket clients.
+ */
+class SimulationWorldDeltaEncoder {
+ public:
+  using Frame = std::shared_ptr<const std::string>;
+
+  /**
+   * @param resolution The object coordinates are rounded to this many meters,
+   * so that jitter below it doesn't count as a change.
+   */
+  explicit SimulationWorldDeltaEncoder(const double resolution);
+
+  /**
+   * @brief Encode the next update of the world.
+   */
+  void Update(const SimulationWorld &world);
+
+  /**
+   * @brief The sequence number of the latest update, 0 before any update.
+   */
+  uint64_t SequenceNum() const { return sequence_num_; }
+
+  /**
+   * @brief The frame to send to a client which has the update of
+   * last_sequence_num: the delta frame if that is the previous update, a key
+   * frame otherwise, and nullptr if the client is up to date.
+   */
+  Frame FrameFor(const uint64_t last_sequence_num) const;
+
+ private:
+  void Quantize(Object *object) const;
+
+  const double resolution_;
+  uint64_t sequence_num_ = 0;
+  // The serialized quantized objects of the latest update keyed by id.
+  std::unordered_map<std::string, std::string> objects_;
+  Frame key_frame_;
+  Frame delta_frame_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
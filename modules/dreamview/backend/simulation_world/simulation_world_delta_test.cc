@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+Object *AddObject(const std::string &id, const double x,
+                  SimulationWorld *world) {
+  Object *object = world->add_object();
+  object->set_id(id);
+  object->set_position_x(x);
+  object->set_position_y(0.0);
+  return object;
+}
+
+SimulationWorldDelta ParseFrame(const SimulationWorldDeltaEncoder::Frame &f) {
+  SimulationWorldDelta frame;
+  EXPECT_TRUE(f != nullptr);
+  if (f != nullptr) {
+    EXPECT_TRUE(frame.ParseFromString(*f));
+  }
+  return frame;
+}
+
+}  // namespace
+
+TEST(SimulationWorldDeltaEncoderTest, KeyAndDeltaFrames) {
+  SimulationWorldDeltaEncoder encoder(0.01);
+  EXPECT_EQ(0, encoder.SequenceNum());
+  EXPECT_TRUE(encoder.FrameFor(0) == nullptr);
+
+  SimulationWorld world;
+  world.set_sequence_num(1);
+  AddObject("1", 1.0, &world);
+  AddObject("2", 2.0, &world);
+  AddObject("3", 3.0, &world);
+  encoder.Update(world);
+  EXPECT_EQ(1, encoder.SequenceNum());
+  SimulationWorldDelta frame = ParseFrame(encoder.FrameFor(0));
+  EXPECT_EQ(1, frame.sequence_num());
+  EXPECT_EQ(0, frame.base_sequence_num());
+  EXPECT_EQ(3, frame.world().object_size());
+  EXPECT_TRUE(encoder.FrameFor(1) == nullptr);
+
+  // Object 1 jitters below the resolution, 2 moves and 3 disappears.
+  world.set_sequence_num(2);
+  world.clear_object();
+  AddObject("1", 1.001, &world)->set_timestamp_sec(2.0);
+  AddObject("2", 2.5, &world);
+  encoder.Update(world);
+  frame = ParseFrame(encoder.FrameFor(1));
+  EXPECT_EQ(2, frame.sequence_num());
+  EXPECT_EQ(1, frame.base_sequence_num());
+  EXPECT_EQ(2, frame.world().sequence_num());
+  ASSERT_EQ(1, frame.world().object_size());
+  EXPECT_EQ("2", frame.world().object(0).id());
+  EXPECT_DOUBLE_EQ(2.5, frame.world().object(0).position_x());
+  ASSERT_EQ(1, frame.removed_object_id_size());
+  EXPECT_EQ("3", frame.removed_object_id(0));
+
+  // A client which missed an update gets the whole world.
+  frame = ParseFrame(encoder.FrameFor(0));
+  EXPECT_EQ(0, frame.base_sequence_num());
+  ASSERT_EQ(2, frame.world().object_size());
+  EXPECT_DOUBLE_EQ(1.0, frame.world().object(0).position_x());
+  EXPECT_DOUBLE_EQ(2.0, frame.world().object(0).timestamp_sec());
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "modules/dreamview/backend/simulation_world/simulation_world_updater.h"
 
+#include <algorithm>
+
 #include "google/protobuf/util/json_util.h"
 
 #include "cyber/common/file.h"
@@ -51,7 +53,8 @@ SimulationWorldUpdater::SimulationWorldUpdater(
       camera_ws_(camera_ws),
       sim_control_(sim_control),
       data_collection_monitor_(data_collection_monitor),
-      perception_camera_updater_(perception_camera_updater) {
+      perception_camera_updater_(perception_camera_updater),
+      delta_encoder_(FLAGS_sim_world_delta_resolution) {
   RegisterMessageHandlers();
 }
 
@@ -63,6 +66,10 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         response["type"] = "SimControlStatus";
         response["enabled"] = sim_control_->IsEnabled();
         websocket_->SendData(conn, response.dump());
+
+        // A new connection starts the delta stream with a key frame.
+        std::lock_guard<std::mutex> lock(delta_clients_mutex_);
+        delta_clients_.erase(conn);
       });
 
   map_ws_->RegisterMessageHandler(
@@ -72,11 +79,8 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (iter != json.end()) {
           MapElementIds map_element_ids;
           if (JsonStringToMessage(iter->dump(), &map_element_ids).ok()) {
-            auto retrieved = map_service_->RetrieveMapElements(map_element_ids);
-
-            std::string retrieved_map_string;
-            retrieved.SerializeToString(&retrieved_map_string);
-
+            const std::string retrieved_map_string =
+                map_service_->RetrieveSerializedMapElements(map_element_ids);
             map_ws_->SendBinaryData(conn, retrieved_map_string, true);
           } else {
             AERROR << "Failed to parse MapElementIds from json";
@@ -174,6 +178,12 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
+        auto delta = json.find("delta");
+        if (FLAGS_enable_sim_world_delta && !enable_pnc_monitor &&
+            delta != json.end() && delta->is_boolean() && delta->get<bool>()) {
+          SendSimulationWorldDelta(conn);
+          return;
+        }
         std::string to_send;
         {
           // Pay the price to copy the data instead of sending data over the
@@ -420,7 +430,52 @@ void SimulationWorldUpdater::OnTimer() {
         &simulation_world_with_planning_data_);
     sim_world_service_.GetRelativeMap().SerializeToString(
         &relative_map_string_);
+    if (FLAGS_enable_sim_world_delta) {
+      // The planning data has been cleared from the world by now.
+      delta_encoder_.Update(sim_world_service_.world());
+    }
+  }
+}
+
+void SimulationWorldUpdater::SendSimulationWorldDelta(
+    WebSocketHandler::Connection *conn) {
+  static constexpr uint64_t kMaxDeltaInterval = 8;
+  DeltaClient client;
+  {
+    std::lock_guard<std::mutex> lock(delta_clients_mutex_);
+    client = delta_clients_[conn];
   }
+
+  uint64_t sequence_num = 0;
+  SimulationWorldDeltaEncoder::Frame frame;
+  {
+    boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+    sequence_num = delta_encoder_.SequenceNum();
+    if (sequence_num < client.next_sequence_num) {
+      return;
+    }
+    frame = delta_encoder_.FrameFor(client.last_sequence_num);
+  }
+  if (frame == nullptr) {
+    return;
+  }
+  if (FLAGS_enable_update_size_check && frame->size() > FLAGS_max_update_size) {
+    AWARN << "update size is too big:" << frame->size();
+    return;
+  }
+
+  if (websocket_->SendBinaryData(conn, *frame, true)) {
+    client.last_sequence_num = sequence_num;
+    client.interval = std::max<uint64_t>(client.interval / 2, 1);
+  } else {
+    // The connection is still busy with an earlier frame, serve it less
+    // often. It gets a key frame next as it missed this update.
+    client.interval = std::min(client.interval * 2, kMaxDeltaInterval);
+  }
+  client.next_sequence_num = sequence_num + client.interval;
+
+  std::lock_guard<std::mutex> lock(delta_clients_mutex_);
+  delta_clients_[conn] = client;
 }
 
 bool SimulationWorldUpdater::LoadPOI() {
@@ -21,7 +21,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
@@ -34,6 +36,7 @@
 #include "modules/dreamview/backend/map/map_service.h"
 #include "modules/dreamview/backend/perception_camera_updater/perception_camera_updater.h"
 #include "modules/dreamview/backend/sim_control/sim_control.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_delta.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_service.h"
 #include "modules/routing/proto/poi.pb.h"
 
@@ -115,6 +118,17 @@ class SimulationWorldUpdater {
 
   void RegisterMessageHandlers();
 
+  // Send the client the frame of the delta stream it is due, if any.
+  void SendSimulationWorldDelta(WebSocketHandler::Connection *conn);
+
+  struct DeltaClient {
+    uint64_t last_sequence_num = 0;
+    // The client is not served before this update.
+    uint64_t next_sequence_num = 0;
+    // Updates between two frames, grows while the connection is busy.
+    uint64_t interval = 1;
+  };
+
   SimulationWorldService sim_world_service_;
   const MapService *map_service_ = nullptr;
   WebSocketHandler *websocket_ = nullptr;
@@ -135,6 +149,12 @@ class SimulationWorldUpdater {
   // Received relative map data in wire format.
   std::string relative_map_string_;
 
+  // Guarded by mutex_.
+  SimulationWorldDeltaEncoder delta_encoder_;
+  std::unordered_map<WebSocketHandler::Connection *, DeltaClient>
+      delta_clients_;
+  std::mutex delta_clients_mutex_;
+
   // Mutex to protect concurrent access to simulation_world_json_.
   // NOTE: Use boost until we have std version of rwlock support.
   boost::shared_mutex mutex_;
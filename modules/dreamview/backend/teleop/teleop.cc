@@ -20,6 +20,7 @@
 #include "cyber/time/time.h"
 #include "google/protobuf/util/json_util.h"
 #include "modules/common/util/message_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 
 #include <iomanip>
 #include <sstream>
@@ -29,6 +30,7 @@ namespace dreamview {
 
 using Json = nlohmann::json;
 using apollo::cyber::Time;
+using apollo::drivers::CompressedImage;
 using apollo::planning::ADCTrajectory;
 using apollo::planning::DrivingAction;
 using apollo::planning::PadMessage;
@@ -125,6 +127,21 @@ void TeleopService::Start() {
       });
 
   pad_message_writer_ = node_->CreateWriter<PadMessage>(planning_pad_channel);
+
+  if (!FLAGS_teleop_stream_channel.empty()) {
+    stream_.reset(new TeleopStream(websocket_));
+    if (stream_->Init(FLAGS_teleop_stream_codec)) {
+      stream_image_reader_ = node_->CreateReader<CompressedImage>(
+          FLAGS_teleop_stream_channel,
+          [this](const std::shared_ptr<CompressedImage> &msg) {
+            stream_->OnImage(*msg);
+          });
+    } else {
+      AERROR << "Failed to start the teleop stream of "
+             << FLAGS_teleop_stream_channel;
+      stream_.reset();
+    }
+  }
 }
 
 void TeleopService::RegisterMessageHandlers() {
@@ -258,12 +275,15 @@ void TeleopService::RegisterMessageHandlers() {
 }
 
 void TeleopService::SendStatus(WebSocketHandler::Connection *conn) {
-  std::string to_send;
+  Json status;
   {
     boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-    to_send = teleop_status_.dump();
+    status = teleop_status_;
+  }
+  if (stream_ != nullptr) {
+    stream_->GetMetrics(&status["stream"]);
   }
-  websocket_->SendData(conn, to_send);
+  websocket_->SendData(conn, status.dump());
 }
 
 void TeleopService::UpdateModem(const std::string &modem_id,
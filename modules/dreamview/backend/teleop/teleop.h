@@ -31,6 +31,7 @@
 #endif
 
 #include "modules/dreamview/backend/handlers/websocket_handler.h"
+#include "modules/dreamview/backend/teleop/teleop_stream.h"
 
 namespace apollo {
 namespace dreamview {
@@ -100,6 +101,12 @@ class TeleopService {
       pad_message_writer_;
   void UpdatePlanning(
       const std::shared_ptr<apollo::planning::ADCTrajectory> &msg);
+
+  // adaptive bitrate camera stream to the console, off without
+  // --teleop_stream_channel
+  std::unique_ptr<TeleopStream> stream_;
+  std::shared_ptr<cyber::Reader<apollo::drivers::CompressedImage>>
+      stream_image_reader_;
 #endif
 
   // Store teleop status
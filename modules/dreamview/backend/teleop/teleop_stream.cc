@@ -0,0 +1,330 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/dreamview/backend/teleop/teleop_stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "modules/common/util/json_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
+
+namespace apollo {
+namespace dreamview {
+
+using apollo::common::util::JsonUtil;
+using apollo::drivers::CompressedImage;
+
+namespace {
+
+// The base round trip time is the minimum of the last two windows, so it
+// follows a route change within two windows.
+constexpr double kBaseRttWindowMs = 10000.0;
+// Queueing delay tolerated over the base round trip time, at least this
+// much or half of the base.
+constexpr double kRttSlackMs = 40.0;
+constexpr double kMinDecreaseIntervalMs = 200.0;
+constexpr double kIncreaseIntervalMs = 1000.0;
+constexpr int kMinIncrease = 50000;
+// More frames waiting than this means the link does not keep up.
+constexpr size_t kMaxQueueDepth = 2;
+
+constexpr char kStreamMagic[] = "TVS1";
+constexpr uint32_t kStreamKeyFrame = 1;
+constexpr uint32_t kStreamHevc = 2;
+
+template <typename T>
+void AppendRaw(const T &value, std::string *data) {
+  data->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+}  // namespace
+
+StreamRateController::StreamRateController(int min_bitrate, int max_bitrate,
+                                           int start_bitrate)
+    : min_bitrate_(min_bitrate),
+      max_bitrate_(std::max(min_bitrate, max_bitrate)),
+      bitrate_(std::min(std::max(start_bitrate, min_bitrate_), max_bitrate_)) {}
+
+void StreamRateController::OnRtt(double now_ms, double rtt_ms) {
+  rtt_ms_ = rtt_ms_ == 0.0 ? rtt_ms : 0.875 * rtt_ms_ + 0.125 * rtt_ms;
+  if (window_min_rtt_ms_ == 0.0) {
+    window_start_ms_ = now_ms;
+  } else if (now_ms - window_start_ms_ >= kBaseRttWindowMs) {
+    last_window_min_rtt_ms_ = window_min_rtt_ms_;
+    window_min_rtt_ms_ = 0.0;
+    window_start_ms_ = now_ms;
+  }
+  if (window_min_rtt_ms_ == 0.0 || rtt_ms < window_min_rtt_ms_) {
+    window_min_rtt_ms_ = rtt_ms;
+  }
+}
+
+void StreamRateController::OnDrop(int frames) { dropped_frames_ += frames; }
+
+double StreamRateController::base_rtt_ms() const {
+  if (last_window_min_rtt_ms_ == 0.0) {
+    return window_min_rtt_ms_;
+  }
+  return std::min(window_min_rtt_ms_, last_window_min_rtt_ms_);
+}
+
+int StreamRateController::Update(double now_ms, size_t queue_depth) {
+  const double base_rtt = base_rtt_ms();
+  const bool delayed =
+      base_rtt > 0.0 &&
+      rtt_ms_ > base_rtt + std::max(kRttSlackMs, 0.5 * base_rtt);
+  if (dropped_frames_ > 0 || queue_depth > kMaxQueueDepth || delayed) {
+    // One cut per round trip, the samples right after a cut still carry the
+    // queue built up before it.
+    if (now_ms - last_decrease_ms_ >=
+        std::max(kMinDecreaseIntervalMs, rtt_ms_)) {
+      const double factor = dropped_frames_ > 0 ? 0.7 : 0.85;
+      bitrate_ = static_cast<int>(bitrate_ * factor);
+      last_decrease_ms_ = now_ms;
+      dropped_frames_ = 0;
+    }
+    last_increase_ms_ = now_ms;
+  } else if (now_ms - last_increase_ms_ >= kIncreaseIntervalMs) {
+    bitrate_ += std::max(static_cast<int>(bitrate_ * 0.08), kMinIncrease);
+    last_increase_ms_ = now_ms;
+  }
+  bitrate_ = std::min(std::max(bitrate_, min_bitrate_), max_bitrate_);
+  return bitrate_;
+}
+
+int LatestFrameQueue::Push(Frame frame) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (shutdown_) {
+    return 1;
+  }
+  int dropped = 0;
+  if (!frames_.empty() &&
+      frame.enqueue_ms - frames_.front().enqueue_ms > max_latency_ms_) {
+    dropped = Flush();
+  }
+  if (frame.keyframe) {
+    waiting_keyframe_ = false;
+  } else if (waiting_keyframe_) {
+    return dropped + 1;
+  }
+  frames_.push_back(std::move(frame));
+  cv_.notify_one();
+  return dropped;
+}
+
+bool LatestFrameQueue::Pop(int timeout_ms, Frame *frame, int *dropped) {
+  *dropped = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                    [this] { return shutdown_ || !frames_.empty(); }) ||
+      shutdown_) {
+    return false;
+  }
+  if (TeleopStream::NowMs() - frames_.front().enqueue_ms > max_latency_ms_) {
+    *dropped = Flush();
+    return false;
+  }
+  *frame = std::move(frames_.front());
+  frames_.pop_front();
+  return true;
+}
+
+bool LatestFrameQueue::WaitingKeyFrame() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return waiting_keyframe_;
+}
+
+void LatestFrameQueue::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+}
+
+size_t LatestFrameQueue::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return frames_.size();
+}
+
+int LatestFrameQueue::Flush() {
+  const int dropped = static_cast<int>(frames_.size());
+  frames_.clear();
+  waiting_keyframe_ = true;
+  return dropped;
+}
+
+TeleopStream::TeleopStream(WebSocketHandler *websocket)
+    : websocket_(websocket),
+      queue_(FLAGS_teleop_stream_max_latency_ms),
+      rate_controller_(FLAGS_teleop_stream_min_bitrate,
+                       FLAGS_teleop_stream_max_bitrate,
+                       FLAGS_camera_stream_bitrate) {}
+
+TeleopStream::~TeleopStream() {
+  running_ = false;
+  queue_.Shutdown();
+  if (sender_.joinable()) {
+    sender_.join();
+  }
+}
+
+double TeleopStream::NowMs() {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool TeleopStream::Init(const std::string &codec_name) {
+  encoder_.reset(new CameraStreamEncoder());
+  if (!encoder_->Init(codec_name)) {
+    encoder_.reset();
+    return false;
+  }
+  encoder_->SetBitrate(rate_controller_.bitrate());
+  decoder_ =
+      apollo::drivers::camera::CreateJpegDecoder(FLAGS_camera_jpeg_backend);
+  websocket_->RegisterMessageHandler(
+      "TeleopStreamPong",
+      [this](const Json &json, WebSocketHandler::Connection *conn) {
+        OnPong(json);
+      });
+  websocket_->RegisterConnectionReadyHandler(
+      [this](WebSocketHandler::Connection *conn) { force_keyframe_ = true; });
+  running_ = true;
+  sender_ = std::thread(&TeleopStream::SendLoop, this);
+  AINFO << "Teleop stream started with " << codec_name;
+  return true;
+}
+
+void TeleopStream::OnImage(const CompressedImage &compressed_image) {
+  if (!running_) {
+    return;
+  }
+  if (!decoder_->Decode(compressed_image.data(), &decoded_image_)) {
+    AERROR << "Failed to decode teleop image with format "
+           << compressed_image.format();
+    return;
+  }
+
+  int bitrate = 0;
+  {
+    std::lock_guard<std::mutex> lock(rate_mutex_);
+    bitrate = rate_controller_.Update(NowMs(), queue_.size());
+  }
+  encoder_->SetBitrate(bitrate);
+
+  const bool keyframe =
+      force_keyframe_.exchange(false) || queue_.WaitingKeyFrame();
+  bool is_keyframe = false;
+  if (!encoder_->Encode(decoded_image_, 1.0, keyframe, &encoded_,
+                        &is_keyframe)) {
+    force_keyframe_ = true;
+    return;
+  }
+  if (encoded_.empty()) {
+    return;
+  }
+
+  uint32_t flags = 0;
+  if (is_keyframe) {
+    flags |= kStreamKeyFrame;
+  }
+  if (encoder_->IsHevc()) {
+    flags |= kStreamHevc;
+  }
+  const double timestamp = compressed_image.has_measurement_time()
+                               ? compressed_image.measurement_time()
+                               : compressed_image.header().timestamp_sec();
+  LatestFrameQueue::Frame frame;
+  frame.data.reserve(std::strlen(kStreamMagic) + sizeof(flags) +
+                     sizeof(timestamp) + encoded_.size());
+  frame.data.append(kStreamMagic, std::strlen(kStreamMagic));
+  AppendRaw(flags, &frame.data);
+  AppendRaw(timestamp, &frame.data);
+  frame.data.append(encoded_);
+  frame.keyframe = is_keyframe;
+  frame.enqueue_ms = NowMs();
+  const int dropped = queue_.Push(std::move(frame));
+  if (dropped > 0) {
+    dropped_frames_ += dropped;
+    std::lock_guard<std::mutex> lock(rate_mutex_);
+    rate_controller_.OnDrop(dropped);
+  }
+}
+
+void TeleopStream::SendLoop() {
+  double last_ping_ms = 0.0;
+  while (running_) {
+    LatestFrameQueue::Frame frame;
+    int dropped = 0;
+    if (queue_.Pop(FLAGS_teleop_stream_ping_interval_ms, &frame, &dropped)) {
+      // Not skippable, a dropped access unit breaks the picture until the
+      // next key frame. Stale frames are dropped by the queue instead.
+      websocket_->BroadcastBinaryData(frame.data);
+      ++sent_frames_;
+    }
+    if (dropped > 0) {
+      dropped_frames_ += dropped;
+      std::lock_guard<std::mutex> lock(rate_mutex_);
+      rate_controller_.OnDrop(dropped);
+    }
+    const double now_ms = NowMs();
+    if (now_ms - last_ping_ms >= FLAGS_teleop_stream_ping_interval_ms) {
+      SendPing(now_ms);
+      last_ping_ms = now_ms;
+    }
+  }
+}
+
+void TeleopStream::SendPing(double now_ms) {
+  Json ping;
+  ping["type"] = "TeleopStreamPing";
+  ping["time"] = now_ms;
+  GetMetrics(&ping["stats"]);
+  websocket_->BroadcastData(ping.dump());
+}
+
+void TeleopStream::OnPong(const Json &json) {
+  double time_ms = 0.0;
+  if (!JsonUtil::GetNumber(json, "time", &time_ms)) {
+    return;
+  }
+  const double now_ms = NowMs();
+  if (now_ms < time_ms) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(rate_mutex_);
+  rate_controller_.OnRtt(now_ms, now_ms - time_ms);
+}
+
+void TeleopStream::GetMetrics(Json *metrics) const {
+  {
+    std::lock_guard<std::mutex> lock(rate_mutex_);
+    (*metrics)["bitrate"] = rate_controller_.bitrate();
+    (*metrics)["rtt_ms"] = rate_controller_.rtt_ms();
+    (*metrics)["base_rtt_ms"] = rate_controller_.base_rtt_ms();
+  }
+  (*metrics)["queue_depth"] = queue_.size();
+  (*metrics)["sent_frames"] = sent_frames_.load();
+  (*metrics)["dropped_frames"] = dropped_frames_.load();
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "nlohmann/json.hpp"
+
+#include "modules/dreamview/backend/handlers/websocket_handler.h"
+#include "modules/dreamview/backend/perception_camera_updater/camera_stream_encoder.h"
+#include "modules/drivers/camera/jpeg_codec.h"
+#include "modules/drivers/proto/sensor_image.pb.h"
+
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class StreamRateController
+ *
+ * @brief Delay based bitrate control of the teleop stream. The round trip
+ * time growing over its recent minimum, frames queueing up or frames being
+ * dropped mean the link is congested and cut the bitrate multiplicatively,
+ * otherwise the bitrate grows by a few percent each second.
+ */
+class StreamRateController {
+ public:
+  StreamRateController(int min_bitrate, int max_bitrate, int start_bitrate);
+
+  /**
+   * @brief Feeds a round trip time sample measured at now_ms.
+   */
+  void OnRtt(double now_ms, double rtt_ms);
+
+  /**
+   * @brief Notes frames dropped because they waited too long.
+   */
+  void OnDrop(int frames);
+
+  /**
+   * @brief Updates and returns the bitrate for the next frame given the
+   * frames currently waiting to be sent.
+   */
+  int Update(double now_ms, size_t queue_depth);
+
+  int bitrate() const { return bitrate_; }
+  // Smoothed round trip time, 0 before the first sample.
+  double rtt_ms() const { return rtt_ms_; }
+  // Lowest round trip time of the last two windows.
+  double base_rtt_ms() const;
+
+ private:
+  const int min_bitrate_;
+  const int max_bitrate_;
+  int bitrate_;
+
+  double rtt_ms_ = 0.0;
+  double window_start_ms_ = 0.0;
+  double window_min_rtt_ms_ = 0.0;
+  double last_window_min_rtt_ms_ = 0.0;
+
+  int dropped_frames_ = 0;
+  double last_decrease_ms_ = 0.0;
+  double last_increase_ms_ = 0.0;
+};
+
+/**
+ * @class LatestFrameQueue
+ *
+ * @brief Latency first queue of encoded frames. A frame waiting longer than
+ * the latency budget is never sent: the queue is flushed instead and the
+ * frames up to the next key frame are dropped, as they would not decode
+ * without the frames before them.
+ */
+class LatestFrameQueue {
+ public:
+  struct Frame {
+    std::string data;
+    bool keyframe = false;
+    double enqueue_ms = 0.0;
+  };
+
+  explicit LatestFrameQueue(double max_latency_ms)
+      : max_latency_ms_(max_latency_ms) {}
+
+  /**
+   * @brief Queues a frame, frame.enqueue_ms is on the TeleopStream::NowMs
+   * clock.
+   * @return The number of frames dropped, including this one.
+   */
+  int Push(Frame frame);
+
+  /**
+   * @brief Waits up to timeout_ms for a frame. If the oldest frame is out of
+   * the latency budget already, the queue is flushed instead.
+   * @return False on timeout, flush or shutdown.
+   */
+  bool Pop(int timeout_ms, Frame *frame, int *dropped);
+
+  /**
+   * @brief Whether the next frame needs to be a key frame.
+   */
+  bool WaitingKeyFrame() const;
+
+  void Shutdown();
+
+  size_t size() const;
+
+ private:
+  // Drops everything queued, the lock is held by the caller.
+  int Flush();
+
+  const double max_latency_ms_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Frame> frames_;
+  bool waiting_keyframe_ = true;
+  bool shutdown_ = false;
+};
+
+/**
+ * @class TeleopStream
+ *
+ * @brief Streams a camera channel to the teleop console through the teleop
+ * websocket, encoded with the camera stream encoder at a bitrate following
+ * the round trip time probed over the same websocket. The probes carry the
+ * stream metrics, so they double as a telemetry channel.
+ */
+class TeleopStream {
+ public:
+  using Json = nlohmann::json;
+
+  explicit TeleopStream(WebSocketHandler *websocket);
+  ~TeleopStream();
+
+  /**
+   * @brief Opens the encoder and starts the sender thread.
+   */
+  bool Init(const std::string &codec_name);
+
+  /**
+   * @brief Decodes, encodes and queues a camera image, called on the reader
+   * thread.
+   */
+  void OnImage(const apollo::drivers::CompressedImage &compressed_image);
+
+  /**
+   * @brief Fills the bitrate, round trip time and queue metrics.
+   */
+  void GetMetrics(Json *metrics) const;
+
+  static double NowMs();
+
+ private:
+  void SendLoop();
+  void SendPing(double now_ms);
+  void OnPong(const Json &json);
+
+  WebSocketHandler *websocket_ = nullptr;
+  std::unique_ptr<CameraStreamEncoder> encoder_;
+  std::unique_ptr<apollo::drivers::camera::JpegDecoder> decoder_;
+  apollo::drivers::Image decoded_image_;
+  std::string encoded_;
+  std::atomic<bool> force_keyframe_{true};
+
+  LatestFrameQueue queue_;
+  // Guards the rate controller, fed by the reader, sender and websocket
+  // threads.
+  mutable std::mutex rate_mutex_;
+  StreamRateController rate_controller_;
+
+  std::atomic<uint64_t> sent_frames_{0};
+  std::atomic<uint64_t> dropped_frames_{0};
+  std::atomic<bool> running_{false};
+  std::thread sender_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
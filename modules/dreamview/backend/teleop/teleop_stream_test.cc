@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2019 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/dreamview/backend/teleop/teleop_stream.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+TEST(StreamRateControllerTest, IncreaseAndDecrease) {
+  StreamRateController controller(100000, 1000000, 500000);
+  EXPECT_EQ(500000, controller.bitrate());
+
+  // Steady round trip time lets the bitrate grow once per second up to the
+  // maximum.
+  double now_ms = 0.0;
+  for (int i = 0; i < 100; ++i) {
+    now_ms += 100.0;
+    controller.OnRtt(now_ms, 50.0);
+    controller.Update(now_ms, 0);
+  }
+  EXPECT_EQ(1000000, controller.bitrate());
+  EXPECT_DOUBLE_EQ(50.0, controller.base_rtt_ms());
+
+  // Queueing delay on the link cuts the bitrate.
+  for (int i = 0; i < 10; ++i) {
+    now_ms += 100.0;
+    controller.OnRtt(now_ms, 400.0);
+  }
+  const int before = controller.bitrate();
+  EXPECT_LT(controller.Update(now_ms, 0), before);
+  // At most once per round trip.
+  const int after = controller.bitrate();
+  EXPECT_EQ(after, controller.Update(now_ms + 10.0, 0));
+
+  // Dropped frames cut it harder, down to the minimum.
+  for (int i = 0; i < 50; ++i) {
+    now_ms += 500.0;
+    controller.OnDrop(1);
+    controller.Update(now_ms, 0);
+  }
+  EXPECT_EQ(100000, controller.bitrate());
+}
+
+TEST(StreamRateControllerTest, QueueDepth) {
+  StreamRateController controller(100000, 1000000, 500000);
+  EXPECT_EQ(500000, controller.Update(0.0, 3));
+  EXPECT_GT(500000, controller.Update(1000.0, 3));
+}
+
+TEST(LatestFrameQueueTest, DropsStaleFramesUntilKeyFrame) {
+  LatestFrameQueue queue(100.0);
+  const double now_ms = TeleopStream::NowMs();
+  LatestFrameQueue::Frame frame;
+
+  // Nothing decodes before the first key frame.
+  frame.enqueue_ms = now_ms;
+  EXPECT_EQ(1, queue.Push(frame));
+  EXPECT_TRUE(queue.WaitingKeyFrame());
+  frame.keyframe = true;
+  EXPECT_EQ(0, queue.Push(frame));
+  EXPECT_FALSE(queue.WaitingKeyFrame());
+  frame.keyframe = false;
+  frame.enqueue_ms = now_ms + 50.0;
+  EXPECT_EQ(0, queue.Push(frame));
+  EXPECT_EQ(2u, queue.size());
+
+  // A frame arriving past the budget of the oldest one flushes the queue,
+  // and itself, as it depends on them.
+  frame.enqueue_ms = now_ms + 150.0;
+  EXPECT_EQ(3, queue.Push(frame));
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_TRUE(queue.WaitingKeyFrame());
+
+  frame.keyframe = true;
+  frame.data = "key";
+  frame.enqueue_ms = TeleopStream::NowMs();
+  EXPECT_EQ(0, queue.Push(frame));
+  LatestFrameQueue::Frame popped;
+  int dropped = 0;
+  EXPECT_TRUE(queue.Pop(10, &popped, &dropped));
+  EXPECT_EQ(0, dropped);
+  EXPECT_EQ("key", popped.data);
+  EXPECT_FALSE(queue.Pop(10, &popped, &dropped));
+
+  // Frames which waited too long in the queue are flushed on pop.
+  frame.enqueue_ms = TeleopStream::NowMs() - 200.0;
+  EXPECT_EQ(0, queue.Push(frame));
+  EXPECT_FALSE(queue.Pop(10, &popped, &dropped));
+  EXPECT_EQ(1, dropped);
+  EXPECT_TRUE(queue.WaitingKeyFrame());
+
+  queue.Shutdown();
+  EXPECT_FALSE(queue.Pop(1000, &popped, &dropped));
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -20,6 +20,8 @@
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
+#include "modules/drivers/camera/jpeg_codec.h"
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 
@@ -41,6 +43,8 @@ class CompressComponent : public Component<Image> {
  private:
   std::shared_ptr<CCObjectPool<CompressedImage>> image_pool_;
   std::shared_ptr<Writer<CompressedImage>> writer_ = nullptr;
+  std::unique_ptr<camera::JpegEncoder> encoder_ = nullptr;
+  std::unique_ptr<common::LatencyRecorder> latency_recorder_ = nullptr;
   Config config_;
 };
 
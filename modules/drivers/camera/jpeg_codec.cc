@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/camera/jpeg_codec.h"
+
+#include <exception>
+#include <utility>
+
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgcodecs/imgcodecs.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "cyber/common/log.h"
+#include "modules/drivers/camera/vaapi_jpeg_codec.h"
+#if USE_GPU == 1
+#include "modules/drivers/camera/nvjpeg_codec.h"
+#endif
+
+DEFINE_string(camera_jpeg_backend, "opencv",
+              "Jpeg codec of the camera compression and decompression: "
+              "opencv, vaapi or nvjpeg.");
+DEFINE_int32(camera_jpeg_quality, 95, "Jpeg quality of the compression.");
+DEFINE_string(camera_vaapi_device, "/dev/dri/renderD128",
+              "DRM render node of the vaapi jpeg codec.");
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+std::unique_ptr<JpegEncoder> CreateJpegEncoder(const std::string& backend) {
+  if (backend == "vaapi") {
+    std::unique_ptr<VaapiJpegEncoder> encoder(new VaapiJpegEncoder());
+    if (encoder->Init()) {
+      return std::move(encoder);
+    }
+    AWARN << "vaapi jpeg encoder unavailable, use opencv.";
+#if USE_GPU == 1
+  } else if (backend == "nvjpeg") {
+    std::unique_ptr<NvjpegEncoder> encoder(new NvjpegEncoder());
+    if (encoder->Init()) {
+      return std::move(encoder);
+    }
+    AWARN << "nvjpeg encoder unavailable, use opencv.";
+#endif
+  } else if (backend != "opencv") {
+    AWARN << "unknown jpeg backend " << backend << ", use opencv.";
+  }
+  return std::unique_ptr<JpegEncoder>(new OpenCVJpegEncoder());
+}
+
+std::unique_ptr<JpegDecoder> CreateJpegDecoder(const std::string& backend) {
+  if (backend == "vaapi") {
+    std::unique_ptr<VaapiJpegDecoder> decoder(new VaapiJpegDecoder());
+    if (decoder->Init()) {
+      return std::move(decoder);
+    }
+    AWARN << "vaapi jpeg decoder unavailable, use opencv.";
+#if USE_GPU == 1
+  } else if (backend == "nvjpeg") {
+    std::unique_ptr<NvjpegDecoder> decoder(new NvjpegDecoder());
+    if (decoder->Init()) {
+      return std::move(decoder);
+    }
+    AWARN << "nvjpeg decoder unavailable, use opencv.";
+#endif
+  } else if (backend != "opencv") {
+    AWARN << "unknown jpeg backend " << backend << ", use opencv.";
+  }
+  return std::unique_ptr<JpegDecoder>(new OpenCVJpegDecoder());
+}
+
+bool OpenCVJpegEncoder::Encode(const Image& image, std::string* data) {
+  if (params_.empty()) {
+    params_ = {cv::IMWRITE_JPEG_QUALITY, FLAGS_camera_jpeg_quality};
+  }
+  try {
+    cv::Mat mat_image(image.height(), image.width(), CV_8UC3,
+                      const_cast<char*>(image.data().data()), image.step());
+    cv::Mat tmp_mat;
+    cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
+    if (!cv::imencode(".jpg", tmp_mat, buffer_, params_)) {
+      AERROR << "cv::imencode (jpeg) failed on input image";
+      return false;
+    }
+  } catch (std::exception& e) {
+    AERROR << "cv::imencode (jpeg) exception :" << e.what();
+    return false;
+  }
+  data->assign(reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
+  return true;
+}
+
+bool OpenCVJpegDecoder::Decode(const std::string& data, Image* image) {
+  cv::Mat raw_data(1, static_cast<int>(data.size()), CV_8UC1,
+                   const_cast<char*>(data.data()));
+  cv::Mat mat_image = cv::imdecode(raw_data, cv::IMREAD_COLOR);
+  if (mat_image.empty()) {
+    AERROR << "cv::imdecode (jpeg) failed";
+    return false;
+  }
+  cv::cvtColor(mat_image, mat_image, cv::COLOR_BGR2RGB);
+  image->set_width(mat_image.cols);
+  image->set_height(mat_image.rows);
+  image->set_encoding("rgb8");
+  image->set_step(3 * image->width());
+  image->set_data(mat_image.data, mat_image.step * mat_image.rows);
+  return true;
+}
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
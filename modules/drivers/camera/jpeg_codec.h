@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "modules/drivers/proto/sensor_image.pb.h"
+
+DECLARE_string(camera_jpeg_backend);
+DECLARE_int32(camera_jpeg_quality);
+DECLARE_string(camera_vaapi_device);
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @brief encodes rgb8 images to jpeg, the buffers of an encoder are reused
+ *   from frame to frame so one encoder serves one channel.
+ */
+class JpegEncoder {
+ public:
+  virtual ~JpegEncoder() = default;
+  virtual bool Encode(const Image& image, std::string* data) = 0;
+};
+
+/**
+ * @brief decodes jpeg data to an rgb8 image.
+ */
+class JpegDecoder {
+ public:
+  virtual ~JpegDecoder() = default;
+  virtual bool Decode(const std::string& data, Image* image) = 0;
+};
+
+/**
+ * @brief backends are "opencv", "vaapi" and, when built with gpu, "nvjpeg".
+ *   a backend that can not be initialized falls back to opencv.
+ */
+std::unique_ptr<JpegEncoder> CreateJpegEncoder(const std::string& backend);
+std::unique_ptr<JpegDecoder> CreateJpegDecoder(const std::string& backend);
+
+class OpenCVJpegEncoder : public JpegEncoder {
+ public:
+  bool Encode(const Image& image, std::string* data) override;
+
+ private:
+  std::vector<int> params_;
+  std::vector<uint8_t> buffer_;
+};
+
+class OpenCVJpegDecoder : public JpegDecoder {
+ public:
+  bool Decode(const std::string& data, Image* image) override;
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/camera/nvjpeg_codec.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+namespace {
+
+bool ReserveDevice(size_t size, unsigned char** buffer, size_t* buffer_size) {
+  if (size <= *buffer_size) {
+    return true;
+  }
+  cudaFree(*buffer);
+  *buffer = nullptr;
+  *buffer_size = 0;
+  if (cudaMalloc(reinterpret_cast<void**>(buffer), size) != cudaSuccess) {
+    AERROR << "cudaMalloc " << size << " bytes failed";
+    return false;
+  }
+  *buffer_size = size;
+  return true;
+}
+
+}  // namespace
+
+NvjpegEncoder::~NvjpegEncoder() {
+  if (params_ != nullptr) {
+    nvjpegEncoderParamsDestroy(params_);
+  }
+  if (state_ != nullptr) {
+    nvjpegEncoderStateDestroy(state_);
+  }
+  if (handle_ != nullptr) {
+    nvjpegDestroy(handle_);
+  }
+  cudaFree(device_image_);
+  if (stream_ != nullptr) {
+    cudaStreamDestroy(stream_);
+  }
+}
+
+bool NvjpegEncoder::Init() {
+  if (cudaStreamCreate(&stream_) != cudaSuccess) {
+    AERROR << "cudaStreamCreate failed";
+    return false;
+  }
+  if (nvjpegCreateSimple(&handle_) != NVJPEG_STATUS_SUCCESS ||
+      nvjpegEncoderStateCreate(handle_, &state_, stream_) !=
+          NVJPEG_STATUS_SUCCESS ||
+      nvjpegEncoderParamsCreate(handle_, &params_, stream_) !=
+          NVJPEG_STATUS_SUCCESS ||
+      nvjpegEncoderParamsSetQuality(params_, FLAGS_camera_jpeg_quality,
+                                    stream_) != NVJPEG_STATUS_SUCCESS ||
+      nvjpegEncoderParamsSetSamplingFactors(params_, NVJPEG_CSS_420,
+                                            stream_) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "init nvjpeg encoder failed";
+    return false;
+  }
+  return true;
+}
+
+bool NvjpegEncoder::Encode(const Image& image, std::string* data) {
+  const size_t size = image.step() * image.height();
+  if (!ReserveDevice(size, &device_image_, &device_image_size_)) {
+    return false;
+  }
+  cudaMemcpyAsync(device_image_, image.data().data(), size,
+                  cudaMemcpyHostToDevice, stream_);
+  nvjpegImage_t source = {};
+  source.channel[0] = device_image_;
+  source.pitch[0] = image.step();
+  if (nvjpegEncodeImage(handle_, state_, params_, &source, NVJPEG_INPUT_RGBI,
+                        image.width(), image.height(),
+                        stream_) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "nvjpeg encode failed";
+    return false;
+  }
+  size_t length = 0;
+  nvjpegEncodeRetrieveBitstream(handle_, state_, nullptr, &length, stream_);
+  cudaStreamSynchronize(stream_);
+  data->resize(length);
+  if (nvjpegEncodeRetrieveBitstream(
+          handle_, state_, reinterpret_cast<unsigned char*>(&(*data)[0]),
+          &length, stream_) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "nvjpeg retrieve bitstream failed";
+    return false;
+  }
+  return cudaStreamSynchronize(stream_) == cudaSuccess;
+}
+
+NvjpegDecoder::~NvjpegDecoder() {
+  if (state_ != nullptr) {
+    nvjpegJpegStateDestroy(state_);
+  }
+  if (handle_ != nullptr) {
+    nvjpegDestroy(handle_);
+  }
+  cudaFree(device_image_);
+  if (stream_ != nullptr) {
+    cudaStreamDestroy(stream_);
+  }
+}
+
+bool NvjpegDecoder::Init() {
+  if (cudaStreamCreate(&stream_) != cudaSuccess) {
+    AERROR << "cudaStreamCreate failed";
+    return false;
+  }
+  if (nvjpegCreateSimple(&handle_) != NVJPEG_STATUS_SUCCESS ||
+      nvjpegJpegStateCreate(handle_, &state_) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "init nvjpeg decoder failed";
+    return false;
+  }
+  return true;
+}
+
+bool NvjpegDecoder::Decode(const std::string& data, Image* image) {
+  const auto* jpeg = reinterpret_cast<const unsigned char*>(data.data());
+  int components = 0;
+  nvjpegChromaSubsampling_t subsampling;
+  int widths[NVJPEG_MAX_COMPONENT];
+  int heights[NVJPEG_MAX_COMPONENT];
+  if (nvjpegGetImageInfo(handle_, jpeg, data.size(), &components,
+                         &subsampling, widths,
+                         heights) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "nvjpeg get image info failed";
+    return false;
+  }
+  const int width = widths[0];
+  const int height = heights[0];
+  const size_t size = 3 * width * height;
+  if (!ReserveDevice(size, &device_image_, &device_image_size_)) {
+    return false;
+  }
+  nvjpegImage_t output = {};
+  output.channel[0] = device_image_;
+  output.pitch[0] = 3 * width;
+  if (nvjpegDecode(handle_, state_, jpeg, data.size(), NVJPEG_OUTPUT_RGBI,
+                   &output, stream_) != NVJPEG_STATUS_SUCCESS) {
+    AERROR << "nvjpeg decode failed";
+    return false;
+  }
+  image->set_width(width);
+  image->set_height(height);
+  image->set_encoding("rgb8");
+  image->set_step(3 * width);
+  std::string* rgb = image->mutable_data();
+  rgb->resize(size);
+  cudaMemcpyAsync(&(*rgb)[0], device_image_, size, cudaMemcpyDeviceToHost,
+                  stream_);
+  return cudaStreamSynchronize(stream_) == cudaSuccess;
+}
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include "cuda_runtime_api.h"
+#include "nvjpeg.h"
+
+#include "modules/drivers/camera/jpeg_codec.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @brief jpeg encoder on nvjpeg, the rgb image is copied to a reused device
+ *   buffer and encoded on the gpu.
+ */
+class NvjpegEncoder : public JpegEncoder {
+ public:
+  ~NvjpegEncoder();
+  bool Init();
+  bool Encode(const Image& image, std::string* data) override;
+
+ private:
+  cudaStream_t stream_ = nullptr;
+  nvjpegHandle_t handle_ = nullptr;
+  nvjpegEncoderState_t state_ = nullptr;
+  nvjpegEncoderParams_t params_ = nullptr;
+  unsigned char* device_image_ = nullptr;
+  size_t device_image_size_ = 0;
+};
+
+/**
+ * @brief jpeg decoder on nvjpeg.
+ */
+class NvjpegDecoder : public JpegDecoder {
+ public:
+  ~NvjpegDecoder();
+  bool Init();
+  bool Decode(const std::string& data, Image* image) override;
+
+ private:
+  cudaStream_t stream_ = nullptr;
+  nvjpegHandle_t handle_ = nullptr;
+  nvjpegJpegState_t state_ = nullptr;
+  unsigned char* device_image_ = nullptr;
+  size_t device_image_size_ = 0;
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/camera/vaapi_jpeg_codec.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+namespace {
+
+bool CreateVaapiDevice(AVBufferRef** hw_device) {
+  if (av_hwdevice_ctx_create(hw_device, AV_HWDEVICE_TYPE_VAAPI,
+                             FLAGS_camera_vaapi_device.c_str(), nullptr,
+                             0) < 0) {
+    AERROR << "open vaapi device failed: " << FLAGS_camera_vaapi_device;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+VaapiJpegEncoder::~VaapiJpegEncoder() {
+  Close();
+  av_buffer_unref(&hw_device_);
+}
+
+bool VaapiJpegEncoder::Init() {
+  codec_ = avcodec_find_encoder_by_name("mjpeg_vaapi");
+  if (codec_ == nullptr) {
+    AERROR << "ffmpeg is built without the mjpeg_vaapi encoder";
+    return false;
+  }
+  return CreateVaapiDevice(&hw_device_);
+}
+
+bool VaapiJpegEncoder::Open(int width, int height) {
+  if (context_ != nullptr && context_->width == width &&
+      context_->height == height) {
+    return true;
+  }
+  Close();
+  context_ = avcodec_alloc_context3(codec_);
+  if (context_ == nullptr) {
+    return false;
+  }
+  context_->width = width;
+  context_->height = height;
+  context_->time_base = AVRational{1, 30};
+  context_->pix_fmt = AV_PIX_FMT_VAAPI;
+  context_->color_range = AVCOL_RANGE_JPEG;
+  // mjpeg_vaapi takes the jpeg quality factor from global_quality
+  context_->global_quality = FLAGS_camera_jpeg_quality;
+
+  AVBufferRef* frames = av_hwframe_ctx_alloc(hw_device_);
+  if (frames == nullptr) {
+    Close();
+    return false;
+  }
+  auto* frames_context = reinterpret_cast<AVHWFramesContext*>(frames->data);
+  frames_context->format = AV_PIX_FMT_VAAPI;
+  frames_context->sw_format = AV_PIX_FMT_NV12;
+  frames_context->width = width;
+  frames_context->height = height;
+  frames_context->initial_pool_size = 4;
+  if (av_hwframe_ctx_init(frames) < 0) {
+    AERROR << "init vaapi frames failed";
+    av_buffer_unref(&frames);
+    Close();
+    return false;
+  }
+  // the context takes over the reference
+  context_->hw_frames_ctx = frames;
+  if (avcodec_open2(context_, codec_, nullptr) < 0) {
+    AERROR << "open mjpeg_vaapi encoder failed";
+    Close();
+    return false;
+  }
+
+  sw_frame_ = av_frame_alloc();
+  hw_frame_ = av_frame_alloc();
+  packet_ = av_packet_alloc();
+  if (sw_frame_ == nullptr || hw_frame_ == nullptr || packet_ == nullptr) {
+    Close();
+    return false;
+  }
+  sw_frame_->format = AV_PIX_FMT_NV12;
+  sw_frame_->width = width;
+  sw_frame_->height = height;
+  if (av_frame_get_buffer(sw_frame_, 0) < 0) {
+    Close();
+    return false;
+  }
+  sws_ = sws_getContext(width, height, AV_PIX_FMT_RGB24, width, height,
+                        AV_PIX_FMT_NV12, SWS_BILINEAR, nullptr, nullptr,
+                        nullptr);
+  if (sws_ == nullptr) {
+    Close();
+    return false;
+  }
+  // jpeg is full range yuv
+  const int* coefficients = sws_getCoefficients(SWS_CS_ITU601);
+  sws_setColorspaceDetails(sws_, coefficients, 0, coefficients, 1, 0, 1 << 16,
+                           1 << 16);
+  return true;
+}
+
+void VaapiJpegEncoder::Close() {
+  sws_freeContext(sws_);
+  sws_ = nullptr;
+  av_frame_free(&sw_frame_);
+  av_frame_free(&hw_frame_);
+  av_packet_free(&packet_);
+  avcodec_free_context(&context_);
+}
+
+bool VaapiJpegEncoder::Encode(const Image& image, std::string* data) {
+  const int width = static_cast<int>(image.width());
+  const int height = static_cast<int>(image.height());
+  if (!Open(width, height)) {
+    AERROR << "open vaapi jpeg encoder for " << width << "x" << height
+           << " failed";
+    return false;
+  }
+  const uint8_t* src[1] = {
+      reinterpret_cast<const uint8_t*>(image.data().data())};
+  const int src_stride[1] = {static_cast<int>(image.step())};
+  sws_scale(sws_, src, src_stride, 0, height, sw_frame_->data,
+            sw_frame_->linesize);
+
+  if (av_hwframe_get_buffer(context_->hw_frames_ctx, hw_frame_, 0) < 0 ||
+      av_hwframe_transfer_data(hw_frame_, sw_frame_, 0) < 0) {
+    AERROR << "upload frame to vaapi failed";
+    av_frame_unref(hw_frame_);
+    return false;
+  }
+  int ret = avcodec_send_frame(context_, hw_frame_);
+  av_frame_unref(hw_frame_);
+  if (ret < 0 || avcodec_receive_packet(context_, packet_) < 0) {
+    AERROR << "mjpeg_vaapi encode failed";
+    return false;
+  }
+  data->assign(reinterpret_cast<const char*>(packet_->data), packet_->size);
+  av_packet_unref(packet_);
+  return true;
+}
+
+VaapiJpegDecoder::~VaapiJpegDecoder() {
+  sws_freeContext(sws_);
+  av_frame_free(&hw_frame_);
+  av_frame_free(&sw_frame_);
+  av_packet_free(&packet_);
+  avcodec_free_context(&context_);
+  av_buffer_unref(&hw_device_);
+}
+
+bool VaapiJpegDecoder::Init() {
+  const AVCodec* codec = avcodec_find_decoder(AV_CODEC_ID_MJPEG);
+  if (codec == nullptr) {
+    AERROR << "ffmpeg is built without the mjpeg decoder";
+    return false;
+  }
+  if (!CreateVaapiDevice(&hw_device_)) {
+    return false;
+  }
+  context_ = avcodec_alloc_context3(codec);
+  if (context_ == nullptr) {
+    return false;
+  }
+  context_->hw_device_ctx = av_buffer_ref(hw_device_);
+  context_->get_format = &VaapiJpegDecoder::GetFormat;
+  if (avcodec_open2(context_, codec, nullptr) < 0) {
+    AERROR << "open mjpeg decoder failed";
+    return false;
+  }
+  hw_frame_ = av_frame_alloc();
+  sw_frame_ = av_frame_alloc();
+  packet_ = av_packet_alloc();
+  return hw_frame_ != nullptr && sw_frame_ != nullptr && packet_ != nullptr;
+}
+
+AVPixelFormat VaapiJpegDecoder::GetFormat(AVCodecContext* context,
+                                          const AVPixelFormat* formats) {
+  for (const AVPixelFormat* format = formats; *format != AV_PIX_FMT_NONE;
+       ++format) {
+    if (*format == AV_PIX_FMT_VAAPI) {
+      return *format;
+    }
+  }
+  // the hardware does not take this stream, decode it in software
+  return formats[0];
+}
+
+bool VaapiJpegDecoder::Decode(const std::string& data, Image* image) {
+  packet_->data = reinterpret_cast<uint8_t*>(const_cast<char*>(data.data()));
+  packet_->size = static_cast<int>(data.size());
+  int ret = avcodec_send_packet(context_, packet_);
+  packet_->data = nullptr;
+  packet_->size = 0;
+  if (ret < 0 || avcodec_receive_frame(context_, hw_frame_) < 0) {
+    AERROR << "mjpeg decode failed";
+    return false;
+  }
+  AVFrame* frame = hw_frame_;
+  if (hw_frame_->format == AV_PIX_FMT_VAAPI) {
+    if (av_hwframe_transfer_data(sw_frame_, hw_frame_, 0) < 0) {
+      AERROR << "download frame from vaapi failed";
+      av_frame_unref(hw_frame_);
+      return false;
+    }
+    frame = sw_frame_;
+  }
+
+  const int width = frame->width;
+  const int height = frame->height;
+  sws_ = sws_getCachedContext(
+      sws_, width, height, static_cast<AVPixelFormat>(frame->format), width,
+      height, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+  if (sws_ == nullptr) {
+    av_frame_unref(sw_frame_);
+    av_frame_unref(hw_frame_);
+    return false;
+  }
+  image->set_width(width);
+  image->set_height(height);
+  image->set_encoding("rgb8");
+  image->set_step(3 * width);
+  std::string* rgb = image->mutable_data();
+  rgb->resize(3 * width * height);
+  uint8_t* dst[1] = {reinterpret_cast<uint8_t*>(&(*rgb)[0])};
+  const int dst_stride[1] = {3 * width};
+  sws_scale(sws_, frame->data, frame->linesize, 0, height, dst, dst_stride);
+  av_frame_unref(sw_frame_);
+  av_frame_unref(hw_frame_);
+  return true;
+}
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
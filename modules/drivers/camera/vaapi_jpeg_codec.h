@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/hwcontext.h>
+#include <libswscale/swscale.h>
+}
+
+#include "modules/drivers/camera/jpeg_codec.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @brief jpeg encoder on the ffmpeg mjpeg_vaapi encoder. the rgb image is
+ *   converted to nv12 and uploaded to a vaapi surface, the entropy coding
+ *   runs on the gpu.
+ */
+class VaapiJpegEncoder : public JpegEncoder {
+ public:
+  ~VaapiJpegEncoder();
+  bool Init();
+  bool Encode(const Image& image, std::string* data) override;
+
+ private:
+  bool Open(int width, int height);
+  void Close();
+
+  const AVCodec* codec_ = nullptr;
+  AVBufferRef* hw_device_ = nullptr;
+  AVCodecContext* context_ = nullptr;
+  SwsContext* sws_ = nullptr;
+  AVFrame* sw_frame_ = nullptr;
+  AVFrame* hw_frame_ = nullptr;
+  AVPacket* packet_ = nullptr;
+};
+
+/**
+ * @brief jpeg decoder on the ffmpeg mjpeg decoder with vaapi hwaccel.
+ */
+class VaapiJpegDecoder : public JpegDecoder {
+ public:
+  ~VaapiJpegDecoder();
+  bool Init();
+  bool Decode(const std::string& data, Image* image) override;
+
+ private:
+  static AVPixelFormat GetFormat(AVCodecContext* context,
+                                 const AVPixelFormat* formats);
+
+  AVBufferRef* hw_device_ = nullptr;
+  AVCodecContext* context_ = nullptr;
+  SwsContext* sws_ = nullptr;
+  AVFrame* hw_frame_ = nullptr;
+  AVFrame* sw_frame_ = nullptr;
+  AVPacket* packet_ = nullptr;
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -153,6 +153,27 @@ class CanClient {
   virtual apollo::common::ErrorCode Receive(std::vector<CanFrame> *const frames,
                                             int32_t *const frame_num) = 0;
 
+  /**
+   * @brief Get a file descriptor which turns readable when frames arrive,
+   *        so that several clients can be waited on together.
+   * @return The file descriptor, or -1 if the client can not be polled.
+   */
+  virtual int GetPollFd() const { return -1; }
+
+  /**
+   * @brief Receive the messages already pending without waiting, used after
+   *        GetPollFd() turned readable.
+   * @param frames The messages to receive.
+   * @param frame_num The maximum amount of messages to receive, set to the
+   *        amount received.
+   * @return The status of the receiving action which is defined by
+   *         apollo::common::ErrorCode.
+   */
+  virtual apollo::common::ErrorCode ReceivePending(
+      std::vector<CanFrame> *const frames, int32_t *const frame_num) {
+    return Receive(frames, frame_num);
+  }
+
   /**
    * @brief Get the error string.
    * @param status The status to get the error string.
@@ -22,7 +22,11 @@
 
 #include "modules/drivers/canbus/can_client/socket/socket_can_client_raw.h"
 
+#include <algorithm>
+#include <cerrno>
+
 #include "absl/strings/str_cat.h"
+#include "modules/drivers/canbus/sensor_gflags.h"
 
 namespace apollo {
 namespace drivers {
@@ -195,6 +199,10 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
     return ErrorCode::CAN_CLIENT_ERROR_FRAME_NUM;
   }
 
+  if (FLAGS_can_batched_receive) {
+    return ReceiveBatch(frames, frame_num);
+  }
+
   for (int32_t i = 0; i < *frame_num && i < MAX_CAN_RECV_FRAME_LEN; ++i) {
     CanFrame cf;
     auto ret = read(dev_handler_, &recv_frames_[i], sizeof(recv_frames_[i]));
@@ -219,6 +227,55 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
   return ErrorCode::OK;
 }
 
+ErrorCode SocketCanClientRaw::ReceiveBatch(std::vector<CanFrame> *const frames,
+                                           int32_t *const frame_num,
+                                           bool wait) {
+  if (!is_started_) {
+    AERROR << "Nvidia can client is not init! Please init first!";
+    return ErrorCode::CAN_CLIENT_ERROR_RECV_FAILED;
+  }
+  const int32_t max_frame_num = std::min(*frame_num, MAX_CAN_RECV_FRAME_LEN);
+  struct mmsghdr msgs[MAX_CAN_RECV_FRAME_LEN];
+  struct iovec iovecs[MAX_CAN_RECV_FRAME_LEN];
+  std::memset(msgs, 0, sizeof(msgs));
+  for (int32_t i = 0; i < max_frame_num; ++i) {
+    iovecs[i].iov_base = &recv_frames_[i];
+    iovecs[i].iov_len = sizeof(recv_frames_[i]);
+    msgs[i].msg_hdr.msg_iov = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // block until the first frame unless told not to, then take whatever else
+  // is pending
+  const int ret = recvmmsg(dev_handler_, msgs, max_frame_num,
+                           wait ? MSG_WAITFORONE : MSG_DONTWAIT, nullptr);
+  if (ret < 0) {
+    if (!wait && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      *frame_num = 0;
+      return ErrorCode::OK;
+    }
+    AERROR << "receive message failed, error code: " << ret;
+    return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  }
+
+  for (int i = 0; i < ret; ++i) {
+    if (recv_frames_[i].can_dlc > CANBUS_MESSAGE_LENGTH) {
+      AERROR << "recv_frames_[" << i
+             << "].can_dlc = " << recv_frames_[i].can_dlc
+             << ", which is not equal to can message data length ("
+             << CANBUS_MESSAGE_LENGTH << ").";
+      return ErrorCode::CAN_CLIENT_ERROR_RECV_FAILED;
+    }
+    CanFrame cf;
+    cf.id = recv_frames_[i].can_id;
+    cf.len = recv_frames_[i].can_dlc;
+    std::memcpy(cf.data, recv_frames_[i].data, recv_frames_[i].can_dlc);
+    frames->push_back(cf);
+  }
+  *frame_num = ret;
+  return ErrorCode::OK;
+}
+
 std::string SocketCanClientRaw::GetErrorString(const int32_t /*status*/) {
   return "";
 }
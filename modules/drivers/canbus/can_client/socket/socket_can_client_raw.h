@@ -103,6 +103,38 @@ class SocketCanClientRaw : public CanClient {
   apollo::common::ErrorCode Receive(std::vector<CanFrame> *const frames,
                                     int32_t *const frame_num) override;
 
+  /**
+   * @brief Receive all the pending messages in one call, waiting for the
+   *        first one only.
+   * @param frames The messages to receive.
+   * @param frame_num The maximum amount of messages to receive, set to the
+   *        amount received.
+   * @return The status of the receiving action which is defined by
+   *         apollo::common::ErrorCode.
+   */
+  apollo::common::ErrorCode ReceiveBatch(std::vector<CanFrame> *const frames,
+                                         int32_t *const frame_num,
+                                         bool wait = true);
+
+  /**
+   * @brief Get the socket, readable when frames arrive.
+   * @return The socket, or -1 if the client is not started.
+   */
+  int GetPollFd() const override { return is_started_ ? dev_handler_ : -1; }
+
+  /**
+   * @brief Receive the pending messages without waiting.
+   * @param frames The messages to receive.
+   * @param frame_num The maximum amount of messages to receive, set to the
+   *        amount received.
+   * @return The status of the receiving action which is defined by
+   *         apollo::common::ErrorCode.
+   */
+  apollo::common::ErrorCode ReceivePending(
+      std::vector<CanFrame> *const frames, int32_t *const frame_num) override {
+    return ReceiveBatch(frames, frame_num, false);
+  }
+
   /**
    * @brief Get the error string.
    * @param status The status to get the error string.
@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/canbus/can_comm/can_ingestion_service.h"
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "cyber/common/log.h"
+
+#include "modules/drivers/canbus/common/canbus_consts.h"
+
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+namespace {
+
+constexpr int kMaxEvents = 16;
+constexpr int kWaitTimeoutMs = 100;
+
+}  // namespace
+
+CanIngestionService::CanIngestionService() {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    AERROR << "epoll_create1 failed: " << strerror(errno);
+  }
+}
+
+CanIngestionService::~CanIngestionService() {
+  Shutdown();
+  if (epoll_fd_ >= 0) {
+    close(epoll_fd_);
+  }
+}
+
+bool CanIngestionService::Register(CanClient *can_client,
+                                   const FramesCallback &callback) {
+  const int fd = can_client == nullptr ? -1 : can_client->GetPollFd();
+  if (fd < 0 || epoll_fd_ < 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (channels_.find(fd) != channels_.end()) {
+    AERROR << "Can client is already registered.";
+    return false;
+  }
+  std::unique_ptr<Channel> channel(new Channel);
+  channel->can_client = can_client;
+  channel->callback = callback;
+  channel->frames.reserve(MAX_CAN_RECV_FRAME_LEN);
+
+  epoll_event event;
+  event.events = EPOLLIN;
+  event.data.fd = fd;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+    AERROR << "epoll_ctl add failed: " << strerror(errno);
+    return false;
+  }
+  channels_[fd] = std::move(channel);
+  if (!running_.exchange(true)) {
+    thread_ = std::thread(&CanIngestionService::Run, this);
+  }
+  AINFO << "Can client with fd " << fd << " is received on the shared thread.";
+  return true;
+}
+
+void CanIngestionService::Unregister(CanClient *can_client) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = channels_.begin(); it != channels_.end(); ++it) {
+    if (it->second->can_client == can_client) {
+      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->first, nullptr);
+      channels_.erase(it);
+      return;
+    }
+  }
+}
+
+void CanIngestionService::Shutdown() {
+  if (running_.exchange(false) && thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void CanIngestionService::Run() {
+  AINFO << "Shared can ingestion thread starts.";
+  epoll_event events[kMaxEvents];
+  while (running_.load()) {
+    const int num = epoll_wait(epoll_fd_, events, kMaxEvents, kWaitTimeoutMs);
+    if (num < 0) {
+      if (errno != EINTR) {
+        AERROR << "epoll_wait failed: " << strerror(errno);
+      }
+      continue;
+    }
+    for (int i = 0; i < num; ++i) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = channels_.find(events[i].data.fd);
+      if (it == channels_.end()) {
+        // unregistered since epoll_wait returned
+        continue;
+      }
+      Channel *channel = it->second.get();
+      channel->frames.clear();
+      int32_t frame_num = MAX_CAN_RECV_FRAME_LEN;
+      if (channel->can_client->ReceivePending(&channel->frames, &frame_num) !=
+          common::ErrorCode::OK) {
+        AERROR_EVERY(100) << "Failed to receive on fd " << it->first;
+        continue;
+      }
+      if (!channel->frames.empty()) {
+        channel->callback(channel->frames);
+      }
+    }
+  }
+  AINFO << "Shared can ingestion thread stopped.";
+}
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the CanIngestionService class.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+
+#include "modules/drivers/canbus/can_client/can_client.h"
+
+/**
+ * @namespace apollo::drivers::canbus
+ * @brief apollo::drivers::canbus
+ */
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+/**
+ * @class CanIngestionService
+ * @brief Receives the frames of several CAN clients on one epoll thread, so
+ *        a process with many CAN devices does not need a thread per device.
+ */
+class CanIngestionService {
+ public:
+  using FramesCallback = std::function<void(const std::vector<CanFrame> &)>;
+
+  ~CanIngestionService();
+
+  /**
+   * @brief Start receiving the frames of a CAN client on the shared thread.
+   * @param can_client The started CAN client, it must have a poll fd.
+   * @param callback Called on the shared thread with each batch of frames.
+   * @return If the client is registered.
+   */
+  bool Register(CanClient *can_client, const FramesCallback &callback);
+
+  /**
+   * @brief Stop receiving the frames of a CAN client. The callback is not
+   *        running anymore when this returns.
+   * @param can_client The CAN client registered before.
+   */
+  void Unregister(CanClient *can_client);
+
+  /**
+   * @brief Stop the shared thread.
+   */
+  void Shutdown();
+
+ private:
+  struct Channel {
+    CanClient *can_client = nullptr;
+    FramesCallback callback;
+    std::vector<CanFrame> frames;
+  };
+
+  void Run();
+
+  int epoll_fd_ = -1;
+  std::atomic<bool> running_ = {false};
+  std::thread thread_;
+  // Guards channels_ and is held while a callback runs.
+  std::mutex mutex_;
+  std::unordered_map<int, std::unique_ptr<Channel>> channels_;
+
+  DECLARE_SINGLETON(CanIngestionService)
+};
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
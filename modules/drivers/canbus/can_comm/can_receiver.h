@@ -36,8 +36,10 @@
 #include "modules/common/proto/error_code.pb.h"
 
 #include "modules/drivers/canbus/can_client/can_client.h"
+#include "modules/drivers/canbus/can_comm/can_ingestion_service.h"
 #include "modules/drivers/canbus/can_comm/message_manager.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/sensor_gflags.h"
 
 /**
  * @namespace apollo::drivers::canbus
@@ -97,6 +99,8 @@ class CanReceiver {
  private:
   void RecvThreadFunc();
 
+  void ParseFrames(const std::vector<CanFrame> &frames);
+
   int32_t Start(bool is_blocked);
 
  private:
@@ -106,6 +110,8 @@ class CanReceiver {
   MessageManager<SensorType> *pt_manager_ = nullptr;
   bool enable_log_ = false;
   bool is_init_ = false;
+  // received on the shared CanIngestionService thread instead of our own
+  bool shared_ = false;
   std::future<void> async_result_;
 
   DISALLOW_COPY_AND_ASSIGN(CanReceiver);
@@ -169,20 +175,25 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
     }
     receive_none_count = 0;
 
-    for (const auto &frame : buf) {
-      uint8_t len = frame.len;
-      uint32_t uid = frame.id;
-      const uint8_t *data = frame.data;
-      pt_manager_->Parse(uid, data, len);
-      if (enable_log_) {
-        ADEBUG << "recv_can_frame#" << frame.CanFrameString();
-      }
-    }
+    ParseFrames(buf);
     cyber::Yield();
   }
   AINFO << "Can client receiver thread stopped.";
 }
 
+template <typename SensorType>
+void CanReceiver<SensorType>::ParseFrames(const std::vector<CanFrame> &frames) {
+  for (const auto &frame : frames) {
+    uint8_t len = frame.len;
+    uint32_t uid = frame.id;
+    const uint8_t *data = frame.data;
+    pt_manager_->Parse(uid, data, len);
+    if (enable_log_) {
+      ADEBUG << "recv_can_frame#" << frame.CanFrameString();
+    }
+  }
+}
+
 template <typename SensorType>
 bool CanReceiver<SensorType>::IsRunning() const {
   return is_running_.load();
@@ -195,6 +206,16 @@ template <typename SensorType>
   }
   is_running_.exchange(true);
 
+  if (FLAGS_can_shared_ingestion && can_client_->GetPollFd() >= 0) {
+    shared_ = CanIngestionService::Instance()->Register(
+        can_client_, [this](const std::vector<CanFrame> &frames) {
+          ParseFrames(frames);
+        });
+    if (shared_) {
+      return ::apollo::common::ErrorCode::OK;
+    }
+    AWARN << "Fall back to a dedicated can client receiver thread.";
+  }
   async_result_ = cyber::Async(&CanReceiver<SensorType>::RecvThreadFunc, this);
   return ::apollo::common::ErrorCode::OK;
 }
@@ -204,7 +225,12 @@ void CanReceiver<SensorType>::Stop() {
   if (IsRunning()) {
     AINFO << "Stopping can client receiver ...";
     is_running_.exchange(false);
-    async_result_.wait();
+    if (shared_) {
+      CanIngestionService::Instance()->Unregister(can_client_);
+      shared_ = false;
+    } else {
+      async_result_.wait();
+    }
   } else {
     AINFO << "Can client receiver is not running.";
   }
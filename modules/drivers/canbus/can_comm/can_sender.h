@@ -21,8 +21,17 @@
 
 #pragma once
 
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -38,6 +47,7 @@
 #include "modules/common/proto/error_code.pb.h"
 #include "modules/drivers/canbus/can_client/can_client.h"
 #include "modules/drivers/canbus/can_comm/protocol_data.h"
+#include "modules/drivers/canbus/sensor_gflags.h"
 
 /**
  * @namespace apollo::drivers::canbus
@@ -111,6 +121,12 @@ class SenderMessage {
    */
   int32_t curr_period() const;
 
+  /**
+   * @brief Get the period to send messages from protocol data.
+   * @return The period.
+   */
+  int32_t period() const;
+
  private:
   uint32_t message_id_ = 0;
   ProtocolData<SensorType> *protocol_data_ = nullptr;
@@ -167,7 +183,9 @@ class CanSender {
   apollo::common::ErrorCode Start();
 
   /*
-   * @brief Update the protocol data based the types.
+   * @brief Update the protocol data based the types. With
+   *        FLAGS_can_event_driven_sender the updated frames are sent right
+   *        away instead of at their next period.
    */
   void Update();
 
@@ -184,10 +202,19 @@ class CanSender {
   bool IsRunning() const;
   bool enable_log() const;
 
+  /**
+   * @brief Get the latency from the last Update to its frames being sent,
+   *        measured with FLAGS_can_event_driven_sender.
+   * @return The latency in us, or -1 if no update was sent yet.
+   */
+  int64_t last_send_latency_us() const;
+
   FRIEND_TEST(CanSenderTest, OneRunCase);
 
  private:
   void PowerSendThreadFunc();
+  void EventSendThreadFunc();
+  void SendMessage(SenderMessage<SensorType> *message);
 
   bool NeedSend(const SenderMessage<SensorType> &msg,
                 const int32_t delta_period);
@@ -199,6 +226,11 @@ class CanSender {
   std::unique_ptr<std::thread> thread_;
   bool enable_log_ = false;
 
+  // wakes up the event driven sender thread on update and stop
+  int event_fd_ = -1;
+  std::atomic<int64_t> update_time_us_ = {0};
+  std::atomic<int64_t> last_send_latency_us_ = {-1};
+
   DISALLOW_COPY_AND_ASSIGN(CanSender);
 };
 
@@ -269,6 +301,24 @@ int32_t SenderMessage<SensorType>::curr_period() const {
   return curr_period_;
 }
 
+template <typename SensorType>
+int32_t SenderMessage<SensorType>::period() const {
+  return period_;
+}
+
+template <typename SensorType>
+void CanSender<SensorType>::SendMessage(SenderMessage<SensorType> *message) {
+  std::vector<CanFrame> can_frames;
+  CanFrame can_frame = message->CanFrame();
+  can_frames.push_back(can_frame);
+  if (can_client_->SendSingleFrame(can_frames) != common::ErrorCode::OK) {
+    AERROR << "Send msg failed:" << can_frame.CanFrameString();
+  }
+  if (enable_log()) {
+    ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
+  }
+}
+
 template <typename SensorType>
 void CanSender<SensorType>::PowerSendThreadFunc() {
   CHECK_NOTNULL(can_client_);
@@ -276,6 +326,11 @@ void CanSender<SensorType>::PowerSendThreadFunc() {
   sch.sched_priority = 99;
   pthread_setschedparam(pthread_self(), SCHED_FIFO, &sch);
 
+  if (FLAGS_can_event_driven_sender) {
+    EventSendThreadFunc();
+    return;
+  }
+
   const int32_t INIT_PERIOD = 5000;  // 5ms
   int32_t delta_period = INIT_PERIOD;
   int32_t new_delta_period = INIT_PERIOD;
@@ -298,15 +353,7 @@ void CanSender<SensorType>::PowerSendThreadFunc() {
       if (!need_send) {
         continue;
       }
-      std::vector<CanFrame> can_frames;
-      CanFrame can_frame = message.CanFrame();
-      can_frames.push_back(can_frame);
-      if (can_client_->SendSingleFrame(can_frames) != common::ErrorCode::OK) {
-        AERROR << "Send msg failed:" << can_frame.CanFrameString();
-      }
-      if (enable_log()) {
-        ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
-      }
+      SendMessage(&message);
     }
     delta_period = new_delta_period;
     tm_end = cyber::Time::Now().ToNanosecond() / 1e3;
@@ -323,6 +370,100 @@ void CanSender<SensorType>::PowerSendThreadFunc() {
   AINFO << "Can client sender thread stopped!";
 }
 
+template <typename SensorType>
+void CanSender<SensorType>::EventSendThreadFunc() {
+  const int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0) {
+    AERROR << "Failed to create epoll for can sender: " << strerror(errno);
+    return;
+  }
+  struct epoll_event event;
+  event.events = EPOLLIN;
+  event.data.fd = event_fd_;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, event_fd_, &event);
+
+  // one timer per send period, firing for all the messages of the period
+  std::map<int32_t, int> period_timers;
+  std::unordered_map<int, std::vector<size_t>> timer_messages;
+  for (size_t i = 0; i < send_messages_.size(); ++i) {
+    const int32_t period = send_messages_[i].period();
+    if (period <= 0) {
+      AWARN << "Message " << std::hex << send_messages_[i].message_id()
+            << " has no period, only send it on update.";
+      continue;
+    }
+    auto iter = period_timers.find(period);
+    if (iter == period_timers.end()) {
+      const int timer_fd =
+          timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+      if (timer_fd < 0) {
+        AERROR << "Failed to create timer for period " << period
+               << "us: " << strerror(errno);
+        continue;
+      }
+      event.data.fd = timer_fd;
+      epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &event);
+      iter = period_timers.emplace(period, timer_fd).first;
+    }
+    timer_messages[iter->second].push_back(i);
+  }
+  auto arm_timers = [&period_timers]() {
+    for (const auto &timer : period_timers) {
+      struct itimerspec spec;
+      spec.it_interval.tv_sec = timer.first / 1000000;
+      spec.it_interval.tv_nsec = (timer.first % 1000000) * 1000;
+      spec.it_value = spec.it_interval;
+      timerfd_settime(timer.second, 0, &spec, nullptr);
+    }
+  };
+  arm_timers();
+
+  AINFO << "Can client event driven sender thread starts with "
+        << period_timers.size() << " period timers.";
+
+  const int kMaxEvents = 16;
+  const int kWaitTimeoutMs = 100;
+  struct epoll_event events[kMaxEvents];
+  while (is_running_) {
+    const int event_num =
+        epoll_wait(epoll_fd, events, kMaxEvents, kWaitTimeoutMs);
+    if (event_num < 0 && errno != EINTR) {
+      AERROR << "Can sender epoll wait failed: " << strerror(errno);
+      break;
+    }
+    for (int i = 0; i < event_num && is_running_; ++i) {
+      uint64_t count = 0;
+      const int fd = events[i].data.fd;
+      if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        continue;
+      }
+      if (fd != event_fd_) {
+        for (const size_t index : timer_messages[fd]) {
+          SendMessage(&send_messages_[index]);
+        }
+        continue;
+      }
+      // send the updated frames now and restart the periods from here
+      for (auto &message : send_messages_) {
+        SendMessage(&message);
+      }
+      arm_timers();
+      const int64_t latency_us =
+          cyber::Time::Now().ToMicrosecond() - update_time_us_.load();
+      last_send_latency_us_.store(latency_us);
+      if (enable_log()) {
+        ADEBUG << "update to can bus latency: " << latency_us << "us";
+      }
+    }
+  }
+
+  for (const auto &timer : period_timers) {
+    close(timer.second);
+  }
+  close(epoll_fd);
+  AINFO << "Can client sender thread stopped!";
+}
+
 template <typename SensorType>
 common::ErrorCode CanSender<SensorType>::Init(CanClient *can_client,
                                               bool enable_log) {
@@ -359,6 +500,13 @@ common::ErrorCode CanSender<SensorType>::Start() {
     AERROR << "Cansender has already started.";
     return common::ErrorCode::CANBUS_ERROR;
   }
+  if (FLAGS_can_event_driven_sender && event_fd_ < 0) {
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0) {
+      AERROR << "Failed to create can sender event: " << strerror(errno);
+      return common::ErrorCode::CANBUS_ERROR;
+    }
+  }
   is_running_ = true;
   thread_.reset(new std::thread([this] { PowerSendThreadFunc(); }));
 
@@ -370,6 +518,13 @@ void CanSender<SensorType>::Update() {
   for (auto &message : send_messages_) {
     message.Update();
   }
+  if (event_fd_ >= 0) {
+    update_time_us_.store(cyber::Time::Now().ToMicrosecond());
+    const uint64_t one = 1;
+    if (write(event_fd_, &one, sizeof(one)) != sizeof(one)) {
+      AERROR << "Failed to wake up can sender: " << strerror(errno);
+    }
+  }
 }
 
 template <typename SensorType>
@@ -377,10 +532,19 @@ void CanSender<SensorType>::Stop() {
   if (is_running_) {
     AINFO << "Stopping can sender ...";
     is_running_ = false;
+    if (event_fd_ >= 0) {
+      const uint64_t one = 1;
+      AERROR_IF(write(event_fd_, &one, sizeof(one)) != sizeof(one))
+          << "Failed to wake up can sender: " << strerror(errno);
+    }
     if (thread_ != nullptr && thread_->joinable()) {
       thread_->join();
     }
     thread_.reset();
+    if (event_fd_ >= 0) {
+      close(event_fd_);
+      event_fd_ = -1;
+    }
   } else {
     AERROR << "CanSender is not running.";
   }
@@ -398,6 +562,11 @@ bool CanSender<SensorType>::enable_log() const {
   return enable_log_;
 }
 
+template <typename SensorType>
+int64_t CanSender<SensorType>::last_send_latency_us() const {
+  return last_send_latency_us_.load();
+}
+
 template <typename SensorType>
 bool CanSender<SensorType>::NeedSend(const SenderMessage<SensorType> &msg,
                                      const int32_t delta_period) {
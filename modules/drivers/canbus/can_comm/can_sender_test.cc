@@ -51,6 +51,29 @@ TEST(CanSenderTest, OneRunCase) {
   EXPECT_FALSE(sender.IsRunning());
 }
 
+TEST(CanSenderTest, EventDrivenCase) {
+  FLAGS_can_event_driven_sender = true;
+  CanSender<::apollo::canbus::ChassisDetail> sender;
+  can::FakeCanClient can_client;
+  sender.Init(&can_client, true);
+
+  ProtocolData<::apollo::canbus::ChassisDetail> mpd;
+  sender.AddMessage(1, &mpd);
+  EXPECT_EQ(sender.Start(), common::ErrorCode::OK);
+  EXPECT_TRUE(sender.IsRunning());
+  EXPECT_EQ(sender.last_send_latency_us(), -1);
+
+  sender.Update();
+  for (int i = 0; i < 100 && sender.last_send_latency_us() < 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_GE(sender.last_send_latency_us(), 0);
+
+  sender.Stop();
+  EXPECT_FALSE(sender.IsRunning());
+  FLAGS_can_event_driven_sender = false;
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
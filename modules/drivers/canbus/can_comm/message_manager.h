@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include <array>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -121,6 +122,13 @@ class MessageManager {
 
   std::unordered_map<uint32_t, ProtocolData<SensorType> *> protocol_data_map_;
   std::unordered_map<uint32_t, CheckIdArg> check_ids_;
+
+  // flat tables over the standard 11 bit ids, so that parsing a frame needs
+  // no hash lookup; extended ids fall back to the maps above
+  static constexpr uint32_t kStandardIdNum = 0x800;
+  std::array<ProtocolData<SensorType> *, kStandardIdNum>
+      protocol_data_table_ = {};
+  std::array<CheckIdArg *, kStandardIdNum> check_id_table_ = {};
   std::set<uint32_t> received_ids_;
 
   std::mutex sensor_data_mutex_;
@@ -130,6 +138,9 @@ class MessageManager {
   std::condition_variable cvar_;
 };
 
+template <typename SensorType>
+constexpr uint32_t MessageManager<SensorType>::kStandardIdNum;
+
 template <typename SensorType>
 template <class T, bool need_check>
 void MessageManager<SensorType>::AddRecvProtocolData() {
@@ -139,11 +150,17 @@ void MessageManager<SensorType>::AddRecvProtocolData() {
     return;
   }
   protocol_data_map_[T::ID] = dt;
+  if (static_cast<uint32_t>(T::ID) < kStandardIdNum) {
+    protocol_data_table_[T::ID] = dt;
+  }
   if (need_check) {
     check_ids_[T::ID].period = dt->GetPeriod();
     check_ids_[T::ID].real_period = 0;
     check_ids_[T::ID].last_time = 0;
     check_ids_[T::ID].error_count = 0;
+    if (static_cast<uint32_t>(T::ID) < kStandardIdNum) {
+      check_id_table_[T::ID] = &check_ids_[T::ID];
+    }
   }
 }
 
@@ -156,11 +173,17 @@ void MessageManager<SensorType>::AddSendProtocolData() {
     return;
   }
   protocol_data_map_[T::ID] = dt;
+  if (static_cast<uint32_t>(T::ID) < kStandardIdNum) {
+    protocol_data_table_[T::ID] = dt;
+  }
   if (need_check) {
     check_ids_[T::ID].period = dt->GetPeriod();
     check_ids_[T::ID].real_period = 0;
     check_ids_[T::ID].last_time = 0;
     check_ids_[T::ID].error_count = 0;
+    if (static_cast<uint32_t>(T::ID) < kStandardIdNum) {
+      check_id_table_[T::ID] = &check_ids_[T::ID];
+    }
   }
 }
 
@@ -168,6 +191,9 @@ template <typename SensorType>
 ProtocolData<SensorType>
     *MessageManager<SensorType>::GetMutableProtocolDataById(
         const uint32_t message_id) {
+  if (message_id < kStandardIdNum && protocol_data_table_[message_id]) {
+    return protocol_data_table_[message_id];
+  }
   if (protocol_data_map_.find(message_id) == protocol_data_map_.end()) {
     ADEBUG << "Unable to get protocol data because of invalid message_id:"
            << Byte::byte_to_hex(message_id);
@@ -190,19 +216,27 @@ void MessageManager<SensorType>::Parse(const uint32_t message_id,
   }
   received_ids_.insert(message_id);
   // check if need to check period
-  const auto it = check_ids_.find(message_id);
-  if (it != check_ids_.end()) {
+  CheckIdArg *check_id = nullptr;
+  if (message_id < kStandardIdNum) {
+    check_id = check_id_table_[message_id];
+  } else {
+    const auto it = check_ids_.find(message_id);
+    if (it != check_ids_.end()) {
+      check_id = &it->second;
+    }
+  }
+  if (check_id != nullptr) {
     const int64_t time = Time::Now().ToNanosecond() / 1e3;
-    it->second.real_period = time - it->second.last_time;
+    check_id->real_period = time - check_id->last_time;
     // if period 1.5 large than base period, inc error_count
     const double period_multiplier = 1.5;
-    if (static_cast<double>(it->second.real_period) >
-        (static_cast<double>(it->second.period) * period_multiplier)) {
-      it->second.error_count += 1;
+    if (static_cast<double>(check_id->real_period) >
+        (static_cast<double>(check_id->period) * period_multiplier)) {
+      check_id->error_count += 1;
     } else {
-      it->second.error_count = 0;
+      check_id->error_count = 0;
     }
-    it->second.last_time = time;
+    check_id->last_time = time;
   }
 }
 
@@ -36,12 +36,20 @@ class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
   MockProtocolData() {}
 };
 
+class MockExtendedProtocolData
+    : public ProtocolData<::apollo::canbus::ChassisDetail> {
+ public:
+  static const int32_t ID = 0x18FF0001;
+  MockExtendedProtocolData() {}
+};
+
 class MockMessageManager
     : public MessageManager<::apollo::canbus::ChassisDetail> {
  public:
   MockMessageManager() {
     AddRecvProtocolData<MockProtocolData, true>();
     AddSendProtocolData<MockProtocolData, true>();
+    AddRecvProtocolData<MockExtendedProtocolData, true>();
   }
 };
 
@@ -58,6 +66,17 @@ TEST(MessageManagerTest, GetMutableProtocolDataById) {
   EXPECT_EQ(manager.GetSensorData(nullptr), ErrorCode::CANBUS_ERROR);
 }
 
+TEST(MessageManagerTest, StandardAndExtendedIds) {
+  uint8_t mock_data[8] = {0};
+  MockMessageManager manager;
+  manager.Parse(MockExtendedProtocolData::ID, mock_data, 8);
+  EXPECT_NE(manager.GetMutableProtocolDataById(MockProtocolData::ID), nullptr);
+  EXPECT_NE(manager.GetMutableProtocolDataById(MockExtendedProtocolData::ID),
+            nullptr);
+  EXPECT_EQ(manager.GetMutableProtocolDataById(0x112), nullptr);
+  EXPECT_EQ(manager.GetMutableProtocolDataById(0x18FF0002), nullptr);
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
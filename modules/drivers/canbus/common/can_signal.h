@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the CanSignal class template, the compile time layout of a
+ *        signal in a CAN frame.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "modules/drivers/canbus/common/canbus_consts.h"
+
+/**
+ * @namespace apollo::drivers::canbus
+ * @brief apollo::drivers::canbus
+ */
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+/**
+ * @brief The byte order of a signal, as the 'order' of the dbc config.
+ */
+enum class SignalOrder { MOTOROLA, INTEL };
+
+/**
+ * @class CanSignal
+ * @brief The layout of a signal in a CAN frame, with the start bit, length,
+ *        sign and order of the dbc config.
+ *
+ * The frame is read as one 64 bit word and the signal is taken out with a
+ * shift and a mask computed at compile time, so decoding has no branch and
+ * no per byte loop. The same bits are decoded as Byte based parsers do.
+ * The data must be the CANBUS_MESSAGE_LENGTH bytes of a frame.
+ */
+template <int32_t kBit, int32_t kLength, bool kSigned = false,
+          SignalOrder kOrder = SignalOrder::MOTOROLA>
+class CanSignal {
+ public:
+  static_assert(kBit >= 0 && kBit < CANBUS_MESSAGE_LENGTH * 8,
+                "signal start bit out of the frame");
+  static_assert(kLength > 0 && kLength <= 32, "signal length out of range");
+
+  /**
+   * @brief Decode the raw value of the signal.
+   * @param bytes The data of the frame.
+   * @return The raw value, sign extended for signed signals.
+   */
+  static int64_t Raw(const uint8_t *bytes) {
+    const uint64_t word = kOrder == SignalOrder::MOTOROLA
+                              ? LoadBigEndian(bytes)
+                              : LoadLittleEndian(bytes);
+    // the signal bits end up in the top bits, the arithmetic shift back
+    // right sign extends signed signals
+    const uint64_t top = word << kTopShift;
+    return kSigned ? static_cast<int64_t>(top) >> (64 - kLength)
+                   : static_cast<int64_t>(top >> (64 - kLength));
+  }
+
+  /**
+   * @brief Decode the physical value of the signal.
+   * @param bytes The data of the frame.
+   * @param precision The precision of the signal.
+   * @param offset The offset of the signal.
+   * @return The raw value scaled by the precision plus the offset.
+   */
+  static double Physical(const uint8_t *bytes, const double precision,
+                         const double offset) {
+    return static_cast<double>(Raw(bytes)) * precision + offset;
+  }
+
+ private:
+  // The bit position of the least significant bit of the signal in the
+  // loaded word. For motorola the start bit is the most significant bit and
+  // byte 0 is the top byte of the word.
+  static constexpr int32_t kLowBit =
+      kOrder == SignalOrder::MOTOROLA
+          ? (CANBUS_MESSAGE_LENGTH - 1 - kBit / 8) * 8 + kBit % 8 - kLength + 1
+          : kBit;
+  static_assert(kLowBit >= 0 && kLowBit + kLength <= 64,
+                "signal out of the frame");
+  static constexpr int32_t kTopShift = 64 - kLowBit - kLength;
+
+  static uint64_t LoadBigEndian(const uint8_t *bytes) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+  }
+
+  static uint64_t LoadLittleEndian(const uint8_t *bytes) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+  }
+};
+
+template <int32_t kBit, int32_t kLength, bool kSigned, SignalOrder kOrder>
+constexpr int32_t CanSignal<kBit, kLength, kSigned, kOrder>::kLowBit;
+
+template <int32_t kBit, int32_t kLength, bool kSigned, SignalOrder kOrder>
+constexpr int32_t CanSignal<kBit, kLength, kSigned, kOrder>::kTopShift;
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/canbus/common/can_signal.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/drivers/canbus/common/byte.h"
+
+namespace apollo {
+namespace drivers {
+namespace canbus {
+
+TEST(CanSignalTest, MotorolaWholeBytes) {
+  const uint8_t data[8] = {0x04, 0x01, 0x01, 0x14, 0x1E, 0x03, 0x04, 0x05};
+  EXPECT_EQ(0x04, (CanSignal<55, 8>::Raw(data)));
+  EXPECT_EQ(0x00, (CanSignal<1, 2>::Raw(data)));
+  EXPECT_EQ(0x01, (CanSignal<2, 1>::Raw(data)));
+  EXPECT_EQ(0x141E, (CanSignal<31, 16>::Raw(data)));
+  EXPECT_NEAR(15.0, (CanSignal<31, 16>::Physical(data, 0.1, -500.0)), 1e-9);
+}
+
+TEST(CanSignalTest, MotorolaAsByte) {
+  const uint8_t data[8] = {0xA5, 0x3C, 0xF0, 0x96, 0xF0, 0x81, 0x7E, 0xC3};
+  // 'bit': 12, 'len': 10, decoded as generated by gen_vehicle_protocol
+  Byte t0(data + 1);
+  int32_t x = t0.get_byte(0, 5);
+  Byte t1(data + 2);
+  int32_t t = t1.get_byte(3, 5);
+  x <<= 5;
+  x |= t;
+  EXPECT_EQ(x, (CanSignal<12, 10>::Raw(data)));
+
+  // 'bit': 39, 'len': 12, 'is_signed_var': True
+  Byte t2(data + 4);
+  x = t2.get_byte(0, 8);
+  Byte t3(data + 5);
+  t = t3.get_byte(4, 4);
+  x <<= 4;
+  x |= t;
+  x <<= 20;
+  x >>= 20;
+  EXPECT_EQ(x, (CanSignal<39, 12, true>::Raw(data)));
+  EXPECT_EQ(0xF08 - 0x1000, (CanSignal<39, 12, true>::Raw(data)));
+  EXPECT_EQ(0xF08, (CanSignal<39, 12>::Raw(data)));
+}
+
+TEST(CanSignalTest, Intel) {
+  const uint8_t data[8] = {0x34, 0x12, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x01};
+  EXPECT_EQ(0x1234, (CanSignal<0, 16, false, SignalOrder::INTEL>::Raw(data)));
+  EXPECT_EQ(0x23, (CanSignal<4, 8, false, SignalOrder::INTEL>::Raw(data)));
+  EXPECT_EQ(-1, (CanSignal<16, 8, true, SignalOrder::INTEL>::Raw(data)));
+  EXPECT_EQ(0x80FF - 0x10000,
+            (CanSignal<16, 16, true, SignalOrder::INTEL>::Raw(data)));
+  EXPECT_EQ(1, (CanSignal<56, 1, false, SignalOrder::INTEL>::Raw(data)));
+}
+
+}  // namespace canbus
+}  // namespace drivers
+}  // namespace apollo
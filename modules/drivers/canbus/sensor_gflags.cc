@@ -33,3 +33,17 @@ DEFINE_string(sensor_node_name, "", "Sensor node name.");
 // esd can extended frame gflags
 DEFINE_bool(esd_can_extended_frame, false,
             "check esd can exdended frame enabled or not");
+
+// event driven can io gflags
+DEFINE_bool(can_event_driven_sender, false,
+            "Send the can frames from period timers and right after an "
+            "update instead of polling all messages in a sleep loop");
+DEFINE_bool(can_batched_receive, false,
+            "Receive all the pending socket can frames in one batch, "
+            "returning as soon as one frame arrives");
+DEFINE_bool(can_shared_ingestion, false,
+            "Receive the pollable can clients of the process on one shared "
+            "epoll thread instead of one receive thread each");
+DEFINE_bool(radar_publish_on_sweep_end, false,
+            "Publish a radar sweep as soon as its last object or cluster "
+            "frame arrives instead of waiting for the next list status");
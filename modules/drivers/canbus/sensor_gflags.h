@@ -33,3 +33,9 @@ DECLARE_string(sensor_node_name);
 
 // esd Can Extended frame supported or not
 DECLARE_bool(esd_can_extended_frame);
+
+// event driven can io
+DECLARE_bool(can_event_driven_sender);
+DECLARE_bool(can_batched_receive);
+DECLARE_bool(can_shared_ingestion);
+DECLARE_bool(radar_publish_on_sweep_end);
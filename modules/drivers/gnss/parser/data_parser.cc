@@ -24,6 +24,7 @@
 #include "boost/array.hpp"
 #include "cyber/cyber.h"
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
 #include "modules/common/util/message_util.h"
 #include "modules/drivers/gnss/proto/gnss_best_pose.pb.h"
 #include "modules/drivers/gnss/proto/gnss_raw_observation.pb.h"
@@ -33,6 +34,10 @@
 #include "modules/drivers/gnss/parser/parser.h"
 #include "modules/drivers/gnss/util/time_conversion.h"
 
+DEFINE_bool(gnss_record_latency, false,
+            "Whether to record the latency from reading the bytes to "
+            "publishing the parsed gnss messages.");
+
 namespace apollo {
 namespace drivers {
 namespace gnss {
@@ -115,12 +120,18 @@ bool DataParser::Init() {
 }
 
 void DataParser::ParseRawData(const std::string &msg) {
+  ParseRawData(reinterpret_cast<const uint8_t *>(msg.data()), msg.size(),
+               cyber::Time::Now());
+}
+
+void DataParser::ParseRawData(const uint8_t *data, size_t length,
+                              const cyber::Time &receive_time) {
   if (!init_flag_) {
     AERROR << "Data parser not init.";
     return;
   }
 
-  data_parser_->Update(msg);
+  data_parser_->Update(data, length);
   Parser::MessageType type;
   MessagePtr msg_ptr;
 
@@ -130,6 +141,11 @@ void DataParser::ParseRawData(const std::string &msg) {
       break;
     }
     DispatchMessage(type, msg_ptr);
+    if (FLAGS_gnss_record_latency) {
+      static apollo::common::LatencyRecorder latency_recorder("gnss");
+      latency_recorder.AppendLatencyRecord(receive_time.ToNanosecond(),
+                                           receive_time, cyber::Time::Now());
+    }
   }
 }
 
@@ -50,6 +50,10 @@ class DataParser {
   ~DataParser() {}
   bool Init();
   void ParseRawData(const std::string &msg);
+  // Parses the bytes in place, receive_time is when they were read and is
+  // what the latency of the published messages is measured from.
+  void ParseRawData(const uint8_t *data, size_t length,
+                    const apollo::cyber::Time &receive_time);
 
  private:
   void DispatchMessage(Parser::MessageType type, MessagePtr message);
@@ -18,7 +18,10 @@
 // messages must be
 // logged in order for this parser to work properly.
 //
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -76,16 +79,60 @@ inline uint32_t crc32_word(uint32_t word) {
   return word;
 }
 
+// crc32_word of every byte value, so a block takes one lookup per byte.
+const std::array<uint32_t, 256>& crc32_table() {
+  static const std::array<uint32_t, 256> table = []() {
+    std::array<uint32_t, 256> words;
+    for (uint32_t i = 0; i < words.size(); ++i) {
+      words[i] = crc32_word(i);
+    }
+    return words;
+  }();
+  return table;
+}
+
 inline uint32_t crc32_block(const uint8_t* buffer, size_t length) {
+  const auto& table = crc32_table();
   uint32_t word = 0;
   while (length--) {
-    uint32_t t1 = (word >> 8) & 0xFFFFFF;
-    uint32_t t2 = crc32_word((word ^ *buffer++) & 0xFF);
-    word = t1 ^ t2;
+    word = (word >> 8) ^ table[(word ^ *buffer++) & 0xFF];
   }
   return word;
 }
 
+constexpr size_t SYNC_LENGTH = 3;
+
+constexpr size_t INVALID_FRAME = std::numeric_limits<size_t>::max();
+
+// Returns the total length of the frame starting with SYNC_0 at frame, 0 if
+// more bytes are needed to tell, or INVALID_FRAME if it is not a frame.
+size_t get_frame_length(const uint8_t* frame, size_t size) {
+  if (size > 1 && frame[1] != novatel::SYNC_1) {
+    return INVALID_FRAME;
+  }
+  if (size < SYNC_LENGTH) {
+    return 0;
+  }
+  switch (frame[2]) {
+    case novatel::SYNC_2_LONG_HEADER:
+      if (size < sizeof(novatel::LongHeader)) {
+        return 0;
+      }
+      return sizeof(novatel::LongHeader) + novatel::CRC_LENGTH +
+             reinterpret_cast<const novatel::LongHeader*>(frame)
+                 ->message_length;
+    case novatel::SYNC_2_SHORT_HEADER:
+      if (size < sizeof(novatel::ShortHeader)) {
+        return 0;
+      }
+      return sizeof(novatel::ShortHeader) + novatel::CRC_LENGTH +
+             reinterpret_cast<const novatel::ShortHeader*>(frame)
+                 ->message_length;
+    default:
+      return INVALID_FRAME;
+  }
+}
+
 // Converts NovAtel's azimuth (north = 0, east = 90) to FLU yaw (east = 0, north
 // = pi/2).
 constexpr double azimuth_deg_to_yaw_rad(double azimuth) {
@@ -111,9 +158,10 @@ class NovatelParser : public Parser {
   virtual MessageType GetMessage(MessagePtr* message_ptr);
 
  private:
-  bool check_crc();
+  bool check_crc(const uint8_t* frame, size_t length);
 
-  Parser::MessageType PrepareMessage(MessagePtr* message_ptr);
+  Parser::MessageType PrepareMessage(const uint8_t* frame, size_t length,
+                                     MessagePtr* message_ptr);
 
   // The handle_xxx functions return whether a message is ready.
   bool HandleBestPos(const novatel::BestPos* pos, uint16_t gps_week,
@@ -162,12 +210,10 @@ class NovatelParser : public Parser {
 
   double imu_measurement_time_previous_ = -1.0;
 
+  // Holds a frame split across two updates, frames within one update are
+  // parsed in place.
   std::vector<uint8_t> buffer_;
 
-  size_t header_length_ = 0;
-
-  size_t total_length_ = 0;
-
   config::ImuType imu_type_ = config::ImuType::ADIS16488;
 
   // -1 is an unused value.
@@ -228,92 +274,93 @@ Parser::MessageType NovatelParser::GetMessage(MessagePtr* message_ptr) {
   }
 
   while (data_ < data_end_) {
-    if (buffer_.empty()) {  // Looking for SYNC0
-      if (*data_ == novatel::SYNC_0) {
-        buffer_.push_back(*data_);
-      }
-      ++data_;
-    } else if (buffer_.size() == 1) {  // Looking for SYNC1
-      if (*data_ == novatel::SYNC_1) {
-        buffer_.push_back(*data_++);
-      } else {
-        buffer_.clear();
-      }
-    } else if (buffer_.size() == 2) {  // Looking for SYNC2
-      switch (*data_) {
-        case novatel::SYNC_2_LONG_HEADER:
-          buffer_.push_back(*data_++);
-          header_length_ = sizeof(novatel::LongHeader);
-          break;
-        case novatel::SYNC_2_SHORT_HEADER:
-          buffer_.push_back(*data_++);
-          header_length_ = sizeof(novatel::ShortHeader);
-          break;
-        default:
-          buffer_.clear();
-      }
-    } else if (header_length_ > 0) {  // Working on header.
-      if (buffer_.size() < header_length_) {
-        buffer_.push_back(*data_++);
-      } else {
-        if (header_length_ == sizeof(novatel::LongHeader)) {
-          total_length_ = header_length_ + novatel::CRC_LENGTH +
-                          reinterpret_cast<novatel::LongHeader*>(buffer_.data())
-                              ->message_length;
-        } else if (header_length_ == sizeof(novatel::ShortHeader)) {
-          total_length_ =
-              header_length_ + novatel::CRC_LENGTH +
-              reinterpret_cast<novatel::ShortHeader*>(buffer_.data())
-                  ->message_length;
-        } else {
-          AERROR << "Incorrect header_length_. Should never reach here.";
-          buffer_.clear();
-        }
-        header_length_ = 0;
+    if (buffer_.empty()) {
+      // Looking for SYNC0, memchr checks many bytes at a time.
+      const auto* sync = static_cast<const uint8_t*>(
+          memchr(data_, novatel::SYNC_0, data_end_ - data_));
+      if (sync == nullptr) {
+        data_ = data_end_;
+        break;
       }
-    } else if (total_length_ > 0) {
-      if (buffer_.size() < total_length_) {  // Working on body.
-        buffer_.push_back(*data_++);
+      data_ = sync;
+      const size_t available = data_end_ - data_;
+      const size_t frame_length = get_frame_length(data_, available);
+      if (frame_length == INVALID_FRAME) {
+        ++data_;
         continue;
       }
-      MessageType type = PrepareMessage(message_ptr);
-      buffer_.clear();
-      total_length_ = 0;
+      if (frame_length == 0 || frame_length > available) {
+        // The rest of the frame comes with the next update.
+        buffer_.assign(data_, data_end_);
+        data_ = data_end_;
+        break;
+      }
+      const uint8_t* frame = data_;
+      data_ += frame_length;
+      MessageType type = PrepareMessage(frame, frame_length, message_ptr);
       if (type != MessageType::NONE) {
         return type;
       }
+      continue;
+    }
+
+    // Completing the frame started in an earlier update.
+    size_t frame_length = get_frame_length(buffer_.data(), buffer_.size());
+    if (frame_length == 0) {
+      buffer_.push_back(*data_++);
+      continue;
+    }
+    if (frame_length == INVALID_FRAME) {
+      buffer_.clear();
+      continue;
+    }
+    const size_t missing =
+        std::min<size_t>(frame_length - buffer_.size(), data_end_ - data_);
+    buffer_.insert(buffer_.end(), data_, data_ + missing);
+    data_ += missing;
+    if (buffer_.size() < frame_length) {
+      break;
+    }
+    MessageType type =
+        PrepareMessage(buffer_.data(), buffer_.size(), message_ptr);
+    buffer_.clear();
+    if (type != MessageType::NONE) {
+      return type;
     }
   }
   return MessageType::NONE;
 }
 
-bool NovatelParser::check_crc() {
-  size_t l = buffer_.size() - novatel::CRC_LENGTH;
-  return crc32_block(buffer_.data(), l) ==
-         *reinterpret_cast<uint32_t*>(buffer_.data() + l);
+bool NovatelParser::check_crc(const uint8_t* frame, size_t length) {
+  size_t l = length - novatel::CRC_LENGTH;
+  uint32_t crc;
+  memcpy(&crc, frame + l, sizeof(crc));
+  return crc32_block(frame, l) == crc;
 }
 
-Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
-  if (!check_crc()) {
+Parser::MessageType NovatelParser::PrepareMessage(const uint8_t* frame,
+                                                  size_t length,
+                                                  MessagePtr* message_ptr) {
+  if (!check_crc(frame, length)) {
     AERROR << "CRC check failed.";
     return MessageType::NONE;
   }
 
-  uint8_t* message = nullptr;
+  const uint8_t* message = nullptr;
   novatel::MessageId message_id;
   uint16_t message_length;
   uint16_t gps_week;
   uint32_t gps_millisecs;
-  if (buffer_[2] == novatel::SYNC_2_LONG_HEADER) {
-    auto header = reinterpret_cast<const novatel::LongHeader*>(buffer_.data());
-    message = buffer_.data() + sizeof(novatel::LongHeader);
+  if (frame[2] == novatel::SYNC_2_LONG_HEADER) {
+    auto header = reinterpret_cast<const novatel::LongHeader*>(frame);
+    message = frame + sizeof(novatel::LongHeader);
     gps_week = header->gps_week;
     gps_millisecs = header->gps_millisecs;
     message_id = header->message_id;
     message_length = header->message_length;
   } else {
-    auto header = reinterpret_cast<const novatel::ShortHeader*>(buffer_.data());
-    message = buffer_.data() + sizeof(novatel::ShortHeader);
+    auto header = reinterpret_cast<const novatel::ShortHeader*>(frame);
+    message = frame + sizeof(novatel::ShortHeader);
     gps_week = header->gps_week;
     gps_millisecs = header->gps_millisecs;
     message_id = header->message_id;
@@ -325,7 +372,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleGnssBestpos(reinterpret_cast<novatel::BestPos*>(message),
+      if (HandleGnssBestpos(reinterpret_cast<const novatel::BestPos*>(message),
                             gps_week, gps_millisecs)) {
         *message_ptr = &bestpos_;
         return MessageType::BEST_GNSS_POS;
@@ -338,8 +385,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleBestPos(reinterpret_cast<novatel::BestPos*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleBestPos(reinterpret_cast<const novatel::BestPos*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &gnss_;
         return MessageType::GNSS;
       }
@@ -352,8 +399,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleBestVel(reinterpret_cast<novatel::BestVel*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleBestVel(reinterpret_cast<const novatel::BestVel*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &gnss_;
         return MessageType::GNSS;
       }
@@ -367,7 +414,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleCorrImuData(reinterpret_cast<novatel::CorrImuData*>(message))) {
+      if (HandleCorrImuData(
+              reinterpret_cast<const novatel::CorrImuData*>(message))) {
         *message_ptr = &ins_;
         return MessageType::INS;
       }
@@ -380,7 +428,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleInsCov(reinterpret_cast<novatel::InsCov*>(message))) {
+      if (HandleInsCov(reinterpret_cast<const novatel::InsCov*>(message))) {
         *message_ptr = &ins_;
         return MessageType::INS;
       }
@@ -393,7 +441,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleInsPva(reinterpret_cast<novatel::InsPva*>(message))) {
+      if (HandleInsPva(reinterpret_cast<const novatel::InsPva*>(message))) {
         *message_ptr = &ins_;
         return MessageType::INS;
       }
@@ -406,7 +454,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleRawImuX(reinterpret_cast<novatel::RawImuX*>(message))) {
+      if (HandleRawImuX(reinterpret_cast<const novatel::RawImuX*>(message))) {
         *message_ptr = &imu_;
         return MessageType::IMU;
       }
@@ -419,7 +467,7 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleRawImu(reinterpret_cast<novatel::RawImu*>(message))) {
+      if (HandleRawImu(reinterpret_cast<const novatel::RawImu*>(message))) {
         *message_ptr = &imu_;
         return MessageType::IMU;
       }
@@ -431,8 +479,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         break;
       }
 
-      if (HandleInsPvax(reinterpret_cast<novatel::InsPvaX*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleInsPvax(reinterpret_cast<const novatel::InsPvaX*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &ins_stat_;
         return MessageType::INS_STAT;
       }
@@ -443,7 +491,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect BDSEPHEMERIS message_length";
         break;
       }
-      if (HandleBdsEph(reinterpret_cast<novatel::BDS_Ephemeris*>(message))) {
+      if (HandleBdsEph(
+              reinterpret_cast<const novatel::BDS_Ephemeris*>(message))) {
         *message_ptr = &gnss_ephemeris_;
         return MessageType::BDSEPHEMERIDES;
       }
@@ -454,7 +503,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect GPSEPHEMERIS message_length";
         break;
       }
-      if (HandleGpsEph(reinterpret_cast<novatel::GPS_Ephemeris*>(message))) {
+      if (HandleGpsEph(
+              reinterpret_cast<const novatel::GPS_Ephemeris*>(message))) {
         *message_ptr = &gnss_ephemeris_;
         return MessageType::GPSEPHEMERIDES;
       }
@@ -465,15 +515,15 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect GLOEPHEMERIS message length";
         break;
       }
-      if (HandleGloEph(reinterpret_cast<novatel::GLO_Ephemeris*>(message))) {
+      if (HandleGloEph(
+              reinterpret_cast<const novatel::GLO_Ephemeris*>(message))) {
         *message_ptr = &gnss_ephemeris_;
         return MessageType::GLOEPHEMERIDES;
       }
       break;
 
     case novatel::RANGE:
-      if (DecodeGnssObservation(buffer_.data(),
-                                buffer_.data() + buffer_.size())) {
+      if (DecodeGnssObservation(frame, frame + length)) {
         *message_ptr = &gnss_observation_;
         return MessageType::OBSERVATION;
       }
@@ -484,8 +534,8 @@ Parser::MessageType NovatelParser::PrepareMessage(MessagePtr* message_ptr) {
         AERROR << "Incorrect message_length";
         break;
       }
-      if (HandleHeading(reinterpret_cast<novatel::Heading*>(message), gps_week,
-                        gps_millisecs)) {
+      if (HandleHeading(reinterpret_cast<const novatel::Heading*>(message),
+                        gps_week, gps_millisecs)) {
         *message_ptr = &heading_;
         return MessageType::HEADING;
       }
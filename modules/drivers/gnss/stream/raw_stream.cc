@@ -481,6 +481,9 @@ void RawStream::DataSpin() {
   while (cyber::OK()) {
     size_t length = data_stream_->read(buffer_, BUFFER_SIZE);
     if (length > 0) {
+      // Parse from the read buffer first so the parsed messages do not wait
+      // for the raw copy.
+      data_parser_ptr_->ParseRawData(buffer_, length, cyber::Time::Now());
       std::shared_ptr<RawData> msg_pub = std::make_shared<RawData>();
       if (!msg_pub) {
         AERROR << "New data sting msg failed.";
@@ -488,7 +491,6 @@ void RawStream::DataSpin() {
       }
       msg_pub->set_data(reinterpret_cast<const char *>(buffer_), length);
       raw_writer_->Write(msg_pub);
-      data_parser_ptr_->ParseRawData(msg_pub->data());
       if (push_location_) {
         PushGpgga(length);
       }
@@ -69,6 +69,10 @@ bool HesaiDriver::Init() {
 
 void HesaiDriver::PollThread() {
   AINFO << "Poll thread start";
+  if (FLAGS_hesai_batched_receive) {
+    BatchedPollThread();
+    return;
+  }
   while (running_) {
     auto start = std::chrono::steady_clock::now();
     std::shared_ptr<HesaiPacket>& pkt = pkt_buffer_[pkt_index_];
@@ -91,6 +95,27 @@ void HesaiDriver::PollThread() {
   }
 }
 
+void HesaiDriver::BatchedPollThread() {
+  // the batches are received straight into the packet ring, a batch never
+  // wraps around the end of the ring
+  static const int kMaxBatchSize = 32;
+  while (running_) {
+    int num = std::min(kMaxBatchSize, pkt_buffer_capacity_ - pkt_index_);
+    int received = input_->GetPackets(&pkt_buffer_[pkt_index_], num);
+    if (received <= 0) {
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lck(packet_mutex_);
+      for (int i = 0; i < received; ++i) {
+        pkt_queue_.push_back(pkt_buffer_[pkt_index_ + i]);
+      }
+      packet_condition_.notify_all();
+    }
+    pkt_index_ = (pkt_index_ + received) % pkt_buffer_capacity_;
+  }
+}
+
 void HesaiDriver::ProcessGps(const HesaiPacket& pkt) {
   if (pkt.size != GPS_PACKET_SIZE) {
     return;
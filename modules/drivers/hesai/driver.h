@@ -17,6 +17,7 @@
 #ifndef LIDAR_HESAI_DRIVER_H_
 #define LIDAR_HESAI_DRIVER_H_
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <deque>
@@ -66,6 +67,7 @@ class HesaiDriver {
 
  private:
   void PollThread();
+  void BatchedPollThread();
   void ProcessThread();
   void ProcessGps(const HesaiPacket& pkt);
 
@@ -18,6 +18,8 @@
 
 #include <arpa/inet.h>
 #include <fcntl.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <poll.h>
 #include <sys/file.h>
 #include <sys/socket.h>
@@ -29,10 +31,40 @@
 
 #include "cyber/cyber.h"
 
+DEFINE_bool(hesai_batched_receive, false,
+            "Receive the hesai packets in batches with recvmmsg and stamp "
+            "them with the kernel receive time.");
+
 namespace apollo {
 namespace drivers {
 namespace hesai {
 
+namespace {
+
+const size_t kControlSize = CMSG_SPACE(sizeof(scm_timestamping));
+
+// hardware stamp when the nic provides one, else the kernel software stamp
+double ReceiveStamp(msghdr *msg) {
+  for (cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET ||
+        cmsg->cmsg_type != SCM_TIMESTAMPING) {
+      continue;
+    }
+    const auto *stamps =
+        reinterpret_cast<const scm_timestamping *>(CMSG_DATA(cmsg));
+    const timespec &ts =
+        (stamps->ts[2].tv_sec != 0) ? stamps->ts[2] : stamps->ts[0];
+    if (ts.tv_sec != 0) {
+      return static_cast<double>(ts.tv_sec) +
+             static_cast<double>(ts.tv_nsec) * 1e-9;
+    }
+  }
+  return ::apollo::cyber::Time::Now().ToSecond();
+}
+
+}  // namespace
+
 Input::Input(uint16_t port, uint16_t gpsPort) {
   socketForLidar = -1;
   socketForLidar = socket(PF_INET, SOCK_DGRAM, 0);
@@ -58,6 +90,17 @@ Input::Input(uint16_t port, uint16_t gpsPort) {
     return;
   }
 
+  if (FLAGS_hesai_batched_receive) {
+    int stamp_flags = SOF_TIMESTAMPING_RX_HARDWARE |
+                      SOF_TIMESTAMPING_RAW_HARDWARE |
+                      SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(socketForLidar, SOL_SOCKET, SO_TIMESTAMPING, &stamp_flags,
+                   sizeof(stamp_flags)) < 0) {
+      AWARN << "SO_TIMESTAMPING not supported, stamp packets in user space: "
+            << strerror(errno);
+    }
+  }
+
   if (port == gpsPort) {
     socketNumber = 1;
     return;
@@ -99,6 +142,65 @@ Input::~Input(void) {
 //          1 - gps
 //         -1 - error
 int Input::GetPacket(HesaiPacket *pkt) {
+  int fd = Poll();
+  if (fd < 0) {
+    return -1;
+  }
+
+  sockaddr_in senderAddress;
+  socklen_t senderAddressLen = sizeof(senderAddress);
+  ssize_t nbytes =
+      recvfrom(fd, &pkt->data[0], ETHERNET_MTU, 0,
+               reinterpret_cast<sockaddr *>(&senderAddress), &senderAddressLen);
+
+  if (nbytes < 0) {
+    if (errno != EWOULDBLOCK) {
+      AERROR << "recvfrom error";
+      return -1;
+    }
+  }
+
+  pkt->size = nbytes;
+  return 0;
+}
+
+int Input::GetPackets(std::shared_ptr<HesaiPacket> *pkts, int num) {
+  int fd = Poll();
+  if (fd < 0) {
+    return -1;
+  }
+
+  if (static_cast<int>(msgs.size()) < num) {
+    msgs.resize(num);
+    iovecs.resize(num);
+    controls.resize(num * kControlSize);
+  }
+  for (int i = 0; i < num; ++i) {
+    iovecs[i].iov_base = &pkts[i]->data[0];
+    iovecs[i].iov_len = ETHERNET_MTU;
+    memset(&msgs[i], 0, sizeof(mmsghdr));
+    msgs[i].msg_hdr.msg_iov = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = &controls[i * kControlSize];
+    msgs[i].msg_hdr.msg_controllen = kControlSize;
+  }
+
+  // the sockets are non blocking, this drains what the kernel queued
+  int received = recvmmsg(fd, msgs.data(), num, 0, nullptr);
+  if (received < 0) {
+    if (errno != EWOULDBLOCK && errno != EINTR) {
+      AERROR << "recvmmsg error: " << strerror(errno);
+    }
+    return -1;
+  }
+  for (int i = 0; i < received; ++i) {
+    pkts[i]->size = msgs[i].msg_len;
+    pkts[i]->stamp = ReceiveStamp(&msgs[i].msg_hdr);
+  }
+  return received;
+}
+
+int Input::Poll() {
   struct pollfd fds[socketNumber];
   if (socketNumber == 2) {
     fds[0].fd = socketForGPS;
@@ -112,8 +214,6 @@ int Input::GetPacket(HesaiPacket *pkt) {
   }
   static const int POLL_TIMEOUT = 1000;  // one second (in msec)
 
-  sockaddr_in senderAddress;
-  socklen_t senderAddressLen = sizeof(senderAddress);
   int retval = poll(fds, socketNumber, POLL_TIMEOUT);
   if (retval < 0) {
     if (errno != EINTR) {
@@ -131,26 +231,12 @@ int Input::GetPacket(HesaiPacket *pkt) {
     return -1;
   }
 
-  senderAddressLen = sizeof(senderAddress);
-  ssize_t nbytes = 0;
   for (int i = 0; i != socketNumber; ++i) {
     if (fds[i].revents & POLLIN) {
-      nbytes = recvfrom(fds[i].fd, &pkt->data[0], ETHERNET_MTU, 0,
-                        reinterpret_cast<sockaddr *>(&senderAddress),
-                        &senderAddressLen);
-      break;
+      return fds[i].fd;
     }
   }
-
-  if (nbytes < 0) {
-    if (errno != EWOULDBLOCK) {
-      AERROR << "recvfrom error";
-      return -1;
-    }
-  }
-
-  pkt->size = nbytes;
-  return 0;
+  return -1;
 }
 
 }  // namespace hesai
@@ -17,9 +17,17 @@
 #ifndef LIDAR_HESAI_SRC_INPUT_H_
 #define LIDAR_HESAI_SRC_INPUT_H_
 
+#include <sys/socket.h>
+
 #include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gflags/gflags.h"
 #include "modules/drivers/hesai/type_defs.h"
 
+DECLARE_bool(hesai_batched_receive);
+
 namespace apollo {
 namespace drivers {
 namespace hesai {
@@ -29,11 +37,22 @@ class Input {
   Input(uint16_t port, uint16_t gpsPort);
   ~Input();
   int GetPacket(HesaiPacket *pkt);
+  // receives up to num packets of the first readable socket with one
+  // recvmmsg, stamped with the kernel receive time. return : the number of
+  // packets, -1 - error
+  int GetPackets(std::shared_ptr<HesaiPacket> *pkts, int num);
 
  private:
+  // return : the readable socket, -1 - error or timeout
+  int Poll();
+
   int socketForLidar = -1;
   int socketForGPS = -1;
   int socketNumber = -1;
+  // recvmmsg headers, reused by every batch
+  std::vector<mmsghdr> msgs;
+  std::vector<iovec> iovecs;
+  std::vector<char> controls;
 };
 
 }  // namespace hesai
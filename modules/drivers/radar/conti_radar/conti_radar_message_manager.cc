@@ -66,14 +66,35 @@ void ContiRadarMessageManager::set_can_client(
 
 ProtocolData<ContiRadar> *ContiRadarMessageManager::GetMutableProtocolDataById(
     const uint32_t message_id) {
-  uint32_t converted_message_id = message_id;
-  if (protocol_data_map_.find(converted_message_id) ==
-      protocol_data_map_.end()) {
+  const auto it = protocol_data_map_.find(message_id);
+  if (it == protocol_data_map_.end()) {
     ADEBUG << "Unable to get protocol data because of invalid message_id:"
            << message_id;
     return nullptr;
   }
-  return protocol_data_map_[converted_message_id];
+  return it->second;
+}
+
+void ContiRadarMessageManager::StartSweep(const uint32_t message_id) {
+  sweep_published_ = false;
+  sweep_received_ = 0;
+  if (message_id == ObjectListStatus60A::ID) {
+    // the frames of an object come in general, quality, extended order
+    if (radar_config_.radar_conf().send_ext_info()) {
+      sweep_last_id_ = ObjectExtendedInfo60D::ID;
+    } else if (radar_config_.radar_conf().send_quality()) {
+      sweep_last_id_ = ObjectQualityInfo60C::ID;
+    } else {
+      sweep_last_id_ = ObjectGeneralInfo60B::ID;
+    }
+    sweep_expected_ = sensor_data_.object_list_status().nof_objects();
+  } else {
+    sweep_last_id_ = radar_config_.radar_conf().send_quality()
+                         ? ClusterQualityInfo702::ID
+                         : ClusterGeneralInfo701::ID;
+    sweep_expected_ = sensor_data_.cluster_list_status().near() +
+                      sensor_data_.cluster_list_status().far();
+  }
 }
 
 void ContiRadarMessageManager::Parse(const uint32_t message_id,
@@ -95,8 +116,9 @@ void ContiRadarMessageManager::Parse(const uint32_t message_id,
       message_id == ObjectListStatus60A::ID) {
     ADEBUG << sensor_data_.ShortDebugString();
 
-    if (sensor_data_.contiobs_size() <=
-        sensor_data_.object_list_status().nof_objects()) {
+    if (!sweep_published_ &&
+        sensor_data_.contiobs_size() <=
+            sensor_data_.object_list_status().nof_objects()) {
       // maybe lost an object_list_status msg
       conti_radar_writer_->Write(sensor_data_);
     }
@@ -107,6 +129,21 @@ void ContiRadarMessageManager::Parse(const uint32_t message_id,
 
   sensor_protocol_data->Parse(data, length, &sensor_data_);
 
+  if (FLAGS_radar_publish_on_sweep_end) {
+    if (message_id == ClusterListStatus600::ID ||
+        message_id == ObjectListStatus60A::ID) {
+      StartSweep(message_id);
+    } else if (message_id == sweep_last_id_) {
+      ++sweep_received_;
+    }
+    if (!sweep_published_ && sweep_last_id_ != 0 &&
+        sweep_received_ >= sweep_expected_) {
+      // the last frame of the sweep is in, no need to wait for the next one
+      conti_radar_writer_->Write(sensor_data_);
+      sweep_published_ = true;
+    }
+  }
+
   if (message_id == RadarState201::ID) {
     ADEBUG << sensor_data_.ShortDebugString();
     if (sensor_data_.radar_state().send_quality() ==
@@ -26,6 +26,7 @@
 #include "modules/drivers/canbus/can_client/can_client_factory.h"
 #include "modules/drivers/canbus/can_comm/can_sender.h"
 #include "modules/drivers/canbus/can_comm/message_manager.h"
+#include "modules/drivers/canbus/sensor_gflags.h"
 #include "modules/drivers/proto/conti_radar.pb.h"
 #include "modules/drivers/radar/conti_radar/protocol/radar_config_200.h"
 
@@ -47,7 +48,14 @@ class ContiRadarMessageManager
       std::shared_ptr<apollo::drivers::canbus::CanClient> can_client);
 
  private:
+  void StartSweep(const uint32_t message_id);
+
   bool is_configured_ = false;
+  // the frame id closing the current sweep and how many of it are expected
+  uint32_t sweep_last_id_ = 0;
+  int32_t sweep_expected_ = 0;
+  int32_t sweep_received_ = 0;
+  bool sweep_published_ = false;
   RadarConfig200 radar_config_;
   std::shared_ptr<apollo::drivers::canbus::CanClient> can_client_;
   std::shared_ptr<apollo::cyber::Writer<ContiRadar>> conti_radar_writer_;
@@ -57,7 +57,14 @@ class RacobitRadarMessageManager : public MessageManager<RacobitRadar> {
   void set_can_client(std::shared_ptr<CanClient> can_client);
 
  private:
+  void StartSweep(const uint32_t message_id);
+
   bool is_configured_ = false;
+  // the frame id closing the current sweep and how many of it are expected
+  uint32_t sweep_last_id_ = 0;
+  int32_t sweep_expected_ = 0;
+  int32_t sweep_received_ = 0;
+  bool sweep_published_ = false;
   RadarConfig200 radar_config_;
   std::shared_ptr<CanClient> can_client_;
   std::shared_ptr<cyber::Writer<RacobitRadar>> writer_;
@@ -236,8 +236,7 @@ int Decoder32<vpoint>::decodeMsopPkt(
         if (this->use_lidar_clock_) {
           point.set_timestamp(pkt_time * kSecondToNanoFactor);
         } else {
-          point.set_timestamp(cyber::Time().Now().ToSecond() *
-                              kSecondToNanoFactor);
+          point.set_timestamp(this->receiveTime() * kSecondToNanoFactor);
         }
 
         if (std::isnan(intensity)) {
@@ -144,8 +144,15 @@ class DecoderBase {
   virtual int32_t processDifopPkt(const uint8_t *pkt);
   virtual double getLidarTime(const uint8_t *pkt) = 0;
   virtual void loadCalibrationFile(std::string cali_path) = 0;
+  // kernel receive time of the next msop packet, 0 stamps the points with
+  // the decoding time
+  void setReceiveTime(double receive_time) { receive_time_ = receive_time; }
 
  protected:
+  double receiveTime() const {
+    return receive_time_ > 0.0 ? receive_time_
+                               : cyber::Time().Now().ToSecond();
+  }
   virtual int32_t azimuthCalibration(float azimuth, int32_t channel);
   virtual int32_t decodeMsopPkt(const uint8_t *pkt,
                                 std::shared_ptr<std::vector<vpoint>> vec_ptr,
@@ -169,6 +176,7 @@ class DecoderBase {
   int32_t pkt_counter_;
   int32_t cut_angle_;
   int32_t last_azimuth_;
+  double receive_time_ = 0.0;
   // calibration data
   std::string cali_files_dir_;
   uint32_t cali_data_flag_;
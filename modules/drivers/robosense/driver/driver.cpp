@@ -66,6 +66,10 @@ bool RobosenseDriver::init() {
 }
 
 void RobosenseDriver::getPackets() {
+  if (FLAGS_robosense_batched_receive) {
+    getBatchedPackets();
+    return;
+  }
   while (thread_flag_) {
     LidarPacketMsg pkt_msg;
     InputState ret = lidar_input_ptr_->getPacket(pkt_msg.packet.data(), 100);
@@ -88,6 +92,35 @@ void RobosenseDriver::getPackets() {
   }
 }
 
+void RobosenseDriver::getBatchedPackets() {
+  static const uint32_t kMaxBatchSize = 32;
+  while (thread_flag_) {
+    InputState ret = lidar_input_ptr_->getPackets(kMaxBatchSize, 100);
+    if (ret & (INPUT_ERROR | INPUT_EXIT)) {
+      AERROR << "ErrCode_LidarDriverInterrupt";
+    }
+    if (!(ret & (INPUT_MSOP | INPUT_DIFOP))) {
+      continue;
+    }
+    auto &queue = (ret & INPUT_MSOP) ? msop_pkt_queue_ : difop_pkt_queue_;
+    LidarPacketMsg pkt_msg;
+    for (size_t i = 0; i < lidar_input_ptr_->batchSize(); ++i) {
+      pkt_msg.timestamp = lidar_input_ptr_->batchStamp(i);
+      memcpy(pkt_msg.packet.data(), lidar_input_ptr_->batchPacket(i),
+             PKT_DATA_LENGTH);
+      queue.push(pkt_msg);
+    }
+    if (queue.is_task_finished.load()) {
+      queue.is_task_finished.store(false);
+      if (ret & INPUT_MSOP) {
+        ThreadPool::getInstance()->commit([this]() { processMsopPackets(); });
+      } else {
+        ThreadPool::getInstance()->commit([this]() { processDifopPackets(); });
+      }
+    }
+  }
+}
+
 void RobosenseDriver::processMsopPackets() {
   while (msop_pkt_queue_.m_quque.size() > 0 && thread_flag_) {
     LidarPacketMsg pkt = msop_pkt_queue_.m_quque.front();
@@ -101,6 +134,7 @@ void RobosenseDriver::processMsopPackets() {
         std::make_shared<std::vector<PointXYZIT>>();
     int ret = 0;
     if (thread_flag_) {
+      lidar_decoder_ptr_->setReceiveTime(pkt.timestamp);
       ret = lidar_decoder_ptr_->processMsopPkt(pkt.packet.data(), point_vec_ptr,
                                                height_ptr);
     }
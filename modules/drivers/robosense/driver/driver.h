@@ -47,6 +47,7 @@ class RobosenseDriver {
 
  private:
   void getPackets();
+  void getBatchedPackets();
   void processMsopPackets();
   void processDifopPackets();
 
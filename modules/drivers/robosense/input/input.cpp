@@ -14,10 +14,46 @@
  * limitations under the License.
  *****************************************************************************/
 #include "modules/drivers/robosense/input/input.h"
+
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+
+#include "cyber/cyber.h"
+
+DEFINE_bool(robosense_batched_receive, false,
+            "Receive the robosense packets in batches with recvmmsg and stamp "
+            "them with the kernel receive time.");
+
 namespace apollo {
 namespace drivers {
 
 namespace robosense {
+namespace {
+
+const size_t kControlSize = CMSG_SPACE(sizeof(scm_timestamping));
+
+// hardware stamp when the nic provides one, else the kernel software stamp
+double receiveStamp(msghdr *msg) {
+  for (cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET ||
+        cmsg->cmsg_type != SCM_TIMESTAMPING) {
+      continue;
+    }
+    const auto *stamps =
+        reinterpret_cast<const scm_timestamping *>(CMSG_DATA(cmsg));
+    const timespec &ts =
+        (stamps->ts[2].tv_sec != 0) ? stamps->ts[2] : stamps->ts[0];
+    if (ts.tv_sec != 0) {
+      return static_cast<double>(ts.tv_sec) +
+             static_cast<double>(ts.tv_nsec) * 1e-9;
+    }
+  }
+  return cyber::Time().Now().ToSecond();
+}
+
+}  // namespace
+
 Input::Input(const uint16_t &msop_port, const uint16_t &difop_port) {
   this->msop_fd_ = setUpSocket(msop_port);
   this->difop_fd_ = setUpSocket(difop_port);
@@ -52,6 +88,16 @@ int Input::setUpSocket(uint16_t port) {
     std::cerr << "setsockopt: " << std::strerror(errno) << std::endl;
     return -1;
   }
+  if (FLAGS_robosense_batched_receive) {
+    int stamp_flags = SOF_TIMESTAMPING_RX_HARDWARE |
+                      SOF_TIMESTAMPING_RAW_HARDWARE |
+                      SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+    if (setsockopt(sock_fd, SOL_SOCKET, SO_TIMESTAMPING, &stamp_flags,
+                   sizeof(stamp_flags)) < 0) {
+      std::cerr << "setsockopt SO_TIMESTAMPING: " << std::strerror(errno)
+                << std::endl;
+    }
+  }
   return sock_fd;
 }
 
@@ -92,6 +138,72 @@ InputState Input::getPacket(uint8_t *pkt, uint32_t timeout) {
   return res;
 }
 
+InputState Input::getPackets(uint32_t max_num, uint32_t timeout) {
+  batch_packets_.clear();
+  batch_stamps_.clear();
+  if (batch_msgs_.size() < max_num) {
+    batch_buffer_.resize(max_num * RSLIDAR_PKT_LEN);
+    batch_msgs_.resize(max_num);
+    batch_iovecs_.resize(max_num);
+    batch_controls_.resize(max_num * kControlSize);
+    batch_packets_.reserve(max_num);
+    batch_stamps_.reserve(max_num);
+  }
+  fd_set rfds;
+  struct timeval tmout;
+  tmout.tv_sec = timeout / 1000;
+  tmout.tv_usec = (timeout % 1000) * 1000;
+  FD_ZERO(&rfds);
+  FD_SET(this->msop_fd_, &rfds);
+  FD_SET(this->difop_fd_, &rfds);
+  int max_fd = std::max(this->msop_fd_, this->difop_fd_);
+  int retval = select(max_fd + 1, &rfds, NULL, NULL, &tmout);
+  if (retval == -1 && errno == EINTR) {
+    return INPUT_EXIT;
+  } else if (retval == -1) {
+    std::cerr << "select: " << std::strerror(errno) << std::endl;
+    return INPUT_ERROR;
+  } else if (retval == 0) {
+    return InputState(0);
+  }
+
+  int fd = -1;
+  InputState res = InputState(0);
+  if (FD_ISSET(this->msop_fd_, &rfds)) {
+    fd = this->msop_fd_;
+    res = INPUT_MSOP;
+  } else if (FD_ISSET(this->difop_fd_, &rfds)) {
+    fd = this->difop_fd_;
+    res = INPUT_DIFOP;
+  } else {
+    return INPUT_ERROR;
+  }
+  for (uint32_t i = 0; i < max_num; ++i) {
+    batch_iovecs_[i].iov_base = &batch_buffer_[i * RSLIDAR_PKT_LEN];
+    batch_iovecs_[i].iov_len = RSLIDAR_PKT_LEN;
+    memset(&batch_msgs_[i], 0, sizeof(mmsghdr));
+    batch_msgs_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+    batch_msgs_[i].msg_hdr.msg_iovlen = 1;
+    batch_msgs_[i].msg_hdr.msg_control = &batch_controls_[i * kControlSize];
+    batch_msgs_[i].msg_hdr.msg_controllen = kControlSize;
+  }
+  // select reported a packet, take it and whatever else is already queued
+  int n = recvmmsg(fd, batch_msgs_.data(), max_num, MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    std::cerr << "recvmmsg: " << std::strerror(errno) << std::endl;
+    return INPUT_ERROR;
+  }
+  for (int i = 0; i < n; ++i) {
+    if (batch_msgs_[i].msg_len != RSLIDAR_PKT_LEN) {
+      res = InputState(res | INPUT_ERROR);
+      continue;
+    }
+    batch_packets_.push_back(&batch_buffer_[i * RSLIDAR_PKT_LEN]);
+    batch_stamps_.push_back(receiveStamp(&batch_msgs_[i].msg_hdr));
+  }
+  return res;
+}
+
 }  // namespace robosense
 }  // namespace drivers
 }  // namespace apollo
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 #include <netdb.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -25,6 +26,11 @@
 #include <iostream>
 #include <memory>
 #include <vector>
+
+#include "gflags/gflags.h"
+
+DECLARE_bool(robosense_batched_receive);
+
 namespace apollo {
 namespace drivers {
 namespace robosense {
@@ -43,11 +49,25 @@ class Input {
   Input(const uint16_t &msop_port, const uint16_t &difop_port);
   ~Input();
   InputState getPacket(uint8_t *pkt, uint32_t timeout);
+  // receives up to max_num packets of the first readable socket with one
+  // recvmmsg into the reused batch buffer, the packets stay valid until the
+  // next call
+  InputState getPackets(uint32_t max_num, uint32_t timeout);
+  size_t batchSize() const { return batch_packets_.size(); }
+  const uint8_t *batchPacket(size_t i) const { return batch_packets_[i]; }
+  // kernel receive time in seconds
+  double batchStamp(size_t i) const { return batch_stamps_[i]; }
 
  private:
   int setUpSocket(uint16_t port);
   int msop_fd_;
   int difop_fd_;
+  std::vector<uint8_t> batch_buffer_;
+  std::vector<mmsghdr> batch_msgs_;
+  std::vector<iovec> batch_iovecs_;
+  std::vector<char> batch_controls_;
+  std::vector<const uint8_t *> batch_packets_;
+  std::vector<double> batch_stamps_;
 };
 }  // namespace robosense
 }  // namespace drivers
@@ -16,13 +16,6 @@
 
 #include "modules/drivers/smartereye/compress_component.h"
 
-#include <exception>
-#include <vector>
-
-#include "opencv2/core/core.hpp"
-#include "opencv2/highgui/highgui.hpp"
-#include "opencv2/imgproc/imgproc.hpp"
-
 namespace apollo {
 namespace drivers {
 namespace smartereye {
@@ -44,6 +37,9 @@ bool CompressComponent::Init() {
 
   writer_ = node_->CreateWriter<CompressedImage>(
       config_.compress_conf().output_channel());
+  encoder_ = camera::CreateJpegEncoder(FLAGS_camera_jpeg_backend);
+  latency_recorder_.reset(
+      new common::LatencyRecorder(config_.compress_conf().output_channel()));
   return true;
 }
 
@@ -55,27 +51,16 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   compressed_image->set_measurement_time(image->measurement_time());
   compressed_image->set_format(image->encoding() + "; jpeg compressed bgr8");
 
-  std::vector<int> params;
-  params.resize(3, 0);
-  params[0] = cv::IMWRITE_JPEG_QUALITY;
-  params[1] = 95;
-
-  try {
-    cv::Mat mat_image(image->height(), image->width(), CV_8UC3,
-                      const_cast<char*>(image->data().data()), image->step());
-    cv::Mat tmp_mat;
-    cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
-    std::vector<uint8_t> compress_buffer;
-    if (!cv::imencode(".jpg", tmp_mat, compress_buffer, params)) {
-      AERROR << "cv::imencode (jpeg) failed on input image";
-      return false;
-    }
-    compressed_image->set_data(compress_buffer.data(), compress_buffer.size());
-    writer_->Write(compressed_image);
-  } catch (std::exception& e) {
-    AERROR << "cv::imencode (jpeg) exception :" << e.what();
+  const auto start_time = cyber::Time::Now();
+  if (!encoder_->Encode(*image, compressed_image->mutable_data())) {
     return false;
   }
+  const auto end_time = cyber::Time::Now();
+  ADEBUG << "jpeg encode (ms): "
+         << (end_time - start_time).ToNanosecond() / 1e6;
+  latency_recorder_->AppendLatencyRecord(image->header().camera_timestamp(),
+                                         start_time, end_time);
+  writer_->Write(compressed_image);
   return true;
 }
 
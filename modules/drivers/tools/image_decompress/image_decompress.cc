@@ -16,10 +16,6 @@
 
 #include "modules/drivers/tools/image_decompress/image_decompress.h"
 
-#include <vector>
-
-#include "opencv2/opencv.hpp"
-
 namespace apollo {
 namespace image_decompress {
 
@@ -32,6 +28,8 @@ bool ImageDecompressComponent::Init() {
   }
   AINFO << "Decompress config: \n" << config_.DebugString();
   writer_ = node_->CreateWriter<Image>(config_.channel_name());
+  decoder_ =
+      apollo::drivers::camera::CreateJpegDecoder(FLAGS_camera_jpeg_backend);
   return true;
 }
 
@@ -44,18 +42,9 @@ bool ImageDecompressComponent::Proc(
   } else {
     image->set_measurement_time(compressed_image->header().timestamp_sec());
   }
-  std::vector<uint8_t> compressed_raw_data(compressed_image->data().begin(),
-                                           compressed_image->data().end());
-  cv::Mat mat_image = cv::imdecode(compressed_raw_data, cv::IMREAD_COLOR);
-  cv::cvtColor(mat_image, mat_image, cv::COLOR_BGR2RGB);
-  image->set_width(mat_image.cols);
-  image->set_height(mat_image.rows);
-  // Now olny rgb
-  image->set_encoding("rgb8");
-  image->set_step(3 * image->width());
-
-  auto size = mat_image.step * mat_image.rows;
-  image->set_data(&(mat_image.data[0]), size);
+  if (!decoder_->Decode(compressed_image->data(), image.get())) {
+    return false;
+  }
   writer_->Write(image);
   return true;
 }
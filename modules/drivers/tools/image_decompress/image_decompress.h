@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "cyber/component/component.h"
+#include "modules/drivers/camera/jpeg_codec.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 #include "modules/drivers/tools/image_decompress/proto/config.pb.h"
 
@@ -34,6 +35,7 @@ class ImageDecompressComponent final
 
  private:
   std::shared_ptr<cyber::Writer<apollo::drivers::Image>> writer_;
+  std::unique_ptr<apollo::drivers::camera::JpegDecoder> decoder_;
   Config config_;
 };
 
@@ -16,9 +16,23 @@
 
 #include "modules/drivers/velodyne/compensator/compensator.h"
 
+#include <algorithm>
+#include <future>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "cyber/task/task.h"
+
+DEFINE_bool(velodyne_batched_compensation, false,
+            "Compensate the points in place on the reused output cloud with "
+            "one interpolated pose per block of points.");
+DEFINE_int32(velodyne_compensation_block_size, 16,
+             "Number of points sharing one interpolated pose in the batched "
+             "compensation.");
+DEFINE_int32(velodyne_compensation_num_threads, 1,
+             "Number of threads of the batched compensation.");
 
 namespace apollo {
 namespace drivers {
@@ -65,6 +79,20 @@ bool Compensator::MotionCompensation(
     AERROR << "PointCloud width & height should not be 0";
     return false;
   }
+  if (FLAGS_velodyne_batched_compensation) {
+    msg_compensated->mutable_header()->set_timestamp_sec(
+        cyber::Time::Now().ToSecond());
+    msg_compensated->mutable_header()->set_frame_id(msg->header().frame_id());
+    msg_compensated->mutable_header()->set_lidar_timestamp(
+        msg->header().lidar_timestamp());
+    msg_compensated->set_measurement_time(msg->measurement_time());
+    msg_compensated->set_height(msg->height());
+    msg_compensated->set_width(msg->width());
+    msg_compensated->set_is_dense(msg->is_dense());
+    // merges into the points left by Clear(), no allocation on a reused cloud
+    msg_compensated->mutable_point()->CopyFrom(msg->point());
+    return MotionCompensation(msg_compensated.get());
+  }
   uint64_t start = cyber::Time::Now().ToNanosecond();
   Eigen::Affine3d pose_min_time;
   Eigen::Affine3d pose_max_time;
@@ -72,7 +100,7 @@ bool Compensator::MotionCompensation(
   uint64_t timestamp_min = 0;
   uint64_t timestamp_max = 0;
   std::string frame_id = msg->header().frame_id();
-  GetTimestampInterval(msg, &timestamp_min, &timestamp_max);
+  GetTimestampInterval(*msg, &timestamp_min, &timestamp_max);
 
   msg_compensated->mutable_header()->set_timestamp_sec(
       cyber::Time::Now().ToSecond());
@@ -105,13 +133,126 @@ bool Compensator::MotionCompensation(
   return false;
 }
 
-inline void Compensator::GetTimestampInterval(
-    const std::shared_ptr<const PointCloud>& msg, uint64_t* timestamp_min,
-    uint64_t* timestamp_max) {
+bool Compensator::MotionCompensation(PointCloud* msg) {
+  if (msg->height() == 0 || msg->width() == 0 || msg->point_size() == 0) {
+    AERROR << "PointCloud width & height should not be 0";
+    return false;
+  }
+  uint64_t timestamp_min = 0;
+  uint64_t timestamp_max = 0;
+  GetTimestampInterval(*msg, &timestamp_min, &timestamp_max);
+
+  Eigen::Affine3d pose_min_time;
+  Eigen::Affine3d pose_max_time;
+  const std::string& frame_id = msg->header().frame_id();
+  if (!QueryPoseAffineFromTF2(timestamp_min, &pose_min_time, frame_id) ||
+      !QueryPoseAffineFromTF2(timestamp_max, &pose_max_time, frame_id)) {
+    return false;
+  }
+  const MotionInterpolation motion(timestamp_min, timestamp_max, pose_min_time,
+                                   pose_max_time);
+
+  // the threads take whole blocks so the poses do not depend on the split
+  const int size = msg->point_size();
+  const int block_size = std::max(1, FLAGS_velodyne_compensation_block_size);
+  const int num_blocks = (size + block_size - 1) / block_size;
+  const int num_threads =
+      std::min(std::max(1, FLAGS_velodyne_compensation_num_threads),
+               num_blocks);
+  const int blocks_per_thread = (num_blocks + num_threads - 1) / num_threads;
+  const int chunk = blocks_per_thread * block_size;
+  std::vector<std::future<void>> results;
+  for (int begin = chunk; begin < size; begin += chunk) {
+    const int end = std::min(size, begin + chunk);
+    results.push_back(cyber::Async([this, &motion, begin, end, msg]() {
+      CompensateRange(motion, begin, end, msg);
+    }));
+  }
+  CompensateRange(motion, 0, std::min(size, chunk), msg);
+  for (auto& result : results) {
+    result.get();
+  }
+  return true;
+}
+
+Compensator::MotionInterpolation::MotionInterpolation(
+    const uint64_t timestamp_min, const uint64_t timestamp_max,
+    const Eigen::Affine3d& pose_min_time, const Eigen::Affine3d& pose_max_time)
+    : timestamp_max(timestamp_max) {
+  translation = pose_min_time.translation() - pose_max_time.translation();
+  Eigen::Quaterniond q_max(pose_max_time.linear());
+  Eigen::Quaterniond q_min(pose_min_time.linear());
+  q1 = q_max.conjugate() * q_min;
+  q1.normalize();
+  translation = q_max.conjugate() * translation;
+
+  double d = Eigen::Quaterniond::Identity().dot(q1);
+  double abs_d = std::abs(d);
+  f = timestamp_max > timestamp_min
+          ? 1.0 / static_cast<double>(timestamp_max - timestamp_min)
+          : 0.0;
+  // the same "significant" rotation threshold as the per point compensation
+  rotation = abs_d < 1.0 - 1.0e-8;
+  if (rotation) {
+    theta = std::acos(abs_d);
+    sin_theta = std::sin(theta);
+    c1_sign = (d > 0) ? 1 : -1;
+  }
+}
+
+Eigen::Affine3d Compensator::MotionInterpolation::At(const double t) const {
+  Eigen::Translation3d ti(t * translation);
+  if (!rotation) {
+    return Eigen::Affine3d(ti);
+  }
+  double c0 = std::sin((1 - t) * theta) / sin_theta;
+  double c1 = std::sin(t * theta) / sin_theta * c1_sign;
+  Eigen::Quaterniond qi(c0 * Eigen::Quaterniond::Identity().coeffs() +
+                        c1 * q1.coeffs());
+  return ti * qi;
+}
+
+void Compensator::CompensateRange(const MotionInterpolation& motion,
+                                  const int begin, const int end,
+                                  PointCloud* msg) {
+  const int block_size = std::max(1, FLAGS_velodyne_compensation_block_size);
+  auto* points = msg->mutable_point();
+  for (int block_begin = begin; block_begin < end; block_begin += block_size) {
+    const int block_end = std::min(end, block_begin + block_size);
+    // one pose at the mean point time of the block, relative to
+    // timestamp_max so the sum does not lose precision
+    double time_sum = 0.0;
+    for (int i = block_begin; i < block_end; ++i) {
+      time_sum += static_cast<double>(motion.timestamp_max -
+                                      points->Get(i).timestamp());
+    }
+    const double t = time_sum / (block_end - block_begin) * motion.f;
+    const Eigen::Matrix<float, 3, 4> trans =
+        motion.At(t).matrix().topRows<3>().cast<float>();
+
+    for (int i = block_begin; i < block_end; ++i) {
+      auto* point = points->Mutable(i);
+      if (std::isnan(point->x())) {
+        continue;
+      }
+      const Eigen::Vector3f p =
+          trans.leftCols<3>() * Eigen::Vector3f(point->x(), point->y(),
+                                                point->z()) +
+          trans.col(3);
+      point->set_x(p.x());
+      point->set_y(p.y());
+      point->set_z(p.z());
+    }
+  }
+}
+
+inline void Compensator::GetTimestampInterval(const PointCloud& msg,
+                                              uint64_t* timestamp_min,
+                                              uint64_t* timestamp_max) {
   *timestamp_max = 0;
   *timestamp_min = std::numeric_limits<uint64_t>::max();
 
-  for (const auto& point : msg->point()) {
+  for (const auto& point : msg.point()) {
     uint64_t timestamp = point.timestamp();
     if (timestamp < *timestamp_min) {
       *timestamp_min = timestamp;
@@ -20,6 +20,7 @@
 #include <string>
 
 #include "Eigen/Eigen"
+#include "gflags/gflags.h"
 
 // Eigen 3.3.7: #define ALIVE (0)
 // fastrtps: enum ChangeKind_t { ALIVE, ... };
@@ -31,6 +32,10 @@
 #include "modules/drivers/velodyne/proto/config.pb.h"
 #include "modules/transform/buffer.h"
 
+DECLARE_bool(velodyne_batched_compensation);
+DECLARE_int32(velodyne_compensation_block_size);
+DECLARE_int32(velodyne_compensation_num_threads);
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -45,7 +50,38 @@ class Compensator {
   bool MotionCompensation(const std::shared_ptr<const PointCloud>& msg,
                           std::shared_ptr<PointCloud> msg_compensated);
 
+  /**
+   * @brief motion compensation of the points of msg in place, one pose is
+   *   interpolated per block of points and the blocks are shared by the
+   *   compensation threads. nan points are kept so the point order is
+   *   unchanged, msg may be a reused buffer.
+   */
+  bool MotionCompensation(PointCloud* msg);
+
  private:
+  /**
+   * @brief relative motion from the pose at timestamp_max to the pose at a
+   *   point timestamp, interpolated between the start and end poses.
+   */
+  struct MotionInterpolation {
+    Eigen::Vector3d translation;
+    Eigen::Quaterniond q1;
+    double theta = 0.0;
+    double sin_theta = 0.0;
+    double c1_sign = 1.0;
+    double f = 0.0;
+    uint64_t timestamp_max = 0;
+    bool rotation = false;
+
+    MotionInterpolation(const uint64_t timestamp_min,
+                        const uint64_t timestamp_max,
+                        const Eigen::Affine3d& pose_min_time,
+                        const Eigen::Affine3d& pose_max_time);
+    Eigen::Affine3d At(const double t) const;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
   /**
    * @brief get pose affine from tf2 by gps timestamp
    *   novatel-preprocess broadcast the tf2 transfrom.
@@ -65,10 +101,16 @@ class Compensator {
   /**
    * @brief get min timestamp and max timestamp from points in pointcloud2
    */
-  inline void GetTimestampInterval(const std::shared_ptr<const PointCloud>& msg,
+  inline void GetTimestampInterval(const PointCloud& msg,
                                    uint64_t* timestamp_min,
                                    uint64_t* timestamp_max);
 
+  /**
+   * @brief compensate the points [begin, end) of msg in place
+   */
+  void CompensateRange(const MotionInterpolation& motion, const int begin,
+                       const int end, PointCloud* msg);
+
   bool IsValid(const Eigen::Vector3d& point);
 
   transform::Buffer* tf2_buffer_ptr_ = transform::Buffer::Instance();
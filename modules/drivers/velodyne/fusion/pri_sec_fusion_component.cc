@@ -17,8 +17,15 @@
 #include "modules/drivers/velodyne/fusion/pri_sec_fusion_component.h"
 
 #include <memory>
+#include <string>
 #include <thread>
 
+DEFINE_bool(velodyne_fusion_gather, false,
+            "Gather the secondary clouds before merging and write the fused "
+            "cloud once into a pooled, preallocated output cloud.");
+DEFINE_int32(velodyne_fusion_pool_size, 4,
+             "Number of pooled fused clouds of the gather fusion.");
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -38,11 +45,22 @@ bool PriSecFusionComponent::Init() {
     auto reader = node_->CreateReader<PointCloud>(channel);
     readers_.emplace_back(reader);
   }
+
+  if (FLAGS_velodyne_fusion_gather) {
+    fusion_pool_.reset(
+        new CCObjectPool<PointCloud>(FLAGS_velodyne_fusion_pool_size));
+    fusion_pool_->ConstructAll();
+    sources_.reserve(readers_.size());
+    source_poses_.reserve(readers_.size());
+  }
   return true;
 }
 
 bool PriSecFusionComponent::Proc(
     const std::shared_ptr<PointCloud>& point_cloud) {
+  if (FLAGS_velodyne_fusion_gather) {
+    return GatherFusion(point_cloud);
+  }
   auto target = std::make_shared<PointCloud>(*point_cloud);
   auto fusion_readers = readers_;
   auto start_time = Time::Now().ToSecond();
@@ -71,6 +89,99 @@ bool PriSecFusionComponent::Proc(
   return true;
 }
 
+bool PriSecFusionComponent::GatherFusion(
+    const std::shared_ptr<PointCloud>& point_cloud) {
+  sources_.clear();
+  source_poses_.clear();
+  auto fusion_readers = readers_;
+  auto start_time = Time::Now().ToSecond();
+  int expired = 0;
+  while ((Time::Now().ToSecond() - start_time) < conf_.wait_time_s() &&
+         fusion_readers.size() > 0) {
+    for (auto itr = fusion_readers.begin(); itr != fusion_readers.end();) {
+      (*itr)->Observe();
+      if (!(*itr)->Empty()) {
+        auto source = (*itr)->GetLatestObserved();
+        if (conf_.drop_expired_data() && IsExpired(point_cloud, source)) {
+          ++expired;
+          ++itr;
+        } else {
+          Eigen::Affine3d pose;
+          if (QueryPoseAffine(point_cloud->header().frame_id(),
+                              source->header().frame_id(), &pose)) {
+            sources_.push_back(source);
+            source_poses_.push_back(pose);
+          }
+          itr = fusion_readers.erase(itr);
+        }
+      } else {
+        ++itr;
+      }
+    }
+    if (fusion_readers.size() > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+  auto wait_time = Time::Now().ToSecond() - start_time;
+  for (const auto& reader : fusion_readers) {
+    AWARN << "Pointcloud fusion timeout on " << reader->GetChannelName()
+          << " after " << wait_time * 1000 << "ms, expired: " << expired;
+  }
+
+  int point_size = point_cloud->point_size();
+  for (const auto& source : sources_) {
+    point_size += source->point_size();
+  }
+  auto target = fusion_pool_->GetObject();
+  if (target == nullptr) {
+    AWARN << "fusion fail to getobject, will be new";
+    target = std::make_shared<PointCloud>();
+  }
+  // the cleared points are reused, the fused points are allocated only when
+  // a frame is larger than every previous one
+  target->Clear();
+  target->mutable_point()->Reserve(point_size);
+  target->MergeFrom(*point_cloud);
+  for (size_t i = 0; i < sources_.size(); ++i) {
+    AppendTransformed(*sources_[i], source_poses_[i], target.get());
+  }
+  target->set_width(target->point_size() / target->height());
+  sources_.clear();
+
+  auto diff = Time::Now().ToNanosecond() - target->header().lidar_timestamp();
+  AINFO << "Pointcloud fusion diff: " << diff / 1000000 << "ms, fused "
+        << source_poses_.size() << "/" << readers_.size()
+        << " clouds, missing: " << fusion_readers.size()
+        << ", wait: " << wait_time * 1000 << "ms";
+  fusion_writer_->Write(target);
+  return true;
+}
+
+void PriSecFusionComponent::AppendTransformed(const PointCloud& point_cloud_add,
+                                              const Eigen::Affine3d& pose,
+                                              PointCloud* point_cloud) {
+  const bool transform = !std::isnan(pose(0, 0));
+  const Eigen::Matrix<float, 3, 4> trans =
+      pose.matrix().topRows<3>().cast<float>();
+  for (const auto& point : point_cloud_add.point()) {
+    PointXYZIT* point_new = point_cloud->add_point();
+    point_new->set_intensity(point.intensity());
+    point_new->set_timestamp(point.timestamp());
+    if (!transform || std::isnan(point.x())) {
+      point_new->set_x(point.x());
+      point_new->set_y(point.y());
+      point_new->set_z(point.z());
+      continue;
+    }
+    const Eigen::Vector3f p =
+        trans.leftCols<3>() * Eigen::Vector3f(point.x(), point.y(), point.z()) +
+        trans.col(3);
+    point_new->set_x(p.x());
+    point_new->set_y(p.y());
+    point_new->set_z(p.z());
+  }
+}
+
 bool PriSecFusionComponent::IsExpired(
     const std::shared_ptr<PointCloud>& target,
     const std::shared_ptr<PointCloud>& source) {
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "Eigen/Eigen"
+#include "gflags/gflags.h"
 
 // Eigen 3.3.7: #define ALIVE (0)
 // fastrtps: enum ChangeKind_t { ALIVE, ... };
@@ -28,11 +29,15 @@
 #   undef ALIVE
 #endif
 
+#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/drivers/velodyne/proto/config.pb.h"
 #include "modules/transform/buffer.h"
 
+DECLARE_bool(velodyne_fusion_gather);
+DECLARE_int32(velodyne_fusion_pool_size);
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -40,6 +45,7 @@ namespace velodyne {
 using apollo::cyber::Component;
 using apollo::cyber::Reader;
 using apollo::cyber::Writer;
+using apollo::cyber::base::CCObjectPool;
 using apollo::drivers::PointCloud;
 
 class PriSecFusionComponent : public Component<PointCloud> {
@@ -48,6 +54,14 @@ class PriSecFusionComponent : public Component<PointCloud> {
   bool Proc(const std::shared_ptr<PointCloud>& point_cloud) override;
 
  private:
+  /**
+   * @brief waits for the secondary clouds first and writes the primary and
+   *   the transformed secondary points once into a pooled output cloud
+   *   reserved for all of them.
+   */
+  bool GatherFusion(const std::shared_ptr<PointCloud>& point_cloud);
+  void AppendTransformed(const PointCloud& point_cloud_add,
+                         const Eigen::Affine3d& pose, PointCloud* point_cloud);
   bool Fusion(std::shared_ptr<PointCloud> target,
               std::shared_ptr<PointCloud> source);
   bool IsExpired(const std::shared_ptr<PointCloud>& target,
@@ -63,6 +77,11 @@ class PriSecFusionComponent : public Component<PointCloud> {
   apollo::transform::Buffer* buffer_ptr_ = nullptr;
   std::shared_ptr<Writer<PointCloud>> fusion_writer_;
   std::vector<std::shared_ptr<Reader<PointCloud>>> readers_;
+  std::shared_ptr<CCObjectPool<PointCloud>> fusion_pool_ = nullptr;
+  // reused by GatherFusion
+  std::vector<std::shared_ptr<PointCloud>> sources_;
+  std::vector<Eigen::Affine3d, Eigen::aligned_allocator<Eigen::Affine3d>>
+      source_poses_;
 };
 
 CYBER_REGISTER_COMPONENT(PriSecFusionComponent)
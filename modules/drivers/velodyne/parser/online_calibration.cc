@@ -16,6 +16,9 @@
 
 #include "modules/drivers/velodyne/parser/online_calibration.h"
 
+#include <chrono>
+#include <cstring>
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -23,42 +26,124 @@ namespace velodyne {
 using apollo::drivers::velodyne::VelodynePacket;
 using apollo::drivers::velodyne::VelodyneScan;
 
+namespace {
+
+// read calibration when get 2s packet
+constexpr size_t kStatusSizeToDecode = 5789 * 2;
+
+// the indexes of the "UNIT#" values in the status
+std::vector<int> GetUnitIndex(const std::vector<uint8_t>& status_values) {
+  std::vector<int> unit_indexs;
+  int size = static_cast<int>(status_values.size());
+  // simple check only for value, maybe need more check fro status type
+  for (int start_index = 0; start_index < size - 5; ++start_index) {
+    if (status_values[start_index] == 85            // "U"
+        && status_values[start_index + 1] == 78     // "N"
+        && status_values[start_index + 2] == 73     // "I"
+        && status_values[start_index + 3] == 84     // "T"
+        && status_values[start_index + 4] == 35) {  // "#"
+      unit_indexs.emplace_back(start_index);
+    }
+  }
+  return unit_indexs;
+}
+
+int16_t ReadInt16(const std::vector<uint8_t>& status_values, int index) {
+  int16_t value = 0;
+  std::memcpy(&value, &status_values[index], sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+OnlineCalibration::~OnlineCalibration() {
+  if (decode_task_.valid()) {
+    decode_task_.wait();
+  }
+}
+
 int OnlineCalibration::decode(const std::shared_ptr<VelodyneScan>& scan_msgs) {
   if (inited_) {
     return 0;
   }
+  if (!CollectStatus(scan_msgs)) {
+    return -1;
+  }
+  if (status_types_.size() < kStatusSizeToDecode) {
+    AINFO << "Wait for more scan msgs";
+    return -1;
+  }
+  if (DecodeStatus(status_values_, &calibration_) != 0) {
+    return -1;
+  }
+  inited_ = true;
+  return 0;
+}
+
+std::shared_ptr<const Calibration> OnlineCalibration::AsyncDecode(
+    const std::shared_ptr<VelodyneScan>& scan_msgs) {
+  auto calibration = std::atomic_load(&decoded_calibration_);
+  if (calibration != nullptr) {
+    return calibration;
+  }
+  if (!CollectStatus(scan_msgs) ||
+      status_types_.size() < kStatusSizeToDecode) {
+    return nullptr;
+  }
+  if (decode_task_.valid()) {
+    if (decode_task_.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      return nullptr;
+    }
+    decode_task_.get();
+  }
+
+  // the task decodes a snapshot, the packets keep being collected meanwhile
+  auto status_values = std::make_shared<std::vector<uint8_t>>(status_values_);
+  decode_task_ = cyber::Async([this, status_values]() {
+    auto calibration = std::make_shared<Calibration>();
+    if (DecodeStatus(*status_values, calibration.get()) == 0) {
+      std::atomic_store(&decoded_calibration_,
+                        std::shared_ptr<const Calibration>(calibration));
+    }
+  });
+  return nullptr;
+}
+
+bool OnlineCalibration::CollectStatus(
+    const std::shared_ptr<VelodyneScan>& scan_msgs) {
   for (auto& packet : scan_msgs->firing_pkts()) {
     if (packet.data().size() < 1206) {
       AERROR << "Ivalid packet data size, expect 1206, actually "
              << packet.data().size();
-      return -1;
+      return false;
     }
-    uint8_t* data =
-        reinterpret_cast<uint8_t*>(const_cast<char*>(packet.data().c_str()));
+    const uint8_t* data =
+        reinterpret_cast<const uint8_t*>(packet.data().c_str());
     status_types_.emplace_back(data[1204]);
     status_values_.emplace_back(data[1205]);
   }
-  // read calibration when get 2s packet
-  if (status_types_.size() < 5789 * 2) {
-    AINFO << "Wait for more scan msgs";
-    return -1;
-  }
-  get_unit_index();
-  int unit_size = static_cast<int>(unit_indexs_.size());
+  return true;
+}
+
+int OnlineCalibration::DecodeStatus(const std::vector<uint8_t>& status_values,
+                                    Calibration* calibration) {
+  std::vector<int> unit_indexs = GetUnitIndex(status_values);
+  int unit_size = static_cast<int>(unit_indexs.size());
   if (unit_size < 2) {
     // can not find two unit# index, may be lost packet
     AINFO << "unit count less than 2, maybe lost packets";
     return -1;
   }
 
-  if (unit_indexs_[unit_size - 1] - unit_indexs_[unit_size - 2] !=
+  if (unit_indexs[unit_size - 1] - unit_indexs[unit_size - 2] !=
       65 * 64) {  // 64 lasers
     // lost packet
     AERROR << "two unit distance is wrong";
     return -1;
   }
 
-  int start_index = unit_indexs_[unit_size - 2];
+  int start_index = unit_indexs[unit_size - 2];
   for (int i = 0; i < 64; ++i) {
     LaserCorrection laser_correction;
 
@@ -66,39 +151,33 @@ int OnlineCalibration::decode(const std::shared_ptr<VelodyneScan>& scan_msgs) {
     int index_32 = start_index + i * 64 + 32;
     int index_48 = start_index + i * 64 + 48;
 
-    laser_correction.laser_ring = status_values_[index_16];
+    laser_correction.laser_ring = status_values[index_16];
 
     laser_correction.vert_correction =
-        *reinterpret_cast<int16_t*>(&status_values_[index_16 + 1]) / 100.0f *
+        ReadInt16(status_values, index_16 + 1) / 100.0f *
         static_cast<float>(DEGRESS_TO_RADIANS);
     laser_correction.rot_correction =
-        *reinterpret_cast<int16_t*>(&status_values_[index_16 + 3]) / 100.0f *
+        ReadInt16(status_values, index_16 + 3) / 100.0f *
         static_cast<float>(DEGRESS_TO_RADIANS);
     laser_correction.dist_correction =
-        *reinterpret_cast<int16_t*>(&status_values_[index_16 + 5]) / 10.0f /
-        100.0f;  // to meter
+        ReadInt16(status_values, index_16 + 5) / 10.0f / 100.0f;  // to meter
     laser_correction.dist_correction_x =
-        *reinterpret_cast<int16_t*>(&status_values_[index_32]) / 10.0f /
-        100.0f;  // to meter
+        ReadInt16(status_values, index_32) / 10.0f / 100.0f;  // to meter
     laser_correction.dist_correction_y =
-        *reinterpret_cast<int16_t*>(&status_values_[index_32 + 2]) / 10.0f /
-        100.0f;  // to meter
+        ReadInt16(status_values, index_32 + 2) / 10.0f / 100.0f;  // to meter
     laser_correction.vert_offset_correction =
-        *reinterpret_cast<int16_t*>(&status_values_[index_32 + 4]) / 10.0f /
-        100.0f;  // to meter
+        ReadInt16(status_values, index_32 + 4) / 10.0f / 100.0f;  // to meter
     laser_correction.horiz_offset_correction =
-        static_cast<int16_t>(static_cast<int16_t>(status_values_[index_48])
+        static_cast<int16_t>(static_cast<int16_t>(status_values[index_48])
                                  << 8 |
-                             status_values_[index_32 + 6]) /
+                             status_values[index_32 + 6]) /
         10.0f / 100.0f;  // to meter
     laser_correction.focal_distance =
-        *reinterpret_cast<int16_t*>(&status_values_[index_48 + 1]) / 10.0f /
-        100.0f;  // to meter
+        ReadInt16(status_values, index_48 + 1) / 10.0f / 100.0f;  // to meter
     laser_correction.focal_slope =
-        *reinterpret_cast<int16_t*>(&status_values_[index_48 + 3]) /
-        10.0f;  // to meter
-    laser_correction.max_intensity = status_values_[index_48 + 6];
-    laser_correction.min_intensity = status_values_[index_48 + 5];
+        ReadInt16(status_values, index_48 + 3) / 10.0f;  // to meter
+    laser_correction.max_intensity = status_values[index_48 + 6];
+    laser_correction.min_intensity = status_values[index_48 + 5];
 
     laser_correction.cos_rot_correction = cosf(laser_correction.rot_correction);
     laser_correction.sin_rot_correction = sinf(laser_correction.rot_correction);
@@ -110,33 +189,14 @@ int OnlineCalibration::decode(const std::shared_ptr<VelodyneScan>& scan_msgs) {
         256.0f * static_cast<float>(
                      std::pow(1 - laser_correction.focal_distance / 13100, 2));
 
-    calibration_.laser_corrections_[laser_correction.laser_ring] =
+    calibration->laser_corrections_[laser_correction.laser_ring] =
         laser_correction;
   }
-  calibration_.num_lasers_ = 64;
-  calibration_.initialized_ = true;
-  inited_ = true;
+  calibration->num_lasers_ = 64;
+  calibration->initialized_ = true;
   return 0;
 }
 
-void OnlineCalibration::get_unit_index() {
-  int size = static_cast<int>(status_values_.size());
-  // simple check only for value, maybe need more check fro status type
-  int start_index = 0;
-  if (unit_indexs_.size() > 0) {
-    start_index = unit_indexs_.back() + 5;
-  }
-  for (; start_index < size - 5; ++start_index) {
-    if (status_values_[start_index] == 85            // "U"
-        && status_values_[start_index + 1] == 78     // "N"
-        && status_values_[start_index + 2] == 73     // "I"
-        && status_values_[start_index + 3] == 84     // "T"
-        && status_values_[start_index + 4] == 35) {  // "#"
-      unit_indexs_.emplace_back(start_index);
-    }
-  }
-}
-
 void OnlineCalibration::dump(const std::string& file_path) {
   if (!inited_) {
     AERROR << "Please decode calibraion info first";
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -37,21 +38,33 @@ constexpr double DEGRESS_TO_RADIANS = 3.1415926535897 / 180.0;
 class OnlineCalibration {
  public:
   OnlineCalibration() {}
-  ~OnlineCalibration() {}
+  ~OnlineCalibration();
 
   int decode(const std::shared_ptr<VelodyneScan>& scan_msgs);
+  /**
+   * @brief Collect the status bytes of the scan on the caller thread, the
+   * calibration is decoded from them in a cyber task once enough arrived.
+   * @return the decoded calibration, nullptr until decoding succeeded
+   */
+  std::shared_ptr<const Calibration> AsyncDecode(
+      const std::shared_ptr<VelodyneScan>& scan_msgs);
   void dump(const std::string& file_path);
-  void get_unit_index();
   bool inited() const { return inited_; }
   Calibration calibration() const { return calibration_; }
 
  private:
-  bool inited_;
+  bool CollectStatus(const std::shared_ptr<VelodyneScan>& scan_msgs);
+  static int DecodeStatus(const std::vector<uint8_t>& status_values,
+                          Calibration* calibration);
+
+  bool inited_ = false;
   Calibration calibration_;
   std::vector<uint8_t> status_types_;
   std::vector<uint8_t> status_values_;
-  // store first two "unit#" value index
-  std::vector<int> unit_indexs_;
+
+  // published by the decode task, swapped in by the packet thread
+  std::shared_ptr<const Calibration> decoded_calibration_;
+  std::future<void> decode_task_;
 };
 
 }  // namespace velodyne
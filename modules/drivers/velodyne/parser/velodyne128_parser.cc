@@ -36,6 +36,9 @@ void Velodyne128Parser::GeneratePointcloud(
 
   // us
   gps_base_usec_ = scan_msg->basetime();
+  // cleared points of a pooled cloud are reused by add_point
+  out_msg->mutable_point()->Reserve(scan_msg->firing_pkts_size() *
+                                    SCANS_PER_PACKET);
 
   for (int i = 0; i < scan_msg->firing_pkts_size(); ++i) {
     Unpack(scan_msg->firing_pkts(i), out_msg);
@@ -68,53 +71,94 @@ void Velodyne128Parser::Order(std::shared_ptr<PointCloud> cloud) {
   (void)cloud;
 }
 
+void Velodyne128Parser::setup() {
+  VelodyneParser::setup();
+  InitBlockCorrections();
+}
+
+void Velodyne128Parser::InitBlockCorrections() {
+  for (int group = 0; group < kBlockGroups; ++group) {
+    BlockCorrections& block = block_corrections_[group];
+    for (int j = 0; j < SCANS_PER_BLOCK; ++j) {
+      const LaserCorrection& corrections =
+          corrections_[j + group * SCANS_PER_BLOCK];
+      block.dist_correction[j] = corrections.dist_correction;
+      block.cos_rot_correction[j] = corrections.cos_rot_correction;
+      block.sin_rot_correction[j] = corrections.sin_rot_correction;
+      block.cos_vert_correction[j] = corrections.cos_vert_correction;
+      block.sin_vert_correction[j] = corrections.sin_vert_correction;
+      block.horiz_offset_correction[j] = corrections.horiz_offset_correction;
+      block.vert_offset_correction[j] = corrections.vert_offset_correction;
+      block.focal_offset[j] = 256 *
+                              (1 - corrections.focal_distance / 13100) *
+                              (1 - corrections.focal_distance / 13100);
+      block.focal_slope[j] = corrections.focal_slope;
+      block.min_intensity[j] = corrections.min_intensity;
+      block.max_intensity[j] = corrections.max_intensity;
+    }
+  }
+}
+
 void Velodyne128Parser::Unpack(const VelodynePacket& pkt,
                                std::shared_ptr<PointCloud> pc) {
-  float azimuth_diff, azimuth_corrected_f;
-  float last_azimuth_diff = 0.0f;
-  uint16_t azimuth = 0;
-  uint16_t azimuth_next = 0;
-  uint16_t azimuth_corrected = 0;
   const RawPacket* raw = (const RawPacket*)pkt.data().c_str();
   double basetime = raw->gps_timestamp;
 
+  ChannelArray raw_distance;
+  ChannelArray raw_intensity;
   for (int block = 0; block < BLOCKS_PER_PACKET; block++) {
-    // Calculate difference between current and next block's azimuth angle.
-    if (block == 0) {
-      azimuth = raw->blocks[block].rotation;
-    } else {
-      azimuth = azimuth_next;
-    }
-    if (block < (BLOCKS_PER_PACKET - 1)) {
-      azimuth_next = raw->blocks[block + 1].rotation;
-      azimuth_diff =
-          static_cast<float>((36000 + azimuth_next - azimuth) % 36000);
-      last_azimuth_diff = azimuth_diff;
-    } else {
-      azimuth_diff = last_azimuth_diff;
-    }
-
-    /*condition added to avoid calculating points which are not
-      in the interesting defined area (min_angle < area < max_angle)*/
+    const BlockCorrections& corrections =
+        block_corrections_[block % kBlockGroups];
+    // all the channels of a block fire at the block azimuth, the firing
+    // order correction is zero for this sensor
+    const uint16_t azimuth = raw->blocks[block].rotation;
+    const uint16_t rotation = azimuth % 36000;
+
+    // distance and intensity extraction
+    const uint8_t* data = raw->blocks[block].data;
     for (int j = 0, k = 0; j < SCANS_PER_BLOCK; j++, k += RAW_SCAN_SIZE) {
-      uint8_t group = static_cast<uint8_t>(block % 4);
-      uint8_t chan_id = static_cast<uint8_t>(j + group * 32);
-      uint8_t firing_order = chan_id / 8;
-      firing_order = 0;
-      LaserCorrection& corrections = calibration_.laser_corrections_[chan_id];
-      // distance extraction
-      // union two_bytes tmp;
-      union RawDistance raw_distance;
-      raw_distance.bytes[0] = raw->blocks[block].data[k];
-      raw_distance.bytes[1] = raw->blocks[block].data[k + 1];
-
-      float real_distance =
-          raw_distance.raw_distance * VSL128_DISTANCE_RESOLUTION;
-      float distance = real_distance + corrections.dist_correction;
+      union RawDistance distance;
+      distance.bytes[0] = data[k];
+      distance.bytes[1] = data[k + 1];
+      raw_distance[j] = distance.raw_distance;
+      raw_intensity[j] = data[k + 2];
+    }
 
+    // the same computation as ComputeCoords and the intensity compensation
+    // of the 64 parser, for the 32 channels of the block at once
+    const ChannelArray real_distance =
+        raw_distance * VSL128_DISTANCE_RESOLUTION;
+    const ChannelArray distance = real_distance + corrections.dist_correction;
+    const float cos_rot = cos_rot_table_[rotation];
+    const float sin_rot = sin_rot_table_[rotation];
+    const ChannelArray cos_rot_angle =
+        cos_rot * corrections.cos_rot_correction +
+        sin_rot * corrections.sin_rot_correction;
+    const ChannelArray sin_rot_angle =
+        sin_rot * corrections.cos_rot_correction -
+        cos_rot * corrections.sin_rot_correction;
+    const ChannelArray xy_distance = distance * corrections.cos_vert_correction;
+    const ChannelArray x = xy_distance * sin_rot_angle -
+                           corrections.horiz_offset_correction * cos_rot_angle;
+    const ChannelArray y = xy_distance * cos_rot_angle +
+                           corrections.horiz_offset_correction * sin_rot_angle;
+    const ChannelArray z = distance * corrections.sin_vert_correction +
+                           corrections.vert_offset_correction;
+
+    const ChannelArray distance_ratio = 1.0f - raw_distance / 65535.0f;
+    const ChannelIntArray intensity =
+        (raw_intensity.cast<int>() +
+         (corrections.focal_slope *
+          (corrections.focal_offset - 256.0f * distance_ratio * distance_ratio)
+              .abs())
+             .cast<int>())
+            .max(corrections.min_intensity)
+            .min(corrections.max_intensity);
+
+    for (int j = 0; j < SCANS_PER_BLOCK; j++) {
       uint64_t timestamp = static_cast<uint64_t>(GetTimestamp(
           basetime, (*inner_time_)[block][j], static_cast<uint16_t>(block)));
-      if (!is_scan_valid(azimuth, distance)) {
+      if (!is_scan_valid(azimuth, distance[j])) {
         // todo organized
         if (config_.organized()) {
           apollo::drivers::PointXYZIT* point_new = pc->add_point();
@@ -127,54 +171,15 @@ void Velodyne128Parser::Unpack(const VelodynePacket& pkt,
         continue;
       }
 
-      // if (pointInRange(distance)) {
-      int intensity = static_cast<int>(raw->blocks[block].data[k + 2]);
-
-      /** correct for the laser rotation as a function of timing during the
-       * firings **/
-      azimuth_corrected_f =
-          azimuth +
-          (azimuth_diff * (firing_order * CHANNEL_TDURATION) / SEQ_TDURATION);
-      azimuth_corrected =
-          (static_cast<uint16_t>(round(azimuth_corrected_f))) % 36000;
-
-      // add new point
+      // add new point, in the standard ROS coordinate system
       PointXYZIT* point_new = pc->add_point();
-
-      // compute time , time offset is zero
       point_new->set_timestamp(timestamp);
-      ComputeCoords(real_distance, corrections, azimuth_corrected, point_new);
-
-      intensity = IntensityCompensate(corrections, raw_distance.raw_distance,
-                                      intensity);
-      point_new->set_intensity(intensity);
+      point_new->set_x(y[j]);
+      point_new->set_y(-x[j]);
+      point_new->set_z(z[j]);
+      point_new->set_intensity(intensity[j]);
     }
-    // }
-  }
-}
-
-int Velodyne128Parser::IntensityCompensate(const LaserCorrection& corrections,
-                                           const uint16_t raw_distance,
-                                           int intensity) {
-  float focal_offset = 256 * (1 - corrections.focal_distance / 13100) *
-                       (1 - corrections.focal_distance / 13100);
-  float focal_slope = corrections.focal_slope;
-
-  intensity += static_cast<int>(
-      focal_slope *
-      static_cast<float>(std::abs(
-          focal_offset -
-          256.0f * (1.0f - static_cast<float>(raw_distance) / 65535.0f) *
-              (1.0f - static_cast<float>(raw_distance) / 65535.0f))));
-
-  if (intensity < corrections.min_intensity) {
-    intensity = corrections.min_intensity;
-  }
-
-  if (intensity > corrections.max_intensity) {
-    intensity = corrections.max_intensity;
   }
-  return intensity;
 }
 
 }  // namespace velodyne
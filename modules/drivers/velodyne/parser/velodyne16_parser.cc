@@ -91,7 +91,7 @@ void Velodyne16Parser::Unpack(const VelodynePacket& pkt,
     for (int firing = 0, k = 0; firing < VLP16_FIRINGS_PER_BLOCK; ++firing) {
       for (int dsr = 0; dsr < VLP16_SCANS_PER_FIRING;
            ++dsr, k += RAW_SCAN_SIZE) {
-        LaserCorrection& corrections = calibration_.laser_corrections_[dsr];
+        const LaserCorrection& corrections = corrections_[dsr];
 
         /** Position Calculation */
         union RawDistance raw_distance;
@@ -130,7 +130,7 @@ void Velodyne32Parser::UnpackVLP32C(const VelodynePacket& pkt,
     }
     for (int laser_id = 0, k = 0; laser_id < SCANS_PER_BLOCK;
          ++laser_id, k += RAW_SCAN_SIZE) {  // 32, 3
-      LaserCorrection& corrections = calibration_.laser_corrections_[laser_id];
+      const LaserCorrection& corrections = corrections_[laser_id];
 
       union RawDistance raw_distance;
       raw_distance.bytes[0] = raw->blocks[i].data[k];
@@ -185,7 +185,7 @@ void Velodyne32Parser::Unpack(const VelodynePacket& pkt,
   for (int i = 0; i < BLOCKS_PER_PACKET; i++) {  // 12
     for (int laser_id = 0, k = 0; laser_id < SCANS_PER_BLOCK;
          ++laser_id, k += RAW_SCAN_SIZE) {  // 32, 3
-      LaserCorrection& corrections = calibration_.laser_corrections_[laser_id];
+      const LaserCorrection& corrections = corrections_[laser_id];
 
       union RawDistance raw_distance;
       raw_distance.bytes[0] = raw->blocks[i].data[k];
@@ -137,9 +137,8 @@ void Velodyne64Parser::InitOffsets() {
   // pre compute col offsets
   for (int i = 0; i < width; ++i) {
     int col = velodyne::ORDER_64[i];
-    // compute offset, NOTICE: std::map doesn't have const [] since [] may
-    // insert new values into map
-    const LaserCorrection& corrections = calibration_.laser_corrections_[col];
+    // compute offset
+    const LaserCorrection& corrections = corrections_[col];
     int offset =
         static_cast<int>(corrections.rot_correction / ANGULAR_RESOLUTION + 0.5);
     offsets_[i] = offset;
@@ -150,10 +149,13 @@ void Velodyne64Parser::GeneratePointcloud(
     const std::shared_ptr<VelodyneScan>& scan_msg,
     std::shared_ptr<PointCloud> pointcloud) {
   if (config_.calibration_online() && !calibration_.initialized_) {
-    if (online_calibration_.decode(scan_msg) == -1) {
+    // decoding runs off this thread, swap the tables in once it is done
+    auto calibration = online_calibration_.AsyncDecode(scan_msg);
+    if (calibration == nullptr) {
       return;
     }
-    calibration_ = online_calibration_.calibration();
+    calibration_ = *calibration;
+    UpdateCorrections();
     if (config_.organized()) {
       InitOffsets();
     }
@@ -260,8 +262,7 @@ void Velodyne64Parser::Unpack(const VelodynePacket& pkt,
       // One point
       uint8_t laser_number =
           static_cast<uint8_t>(j + bank_origin);  // hardware laser number
-      LaserCorrection& corrections =
-          calibration_.laser_corrections_[laser_number];
+      const LaserCorrection& corrections = corrections_[laser_number];
 
       union RawDistance raw_distance;
       raw_distance.bytes[0] = raw->blocks[i].data[k];
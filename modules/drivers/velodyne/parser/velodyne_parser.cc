@@ -14,6 +14,8 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+
 #include "cyber/cyber.h"
 
 #include "modules/drivers/velodyne/parser/util.h"
@@ -23,6 +25,25 @@ namespace apollo {
 namespace drivers {
 namespace velodyne {
 
+namespace {
+
+struct RotationTable {
+  RotationTable() {
+    init_sin_cos_rot_table(sin_rot, cos_rot, ROTATION_MAX_UNITS,
+                           ROTATION_RESOLUTION);
+  }
+
+  float sin_rot[ROTATION_MAX_UNITS];
+  float cos_rot[ROTATION_MAX_UNITS];
+};
+
+const RotationTable& GetRotationTable() {
+  static const RotationTable table;
+  return table;
+}
+
+}  // namespace
+
 uint64_t VelodyneParser::GetGpsStamp(double current_packet_stamp,
                                      double *previous_packet_stamp,
                                      uint64_t *gps_base_usec) {
@@ -101,8 +122,25 @@ void VelodyneParser::setup() {
 
   // setup angle parameters.
   init_angle_params(config_.view_direction(), config_.view_width());
-  init_sin_cos_rot_table(sin_rot_table_, cos_rot_table_, ROTATION_MAX_UNITS,
-                         ROTATION_RESOLUTION);
+  const RotationTable& table = GetRotationTable();
+  sin_rot_table_ = table.sin_rot;
+  cos_rot_table_ = table.cos_rot;
+  UpdateCorrections();
+}
+
+void VelodyneParser::UpdateCorrections() {
+  int size = MAX_LASER_NUM;
+  if (!calibration_.laser_corrections_.empty()) {
+    size = std::max(size, calibration_.laser_corrections_.rbegin()->first + 1);
+  }
+  // lasers missing from the calibration get zero corrections, the same as
+  // looking them up in the map would add
+  corrections_.assign(size, LaserCorrection());
+  for (const auto& correction : calibration_.laser_corrections_) {
+    if (correction.first >= 0) {
+      corrections_[correction.first] = correction.second;
+    }
+  }
 }
 
 bool VelodyneParser::is_scan_valid(int rotation, float range) {
@@ -56,9 +56,12 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/format.hpp>
 
+#include "Eigen/Core"
+
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/drivers/velodyne/parser/calibration.h"
 #include "modules/drivers/velodyne/parser/const_variables.h"
@@ -99,6 +102,9 @@ static const float ROTATION_RESOLUTION = 0.01f; /**< degrees */
 // because angle_rang is [0, 36000], so the size is 36001
 static const uint16_t ROTATION_MAX_UNITS = 36001; /**< hundredths of degrees */
 
+/** the laser ids of all the models are below this */
+static const int MAX_LASER_NUM = 128;
+
 /** According to Bruce Hall DISTANCE_MAX is 65.0, but we noticed
  *  valid packets with readings up to 130.0. */
 static const float DISTANCE_MAX = 130.0f;        /**< meters */
@@ -250,8 +256,12 @@ class VelodyneParser {
   const float (*inner_time_)[12][32];
 
   Calibration calibration_;
-  float sin_rot_table_[ROTATION_MAX_UNITS];
-  float cos_rot_table_[ROTATION_MAX_UNITS];
+  // calibration_ indexed by laser id, the conversion loops look corrections
+  // up here instead of searching the map
+  std::vector<LaserCorrection> corrections_;
+  // the rotation tables are computed once and shared by all parsers
+  const float* sin_rot_table_ = nullptr;
+  const float* cos_rot_table_ = nullptr;
   double last_time_stamp_;
   Config config_;
   // Last Velodyne packet time stamp. (Full time)
@@ -260,6 +270,10 @@ class VelodyneParser {
 
   PointXYZIT get_nan_point(uint64_t timestamp);
   void init_angle_params(double view_direction, double view_width);
+  /**
+   * \brief Rebuild corrections_ after calibration_ changed
+   */
+  void UpdateCorrections();
   /**
    * \brief Compute coords with the data in block
    *
@@ -353,19 +367,43 @@ class Velodyne16Parser : public VelodyneParser {
 
 class Velodyne128Parser : public VelodyneParser {
  public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   explicit Velodyne128Parser(const Config& config);
   ~Velodyne128Parser() {}
 
   void GeneratePointcloud(const std::shared_ptr<VelodyneScan>& scan_msg,
                           std::shared_ptr<PointCloud> out_msg);
   void Order(std::shared_ptr<PointCloud> cloud);
+  void setup() override;
 
  private:
+  using ChannelArray = Eigen::Array<float, SCANS_PER_BLOCK, 1>;
+  using ChannelIntArray = Eigen::Array<int, SCANS_PER_BLOCK, 1>;
+
+  // The corrections of the channels fired in one block, laid out as arrays
+  // over the channels so that a whole block is decoded with vector math.
+  struct BlockCorrections {
+    ChannelArray dist_correction;
+    ChannelArray cos_rot_correction;
+    ChannelArray sin_rot_correction;
+    ChannelArray cos_vert_correction;
+    ChannelArray sin_vert_correction;
+    ChannelArray horiz_offset_correction;
+    ChannelArray vert_offset_correction;
+    ChannelArray focal_offset;
+    ChannelArray focal_slope;
+    ChannelIntArray min_intensity;
+    ChannelIntArray max_intensity;
+  };
+  static const int kBlockGroups = 4;
+
   uint64_t GetTimestamp(double base_time, float time_offset,
                         uint16_t laser_block_id);
   void Unpack(const VelodynePacket& pkt, std::shared_ptr<PointCloud> pc);
-  int IntensityCompensate(const LaserCorrection& corrections,
-                          const uint16_t raw_distance, int intensity);
+  void InitBlockCorrections();
+
+  BlockCorrections block_corrections_[kBlockGroups];
   // Previous Velodyne packet time stamp. (offset to the top hour)
   double previous_packet_stamp_;
   uint64_t gps_base_usec_;  // full time
@@ -40,10 +40,21 @@ bool CameraDriver::PollByFrame(std::shared_ptr<CompressedImage> h265Pb) {
   h265Pb->set_frame_id(config_.frame_id());
   uint64_t camera_timestamp = h265Pb->mutable_header()->camera_timestamp();
   uint64_t current_time = cyber::Time().Now().ToNanosecond();
-  AINFO << "Get frame from port: " << config_.udp_port()
-        << ", size: " << h265Pb->data().size() << ", ts: camera/host "
-        << camera_timestamp << "/" << current_time << ", diff: "
-        << static_cast<double>(current_time - camera_timestamp) * 1e-6;
+  ADEBUG << "Get frame from port: " << config_.udp_port()
+         << ", size: " << h265Pb->data().size() << ", ts: camera/host "
+         << camera_timestamp << "/" << current_time << ", diff: "
+         << static_cast<double>(current_time - camera_timestamp) * 1e-6;
+
+  // Per camera statistics, logged once every kStatisticsFrames frames
+  static constexpr int kStatisticsFrames = 100;
+  latency_sum_ += static_cast<double>(current_time - camera_timestamp);
+  if (++frame_count_ == kStatisticsFrames) {
+    AINFO << "Port: " << config_.udp_port() << ", average latency ms: "
+          << latency_sum_ / frame_count_ * 1e-6
+          << ", jitter ms: " << input_->Jitter() * 1e-6;
+    frame_count_ = 0;
+    latency_sum_ = 0.0;
+  }
 
   return true;
 }
@@ -38,11 +38,16 @@ class CameraDriver {
   void Init();
   int Port() { return config_.udp_port(); }
   int Record() { return config_.record(); }
+  uint64_t FrameReceiveTime() const { return input_->FrameReceiveTime(); }
 
  protected:
   CameraH265Config config_;
   std::shared_ptr<SocketInput> input_;
   bool PollByFrame(std::shared_ptr<CompressedImage> h265);
+
+ private:
+  int frame_count_ = 0;
+  double latency_sum_ = 0.0;
 };
 
 }  // namespace video
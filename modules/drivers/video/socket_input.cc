@@ -21,7 +21,9 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <cstdlib>
 #include <memory>
 
 #include "cyber/cyber.h"
@@ -41,22 +43,10 @@ namespace video {
  *  @param private_nh private node handle for driver
  *  @param udpport UDP port number to connect
  */
-SocketInput::SocketInput() : sockfd_(-1), port_(0) {
-  pkg_num_ = 0;
-  bytes_num_ = 0;
-  frame_id_ = 0;
-}
+SocketInput::SocketInput() : sockfd_(-1), port_(0) { frame_id_ = 0; }
 
 /** @brief destructor */
-SocketInput::~SocketInput() {
-  if (buf_) {
-    delete[] buf_;
-  }
-  if (pdu_) {
-    delete[] pdu_;
-  }
-  (void)close(sockfd_);
-}
+SocketInput::~SocketInput() { (void)close(sockfd_); }
 
 void SocketInput::Init(uint32_t port) {
   if (sockfd_ != -1) {
@@ -96,59 +86,88 @@ void SocketInput::Init(uint32_t port) {
     AERROR << "Failed to enable socket reuseable address.";
   }
 
-  buf_ = new uint8_t[H265_FRAME_PACKAGE_SIZE];
-  if (!buf_) {
-    AERROR << "Failed to allocate H265 frame package buffer.";
+  // One recvmmsg takes up to a batch of packets into the ring.
+  ring_.resize(H265_RECV_BATCH_SIZE * H265_PDU_SIZE);
+  msgs_.resize(H265_RECV_BATCH_SIZE);
+  iovecs_.resize(H265_RECV_BATCH_SIZE);
+  for (int i = 0; i < H265_RECV_BATCH_SIZE; ++i) {
+    iovecs_[i].iov_base = &ring_[i * H265_PDU_SIZE];
+    iovecs_[i].iov_len = H265_PDU_SIZE;
+    memset(&msgs_[i], 0, sizeof(mmsghdr));
+    msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+    msgs_[i].msg_hdr.msg_iovlen = 1;
   }
-  pdu_ = new uint8_t[H265_PDU_SIZE];
-  if (!pdu_) {
-    AERROR << "Failed to allocate H265 PDU buffer.";
-  }
-  // _metric_controller->Init();
+  ring_count_ = 0;
+  ring_index_ = 0;
   AINFO << "Camera socket fd: " << sockfd_ << ", port: " << port_;
 }
 
+int SocketInput::ReceiveBatch() {
+  int count = recvmmsg(sockfd_, msgs_.data(), H265_RECV_BATCH_SIZE,
+                       MSG_DONTWAIT, nullptr);
+  if (count < 0) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR) {
+      return 0;
+    }
+    AERROR << "Failed to receive package from port: " << port_;
+    return RECIEVE_FAIL;
+  }
+  ring_count_ = count;
+  ring_index_ = 0;
+  ring_time_ = cyber::Time::Now().ToNanosecond();
+  return count;
+}
+
 /** @brief Get one camera packet. */
 int SocketInput::GetFramePacket(std::shared_ptr<CompressedImage> h265Pb) {
-  uint8_t *frame_data = &buf_[0];
-  uint8_t *pdu_data = &pdu_[0];
-  int total = 0;
-  int pkg_len = 0;
+  // The frame is assembled right in the message, the only copy of the data.
+  std::string *frame = h265Pb->mutable_data();
   size_t frame_len = 0;
-  uint16_t pre_seq = 0;
+  size_t received = 0;
 
   do {
-    if (!InputAvailable(POLL_TIMEOUT)) {
-      return SOCKET_TIMEOUT;
-    }
-    // Receive packets that should now be available from the socket using
-    // a blocking read.
-    ssize_t pdu_len = recvfrom(sockfd_, pdu_data, H265_PDU_SIZE, 0, NULL, NULL);
-    if (pdu_len < 0) {
-      if (errno != EWOULDBLOCK) {
-        AERROR << "Failed to receive package from port: " << port_;
+    if (ring_index_ >= ring_count_) {
+      if (!InputAvailable(POLL_TIMEOUT)) {
+        return SOCKET_TIMEOUT;
+      }
+      const int count = ReceiveBatch();
+      if (count < 0) {
         return RECIEVE_FAIL;
       }
+      if (count == 0) {
+        continue;
+      }
+    }
+    const uint8_t *pdu_data = &ring_[ring_index_ * H265_PDU_SIZE];
+    const size_t pdu_len = msgs_[ring_index_].msg_len;
+    ++ring_index_;
+    if (pdu_len < sizeof(RtpHeader)) {
+      AERROR << "Error! port: " << port_ << ", short package: " << pdu_len;
+      continue;
     }
 
-    AINFO << "Received pdu length: " << pdu_len << " from port: " << port_;
-    HwPduPacket *pdu_pkg = reinterpret_cast<HwPduPacket *>(&pdu_[0]);
+    ADEBUG << "Received pdu length: " << pdu_len << " from port: " << port_;
+    const HwPduPacket *pdu_pkg =
+        reinterpret_cast<const HwPduPacket *>(pdu_data);
     uint16_t local_seq = ntohs(pdu_pkg->rtp_header.seq);
-    AINFO << "Package seq number: " << local_seq;
-    if (local_seq - pre_seq != 1 && pre_seq > 1 && local_seq > 0) {
+    ADEBUG << "Package seq number: " << local_seq;
+    if (static_cast<uint16_t>(local_seq - pre_seq_) != 1 && pre_seq_ > 1 &&
+        local_seq > 0) {
       AERROR << "Error! port: " << port_
              << ", package sequence is wrong. curent/pre " << local_seq << "/"
-             << pre_seq;
+             << pre_seq_;
     }
-    pre_seq = local_seq;
+    pre_seq_ = local_seq;
 
-    if (ntohl(pdu_pkg->header.magic0) == HW_CAMERA_MAGIC0 &&
+    if (pdu_len >= sizeof(HwPduPacket) &&
+        ntohl(pdu_pkg->header.magic0) == HW_CAMERA_MAGIC0 &&
         ntohl(pdu_pkg->header.magic1) == HW_CAMERA_MAGIC1) {
       // Receive camera frame head
-      if (total) {
-        AERROR << "Error! lost package for last frame, left bytes: " << total;
+      if (received < frame_len) {
+        AERROR << "Error! lost package for last frame, left bytes: "
+               << frame_len - received;
       }
-      AINFO << "Received new frame from port: " << port_;
+      ADEBUG << "Received new frame from port: " << port_;
 
       uint32_t frame_id = ntohl(pdu_pkg->header.frame_id);
       if (frame_id - frame_id_ != 1 && frame_id_ > 1 && frame_id > 1) {
@@ -160,39 +179,48 @@ int SocketInput::GetFramePacket(std::shared_ptr<CompressedImage> h265Pb) {
 
       cyber::Time image_time(ntohl(pdu_pkg->header.ts_sec),
                              1000 * ntohl(pdu_pkg->header.ts_usec));
-      // AINFO << "image_time second: " << ntohl(pdu_pkg->header.ts_sec) <<
-      // " usec: " << ntohl(pdu_pkg->header.ts_usec);
       uint64_t camera_timestamp = image_time.ToNanosecond();
       h265Pb->mutable_header()->set_camera_timestamp(camera_timestamp);
       h265Pb->set_measurement_time(image_time.ToSecond());
       h265Pb->set_format("h265");
       h265Pb->set_frame_type(static_cast<int>(pdu_pkg->header.frame_type));
-      AINFO << "Port: " << port_
-            << ", received frame size: " << ntohl(pdu_pkg->header.frame_size)
-            << ", frame type: " << static_cast<int>(pdu_pkg->header.frame_type)
-            << ", PhyNo: " << static_cast<int>(pdu_pkg->header.PhyNo)
-            << ", frame id: " << frame_id;
+      ADEBUG << "Port: " << port_
+             << ", received frame size: " << ntohl(pdu_pkg->header.frame_size)
+             << ", frame type: "
+             << static_cast<int>(pdu_pkg->header.frame_type)
+             << ", PhyNo: " << static_cast<int>(pdu_pkg->header.PhyNo)
+             << ", frame id: " << frame_id;
 
       frame_len = ntohl(pdu_pkg->header.frame_size);
-      total = static_cast<int>(frame_len);
-      frame_data = &buf_[0];
+      if (frame_len > H265_FRAME_PACKAGE_SIZE) {
+        AERROR << "Error! port: " << port_ << ", frame too large: "
+               << frame_len;
+        frame_len = 0;
+      }
+      // resize keeps the capacity of the earlier frames
+      frame->resize(frame_len);
+      received = 0;
+      frame_receive_time_ = ring_time_;
       continue;
     }
     // Receive camera frame data
-    if (total > 0) {
-      pkg_len = static_cast<int>(pdu_len - sizeof(RtpHeader));
-      memcpy(frame_data, pdu_data + sizeof(RtpHeader), pkg_len);
-      total -= pkg_len;
-      frame_data += pkg_len;
-      // AINFO << "receive pkg data " << pkg_len << "/" << total << "/"
-      // << frame_len;
+    if (received < frame_len) {
+      const size_t pkg_len =
+          std::min(pdu_len - sizeof(RtpHeader), frame_len - received);
+      memcpy(&(*frame)[received], pdu_data + sizeof(RtpHeader), pkg_len);
+      received += pkg_len;
     }
-    if (total <= 0) {
-      total = 0;
-      // AINFO << "receive frame data " << pkg_len << "/" << total << "/"
-      // << frame_len;
+    if (received >= frame_len) {
       if (frame_len > 0) {
-        h265Pb->set_data(buf_, frame_len);
+        const int64_t transit =
+            static_cast<int64_t>(frame_receive_time_) -
+            static_cast<int64_t>(h265Pb->header().camera_timestamp());
+        if (last_transit_ != 0) {
+          jitter_ += (std::abs(static_cast<double>(transit - last_transit_)) -
+                      jitter_) /
+                     16.0;
+        }
+        last_transit_ = transit;
         break;
       }
       AERROR << "Error! frame info is wrong. frame length: " << frame_len;
@@ -16,12 +16,14 @@
 
 #pragma once
 
+#include <sys/socket.h>
 #include <unistd.h>
 
 #include <cstdio>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cyber/cyber.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
@@ -35,6 +37,7 @@ static const int RECIEVE_FAIL = -3;
 static const int POLL_TIMEOUT = 1000;  // one second (in msec)
 static const size_t H265_FRAME_PACKAGE_SIZE = 4 * 1024 * 1024;
 static const size_t H265_PDU_SIZE = 1500;
+static const int H265_RECV_BATCH_SIZE = 64;
 
 /** @brief Live Velodyne input from socket. */
 class SocketInput {
@@ -44,15 +47,33 @@ class SocketInput {
   void Init(uint32_t port);
   int GetFramePacket(std::shared_ptr<CompressedImage> h265);
 
+  // Host time in ns when the first packet of the last frame was received.
+  uint64_t FrameReceiveTime() const { return frame_receive_time_; }
+  // Interarrival jitter in ns of the frames, estimated as in RFC 3550 from
+  // the camera timestamps and the host receive times.
+  double Jitter() const { return jitter_; }
+
  private:
   int sockfd_;
   int port_;
-  uint8_t *buf_ = nullptr;
-  uint8_t *pdu_ = nullptr;
-  int pkg_num_;
-  int bytes_num_;
   uint32_t frame_id_;
+  uint16_t pre_seq_ = 0;
   bool InputAvailable(int timeout);
+  // Returns the number of packets received, 0 if none was ready.
+  int ReceiveBatch();
+
+  // Packets taken by the last recvmmsg, the ones from ring_index_ on are not
+  // handled yet.
+  std::vector<uint8_t> ring_;
+  std::vector<mmsghdr> msgs_;
+  std::vector<iovec> iovecs_;
+  int ring_count_ = 0;
+  int ring_index_ = 0;
+  uint64_t ring_time_ = 0;
+
+  uint64_t frame_receive_time_ = 0;
+  int64_t last_transit_ = 0;
+  double jitter_ = 0.0;
 };
 
 }  // namespace video
@@ -54,6 +54,8 @@ bool CompCameraH265Compressed::Init() {
 
   writer_ = node_->CreateWriter<CompressedImage>(
       video_config.compress_conf().output_channel());
+  latency_recorder_.reset(new apollo::common::LatencyRecorder(
+      video_config.compress_conf().output_channel()));
 
   runing_ = true;
   video_thread_ = std::shared_ptr<std::thread>(
@@ -89,8 +91,12 @@ void CompCameraH265Compressed::VideoPoll() {
     poll_failure_number = 0;
     pb_image_->mutable_header()->set_timestamp_sec(
         cyber::Time::Now().ToSecond());
-    AINFO << "Send compressed image.";
+    ADEBUG << "Send compressed image.";
     writer_->Write(pb_image_);
+    // From the first packet of the frame to its publishing
+    latency_recorder_->AppendLatencyRecord(
+        pb_image_->header().camera_timestamp(),
+        cyber::Time(camera_deivce_->FrameReceiveTime()), cyber::Time::Now());
 
     if (camera_deivce_->Record()) {
       fout.write(pb_image_->data().c_str(), pb_image_->data().size());
@@ -22,6 +22,7 @@
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
+#include "modules/common/latency_recorder/latency_recorder.h"
 #include "modules/drivers/proto/sensor_image.pb.h"
 #include "modules/drivers/video/driver.h"
 #include "modules/drivers/video/proto/video_h265cfg.pb.h"
@@ -53,6 +54,7 @@ class CompCameraH265Compressed : public Component<> {
   std::unique_ptr<CameraDriver> camera_deivce_;
   std::string record_folder_;
   std::shared_ptr<CompressedImage> pb_image_ = nullptr;
+  std::unique_ptr<apollo::common::LatencyRecorder> latency_recorder_;
 };
 
 CYBER_REGISTER_COMPONENT(CompCameraH265Compressed);
@@ -60,6 +60,14 @@ bool GuardianComponent::Init() {
 
   guardian_writer_ = node_->CreateWriter<GuardianCommand>(FLAGS_guardian_topic);
 
+  // more than the readers may hold at once, Proc() falls back to the heap
+  // when they run out
+  constexpr uint32_t kGuardianCmdPoolSize = 16;
+  guardian_cmd_pool_ =
+      std::make_shared<cyber::base::CCObjectPool<GuardianCommand>>(
+          kGuardianCmdPoolSize);
+  guardian_cmd_pool_->ConstructAll();
+
   return true;
 }
 
@@ -86,7 +94,12 @@ bool GuardianComponent::Proc() {
   }
 
   common::util::FillHeader(node_->Name(), &guardian_cmd_);
-  guardian_writer_->Write(guardian_cmd_);
+  auto guardian_cmd = guardian_cmd_pool_->GetObject();
+  if (guardian_cmd == nullptr) {
+    guardian_cmd = std::make_shared<GuardianCommand>();
+  }
+  guardian_cmd->CopyFrom(guardian_cmd_);
+  guardian_writer_->Write(guardian_cmd);
   return true;
 }
 
@@ -22,6 +22,7 @@
 
 #include <memory>
 
+#include "cyber/base/concurrent_object_pool.h"
 #include "cyber/common/macros.h"
 #include "cyber/component/timer_component.h"
 #include "cyber/cyber.h"
@@ -64,6 +65,11 @@ class GuardianComponent : public apollo::cyber::TimerComponent {
       system_status_reader_;
   std::shared_ptr<apollo::cyber::Writer<apollo::guardian::GuardianCommand>>
       guardian_writer_;
+  // commands are copied into preallocated messages, so a steady state Proc()
+  // does not allocate
+  std::shared_ptr<apollo::cyber::base::CCObjectPool<
+      apollo::guardian::GuardianCommand>>
+      guardian_cmd_pool_;
 
   std::mutex mutex_;
 };
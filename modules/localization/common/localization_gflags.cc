@@ -75,6 +75,15 @@ DEFINE_double(lidar_imu_max_delay_time, 0.4,
               "Lidar msg and imu msg max delay time");
 DEFINE_double(lidar_map_coverage_theshold, 0.9,
               "Threshold to detect whether vehicle is out of map");
+DEFINE_double(lidar_map_preload_lookahead_time, 0.0,
+              "Seconds of motion to preload the map nodes ahead along the "
+              "velocity, 0 preloads a fixed neighbourhood");
+DEFINE_int32(lidar_map_preload_max_nodes, 0,
+             "The most map nodes preloaded ahead at once, 0 for the capacity "
+             "of the map node cache");
+DEFINE_int32(lidar_map_cache_size_mb, 0,
+             "Megabytes of loaded map nodes, the map node pool and cache are "
+             "sized to it, 0 for the fixed node count");
 DEFINE_bool(lidar_debug_log_flag, false, "Lidar Debug switch.");
 DEFINE_int32(point_cloud_step, 2, "Point cloud step");
 DEFINE_bool(if_use_avx, false,
@@ -112,6 +121,15 @@ DEFINE_bool(if_utm_zone_id_from_folder, true,
 DEFINE_bool(trans_gpstime_to_utctime, true, "");
 DEFINE_int32(gnss_mode, 0, "GNSS Mode, 0 for bestgnss pose, 1 for self gnss.");
 DEFINE_bool(imu_coord_rfu, true, "Right/forward/up");
+DEFINE_int32(msf_imu_queue_size, 0,
+             "imu messages queued for the localization timer, which "
+             "integrates all of them, 0 keeps only the latest one");
+DEFINE_bool(msf_imu_process_on_arrival, false,
+            "integrate and publish each imu message in the reader callback "
+            "instead of the localization timer");
+DEFINE_string(msf_imu_latency_topic, "",
+              "topic for the imu receipt to pose output latency histogram, "
+              "empty to not publish it");
 DEFINE_bool(gnss_only_init, false,
             "Whether use bestgnsspose as measure after initializaiton.");
 DEFINE_bool(enable_lidar_localization, true,
@@ -181,6 +199,11 @@ DEFINE_double(ndt_transformation_epsilon, 0.01,
               "iteration convergence condition on transformation");
 DEFINE_int32(ndt_filter_size_x, 48, "x size for ndt searching area");
 DEFINE_int32(ndt_filter_size_y, 48, "y size for ndt searching area");
+DEFINE_int32(ndt_num_threads, 1,
+             "threads to accumulate the ndt score derivatives with");
+DEFINE_string(ndt_neighbor_search_method, "kdtree",
+              "how ndt finds the target voxels near a point: kdtree, "
+              "direct7 (voxel and face neighbors) or direct1 (voxel only)");
 DEFINE_int32(ndt_bad_score_count_threshold, 10,
              "count for continuous bad ndt fitness score");
 DEFINE_double(ndt_warnning_ndt_score, 1.0,
@@ -56,6 +56,9 @@ DECLARE_int32(lidar_yaw_align_mode);
 DECLARE_int32(lidar_filter_size);
 DECLARE_double(lidar_imu_max_delay_time);
 DECLARE_double(lidar_map_coverage_theshold);
+DECLARE_double(lidar_map_preload_lookahead_time);
+DECLARE_int32(lidar_map_preload_max_nodes);
+DECLARE_int32(lidar_map_cache_size_mb);
 DECLARE_bool(lidar_debug_log_flag);
 DECLARE_int32(point_cloud_step);
 DECLARE_bool(if_use_avx);
@@ -88,6 +91,9 @@ DECLARE_bool(if_utm_zone_id_from_folder);
 DECLARE_bool(trans_gpstime_to_utctime);
 DECLARE_int32(gnss_mode);
 DECLARE_bool(imu_coord_rfu);
+DECLARE_int32(msf_imu_queue_size);
+DECLARE_bool(msf_imu_process_on_arrival);
+DECLARE_string(msf_imu_latency_topic);
 DECLARE_bool(gnss_only_init);
 DECLARE_bool(enable_lidar_localization);
 
@@ -134,6 +140,8 @@ DECLARE_double(ndt_line_search_step_size);
 DECLARE_double(ndt_transformation_epsilon);
 DECLARE_int32(ndt_filter_size_x);
 DECLARE_int32(ndt_filter_size_y);
+DECLARE_int32(ndt_num_threads);
+DECLARE_string(ndt_neighbor_search_method);
 DECLARE_int32(ndt_bad_score_count_threshold);
 DECLARE_double(ndt_warnning_ndt_score);
 DECLARE_double(ndt_error_ndt_score);
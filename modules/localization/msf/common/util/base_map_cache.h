@@ -16,6 +16,7 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <utility>
 #include "cyber/common/log.h"
 
@@ -28,11 +29,24 @@ namespace msf {
 template <class Key, class Element>
 using LRUCache = ::apollo::common::util::LRUCache<Key, Element*>;
 
+/**@brief The statistics of a map node cache. */
+struct MapNodeCacheStatistics {
+  /**@brief The lookups by Get which found the element. */
+  size_t hit_count = 0;
+  /**@brief The lookups by Get which didn't find the element. */
+  size_t miss_count = 0;
+  /**@brief The elements in the cache. */
+  size_t size = 0;
+  /**@brief The summed cost of the elements in the cache. */
+  size_t resident_cost = 0;
+};
+
 /**@brief The data structure of the LRUCache. */
 template <class Key, class Element, class MapLRUCache = LRUCache<Key, Element>>
 class MapNodeCache {
  public:
   using DestroyFunc = std::function<bool(Element*)>;
+  using CostFunc = std::function<size_t(Element*)>;
   static bool CacheL1Destroy(Element* value) {
     value->SetIsReserved(false);
     return true;
@@ -78,6 +92,17 @@ class MapNodeCache {
   /**@brief return cache's max capacity. */
   unsigned Capacity() { return lru_map_nodes_.capacity(); }
 
+  /**@brief Bound the summed cost of the elements besides their count, the
+   * cost of an element is taken when it is put. Zero max_cost bounds the
+   * count only. */
+  void SetCostBudget(size_t max_cost, const CostFunc& cost_func);
+  /**@brief Remove the least recently used element which can be removed,
+   * if the summed cost is over the budget. The most recently used element is
+   * always kept. Return the removed element or null. */
+  Element* ClearOneOverBudget();
+  /**@brief Return the hits, misses and the resident cost so far. */
+  MapNodeCacheStatistics GetStatistics();
+
  private:
   /**@brief do something before remove an element from cache.
    * Return true if the element can be removed. Return false if the element
@@ -85,6 +110,17 @@ class MapNodeCache {
    * remove. */
   const DestroyFunc destroy_func_;
   MapLRUCache lru_map_nodes_;
+
+  /**@brief Account the cost of an element put for key. */
+  void AddCost(const Key& key, Element* value);
+  /**@brief Forget the cost of the element for key. */
+  void RemoveCost(const Key& key);
+
+  CostFunc cost_func_;
+  size_t max_cost_ = 0;
+  /**@brief The cost of every element, only kept with a cost_func_. */
+  std::map<Key, size_t> element_costs_;
+  MapNodeCacheStatistics statistics_;
 };
 
 template <class Key, class Element, class MapLRUCache>
@@ -92,8 +128,10 @@ bool MapNodeCache<Key, Element, MapLRUCache>::Get(const Key& key,
                                                   Element** value) {
   auto value_ptr = lru_map_nodes_.Get(key);
   if (!value_ptr) {
+    ++statistics_.miss_count;
     return false;
   }
+  ++statistics_.hit_count;
   *value = *value_ptr;
   return true;
 }
@@ -123,6 +161,7 @@ Element* MapNodeCache<Key, Element, MapLRUCache>::Put(const Key& key,
     node_remove = *value_ptr;
     if (destroy_func_(node_remove)) {
       *value_ptr = value;
+      AddCost(key, value);
     } else {
       node_remove = value;
     }
@@ -134,21 +173,26 @@ Element* MapNodeCache<Key, Element, MapLRUCache>::Put(const Key& key,
     node_remove = node->val;
     Key key_tmp;
     lru_map_nodes_.PutAndGetObsolete(key, &value, &key_tmp);
+    RemoveCost(key_tmp);
+    AddCost(key, value);
     return node_remove;
   }
 
-  lru_map_nodes_.Put(key, std::move(value));
+  lru_map_nodes_.Put(key, value);
+  AddCost(key, value);
   return node_remove;
 }
 
 template <class Key, class Element, class MapLRUCache>
 Element* MapNodeCache<Key, Element, MapLRUCache>::Remove(const Key& key) {
-  auto* node_remove = lru_map_nodes_.GetSilently(key);
-  if (node_remove && lru_map_nodes_.Remove(key)) {
-    return *node_remove;
+  auto* value_ptr = lru_map_nodes_.GetSilently(key);
+  if (!value_ptr) {
+    return nullptr;
   }
-
-  return nullptr;
+  Element* node_remove = *value_ptr;
+  lru_map_nodes_.Remove(key);
+  RemoveCost(key);
+  return node_remove;
 }
 
 template <class Key, class Element, class MapLRUCache>
@@ -159,19 +203,81 @@ Element* MapNodeCache<Key, Element, MapLRUCache>::ClearOne() {
   }
   while (node_remove != lru_map_nodes_.First()) {
     if (destroy_func_(node_remove->val)) {
-      lru_map_nodes_.Remove(node_remove->key);
-      return node_remove->val;
+      return Remove(node_remove->key);
     }
     node_remove = node_remove->prev;
   }
   if (node_remove == lru_map_nodes_.First() &&
       destroy_func_(node_remove->val)) {
-    lru_map_nodes_.Remove(node_remove->key);
-    return node_remove->val;
+    return Remove(node_remove->key);
+  }
+  return nullptr;
+}
+
+template <class Key, class Element, class MapLRUCache>
+void MapNodeCache<Key, Element, MapLRUCache>::SetCostBudget(
+    size_t max_cost, const CostFunc& cost_func) {
+  max_cost_ = max_cost;
+  cost_func_ = cost_func;
+  element_costs_.clear();
+  statistics_.resident_cost = 0;
+  if (!cost_func_) {
+    return;
+  }
+  for (auto* node = lru_map_nodes_.First(); node != nullptr;
+       node = node->next) {
+    AddCost(node->key, node->val);
+    if (node == lru_map_nodes_.Last()) {
+      break;
+    }
+  }
+}
+
+template <class Key, class Element, class MapLRUCache>
+Element* MapNodeCache<Key, Element, MapLRUCache>::ClearOneOverBudget() {
+  if (max_cost_ == 0 || statistics_.resident_cost <= max_cost_) {
+    return nullptr;
+  }
+  auto* node_remove = lru_map_nodes_.Last();
+  while (node_remove != nullptr && node_remove != lru_map_nodes_.First()) {
+    if (destroy_func_(node_remove->val)) {
+      return Remove(node_remove->key);
+    }
+    node_remove = node_remove->prev;
   }
   return nullptr;
 }
 
+template <class Key, class Element, class MapLRUCache>
+MapNodeCacheStatistics
+MapNodeCache<Key, Element, MapLRUCache>::GetStatistics() {
+  MapNodeCacheStatistics statistics = statistics_;
+  statistics.size = lru_map_nodes_.size();
+  return statistics;
+}
+
+template <class Key, class Element, class MapLRUCache>
+void MapNodeCache<Key, Element, MapLRUCache>::AddCost(const Key& key,
+                                                     Element* value) {
+  if (!cost_func_) {
+    return;
+  }
+  RemoveCost(key);
+  const size_t cost = cost_func_(value);
+  element_costs_[key] = cost;
+  statistics_.resident_cost += cost;
+}
+
+template <class Key, class Element, class MapLRUCache>
+void MapNodeCache<Key, Element, MapLRUCache>::RemoveCost(const Key& key) {
+  auto itr = element_costs_.find(key);
+  if (itr == element_costs_.end()) {
+    return;
+  }
+  statistics_.resident_cost -= itr->second;
+  element_costs_.erase(itr);
+}
+
 template <class Key, class Element, class MapLRUCache>
 bool MapNodeCache<Key, Element, MapLRUCache>::IsExist(const Key& key) {
   return lru_map_nodes_.Prioritize(key);
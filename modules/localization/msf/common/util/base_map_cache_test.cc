@@ -156,6 +156,49 @@ TEST_F(MapNodeCacheTest, PutOverCapacity) {
   EXPECT_EQ(map_node_cache_lvl_->IsExist(std::move(NodeIndex(4, 5))), true);
 }
 
+TEST_F(MapNodeCacheTest, CostBudget) {
+  map_node_cache_lvl_.reset(
+      new MapNodeCache<NodeIndex, NodeData>(4, destroy_func_lvl2_));
+  // two elements fit the budget, the cost of each is its name length
+  map_node_cache_lvl_->SetCostBudget(
+      6, [](NodeData* node) { return node->GetName().size(); });
+  map_node_cache_lvl_->Put(node_pool_[0].first, &(node_pool_[0].second));
+  map_node_cache_lvl_->Put(node_pool_[1].first, &(node_pool_[1].second));
+  EXPECT_EQ(map_node_cache_lvl_->ClearOneOverBudget(), nullptr);
+  EXPECT_EQ(map_node_cache_lvl_->GetStatistics().resident_cost, 6);
+
+  node_pool_[1].second.SetIsReserved(true);
+  map_node_cache_lvl_->Put(node_pool_[2].first, &(node_pool_[2].second));
+  EXPECT_EQ(map_node_cache_lvl_->GetStatistics().resident_cost, 9);
+  // the least recently used one which can be removed goes first
+  NodeData* node_data = nullptr;
+  map_node_cache_lvl_->Get(node_pool_[0].first, &node_data);
+  EXPECT_EQ(map_node_cache_lvl_->ClearOneOverBudget(),
+            &(node_pool_[2].second));
+  EXPECT_EQ(map_node_cache_lvl_->ClearOneOverBudget(), nullptr);
+  EXPECT_EQ(map_node_cache_lvl_->Size(), 2);
+  EXPECT_EQ(map_node_cache_lvl_->GetStatistics().resident_cost, 6);
+  EXPECT_EQ(map_node_cache_lvl_->IsExist(node_pool_[2].first), false);
+}
+
+TEST_F(MapNodeCacheTest, Statistics) {
+  map_node_cache_lvl_->Put(node_pool_[0].first, &(node_pool_[0].second));
+  NodeData* node_data = nullptr;
+  EXPECT_EQ(map_node_cache_lvl_->Get(node_pool_[0].first, &node_data), true);
+  EXPECT_EQ(map_node_cache_lvl_->Get(node_pool_[1].first, &node_data),
+            false);
+  MapNodeCacheStatistics statistics = map_node_cache_lvl_->GetStatistics();
+  EXPECT_EQ(statistics.hit_count, 1);
+  EXPECT_EQ(statistics.miss_count, 1);
+  EXPECT_EQ(statistics.size, 1);
+  EXPECT_EQ(statistics.resident_cost, 0);
+
+  map_node_cache_lvl_->Remove(node_pool_[0].first);
+  EXPECT_EQ(map_node_cache_lvl_->Get(node_pool_[0].first, &node_data),
+            false);
+  EXPECT_EQ(map_node_cache_lvl_->Size(), 0);
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_integ/localization_lidar.h"
 
+#include <algorithm>
+
 namespace apollo {
 namespace localization {
 namespace msf {
@@ -62,9 +64,29 @@ bool LocalizationLidar::Init(const std::string& map_path,
     LOG(FATAL) << "Reflectance map folder is invalid!";
     return false;
   }
+  const unsigned int cache_l1_size = 12;
+  unsigned int cache_l2_size = 24;
+  if (map_cache_byte_budget_ > 0) {
+    PyramidMapMatrix matrix;
+    matrix.Init(map_.GetMapConfig());
+    const size_t node_bytes = std::max<size_t>(matrix.GetMemorySize(), 1);
+    const size_t budget_nodes = map_cache_byte_budget_ / node_bytes;
+    // the reserved nodes of the level 1 cache are held by level 2 as well
+    if (budget_nodes <= cache_l1_size) {
+      AWARN << "Map cache budget of " << map_cache_byte_budget_
+            << " bytes fits " << budget_nodes << " map nodes of " << node_bytes
+            << " bytes, keep " << cache_l1_size + 1 << " nodes.";
+    }
+    cache_l2_size = static_cast<unsigned int>(
+        std::max<size_t>(budget_nodes, cache_l1_size + 1));
+    map_node_pool_.SetPoolSize(cache_l2_size + 1);
+    AINFO << "Map cache budget: " << map_cache_byte_budget_ << " bytes, "
+          << cache_l2_size << " map nodes of " << node_bytes << " bytes.";
+  }
   map_node_pool_.Initial(&(map_.GetMapConfig()));
-  map_.InitMapNodeCaches(12, 24);
+  map_.InitMapNodeCaches(cache_l1_size, cache_l2_size);
   map_.AttachMapNodePool(&map_node_pool_);
+  map_.SetMapNodeCacheByteBudget(map_cache_byte_budget_);
 
   // init locator
   node_size_x_ = map_.GetMapConfig().map_node_size_x_;
@@ -99,6 +121,21 @@ void LocalizationLidar::SetValidThreshold(float valid_threashold) {
   lidar_locator_->SetValidThreshold(valid_threashold);
 }
 
+void LocalizationLidar::SetMapPreloadPolicy(double lookahead_time,
+                                            int max_preload_nodes) {
+  pyramid_map::MapPreloadPolicy policy;
+  policy.lookahead_time = lookahead_time;
+  policy.max_preload_nodes =
+      static_cast<unsigned int>(std::max(max_preload_nodes, 0));
+  map_.SetPreloadPolicy(policy);
+  AINFO << "Map preload lookahead time: " << lookahead_time
+        << ", max preload nodes: " << max_preload_nodes;
+}
+
+void LocalizationLidar::SetMapCacheByteBudget(size_t max_bytes) {
+  map_cache_byte_budget_ = max_bytes;
+}
+
 void LocalizationLidar::SetImageAlignMode(int mode) {
   lidar_locator_->SetImageAlignMode(mode);
 }
@@ -138,6 +175,18 @@ int LocalizationLidar::Update(const unsigned int frame_idx,
   // preload map for next locate
   map_.PreloadMapArea(pose_trans, velocity, resolution_id_, zone_id_);
 
+  MapNodeCacheStatistics cache_l1_statistics;
+  MapNodeCacheStatistics cache_l2_statistics;
+  map_.GetMapNodeCacheStatistics(&cache_l1_statistics, &cache_l2_statistics);
+  AINFO_EVERY(100) << "Map node cache L1 hits: "
+                   << cache_l1_statistics.hit_count
+                   << ", misses: " << cache_l1_statistics.miss_count
+                   << ", L2 hits: " << cache_l2_statistics.hit_count
+                   << ", misses: " << cache_l2_statistics.miss_count
+                   << ", nodes: " << cache_l2_statistics.size
+                   << ", resident bytes: "
+                   << cache_l2_statistics.resident_cost;
+
   // generate composed map for compare
   ComposeMapNode(pose_trans);
 
@@ -355,19 +404,26 @@ void LocalizationLidar::ComposeMapNode(const Eigen::Vector3d& trans) {
       FloatMatrix* intensity_var_matrix = map_cells.GetIntensityVarMatrix(0);
       FloatMatrix* altitude_matrix = map_cells.GetAltitudeMatrix(0);
       UIntMatrix* count_matrix = map_cells.GetCountMatrix(0);
+      if (range_x <= 0) {
+        continue;
+      }
+      // the rows of a quadrant are contiguous in both the map node and the
+      // composed node, copy them whole instead of cell by cell
       for (int y = 0; y < range_y; ++y) {
-        int dst_base_x = (dst_y + y) * node_size_x_ + dst_x;
-        for (int x = 0; x < range_x; ++x) {
-          int dst_idx = dst_base_x + x;
-          lidar_map_node_->intensities[dst_idx] =
-              (*intensity_matrix)[src_y + y][src_x + x];
-          lidar_map_node_->intensities_var[dst_idx] =
-              (*intensity_var_matrix)[src_y + y][src_x + x];
-          lidar_map_node_->altitudes[dst_idx] =
-              (*altitude_matrix)[src_y + y][src_x + x];
-          lidar_map_node_->count[dst_idx] =
-              (*count_matrix)[src_y + y][src_x + x];
-        }
+        int dst_idx = (dst_y + y) * node_size_x_ + dst_x;
+        const float* src_intensity = (*intensity_matrix)[src_y + y] + src_x;
+        std::copy(src_intensity, src_intensity + range_x,
+                  lidar_map_node_->intensities + dst_idx);
+        const float* src_intensity_var =
+            (*intensity_var_matrix)[src_y + y] + src_x;
+        std::copy(src_intensity_var, src_intensity_var + range_x,
+                  lidar_map_node_->intensities_var + dst_idx);
+        const float* src_altitude = (*altitude_matrix)[src_y + y] + src_x;
+        std::copy(src_altitude, src_altitude + range_x,
+                  lidar_map_node_->altitudes + dst_idx);
+        const unsigned int* src_count = (*count_matrix)[src_y + y] + src_x;
+        std::copy(src_count, src_count + range_x,
+                  lidar_map_node_->count + dst_idx);
       }
     }
   }
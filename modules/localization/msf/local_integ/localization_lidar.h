@@ -98,6 +98,12 @@ class LocalizationLidar {
 
   void SetValidThreshold(float valid_threashold);
 
+  void SetMapPreloadPolicy(double lookahead_time, int max_preload_nodes);
+
+  /**@brief Bound the bytes of the loaded map nodes, the node pool and cache
+   * are sized to it. Call it before Init, zero keeps the fixed node count. */
+  void SetMapCacheByteBudget(size_t max_bytes);
+
   void SetImageAlignMode(int mode);
 
   void SetLocalizationMode(int mode);
@@ -134,6 +140,7 @@ class LocalizationLidar {
   PyramidMapConfig config_;
   PyramidMap map_;
   PyramidMapNodePool map_node_pool_;
+  size_t map_cache_byte_budget_ = 0;
   Eigen::Vector2d map_left_top_corner_;
   unsigned int resolution_id_ = 0;
   int zone_id_ = 50;
@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_integ/localization_lidar_process.h"
 
+#include <algorithm>
+
 #include "yaml-cpp/yaml.h"
 
 #include "cyber/common/file.h"
@@ -81,6 +83,9 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
   yaw_align_mode_ = params.lidar_yaw_align_mode;
   utm_zone_id_ = params.utm_zone_id;
   map_coverage_theshold_ = params.map_coverage_theshold;
+  map_preload_lookahead_time_ = params.map_preload_lookahead_time;
+  map_preload_max_nodes_ = params.map_preload_max_nodes;
+  map_cache_size_mb_ = params.map_cache_size_mb;
   imu_lidar_max_delay_time_ = params.imu_lidar_max_delay_time;
 
   lidar_filter_size_ = params.lidar_filter_size;
@@ -124,6 +129,8 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
     lidar_height_.height = params.lidar_height_default;
   }
 
+  locator_->SetMapCacheByteBudget(
+      static_cast<size_t>(std::max(map_cache_size_mb_, 0)) << 20);
   if (!locator_->Init(map_path_, lidar_filter_size_, lidar_filter_size_,
                       utm_zone_id_)) {
     local_lidar_status_ = LocalLidarStatus::MSF_LOCAL_LIDAR_MAP_LOADING_FAILED;
@@ -137,6 +144,8 @@ Status LocalizationLidarProcess::Init(const LocalizationIntegParam& params) {
   locator_->SetValidThreshold(static_cast<float>(map_coverage_theshold_));
   locator_->SetVehicleHeight(lidar_height_.height);
   locator_->SetDeltaPitchRollLimit(compensate_pitch_roll_limit_);
+  locator_->SetMapPreloadPolicy(map_preload_lookahead_time_,
+                                map_preload_max_nodes_);
 
   const double deg_to_rad = 0.017453292519943;
   const double max_gyro_input = 200 * deg_to_rad;  // 200 degree
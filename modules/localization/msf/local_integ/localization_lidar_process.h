@@ -122,6 +122,9 @@ class LocalizationLidarProcess {
   double compensate_pitch_roll_limit_ = 0.035;
   int utm_zone_id_ = 50;
   double map_coverage_theshold_ = 0.8;
+  double map_preload_lookahead_time_ = 0.0;
+  int map_preload_max_nodes_ = 0;
+  int map_cache_size_mb_ = 0;
   TransformD lidar_extrinsic_;
   LidarHeight lidar_height_;
 
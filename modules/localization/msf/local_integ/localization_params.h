@@ -85,6 +85,9 @@ struct LocalizationIntegParam {
   int lidar_yaw_align_mode = 2;
   int lidar_filter_size = 17;
   double map_coverage_theshold = 0.8;
+  double map_preload_lookahead_time = 0.0;
+  int map_preload_max_nodes = 0;
+  int map_cache_size_mb = 0;
   double imu_lidar_max_delay_time = 0.4;
   int utm_zone_id = 50;
   bool is_lidar_unstable_reset = true;
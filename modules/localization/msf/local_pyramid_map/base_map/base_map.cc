@@ -16,8 +16,10 @@
 
 #include "modules/localization/msf/local_pyramid_map/base_map/base_map.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -50,6 +52,20 @@ void BaseMap::InitMapNodeCaches(int cacheL1_size, int cahceL2_size) {
       cahceL2_size, destroy_func_lvl2_));
 }
 
+void BaseMap::SetMapNodeCacheByteBudget(size_t max_bytes) {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  map_node_cache_lvl2_->SetCostBudget(max_bytes, [](BaseMapNode* node) {
+    return node->GetMapCellMatrix().GetMemorySize();
+  });
+}
+
+void BaseMap::GetMapNodeCacheStatistics(MapNodeCacheStatistics* level1,
+                                        MapNodeCacheStatistics* level2) {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  *level1 = map_node_cache_lvl1_->GetStatistics();
+  *level2 = map_node_cache_lvl2_->GetStatistics();
+}
+
 void BaseMap::AttachMapNodePool(BaseMapNodePool* map_node_pool) {
   map_node_pool_ = map_node_pool;
 }
@@ -141,12 +157,22 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
     }
   }
   // check and update cache
+  const size_t needed_size = map_ids->size();
   CheckAndUpdateCache(map_ids);
+  {
+    boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+    preload_statistics_.hit_count += needed_size - map_ids->size();
+    preload_statistics_.miss_count += map_ids->size();
+    if (!map_ids->empty()) {
+      AERROR << "Preload map node failed! missed: " << map_ids->size()
+             << ", total hits: " << preload_statistics_.hit_count
+             << ", total misses: " << preload_statistics_.miss_count;
+    }
+  }
   // load from disk sync
   std::vector<std::future<void>> load_futures_;
   itr = map_ids->begin();
   while (itr != map_ids->end()) {
-    AERROR << "Preload map node failed!";
     load_futures_.emplace_back(
         cyber::Async(&BaseMap::LoadMapNodeThreadSafety, this, *itr, true));
     ++itr;
@@ -179,12 +205,19 @@ void BaseMap::CheckAndUpdateCache(std::set<MapNodeIndex>* map_ids) {
 }
 
 void BaseMap::PreloadMapNodes(std::set<MapNodeIndex>* map_ids) {
+  std::vector<MapNodeIndex> ordered_ids(map_ids->begin(), map_ids->end());
+  PreloadMapNodes(&ordered_ids);
+  map_ids->clear();
+  map_ids->insert(ordered_ids.begin(), ordered_ids.end());
+}
+
+void BaseMap::PreloadMapNodes(std::vector<MapNodeIndex>* map_ids) {
   if (map_ids->size() > map_node_cache_lvl2_->Capacity()) {
     AERROR << "map_ids's size is bigger than cache's capacity";
     return;
   }
   // check in cacheL2
-  std::set<MapNodeIndex>::iterator itr = map_ids->begin();
+  auto itr = map_ids->begin();
   bool is_exist = false;
   while (itr != map_ids->end()) {
     boost::unique_lock<boost::recursive_mutex> lock1(map_load_mutex_);
@@ -254,10 +287,28 @@ void BaseMap::LoadMapNodeThreadSafety(const MapNodeIndex& index,
   if (itr != map_preloading_task_index_.end()) {
     map_preloading_task_index_.erase(itr);
   }
+  std::vector<BaseMapNode*> nodes_over_budget;
+  BaseMapNode* node_over_budget = nullptr;
+  while ((node_over_budget = map_node_cache_lvl2_->ClearOneOverBudget())) {
+    nodes_over_budget.push_back(node_over_budget);
+  }
   lock.unlock();
   if (node_remove) {
     map_node_pool_->FreeMapNode(node_remove);
   }
+  for (BaseMapNode* node : nodes_over_budget) {
+    map_node_pool_->FreeMapNode(node);
+  }
+}
+
+void BaseMap::SetPreloadPolicy(const MapPreloadPolicy& policy) {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  preload_policy_ = policy;
+}
+
+MapPreloadStatistics BaseMap::GetPreloadStatistics() {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  return preload_statistics_;
 }
 
 void BaseMap::PreloadMapArea(const Eigen::Vector3d& location,
@@ -267,6 +318,10 @@ void BaseMap::PreloadMapArea(const Eigen::Vector3d& location,
     std::cerr << "Map node pool is nullptr!" << std::endl;
     return;
   }
+  if (preload_policy_.lookahead_time > 0.0) {
+    PreloadMapAreaAhead(location, trans_diff, resolution_id, zone_id);
+    return;
+  }
   int x_direction = trans_diff[0] > 0 ? 1 : -1;
   int y_direction = trans_diff[1] > 0 ? 1 : -1;
   std::set<MapNodeIndex> map_ids;
@@ -391,6 +446,56 @@ void BaseMap::PreloadMapArea(const Eigen::Vector3d& location,
   this->PreloadMapNodes(&map_ids);
 }
 
+void BaseMap::PreloadMapAreaAhead(const Eigen::Vector3d& location,
+                                  const Eigen::Vector3d& velocity,
+                                  unsigned int resolution_id,
+                                  unsigned int zone_id) {
+  const double map_pixel_resolution =
+      this->map_config_->map_resolutions_[resolution_id];
+  const double half_size_x =
+      this->map_config_->map_node_size_x_ * map_pixel_resolution / 2.0;
+  const double half_size_y =
+      this->map_config_->map_node_size_y_ * map_pixel_resolution / 2.0;
+  size_t max_size = map_node_cache_lvl2_->Capacity();
+  if (preload_policy_.max_preload_nodes > 0) {
+    max_size = std::min<size_t>(max_size, preload_policy_.max_preload_nodes);
+  }
+
+  Eigen::Vector3d direction(velocity[0], velocity[1], 0.0);
+  const double speed = direction.norm();
+  const double distance = speed * preload_policy_.lookahead_time;
+  if (speed > 0.0) {
+    direction /= speed;
+  }
+
+  // the area LoadMapArea needs at each location passed within the lookahead
+  // time, sampled every half node so no node along the heading is skipped
+  static const double kAreaCorners[5][2] = {
+      {0.0, 0.0}, {-1.0, -1.0}, {1.0, -1.0}, {-1.0, 1.0}, {1.0, 1.0}};
+  const double step = std::min(half_size_x, half_size_y);
+  std::vector<MapNodeIndex> map_ids;
+  std::set<MapNodeIndex> added_ids;
+  for (int i = 0; map_ids.size() < max_size; ++i) {
+    const double s = std::min(i * step, distance);
+    for (const auto& corner : kAreaCorners) {
+      Eigen::Vector3d pt = location + s * direction;
+      pt[0] += corner[0] * half_size_x;
+      pt[1] += corner[1] * half_size_y;
+      pt[2] = 0;
+      MapNodeIndex map_id = MapNodeIndex::GetMapNodeIndex(
+          *map_config_, pt, resolution_id, zone_id);
+      if (map_ids.size() < max_size && added_ids.insert(map_id).second) {
+        map_ids.push_back(map_id);
+      }
+    }
+    if (s >= distance) {
+      break;
+    }
+  }
+
+  this->PreloadMapNodes(&map_ids);
+}
+
 bool BaseMap::LoadMapArea(const Eigen::Vector3d& seed_pt3d,
                           unsigned int resolution_id, unsigned int zone_id,
                           int filter_size_x, int filter_size_y) {
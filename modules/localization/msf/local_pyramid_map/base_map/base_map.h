@@ -34,6 +34,25 @@ namespace localization {
 namespace msf {
 namespace pyramid_map {
 
+/**@brief The policy of preloading the map nodes ahead of the vehicle. */
+struct MapPreloadPolicy {
+  /**@brief The seconds of motion to preload ahead, the trans_diff of
+   * PreloadMapArea is taken as the velocity then. Zero preloads the fixed
+   * neighbourhood around the location. */
+  double lookahead_time = 0.0;
+  /**@brief The most map nodes to preload at once, zero means the capacity of
+   * the level 2 cache. */
+  unsigned int max_preload_nodes = 0;
+};
+
+/**@brief The statistics of the map nodes newly needed by LoadMapArea. */
+struct MapPreloadStatistics {
+  /**@brief The nodes which were preloaded in time. */
+  size_t hit_count = 0;
+  /**@brief The nodes which were loaded while waiting. */
+  size_t miss_count = 0;
+};
+
 /**@brief The data structure of the base map. */
 class BaseMap {
  public:
@@ -85,6 +104,20 @@ class BaseMap {
                            unsigned int resolution_id, unsigned int zone_id,
                            int filter_size_x, int filter_size_y);
 
+  /**@brief Bound the bytes of the map nodes held by the level 2 cache, the
+   * least recently used nodes of any resolution are evicted past it. Zero
+   * bounds the node count only, the bytes are still accounted. */
+  void SetMapNodeCacheByteBudget(size_t max_bytes);
+  /**@brief Get the hits, misses and resident bytes of the map node caches,
+   * the level 2 cache holds every loaded node. */
+  void GetMapNodeCacheStatistics(MapNodeCacheStatistics* level1,
+                                 MapNodeCacheStatistics* level2);
+
+  /**@brief Set the policy of PreloadMapArea. */
+  void SetPreloadPolicy(const MapPreloadPolicy& policy);
+  /**@brief Get how many needed nodes were preloaded in time so far. */
+  MapPreloadStatistics GetPreloadStatistics();
+
   /**@brief Compute md5 for all map node file in map. */
   void ComputeMd5ForAllMapNodes();
 
@@ -115,6 +148,12 @@ class BaseMap {
   void LoadMapNodes(std::set<MapNodeIndex>* map_ids);
   /**@brief Load map node by index.*/
   void PreloadMapNodes(std::set<MapNodeIndex>* map_ids);
+  /**@brief Load map node by index, in the order of the indices. */
+  void PreloadMapNodes(std::vector<MapNodeIndex>* map_ids);
+  /**@brief Preload the map nodes along the heading, the nearest first. */
+  void PreloadMapAreaAhead(const Eigen::Vector3d& location,
+                           const Eigen::Vector3d& velocity,
+                           unsigned int resolution_id, unsigned int zone_id);
   /**@brief Load map node by index, thread_safety. */
   void LoadMapNodeThreadSafety(const MapNodeIndex& index,
                                bool is_reserved = false);
@@ -138,6 +177,10 @@ class BaseMap {
   std::set<MapNodeIndex> map_preloading_task_index_;
   /**@brief The mutex for preload map node. **/
   boost::recursive_mutex map_load_mutex_;
+  /**@brief The policy of PreloadMapArea. */
+  MapPreloadPolicy preload_policy_;
+  /**@brief The preload statistics, guarded by map_load_mutex_. */
+  MapPreloadStatistics preload_statistics_;
 
   /**@brief All the map nodes in the Map (in the disk). */
   std::vector<MapNodeIndex> all_map_node_indices_;
@@ -35,6 +35,8 @@ bool BaseMapMatrix::GetAltitudeImg(cv::Mat* altitude_img) const {
   return false;
 }
 
+size_t BaseMapMatrix::GetMemorySize() const { return 0; }
+
 }  // namespace pyramid_map
 }  // namespace msf
 }  // namespace localization
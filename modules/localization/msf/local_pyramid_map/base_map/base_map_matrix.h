@@ -43,6 +43,8 @@ class BaseMapMatrix {
   virtual bool GetIntensityImg(cv::Mat* intensity_img) const;
   /**@brief get altitude image of node. */
   virtual bool GetAltitudeImg(cv::Mat* altitude_img) const;
+  /**@brief Get the bytes the map cells take in memory. */
+  virtual size_t GetMemorySize() const;
 };
 
 }  // namespace pyramid_map
@@ -161,6 +161,12 @@ bool BaseMapNode::Load() {
 bool BaseMapNode::Load(const char* filename) {
   data_is_ready_ = false;
 
+  if (LoadMapped(filename)) {
+    is_changed_ = false;
+    data_is_ready_ = true;
+    return true;
+  }
+
   FILE* file = fopen(filename, "rb");
   if (file) {
     bool success = LoadBinary(file);
@@ -149,6 +149,11 @@ class BaseMapNode {
   bool CheckMapDirectoryRecursively(
       const std::vector<std::string>& paths) const;
 
+  /**@brief Try to map a ready to use copy of the node file into memory
+   * instead of reading and decoding it.
+   * @param <return> True if the map cells are loaded this way. */
+  virtual bool LoadMapped(const std::string& filename) { return false; }
+
   /**@brief Load the map cell from a binary chunk.
    */
   virtual bool LoadBinary(FILE* file);
@@ -57,6 +57,8 @@ class BaseMapNodePool {
   void FreeMapNode(BaseMapNode* map_node);
   /**@brief Get the size of pool. */
   unsigned int GetPoolSize() { return pool_size_; }
+  /**@brief Set the number of nodes Initial allocates, before Initial. */
+  void SetPoolSize(unsigned int pool_size) { pool_size_ = pool_size; }
 
  private:
   /**@brief The task function of the thread pool for release node.
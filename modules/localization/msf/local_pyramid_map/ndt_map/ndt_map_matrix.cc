@@ -499,6 +499,21 @@ size_t NdtMapMatrix::GetBinarySize() const {
   return target_size;
 }
 
+size_t NdtMapMatrix::GetMemorySize() const {
+  // every altitude layer is a hash node holding the key and the cell
+  const size_t layer_size =
+      sizeof(void*) * 2 + sizeof(std::pair<const int, NdtMapSingleCell>);
+  size_t memory_size = sizeof(NdtMapCells) * rows_ * cols_;
+  for (unsigned int y = 0; y < rows_; ++y) {
+    for (unsigned int x = 0; x < cols_; ++x) {
+      const NdtMapCells& cell = GetMapCell(y, x);
+      memory_size += cell.cells_.size() * layer_size +
+                     cell.road_cell_indices_.capacity() * sizeof(int);
+    }
+  }
+  return memory_size;
+}
+
 void NdtMapMatrix::Reduce(NdtMapMatrix* cells, const NdtMapMatrix& cells_new) {
   for (unsigned int y = 0; y < cells->GetRows(); ++y) {
     for (unsigned int x = 0; x < cells->GetCols(); ++x) {
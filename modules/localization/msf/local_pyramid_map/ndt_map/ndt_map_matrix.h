@@ -170,6 +170,10 @@ class NdtMapMatrix : public BaseMapMatrix {
 
   virtual bool GetIntensityImg(cv::Mat* intensity_img) const;
 
+  /**@brief Get the bytes the cells and their altitude layers take in
+   * memory. */
+  virtual size_t GetMemorySize() const;
+
   /**@brief Get a const map cell. */
   inline const NdtMapCells& GetMapCell(unsigned int row,
                                        unsigned int col) const {
@@ -32,6 +32,10 @@ class AlignedMatrix {
   ~AlignedMatrix();
 
   void Init(int rows, int cols);
+  /**@brief Use external storage, e.g. a memory mapped file, instead of owned
+   * memory. The storage is not freed and must outlive the matrix or its next
+   * Init. It has to be aligned as well. */
+  void Attach(Scalar* data, int rows, int cols);
   void MakeEmpty();
   void MakeEmpty(int start_id, int end_id);
   int GetRow() const;
@@ -72,7 +76,11 @@ AlignedMatrix<Scalar, aligned_len>::AlignedMatrix(
   rows_ = matrix.rows_;
   cols_ = matrix.cols_;
 
-  raw_size_ = matrix.raw_size_;
+  // the copy of an attached matrix owns its data
+  raw_size_ = matrix.raw_ptr_ != nullptr
+                  ? matrix.raw_size_
+                  : static_cast<int>(sizeof(Scalar)) * (rows_ * cols_) +
+                        aligned_len;
   raw_ptr_ = malloc(raw_size_);
 
   row_data_ = reinterpret_cast<Scalar**>(malloc(sizeof(Scalar*) * rows_));
@@ -153,6 +161,30 @@ void AlignedMatrix<Scalar, aligned_len>::Init(int rows, int cols) {
   // printf("aligned addr: %p\n", (void*)data_);
 }
 
+template <typename Scalar, int aligned_len>
+void AlignedMatrix<Scalar, aligned_len>::Attach(Scalar* data, int rows,
+                                                int cols) {
+  if (raw_ptr_) {
+    free(raw_ptr_);
+    raw_size_ = 0;
+    raw_ptr_ = nullptr;
+  }
+
+  if (row_data_) {
+    free(row_data_);
+    row_data_ = nullptr;
+  }
+
+  rows_ = rows;
+  cols_ = cols;
+  data_ = data;
+
+  row_data_ = reinterpret_cast<Scalar**>(malloc(sizeof(Scalar*) * rows_));
+  for (int k = 0; k < rows_; k++) {
+    row_data_[k] = data_ + k * cols_;
+  }
+}
+
 template <typename Scalar, int aligned_len>
 void AlignedMatrix<Scalar, aligned_len>::MakeEmpty() {
   memset(data_, 0, sizeof(Scalar) * rows_ * cols_);
@@ -202,7 +234,11 @@ operator=(const AlignedMatrix<Scalar, aligned_len>& matrix) {
   rows_ = matrix.rows_;
   cols_ = matrix.cols_;
 
-  raw_size_ = matrix.raw_size_;
+  // the copy of an attached matrix owns its data
+  raw_size_ = matrix.raw_ptr_ != nullptr
+                  ? matrix.raw_size_
+                  : static_cast<int>(sizeof(Scalar)) * (rows_ * cols_) +
+                        aligned_len;
   raw_ptr_ = malloc(raw_size_);
 
   row_data_ = reinterpret_cast<Scalar**>(malloc(sizeof(Scalar*) * rows_));
@@ -181,6 +181,54 @@ void PyramidMapMatrix::Init(unsigned int rows, unsigned int cols,
   }
 }
 
+void PyramidMapMatrix::Attach(const PyramidMapMatrixStorage& storage) {
+  const bool has_intensity = storage.intensity != nullptr;
+  const bool has_intensity_var = storage.intensity_var != nullptr;
+  const bool has_altitude = storage.altitude != nullptr;
+  const bool has_altitude_var = storage.altitude_var != nullptr;
+  const bool has_ground_altitude = storage.ground_altitude != nullptr;
+  const bool has_count = storage.count != nullptr;
+  const bool has_ground_count = storage.ground_count != nullptr;
+  if (!rows_mr_.empty() && rows_mr_[0] == storage.rows &&
+      cols_mr_[0] == storage.cols && has_intensity_ == has_intensity &&
+      has_intensity_var_ == has_intensity_var &&
+      has_altitude_ == has_altitude && has_altitude_var_ == has_altitude_var &&
+      has_ground_altitude_ == has_ground_altitude &&
+      has_count_ == has_count && has_ground_count_ == has_ground_count) {
+    for (unsigned int i = 1; i < resolution_num_; ++i) {
+      Reset(i);
+    }
+  } else {
+    Init(storage.rows, storage.cols, has_intensity, has_intensity_var,
+         has_altitude, has_altitude_var, has_ground_altitude, has_count,
+         has_ground_count);
+  }
+
+  const int rows = static_cast<int>(storage.rows);
+  const int cols = static_cast<int>(storage.cols);
+  if (has_intensity_) {
+    intensity_matrixes_[0].Attach(storage.intensity, rows, cols);
+  }
+  if (has_intensity_var_) {
+    intensity_var_matrixes_[0].Attach(storage.intensity_var, rows, cols);
+  }
+  if (has_altitude_) {
+    altitude_matrixes_[0].Attach(storage.altitude, rows, cols);
+  }
+  if (has_altitude_var_) {
+    altitude_var_matrixes_[0].Attach(storage.altitude_var, rows, cols);
+  }
+  if (has_ground_altitude_) {
+    ground_altitude_matrixes_[0].Attach(storage.ground_altitude, rows, cols);
+  }
+  if (has_count_) {
+    count_matrixes_[0].Attach(storage.count, rows, cols);
+  }
+  if (has_ground_count_) {
+    ground_count_matrixes_[0].Attach(storage.ground_count, rows, cols);
+  }
+}
+
 void PyramidMapMatrix::Reset(unsigned int level) {
   if (level >= resolution_num_) {
     AERROR << "PyramidMapMatrix: [reset] The level id is illegal.";
@@ -279,6 +327,23 @@ bool PyramidMapMatrix::GetIntensityImg(cv::Mat* intensity_img) const {
   return GetIntensityImg(0, intensity_img);
 }
 
+size_t PyramidMapMatrix::GetMemorySize() const {
+  size_t cell_size = 0;
+  cell_size += has_intensity_ ? sizeof(float) : 0;
+  cell_size += has_intensity_var_ ? sizeof(float) : 0;
+  cell_size += has_altitude_ ? sizeof(float) : 0;
+  cell_size += has_altitude_var_ ? sizeof(float) : 0;
+  cell_size += has_ground_altitude_ ? sizeof(float) : 0;
+  cell_size += has_count_ ? sizeof(unsigned int) : 0;
+  cell_size += has_ground_count_ ? sizeof(unsigned int) : 0;
+
+  size_t memory_size = 0;
+  for (unsigned int level = 0; level < rows_mr_.size(); ++level) {
+    memory_size += rows_mr_[level] * cols_mr_[level] * cell_size;
+  }
+  return memory_size;
+}
+
 bool PyramidMapMatrix::GetIntensityImg(unsigned int level,
                                        cv::Mat* intensity_img) const {
   if (!has_intensity_ || resolution_num_ < 1) {
@@ -30,6 +30,20 @@ namespace pyramid_map {
 typedef AlignedMatrix<float> FloatMatrix;
 typedef AlignedMatrix<unsigned int> UIntMatrix;
 
+/**@brief External storage of the finest level of a PyramidMapMatrix, the
+ * absent layers are nullptr. */
+struct PyramidMapMatrixStorage {
+  unsigned int rows = 0;
+  unsigned int cols = 0;
+  float* intensity = nullptr;
+  float* intensity_var = nullptr;
+  float* altitude = nullptr;
+  float* altitude_var = nullptr;
+  float* ground_altitude = nullptr;
+  unsigned int* count = nullptr;
+  unsigned int* ground_count = nullptr;
+};
+
 class PyramidMapMatrix : public BaseMapMatrix {
  public:
   PyramidMapMatrix();
@@ -46,6 +60,12 @@ class PyramidMapMatrix : public BaseMapMatrix {
             bool has_count = true, bool has_ground_count = true,
             unsigned int resolution_num = 1, unsigned int ratio = 2);
 
+  /**@brief Let the finest level use external storage instead of decoded
+   * copies. The coarser levels are kept if the matrix already has the same
+   * size and layers, and reset. The storage must outlive the matrix or its
+   * next Init. */
+  void Attach(const PyramidMapMatrixStorage& storage);
+
   /**@brief Reset all of map cells data in a specific resolution level. */
   void Reset(unsigned int level);
   /**@brief Reset map cells data from start_id to end_id
@@ -64,6 +84,8 @@ class PyramidMapMatrix : public BaseMapMatrix {
   /**@brief get altitude image of node. */
   virtual bool GetAltitudeImg(cv::Mat* altitude_img) const;
   bool GetAltitudeImg(unsigned int level, cv::Mat* altitude_img) const;
+  /**@brief Get the bytes the map cells of all levels take in memory. */
+  virtual size_t GetMemorySize() const;
 
   /**@brief Propagate the data from fine level to the coarse resolution by
    * check. */
@@ -57,6 +57,8 @@ TEST_F(PyramidMapMatrixTestSuite, constructor_and_init) {
   EXPECT_TRUE(pm_matrix->has_ground_count_);
   EXPECT_EQ(pm_matrix->resolution_num_, 1);
   EXPECT_EQ(pm_matrix->ratio_, 2);
+  // five float and two unsigned int layers
+  EXPECT_EQ(pm_matrix->GetMemorySize(), 1024 * 1024 * 7 * 4);
 
   // check operator =
   std::shared_ptr<PyramidMapMatrix> pm_matrix2(new PyramidMapMatrix());
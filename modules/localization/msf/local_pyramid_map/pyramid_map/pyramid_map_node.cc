@@ -16,7 +16,10 @@
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_node.h"
 
 #include <memory>
+#include <string>
 #include <vector>
+
+#include "cyber/common/log.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_matrix.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_matrix_handler.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_node_config.h"
@@ -49,6 +52,7 @@ void PyramidMapNode::Init(const BaseMapConfig* map_config) {
   is_changed_ = false;
 
   map_matrix_.reset(new PyramidMapMatrix());
+  raw_tile_.reset();
   map_matrix_handler_.reset(
       PyramidMapMatrixHandlerSelector::AllocPyramidMapMatrixHandler(
           map_node_config_->map_version_));
@@ -89,6 +93,7 @@ void PyramidMapNode::Init(const BaseMapConfig* map_config,
   is_changed_ = false;
 
   map_matrix_.reset(new PyramidMapMatrix());
+  raw_tile_.reset();
   map_matrix_handler_.reset(
       PyramidMapMatrixHandlerSelector::AllocPyramidMapMatrixHandler(
           map_node_config_->map_version_));
@@ -99,6 +104,37 @@ void PyramidMapNode::Init(const BaseMapConfig* map_config,
   }
 }
 
+void PyramidMapNode::ResetMapNode() {
+  DetachRawTile();
+  BaseMapNode::ResetMapNode();
+}
+
+bool PyramidMapNode::LoadMapped(const std::string& filename) {
+  DetachRawTile();
+  std::shared_ptr<PyramidMapRawTile> raw_tile =
+      PyramidMapRawTile::Open(filename + ".raw");
+  if (raw_tile == nullptr) {
+    return false;
+  }
+  if (raw_tile->GetMapNodeIndex() != map_node_config_->node_index_) {
+    AERROR << "The raw tile of " << filename << " belongs to "
+           << raw_tile->GetMapNodeIndex() << ", load the node file instead.";
+    return false;
+  }
+
+  raw_tile->AttachTo(static_cast<PyramidMapMatrix*>(map_matrix_.get()));
+  raw_tile_ = raw_tile;
+  return true;
+}
+
+void PyramidMapNode::DetachRawTile() {
+  if (raw_tile_ == nullptr) {
+    return;
+  }
+  InitMapMatrix(map_config_);
+  raw_tile_.reset();
+}
+
 void PyramidMapNode::BottomUpBase() {
   std::shared_ptr<PyramidMapMatrix> map_matrix =
       std::dynamic_pointer_cast<PyramidMapMatrix>(map_matrix_);
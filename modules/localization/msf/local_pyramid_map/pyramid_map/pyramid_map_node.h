@@ -15,12 +15,15 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "Eigen/Core"
 
 #include "modules/localization/msf/local_pyramid_map/base_map/base_map_node.h"
 #include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_matrix.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_raw_tile.h"
 
 namespace apollo {
 namespace localization {
@@ -36,6 +39,7 @@ class PyramidMapNode : public BaseMapNode {
   virtual void Init(const BaseMapConfig* map_config);
   virtual void Init(const BaseMapConfig* map_config, const MapNodeIndex& index,
                     bool create_map_cells = true);
+  virtual void ResetMapNode();
 
   /**@brief Propagate the data to the coarse resolution by check. */
   void BottomUpSafe();
@@ -136,8 +140,18 @@ class PyramidMapNode : public BaseMapNode {
   /**@brief Compute mean intensity. */
   double ComputeMeanIntensity(unsigned int level = 0);
 
+ protected:
+  /**@brief Attach the finest level to the raw tile "<filename>.raw" if it
+   * exists, see PyramidMapRawTile. */
+  virtual bool LoadMapped(const std::string& filename);
+
  private:
+  /**@brief Give the map matrix its own storage back. */
+  void DetachRawTile();
+
   std::vector<float> resolutions_mr_;
+  /**@brief The raw tile the map matrix is attached to. */
+  std::shared_ptr<PyramidMapRawTile> raw_tile_ = nullptr;
 };
 
 }  // namespace pyramid_map
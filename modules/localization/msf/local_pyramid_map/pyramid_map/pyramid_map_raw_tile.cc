@@ -0,0 +1,270 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_raw_tile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace pyramid_map {
+
+namespace {
+
+constexpr char kRawTileMagic[8] = {'P', 'M', 'R', 'A', 'W', 'T', 'L', '1'};
+constexpr uint32_t kRawTileVersion = 1;
+constexpr uint64_t kRawTilePageSize = 4096;
+
+enum RawTileLayer {
+  INTENSITY = 0,
+  INTENSITY_VAR,
+  ALTITUDE,
+  ALTITUDE_VAR,
+  GROUND_ALTITUDE,
+  COUNT,
+  GROUND_COUNT,
+  LAYER_NUM,
+};
+
+struct RawTileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t rows;
+  uint32_t cols;
+  uint32_t resolution_id;
+  int32_t zone_id;
+  uint32_t m;
+  uint32_t n;
+  uint32_t layer_mask;
+  uint64_t offsets[LAYER_NUM];
+};
+
+static_assert(sizeof(RawTileHeader) <= kRawTilePageSize,
+              "The raw tile header does not fit in a page.");
+static_assert(sizeof(float) == 4 && sizeof(unsigned int) == 4,
+              "The raw tile stores 4 bytes per cell.");
+
+uint64_t AlignToPage(uint64_t size) {
+  return (size + kRawTilePageSize - 1) / kRawTilePageSize * kRawTilePageSize;
+}
+
+template <typename Matrix>
+bool WriteLayer(const Matrix& matrix, uint64_t offset, FILE* file) {
+  if (fseek(file, static_cast<long>(offset), SEEK_SET) != 0) {  // NOLINT
+    return false;
+  }
+  const size_t cols = static_cast<size_t>(matrix.GetCol());
+  for (int row = 0; row < matrix.GetRow(); ++row) {
+    if (fwrite(matrix[row], 4, cols, file) != cols) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+PyramidMapRawTile::~PyramidMapRawTile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+    data_ = nullptr;
+  }
+}
+
+bool PyramidMapRawTile::Save(const std::string& filename,
+                             const MapNodeIndex& index,
+                             const PyramidMapMatrix& matrix) {
+  const bool has_layers[LAYER_NUM] = {
+      matrix.HasIntensity(),      matrix.HasIntensityVar(),
+      matrix.HasAltitude(),       matrix.HasAltitudeVar(),
+      matrix.HasGroundAltitude(), matrix.HasCount(),
+      matrix.HasGroundCount()};
+  bool has_any_layer = false;
+  for (int i = 0; i < LAYER_NUM; ++i) {
+    has_any_layer = has_any_layer || has_layers[i];
+  }
+  if (!has_any_layer) {
+    AERROR << "Can't save an empty matrix to raw tile: " << filename << ".";
+    return false;
+  }
+
+  RawTileHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kRawTileMagic, sizeof(header.magic));
+  header.version = kRawTileVersion;
+  header.rows = matrix.GetRows();
+  header.cols = matrix.GetCols();
+  header.resolution_id = index.resolution_id_;
+  header.zone_id = index.zone_id_;
+  header.m = index.m_;
+  header.n = index.n_;
+
+  const uint64_t layer_size =
+      AlignToPage(static_cast<uint64_t>(header.rows) * header.cols * 4);
+  uint64_t offset = kRawTilePageSize;
+  for (int i = 0; i < LAYER_NUM; ++i) {
+    if (has_layers[i]) {
+      header.layer_mask |= 1u << i;
+      header.offsets[i] = offset;
+      offset += layer_size;
+    }
+  }
+
+  // tiles still mapped by a reader keep the old file when it is replaced
+  const std::string tmp_filename = filename + ".tmp";
+  FILE* file = fopen(tmp_filename.c_str(), "wb");
+  if (file == nullptr) {
+    AERROR << "Can't write to file: " << tmp_filename << ".";
+    return false;
+  }
+  std::vector<unsigned char> page(kRawTilePageSize, 0);
+  memcpy(page.data(), &header, sizeof(header));
+  bool success = fwrite(page.data(), 1, page.size(), file) == page.size();
+  if (success && has_layers[INTENSITY]) {
+    success = WriteLayer(*matrix.GetIntensityMatrix(),
+                         header.offsets[INTENSITY], file);
+  }
+  if (success && has_layers[INTENSITY_VAR]) {
+    success = WriteLayer(*matrix.GetIntensityVarMatrix(),
+                         header.offsets[INTENSITY_VAR], file);
+  }
+  if (success && has_layers[ALTITUDE]) {
+    success =
+        WriteLayer(*matrix.GetAltitudeMatrix(), header.offsets[ALTITUDE], file);
+  }
+  if (success && has_layers[ALTITUDE_VAR]) {
+    success = WriteLayer(*matrix.GetAltitudeVarMatrix(),
+                         header.offsets[ALTITUDE_VAR], file);
+  }
+  if (success && has_layers[GROUND_ALTITUDE]) {
+    success = WriteLayer(*matrix.GetGroundAltitudeMatrix(),
+                         header.offsets[GROUND_ALTITUDE], file);
+  }
+  if (success && has_layers[COUNT]) {
+    success = WriteLayer(*matrix.GetCountMatrix(), header.offsets[COUNT], file);
+  }
+  if (success && has_layers[GROUND_COUNT]) {
+    success = WriteLayer(*matrix.GetGroundCountMatrix(),
+                         header.offsets[GROUND_COUNT], file);
+  }
+  // pad the last layer to a full page so every layer can be mapped
+  if (success && offset > kRawTilePageSize) {
+    success = fseek(file, static_cast<long>(offset - 1),  // NOLINT
+                    SEEK_SET) == 0 &&
+              fputc(0, file) != EOF;
+  }
+  if (fclose(file) != 0) {
+    success = false;
+  }
+  if (success && std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    success = false;
+  }
+  if (!success) {
+    std::remove(tmp_filename.c_str());
+    AERROR << "Failed to write raw tile: " << filename << ".";
+  }
+  return success;
+}
+
+std::shared_ptr<PyramidMapRawTile> PyramidMapRawTile::Open(
+    const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat file_attr;
+  if (fstat(fd, &file_attr) < 0 ||
+      static_cast<uint64_t>(file_attr.st_size) < kRawTilePageSize) {
+    AERROR << "Invalid raw tile: " << filename << ".";
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = static_cast<size_t>(file_attr.st_size);
+  void* data =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    AERROR << "Failed to map raw tile " << filename << ": " << strerror(errno);
+    return nullptr;
+  }
+  madvise(data, size, MADV_WILLNEED);
+
+  std::shared_ptr<PyramidMapRawTile> tile(new PyramidMapRawTile());
+  tile->data_ = data;
+  tile->size_ = size;
+
+  RawTileHeader header;
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, kRawTileMagic, sizeof(header.magic)) != 0 ||
+      header.version != kRawTileVersion) {
+    AERROR << "Unknown raw tile format: " << filename << ".";
+    return nullptr;
+  }
+
+  const uint64_t layer_bytes =
+      static_cast<uint64_t>(header.rows) * header.cols * 4;
+  void* layers[LAYER_NUM] = {nullptr};
+  for (int i = 0; i < LAYER_NUM; ++i) {
+    if ((header.layer_mask & (1u << i)) == 0) {
+      continue;
+    }
+    if (header.offsets[i] % kRawTilePageSize != 0 ||
+        header.offsets[i] + layer_bytes > size) {
+      AERROR << "Corrupted raw tile: " << filename << ".";
+      return nullptr;
+    }
+    layers[i] = static_cast<char*>(data) + header.offsets[i];
+  }
+
+  tile->index_.resolution_id_ = header.resolution_id;
+  tile->index_.zone_id_ = header.zone_id;
+  tile->index_.m_ = header.m;
+  tile->index_.n_ = header.n;
+
+  PyramidMapMatrixStorage& storage = tile->storage_;
+  storage.rows = header.rows;
+  storage.cols = header.cols;
+  storage.intensity = static_cast<float*>(layers[INTENSITY]);
+  storage.intensity_var = static_cast<float*>(layers[INTENSITY_VAR]);
+  storage.altitude = static_cast<float*>(layers[ALTITUDE]);
+  storage.altitude_var = static_cast<float*>(layers[ALTITUDE_VAR]);
+  storage.ground_altitude = static_cast<float*>(layers[GROUND_ALTITUDE]);
+  storage.count = static_cast<unsigned int*>(layers[COUNT]);
+  storage.ground_count = static_cast<unsigned int*>(layers[GROUND_COUNT]);
+  return tile;
+}
+
+void PyramidMapRawTile::AttachTo(PyramidMapMatrix* matrix) const {
+  matrix->Attach(storage_);
+}
+
+}  // namespace pyramid_map
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "modules/localization/msf/local_pyramid_map/base_map/base_map_node_index.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_matrix.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace pyramid_map {
+
+/**@brief An uncompressed, page aligned copy of the finest level of a pyramid
+ * map node, which is mapped into memory instead of being read and decoded.
+ * The file starts with a one page header, followed by one page aligned block
+ * of rows * cols 4 bytes values per layer. The mapping is private, so writes
+ * to an attached matrix never reach the file. */
+class PyramidMapRawTile {
+ public:
+  ~PyramidMapRawTile();
+
+  /**@brief Write the finest level of the matrix to a raw tile file. An
+   * existing file is replaced, not overwritten in place. */
+  static bool Save(const std::string& filename, const MapNodeIndex& index,
+                   const PyramidMapMatrix& matrix);
+  /**@brief Map a raw tile file into memory.
+   * @param <return> The tile, nullptr if the file is absent or invalid. */
+  static std::shared_ptr<PyramidMapRawTile> Open(const std::string& filename);
+
+  /**@brief The index of the node the tile was saved from. */
+  const MapNodeIndex& GetMapNodeIndex() const { return index_; }
+  /**@brief Let the finest level of the matrix use the mapped layers. The tile
+   * must be kept alive as long as the matrix is attached. */
+  void AttachTo(PyramidMapMatrix* matrix) const;
+
+ private:
+  PyramidMapRawTile() = default;
+  PyramidMapRawTile(const PyramidMapRawTile&) = delete;
+  PyramidMapRawTile& operator=(const PyramidMapRawTile&) = delete;
+
+  void* data_ = nullptr;
+  size_t size_ = 0;
+  MapNodeIndex index_;
+  PyramidMapMatrixStorage storage_;
+};
+
+}  // namespace pyramid_map
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_raw_tile.h"
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+namespace pyramid_map {
+
+class PyramidMapRawTileTestSuite : public ::testing::Test {
+ protected:
+  PyramidMapRawTileTestSuite() {}
+  virtual ~PyramidMapRawTileTestSuite() {}
+  virtual void SetUp() {}
+  virtual void TearDown() { std::remove(filename_.c_str()); }
+
+  const std::string filename_ = "/tmp/pyramid_map_raw_tile_test.raw";
+};
+
+TEST_F(PyramidMapRawTileTestSuite, save_and_attach) {
+  MapNodeIndex index;
+  index.resolution_id_ = 0;
+  index.zone_id_ = 50;
+  index.m_ = 3;
+  index.n_ = 7;
+
+  PyramidMapMatrix matrix;
+  matrix.Init(3, 5, true, true, true, true, false, true, false, 2, 2);
+  for (unsigned int r = 0; r < 3; ++r) {
+    for (unsigned int c = 0; c < 5; ++c) {
+      matrix.SetIntensitySafe(static_cast<float>(r * 5 + c), r, c);
+      matrix.SetAltitudeSafe(static_cast<float>(r) + 0.5f, r, c);
+      matrix.SetCountSafe(r + c, r, c);
+    }
+  }
+  EXPECT_TRUE(PyramidMapRawTile::Save(filename_, index, matrix));
+
+  std::shared_ptr<PyramidMapRawTile> tile =
+      PyramidMapRawTile::Open(filename_);
+  ASSERT_NE(tile, nullptr);
+  EXPECT_TRUE(tile->GetMapNodeIndex() == index);
+
+  // a matrix of the same layout keeps its coarse level
+  PyramidMapMatrix attached(matrix);
+  tile->AttachTo(&attached);
+  EXPECT_EQ(attached.GetResolutionNum(), 2);
+  EXPECT_EQ(attached.GetColsSafe(1), 2);
+  EXPECT_FALSE(attached.HasGroundAltitude());
+  EXPECT_FALSE(attached.HasGroundCount());
+  EXPECT_FLOAT_EQ(*attached.GetIntensitySafe(2, 4), 14.f);
+  EXPECT_FLOAT_EQ(*attached.GetAltitudeSafe(1, 3), 1.5f);
+  EXPECT_EQ(*attached.GetCountSafe(2, 3), 5);
+
+  // the matrix is initialized to the tile otherwise
+  PyramidMapMatrix empty;
+  tile->AttachTo(&empty);
+  EXPECT_EQ(empty.GetResolutionNum(), 1);
+  EXPECT_EQ(empty.GetRowsSafe(), 3);
+  EXPECT_EQ(empty.GetColsSafe(), 5);
+  EXPECT_FLOAT_EQ(*empty.GetIntensitySafe(1, 1), 6.f);
+
+  // writes stay in the private mapping
+  empty.SetIntensitySafe(100.f, 1, 1);
+  PyramidMapMatrix copy(empty);
+  tile.reset();
+  EXPECT_FLOAT_EQ(*copy.GetIntensitySafe(1, 1), 100.f);
+  tile = PyramidMapRawTile::Open(filename_);
+  ASSERT_NE(tile, nullptr);
+  tile->AttachTo(&empty);
+  EXPECT_FLOAT_EQ(*empty.GetIntensitySafe(1, 1), 6.f);
+}
+
+TEST_F(PyramidMapRawTileTestSuite, open_invalid) {
+  EXPECT_EQ(PyramidMapRawTile::Open(filename_), nullptr);
+
+  FILE* file = fopen(filename_.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  const std::string content(8192, 'x');
+  fwrite(content.data(), 1, content.size(), file);
+  fclose(file);
+  EXPECT_EQ(PyramidMapRawTile::Open(filename_), nullptr);
+
+  PyramidMapMatrix matrix;
+  EXPECT_FALSE(PyramidMapRawTile::Save(filename_, MapNodeIndex(), matrix));
+}
+
+}  // namespace pyramid_map
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -126,6 +126,9 @@ TEST_F(PyramidMapTestSuite, pyramid_map_function) {
   EXPECT_TRUE(pyramid_map.IsMapNodeExist(*(indexes.begin() + 9)));
   EXPECT_TRUE(pyramid_map.IsMapNodeExist(*(indexes.begin() + 10)));
   EXPECT_FALSE(pyramid_map.IsMapNodeExist(*(indexes.begin() + 0)));
+  MapPreloadStatistics statistics = pyramid_map.GetPreloadStatistics();
+  EXPECT_EQ(statistics.hit_count, 0);
+  EXPECT_EQ(statistics.miss_count, 4);
 
   // preload map area
   Eigen::Vector3d trans_diff;
@@ -142,6 +145,13 @@ TEST_F(PyramidMapTestSuite, pyramid_map_function) {
   trans_diff_eigen[2] = trans_diff[2];
   pyramid_map.PreloadMapArea(loc_eigen, trans_diff_eigen, 0, 50);
 
+  // preload map area ahead along the velocity
+  MapPreloadPolicy policy;
+  policy.lookahead_time = 2.0;
+  policy.max_preload_nodes = 6;
+  pyramid_map.SetPreloadPolicy(policy);
+  pyramid_map.PreloadMapArea(loc, trans_diff, 0, 50);
+
   // get path
   pyramid_map.ComputeMd5ForAllMapNodes();
   std::vector<std::string> paths = pyramid_map.GetAllMapNodePaths();
@@ -52,7 +52,10 @@ int main(int argc, char **argv) {
       "odometry_loc_topic",
       boost::program_options::value<std::string>()->default_value(
           "/apollo/sensor/gnss/odometry"),
-      "provide odometry localization topic");
+      "provide odometry localization topic")(
+      "pcd_threads",
+      boost::program_options::value<unsigned int>()->default_value(1),
+      "provide the number of threads writing pcd files");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -83,7 +86,10 @@ int main(int argc, char **argv) {
   const std::string odometry_loc_topic =
       boost_args["odometry_loc_topic"].as<std::string>();
 
-  std::unique_ptr<PCDExporter> pcd_exporter(new PCDExporter(pcd_folder));
+  const unsigned int pcd_threads = boost_args["pcd_threads"].as<unsigned int>();
+
+  std::unique_ptr<PCDExporter> pcd_exporter(
+      new PCDExporter(pcd_folder, pcd_threads));
   std::unique_ptr<LocationExporter> loc_exporter(
       new LocationExporter(pcd_folder));
 
@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_tool/data_extraction/cyber_record_reader.h"
 
+#include <set>
+
 #include "cyber/cyber.h"
 #include "cyber/record/record_reader.h"
 
@@ -38,6 +40,9 @@ void CyberRecordReader::Subscribe(
 
 void CyberRecordReader::Read(const std::string &file_name) {
   RecordReader reader(file_name);
+  // the messages of the other channels are skipped without being copied
+  reader.SetChannelFilter(
+      std::set<std::string>(topics_.begin(), topics_.end()));
   cyber::record::RecordMessage message;
   while (reader.ReadMessage(&message)) {
     auto itr = call_back_map_.find(message.channel_name);
@@ -25,16 +25,23 @@ namespace apollo {
 namespace localization {
 namespace msf {
 
-PCDExporter::PCDExporter(const std::string &pcd_folder) {
+PCDExporter::PCDExporter(const std::string &pcd_folder,
+                         unsigned int thread_num) {
   pcd_folder_ = pcd_folder;
   std::string stamp_file = pcd_folder_ + "/pcd_timestamp.txt";
 
   if ((stamp_file_handle_ = fopen(stamp_file.c_str(), "a")) == nullptr) {
     AERROR << "Cannot open stamp file!";
   }
+  if (thread_num > 1) {
+    max_pending_num_ = 2 * thread_num;
+    thread_pool_.reset(
+        new cyber::base::ThreadPool(thread_num, max_pending_num_));
+  }
 }
 
 PCDExporter::~PCDExporter() {
+  Flush();
   if (stamp_file_handle_ != nullptr) {
     fclose(stamp_file_handle_);
   }
@@ -42,20 +49,48 @@ PCDExporter::~PCDExporter() {
 
 void PCDExporter::CompensatedPcdCallback(const std::string &msg_string) {
   AINFO << "Compensated pcd callback.";
+  const unsigned int index = index_++;
+  if (thread_pool_ == nullptr) {
+    WriteStamp(index, ExportPcd(msg_string, index));
+    return;
+  }
+
+  // bound the memory held by the clouds not written yet
+  while (pending_.size() >= max_pending_num_) {
+    WriteStamp(pending_.front().first, pending_.front().second.get());
+    pending_.pop_front();
+  }
+  pending_.emplace_back(index, thread_pool_->Enqueue(&PCDExporter::ExportPcd,
+                                                     this, msg_string, index));
+}
+
+void PCDExporter::Flush() {
+  while (!pending_.empty()) {
+    WriteStamp(pending_.front().first, pending_.front().second.get());
+    pending_.pop_front();
+  }
+  if (stamp_file_handle_ != nullptr) {
+    fflush(stamp_file_handle_);
+  }
+}
+
+double PCDExporter::ExportPcd(const std::string &msg_string,
+                              unsigned int index) {
   drivers::PointCloud msg;
   msg.ParseFromString(msg_string);
 
-  static unsigned int index = 1;
-
   std::stringstream ss_pcd;
   ss_pcd << pcd_folder_ << "/" << index << ".pcd";
   std::string pcd_filename = ss_pcd.str();
 
   WritePcdFile(pcd_filename, msg);
-  double timestamp = cyber::Time(msg.measurement_time()).ToSecond();
-  fprintf(stamp_file_handle_, "%u %lf\n", index, timestamp);
+  return cyber::Time(msg.measurement_time()).ToSecond();
+}
 
-  ++index;
+void PCDExporter::WriteStamp(unsigned int index, double timestamp) {
+  if (stamp_file_handle_ != nullptr) {
+    fprintf(stamp_file_handle_, "%u %lf\n", index, timestamp);
+  }
 }
 
 void PCDExporter::WritePcdFile(const std::string &filename,
@@ -16,8 +16,13 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
+#include <memory>
 #include <string>
+#include <utility>
 
+#include "cyber/base/thread_pool.h"
 #include "modules/drivers/proto/pointcloud.pb.h"
 
 namespace apollo {
@@ -30,17 +35,34 @@ namespace msf {
  */
 class PCDExporter {
  public:
-  explicit PCDExporter(const std::string &pcd_folder);
+  /**
+   * @brief With more than one thread the clouds are decoded and written in
+   * parallel, at most two per thread being in flight at a time.
+   */
+  explicit PCDExporter(const std::string &pcd_folder,
+                       unsigned int thread_num = 1);
   ~PCDExporter();
 
   void CompensatedPcdCallback(const std::string &msg);
 
+  /**
+   * @brief Wait for the pending clouds and write their timestamps.
+   */
+  void Flush();
+
  private:
+  double ExportPcd(const std::string &msg_string, unsigned int index);
   void WritePcdFile(const std::string &filename,
                     const drivers::PointCloud &msg);
+  void WriteStamp(unsigned int index, double timestamp);
 
   std::string pcd_folder_;
   FILE *stamp_file_handle_;
+  unsigned int index_ = 1;
+  size_t max_pending_num_ = 0;
+  std::unique_ptr<cyber::base::ThreadPool> thread_pool_;
+  // the timestamps of the exported clouds, in index order
+  std::deque<std::pair<unsigned int, std::future<double>>> pending_;
 };
 
 }  // namespace msf
@@ -14,6 +14,11 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <boost/filesystem.hpp>
@@ -76,7 +81,15 @@ bool ParseCommandLine(int argc, char* argv[],
           "resolution",
           boost::program_options::value<float>()->default_value(0.125),
           "optional: resolution for single resolution generation, default: "
-          "0.125");
+          "0.125")(
+          "num_threads",
+          boost::program_options::value<unsigned int>()->default_value(1),
+          "optional: threads binning the points of a batch of frames, "
+          "default: 1")(
+          "frames_per_batch",
+          boost::program_options::value<unsigned int>()->default_value(64),
+          "optional: frames binned before they are merged into the map, "
+          "default: 64");
   try {
     boost::program_options::store(
         boost::program_options::parse_command_line(argc, argv, desc), *vm);
@@ -106,10 +119,107 @@ void VarianceOnline(double* mean, double* var, unsigned int* N, double x) {
 
 using ::apollo::common::EigenAffine3dVec;
 using ::apollo::common::EigenVector3dVec;
+using apollo::localization::msf::pyramid_map::BaseMapNode;
 
-int main(int argc, char** argv) {
-  FeatureXYPlane plane_extractor;
+// One point of a frame binned into the cell it falls into.
+struct CellUpdate {
+  unsigned int row = 0;
+  unsigned int col = 0;
+  unsigned char intensity = 0;
+  bool has_ground_altitude = false;
+  float ground_altitude = 0.0f;
+};
+
+// The binned points of some frames keyed by the node they fall into, in the
+// order the frames and their points came in.
+typedef std::map<MapNodeIndex, std::vector<CellUpdate>> NodeShard;
+
+void BinPoint(const PyramidMapConfig& config, const Eigen::Vector3d& pt3d,
+              int zone_id, CellUpdate* update, NodeShard* shard) {
+  const unsigned int resolution_id = 0;
+  MapNodeIndex map_node_index =
+      MapNodeIndex::GetMapNodeIndex(config, pt3d, resolution_id, zone_id);
+  // Same as BaseMapNode::GetCoordinate without loading the node.
+  const Eigen::Vector2d left_top_corner =
+      BaseMapNode::GetLeftTopCorner(config, map_node_index);
+  const float resolution = config.map_resolutions_[resolution_id];
+  update->col = static_cast<unsigned int>((pt3d[0] - left_top_corner[0]) /
+                                          resolution);
+  update->row = static_cast<unsigned int>((pt3d[1] - left_top_corner[1]) /
+                                          resolution);
+  (*shard)[map_node_index].push_back(*update);
+}
+
+void BinFrame(const PyramidMapConfig& config, int zone_id,
+              bool use_plane_inliers_only, const std::string& pcd_file_path,
+              unsigned int frame_idx, const Eigen::Affine3d& pcd_pose,
+              FeatureXYPlane* plane_extractor, NodeShard* shard) {
+  apollo::localization::msf::velodyne::VelodyneFrame velodyne_frame;
+  apollo::localization::msf::velodyne::LoadPcds(
+      pcd_file_path, frame_idx, pcd_pose, &velodyne_frame, false);
+  AINFO << "Loaded " << velodyne_frame.pt3ds.size()
+        << "3D Points at Frame: " << frame_idx << ".";
+
+  CellUpdate update;
+  for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
+    update.intensity = velodyne_frame.intensities[i];
+    BinPoint(config, velodyne_frame.pose * velodyne_frame.pt3ds[i], zone_id,
+             &update, shard);
+  }
+
+  if (!use_plane_inliers_only) {
+    return;
+  }
+  PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
+  pcl_pc->resize(velodyne_frame.pt3ds.size());
+  for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
+    PclPointT& pt = pcl_pc->at(i);
+    pt.x = static_cast<float>(velodyne_frame.pt3ds[i][0]);
+    pt.y = static_cast<float>(velodyne_frame.pt3ds[i][1]);
+    pt.z = static_cast<float>(velodyne_frame.pt3ds[i][2]);
+    pt.intensity = static_cast<float>(velodyne_frame.intensities[i]);
+  }
+
+  plane_extractor->ExtractXYPlane(pcl_pc);
+  PclPointCloudPtrT& plane_pc = plane_extractor->GetXYPlaneCloud();
+
+  update.has_ground_altitude = true;
+  for (unsigned int k = 0; k < plane_pc->size(); ++k) {
+    const PclPointT& plane_pt = plane_pc->at(k);
+    Eigen::Vector3d pt3d_local_double;
+    pt3d_local_double[0] = plane_pt.x;
+    pt3d_local_double[1] = plane_pt.y;
+    pt3d_local_double[2] = plane_pt.z;
+    update.intensity = static_cast<unsigned char>(plane_pt.intensity);
+    Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local_double;
+    update.ground_altitude = static_cast<float>(pt3d_global[2]);
+    BinPoint(config, pt3d_global, zone_id, &update, shard);
+  }
+}
+
+void MergeShard(const PyramidMapConfig& config, const NodeShard& shard,
+                PyramidMap* map) {
+  for (const auto& item : shard) {
+    PyramidMapNode* map_node =
+        dynamic_cast<PyramidMapNode*>(map->GetMapNodeSafe(item.first));
+    PyramidMapMatrix& map_matrix =
+        dynamic_cast<PyramidMapMatrix&>(map_node->GetMapCellMatrix());
+    for (const CellUpdate& update : item.second) {
+      if (update.col >= config.map_node_size_x_ ||
+          update.row >= config.map_node_size_y_) {
+        continue;
+      }
+      map_matrix.SetIntensitySafe(update.intensity, update.row, update.col);
+      if (update.has_ground_altitude) {
+        map_matrix.SetGroundAltitudeSafe(update.ground_altitude, update.row,
+                                         update.col);
+      }
+    }
+    map_node->SetIsChanged(true);
+  }
+}
 
+int main(int argc, char** argv) {
   boost::program_options::variables_map boost_args;
   if (!ParseCommandLine(argc, argv, &boost_args)) {
     AERROR << "Parse input command line failed.";
@@ -162,6 +272,11 @@ int main(int argc, char** argv) {
           << "4.0, 8.0 or 16.0.";
   }
 
+  const unsigned int num_threads =
+      std::max(boost_args["num_threads"].as<unsigned int>(), 1u);
+  const unsigned int frames_per_batch =
+      std::max(boost_args["frames_per_batch"].as<unsigned int>(), 1u);
+
   const size_t num_trials = pcd_folder_paths.size();
 
   // load all poses
@@ -259,74 +374,50 @@ int main(int argc, char** argv) {
   map.InitMapNodeCaches(12, 24);
   map.AttachMapNodePool(&lossless_map_node_pool);
 
+  // Frames are binned by node in parallel a batch at a time, each thread
+  // taking a contiguous run of the batch. The shards are then merged in frame
+  // order, so every cell ends up as in a sequential pass, and nodes the
+  // route has left are saved as the map node caches evict them.
+  std::vector<std::pair<unsigned int, unsigned int>> frames;
   for (unsigned int trial = 0; trial < num_trials; ++trial) {
     for (unsigned int frame_idx = 0; frame_idx < ieout_poses[trial].size();
          ++frame_idx) {
-      unsigned int trial_frame_idx = frame_idx;
-      const EigenAffine3dVec& poses = ieout_poses[trial];
-      apollo::localization::msf::velodyne::VelodyneFrame velodyne_frame;
-      std::string pcd_file_path = absl::StrCat(
-          pcd_folder_paths[trial], "/", pcd_indices[trial][frame_idx], ".pcd");
-      const Eigen::Affine3d& pcd_pose = poses[trial_frame_idx];
-      apollo::localization::msf::velodyne::LoadPcds(
-          pcd_file_path, trial_frame_idx, pcd_pose, &velodyne_frame, false);
-      AINFO << "Loaded " << velodyne_frame.pt3ds.size()
-            << "3D Points at Trial: " << trial << " Frame: " << trial_frame_idx
-            << ".";
-
-      unsigned int resolution_id = 0;
-      unsigned int row = 0;
-      unsigned int col = 0;
-      for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-        Eigen::Vector3d& pt3d_local = velodyne_frame.pt3ds[i];
-        unsigned char intensity = velodyne_frame.intensities[i];
-        Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local;
-        MapNodeIndex map_node_index = MapNodeIndex::GetMapNodeIndex(
-            loss_less_config, pt3d_global, resolution_id, zone_id);
-        PyramidMapNode* map_node =
-            dynamic_cast<PyramidMapNode*>(map.GetMapNodeSafe(map_node_index));
-        map_node->GetCoordinate(pt3d_global, &col, &row);
-        PyramidMapMatrix& map_matrix =
-            dynamic_cast<PyramidMapMatrix&>(map_node->GetMapCellMatrix());
-        map_matrix.SetIntensitySafe(intensity, row, col);
-      }
-
-      if (use_plane_inliers_only) {
-        PclPointCloudPtrT pcl_pc = PclPointCloudPtrT(new PclPointCloudT);
-        pcl_pc->resize(velodyne_frame.pt3ds.size());
-        for (size_t i = 0; i < velodyne_frame.pt3ds.size(); ++i) {
-          PclPointT& pt = pcl_pc->at(i);
-          pt.x = static_cast<float>(velodyne_frame.pt3ds[i][0]);
-          pt.y = static_cast<float>(velodyne_frame.pt3ds[i][1]);
-          pt.z = static_cast<float>(velodyne_frame.pt3ds[i][2]);
-          pt.intensity = static_cast<float>(velodyne_frame.intensities[i]);
-        }
-
-        plane_extractor.ExtractXYPlane(pcl_pc);
-        PclPointCloudPtrT& plane_pc = plane_extractor.GetXYPlaneCloud();
-
-        for (unsigned int k = 0; k < plane_pc->size(); ++k) {
-          const PclPointT& plane_pt = plane_pc->at(k);
-          Eigen::Vector3d pt3d_local_double;
-          pt3d_local_double[0] = plane_pt.x;
-          pt3d_local_double[1] = plane_pt.y;
-          pt3d_local_double[2] = plane_pt.z;
-          unsigned char intensity =
-              static_cast<unsigned char>(plane_pt.intensity);
-          Eigen::Vector3d pt3d_global = velodyne_frame.pose * pt3d_local_double;
-          float ground_altitude = static_cast<float>(pt3d_global[2]);
-          MapNodeIndex map_node_index = MapNodeIndex::GetMapNodeIndex(
-              loss_less_config, pt3d_global, resolution_id, zone_id);
-          PyramidMapNode* map_node =
-              dynamic_cast<PyramidMapNode*>(map.GetMapNodeSafe(map_node_index));
-          map_node->GetCoordinate(pt3d_global, &col, &row);
-          PyramidMapMatrix& map_matrix =
-              dynamic_cast<PyramidMapMatrix&>(map_node->GetMapCellMatrix());
-          map_matrix.SetIntensitySafe(intensity, row, col);
-          map_matrix.SetGroundAltitudeSafe(ground_altitude, row, col);
-          map_node->SetIsChanged(true);
-        }
+      frames.emplace_back(trial, frame_idx);
+    }
+  }
+  std::vector<FeatureXYPlane> plane_extractors(num_threads);
+  std::vector<NodeShard> shards(num_threads);
+  for (size_t batch_begin = 0; batch_begin < frames.size();
+       batch_begin += frames_per_batch) {
+    const size_t batch_size =
+        std::min(static_cast<size_t>(frames_per_batch),
+                 frames.size() - batch_begin);
+    auto bin_frames = [&](unsigned int thread_id) {
+      const size_t begin = batch_begin + batch_size * thread_id / num_threads;
+      const size_t end =
+          batch_begin + batch_size * (thread_id + 1) / num_threads;
+      for (size_t i = begin; i < end; ++i) {
+        const unsigned int trial = frames[i].first;
+        const unsigned int frame_idx = frames[i].second;
+        std::string pcd_file_path =
+            absl::StrCat(pcd_folder_paths[trial], "/",
+                         pcd_indices[trial][frame_idx], ".pcd");
+        BinFrame(loss_less_config, zone_id, use_plane_inliers_only,
+                 pcd_file_path, frame_idx, ieout_poses[trial][frame_idx],
+                 &plane_extractors[thread_id], &shards[thread_id]);
       }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned int thread_id = 1; thread_id < num_threads; ++thread_id) {
+      workers.emplace_back(bin_frames, thread_id);
+    }
+    bin_frames(0);
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    for (NodeShard& shard : shards) {
+      MergeShard(loss_less_config, shard, &map);
+      shard.clear();
     }
   }
 
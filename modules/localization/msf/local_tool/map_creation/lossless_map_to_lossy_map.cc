@@ -14,6 +14,13 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
@@ -85,34 +92,10 @@ bool GetAllMapIndex(const std::string& src_map_folder,
   return true;
 }
 
-}  // namespace msf
-}  // namespace localization
-}  // namespace apollo
-
-int main(int argc, char** argv) {
-  boost::program_options::options_description boost_desc("Allowed options");
-  boost_desc.add_options()("help", "produce help message")(
-      "srcdir", boost::program_options::value<std::string>(),
-      "provide the data base dir")("dstdir",
-                                   boost::program_options::value<std::string>(),
-                                   "provide the lossy map destination dir");
-
-  boost::program_options::variables_map boost_args;
-  boost::program_options::store(
-      boost::program_options::parse_command_line(argc, argv, boost_desc),
-      boost_args);
-  boost::program_options::notify(boost_args);
-
-  if (boost_args.count("help") || !boost_args.count("srcdir") ||
-      !boost_args.count("dstdir")) {
-    AERROR << boost_desc;
-    return 0;
-  }
-
-  const std::string src_path = boost_args["srcdir"].as<std::string>();
-  const std::string dst_path = boost_args["dstdir"].as<std::string>();
-  std::string src_map_folder = src_path + "/";
-
+void ConvertMapNodes(const std::string& src_map_folder,
+                     const std::string& dst_map_folder,
+                     const std::vector<MapNodeIndex>& indices,
+                     unsigned int thread_id, unsigned int num_threads) {
   PyramidMapConfig lossless_config("lossless_map");
   PyramidMapNodePool lossless_map_node_pool(25, 8);
   lossless_map_node_pool.Initial(&lossless_config);
@@ -122,27 +105,11 @@ int main(int argc, char** argv) {
   lossless_map.AttachMapNodePool(&lossless_map_node_pool);
   if (!lossless_map.SetMapFolderPath(src_map_folder)) {
     AERROR << "Reflectance map folder is invalid!";
-    return -1;
+    return;
   }
 
-  // create lossy map
-  std::string dst_map_folder = dst_path + "/lossy_map/";
-  if (!boost::filesystem::exists(dst_map_folder)) {
-    boost::filesystem::create_directory(dst_map_folder);
-  }
-
-  std::list<MapNodeIndex> buf;
-  apollo::localization::msf::GetAllMapIndex(src_map_folder, dst_map_folder,
-                                            &buf);
-  AINFO << "index size: " << buf.size();
-
   PyramidMapConfig config_transform_lossy("lossless_map");
-  config_transform_lossy.Load(src_map_folder + "config.xml");
-  config_transform_lossy.map_version_ = "lossy_map";
-  config_transform_lossy.Save(dst_map_folder + "config.xml");
-
-  AINFO << "lossy map directory structure has built.";
-
+  config_transform_lossy.Load(dst_map_folder + "config.xml");
   PyramidMapNodePool lossy_map_node_pool(25, 8);
   lossy_map_node_pool.Initial(&config_transform_lossy);
   PyramidMap lossy_map(&config_transform_lossy);
@@ -152,11 +119,11 @@ int main(int argc, char** argv) {
     AINFO << "lossy_map config xml not exist";
   }
 
-  int index = 0;
-  auto itr = buf.begin();
-  for (; itr != buf.end(); ++itr, ++index) {
-    PyramidMapNode* lossless_node =
-        static_cast<PyramidMapNode*>(lossless_map.GetMapNodeSafe(*itr));
+  const size_t begin = indices.size() * thread_id / num_threads;
+  const size_t end = indices.size() * (thread_id + 1) / num_threads;
+  for (size_t index = begin; index < end; ++index) {
+    PyramidMapNode* lossless_node = static_cast<PyramidMapNode*>(
+        lossless_map.GetMapNodeSafe(indices[index]));
     if (lossless_node == nullptr) {
       AWARN << "index: " << index << " is a nullptr pointer!";
       continue;
@@ -165,7 +132,7 @@ int main(int argc, char** argv) {
         static_cast<PyramidMapMatrix&>(lossless_node->GetMapCellMatrix());
 
     PyramidMapNode* lossy_node =
-        static_cast<PyramidMapNode*>(lossy_map.GetMapNodeSafe(*itr));
+        static_cast<PyramidMapNode*>(lossy_map.GetMapNodeSafe(indices[index]));
     PyramidMapMatrix& lossy_matrix =
         static_cast<PyramidMapMatrix&>(lossy_node->GetMapCellMatrix());
 
@@ -210,6 +177,78 @@ int main(int argc, char** argv) {
     }
     lossy_node->SetIsChanged(true);
   }
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  boost::program_options::options_description boost_desc("Allowed options");
+  boost_desc.add_options()("help", "produce help message")(
+      "srcdir", boost::program_options::value<std::string>(),
+      "provide the data base dir")("dstdir",
+                                   boost::program_options::value<std::string>(),
+                                   "provide the lossy map destination dir")(
+      "num_threads",
+      boost::program_options::value<unsigned int>()->default_value(1),
+      "threads converting the map nodes, default: 1");
+
+  boost::program_options::variables_map boost_args;
+  boost::program_options::store(
+      boost::program_options::parse_command_line(argc, argv, boost_desc),
+      boost_args);
+  boost::program_options::notify(boost_args);
+
+  if (boost_args.count("help") || !boost_args.count("srcdir") ||
+      !boost_args.count("dstdir")) {
+    AERROR << boost_desc;
+    return 0;
+  }
+
+  const std::string src_path = boost_args["srcdir"].as<std::string>();
+  const std::string dst_path = boost_args["dstdir"].as<std::string>();
+  const unsigned int num_threads =
+      std::max(boost_args["num_threads"].as<unsigned int>(), 1u);
+  std::string src_map_folder = src_path + "/";
+
+  if (!boost::filesystem::exists(src_map_folder + "config.xml")) {
+    AERROR << "Reflectance map folder is invalid!";
+    return -1;
+  }
+
+  // create lossy map
+  std::string dst_map_folder = dst_path + "/lossy_map/";
+  if (!boost::filesystem::exists(dst_map_folder)) {
+    boost::filesystem::create_directory(dst_map_folder);
+  }
+
+  std::list<MapNodeIndex> buf;
+  apollo::localization::msf::GetAllMapIndex(src_map_folder, dst_map_folder,
+                                            &buf);
+  AINFO << "index size: " << buf.size();
+
+  PyramidMapConfig config_transform_lossy("lossless_map");
+  config_transform_lossy.Load(src_map_folder + "config.xml");
+  config_transform_lossy.map_version_ = "lossy_map";
+  config_transform_lossy.Save(dst_map_folder + "config.xml");
+
+  AINFO << "lossy map directory structure has built.";
+
+  // Nodes convert independently, every thread works through its own share of
+  // them with its own maps, caches and node pools.
+  std::vector<MapNodeIndex> indices(buf.begin(), buf.end());
+  std::vector<std::thread> workers;
+  for (unsigned int thread_id = 1; thread_id < num_threads; ++thread_id) {
+    workers.emplace_back(apollo::localization::msf::ConvertMapNodes,
+                         std::cref(src_map_folder), std::cref(dst_map_folder),
+                         std::cref(indices), thread_id, num_threads);
+  }
+  apollo::localization::msf::ConvertMapNodes(src_map_folder, dst_map_folder,
+                                              indices, 0, num_threads);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
 
   return 0;
 }
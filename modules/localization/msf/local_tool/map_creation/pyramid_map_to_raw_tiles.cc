@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "cyber/common/log.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_config.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_matrix.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_node.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_raw_tile.h"
+
+using apollo::localization::msf::pyramid_map::MapNodeIndex;
+using apollo::localization::msf::pyramid_map::PyramidMapConfig;
+using apollo::localization::msf::pyramid_map::PyramidMapMatrix;
+using apollo::localization::msf::pyramid_map::PyramidMapNode;
+using apollo::localization::msf::pyramid_map::PyramidMapRawTile;
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+MapNodeIndex GetMapIndexFromMapFolder(const std::string& map_folder) {
+  MapNodeIndex index;
+  char buf[100];
+  sscanf(map_folder.c_str(), "/%03u/%05s/%02d/%08u/%08u", &index.resolution_id_,
+         buf, &index.zone_id_, &index.m_, &index.n_);
+  std::string zone = buf;
+  if (zone == "south") {
+    index.zone_id_ = -index.zone_id_;
+  }
+  ADEBUG << index;
+  return index;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  boost::program_options::options_description boost_desc("Allowed options");
+  boost_desc.add_options()("help", "produce help message")(
+      "srcdir", boost::program_options::value<std::string>(),
+      "provide the pyramid map dir, the raw tiles are written next to the "
+      "node files");
+
+  boost::program_options::variables_map boost_args;
+  boost::program_options::store(
+      boost::program_options::parse_command_line(argc, argv, boost_desc),
+      boost_args);
+  boost::program_options::notify(boost_args);
+
+  if (boost_args.count("help") || !boost_args.count("srcdir")) {
+    AERROR << boost_desc;
+    return 0;
+  }
+
+  const std::string src_map_folder =
+      boost_args["srcdir"].as<std::string>() + "/";
+  PyramidMapConfig config("lossy_map");
+  if (!config.Load(src_map_folder + "config.xml")) {
+    AERROR << "Pyramid map config xml is invalid!";
+    return -1;
+  }
+  config.map_folder_path_ = src_map_folder;
+
+  const std::string map_path = src_map_folder + "map";
+  boost::filesystem::recursive_directory_iterator end_iter;
+  boost::filesystem::recursive_directory_iterator iter(map_path);
+  int converted = 0;
+  int failed = 0;
+  for (; iter != end_iter; ++iter) {
+    if (boost::filesystem::is_directory(*iter) ||
+        iter->path().extension() != "") {
+      continue;
+    }
+    const std::string node_path = iter->path().string();
+    const MapNodeIndex index = apollo::localization::msf::
+        GetMapIndexFromMapFolder(node_path.substr(map_path.length()));
+
+    PyramidMapNode node;
+    node.Init(&config, index);
+    if (!node.Load(node_path.c_str()) ||
+        !PyramidMapRawTile::Save(
+            node_path + ".raw", index,
+            static_cast<const PyramidMapMatrix&>(node.GetMapCellMatrix()))) {
+      AWARN << "Failed to convert map node: " << node_path;
+      ++failed;
+      continue;
+    }
+    ++converted;
+  }
+  AINFO << "Converted " << converted << " map nodes to raw tiles, " << failed
+        << " failed.";
+
+  return failed == 0 ? 0 : -1;
+}
@@ -16,10 +16,13 @@
 
 #include "modules/localization/msf/msf_localization.h"
 
+#include <iomanip>
+
 #include "yaml-cpp/yaml.h"
 
 #include "cyber/common/file.h"
 #include "cyber/time/clock.h"
+#include "cyber/time/time.h"
 #include "modules/common/configs/config_gflags.h"
 #include "modules/common/math/euler_angles_zxy.h"
 #include "modules/common/math/math_utils.h"
@@ -33,6 +36,11 @@ namespace localization {
 
 using apollo::common::Status;
 
+namespace {
+// imu to pose latency is published once per this many poses
+constexpr uint64_t kImuLatencyPublishInterval = 100;
+}  // namespace
+
 MSFLocalization::MSFLocalization()
     : monitor_logger_(
           apollo::common::monitor::MonitorMessageItem::LOCALIZATION),
@@ -71,6 +79,10 @@ void MSFLocalization::InitParams() {
   localization_param_.lidar_yaw_align_mode = FLAGS_lidar_yaw_align_mode;
   localization_param_.lidar_filter_size = FLAGS_lidar_filter_size;
   localization_param_.map_coverage_theshold = FLAGS_lidar_map_coverage_theshold;
+  localization_param_.map_preload_lookahead_time =
+      FLAGS_lidar_map_preload_lookahead_time;
+  localization_param_.map_preload_max_nodes = FLAGS_lidar_map_preload_max_nodes;
+  localization_param_.map_cache_size_mb = FLAGS_lidar_map_cache_size_mb;
   localization_param_.imu_lidar_max_delay_time = FLAGS_lidar_imu_max_delay_time;
   localization_param_.if_use_avx = FLAGS_if_use_avx;
 
@@ -186,6 +198,20 @@ void MSFLocalization::InitParams() {
   localization_param_.localization_std_y_threshold_2 =
       FLAGS_localization_std_y_threshold_2;
 
+  if (FLAGS_msf_imu_process_on_arrival) {
+    AINFO << "Process imu messages on arrival.";
+    return;
+  }
+
+  if (FLAGS_msf_imu_queue_size > 0) {
+    use_imu_queue_ = imu_queue_.Init(FLAGS_msf_imu_queue_size);
+    if (use_imu_queue_) {
+      imu_batch_.resize(FLAGS_msf_imu_queue_size);
+    } else {
+      AERROR << "Init imu queue failed, keep the latest imu message only.";
+    }
+  }
+
   localization_timer_.reset(new cyber::Timer(
       10, [this]() { this->OnLocalizationTimer(); }, false));
   localization_timer_->Start();
@@ -209,13 +235,17 @@ void MSFLocalization::OnPointCloud(
   }
 }
 
-void MSFLocalization::OnRawImu(
-    const std::shared_ptr<drivers::gnss::Imu> &imu_msg) {
+void MSFLocalization::IntegrateRawImu(const drivers::gnss::Imu &imu_msg) {
   if (FLAGS_imu_coord_rfu) {
-    localization_integ_.RawImuProcessRfu(*imu_msg);
+    localization_integ_.RawImuProcessRfu(imu_msg);
   } else {
-    localization_integ_.RawImuProcessFlu(*imu_msg);
+    localization_integ_.RawImuProcessFlu(imu_msg);
   }
+}
+
+void MSFLocalization::OnRawImu(
+    const std::shared_ptr<drivers::gnss::Imu> &imu_msg) {
+  IntegrateRawImu(*imu_msg);
 
   const auto &result = localization_integ_.GetLastestIntegLocalization();
 
@@ -245,10 +275,32 @@ void MSFLocalization::OnRawImu(
 
 void MSFLocalization::OnRawImuCache(
     const std::shared_ptr<drivers::gnss::Imu> &imu_msg) {
-  if (imu_msg) {
+  if (!imu_msg) {
+    return;
+  }
+  uint64_t receive_time_ns = cyber::Time::MonoTime().ToNanosecond();
+
+  if (FLAGS_msf_imu_process_on_arrival) {
     std::unique_lock<std::mutex> lock(mutex_imu_msg_);
-    raw_imu_msg_ = const_cast<std::shared_ptr<drivers::gnss::Imu> &>(imu_msg);
+    OnRawImu(imu_msg);
+    RecordImuLatency(receive_time_ns);
+    return;
+  }
+
+  if (use_imu_queue_) {
+    PendingImu pending;
+    pending.msg = imu_msg;
+    pending.receive_time_ns = receive_time_ns;
+    if (!imu_queue_.Enqueue(std::move(pending))) {
+      AWARN_EVERY(100) << "imu queue is full, drop imu message at "
+                       << std::setprecision(16) << imu_msg->measurement_time();
+    }
+    return;
   }
+
+  std::unique_lock<std::mutex> lock(mutex_imu_msg_);
+  raw_imu_msg_ = const_cast<std::shared_ptr<drivers::gnss::Imu> &>(imu_msg);
+  raw_imu_receive_time_ns_ = receive_time_ns;
 }
 
 void MSFLocalization::OnGnssBestPose(
@@ -309,11 +361,46 @@ void MSFLocalization::OnGnssHeading(
 }
 
 void MSFLocalization::OnLocalizationTimer() {
+  if (use_imu_queue_) {
+    ProcessImuQueue();
+    return;
+  }
+
   if (!raw_imu_msg_) {
     return;
   }
   std::unique_lock<std::mutex> lock(mutex_imu_msg_);
   OnRawImu(raw_imu_msg_);
+  RecordImuLatency(raw_imu_receive_time_ns_);
+}
+
+void MSFLocalization::ProcessImuQueue() {
+  uint64_t num = imu_queue_.DequeueBulk(imu_batch_.data(), imu_batch_.size());
+  if (num == 0) {
+    return;
+  }
+
+  // every imu since the last tick is integrated, only the newest pose is
+  // published
+  std::unique_lock<std::mutex> lock(mutex_imu_msg_);
+  for (uint64_t i = 0; i + 1 < num; ++i) {
+    IntegrateRawImu(*imu_batch_[i].msg);
+  }
+  OnRawImu(imu_batch_[num - 1].msg);
+  RecordImuLatency(imu_batch_[num - 1].receive_time_ns);
+
+  for (uint64_t i = 0; i < num; ++i) {
+    imu_batch_[i].msg.reset();
+  }
+}
+
+void MSFLocalization::RecordImuLatency(uint64_t receive_time_ns) {
+  uint64_t now = cyber::Time::MonoTime().ToNanosecond();
+  imu_to_pose_latency_.Record(now > receive_time_ns ? now - receive_time_ns
+                                                    : 0);
+  if (++imu_latency_sample_count_ % kImuLatencyPublishInterval == 0) {
+    publisher_->PublishImuLatency(imu_to_pose_latency_);
+  }
 }
 
 void MSFLocalization::SetPublisher(
@@ -24,6 +24,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest_prod.h"
 
@@ -36,6 +37,8 @@
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/localization/proto/localization.pb.h"
 
+#include "cyber/base/bounded_queue.h"
+#include "cyber/base/latency_histogram.h"
 #include "cyber/common/log.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
@@ -80,6 +83,14 @@ class MSFLocalization {
   void OnLocalizationTimer();
 
  private:
+  struct PendingImu {
+    std::shared_ptr<drivers::gnss::Imu> msg;
+    uint64_t receive_time_ns = 0;
+  };
+
+  void IntegrateRawImu(const drivers::gnss::Imu &imu_msg);
+  void ProcessImuQueue();
+  void RecordImuLatency(uint64_t receive_time_ns);
   bool LoadGnssAntennaExtrinsic(const std::string &file_path, double *offset_x,
                                 double *offset_y, double *offset_z,
                                 double *uncertainty_x, double *uncertainty_y,
@@ -104,8 +115,20 @@ class MSFLocalization {
 
   std::shared_ptr<LocalizationMsgPublisher> publisher_;
   std::shared_ptr<drivers::gnss::Imu> raw_imu_msg_;
+  uint64_t raw_imu_receive_time_ns_ = 0;
   std::mutex mutex_imu_msg_;
   std::unique_ptr<cyber::Timer> localization_timer_ = nullptr;
+
+  // with msf_imu_queue_size set the reader is the only producer and the
+  // timer the only consumer of imu_queue_
+  bool use_imu_queue_ = false;
+  cyber::base::BoundedQueue<PendingImu> imu_queue_;
+  std::vector<PendingImu> imu_batch_;
+
+  // from the imu message reaching the component to its pose being output,
+  // recorded by whichever thread outputs the pose
+  cyber::base::LatencyHistogram imu_to_pose_latency_;
+  uint64_t imu_latency_sample_count_ = 0;
 };
 
 }  // namespace localization
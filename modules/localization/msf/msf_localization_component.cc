@@ -117,6 +117,7 @@ bool LocalizationMsgPublisher::InitConfig() {
   lidar_local_topic_ = FLAGS_localization_lidar_topic;
   gnss_local_topic_ = FLAGS_localization_gnss_topic;
   localization_status_topic_ = FLAGS_localization_msf_status;
+  imu_latency_topic_ = FLAGS_msf_imu_latency_topic;
 
   return true;
 }
@@ -133,6 +134,11 @@ bool LocalizationMsgPublisher::InitIO() {
 
   localization_status_talker_ =
       node_->CreateWriter<LocalizationStatus>(localization_status_topic_);
+
+  if (!imu_latency_topic_.empty()) {
+    imu_latency_talker_ = node_->CreateWriter<cyber::proto::LatencyHistogram>(
+        imu_latency_topic_);
+  }
   return true;
 }
 
@@ -197,5 +203,22 @@ void LocalizationMsgPublisher::PublishLocalizationStatus(
   localization_status_talker_->Write(localization_status);
 }
 
+void LocalizationMsgPublisher::PublishImuLatency(
+    const cyber::base::LatencyHistogram& latency) {
+  if (imu_latency_talker_ == nullptr) {
+    return;
+  }
+  cyber::proto::LatencyHistogram msg;
+  msg.set_count(latency.Count());
+  msg.set_sum_ns(latency.Sum());
+  msg.set_max_ns(latency.Max());
+  msg.set_p50_us(latency.Percentile(0.5));
+  msg.set_p99_us(latency.Percentile(0.99));
+  for (uint32_t i = 0; i < cyber::base::LatencyHistogram::kBucketNum; ++i) {
+    msg.add_bucket(latency.Bucket(i));
+  }
+  imu_latency_talker_->Write(msg);
+}
+
 }  // namespace localization
 }  // namespace apollo
@@ -23,6 +23,7 @@
 #include "cyber/component/component.h"
 #include "cyber/cyber.h"
 #include "cyber/message/raw_message.h"
+#include "cyber/proto/sched_latency.pb.h"
 
 #include "modules/localization/msf/msf_localization.h"
 
@@ -87,6 +88,7 @@ class LocalizationMsgPublisher {
   void PublishLocalizationMsfGnss(const LocalizationEstimate& localization);
   void PublishLocalizationMsfLidar(const LocalizationEstimate& localization);
   void PublishLocalizationStatus(const LocalizationStatus& localization_status);
+  void PublishImuLatency(const cyber::base::LatencyHistogram& latency);
 
  private:
   std::shared_ptr<cyber::Node> node_;
@@ -110,6 +112,10 @@ class LocalizationMsgPublisher {
   std::string localization_status_topic_ = "";
   std::shared_ptr<cyber::Writer<LocalizationStatus>>
       localization_status_talker_ = nullptr;
+
+  std::string imu_latency_topic_ = "";
+  std::shared_ptr<cyber::Writer<cyber::proto::LatencyHistogram>>
+      imu_latency_talker_ = nullptr;
   double pre_system_time_ = 0.0;
 };
 
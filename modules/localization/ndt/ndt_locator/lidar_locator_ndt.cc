@@ -26,6 +26,7 @@
 #include "pcl/io/pcd_io.h"
 
 #include "cyber/common/log.h"
+#include "modules/common/math/voxel_grid.h"
 #include "modules/common/util/perf_util.h"
 #include "modules/localization/common/localization_gflags.h"
 
@@ -59,6 +60,18 @@ void LidarLocatorNdt::Init(const Eigen::Affine3d& init_location,
   ndt_target_resolution_ = FLAGS_ndt_target_resolution;
   ndt_line_search_step_size_ = FLAGS_ndt_line_search_step_size;
   ndt_transformation_epsilon_ = FLAGS_ndt_transformation_epsilon;
+  ndt_num_threads_ = FLAGS_ndt_num_threads;
+  if (FLAGS_ndt_neighbor_search_method == "direct7") {
+    ndt_neighbor_search_method_ = NeighborSearchMethod::DIRECT7;
+  } else if (FLAGS_ndt_neighbor_search_method == "direct1") {
+    ndt_neighbor_search_method_ = NeighborSearchMethod::DIRECT1;
+  } else {
+    if (FLAGS_ndt_neighbor_search_method != "kdtree") {
+      AWARN << "Unknown ndt neighbor search method "
+            << FLAGS_ndt_neighbor_search_method << ", use kdtree.";
+    }
+    ndt_neighbor_search_method_ = NeighborSearchMethod::KDTREE;
+  }
 
   if (!is_map_loaded_) {
     map_preload_node_pool_.Initial(&(map_.GetMapConfig()));
@@ -85,6 +98,8 @@ void LidarLocatorNdt::Init(const Eigen::Affine3d& init_location,
   reg_.SetResolution(static_cast<float>(ndt_target_resolution_));
   reg_.SetStepSize(ndt_line_search_step_size_);
   reg_.SetTransformationEpsilon(ndt_transformation_epsilon_);
+  reg_.SetNumThreads(ndt_num_threads_);
+  reg_.SetNeighborSearchMethod(ndt_neighbor_search_method_);
 
   is_initialized_ = true;
 }
@@ -173,10 +188,9 @@ int LidarLocatorNdt::Update(unsigned int frame_idx, const Eigen::Affine3d& pose,
   AINFO << "Online point cloud leaf size: " << proj_reslution_;
   pcl::PointCloud<pcl::PointXYZ>::Ptr online_points_filtered(
       new pcl::PointCloud<pcl::PointXYZ>());
-  pcl::VoxelGrid<pcl::PointXYZ> sor;
-  sor.setInputCloud(online_points);
-  sor.setLeafSize(proj_reslution_, proj_reslution_, proj_reslution_);
-  sor.filter(*online_points_filtered);
+  apollo::common::math::VoxelGridDownsample(
+      *online_points, proj_reslution_, proj_reslution_, proj_reslution_,
+      online_points_filtered.get());
   AINFO << "Online Pointcloud size: " << online_points->size() << "/"
         << online_points_filtered->size();
   online_filtered_timer.End("online point calc end.");
@@ -184,6 +184,9 @@ class LidarLocatorNdt {
   double ndt_target_resolution_ = 1.0;
   double ndt_line_search_step_size_ = 0.1;
   double ndt_transformation_epsilon_ = 0.01;
+  int ndt_num_threads_ = 1;
+  NeighborSearchMethod ndt_neighbor_search_method_ =
+      NeighborSearchMethod::KDTREE;
 
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -55,6 +55,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -69,6 +70,17 @@ namespace apollo {
 namespace localization {
 namespace ndt {
 
+/**@brief The ways to find the voxels a transformed source point is scored
+ * against. */
+enum class NeighborSearchMethod {
+  /**@brief Voxels whose centroid lies within the resolution, via kd-tree. */
+  KDTREE,
+  /**@brief The voxel containing the point and its six face neighbors. */
+  DIRECT7,
+  /**@brief Only the voxel containing the point. */
+  DIRECT1
+};
+
 template <typename PointSource, typename PointTarget>
 class NormalDistributionsTransform {
  protected:
@@ -124,7 +136,9 @@ class NormalDistributionsTransform {
     target_ = cloud;
     target_cells_.SetVoxelGridResolution(resolution_, resolution_, resolution_);
     target_cells_.SetInputCloud(cloud);
-    target_cells_.filter(cell_leaf, true);
+    // The direct searches index the voxels, the kd-tree is only built if used
+    target_cells_.filter(cell_leaf,
+                         search_method_ == NeighborSearchMethod::KDTREE);
   }
 
   /**@brief Provide a pointer to the input target. */
@@ -166,6 +180,25 @@ class NormalDistributionsTransform {
     outlier_ratio_ = outlier_ratio;
   }
 
+  /**@brief Set/change how the voxels near a source point are found. */
+  inline void SetNeighborSearchMethod(NeighborSearchMethod method) {
+    search_method_ = method;
+  }
+
+  /**@brief Get how the voxels near a source point are found. */
+  inline NeighborSearchMethod GetNeighborSearchMethod() const {
+    return search_method_;
+  }
+
+  /**@brief Set/change the number of threads the derivatives of the score are
+   * accumulated with. For a given value the result is deterministic. */
+  inline void SetNumThreads(int num_threads) {
+    num_threads_ = std::max(num_threads, 1);
+  }
+
+  /**@brief Get the number of threads the derivatives are accumulated with. */
+  inline int GetNumThreads() const { return num_threads_; }
+
   /**@brief Get the registration alignment probability. */
   inline double GetTransformationProbability() const {
     return trans_probability_;
@@ -256,7 +289,9 @@ class NormalDistributionsTransform {
 
   /**@brief Compute individual point contributions to derivatives of
    * probability function w.r.t. the transformation vector. */
-  double UpdateDerivatives(Eigen::Matrix<double, 6, 1> *score_gradient,
+  double UpdateDerivatives(const Eigen::Matrix<double, 3, 6> &point_gradient,
+                           const Eigen::Matrix<double, 18, 6> &point_hessian,
+                           Eigen::Matrix<double, 6, 1> *score_gradient,
                            Eigen::Matrix<double, 6, 6> *hessian,
                            const Eigen::Vector3d &x_trans,
                            const Eigen::Matrix3d &c_inv,
@@ -268,8 +303,15 @@ class NormalDistributionsTransform {
 
   /**@brief Compute point derivatives. */
   void ComputePointDerivatives(const Eigen::Vector3d &x,
+                               Eigen::Matrix<double, 3, 6> *point_gradient,
+                               Eigen::Matrix<double, 18, 6> *point_hessian,
                                bool ComputeHessian = true);
 
+  /**@brief Find the voxels the transformed source point is scored against. */
+  void FindNeighbors(const PointSource &x_trans_pt,
+                     std::vector<TargetGridLeafConstPtr> *neighborhood,
+                     std::vector<float> *distances) const;
+
   /**@brief Compute hessian of probability function w.r.t. the transformation
    * vector. */
   void ComputeHessian(Eigen::Matrix<double, 6, 6> *hessian,
@@ -278,7 +320,9 @@ class NormalDistributionsTransform {
 
   /**@brief Compute individual point contributions to hessian of probability
    * function. */
-  void UpdateHessian(Eigen::Matrix<double, 6, 6> *hessian,
+  void UpdateHessian(const Eigen::Matrix<double, 3, 6> &point_gradient,
+                     const Eigen::Matrix<double, 18, 6> &point_hessian,
+                     Eigen::Matrix<double, 6, 6> *hessian,
                      const Eigen::Vector3d &x_trans,
                      const Eigen::Matrix3d &c_inv);
 
@@ -344,6 +388,10 @@ class NormalDistributionsTransform {
   float resolution_;
   /**@brief The maximum step length. */
   double step_size_;
+  /**@brief How the voxels near a source point are found. */
+  NeighborSearchMethod search_method_;
+  /**@brief Threads the derivatives are accumulated with. */
+  int num_threads_;
   /**@brief The ratio of outliers of points w.r.t. a normal distribution,
    * Equation 6.7 [Magnusson 2009]. */
   double outlier_ratio_;
@@ -364,10 +412,12 @@ class NormalDistributionsTransform {
       h_ang_c3_, h_ang_d1_, h_ang_d2_, h_ang_d3_, h_ang_e1_, h_ang_e2_,
       h_ang_e3_, h_ang_f1_, h_ang_f2_, h_ang_f3_;
   /**@brief The first order derivative of the transformation of a point
-   * w.r.t. the transform vector, Equation 6.18 [Magnusson 2009]. */
+   * w.r.t. the transform vector, Equation 6.18 [Magnusson 2009]. Only the
+   * constant entries are kept here, each thread fills a copy per point. */
   Eigen::Matrix<double, 3, 6> point_gradient_;
   /**@brief The second order derivative of the transformation of a point
-   * w.r.t. the transform vector, Equation 6.20 [Magnusson 2009]. */
+   * w.r.t. the transform vector, Equation 6.20 [Magnusson 2009]. Only the
+   * constant entries are kept here, each thread fills a copy per point. */
   Eigen::Matrix<double, 18, 6> point_hessian_;
 
  public:
@@ -165,6 +165,8 @@ NormalDistributionsTransform<PointSource,
       target_cells_(),
       resolution_(1.0f),
       step_size_(0.1),
+      search_method_(NeighborSearchMethod::KDTREE),
+      num_threads_(1),
       outlier_ratio_(0.55),
       gauss_d1_(),
       gauss_d2_(),
@@ -324,15 +326,6 @@ NormalDistributionsTransform<PointSource, PointTarget>::ComputeDerivatives(
     Eigen::Matrix<double, 6, 1> *score_gradient,
     Eigen::Matrix<double, 6, 6> *hessian, PointCloudSourcePtr trans_cloud,
     Eigen::Matrix<double, 6, 1> *p, bool compute_hessian) {
-  // Original Point and Transformed Point
-  PointSource x_pt, x_trans_pt;
-  // Original Point and Transformed Point (for math)
-  Eigen::Vector3d x, x_trans;
-  // Occupied Voxel
-  TargetGridLeafConstPtr cell;
-  // Inverse Covariance of Occupied Voxel
-  Eigen::Matrix3d c_inv;
-
   score_gradient->setZero();
   hessian->setZero();
   double score = 0;
@@ -340,45 +333,97 @@ NormalDistributionsTransform<PointSource, PointTarget>::ComputeDerivatives(
   // Precompute Angular Derivatives (eq. 6.19 and 6.21)[Magnusson 2009]
   ComputeAngleDerivatives(*p);
 
-  // Update gradient and hessian for each point, line 17 in Algorithm 2
-  // [Magnusson 2009]
-  for (size_t idx = 0; idx < input_->points.size(); idx++) {
-    x_trans_pt = trans_cloud->points[idx];
-
-    // Find neighbors (Radius search has been experimentally faster than
-    // direct neighbor checking.
+  // Each thread sums a contiguous block of points into its own partial sums,
+  // which are added up in block order so the result only depends on
+  // num_threads_
+  const int num_blocks = num_threads_;
+  const size_t num_points = input_->points.size();
+  std::vector<double> block_scores(num_blocks, 0.0);
+  std::vector<Eigen::Matrix<double, 6, 1>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 1>>>
+      block_gradients(num_blocks, Eigen::Matrix<double, 6, 1>::Zero());
+  std::vector<Eigen::Matrix<double, 6, 6>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 6>>>
+      block_hessians(num_blocks, Eigen::Matrix<double, 6, 6>::Zero());
+
+#pragma omp parallel for schedule(static) num_threads(num_blocks)
+  for (int block = 0; block < num_blocks; ++block) {
+    // Original Point and Transformed Point
+    PointSource x_pt, x_trans_pt;
+    // Original Point and Transformed Point (for math)
+    Eigen::Vector3d x, x_trans;
+    // Occupied Voxel
+    TargetGridLeafConstPtr cell;
+    // Inverse Covariance of Occupied Voxel
+    Eigen::Matrix3d c_inv;
+    Eigen::Matrix<double, 3, 6> point_gradient = point_gradient_;
+    Eigen::Matrix<double, 18, 6> point_hessian = point_hessian_;
     std::vector<TargetGridLeafConstPtr> neighborhood;
     std::vector<float> distances;
-    target_cells_.RadiusSearch(x_trans_pt, resolution_, &neighborhood,
-                               &distances);
-
-    for (typename std::vector<TargetGridLeafConstPtr>::iterator
-             neighborhood_it = neighborhood.begin();
-         neighborhood_it != neighborhood.end(); neighborhood_it++) {
-      cell = *neighborhood_it;
-      x_pt = input_->points[idx];
-      x = Eigen::Vector3d(x_pt.x, x_pt.y, x_pt.z);
-
-      x_trans = Eigen::Vector3d(x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
-
-      // Denorm point, x_k' in Equations 6.12 and 6.13 [Magnusson 2009]
-      x_trans -= cell->GetMean();
-      // Uses precomputed covariance for speed.
-      c_inv = cell->GetInverseCov();
-
-      // Compute derivative of transform function w.r.t. transform vector,
-      // J_E and H_E in Equations 6.18 and 6.20 [Magnusson 2009]
-      ComputePointDerivatives(x);
-      // Update score, gradient and hessian, lines 19-21 in Algorithm 2,
-      // according to Equations 6.10, 6.12 and 6.13, respectively [Magnusson
-      // 2009]
-      score += UpdateDerivatives(score_gradient, hessian, x_trans, c_inv,
-                                 compute_hessian);
+
+    const size_t begin = num_points * block / num_blocks;
+    const size_t end = num_points * (block + 1) / num_blocks;
+    // Update gradient and hessian for each point, line 17 in Algorithm 2
+    // [Magnusson 2009]
+    for (size_t idx = begin; idx < end; idx++) {
+      x_trans_pt = trans_cloud->points[idx];
+
+      FindNeighbors(x_trans_pt, &neighborhood, &distances);
+
+      for (typename std::vector<TargetGridLeafConstPtr>::iterator
+               neighborhood_it = neighborhood.begin();
+           neighborhood_it != neighborhood.end(); neighborhood_it++) {
+        cell = *neighborhood_it;
+        x_pt = input_->points[idx];
+        x = Eigen::Vector3d(x_pt.x, x_pt.y, x_pt.z);
+
+        x_trans = Eigen::Vector3d(x_trans_pt.x, x_trans_pt.y, x_trans_pt.z);
+
+        // Denorm point, x_k' in Equations 6.12 and 6.13 [Magnusson 2009]
+        x_trans -= cell->GetMean();
+        // Uses precomputed covariance for speed.
+        c_inv = cell->GetInverseCov();
+
+        // Compute derivative of transform function w.r.t. transform vector,
+        // J_E and H_E in Equations 6.18 and 6.20 [Magnusson 2009]
+        ComputePointDerivatives(x, &point_gradient, &point_hessian);
+        // Update score, gradient and hessian, lines 19-21 in Algorithm 2,
+        // according to Equations 6.10, 6.12 and 6.13, respectively
+        // [Magnusson 2009]
+        block_scores[block] += UpdateDerivatives(
+            point_gradient, point_hessian, &block_gradients[block],
+            &block_hessians[block], x_trans, c_inv, compute_hessian);
+      }
     }
   }
+
+  for (int block = 0; block < num_blocks; ++block) {
+    score += block_scores[block];
+    *score_gradient += block_gradients[block];
+    *hessian += block_hessians[block];
+  }
   return (score);
 }
 
+template <typename PointSource, typename PointTarget>
+void NormalDistributionsTransform<PointSource, PointTarget>::FindNeighbors(
+    const PointSource &x_trans_pt,
+    std::vector<TargetGridLeafConstPtr> *neighborhood,
+    std::vector<float> *distances) const {
+  switch (search_method_) {
+    case NeighborSearchMethod::DIRECT7:
+      target_cells_.DirectSearch(x_trans_pt, true, neighborhood);
+      break;
+    case NeighborSearchMethod::DIRECT1:
+      target_cells_.DirectSearch(x_trans_pt, false, neighborhood);
+      break;
+    default:
+      target_cells_.RadiusSearch(x_trans_pt, resolution_, neighborhood,
+                                 distances);
+      break;
+  }
+}
+
 template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<PointSource, PointTarget>::
     ComputeAngleDerivatives(const Eigen::Matrix<double, 6, 1> &p,
@@ -451,19 +496,22 @@ void NormalDistributionsTransform<PointSource, PointTarget>::
 
 template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<
-    PointSource, PointTarget>::ComputePointDerivatives(const Eigen::Vector3d &x,
-                                                       bool compute_hessian) {
+    PointSource, PointTarget>::
+    ComputePointDerivatives(const Eigen::Vector3d &x,
+                            Eigen::Matrix<double, 3, 6> *point_gradient,
+                            Eigen::Matrix<double, 18, 6> *point_hessian,
+                            bool compute_hessian) {
   // Calculate first derivative of Transformation Equation 6.17 w.r.t. transform
   // vector p. Derivative w.r.t. ith element of transform vector corresponds to
   // column i, Equation 6.18 and 6.19 [Magnusson 2009]
-  point_gradient_(1, 3) = x.dot(j_ang_a_);
-  point_gradient_(2, 3) = x.dot(j_ang_b_);
-  point_gradient_(0, 4) = x.dot(j_ang_c_);
-  point_gradient_(1, 4) = x.dot(j_ang_d_);
-  point_gradient_(2, 4) = x.dot(j_ang_e_);
-  point_gradient_(0, 5) = x.dot(j_ang_f_);
-  point_gradient_(1, 5) = x.dot(j_ang_g_);
-  point_gradient_(2, 5) = x.dot(j_ang_h_);
+  (*point_gradient)(1, 3) = x.dot(j_ang_a_);
+  (*point_gradient)(2, 3) = x.dot(j_ang_b_);
+  (*point_gradient)(0, 4) = x.dot(j_ang_c_);
+  (*point_gradient)(1, 4) = x.dot(j_ang_d_);
+  (*point_gradient)(2, 4) = x.dot(j_ang_e_);
+  (*point_gradient)(0, 5) = x.dot(j_ang_f_);
+  (*point_gradient)(1, 5) = x.dot(j_ang_g_);
+  (*point_gradient)(2, 5) = x.dot(j_ang_h_);
 
   if (compute_hessian) {
     // Vectors from Equation 6.21 [Magnusson 2009]
@@ -480,21 +528,23 @@ void NormalDistributionsTransform<
     // transform vector p. Derivative w.r.t. ith and jth elements of transform
     // vector corresponds to the 3x1 block matrix starting at (3i,j),
     // Equation 6.20 and 6.21 [Magnusson 2009]
-    point_hessian_.block<3, 1>(9, 3) = a;
-    point_hessian_.block<3, 1>(12, 3) = b;
-    point_hessian_.block<3, 1>(15, 3) = c;
-    point_hessian_.block<3, 1>(9, 4) = b;
-    point_hessian_.block<3, 1>(12, 4) = d;
-    point_hessian_.block<3, 1>(15, 4) = e;
-    point_hessian_.block<3, 1>(9, 5) = c;
-    point_hessian_.block<3, 1>(12, 5) = e;
-    point_hessian_.block<3, 1>(15, 5) = f;
+    point_hessian->block<3, 1>(9, 3) = a;
+    point_hessian->block<3, 1>(12, 3) = b;
+    point_hessian->block<3, 1>(15, 3) = c;
+    point_hessian->block<3, 1>(9, 4) = b;
+    point_hessian->block<3, 1>(12, 4) = d;
+    point_hessian->block<3, 1>(15, 4) = e;
+    point_hessian->block<3, 1>(9, 5) = c;
+    point_hessian->block<3, 1>(12, 5) = e;
+    point_hessian->block<3, 1>(15, 5) = f;
   }
 }
 
 template <typename PointSource, typename PointTarget>
 double
 NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
+    const Eigen::Matrix<double, 3, 6> &point_gradient,
+    const Eigen::Matrix<double, 18, 6> &point_hessian,
     Eigen::Matrix<double, 6, 1> *score_gradient,
     Eigen::Matrix<double, 6, 6> *hessian, const Eigen::Vector3d &x_trans,
     const Eigen::Matrix3d &c_inv, bool compute_hessian) {
@@ -519,7 +569,7 @@ NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
   for (int i = 0; i < 6; i++) {
     // Sigma_k^-1 d(T(x,p))/dpi, Reusable portion of Equation 6.12 and 6.13
     // [Magnusson 2009]
-    cov_dxd_pi = c_inv * point_gradient_.col(i);
+    cov_dxd_pi = c_inv * point_gradient.col(i);
 
     // Update gradient, Equation 6.12 [Magnusson 2009]
     (*score_gradient)(i) += x_trans.dot(cov_dxd_pi) * e_x_cov_x;
@@ -530,9 +580,9 @@ NormalDistributionsTransform<PointSource, PointTarget>::UpdateDerivatives(
         (*hessian)(i, j) +=
             e_x_cov_x *
             (-gauss_d2_ * x_trans.dot(cov_dxd_pi) *
-                 x_trans.dot(c_inv * point_gradient_.col(j)) +
-             x_trans.dot(c_inv * point_hessian_.block<3, 1>(3 * i, j)) +
-             point_gradient_.col(j).dot(cov_dxd_pi));
+                 x_trans.dot(c_inv * point_gradient.col(j)) +
+             x_trans.dot(c_inv * point_hessian.block<3, 1>(3 * i, j)) +
+             point_gradient.col(j).dot(cov_dxd_pi));
       }
     }
   }
@@ -544,36 +594,45 @@ template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<PointSource, PointTarget>::ComputeHessian(
     Eigen::Matrix<double, 6, 6> *hessian, const PointCloudSource &trans_cloud,
     Eigen::Matrix<double, 6, 1> *p) {
-  // Original Point and Transformed Point
-  PointSource x_pt, x_trans_pt;
-  // Original Point and Transformed Point (for math)
-  Eigen::Vector3d x, x_trans;
-  // Occupied Voxel
-  TargetGridLeafConstPtr cell;
-  // Inverse Covariance of Occupied Voxel
-  Eigen::Matrix3d c_inv;
-
   hessian->setZero();
 
   // Precompute Angular Derivatives unnecessary because only used after regular
   // derivative calculation
 
-  // Update hessian for each point, line 17 in Algorithm 2 [Magnusson 2009]
-  for (size_t idx = 0; idx < input_->points.size(); idx++) {
-    x_trans_pt = trans_cloud.points[idx];
-
-    // Find neighbors (Radius search has been experimentally faster than
-    // direct neighbor checking.
+  // Blocks of points are summed per thread as in ComputeDerivatives
+  const int num_blocks = num_threads_;
+  const size_t num_points = input_->points.size();
+  std::vector<Eigen::Matrix<double, 6, 6>,
+              Eigen::aligned_allocator<Eigen::Matrix<double, 6, 6>>>
+      block_hessians(num_blocks, Eigen::Matrix<double, 6, 6>::Zero());
+
+#pragma omp parallel for schedule(static) num_threads(num_blocks)
+  for (int block = 0; block < num_blocks; ++block) {
+    // Original Point and Transformed Point
+    PointSource x_pt, x_trans_pt;
+    // Original Point and Transformed Point (for math)
+    Eigen::Vector3d x, x_trans;
+    // Occupied Voxel
+    TargetGridLeafConstPtr cell;
+    // Inverse Covariance of Occupied Voxel
+    Eigen::Matrix3d c_inv;
+    Eigen::Matrix<double, 3, 6> point_gradient = point_gradient_;
+    Eigen::Matrix<double, 18, 6> point_hessian = point_hessian_;
     std::vector<TargetGridLeafConstPtr> neighborhood;
     std::vector<float> distances;
-    target_cells_.RadiusSearch(x_trans_pt, resolution_, &neighborhood,
-                               &distances);
-
-    for (typename std::vector<TargetGridLeafConstPtr>::iterator
-             neighborhood_it = neighborhood.begin();
-         neighborhood_it != neighborhood.end(); neighborhood_it++) {
-      cell = *neighborhood_it;
-      {
+
+    const size_t begin = num_points * block / num_blocks;
+    const size_t end = num_points * (block + 1) / num_blocks;
+    // Update hessian for each point, line 17 in Algorithm 2 [Magnusson 2009]
+    for (size_t idx = begin; idx < end; idx++) {
+      x_trans_pt = trans_cloud.points[idx];
+
+      FindNeighbors(x_trans_pt, &neighborhood, &distances);
+
+      for (typename std::vector<TargetGridLeafConstPtr>::iterator
+               neighborhood_it = neighborhood.begin();
+           neighborhood_it != neighborhood.end(); neighborhood_it++) {
+        cell = *neighborhood_it;
         x_pt = input_->points[idx];
         x = Eigen::Vector3d(x_pt.x, x_pt.y, x_pt.z);
 
@@ -588,17 +647,24 @@ void NormalDistributionsTransform<PointSource, PointTarget>::ComputeHessian(
         // Compute derivative of transform function w.r.t. transform
         // vector, J_E and H_E in Equations 6.18 and 6.20 [Magnusson
         // 2009]
-        ComputePointDerivatives(x);
+        ComputePointDerivatives(x, &point_gradient, &point_hessian);
         // Update hessian, lines 21 in Algorithm 2, according to
         // Equations 6.10, 6.12 and 6.13, respectively [Magnusson 2009]
-        UpdateHessian(hessian, x_trans, c_inv);
+        UpdateHessian(point_gradient, point_hessian, &block_hessians[block],
+                      x_trans, c_inv);
       }
     }
   }
+
+  for (int block = 0; block < num_blocks; ++block) {
+    *hessian += block_hessians[block];
+  }
 }
 
 template <typename PointSource, typename PointTarget>
 void NormalDistributionsTransform<PointSource, PointTarget>::UpdateHessian(
+    const Eigen::Matrix<double, 3, 6> &point_gradient,
+    const Eigen::Matrix<double, 18, 6> &point_hessian,
     Eigen::Matrix<double, 6, 6> *hessian, const Eigen::Vector3d &x_trans,
     const Eigen::Matrix3d &c_inv) {
   Eigen::Vector3d cov_dxd_pi;
@@ -618,16 +684,16 @@ void NormalDistributionsTransform<PointSource, PointTarget>::UpdateHessian(
   for (int i = 0; i < 6; i++) {
     // Sigma_k^-1 d(T(x,p))/dpi, Reusable portion of Equation 6.12 and 6.13
     // [Magnusson 2009]
-    cov_dxd_pi = c_inv * point_gradient_.col(i);
+    cov_dxd_pi = c_inv * point_gradient.col(i);
 
     for (int j = 0; j < hessian->cols(); j++) {
       // Update hessian, Equation 6.13 [Magnusson 2009]
       (*hessian)(i, j) +=
           e_x_cov_x *
           (-gauss_d2_ * x_trans.dot(cov_dxd_pi) *
-               x_trans.dot(c_inv * point_gradient_.col(j)) +
-           x_trans.dot(c_inv * point_hessian_.block<3, 1>(3 * i, j)) +
-           point_gradient_.col(j).dot(cov_dxd_pi));
+               x_trans.dot(c_inv * point_gradient.col(j)) +
+           x_trans.dot(c_inv * point_hessian.block<3, 1>(3 * i, j)) +
+           point_gradient.col(j).dot(cov_dxd_pi));
     }
   }
 }
@@ -215,6 +215,21 @@ TEST_F(NdtSolverTestSuite, NdtSolver) {
   ASSERT_LE(fitness_score, 2.0);
   ASSERT_TRUE(has_converged);
   ASSERT_LE(iteration, 7);
+
+  // Split over threads and scored against the neighboring voxels directly.
+  NormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ> reg_direct;
+  reg_direct.SetMaximumIterations(5);
+  reg_direct.SetStepSize(0.1);
+  reg_direct.SetTransformationEpsilon(0.01);
+  reg_direct.SetNumThreads(2);
+  reg_direct.SetNeighborSearchMethod(NeighborSearchMethod::DIRECT7);
+  reg_direct.SetLeftTopCorner(target_left_top_corner);
+  reg_direct.SetResolution(ndt_map_config.map_resolutions_[0]);
+  reg_direct.SetInputTarget(cell_map, cell_pointcloud);
+  reg_direct.SetInputSource(cloud_source);
+  reg_direct.Align(output_cloud, transform.cast<float>());
+  ASSERT_LE(reg_direct.GetFitnessScore(), 2.0);
+  ASSERT_TRUE(reg_direct.HasConverged());
 }
 
 }  // namespace ndt
@@ -155,7 +155,7 @@ class VoxelGridCovariance {
                      bool searchable = true) {
     voxel_centroids_ = PointCloudPtr(new PointCloud);
     SetMap(cell_leaf, voxel_centroids_);
-    if (voxel_centroids_->size() > 0) {
+    if (searchable && voxel_centroids_->size() > 0) {
       kdtree_.setInputCloud(voxel_centroids_);
     }
   }
@@ -239,7 +239,13 @@ class VoxelGridCovariance {
   int RadiusSearch(const PointT &point, double radius,
                    std::vector<LeafConstPtr> *k_leaves,
                    std::vector<float> *k_sqr_distances,
-                   unsigned int max_nn = 0);
+                   unsigned int max_nn = 0) const;
+
+  /**@brief Search for the occupied voxel containing the query point and, if
+   * face_neighbors is set, the occupied voxels sharing a face with it. Needs
+   * no kd-tree, so it also works on a grid filtered as not searchable. */
+  int DirectSearch(const PointT &point, bool face_neighbors,
+                   std::vector<LeafConstPtr> *k_leaves) const;
 
   void GetDisplayCloud(pcl::PointCloud<pcl::PointXYZ> *cell_cloud);
 
@@ -142,7 +142,7 @@ void VoxelGridCovariance<PointT>::SetMap(const std::vector<Leaf>& map_leaves,
 template <typename PointT>
 int VoxelGridCovariance<PointT>::RadiusSearch(
     const PointT& point, double radius, std::vector<LeafConstPtr>* k_leaves,
-    std::vector<float>* k_sqr_distances, unsigned int max_nn) {
+    std::vector<float>* k_sqr_distances, unsigned int max_nn) const {
   k_leaves->clear();
 
   // Find neighbors within radius in the occupied voxel centroid cloud
@@ -154,11 +154,54 @@ int VoxelGridCovariance<PointT>::RadiusSearch(
   k_leaves->reserve(k);
   for (std::vector<int>::iterator iter = k_indices.begin();
        iter != k_indices.end(); iter++) {
-    k_leaves->push_back(&leaves_[voxel_centroids_leaf_indices_[*iter]]);
+    k_leaves->push_back(
+        &(leaves_.find(voxel_centroids_leaf_indices_[*iter])->second));
   }
   return k;
 }
 
+template <typename PointT>
+int VoxelGridCovariance<PointT>::DirectSearch(
+    const PointT& point, bool face_neighbors,
+    std::vector<LeafConstPtr>* k_leaves) const {
+  static const int kOffsets[7][3] = {{0, 0, 0},  {-1, 0, 0}, {1, 0, 0},
+                                     {0, -1, 0}, {0, 1, 0},  {0, 0, -1},
+                                     {0, 0, 1}};
+  k_leaves->clear();
+
+  // Same index as GetLeaf, so the voxel matches the one SetMap filled
+  const int ijk0 = static_cast<int>((point.x - map_left_top_corner_(0)) *
+                                    inverse_leaf_size_[0]) -
+                   min_b_[0];
+  const int ijk1 = static_cast<int>((point.y - map_left_top_corner_(1)) *
+                                    inverse_leaf_size_[1]) -
+                   min_b_[1];
+  const int ijk2 = static_cast<int>((point.z - map_left_top_corner_(2)) *
+                                    inverse_leaf_size_[2]) -
+                   min_b_[2];
+
+  const int num_offsets = face_neighbors ? 7 : 1;
+  for (int i = 0; i < num_offsets; ++i) {
+    const int i0 = ijk0 + kOffsets[i][0];
+    const int i1 = ijk1 + kOffsets[i][1];
+    const int i2 = ijk2 + kOffsets[i][2];
+    // Outside the grid the index would alias another voxel
+    if (i0 < 0 || i0 >= div_b_[0] || i1 < 0 || i1 >= div_b_[1] || i2 < 0 ||
+        i2 >= div_b_[2]) {
+      continue;
+    }
+    const int idx = i0 * divb_mul_[0] + i1 * divb_mul_[1] + i2 * divb_mul_[2];
+    typename std::map<size_t, Leaf>::const_iterator leaf_iter =
+        leaves_.find(idx);
+    if (leaf_iter == leaves_.end() ||
+        leaf_iter->second.nr_points_ < min_points_per_voxel_) {
+      continue;
+    }
+    k_leaves->push_back(&(leaf_iter->second));
+  }
+  return static_cast<int>(k_leaves->size());
+}
+
 template <typename PointT>
 void VoxelGridCovariance<PointT>::GetDisplayCloud(
     pcl::PointCloud<pcl::PointXYZ>* cell_cloud) {
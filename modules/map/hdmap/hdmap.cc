@@ -139,6 +139,37 @@ int HDMap::GetPNCJunctions(
   return impl_.GetPNCJunctions(point, distance, pnc_junctions);
 }
 
+int HDMap::GetLanes(const std::vector<apollo::common::PointENU>& points,
+                    double distance,
+                    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  return impl_.GetLanes(points, distance, lanes);
+}
+
+int HDMap::GetJunctions(
+    const std::vector<apollo::common::PointENU>& points, double distance,
+    std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const {
+  return impl_.GetJunctions(points, distance, junctions);
+}
+
+int HDMap::GetCrosswalks(
+    const std::vector<apollo::common::PointENU>& points, double distance,
+    std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const {
+  return impl_.GetCrosswalks(points, distance, crosswalks);
+}
+
+int HDMap::GetSignals(
+    const std::vector<apollo::common::PointENU>& points, double distance,
+    std::vector<std::vector<SignalInfoConstPtr>>* signals) const {
+  return impl_.GetSignals(points, distance, signals);
+}
+
+int HDMap::GetNearestLanes(const std::vector<apollo::common::PointENU>& points,
+                           std::vector<LaneInfoConstPtr>* nearest_lanes,
+                           std::vector<double>* nearest_s,
+                           std::vector<double>* nearest_l) const {
+  return impl_.GetNearestLanes(points, nearest_lanes, nearest_s, nearest_l);
+}
+
 int HDMap::GetNearestLane(const common::PointENU& point,
                           LaneInfoConstPtr* nearest_lane, double* nearest_s,
                           double* nearest_l) const {
@@ -181,6 +181,63 @@ class HDMap {
   int GetPNCJunctions(
       const apollo::common::PointENU& point, double distance,
       std::vector<PNCJunctionInfoConstPtr>* pnc_junctions) const;
+  /**
+   * @brief get all lanes in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param lanes store all lanes in the range of each point, in the order of
+   * points
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get all junctions in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param junctions store all junctions in the range of each point, in the
+   * order of points
+   * @return 0:success, otherwise failed
+   */
+  int GetJunctions(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const;
+  /**
+   * @brief get all crosswalks in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param crosswalks store all crosswalks in the range of each point, in the
+   * order of points
+   * @return 0:success, otherwise failed
+   */
+  int GetCrosswalks(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const;
+  /**
+   * @brief get all signals in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param signals store all signals in the range of each point, in the order
+   * of points
+   * @return 0:success, otherwise failed
+   */
+  int GetSignals(const std::vector<apollo::common::PointENU>& points,
+                 double distance,
+                 std::vector<std::vector<SignalInfoConstPtr>>* signals) const;
+  /**
+   * @brief get nearest lane of each point
+   * @param points the target points
+   * @param nearest_lanes the nearest lane of each point, nullptr when there is
+   * none
+   * @param nearest_s the offset of each point along its nearest lane
+   * @param nearest_l the lateral offset of each point from its nearest lane
+   * @return 0:success, otherwise, failed.
+   */
+  int GetNearestLanes(const std::vector<apollo::common::PointENU>& points,
+                      std::vector<LaneInfoConstPtr>* nearest_lanes,
+                      std::vector<double>* nearest_s,
+                      std::vector<double>* nearest_l) const;
   /**
    * @brief get nearest lane from target point,
    * @param point the target point
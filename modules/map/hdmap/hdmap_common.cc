@@ -16,7 +16,9 @@ limitations under the License.
 #include "modules/map/hdmap/hdmap_common.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <utility>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/linear_interpolation.h"
@@ -179,10 +181,73 @@ void LaneInfo::Init() {
   }
 
   CreateKDTree();
+  if (FLAGS_lane_lookup_table_resolution > 0.0) {
+    BuildLookupTables(FLAGS_lane_lookup_table_resolution);
+  }
+}
+
+void LaneInfo::BuildLookupTables(const double resolution) {
+  // The tables are sampled through the regular lookups, so build them aside
+  // and only publish them once complete.
+  const size_t num_samples =
+      std::max(static_cast<size_t>(std::ceil(total_length_ / resolution)),
+               static_cast<size_t>(1)) +
+      1;
+  std::vector<double> headings;
+  std::vector<double> curvatures;
+  std::vector<double> left_widths;
+  std::vector<double> right_widths;
+  headings.reserve(num_samples);
+  curvatures.reserve(num_samples);
+  left_widths.reserve(num_samples);
+  right_widths.reserve(num_samples);
+  for (size_t i = 0; i < num_samples; ++i) {
+    const double s =
+        std::min(static_cast<double>(i) * resolution, total_length_);
+    headings.push_back(Heading(s));
+    curvatures.push_back(Curvature(s));
+    left_widths.push_back(GetWidthFromSample(sampled_left_width_, s));
+    right_widths.push_back(GetWidthFromSample(sampled_right_width_, s));
+  }
+  lookup_headings_ = std::move(headings);
+  lookup_curvatures_ = std::move(curvatures);
+  lookup_left_widths_ = std::move(left_widths);
+  lookup_right_widths_ = std::move(right_widths);
+  lookup_resolution_ = resolution;
+}
+
+void LaneInfo::LookupSample(const double s, size_t *index,
+                            double *ratio) const {
+  const size_t last = lookup_headings_.size() - 1;
+  const double position = std::max(s, 0.0) / lookup_resolution_;
+  *index = std::min(static_cast<size_t>(position), last - 1);
+  const double start_s = static_cast<double>(*index) * lookup_resolution_;
+  const double end_s = std::min(start_s + lookup_resolution_, total_length_);
+  if (end_s - start_s <= common::math::kMathEpsilon) {
+    *ratio = 0.0;
+    return;
+  }
+  *ratio = std::min(std::max((s - start_s) / (end_s - start_s), 0.0), 1.0);
 }
 
 void LaneInfo::GetWidth(const double s, double *left_width,
                         double *right_width) const {
+  if (!lookup_left_widths_.empty()) {
+    size_t index = 0;
+    double ratio = 0.0;
+    LookupSample(s, &index, &ratio);
+    if (left_width != nullptr) {
+      *left_width = lookup_left_widths_[index] +
+                    ratio * (lookup_left_widths_[index + 1] -
+                             lookup_left_widths_[index]);
+    }
+    if (right_width != nullptr) {
+      *right_width = lookup_right_widths_[index] +
+                     ratio * (lookup_right_widths_[index + 1] -
+                              lookup_right_widths_[index]);
+    }
+    return;
+  }
   if (left_width != nullptr) {
     *left_width = GetWidthFromSample(sampled_left_width_, s);
   }
@@ -201,6 +266,13 @@ double LaneInfo::Heading(const double s) const {
     AERROR << "s:" << s << " should be <= " << accumulated_s_.back();
     return 0.0;
   }
+  if (!lookup_headings_.empty()) {
+    size_t lookup_index = 0;
+    double ratio = 0.0;
+    LookupSample(s, &lookup_index, &ratio);
+    return common::math::slerp(lookup_headings_[lookup_index], 0.0,
+                               lookup_headings_[lookup_index + 1], 1.0, ratio);
+  }
 
   auto iter = std::lower_bound(accumulated_s_.begin(), accumulated_s_.end(), s);
   int index = static_cast<int>(std::distance(accumulated_s_.begin(), iter));
@@ -225,6 +297,13 @@ double LaneInfo::Curvature(const double s) const {
     AERROR << "s:" << s << " should be <= " << accumulated_s_.back();
     return 0.0;
   }
+  if (!lookup_curvatures_.empty()) {
+    size_t index = 0;
+    double ratio = 0.0;
+    LookupSample(s, &index, &ratio);
+    return lookup_curvatures_[index] +
+           ratio * (lookup_curvatures_[index + 1] - lookup_curvatures_[index]);
+  }
 
   auto iter = std::lower_bound(accumulated_s_.begin(), accumulated_s_.end(), s);
   if (iter == accumulated_s_.end()) {
@@ -436,6 +515,57 @@ bool LaneInfo::GetProjection(const Vec2d &point, double *accumulate_s,
 
 void LaneInfo::PostProcess(const HDMapImpl &map_instance) {
   UpdateOverlaps(map_instance);
+  BuildOverlapIntervals();
+}
+
+void LaneInfo::BuildOverlapIntervals() {
+  overlap_intervals_.clear();
+  overlap_max_end_s_.clear();
+  for (const auto &overlap : overlaps_) {
+    const auto *object_info = overlap->GetObjectOverlapInfo(lane_.id());
+    if (object_info == nullptr || !object_info->has_lane_overlap_info()) {
+      continue;
+    }
+    OverlapInterval interval;
+    interval.start_s = object_info->lane_overlap_info().start_s();
+    interval.end_s = object_info->lane_overlap_info().end_s();
+    interval.overlap = overlap;
+    overlap_intervals_.push_back(std::move(interval));
+  }
+  std::stable_sort(overlap_intervals_.begin(), overlap_intervals_.end(),
+                   [](const OverlapInterval &lhs, const OverlapInterval &rhs) {
+                     return lhs.start_s < rhs.start_s;
+                   });
+  double max_end_s = -std::numeric_limits<double>::infinity();
+  overlap_max_end_s_.reserve(overlap_intervals_.size());
+  for (const auto &interval : overlap_intervals_) {
+    max_end_s = std::max(max_end_s, interval.end_s);
+    overlap_max_end_s_.push_back(max_end_s);
+  }
+}
+
+void LaneInfo::GetOverlapsInRange(
+    const double start_s, const double end_s,
+    std::vector<OverlapInfoConstPtr> *overlaps) const {
+  CHECK_NOTNULL(overlaps);
+  // Intervals before first all end before start_s, and the ones from last on
+  // all start after end_s.
+  const size_t first = std::distance(
+      overlap_max_end_s_.begin(),
+      std::lower_bound(overlap_max_end_s_.begin(), overlap_max_end_s_.end(),
+                       start_s));
+  const size_t last = std::distance(
+      overlap_intervals_.begin(),
+      std::upper_bound(overlap_intervals_.begin(), overlap_intervals_.end(),
+                       end_s,
+                       [](const double s, const OverlapInterval &interval) {
+                         return s < interval.start_s;
+                       }));
+  for (size_t i = first; i < last; ++i) {
+    if (overlap_intervals_[i].end_s >= start_s) {
+      overlaps->push_back(overlap_intervals_[i].overlap);
+    }
+  }
 }
 
 void LaneInfo::UpdateOverlaps(const HDMapImpl &map_instance) {
@@ -223,6 +223,21 @@ class LaneInfo {
   bool GetProjection(const apollo::common::math::Vec2d &point,
                      double *accumulate_s, double *lateral) const;
 
+  // The range of an overlap on the lane.
+  struct OverlapInterval {
+    double start_s = 0.0;
+    double end_s = 0.0;
+    OverlapInfoConstPtr overlap;
+  };
+  // Overlaps with a lane overlap info for the lane, sorted by start_s.
+  const std::vector<OverlapInterval> &overlap_intervals() const {
+    return overlap_intervals_;
+  }
+  // Appends the overlaps whose range intersects [start_s, end_s], sorted by
+  // start_s.
+  void GetOverlapsInRange(const double start_s, const double end_s,
+                          std::vector<OverlapInfoConstPtr> *overlaps) const;
+
  private:
   friend class HDMapImpl;
   friend class RoadInfo;
@@ -232,6 +247,10 @@ class LaneInfo {
   double GetWidthFromSample(const std::vector<LaneInfo::SampledWidth> &samples,
                             const double s) const;
   void CreateKDTree();
+  void BuildLookupTables(const double resolution);
+  void BuildOverlapIntervals();
+  // Locates s between the lookup samples index and index + 1.
+  void LookupSample(const double s, size_t *index, double *ratio) const;
   void set_road_id(const Id &road_id) { road_id_ = road_id; }
   void set_section_id(const Id &section_id) { section_id_ = section_id; }
 
@@ -261,6 +280,18 @@ class LaneInfo {
   std::vector<SampledWidth> sampled_left_road_width_;
   std::vector<SampledWidth> sampled_right_road_width_;
 
+  // Heading, curvature and widths resampled every lookup_resolution_ meters,
+  // empty unless FLAGS_lane_lookup_table_resolution is positive.
+  double lookup_resolution_ = 0.0;
+  std::vector<double> lookup_headings_;
+  std::vector<double> lookup_curvatures_;
+  std::vector<double> lookup_left_widths_;
+  std::vector<double> lookup_right_widths_;
+
+  std::vector<OverlapInterval> overlap_intervals_;
+  // The largest end_s of overlap_intervals_ up to each index.
+  std::vector<double> overlap_max_end_s_;
+
   std::vector<LaneSegmentBox> segment_box_list_;
   std::unique_ptr<LaneSegmentKDTree> lane_segment_kdtree_;
 
@@ -14,6 +14,7 @@ limitations under the License.
 =========================================================================*/
 
 #include "gtest/gtest.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/map/hdmap/hdmap_impl.h"
 
 namespace apollo {
@@ -373,6 +374,28 @@ TEST_F(HDMapCommonTestSuite, GetWidth) {
   EXPECT_NEAR(2.4, lane_info.GetWidth(3.5), 1E-3);
 }
 
+TEST_F(HDMapCommonTestSuite, LookupTables) {
+  Lane lane;
+  InitLaneObj(&lane);
+  LaneInfo lane_info(lane);
+  FLAGS_lane_lookup_table_resolution = 0.25;
+  LaneInfo table_lane_info(lane);
+  FLAGS_lane_lookup_table_resolution = 0.0;
+  for (double s = 0.0; s <= lane_info.total_length(); s += 0.1) {
+    double left_width = 0.0;
+    double right_width = 0.0;
+    double table_left_width = 0.0;
+    double table_right_width = 0.0;
+    lane_info.GetWidth(s, &left_width, &right_width);
+    table_lane_info.GetWidth(s, &table_left_width, &table_right_width);
+    EXPECT_NEAR(left_width, table_left_width, 1E-6);
+    EXPECT_NEAR(right_width, table_right_width, 1E-6);
+    EXPECT_NEAR(lane_info.Heading(s), table_lane_info.Heading(s), 1E-6);
+    EXPECT_NEAR(lane_info.Curvature(s), table_lane_info.Curvature(s), 1E-6);
+  }
+  EXPECT_NEAR(2.64, table_lane_info.GetWidth(2.6), 1E-6);
+}
+
 TEST_F(HDMapCommonTestSuite, GetEffectiveWidth) {
   Lane lane;
   InitLaneObj(&lane);
@@ -16,13 +16,17 @@ limitations under the License.
 #include "modules/map/hdmap/hdmap_impl.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <mutex>
 #include <set>
+#include <thread>
 #include <unordered_set>
 
 #include "absl/strings/match.h"
 #include "cyber/common/file.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 
@@ -40,6 +44,46 @@ Id CreateHDMapId(const std::string& string_id) {
   return id;
 }
 
+// Calls func(i) for every i in [0, size) on up to num_threads threads.
+void ParallelFor(const int size, const int num_threads,
+                 const std::function<void(int)>& func) {
+  const int num_workers = std::min(num_threads, size);
+  if (num_workers <= 1) {
+    for (int i = 0; i < size; ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::atomic<int> next(0);
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (int w = 0; w < num_workers; ++w) {
+    workers.emplace_back([&next, &func, size] {
+      for (int i = next++; i < size; i = next++) {
+        func(i);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+// Constructs the info objects of protos concurrently, then inserts them in
+// proto order so that a duplicated id keeps its last object as before.
+template <class Info, class Proto, class Table>
+void FillTable(const google::protobuf::RepeatedPtrField<Proto>& protos,
+               const int num_threads, Table* const table) {
+  std::vector<std::shared_ptr<Info>> infos(protos.size());
+  ParallelFor(protos.size(), num_threads, [&protos, &infos](const int i) {
+    infos[i].reset(new Info(protos.Get(i)));
+  });
+  table->reserve(protos.size());
+  for (int i = 0; i < protos.size(); ++i) {
+    (*table)[protos.Get(i).id().id()] = std::move(infos[i]);
+  }
+}
+
 // default lanes search radius in GetForwardNearestSignalsOnLane
 constexpr double kLanesSearchRange = 10.0;
 // backward search distance in GetForwardNearestSignalsOnLane
@@ -47,6 +91,18 @@ constexpr int kBackwardDistance = 4;
 
 }  // namespace
 
+template <class Table>
+void HDMapImpl::PostProcessTable(const Table& table,
+                                 const int num_threads) const {
+  std::vector<typename Table::mapped_type> infos;
+  infos.reserve(table.size());
+  for (const auto& info_pair : table) {
+    infos.push_back(info_pair.second);
+  }
+  ParallelFor(static_cast<int>(infos.size()), num_threads,
+              [this, &infos](const int i) { infos[i]->PostProcess(*this); });
+}
+
 int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
   Clear();
   // TODO(All) seems map_ can be changed to a local variable of this
@@ -67,54 +123,23 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
     Clear();
     map_ = map_proto;
   }
-  for (const auto& lane : map_.lane()) {
-    lane_table_[lane.id().id()].reset(new LaneInfo(lane));
-  }
-  for (const auto& junction : map_.junction()) {
-    junction_table_[junction.id().id()].reset(new JunctionInfo(junction));
-  }
-  for (const auto& signal : map_.signal()) {
-    signal_table_[signal.id().id()].reset(new SignalInfo(signal));
-  }
-  for (const auto& crosswalk : map_.crosswalk()) {
-    crosswalk_table_[crosswalk.id().id()].reset(new CrosswalkInfo(crosswalk));
-  }
-  for (const auto& stop_sign : map_.stop_sign()) {
-    stop_sign_table_[stop_sign.id().id()].reset(new StopSignInfo(stop_sign));
-  }
-  for (const auto& yield_sign : map_.yield()) {
-    yield_sign_table_[yield_sign.id().id()].reset(
-        new YieldSignInfo(yield_sign));
-  }
-  for (const auto& clear_area : map_.clear_area()) {
-    clear_area_table_[clear_area.id().id()].reset(
-        new ClearAreaInfo(clear_area));
-  }
-  for (const auto& speed_bump : map_.speed_bump()) {
-    speed_bump_table_[speed_bump.id().id()].reset(
-        new SpeedBumpInfo(speed_bump));
-  }
-  for (const auto& parking_space : map_.parking_space()) {
-    parking_space_table_[parking_space.id().id()].reset(
-        new ParkingSpaceInfo(parking_space));
-  }
-  for (const auto& pnc_junction : map_.pnc_junction()) {
-    pnc_junction_table_[pnc_junction.id().id()].reset(
-        new PNCJunctionInfo(pnc_junction));
-  }
-  for (const auto& rsu : map_.rsu()) {
-    rsu_table_[rsu.id().id()].reset(new RSUInfo(rsu));
-  }
-  for (const auto& overlap : map_.overlap()) {
-    overlap_table_[overlap.id().id()].reset(new OverlapInfo(overlap));
-  }
+  const int num_threads = FLAGS_map_loading_threads;
+  FillTable<LaneInfo>(map_.lane(), num_threads, &lane_table_);
+  FillTable<JunctionInfo>(map_.junction(), num_threads, &junction_table_);
+  FillTable<SignalInfo>(map_.signal(), num_threads, &signal_table_);
+  FillTable<CrosswalkInfo>(map_.crosswalk(), num_threads, &crosswalk_table_);
+  FillTable<StopSignInfo>(map_.stop_sign(), num_threads, &stop_sign_table_);
+  FillTable<YieldSignInfo>(map_.yield(), num_threads, &yield_sign_table_);
+  FillTable<ClearAreaInfo>(map_.clear_area(), num_threads, &clear_area_table_);
+  FillTable<SpeedBumpInfo>(map_.speed_bump(), num_threads, &speed_bump_table_);
+  FillTable<ParkingSpaceInfo>(map_.parking_space(), num_threads,
+                              &parking_space_table_);
+  FillTable<PNCJunctionInfo>(map_.pnc_junction(), num_threads,
+                             &pnc_junction_table_);
+  FillTable<RSUInfo>(map_.rsu(), num_threads, &rsu_table_);
+  FillTable<OverlapInfo>(map_.overlap(), num_threads, &overlap_table_);
+  FillTable<RoadInfo>(map_.road(), num_threads, &road_table_);
 
-  for (const auto& road : map_.road()) {
-    road_table_[road.id().id()].reset(new RoadInfo(road));
-  }
-  for (const auto& rsu : map_.rsu()) {
-    rsu_table_[rsu.id().id()].reset(new RSUInfo(rsu));
-  }
   for (const auto& road_ptr_pair : road_table_) {
     const auto& road_id = road_ptr_pair.second->id();
     for (const auto& road_section : road_ptr_pair.second->sections()) {
@@ -130,25 +155,27 @@ int HDMapImpl::LoadMapFromProto(const Map& map_proto) {
       }
     }
   }
-  for (const auto& lane_ptr_pair : lane_table_) {
-    lane_ptr_pair.second->PostProcess(*this);
-  }
-  for (const auto& junction_ptr_pair : junction_table_) {
-    junction_ptr_pair.second->PostProcess(*this);
-  }
-  for (const auto& stop_sign_ptr_pair : stop_sign_table_) {
-    stop_sign_ptr_pair.second->PostProcess(*this);
-  }
-  BuildLaneSegmentKDTree();
-  BuildJunctionPolygonKDTree();
-  BuildSignalSegmentKDTree();
-  BuildCrosswalkPolygonKDTree();
-  BuildStopSignSegmentKDTree();
-  BuildYieldSignSegmentKDTree();
-  BuildClearAreaPolygonKDTree();
-  BuildSpeedBumpSegmentKDTree();
-  BuildParkingSpacePolygonKDTree();
-  BuildPNCJunctionPolygonKDTree();
+  // Post processing only reads the other tables, so the objects can be
+  // processed concurrently.
+  PostProcessTable(lane_table_, num_threads);
+  PostProcessTable(junction_table_, num_threads);
+  PostProcessTable(stop_sign_table_, num_threads);
+
+  // Every index is built from its own table into its own members.
+  const std::vector<std::function<void()>> build_kdtrees = {
+      [this] { BuildLaneSegmentKDTree(); },
+      [this] { BuildJunctionPolygonKDTree(); },
+      [this] { BuildSignalSegmentKDTree(); },
+      [this] { BuildCrosswalkPolygonKDTree(); },
+      [this] { BuildStopSignSegmentKDTree(); },
+      [this] { BuildYieldSignSegmentKDTree(); },
+      [this] { BuildClearAreaPolygonKDTree(); },
+      [this] { BuildSpeedBumpSegmentKDTree(); },
+      [this] { BuildParkingSpacePolygonKDTree(); },
+      [this] { BuildPNCJunctionPolygonKDTree(); },
+  };
+  ParallelFor(static_cast<int>(build_kdtrees.size()), num_threads,
+              [&build_kdtrees](const int i) { build_kdtrees[i](); });
   return 0;
 }
 
@@ -226,17 +253,8 @@ int HDMapImpl::GetLanes(const Vec2d& point, double distance,
   if (lanes == nullptr || lane_segment_kdtree_ == nullptr) {
     return -1;
   }
-  lanes->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *lane_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    lanes->emplace_back(GetLaneById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *lane_segment_kdtree_, lane_table_,
+                       lanes);
 }
 
 int HDMapImpl::GetRoads(const PointENU& point, double distance,
@@ -278,17 +296,8 @@ int HDMapImpl::GetJunctions(
   if (junctions == nullptr || junction_polygon_kdtree_ == nullptr) {
     return -1;
   }
-  junctions->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *junction_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    junctions->emplace_back(GetJunctionById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *junction_polygon_kdtree_,
+                       junction_table_, junctions);
 }
 
 int HDMapImpl::GetSignals(const PointENU& point, double distance,
@@ -301,17 +310,8 @@ int HDMapImpl::GetSignals(const Vec2d& point, double distance,
   if (signals == nullptr || signal_segment_kdtree_ == nullptr) {
     return -1;
   }
-  signals->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *signal_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    signals->emplace_back(GetSignalById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *signal_segment_kdtree_, signal_table_,
+                       signals);
 }
 
 int HDMapImpl::GetCrosswalks(
@@ -326,17 +326,8 @@ int HDMapImpl::GetCrosswalks(
   if (crosswalks == nullptr || crosswalk_polygon_kdtree_ == nullptr) {
     return -1;
   }
-  crosswalks->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *crosswalk_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    crosswalks->emplace_back(GetCrosswalkById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *crosswalk_polygon_kdtree_,
+                       crosswalk_table_, crosswalks);
 }
 
 int HDMapImpl::GetStopSigns(
@@ -351,17 +342,8 @@ int HDMapImpl::GetStopSigns(
   if (stop_signs == nullptr || stop_sign_segment_kdtree_ == nullptr) {
     return -1;
   }
-  stop_signs->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *stop_sign_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    stop_signs->emplace_back(GetStopSignById(CreateHDMapId(id)));
-  }
-  return 0;
+  return SearchObjects(point, distance, *stop_sign_segment_kdtree_,
+                       stop_sign_table_, stop_signs);
 }
 
 int HDMapImpl::GetYieldSigns(
@@ -376,18 +358,8 @@ int HDMapImpl::GetYieldSigns(
   if (yield_signs == nullptr || yield_sign_segment_kdtree_ == nullptr) {
     return -1;
   }
-  yield_signs->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *yield_sign_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    yield_signs->emplace_back(GetYieldSignById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *yield_sign_segment_kdtree_,
+                       yield_sign_table_, yield_signs);
 }
 
 int HDMapImpl::GetClearAreas(
@@ -402,18 +374,8 @@ int HDMapImpl::GetClearAreas(
   if (clear_areas == nullptr || clear_area_polygon_kdtree_ == nullptr) {
     return -1;
   }
-  clear_areas->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *clear_area_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    clear_areas->emplace_back(GetClearAreaById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *clear_area_polygon_kdtree_,
+                       clear_area_table_, clear_areas);
 }
 
 int HDMapImpl::GetSpeedBumps(
@@ -428,18 +390,8 @@ int HDMapImpl::GetSpeedBumps(
   if (speed_bumps == nullptr || speed_bump_segment_kdtree_ == nullptr) {
     return -1;
   }
-  speed_bumps->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *speed_bump_segment_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    speed_bumps->emplace_back(GetSpeedBumpById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *speed_bump_segment_kdtree_,
+                       speed_bump_table_, speed_bumps);
 }
 
 int HDMapImpl::GetParkingSpaces(
@@ -454,18 +406,8 @@ int HDMapImpl::GetParkingSpaces(
   if (parking_spaces == nullptr || parking_space_polygon_kdtree_ == nullptr) {
     return -1;
   }
-  parking_spaces->clear();
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *parking_space_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
-  }
-  for (const auto& id : ids) {
-    parking_spaces->emplace_back(GetParkingSpaceById(CreateHDMapId(id)));
-  }
-
-  return 0;
+  return SearchObjects(point, distance, *parking_space_polygon_kdtree_,
+                       parking_space_table_, parking_spaces);
 }
 
 int HDMapImpl::GetPNCJunctions(
@@ -480,20 +422,68 @@ int HDMapImpl::GetPNCJunctions(
   if (pnc_junctions == nullptr || pnc_junction_polygon_kdtree_ == nullptr) {
     return -1;
   }
-  pnc_junctions->clear();
+  return SearchObjects(point, distance, *pnc_junction_polygon_kdtree_,
+                       pnc_junction_table_, pnc_junctions);
+}
 
-  std::vector<std::string> ids;
-  const int status =
-      SearchObjects(point, distance, *pnc_junction_polygon_kdtree_, &ids);
-  if (status < 0) {
-    return status;
+int HDMapImpl::GetLanes(
+    const std::vector<PointENU>& points, double distance,
+    std::vector<std::vector<LaneInfoConstPtr>>* lanes) const {
+  if (lanes == nullptr || lane_segment_kdtree_ == nullptr) {
+    return -1;
   }
+  return SearchObjects(points, distance, *lane_segment_kdtree_, lane_table_,
+                       lanes);
+}
 
-  for (const auto& id : ids) {
-    pnc_junctions->emplace_back(GetPNCJunctionById(CreateHDMapId(id)));
+int HDMapImpl::GetJunctions(
+    const std::vector<PointENU>& points, double distance,
+    std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const {
+  if (junctions == nullptr || junction_polygon_kdtree_ == nullptr) {
+    return -1;
   }
+  return SearchObjects(points, distance, *junction_polygon_kdtree_,
+                       junction_table_, junctions);
+}
 
-  return 0;
+int HDMapImpl::GetCrosswalks(
+    const std::vector<PointENU>& points, double distance,
+    std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const {
+  if (crosswalks == nullptr || crosswalk_polygon_kdtree_ == nullptr) {
+    return -1;
+  }
+  return SearchObjects(points, distance, *crosswalk_polygon_kdtree_,
+                       crosswalk_table_, crosswalks);
+}
+
+int HDMapImpl::GetSignals(
+    const std::vector<PointENU>& points, double distance,
+    std::vector<std::vector<SignalInfoConstPtr>>* signals) const {
+  if (signals == nullptr || signal_segment_kdtree_ == nullptr) {
+    return -1;
+  }
+  return SearchObjects(points, distance, *signal_segment_kdtree_,
+                       signal_table_, signals);
+}
+
+int HDMapImpl::GetNearestLanes(const std::vector<PointENU>& points,
+                               std::vector<LaneInfoConstPtr>* nearest_lanes,
+                               std::vector<double>* nearest_s,
+                               std::vector<double>* nearest_l) const {
+  CHECK_NOTNULL(nearest_lanes);
+  CHECK_NOTNULL(nearest_s);
+  CHECK_NOTNULL(nearest_l);
+  nearest_lanes->assign(points.size(), nullptr);
+  nearest_s->assign(points.size(), 0.0);
+  nearest_l->assign(points.size(), 0.0);
+  int status = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (GetNearestLane({points[i].x(), points[i].y()}, &(*nearest_lanes)[i],
+                       &(*nearest_s)[i], &(*nearest_l)[i]) != 0) {
+      status = -1;
+    }
+  }
+  return status;
 }
 
 int HDMapImpl::GetNearestLane(const PointENU& point,
@@ -1419,23 +1409,68 @@ void HDMapImpl::BuildPNCJunctionPolygonKDTree() {
 }
 
 template <class KDTree>
-int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
-                             const KDTree& kdtree,
-                             std::vector<std::string>* const results) {
+std::mutex& HDMapImpl::SearchObjectsMutex() {
   static std::mutex mutex_search_object;
-  UNIQUE_LOCK_MULTITHREAD(mutex_search_object);
+  return mutex_search_object;
+}
+
+template <class KDTree, class Table, class InfoConstPtr>
+void HDMapImpl::CollectObjects(const Vec2d& center, const double radius,
+                               const KDTree& kdtree, const Table& table,
+                               std::vector<InfoConstPtr>* const results) {
+  // one map object has many boxes, keep each object once without building
+  // a set of id strings
+  auto objects = kdtree.GetObjects(center, radius);
+  std::sort(objects.begin(), objects.end(),
+            [](const typename KDTree::ObjectPtr lhs,
+               const typename KDTree::ObjectPtr rhs) {
+              return std::less<const void*>()(lhs->object(), rhs->object());
+            });
+  auto objects_end =
+      std::unique(objects.begin(), objects.end(),
+                  [](const typename KDTree::ObjectPtr lhs,
+                     const typename KDTree::ObjectPtr rhs) {
+                    return lhs->object() == rhs->object();
+                  });
+  results->reserve(results->size() +
+                   std::distance(objects.begin(), objects_end));
+  for (auto iter = objects.begin(); iter != objects_end; ++iter) {
+    auto it = table.find((*iter)->object()->id().id());
+    if (it != table.end()) {
+      results->emplace_back(it->second);
+    }
+  }
+}
+
+template <class KDTree, class Table, class InfoConstPtr>
+int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
+                             const KDTree& kdtree, const Table& table,
+                             std::vector<InfoConstPtr>* const results) {
+  UNIQUE_LOCK_MULTITHREAD(SearchObjectsMutex<KDTree>());
   if (results == nullptr) {
     return -1;
   }
-  auto objects = kdtree.GetObjects(center, radius);
-  std::unordered_set<std::string> result_ids;
-  result_ids.reserve(objects.size());
-  for (const auto* object_ptr : objects) {
-    result_ids.insert(object_ptr->object()->id().id());
-  }
+  results->clear();
+  CollectObjects(center, radius, kdtree, table, results);
+  return 0;
+}
 
-  results->reserve(result_ids.size());
-  results->assign(result_ids.begin(), result_ids.end());
+template <class KDTree, class Table, class InfoConstPtr>
+int HDMapImpl::SearchObjects(
+    const std::vector<PointENU>& points, const double radius,
+    const KDTree& kdtree, const Table& table,
+    std::vector<std::vector<InfoConstPtr>>* const results) {
+  // a single lock for the whole batch
+  UNIQUE_LOCK_MULTITHREAD(SearchObjectsMutex<KDTree>());
+  if (results == nullptr) {
+    return -1;
+  }
+  results->resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    (*results)[i].clear();
+    CollectObjects({points[i].x(), points[i].y()}, radius, kdtree, table,
+                   &(*results)[i]);
+  }
   return 0;
 }
 
@@ -16,6 +16,7 @@ limitations under the License.
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -212,6 +213,63 @@ class HDMapImpl {
   int GetPNCJunctions(
       const apollo::common::PointENU& point, double distance,
       std::vector<PNCJunctionInfoConstPtr>* pnc_junctions) const;
+  /**
+   * @brief get all lanes in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param lanes store all lanes in the range of each point, in the order of
+   * points
+   * @return 0:success, otherwise failed
+   */
+  int GetLanes(const std::vector<apollo::common::PointENU>& points,
+               double distance,
+               std::vector<std::vector<LaneInfoConstPtr>>* lanes) const;
+  /**
+   * @brief get all junctions in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param junctions store all junctions in the range of each point, in the
+   * order of points
+   * @return 0:success, otherwise failed
+   */
+  int GetJunctions(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<JunctionInfoConstPtr>>* junctions) const;
+  /**
+   * @brief get all crosswalks in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param crosswalks store all crosswalks in the range of each point, in the
+   * order of points
+   * @return 0:success, otherwise failed
+   */
+  int GetCrosswalks(
+      const std::vector<apollo::common::PointENU>& points, double distance,
+      std::vector<std::vector<CrosswalkInfoConstPtr>>* crosswalks) const;
+  /**
+   * @brief get all signals in certain range of each point
+   * @param points the central points of the ranges
+   * @param distance the search radius
+   * @param signals store all signals in the range of each point, in the order
+   * of points
+   * @return 0:success, otherwise failed
+   */
+  int GetSignals(const std::vector<apollo::common::PointENU>& points,
+                 double distance,
+                 std::vector<std::vector<SignalInfoConstPtr>>* signals) const;
+  /**
+   * @brief get nearest lane of each point
+   * @param points the target points
+   * @param nearest_lanes the nearest lane of each point, nullptr when there is
+   * none
+   * @param nearest_s the offset of each point along its nearest lane
+   * @param nearest_l the lateral offset of each point from its nearest lane
+   * @return 0:success, otherwise, failed.
+   */
+  int GetNearestLanes(const std::vector<apollo::common::PointENU>& points,
+                      std::vector<LaneInfoConstPtr>* nearest_lanes,
+                      std::vector<double>* nearest_s,
+                      std::vector<double>* nearest_l) const;
 
   /**
    * @brief get nearest lane from target point,
@@ -393,6 +451,9 @@ class HDMapImpl {
       const Table& table, const apollo::common::math::AABoxKDTreeParams& params,
       BoxTable* const box_table, std::unique_ptr<KDTree>* const kdtree);
 
+  template <class Table>
+  void PostProcessTable(const Table& table, const int num_threads) const;
+
   void BuildLaneSegmentKDTree();
   void BuildJunctionPolygonKDTree();
   void BuildCrosswalkPolygonKDTree();
@@ -405,9 +466,22 @@ class HDMapImpl {
   void BuildPNCJunctionPolygonKDTree();
 
   template <class KDTree>
+  static std::mutex& SearchObjectsMutex();
+  template <class KDTree, class Table, class InfoConstPtr>
+  static void CollectObjects(const apollo::common::math::Vec2d& center,
+                             const double radius, const KDTree& kdtree,
+                             const Table& table,
+                             std::vector<InfoConstPtr>* const results);
+  template <class KDTree, class Table, class InfoConstPtr>
   static int SearchObjects(const apollo::common::math::Vec2d& center,
                            const double radius, const KDTree& kdtree,
-                           std::vector<std::string>* const results);
+                           const Table& table,
+                           std::vector<InfoConstPtr>* const results);
+  template <class KDTree, class Table, class InfoConstPtr>
+  static int SearchObjects(
+      const std::vector<apollo::common::PointENU>& points,
+      const double radius, const KDTree& kdtree, const Table& table,
+      std::vector<std::vector<InfoConstPtr>>* const results);
 
   void Clear();
 
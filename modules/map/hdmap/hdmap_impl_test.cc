@@ -19,6 +19,7 @@ limitations under the License.
 #include "gtest/gtest.h"
 
 #include "cyber/common/file.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/map/hdmap/hdmap_impl.h"
 
 DEFINE_string(output_dir, "/tmp", "output map directory");
@@ -325,6 +326,73 @@ TEST_F(HDMapImplTestSuite, GetNearestLane) {
   EXPECT_NEAR(l, -3.257, 1e-3);
 }
 
+TEST_F(HDMapImplTestSuite, GetObjectsOfPoints) {
+  std::vector<apollo::common::PointENU> points(3);
+  points[0].set_x(586424.09);
+  points[0].set_y(4140727.02);
+  points[1].set_x(586441.61);
+  points[1].set_y(4140746.48);
+  points[2].set_x(586449.32);
+  points[2].set_y(4140789.59);
+
+  std::vector<std::vector<LaneInfoConstPtr>> lanes;
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(points, 5, &lanes));
+  ASSERT_EQ(points.size(), lanes.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    std::vector<LaneInfoConstPtr> expected_lanes;
+    EXPECT_EQ(0, hdmap_impl_.GetLanes(points[i], 5, &expected_lanes));
+    EXPECT_EQ(expected_lanes.size(), lanes[i].size());
+  }
+  ASSERT_EQ(1, lanes[0].size());
+  EXPECT_EQ("773_1_-2", lanes[0][0]->id().id());
+
+  std::vector<std::vector<JunctionInfoConstPtr>> junctions;
+  EXPECT_EQ(0, hdmap_impl_.GetJunctions(points, 3, &junctions));
+  ASSERT_EQ(points.size(), junctions.size());
+  ASSERT_EQ(1, junctions[1].size());
+  EXPECT_EQ("1183", junctions[1][0]->id().id());
+
+  std::vector<std::vector<CrosswalkInfoConstPtr>> crosswalks;
+  EXPECT_EQ(0, hdmap_impl_.GetCrosswalks(points, 3, &crosswalks));
+  ASSERT_EQ(points.size(), crosswalks.size());
+  EXPECT_TRUE(crosswalks[0].empty());
+  ASSERT_EQ(1, crosswalks[2].size());
+  EXPECT_EQ("1277", crosswalks[2][0]->id().id());
+
+  std::vector<std::vector<SignalInfoConstPtr>> signals;
+  EXPECT_EQ(0, hdmap_impl_.GetSignals(points, 1e-6, &signals));
+  ASSERT_EQ(points.size(), signals.size());
+  for (const auto& point_signals : signals) {
+    EXPECT_TRUE(point_signals.empty());
+  }
+}
+
+TEST_F(HDMapImplTestSuite, GetNearestLanes) {
+  std::vector<apollo::common::PointENU> points(2);
+  points[0].set_x(586424.09);
+  points[0].set_y(4140727.02);
+  points[1].set_x(586441.61);
+  points[1].set_y(4140746.48);
+
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<double> s;
+  std::vector<double> l;
+  EXPECT_EQ(0, hdmap_impl_.GetNearestLanes(points, &lanes, &s, &l));
+  ASSERT_EQ(points.size(), lanes.size());
+  EXPECT_EQ("773_1_-2", lanes[0]->id().id());
+  EXPECT_NEAR(s[0], 25.891, 1e-3);
+  EXPECT_NEAR(l[0], -3.257, 1e-3);
+
+  LaneInfoConstPtr lane;
+  double nearest_s = 0.0;
+  double nearest_l = 0.0;
+  EXPECT_EQ(0, hdmap_impl_.GetNearestLane(points[1], &lane, &nearest_s,
+                                          &nearest_l));
+  EXPECT_EQ(lane->id().id(), lanes[1]->id().id());
+  EXPECT_NEAR(nearest_s, s[1], 1e-9);
+  EXPECT_NEAR(nearest_l, l[1], 1e-9);
+}
+
 TEST_F(HDMapImplTestSuite, GetRoadBoundaries) {
   apollo::common::PointENU point;
   point.set_x(586427.58);
@@ -431,5 +499,70 @@ TEST_F(HDMapImplTestSuite, GetLocalMap) {
   cyber::common::DeleteFile(output_bin_file);
 }
 
+TEST_F(HDMapImplTestSuite, ParallelLoad) {
+  FLAGS_map_loading_threads = 4;
+  HDMapImpl parallel_hdmap_impl;
+  EXPECT_EQ(0, parallel_hdmap_impl.LoadMapFromFile(kMapFilename));
+  FLAGS_map_loading_threads = 1;
+
+  Id lane_id;
+  lane_id.set_id("1272_1_-1");
+  auto lane = hdmap_impl_.GetLaneById(lane_id);
+  auto parallel_lane = parallel_hdmap_impl.GetLaneById(lane_id);
+  ASSERT_NE(nullptr, lane);
+  ASSERT_NE(nullptr, parallel_lane);
+  EXPECT_EQ(lane->road_id().id(), parallel_lane->road_id().id());
+  EXPECT_EQ(lane->overlaps().size(), parallel_lane->overlaps().size());
+  EXPECT_EQ(lane->cross_lanes().size(), parallel_lane->cross_lanes().size());
+
+  apollo::common::PointENU point;
+  point.set_x(586424.09);
+  point.set_y(4140727.02);
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<LaneInfoConstPtr> parallel_lanes;
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(point, 50, &lanes));
+  EXPECT_EQ(0, parallel_hdmap_impl.GetLanes(point, 50, &parallel_lanes));
+  ASSERT_EQ(lanes.size(), parallel_lanes.size());
+  for (size_t i = 0; i < lanes.size(); ++i) {
+    EXPECT_EQ(lanes[i]->id().id(), parallel_lanes[i]->id().id());
+  }
+
+  std::vector<JunctionInfoConstPtr> junctions;
+  std::vector<JunctionInfoConstPtr> parallel_junctions;
+  EXPECT_EQ(0, hdmap_impl_.GetJunctions(point, 50, &junctions));
+  EXPECT_EQ(0, parallel_hdmap_impl.GetJunctions(point, 50,
+                                                &parallel_junctions));
+  EXPECT_EQ(junctions.size(), parallel_junctions.size());
+}
+
+TEST_F(HDMapImplTestSuite, GetOverlapsInRange) {
+  apollo::common::PointENU point;
+  point.set_x(586424.09);
+  point.set_y(4140727.02);
+  std::vector<LaneInfoConstPtr> lanes;
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(point, 100, &lanes));
+  ASSERT_FALSE(lanes.empty());
+  for (const auto& lane : lanes) {
+    const auto& intervals = lane->overlap_intervals();
+    EXPECT_LE(intervals.size(), lane->overlaps().size());
+    for (size_t i = 1; i < intervals.size(); ++i) {
+      EXPECT_LE(intervals[i - 1].start_s, intervals[i].start_s);
+    }
+    for (double start_s = -1.0; start_s < lane->total_length() + 1.0;
+         start_s += 3.0) {
+      const double end_s = start_s + 5.0;
+      std::vector<OverlapInfoConstPtr> overlaps;
+      lane->GetOverlapsInRange(start_s, end_s, &overlaps);
+      std::vector<OverlapInfoConstPtr> expected_overlaps;
+      for (const auto& interval : intervals) {
+        if (interval.start_s <= end_s && interval.end_s >= start_s) {
+          expected_overlaps.push_back(interval.overlap);
+        }
+      }
+      EXPECT_EQ(expected_overlaps, overlaps);
+    }
+  }
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -89,24 +89,28 @@ std::unique_ptr<HDMap> CreateMap(const MapMsg& map_msg) {
   return hdmap;
 }
 
-std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
+std::shared_ptr<const HDMap> HDMapUtil::base_map_ = nullptr;
+std::atomic<uint64_t> HDMapUtil::base_map_version_{0};
 uint64_t HDMapUtil::base_map_seq_ = 0;
 std::mutex HDMapUtil::base_map_mutex_;
 
-std::unique_ptr<HDMap> HDMapUtil::sim_map_ = nullptr;
+std::shared_ptr<const HDMap> HDMapUtil::sim_map_ = nullptr;
 std::mutex HDMapUtil::sim_map_mutex_;
 
 const HDMap* HDMapUtil::BaseMapPtr(const MapMsg& map_msg) {
   std::lock_guard<std::mutex> lock(base_map_mutex_);
-  if (base_map_ != nullptr &&
+  auto base_map = std::atomic_load(&base_map_);
+  if (base_map != nullptr &&
       base_map_seq_ == map_msg.header().sequence_num()) {
     // avoid re-create map in the same cycle.
-    return base_map_.get();
+    return base_map.get();
   } else {
-    base_map_ = CreateMap(map_msg);
+    base_map = CreateMap(map_msg);
+    std::atomic_store(&base_map_, base_map);
+    ++base_map_version_;
     base_map_seq_ = map_msg.header().sequence_num();
   }
-  return base_map_.get();
+  return base_map.get();
 }
 
 const HDMap* HDMapUtil::BaseMapPtr() {
@@ -132,41 +136,68 @@ const HDMap* HDMapUtil::BaseMapPtr() {
       base_map_seq_ = latest.header().sequence_num();
     }
   } else*/
-  if (base_map_ == nullptr) {
+  return BaseMapSnapshot().get();
+}
+
+std::shared_ptr<const HDMap> HDMapUtil::BaseMapSnapshot() {
+  auto base_map = std::atomic_load(&base_map_);
+  if (base_map == nullptr) {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
-    if (base_map_ == nullptr) {  // Double check.
-      base_map_ = CreateMap(BaseMapFile());
+    base_map = std::atomic_load(&base_map_);
+    if (base_map == nullptr) {  // Double check.
+      base_map = CreateMap(BaseMapFile());
+      std::atomic_store(&base_map_, base_map);
+      ++base_map_version_;
     }
   }
-  return base_map_.get();
+  return base_map;
 }
 
 const HDMap& HDMapUtil::BaseMap() { return *CHECK_NOTNULL(BaseMapPtr()); }
 
-const HDMap* HDMapUtil::SimMapPtr() {
+const HDMap* HDMapUtil::SimMapPtr() { return SimMapSnapshot().get(); }
+
+std::shared_ptr<const HDMap> HDMapUtil::SimMapSnapshot() {
   if (FLAGS_use_navigation_mode) {
-    return BaseMapPtr();
-  } else if (sim_map_ == nullptr) {
+    return BaseMapSnapshot();
+  }
+  auto sim_map = std::atomic_load(&sim_map_);
+  if (sim_map == nullptr) {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
-    if (sim_map_ == nullptr) {  // Double check.
-      sim_map_ = CreateMap(SimMapFile());
+    sim_map = std::atomic_load(&sim_map_);
+    if (sim_map == nullptr) {  // Double check.
+      sim_map = CreateMap(SimMapFile());
+      std::atomic_store(&sim_map_, sim_map);
     }
   }
-  return sim_map_.get();
+  return sim_map;
 }
 
 const HDMap& HDMapUtil::SimMap() { return *CHECK_NOTNULL(SimMapPtr()); }
 
 bool HDMapUtil::ReloadMaps() {
-  {
+  // Build the new versions aside, readers keep loading the current ones until
+  // they are swapped in.
+  std::shared_ptr<const HDMap> base_map = CreateMap(BaseMapFile());
+  std::shared_ptr<const HDMap> sim_map = CreateMap(SimMapFile());
+  if (base_map != nullptr) {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
-    base_map_ = CreateMap(BaseMapFile());
+    std::atomic_store(&base_map_, base_map);
+    ++base_map_version_;
+  } else {
+    AERROR << "Keep the current base map, failed to reload it.";
   }
-  {
+  if (sim_map != nullptr) {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
-    sim_map_ = CreateMap(SimMapFile());
+    std::atomic_store(&sim_map_, sim_map);
+  } else {
+    AERROR << "Keep the current sim map, failed to reload it.";
   }
-  return base_map_ != nullptr && sim_map_ != nullptr;
+  return base_map != nullptr && sim_map != nullptr;
+}
+
+std::future<bool> HDMapUtil::ReloadMapsAsync() {
+  return std::async(std::launch::async, &HDMapUtil::ReloadMaps);
 }
 
 }  // namespace hdmap
@@ -15,7 +15,10 @@ limitations under the License.
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "absl/strings/str_cat.h"
@@ -74,11 +77,18 @@ inline apollo::hdmap::Id MakeMapId(const std::string& id) {
 
 std::unique_ptr<HDMap> CreateMap(const std::string& map_file_path);
 
+// The maps are immutable snapshots swapped atomically on reload. Readers
+// holding a snapshot from BaseMapSnapshot() or SimMapSnapshot() keep it valid
+// across reloads, while the raw pointers of BaseMapPtr() and SimMapPtr() are
+// only valid until the next reload.
 class HDMapUtil {
  public:
   // Get default base map from the file specified by global flags.
   // Return nullptr if failed to load.
   static const HDMap* BaseMapPtr();
+  // Get the current version of the base map, loading it on the first call.
+  // Return nullptr if failed to load.
+  static std::shared_ptr<const HDMap> BaseMapSnapshot();
   static const HDMap* BaseMapPtr(const relative_map::MapMsg& map_msg);
   // Guarantee to return a valid base_map, or else raise fatal error.
   static const HDMap& BaseMap();
@@ -86,21 +96,33 @@ class HDMapUtil {
   // Get default sim_map from the file specified by global flags.
   // Return nullptr if failed to load.
   static const HDMap* SimMapPtr();
+  // Get the current version of the sim_map, loading it on the first call.
+  // Return nullptr if failed to load.
+  static std::shared_ptr<const HDMap> SimMapSnapshot();
 
   // Guarantee to return a valid sim_map, or else raise fatal error.
   static const HDMap& SimMap();
 
-  // Reload maps from the file specified by global flags.
+  // Reload maps from the file specified by global flags. The new versions are
+  // built while readers keep using the current ones, which stay in place if
+  // a map fails to load.
   static bool ReloadMaps();
+  // Reload maps as ReloadMaps() does on a background thread.
+  static std::future<bool> ReloadMapsAsync();
+
+  // The number of versions of the base map installed so far.
+  static uint64_t BaseMapVersion() { return base_map_version_.load(); }
 
  private:
   HDMapUtil() = delete;
 
-  static std::unique_ptr<HDMap> base_map_;
+  static std::shared_ptr<const HDMap> base_map_;
+  static std::atomic<uint64_t> base_map_version_;
   static uint64_t base_map_seq_;
+  // Serializes the writers of base_map_, readers load it atomically.
   static std::mutex base_map_mutex_;
 
-  static std::unique_ptr<HDMap> sim_map_;
+  static std::shared_ptr<const HDMap> sim_map_;
   static std::mutex sim_map_mutex_;
 };
 
@@ -52,5 +52,29 @@ void HDMapUtilTestSuite::InitMapProto(Map* map_proto) {
   lane->set_type(Lane::CITY_DRIVING);
 }
 
+TEST_F(HDMapUtilTestSuite, ReloadMapsKeepsSnapshots) {
+  FLAGS_map_dir = "modules/map/hdmap/test-data";
+  FLAGS_base_map_filename = "base_map.bin";
+  FLAGS_sim_map_filename = "base_map.bin";
+  const auto base_map = HDMapUtil::BaseMapSnapshot();
+  const auto sim_map = HDMapUtil::SimMapSnapshot();
+  ASSERT_NE(nullptr, base_map);
+  ASSERT_NE(nullptr, sim_map);
+  EXPECT_EQ(base_map.get(), HDMapUtil::BaseMapPtr());
+  const uint64_t version = HDMapUtil::BaseMapVersion();
+
+  auto reload = HDMapUtil::ReloadMapsAsync();
+  // Readers are not blocked while the new versions are built.
+  EXPECT_NE(nullptr, HDMapUtil::BaseMapSnapshot());
+  EXPECT_TRUE(reload.get());
+  EXPECT_EQ(version + 1, HDMapUtil::BaseMapVersion());
+  EXPECT_NE(base_map, HDMapUtil::BaseMapSnapshot());
+  EXPECT_NE(sim_map, HDMapUtil::SimMapSnapshot());
+
+  // The previous versions stay valid for the readers holding them.
+  EXPECT_NE(nullptr, base_map->GetLaneById(MakeMapId("1272_1_-1")));
+  EXPECT_NE(nullptr, sim_map->GetLaneById(MakeMapId("1272_1_-1")));
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -117,5 +117,142 @@ int CudaNearestSegment::FindNearestSegment(double x, double y) {
   }
   return min_index - 1;
 }
+
+CudaBatchNearestSegment::~CudaBatchNearestSegment() {
+  cudaFree(dev_seg_);
+  cudaFree(dev_points_);
+  cudaFree(dev_indices_);
+}
+
+bool CudaBatchNearestSegment::IsAvailable() {
+  int device_count = 0;
+  return cudaGetDeviceCount(&device_count) == cudaSuccess && device_count > 0;
+}
+
+bool CudaBatchNearestSegment::Reserve(std::size_t num_segments,
+                                      std::size_t num_points) {
+  if (num_segments > segment_capacity_) {
+    cudaFree(dev_seg_);
+    dev_seg_ = nullptr;
+    segment_capacity_ = 0;
+    if (cudaMalloc((void**)&dev_seg_,
+                   sizeof(CudaProjectionSegment) * num_segments) !=
+        cudaSuccess) {
+      AERROR << "Failed to allocate " << num_segments
+             << " segments on cuda device";
+      return false;
+    }
+    segment_capacity_ = num_segments;
+  }
+  if (num_points > point_capacity_) {
+    cudaFree(dev_points_);
+    cudaFree(dev_indices_);
+    dev_points_ = nullptr;
+    dev_indices_ = nullptr;
+    point_capacity_ = 0;
+    if (cudaMalloc((void**)&dev_points_, sizeof(double) * 2 * num_points) !=
+            cudaSuccess ||
+        cudaMalloc((void**)&dev_indices_, sizeof(int) * num_points) !=
+            cudaSuccess) {
+      AERROR << "Failed to allocate " << num_points
+             << " points on cuda device";
+      return false;
+    }
+    point_capacity_ = num_points;
+  }
+  return true;
+}
+
+__global__ void NearestSegments(const CudaProjectionSegment* dev_seg,
+                                int32_t num_segments, const double* dev_points,
+                                int32_t num_points, int* dev_indices) {
+  int32_t index = blockDim.x * blockIdx.x + threadIdx.x;
+  if (index >= num_points) {
+    return;
+  }
+  const double x = dev_points[2 * index];
+  const double y = dev_points[2 * index + 1];
+  double min_distance = 0.0;
+  int min_index = -1;
+  for (int32_t i = 0; i < num_segments; ++i) {
+    const auto& seg = dev_seg[i];
+    const double x0 = x - seg.start_x;
+    const double y0 = y - seg.start_y;
+    const double proj = x0 * seg.unit_x + y0 * seg.unit_y;
+    double distance = 0.0;
+    if (proj <= 0.0) {
+      distance = x0 * x0 + y0 * y0;
+    } else if (proj >= seg.length) {
+      const double x1 = x - seg.end_x;
+      const double y1 = y - seg.end_y;
+      distance = x1 * x1 + y1 * y1;
+    } else {
+      const double cross = x0 * seg.unit_y - y0 * seg.unit_x;
+      distance = cross * cross;
+    }
+    if (min_index < 0 || distance < min_distance) {
+      min_distance = distance;
+      min_index = i;
+    }
+  }
+  dev_indices[index] = min_index;
+}
+
+bool CudaBatchNearestSegment::FindNearestSegments(
+    const std::vector<apollo::common::math::LineSegment2d>& segments,
+    const std::vector<apollo::common::math::Vec2d>& points,
+    std::vector<int>* indices) {
+  if (segments.empty() || indices == nullptr) {
+    return false;
+  }
+  indices->resize(points.size());
+  if (points.empty()) {
+    return true;
+  }
+  if (!Reserve(segments.size(), points.size())) {
+    return false;
+  }
+
+  host_seg_.resize(segments.size());
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    const auto& segment = segments[i];
+    // Degenerated segments project on their start point, as on the host.
+    const bool degenerated =
+        segment.length() <= apollo::common::math::kMathEpsilon;
+    host_seg_[i].start_x = segment.start().x();
+    host_seg_[i].start_y = segment.start().y();
+    host_seg_[i].end_x = segment.end().x();
+    host_seg_[i].end_y = segment.end().y();
+    host_seg_[i].unit_x = degenerated ? 0.0 : segment.unit_direction().x();
+    host_seg_[i].unit_y = degenerated ? 0.0 : segment.unit_direction().y();
+    host_seg_[i].length = segment.length();
+  }
+  host_points_.resize(2 * points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    host_points_[2 * i] = points[i].x();
+    host_points_[2 * i + 1] = points[i].y();
+  }
+
+  if (cudaMemcpy(dev_seg_, host_seg_.data(),
+                 host_seg_.size() * sizeof(CudaProjectionSegment),
+                 cudaMemcpyHostToDevice) != cudaSuccess ||
+      cudaMemcpy(dev_points_, host_points_.data(),
+                 host_points_.size() * sizeof(double),
+                 cudaMemcpyHostToDevice) != cudaSuccess) {
+    AERROR << "Failed to copy to cuda device";
+    return false;
+  }
+  const int32_t num_points = static_cast<int32_t>(points.size());
+  NearestSegments<<<(num_points + 255) / 256, 256>>>(
+      dev_seg_, static_cast<int32_t>(segments.size()), dev_points_,
+      num_points, dev_indices_);
+  if (cudaMemcpy(indices->data(), dev_indices_, num_points * sizeof(int),
+                 cudaMemcpyDeviceToHost) != cudaSuccess) {
+    AERROR << "Failed to find nearest segments on cuda device";
+    return false;
+  }
+  return true;
+}
+
 }  // namespace pnc_map
 }  // namespace apollo
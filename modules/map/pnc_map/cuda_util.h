@@ -50,5 +50,44 @@ class CudaNearestSegment {
   cublasHandle_t handle_;
 };
 
+struct CudaProjectionSegment {
+  double start_x;
+  double start_y;
+  double end_x;
+  double end_y;
+  double unit_x;
+  double unit_y;
+  double length;
+};
+
+// Finds the nearest segment of many points at once, one device thread per
+// point, with the same distance as LineSegment2d::DistanceSquareTo. Device
+// buffers grow with the largest batch seen so far.
+class CudaBatchNearestSegment {
+ public:
+  CudaBatchNearestSegment() = default;
+
+  ~CudaBatchNearestSegment();
+
+  // Whether there is a cuda device to run on.
+  static bool IsAvailable();
+
+  bool FindNearestSegments(
+      const std::vector<apollo::common::math::LineSegment2d>& segments,
+      const std::vector<apollo::common::math::Vec2d>& points,
+      std::vector<int>* indices);
+
+ private:
+  bool Reserve(std::size_t num_segments, std::size_t num_points);
+
+  std::size_t segment_capacity_ = 0;
+  std::size_t point_capacity_ = 0;
+  std::vector<CudaProjectionSegment> host_seg_;
+  std::vector<double> host_points_;
+  CudaProjectionSegment* dev_seg_ = nullptr;
+  double* dev_points_ = nullptr;
+  int* dev_indices_ = nullptr;
+};
+
 }  // namespace pnc_map
 }  // namespace apollo
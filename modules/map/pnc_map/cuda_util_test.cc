@@ -43,5 +43,21 @@ TEST(CudaUtil, CudaNearestSegment) {
   EXPECT_EQ(1, nearest_index);
 }
 
+TEST(CudaUtil, CudaBatchNearestSegment) {
+  if (!CudaBatchNearestSegment::IsAvailable()) {
+    return;
+  }
+  CudaBatchNearestSegment segment_tool;
+  std::vector<LineSegment2d> segments;
+  segments.emplace_back(Vec2d(0, 0), Vec2d(1, 0));
+  segments.emplace_back(Vec2d(1, 0), Vec2d(5, 0));
+  segments.emplace_back(Vec2d(5, 0), Vec2d(5, 5));
+
+  std::vector<int> indices;
+  EXPECT_TRUE(segment_tool.FindNearestSegments(
+      segments, {{0.5, 1.0}, {3.0, 1.0}, {6.0, 3.0}, {-1.0, 0.0}}, &indices));
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 0}), indices);
+}
+
 }  // namespace pnc_map
 }  // namespace apollo
@@ -18,18 +18,27 @@
 
 #include <algorithm>
 #include <limits>
+#include <mutex>
 #include <unordered_map>
 
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/line_segment2d_batch.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/polygon2d.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/util/string_util.h"
+#if USE_GPU == 1
+#include "modules/map/pnc_map/cuda_util.h"
+#endif
 
 // https://nacto.org/publication/urban-street-design-guide/street-design-elements/lane-width/
 DEFINE_double(default_lane_width, 3.048, "default lane width is about 10 feet");
+DEFINE_int32(path_gpu_projection_min_points, 256,
+             "smallest batch of points Path::GetProjections searches on the "
+             "gpu when built with gpu support, non-positive to always use "
+             "the cpu");
 
 namespace apollo {
 namespace hdmap {
@@ -59,6 +68,28 @@ bool FindLaneSegment(const MapPathPoint& p1, const MapPathPoint& p2,
   return false;
 }
 
+#if USE_GPU == 1
+// The device search only pays off for batches large enough to hide the
+// copies, and the one device context is shared by all paths.
+bool FindNearestSegmentsOnGpu(const std::vector<LineSegment2d>& segments,
+                              const std::vector<Vec2d>& points,
+                              std::vector<int>* indices) {
+  if (FLAGS_path_gpu_projection_min_points <= 0 ||
+      static_cast<int>(points.size()) < FLAGS_path_gpu_projection_min_points) {
+    return false;
+  }
+  static const bool available =
+      apollo::pnc_map::CudaBatchNearestSegment::IsAvailable();
+  if (!available) {
+    return false;
+  }
+  static std::mutex mutex;
+  static auto* finder = new apollo::pnc_map::CudaBatchNearestSegment();
+  std::lock_guard<std::mutex> lock(mutex);
+  return finder->FindNearestSegments(segments, points, indices);
+}
+#endif
+
 }  // namespace
 
 std::string LaneWaypoint::DebugString() const {
@@ -755,28 +786,8 @@ bool Path::GetProjectionWithHueristicParams(const Vec2d& point,
     }
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
-  const auto prod = nearest_seg.ProductOntoUnit(point);
-  const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
-    *accumulate_s = std::min(proj, nearest_seg.length());
-    if (proj < 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
-    if (proj > 0) {
-      *lateral = prod;
-    } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-    }
-  } else {
-    *accumulate_s = accumulated_s_[min_index] +
-                    std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
-  }
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
   return true;
 }
 
@@ -804,29 +815,120 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
     }
   }
   *min_distance = std::sqrt(*min_distance);
-  const auto& nearest_seg = segments_[min_index];
+  GetProjectionOnSegment(point, min_index, *min_distance, accumulate_s,
+                         lateral);
+  return true;
+}
+
+bool Path::GetProjectionWithWarmStartS(const Vec2d& point,
+                                       double* accumulate_s,
+                                       double* lateral) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr) {
+    return false;
+  }
+  CHECK_GE(num_points_, 2);
+  int min_index = std::min(GetIndexFromS(*accumulate_s).id, num_segments_ - 1);
+  double min_distance = segments_[min_index].DistanceSquareTo(point);
+  // the distance to the segments is unimodal around a close enough start, so
+  // walk towards the nearer neighbor until it stops decreasing
+  while (min_index + 1 < num_segments_) {
+    const double distance = segments_[min_index + 1].DistanceSquareTo(point);
+    if (distance >= min_distance) {
+      break;
+    }
+    min_distance = distance;
+    ++min_index;
+  }
+  while (min_index > 0) {
+    const double distance = segments_[min_index - 1].DistanceSquareTo(point);
+    if (distance >= min_distance) {
+      break;
+    }
+    min_distance = distance;
+    --min_index;
+  }
+  GetProjectionOnSegment(point, min_index, std::sqrt(min_distance),
+                         accumulate_s, lateral);
+  return true;
+}
+
+bool Path::GetProjections(const std::vector<Vec2d>& points,
+                          std::vector<double>* accumulate_s,
+                          std::vector<double>* lateral) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr) {
+    return false;
+  }
+  accumulate_s->resize(points.size());
+  lateral->resize(points.size());
+  if (use_path_approximation_) {
+    double min_distance = 0.0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (!approximation_.GetProjection(*this, points[i], &(*accumulate_s)[i],
+                                        &(*lateral)[i], &min_distance)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  CHECK_GE(num_points_, 2);
+  std::vector<int> min_indices;
+  std::vector<double> min_distances;
+#if USE_GPU == 1
+  if (FindNearestSegmentsOnGpu(segments_, points, &min_indices)) {
+    min_distances.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      min_distances.push_back(
+          segments_[min_indices[i]].DistanceSquareTo(points[i]));
+    }
+  }
+#endif
+  if (min_distances.size() != points.size()) {
+    const common::math::LineSegment2dBatch batch(segments_);
+    min_indices.resize(points.size());
+    min_distances.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      min_indices[i] = batch.NearestSegment(points[i], &min_distances[i]);
+    }
+  }
+  for (size_t i = 0; i < points.size(); ++i) {
+    GetProjectionOnSegment(points[i], min_indices[i],
+                           std::sqrt(min_distances[i]), &(*accumulate_s)[i],
+                           &(*lateral)[i]);
+  }
+  return true;
+}
+
+void Path::GetProjectionOnSegment(const Vec2d& point, const int index,
+                                  const double distance, double* accumulate_s,
+                                  double* lateral) const {
+  const auto& nearest_seg = segments_[index];
   const auto prod = nearest_seg.ProductOntoUnit(point);
   const auto proj = nearest_seg.ProjectOntoUnit(point);
-  if (min_index == 0) {
+  if (index == 0) {
     *accumulate_s = std::min(proj, nearest_seg.length());
     if (proj < 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * distance;
     }
-  } else if (min_index == num_segments_ - 1) {
-    *accumulate_s = accumulated_s_[min_index] + std::max(0.0, proj);
+  } else if (index == num_segments_ - 1) {
+    *accumulate_s = accumulated_s_[index] + std::max(0.0, proj);
     if (proj > 0) {
       *lateral = prod;
     } else {
-      *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+      *lateral = (prod > 0.0 ? 1 : -1) * distance;
     }
   } else {
-    *accumulate_s = accumulated_s_[min_index] +
+    *accumulate_s = accumulated_s_[index] +
                     std::max(0.0, std::min(proj, nearest_seg.length()));
-    *lateral = (prod > 0.0 ? 1 : -1) * *min_distance;
+    *lateral = (prod > 0.0 ? 1 : -1) * distance;
   }
-  return true;
 }
 
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
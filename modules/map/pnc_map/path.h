@@ -260,6 +260,18 @@ class Path {
                      double* lateral) const;
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral, double* distance) const;
+  // Project point by searching locally around the segment at accumulate_s,
+  // which holds the s of a nearby projection on input (e.g. the previous
+  // point of a polyline) and the projected s on output.
+  bool GetProjectionWithWarmStartS(const common::math::Vec2d& point,
+                                   double* accumulate_s,
+                                   double* lateral) const;
+  // Project a batch of points. The nearest segments are searched on the gpu
+  // for batches of at least FLAGS_path_gpu_projection_min_points points when
+  // built with gpu support and a device is present, and with simd otherwise.
+  bool GetProjections(const std::vector<common::math::Vec2d>& points,
+                      std::vector<double>* accumulate_s,
+                      std::vector<double>* lateral) const;
 
   bool GetHeadingAlongPath(const common::math::Vec2d& point,
                            double* heading) const;
@@ -340,6 +352,9 @@ class Path {
   void InitOverlaps();
 
   double GetSample(const std::vector<double>& samples, const double s) const;
+  void GetProjectionOnSegment(const common::math::Vec2d& point,
+                              const int index, const double distance,
+                              double* accumulate_s, double* lateral) const;
 
   using GetOverlapFromLaneFunc =
       std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
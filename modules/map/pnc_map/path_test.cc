@@ -458,6 +458,20 @@ TEST(TestSuite, hdmap_circle_path) {
                 1e-6);
   }
 
+  // Points sweeping along the path projected with the previous s as warm
+  // start match the full search.
+  double warm_start_s = 0.0;
+  for (int case_id = 0; case_id <= 200; ++case_id) {
+    const double p = M_PI_2 * static_cast<double>(case_id) / 200.0;
+    const double r = kRadius + RandomDouble(-3.0, 3.0);
+    const Vec2d point(r * cos(p), r * sin(p));
+    EXPECT_TRUE(
+        path_no_approximation.GetProjection(point, &accumulate_s, &lateral));
+    EXPECT_TRUE(path_no_approximation.GetProjectionWithWarmStartS(
+        point, &warm_start_s, &lateral));
+    EXPECT_NEAR(accumulate_s, warm_start_s, 1e-6);
+  }
+
   // Test path.get_smooth_point and get_s_from_index
   for (int case_id = -10; case_id <= 80; ++case_id) {
     const double ratio = static_cast<double>(case_id) / 70.0;
@@ -500,6 +514,44 @@ TEST(TestSuite, hdmap_circle_path) {
   }
 }
 
+TEST(TestSuite, hdmap_path_get_projections) {
+  const double kRadius = 50.0;
+  const int kNumSegments = 100;
+  std::vector<MapPathPoint> path_points;
+  for (int i = 0; i <= kNumSegments; ++i) {
+    const double p =
+        M_PI_2 * static_cast<double>(i) / static_cast<double>(kNumSegments);
+    path_points.push_back(
+        MakeMapPathPoint(kRadius * cos(p), kRadius * sin(p)));
+  }
+  std::vector<Vec2d> points;
+  for (int i = 0; i < 300; ++i) {
+    const double p = -0.2 + 2.0 * static_cast<double>(i) / 300.0;
+    const double radius = kRadius + static_cast<double>(i % 7) - 3.0;
+    points.emplace_back(radius * cos(p), radius * sin(p));
+  }
+
+  for (const Path& path : {Path(path_points, {}), Path(path_points, {}, 2.0)}) {
+    std::vector<double> accumulate_s;
+    std::vector<double> lateral;
+    EXPECT_TRUE(path.GetProjections(points, &accumulate_s, &lateral));
+    ASSERT_EQ(points.size(), accumulate_s.size());
+    ASSERT_EQ(points.size(), lateral.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      double expected_s = 0.0;
+      double expected_l = 0.0;
+      EXPECT_TRUE(path.GetProjection(points[i], &expected_s, &expected_l));
+      EXPECT_NEAR(expected_s, accumulate_s[i], 1e-6);
+      EXPECT_NEAR(expected_l, lateral[i], 1e-6);
+    }
+  }
+
+  const Path empty_path;
+  std::vector<double> accumulate_s;
+  std::vector<double> lateral;
+  EXPECT_FALSE(empty_path.GetProjections(points, &accumulate_s, &lateral));
+}
+
 TEST(TestSuite, hdmap_jerky_path) {
   const int kNumPaths = 100;
   const int kCasesPerPath = 1000;
@@ -43,6 +43,10 @@ DEFINE_double(look_forward_short_distance, 180,
 DEFINE_double(
     look_forward_long_distance, 250,
     "look forward this distance when creating reference line from routing");
+DEFINE_double(route_segments_window_margin, 0.0,
+              "extend the segments of a passage this much further on both "
+              "ends and truncate them in the following frames until the "
+              "vehicle leaves the window, 0 to extend them every frame");
 
 namespace apollo {
 namespace hdmap {
@@ -176,6 +180,12 @@ bool PncMap::UpdateVehicleState(const VehicleState &vehicle_state) {
     return false;
   }
 
+  // The route successors preferred when extending segments follow the
+  // routing range of the adc.
+  if (route_index != adc_route_index_) {
+    segments_windows_.clear();
+  }
+
   // Track how many routing request waypoints the adc have passed.
   UpdateNextRoutingWaypointIndex(route_index);
   adc_route_index_ = route_index;
@@ -209,6 +219,7 @@ bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
   range_lane_ids_.clear();
   route_indices_.clear();
   all_lane_ids_.clear();
+  segments_windows_.clear();
   for (int road_index = 0; road_index < routing.road_size(); ++road_index) {
     const auto &road_segment = routing.road(road_index);
     for (int passage_index = 0; passage_index < road_segment.passage_size();
@@ -461,8 +472,10 @@ bool PncMap::GetRouteSegments(const VehicleState &vehicle_state,
     }
     route_segments->emplace_back();
     const auto last_waypoint = segments.LastWaypoint();
-    if (!ExtendSegments(segments, sl.s() - backward_length,
-                        sl.s() + forward_length, &route_segments->back())) {
+    if (!ExtendPassageSegments(road_index, index, segments,
+                               sl.s() - backward_length,
+                               sl.s() + forward_length,
+                               &route_segments->back())) {
       AERROR << "Failed to extend segments with s=" << sl.s()
              << ", backward: " << backward_length
              << ", forward: " << forward_length;
@@ -614,6 +627,56 @@ bool PncMap::ExtendSegments(const RouteSegments &segments,
 bool PncMap::ExtendSegments(const RouteSegments &segments, double start_s,
                             double end_s,
                             RouteSegments *const truncated_segments) const {
+  return ExtendSegments(segments, start_s, end_s, truncated_segments, nullptr);
+}
+
+bool PncMap::ExtendPassageSegments(const int road_index,
+                                   const int passage_index,
+                                   const RouteSegments &segments,
+                                   const double start_s, const double end_s,
+                                   RouteSegments *const extended_segments) {
+  const double margin = FLAGS_route_segments_window_margin;
+  if (margin <= 0.0) {
+    return ExtendSegments(segments, start_s, end_s, extended_segments);
+  }
+  static constexpr double kRouteEpsilon = 1e-3;
+  const auto key = std::make_pair(road_index, passage_index);
+  auto iter = segments_windows_.find(key);
+  if (iter == segments_windows_.end() || start_s < iter->second.start_s ||
+      end_s > iter->second.end_s - kRouteEpsilon) {
+    SegmentsWindow window;
+    if (!ExtendSegments(segments, start_s - margin, end_s + margin,
+                        &window.segments, &window.start_s)) {
+      return false;
+    }
+    window.end_s = window.start_s;
+    for (const auto &segment : window.segments) {
+      window.end_s += segment.end_s - segment.start_s;
+    }
+    iter = segments_windows_.emplace(key, SegmentsWindow()).first;
+    iter->second = std::move(window);
+    ADEBUG << "Extended window [" << iter->second.start_s << ", "
+           << iter->second.end_s << "] of passage " << road_index << "_"
+           << passage_index;
+  }
+  const auto &window = iter->second;
+  if (start_s < window.start_s || end_s > window.end_s - kRouteEpsilon) {
+    // The route ends within the requested range, so the window can't cover
+    // it and may have stopped at a lane the range itself never repeats.
+    return ExtendSegments(segments, start_s, end_s, extended_segments);
+  }
+  if (!ExtendSegments(window.segments, start_s - window.start_s,
+                      end_s - window.start_s, extended_segments)) {
+    return false;
+  }
+  extended_segments->SetProperties(segments);
+  return true;
+}
+
+bool PncMap::ExtendSegments(const RouteSegments &segments, double start_s,
+                            double end_s,
+                            RouteSegments *const truncated_segments,
+                            double *const truncated_start_s) const {
   if (segments.empty()) {
     AERROR << "The input segments is empty";
     return false;
@@ -627,6 +690,9 @@ bool PncMap::ExtendSegments(const RouteSegments &segments, double start_s,
   }
   std::unordered_set<std::string> unique_lanes;
   static constexpr double kRouteEpsilon = 1e-3;
+  if (truncated_start_s != nullptr) {
+    *truncated_start_s = start_s;
+  }
   // Extend the trajectory towards the start of the trajectory.
   if (start_s < 0) {
     const auto &first_segment = *segments.begin();
@@ -653,6 +719,9 @@ bool PncMap::ExtendSegments(const RouteSegments &segments, double start_s,
     truncated_segments->insert(truncated_segments->begin(),
                                extended_lane_segments.rbegin(),
                                extended_lane_segments.rend());
+    if (truncated_start_s != nullptr) {
+      *truncated_start_s = start_s + std::max(extend_s, 0.0);
+    }
   }
   bool found_loop = false;
   double router_s = 0;
@@ -21,7 +21,9 @@
 #pragma once
 
 #include <list>
+#include <map>
 #include <string>
+#include <utility>
 #include <unordered_set>
 #include <vector>
 
@@ -38,6 +40,7 @@
 DECLARE_double(look_backward_distance);
 DECLARE_double(look_forward_short_distance);
 DECLARE_double(look_forward_long_distance);
+DECLARE_double(route_segments_window_margin);
 
 namespace apollo {
 namespace hdmap {
@@ -157,6 +160,25 @@ class PncMap {
 
   void UpdateRoutingRange(int adc_index);
 
+  /**
+   * @brief Same as ExtendSegments, but also reports where the result starts
+   * in the s of segments, which differs from start_s when the route doesn't
+   * reach back that far.
+   */
+  bool ExtendSegments(const RouteSegments &segments, double start_s,
+                      double end_s, RouteSegments *const truncated_segments,
+                      double *const truncated_start_s) const;
+
+  /**
+   * @brief Extend the segments of a passage to [start_s, end_s] by truncating
+   * a wider window kept from previous frames, the window is only extended
+   * through the HDMap again once the vehicle moves out of it.
+   */
+  bool ExtendPassageSegments(const int road_index, const int passage_index,
+                             const RouteSegments &segments,
+                             const double start_s, const double end_s,
+                             RouteSegments *const extended_segments);
+
  private:
   routing::RoutingResponse routing_;
   struct RouteIndex {
@@ -215,6 +237,17 @@ class PncMap {
    */
   bool stop_for_destination_ = false;
 
+  /**
+   * The extended segments of passages, keyed by {road_index, passage_index},
+   * covering [start_s, end_s] of the passage.
+   */
+  struct SegmentsWindow {
+    RouteSegments segments;
+    double start_s = 0.0;
+    double end_s = 0.0;
+  };
+  std::map<std::pair<int, int>, SegmentsWindow> segments_windows_;
+
   FRIEND_TEST(PncMapTest, UpdateRouting);
   FRIEND_TEST(PncMapTest, GetNearestPointFromRouting);
   FRIEND_TEST(PncMapTest, UpdateWaypointIndex);
@@ -222,6 +255,7 @@ class PncMap {
   FRIEND_TEST(PncMapTest, GetNeighborPassages);
   FRIEND_TEST(PncMapTest, NextWaypointIndex);
   FRIEND_TEST(PncMapTest, SearchForwardIndex_SearchBackwardIndex);
+  FRIEND_TEST(PncMapTest, ExtendPassageSegments);
 };
 
 }  // namespace hdmap
@@ -231,5 +231,29 @@ TEST_F(PncMapTest, GetNeighborPassages) {
   }
 }
 
+TEST_F(PncMapTest, ExtendPassageSegments) {
+  RouteSegments passage_segments;
+  ASSERT_TRUE(pnc_map_->PassageToSegments(routing_.road(0).passage(0),
+                                          &passage_segments));
+  FLAGS_route_segments_window_margin = 50.0;
+  for (double s = 0.0; s < 100.0; s += 7.5) {
+    RouteSegments expected;
+    ASSERT_TRUE(
+        pnc_map_->ExtendSegments(passage_segments, s - 10, s + 30, &expected));
+    RouteSegments segments;
+    ASSERT_TRUE(pnc_map_->ExtendPassageSegments(0, 0, passage_segments, s - 10,
+                                                s + 30, &segments));
+    ASSERT_EQ(expected.size(), segments.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i].lane->id().id(), segments[i].lane->id().id());
+      EXPECT_NEAR(expected[i].start_s, segments[i].start_s, 1e-6);
+      EXPECT_NEAR(expected[i].end_s, segments[i].end_s, 1e-6);
+    }
+  }
+  EXPECT_EQ(1, pnc_map_->segments_windows_.size());
+  FLAGS_route_segments_window_margin = 0.0;
+  pnc_map_->segments_windows_.clear();
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -30,5 +30,10 @@ DEFINE_int32(relative_map_loop_rate, 10, "Loop rate for relative_map node");
 DEFINE_bool(enable_cyclic_rerouting, false,
             "Enable auto rerouting in a in a cyclic/circular navigaton line.");
 
+DEFINE_bool(enable_navigation_line_window, false,
+            "Keep the normalized points of the span of each navigation line "
+            "around the vehicle between cycles, only reading the points "
+            "entering the span.");
+
 DEFINE_bool(relative_map_generate_left_boundray, true,
             "Generate left boundary for detected lanes.");
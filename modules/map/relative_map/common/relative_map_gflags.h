@@ -22,4 +22,5 @@ DECLARE_string(relative_map_config_filename);
 DECLARE_string(navigator_config_filename);
 DECLARE_int32(relative_map_loop_rate);
 DECLARE_bool(enable_cyclic_rerouting);
+DECLARE_bool(enable_navigation_line_window);
 DECLARE_bool(relative_map_generate_left_boundray);
@@ -22,6 +22,7 @@
 #include "modules/map/relative_map/navigation_lane.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 
@@ -152,6 +153,7 @@ void NavigationLane::UpdateNavigationInfo(
     const NavigationInfo &navigation_path) {
   navigation_info_ = navigation_path;
   last_project_index_map_.clear();
+  navigation_line_windows_.clear();
   navigation_path_list_.clear();
   current_navi_path_tuple_ = std::make_tuple(-1, -1.0, -1.0, nullptr);
   if (FLAGS_enable_cyclic_rerouting) {
@@ -460,6 +462,7 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
     AERROR << "Invalid projection index " << current_project_index
            << " in line " << line_index;
     last_project_index_map_.erase(line_index);
+    navigation_line_windows_.erase(line_index);
     return false;
   } else {
     last_project_index_map_[line_index] = proj_index_pair;
@@ -468,27 +471,39 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
   // offset between the current vehicle state and navigation line
   const double dx = -original_pose_.position().x();
   const double dy = -original_pose_.position().y();
-  auto enu_to_flu_func = [this, dx, dy](const double enu_x, const double enu_y,
-                                        const double enu_theta, double *flu_x,
-                                        double *flu_y, double *flu_theta) {
+  const double heading = original_pose_.heading();
+  // the rotation is the same for every point, as in RotateVector2d
+  const double cos_heading = std::cos(-heading);
+  const double sin_heading = std::sin(-heading);
+  auto enu_to_flu_func = [dx, dy, heading, cos_heading, sin_heading](
+                             const double enu_x, const double enu_y,
+                             const double normalized_enu_theta, double *flu_x,
+                             double *flu_y, double *flu_theta) {
     if (flu_x != nullptr && flu_y != nullptr) {
-      Eigen::Vector2d flu_coordinate = common::math::RotateVector2d(
-          {enu_x + dx, enu_y + dy}, -original_pose_.heading());
-
-      *flu_x = flu_coordinate.x();
-      *flu_y = flu_coordinate.y();
+      *flu_x = cos_heading * (enu_x + dx) - sin_heading * (enu_y + dy);
+      *flu_y = sin_heading * (enu_x + dx) + cos_heading * (enu_y + dy);
     }
 
     if (flu_theta != nullptr) {
-      *flu_theta = common::math::NormalizeAngle(
-          common::math::NormalizeAngle(enu_theta) - original_pose_.heading());
+      *flu_theta = common::math::NormalizeAngle(normalized_enu_theta - heading);
     }
   };
 
+  // points before the span of this cycle won't be read again
+  const int window_start_index = std::max(0, current_project_index - 3);
+  if (FLAGS_enable_navigation_line_window) {
+    auto &window = navigation_line_windows_[line_index];
+    while (!window.points.empty() && window.start_index < window_start_index) {
+      window.points.pop_front();
+      ++window.start_index;
+    }
+  }
+
   auto gen_navi_path_loop_func =
-      [this, &navigation_path, &enu_to_flu_func](
+      [this, line_index, &navigation_path, &enu_to_flu_func](
           const int start, const int end, const double ref_s_base,
-          const double max_length, common::Path *path) {
+          const double max_length, const bool use_window,
+          common::Path *path) {
         CHECK_NOTNULL(path);
         const double ref_s = navigation_path.path_point(start).s();
         for (int i = start; i < end; ++i) {
@@ -498,8 +513,16 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
           double flu_x = 0.0;
           double flu_y = 0.0;
           double flu_theta = 0.0;
-          enu_to_flu_func(point->x(), point->y(), point->theta(), &flu_x,
-                          &flu_y, &flu_theta);
+          if (use_window) {
+            const auto &window_point =
+                GetNavigationLineWindowPoint(line_index, navigation_path, i);
+            enu_to_flu_func(window_point.x, window_point.y, window_point.theta,
+                            &flu_x, &flu_y, &flu_theta);
+          } else {
+            enu_to_flu_func(point->x(), point->y(),
+                            common::math::NormalizeAngle(point->theta()),
+                            &flu_x, &flu_y, &flu_theta);
+          }
 
           point->set_x(flu_x);
           point->set_y(flu_y);
@@ -539,14 +562,17 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
 
       double length = navigation_path.path_point(stitch_start_index).s() -
                       navigation_path.path_point(current_project_index).s();
-      gen_navi_path_loop_func(std::max(0, current_project_index - 3),
-                              stitch_start_index + 1, 0.0, length, path);
+      gen_navi_path_loop_func(window_start_index, stitch_start_index + 1, 0.0,
+                              length, FLAGS_enable_navigation_line_window,
+                              path);
       if (length > config_.max_len_from_navigation_line()) {
         return true;
       }
+      // the stitched span is at the other end of the line, out of the window
       gen_navi_path_loop_func(stitch_end_index,
                               navigation_path.path_point_size(), length,
-                              config_.max_len_from_navigation_line(), path);
+                              config_.max_len_from_navigation_line(), false,
+                              path);
       return true;
     }
   }
@@ -554,12 +580,36 @@ bool NavigationLane::ConvertNavigationLineToPath(const int line_index,
   if (dist < 20) {
     return false;
   }
-  gen_navi_path_loop_func(std::max(0, current_project_index - 3),
+  gen_navi_path_loop_func(window_start_index,
                           navigation_path.path_point_size(), 0.0,
-                          config_.max_len_from_navigation_line(), path);
+                          config_.max_len_from_navigation_line(),
+                          FLAGS_enable_navigation_line_window, path);
   return true;
 }
 
+const NavigationLane::NavigationLineWindow::Point &
+NavigationLane::GetNavigationLineWindowPoint(const int line_index,
+                                             const common::Path &path,
+                                             const int index) {
+  auto &window = navigation_line_windows_[line_index];
+  if (index < window.start_index ||
+      index > window.start_index + static_cast<int>(window.points.size())) {
+    window.start_index = index;
+    window.points.clear();
+  }
+  while (window.start_index + static_cast<int>(window.points.size()) <=
+         index) {
+    const auto &path_point = path.path_point(
+        window.start_index + static_cast<int>(window.points.size()));
+    NavigationLineWindow::Point point;
+    point.x = path_point.x();
+    point.y = path_point.y();
+    point.theta = common::math::NormalizeAngle(path_point.theta());
+    window.points.push_back(point);
+  }
+  return window.points[index - window.start_index];
+}
+
 // project adc_state_ onto path
 ProjIndexPair NavigationLane::UpdateProjectionIndex(const common::Path &path,
                                                     const int line_index) {
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <deque>
 #include <list>
 #include <memory>
 #include <tuple>
@@ -264,6 +265,30 @@ class NavigationLane {
    */
   void UpdateStitchIndexInfo();
 
+  // The ENU points of the span of a navigation line around the vehicle, with
+  // normalized headings.
+  struct NavigationLineWindow {
+    struct Point {
+      double x = 0.0;
+      double y = 0.0;
+      double theta = 0.0;
+    };
+    int start_index = 0;
+    std::deque<Point> points;
+  };
+
+  /**
+   * @brief Get a point of the window of a navigation line, sliding the window
+   * forward over the points not read yet, or restarting it at the point when
+   * it is not adjacent to the window.
+   * @param line_index The index of the navigation line.
+   * @param path The entire navigation line.
+   * @param index The index of the point in the navigation line.
+   * @return The point in the window.
+   */
+  const NavigationLineWindow::Point& GetNavigationLineWindowPoint(
+      const int line_index, const common::Path& path, const int index);
+
  private:
   // the configuration information required by the `NavigationLane`
   NavigationLaneConfig config_;
@@ -300,6 +325,10 @@ class NavigationLane {
   // value: stitching index pair in the "key" line.
   std::unordered_map<int, StitchIndexPair> stitch_index_map_;
 
+  // key: line index,
+  // value: the window of the "key" line used by the last generated path.
+  std::unordered_map<int, NavigationLineWindow> navigation_line_windows_;
+
   // in world coordination: ENU
   localization::Pose original_pose_;
   common::VehicleStateProvider* vehicle_state_provider_ = nullptr;
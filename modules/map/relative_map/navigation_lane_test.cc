@@ -226,5 +226,32 @@ TEST_F(NavigationLaneTest, GenerateThreeLaneMap) {
   }
 }
 
+TEST_F(NavigationLaneTest, NavigationLineWindow) {
+  navigation_line_filenames_.emplace_back(data_file_dir_ + "left.smoothed");
+  EXPECT_TRUE(
+      GenerateNavigationInfo(navigation_line_filenames_, &navigation_info_));
+  navigation_lane_.UpdateNavigationInfo(navigation_info_);
+  EXPECT_TRUE(navigation_lane_.GeneratePath());
+  const auto expected_path = navigation_lane_.Path();
+
+  FLAGS_enable_navigation_line_window = true;
+  // The second cycle reads the points from the window of the first one.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(navigation_lane_.GeneratePath());
+    const auto path = navigation_lane_.Path();
+    ASSERT_EQ(expected_path.path().path_point_size(),
+              path.path().path_point_size());
+    for (int j = 0; j < path.path().path_point_size(); ++j) {
+      const auto& expected_point = expected_path.path().path_point(j);
+      const auto& point = path.path().path_point(j);
+      EXPECT_DOUBLE_EQ(expected_point.x(), point.x());
+      EXPECT_DOUBLE_EQ(expected_point.y(), point.y());
+      EXPECT_DOUBLE_EQ(expected_point.theta(), point.theta());
+      EXPECT_DOUBLE_EQ(expected_point.s(), point.s());
+    }
+  }
+  FLAGS_enable_navigation_line_window = false;
+}
+
 }  // namespace relative_map
 }  // namespace apollo
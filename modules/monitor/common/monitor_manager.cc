@@ -40,6 +40,10 @@ void MonitorManager::Init(const std::shared_ptr<apollo::cyber::Node>& node) {
   if (FLAGS_use_sim_time) {
     status_.set_is_realtime_in_simulation(true);
   }
+  if (FLAGS_monitor_status_board) {
+    status_board_.reset(new StatusBoard());
+    status_board_->Init(node_);
+  }
 }
 
 bool MonitorManager::StartFrame(const double current_time) {
@@ -73,6 +77,9 @@ bool MonitorManager::StartFrame(const double current_time) {
   }
 
   in_autonomous_driving_ = CheckAutonomousDriving(current_time);
+  if (status_board_ != nullptr) {
+    status_board_->StartFrame();
+  }
   return true;
 }
 
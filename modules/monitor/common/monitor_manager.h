@@ -25,6 +25,7 @@
 #include "modules/dreamview/proto/hmi_config.pb.h"
 #include "modules/dreamview/proto/hmi_mode.pb.h"
 #include "modules/dreamview/proto/hmi_status.pb.h"
+#include "modules/monitor/common/status_board.h"
 #include "modules/monitor/proto/system_status.pb.h"
 
 /**
@@ -48,6 +49,8 @@ class MonitorManager {
   bool IsInAutonomousMode() const { return in_autonomous_driving_; }
   SystemStatus* GetStatus() { return &status_; }
   apollo::common::monitor::MonitorLogBuffer& LogBuffer() { return log_buffer_; }
+  // Null unless --monitor_status_board is set.
+  StatusBoard* GetStatusBoard() { return status_board_.get(); }
 
   // Cyber reader / writer creator.
   template <class T>
@@ -76,6 +79,7 @@ class MonitorManager {
   apollo::common::monitor::MonitorLogBuffer log_buffer_;
   std::shared_ptr<apollo::cyber::Node> node_;
   std::unordered_map<std::string, std::shared_ptr<cyber::ReaderBase>> readers_;
+  std::unique_ptr<StatusBoard> status_board_;
 
   DECLARE_SINGLETON(MonitorManager)
 };
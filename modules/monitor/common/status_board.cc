@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/common/status_board.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cctype>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
+#include "cyber/time/clock.h"
+
+DEFINE_bool(monitor_status_board, false,
+            "Whether the runners share one /proc scan per frame and take the "
+            "channel freshness from the transport stats.");
+
+DEFINE_string(monitor_transport_stats_topic, "/apollo/cyber/transport_stats",
+              "Channel of the transport stats published by cyber processes.");
+
+namespace apollo {
+namespace monitor {
+
+void StatusBoard::Init(const std::shared_ptr<cyber::Node>& node) {
+  stats_reader_ = node->CreateReader<cyber::proto::TransportStats>(
+      FLAGS_monitor_transport_stats_topic,
+      [this](const std::shared_ptr<cyber::proto::TransportStats>& stats) {
+        OnTransportStats(stats);
+      });
+}
+
+const std::vector<StatusBoard::Process>& StatusBoard::GetProcesses() {
+  if (!processes_scanned_) {
+    processes_scanned_ = true;
+    ScanProcesses();
+  }
+  return processes_;
+}
+
+bool StatusBoard::FindProcess(const std::string& keyword, int* pid) {
+  for (const auto& process : GetProcesses()) {
+    if (process.cmdline.find(keyword) != std::string::npos) {
+      *pid = process.pid;
+      return true;
+    }
+  }
+  return false;
+}
+
+void StatusBoard::ScanProcesses() {
+  ++scan_count_;
+  processes_.clear();
+  DIR* proc_dir = opendir("/proc");
+  if (proc_dir == nullptr) {
+    AERROR << "Failed to open /proc.";
+    return;
+  }
+  struct dirent* entry = nullptr;
+  while ((entry = readdir(proc_dir)) != nullptr) {
+    const std::string dir_name = entry->d_name;
+    if (dir_name.empty() ||
+        !std::all_of(dir_name.begin(), dir_name.end(), ::isdigit)) {
+      continue;
+    }
+    const std::string proc_path = absl::StrCat("/proc/", dir_name);
+    struct stat proc_stat;
+    if (stat(proc_path.c_str(), &proc_stat) != 0) {
+      continue;
+    }
+    const int pid = std::stoi(dir_name);
+    const int64_t start_ns =
+        static_cast<int64_t>(proc_stat.st_ctim.tv_sec) * 1000000000 +
+        proc_stat.st_ctim.tv_nsec;
+    auto& cached = process_cache_[pid];
+    if (cached.scan == 0 || cached.start_ns != start_ns) {
+      cached.start_ns = start_ns;
+      cached.cmdline.clear();
+      // In /proc/<PID>/cmdline, the parts are separated with \0, which will be
+      // converted back to whitespaces here.
+      if (cyber::common::GetContent(absl::StrCat(proc_path, "/cmdline"),
+                                    &cached.cmdline)) {
+        std::replace(cached.cmdline.begin(), cached.cmdline.end(), '\0', ' ');
+      }
+    }
+    cached.scan = scan_count_;
+    if (!cached.cmdline.empty()) {
+      processes_.push_back({pid, cached.cmdline});
+    }
+  }
+  closedir(proc_dir);
+
+  // Forget the processes gone since the last scan.
+  for (auto iter = process_cache_.begin(); iter != process_cache_.end();) {
+    if (iter->second.scan != scan_count_) {
+      iter = process_cache_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+void StatusBoard::OnTransportStats(
+    const std::shared_ptr<cyber::proto::TransportStats>& stats) {
+  const double now = cyber::Clock::NowInSeconds();
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  for (const auto& channel : stats->channel()) {
+    if (channel.role() != "writer") {
+      continue;
+    }
+    const std::string key = absl::StrCat(stats->pid(), ":", channel.mode(),
+                                         ":", channel.channel_name());
+    // The first count of a writer only sets the baseline, the messages may
+    // have been sent long ago.
+    auto iter = writer_messages_.find(key);
+    if (iter == writer_messages_.end()) {
+      writer_messages_.emplace(key, channel.messages());
+    } else if (channel.messages() != iter->second) {
+      iter->second = channel.messages();
+      channel_update_time_[channel.channel_name()] = now;
+    }
+  }
+}
+
+bool StatusBoard::GetChannelDelay(const std::string& channel,
+                                  const double current_time, double* delay) {
+  std::lock_guard<std::mutex> lock(channel_mutex_);
+  const auto iter = channel_update_time_.find(channel);
+  if (iter == channel_update_time_.end()) {
+    return false;
+  }
+  *delay = current_time - iter->second;
+  return true;
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/proto/transport_stats.pb.h"
+
+#include "cyber/cyber.h"
+#include "gflags/gflags.h"
+
+DECLARE_bool(monitor_status_board);
+
+namespace apollo {
+namespace monitor {
+
+// Samples shared by all the runners of a monitor frame: the processes from one
+// /proc scan and the channel freshness from the transport stats published by
+// the cyber processes, instead of each runner scanning and subscribing.
+class StatusBoard {
+ public:
+  struct Process {
+    int pid = 0;
+    // Parts separated with whitespaces.
+    std::string cmdline;
+  };
+
+  void Init(const std::shared_ptr<cyber::Node>& node);
+  // Marks the processes stale for the new frame.
+  void StartFrame() { processes_scanned_ = false; }
+
+  // Running processes, /proc is scanned on the first call of a frame and
+  // only the cmdline of new processes is read.
+  const std::vector<Process>& GetProcesses();
+  // The first process whose cmdline contains keyword.
+  bool FindProcess(const std::string& keyword, int* pid);
+
+  // Seconds since a writer of the channel was last seen sending, false if
+  // no process publishes the stats of the channel.
+  bool GetChannelDelay(const std::string& channel, const double current_time,
+                       double* delay);
+
+ private:
+  struct CachedProcess {
+    // The change time of /proc/<pid>, which tells a reused pid apart.
+    int64_t start_ns = 0;
+    std::string cmdline;
+    uint64_t scan = 0;
+  };
+
+  void ScanProcesses();
+  void OnTransportStats(
+      const std::shared_ptr<cyber::proto::TransportStats>& stats);
+
+  bool processes_scanned_ = false;
+  uint64_t scan_count_ = 0;
+  std::unordered_map<int, CachedProcess> process_cache_;
+  std::vector<Process> processes_;
+
+  std::mutex channel_mutex_;
+  // key: pid, channel and mode of a writer, value: messages sent.
+  std::unordered_map<std::string, uint64_t> writer_messages_;
+  std::unordered_map<std::string, double> channel_update_time_;
+  std::shared_ptr<cyber::Reader<cyber::proto::TransportStats>> stats_reader_;
+};
+
+}  // namespace monitor
+}  // namespace apollo
@@ -45,6 +45,10 @@ namespace monitor {
 namespace {
 
 bool GetPIDByCmdLine(const std::string& process_dag_path, int* pid) {
+  auto* status_board = MonitorManager::Instance()->GetStatusBoard();
+  if (status_board != nullptr) {
+    return status_board->FindProcess(process_dag_path, pid);
+  }
   const std::string system_proc_path = "/proc";
   const std::string proc_cmdline_path = "/cmdline";
   const auto dirs = cyber::common::ListSubPaths(system_proc_path);
@@ -154,30 +154,42 @@ void ChannelMonitor::RunOnce(const double current_time) {
           latency_monitor_->GetFrequency(config.channel().name(), &freq);
       UpdateStatus(config.channel(),
                    components->at(name).mutable_channel_status(), update_freq,
-                   freq);
+                   freq, current_time);
     }
   }
 }
 
 void ChannelMonitor::UpdateStatus(
     const apollo::dreamview::ChannelMonitorConfig& config,
-    ComponentStatus* status, const bool update_freq, const double freq) {
+    ComponentStatus* status, const bool update_freq, const double freq,
+    const double current_time) {
   status->clear_status();
 
-  const auto reader_message_pair = GetReaderAndLatestMessage(config.name());
-  const auto reader = reader_message_pair.first;
-  const auto message = reader_message_pair.second;
-
-  if (reader == nullptr) {
-    SummaryMonitor::EscalateStatus(
-        ComponentStatus::UNKNOWN,
-        absl::StrCat(config.name(), " is not registered in ChannelMonitor."),
-        status);
-    return;
+  // The transport stats tell the delay without subscribing to the channel,
+  // a reader is then only needed to check the fields.
+  double delay = 0.0;
+  auto* status_board = MonitorManager::Instance()->GetStatusBoard();
+  const bool has_stats_delay =
+      status_board != nullptr && config.mandatory_fields().empty() &&
+      status_board->GetChannelDelay(config.name(), current_time, &delay);
+
+  std::shared_ptr<google::protobuf::Message> message;
+  if (!has_stats_delay) {
+    const auto reader_message_pair = GetReaderAndLatestMessage(config.name());
+    const auto reader = reader_message_pair.first;
+    message = reader_message_pair.second;
+
+    if (reader == nullptr) {
+      SummaryMonitor::EscalateStatus(
+          ComponentStatus::UNKNOWN,
+          absl::StrCat(config.name(), " is not registered in ChannelMonitor."),
+          status);
+      return;
+    }
+    delay = reader->GetDelaySec();
   }
 
   // Check channel delay
-  const double delay = reader->GetDelaySec();
   if (delay < 0 || delay > config.delay_fatal()) {
     SummaryMonitor::EscalateStatus(
         ComponentStatus::FATAL,
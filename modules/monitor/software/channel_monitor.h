@@ -36,7 +36,8 @@ class ChannelMonitor : public RecurrentRunner {
  private:
   static void UpdateStatus(
       const apollo::dreamview::ChannelMonitorConfig& config,
-      ComponentStatus* status, const bool update_freq, const double freq);
+      ComponentStatus* status, const bool update_freq, const double freq,
+      const double current_time);
   std::shared_ptr<LatencyMonitor> latency_monitor_;
 };
 
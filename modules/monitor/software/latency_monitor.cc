@@ -42,11 +42,24 @@ DEFINE_double(latency_report_interval, 15.0,
 DEFINE_int32(latency_reader_capacity, 30,
              "The max message numbers in latency reader queue.");
 
+DEFINE_double(latency_e2e_budget_ms, 0.0,
+              "Alert when the p99 latency from the sensor timestamp to the "
+              "budget channel exceeds it, 0 to disable.");
+
+DEFINE_string(latency_e2e_budget_channel, "",
+              "Channel at the end of the budgeted chain, the control command "
+              "topic if empty.");
+
+DEFINE_int32(latency_e2e_budget_min_samples, 20,
+             "Min number of new samples to check the p99 latency against the "
+             "budget.");
+
 namespace apollo {
 namespace monitor {
 
 namespace {
 
+using apollo::common::LatencyHistogramMap;
 using apollo::common::LatencyRecordMap;
 using apollo::common::LatencyReport;
 using apollo::common::LatencyStat;
@@ -84,6 +97,80 @@ void SetLatency(const std::string& latency_name,
   SetStat(GenerateStat(latency_values), latency_track->mutable_latency_stat());
 }
 
+// Adds the latencies recorded between the reported and the current
+// cumulative histograms.
+void SetHistogramLatency(const std::string& latency_name,
+                         const apollo::cyber::proto::LatencyHistogram& current,
+                         const apollo::cyber::proto::LatencyHistogram& reported,
+                         LatencyTrack* track) {
+  // The counts start over when the module restarts.
+  const bool restarted = current.count() < reported.count();
+  const uint64_t sample_size =
+      current.count() - (restarted ? 0 : reported.count());
+  if (sample_size == 0) {
+    return;
+  }
+  const uint64_t sum = current.sum_ns() - (restarted ? 0 : reported.sum_ns());
+  // The lower bound of the first bucket with new samples.
+  uint64_t min_duration = 0;
+  for (int i = 0; i < current.bucket_size(); ++i) {
+    const uint64_t reported_bucket =
+        (restarted || i >= reported.bucket_size()) ? 0 : reported.bucket(i);
+    if (current.bucket(i) > reported_bucket) {
+      min_duration = i == 0 ? 0 : (1000ULL << (i - 1));
+      break;
+    }
+  }
+
+  auto* latency_track = track->add_latency_track();
+  latency_track->set_latency_name(latency_name);
+  auto* stat = latency_track->mutable_latency_stat();
+  stat->set_min_duration(min_duration);
+  stat->set_max_duration(current.max_ns());
+  stat->set_aver_duration(sum / sample_size);
+  stat->set_sample_size(static_cast<uint32_t>(sample_size));
+}
+
+// Upper bound in ns of the bucket the fraction of the latencies recorded
+// between the two cumulative histograms fall in, 0 if there is none.
+uint64_t HistogramPercentile(
+    const apollo::cyber::proto::LatencyHistogram& current,
+    const apollo::cyber::proto::LatencyHistogram& reported,
+    const double fraction, uint64_t* sample_size) {
+  const bool restarted = current.count() < reported.count();
+  *sample_size = current.count() - (restarted ? 0 : reported.count());
+  if (*sample_size == 0) {
+    return 0;
+  }
+  const auto rank = static_cast<uint64_t>(fraction * *sample_size);
+  uint64_t seen = 0;
+  for (int i = 0; i < current.bucket_size(); ++i) {
+    const uint64_t reported_bucket =
+        (restarted || i >= reported.bucket_size()) ? 0 : reported.bucket(i);
+    seen += current.bucket(i) - reported_bucket;
+    if (seen > rank) {
+      return 1000ULL << i;
+    }
+  }
+  return current.max_ns();
+}
+
+uint64_t Percentile(std::vector<uint64_t> numbers, const double fraction) {
+  if (numbers.empty()) {
+    return 0;
+  }
+  const size_t rank = std::min(
+      numbers.size() - 1, static_cast<size_t>(fraction * numbers.size()));
+  std::nth_element(numbers.begin(), numbers.begin() + rank, numbers.end());
+  return numbers[rank];
+}
+
+const std::string& BudgetChannel() {
+  return FLAGS_latency_e2e_budget_channel.empty()
+             ? FLAGS_control_command_topic
+             : FLAGS_latency_e2e_budget_channel;
+}
+
 }  // namespace
 
 LatencyMonitor::LatencyMonitor()
@@ -112,9 +199,22 @@ void LatencyMonitor::RunOnce(const double current_time) {
   }
   last_processed_key = first_key_of_current_round;
 
+  static auto histogram_reader =
+      MonitorManager::Instance()->CreateReader<LatencyHistogramMap>(
+          FLAGS_latency_histogram_topic);
+  histogram_reader->SetHistoryDepth(FLAGS_latency_reader_capacity);
+  histogram_reader->Observe();
+  for (auto it = histogram_reader->Begin(); it != histogram_reader->End();
+       ++it) {
+    UpdateHistograms(*it);
+  }
+  if (FLAGS_latency_e2e_budget_ms > 0.0) {
+    CheckHistogramBudget();
+  }
+
   if (current_time - flush_time_ > FLAGS_latency_report_interval) {
     flush_time_ = current_time;
-    if (!track_map_.empty()) {
+    if (!track_map_.empty() || !latest_histograms_.empty()) {
       PublishLatencyReport();
     }
   }
@@ -139,6 +239,24 @@ void LatencyMonitor::UpdateStat(
   }
 }
 
+void LatencyMonitor::UpdateHistograms(
+    const std::shared_ptr<LatencyHistogramMap>& histograms) {
+  const auto& module_name = histograms->module_name();
+  auto& latest = latest_histograms_[module_name];
+  const double time_span =
+      histograms->header().timestamp_sec() - latest.header().timestamp_sec();
+  if (latest.has_header() && time_span <= 0.0) {
+    return;
+  }
+  const uint64_t count = histograms->module_latency().count();
+  const uint64_t latest_count = latest.module_latency().count();
+  if (latest.has_header() && count >= latest_count) {
+    freq_map_[module_name] =
+        static_cast<double>(count - latest_count) / time_span;
+  }
+  latest = *histograms;
+}
+
 void LatencyMonitor::PublishLatencyReport() {
   static auto writer = MonitorManager::Instance()->CreateWriter<LatencyReport>(
       FLAGS_latency_reporting_topic);
@@ -211,6 +329,59 @@ void LatencyMonitor::AggregateLatency() {
     SetLatency(absl::StrCat(kE2EStartPoint, " -> ", e2e.first), e2e.second,
                e2es_latency);
   }
+  // the records only give e2e latencies once per report
+  const auto budget_track = e2es_track.find(BudgetChannel());
+  if (FLAGS_latency_e2e_budget_ms > 0.0 && budget_track != e2es_track.end() &&
+      budget_track->second.size() >=
+          static_cast<size_t>(FLAGS_latency_e2e_budget_min_samples)) {
+    CheckBudget(Percentile(budget_track->second, 0.99),
+                budget_track->second.size());
+  }
+
+  // Modules recording into histograms measure e2e from the sensor timestamp
+  // carried as message id.
+  for (const auto& latest : latest_histograms_) {
+    auto& reported = reported_histograms_[latest.first];
+    SetHistogramLatency(latest.first, latest.second.module_latency(),
+                        reported.module_latency(), modules_latency);
+    SetHistogramLatency(absl::StrCat(kE2EStartPoint, " -> ", latest.first),
+                        latest.second.e2e_latency(), reported.e2e_latency(),
+                        e2es_latency);
+    reported = latest.second;
+  }
+}
+
+void LatencyMonitor::CheckHistogramBudget() {
+  const auto latest = latest_histograms_.find(BudgetChannel());
+  if (latest == latest_histograms_.end()) {
+    return;
+  }
+  // checked continuously rather than once per report
+  auto& checked = budget_checked_histogram_;
+  uint64_t sample_size = 0;
+  const uint64_t p99 = HistogramPercentile(latest->second.e2e_latency(),
+                                           checked, 0.99, &sample_size);
+  if (sample_size <
+      static_cast<uint64_t>(FLAGS_latency_e2e_budget_min_samples)) {
+    return;
+  }
+  checked = latest->second.e2e_latency();
+  CheckBudget(p99, sample_size);
+}
+
+void LatencyMonitor::CheckBudget(const uint64_t p99_ns,
+                                 const uint64_t sample_size) {
+  const double p99_ms = static_cast<double>(p99_ns) * 1e-6;
+  if (p99_ms <= FLAGS_latency_e2e_budget_ms) {
+    return;
+  }
+  const std::string msg =
+      absl::StrCat("p99 latency ", p99_ms, "ms from sensor to ",
+                   BudgetChannel(), " over ", sample_size,
+                   " messages exceeds the budget ",
+                   FLAGS_latency_e2e_budget_ms, "ms.");
+  AWARN << msg;
+  MonitorManager::Instance()->LogBuffer().WARN(msg);
 }
 
 bool LatencyMonitor::GetFrequency(const std::string& channel_name,
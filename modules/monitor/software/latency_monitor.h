@@ -22,6 +22,7 @@
 #include <tuple>
 #include <unordered_map>
 
+#include "modules/common/latency_recorder/proto/latency_histogram.pb.h"
 #include "modules/common/latency_recorder/proto/latency_record.pb.h"
 #include "modules/monitor/common/recurrent_runner.h"
 
@@ -37,14 +38,27 @@ class LatencyMonitor : public RecurrentRunner {
  private:
   void UpdateStat(
       const std::shared_ptr<apollo::common::LatencyRecordMap>& records);
+  void UpdateHistograms(
+      const std::shared_ptr<apollo::common::LatencyHistogramMap>& histograms);
   void PublishLatencyReport();
   void AggregateLatency();
+  // Alert when the p99 e2e latency of the budget channel is over budget.
+  void CheckHistogramBudget();
+  void CheckBudget(const uint64_t p99_ns, const uint64_t sample_size);
 
   apollo::common::LatencyReport latency_report_;
   std::unordered_map<uint64_t,
                      std::set<std::tuple<uint64_t, uint64_t, std::string>>>
       track_map_;
   std::unordered_map<std::string, double> freq_map_;
+  // The cumulative histograms of each module, the latest ones and the ones
+  // of the last report.
+  std::unordered_map<std::string, apollo::common::LatencyHistogramMap>
+      latest_histograms_;
+  std::unordered_map<std::string, apollo::common::LatencyHistogramMap>
+      reported_histograms_;
+  // The e2e histogram of the budget channel at the last budget check.
+  apollo::cyber::proto::LatencyHistogram budget_checked_histogram_;
   double flush_time_ = 0.0;
 };
 
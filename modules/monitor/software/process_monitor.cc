@@ -39,15 +39,22 @@ ProcessMonitor::ProcessMonitor()
 void ProcessMonitor::RunOnce(const double current_time) {
   // Get running processes.
   std::vector<std::string> running_processes;
-  for (const auto& cmd_file : cyber::common::Glob("/proc/*/cmdline")) {
-    // Get process command string.
-    std::string cmd_string;
-    if (cyber::common::GetContent(cmd_file, &cmd_string) &&
-        !cmd_string.empty()) {
-      // In /proc/<PID>/cmdline, the parts are separated with \0, which will be
-      // converted back to whitespaces here.
-      std::replace(cmd_string.begin(), cmd_string.end(), '\0', ' ');
-      running_processes.push_back(cmd_string);
+  auto* status_board = MonitorManager::Instance()->GetStatusBoard();
+  if (status_board != nullptr) {
+    for (const auto& process : status_board->GetProcesses()) {
+      running_processes.push_back(process.cmdline);
+    }
+  } else {
+    for (const auto& cmd_file : cyber::common::Glob("/proc/*/cmdline")) {
+      // Get process command string.
+      std::string cmd_string;
+      if (cyber::common::GetContent(cmd_file, &cmd_string) &&
+          !cmd_string.empty()) {
+        // In /proc/<PID>/cmdline, the parts are separated with \0, which will
+        // be converted back to whitespaces here.
+        std::replace(cmd_string.begin(), cmd_string.end(), '\0', ' ');
+        running_processes.push_back(cmd_string);
+      }
     }
   }
 
@@ -15,29 +15,51 @@
  *****************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <vector>
 
+#include "cyber/base/bounded_queue.h"
 #include "modules/perception/base/object_pool.h"
+#include "modules/perception/common/perception_gflags.h"
 
-#define PERCEPTION_BASE_DISABLE_POOL
 namespace apollo {
 namespace perception {
 namespace base {
 
 static const size_t kPoolDefaultExtendNum = 10;
 static const size_t kPoolDefaultSize = 100;
+// objects a thread takes from the global queue at once, a thread cache
+// holding twice as many hands the surplus back
+static const size_t kPoolLocalCacheSize = 64;
+// the global queue holds up to this many times the default size, objects
+// allocated beyond that are freed on release instead of pooled
+static const size_t kPoolMaxSizeFactor = 4;
 
 // @brief default initializer used in concurrent object pool
 template <class T>
 struct ObjectPoolDefaultInitializer {
   void operator()(T* t) const {}
 };
-// @brief concurrent object pool with dynamic size
+
+// @brief slow path events of a concurrent object pool
+struct ObjectPoolStats {
+  // thread caches refilled from the global queue
+  uint64_t refill_num = 0;
+  // objects allocated after warm up
+  uint64_t extend_num = 0;
+  // objects allocated beyond the pool size, freed on release
+  uint64_t overflow_num = 0;
+};
+
+// @brief concurrent object pool with dynamic size, enabled by
+// FLAGS_enable_base_object_pool. Every thread keeps a small cache of free
+// objects and refills or drains it in batches through a lock free global
+// queue, so only allocations after warm up take the mutex.
 template <class ObjectType, size_t N = kPoolDefaultSize,
           class Initializer = ObjectPoolDefaultInitializer<ObjectType>>
 class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
@@ -51,60 +73,25 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   }
   // @brief overrided function to get object smart pointer
   std::shared_ptr<ObjectType> Get() override {
-// TODO(All): remove conditional build
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-    ObjectType* ptr = nullptr;
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.empty()) {
-        Add(1 + kPoolDefaultExtendNum);
-      }
-      ptr = queue_.front();
-      queue_.pop();
+    if (!FLAGS_enable_base_object_pool) {
+      return std::shared_ptr<ObjectType>(new ObjectType);
     }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
-    kInitializer(ptr);
-    return std::shared_ptr<ObjectType>(ptr, [&](ObjectType* obj_ptr) {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(obj_ptr);
-    });
-#else
-    return std::shared_ptr<ObjectType>(new ObjectType);
-#endif
+    return Make(1);
   }
   // @brief overrided function to get batch of smart pointers
   // @params[IN] num: batch number
   // @params[OUT] data: vector container to store the pointers
   void BatchGet(size_t num,
                 std::vector<std::shared_ptr<ObjectType>>* data) override {
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
+    if (!FLAGS_enable_base_object_pool) {
       for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
+        data->emplace_back(new ObjectType);
       }
+      return;
     }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      data->emplace_back(
-          std::shared_ptr<ObjectType>(buffer[i], [&](ObjectType* obj_ptr) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(obj_ptr);
-          }));
-    }
-#else
-    for (size_t i = 0; i < num; ++i) {
-      data->emplace_back(new ObjectType);
+      data->emplace_back(Make(num - i));
     }
-#endif
   }
   // @brief overrided function to get batch of smart pointers
   // @params[IN] num: batch number
@@ -112,40 +99,7 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   // @params[OUT] data: list container to store the pointers
   void BatchGet(size_t num, bool is_front,
                 std::list<std::shared_ptr<ObjectType>>* data) override {
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
-    for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
-    }
-#else
-    for (size_t i = 0; i < num; ++i) {
-      is_front ? data->emplace_front(new ObjectType)
-               : data->emplace_back(new ObjectType);
-    }
-#endif
+    BatchGetFrontOrBack(num, is_front, data);
   }
   // @brief overrided function to get batch of smart pointers
   // @params[IN] num: batch number
@@ -153,50 +107,54 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   // @params[OUT] data: deque container to store the pointers
   void BatchGet(size_t num, bool is_front,
                 std::deque<std::shared_ptr<ObjectType>>* data) override {
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
+    BatchGetFrontOrBack(num, is_front, data);
+  }
+  // @brief overrided function to set capacity
+  void set_capacity(size_t capacity) override {
+    if (!FLAGS_enable_base_object_pool) {
+      return;
+    }
+    Warmup();
+    std::vector<ObjectType*> objects;
     {
       std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
+      if (capacity_ < capacity) {
+        Extend(capacity - capacity_, &objects);
       }
     }
-    for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
-    }
-#else
-    for (size_t i = 0; i < num; ++i) {
-      is_front ? data->emplace_front(new ObjectType)
-               : data->emplace_back(new ObjectType);
-    }
-#endif
+    global_.EnqueueBulk(objects.begin(), objects.size());
   }
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-  // @brief overrided function to set capacity
-  void set_capacity(size_t capacity) override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (capacity_ < capacity) {
-      Add(capacity - capacity_);
+  // @brief get remained object number, including the cache of the calling
+  // thread
+  size_t RemainedNum() override {
+    if (!FLAGS_enable_base_object_pool) {
+      return 0;
     }
+    Warmup();
+    return global_.Size() + local_cache_.objects.size();
+  }
+  // @brief allocate the default size up front, call it at init so that
+  // the frame path never allocates
+  void Warmup() {
+    std::call_once(warmup_flag_, [this]() {
+      global_.Init(kMaxSize);
+      cache_ = new ObjectType[kDefaultCacheSize];
+      std::vector<ObjectType*> objects(kDefaultCacheSize);
+      for (size_t i = 0; i < kDefaultCacheSize; ++i) {
+        objects[i] = &cache_[i];
+      }
+      global_.EnqueueBulk(objects.begin(), objects.size());
+      capacity_ = kDefaultCacheSize;
+    });
+  }
+  // @brief slow path counters since start
+  ObjectPoolStats stats() const {
+    ObjectPoolStats stats;
+    stats.refill_num = refill_num_.load(std::memory_order_relaxed);
+    stats.extend_num = extend_num_.load(std::memory_order_relaxed);
+    stats.overflow_num = overflow_num_.load(std::memory_order_relaxed);
+    return stats;
   }
-  // @brief get remained object number
-  size_t RemainedNum() override { return queue_.size(); }
-#endif
   // @brief destructor to release the cached memory
   ~ConcurrentObjectPool() override {
     if (cache_) {
@@ -210,38 +168,121 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   }
 
  protected:
-// @brief add num objects, should add lock before invoke this function
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-  void Add(size_t num) {
+  // @brief free objects owned by one thread
+  struct LocalCache {
+    std::vector<ObjectType*> objects;
+    ~LocalCache() {
+      if (!objects.empty()) {
+        Instance().global_.EnqueueBulk(objects.begin(), objects.size());
+      }
+    }
+  };
+
+  template <typename Container>
+  void BatchGetFrontOrBack(size_t num, bool is_front, Container* data) {
+    if (!FLAGS_enable_base_object_pool) {
+      for (size_t i = 0; i < num; ++i) {
+        is_front ? data->emplace_front(new ObjectType)
+                 : data->emplace_back(new ObjectType);
+      }
+      return;
+    }
+    for (size_t i = 0; i < num; ++i) {
+      is_front ? data->emplace_front(Make(num - i))
+               : data->emplace_back(Make(num - i));
+    }
+  }
+  // @brief get one initialized object, hint is the number of objects the
+  // caller still needs and sizes a refill
+  std::shared_ptr<ObjectType> Make(size_t hint) {
+    Warmup();
+    ObjectType* ptr = Take(hint);
+    if (ptr == nullptr) {
+      overflow_num_.fetch_add(1, std::memory_order_relaxed);
+      ptr = new ObjectType;
+      kInitializer(ptr);
+      return std::shared_ptr<ObjectType>(ptr);
+    }
+    kInitializer(ptr);
+    return std::shared_ptr<ObjectType>(
+        ptr, [this](ObjectType* obj_ptr) { Release(obj_ptr); });
+  }
+  // @brief take a free object from the thread cache, nullptr when the pool
+  // reached its max size
+  ObjectType* Take(size_t hint) {
+    auto& objects = local_cache_.objects;
+    if (objects.empty()) {
+      Refill(std::max(hint, kPoolLocalCacheSize));
+    }
+    if (objects.empty()) {
+      return nullptr;
+    }
+    ObjectType* ptr = objects.back();
+    objects.pop_back();
+    return ptr;
+  }
+  void Refill(size_t num) {
+    auto& objects = local_cache_.objects;
+    objects.resize(num);
+    objects.resize(global_.DequeueBulk(objects.data(), num));
+    refill_num_.fetch_add(1, std::memory_order_relaxed);
+    if (objects.empty()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Extend(num + kPoolDefaultExtendNum, &objects);
+    }
+  }
+  void Release(ObjectType* ptr) {
+    auto& objects = local_cache_.objects;
+    objects.push_back(ptr);
+    if (objects.size() >= 2 * kPoolLocalCacheSize) {
+      // the global queue always has room for every pooled object
+      global_.EnqueueBulk(objects.end() - kPoolLocalCacheSize,
+                          kPoolLocalCacheSize);
+      objects.resize(objects.size() - kPoolLocalCacheSize);
+    }
+  }
+  // @brief add up to num objects, should add lock before invoke this
+  // function
+  void Extend(size_t num, std::vector<ObjectType*>* objects) {
+    num = std::min(num, kMaxSize - capacity_);
     for (size_t i = 0; i < num; ++i) {
       ObjectType* ptr = new ObjectType;
       extended_cache_.push_back(ptr);
-      queue_.push(ptr);
+      objects->push_back(ptr);
     }
-    capacity_ = kDefaultCacheSize + extended_cache_.size();
+    capacity_ += num;
+    extend_num_.fetch_add(num, std::memory_order_relaxed);
   }
-#endif
   // @brief default constructor
   explicit ConcurrentObjectPool(const size_t default_size)
-      : kDefaultCacheSize(default_size) {
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-    cache_ = new ObjectType[kDefaultCacheSize];
-    for (size_t i = 0; i < kDefaultCacheSize; ++i) {
-      queue_.push(&cache_[i]);
-    }
-    capacity_ = kDefaultCacheSize;
-#endif
-  }
+      : kDefaultCacheSize(default_size),
+        kMaxSize(default_size * kPoolMaxSizeFactor) {}
   std::mutex mutex_;
-  std::queue<ObjectType*> queue_;
+  cyber::base::BoundedQueue<ObjectType*> global_;
+  std::once_flag warmup_flag_;
+  std::atomic<uint64_t> refill_num_ = {0};
+  std::atomic<uint64_t> extend_num_ = {0};
+  std::atomic<uint64_t> overflow_num_ = {0};
   // @brief point to a continuous memory of default pool size
   ObjectType* cache_ = nullptr;
   const size_t kDefaultCacheSize;
+  const size_t kMaxSize;
   // @brief list to store extended memory, not as efficient
   std::list<ObjectType*> extended_cache_;
   static const Initializer kInitializer;
+  static thread_local LocalCache local_cache_;
 };
 
+template <class ObjectType, size_t N, class Initializer>
+const Initializer
+    ConcurrentObjectPool<ObjectType, N, Initializer>::kInitializer =
+        Initializer();
+
+template <class ObjectType, size_t N, class Initializer>
+thread_local typename ConcurrentObjectPool<ObjectType, N,
+                                           Initializer>::LocalCache
+    ConcurrentObjectPool<ObjectType, N, Initializer>::local_cache_;
+
 }  // namespace base
 }  // namespace perception
 }  // namespace apollo
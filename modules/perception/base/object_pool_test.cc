@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/base/object_pool.h"
 
+#include <thread>
+
 #include "modules/perception/base/light_object_pool.h"
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/object_pool_types.h"
@@ -25,13 +27,20 @@ namespace apollo {
 namespace perception {
 namespace base {
 
+// the concurrent pools fall back to plain allocation unless enabled
+class ObjectPoolEnvironment : public ::testing::Environment {
+ public:
+  void SetUp() override { FLAGS_enable_base_object_pool = true; }
+};
+
+const ::testing::Environment* const kObjectPoolEnvironment =
+    ::testing::AddGlobalTestEnvironment(new ObjectPoolEnvironment);
+
 TEST(ObjectPoolTest, basic_test) {
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   EXPECT_EQ(ObjectPool::Instance().RemainedNum(), kObjectPoolSize);
   EXPECT_EQ(PointFCloudPool::Instance().RemainedNum(), kPointCloudPoolSize);
   EXPECT_EQ(PointDCloudPool::Instance().RemainedNum(), kPointCloudPoolSize);
   EXPECT_EQ(FramePool::Instance().RemainedNum(), kFramePoolSize);
-#endif
 }
 
 TEST(ObjectPoolTest, dummy_object_pool_test) {
@@ -80,14 +89,12 @@ TEST(ObjectPoolTest, dummy_object_pool_test) {
 }
 
 TEST(ObjectPoolTest, concurrent_object_pool_capacity_test) {
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   typedef ConcurrentObjectPool<Object> TestObjectPool;
   size_t capacity = TestObjectPool::Instance().RemainedNum();
   TestObjectPool::Instance().set_capacity(capacity - 10);
   EXPECT_EQ(TestObjectPool::Instance().RemainedNum(), capacity);
   TestObjectPool::Instance().set_capacity(capacity + 10);
   EXPECT_EQ(TestObjectPool::Instance().RemainedNum(), capacity + 10);
-#endif
 }
 
 TEST(ObjectPoolTest, concurrent_object_pool_get_test) {
@@ -98,29 +105,23 @@ TEST(ObjectPoolTest, concurrent_object_pool_get_test) {
   for (size_t i = 0; i < size; ++i) {
     memory.push_back(instance.Get());
   }
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   EXPECT_EQ(instance.RemainedNum(), 0);
-#endif
   {
     std::shared_ptr<Object> obj = instance.Get();
     EXPECT_NE(obj, nullptr);
   }
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   EXPECT_GE(instance.RemainedNum(), 1);
-#endif
 }
 
 TEST(ObjectPoolTest, concurrent_object_pool_batch_get_vec_test) {
   typedef ConcurrentObjectPool<Object> TestObjectPool;
   auto& instance = TestObjectPool::Instance();
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   size_t size = instance.RemainedNum();
   std::vector<std::shared_ptr<Object>> memory;
   for (size_t i = 0; i < size - 1; ++i) {
     memory.push_back(instance.Get());
   }
   EXPECT_EQ(instance.RemainedNum(), 1);
-#endif
   std::shared_ptr<Object> obj = instance.Get();
   EXPECT_NE(obj, nullptr);
   obj->id = 0;
@@ -136,22 +137,18 @@ TEST(ObjectPoolTest, concurrent_object_pool_batch_get_vec_test) {
       EXPECT_EQ(objects_vector[i]->id, -1);
     }
   }
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   EXPECT_GE(instance.RemainedNum(), 5);
-#endif
 }
 
 TEST(ObjectPoolTest, concurrent_object_pool_batch_get_list_test) {
   typedef ConcurrentObjectPool<Object> TestObjectPool;
   auto& instance = TestObjectPool::Instance();
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   size_t size = instance.RemainedNum();
   std::vector<std::shared_ptr<Object>> memory;
   for (size_t i = 0; i < size - 1; ++i) {
     memory.push_back(instance.Get());
   }
   EXPECT_EQ(instance.RemainedNum(), 1);
-#endif
   std::shared_ptr<Object> obj = instance.Get();
   EXPECT_NE(obj, nullptr);
   obj->id = 0;
@@ -168,22 +165,18 @@ TEST(ObjectPoolTest, concurrent_object_pool_batch_get_list_test) {
     objects_list.pop_front();
     EXPECT_EQ(objects_list.front()->id, 0);
   }
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   EXPECT_GE(instance.RemainedNum(), 4);
-#endif
 }
 
 TEST(ObjectPoolTest, concurrent_object_pool_batch_get_deque_test) {
   typedef ConcurrentObjectPool<Object> TestObjectPool;
   auto& instance = TestObjectPool::Instance();
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   size_t size = instance.RemainedNum();
   std::vector<std::shared_ptr<Object>> memory;
   for (size_t i = 0; i < size - 1; ++i) {
     memory.push_back(instance.Get());
   }
   EXPECT_EQ(instance.RemainedNum(), 1);
-#endif
   std::shared_ptr<Object> obj = instance.Get();
   EXPECT_NE(obj, nullptr);
   obj->id = 0;
@@ -202,26 +195,44 @@ TEST(ObjectPoolTest, concurrent_object_pool_batch_get_deque_test) {
     EXPECT_EQ(objects_dequeue[3]->id, -1);
     EXPECT_EQ(objects_dequeue[4]->id, -1);
   }
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   EXPECT_GE(instance.RemainedNum(), 4);
-#endif
 }
 
-#ifndef PERCEPTION_BASE_DISABLE_POOL
 TEST(ObjectPoolTest, concurrent_object_pool_constructor_test) {
   typedef ConcurrentObjectPool<Object, 10> TestObjectPool;
   auto& pool = TestObjectPool::Instance();
   EXPECT_EQ(pool.RemainedNum(), 10);
   EXPECT_EQ(pool.get_capacity(), 10);
 }
-#endif
+
+TEST(ObjectPoolTest, concurrent_object_pool_thread_cache_test) {
+  typedef ConcurrentObjectPool<Object, 50> TestObjectPool;
+  auto& instance = TestObjectPool::Instance();
+  EXPECT_EQ(instance.RemainedNum(), 50);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&instance]() {
+      for (int round = 0; round < 100; ++round) {
+        std::vector<std::shared_ptr<Object>> objects;
+        instance.BatchGet(20, &objects);
+        EXPECT_EQ(objects.size(), 20);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // the caches of finished threads are handed back to the global queue
+  EXPECT_EQ(instance.RemainedNum(), instance.get_capacity());
+  EXPECT_GT(instance.stats().refill_num, 0);
+  EXPECT_LE(instance.get_capacity(), 50 * kPoolMaxSizeFactor);
+}
 
 struct TestObjectPoolInitializer {
   void operator()(Object* t) const { t->id = 1; }
 };
 
 TEST(ObjectPoolTest, concurrent_object_pool_initializer_test) {
-#ifndef PERCEPTION_BASE_DISABLE_POOL
   {
     typedef ConcurrentObjectPool<Object, 10, TestObjectPoolInitializer>
         TestObjectPool;
@@ -251,7 +262,6 @@ TEST(ObjectPoolTest, concurrent_object_pool_initializer_test) {
       }
     }
   }
-#endif
   {
     typedef ConcurrentObjectPool<Object> TestObjectPool;
     std::shared_ptr<Object> ptr = TestObjectPool::Instance().Get();
@@ -27,11 +27,7 @@ __attribute__((constructor)) void PoolInitialize() {
   PointFCloudPool::Instance();
   PointDCloudPool::Instance();
   FramePool::Instance();
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-  AINFO << "Initialize base object pool (no-malloc).";
-#else
-  AINFO << "Initialize base object pool (malloc).";
-#endif
+  AINFO << "Initialize base object pool.";
 }
 
 }  // namespace base
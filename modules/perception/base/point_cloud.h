@@ -77,6 +77,8 @@ class PointCloud {
   inline size_t width() const { return width_; }
   // @brief accessor of point size, wrapper of vector
   inline size_t size() const { return points_.size(); }
+  // @brief accessor of the bytes stored for each point
+  inline virtual size_t point_bytes() const { return sizeof(PointT); }
   // @brief reserve function wrapper of vector
   inline virtual void reserve(size_t size) { points_.reserve(size); }
   // @brief empty function wrapper of vector
@@ -183,13 +185,13 @@ class PointCloud {
   // @brief cloud timestamp setter
   void set_timestamp(const double timestamp) { timestamp_ = timestamp; }
   // @brief cloud timestamp getter
-  double get_timestamp() { return timestamp_; }
+  double get_timestamp() const { return timestamp_; }
   // @brief sensor to world pose setter
   void set_sensor_to_world_pose(const Eigen::Affine3d& sensor_to_world_pose) {
     sensor_to_world_pose_ = sensor_to_world_pose;
   }
   // @brief sensor to world pose getter
-  const Eigen::Affine3d& sensor_to_world_pose() {
+  const Eigen::Affine3d& sensor_to_world_pose() const {
     return sensor_to_world_pose_;
   }
   // @brief rotate the point cloud and set rotation part of pose to identity
@@ -308,6 +310,11 @@ class AttributePointCloud : public PointCloud<PointT> {
     height_ = 1;
     return *this;
   }
+  // @brief overrided accessor of the bytes stored for each point
+  inline size_t point_bytes() const override {
+    return sizeof(PointT) + sizeof(double) + sizeof(float) + sizeof(int32_t) +
+           sizeof(uint8_t);
+  }
   // @brief overrided reserve function wrapper of vector
   inline void reserve(const size_t size) override {
     points_.reserve(size);
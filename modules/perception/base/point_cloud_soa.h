@@ -0,0 +1,314 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "modules/perception/base/point.h"
+#include "modules/perception/base/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+// @brief Point cloud class storing every field of the points in its own
+// aligned array, for kernels which only read one or two of the fields.
+// The accessors follow AttributePointCloud, the coordinates are exposed as
+// per-field arrays instead of a point vector.
+template <typename T>
+class SoAPointCloud {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+ public:
+  template <typename FieldT>
+  using FieldVector = std::vector<FieldT, Eigen::aligned_allocator<FieldT>>;
+  using PointType = Point<T>;
+
+  // @brief default constructor
+  SoAPointCloud() = default;
+  // @brief construct from an attribute point cloud
+  explicit SoAPointCloud(const AttributePointCloud<PointType>& pc) {
+    Assign(pc);
+  }
+  // @brief destructor
+  ~SoAPointCloud() = default;
+
+  // @brief whether the cloud is organized
+  inline bool IsOrganized() const { return height_ > 1; }
+  // @brief accessor of point cloud height
+  inline size_t height() const { return height_; }
+  // @brief accessor of point cloud width
+  inline size_t width() const { return width_; }
+  // @brief accessor of point size
+  inline size_t size() const { return x_.size(); }
+  // @brief empty function wrapper of vector
+  inline bool empty() const { return x_.empty(); }
+  // @brief accessor of the bytes stored for each point
+  inline size_t point_bytes() const {
+    return 4 * sizeof(T) + sizeof(double) + sizeof(float) + sizeof(int32_t) +
+           sizeof(uint8_t);
+  }
+  // @brief reserve function wrapper of vector
+  inline void reserve(const size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+    intensity_.reserve(size);
+    points_timestamp_.reserve(size);
+    points_height_.reserve(size);
+    points_beam_id_.reserve(size);
+    points_label_.reserve(size);
+  }
+  // @brief resize function wrapper of vector
+  inline void resize(const size_t size) {
+    x_.resize(size, 0);
+    y_.resize(size, 0);
+    z_.resize(size, 0);
+    intensity_.resize(size, 0);
+    points_timestamp_.resize(size, 0.0);
+    points_height_.resize(size, std::numeric_limits<float>::max());
+    points_beam_id_.resize(size, -1);
+    points_label_.resize(size, 0);
+    if (size != width_ * height_) {
+      width_ = size;
+      height_ = 1;
+    }
+  }
+  // @brief push_back function wrapper of vector
+  inline void push_back(const PointType& point, double timestamp = 0.0,
+                        float height = std::numeric_limits<float>::max(),
+                        int32_t beam_id = -1, uint8_t label = 0) {
+    x_.push_back(point.x);
+    y_.push_back(point.y);
+    z_.push_back(point.z);
+    intensity_.push_back(point.intensity);
+    points_timestamp_.push_back(timestamp);
+    points_height_.push_back(height);
+    points_beam_id_.push_back(beam_id);
+    points_label_.push_back(label);
+    width_ = x_.size();
+    height_ = 1;
+  }
+  // @brief clear function wrapper of vector
+  inline void clear() {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    intensity_.clear();
+    points_timestamp_.clear();
+    points_height_.clear();
+    points_beam_id_.clear();
+    points_label_.clear();
+    width_ = height_ = 0;
+  }
+  // @brief gather point via 1d index
+  inline PointType point(const size_t i) const {
+    PointType point;
+    point.x = x_[i];
+    point.y = y_[i];
+    point.z = z_[i];
+    point.intensity = intensity_[i];
+    return point;
+  }
+  // @brief scatter point via 1d index
+  inline void SetPoint(const size_t i, const PointType& point) {
+    x_[i] = point.x;
+    y_[i] = point.y;
+    z_[i] = point.z;
+    intensity_[i] = point.intensity;
+  }
+
+  // @brief copy all the fields of an attribute point cloud
+  void Assign(const AttributePointCloud<PointType>& pc) {
+    const size_t size = pc.size();
+    x_.resize(size);
+    y_.resize(size);
+    z_.resize(size);
+    intensity_.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      const PointType& point = pc[i];
+      x_[i] = point.x;
+      y_[i] = point.y;
+      z_[i] = point.z;
+      intensity_[i] = point.intensity;
+    }
+    points_timestamp_.assign(pc.points_timestamp().begin(),
+                             pc.points_timestamp().end());
+    points_height_.assign(pc.points_height().begin(),
+                          pc.points_height().end());
+    points_beam_id_.assign(pc.points_beam_id().begin(),
+                           pc.points_beam_id().end());
+    points_label_.assign(pc.points_label().begin(), pc.points_label().end());
+    width_ = pc.width();
+    height_ = pc.height();
+    sensor_to_world_pose_ = pc.sensor_to_world_pose();
+    timestamp_ = pc.get_timestamp();
+  }
+  // @brief copy all the fields into an attribute point cloud
+  void CopyTo(AttributePointCloud<PointType>* pc) const {
+    const size_t size = x_.size();
+    if (IsOrganized()) {
+      *pc = AttributePointCloud<PointType>(width_, height_);
+    } else {
+      pc->clear();
+      pc->resize(size);
+    }
+    for (size_t i = 0; i < size; ++i) {
+      pc->at(i) = point(i);
+      pc->mutable_points_timestamp()->at(i) = points_timestamp_[i];
+      pc->points_height(i) = points_height_[i];
+      pc->points_beam_id(i) = points_beam_id_[i];
+      pc->points_label(i) = points_label_[i];
+    }
+    pc->set_sensor_to_world_pose(sensor_to_world_pose_);
+    pc->set_timestamp(timestamp_);
+  }
+  // @brief copy point cloud given indices
+  template <typename IndexType>
+  inline void CopyPointCloud(const SoAPointCloud<T>& rhs,
+                             const std::vector<IndexType>& indices) {
+    clear();
+    resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const size_t id = static_cast<size_t>(indices[i]);
+      x_[i] = rhs.x_[id];
+      y_[i] = rhs.y_[id];
+      z_[i] = rhs.z_[id];
+      intensity_[i] = rhs.intensity_[id];
+      points_timestamp_[i] = rhs.points_timestamp_[id];
+      points_height_[i] = rhs.points_height_[id];
+      points_beam_id_[i] = rhs.points_beam_id_[id];
+      points_label_[i] = rhs.points_label_[id];
+    }
+  }
+  // @brief swap point cloud
+  inline void SwapPointCloud(SoAPointCloud<T>* rhs) {
+    x_.swap(rhs->x_);
+    y_.swap(rhs->y_);
+    z_.swap(rhs->z_);
+    intensity_.swap(rhs->intensity_);
+    points_timestamp_.swap(rhs->points_timestamp_);
+    points_height_.swap(rhs->points_height_);
+    points_beam_id_.swap(rhs->points_beam_id_);
+    points_label_.swap(rhs->points_label_);
+    std::swap(width_, rhs->width_);
+    std::swap(height_, rhs->height_);
+    std::swap(sensor_to_world_pose_, rhs->sensor_to_world_pose_);
+    std::swap(timestamp_, rhs->timestamp_);
+  }
+  // @brief transform the coordinates in place, set the pose to identity
+  void TransformPointCloud() {
+    const Eigen::Matrix<T, 3, 4> m =
+        sensor_to_world_pose_.matrix().template topRows<3>().template cast<T>();
+    T* __restrict__ xs = x_.data();
+    T* __restrict__ ys = y_.data();
+    T* __restrict__ zs = z_.data();
+    const size_t size = x_.size();
+    // no branch and no aliasing, the compiler vectorizes this loop
+    for (size_t i = 0; i < size; ++i) {
+      const T x = xs[i];
+      const T y = ys[i];
+      const T z = zs[i];
+      xs[i] = m(0, 0) * x + m(0, 1) * y + m(0, 2) * z + m(0, 3);
+      ys[i] = m(1, 0) * x + m(1, 1) * y + m(1, 2) * z + m(1, 3);
+      zs[i] = m(2, 0) * x + m(2, 1) * y + m(2, 2) * z + m(2, 3);
+    }
+    sensor_to_world_pose_.setIdentity();
+  }
+  // @brief check data member consistency
+  bool CheckConsistency() const {
+    const size_t size = x_.size();
+    return y_.size() == size && z_.size() == size &&
+           intensity_.size() == size && points_timestamp_.size() == size &&
+           points_height_.size() == size && points_beam_id_.size() == size &&
+           points_label_.size() == size;
+  }
+
+  const FieldVector<T>& points_x() const { return x_; }
+  FieldVector<T>* mutable_points_x() { return &x_; }
+  const FieldVector<T>& points_y() const { return y_; }
+  FieldVector<T>* mutable_points_y() { return &y_; }
+  const FieldVector<T>& points_z() const { return z_; }
+  FieldVector<T>* mutable_points_z() { return &z_; }
+  const FieldVector<T>& points_intensity() const { return intensity_; }
+  FieldVector<T>* mutable_points_intensity() { return &intensity_; }
+
+  const FieldVector<double>& points_timestamp() const {
+    return points_timestamp_;
+  }
+  double points_timestamp(size_t i) const { return points_timestamp_[i]; }
+  FieldVector<double>* mutable_points_timestamp() { return &points_timestamp_; }
+
+  const FieldVector<float>& points_height() const { return points_height_; }
+  float& points_height(size_t i) { return points_height_[i]; }
+  const float& points_height(size_t i) const { return points_height_[i]; }
+  void SetPointHeight(size_t i, float height) { points_height_[i] = height; }
+  FieldVector<float>* mutable_points_height() { return &points_height_; }
+
+  const FieldVector<int32_t>& points_beam_id() const { return points_beam_id_; }
+  FieldVector<int32_t>* mutable_points_beam_id() { return &points_beam_id_; }
+  int32_t& points_beam_id(size_t i) { return points_beam_id_[i]; }
+  const int32_t& points_beam_id(size_t i) const { return points_beam_id_[i]; }
+
+  const FieldVector<uint8_t>& points_label() const { return points_label_; }
+  FieldVector<uint8_t>* mutable_points_label() { return &points_label_; }
+  uint8_t& points_label(size_t i) { return points_label_[i]; }
+  const uint8_t& points_label(size_t i) const { return points_label_[i]; }
+
+  // @brief cloud timestamp setter
+  void set_timestamp(const double timestamp) { timestamp_ = timestamp; }
+  // @brief cloud timestamp getter
+  double get_timestamp() const { return timestamp_; }
+  // @brief sensor to world pose setter
+  void set_sensor_to_world_pose(const Eigen::Affine3d& sensor_to_world_pose) {
+    sensor_to_world_pose_ = sensor_to_world_pose;
+  }
+  // @brief sensor to world pose getter
+  const Eigen::Affine3d& sensor_to_world_pose() const {
+    return sensor_to_world_pose_;
+  }
+
+ private:
+  FieldVector<T> x_;
+  FieldVector<T> y_;
+  FieldVector<T> z_;
+  FieldVector<T> intensity_;
+  FieldVector<double> points_timestamp_;
+  FieldVector<float> points_height_;
+  FieldVector<int32_t> points_beam_id_;
+  FieldVector<uint8_t> points_label_;
+  size_t width_ = 0;
+  size_t height_ = 0;
+
+  Eigen::Affine3d sensor_to_world_pose_ = Eigen::Affine3d::Identity();
+  double timestamp_ = 0.0;
+};
+
+typedef SoAPointCloud<float> SoAPointFCloud;
+typedef SoAPointCloud<double> SoAPointDCloud;
+
+typedef std::shared_ptr<SoAPointFCloud> SoAPointFCloudPtr;
+typedef std::shared_ptr<const SoAPointFCloud> SoAPointFCloudConstPtr;
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
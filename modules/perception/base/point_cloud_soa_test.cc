@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/base/point_cloud_soa.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+TEST(SoAPointCloudTest, soa_point_cloud_test) {
+  PointFCloud cloud;
+  for (int i = 0; i < 37; ++i) {
+    PointF point;
+    point.x = 0.5f * static_cast<float>(i);
+    point.y = -0.25f * static_cast<float>(i);
+    point.z = 0.1f * static_cast<float>(i % 5);
+    point.intensity = static_cast<float>(i % 7);
+    cloud.push_back(point, 0.01 * i, 0.2f * static_cast<float>(i), i % 16,
+                    static_cast<uint8_t>(i % 3));
+  }
+  cloud.set_timestamp(12.5);
+
+  SoAPointFCloud soa(cloud);
+  EXPECT_EQ(soa.size(), cloud.size());
+  EXPECT_EQ(soa.width(), cloud.width());
+  EXPECT_EQ(soa.height(), cloud.height());
+  EXPECT_TRUE(soa.CheckConsistency());
+  EXPECT_DOUBLE_EQ(soa.get_timestamp(), 12.5);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(soa.points_x().data()) % 16, 0);
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    EXPECT_EQ(soa.points_x()[i], cloud[i].x);
+    EXPECT_EQ(soa.points_y()[i], cloud[i].y);
+    EXPECT_EQ(soa.points_z()[i], cloud[i].z);
+    EXPECT_EQ(soa.points_intensity()[i], cloud[i].intensity);
+    EXPECT_EQ(soa.points_timestamp(i), cloud.points_timestamp(i));
+    EXPECT_EQ(soa.points_height(i), cloud.points_height(i));
+    EXPECT_EQ(soa.points_beam_id(i), cloud.points_beam_id(i));
+    EXPECT_EQ(soa.points_label(i), cloud.points_label(i));
+  }
+
+  PointFCloud copied;
+  soa.CopyTo(&copied);
+  EXPECT_EQ(copied.size(), cloud.size());
+  EXPECT_TRUE(copied.CheckConsistency());
+  EXPECT_DOUBLE_EQ(copied.get_timestamp(), 12.5);
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    EXPECT_EQ(copied[i].x, cloud[i].x);
+    EXPECT_EQ(copied[i].intensity, cloud[i].intensity);
+    EXPECT_EQ(copied.points_beam_id(i), cloud.points_beam_id(i));
+    EXPECT_EQ(copied.points_label(i), cloud.points_label(i));
+  }
+
+  std::vector<int> indices = {3, 0, 36};
+  SoAPointFCloud sub;
+  sub.CopyPointCloud(soa, indices);
+  EXPECT_EQ(sub.size(), 3);
+  EXPECT_EQ(sub.point(0).x, cloud[3].x);
+  EXPECT_EQ(sub.point(2).y, cloud[36].y);
+  EXPECT_EQ(sub.points_height(1), cloud.points_height(0));
+
+  sub.push_back(PointF(), 1.0);
+  EXPECT_EQ(sub.size(), 4);
+  EXPECT_EQ(sub.points_beam_id(3), -1);
+  sub.SwapPointCloud(&soa);
+  EXPECT_EQ(sub.size(), 37);
+  EXPECT_EQ(soa.size(), 4);
+  soa.clear();
+  EXPECT_TRUE(soa.empty());
+}
+
+TEST(SoAPointCloudTest, organized_copy_test) {
+  PointFCloud cloud(4, 3);
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    cloud[i].x = static_cast<float>(i);
+    cloud.points_beam_id(i) = static_cast<int32_t>(i / 4);
+  }
+  SoAPointFCloud soa(cloud);
+  EXPECT_TRUE(soa.IsOrganized());
+  PointFCloud copied;
+  soa.CopyTo(&copied);
+  EXPECT_EQ(copied.width(), 4);
+  EXPECT_EQ(copied.height(), 3);
+  EXPECT_EQ(copied.at(1, 2)->x, 9.f);
+  EXPECT_EQ(copied.points_beam_id(9), 2);
+}
+
+TEST(SoAPointCloudTest, transform_test) {
+  PointFCloud cloud;
+  for (int i = 0; i < 21; ++i) {
+    PointF point;
+    point.x = static_cast<float>(i);
+    point.y = 1.f - static_cast<float>(i);
+    point.z = 0.5f * static_cast<float>(i);
+    cloud.push_back(point);
+  }
+  Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+  pose.rotate(
+      Eigen::AngleAxisd(0.3, Eigen::Vector3d(0.2, 0.3, 1.0).normalized()));
+  pose.translation() << 10.0, -5.0, 2.0;
+  cloud.set_sensor_to_world_pose(pose);
+
+  SoAPointFCloud soa(cloud);
+  soa.TransformPointCloud();
+  cloud.TransformPointCloud();
+  EXPECT_TRUE(soa.sensor_to_world_pose().isApprox(Eigen::Affine3d::Identity()));
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    EXPECT_NEAR(soa.points_x()[i], cloud[i].x, 1e-4);
+    EXPECT_NEAR(soa.points_y()[i], cloud[i].y, 1e-4);
+    EXPECT_NEAR(soa.points_z()[i], cloud[i].z, 1e-4);
+  }
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
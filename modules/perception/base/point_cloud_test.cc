@@ -409,6 +409,17 @@ TEST(PointCloudTest, dynamic_binding_test) {
   EXPECT_TRUE(attribute_cloud->CheckConsistency());
 }
 
+TEST(PointCloudTest, point_bytes_test) {
+  PointCloud<PointF> cloud;
+  EXPECT_EQ(cloud.point_bytes(), sizeof(PointF));
+
+  std::shared_ptr<PointCloud<PointF>> attribute_cloud(
+      new AttributePointCloud<PointF>);
+  EXPECT_EQ(attribute_cloud->point_bytes(),
+            sizeof(PointF) + sizeof(double) + sizeof(float) + sizeof(int32_t) +
+                sizeof(uint8_t));
+}
+
 }  // namespace base
 }  // namespace perception
 }  // namespace apollo
@@ -66,6 +66,24 @@ namespace apollo {
 namespace perception {
 namespace base {
 
+namespace {
+
+thread_local TransferStats thread_transfer_stats;
+
+}  // namespace
+
+TransferStats SyncedMemory::transfer_stats() { return thread_transfer_stats; }
+
+void SyncedMemory::RecordHostToDevice(size_t bytes) {
+  ++thread_transfer_stats.host_to_device_count;
+  thread_transfer_stats.host_to_device_bytes += bytes;
+}
+
+void SyncedMemory::RecordDeviceToHost(size_t bytes) {
+  ++thread_transfer_stats.device_to_host_count;
+  thread_transfer_stats.device_to_host_bytes += bytes;
+}
+
 SyncedMemory::SyncedMemory(bool use_cuda)
     : cpu_ptr_(NULL),
       gpu_ptr_(NULL),
@@ -131,6 +149,7 @@ inline void SyncedMemory::to_cpu() {
         own_cpu_data_ = true;
       }
       BASE_CUDA_CHECK(cudaMemcpy(cpu_ptr_, gpu_ptr_, size_, cudaMemcpyDefault));
+      RecordDeviceToHost(size_);
       head_ = SYNCED;
 #else
       NO_GPU;
@@ -158,6 +177,7 @@ inline void SyncedMemory::to_gpu() {
         own_gpu_data_ = true;
       }
       BASE_CUDA_CHECK(cudaMemcpy(gpu_ptr_, cpu_ptr_, size_, cudaMemcpyDefault));
+      RecordHostToDevice(size_);
       head_ = SYNCED;
       break;
     case HEAD_AT_GPU:
@@ -241,6 +261,7 @@ void SyncedMemory::async_gpu_push(const cudaStream_t& stream) {
   }
   const cudaMemcpyKind put = cudaMemcpyHostToDevice;
   BASE_CUDA_CHECK(cudaMemcpyAsync(gpu_ptr_, cpu_ptr_, size_, put, stream));
+  RecordHostToDevice(size_);
   // Assume caller will synchronize on the stream before use
   head_ = SYNCED;
 }
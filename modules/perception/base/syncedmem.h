@@ -62,6 +62,8 @@ license and copyright terms herein.
  *****************************************************************************/
 #pragma once
 
+#include <cstdint>
+
 #include "cyber/common/log.h"
 #include "modules/perception/base/common.h"
 
@@ -90,6 +92,28 @@ inline void PerceptionFreeHost(void* ptr, bool use_cuda) {
   free(ptr);
 }
 
+// host and device copies made by the calling thread, diff two snapshots to
+// get the transfers of the work done in between.
+struct TransferStats {
+  uint64_t host_to_device_count = 0;
+  uint64_t host_to_device_bytes = 0;
+  uint64_t device_to_host_count = 0;
+  uint64_t device_to_host_bytes = 0;
+
+  TransferStats operator-(const TransferStats& other) const {
+    TransferStats diff;
+    diff.host_to_device_count =
+        host_to_device_count - other.host_to_device_count;
+    diff.host_to_device_bytes =
+        host_to_device_bytes - other.host_to_device_bytes;
+    diff.device_to_host_count =
+        device_to_host_count - other.device_to_host_count;
+    diff.device_to_host_bytes =
+        device_to_host_bytes - other.device_to_host_bytes;
+    return diff;
+  }
+};
+
 /**
  * @brief Manages memory allocation and synchronization between the host (CPU)
  *        and device (GPU).
@@ -123,6 +147,12 @@ class SyncedMemory {
   void async_gpu_push(const cudaStream_t& stream);
 #endif
 
+  // @brief: the syncs between head_ states are counted here, copies made
+  // outside SyncedMemory can be reported with the Record* functions.
+  static TransferStats transfer_stats();
+  static void RecordHostToDevice(size_t bytes);
+  static void RecordDeviceToHost(size_t bytes);
+
  private:
   void check_device();
   void to_cpu();
@@ -200,6 +200,29 @@ TEST_F(SyncedMemoryTest, TestGPUWrite) {
   EXPECT_EQ(mem.head(), SyncedMemory::SYNCED);
 }
 
+TEST_F(SyncedMemoryTest, TestTransferStats) {
+  const TransferStats begin = SyncedMemory::transfer_stats();
+  SyncedMemory mem(10, true);
+  // first touch allocates without copying
+  mem.mutable_gpu_data();
+  mem.gpu_data();
+  TransferStats diff = SyncedMemory::transfer_stats() - begin;
+  EXPECT_EQ(diff.host_to_device_count, 0u);
+  EXPECT_EQ(diff.device_to_host_count, 0u);
+
+  mem.cpu_data();
+  mem.cpu_data();
+  diff = SyncedMemory::transfer_stats() - begin;
+  EXPECT_EQ(diff.device_to_host_count, 1u);
+  EXPECT_EQ(diff.device_to_host_bytes, 10u);
+
+  mem.mutable_cpu_data();
+  mem.gpu_data();
+  diff = SyncedMemory::transfer_stats() - begin;
+  EXPECT_EQ(diff.host_to_device_count, 1u);
+  EXPECT_EQ(diff.host_to_device_bytes, 10u);
+}
+
 #endif
 
 }  // namespace base
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/camera/app/obstacle_camera_perception.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "absl/strings/str_cat.h"
@@ -26,6 +27,7 @@
 #include "modules/perception/camera/common/global_config.h"
 #include "modules/perception/camera/common/util.h"
 #include "modules/perception/common/io/io_util.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/inference/utils/cuda_util.h"
 
 namespace apollo {
@@ -52,6 +54,11 @@ bool ObstacleCameraPerception::Init(
   ACHECK(perception_param_.detector_param_size() > 0)
       << "Failed to init detector.";
   // Init detector
+  // with batched detection, cameras of the same detector config and image
+  // size share one detector so that their images run in one forward
+  const bool share_detector = FLAGS_camera_obstacle_detection_batch_size > 1;
+  std::map<std::string, std::shared_ptr<BaseObstacleDetector>>
+      shared_detector_map;
   base::BaseCameraModelPtr model;
   for (int i = 0; i < perception_param_.detector_param_size(); ++i) {
     ObstacleDetectorInitOptions detector_init_options;
@@ -68,6 +75,18 @@ bool ObstacleCameraPerception::Init(
     name_intrinsic_map_.insert(std::pair<std::string, Eigen::Matrix3f>(
         detector_param.camera_name(), pinhole->get_intrinsic_params()));
     detector_init_options.base_camera_model = model;
+    const std::string shared_key = absl::StrCat(
+        plugin_param.name(), ":", detector_init_options.root_dir, ":",
+        detector_init_options.conf_file, ":", model->get_width(), "x",
+        model->get_height());
+    if (share_detector && shared_detector_map.count(shared_key) > 0) {
+      AINFO << detector_param.camera_name() << " shares detector "
+            << shared_key;
+      name_detector_map_.insert(
+          std::pair<std::string, std::shared_ptr<BaseObstacleDetector>>(
+              detector_param.camera_name(), shared_detector_map[shared_key]));
+      continue;
+    }
     std::shared_ptr<BaseObstacleDetector> detector_ptr(
         BaseObstacleDetectorRegisterer::GetInstanceByName(plugin_param.name()));
     name_detector_map_.insert(
@@ -77,6 +96,9 @@ bool ObstacleCameraPerception::Init(
     ACHECK(name_detector_map_.at(detector_param.camera_name())
                ->Init(detector_init_options))
         << "Failed to init: " << plugin_param.name();
+    if (share_detector) {
+      shared_detector_map[shared_key] = detector_ptr;
+    }
   }
 
   // Init tracker
@@ -308,6 +330,48 @@ bool ObstacleCameraPerception::GetCalibrationService(
 
 bool ObstacleCameraPerception::Perception(
     const CameraPerceptionOptions &options, CameraFrame *frame) {
+  return Perception(options, frame, true);
+}
+
+bool ObstacleCameraPerception::PerceptionBatch(
+    const CameraPerceptionOptions &options,
+    const std::vector<CameraFrame *> &frames) {
+  inference::CudaUtil::set_device_id(perception_param_.gpu_id());
+  // obstacle detection only needs the image, so the frames of a shared
+  // detector are detected together ahead of the per frame pipeline
+  std::vector<std::shared_ptr<BaseObstacleDetector>> detectors;
+  std::vector<std::vector<CameraFrame *>> detector_frames;
+  for (auto *frame : frames) {
+    auto detector = name_detector_map_.at(frame->data_provider->sensor_name());
+    auto iter = std::find(detectors.begin(), detectors.end(), detector);
+    if (iter == detectors.end()) {
+      detectors.push_back(detector);
+      detector_frames.emplace_back();
+      iter = detectors.end() - 1;
+    }
+    detector_frames[iter - detectors.begin()].push_back(frame);
+  }
+  ObstacleDetectorOptions detector_options;
+  for (size_t i = 0; i < detectors.size(); ++i) {
+    if (!detectors[i]->DetectBatch(detector_options, detector_frames[i])) {
+      AERROR << "Failed to detect.";
+      return false;
+    }
+    ADEBUG << "Detected " << detector_frames[i].size() << " images with "
+           << detectors[i]->Name();
+  }
+
+  for (auto *frame : frames) {
+    if (!Perception(options, frame, false)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ObstacleCameraPerception::Perception(
+    const CameraPerceptionOptions &options, CameraFrame *frame,
+    bool run_detector) {
   PERF_FUNCTION();
   inference::CudaUtil::set_device_id(perception_param_.gpu_id());
   ObstacleDetectorOptions detector_options;
@@ -370,14 +434,17 @@ bool ObstacleCameraPerception::Perception(
   }
   PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(), "Predict");
 
-  std::shared_ptr<BaseObstacleDetector> detector =
-      name_detector_map_.at(frame->data_provider->sensor_name());
+  if (run_detector) {
+    std::shared_ptr<BaseObstacleDetector> detector =
+        name_detector_map_.at(frame->data_provider->sensor_name());
 
-  if (!detector->Detect(detector_options, frame)) {
-    AERROR << "Failed to detect.";
-    return false;
+    if (!detector->Detect(detector_options, frame)) {
+      AERROR << "Failed to detect.";
+      return false;
+    }
+    PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(),
+                                  "detect");
   }
-  PERF_BLOCK_END_WITH_INDICATOR(frame->data_provider->sensor_name(), "detect");
 
   // Save all detections results as kitti format
   WriteDetections(
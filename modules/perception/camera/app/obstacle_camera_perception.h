@@ -19,6 +19,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/perception/camera/app/proto/perception.pb.h"
 #include "modules/perception/camera/common/camera_frame.h"
@@ -67,9 +68,16 @@ class ObstacleCameraPerception : public BaseCameraPerception {
   bool GetCalibrationService(BaseCalibrationService **calibration_service);
   bool Perception(const CameraPerceptionOptions &options,
                   CameraFrame *frame) override;
+  // @brief: run time aligned frames of several cameras, the images of
+  // cameras sharing a detector are detected in one batch.
+  bool PerceptionBatch(const CameraPerceptionOptions &options,
+                       const std::vector<CameraFrame *> &frames);
   std::string Name() const override { return "ObstacleCameraPerception"; }
 
  private:
+  bool Perception(const CameraPerceptionOptions &options, CameraFrame *frame,
+                  bool run_detector);
+
   std::map<std::string, Eigen::Matrix3f> name_intrinsic_map_;
   std::map<std::string, std::shared_ptr<BaseObstacleDetector>>
       name_detector_map_;
@@ -41,12 +41,8 @@ bool DataProvider::Init(const DataProvider::InitOptions &options) {
   rgb_.reset(new base::Image8U(src_height_, src_width_, base::Color::RGB));
   bgr_.reset(new base::Image8U(src_height_, src_width_, base::Color::BGR));
 
-  // Allocate CPU memory for uint8 blobs
-  gray_->cpu_data();
-  rgb_->cpu_data();
-  bgr_->cpu_data();
-
-  // Allocate GPU memory for uint8 blobs
+  // Allocate GPU memory for uint8 blobs, the images stay on the device
+  // and host memory is only allocated if someone reads them on the host
   gray_->gpu_data();
   rgb_->gpu_data();
   bgr_->gpu_data();
@@ -64,11 +60,6 @@ bool DataProvider::Init(const DataProvider::InitOptions &options) {
     ori_bgr_.reset(
         new base::Image8U(src_height_, src_width_, base::Color::BGR));
 
-    // Allocate CPU memory for uint8 blobs
-    ori_gray_->cpu_data();
-    ori_rgb_->cpu_data();
-    ori_bgr_->cpu_data();
-
     // Allocate GPU memory for uint8 blobs
     ori_gray_->gpu_data();
     ori_rgb_->gpu_data();
@@ -153,10 +144,14 @@ bool DataProvider::FillImageData(int rows, int cols, const uint8_t *data,
     if (handler_ != nullptr) {
       cudaMemcpy(ori_rgb_->mutable_gpu_data(), data,
                  ori_rgb_->rows() * ori_rgb_->width_step(), cudaMemcpyDefault);
+      base::SyncedMemory::RecordHostToDevice(ori_rgb_->rows() *
+                                             ori_rgb_->width_step());
       success = handler_->Handle(*ori_rgb_, rgb_.get());
     } else {
       cudaMemcpy(rgb_->mutable_gpu_data(), data,
                  rgb_->rows() * rgb_->width_step(), cudaMemcpyDefault);
+      base::SyncedMemory::RecordHostToDevice(rgb_->rows() *
+                                             rgb_->width_step());
       success = true;
     }
     rgb_ready_ = true;
@@ -164,10 +159,14 @@ bool DataProvider::FillImageData(int rows, int cols, const uint8_t *data,
     if (handler_ != nullptr) {
       cudaMemcpy(ori_bgr_->mutable_gpu_data(), data,
                  ori_bgr_->rows() * ori_bgr_->width_step(), cudaMemcpyDefault);
+      base::SyncedMemory::RecordHostToDevice(ori_bgr_->rows() *
+                                             ori_bgr_->width_step());
       success = handler_->Handle(*ori_bgr_, bgr_.get());
     } else {
       cudaMemcpy(bgr_->mutable_gpu_data(), data,
                  bgr_->rows() * bgr_->width_step(), cudaMemcpyDefault);
+      base::SyncedMemory::RecordHostToDevice(bgr_->rows() *
+                                             bgr_->width_step());
       success = true;
     }
     bgr_ready_ = true;
@@ -176,10 +175,14 @@ bool DataProvider::FillImageData(int rows, int cols, const uint8_t *data,
       cudaMemcpy(ori_gray_->mutable_gpu_data(), data,
                  ori_gray_->rows() * ori_gray_->width_step(),
                  cudaMemcpyDefault);
+      base::SyncedMemory::RecordHostToDevice(ori_gray_->rows() *
+                                             ori_gray_->width_step());
       success = handler_->Handle(*ori_gray_, gray_.get());
     } else {
       cudaMemcpy(gray_->mutable_gpu_data(), data,
                  gray_->rows() * gray_->width_step(), cudaMemcpyDefault);
+      base::SyncedMemory::RecordHostToDevice(gray_->rows() *
+                                             gray_->width_step());
       success = true;
     }
     gray_ready_ = true;
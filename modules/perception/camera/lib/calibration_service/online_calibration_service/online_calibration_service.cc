@@ -45,6 +45,7 @@ bool OnlineCalibrationService::Init(
     name_camera_status_map_.insert(
         std::pair<std::string, CameraStatus>(iter->first, camera_status));
   }
+  UpdateSensorStatus();
   // Only init calibrator on master_sensor
   CalibratorInitOptions calibrator_init_options;
   calibrator_init_options.image_width = options.image_width;
@@ -72,17 +73,16 @@ bool OnlineCalibrationService::BuildIndex() {
 
 bool OnlineCalibrationService::QueryDepthOnGroundPlane(int x, int y,
                                                        double *depth) const {
-  if (!is_service_ready_) {
+  if (!is_service_ready_ || sensor_status_ == nullptr) {
     return false;
   }
   ACHECK(depth != nullptr);
   double pixel[2] = {static_cast<double>(x), static_cast<double>(y)};
   double point[3] = {0};
 
-  auto iter = name_camera_status_map_.find(sensor_name_);
   bool success = common::IBackprojectPlaneIntersectionCanonical(
-      pixel, &(iter->second.k_matrix[0]), &(iter->second.ground_plane[0]),
-      point);
+      pixel, &(sensor_status_->k_matrix[0]),
+      &(sensor_status_->ground_plane[0]), point);
   if (!success) {
     *depth = 0.0;
     return false;
@@ -94,16 +94,15 @@ bool OnlineCalibrationService::QueryDepthOnGroundPlane(int x, int y,
 
 bool OnlineCalibrationService::QueryPoint3dOnGroundPlane(
     int x, int y, Eigen::Vector3d *point3d) const {
-  if (!is_service_ready_) {
+  if (!is_service_ready_ || sensor_status_ == nullptr) {
     return false;
   }
   ACHECK(point3d != nullptr);
   double pixel[2] = {static_cast<double>(x), static_cast<double>(y)};
   double point[3] = {0};
-  auto iter = name_camera_status_map_.find(sensor_name_);
   bool success = common::IBackprojectPlaneIntersectionCanonical(
-      pixel, &(iter->second.k_matrix[0]), &(iter->second.ground_plane[0]),
-      point);
+      pixel, &(sensor_status_->k_matrix[0]),
+      &(sensor_status_->ground_plane[0]), point);
   if (!success) {
     (*point3d)(0) = (*point3d)(1) = (*point3d)(2) = 0.0;
     return false;
@@ -115,22 +114,45 @@ bool OnlineCalibrationService::QueryPoint3dOnGroundPlane(
   return true;
 }
 
+int OnlineCalibrationService::QueryDepthsOnGroundPlane(
+    const std::vector<Eigen::Vector2i> &pixels,
+    std::vector<double> *depths) const {
+  ACHECK(depths != nullptr);
+  depths->assign(pixels.size(), 0.0);
+  if (!is_service_ready_ || sensor_status_ == nullptr) {
+    return 0;
+  }
+  const double *k_matrix = &(sensor_status_->k_matrix[0]);
+  const double *ground_plane = &(sensor_status_->ground_plane[0]);
+  int nr_valid = 0;
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    double pixel[2] = {static_cast<double>(pixels[i](0)),
+                       static_cast<double>(pixels[i](1))};
+    double point[3] = {0};
+    if (common::IBackprojectPlaneIntersectionCanonical(pixel, k_matrix,
+                                                       ground_plane, point)) {
+      (*depths)[i] = point[2];
+      ++nr_valid;
+    }
+  }
+  return nr_valid;
+}
+
 bool OnlineCalibrationService::QueryGroundPlaneInCameraFrame(
     Eigen::Vector4d *plane_param) const {
   if (plane_param == nullptr) {
     AERROR << "plane_param is nullptr";
     return false;
   }
-  if (!is_service_ready_) {
+  if (!is_service_ready_ || sensor_status_ == nullptr) {
     (*plane_param)(0) = (*plane_param)(1) = (*plane_param)(2) =
         (*plane_param)(3) = 0.0;
     return false;
   }
-  auto iter = name_camera_status_map_.find(sensor_name_);
-  (*plane_param)(0) = iter->second.ground_plane[0];
-  (*plane_param)(1) = iter->second.ground_plane[1];
-  (*plane_param)(2) = iter->second.ground_plane[2];
-  (*plane_param)(3) = iter->second.ground_plane[3];
+  (*plane_param)(0) = sensor_status_->ground_plane[0];
+  (*plane_param)(1) = sensor_status_->ground_plane[1];
+  (*plane_param)(2) = sensor_status_->ground_plane[2];
+  (*plane_param)(3) = sensor_status_->ground_plane[3];
   return true;
 }
 
@@ -144,13 +166,12 @@ bool OnlineCalibrationService::QueryCameraToGroundHeightAndPitchAngle(
     AERROR << "pitch is nullptr";
     return false;
   }
-  if (!is_service_ready_) {
+  if (!is_service_ready_ || sensor_status_ == nullptr) {
     *height = *pitch = 0.0;
     return false;
   }
-  auto iter = name_camera_status_map_.find(sensor_name_);
-  *height = iter->second.camera_ground_height;
-  *pitch = iter->second.pitch_angle;
+  *height = sensor_status_->camera_ground_height;
+  *pitch = sensor_status_->pitch_angle;
   return true;
 }
 
@@ -159,7 +180,10 @@ void OnlineCalibrationService::Update(CameraFrame *frame) {
     AERROR << "frame is nullptr";
     return;
   }
-  sensor_name_ = frame->data_provider->sensor_name();
+  if (sensor_name_ != frame->data_provider->sensor_name()) {
+    sensor_name_ = frame->data_provider->sensor_name();
+    UpdateSensorStatus();
+  }
   if (sensor_name_ == master_sensor_name_) {
     CalibratorOptions calibrator_options;
     calibrator_options.lane_objects =
@@ -184,11 +208,14 @@ void OnlineCalibrationService::Update(CameraFrame *frame) {
       }
     }
   }
-  auto iter = name_camera_status_map_.find(sensor_name_);
-  AINFO << "camera_ground_height: " << iter->second.camera_ground_height
-        << " meter.";
-  AINFO << "pitch_angle: " << iter->second.pitch_angle * 180.0 / M_PI
-        << " degree.";
+  if (sensor_status_ == nullptr) {
+    AERROR << "No intrinsics of " << sensor_name_;
+  } else {
+    AINFO << "camera_ground_height: " << sensor_status_->camera_ground_height
+          << " meter.";
+    AINFO << "pitch_angle: " << sensor_status_->pitch_angle * 180.0 / M_PI
+          << " degree.";
+  }
   // ACHECK(BuildIndex());
   is_service_ready_ = true;
 }
@@ -53,6 +53,11 @@ class OnlineCalibrationService : public BaseCalibrationService {
   bool QueryPoint3dOnGroundPlane(int x, int y,
                                  Eigen::Vector3d *point3d) const override;
 
+  // @brief query depths on ground plane of a batch of pixel coordinates,
+  // with one lookup of the camera status for the whole batch
+  int QueryDepthsOnGroundPlane(const std::vector<Eigen::Vector2i> &pixels,
+                               std::vector<double> *depths) const override;
+
   // @brief query ground plane in camera frame, parameterized as
   // [n^T, d] with n^T*x+d=0
   bool QueryGroundPlaneInCameraFrame(
@@ -63,17 +68,15 @@ class OnlineCalibrationService : public BaseCalibrationService {
                                               float *pitch) const override;
 
   float QueryCameraToGroundHeight() const override {
-    if (is_service_ready_) {
-      auto iter = name_camera_status_map_.find(sensor_name_);
-      return (iter->second).camera_ground_height;
+    if (is_service_ready_ && sensor_status_ != nullptr) {
+      return sensor_status_->camera_ground_height;
     }
     return -1.f;
   }
 
   float QueryPitchAngle() const override {
-    if (is_service_ready_) {
-      auto iter = name_camera_status_map_.find(sensor_name_);
-      return (iter->second).pitch_angle;
+    if (is_service_ready_ && sensor_status_ != nullptr) {
+      return sensor_status_->pitch_angle;
     }
     return -1.f;
   }
@@ -95,6 +98,14 @@ class OnlineCalibrationService : public BaseCalibrationService {
            name_camera_status_map_.end();
   }
 
+  // look up the status of sensor_name_ once per sensor switch instead of
+  // once per query
+  void UpdateSensorStatus() {
+    auto iter = name_camera_status_map_.find(sensor_name_);
+    sensor_status_ =
+        iter == name_camera_status_map_.end() ? nullptr : &(iter->second);
+  }
+
   bool HasSetGroundPlane() {
     bool has_set_ground_plane =
         name_camera_status_map_.find(sensor_name_) !=
@@ -107,6 +118,8 @@ class OnlineCalibrationService : public BaseCalibrationService {
   std::string sensor_name_ = "";
   std::string master_sensor_name_ = "";
   std::map<std::string, CameraStatus> name_camera_status_map_;
+  // points into name_camera_status_map_, whose nodes stay in place
+  const CameraStatus *sensor_status_ = nullptr;
   std::shared_ptr<BaseCalibrator> calibrator_;
 };
 
@@ -17,6 +17,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "modules/perception/camera/common/camera_frame.h"
 #include "modules/perception/camera/lib/interface/base_init_options.h"
@@ -64,6 +65,25 @@ class BaseCalibrationService {
     return false;
   }
 
+  // @brief query depths on ground plane given pixel coordinates of all the
+  // objects of a frame, depth is 0 where the query fails
+  // @return number of pixels with a valid depth
+  virtual int QueryDepthsOnGroundPlane(
+      const std::vector<Eigen::Vector2i> &pixels,
+      std::vector<double> *depths) const {
+    depths->assign(pixels.size(), 0.0);
+    int nr_valid = 0;
+    for (size_t i = 0; i < pixels.size(); ++i) {
+      if (QueryDepthOnGroundPlane(pixels[i](0), pixels[i](1),
+                                  &(*depths)[i])) {
+        ++nr_valid;
+      } else {
+        (*depths)[i] = 0.0;
+      }
+    }
+    return nr_valid;
+  }
+
   // @brief query ground plane in camera frame, parameterized as
   // [n^T, d] with n^T*x+d=0
   virtual bool QueryGroundPlaneInCameraFrame(
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/perception/base/camera.h"
 #include "modules/perception/camera/common/camera_frame.h"
@@ -53,6 +54,21 @@ class BaseObstacleDetector {
   virtual bool Detect(const ObstacleDetectorOptions &options,
                       CameraFrame *frame) = 0;
 
+  // @brief: detect obstacles from images of several cameras at once.
+  // @param [in]: options
+  // @param [in/out]: frames, time aligned frames of different cameras
+  // detectors running a batched network override it, others detect the
+  // frames one by one.
+  virtual bool DetectBatch(const ObstacleDetectorOptions &options,
+                           const std::vector<CameraFrame *> &frames) {
+    for (auto *frame : frames) {
+      if (!Detect(options, frame)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   virtual std::string Name() const = 0;
 
   BaseObstacleDetector(const BaseObstacleDetector &) = delete;
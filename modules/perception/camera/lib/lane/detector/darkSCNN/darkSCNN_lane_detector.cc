@@ -22,6 +22,7 @@
 
 #include "modules/perception/camera/common/util.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/inference_scheduler.h"
 #include "modules/perception/inference/utils/resize.h"
 
 namespace apollo {
@@ -215,7 +216,9 @@ bool DarkSCNNLaneDetector::Detect(const LaneDetectorOptions &options,
       static_cast<float>(image_mean_[2]), false, static_cast<float>(1.0));
   ADEBUG << "resize gpu finish.";
   cudaDeviceSynchronize();
-  cnnadapter_lane_->Infer();
+  inference::InferenceScheduler::Instance()->Infer(
+      "darkscnn_lane", inference::InferencePriority::LANE,
+      cnnadapter_lane_.get());
   ADEBUG << "infer finish.";
 
   auto elapsed_1 = std::chrono::high_resolution_clock::now() - start;
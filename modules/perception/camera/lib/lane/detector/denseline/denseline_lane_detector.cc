@@ -21,6 +21,7 @@
 #include "cyber/common/file.h"
 #include "modules/perception/camera/common/util.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/inference_scheduler.h"
 #include "modules/perception/inference/utils/resize.h"
 
 namespace apollo {
@@ -195,7 +196,8 @@ bool DenselineLaneDetector::Detect(const LaneDetectorOptions &options,
       static_cast<float>(image_mean_[2]), false, static_cast<float>(1.0));
   AINFO << "resize gpu finish.";
   cudaDeviceSynchronize();
-  rt_net_->Infer();
+  inference::InferenceScheduler::Instance()->Infer(
+      "denseline_lane", inference::InferencePriority::LANE, rt_net_.get());
   AINFO << "infer finish.";
 
   frame->lane_detected_blob = rt_net_->get_blob(net_outputs_[0]);
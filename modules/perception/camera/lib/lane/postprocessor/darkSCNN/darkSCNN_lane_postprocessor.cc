@@ -23,6 +23,7 @@
 
 #include "modules/perception/base/object_types.h"
 #include "modules/perception/camera/common/math_functions.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/utils/timer.h"
 
 namespace apollo {
@@ -113,6 +114,19 @@ bool DarkSCNNLanePostprocessor::Init(
 
   lane_type_num_ = static_cast<int>(spatialLUTind.size());
   AINFO << "lane_type_num_: " << lane_type_num_;
+#if USE_GPU == 1
+  if (FLAGS_enable_gpu_lane_postprocess) {
+    // the rows scanned by Process2D
+    std::vector<int> sample_rows;
+    int y = static_cast<int>(lane_map_height_ * 0.9 - 1);
+    while (y > 0) {
+      sample_rows.push_back(y);
+      y -= (y - 45) * (y - 45) / 6400 + 1;
+    }
+    gpu_postprocessor_.reset(new DarkSCNNLanePostprocessorCuda());
+    gpu_postprocessor_->Init(sample_rows, lane_map_width_);
+  }
+#endif
   return true;
 }
 
@@ -122,95 +136,15 @@ bool DarkSCNNLanePostprocessor::Process2D(
   frame->lane_objects.clear();
   auto start = std::chrono::high_resolution_clock::now();
 
-  cv::Mat lane_map(lane_map_height_, lane_map_width_, CV_32FC1);
-  memcpy(lane_map.data, frame->lane_detected_blob->cpu_data(),
-         lane_map_width_ * lane_map_height_ * sizeof(float));
-
-  // if (options.use_lane_history &&
-  //     (!use_history_ || time_stamp_ > options.timestamp)) {
-  //   InitLaneHistory();
-  // }
-
-  // 1. Sample points on lane_map and project them onto world coordinate
-
-  // TODO(techoe): Should be fixed
-  int y = static_cast<int>(lane_map.rows * 0.9 - 1);
-  // TODO(techoe): Should be fixed
-  int step_y = (y - 40) * (y - 40) / 6400 + 1;
-
-  xy_points.clear();
-  xy_points.resize(lane_type_num_);
-  uv_points.clear();
-  uv_points.resize(lane_type_num_);
-
-  while (y > 0) {
-    for (int x = 1; x < lane_map.cols - 1; ++x) {
-      int value = static_cast<int>(round(lane_map.at<float>(y, x)));
-      // lane on left
-
-      if ((value > 0 && value < 5) || value == 11) {
-        // right edge (inner) of the lane
-        if (value != static_cast<int>(round(lane_map.at<float>(y, x + 1)))) {
-          Eigen::Matrix<float, 3, 1> img_point(
-              static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
-              1.0);
-          Eigen::Matrix<float, 3, 1> xy_p;
-          xy_p = trans_mat_ * img_point;
-          Eigen::Matrix<float, 2, 1> xy_point;
-          Eigen::Matrix<float, 2, 1> uv_point;
-          if (std::fabs(xy_p(2)) < 1e-6) continue;
-          xy_point << xy_p(0) / xy_p(2), xy_p(1) / xy_p(2);
-
-          // Filter out lane line points
-          if (xy_point(0) < 0.0 ||  // This condition is only for front camera
-              xy_point(0) > max_longitudinal_distance_ ||
-              std::abs(xy_point(1)) > 30.0) {
-            continue;
-          }
-          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
-          if (xy_points[value].size() < minNumPoints_ || xy_point(0) < 50.0f ||
-              std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
-            xy_points[value].push_back(xy_point);
-            uv_points[value].push_back(uv_point);
-          }
-        }
-      } else if (value >= 5 && value < lane_type_num_) {
-        // Left edge (inner) of the lane
-        if (value != static_cast<int>(round(lane_map.at<float>(y, x - 1)))) {
-          Eigen::Matrix<float, 3, 1> img_point(
-              static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
-              1.0);
-          Eigen::Matrix<float, 3, 1> xy_p;
-          xy_p = trans_mat_ * img_point;
-          Eigen::Matrix<float, 2, 1> xy_point;
-          Eigen::Matrix<float, 2, 1> uv_point;
-          if (std::fabs(xy_p(2)) < 1e-6) continue;
-          xy_point << xy_p(0) / xy_p(2), xy_p(1) / xy_p(2);
-          // Filter out lane line points
-          if (xy_point(0) < 0.0 ||  // This condition is only for front camera
-              xy_point(0) > max_longitudinal_distance_ ||
-              std::abs(xy_point(1)) > 30.0) {
-            continue;
-          }
-          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
-              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
-          if (xy_points[value].size() < minNumPoints_ || xy_point(0) < 50.0f ||
-              std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
-            xy_points[value].push_back(xy_point);
-            uv_points[value].push_back(uv_point);
-          }
-        } else if (value >= lane_type_num_) {
-          AWARN << "Lane line value shouldn't be equal or more than: "
-                << lane_type_num_;
-        }
-      }
-    }
-    step_y = (y - 45) * (y - 45) / 6400 + 1;
-    y -= step_y;
+#if USE_GPU == 1
+  if (gpu_postprocessor_ != nullptr) {
+    SampleLanePointsGPU(frame);
+  } else {
+    SampleLanePoints(frame);
   }
+#else
+  SampleLanePoints(frame);
+#endif
 
   auto elapsed_1 = std::chrono::high_resolution_clock::now() - start;
   int64_t microseconds_1 =
@@ -404,6 +338,138 @@ bool DarkSCNNLanePostprocessor::Process2D(
 }
 
 // Produce laneline output in camera coordinates (optional)
+void DarkSCNNLanePostprocessor::SampleLanePoints(CameraFrame* frame) {
+  cv::Mat lane_map(lane_map_height_, lane_map_width_, CV_32FC1);
+  memcpy(lane_map.data, frame->lane_detected_blob->cpu_data(),
+         lane_map_width_ * lane_map_height_ * sizeof(float));
+
+  // if (options.use_lane_history &&
+  //     (!use_history_ || time_stamp_ > options.timestamp)) {
+  //   InitLaneHistory();
+  // }
+
+  // 1. Sample points on lane_map and project them onto world coordinate
+
+  // TODO(techoe): Should be fixed
+  int y = static_cast<int>(lane_map.rows * 0.9 - 1);
+  // TODO(techoe): Should be fixed
+  int step_y = (y - 40) * (y - 40) / 6400 + 1;
+
+  xy_points.clear();
+  xy_points.resize(lane_type_num_);
+  uv_points.clear();
+  uv_points.resize(lane_type_num_);
+
+  while (y > 0) {
+    for (int x = 1; x < lane_map.cols - 1; ++x) {
+      int value = static_cast<int>(round(lane_map.at<float>(y, x)));
+      // lane on left
+
+      if ((value > 0 && value < 5) || value == 11) {
+        // right edge (inner) of the lane
+        if (value != static_cast<int>(round(lane_map.at<float>(y, x + 1)))) {
+          Eigen::Matrix<float, 3, 1> img_point(
+              static_cast<float>(x * roi_width_ / lane_map.cols),
+              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
+              1.0);
+          Eigen::Matrix<float, 3, 1> xy_p;
+          xy_p = trans_mat_ * img_point;
+          Eigen::Matrix<float, 2, 1> xy_point;
+          Eigen::Matrix<float, 2, 1> uv_point;
+          if (std::fabs(xy_p(2)) < 1e-6) continue;
+          xy_point << xy_p(0) / xy_p(2), xy_p(1) / xy_p(2);
+
+          // Filter out lane line points
+          if (xy_point(0) < 0.0 ||  // This condition is only for front camera
+              xy_point(0) > max_longitudinal_distance_ ||
+              std::abs(xy_point(1)) > 30.0) {
+            continue;
+          }
+          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
+              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
+          if (xy_points[value].size() < minNumPoints_ || xy_point(0) < 50.0f ||
+              std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
+            xy_points[value].push_back(xy_point);
+            uv_points[value].push_back(uv_point);
+          }
+        }
+      } else if (value >= 5 && value < lane_type_num_) {
+        // Left edge (inner) of the lane
+        if (value != static_cast<int>(round(lane_map.at<float>(y, x - 1)))) {
+          Eigen::Matrix<float, 3, 1> img_point(
+              static_cast<float>(x * roi_width_ / lane_map.cols),
+              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_),
+              1.0);
+          Eigen::Matrix<float, 3, 1> xy_p;
+          xy_p = trans_mat_ * img_point;
+          Eigen::Matrix<float, 2, 1> xy_point;
+          Eigen::Matrix<float, 2, 1> uv_point;
+          if (std::fabs(xy_p(2)) < 1e-6) continue;
+          xy_point << xy_p(0) / xy_p(2), xy_p(1) / xy_p(2);
+          // Filter out lane line points
+          if (xy_point(0) < 0.0 ||  // This condition is only for front camera
+              xy_point(0) > max_longitudinal_distance_ ||
+              std::abs(xy_point(1)) > 30.0) {
+            continue;
+          }
+          uv_point << static_cast<float>(x * roi_width_ / lane_map.cols),
+              static_cast<float>(y * roi_height_ / lane_map.rows + roi_start_);
+          if (xy_points[value].size() < minNumPoints_ || xy_point(0) < 50.0f ||
+              std::fabs(xy_point(1) - xy_points[value].back()(1)) < 1.0f) {
+            xy_points[value].push_back(xy_point);
+            uv_points[value].push_back(uv_point);
+          }
+        } else if (value >= lane_type_num_) {
+          AWARN << "Lane line value shouldn't be equal or more than: "
+                << lane_type_num_;
+        }
+      }
+    }
+    step_y = (y - 45) * (y - 45) / 6400 + 1;
+    y -= step_y;
+  }
+}
+
+#if USE_GPU == 1
+void DarkSCNNLanePostprocessor::SampleLanePointsGPU(CameraFrame* frame) {
+  xy_points.clear();
+  xy_points.resize(lane_type_num_);
+  uv_points.clear();
+  uv_points.resize(lane_type_num_);
+
+  DarkSCNNLanePointParams params;
+  params.lane_map_width = lane_map_width_;
+  params.lane_map_height = lane_map_height_;
+  params.roi_width = roi_width_;
+  params.roi_height = roi_height_;
+  params.roi_start = roi_start_;
+  params.lane_type_num = lane_type_num_;
+  params.max_longitudinal_distance = max_longitudinal_distance_;
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 3; ++c) {
+      params.trans_mat[3 * r + c] = trans_mat_(r, c);
+    }
+  }
+  gpu_postprocessor_->ExtractLanePoints(
+      params, frame->lane_detected_blob->gpu_data(), &gpu_lane_points_);
+
+  // keeping a point depends on the points kept before it on the same lane,
+  // so this stays a sequential pass over the compact points
+  for (const auto& point : gpu_lane_points_) {
+    auto& lane_xy_points = xy_points[point.label];
+    if (lane_xy_points.size() < minNumPoints_ || point.x < 50.0f ||
+        std::fabs(point.y - lane_xy_points.back()(1)) < 1.0f) {
+      Eigen::Matrix<float, 2, 1> xy_point;
+      Eigen::Matrix<float, 2, 1> uv_point;
+      xy_point << point.x, point.y;
+      uv_point << point.u, point.v;
+      lane_xy_points.push_back(xy_point);
+      uv_points[point.label].push_back(uv_point);
+    }
+  }
+}
+#endif
+
 bool DarkSCNNLanePostprocessor::Process3D(
     const LanePostprocessorOptions& options, CameraFrame* frame) {
   ConvertImagePoint2Camera(frame);
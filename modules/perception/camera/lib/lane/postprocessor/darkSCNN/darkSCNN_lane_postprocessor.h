@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,7 @@
 #include "modules/perception/camera/lib/interface/base_lane_postprocessor.h"
 #include "modules/perception/camera/lib/lane/common/common_functions.h"
 #include "modules/perception/camera/lib/lane/common/proto/darkSCNN.pb.h"
+#include "modules/perception/camera/lib/lane/postprocessor/darkSCNN/darkSCNN_lane_postprocessor_cuda.h"
 #include "modules/perception/camera/lib/lane/postprocessor/darkSCNN/proto/darkSCNN_postprocessor.pb.h"
 #include "modules/perception/lib/registerer/registerer.h"
 
@@ -71,6 +73,15 @@ class DarkSCNNLanePostprocessor : public BaseLanePostprocessor {
   void ConvertImagePoint2Camera(CameraFrame* frame);
   // @brief: fit camera lane line using polynomial
   void PolyFitCameraLaneline(CameraFrame* frame);
+  // @brief: sample points on the lane map and project them to the ground
+  void SampleLanePoints(CameraFrame* frame);
+#if USE_GPU == 1
+  // @brief: the point sampling of Process2D on the gpu, only the lane
+  // points are copied back
+  void SampleLanePointsGPU(CameraFrame* frame);
+  std::unique_ptr<DarkSCNNLanePostprocessorCuda> gpu_postprocessor_;
+  std::vector<DarkSCNNLanePoint> gpu_lane_points_;
+#endif
 
  private:
   int input_offset_x_ = 0;
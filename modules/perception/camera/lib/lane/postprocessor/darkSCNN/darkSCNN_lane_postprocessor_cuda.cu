@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/camera/lib/lane/postprocessor/darkSCNN/darkSCNN_lane_postprocessor_cuda.h"
+
+#include <thrust/execution_policy.h>
+#include <thrust/sort.h>
+
+#include "modules/perception/base/common.h"
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+namespace {
+
+struct ScanOrder {
+  __host__ __device__ bool operator()(const DarkSCNNLanePoint& a,
+                                      const DarkSCNNLanePoint& b) const {
+    return a.row < b.row || (a.row == b.row && a.col < b.col);
+  }
+};
+
+// the same edge test and projection as DarkSCNNLanePostprocessor::Process2D
+__global__ void ExtractKernel(const DarkSCNNLanePointParams params,
+                              const float* lane_map, const int* sample_rows,
+                              const int num_sample_rows,
+                              DarkSCNNLanePoint* points, int* num_points) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x + 1;
+  const int row = blockIdx.y;
+  if (x >= params.lane_map_width - 1 || row >= num_sample_rows) {
+    return;
+  }
+  const int y = sample_rows[row];
+  const float* line = lane_map + y * params.lane_map_width;
+  const int value = static_cast<int>(roundf(line[x]));
+  int neighbour = 0;
+  if ((value > 0 && value < 5) || value == 11) {
+    // right edge (inner) of the lane
+    neighbour = static_cast<int>(roundf(line[x + 1]));
+  } else if (value >= 5 && value < params.lane_type_num) {
+    // left edge (inner) of the lane
+    neighbour = static_cast<int>(roundf(line[x - 1]));
+  } else {
+    return;
+  }
+  if (value == neighbour) {
+    return;
+  }
+
+  const float u =
+      static_cast<float>(x * params.roi_width / params.lane_map_width);
+  const float v = static_cast<float>(
+      y * params.roi_height / params.lane_map_height + params.roi_start);
+  const float* m = params.trans_mat;
+  const float w = m[6] * u + m[7] * v + m[8];
+  if (fabsf(w) < 1e-6f) {
+    return;
+  }
+  const float ground_x = (m[0] * u + m[1] * v + m[2]) / w;
+  const float ground_y = (m[3] * u + m[4] * v + m[5]) / w;
+  // this condition is only for front camera
+  if (ground_x < 0.0f || ground_x > params.max_longitudinal_distance ||
+      fabsf(ground_y) > 30.0f) {
+    return;
+  }
+  const int index = atomicAdd(num_points, 1);
+  DarkSCNNLanePoint& point = points[index];
+  point.row = row;
+  point.col = x;
+  point.label = value;
+  point.x = ground_x;
+  point.y = ground_y;
+  point.u = u;
+  point.v = v;
+}
+
+}  // namespace
+
+DarkSCNNLanePostprocessorCuda::~DarkSCNNLanePostprocessorCuda() {
+  ReleaseGPUMemory();
+}
+
+void DarkSCNNLanePostprocessorCuda::ReleaseGPUMemory() {
+  BASE_CUDA_CHECK(cudaFree(dev_sample_rows_));
+  BASE_CUDA_CHECK(cudaFree(dev_points_));
+  BASE_CUDA_CHECK(cudaFree(dev_num_points_));
+  dev_sample_rows_ = nullptr;
+  dev_points_ = nullptr;
+  dev_num_points_ = nullptr;
+  num_sample_rows_ = 0;
+  capacity_ = 0;
+}
+
+void DarkSCNNLanePostprocessorCuda::Init(const std::vector<int>& sample_rows,
+                                         const int lane_map_width) {
+  ReleaseGPUMemory();
+  num_sample_rows_ = static_cast<int>(sample_rows.size());
+  // at most every pixel of the sampled rows is an edge
+  capacity_ = num_sample_rows_ * lane_map_width;
+  if (capacity_ <= 0) {
+    return;
+  }
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_sample_rows_),
+                             num_sample_rows_ * sizeof(int)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_points_),
+                             capacity_ * sizeof(DarkSCNNLanePoint)));
+  BASE_CUDA_CHECK(
+      cudaMalloc(reinterpret_cast<void**>(&dev_num_points_), sizeof(int)));
+  BASE_CUDA_CHECK(cudaMemcpy(dev_sample_rows_, sample_rows.data(),
+                             num_sample_rows_ * sizeof(int),
+                             cudaMemcpyHostToDevice));
+}
+
+void DarkSCNNLanePostprocessorCuda::ExtractLanePoints(
+    const DarkSCNNLanePointParams& params, const float* dev_lane_map,
+    std::vector<DarkSCNNLanePoint>* points) {
+  points->clear();
+  if (capacity_ <= 0 || dev_lane_map == nullptr) {
+    return;
+  }
+  BASE_CUDA_CHECK(cudaMemset(dev_num_points_, 0, sizeof(int)));
+  const dim3 blocks((params.lane_map_width + kNumThreads - 1) / kNumThreads,
+                    num_sample_rows_);
+  ExtractKernel<<<blocks, kNumThreads>>>(params, dev_lane_map,
+                                         dev_sample_rows_, num_sample_rows_,
+                                         dev_points_, dev_num_points_);
+  int num_points = 0;
+  BASE_CUDA_CHECK(cudaMemcpy(&num_points, dev_num_points_, sizeof(int),
+                             cudaMemcpyDeviceToHost));
+  if (num_points == 0) {
+    return;
+  }
+  // the cpu keeps a point depending on the previous points of its lane, so
+  // the points go back in scan order
+  thrust::sort(thrust::device, dev_points_, dev_points_ + num_points,
+               ScanOrder());
+  points->resize(num_points);
+  BASE_CUDA_CHECK(cudaMemcpy(points->data(), dev_points_,
+                             num_points * sizeof(DarkSCNNLanePoint),
+                             cudaMemcpyDeviceToHost));
+}
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
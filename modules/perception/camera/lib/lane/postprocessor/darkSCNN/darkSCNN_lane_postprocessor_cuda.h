@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+namespace apollo {
+namespace perception {
+namespace camera {
+
+struct DarkSCNNLanePointParams {
+  int lane_map_width = 640;
+  int lane_map_height = 480;
+  int roi_width = 1920;
+  int roi_height = 768;
+  int roi_start = 312;
+  int lane_type_num = 13;
+  float max_longitudinal_distance = 300.0f;
+  // row major image to car homography
+  float trans_mat[9] = {0.0f};
+};
+
+// an inner lane edge pixel of a sampled row, projected to the ground
+struct DarkSCNNLanePoint {
+  int row;  // index in the sampled rows
+  int col;
+  int label;
+  float x;
+  float y;
+  float u;
+  float v;
+};
+
+class DarkSCNNLanePostprocessorCuda {
+ public:
+  DarkSCNNLanePostprocessorCuda() = default;
+
+  ~DarkSCNNLanePostprocessorCuda();
+
+  // @brief: set the lane map rows to sample, in sampling order
+  void Init(const std::vector<int>& sample_rows, const int lane_map_width);
+
+  // @brief: finds the inner lane edges on the sampled rows of the lane map
+  // on the gpu and projects them to the ground, only these points are
+  // copied back
+  // @param [in]: params
+  // @param [in]: dev_lane_map, lane labels on the device
+  // @param [out]: points, in the order of the cpu scan, that is by sampled
+  // row and then by column
+  void ExtractLanePoints(const DarkSCNNLanePointParams& params,
+                         const float* dev_lane_map,
+                         std::vector<DarkSCNNLanePoint>* points);
+
+ private:
+  void ReleaseGPUMemory();
+
+  int* dev_sample_rows_ = nullptr;
+  DarkSCNNLanePoint* dev_points_ = nullptr;
+  int* dev_num_points_ = nullptr;
+  int num_sample_rows_ = 0;
+  int capacity_ = 0;
+
+  static constexpr int kNumThreads = 128;
+};  // class DarkSCNNLanePostprocessorCuda
+
+}  // namespace camera
+}  // namespace perception
+}  // namespace apollo
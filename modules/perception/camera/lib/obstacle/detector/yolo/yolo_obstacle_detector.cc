@@ -15,13 +15,17 @@
  *****************************************************************************/
 #include "modules/perception/camera/lib/obstacle/detector/yolo/yolo_obstacle_detector.h"
 
+#include <algorithm>
+
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 
 #include "modules/common/util/perf_util.h"
 #include "modules/perception/base/common.h"
 #include "modules/perception/camera/common/timer.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/inference_scheduler.h"
 #include "modules/perception/inference/utils/resize.h"
 
 namespace apollo {
@@ -30,6 +34,45 @@ namespace camera {
 
 using cyber::common::GetAbsolutePath;
 
+namespace {
+
+using BlobPtr = std::shared_ptr<base::Blob<float>>;
+
+// yolo blobs written by the network, the others are shared by all images
+constexpr BlobPtr YoloBlobs::*kNetOutputBlobs[] = {
+    &YoloBlobs::det1_loc_blob,      &YoloBlobs::det1_obj_blob,
+    &YoloBlobs::det1_cls_blob,      &YoloBlobs::det1_ori_conf_blob,
+    &YoloBlobs::det1_ori_blob,      &YoloBlobs::det1_dim_blob,
+    &YoloBlobs::det2_loc_blob,      &YoloBlobs::det2_obj_blob,
+    &YoloBlobs::det2_cls_blob,      &YoloBlobs::det2_ori_conf_blob,
+    &YoloBlobs::det2_ori_blob,      &YoloBlobs::det2_dim_blob,
+    &YoloBlobs::det3_loc_blob,      &YoloBlobs::det3_obj_blob,
+    &YoloBlobs::det3_cls_blob,      &YoloBlobs::det3_ori_conf_blob,
+    &YoloBlobs::det3_ori_blob,      &YoloBlobs::det3_dim_blob,
+    &YoloBlobs::lof_blob,           &YoloBlobs::lor_blob,
+    &YoloBlobs::brvis_blob,         &YoloBlobs::brswt_blob,
+    &YoloBlobs::ltvis_blob,         &YoloBlobs::ltswt_blob,
+    &YoloBlobs::rtvis_blob,         &YoloBlobs::rtswt_blob,
+    &YoloBlobs::area_id_blob,       &YoloBlobs::visible_ratio_blob,
+    &YoloBlobs::cut_off_ratio_blob,
+};
+
+// points view at the index-th image of the batched blob
+void SetBatchView(const BlobPtr &blob, int index, BlobPtr *view) {
+  if (blob == nullptr) {
+    view->reset();
+    return;
+  }
+  if (*view == nullptr) {
+    std::vector<int> shape = blob->shape();
+    shape[0] = 1;
+    view->reset(new base::Blob<float>(shape));
+  }
+  (*view)->set_gpu_data(blob->mutable_gpu_data() + blob->offset(index));
+}
+
+}  // namespace
+
 void YoloObstacleDetector::LoadInputShape(const yolo::ModelParam &model_param) {
   float offset_ratio = model_param.offset_ratio();
   float cropped_ratio = model_param.cropped_ratio();
@@ -133,7 +176,7 @@ bool YoloObstacleDetector::InitNet(const yolo::YoloParam &yolo_param,
     return false;
   }
   inference_->set_gpu_id(gpu_id_);
-  std::vector<int> shape = {1, height_, width_, 3};
+  std::vector<int> shape = {batch_size_, height_, width_, 3};
   std::map<std::string, std::vector<int>> shape_map{
       {net_param.input_blob(), shape}};
 
@@ -248,8 +291,31 @@ void YoloObstacleDetector::InitYoloBlob(const yolo::NetworkParam &net_param) {
       inference_->get_blob(yolo_param_.net_param().cut_off_ratio_blob());
 }
 
+void YoloObstacleDetector::InitBatchBlobs() {
+  batch_slots_.resize(batch_size_);
+  for (auto &slot : batch_slots_) {
+    slot.yolo_blobs = yolo_blobs_;
+    for (auto blob : kNetOutputBlobs) {
+      slot.yolo_blobs.*blob = nullptr;
+    }
+  }
+  UpdateBatchBlobs();
+}
+
+void YoloObstacleDetector::UpdateBatchBlobs() {
+  auto feat_blob = inference_->get_blob(yolo_param_.net_param().feat_blob());
+  for (int i = 0; i < batch_size_; ++i) {
+    auto &slot = batch_slots_[i];
+    for (auto blob : kNetOutputBlobs) {
+      SetBatchView(yolo_blobs_.*blob, i, &(slot.yolo_blobs.*blob));
+    }
+    SetBatchView(feat_blob, i, &slot.feat_blob);
+  }
+}
+
 bool YoloObstacleDetector::Init(const ObstacleDetectorInitOptions &options) {
   gpu_id_ = options.gpu_id;
+  batch_size_ = std::max(1, FLAGS_camera_obstacle_detection_batch_size);
   BASE_CUDA_CHECK(cudaSetDevice(gpu_id_));
   BASE_CUDA_CHECK(cudaStreamCreate(&stream_));
 
@@ -288,6 +354,9 @@ bool YoloObstacleDetector::Init(const ObstacleDetectorInitOptions &options) {
     return false;
   }
   InitYoloBlob(yolo_param_.net_param());
+  if (batch_size_ > 1) {
+    InitBatchBlobs();
+  }
   if (!InitFeatureExtractor(model_root)) {
     return false;
   }
@@ -295,20 +364,40 @@ bool YoloObstacleDetector::Init(const ObstacleDetectorInitOptions &options) {
 }
 
 bool YoloObstacleDetector::InitFeatureExtractor(const std::string &root_dir) {
+  auto feat_blob_name = yolo_param_.net_param().feat_blob();
+  feature_extractor_ =
+      CreateFeatureExtractor(root_dir, inference_->get_blob(feat_blob_name));
+  if (feature_extractor_ == nullptr) {
+    return false;
+  }
+  // each image of the batch rois its own slice of the feature blob
+  for (auto &slot : batch_slots_) {
+    slot.feature_extractor = CreateFeatureExtractor(root_dir, slot.feat_blob);
+    if (slot.feature_extractor == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<BaseFeatureExtractor>
+YoloObstacleDetector::CreateFeatureExtractor(
+    const std::string &root_dir,
+    const std::shared_ptr<base::Blob<float>> &feat_blob) {
   FeatureExtractorInitOptions feat_options;
   feat_options.conf_file = yolo_param_.model_param().feature_file();
   feat_options.root_dir = root_dir;
   feat_options.gpu_id = gpu_id_;
-  auto feat_blob_name = yolo_param_.net_param().feat_blob();
-  feat_options.feat_blob = inference_->get_blob(feat_blob_name);
+  feat_options.feat_blob = feat_blob;
   feat_options.input_height = height_;
   feat_options.input_width = width_;
-  feature_extractor_.reset(BaseFeatureExtractorRegisterer::GetInstanceByName(
-      "TrackingFeatureExtractor"));
-  if (!feature_extractor_->Init(feat_options)) {
-    return false;
+  std::shared_ptr<BaseFeatureExtractor> feature_extractor(
+      BaseFeatureExtractorRegisterer::GetInstanceByName(
+          "TrackingFeatureExtractor"));
+  if (!feature_extractor->Init(feat_options)) {
+    return nullptr;
   }
-  return true;
+  return feature_extractor;
 }
 
 bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
@@ -316,7 +405,25 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
   if (frame == nullptr) {
     return false;
   }
+  return DetectImages({frame});
+}
 
+bool YoloObstacleDetector::DetectBatch(
+    const ObstacleDetectorOptions &options,
+    const std::vector<CameraFrame *> &frames) {
+  const size_t batch_size = static_cast<size_t>(batch_size_);
+  for (size_t begin = 0; begin < frames.size(); begin += batch_size) {
+    size_t end = std::min(frames.size(), begin + batch_size);
+    if (!DetectImages(std::vector<CameraFrame *>(frames.begin() + begin,
+                                                 frames.begin() + end))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool YoloObstacleDetector::DetectImages(
+    const std::vector<CameraFrame *> &frames) {
   Timer timer;
   if (cudaSetDevice(gpu_id_) != cudaSuccess) {
     AERROR << "Failed to set device to " << gpu_id_;
@@ -331,17 +438,52 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
       0, offset_y_, static_cast<int>(base_camera_model_->get_width()),
       static_cast<int>(base_camera_model_->get_height()) - offset_y_);
   image_options.do_crop = true;
-  frame->data_provider->GetImage(image_options, image_.get());
-  AINFO << "GetImageBlob: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  inference::ResizeGPU(*image_, input_blob, frame->data_provider->src_width(),
-                       0);
-  AINFO << "Resize: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
+  for (size_t i = 0; i < frames.size(); ++i) {
+    CameraFrame *frame = frames[i];
+    if (frame == nullptr) {
+      return false;
+    }
+    // the crop and the input shape come from the init camera, a detector
+    // shared by several cameras needs images of the same size
+    if (batch_size_ > 1 &&
+        (frame->data_provider->src_width() !=
+             static_cast<int>(base_camera_model_->get_width()) ||
+         frame->data_provider->src_height() !=
+             static_cast<int>(base_camera_model_->get_height()))) {
+      AERROR << "Image size of " << frame->data_provider->sensor_name()
+             << " does not match the detector input.";
+      return false;
+    }
+    frame->data_provider->GetImage(image_options, image_.get());
+    inference::ResizeGPU(*image_, input_blob, frame->data_provider->src_width(),
+                         static_cast<int>(i));
+  }
+  AINFO << "GetImageBlob and Resize: "
+        << static_cast<double>(timer.Toc()) * 0.001 << "ms";
 
   /////////////////////////// detection part ///////////////////////////
-  inference_->Infer();
+  inference::InferenceScheduler::Instance()->Infer(
+      "yolo_obstacle", inference::InferencePriority::OBSTACLE,
+      inference_.get());
   AINFO << "Network Forward: " << static_cast<double>(timer.Toc()) * 0.001
         << "ms";
-  get_objects_gpu(yolo_blobs_, stream_, types_, nms_, yolo_param_.model_param(),
+  if (batch_size_ == 1) {
+    PostProcess(yolo_blobs_, feature_extractor_.get(), frames[0]);
+    return true;
+  }
+  UpdateBatchBlobs();
+  for (size_t i = 0; i < frames.size(); ++i) {
+    PostProcess(batch_slots_[i].yolo_blobs,
+                batch_slots_[i].feature_extractor.get(), frames[i]);
+  }
+  return true;
+}
+
+void YoloObstacleDetector::PostProcess(const YoloBlobs &yolo_blobs,
+                                       BaseFeatureExtractor *feature_extractor,
+                                       CameraFrame *frame) {
+  Timer timer;
+  get_objects_gpu(yolo_blobs, stream_, types_, nms_, yolo_param_.model_param(),
                   light_vis_conf_threshold_, light_swt_conf_threshold_,
                   overlapped_.get(), idx_sm_.get(), &(frame->detected_objects));
 
@@ -350,7 +492,7 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
   FeatureExtractorOptions feat_options;
   feat_options.normalized = true;
   AINFO << "Post1: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-  feature_extractor_->Extract(feat_options, frame);
+  feature_extractor->Extract(feat_options, frame);
   AINFO << "Extract: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
   recover_bbox(frame->data_provider->src_width(),
                frame->data_provider->src_height() - offset_y_, offset_y_,
@@ -379,8 +521,6 @@ bool YoloObstacleDetector::Detect(const ObstacleDetectorOptions &options,
     }
   }
   AINFO << "Post2: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
-
-  return true;
 }
 
 REGISTER_OBSTACLE_DETECTOR(YoloObstacleDetector);
@@ -50,6 +50,11 @@ class YoloObstacleDetector : public BaseObstacleDetector {
 
   bool Detect(const ObstacleDetectorOptions &options,
               CameraFrame *frame) override;
+  // @brief: frames beyond camera_obstacle_detection_batch_size are split
+  // into several network forwards, all frames need the image size of the
+  // camera the detector is initialized with.
+  bool DetectBatch(const ObstacleDetectorOptions &options,
+                   const std::vector<CameraFrame *> &frames) override;
   std::string Name() const override { return "YoloObstacleDetector"; }
 
  protected:
@@ -59,8 +64,25 @@ class YoloObstacleDetector : public BaseObstacleDetector {
                const std::string &model_root);
   void InitYoloBlob(const yolo::NetworkParam &net_param);
   bool InitFeatureExtractor(const std::string &root_dir);
+  std::shared_ptr<BaseFeatureExtractor> CreateFeatureExtractor(
+      const std::string &root_dir,
+      const std::shared_ptr<base::Blob<float>> &feat_blob);
+  void InitBatchBlobs();
+  void UpdateBatchBlobs();
+  bool DetectImages(const std::vector<CameraFrame *> &frames);
+  void PostProcess(const YoloBlobs &yolo_blobs,
+                   BaseFeatureExtractor *feature_extractor,
+                   CameraFrame *frame);
 
  private:
+  // network outputs of one image of the batch, the blobs point into the
+  // batched outputs and are re-pointed after every forward
+  struct BatchSlot {
+    YoloBlobs yolo_blobs;
+    std::shared_ptr<base::Blob<float>> feat_blob = nullptr;
+    std::shared_ptr<BaseFeatureExtractor> feature_extractor = nullptr;
+  };
+
   std::shared_ptr<BaseFeatureExtractor> feature_extractor_;
   yolo::YoloParam yolo_param_;
   std::shared_ptr<base::BaseCameraModel> base_camera_model_ = nullptr;
@@ -76,6 +98,7 @@ class YoloObstacleDetector : public BaseObstacleDetector {
   int offset_y_ = 0;
   int gpu_id_ = 0;
   int obj_k_ = kMaxObjSize;
+  int batch_size_ = 1;
 
   int ori_cycle_ = 1;
   float confidence_threshold_ = 0.f;
@@ -83,6 +106,7 @@ class YoloObstacleDetector : public BaseObstacleDetector {
   float light_swt_conf_threshold_ = 0.f;
   MinDims min_dims_;
   YoloBlobs yolo_blobs_;
+  std::vector<BatchSlot> batch_slots_;
 
   std::shared_ptr<base::Image8U> image_ = nullptr;
   std::shared_ptr<base::Blob<bool>> overlapped_ = nullptr;
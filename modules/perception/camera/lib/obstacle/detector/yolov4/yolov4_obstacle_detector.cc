@@ -22,6 +22,7 @@
 #include "modules/perception/base/common.h"
 #include "modules/perception/camera/common/timer.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/inference_scheduler.h"
 #include "modules/perception/inference/utils/resize.h"
 
 namespace apollo {
@@ -339,7 +340,9 @@ bool Yolov4ObstacleDetector::Detect(const ObstacleDetectorOptions &options,
   AINFO << "Resize: " << static_cast<double>(timer.Toc()) * 0.001 << "ms";
 
   /////////////////////////// detection part ///////////////////////////
-  inference_->Infer();
+  inference::InferenceScheduler::Instance()->Infer(
+      "yolov4_obstacle", inference::InferencePriority::OBSTACLE,
+      inference_.get());
   AINFO << "Network Forward: " << static_cast<double>(timer.Toc()) * 0.001
         << "ms";
   get_objects_gpu(yolo_blobs_, stream_, types_, nms_, yolo_param_.model_param(),
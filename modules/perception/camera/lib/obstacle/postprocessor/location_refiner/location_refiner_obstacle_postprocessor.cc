@@ -77,6 +77,8 @@ bool LocationRefinerObstaclePostprocessor::Process(
   const int width_image = frame->data_provider->src_width();
   const int height_image = frame->data_provider->src_height();
   postprocessor_->Init(k_mat, width_image, height_image);
+  // once per camera and frame instead of once per object
+  const Eigen::Matrix3f camera_k_inverse = camera_k_matrix.inverse();
   ObjPostProcessorOptions obj_postprocessor_options;
 
   int nr_valid_obj = 0;
@@ -109,7 +111,7 @@ bool LocationRefinerObstaclePostprocessor::Process(
     Eigen::Vector3f image_point_low_center(box_cent_x, bbox2d[3], 1);
     Eigen::Vector3f point_in_camera =
         static_cast<Eigen::Matrix<float, 3, 1, 0, 3, 1>>(
-            camera_k_matrix.inverse() * image_point_low_center);
+            camera_k_inverse * image_point_low_center);
     float theta_ray =
         static_cast<float>(atan2(point_in_camera.x(), point_in_camera.z()));
     float rotation_y =
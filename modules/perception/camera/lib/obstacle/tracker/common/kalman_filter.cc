@@ -19,6 +19,7 @@
 
 #include "Eigen/LU"
 #include "cyber/common/log.h"
+#include "modules/common/math/kalman_filter_models.h"
 
 namespace apollo {
 namespace perception {
@@ -41,8 +42,8 @@ void KalmanFilterConstVelocity::Init(Eigen::VectorXd x) {
 
 void KalmanFilterConstVelocity::Predict(float delta_t) {
   if (inited_) {
-    state_transition_matrix_(0, 2) = delta_t;
-    state_transition_matrix_(1, 3) = delta_t;
+    common::math::ConstantVelocityTransition(static_cast<double>(delta_t),
+                                             &state_transition_matrix_);
     state_ = state_transition_matrix_ * state_;
     predict_state_ = state_;
     variance_ = state_transition_matrix_ * variance_ *
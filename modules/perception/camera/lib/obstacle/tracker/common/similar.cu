@@ -16,6 +16,7 @@
 #include "modules/perception/camera/lib/obstacle/tracker/common/similar.h"
 
 #include <cblas.h>
+#include <cstring>
 #include <memory>
 
 #include "cyber/common/log.h"
@@ -50,6 +51,66 @@ bool GPUSimilar::Calc(CameraFrame *frame1, CameraFrame *frame2,
   return true;
 }
 
+bool GPUSimilar::Calc(const std::vector<CameraFrame *> &frames,
+                      CameraFrame *frame,
+                      const std::vector<base::Blob<float> *> &sims) {
+  int m = static_cast<int>(frame->detected_objects.size());
+  if (m == 0 || frame->track_feature_blob == nullptr) {
+    return false;
+  }
+  int dim = frame->track_feature_blob->count(1);
+
+  int total = 0;
+  for (auto *frame1 : frames) {
+    if (frame1->track_feature_blob == nullptr ||
+        frame1->detected_objects.empty()) {
+      continue;
+    }
+    assert(dim == frame1->track_feature_blob->count(1));
+    total += static_cast<int>(frame1->detected_objects.size());
+  }
+  if (total == 0) {
+    return false;
+  }
+
+  packed_features_.Reshape({total, dim});
+  float *packed = packed_features_.mutable_gpu_data();
+  int row = 0;
+  for (auto *frame1 : frames) {
+    if (frame1->track_feature_blob == nullptr ||
+        frame1->detected_objects.empty()) {
+      continue;
+    }
+    int n = static_cast<int>(frame1->detected_objects.size());
+    BASE_CUDA_CHECK(cudaMemcpy(packed + row * dim,
+                               frame1->track_feature_blob->gpu_data(),
+                               n * dim * sizeof(float),
+                               cudaMemcpyDeviceToDevice));
+    row += n;
+  }
+
+  packed_sim_.Reshape({total, m});
+  inference::GPUGemmFloat(CblasNoTrans, CblasTrans, total, m, dim, 1.0, packed,
+                          frame->track_feature_blob->gpu_data(), 0.0,
+                          packed_sim_.mutable_gpu_data());
+  const float *packed_sim = packed_sim_.cpu_data();
+
+  row = 0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    auto *frame1 = frames[i];
+    if (frame1->track_feature_blob == nullptr ||
+        frame1->detected_objects.empty()) {
+      continue;
+    }
+    int n = static_cast<int>(frame1->detected_objects.size());
+    sims[i]->Reshape({n, m});
+    memcpy(sims[i]->mutable_cpu_data(), packed_sim + row * m,
+           n * m * sizeof(float));
+    row += n;
+  }
+  return true;
+}
+
 }  // namespace camera
 }  // namespace perception
 }  // namespace apollo
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #pragma once
 
+#include <vector>
+
 #include "modules/perception/camera/common/camera_frame.h"
 
 namespace apollo {
@@ -39,6 +41,17 @@ class GPUSimilar : public BaseSimilar {
  public:
   bool Calc(CameraFrame *frame1, CameraFrame *frame2,
             base::Blob<float> *sim) override;
+
+  // Similarities of the objects of each of frames to the objects of frame, the
+  // features of frames are packed into one matrix so that a single product
+  // and a single download serve them all. sims[i] gets the matrix of
+  // frames[i] on the cpu, frames without objects are left out.
+  bool Calc(const std::vector<CameraFrame *> &frames, CameraFrame *frame,
+            const std::vector<base::Blob<float> *> &sims);
+
+ private:
+  base::Blob<float> packed_features_;
+  base::Blob<float> packed_sim_;
 };
 }  // namespace camera
 }  // namespace perception
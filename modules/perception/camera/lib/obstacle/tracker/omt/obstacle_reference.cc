@@ -148,7 +148,23 @@ void ObstacleReference::CorrectSize(CameraFrame *frame) {
   const std::vector<TemplateMap> &kTemplateHWL =
       object_template_manager_->TemplateHWL();
 
-  for (auto &obj : frame->detected_objects) {
+  // depths of the bottom centers on the calibrated ground, queried for all
+  // the objects of the frame at once
+  std::vector<double> calib_depths;
+  if (frame->calibration_service != nullptr) {
+    std::vector<Eigen::Vector2i> bottom_centers;
+    bottom_centers.reserve(frame->detected_objects.size());
+    for (const auto &obj : frame->detected_objects) {
+      const auto &box = obj->camera_supplement.box;
+      bottom_centers.emplace_back(static_cast<int>(box.Center().x),
+                                  static_cast<int>(box.ymax));
+    }
+    frame->calibration_service->QueryDepthsOnGroundPlane(bottom_centers,
+                                                         &calib_depths);
+  }
+
+  for (size_t obj_id = 0; obj_id < frame->detected_objects.size(); ++obj_id) {
+    auto &obj = frame->detected_objects[obj_id];
     float volume_object = obj->size[0] * obj->size[1] * obj->size[2];
     ADEBUG << "Det " << frame->frame_id << " (" << obj->id << ") "
            << "ori size:" << obj->size.transpose() << " "
@@ -205,11 +221,9 @@ void ObstacleReference::CorrectSize(CameraFrame *frame) {
 
       // h from calibration service
       if (frame->calibration_service != nullptr) {
-        double z_calib = 0.0;
-        bool success = frame->calibration_service->QueryDepthOnGroundPlane(
-            static_cast<int>(supplement.box.Center().x),
-            static_cast<int>(supplement.box.ymax), &z_calib);
-        if (success) {
+        double z_calib = calib_depths[obj_id];
+        // valid depths on the ground are positive
+        if (z_calib > 0.0) {
           z_calib = std::max(z_calib, z_obj);
           float k2 = static_cast<float>(z_calib / frame->camera_k_matrix(1, 1));
           float h = k2 * (supplement.box.ymax - supplement.box.ymin);
@@ -219,8 +233,6 @@ void ObstacleReference::CorrectSize(CameraFrame *frame) {
         } else {
           height.push_back(kMaxTemplateHWL.at(obj->sub_type).at(0));
         }
-        Eigen::Vector4d plane_param;
-        frame->calibration_service->QueryGroundPlaneInCameraFrame(&plane_param);
       }
 
       // h from history reference vote
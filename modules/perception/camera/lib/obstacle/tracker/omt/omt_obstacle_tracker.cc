@@ -24,6 +24,7 @@
 #include "modules/perception/camera/common/math_functions.h"
 #include "modules/perception/camera/common/util.h"
 #include "modules/perception/common/geometry/common.h"
+#include "modules/perception/common/perception_gflags.h"
 
 namespace apollo {
 namespace perception {
@@ -167,13 +168,30 @@ bool OMTObstacleTracker::CombineDuplicateTargets() {
 void OMTObstacleTracker::GenerateHypothesis(const TrackObjectPtrs &objects) {
   std::vector<Hypothesis> score_list;
   Hypothesis hypo;
+  std::vector<const float *> rows;
   for (size_t i = 0; i < targets_.size(); ++i) {
     ADEBUG << "Target " << targets_[i].id;
+    const PatchIndicator *rows_indicator = nullptr;
     for (size_t j = 0; j < objects.size(); ++j) {
       hypo.target = static_cast<int>(i);
       hypo.object = static_cast<int>(j);
-      float sa = ScoreAppearance(targets_[i], objects[j]);
       float sm = ScoreMotion(targets_[i], objects[j]);
+      // 95.44% area is range [mu - sigma*2, mu + sigma*2]
+      // don't match if motion is beyond the range
+      if (sm < 0.045) {
+        continue;
+      }
+      // the rows only change with the frame and sensor of the object, which
+      // all objects of one frame share
+      const PatchIndicator &indicator = objects[j]->indicator;
+      if (rows_indicator == nullptr ||
+          rows_indicator->frame_id != indicator.frame_id ||
+          rows_indicator->sensor_name != indicator.sensor_name) {
+        GetAppearanceRows(targets_[i], indicator.sensor_name,
+                          indicator.frame_id, &rows);
+        rows_indicator = &indicator;
+      }
+      float sa = ScoreAppearance(rows, indicator.patch_id);
       float ss = ScoreShape(targets_[i], objects[j]);
       float so = ScoreOverlap(targets_[i], objects[j]);
       if (sa == 0) {
@@ -193,9 +211,7 @@ void OMTObstacleTracker::GenerateHypothesis(const TrackObjectPtrs &objects) {
              << ") sa:" << sa << " sm: " << sm << " ss: " << ss << " so: " << so
              << " score: " << hypo.score;
 
-      // 95.44% area is range [mu - sigma*2, mu + sigma*2]
-      // don't match if motion is beyond the range
-      if (sm < 0.045 || hypo.score < omt_param_.target_thresh()) {
+      if (hypo.score < omt_param_.target_thresh()) {
         continue;
       }
       score_list.push_back(hypo);
@@ -240,23 +256,27 @@ float OMTObstacleTracker::ScoreShape(const Target &target,
   return -std::abs(s);
 }
 
-float OMTObstacleTracker::ScoreAppearance(const Target &target,
-                                          TrackObjectPtr track_obj) {
-  float energy = 0.0f;
-  int count = 0;
-  auto sensor_name = track_obj->indicator.sensor_name;
+void OMTObstacleTracker::GetAppearanceRows(
+    const Target &target, const std::string &sensor_name, int frame_id,
+    std::vector<const float *> *rows) const {
+  rows->clear();
   for (int i = target.Size() - 1; i >= 0; --i) {
-    if (target[i]->indicator.sensor_name != sensor_name) {
+    const PatchIndicator &p1 = target[i]->indicator;
+    if (p1.sensor_name != sensor_name) {
       continue;
     }
-    PatchIndicator p1 = target[i]->indicator;
-    PatchIndicator p2 = track_obj->indicator;
-
-    energy += similar_map_.sim(p1, p2);
-    count += 1;
+    auto blob = similar_map_.get(p1.frame_id, frame_id);
+    rows->push_back(blob->cpu_data() + blob->offset(p1.patch_id));
   }
+}
 
-  return energy / (0.1f + static_cast<float>(count) * 0.9f);
+float OMTObstacleTracker::ScoreAppearance(
+    const std::vector<const float *> &rows, int patch_id) {
+  float energy = 0.0f;
+  for (const float *row : rows) {
+    energy += row[patch_id];
+  }
+  return energy / (0.1f + static_cast<float>(rows.size()) * 0.9f);
 }
 
 // [new]
@@ -351,11 +371,23 @@ bool OMTObstacleTracker::Associate2D(const ObstacleTrackerOptions &options,
                                      CameraFrame *frame) {
   inference::CudaUtil::set_device_id(gpu_id_);
   frame_list_.Add(frame);
-  for (int t = 0; t < frame_list_.Size(); t++) {
-    int frame1 = frame_list_[t]->frame_id;
+  if (FLAGS_enable_omt_batched_similarity) {
+    std::vector<CameraFrame *> frames;
+    std::vector<base::Blob<float> *> sims;
     int frame2 = frame_list_[-1]->frame_id;
-    similar_->Calc(frame_list_[frame1], frame_list_[frame2],
-                   similar_map_.get(frame1, frame2).get());
+    for (int t = 0; t < frame_list_.Size(); t++) {
+      int frame1 = frame_list_[t]->frame_id;
+      frames.push_back(frame_list_[frame1]);
+      sims.push_back(similar_map_.get(frame1, frame2).get());
+    }
+    similar_->Calc(frames, frame_list_[frame2], sims);
+  } else {
+    for (int t = 0; t < frame_list_.Size(); t++) {
+      int frame1 = frame_list_[t]->frame_id;
+      int frame2 = frame_list_[-1]->frame_id;
+      similar_->Calc(frame_list_[frame1], frame_list_[frame2],
+                     similar_map_.get(frame1, frame2).get());
+    }
   }
 
   for (auto &target : targets_) {
@@ -98,7 +98,11 @@ class OMTObstacleTracker : public BaseObstacleTracker {
   std::string Name() const override;
 
  private:
-  float ScoreAppearance(const Target &target, TrackObjectPtr object);
+  // The similarity rows of the objects of target seen by sensor_name,
+  // latest first, against the objects of frame frame_id.
+  void GetAppearanceRows(const Target &target, const std::string &sensor_name,
+                         int frame_id, std::vector<const float *> *rows) const;
+  float ScoreAppearance(const std::vector<const float *> &rows, int patch_id);
 
   float ScoreMotion(const Target &target, TrackObjectPtr object);
   float ScoreShape(const Target &target, TrackObjectPtr object);
@@ -112,7 +116,7 @@ class OMTObstacleTracker : public BaseObstacleTracker {
   omt::OmtParam omt_param_;
   FrameList frame_list_;
   SimilarMap similar_map_;
-  std::shared_ptr<BaseSimilar> similar_ = nullptr;
+  std::shared_ptr<GPUSimilar> similar_ = nullptr;
   std::vector<Target> targets_;
   std::vector<bool> used_;
   ObstacleReference reference_;
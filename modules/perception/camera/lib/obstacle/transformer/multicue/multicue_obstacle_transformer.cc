@@ -43,8 +43,9 @@ bool MultiCueObstacleTransformer::Init(
 }
 
 void MultiCueObstacleTransformer::SetObjMapperOptions(
-    base::ObjectPtr obj, Eigen::Matrix3f camera_k_matrix, int width_image,
-    int height_image, ObjMapperOptions *obj_mapper_options, float *theta_ray) {
+    base::ObjectPtr obj, const Eigen::Matrix3f &camera_k_inverse,
+    int width_image, int height_image, ObjMapperOptions *obj_mapper_options,
+    float *theta_ray) {
   // prepare bbox2d
   float bbox2d[4] = {
       obj->camera_supplement.box.xmin, obj->camera_supplement.box.ymin,
@@ -65,7 +66,7 @@ void MultiCueObstacleTransformer::SetObjMapperOptions(
   Eigen::Vector3f image_point_low_center(box_cent_x, bbox2d[3], 1);
   Eigen::Vector3f point_in_camera =
       static_cast<Eigen::Matrix<float, 3, 1, 0, 3, 1>>(
-          camera_k_matrix.inverse() * image_point_low_center);
+          camera_k_inverse * image_point_low_center);
   *theta_ray =
       static_cast<float>(atan2(point_in_camera.x(), point_in_camera.z()));
   float rotation_y =
@@ -168,7 +169,8 @@ int MultiCueObstacleTransformer::MatchTemplates(base::ObjectSubType sub_type,
 
 void MultiCueObstacleTransformer::FillResults(
     float object_center[3], float dimension_hwl[3], float rotation_y,
-    Eigen::Affine3d camera2world_pose, float theta_ray, base::ObjectPtr obj) {
+    const Eigen::Affine3d &camera2world_pose, float theta_ray,
+    base::ObjectPtr obj) {
   if (obj == nullptr) {
     return;
   }
@@ -195,7 +197,7 @@ void MultiCueObstacleTransformer::FillResults(
   obj->center_uncertainty(2) = static_cast<float>(pos_var(2));
 
   float theta = rotation_y;
-  Eigen::Vector3d dir = (camera2world_pose.matrix().block(0, 0, 3, 3) *
+  Eigen::Vector3d dir = (camera2world_pose.linear() *
                          Eigen::Vector3d(cos(theta), 0, -sin(theta)));
   obj->direction[0] = static_cast<float>(dir[0]);
   obj->direction[1] = static_cast<float>(dir[1]);
@@ -236,6 +238,8 @@ bool MultiCueObstacleTransformer::Transform(
   const int height_image = frame->data_provider->src_height();
   const auto &camera2world_pose = frame->camera2world_pose;
   mapper_->Init(k_mat, width_image, height_image);
+  // once per camera and frame instead of once per object
+  const Eigen::Matrix3f camera_k_inverse = camera_k_matrix.inverse();
 
   ObjMapperOptions obj_mapper_options;
   float object_center[3] = {0};
@@ -251,7 +255,7 @@ bool MultiCueObstacleTransformer::Transform(
 
     // set object mapper options
     float theta_ray = 0.0f;
-    SetObjMapperOptions(obj, camera_k_matrix, width_image, height_image,
+    SetObjMapperOptions(obj, camera_k_inverse, width_image, height_image,
                         &obj_mapper_options, &theta_ray);
 
     // process
@@ -23,6 +23,7 @@
 #include "cyber/common/log.h"
 #include "modules/perception/camera/common/util.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/inference_scheduler.h"
 #include "modules/perception/inference/utils/resize.h"
 #include "modules/perception/inference/utils/util.h"
 
@@ -213,7 +214,9 @@ bool TrafficLightDetection::Inference(
   }
   // _detection
   cudaDeviceSynchronize();
-  rt_net_->Infer();
+  inference::InferenceScheduler::Instance()->Infer(
+      "traffic_light_detection", inference::InferencePriority::TRAFFIC_LIGHT,
+      rt_net_.get());
   cudaDeviceSynchronize();
   AINFO << "rt_net run success";
 
@@ -15,11 +15,14 @@
  *****************************************************************************/
 #include "modules/perception/camera/lib/traffic_light/detector/recognition/classify.h"
 
+#include <algorithm>
 #include <map>
 
 #include "cyber/common/file.h"
 #include "modules/perception/camera/common/util.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/inference_scheduler.h"
 #include "modules/perception/inference/utils/resize.h"
 
 namespace apollo {
@@ -89,8 +92,9 @@ void ClassifyBySimple::Init(
   std::vector<int> shape = {1, resize_height_, resize_width_, 3};
   mean_buffer_.reset(new base::Blob<float>(shape));
 
+  batch_size_ = std::max(1, FLAGS_traffic_light_recognition_batch_size);
   std::map<std::string, std::vector<int>> input_reshape{
-      {net_inputs_[0], shape}};
+      {net_inputs_[0], {batch_size_, resize_height_, resize_width_, 3}}};
   AINFO << "input_reshape: " << input_reshape[net_inputs_[0]][0] << ", "
         << input_reshape[net_inputs_[0]][1] << ", "
         << input_reshape[net_inputs_[0]][2] << ", "
@@ -112,36 +116,58 @@ void ClassifyBySimple::Perform(const CameraFrame* frame,
     AERROR << "Failed to set device to " << gpu_id_;
     return;
   }
-  std::shared_ptr<base::Blob<uint8_t>> rectified_blob;
-
-  auto input_blob_recog = rt_net_->get_blob(net_inputs_[0]);
-  auto output_blob_recog = rt_net_->get_blob(net_outputs_[0]);
 
+  batch_lights_.clear();
   for (base::TrafficLightPtr light : *lights) {
-    if (!light->region.is_detected) {
-      continue;
+    if (light->region.is_detected) {
+      batch_lights_.push_back(light);
     }
+  }
+
+  const size_t batch_size = static_cast<size_t>(batch_size_);
+  for (size_t begin = 0; begin < batch_lights_.size(); begin += batch_size) {
+    size_t end = std::min(batch_lights_.size(), begin + batch_size);
+    ClassifyBatch(frame, std::vector<base::TrafficLightPtr>(
+                             batch_lights_.begin() + begin,
+                             batch_lights_.begin() + end));
+  }
+}
+
+void ClassifyBySimple::ClassifyBatch(
+    const CameraFrame* frame,
+    const std::vector<base::TrafficLightPtr>& lights) {
+  auto input_blob_recog = rt_net_->get_blob(net_inputs_[0]);
+  input_blob_recog->Reshape({static_cast<int>(lights.size()), resize_height_,
+                             resize_width_, 3});
 
-    data_provider_image_option_.crop_roi = light->region.detection_roi;
+  // every crop is resized into its own slot of the input batch
+  const float* mean = mean_->cpu_data();
+  for (size_t i = 0; i < lights.size(); ++i) {
+    data_provider_image_option_.crop_roi = lights[i]->region.detection_roi;
     data_provider_image_option_.do_crop = true;
     data_provider_image_option_.target_color = base::Color::RGB;
     frame->data_provider->GetImage(data_provider_image_option_, image_.get());
 
-    AINFO << "get img done";
-
-    const float* mean = mean_->cpu_data();
     inference::ResizeGPU(*image_, input_blob_recog,
-                         frame->data_provider->src_width(), 0, mean[0],
-                         mean[1], mean[2], true, scale_);
+                         frame->data_provider->src_width(),
+                         static_cast<int>(i), mean[0], mean[1], mean[2], true,
+                         scale_);
+  }
 
-    AINFO << "resize gpu finish.";
-    cudaDeviceSynchronize();
-    rt_net_->Infer();
-    cudaDeviceSynchronize();
-    AINFO << "infer finish.";
+  AINFO << "resize gpu finish, batch " << lights.size();
+  cudaDeviceSynchronize();
+  inference::InferenceScheduler::Instance()->Infer(
+      "traffic_light_recognition", inference::InferencePriority::TRAFFIC_LIGHT,
+      rt_net_.get());
+  cudaDeviceSynchronize();
+  AINFO << "infer finish.";
 
-    float* out_put_data = output_blob_recog->mutable_cpu_data();
-    Prob2Color(out_put_data, unknown_threshold_, light);
+  auto output_blob_recog = rt_net_->get_blob(net_outputs_[0]);
+  const int output_length = output_blob_recog->count(1);
+  float* out_put_data = output_blob_recog->mutable_cpu_data();
+  for (size_t i = 0; i < lights.size(); ++i) {
+    Prob2Color(out_put_data + i * output_length, unknown_threshold_,
+               lights[i]);
   }
 }
 
@@ -44,6 +44,8 @@ class ClassifyBySimple {
  private:
   void Prob2Color(const float* out_put_data, float threshold,
                   base::TrafficLightPtr light);
+  void ClassifyBatch(const CameraFrame* frame,
+                     const std::vector<base::TrafficLightPtr>& lights);
   std::shared_ptr<inference::Inference> rt_net_ = nullptr;
   DataProvider::ImageOptions data_provider_image_option_;
   std::shared_ptr<base::Image8U> image_ = nullptr;
@@ -51,6 +53,8 @@ class ClassifyBySimple {
   std::shared_ptr<base::Blob<float>> mean_;
   std::vector<std::string> net_inputs_;
   std::vector<std::string> net_outputs_;
+  std::vector<base::TrafficLightPtr> batch_lights_;
+  int batch_size_ = 1;
   int resize_width_;
   int resize_height_;
   float unknown_threshold_;
@@ -93,6 +93,16 @@ TEST(OnlineCalibrationServiceTest, online_calibration_service_test) {
     EXPECT_GT(depth, 0.0);
     AINFO << "Query depth: " << depth;
 
+    // the batched query matches the single one and fails above the horizon
+    std::vector<Eigen::Vector2i> pixels = {Eigen::Vector2i(x, y),
+                                           Eigen::Vector2i(x, 0)};
+    std::vector<double> depths;
+    EXPECT_EQ(online_calib_service->QueryDepthsOnGroundPlane(pixels, &depths),
+              1);
+    EXPECT_EQ(depths.size(), 2);
+    EXPECT_DOUBLE_EQ(depths[0], depth);
+    EXPECT_DOUBLE_EQ(depths[1], 0.0);
+
     name_camera_ground_height_map["onsemi_obstacle"] = 100;
     name_camera_pitch_angle_diff_map["onsemi_obstacle"] = 0;
 
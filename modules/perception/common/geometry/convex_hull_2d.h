@@ -32,6 +32,7 @@ class ConvexHull2D {
   ConvexHull2D() : in_cloud_(nullptr) {
     points_.reserve(1000.0);
     polygon_indices_.reserve(1000.0);
+    sorted_indices_.reserve(1000.0);
   }
   ~ConvexHull2D() { in_cloud_ = nullptr; }
   // main interface to get polygon from input point cloud
@@ -92,12 +93,20 @@ class ConvexHull2D {
     }
     return true;
   }
+  // drop the points strictly inside the octagon of the extreme points before
+  // sorting once the input has at least min_size points, 0 disables it.
+  // those points are never on the hull, so the polygon does not change.
+  void set_prefilter_min_size(std::size_t min_size) {
+    prefilter_min_size_ = min_size;
+  }
 
  private:
   // save points in local memory, and transform to double
   void SetPoints(const CLOUD_IN_TYPE& in_cloud);
   // mock a polygon for some degenerate cases
   bool MockConvexHull(CLOUD_OUT_TYPE* out_polygon);
+  // fill sorted_indices_ with the points which may be on the hull
+  void GetHullCandidates(const double& eps);
   // compute convex hull using Andrew's monotone chain algorithm
   bool GetConvexHullMonotoneChain(CLOUD_OUT_TYPE* out_polygon);
   // given 3 ordered points, return true if in counter clock wise.
@@ -111,6 +120,8 @@ class ConvexHull2D {
  private:
   std::vector<Eigen::Vector2d> points_;
   std::vector<std::size_t> polygon_indices_;
+  std::vector<std::size_t> sorted_indices_;
+  std::size_t prefilter_min_size_ = 0;
   const CLOUD_IN_TYPE* in_cloud_;
 };
 
@@ -171,6 +182,69 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::MockConvexHull(
   return true;
 }
 
+template <class CLOUD_IN_TYPE, class CLOUD_OUT_TYPE>
+void ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetHullCandidates(
+    const double& eps) {
+  sorted_indices_.resize(points_.size());
+  std::iota(sorted_indices_.begin(), sorted_indices_.end(), 0);
+  if (prefilter_min_size_ == 0 || points_.size() < prefilter_min_size_) {
+    return;
+  }
+  // extreme points along y, x - y, x, x + y, -y, y - x, -x and -x - y,
+  // which are hull vertices in counter clock wise order
+  static const double kDirections[8][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1},
+                                           {0, 1},  {-1, 1}, {-1, 0}, {-1, -1}};
+  std::size_t extremes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  double extreme_values[8];
+  for (std::size_t k = 0; k < 8; ++k) {
+    extreme_values[k] = kDirections[k][0] * points_[0](0) +
+                        kDirections[k][1] * points_[0](1);
+  }
+  for (std::size_t i = 1; i < points_.size(); ++i) {
+    for (std::size_t k = 0; k < 8; ++k) {
+      const double value = kDirections[k][0] * points_[i](0) +
+                           kDirections[k][1] * points_[i](1);
+      if (value > extreme_values[k]) {
+        extreme_values[k] = value;
+        extremes[k] = i;
+      }
+    }
+  }
+  Eigen::Vector2d octagon[8];
+  std::size_t num_edges = 0;
+  for (std::size_t k = 0; k < 8; ++k) {
+    const auto& point = points_[extremes[k]];
+    if (num_edges == 0 || point != octagon[num_edges - 1]) {
+      octagon[num_edges++] = point;
+    }
+  }
+  while (num_edges > 1 && octagon[num_edges - 1] == octagon[0]) {
+    --num_edges;
+  }
+  if (num_edges < 3) {
+    return;
+  }
+  for (std::size_t k = 0; k < num_edges; ++k) {
+    // bail out on ties which do not give a convex octagon
+    if (IsCounterClockWise(octagon[(k + 1) % num_edges], octagon[k],
+                           octagon[(k + 2) % num_edges], 0.0)) {
+      return;
+    }
+  }
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < points_.size(); ++i) {
+    bool inside = true;
+    for (std::size_t k = 0; k < num_edges && inside; ++k) {
+      inside = IsCounterClockWise(octagon[k], octagon[(k + 1) % num_edges],
+                                  points_[i], eps);
+    }
+    if (!inside) {
+      sorted_indices_[count++] = i;
+    }
+  }
+  sorted_indices_.resize(count);
+}
+
 template <class CLOUD_IN_TYPE, class CLOUD_OUT_TYPE>
 bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
     CLOUD_OUT_TYPE* out_polygon) {
@@ -178,10 +252,9 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
     return false;
   }
 
-  std::vector<std::size_t> sorted_indices(points_.size());
-  std::iota(sorted_indices.begin(), sorted_indices.end(), 0);
-
   static const double eps = 1e-9;
+  GetHullCandidates(eps);
+  std::vector<std::size_t>& sorted_indices = sorted_indices_;
   std::sort(sorted_indices.begin(), sorted_indices.end(),
             [&](const std::size_t& lhs, const std::size_t& rhs) {
               double dx = points_[lhs](0) - points_[rhs](0);
@@ -193,15 +266,15 @@ bool ConvexHull2D<CLOUD_IN_TYPE, CLOUD_OUT_TYPE>::GetConvexHullMonotoneChain(
   int count = 0;
   int last_count = 1;
   polygon_indices_.clear();
-  polygon_indices_.reserve(points_.size());
+  polygon_indices_.reserve(sorted_indices.size());
 
-  std::size_t size2 = points_.size() * 2;
+  std::size_t size2 = sorted_indices.size() * 2;
   for (std::size_t i = 0; i < size2; ++i) {
-    if (i == points_.size()) {
+    if (i == sorted_indices.size()) {
       last_count = count;
     }
     const std::size_t& idx =
-        sorted_indices[(i < points_.size()) ? i : (size2 - 1 - i)];
+        sorted_indices[(i < sorted_indices.size()) ? i : (size2 - 1 - i)];
     const auto& point = points_[idx];
     while (count > last_count &&
            !IsCounterClockWise(points_[polygon_indices_[count - 2]],
@@ -15,6 +15,9 @@
  *****************************************************************************/
 #include "modules/perception/common/geometry/convex_hull_2d.h"
 
+#include <cmath>
+#include <cstdlib>
+
 #include "gtest/gtest.h"
 
 #include "modules/perception/base/point.h"
@@ -125,6 +128,50 @@ TEST(ConvexHull2DTest1, convex_hull_2d1) {
   EXPECT_EQ(pointcloud_out.size(), 4);
 }
 
+TEST(ConvexHull2DTest, convex_hull_2d_prefilter) {
+  ConvexHull2D<PointFCloud, PointFCloud> convex_hull_2d;
+  ConvexHull2D<PointFCloud, PointFCloud> filtered_convex_hull_2d;
+  filtered_convex_hull_2d.set_prefilter_min_size(16);
+  PointFCloud pointcloud_in, pointcloud_out, filtered_pointcloud_out;
+  PointF pt;
+  unsigned int seed = 1;
+  for (size_t i = 0; i < 2000; i++) {
+    // an ellipse like cluster with a few points on the same line
+    const float angle = static_cast<float>(rand_r(&seed) % 3600) * 0.1f;
+    const float radius = static_cast<float>(rand_r(&seed) % 1000) * 1e-3f;
+    pt.x = 4.f * radius * std::cos(angle * static_cast<float>(M_PI) / 180.f);
+    pt.y = 2.f * radius * std::sin(angle * static_cast<float>(M_PI) / 180.f);
+    pt.z = static_cast<float>(i % 7);
+    if (i % 100 == 0) {
+      pt.y = -2.f;
+    }
+    pointcloud_in.push_back(pt);
+  }
+  EXPECT_TRUE(convex_hull_2d.GetConvexHull(pointcloud_in, &pointcloud_out));
+  EXPECT_TRUE(filtered_convex_hull_2d.GetConvexHull(pointcloud_in,
+                                                    &filtered_pointcloud_out));
+  ASSERT_EQ(pointcloud_out.size(), filtered_pointcloud_out.size());
+  for (size_t i = 0; i < pointcloud_out.size(); ++i) {
+    EXPECT_EQ(pointcloud_out[i].x, filtered_pointcloud_out[i].x);
+    EXPECT_EQ(pointcloud_out[i].y, filtered_pointcloud_out[i].y);
+    EXPECT_EQ(pointcloud_out[i].z, filtered_pointcloud_out[i].z);
+  }
+
+  // all the points on a line are kept
+  pointcloud_in.clear();
+  for (size_t i = 0; i < 100; i++) {
+    pt.x = static_cast<float>(i);
+    pt.y = static_cast<float>(i);
+    pointcloud_in.push_back(pt);
+  }
+  pointcloud_out.clear();
+  filtered_pointcloud_out.clear();
+  EXPECT_EQ(convex_hull_2d.GetConvexHull(pointcloud_in, &pointcloud_out),
+            filtered_convex_hull_2d.GetConvexHull(pointcloud_in,
+                                                  &filtered_pointcloud_out));
+  EXPECT_EQ(pointcloud_out.size(), filtered_pointcloud_out.size());
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
@@ -18,11 +18,14 @@
 
 #include <algorithm>
 #include <functional>
+#include <future>
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 
 #include "modules/perception/common/graph/connected_component_analysis.h"
 #include "modules/perception/common/graph/hungarian_optimizer.h"
@@ -36,7 +39,8 @@ class GatedHungarianMatcher {
  public:
   enum class OptimizeFlag { OPTMAX, OPTMIN };
 
-  explicit GatedHungarianMatcher(int max_matching_size = 1000) {
+  explicit GatedHungarianMatcher(int max_matching_size = 1000)
+      : max_matching_size_(max_matching_size) {
     global_costs_.Reserve(max_matching_size, max_matching_size);
     optimizer_.costs()->Reserve(max_matching_size, max_matching_size);
   }
@@ -52,6 +56,13 @@ class GatedHungarianMatcher {
   const SecureMat<T>& global_costs() const { return global_costs_; }
   SecureMat<T>* mutable_global_costs() { return &global_costs_; }
 
+  /* @brief: connected components are independent, with more than one thread
+   * they are optimized concurrently, each thread with its own optimizer.
+   * the assignments are the same as the serial ones. */
+  void set_num_threads(size_t num_threads) {
+    num_threads_ = std::max(static_cast<size_t>(1), num_threads);
+  }
+
   void Match(T cost_thresh, OptimizeFlag opt_flag,
              std::vector<std::pair<size_t, size_t>>* assignments,
              std::vector<size_t>* unassigned_rows,
@@ -73,12 +84,20 @@ class GatedHungarianMatcher {
    * small sub-parts. */
   void ComputeConnectedComponents(
       std::vector<std::vector<size_t>>* row_components,
-      std::vector<std::vector<size_t>>* col_components) const;
+      std::vector<std::vector<size_t>>* col_components);
 
   /* Step 3:
    * optimize single connected component, which is part of the global one */
-  void OptimizeConnectedComponent(const std::vector<size_t>& row_component,
-                                  const std::vector<size_t>& col_component);
+  void OptimizeConnectedComponent(
+      const std::vector<size_t>& row_component,
+      const std::vector<size_t>& col_component,
+      HungarianOptimizer<T>* optimizer,
+      std::vector<std::pair<size_t, size_t>>* assignments);
+
+  /* optimize all the connected components on several threads */
+  void OptimizeConnectedComponents(
+      const std::vector<std::vector<size_t>>& row_components,
+      const std::vector<std::vector<size_t>>& col_components);
 
   /* Step 4:
    * generate the set of unassigned row or col index. */
@@ -90,15 +109,27 @@ class GatedHungarianMatcher {
    * optimizer directly
    * @params[IN] row_component: the set of index of rows of sub-graph
    * @params[IN] col_component: the set of index of cols of sub-graph
+   * @params[OUT] optimizer: the optimizer owning the local costs
    * @return: nothing */
   void UpdateGatingLocalCostsMat(const std::vector<size_t>& row_component,
-                                 const std::vector<size_t>& col_component);
+                                 const std::vector<size_t>& col_component,
+                                 HungarianOptimizer<T>* optimizer);
 
   void OptimizeAdapter(
+      HungarianOptimizer<T>* optimizer,
       std::vector<std::pair<size_t, size_t>>* local_assignments);
 
   /* Hungarian optimizer */
   HungarianOptimizer<T> optimizer_;
+  int max_matching_size_ = 1000;
+
+  /* optimizers and assignments of the threads, kept between matchings */
+  size_t num_threads_ = 1;
+  std::vector<std::unique_ptr<HungarianOptimizer<T>>> thread_optimizers_;
+  std::vector<std::vector<std::pair<size_t, size_t>>> component_assignments_;
+
+  /* neighbors of the rows & cols, reused between matchings */
+  std::vector<std::vector<int>> nb_graph_;
 
   /* global costs matrix */
   SecureMat<T> global_costs_;
@@ -156,8 +187,13 @@ void GatedHungarianMatcher<T>::Match(
   /* compute assignments */
   assignments_ptr_->clear();
   assignments_ptr_->reserve(std::max(rows_num_, cols_num_));
-  for (size_t i = 0; i < row_components.size(); ++i) {
-    this->OptimizeConnectedComponent(row_components[i], col_components[i]);
+  if (num_threads_ > 1 && row_components.size() > 1) {
+    this->OptimizeConnectedComponents(row_components, col_components);
+  } else {
+    for (size_t i = 0; i < row_components.size(); ++i) {
+      this->OptimizeConnectedComponent(row_components[i], col_components[i],
+                                       &optimizer_, assignments_ptr_);
+    }
   }
 
   this->GenerateUnassignedData(unassigned_rows, unassigned_cols);
@@ -186,23 +222,26 @@ void GatedHungarianMatcher<T>::MatchInit() {
 template <typename T>
 void GatedHungarianMatcher<T>::ComputeConnectedComponents(
     std::vector<std::vector<size_t>>* row_components,
-    std::vector<std::vector<size_t>>* col_components) const {
+    std::vector<std::vector<size_t>>* col_components) {
   CHECK_NOTNULL(row_components);
   CHECK_NOTNULL(col_components);
 
-  std::vector<std::vector<int>> nb_graph;
-  nb_graph.resize(rows_num_ + cols_num_);
+  // clear instead of reallocating the neighbor lists of every node
+  nb_graph_.resize(rows_num_ + cols_num_);
+  for (auto& neighbors : nb_graph_) {
+    neighbors.clear();
+  }
   for (size_t i = 0; i < rows_num_; ++i) {
     for (size_t j = 0; j < cols_num_; ++j) {
       if (is_valid_cost_(global_costs_(i, j))) {
-        nb_graph[i].push_back(static_cast<int>(rows_num_) + j);
-        nb_graph[j + rows_num_].push_back(i);
+        nb_graph_[i].push_back(static_cast<int>(rows_num_) + j);
+        nb_graph_[j + rows_num_].push_back(i);
       }
     }
   }
 
   std::vector<std::vector<int>> components;
-  ConnectedComponentAnalysis(nb_graph, &components);
+  ConnectedComponentAnalysis(nb_graph_, &components);
   row_components->clear();
   row_components->resize(components.size());
   col_components->clear();
@@ -223,7 +262,8 @@ void GatedHungarianMatcher<T>::ComputeConnectedComponents(
 template <typename T>
 void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     const std::vector<size_t>& row_component,
-    const std::vector<size_t>& col_component) {
+    const std::vector<size_t>& col_component, HungarianOptimizer<T>* optimizer,
+    std::vector<std::pair<size_t, size_t>>* assignments) {
   size_t local_rows_num = row_component.size();
   size_t local_cols_num = col_component.size();
 
@@ -236,17 +276,17 @@ void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     size_t idx_r = row_component[0];
     size_t idx_c = col_component[0];
     if (is_valid_cost_(global_costs_(idx_r, idx_c))) {
-      assignments_ptr_->push_back(std::make_pair(idx_r, idx_c));
+      assignments->push_back(std::make_pair(idx_r, idx_c));
     }
     return;
   }
 
   /* update local cost matrix */
-  UpdateGatingLocalCostsMat(row_component, col_component);
+  UpdateGatingLocalCostsMat(row_component, col_component, optimizer);
 
   /* get local assignments */
   std::vector<std::pair<size_t, size_t>> local_assignments;
-  OptimizeAdapter(&local_assignments);
+  OptimizeAdapter(optimizer, &local_assignments);
 
   /* parse local assginments into global ones */
   for (size_t i = 0; i < local_assignments.size(); ++i) {
@@ -256,7 +296,46 @@ void GatedHungarianMatcher<T>::OptimizeConnectedComponent(
     if (!is_valid_cost_(global_costs_(global_row_idx, global_col_idx))) {
       continue;
     }
-    assignments_ptr_->push_back(std::make_pair(global_row_idx, global_col_idx));
+    assignments->push_back(std::make_pair(global_row_idx, global_col_idx));
+  }
+}
+
+template <typename T>
+void GatedHungarianMatcher<T>::OptimizeConnectedComponents(
+    const std::vector<std::vector<size_t>>& row_components,
+    const std::vector<std::vector<size_t>>& col_components) {
+  const size_t num_components = row_components.size();
+  const size_t num_workers = std::min(num_threads_, num_components);
+  while (thread_optimizers_.size() < num_workers) {
+    thread_optimizers_.emplace_back(
+        new HungarianOptimizer<T>(max_matching_size_));
+  }
+  if (component_assignments_.size() < num_components) {
+    component_assignments_.resize(num_components);
+  }
+
+  std::vector<std::future<void>> results;
+  results.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; ++w) {
+    results.push_back(cyber::Async([this, w, num_workers, num_components,
+                                    &row_components, &col_components]() {
+      for (size_t i = w; i < num_components; i += num_workers) {
+        component_assignments_[i].clear();
+        this->OptimizeConnectedComponent(
+            row_components[i], col_components[i], thread_optimizers_[w].get(),
+            &component_assignments_[i]);
+      }
+    }));
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+
+  /* keep the order of the serial optimization */
+  for (size_t i = 0; i < num_components; ++i) {
+    assignments_ptr_->insert(assignments_ptr_->end(),
+                             component_assignments_[i].begin(),
+                             component_assignments_[i].end());
   }
 }
 
@@ -291,13 +370,15 @@ void GatedHungarianMatcher<T>::GenerateUnassignedData(
 template <typename T>
 void GatedHungarianMatcher<T>::UpdateGatingLocalCostsMat(
     const std::vector<size_t>& row_component,
-    const std::vector<size_t>& col_component) {
+    const std::vector<size_t>& col_component,
+    HungarianOptimizer<T>* optimizer) {
   /* set the invalid cost to bound value */
-  SecureMat<T>* local_costs = optimizer_.costs();
+  SecureMat<T>* local_costs = optimizer->costs();
   local_costs->Resize(row_component.size(), col_component.size());
   for (size_t i = 0; i < row_component.size(); ++i) {
     for (size_t j = 0; j < col_component.size(); ++j) {
-      T& current_cost = global_costs_(row_component[i], col_component[j]);
+      const T& current_cost =
+          global_costs_(row_component[i], col_component[j]);
       if (is_valid_cost_(current_cost)) {
         (*local_costs)(i, j) = current_cost;
       } else {
@@ -309,12 +390,13 @@ void GatedHungarianMatcher<T>::UpdateGatingLocalCostsMat(
 
 template <typename T>
 void GatedHungarianMatcher<T>::OptimizeAdapter(
+    HungarianOptimizer<T>* optimizer,
     std::vector<std::pair<size_t, size_t>>* local_assignments) {
   CHECK_NOTNULL(local_assignments);
   if (opt_flag_ == OptimizeFlag::OPTMAX) {
-    optimizer_.Maximize(local_assignments);
+    optimizer->Maximize(local_assignments);
   } else {
-    optimizer_.Minimize(local_assignments);
+    optimizer->Minimize(local_assignments);
   }
 }
 
@@ -551,6 +551,52 @@ TEST_F(GatedHungarianMatcherTest, test_Match_Maximize) {
   EXPECT_EQ(0, unassigned_rows.size());
 }
 
+TEST_F(GatedHungarianMatcherTest, test_Match_Parallel) {
+  GatedHungarianMatcher<float> parallel_optimizer(1000);
+  parallel_optimizer.set_num_threads(4);
+  SecureMat<float>* global_costs = optimizer_->mutable_global_costs();
+  SecureMat<float>* parallel_costs = parallel_optimizer.mutable_global_costs();
+
+  float cost_thresh = 4.0f;
+  float bound_value = 100.0f;
+  GatedHungarianMatcher<float>::OptimizeFlag opt_flag =
+      GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN;
+  std::vector<std::pair<size_t, size_t>> assignments;
+  std::vector<size_t> unassigned_rows;
+  std::vector<size_t> unassigned_cols;
+  std::vector<std::pair<size_t, size_t>> parallel_assignments;
+  std::vector<size_t> parallel_unassigned_rows;
+  std::vector<size_t> parallel_unassigned_cols;
+
+  /* tracks and objects spread along a line, only near pairs are valid,
+   * which gives many small components */
+  const size_t rows = 60;
+  const size_t cols = 50;
+  global_costs->Resize(rows, cols);
+  parallel_costs->Resize(rows, cols);
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      float cost = std::abs(static_cast<float>(i) * 1.7f -
+                            static_cast<float>(j) * 2.1f) +
+                   static_cast<float>((i * 7 + j * 3) % 5) * 0.3f;
+      (*global_costs)(i, j) = cost;
+      (*parallel_costs)(i, j) = cost;
+    }
+  }
+
+  for (int round = 0; round < 2; ++round) {
+    optimizer_->Match(cost_thresh, bound_value, opt_flag, &assignments,
+                      &unassigned_rows, &unassigned_cols);
+    parallel_optimizer.Match(cost_thresh, bound_value, opt_flag,
+                             &parallel_assignments, &parallel_unassigned_rows,
+                             &parallel_unassigned_cols);
+    EXPECT_FALSE(assignments.empty());
+    EXPECT_EQ(assignments, parallel_assignments);
+    EXPECT_EQ(unassigned_rows, parallel_unassigned_rows);
+    EXPECT_EQ(unassigned_cols, parallel_unassigned_cols);
+  }
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
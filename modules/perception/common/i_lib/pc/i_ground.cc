@@ -16,8 +16,11 @@
 #include "modules/perception/common/i_lib/pc/i_ground.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 
+#include "cyber/task/task.h"
+
 namespace apollo {
 namespace perception {
 namespace common {
@@ -178,6 +181,11 @@ bool PlaneFitGroundDetector::Init() {
   if (!ground_planes_sphe_) {
     return false;
   }
+  prior_planes_ =
+      IAlloc2<GroundPlaneLiDAR>(param_.nr_grids_coarse, param_.nr_grids_coarse);
+  if (!prior_planes_) {
+    return false;
+  }
   ground_z_ = IAlloc2<std::pair<float, bool>>(param_.nr_grids_coarse,
                                               param_.nr_grids_coarse);
   if (!ground_z_) {
@@ -270,6 +278,7 @@ void PlaneFitGroundDetector::CleanUp() {
   }
   IFree2<GroundPlaneLiDAR>(&ground_planes_);
   IFree2<GroundPlaneSpherical>(&ground_planes_sphe_);
+  IFree2<GroundPlaneLiDAR>(&prior_planes_);
   IFree2<std::pair<float, bool>>(&ground_z_);
   IFree2<PlaneFitPointCandIndices>(&local_candis_);
   IFreeAligned<float>(&pf_threeds_);
@@ -392,6 +401,27 @@ void PlaneFitGroundDetector::ComputeSignedGroundHeight(
   for (r = 0; r < nr_points; ++r) {
     height_above_ground[r] = std::numeric_limits<float>::max();
   }
+  const unsigned int nr_workers =
+      IMin(static_cast<unsigned int>(num_threads_), param_.nr_grids_coarse);
+  if (nr_workers > 1) {
+    // every point belongs to one line, the lines are independent
+    std::vector<std::future<void>> results;
+    results.reserve(nr_workers);
+    for (unsigned int w = 0; w < nr_workers; ++w) {
+      results.push_back(cyber::Async([&, w]() {
+        for (unsigned int l = w; l <= nm1; l += nr_workers) {
+          ComputeSignedGroundHeightLine(
+              point_cloud, ground_planes_[l > 0 ? l - 1 : 0],
+              ground_planes_[l], ground_planes_[l < nm1 ? l + 1 : nm1],
+              height_above_ground, l, nr_points, nr_point_elements);
+        }
+      }));
+    }
+    for (auto &result : results) {
+      result.get();
+    }
+    return;
+  }
   ComputeSignedGroundHeightLine(
       point_cloud, ground_planes_[0], ground_planes_[0], ground_planes_[1],
       height_above_ground, 0, nr_points, nr_point_elements);
@@ -543,7 +573,9 @@ int PlaneFitGroundDetector::FilterGrid(const Voxel<float> &vx,
                                        const float *point_cloud,
                                        PlaneFitPointCandIndices *candi,
                                        unsigned int nr_points,
-                                       unsigned int nr_point_element) {
+                                       unsigned int nr_point_element,
+                                       float *sampled_z_values,
+                                       int *sampled_indices) {
   int pos = 0;
   int rseed = I_DEFAULT_SEED;
   int nr_candis = 0;
@@ -559,25 +591,27 @@ int PlaneFitGroundDetector::FilterGrid(const Voxel<float> &vx,
     for (i = 0; i < vx.NrPoints(); ++i) {
       pos = vx.indices_[i] * nr_point_element;
       //  requires the Z element to be in the third position, i.e., after X, Y
-      sampled_z_values_[i] = (point_cloud + pos)[2];
+      sampled_z_values[i] = (point_cloud + pos)[2];
     }
   } else {
-    IRandomSample(sampled_indices_, static_cast<int>(param_.nr_z_comp_candis),
+    IRandomSample(sampled_indices, static_cast<int>(param_.nr_z_comp_candis),
                   static_cast<int>(vx.NrPoints()), &rseed);
     //  sampled z values
     for (i = 0; i < nr_samples; ++i) {
-      pos = vx.indices_[sampled_indices_[i]] * nr_point_element;
+      pos = vx.indices_[sampled_indices[i]] * nr_point_element;
       // requires the Z element to be in the third position, i.e., after X, Y
-      sampled_z_values_[i] = (point_cloud + pos)[2];
+      sampled_z_values[i] = (point_cloud + pos)[2];
     }
   }
   // Filter points and get plane fitting candidates
-  nr_candis = CompareZ(point_cloud, vx.indices_, sampled_z_values_, candi,
+  nr_candis = CompareZ(point_cloud, vx.indices_, sampled_z_values, candi,
                        nr_points, nr_point_element, nr_samples);
   return nr_candis;
 }
 
-int PlaneFitGroundDetector::FilterLine(unsigned int r) {
+int PlaneFitGroundDetector::FilterLine(unsigned int r,
+                                       float *sampled_z_values,
+                                       int *sampled_indices) {
   int nr_candis = 0;
   unsigned int c = 0;
   const float *point_cloud = vg_fine_->const_data();
@@ -589,7 +623,8 @@ int PlaneFitGroundDetector::FilterLine(unsigned int r) {
     parent = map_fine_to_coarse_[begin + c];
     nr_candis +=
         FilterGrid((*vg_fine_)(r, c), point_cloud, &local_candis_[0][parent],
-                   nr_points, nr_point_element);
+                   nr_points, nr_point_element, sampled_z_values,
+                   sampled_indices);
   }
   return nr_candis;
 }
@@ -605,8 +640,40 @@ int PlaneFitGroundDetector::Filter() {
     local_candis_[0][i].Clear();
   }
   //  Filter plane fitting candidates
+  const unsigned int sf = param_.nr_grids_fine / param_.nr_grids_coarse;
+  const unsigned int nr_workers =
+      IMin(static_cast<unsigned int>(num_threads_), param_.nr_grids_coarse);
+  if (nr_workers > 1) {
+    // fine lines of one coarse line share candidate lists, so a worker takes
+    // whole coarse lines and keeps the order of the candidates
+    const unsigned int nr_bands = (param_.nr_grids_fine + sf - 1) / sf;
+    thread_sampled_z_values_.resize(nr_workers);
+    thread_sampled_indices_.resize(nr_workers);
+    std::vector<std::future<int>> results;
+    results.reserve(nr_workers);
+    for (unsigned int w = 0; w < nr_workers; ++w) {
+      thread_sampled_z_values_[w].resize(param_.nr_z_comp_candis);
+      thread_sampled_indices_[w].resize(param_.nr_z_comp_candis);
+      results.push_back(cyber::Async([this, w, sf, nr_bands, nr_workers]() {
+        int nr_candis_band = 0;
+        for (unsigned int b = w; b < nr_bands; b += nr_workers) {
+          const unsigned int end = IMin((b + 1) * sf, param_.nr_grids_fine);
+          for (unsigned int l = b * sf; l < end; ++l) {
+            nr_candis_band +=
+                FilterLine(l, thread_sampled_z_values_[w].data(),
+                           thread_sampled_indices_[w].data());
+          }
+        }
+        return nr_candis_band;
+      }));
+    }
+    for (auto &result : results) {
+      nr_candis += result.get();
+    }
+    return nr_candis;
+  }
   for (r = 0; r < param_.nr_grids_fine; ++r) {
-    nr_candis += FilterLine(r);
+    nr_candis += FilterLine(r, sampled_z_values_, sampled_indices_);
   }
   return nr_candis;
 }
@@ -826,8 +893,9 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   }
 
   GroundPlaneLiDAR plane;
-  int kNr_iter =
-      param_.nr_ransac_iter_threshold + static_cast<int>(neighbors.size());
+  const bool use_prior = use_prior_planes_ && prior_planes_[r][c].IsValid();
+  int kNr_iter = param_.nr_ransac_iter_threshold +
+                 static_cast<int>(neighbors.size()) + (use_prior ? 1 : 0);
   //  check hypothesis initialized correct or not
   if (kNr_iter < 1) {
     return 0;
@@ -913,6 +981,25 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
       hypothesis[i + param_.nr_ransac_iter_threshold].SetNrSupport(nr_inliers);
     }
   }
+  // the plane of the last frame competes like the ones of the neighbors
+  if (use_prior) {
+    GroundPlaneLiDAR &prior = hypothesis[kNr_iter - 1];
+    prior = prior_planes_[r][c];
+    psrc = pf_threeds_;
+    nr_inliers = 0;
+    for (int j = 0; j < nr_samples; ++j) {
+      ptp_dist = IPlaneToPointDistanceWUnitNorm(prior.params, psrc);
+      if (ptp_dist < dist_thre) {
+        nr_inliers++;
+      }
+      psrc += dim_point_;
+    }
+    if (nr_inliers < static_cast<int>(param_.nr_inliers_min_threshold)) {
+      prior.ForceInvalid();
+    } else {
+      prior.SetNrSupport(nr_inliers);
+    }
+  }
 
   nr_inliers_best = -1;
   for (int i = 0; i < kNr_iter; ++i) {
@@ -1280,9 +1367,38 @@ bool PlaneFitGroundDetector::Detect(const float *point_cloud,
   // compute point to ground distance
   ComputeSignedGroundHeight(point_cloud, height_above_ground, nr_points,
                             nr_point_elements);
+  use_prior_planes_ = false;
   return true;
 }
 
+void PlaneFitGroundDetector::SetNumThreads(int num_threads) {
+  num_threads_ = IMax(1, num_threads);
+}
+
+void PlaneFitGroundDetector::UpdatePriorPlanes(const float *shift) {
+  // planes are kept in the last frame until the next detection, move them
+  // by whole cells and express them in the coordinates of the next frame
+  const auto &voxel = vg_coarse_->GetConstVoxels()[0];
+  const int dc = IRound(shift[0] / voxel.dim_x_);
+  const int dr = IRound(shift[1] / voxel.dim_y_);
+  const int nr_grids = static_cast<int>(param_.nr_grids_coarse);
+  for (int r = 0; r < nr_grids; ++r) {
+    for (int c = 0; c < nr_grids; ++c) {
+      GroundPlaneLiDAR &prior = prior_planes_[r][c];
+      const int r_last = r + dr;
+      const int c_last = c + dc;
+      if (r_last < 0 || r_last >= nr_grids || c_last < 0 ||
+          c_last >= nr_grids || !ground_planes_[r_last][c_last].IsValid()) {
+        prior.ForceInvalid();
+        continue;
+      }
+      prior = ground_planes_[r_last][c_last];
+      prior.params[3] += IDot3(prior.params, shift);
+    }
+  }
+  use_prior_planes_ = true;
+}
+
 const char *PlaneFitGroundDetector::GetLabel() const { return labels_; }
 
 const VoxelGridXY<float> *PlaneFitGroundDetector::GetGrid() const {
@@ -253,6 +253,13 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   unsigned int GetGridDimY() const;
   float GetUnknownHeight();
   PlaneFitPointCandIndices **GetCandis() const;
+  // filter the candidates and compute the point heights on several threads,
+  // the results are the same as on one thread
+  void SetNumThreads(int num_threads);
+  // offer the planes of the last detection to the next one as extra
+  // hypotheses, shift is the origin of the next frame in the coordinates of
+  // the last one, only valid for the next call of Detect
+  void UpdatePriorPlanes(const float *shift);
 
  protected:
   void CleanUp();
@@ -276,10 +283,12 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   float CalculateAngleDist(const GroundPlaneLiDAR &plane,
                            const std::vector<std::pair<int, int>> &neighbors);
   int Filter();
-  int FilterLine(unsigned int r);
+  int FilterLine(unsigned int r, float *sampled_z_values,
+                 int *sampled_indices);
   int FilterGrid(const Voxel<float> &vg, const float *point_cloud,
                  PlaneFitPointCandIndices *candi, unsigned int nr_points,
-                 unsigned int nr_point_element);
+                 unsigned int nr_point_element, float *sampled_z_values,
+                 int *sampled_indices);
   int Smooth();
   int SmoothLine(unsigned int up, unsigned int r, unsigned int dn);
   int CompleteGrid(const GroundPlaneSpherical &lt,
@@ -320,6 +329,13 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   float *pf_threeds_;
   int *sampled_indices_;
   std::pair<int, int> *order_table_;
+  // planes of the last detection moved to the current frame
+  GroundPlaneLiDAR **prior_planes_ = nullptr;
+  bool use_prior_planes_ = false;
+  int num_threads_ = 1;
+  // sampling buffers of the filter threads other than the calling one
+  std::vector<std::vector<float>> thread_sampled_z_values_;
+  std::vector<std::vector<int>> thread_sampled_indices_;
 };
 
 }  // namespace common
@@ -37,6 +37,84 @@ DEFINE_bool(enable_base_object_pool, false, "Enable base object pool.");
 DEFINE_string(config_manager_path, "./conf", "The ModelConfig config paths.");
 DEFINE_string(work_root, "", "Project work root direcotry.");
 
+// pointcloud_preprocessor
+DEFINE_bool(enable_gpu_pointcloud_preprocess, false,
+            "Filter and transform the lidar points in one pass on the gpu.");
+
+// inference
+DEFINE_bool(enable_tensorrt_engine_cache, false,
+            "Load serialized TensorRT engines instead of building them.");
+DEFINE_string(tensorrt_engine_cache_dir,
+              "/apollo/data/perception/tensorrt_engines",
+              "Directory of the serialized TensorRT engines.");
+DEFINE_bool(enable_inference_scheduler, false,
+            "Run model inference one at a time, obstacle models first.");
+
+// hdmap_roi_filter
+DEFINE_bool(enable_hdmap_roi_tile_cache, false,
+            "Keep the roi mask as world tiles and only draw changed tiles.");
+DEFINE_int32(hdmap_roi_tile_cache_capacity, 1024,
+             "Max number of 64x64 cell roi tiles kept in the cache.");
+
+// hdmap_input
+DEFINE_bool(enable_hdmap_tile_cache, false,
+            "Serve hdmap roi queries from prefetched world tiles.");
+DEFINE_double(hdmap_tile_size, 100.0, "Side length of an hdmap tile in m.");
+DEFINE_int32(hdmap_tile_cache_capacity, 32,
+             "Max number of hdmap tiles kept in the cache.");
+
+// camera_obstacle_detection
+DEFINE_int32(camera_obstacle_detection_batch_size, 1,
+             "Number of camera images detected in one network forward.");
+
+// camera_obstacle_tracking
+DEFINE_bool(enable_omt_batched_similarity, false,
+            "Compute the omt appearance similarities of all history frames "
+            "in one gpu product.");
+
+// camera_lane_detection
+DEFINE_bool(enable_gpu_lane_postprocess, false,
+            "Extract the darkSCNN lane points on the gpu.");
+
+// traffic_light_recognition
+DEFINE_int32(traffic_light_recognition_batch_size, 1,
+             "Number of traffic light crops classified in one forward.");
+
+// ground_detector
+DEFINE_int32(ground_detector_num_threads, 1,
+             "Number of threads filtering the ground plane candidates.");
+DEFINE_bool(enable_ground_temporal_prior, false,
+            "Try the ground planes of the last frame when fitting a cell.");
+
+// cnnseg
+DEFINE_int32(cnnseg_spp_num_threads, 1,
+             "Number of threads clustering the spp grid and its points.");
+
+// object_builder
+DEFINE_int32(object_builder_num_threads, 1,
+             "Number of threads building the polygons of the objects.");
+DEFINE_int32(object_builder_hull_prefilter_size, 0,
+             "Clusters with at least this many points drop their inner points "
+             "before computing the convex hull, 0 disables it.");
+
+// fused_classifier
+DEFINE_bool(fused_classifier_online_type_fusion, false,
+            "Whether to fuse the sequence types by forward filtering each "
+            "track instead of the inference over its whole temporal window.");
+DEFINE_int32(fused_classifier_type_history_size, 200,
+             "Number of frames per track kept for the online type fusion to "
+             "rerun the window inference when the filtered type changes.");
+
+// multi_lidar_fusion
+DEFINE_int32(mlf_match_num_threads, 1,
+             "Number of threads computing the track object distances.");
+DEFINE_bool(enable_mlf_match_gating, false,
+            "Stop computing a track object distance once it is too far.");
+
+// fusion
+DEFINE_int32(fusion_association_num_threads, 1,
+             "Number of threads solving the association components.");
+
 // lidar_point_pillars
 DEFINE_int32(gpu_id, 0, "The id of gpu used for inference.");
 DEFINE_string(pfe_torch_file,
@@ -66,6 +144,8 @@ DEFINE_double(downsample_voxel_size_y, 0.01,
               "Y-axis size of voxels used for down sampling point cloud.");
 DEFINE_double(downsample_voxel_size_z, 0.01,
               "Z-axis size of voxels used for down sampling point cloud.");
+DEFINE_int32(downsample_voxel_num_threads, 1,
+             "Number of threads used for down sampling large point clouds.");
 DEFINE_bool(enable_fuse_frames, false,
             "Enable fusing preceding frames' point cloud into current frame.");
 DEFINE_int32(num_fuse_frames, 5,
@@ -80,6 +160,9 @@ DEFINE_bool(reproduce_result_mode, false, "True if preprocess in CPU mode.");
 DEFINE_double(score_threshold, 0.5, "Classification score threshold.");
 DEFINE_double(nms_overlap_threshold, 0.5, "Nms overlap threshold.");
 DEFINE_int32(num_output_box_feature, 7, "Length of output box feature.");
+DEFINE_bool(enable_point_pillars_streams, false,
+            "Upload points from a reused pinned buffer on a copy stream and "
+            "time each inference stage with cuda events.");
 
 // emergency detection onnx
 DEFINE_string(onnx_obstacle_detector_model,
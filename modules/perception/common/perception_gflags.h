@@ -31,6 +31,57 @@ DECLARE_bool(enable_base_object_pool);
 DECLARE_string(config_manager_path);
 DECLARE_string(work_root);
 
+// pointcloud_preprocessor
+DECLARE_bool(enable_gpu_pointcloud_preprocess);
+
+// inference
+DECLARE_bool(enable_tensorrt_engine_cache);
+DECLARE_string(tensorrt_engine_cache_dir);
+DECLARE_bool(enable_inference_scheduler);
+
+// hdmap_roi_filter
+DECLARE_bool(enable_hdmap_roi_tile_cache);
+DECLARE_int32(hdmap_roi_tile_cache_capacity);
+
+// hdmap_input
+DECLARE_bool(enable_hdmap_tile_cache);
+DECLARE_double(hdmap_tile_size);
+DECLARE_int32(hdmap_tile_cache_capacity);
+
+// camera_obstacle_detection
+DECLARE_int32(camera_obstacle_detection_batch_size);
+
+// camera_obstacle_tracking
+DECLARE_bool(enable_omt_batched_similarity);
+
+// camera_lane_detection
+DECLARE_bool(enable_gpu_lane_postprocess);
+
+// traffic_light_recognition
+DECLARE_int32(traffic_light_recognition_batch_size);
+
+// ground_detector
+DECLARE_int32(ground_detector_num_threads);
+DECLARE_bool(enable_ground_temporal_prior);
+
+// cnnseg
+DECLARE_int32(cnnseg_spp_num_threads);
+
+// object_builder
+DECLARE_int32(object_builder_num_threads);
+DECLARE_int32(object_builder_hull_prefilter_size);
+
+// fused_classifier
+DECLARE_bool(fused_classifier_online_type_fusion);
+DECLARE_int32(fused_classifier_type_history_size);
+
+// multi_lidar_fusion
+DECLARE_int32(mlf_match_num_threads);
+DECLARE_bool(enable_mlf_match_gating);
+
+// fusion
+DECLARE_int32(fusion_association_num_threads);
+
 // lidar_point_pillars
 DECLARE_int32(gpu_id);
 DECLARE_string(pfe_torch_file);
@@ -45,6 +96,7 @@ DECLARE_bool(enable_downsample_pointcloud);
 DECLARE_double(downsample_voxel_size_x);
 DECLARE_double(downsample_voxel_size_y);
 DECLARE_double(downsample_voxel_size_z);
+DECLARE_int32(downsample_voxel_num_threads);
 DECLARE_bool(enable_fuse_frames);
 DECLARE_int32(num_fuse_frames);
 DECLARE_double(fuse_time_interval);
@@ -54,6 +106,7 @@ DECLARE_bool(reproduce_result_mode);
 DECLARE_double(score_threshold);
 DECLARE_double(nms_overlap_threshold);
 DECLARE_int32(num_output_box_feature);
+DECLARE_bool(enable_point_pillars_streams);
 
 // emergency detection onnx
 DECLARE_string(onnx_obstacle_detector_model);
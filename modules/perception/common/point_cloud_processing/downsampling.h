@@ -22,6 +22,7 @@
 
 #include "cyber/common/log.h"
 
+#include "modules/common/math/voxel_grid.h"
 #include "modules/perception/base/point_cloud.h"
 #include "modules/perception/common/geometry/basic.h"
 
@@ -225,6 +226,19 @@ void DownsamplingRectangleNeighbour(
   down_cloud->resize(pt_num);
 }
 
+// @brief: replace the points of each voxel with their centroid, the other
+//         fields are taken from the first point of the voxel.
+template <typename PointT>
+bool DownsamplingVoxelGrid(
+    float leaf_x, float leaf_y, float leaf_z,
+    typename std::shared_ptr<const base::PointCloud<PointT>> cloud,
+    typename std::shared_ptr<base::PointCloud<PointT>> down_cloud,
+    int num_threads = 1) {
+  down_cloud->clear();
+  return apollo::common::math::VoxelGridDownsample(
+      *cloud, leaf_x, leaf_y, leaf_z, down_cloud.get(), num_threads);
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
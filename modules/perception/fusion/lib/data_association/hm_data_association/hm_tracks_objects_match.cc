@@ -50,7 +50,7 @@ bool HMTrackersObjectsAssociation::Associate(
   const std::vector<SensorObjectPtr>& sensor_objects =
       sensor_measurements->GetForegroundObjects();
   const std::vector<TrackPtr>& fusion_tracks = scene->GetForegroundTracks();
-  std::vector<std::vector<double>> association_mat;
+  std::vector<std::vector<double>>& association_mat = association_mat_;
 
   if (fusion_tracks.empty() || sensor_objects.empty()) {
     association_result->unassigned_tracks.resize(fusion_tracks.size());
@@ -15,10 +15,12 @@
  *****************************************************************************/
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/fusion/lib/data_association/hm_data_association/track_object_distance.h"
 #include "modules/perception/fusion/lib/interface/base_data_association.h"
 
@@ -37,6 +39,8 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
   bool Init() override {
     track_object_distance_.set_distance_thresh(
         static_cast<float>(s_match_distance_thresh_));
+    optimizer_.set_num_threads(
+        static_cast<size_t>(std::max(1, FLAGS_fusion_association_num_threads)));
     return true;
   }
 
@@ -94,6 +98,8 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
  private:
   common::GatedHungarianMatcher<float> optimizer_;
   TrackObjectDistance track_object_distance_;
+  // kept between frames so the rows are not reallocated
+  std::vector<std::vector<double>> association_mat_;
   static double s_match_distance_thresh_;
   static double s_match_distance_bound_;
   static double s_association_center_dist_threshold_;
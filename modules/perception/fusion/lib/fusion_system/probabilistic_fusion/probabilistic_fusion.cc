@@ -22,6 +22,7 @@
 #include "modules/common/util/perf_util.h"
 #include "modules/common/util/string_util.h"
 #include "modules/perception/base/object_pool_types.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/fusion/base/base_init_options.h"
 #include "modules/perception/fusion/base/track_pool_types.h"
 #include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
@@ -76,6 +77,12 @@ bool ProbabilisticFusion::Init(const FusionInitOptions& init_options) {
   Track::SetMaxCameraInvisiblePeriod(params.max_camera_invisible_period());
   Sensor::SetMaxCachedFrameNumber(params.max_cached_frame_num());
 
+  // allocate the pools fusion draws from every frame ahead of time
+  if (FLAGS_enable_base_object_pool) {
+    base::ObjectPool::Instance().Warmup();
+    TrackPool::Instance().Warmup();
+  }
+
   scenes_.reset(new Scene());
   if (params_.data_association_method == "HMAssociation") {
     matcher_.reset(new HMTrackersObjectsAssociation());
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/inference_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "cyber/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+namespace {
+
+double ElapsedMs(const std::chrono::steady_clock::time_point &start,
+                 const std::chrono::steady_clock::time_point &end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}  // namespace
+
+InferenceScheduler::InferenceScheduler()
+    : enabled_(FLAGS_enable_inference_scheduler) {}
+
+void InferenceScheduler::Infer(const std::string &model_name,
+                               InferencePriority priority, Inference *net) {
+  if (!enabled_) {
+    net->Infer();
+    return;
+  }
+
+  const auto enqueue_time = std::chrono::steady_clock::now();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const Ticket ticket(static_cast<int>(priority), next_sequence_++);
+    waiting_.insert(ticket);
+    cv_.wait(lock, [this, &ticket] {
+      return !busy_ && *waiting_.begin() == ticket;
+    });
+    waiting_.erase(waiting_.begin());
+    busy_ = true;
+  }
+
+  const auto start_time = std::chrono::steady_clock::now();
+  net->Infer();
+  const auto end_time = std::chrono::steady_clock::now();
+
+  const double queue_ms = ElapsedMs(enqueue_time, start_time);
+  const double exec_ms = ElapsedMs(start_time, end_time);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    busy_ = false;
+    UpdateStats(model_name, queue_ms, exec_ms);
+  }
+  cv_.notify_all();
+  ADEBUG << model_name << " queue: " << queue_ms << " ms, exec: " << exec_ms
+         << " ms";
+}
+
+bool InferenceScheduler::GetStats(const std::string &model_name,
+                                  InferenceStats *stats) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = stats_.find(model_name);
+  if (iter == stats_.end()) {
+    return false;
+  }
+  *stats = iter->second;
+  return true;
+}
+
+void InferenceScheduler::UpdateStats(const std::string &model_name,
+                                     double queue_ms, double exec_ms) {
+  auto &stats = stats_[model_name];
+  ++stats.count;
+  stats.total_queue_ms += queue_ms;
+  stats.max_queue_ms = std::max(stats.max_queue_ms, queue_ms);
+  stats.total_exec_ms += exec_ms;
+  stats.max_exec_ms = std::max(stats.max_exec_ms, exec_ms);
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
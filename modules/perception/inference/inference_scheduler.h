@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/common/macros.h"
+#include "modules/perception/inference/inference.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// Smaller values run first when several models wait for the gpu.
+enum class InferencePriority {
+  OBSTACLE = 0,
+  LANE = 1,
+  TRAFFIC_LIGHT = 2,
+};
+
+struct InferenceStats {
+  uint64_t count = 0;
+  double total_queue_ms = 0.0;
+  double max_queue_ms = 0.0;
+  double total_exec_ms = 0.0;
+  double max_exec_ms = 0.0;
+};
+
+// Admits one Infer() at a time, picking the waiting request with the highest
+// priority (then the oldest one), and records per model queueing and
+// execution time. When FLAGS_enable_inference_scheduler is off, Infer() just
+// runs the net on the calling thread.
+class InferenceScheduler {
+ public:
+  void Infer(const std::string &model_name, InferencePriority priority,
+             Inference *net);
+
+  bool GetStats(const std::string &model_name, InferenceStats *stats) const;
+
+  void set_enabled(bool enabled) { enabled_ = enabled; }
+
+ private:
+  // (priority, sequence)
+  using Ticket = std::pair<int, uint64_t>;
+
+  void UpdateStats(const std::string &model_name, double queue_ms,
+                   double exec_ms);
+
+  bool enabled_ = false;
+  bool busy_ = false;
+  uint64_t next_sequence_ = 0;
+  std::set<Ticket> waiting_;
+  std::unordered_map<std::string, InferenceStats> stats_;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+
+  DECLARE_SINGLETON(InferenceScheduler)
+};
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/inference/inference_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+class FakeInference : public Inference {
+ public:
+  FakeInference(int id, std::vector<int> *order, std::mutex *order_mutex)
+      : id_(id), order_(order), order_mutex_(order_mutex) {}
+
+  bool Init(const std::map<std::string, std::vector<int>> &shapes) override {
+    return true;
+  }
+
+  void Infer() override {
+    while (hold_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::lock_guard<std::mutex> lock(*order_mutex_);
+    order_->push_back(id_);
+  }
+
+  std::shared_ptr<base::Blob<float>> get_blob(
+      const std::string &name) override {
+    return nullptr;
+  }
+
+  std::atomic<bool> hold_{false};
+
+ private:
+  int id_;
+  std::vector<int> *order_;
+  std::mutex *order_mutex_;
+};
+
+TEST(InferenceSchedulerTest, priority) {
+  auto scheduler = InferenceScheduler::Instance();
+  std::vector<int> order;
+  std::mutex order_mutex;
+  FakeInference busy(0, &order, &order_mutex);
+  FakeInference lane(1, &order, &order_mutex);
+  FakeInference obstacle(2, &order, &order_mutex);
+
+  scheduler->set_enabled(false);
+  scheduler->Infer("disabled", InferencePriority::LANE, &lane);
+  InferenceStats stats;
+  EXPECT_FALSE(scheduler->GetStats("disabled", &stats));
+  order.clear();
+
+  scheduler->set_enabled(true);
+  busy.hold_ = true;
+  auto busy_done = std::async(std::launch::async, [&] {
+    scheduler->Infer("busy", InferencePriority::OBSTACLE, &busy);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto lane_done = std::async(std::launch::async, [&] {
+    scheduler->Infer("lane", InferencePriority::LANE, &lane);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto obstacle_done = std::async(std::launch::async, [&] {
+    scheduler->Infer("obstacle", InferencePriority::OBSTACLE, &obstacle);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  busy.hold_ = false;
+  busy_done.get();
+  lane_done.get();
+  obstacle_done.get();
+
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order[0], 0);
+  EXPECT_EQ(order[1], 2);
+  EXPECT_EQ(order[2], 1);
+
+  EXPECT_TRUE(scheduler->GetStats("lane", &stats));
+  EXPECT_EQ(stats.count, 1);
+  EXPECT_GT(stats.total_queue_ms, 0.0);
+  EXPECT_TRUE(scheduler->GetStats("busy", &stats));
+  EXPECT_GT(stats.total_exec_ms, 0.0);
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -85,23 +85,26 @@ void TorchNet::Infer() {
   // pay attention to the tensor shape order, if changed without permute
   // will get wrong result
   torch::Tensor tensor_image = torch::from_blob(
-                              blob->data()->mutable_gpu_data(),
-                              {blob->shape(1), blob->shape(2), blob->shape(3)},
-                              torch::kFloat32);
+      blob->data()->mutable_gpu_data(),
+      {blob->shape(0), blob->shape(1), blob->shape(2), blob->shape(3)},
+      torch::kFloat32);
   if (device_id_ >= 0) {
     tensor_image = tensor_image.to(device);
   }
 
-  tensor_image = tensor_image.permute({2, 0, 1});
+  // every image of the batch goes through the same forward
+  tensor_image = tensor_image.permute({0, 3, 1, 2});
   tensor_image = tensor_image.toType(torch::kFloat32);
-  tensor_image[0] = tensor_image[0].div_(58.395);
-  tensor_image[1] = tensor_image[1].div_(57.12);
-  tensor_image[2] = tensor_image[2].div_(57.375);
-  tensor_image = tensor_image.unsqueeze(0);
+  tensor_image.select(1, 0).div_(58.395);
+  tensor_image.select(1, 1).div_(57.12);
+  tensor_image.select(1, 2).div_(57.375);
 
   torch::Tensor output = net_.forward({tensor_image}).toTensor();
-  torch::Tensor prob = torch::softmax(output, 1);
-  blobs_[output_names_[0]]->data()->set_gpu_data(prob.data_ptr());
+  prob_ = torch::softmax(output, 1).contiguous();
+  auto output_blob = blobs_[output_names_[0]];
+  output_blob->Reshape({static_cast<int>(prob_.size(0)),
+                        static_cast<int>(prob_.size(1)), 1, 1});
+  output_blob->data()->set_gpu_data(prob_.data_ptr());
   c10::cuda::CUDACachingAllocator::emptyCache();
 }
 
@@ -60,6 +60,9 @@ class TorchNet : public Inference {
   std::vector<std::string> input_names_;
   BlobMap blobs_;
 
+  // keeps the output memory alive until the next forward
+  torch::Tensor prob_;
+
   torch::DeviceType device_type_;
   int device_id_ = 0;
 };
@@ -17,10 +17,14 @@
 #include "modules/perception/inference/tensorrt/rt_net.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <utility>
 
 #include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
 #include "cyber/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/inference/tensorrt/plugins/argmax_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/leakyReLU_plugin.h"
 #include "modules/perception/inference/tensorrt/plugins/slice_plugin.h"
@@ -39,6 +43,48 @@ namespace apollo {
 namespace perception {
 namespace inference {
 
+namespace {
+
+// the custom plugins keep no serialized state, a deserialized engine gets
+// the plugins which were created while parsing the same network
+class CachedPluginFactory : public nvinfer1::IPluginFactory {
+ public:
+  explicit CachedPluginFactory(
+      const std::map<std::string, nvinfer1::IPlugin *> *plugin_layers)
+      : plugin_layers_(plugin_layers) {}
+
+  nvinfer1::IPlugin *createPlugin(const char *layerName,
+                                  const void *serialData,
+                                  size_t serialLength) override {
+    auto iter = plugin_layers_->find(layerName);
+    if (iter == plugin_layers_->end()) {
+      AERROR << "Unknown plugin layer " << layerName;
+      return nullptr;
+    }
+    return iter->second;
+  }
+
+ private:
+  const std::map<std::string, nvinfer1::IPlugin *> *plugin_layers_;
+};
+
+// FNV-1a
+void HashBytes(const void *data, size_t size, uint64_t *hash) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    *hash ^= bytes[i];
+    *hash *= 0x100000001b3ULL;
+  }
+}
+
+void HashString(const std::string &str, uint64_t *hash) {
+  HashBytes(str.data(), str.size(), hash);
+  const size_t size = str.size();
+  HashBytes(&size, sizeof(size), hash);
+}
+
+}  // namespace
+
 void RTNet::ConstructMap(const LayerParameter &layer_param,
                          nvinfer1::ILayer *layer, TensorMap *tensor_map,
                          TensorModifyMap *tensor_modify_map) {
@@ -165,6 +211,7 @@ void RTNet::addActiveLayer(const LayerParameter &layer_param,
         net->addPlugin(inputs, nbInputs, *relu_plugin);
     relu_plugins_.push_back(relu_plugin);
     ReLU_Layer->setName(layer_param.name().c_str());
+    plugin_layers_[layer_param.name()] = relu_plugin.get();
     ConstructMap(layer_param, ReLU_Layer, tensor_map, tensor_modify_map);
   } else {
     nvinfer1::ActivationType type = nvinfer1::ActivationType::kSIGMOID;
@@ -240,6 +287,7 @@ void RTNet::addSliceLayer(const LayerParameter &layer_param,
       net->addPlugin(inputs, nbInputs, *slice_plugin);
   slice_plugins_.push_back(slice_plugin);
   sliceLayer->setName(layer_param.name().c_str());
+  plugin_layers_[layer_param.name()] = slice_plugin.get();
   ConstructMap(layer_param, sliceLayer, tensor_map, tensor_modify_map);
 }
 
@@ -321,6 +369,7 @@ void RTNet::addSoftmaxLayer(const LayerParameter &layer_param,
     nvinfer1::IPluginLayer *softmaxLayer =
         net->addPlugin(inputs, nbInputs, *softmax_plugin);
     softmaxLayer->setName(layer_param.name().c_str());
+    plugin_layers_[layer_param.name()] = softmax_plugin.get();
 
     ConstructMap(layer_param, softmaxLayer, tensor_map, tensor_modify_map);
   } else {
@@ -360,6 +409,7 @@ void RTNet::addArgmaxLayer(const LayerParameter &layer_param,
       net->addPlugin(inputs, nbInputs, *argmax_plugin);
 
   argmaxLayer->setName(layer_param.name().c_str());
+  plugin_layers_[layer_param.name()] = argmax_plugin.get();
   ConstructMap(layer_param, argmaxLayer, tensor_map, tensor_modify_map);
 }
 
@@ -378,6 +428,7 @@ void RTNet::addPermuteLayer(const LayerParameter &layer_param,
   permuteLayer = net->addPlugin(inputs, nbInputs, *mplugin);
 
   permuteLayer->setName(layer_param.name().c_str());
+  plugin_layers_[layer_param.name()] = mplugin;
   ConstructMap(layer_param, permuteLayer, tensor_map, tensor_modify_map);
 }
 
@@ -644,13 +695,115 @@ bool RTNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
 
   builder_->setDebugSync(true);
 
-  nvinfer1::ICudaEngine *engine = builder_->buildCudaEngine(*network_);
+  nvinfer1::ICudaEngine *engine = nullptr;
+  std::string engine_file;
+  if (FLAGS_enable_tensorrt_engine_cache) {
+    engine_file = engineCacheFile(prop, int8_mode, shapes);
+    engine = loadEngine(engine_file);
+  }
+  if (engine == nullptr) {
+    engine = builder_->buildCudaEngine(*network_);
+    if (engine == nullptr) {
+      AERROR << "Failed to build TensorRT engine.";
+      return false;
+    }
+    if (FLAGS_enable_tensorrt_engine_cache) {
+      saveEngine(engine_file, engine);
+    }
+  }
   context_ = engine->createExecutionContext();
   buffers_.resize(input_names_.size() + output_names_.size());
   init_blob(&input_names_);
   init_blob(&output_names_);
   return true;
 }
+std::string RTNet::engineCacheFile(
+    const cudaDeviceProp &prop, bool int8_mode,
+    const std::map<std::string, std::vector<int>> &shapes) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  HashString(net_param_->SerializeAsString(), &hash);
+  for (const auto &layer : weight_map_) {
+    HashString(layer.first, &hash);
+    for (const auto &wt : layer.second) {
+      // loadLayerWeights always stores floats
+      HashBytes(wt.values, wt.count * sizeof(float), &hash);
+    }
+  }
+  for (const auto &shape : shapes) {
+    HashString(shape.first, &hash);
+    HashBytes(shape.second.data(), shape.second.size() * sizeof(int), &hash);
+  }
+  HashBytes(&max_batch_size_, sizeof(max_batch_size_), &hash);
+  HashBytes(&workspaceSize_, sizeof(workspaceSize_), &hash);
+  if (int8_mode) {
+    // a new calibration table gives a new engine
+    size_t length = 0;
+    const void *table = calibrator_->readCalibrationCache(length);
+    if (table == nullptr) {
+      AWARN << "No int8 calibration table, the engine calibrates at build.";
+    } else {
+      HashBytes(table, length, &hash);
+    }
+  }
+
+  // the engine only runs on the gpu arch and TensorRT it was built for
+  return absl::StrCat(FLAGS_tensorrt_engine_cache_dir, "/", absl::Hex(hash),
+                      "_sm", prop.major, prop.minor, "_trt",
+                      getInferLibVersion(), int8_mode ? "_int8" : "_fp32",
+                      ".engine");
+}
+
+nvinfer1::ICudaEngine *RTNet::loadEngine(const std::string &engine_file) {
+  std::string engine_data;
+  if (!cyber::common::PathExists(engine_file) ||
+      !cyber::common::GetContent(engine_file, &engine_data)) {
+    AINFO << "No cached TensorRT engine " << engine_file;
+    return nullptr;
+  }
+  if (runtime_ == nullptr) {
+    runtime_ = nvinfer1::createInferRuntime(rt_gLogger);
+  }
+  CachedPluginFactory plugin_factory(&plugin_layers_);
+  nvinfer1::ICudaEngine *engine = runtime_->deserializeCudaEngine(
+      engine_data.data(), engine_data.size(), &plugin_factory);
+  if (engine == nullptr) {
+    AWARN << "Failed to deserialize cached TensorRT engine " << engine_file;
+    return nullptr;
+  }
+  AINFO << "Loaded cached TensorRT engine " << engine_file;
+  return engine;
+}
+
+void RTNet::saveEngine(const std::string &engine_file,
+                       nvinfer1::ICudaEngine *engine) {
+  if (!cyber::common::EnsureDirectory(FLAGS_tensorrt_engine_cache_dir)) {
+    AWARN << "Failed to create " << FLAGS_tensorrt_engine_cache_dir;
+    return;
+  }
+  nvinfer1::IHostMemory *engine_data = engine->serialize();
+  if (engine_data == nullptr) {
+    AWARN << "Failed to serialize TensorRT engine.";
+    return;
+  }
+  // write aside and rename, so that another process never reads a partial
+  // engine
+  const std::string tmp_file = engine_file + ".tmp";
+  bool ok = false;
+  {
+    std::ofstream output(tmp_file, std::ios::binary);
+    output.write(static_cast<const char *>(engine_data->data()),
+                 engine_data->size());
+    ok = output.good();
+  }
+  engine_data->destroy();
+  if (!ok || std::rename(tmp_file.c_str(), engine_file.c_str()) != 0) {
+    AWARN << "Failed to write TensorRT engine " << engine_file;
+    std::remove(tmp_file.c_str());
+    return;
+  }
+  AINFO << "Saved TensorRT engine " << engine_file;
+}
+
 bool RTNet::checkInt8(const std::string &gpu_name,
                       nvinfer1::IInt8Calibrator *calibrator) {
   if (calibrator == nullptr) {
@@ -734,6 +887,9 @@ RTNet::~RTNet() {
     network_->destroy();
     builder_->destroy();
     context_->destroy();
+    if (runtime_ != nullptr) {
+      runtime_->destroy();
+    }
     for (auto buf : buffers_) {
       cudaFree(buf);
     }
@@ -175,6 +175,14 @@ class RTNet : public Inference {
   bool loadWeights(const std::string &model_file, WeightMap *weight_map);
   void init_blob(std::vector<std::string> *names);
 
+  // engine cache, the file name hashes everything the built engine depends on
+  std::string engineCacheFile(
+      const cudaDeviceProp &prop, bool int8_mode,
+      const std::map<std::string, std::vector<int>> &shapes);
+  nvinfer1::ICudaEngine *loadEngine(const std::string &engine_file);
+  void saveEngine(const std::string &engine_file,
+                  nvinfer1::ICudaEngine *engine);
+
  private:
   nvinfer1::IExecutionContext *context_ = nullptr;
   cudaStream_t stream_ = 0;
@@ -195,6 +203,10 @@ class RTNet : public Inference {
   std::string model_root_;
   nvinfer1::IBuilder *builder_ = nullptr;
   nvinfer1::INetworkDefinition *network_ = nullptr;
+  nvinfer1::IRuntime *runtime_ = nullptr;
+  // plugins of the parsed network by layer name, handed back to a
+  // deserialized engine
+  std::map<std::string, nvinfer1::IPlugin *> plugin_layers_;
   std::vector<std::shared_ptr<float>> weights_mem_;
   BlobMap blobs_;
 };
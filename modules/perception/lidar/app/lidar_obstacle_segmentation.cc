@@ -20,6 +20,7 @@
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/app/proto/lidar_obstacle_segmentation_config.pb.h"
 #include "modules/perception/lidar/common/lidar_log.h"
+#include "modules/perception/lidar/common/lidar_timer.h"
 #include "modules/perception/lidar/lib/scene_manager/scene_manager.h"
 
 namespace apollo {
@@ -88,7 +89,9 @@ LidarProcessResult LidarObstacleSegmentation::Process(
   PointCloudPreprocessorOptions preprocessor_options;
   preprocessor_options.sensor2novatel_extrinsics =
       options.sensor2novatel_extrinsics;
+  Timer timer;
   if (cloud_preprocessor_.Preprocess(preprocessor_options, frame)) {
+    frame->timing.preprocess = timer.toc();
     return ProcessCommon(options, frame);
   }
   return LidarProcessResult(LidarErrorCode::PointCloudPreprocessorError,
@@ -108,7 +111,9 @@ LidarProcessResult LidarObstacleSegmentation::Process(
   preprocessor_options.sensor2novatel_extrinsics =
       options.sensor2novatel_extrinsics;
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "preprocess");
+  Timer timer;
   if (cloud_preprocessor_.Preprocess(preprocessor_options, message, frame)) {
+    frame->timing.preprocess = timer.toc();
     return ProcessCommon(options, frame);
   }
   return LidarProcessResult(LidarErrorCode::PointCloudPreprocessorError,
@@ -120,6 +125,7 @@ LidarProcessResult LidarObstacleSegmentation::ProcessCommon(
   const auto& sensor_name = options.sensor_name;
 
   PERF_BLOCK_START();
+  Timer timer;
   if (use_map_manager_) {
     MapManagerOptions map_manager_options;
     if (!map_manager_.Update(map_manager_options, frame)) {
@@ -128,6 +134,7 @@ LidarProcessResult LidarObstacleSegmentation::ProcessCommon(
     }
   }
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "map_manager");
+  frame->timing.map_manager = timer.toc(true);
 
   SegmentationOptions segmentation_options;
   if (!segmentor_->Segment(segmentation_options, frame)) {
@@ -135,6 +142,7 @@ LidarProcessResult LidarObstacleSegmentation::ProcessCommon(
                               "Failed to segment.");
   }
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "segmentation");
+  frame->timing.segmentation = timer.toc(true);
 
   ObjectBuilderOptions builder_options;
   if (!builder_.Build(builder_options, frame)) {
@@ -142,6 +150,7 @@ LidarProcessResult LidarObstacleSegmentation::ProcessCommon(
                               "Failed to build objects.");
   }
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "object_builder");
+  frame->timing.object_builder = timer.toc(true);
 
   ObjectFilterOptions filter_options;
   if (!filter_bank_.Filter(filter_options, frame)) {
@@ -149,7 +158,10 @@ LidarProcessResult LidarObstacleSegmentation::ProcessCommon(
                               "Failed to filter objects.");
   }
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "filter_bank");
+  frame->timing.filter_bank = timer.toc(true);
 
+  AINFO << sensor_name << " copied " << frame->copied_bytes
+        << " bytes of points";
   return LidarProcessResult(LidarErrorCode::Succeed);
 }
 
@@ -20,6 +20,7 @@
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/app/proto/lidar_obstacle_tracking_config.pb.h"
 #include "modules/perception/lidar/common/lidar_log.h"
+#include "modules/perception/lidar/common/lidar_timer.h"
 
 namespace apollo {
 namespace perception {
@@ -67,12 +68,14 @@ LidarProcessResult LidarObstacleTracking::Process(
   PERF_FUNCTION_WITH_INDICATOR(sensor_name);
 
   PERF_BLOCK_START();
+  Timer timer;
   MultiTargetTrackerOptions tracker_options;
   if (!multi_target_tracker_->Track(tracker_options, frame)) {
     return LidarProcessResult(LidarErrorCode::TrackerError,
                               "Fail to track objects.");
   }
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "tracker");
+  frame->timing.tracker = timer.toc(true);
 
   ClassifierOptions fusion_classifier_options;
   if (!fusion_classifier_->Classify(fusion_classifier_options, frame)) {
@@ -80,6 +83,7 @@ LidarProcessResult LidarObstacleTracking::Process(
                               "Fail to fuse object types.");
   }
   PERF_BLOCK_END_WITH_INDICATOR(sensor_name, "type_fusion");
+  frame->timing.type_fusion = timer.toc(true);
 
   return LidarProcessResult(LidarErrorCode::Succeed);
 }
@@ -30,6 +30,19 @@ namespace apollo {
 namespace perception {
 namespace lidar {
 
+// processing time of the pipeline stages in ms
+struct LidarFrameTiming {
+  double preprocess = 0.0;
+  double map_manager = 0.0;
+  double roi_filter = 0.0;
+  double ground_detector = 0.0;
+  double segmentation = 0.0;
+  double object_builder = 0.0;
+  double filter_bank = 0.0;
+  double tracker = 0.0;
+  double type_fusion = 0.0;
+};
+
 struct LidarFrame {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
@@ -59,6 +72,10 @@ struct LidarFrame {
   base::SensorInfo sensor_info;
   // reserve string
   std::string reserve;
+  // bytes of points copied while processing the frame
+  size_t copied_bytes = 0;
+  // stage timing
+  LidarFrameTiming timing;
 
   void Reset() {
     if (cloud) {
@@ -81,6 +98,13 @@ struct LidarFrame {
     roi_indices.indices.clear();
     non_ground_indices.indices.clear();
     secondary_indices.indices.clear();
+    copied_bytes = 0;
+    timing = LidarFrameTiming();
+  }
+
+  template <typename PointT>
+  void RecordCopy(const base::PointCloud<PointT> &copy) {
+    copied_bytes += copy.size() * copy.point_bytes();
   }
 
   void FilterPointCloud(base::PointCloud<base::PointF> *filtered_cloud,
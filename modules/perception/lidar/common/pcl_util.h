@@ -17,10 +17,10 @@
 
 #include <string>
 
-#include "pcl/filters/voxel_grid.h"
 #include "pcl/io/pcd_io.h"
 #include "pcl/point_types.h"
 
+#include "modules/common/math/voxel_grid.h"
 #include "modules/perception/base/point_cloud.h"
 #include "modules/perception/lidar/common/lidar_log.h"
 
@@ -125,10 +125,9 @@ inline void DownSampleCloudByVoxelGrid(
     const pcl::PointCloud<pcl::PointXYZI>::Ptr& cloud_ptr,
     const pcl::PointCloud<pcl::PointXYZI>::Ptr& filtered_cloud_ptr,
     float lx = 0.01f, float ly = 0.01f, float lz = 0.01f) {
-  pcl::VoxelGrid<pcl::PointXYZI> voxel_grid;
-  voxel_grid.setInputCloud(cloud_ptr);
-  voxel_grid.setLeafSize(lx, ly, lz);
-  voxel_grid.filter(*filtered_cloud_ptr);
+  filtered_cloud_ptr->clear();
+  apollo::common::math::VoxelGridDownsample(*cloud_ptr, lx, ly, lz,
+                                            filtered_cloud_ptr.get());
 }
 
 }  // namespace lidar
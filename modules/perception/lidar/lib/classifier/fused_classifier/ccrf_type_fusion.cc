@@ -15,12 +15,14 @@
  *****************************************************************************/
 #include "modules/perception/lidar/lib/classifier/fused_classifier/ccrf_type_fusion.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "cyber/common/file.h"
 #include "cyber/common/log.h"
 #include "modules/perception/base/object_types.h"
 #include "modules/perception/base/point_cloud.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/proto/ccrf_type_fusion_config.pb.h"
 
@@ -35,6 +37,11 @@ using ObjectPtr = std::shared_ptr<apollo::perception::base::Object>;
 using apollo::cyber::common::GetAbsolutePath;
 using apollo::perception::base::ObjectType;
 
+namespace {
+// same as the time out of the object sequence
+constexpr double kMaxTrackTimeOut = 5.0;
+}  // namespace
+
 bool CCRFOneShotTypeFusion::Init(const TypeFusionInitOption& option) {
   auto config_manager = lib::ConfigManager::Instance();
   const lib::ModelConfig* model_config = nullptr;
@@ -156,6 +163,9 @@ bool CCRFSequenceTypeFusion::Init(const TypeFusionInitOption& option) {
     }
   }
   AINFO << std::endl << transition_matrix_;
+  history_size_ = static_cast<size_t>(
+      std::max(FLAGS_fused_classifier_type_history_size, 1));
+  track_states_.clear();
   return true;
 }
 
@@ -185,8 +195,16 @@ bool CCRFSequenceTypeFusion::FuseWithConditionalProbabilityInference(
     }
   }
 
+  InferSequenceProbs();
+  ObjectPtr object = tracked_objects->rbegin()->second;
+  RecoverFromLogProbability(&fused_sequence_probs_.back(), &object->type_probs,
+                            &object->type);
+  return true;
+}
+
+void CCRFSequenceTypeFusion::InferSequenceProbs() {
   // Use viterbi algorithm to infer the state
-  std::size_t length = tracked_objects->size();
+  std::size_t length = fused_oneshot_probs_.size();
   fused_sequence_probs_.resize(length);
   state_back_trace_.resize(length);
 
@@ -195,29 +213,112 @@ bool CCRFSequenceTypeFusion::FuseWithConditionalProbabilityInference(
   fused_sequence_probs_[0] += transition_matrix_.row(0).transpose();
 
   for (std::size_t i = 1; i < length; ++i) {
-    for (std::size_t right = 0; right < VALID_OBJECT_TYPE; ++right) {
-      double prob = 0.0;
-      double max_prob = -std::numeric_limits<double>::max();
-      std::size_t id = 0;
-      for (std::size_t left = 0; left < VALID_OBJECT_TYPE; ++left) {
-        prob = fused_sequence_probs_[i - 1](left) +
-               transition_matrix_(left, right) * s_alpha_ +
-               fused_oneshot_probs_[i](right);
-        if (prob > max_prob) {
-          max_prob = prob;
-          id = left;
-        }
+    ForwardStep(fused_sequence_probs_[i - 1], fused_oneshot_probs_[i],
+                &fused_sequence_probs_[i], &state_back_trace_[i]);
+  }
+}
+
+void CCRFSequenceTypeFusion::ForwardStep(const Vectord& left_probs,
+                                         const Vectord& oneshot_probs,
+                                         Vectord* right_probs,
+                                         Vectori* back_trace) const {
+  for (std::size_t right = 0; right < VALID_OBJECT_TYPE; ++right) {
+    double prob = 0.0;
+    double max_prob = -std::numeric_limits<double>::max();
+    std::size_t id = 0;
+    for (std::size_t left = 0; left < VALID_OBJECT_TYPE; ++left) {
+      prob = left_probs(left) + transition_matrix_(left, right) * s_alpha_ +
+             oneshot_probs(right);
+      if (prob > max_prob) {
+        max_prob = prob;
+        id = left;
       }
-      fused_sequence_probs_[i](right) = max_prob;
-      state_back_trace_[i](right) = static_cast<int>(id);
     }
+    (*right_probs)(right) = max_prob;
+    (*back_trace)(right) = static_cast<int>(id);
   }
-  ObjectPtr object = tracked_objects->rbegin()->second;
-  RecoverFromLogProbability(&fused_sequence_probs_.back(), &object->type_probs,
-                            &object->type);
+}
+
+bool CCRFSequenceTypeFusion::OnlineTypeFusion(const TypeFusionOption& option,
+                                              double timestamp,
+                                              ObjectPtr object) {
+  if (object == nullptr) {
+    return false;
+  }
+  if (timestamp > current_timestamp_) {
+    current_timestamp_ = timestamp;
+    RemoveStaleTracks(timestamp);
+  }
+  auto iter = track_states_.find(object->track_id);
+  if (iter != track_states_.end() && timestamp <= iter->second.timestamp) {
+    AERROR << "There must exist some timestamp in disorder, so skip.";
+    return true;
+  }
+  Vectord oneshot_probs;
+  if (!one_shot_fuser_.FuseOneShotTypeProbs(object, &oneshot_probs)) {
+    AERROR << "Failed to fuse one short probs in sequence.";
+    return false;
+  }
+
+  if (iter == track_states_.end()) {
+    iter = track_states_.emplace(object->track_id, TrackTypeState()).first;
+    TrackTypeState& state = iter->second;
+    state.oneshot_probs.resize(history_size_);
+    state.timestamps.resize(history_size_);
+    state.belief = oneshot_probs + transition_matrix_.row(0).transpose();
+  } else {
+    TrackTypeState& state = iter->second;
+    Vectord belief;
+    Vectori back_trace;
+    ForwardStep(state.belief, oneshot_probs, &belief, &back_trace);
+    state.belief = belief;
+  }
+  TrackTypeState& state = iter->second;
+  // keep the magnitude bounded, the recovered probabilities do not change
+  state.belief.array() -= state.belief.maxCoeff();
+  state.timestamp = timestamp;
+  const size_t tail = (state.head + state.size) % history_size_;
+  state.oneshot_probs[tail] = oneshot_probs;
+  state.timestamps[tail] = timestamp;
+  if (state.size < history_size_) {
+    ++state.size;
+  } else {
+    state.head = (state.head + 1) % history_size_;
+  }
+
+  const bool new_track = state.size == 1;
+  Vectord prob = state.belief;
+  RecoverFromLogProbability(&prob, &object->type_probs, &object->type);
+  if (!new_track && object->type != state.type) {
+    // confirm the change with the inference over the temporal window
+    fused_oneshot_probs_.clear();
+    const double start_time = timestamp - option.temporal_window;
+    for (size_t i = 0; i < state.size; ++i) {
+      const size_t index = (state.head + i) % history_size_;
+      if (state.timestamps[index] >= start_time) {
+        fused_oneshot_probs_.push_back(state.oneshot_probs[index]);
+      }
+    }
+    InferSequenceProbs();
+    state.belief = fused_sequence_probs_.back();
+    state.belief.array() -= state.belief.maxCoeff();
+    prob = state.belief;
+    RecoverFromLogProbability(&prob, &object->type_probs, &object->type);
+  }
+  state.type = object->type;
   return true;
 }
 
+void CCRFSequenceTypeFusion::RemoveStaleTracks(double timestamp) {
+  for (auto iter = track_states_.begin(); iter != track_states_.end();) {
+    if (timestamp - iter->second.timestamp > kMaxTrackTimeOut) {
+      iter = track_states_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
 bool CCRFSequenceTypeFusion::RecoverFromLogProbability(Vectord* prob,
                                                        std::vector<float>* dst,
                                                        ObjectType* type) {
@@ -52,6 +52,11 @@ class CCRFSequenceTypeFusion : public BaseSequenceTypeFusion {
   bool Init(const TypeFusionInitOption& option) override;
   bool TypeFusion(const TypeFusionOption& option,
                   TrackedObjects* tracked_objects) override;
+  // Forward filtering in O(1) per frame, the window inference only runs on
+  // the stored history when the filtered type changes.
+  bool OnlineTypeFusion(
+      const TypeFusionOption& option, double timestamp,
+      std::shared_ptr<perception::base::Object> object) override;
   std::string Name() const override { return "CCRFSequenceTypeFusion"; }
 
  protected:
@@ -68,6 +73,12 @@ class CCRFSequenceTypeFusion : public BaseSequenceTypeFusion {
 
   // window version of Chain-CRFs inference
   bool FuseWithConditionalProbabilityInference(TrackedObjects* tracked_objects);
+  // chain inference over fused_oneshot_probs_, result in the last of
+  // fused_sequence_probs_
+  void InferSequenceProbs();
+  void ForwardStep(const Vectord& left_probs, const Vectord& oneshot_probs,
+                   Vectord* right_probs, Vectori* back_trace) const;
+  void RemoveStaleTracks(double timestamp);
   // util
   bool RecoverFromLogProbability(Vectord* prob, std::vector<float>* dst,
                                  perception::base::ObjectType* type);
@@ -82,6 +93,22 @@ class CCRFSequenceTypeFusion : public BaseSequenceTypeFusion {
   apollo::common::EigenVector<Vectord> fused_sequence_probs_;
   apollo::common::EigenVector<Vectori> state_back_trace_;
 
+  // data member for online version
+  struct TrackTypeState {
+    // max-product forward message, in the log space
+    Vectord belief;
+    perception::base::ObjectType type = perception::base::ObjectType::UNKNOWN;
+    double timestamp = 0.0;
+    // ring of the fused one shot probs of the latest frames
+    apollo::common::EigenVector<Vectord> oneshot_probs;
+    std::vector<double> timestamps;
+    size_t head = 0;
+    size_t size = 0;
+  };
+  apollo::common::EigenMap<int, TrackTypeState> track_states_;
+  double current_timestamp_ = 0.0;
+  size_t history_size_ = 200;
+
  protected:
   double s_alpha_ = 1.8;
 };
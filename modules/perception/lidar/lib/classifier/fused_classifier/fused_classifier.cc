@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "cyber/common/file.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/proto/fused_classifier_config.pb.h"
 
 namespace apollo {
@@ -41,6 +42,7 @@ bool FusedClassifier::Init(const ClassifierInitOptions& options) {
   FusedClassifierConfig config;
   ACHECK(cyber::common::GetProtoFromFile(config_file, &config));
   temporal_window_ = config.temporal_window();
+  option_.temporal_window = temporal_window_;
   enable_temporal_fusion_ = config.enable_temporal_fusion();
   use_tracked_objects_ = config.use_tracked_objects();
   one_shot_fusion_method_ = config.one_shot_fusion_method();
@@ -65,7 +67,26 @@ bool FusedClassifier::Classify(const ClassifierOptions& options,
   std::vector<ObjectPtr>* objects = use_tracked_objects_
                                         ? &(frame->tracked_objects)
                                         : &(frame->segmented_objects);
-  if (enable_temporal_fusion_ && frame->timestamp > 0.0) {
+  if (enable_temporal_fusion_ && frame->timestamp > 0.0 &&
+      FLAGS_fused_classifier_online_type_fusion) {
+    // online sequence fusion, no history kept here
+    AINFO << "Combined classifier, online temporal fusion";
+    for (auto& object : *objects) {
+      if (object->lidar_supplement.is_background) {
+        object->type_probs.assign(static_cast<int>(ObjectType::MAX_OBJECT_TYPE),
+                                  0);
+        object->type = ObjectType::UNKNOWN_UNMOVABLE;
+        object->type_probs[static_cast<int>(ObjectType::UNKNOWN_UNMOVABLE)] =
+            1.0;
+        continue;
+      }
+      if (!sequence_fuser_->OnlineTypeFusion(option_, frame->timestamp,
+                                             object)) {
+        AERROR << "Failed to fuse types, so break.";
+        break;
+      }
+    }
+  } else if (enable_temporal_fusion_ && frame->timestamp > 0.0) {
     // sequence fusion
     AINFO << "Combined classifier, temporal fusion";
     sequence_.AddTrackedFrameObjects(*objects, frame->timestamp);
@@ -45,6 +45,7 @@ class FusedClassifier : public BaseClassifier {
   FRIEND_TEST(FusedClassifierTest, test_one_shot_fusion);
   FRIEND_TEST(FusedClassifierTest, test_one_sequence_fusion);
   FRIEND_TEST(FusedClassifierTest, test_one_sequence_fusion_bad_timestamp);
+  FRIEND_TEST(FusedClassifierTest, test_online_sequence_fusion);
   ObjectSequence sequence_;
   double temporal_window_ = 20.0;
   bool enable_temporal_fusion_ = true;
@@ -243,6 +243,29 @@ TEST_F(FusedClassifierTest, test_one_sequence_fusion) {
   }
 }
 
+TEST_F(FusedClassifierTest, test_online_sequence_fusion) {
+  FLAGS_fused_classifier_online_type_fusion = true;
+  fused_classifier_->Init();
+  fused_classifier_->enable_temporal_fusion_ = true;
+  std::vector<BaseSequenceTypeFusion*> instances =
+      BaseSequenceTypeFusionRegisterer::GetAllInstances();
+  ClassifierOptions options;
+  TypeFusionInitOption init_option;
+  for (auto& i : instances) {
+    fused_classifier_->sequence_fuser_ = i;
+    EXPECT_TRUE(fused_classifier_->sequence_fuser_->Init(init_option));
+    for (size_t n = 0; n < kSequenceLength; ++n) {
+      frames_[n].timestamp = timestamps_[n];
+      EXPECT_TRUE(fused_classifier_->Classify(options, &frames_[n]));
+      for (size_t j = 0; j < kObjectNum - 1; ++j) {
+        EXPECT_EQ(static_cast<size_t>(frames_[n].segmented_objects[j]->type),
+                  IdMap(j));
+      }
+    }
+  }
+  FLAGS_fused_classifier_online_type_fusion = false;
+}
+
 TEST_F(FusedClassifierTest, test_one_sequence_fusion_bad_timestamp) {
   BuildObjectsBadTimestamp();
   for (auto& frame : frames_) {
@@ -28,7 +28,10 @@ namespace lidar {
 
 struct TypeFusionInitOption {};
 
-struct TypeFusionOption {};
+struct TypeFusionOption {
+  // only used by the online sequence fusion
+  double temporal_window = 20.0;
+};
 
 class BaseOneShotTypeFusion {
  public:
@@ -50,6 +53,13 @@ class BaseSequenceTypeFusion {
   virtual bool Init(const TypeFusionInitOption& option) = 0;
   virtual bool TypeFusion(const TypeFusionOption& option,
                           TrackedObjects* tracked_objects) = 0;
+  // Fuse the type of object with the belief kept for its track, updated with
+  // this object only. Returns false if the fusion does not support it.
+  virtual bool OnlineTypeFusion(
+      const TypeFusionOption& option, double timestamp,
+      std::shared_ptr<perception::base::Object> object) {
+    return false;
+  }
   virtual std::string Name() const = 0;
 };
 
@@ -32,6 +32,7 @@
 
 // headers in STL
 #include <chrono>
+#include <cstring>
 #include <iostream>
 
 #include "cyber/common/log.h"
@@ -102,12 +103,14 @@ PointPillars::PointPillars(const bool reproduce_result_mode,
                            const float score_threshold,
                            const float nms_overlap_threshold,
                            const std::string pfe_torch_file,
-                           const std::string rpn_onnx_file)
+                           const std::string rpn_onnx_file,
+                           const bool enable_streams)
     : reproduce_result_mode_(reproduce_result_mode),
       score_threshold_(score_threshold),
       nms_overlap_threshold_(nms_overlap_threshold),
       pfe_torch_file_(pfe_torch_file),
-      rpn_onnx_file_(rpn_onnx_file) {
+      rpn_onnx_file_(rpn_onnx_file),
+      enable_streams_(enable_streams) {
   if (reproduce_result_mode_) {
     preprocess_points_ptr_.reset(new PreprocessPoints(
         kMaxNumPillars, kMaxNumPointsPerPillar, kNumPointFeature, kGridXSize,
@@ -138,6 +141,14 @@ PointPillars::PointPillars(const bool reproduce_result_mode,
   InitTorch();
   InitTRT();
   InitAnchors();
+
+  if (enable_streams_) {
+    GPU_CHECK(cudaStreamCreate(&copy_stream_));
+    GPU_CHECK(cudaStreamCreate(&compute_stream_));
+    for (int i = 0; i < kNumStageEvents; ++i) {
+      GPU_CHECK(cudaEventCreate(&stage_events_[i]));
+    }
+  }
 }
 
 PointPillars::~PointPillars() {
@@ -197,6 +208,68 @@ PointPillars::~PointPillars() {
   rpn_context_->destroy();
   rpn_runtime_->destroy();
   rpn_engine_->destroy();
+
+  if (enable_streams_) {
+    GPU_CHECK(cudaFreeHost(host_points_));
+    GPU_CHECK(cudaFree(dev_points_));
+    for (int i = 0; i < kNumStageEvents; ++i) {
+      GPU_CHECK(cudaEventDestroy(stage_events_[i]));
+    }
+    GPU_CHECK(cudaStreamDestroy(copy_stream_));
+    GPU_CHECK(cudaStreamDestroy(compute_stream_));
+  }
+}
+
+float* PointPillars::MutablePinnedPoints(const int num_points) {
+  if (!enable_streams_) {
+    return nullptr;
+  }
+  ReservePointsBuffers(num_points);
+  // points outside the detection range are skipped by the caller and must
+  // read as zero, like the value initialized array of the pageable path
+  memset(host_points_, 0, num_points * kNumPointFeature * sizeof(float));
+  return host_points_;
+}
+
+void PointPillars::ReservePointsBuffers(const int num_points) {
+  if (num_points <= points_capacity_) {
+    return;
+  }
+  // grow with some headroom so that small frame to frame changes in the
+  // point count do not reallocate
+  const int capacity = std::max(num_points, points_capacity_ * 3 / 2);
+  GPU_CHECK(cudaFreeHost(host_points_));
+  GPU_CHECK(cudaFree(dev_points_));
+  GPU_CHECK(cudaMallocHost(reinterpret_cast<void**>(&host_points_),
+                           capacity * kNumPointFeature * sizeof(float)));
+  GPU_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_points_),
+                       capacity * kNumPointFeature * sizeof(float)));
+  points_capacity_ = capacity;
+}
+
+void PointPillars::RecordStage(const StageEvent event) {
+  if (enable_streams_) {
+    GPU_CHECK(cudaEventRecord(stage_events_[event], compute_stream_));
+  }
+}
+
+void PointPillars::CollectStageTimes() {
+  GPU_CHECK(cudaEventSynchronize(stage_events_[kPostprocessEnd]));
+  auto elapsed = [this](const StageEvent begin, const StageEvent end) {
+    float ms = 0.0f;
+    GPU_CHECK(
+        cudaEventElapsedTime(&ms, stage_events_[begin], stage_events_[end]));
+    return ms;
+  };
+  // the cpu preprocess reads the host points directly
+  stage_times_.upload_ms =
+      reproduce_result_mode_ ? 0.0f : elapsed(kUploadBegin, kUploadEnd);
+  stage_times_.preprocess_ms = elapsed(kFrameBegin, kPreprocessEnd);
+  stage_times_.anchor_mask_ms = elapsed(kPreprocessEnd, kAnchorMaskEnd);
+  stage_times_.pfe_ms = elapsed(kAnchorMaskEnd, kPfeEnd);
+  stage_times_.scatter_ms = elapsed(kPfeEnd, kScatterEnd);
+  stage_times_.rpn_ms = elapsed(kScatterEnd, kRpnEnd);
+  stage_times_.postprocess_ms = elapsed(kRpnEnd, kPostprocessEnd);
 }
 
 void PointPillars::DeviceMemoryMalloc() {
@@ -603,10 +676,55 @@ void PointPillars::PreprocessGPU(const float* in_points_array,
   GPU_CHECK(cudaFree(dev_points));
 }
 
+void PointPillars::PreprocessGPUStreams(const float* in_points_array,
+                                        const int in_num_points) {
+  const size_t points_size = in_num_points * kNumPointFeature * sizeof(float);
+  if (in_points_array != host_points_) {
+    ReservePointsBuffers(in_num_points);
+    memcpy(host_points_, in_points_array, points_size);
+  }
+
+  GPU_CHECK(cudaEventRecord(stage_events_[kUploadBegin], copy_stream_));
+  GPU_CHECK(cudaMemcpyAsync(dev_points_, host_points_, points_size,
+                            cudaMemcpyHostToDevice, copy_stream_));
+  GPU_CHECK(cudaEventRecord(stage_events_[kUploadEnd], copy_stream_));
+
+  // clear the buffers of the last frame while the points are in flight
+  GPU_CHECK(cudaMemsetAsync(dev_x_coors_, 0, kMaxNumPillars * sizeof(int),
+                            compute_stream_));
+  GPU_CHECK(cudaMemsetAsync(dev_y_coors_, 0, kMaxNumPillars * sizeof(int),
+                            compute_stream_));
+  GPU_CHECK(cudaMemsetAsync(dev_num_points_per_pillar_, 0,
+                            kMaxNumPillars * sizeof(float), compute_stream_));
+  GPU_CHECK(cudaMemsetAsync(dev_pillar_point_feature_, 0,
+                            kMaxNumPillars * kMaxNumPointsPerPillar *
+                                kNumPointFeature * sizeof(float),
+                            compute_stream_));
+  GPU_CHECK(cudaMemsetAsync(dev_pillar_coors_, 0,
+                            kMaxNumPillars * 4 * sizeof(float),
+                            compute_stream_));
+  GPU_CHECK(cudaMemsetAsync(dev_sparse_pillar_map_, 0,
+                            kNumIndsForScan * kNumIndsForScan * sizeof(int),
+                            compute_stream_));
+  GPU_CHECK(cudaMemsetAsync(dev_anchor_mask_, 0, kNumAnchor * sizeof(int),
+                            compute_stream_));
+  host_pillar_count_[0] = 0;
+
+  // the preprocess kernels run on the legacy default stream, which waits
+  // for the compute stream and thereby for the upload
+  GPU_CHECK(cudaStreamWaitEvent(compute_stream_, stage_events_[kUploadEnd], 0));
+  preprocess_points_cuda_ptr_->DoPreprocessPointsCuda(
+      dev_points_, in_num_points, dev_x_coors_, dev_y_coors_,
+      dev_num_points_per_pillar_, dev_pillar_point_feature_, dev_pillar_coors_,
+      dev_sparse_pillar_map_, host_pillar_count_);
+}
+
 void PointPillars::Preprocess(const float* in_points_array,
                               const int in_num_points) {
   if (reproduce_result_mode_) {
     PreprocessCPU(in_points_array, in_num_points);
+  } else if (enable_streams_) {
+    PreprocessGPUStreams(in_points_array, in_num_points);
   } else {
     PreprocessGPU(in_points_array, in_num_points);
   }
@@ -621,15 +739,20 @@ void PointPillars::DoInference(const float* in_points_array,
     return;
   }
 
+  RecordStage(kFrameBegin);
   Preprocess(in_points_array, in_num_points);
+  RecordStage(kPreprocessEnd);
 
   anchor_mask_cuda_ptr_->DoAnchorMaskCuda(
       dev_sparse_pillar_map_, dev_cumsum_along_x_, dev_cumsum_along_y_,
       dev_box_anchors_min_x_, dev_box_anchors_min_y_, dev_box_anchors_max_x_,
       dev_box_anchors_max_y_, dev_anchor_mask_);
+  RecordStage(kAnchorMaskEnd);
 
-  cudaStream_t stream;
-  GPU_CHECK(cudaStreamCreate(&stream));
+  cudaStream_t stream = compute_stream_;
+  if (!enable_streams_) {
+    GPU_CHECK(cudaStreamCreate(&stream));
+  }
   GPU_CHECK(cudaMemcpyAsync(pfe_buffers_[0], dev_pillar_point_feature_,
                             kMaxNumPillars * kMaxNumPointsPerPillar *
                                 kNumPointFeature * sizeof(float),
@@ -657,17 +780,20 @@ void PointPillars::DoInference(const float* in_points_array,
   auto pfe_output = pfe_net_.forward({tensor_pillar_point_feature,
                                       tensor_num_points_per_pillar,
                                       tensor_pillar_coors}).toTensor();
+  RecordStage(kPfeEnd);
 
   GPU_CHECK(
       cudaMemset(dev_scattered_feature_, 0, kRpnInputSize * sizeof(float)));
   scatter_cuda_ptr_->DoScatterCuda(
       host_pillar_count_[0], dev_x_coors_, dev_y_coors_,
       pfe_output.data_ptr<float>(), dev_scattered_feature_);
+  RecordStage(kScatterEnd);
 
   GPU_CHECK(cudaMemcpyAsync(rpn_buffers_[0], dev_scattered_feature_,
                             kBatchSize * kRpnInputSize * sizeof(float),
                             cudaMemcpyDeviceToDevice, stream));
   rpn_context_->enqueueV2(rpn_buffers_, stream, nullptr);
+  RecordStage(kRpnEnd);
 
   GPU_CHECK(cudaMemset(dev_filter_count_, 0, sizeof(int)));
   postprocess_cuda_ptr_->DoPostprocessCuda(
@@ -678,9 +804,14 @@ void PointPillars::DoInference(const float* in_points_array,
       dev_anchors_dy_, dev_anchors_dz_, dev_anchors_ro_, dev_filtered_box_,
       dev_filtered_score_, dev_filtered_label_, dev_filtered_dir_,
       dev_box_for_nms_, dev_filter_count_, out_detections, out_labels);
+  RecordStage(kPostprocessEnd);
 
-  // release the stream and the buffers
-  cudaStreamDestroy(stream);
+  if (enable_streams_) {
+    CollectStageTimes();
+  } else {
+    // release the stream and the buffers
+    cudaStreamDestroy(stream);
+  }
 }
 
 }  // namespace lidar
@@ -103,6 +103,18 @@ class Logger : public nvinfer1::ILogger {
 };
 
 class PointPillars {
+ public:
+  // per stage gpu time in milliseconds of the last DoInference call
+  struct StageTimes {
+    float upload_ms = 0.0f;
+    float preprocess_ms = 0.0f;
+    float anchor_mask_ms = 0.0f;
+    float pfe_ms = 0.0f;
+    float scatter_ms = 0.0f;
+    float rpn_ms = 0.0f;
+    float postprocess_ms = 0.0f;
+  };
+
  private:
   friend class TestClass;
   static const float kPillarXSize;
@@ -149,6 +161,7 @@ class PointPillars {
   const float nms_overlap_threshold_;
   const std::string pfe_torch_file_;
   const std::string rpn_onnx_file_;
+  const bool enable_streams_;
   // end initializer list
 
   int host_pillar_count_[1];
@@ -216,6 +229,27 @@ class PointPillars {
   nvinfer1::IRuntime* rpn_runtime_;
   nvinfer1::ICudaEngine* rpn_engine_;
 
+  // only used when enable_streams_ is set
+  enum StageEvent {
+    kUploadBegin = 0,
+    kUploadEnd,
+    kFrameBegin,
+    kPreprocessEnd,
+    kAnchorMaskEnd,
+    kPfeEnd,
+    kScatterEnd,
+    kRpnEnd,
+    kPostprocessEnd,
+    kNumStageEvents
+  };
+  cudaStream_t copy_stream_ = nullptr;
+  cudaStream_t compute_stream_ = nullptr;
+  cudaEvent_t stage_events_[kNumStageEvents];
+  float* host_points_ = nullptr;
+  float* dev_points_ = nullptr;
+  int points_capacity_ = 0;
+  StageTimes stage_times_;
+
   /**
    * @brief Memory allocation for device memory
    * @details Called in the constructor
@@ -297,6 +331,34 @@ class PointPillars {
    */
   void PreprocessGPU(const float* in_points_array, const int in_num_points);
 
+  /**
+   * @brief Preproces by GPU with the points uploaded on the copy stream
+   * @param[in] in_points_array Point cloud array
+   * @param[in] in_num_points Number of points
+   * @details The points are staged in the pinned buffer unless they were
+   * written there through MutablePinnedPoints, and the pillar buffers are
+   * cleared on the compute stream while the upload is in flight
+   */
+  void PreprocessGPUStreams(const float* in_points_array,
+                            const int in_num_points);
+
+  /**
+   * @brief Grow the pinned host and device point buffers
+   * @param[in] num_points Number of points the buffers must hold
+   */
+  void ReservePointsBuffers(const int num_points);
+
+  /**
+   * @brief Record a stage event on the compute stream
+   * @param[in] event Stage which just finished
+   */
+  void RecordStage(const StageEvent event);
+
+  /**
+   * @brief Read the stage events back into stage_times_
+   */
+  void CollectStageTimes();
+
   /**
    * @brief Convert anchors to box form like min_x, min_y, max_x, max_y anchors
    * @param[in] anchors_px_
@@ -334,14 +396,31 @@ class PointPillars {
    * @param[in] nms_overlap_threshold IOU threshold for NMS
    * @param[in] pfe_torch_file Pillar Feature Extractor Torch file path
    * @param[in] rpn_onnx_file Region Proposal Network ONNX file path
+   * @param[in] enable_streams Boolean, if true, points are uploaded from a
+   * reused pinned buffer on a dedicated stream and each stage is timed
    * @details Variables could be changed through point_pillars_detection
    */
   PointPillars(const bool reproduce_result_mode, const float score_threshold,
                const float nms_overlap_threshold,
                const std::string pfe_torch_file,
-               const std::string rpn_onnx_file);
+               const std::string rpn_onnx_file,
+               const bool enable_streams = false);
   ~PointPillars();
 
+  /**
+   * @brief Pinned buffer the caller can fill with points before DoInference
+   * @param[in] num_points Number of points to be written
+   * @return Zeroed buffer of num_points * kNumPointFeature floats, or nullptr
+   * if streams are disabled
+   */
+  float* MutablePinnedPoints(const int num_points);
+
+  /**
+   * @brief Stage times of the last inference, all zero if streams are
+   * disabled
+   */
+  const StageTimes& stage_times() const { return stage_times_; }
+
   /**
    * @brief Call PointPillars for the inference
    * @param[in] in_points_array Point cloud array
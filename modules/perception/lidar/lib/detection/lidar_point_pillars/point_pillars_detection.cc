@@ -26,6 +26,7 @@
 #include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/base/point_cloud_util.h"
 #include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/common/point_cloud_processing/downsampling.h"
 #include "modules/perception/lidar/common/lidar_timer.h"
 #include "modules/perception/lidar/common/pcl_util.h"
 #include "modules/perception/lidar/lib/detection/lidar_point_pillars/params.h"
@@ -55,7 +56,8 @@ PointPillarsDetection::PointPillarsDetection()
 bool PointPillarsDetection::Init(const DetectionInitOptions& options) {
   point_pillars_ptr_.reset(new PointPillars(
       FLAGS_reproduce_result_mode, FLAGS_score_threshold,
-      FLAGS_nms_overlap_threshold, FLAGS_pfe_torch_file, FLAGS_rpn_onnx_file));
+      FLAGS_nms_overlap_threshold, FLAGS_pfe_torch_file, FLAGS_rpn_onnx_file,
+      FLAGS_enable_point_pillars_streams));
   return true;
 }
 
@@ -109,19 +111,12 @@ bool PointPillarsDetection::Detect(const DetectionOptions& options,
 
   // down sample the point cloud through filtering voxel grid
   if (FLAGS_enable_downsample_pointcloud) {
-    pcl::PointCloud<pcl::PointXYZI>::Ptr pcl_cloud_ptr(
-        new pcl::PointCloud<pcl::PointXYZI>());
-    pcl::PointCloud<pcl::PointXYZI>::Ptr filtered_cloud_ptr(
-        new pcl::PointCloud<pcl::PointXYZI>());
-    TransformToPCLXYZI(*cur_cloud_ptr_, pcl_cloud_ptr);
-    DownSampleCloudByVoxelGrid(pcl_cloud_ptr, filtered_cloud_ptr,
-                               FLAGS_downsample_voxel_size_x,
-                               FLAGS_downsample_voxel_size_y,
-                               FLAGS_downsample_voxel_size_z);
-
-    // transform pcl point cloud to apollo point cloud
     base::PointFCloudPtr downsample_voxel_cloud_ptr(new base::PointFCloud());
-    TransformFromPCLXYZI(filtered_cloud_ptr, downsample_voxel_cloud_ptr);
+    common::DownsamplingVoxelGrid<base::PointF>(
+        static_cast<float>(FLAGS_downsample_voxel_size_x),
+        static_cast<float>(FLAGS_downsample_voxel_size_y),
+        static_cast<float>(FLAGS_downsample_voxel_size_z), cur_cloud_ptr_,
+        downsample_voxel_cloud_ptr, FLAGS_downsample_voxel_num_threads);
     cur_cloud_ptr_ = downsample_voxel_cloud_ptr;
   }
   downsample_time_ = timer.toc(true);
@@ -181,8 +176,13 @@ bool PointPillarsDetection::Detect(const DetectionOptions& options,
   }
   shuffle_time_ = timer.toc(true);
 
-  // point cloud to array
-  float* points_array = new float[num_points * FLAGS_num_point_feature]();
+  // point cloud to array, written straight into the pinned upload buffer
+  // when streams are enabled
+  float* pinned_points_array =
+      point_pillars_ptr_->MutablePinnedPoints(num_points);
+  float* points_array = pinned_points_array != nullptr
+                            ? pinned_points_array
+                            : new float[num_points * FLAGS_num_point_feature]();
   CloudToArray(cur_cloud_ptr_, points_array, FLAGS_normalizing_factor);
   cloud_to_array_time_ = timer.toc(true);
 
@@ -205,8 +205,21 @@ bool PointPillarsDetection::Detect(const DetectionOptions& options,
         << "cloud_to_array: " << cloud_to_array_time_ << "\t"
         << "inference: " << inference_time_ << "\t"
         << "collect: " << collect_time_;
+  if (FLAGS_enable_point_pillars_streams) {
+    const auto& stage_times = point_pillars_ptr_->stage_times();
+    AINFO << "PointPillars gpu stages: " << "\n"
+          << "upload: " << stage_times.upload_ms << "\t"
+          << "preprocess: " << stage_times.preprocess_ms << "\t"
+          << "anchor_mask: " << stage_times.anchor_mask_ms << "\t"
+          << "pfe: " << stage_times.pfe_ms << "\t"
+          << "scatter: " << stage_times.scatter_ms << "\t"
+          << "rpn: " << stage_times.rpn_ms << "\t"
+          << "postprocess: " << stage_times.postprocess_ms;
+  }
 
-  delete[] points_array;
+  if (pinned_points_array == nullptr) {
+    delete[] points_array;
+  }
   return true;
 }
 
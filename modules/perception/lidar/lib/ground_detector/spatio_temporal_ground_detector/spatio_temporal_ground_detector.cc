@@ -17,6 +17,7 @@
 #include "modules/perception/lidar/lib/ground_detector/spatio_temporal_ground_detector/spatio_temporal_ground_detector.h"
 
 #include "cyber/common/file.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/common/point_cloud_processing/common.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_log.h"
@@ -63,6 +64,7 @@ bool SpatioTemporalGroundDetector::Init(
 
   pfdetector_ = new common::PlaneFitGroundDetector(*param_);
   pfdetector_->Init();
+  pfdetector_->SetNumThreads(FLAGS_ground_detector_num_threads);
 
   point_indices_temp_.resize(default_point_size_);
   data_.resize(default_point_size_ * 3);
@@ -156,6 +158,14 @@ bool SpatioTemporalGroundDetector::Detect(const GroundDetectorOptions& options,
   base::PointIndices& non_ground_indices = frame->non_ground_indices;
   ADEBUG << "input of ground detector:" << valid_point_num;
 
+  // start from the planes of the last frame moved by the ego motion
+  if (FLAGS_enable_ground_temporal_prior && has_last_frame_) {
+    const Eigen::Vector3f shift =
+        (cloud_center_ - last_cloud_center_).cast<float>();
+    pfdetector_->UpdatePriorPlanes(shift.data());
+  }
+  has_last_frame_ = false;
+
   if (!pfdetector_->Detect(data_.data(), ground_height_signed_.data(),
                            valid_point_num, nr_points_element)) {
     ADEBUG << "failed to call ground detector!";
@@ -182,6 +192,8 @@ bool SpatioTemporalGroundDetector::Detect(const GroundDetectorOptions& options,
   }
   AINFO << "succeed to call ground detector with non ground points "
         << non_ground_indices.indices.size();
+  last_cloud_center_ = cloud_center_;
+  has_last_frame_ = true;
 
   if (use_ground_service_) {
     auto ground_service = SceneManager::Instance().Service("GroundService");
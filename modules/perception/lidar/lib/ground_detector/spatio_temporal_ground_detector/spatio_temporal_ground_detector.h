@@ -59,6 +59,9 @@ class SpatioTemporalGroundDetector : public BaseGroundDetector {
   float ground_thres_ = 0.25f;
   size_t default_point_size_ = 320000;
   Eigen::Vector3d cloud_center_ = Eigen::Vector3d(0.0, 0.0, 0.0);
+  // center of the last detected frame, for the temporal plane prior
+  Eigen::Vector3d last_cloud_center_ = Eigen::Vector3d(0.0, 0.0, 0.0);
+  bool has_last_frame_ = false;
   GroundServiceContent ground_service_content_;
 };  // class SpatioTemporalGroundDetector
 
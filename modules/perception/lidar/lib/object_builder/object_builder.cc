@@ -16,9 +16,12 @@
 #include "modules/perception/lidar/lib/object_builder/object_builder.h"
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 
+#include "cyber/task/task.h"
 #include "modules/perception/common/geometry/common.h"
-#include "modules/perception/common/geometry/convex_hull_2d.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 // #include "modules/perception/lib/io/protobuf_util.h"
 
@@ -36,6 +39,9 @@ using PointFCloud = apollo::perception::base::PointCloud<PointF>;
 using PolygonDType = apollo::perception::base::PointCloud<PointD>;
 
 bool ObjectBuilder::Init(const ObjectBuilderInitOptions& options) {
+  num_threads_ = std::max(1, FLAGS_object_builder_num_threads);
+  hull_prefilter_size_ = static_cast<size_t>(
+      std::max(0, FLAGS_object_builder_hull_prefilter_size));
   return true;
 }
 
@@ -45,18 +51,44 @@ bool ObjectBuilder::Build(const ObjectBuilderOptions& options,
     return false;
   }
   std::vector<ObjectPtr>* objects = &(frame->segmented_objects);
-  for (size_t i = 0; i < objects->size(); ++i) {
+  // cluster sizes vary a lot, so workers take the next object when done
+  std::atomic<size_t> next_object(0);
+  const size_t num_workers =
+      std::min(static_cast<size_t>(num_threads_), objects->size());
+  if (num_workers <= 1) {
+    BuildObjects(objects, &next_object);
+    return true;
+  }
+  std::vector<std::future<void>> results;
+  results.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; ++w) {
+    results.push_back(cyber::Async([this, objects, &next_object]() {
+      BuildObjects(objects, &next_object);
+    }));
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+  return true;
+}
+
+void ObjectBuilder::BuildObjects(std::vector<ObjectPtr>* objects,
+                                 std::atomic<size_t>* next_object) {
+  // the hull keeps its buffers from one object to the next
+  ConvexHull hull;
+  hull.set_prefilter_min_size(hull_prefilter_size_);
+  for (size_t i = (*next_object)++; i < objects->size();
+       i = (*next_object)++) {
     if (objects->at(i)) {
       objects->at(i)->id = static_cast<int>(i);
-      ComputePolygon2D(objects->at(i));
+      ComputePolygon2D(objects->at(i), &hull);
       ComputePolygonSizeCenter(objects->at(i));
       ComputeOtherObjectInformation(objects->at(i));
     }
   }
-  return true;
 }
 
-void ObjectBuilder::ComputePolygon2D(ObjectPtr object) {
+void ObjectBuilder::ComputePolygon2D(ObjectPtr object, ConvexHull* hull) {
   Eigen::Vector3f min_pt;
   Eigen::Vector3f max_pt;
   PointFCloud& cloud = object->lidar_supplement.cloud;
@@ -66,8 +98,7 @@ void ObjectBuilder::ComputePolygon2D(ObjectPtr object) {
     return;
   }
   LinePerturbation(&cloud);
-  common::ConvexHull2D<PointFCloud, PolygonDType> hull;
-  hull.GetConvexHull(cloud, &(object->polygon));
+  hull->GetConvexHull(cloud, &(object->polygon));
 }
 
 void ObjectBuilder::ComputeOtherObjectInformation(ObjectPtr object) {
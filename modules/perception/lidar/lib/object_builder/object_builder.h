@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/point.h"
 #include "modules/perception/base/point_cloud.h"
+#include "modules/perception/common/geometry/convex_hull_2d.h"
 #include "modules/perception/lib/registerer/registerer.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
 
@@ -53,11 +55,24 @@ class ObjectBuilder {
   std::string Name() const { return "ObjectBuilder"; }
 
  private:
+  using ConvexHull = common::ConvexHull2D<
+      apollo::perception::base::PointCloud<apollo::perception::base::PointF>,
+      apollo::perception::base::PointCloud<apollo::perception::base::PointD>>;
+
+  // @brief: build the objects taken from next_object until none is left.
+  // @param [in/out]: objects.
+  // @param [in/out]: index of the next object to build.
+  void BuildObjects(
+      std::vector<std::shared_ptr<apollo::perception::base::Object>>* objects,
+      std::atomic<size_t>* next_object);
+
   // @brief: calculate 2d polygon.
   //         and fill the convex hull vertices in object->polygon.
   // @param [in/out]: ObjectPtr.
+  // @param [in/out]: convex hull scratch.
   void ComputePolygon2D(
-      std::shared_ptr<apollo::perception::base::Object> object);
+      std::shared_ptr<apollo::perception::base::Object> object,
+      ConvexHull* hull);
 
   // @brief: calculate the size, center of polygon.
   // @param [in/out]: ObjectPtr.
@@ -90,6 +105,9 @@ class ObjectBuilder {
   void GetMinMax3D(const apollo::perception::base::PointCloud<
                        apollo::perception::base::PointF>& cloud,
                    Eigen::Vector3f* min_pt, Eigen::Vector3f* max_pt);
+
+  int num_threads_ = 1;
+  size_t hull_prefilter_size_ = 0;
 };  // class ObjectBuilder
 
 }  // namespace lidar
@@ -20,6 +20,7 @@
 #include "cyber/common/file.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/perception/base/object_pool_types.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_log.h"
 #include "modules/perception/lidar/lib/pointcloud_preprocessor/proto/pointcloud_preprocessor_config.pb.h"
@@ -60,6 +61,11 @@ bool PointCloudPreprocessor::Init(
   box_backward_y_ = static_cast<float>(-vehicle_param.back_edge_to_center());*/
   filter_high_z_points_ = config.filter_high_z_points();
   z_threshold_ = config.z_threshold();
+#if USE_GPU == 1
+  if (FLAGS_enable_gpu_pointcloud_preprocess) {
+    gpu_preprocessor_.reset(new PointCloudPreprocessorCuda());
+  }
+#endif
   return true;
 }
 
@@ -77,6 +83,24 @@ bool PointCloudPreprocessor::Preprocess(
     frame->world_cloud = base::PointDCloudPool::Instance().Get();
   }
   frame->cloud->set_timestamp(message->measurement_time());
+#if USE_GPU == 1
+  if (gpu_preprocessor_ != nullptr) {
+    // only the message is copied on the cpu, all the points go to the gpu
+    frame->cloud->clear();
+    frame->cloud->reserve(message->point_size());
+    base::PointF point;
+    for (int i = 0; i < message->point_size(); ++i) {
+      const apollo::drivers::PointXYZIT& pt = message->point(i);
+      point.x = pt.x();
+      point.y = pt.y();
+      point.z = pt.z();
+      point.intensity = static_cast<float>(pt.intensity());
+      frame->cloud->push_back(point, static_cast<double>(pt.timestamp()) * 1e-9,
+                              std::numeric_limits<float>::max(), i, 0);
+    }
+    return PreprocessGPU(options, frame);
+  }
+#endif
   if (message->point_size() > 0) {
     frame->cloud->reserve(message->point_size());
     base::PointF point;
@@ -124,6 +148,11 @@ bool PointCloudPreprocessor::Preprocess(
   if (frame->world_cloud == nullptr) {
     frame->world_cloud = base::PointDCloudPool::Instance().Get();
   }
+#if USE_GPU == 1
+  if (gpu_preprocessor_ != nullptr) {
+    return PreprocessGPU(options, frame);
+  }
+#endif
   if (frame->cloud->size() > 0) {
     size_t size = frame->cloud->size();
     size_t i = 0;
@@ -164,6 +193,68 @@ bool PointCloudPreprocessor::Preprocess(
   return true;
 }
 
+#if USE_GPU == 1
+bool PointCloudPreprocessor::PreprocessGPU(
+    const PointCloudPreprocessorOptions& options, LidarFrame* frame) const {
+  frame->world_cloud->clear();
+  if (frame->cloud->empty()) {
+    return true;
+  }
+  PointCloudPreprocessorCudaParams params;
+  params.filter_naninf_points = filter_naninf_points_;
+  params.point_inf_threshold = kPointInfThreshold;
+  params.filter_nearby_box_points = filter_nearby_box_points_;
+  params.box_forward_x = box_forward_x_;
+  params.box_backward_x = box_backward_x_;
+  params.box_forward_y = box_forward_y_;
+  params.box_backward_y = box_backward_y_;
+  params.filter_high_z_points = filter_high_z_points_;
+  params.z_threshold = z_threshold_;
+  const Eigen::Matrix4d sensor2novatel =
+      options.sensor2novatel_extrinsics.matrix();
+  const Eigen::Matrix4d lidar2world = frame->lidar2world_pose.matrix();
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      params.sensor2novatel[4 * r + c] = sensor2novatel(r, c);
+      params.lidar2world[4 * r + c] = lidar2world(r, c);
+    }
+  }
+
+  std::vector<int> kept_indices;
+  std::vector<double> world_points;
+  gpu_preprocessor_->Preprocess(params, &(frame->cloud->front()),
+                                static_cast<int>(frame->cloud->size()),
+                                &kept_indices, &world_points);
+
+  const size_t num_points = frame->cloud->size();
+  if (kept_indices.size() < num_points) {
+    // kept indices are ascending, so the cloud is compacted in place
+    // instead of being copied into a new one
+    for (size_t i = 0; i < kept_indices.size(); ++i) {
+      frame->cloud->CopyPoint(i, kept_indices[i], *frame->cloud);
+    }
+    frame->cloud->resize(kept_indices.size());
+  }
+
+  const auto& local_cloud = frame->cloud;
+  auto& world_cloud = frame->world_cloud;
+  world_cloud->reserve(local_cloud->size());
+  base::PointD world_point;
+  for (size_t i = 0; i < local_cloud->size(); ++i) {
+    world_point.x = world_points[3 * i];
+    world_point.y = world_points[3 * i + 1];
+    world_point.z = world_points[3 * i + 2];
+    world_point.intensity = local_cloud->at(i).intensity;
+    world_cloud->push_back(world_point, local_cloud->points_timestamp(i),
+                           std::numeric_limits<float>::max(),
+                           local_cloud->points_beam_id()[i], 0);
+  }
+  AINFO << "Preprocessor filter points: " << num_points << " to "
+        << local_cloud->size();
+  return true;
+}
+#endif
+
 bool PointCloudPreprocessor::TransformCloud(
     const base::PointFCloudPtr& local_cloud, const Eigen::Affine3d& pose,
     base::PointDCloudPtr world_cloud) const {
@@ -20,6 +20,7 @@
 
 #include "modules/drivers/proto/pointcloud.pb.h"
 #include "modules/perception/lidar/common/lidar_frame.h"
+#include "modules/perception/lidar/lib/pointcloud_preprocessor/pointcloud_preprocessor_cuda.h"
 
 namespace apollo {
 namespace perception {
@@ -66,6 +67,13 @@ class PointCloudPreprocessor {
   bool TransformCloud(const base::PointFCloudPtr& local_cloud,
                       const Eigen::Affine3d& pose,
                       base::PointDCloudPtr world_cloud) const;
+#if USE_GPU == 1
+  // @brief: the filters and the world transform of Preprocess in one pass
+  // on the gpu, the kept points stay in input order
+  bool PreprocessGPU(const PointCloudPreprocessorOptions& options,
+                     LidarFrame* frame) const;
+  std::unique_ptr<PointCloudPreprocessorCuda> gpu_preprocessor_;
+#endif
   // params
   bool filter_naninf_points_ = true;
   bool filter_nearby_box_points_ = true;
@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lidar/lib/pointcloud_preprocessor/pointcloud_preprocessor_cuda.h"
+
+#include <thrust/copy.h>
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include "modules/perception/base/common.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+__device__ void Transform(const double* m, const double x, const double y,
+                          const double z, double* out) {
+  out[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+  out[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+  out[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+}
+
+// the same checks as PointCloudPreprocessor::Preprocess on the cpu
+__global__ void FilterKernel(const PointCloudPreprocessorCudaParams params,
+                             const base::PointF* points, const int num_points,
+                             int* keep) {
+  const int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  const base::PointF& pt = points[i];
+  keep[i] = 0;
+  if (params.filter_naninf_points) {
+    if (isnan(pt.x) || isnan(pt.y) || isnan(pt.z)) {
+      return;
+    }
+    if (fabsf(pt.x) > params.point_inf_threshold ||
+        fabsf(pt.y) > params.point_inf_threshold ||
+        fabsf(pt.z) > params.point_inf_threshold) {
+      return;
+    }
+  }
+  if (params.filter_nearby_box_points) {
+    double novatel[3];
+    Transform(params.sensor2novatel, pt.x, pt.y, pt.z, novatel);
+    if (novatel[0] < params.box_forward_x &&
+        novatel[0] > params.box_backward_x &&
+        novatel[1] < params.box_forward_y &&
+        novatel[1] > params.box_backward_y) {
+      return;
+    }
+  }
+  if (params.filter_high_z_points && pt.z > params.z_threshold) {
+    return;
+  }
+  keep[i] = 1;
+}
+
+__global__ void TransformKernel(const PointCloudPreprocessorCudaParams params,
+                                const base::PointF* points,
+                                const int* kept_indices, const int num_kept,
+                                double* world_points) {
+  const int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_kept) {
+    return;
+  }
+  const base::PointF& pt = points[kept_indices[i]];
+  Transform(params.lidar2world, pt.x, pt.y, pt.z, world_points + 3 * i);
+}
+
+}  // namespace
+
+PointCloudPreprocessorCuda::~PointCloudPreprocessorCuda() {
+  ReleaseGPUMemory();
+}
+
+void PointCloudPreprocessorCuda::ReleaseGPUMemory() {
+  BASE_CUDA_CHECK(cudaFree(dev_points_));
+  BASE_CUDA_CHECK(cudaFree(dev_keep_));
+  BASE_CUDA_CHECK(cudaFree(dev_kept_indices_));
+  BASE_CUDA_CHECK(cudaFree(dev_world_points_));
+  dev_points_ = nullptr;
+  dev_keep_ = nullptr;
+  dev_kept_indices_ = nullptr;
+  dev_world_points_ = nullptr;
+  capacity_ = 0;
+}
+
+void PointCloudPreprocessorCuda::Reserve(const int num_points) {
+  if (num_points <= capacity_) {
+    return;
+  }
+  ReleaseGPUMemory();
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_points_),
+                             num_points * sizeof(base::PointF)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_keep_),
+                             num_points * sizeof(int)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_kept_indices_),
+                             num_points * sizeof(int)));
+  BASE_CUDA_CHECK(cudaMalloc(reinterpret_cast<void**>(&dev_world_points_),
+                             num_points * 3 * sizeof(double)));
+  capacity_ = num_points;
+}
+
+void PointCloudPreprocessorCuda::Preprocess(
+    const PointCloudPreprocessorCudaParams& params, const base::PointF* points,
+    const int num_points, std::vector<int>* kept_indices,
+    std::vector<double>* world_points) {
+  kept_indices->clear();
+  world_points->clear();
+  if (num_points <= 0) {
+    return;
+  }
+  Reserve(num_points);
+  BASE_CUDA_CHECK(cudaMemcpy(dev_points_, points,
+                             num_points * sizeof(base::PointF),
+                             cudaMemcpyHostToDevice));
+
+  const int num_blocks = (num_points + kNumThreads - 1) / kNumThreads;
+  FilterKernel<<<num_blocks, kNumThreads>>>(params, dev_points_, num_points,
+                                            dev_keep_);
+  // stream compaction keeps the input order of the points
+  int* kept_end = thrust::copy_if(
+      thrust::device, thrust::counting_iterator<int>(0),
+      thrust::counting_iterator<int>(num_points), dev_keep_,
+      dev_kept_indices_, thrust::identity<int>());
+  const int num_kept = static_cast<int>(kept_end - dev_kept_indices_);
+  if (num_kept == 0) {
+    return;
+  }
+
+  const int num_kept_blocks = (num_kept + kNumThreads - 1) / kNumThreads;
+  TransformKernel<<<num_kept_blocks, kNumThreads>>>(
+      params, dev_points_, dev_kept_indices_, num_kept, dev_world_points_);
+
+  kept_indices->resize(num_kept);
+  world_points->resize(3 * num_kept);
+  BASE_CUDA_CHECK(cudaMemcpy(kept_indices->data(), dev_kept_indices_,
+                             num_kept * sizeof(int), cudaMemcpyDeviceToHost));
+  BASE_CUDA_CHECK(cudaMemcpy(world_points->data(), dev_world_points_,
+                             3 * num_kept * sizeof(double),
+                             cudaMemcpyDeviceToHost));
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/perception/base/point.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+struct PointCloudPreprocessorCudaParams {
+  bool filter_naninf_points = true;
+  float point_inf_threshold = 1e3f;
+  bool filter_nearby_box_points = true;
+  float box_forward_x = 0.0f;
+  float box_backward_x = 0.0f;
+  float box_forward_y = 0.0f;
+  float box_backward_y = 0.0f;
+  bool filter_high_z_points = true;
+  float z_threshold = 5.0f;
+  // row major 3x4 affine transforms
+  double sensor2novatel[12] = {0.0};
+  double lidar2world[12] = {0.0};
+};
+
+class PointCloudPreprocessorCuda {
+ public:
+  PointCloudPreprocessorCuda() = default;
+
+  ~PointCloudPreprocessorCuda();
+
+  // @brief: filters the points and transforms the kept ones to world frame
+  // with one upload and one download
+  // @param [in]: params
+  // @param [in]: points, in lidar frame
+  // @param [in]: num_points
+  // @param [out]: kept_indices, indices of the kept points in input order
+  // @param [out]: world_points, x, y, z of the kept points in world frame
+  void Preprocess(const PointCloudPreprocessorCudaParams& params,
+                  const base::PointF* points, const int num_points,
+                  std::vector<int>* kept_indices,
+                  std::vector<double>* world_points);
+
+ private:
+  void Reserve(const int num_points);
+  void ReleaseGPUMemory();
+
+  base::PointF* dev_points_ = nullptr;
+  int* dev_keep_ = nullptr;
+  int* dev_kept_indices_ = nullptr;
+  double* dev_world_points_ = nullptr;
+  int capacity_ = 0;
+
+  static constexpr int kNumThreads = 512;
+};  // class PointCloudPreprocessorCuda
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
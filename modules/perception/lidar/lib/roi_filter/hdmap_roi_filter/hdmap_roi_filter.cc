@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "cyber/common/file.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_point_label.h"
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
@@ -66,12 +67,25 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   Eigen::Vector2d cell_size(cell_size_, cell_size_);
   bitmap_.Init(min_range, max_range, cell_size);
 
+  // init tile cache, the roi service publishes the vehicle centered bitmap
+  use_tile_cache_ = FLAGS_enable_hdmap_roi_tile_cache && !set_roi_service_;
+  if (FLAGS_enable_hdmap_roi_tile_cache && set_roi_service_) {
+    AWARN << "Roi tile cache is disabled since set_roi_service is on.";
+  }
+  if (use_tile_cache_) {
+    const int kNumRasterizeWorkers = 4;
+    tile_cache_.Init(cell_size_, extend_dist_, no_edge_table_,
+                     FLAGS_hdmap_roi_tile_cache_capacity,
+                     kNumRasterizeWorkers);
+  }
+
   // output input parameters
   AINFO << " HDMap Roi Filter Parameters: "
         << " range: " << range_ << " cell_size: " << cell_size_
         << " extend_dist: " << extend_dist_
         << " no_edge_table: " << no_edge_table_
-        << " set_roi_service: " << set_roi_service_;
+        << " set_roi_service: " << set_roi_service_
+        << " use_tile_cache: " << use_tile_cache_;
   return true;
 }
 
@@ -103,11 +117,21 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
 
   // transform to local
   base::PointFCloudPtr cloud_local = base::PointFCloudPool::Instance().Get();
-  TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
-                 &polygons_local_, &cloud_local);
-
-  bool ret = FilterWithPolygonMask(cloud_local, polygons_local_,
-                                   &(frame->roi_indices));
+  bool ret = false;
+  if (use_tile_cache_) {
+    TransformCloud(frame->cloud, frame->lidar2world_pose, &cloud_local);
+    const Eigen::Vector3d vel_location = frame->lidar2world_pose.translation();
+    ret = tile_cache_.Update(polygons_world_, vel_location.head<2>(),
+                             range_) &&
+          tile_cache_.Filter(*cloud_local, &(frame->roi_indices));
+    ADEBUG << "Roi tiles drawn: " << tile_cache_.NumDrawnTiles()
+           << " cached: " << tile_cache_.NumTiles();
+  } else {
+    TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
+                   &polygons_local_, &cloud_local);
+    ret = FilterWithPolygonMask(cloud_local, polygons_local_,
+                                &(frame->roi_indices));
+  }
 
   // set roi points label
   if (ret) {
@@ -189,9 +213,6 @@ void HdmapROIFilter::TransformFrame(
     std::vector<PolygonDType>* polygons_local,
     base::PointFCloudPtr* cloud_local) {
   Eigen::Vector3d vel_location = vel_pose.translation();
-  Eigen::Matrix3d vel_rot = vel_pose.linear();
-  Eigen::Vector3d x_axis = vel_rot.row(0);
-  Eigen::Vector3d y_axis = vel_rot.row(1);
 
   // transform polygons
   polygons_local->clear();
@@ -206,7 +227,16 @@ void HdmapROIFilter::TransformFrame(
     }
   }
 
-  // transform cloud
+  TransformCloud(cloud, vel_pose, cloud_local);
+}
+
+void HdmapROIFilter::TransformCloud(const base::PointFCloudPtr& cloud,
+                                    const Eigen::Affine3d& vel_pose,
+                                    base::PointFCloudPtr* cloud_local) {
+  Eigen::Matrix3d vel_rot = vel_pose.linear();
+  Eigen::Vector3d x_axis = vel_rot.row(0);
+  Eigen::Vector3d y_axis = vel_rot.row(1);
+
   (*cloud_local)->clear();
   (*cloud_local)->resize(cloud->size());
   for (size_t i = 0; i < (*cloud_local)->size(); ++i) {
@@ -22,6 +22,7 @@
 #include "modules/perception/base/point_cloud.h"
 #include "modules/perception/lidar/lib/interface/base_roi_filter.h"
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/roi_tile_cache.h"
 #include "modules/perception/lidar/lib/scene_manager/roi_service/roi_service.h"
 
 namespace apollo {
@@ -51,6 +52,10 @@ class HdmapROIFilter : public BaseROIFilter {
                       std::vector<base::PolygonDType>* polygons_local,
                       base::PointFCloudPtr* cloud_local);
 
+  void TransformCloud(const base::PointFCloudPtr& cloud,
+                      const Eigen::Affine3d& vel_pose,
+                      base::PointFCloudPtr* cloud_local);
+
   bool FilterWithPolygonMask(
       const base::PointFCloudPtr& cloud,
       const std::vector<base::PolygonDType>& map_polygons,
@@ -69,6 +74,9 @@ class HdmapROIFilter : public BaseROIFilter {
   std::vector<base::PolygonDType> polygons_local_;
   Bitmap2D bitmap_;
   ROIServiceContent roi_service_content_;
+  // world tiles replace bitmap_ when the roi service does not need it
+  bool use_tile_cache_ = false;
+  RoiTileCache tile_cache_;
 
   // unit tests only
   friend class HdmapROIFilterTest;
@@ -0,0 +1,311 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/roi_tile_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <limits>
+#include <utility>
+
+#include "cyber/task/task.h"
+#include "modules/perception/lidar/common/lidar_log.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+uint64_t Mix(uint64_t h) {
+  h += 0x9e3779b97f4a7c15ULL;
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+uint64_t DoubleBits(const double value) {
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+}  // namespace
+
+constexpr int RoiTileCache::kTileCells;
+
+void RoiTileCache::Init(const double cell_size, const double extend_dist,
+                        const bool no_edge_table, const size_t capacity,
+                        const int num_workers) {
+  CHECK_GT(cell_size, 0.0);
+  cell_size_ = cell_size;
+  tile_size_ = cell_size * kTileCells;
+  extend_dist_ = extend_dist;
+  no_edge_table_ = no_edge_table;
+  capacity_ = capacity;
+  num_workers_ = std::max(num_workers, 1);
+  tiles_.clear();
+  window_.clear();
+  window_nx_ = window_ny_ = 0;
+}
+
+bool RoiTileCache::Update(
+    const std::vector<base::PolygonDType*>& polygons_world,
+    const Eigen::Vector2d& center, const double range) {
+  ++frame_;
+  center_ = center;
+  range_ = range;
+
+  // bounding boxes (min x, min y, max x, max y) and vertex hashes
+  polygon_boxes_.resize(polygons_world.size());
+  polygon_hashes_.resize(polygons_world.size());
+  for (size_t i = 0; i < polygons_world.size(); ++i) {
+    const auto& polygon = *polygons_world[i];
+    Eigen::Vector4d box(std::numeric_limits<double>::max(),
+                        std::numeric_limits<double>::max(),
+                        std::numeric_limits<double>::lowest(),
+                        std::numeric_limits<double>::lowest());
+    uint64_t hash = Mix(polygon.size());
+    for (size_t j = 0; j < polygon.size(); ++j) {
+      const auto& pt = polygon[j];
+      box[0] = std::min(box[0], pt.x);
+      box[1] = std::min(box[1], pt.y);
+      box[2] = std::max(box[2], pt.x);
+      box[3] = std::max(box[3], pt.y);
+      hash = Mix(hash ^ DoubleBits(pt.x));
+      hash = Mix(hash ^ DoubleBits(pt.y));
+    }
+    polygon_boxes_[i] = box;
+    polygon_hashes_[i] = hash;
+  }
+
+  window_tx_ = static_cast<int64_t>(std::floor((center.x() - range) /
+                                               tile_size_));
+  window_ty_ = static_cast<int64_t>(std::floor((center.y() - range) /
+                                               tile_size_));
+  window_nx_ = static_cast<int>(
+      std::floor((center.x() + range) / tile_size_) - window_tx_ + 1);
+  window_ny_ = static_cast<int>(
+      std::floor((center.y() + range) / tile_size_) - window_ty_ + 1);
+  window_offset_x_ = center.x() - static_cast<double>(window_tx_) * tile_size_;
+  window_offset_y_ = center.y() - static_cast<double>(window_ty_) * tile_size_;
+
+  // a tile is also drawn one cell past its far edges, see DrawTile
+  const double margin = extend_dist_ + cell_size_;
+  std::vector<DirtyTile> dirty_tiles;
+  std::vector<size_t> polygon_ids;
+  for (int ix = 0; ix < window_nx_; ++ix) {
+    for (int iy = 0; iy < window_ny_; ++iy) {
+      const int64_t tx = window_tx_ + ix;
+      const int64_t ty = window_ty_ + iy;
+      const double min_x = static_cast<double>(tx) * tile_size_ - margin;
+      const double min_y = static_cast<double>(ty) * tile_size_ - margin;
+      const double max_x = min_x + tile_size_ + 2.0 * margin;
+      const double max_y = min_y + tile_size_ + 2.0 * margin;
+      polygon_ids.clear();
+      uint64_t signature = 0;
+      for (size_t i = 0; i < polygon_boxes_.size(); ++i) {
+        const auto& box = polygon_boxes_[i];
+        if (box[0] > max_x || box[2] < min_x || box[1] > max_y ||
+            box[3] < min_y) {
+          continue;
+        }
+        polygon_ids.push_back(i);
+        // order independent, the map may return polygons in any order
+        signature += Mix(polygon_hashes_[i]);
+      }
+      auto iter = tiles_.find(Key(tx, ty));
+      if (iter != tiles_.end() && iter->second.signature == signature) {
+        iter->second.last_used = frame_;
+        continue;
+      }
+      DirtyTile dirty;
+      dirty.tx = tx;
+      dirty.ty = ty;
+      dirty.signature = signature;
+      dirty.polygon_ids = polygon_ids;
+      dirty_tiles.push_back(std::move(dirty));
+    }
+  }
+
+  // tiles are independent, so they are drawn by several workers each with
+  // its own bitmap
+  bool ret = true;
+  const size_t num_workers =
+      std::min(static_cast<size_t>(num_workers_), dirty_tiles.size());
+  if (num_workers > 1) {
+    std::vector<std::future<bool>> results;
+    results.reserve(num_workers);
+    for (size_t w = 0; w < num_workers; ++w) {
+      results.push_back(cyber::Async([this, w, num_workers, &polygons_world,
+                                      &dirty_tiles]() {
+        bool ok = true;
+        for (size_t i = w; i < dirty_tiles.size(); i += num_workers) {
+          ok = DrawTile(polygons_world, &dirty_tiles[i]) && ok;
+        }
+        return ok;
+      }));
+    }
+    for (auto& result : results) {
+      ret = result.get() && ret;
+    }
+  } else {
+    for (auto& dirty : dirty_tiles) {
+      ret = DrawTile(polygons_world, &dirty) && ret;
+    }
+  }
+  if (!ret) {
+    // keep the stale tiles, the frame fails like the full rasterization
+    return false;
+  }
+
+  num_drawn_tiles_ = dirty_tiles.size();
+  for (auto& dirty : dirty_tiles) {
+    dirty.tile.signature = dirty.signature;
+    dirty.tile.last_used = frame_;
+    tiles_[Key(dirty.tx, dirty.ty)] = dirty.tile;
+  }
+  Evict();
+
+  window_.assign(window_nx_ * window_ny_, nullptr);
+  for (int ix = 0; ix < window_nx_; ++ix) {
+    for (int iy = 0; iy < window_ny_; ++iy) {
+      const auto& tile = tiles_[Key(window_tx_ + ix, window_ty_ + iy)];
+      if (!tile.empty) {
+        window_[ix * window_ny_ + iy] = tile.rows.data();
+      }
+    }
+  }
+  return true;
+}
+
+bool RoiTileCache::DrawTile(
+    const std::vector<base::PolygonDType*>& polygons_world,
+    DirtyTile* dirty) const {
+  Tile* tile = &dirty->tile;
+  tile->rows.fill(0);
+  tile->empty = true;
+  if (dirty->polygon_ids.empty()) {
+    return true;
+  }
+
+  // draw relative to the tile corner to keep the precision of the cells far
+  // from the world origin
+  const double origin_x = static_cast<double>(dirty->tx) * tile_size_;
+  const double origin_y = static_cast<double>(dirty->ty) * tile_size_;
+  std::vector<PolygonScanCvter<double>::Polygon> polygons(
+      dirty->polygon_ids.size());
+  for (size_t i = 0; i < dirty->polygon_ids.size(); ++i) {
+    const auto& polygon_world = *polygons_world[dirty->polygon_ids[i]];
+    auto& polygon = polygons[i];
+    polygon.resize(polygon_world.size());
+    for (size_t j = 0; j < polygon_world.size(); ++j) {
+      polygon[j].x() = polygon_world[j].x - origin_x;
+      polygon[j].y() = polygon_world[j].y - origin_y;
+    }
+  }
+
+  // the scan conversion drops the last partial cell of its range, so the
+  // bitmap reaches one cell beyond the tile and the extra cells are ignored
+  Bitmap2D bitmap;
+  bitmap.Init(Eigen::Vector2d(0.0, 0.0),
+              Eigen::Vector2d(tile_size_ + cell_size_, tile_size_ + cell_size_),
+              Eigen::Vector2d(cell_size_, cell_size_));
+  bitmap.SetUp(Bitmap2D::DirectionMajor::XMAJOR);
+  if (!DrawPolygonsMask<double>(polygons, &bitmap, extend_dist_,
+                                no_edge_table_)) {
+    return false;
+  }
+  const size_t row_words = bitmap.map_size()[1];
+  for (int i = 0; i < kTileCells; ++i) {
+    tile->rows[i] = bitmap.bitmap()[i * row_words];
+    if (tile->rows[i] != 0) {
+      tile->empty = false;
+    }
+  }
+  return true;
+}
+
+void RoiTileCache::Evict() {
+  if (tiles_.size() <= capacity_) {
+    return;
+  }
+  std::vector<std::pair<uint64_t, int64_t>> candidates;
+  candidates.reserve(tiles_.size());
+  for (const auto& item : tiles_) {
+    if (item.second.last_used != frame_) {
+      candidates.emplace_back(item.second.last_used, item.first);
+    }
+  }
+  const size_t num_evict =
+      std::min(tiles_.size() - capacity_, candidates.size());
+  std::nth_element(candidates.begin(), candidates.begin() + num_evict,
+                   candidates.end());
+  for (size_t i = 0; i < num_evict; ++i) {
+    tiles_.erase(candidates[i].second);
+  }
+}
+
+bool RoiTileCache::Check(const double local_x, const double local_y) const {
+  const double rx = local_x + window_offset_x_;
+  const double ry = local_y + window_offset_y_;
+  if (rx < 0.0 || ry < 0.0) {
+    return false;
+  }
+  const int64_t cx = static_cast<int64_t>(rx / cell_size_);
+  const int64_t cy = static_cast<int64_t>(ry / cell_size_);
+  const int64_t tx = cx / kTileCells;
+  const int64_t ty = cy / kTileCells;
+  if (tx >= window_nx_ || ty >= window_ny_) {
+    return false;
+  }
+  const uint64_t* rows = window_[tx * window_ny_ + ty];
+  if (rows == nullptr) {
+    return false;
+  }
+  return (rows[cx % kTileCells] >> (cy % kTileCells)) & 1;
+}
+
+bool RoiTileCache::Filter(const base::PointFCloud& cloud_local,
+                          base::PointIndices* roi_indices) const {
+  if (!Check(0.0, 0.0)) {
+    AWARN << " Car is not in roi!!.";
+    return false;
+  }
+  roi_indices->indices.clear();
+  roi_indices->indices.reserve(cloud_local.size());
+  const double range = range_;
+  for (size_t i = 0; i < cloud_local.size(); ++i) {
+    const auto& pt = cloud_local.at(i);
+    const double x = pt.x;
+    const double y = pt.y;
+    if (x < -range || x >= range || y < -range || y >= range) {
+      continue;
+    }
+    if (Check(x, y)) {
+      roi_indices->indices.push_back(static_cast<int>(i));
+    }
+  }
+  return true;
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
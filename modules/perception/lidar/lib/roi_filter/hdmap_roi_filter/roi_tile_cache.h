@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/perception/base/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+// Keeps the roi mask of the map as world anchored tiles of 64 x 64 cells, so
+// that a frame only rasterizes the tiles whose polygons changed since they
+// were last drawn. A tile is drawn in its own frame (x major, one uint64_t
+// bit row per x cell) and tagged with a signature of the polygons touching
+// it, which also catches polygons that were clipped by the map query radius
+// when the tile was first seen.
+class RoiTileCache {
+ public:
+  static constexpr int kTileCells = 64;
+
+  RoiTileCache() = default;
+  ~RoiTileCache() = default;
+
+  void Init(const double cell_size, const double extend_dist,
+            const bool no_edge_table, const size_t capacity,
+            const int num_workers);
+
+  // make sure all tiles within range of center are drawn for polygons
+  bool Update(const std::vector<base::PolygonDType*>& polygons_world,
+              const Eigen::Vector2d& center, const double range);
+
+  // local points are world aligned and relative to the center of the last
+  // Update, same as the local cloud of HdmapROIFilter
+  bool Check(const double local_x, const double local_y) const;
+
+  // append indices of local points inside [-range, range) and the roi,
+  // returns false if the center itself is not in the roi
+  bool Filter(const base::PointFCloud& cloud_local,
+              base::PointIndices* roi_indices) const;
+
+  size_t NumTiles() const { return tiles_.size(); }
+  size_t NumDrawnTiles() const { return num_drawn_tiles_; }
+
+ private:
+  struct Tile {
+    uint64_t signature = 0;
+    uint64_t last_used = 0;
+    bool empty = true;
+    std::array<uint64_t, kTileCells> rows;
+  };
+
+  struct DirtyTile {
+    int64_t tx = 0;
+    int64_t ty = 0;
+    uint64_t signature = 0;
+    std::vector<size_t> polygon_ids;
+    Tile tile;
+  };
+
+  static int64_t Key(const int64_t tx, const int64_t ty) {
+    return (tx << 32) ^ (ty & 0xffffffff);
+  }
+
+  bool DrawTile(const std::vector<base::PolygonDType*>& polygons_world,
+                DirtyTile* dirty) const;
+  void Evict();
+
+  double cell_size_ = 0.25;
+  double tile_size_ = 16.0;
+  double extend_dist_ = 0.0;
+  bool no_edge_table_ = false;
+  size_t capacity_ = 1024;
+  int num_workers_ = 1;
+
+  std::unordered_map<int64_t, Tile> tiles_;
+  uint64_t frame_ = 0;
+  size_t num_drawn_tiles_ = 0;
+
+  // window of the last Update, row pointers are nullptr for empty tiles
+  Eigen::Vector2d center_ = Eigen::Vector2d::Zero();
+  double range_ = 0.0;
+  int64_t window_tx_ = 0;
+  int64_t window_ty_ = 0;
+  int window_nx_ = 0;
+  int window_ny_ = 0;
+  // offset of the local origin from the window corner
+  double window_offset_x_ = 0.0;
+  double window_offset_y_ = 0.0;
+  std::vector<const uint64_t*> window_;
+
+  // per frame scratch
+  std::vector<Eigen::Vector4d> polygon_boxes_;
+  std::vector<uint64_t> polygon_hashes_;
+};
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
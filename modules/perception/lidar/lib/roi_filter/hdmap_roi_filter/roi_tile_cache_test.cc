@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/roi_tile_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+base::PolygonDType MakeBox(const double min_x, const double min_y,
+                           const double max_x, const double max_y) {
+  base::PolygonDType polygon;
+  base::PointD pt;
+  pt.x = min_x;
+  pt.y = min_y;
+  polygon.push_back(pt);
+  pt.x = max_x;
+  polygon.push_back(pt);
+  pt.y = max_y;
+  polygon.push_back(pt);
+  pt.x = min_x;
+  polygon.push_back(pt);
+  return polygon;
+}
+
+}  // namespace
+
+TEST(RoiTileCacheTest, check_and_reuse) {
+  // far from the world origin like utm coordinates
+  const Eigen::Vector2d center(587001.3, 4141003.7);
+  base::PolygonDType road = MakeBox(center.x() - 3.0, center.y() - 40.0,
+                                    center.x() + 3.0, center.y() + 40.0);
+  base::PolygonDType junction = MakeBox(center.x() + 20.0, center.y() - 5.0,
+                                        center.x() + 30.0, center.y() + 5.0);
+  std::vector<base::PolygonDType*> polygons = {&road, &junction};
+
+  RoiTileCache cache;
+  cache.Init(0.25, 0.0, false, 1024, 1);
+  EXPECT_TRUE(cache.Update(polygons, center, 50.0));
+  const size_t num_tiles = cache.NumTiles();
+  EXPECT_GT(num_tiles, 0);
+  EXPECT_EQ(cache.NumDrawnTiles(), num_tiles);
+
+  EXPECT_TRUE(cache.Check(0.0, 0.0));
+  EXPECT_TRUE(cache.Check(2.5, 39.5));
+  EXPECT_TRUE(cache.Check(-2.5, -39.5));
+  EXPECT_TRUE(cache.Check(25.0, 0.0));
+  EXPECT_FALSE(cache.Check(3.5, 0.0));
+  EXPECT_FALSE(cache.Check(10.0, 0.0));
+  EXPECT_FALSE(cache.Check(0.0, 41.0));
+  EXPECT_FALSE(cache.Check(31.0, 0.0));
+  EXPECT_FALSE(cache.Check(200.0, 0.0));
+
+  // same polygons in another order draw nothing
+  std::vector<base::PolygonDType*> reordered = {&junction, &road};
+  EXPECT_TRUE(cache.Update(reordered, center, 50.0));
+  EXPECT_EQ(cache.NumDrawnTiles(), 0);
+  EXPECT_TRUE(cache.Check(25.0, 0.0));
+
+  // only the tiles touched by the moved junction are drawn again
+  junction = MakeBox(center.x() + 20.0, center.y() - 5.0, center.x() + 35.0,
+                     center.y() + 5.0);
+  EXPECT_TRUE(cache.Update(polygons, center, 50.0));
+  EXPECT_GT(cache.NumDrawnTiles(), 0);
+  EXPECT_LT(cache.NumDrawnTiles(), num_tiles);
+  EXPECT_TRUE(cache.Check(33.0, 0.0));
+}
+
+TEST(RoiTileCacheTest, filter) {
+  const Eigen::Vector2d center(-1000.1, 250.2);
+  base::PolygonDType road = MakeBox(center.x() - 10.0, center.y() - 10.0,
+                                    center.x() + 10.0, center.y() + 10.0);
+  std::vector<base::PolygonDType*> polygons = {&road};
+
+  RoiTileCache cache;
+  cache.Init(0.25, 0.0, false, 4, 1);
+  EXPECT_TRUE(cache.Update(polygons, center, 30.0));
+  // the whole window is in use, nothing can be evicted
+  EXPECT_GT(cache.NumTiles(), 4);
+
+  base::PointFCloud cloud;
+  base::PointF pt;
+  pt.x = 1.0f;
+  pt.y = 1.0f;
+  cloud.push_back(pt);
+  pt.x = 15.0f;
+  cloud.push_back(pt);
+  pt.x = -9.0f;
+  pt.y = 9.0f;
+  cloud.push_back(pt);
+  pt.x = 40.0f;
+  cloud.push_back(pt);
+  base::PointIndices indices;
+  EXPECT_TRUE(cache.Filter(cloud, &indices));
+  ASSERT_EQ(indices.indices.size(), 2);
+  EXPECT_EQ(indices.indices[0], 0);
+  EXPECT_EQ(indices.indices[1], 2);
+
+  // away from the road the car is not in the roi
+  const Eigen::Vector2d far_center(center.x() + 500.0, center.y());
+  EXPECT_TRUE(cache.Update(polygons, far_center, 30.0));
+  EXPECT_FALSE(cache.Filter(cloud, &indices));
+  EXPECT_FALSE(cache.Check(0.0, 0.0));
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
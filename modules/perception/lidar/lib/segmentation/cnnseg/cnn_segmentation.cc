@@ -20,6 +20,7 @@
 
 #include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/inference/inference_factory.h"
+#include "modules/perception/inference/inference_scheduler.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/common/lidar_point_label.h"
 #include "modules/perception/lidar/common/lidar_timer.h"
@@ -207,6 +208,8 @@ bool CNNSegmentation::InitClusterAndBackgroundSegmentation() {
       *roi_cloud_ = *original_cloud_;
       *roi_world_cloud_ = *original_world_cloud_;
     }
+    lidar_frame_ref_->RecordCopy(*roi_cloud_);
+    lidar_frame_ref_->RecordCopy(*roi_world_cloud_);
     lidar_frame_ref_->cloud = roi_cloud_;
     lidar_frame_ref_->world_cloud = roi_world_cloud_;
 
@@ -221,6 +224,8 @@ bool CNNSegmentation::InitClusterAndBackgroundSegmentation() {
       lidar_frame_ref_->world_cloud = original_world_cloud_;
     }
     ground_detector_time_ = timer.toc(true);
+    lidar_frame_ref_->timing.roi_filter = roi_filter_time_;
+    lidar_frame_ref_->timing.ground_detector = ground_detector_time_;
     AINFO << "Roi-filter time: " << roi_filter_time_
           << "\tGround-detector time: " << ground_detector_time_;
     return true;
@@ -302,7 +307,8 @@ bool CNNSegmentation::Segment(const SegmentationOptions& options,
   feature_time_ = timer.toc(true);
 
   // model inference
-  inference_->Infer();
+  inference::InferenceScheduler::Instance()->Infer(
+      "cnnseg", inference::InferencePriority::OBSTACLE, inference_.get());
   infer_time_ = timer.toc(true);
 
   // processing clustering
@@ -388,6 +394,8 @@ void CNNSegmentation::GetObjectsFromSppEngine(
                                                   cluster->point_ids);
     object->lidar_supplement.cloud_world.CopyPointCloud(*original_world_cloud_,
                                                         cluster->point_ids);
+    lidar_frame_ref_->RecordCopy(object->lidar_supplement.cloud);
+    lidar_frame_ref_->RecordCopy(object->lidar_supplement.cloud_world);
 
     // for miss detection, try to fill recall with ncut
     /*if (cnnseg_param_.fill_recall_with_ncut()) {
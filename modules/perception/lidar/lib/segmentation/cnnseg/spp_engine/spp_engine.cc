@@ -15,7 +15,13 @@
  *****************************************************************************/
 
 #include "modules/perception/lidar/lib/segmentation/cnnseg/spp_engine/spp_engine.h"
+
+#include <algorithm>
+#include <future>
+
+#include "cyber/task/task.h"
 #include "modules/perception/base/object_pool_types.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lidar/common/lidar_log.h"
 #include "modules/perception/lidar/common/lidar_timer.h"
 
@@ -26,7 +32,9 @@ namespace lidar {
 void SppEngine::Init(size_t width, size_t height, float range,
                      const SppParams& param, const std::string& sensor_name) {
   // initialize connect component detector
+  num_threads_ = std::max(1, FLAGS_cnnseg_spp_num_threads);
   detector_2d_cc_.Init(static_cast<int>(height), static_cast<int>(width));
+  detector_2d_cc_.SetNumThreads(num_threads_);
   detector_2d_cc_.SetData(data_.obs_prob_data_ref, data_.offset_data,
                           static_cast<float>(height) / (2.f * range),
                           data_.objectness_threshold);
@@ -88,23 +96,33 @@ size_t SppEngine::ProcessConnectedComponentCluster(
   // first sync between cluster list and label image,
   // and they shared the same cluster pointer
   clusters_ = labels_2d_;
-  for (size_t i = 0; i < point_cloud->size(); ++i) {
-    if (mask.size() && mask[static_cast<int>(i)] == 0) {
-      continue;
-    }
-    // out of range
-    const int id = data_.grid_indices[i];
-    if (id < 0) {
-      continue;
+  // labels are looked up in parallel chunks, the samples are then added in
+  // point order so the clusters are the same as a serial pass
+  const size_t num_points = point_cloud->size();
+  point_labels_.resize(num_points);
+  const size_t num_chunks =
+      std::min(static_cast<size_t>(num_threads_), num_points);
+  if (num_chunks > 1) {
+    std::vector<std::future<void>> results;
+    results.reserve(num_chunks);
+    for (size_t c = 0; c < num_chunks; ++c) {
+      const size_t start = num_points * c / num_chunks;
+      const size_t end = num_points * (c + 1) / num_chunks;
+      results.push_back(cyber::Async(&SppEngine::LabelPoints, this,
+                                     point_cloud, std::cref(mask), start,
+                                     end));
     }
-    const auto& point = point_cloud->at(i);
-    const uint16_t& label = labels_2d_[0][id];
-    if (!label) {
-      continue;
+    for (auto& result : results) {
+      result.get();
     }
-    if (point.z <=
-        labels_2d_.GetCluster(label - 1)->top_z + data_.top_z_threshold) {
-      clusters_.AddPointSample(label - 1, point, point_cloud->points_height(i),
+  } else {
+    LabelPoints(point_cloud, mask, 0, num_points);
+  }
+  for (size_t i = 0; i < num_points; ++i) {
+    const uint16_t label = point_labels_[i];
+    if (label) {
+      clusters_.AddPointSample(label - 1, point_cloud->at(i),
+                               point_cloud->points_height(i),
                                static_cast<uint32_t>(i));
     }
   }
@@ -121,6 +139,31 @@ size_t SppEngine::ProcessConnectedComponentCluster(
   return clusters_.size();
 }
 
+void SppEngine::LabelPoints(const base::PointFCloudConstPtr& point_cloud,
+                            const CloudMask& mask, size_t start,
+                            size_t end) {
+  const auto& clusters = labels_2d_.GetClusters();
+  for (size_t i = start; i < end; ++i) {
+    point_labels_[i] = 0;
+    if (mask.size() && mask[static_cast<int>(i)] == 0) {
+      continue;
+    }
+    // out of range
+    const int id = data_.grid_indices[i];
+    if (id < 0) {
+      continue;
+    }
+    const uint16_t label = labels_2d_[0][id];
+    if (!label) {
+      continue;
+    }
+    if (point_cloud->at(i).z <=
+        clusters[label - 1]->top_z + data_.top_z_threshold) {
+      point_labels_[i] = label;
+    }
+  }
+}
+
 size_t SppEngine::ProcessForegroundSegmentation(
     const base::PointFCloudConstPtr point_cloud) {
   mask_.clear();
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Eigen/Dense"
 
@@ -72,6 +73,13 @@ class SppEngine {
   // @param [in]: point cloud mask
   size_t ProcessConnectedComponentCluster(
       const base::PointFCloudConstPtr point_cloud, const CloudMask& mask);
+  // @brief: find cluster label of points in [start, end), 0 for none
+  // @param [in]: point cloud
+  // @param [in]: point cloud mask
+  // @param [in]: start point index, inclusive
+  // @param [in]: end point index, exclusive
+  void LabelPoints(const base::PointFCloudConstPtr& point_cloud,
+                   const CloudMask& mask, size_t start, size_t end);
 
  private:
   // feature size
@@ -93,6 +101,10 @@ class SppEngine {
   SppData data_;
   // thread worker for sync data
   lib::ThreadWorker worker_;
+  // number of threads labeling the grid and the points
+  int num_threads_ = 1;
+  // cluster label of each point, 0 for none
+  std::vector<uint16_t> point_labels_;
 };
 
 }  // namespace lidar
@@ -14,7 +14,9 @@
  * limitations under the License.
  *****************************************************************************/
 #include <algorithm>
+#include <future>
 
+#include "cyber/task/task.h"
 #include "modules/perception/lidar/common/lidar_log.h"
 #include "modules/perception/lidar/common/lidar_timer.h"
 #include "modules/perception/lidar/lib/segmentation/cnnseg/spp_engine/spp_seg_cc_2d.h"
@@ -34,14 +36,20 @@ void SppCCDetector::SetData(const float* const* prob_map,
   worker_.Start();
 }
 
-bool SppCCDetector::BuildNodes(int start_row_index, int end_row_index) {
+bool SppCCDetector::BuildNodes(int start_row_index, int end_row_index,
+                               std::vector<uint32_t>* objects) {
+  objects->clear();
   const float* offset_row_ptr = offset_map_ + start_row_index * cols_;
   const float* offset_col_ptr = offset_map_ + (rows_ + start_row_index) * cols_;
   const float* prob_map_ptr = prob_map_[0] + start_row_index * cols_;
   Node* node_ptr = nodes_[0] + start_row_index * cols_;
   for (int row = start_row_index; row < end_row_index; ++row) {
     for (int col = 0; col < cols_; ++col) {
-      node_ptr->set_is_object(*prob_map_ptr++ >= objectness_threshold_);
+      const bool is_object = *prob_map_ptr++ >= objectness_threshold_;
+      node_ptr->set_is_object(is_object);
+      if (is_object) {
+        objects->push_back(static_cast<uint32_t>(row * cols_ + col));
+      }
       int center_row = static_cast<int>(*offset_row_ptr++ * scale_ +
                                         static_cast<float>(row) + 0.5f);
       int center_col = static_cast<int>(*offset_col_ptr++ * scale_ +
@@ -54,6 +62,27 @@ bool SppCCDetector::BuildNodes(int start_row_index, int end_row_index) {
   return true;
 }
 
+void SppCCDetector::BuildNodeBlocks() {
+  const int num_blocks = std::max(1, std::min(num_threads_, rows_));
+  block_objects_.resize(num_blocks);
+  if (num_blocks == 1) {
+    BuildNodes(0, rows_, &block_objects_[0]);
+    return;
+  }
+  // rows are independent, each block writes its own nodes and object list
+  std::vector<std::future<bool>> results;
+  results.reserve(num_blocks);
+  for (int b = 0; b < num_blocks; ++b) {
+    const int start_row = rows_ * b / num_blocks;
+    const int end_row = rows_ * (b + 1) / num_blocks;
+    results.push_back(cyber::Async(&SppCCDetector::BuildNodes, this,
+                                   start_row, end_row, &block_objects_[b]));
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+}
+
 bool SppCCDetector::CleanNodes() {
   memset(nodes_[0], 0, sizeof(Node) * rows_ * cols_);
   uint32_t node_idx = 0;
@@ -71,7 +100,7 @@ size_t SppCCDetector::Detect(SppLabelImage* labels) {
     worker_.Join();  // sync for cleaning nodes
   }
   first_process_ = false;
-  BuildNodes(0, rows_);
+  BuildNodeBlocks();
   double init_time = timer.toc(true);
 
   double sync_time = timer.toc(true);
@@ -94,51 +123,53 @@ size_t SppCCDetector::Detect(SppLabelImage* labels) {
 }
 
 void SppCCDetector::TraverseNodes() {
-  for (int row = 0; row < rows_; row++) {
-    for (int col = 0; col < cols_; col++) {
-      Node& node = nodes_[row][col];
-      if (node.is_object() && node.get_traversed() == 0) {
-        Traverse(&node);
+  // object pixels are visited in raster order, same as the full scan
+  centers_.clear();
+  for (const auto& objects : block_objects_) {
+    for (const uint32_t pixel : objects) {
+      Node* node = nodes_[0] + pixel;
+      if (node->get_traversed() == 0) {
+        Traverse(node);
       }
     }
   }
 }
 
 void SppCCDetector::UnionNodes() {
-  for (int row = 0; row < rows_; ++row) {
-    for (int col = 0; col < cols_; ++col) {
-      Node* node = &nodes_[row][col];
-      if (!node->is_center()) {
-        continue;
-      }
-      Node* node_neighbor = nullptr;
-      // right
-      if (col < cols_ - 1) {
-        node_neighbor = &nodes_[row][col + 1];
-        if (node_neighbor->is_center()) {
-          DisjointSetUnion(node, node_neighbor);
-        }
+  // only center nodes take part in the union, sorting them keeps the union
+  // order of the full scan
+  std::sort(centers_.begin(), centers_.end());
+  for (const uint32_t pixel : centers_) {
+    const int row = static_cast<int>(pixel) / cols_;
+    const int col = static_cast<int>(pixel) % cols_;
+    Node* node = &nodes_[row][col];
+    Node* node_neighbor = nullptr;
+    // right
+    if (col < cols_ - 1) {
+      node_neighbor = &nodes_[row][col + 1];
+      if (node_neighbor->is_center()) {
+        DisjointSetUnion(node, node_neighbor);
       }
-      // down
-      if (row < rows_ - 1) {
-        node_neighbor = &nodes_[row + 1][col];
-        if (node_neighbor->is_center()) {
-          DisjointSetUnion(node, node_neighbor);
-        }
+    }
+    // down
+    if (row < rows_ - 1) {
+      node_neighbor = &nodes_[row + 1][col];
+      if (node_neighbor->is_center()) {
+        DisjointSetUnion(node, node_neighbor);
       }
-      // right down
-      if (row < rows_ - 1 && col < cols_ - 1) {
-        node_neighbor = &nodes_[row + 1][col + 1];
-        if (node_neighbor->is_center()) {
-          DisjointSetUnion(node, node_neighbor);
-        }
+    }
+    // right down
+    if (row < rows_ - 1 && col < cols_ - 1) {
+      node_neighbor = &nodes_[row + 1][col + 1];
+      if (node_neighbor->is_center()) {
+        DisjointSetUnion(node, node_neighbor);
       }
-      // left down
-      if (row < rows_ - 1 && col > 0) {
-        node_neighbor = &nodes_[row + 1][col - 1];
-        if (node_neighbor->is_center()) {
-          DisjointSetUnion(node, node_neighbor);
-        }
+    }
+    // left down
+    if (row < rows_ - 1 && col > 0) {
+      node_neighbor = &nodes_[row + 1][col - 1];
+      if (node_neighbor->is_center()) {
+        DisjointSetUnion(node, node_neighbor);
       }
     }
   }
@@ -146,22 +177,18 @@ void SppCCDetector::UnionNodes() {
 
 size_t SppCCDetector::ToLabelMap(SppLabelImage* labels) {
   uint16_t id = 0;
-  uint32_t pixel_id = 0;
   labels->ResetClusters(kDefaultReserveSize);
-  for (int row = 0; row < rows_; ++row) {
-    for (int col = 0; col < cols_; ++col, ++pixel_id) {
-      Node* node = &nodes_[row][col];
-      if (!node->is_object()) {
-        (*labels)[row][col] = 0;
-        continue;
-      }
-      Node* root = DisjointSetFind(node);
+  uint16_t* label_ptr = (*labels)[0];
+  memset(label_ptr, 0, sizeof(uint16_t) * rows_ * cols_);
+  for (const auto& objects : block_objects_) {
+    for (const uint32_t pixel_id : objects) {
+      Node* root = DisjointSetFind(nodes_[0] + pixel_id);
       // note label in label image started from 1,
       // zero is reserved from non-object
       if (!root->id) {
         root->id = ++id;
       }
-      (*labels)[row][col] = root->id;
+      label_ptr[pixel_id] = root->id;
       labels->AddPixelSample(root->id - 1, pixel_id);
     }
   }
@@ -170,7 +197,7 @@ size_t SppCCDetector::ToLabelMap(SppLabelImage* labels) {
 }
 
 void SppCCDetector::Traverse(SppCCDetector::Node* x) {
-  std::vector<SppCCDetector::Node*> p;
+  std::vector<SppCCDetector::Node*>& p = traverse_path_;
   p.clear();
   while (x->get_traversed() == 0) {
     p.push_back(x);
@@ -180,8 +207,10 @@ void SppCCDetector::Traverse(SppCCDetector::Node* x) {
   if (x->get_traversed() == 2) {
     for (int i = static_cast<int>(p.size()) - 1; i >= 0 && p[i] != x; i--) {
       p[i]->set_is_center(true);
+      centers_.push_back(static_cast<uint32_t>(p[i] - nodes_[0]));
     }
     x->set_is_center(true);
+    centers_.push_back(static_cast<uint32_t>(x - nodes_[0]));
   }
   for (size_t i = 0; i < p.size(); i++) {
     Node* y = p[i];
@@ -55,6 +55,9 @@ class SppCCDetector {
   // @param [in]: objectness threshold
   void SetData(const float* const* prob_map, const float* offset_map,
                float scale, float objectness_threshold);
+  // @brief: set number of row blocks scanned in parallel
+  // @param [in]: number of threads, 1 keeps detection on the caller thread
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
   // @brief: detect clusters
   // @param [out]: label image
   // @return: label number
@@ -64,11 +67,15 @@ class SppCCDetector {
   // @brief: build node matrix given start row index and end row index
   // @param [in]: start row index, inclusive
   // @param [in]: end row index, exclusive
+  // @param [out]: object pixels of the rows in raster order
   // @param [out]: state of build nodes
-  bool BuildNodes(int start_row_index, int end_row_index);
-  // @brief: traverse node matrix
+  bool BuildNodes(int start_row_index, int end_row_index,
+                  std::vector<uint32_t>* objects);
+  // @brief: build node matrix by row blocks
+  void BuildNodeBlocks();
+  // @brief: traverse object nodes
   void TraverseNodes();
-  // @brief: union adjacent nodes
+  // @brief: union adjacent center nodes
   void UnionNodes();
   // @brief: collect clusters to label map
   size_t ToLabelMap(SppLabelImage* labels);
@@ -144,6 +151,13 @@ class SppCCDetector {
   lib::ThreadWorker worker_;
   bool first_process_ = true;
 
+  int num_threads_ = 1;
+  // object pixels of each row block, blocks are in row order so the
+  // concatenation is the raster order of the full scan
+  std::vector<std::vector<uint32_t>> block_objects_;
+  std::vector<uint32_t> centers_;
+  std::vector<Node*> traverse_path_;
+
  private:
   static const size_t kDefaultReserveSize = 500;
 };  // class SppCCDetector
@@ -98,6 +98,8 @@ bool NCutSegmentation::Init(const SegmentationInitOptions& options) {
       *roi_cloud_ = *original_cloud_;
       *roi_world_cloud_ = *original_world_cloud_;
     }
+    lidar_frame_ref_->RecordCopy(*roi_cloud_);
+    lidar_frame_ref_->RecordCopy(*roi_world_cloud_);
     lidar_frame_ref_->cloud = roi_cloud_;
     lidar_frame_ref_->world_cloud = roi_world_cloud_;
     AINFO << "lidar 2 world pose " << lidar_frame_ref_->lidar2world_pose(0, 3)
@@ -225,6 +227,7 @@ bool NCutSegmentation::Segment(const SegmentationOptions& options,
     cloud_above_ground->CopyPointCloud(*lidar_frame_ref_->cloud,
                                        lidar_frame_ref_->secondary_indices);
   }
+  lidar_frame_ref_->RecordCopy(*cloud_above_ground);
 
 #ifdef DEBUG_NCUT
   // filter_by_ground(cloud, non_ground_indices, &cloud_above_ground);
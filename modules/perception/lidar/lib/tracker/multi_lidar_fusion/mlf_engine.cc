@@ -22,6 +22,8 @@
 
 #include "cyber/common/file.h"
 #include "modules/localization/proto/localization.pb.h"
+#include "modules/perception/base/object_pool_types.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/lib/tracker/common/track_pool_types.h"
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/proto/multi_lidar_fusion_config.pb.h"
@@ -65,6 +67,12 @@ bool MlfEngine::Init(const MultiTargetTrackerInitOptions& options) {
   if (main_sensor_.empty()) {
     main_sensor_.emplace("velodyne64");  // default value
   }
+  // allocate the pools tracking draws from every frame ahead of time
+  if (FLAGS_enable_base_object_pool) {
+    base::ObjectPool::Instance().Warmup();
+    TrackedObjectPool::Instance().Warmup();
+    MlfTrackDataPool::Instance().Warmup();
+  }
 
   matcher_.reset(new MlfTrackObjectMatcher);
   MlfTrackObjectMatcherInitOptions matcher_init_options;
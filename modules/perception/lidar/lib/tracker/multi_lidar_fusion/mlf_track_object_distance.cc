@@ -16,6 +16,8 @@
 
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_track_object_distance.h"
 
+#include <limits>
+
 #include "cyber/common/file.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/lib/tracker/association/distance_collection.h"
@@ -87,6 +89,12 @@ bool MlfTrackObjectDistance::Init(
 float MlfTrackObjectDistance::ComputeDistance(
     const TrackedObjectConstPtr& object,
     const MlfTrackDataConstPtr& track) const {
+  return ComputeDistance(object, track, std::numeric_limits<float>::max());
+}
+
+float MlfTrackObjectDistance::ComputeDistance(
+    const TrackedObjectConstPtr& object, const MlfTrackDataConstPtr& track,
+    float gate) const {
   bool is_background = object->is_background;
   const TrackedObjectConstPtr latest_object = track->GetLatestObject().second;
   std::string key = latest_object->sensor_info.name + object->sensor_info.name;
@@ -123,6 +131,10 @@ float MlfTrackObjectDistance::ComputeDistance(
         weights->at(0) * LocationDistance(latest_object, track->predict_.state,
                                           object, time_diff);
   }
+  // every term is non-negative, a far pair can not get under the gate
+  if (distance >= gate) {
+    return distance;
+  }
   if (weights->at(1) > delta) {
     distance +=
         weights->at(1) * DirectionDistance(latest_object, track->predict_.state,
@@ -148,7 +160,7 @@ float MlfTrackObjectDistance::ComputeDistance(
                                                        track->predict_.state,
                                                        object, time_diff);
   }
-  if (weights->at(6) > delta) {
+  if (weights->at(6) > delta && distance < gate) {
     distance += weights->at(6) *
                 BboxIouDistance(latest_object, track->predict_.state, object,
                                 time_diff, background_object_match_threshold_);
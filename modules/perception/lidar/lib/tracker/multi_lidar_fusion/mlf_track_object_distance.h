@@ -43,6 +43,15 @@ class MlfTrackObjectDistance {
   float ComputeDistance(const TrackedObjectConstPtr& object,
                         const MlfTrackDataConstPtr& track) const;
 
+  // @brief: compute object track distance, the remaining terms are skipped
+  //         once the distance reaches the gate
+  // @params [in]: object
+  // @params [in]: track data
+  // @params [in]: gate of distance
+  // @return: distance, not less than gate if the pair is gated
+  float ComputeDistance(const TrackedObjectConstPtr& object,
+                        const MlfTrackDataConstPtr& track, float gate) const;
+
   std::string Name() const { return "MlfTrackObjectDistance"; }
 
  protected:
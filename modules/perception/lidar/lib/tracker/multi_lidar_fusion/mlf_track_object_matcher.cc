@@ -16,9 +16,14 @@
 
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_track_object_matcher.h"
 
+#include <algorithm>
+#include <future>
+#include <limits>
 #include <numeric>
 
 #include "cyber/common/file.h"
+#include "cyber/task/task.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/proto/multi_lidar_fusion_config.pb.h"
 
@@ -58,6 +63,7 @@ bool MlfTrackObjectMatcher::Init(
 
   bound_value_ = config.bound_value();
   max_match_distance_ = config.max_match_distance();
+  num_threads_ = std::max(1, FLAGS_mlf_match_num_threads);
   return true;
 }
 
@@ -104,10 +110,42 @@ void MlfTrackObjectMatcher::ComputeAssociateMatrix(
     const std::vector<MlfTrackDataPtr> &tracks,
     const std::vector<TrackedObjectPtr> &new_objects,
     common::SecureMat<float> *association_mat) {
-  for (size_t i = 0; i < tracks.size(); ++i) {
+  // pairs not under max_match_distance_ are never matched, so their
+  // distance only has to be known to reach it
+  const float gate = FLAGS_enable_mlf_match_gating
+                         ? max_match_distance_
+                         : std::numeric_limits<float>::max();
+  // each track predicts its state, so a track is only handled by one thread
+  const size_t num_workers =
+      std::min(static_cast<size_t>(num_threads_), tracks.size());
+  if (num_workers <= 1) {
+    ComputeAssociateRows(tracks, new_objects, 0, tracks.size(), gate,
+                         association_mat);
+    return;
+  }
+  std::vector<std::future<void>> results;
+  results.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; ++w) {
+    const size_t start = tracks.size() * w / num_workers;
+    const size_t end = tracks.size() * (w + 1) / num_workers;
+    results.push_back(cyber::Async([&, start, end]() {
+      ComputeAssociateRows(tracks, new_objects, start, end, gate,
+                           association_mat);
+    }));
+  }
+  for (auto &result : results) {
+    result.get();
+  }
+}
+
+void MlfTrackObjectMatcher::ComputeAssociateRows(
+    const std::vector<MlfTrackDataPtr> &tracks,
+    const std::vector<TrackedObjectPtr> &new_objects, size_t start, size_t end,
+    float gate, common::SecureMat<float> *association_mat) {
+  for (size_t i = start; i < end; ++i) {
     for (size_t j = 0; j < new_objects.size(); ++j) {
-      (*association_mat)(i, j) =
-          track_object_distance_->ComputeDistance(new_objects[j], tracks[i]);
+      (*association_mat)(i, j) = track_object_distance_->ComputeDistance(
+          new_objects[j], tracks[i], gate);
     }
   }
 }
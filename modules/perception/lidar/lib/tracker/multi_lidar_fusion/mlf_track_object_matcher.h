@@ -64,6 +64,11 @@ class MlfTrackObjectMatcher {
   void ComputeAssociateMatrix(const std::vector<MlfTrackDataPtr> &tracks,
                               const std::vector<TrackedObjectPtr> &new_objects,
                               common::SecureMat<float> *association_mat);
+  // @brief: compute rows of association matrix in [start, end)
+  void ComputeAssociateRows(const std::vector<MlfTrackDataPtr> &tracks,
+                            const std::vector<TrackedObjectPtr> &new_objects,
+                            size_t start, size_t end, float gate,
+                            common::SecureMat<float> *association_mat);
 
  protected:
   std::unique_ptr<MlfTrackObjectDistance> track_object_distance_;
@@ -73,6 +78,7 @@ class MlfTrackObjectMatcher {
   float bound_value_ = 100.f;
   float max_match_distance_ = 4.0f;
   bool use_semantic_map = false;
+  int num_threads_ = 1;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(MlfTrackObjectMatcher);
@@ -23,6 +23,7 @@
 #include "cyber/common/log.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/perception/base/object_pool_types.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/common/geometry/common.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 
@@ -58,11 +59,22 @@ bool HDMapInput::InitInternal() {
   if (!InitHDMap()) {
     return false;
   }
+  if (FLAGS_enable_hdmap_tile_cache) {
+    tile_cache_.Init(FLAGS_hdmap_tile_size, FLAGS_hdmap_tile_cache_capacity,
+                     [this](const base::PointD& center, const double distance,
+                            base::HdmapStruct* hdmap_struct) {
+                       lib::MutexLock lock(&mutex_);
+                       return BuildRoiHDMapStruct(center, distance,
+                                                  hdmap_struct);
+                     });
+  }
   inited_ = true;
   return true;
 }
 
 bool HDMapInput::Reset() {
+  // the tile prefetches take mutex_
+  tile_cache_.Clear();
   lib::MutexLock lock(&mutex_);
   inited_ = false;
   return InitInternal();
@@ -106,7 +118,19 @@ bool HDMapInput::InitHDMap() {
 bool HDMapInput::GetRoiHDMapStruct(
     const base::PointD& pointd, const double distance,
     std::shared_ptr<base::HdmapStruct> hdmap_struct_ptr) {
+  if (hdmap_struct_ptr == nullptr) {
+    return false;
+  }
+  if (FLAGS_enable_hdmap_tile_cache) {
+    return tile_cache_.Get(pointd, distance, hdmap_struct_ptr.get());
+  }
   lib::MutexLock lock(&mutex_);
+  return BuildRoiHDMapStruct(pointd, distance, hdmap_struct_ptr.get());
+}
+
+bool HDMapInput::BuildRoiHDMapStruct(const base::PointD& pointd,
+                                     const double distance,
+                                     base::HdmapStruct* hdmap_struct_ptr) {
   if (hdmap_.get() == nullptr) {
     AERROR << "hdmap is not available";
     return false;
@@ -123,9 +147,6 @@ bool HDMapInput::GetRoiHDMapStruct(
     AERROR << "Failed to get road boundary, point: " << point.DebugString();
     return false;
   }
-  if (hdmap_struct_ptr == nullptr) {
-    return false;
-  }
   hdmap_struct_ptr->hole_polygons.clear();
   hdmap_struct_ptr->junction_polygons.clear();
   hdmap_struct_ptr->road_boundary.clear();
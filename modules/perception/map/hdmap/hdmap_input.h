@@ -26,6 +26,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/perception/base/hdmap_struct.h"
 #include "modules/perception/lib/thread/mutex.h"
+#include "modules/perception/map/hdmap/hdmap_tile_cache.h"
 
 namespace apollo {
 namespace perception {
@@ -47,6 +48,9 @@ class HDMapInput {
   bool InitHDMap();
   bool InitInternal();
 
+  bool BuildRoiHDMapStruct(const base::PointD& pointd, const double distance,
+                           base::HdmapStruct* hdmap_struct_ptr);
+
   void MergeBoundaryJunction(
       const std::vector<apollo::hdmap::RoadRoiPtr>& boundary,
       const std::vector<apollo::hdmap::JunctionInfoConstPtr>& junctions,
@@ -82,6 +86,7 @@ class HDMapInput {
   std::unique_ptr<apollo::hdmap::HDMap> hdmap_;
   int hdmap_sample_step_ = 5;
   std::string hdmap_file_;
+  HDMapTileCache tile_cache_;
 
   DECLARE_SINGLETON(HDMapInput)
 };
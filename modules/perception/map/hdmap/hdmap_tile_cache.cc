@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/map/hdmap/hdmap_tile_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+
+namespace apollo {
+namespace perception {
+namespace map {
+
+HDMapTileCache::~HDMapTileCache() { WaitForPrefetch(); }
+
+void HDMapTileCache::Init(const double tile_size, const size_t capacity,
+                          const Builder& builder) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tile_size_ = tile_size > 0.0 ? tile_size : 100.0;
+  // the current tile and its eight neighbours are always wanted
+  capacity_ = std::max<size_t>(capacity, 9);
+  builder_ = builder;
+  tiles_.clear();
+  frame_ = 0;
+  num_built_tiles_ = 0;
+}
+
+double HDMapTileCache::TileDistance(const double distance) const {
+  // the query circle of any point in the tile lies in this circle around
+  // the tile center
+  return distance + tile_size_ * std::sqrt(0.5);
+}
+
+bool HDMapTileCache::Get(const base::PointD& point, const double distance,
+                         base::HdmapStruct* hdmap_struct) {
+  if (hdmap_struct == nullptr || !builder_) {
+    return false;
+  }
+  const int64_t tx = static_cast<int64_t>(std::floor(point.x / tile_size_));
+  const int64_t ty = static_cast<int64_t>(std::floor(point.y / tile_size_));
+  const int64_t key = Key(tx, ty);
+  const double tile_distance = TileDistance(distance);
+
+  base::HdmapStructConstPtr tile_struct = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++frame_;
+    auto iter = tiles_.find(key);
+    if (iter != tiles_.end() && iter->second.distance >= tile_distance) {
+      iter->second.last_used = frame_;
+      tile_struct = iter->second.hdmap_struct;
+    }
+  }
+  if (tile_struct == nullptr) {
+    ADEBUG << "Hdmap tile cache miss at tile " << tx << ", " << ty;
+    tile_struct = BuildTile(tx, ty, point.z, tile_distance);
+    if (tile_struct == nullptr) {
+      return false;
+    }
+    Insert(key, tile_struct, tile_distance);
+  }
+  *hdmap_struct = *tile_struct;
+  Prefetch(tx, ty, point.z, tile_distance);
+  return true;
+}
+
+base::HdmapStructConstPtr HDMapTileCache::BuildTile(const int64_t tx,
+                                                    const int64_t ty,
+                                                    const double z,
+                                                    const double distance) {
+  base::PointD center;
+  center.x = (static_cast<double>(tx) + 0.5) * tile_size_;
+  center.y = (static_cast<double>(ty) + 0.5) * tile_size_;
+  center.z = z;
+  base::HdmapStructPtr hdmap_struct(new base::HdmapStruct);
+  if (!builder_(center, distance, hdmap_struct.get())) {
+    AERROR << "Failed to build hdmap tile " << tx << ", " << ty;
+    return nullptr;
+  }
+  return hdmap_struct;
+}
+
+void HDMapTileCache::Insert(const int64_t key,
+                            const base::HdmapStructConstPtr& hdmap_struct,
+                            const double distance) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Tile& tile = tiles_[key];
+  tile.hdmap_struct = hdmap_struct;
+  tile.distance = distance;
+  tile.last_used = frame_;
+  ++num_built_tiles_;
+  while (tiles_.size() > capacity_) {
+    auto oldest = tiles_.begin();
+    for (auto iter = tiles_.begin(); iter != tiles_.end(); ++iter) {
+      if (iter->second.last_used < oldest->second.last_used) {
+        oldest = iter;
+      }
+    }
+    tiles_.erase(oldest);
+  }
+}
+
+void HDMapTileCache::Prefetch(const int64_t tx, const int64_t ty,
+                              const double z, const double distance) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto iter = prefetches_.begin(); iter != prefetches_.end();) {
+    if (iter->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      iter = prefetches_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  for (int64_t dy = -1; dy <= 1; ++dy) {
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      const int64_t key = Key(tx + dx, ty + dy);
+      auto iter = tiles_.find(key);
+      if ((iter != tiles_.end() && iter->second.distance >= distance) ||
+          pending_.count(key) > 0) {
+        continue;
+      }
+      pending_.insert(key);
+      prefetches_.push_back(cyber::Async([this, tx, ty, dx, dy, z, distance,
+                                          key]() {
+        auto hdmap_struct = BuildTile(tx + dx, ty + dy, z, distance);
+        if (hdmap_struct != nullptr) {
+          Insert(key, hdmap_struct, distance);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.erase(key);
+      }));
+    }
+  }
+}
+
+void HDMapTileCache::WaitForPrefetch() {
+  std::vector<std::future<void>> prefetches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    prefetches.swap(prefetches_);
+  }
+  for (auto& prefetch : prefetches) {
+    prefetch.wait();
+  }
+}
+
+void HDMapTileCache::Clear() {
+  WaitForPrefetch();
+  std::lock_guard<std::mutex> lock(mutex_);
+  tiles_.clear();
+}
+
+size_t HDMapTileCache::NumTiles() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tiles_.size();
+}
+
+size_t HDMapTileCache::NumBuiltTiles() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_built_tiles_;
+}
+
+}  // namespace map
+}  // namespace perception
+}  // namespace apollo
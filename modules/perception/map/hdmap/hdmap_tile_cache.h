@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "modules/perception/base/hdmap_struct.h"
+
+namespace apollo {
+namespace perception {
+namespace map {
+
+// Keeps the perception ready hdmap struct of square world tiles around the
+// vehicle. A tile is built once around its center with a radius that covers
+// the query distance from anywhere inside the tile, so frames inside a cached
+// tile are served by a copy instead of a map query. The tiles around the
+// current one are built in the background before the vehicle reaches them.
+class HDMapTileCache {
+ public:
+  using Builder = std::function<bool(const base::PointD& center,
+                                     const double distance,
+                                     base::HdmapStruct* hdmap_struct)>;
+
+  HDMapTileCache() = default;
+  ~HDMapTileCache();
+
+  void Init(const double tile_size, const size_t capacity,
+            const Builder& builder);
+
+  // thread safe
+  bool Get(const base::PointD& point, const double distance,
+           base::HdmapStruct* hdmap_struct);
+  void Clear();
+  void WaitForPrefetch();
+
+  size_t NumTiles() const;
+  size_t NumBuiltTiles() const;
+
+ private:
+  struct Tile {
+    base::HdmapStructConstPtr hdmap_struct;
+    double distance = 0.0;
+    uint64_t last_used = 0;
+  };
+
+  static int64_t Key(const int64_t tx, const int64_t ty) {
+    return (tx << 32) ^ (ty & 0xffffffff);
+  }
+
+  double TileDistance(const double distance) const;
+  base::HdmapStructConstPtr BuildTile(const int64_t tx, const int64_t ty,
+                                      const double z, const double distance);
+  void Insert(const int64_t key, const base::HdmapStructConstPtr& hdmap_struct,
+              const double distance);
+  void Prefetch(const int64_t tx, const int64_t ty, const double z,
+                const double distance);
+
+  double tile_size_ = 100.0;
+  size_t capacity_ = 32;
+  Builder builder_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<int64_t, Tile> tiles_;
+  std::unordered_set<int64_t> pending_;
+  std::vector<std::future<void>> prefetches_;
+  uint64_t frame_ = 0;
+  size_t num_built_tiles_ = 0;
+};
+
+}  // namespace map
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/map/hdmap/hdmap_tile_cache.h"
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace map {
+
+// a map with one road polygon point at the query center
+bool BuildCenter(const base::PointD& center, const double distance,
+                 base::HdmapStruct* hdmap_struct) {
+  base::PointCloud<base::PointD> polygon;
+  polygon.push_back(center);
+  hdmap_struct->road_polygons.push_back(polygon);
+  return distance > 0.0;
+}
+
+TEST(HDMapTileCacheTest, serve_from_tile) {
+  std::atomic<int> num_builds(0);
+  HDMapTileCache cache;
+  cache.Init(100.0, 16,
+             [&num_builds](const base::PointD& center, const double distance,
+                           base::HdmapStruct* hdmap_struct) {
+               ++num_builds;
+               return BuildCenter(center, distance, hdmap_struct);
+             });
+
+  base::PointD point;
+  point.x = 10.0;
+  point.y = 90.0;
+  point.z = 0.0;
+  base::HdmapStruct hdmap_struct;
+  EXPECT_TRUE(cache.Get(point, 50.0, &hdmap_struct));
+  ASSERT_EQ(hdmap_struct.road_polygons.size(), 1);
+  EXPECT_DOUBLE_EQ(hdmap_struct.road_polygons[0][0].x, 50.0);
+  EXPECT_DOUBLE_EQ(hdmap_struct.road_polygons[0][0].y, 50.0);
+  cache.WaitForPrefetch();
+  EXPECT_EQ(cache.NumTiles(), 9);
+  EXPECT_EQ(num_builds, 9);
+
+  // same tile and a prefetched neighbour do not build
+  point.x = 60.0;
+  EXPECT_TRUE(cache.Get(point, 50.0, &hdmap_struct));
+  point.x = 150.0;
+  EXPECT_TRUE(cache.Get(point, 50.0, &hdmap_struct));
+  EXPECT_DOUBLE_EQ(hdmap_struct.road_polygons[0][0].x, 150.0);
+  EXPECT_LE(num_builds, 9 + 3);
+  cache.WaitForPrefetch();
+  EXPECT_EQ(num_builds, 12);
+
+  // a larger query distance rebuilds the tile
+  EXPECT_TRUE(cache.Get(point, 80.0, &hdmap_struct));
+  cache.WaitForPrefetch();
+  EXPECT_GT(num_builds, 12);
+
+  cache.Clear();
+  EXPECT_EQ(cache.NumTiles(), 0);
+}
+
+TEST(HDMapTileCacheTest, capacity) {
+  HDMapTileCache cache;
+  cache.Init(10.0, 9, BuildCenter);
+  base::HdmapStruct hdmap_struct;
+  base::PointD point;
+  point.y = 0.0;
+  point.z = 0.0;
+  for (int i = 0; i < 10; ++i) {
+    point.x = 10.0 * i + 5.0;
+    EXPECT_TRUE(cache.Get(point, 5.0, &hdmap_struct));
+    cache.WaitForPrefetch();
+    EXPECT_LE(cache.NumTiles(), 9);
+  }
+
+  // tiles that fail to build are not cached
+  cache.Clear();
+  EXPECT_FALSE(cache.Get(point, -100.0, &hdmap_struct));
+  cache.WaitForPrefetch();
+  EXPECT_EQ(cache.NumTiles(), 0);
+}
+
+}  // namespace map
+}  // namespace perception
+}  // namespace apollo
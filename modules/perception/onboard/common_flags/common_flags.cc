@@ -29,6 +29,19 @@ DEFINE_bool(obs_benchmark_mode, false,
 DEFINE_bool(obs_save_fusion_supplement, false,
             "whether save fusion supplement data, default false");
 DEFINE_bool(start_visualizer, false, "Whether to start visualizer");
+DEFINE_bool(obs_enable_radar_shared_roi, false,
+            "Share one hdmap roi query around the vehicle between radars");
+DEFINE_double(obs_radar_shared_roi_margin, 20.0,
+              "Extra radius of the shared radar roi query, so that the "
+              "vehicle can move before the roi is queried again, in m");
+DEFINE_bool(obs_enable_async_fusion, false,
+            "Fuse sensor frames on a dedicated thread and publish obstacles "
+            "on a fixed period");
+DEFINE_int32(obs_async_fusion_publish_period_ms, 100,
+             "Publish period of the asynchronous fusion output in ms");
+DEFINE_double(obs_async_fusion_max_prediction_time, 0.3,
+              "Stop publishing when the latest fused output is older than "
+              "this, in seconds");
 
 }  // namespace onboard
 }  // namespace perception
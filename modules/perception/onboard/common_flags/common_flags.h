@@ -27,6 +27,11 @@ DECLARE_string(obs_screen_output_dir);
 DECLARE_bool(obs_benchmark_mode);
 DECLARE_bool(obs_save_fusion_supplement);
 DECLARE_bool(start_visualizer);
+DECLARE_bool(obs_enable_async_fusion);
+DECLARE_bool(obs_enable_radar_shared_roi);
+DECLARE_double(obs_radar_shared_roi_margin);
+DECLARE_int32(obs_async_fusion_publish_period_ms);
+DECLARE_double(obs_async_fusion_max_prediction_time);
 
 }  // namespace onboard
 }  // namespace perception
@@ -694,6 +694,8 @@ int FusionCameraDetectionComponent::InternalProc(
   // frame_size != 0, see InitCameraFrames()
   camera_frame.camera2world_pose = camera2world_trans;
   camera_frame.data_provider = data_providers_map_[camera_name].get();
+  const base::TransferStats transfer_begin =
+      base::SyncedMemory::transfer_stats();
   camera_frame.data_provider->FillImageData(
       image_height_, image_width_,
       reinterpret_cast<const uint8_t *>(in_message->data().data()),
@@ -721,6 +723,14 @@ int FusionCameraDetectionComponent::InternalProc(
     prefused_message->error_code_ = *error_code;
     return cyber::FAIL;
   }
+  // the image is uploaded once, anything beyond that and the detection
+  // outputs read back is a host round trip worth looking at
+  const base::TransferStats transfer =
+      base::SyncedMemory::transfer_stats() - transfer_begin;
+  AINFO << camera_name << " host to device: " << transfer.host_to_device_count
+        << " copies " << transfer.host_to_device_bytes
+        << " bytes, device to host: " << transfer.device_to_host_count
+        << " copies " << transfer.device_to_host_bytes << " bytes";
   AINFO << "##" << camera_name << ": pitch "
         << camera_frame.calibration_service->QueryPitchAngle()
         << " | camera_grond_height "
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/onboard/component/fusion_component.h"
 
+#include <limits>
+
 #include "cyber/time/clock.h"
 #include "modules/common/util/perf_util.h"
 #include "modules/perception/base/object_pool_types.h"
@@ -25,6 +27,11 @@ namespace apollo {
 namespace perception {
 namespace onboard {
 
+namespace {
+// frames kept for each sensor while the fusion thread is busy
+constexpr size_t kMaxQueuedFramesPerSensor = 10;
+}  // namespace
+
 uint32_t FusionComponent::s_seq_num_ = 0;
 std::mutex FusionComponent::s_mutex_;
 
@@ -47,6 +54,9 @@ bool FusionComponent::Init() {
       comp_config.output_obstacles_channel_name());
   inner_writer_ = node_->CreateWriter<SensorFrameMessage>(
       comp_config.output_viz_fused_content_channel_name());
+  if (FLAGS_obs_enable_async_fusion) {
+    StartAsyncFusion();
+  }
   return true;
 }
 
@@ -54,6 +64,10 @@ bool FusionComponent::Proc(const std::shared_ptr<SensorFrameMessage>& message) {
   if (message->process_stage_ == ProcessStage::SENSOR_FUSION) {
     return true;
   }
+  if (FLAGS_obs_enable_async_fusion) {
+    EnqueueMessage(message);
+    return true;
+  }
   std::shared_ptr<PerceptionObstacles> out_message(new (std::nothrow)
                                                        PerceptionObstacles);
   std::shared_ptr<SensorFrameMessage> viz_message(new (std::nothrow)
@@ -78,6 +92,131 @@ bool FusionComponent::Proc(const std::shared_ptr<SensorFrameMessage>& message) {
   return status;
 }
 
+void FusionComponent::Clear() {
+  if (publish_timer_ != nullptr) {
+    publish_timer_->Stop();
+  }
+  async_stop_ = true;
+  queue_cv_.notify_all();
+  if (async_fusion_thread_.joinable()) {
+    async_fusion_thread_.join();
+  }
+}
+
+void FusionComponent::StartAsyncFusion() {
+  async_fusion_thread_ = std::thread(&FusionComponent::AsyncFusionLoop, this);
+  publish_timer_.reset(new cyber::Timer(
+      static_cast<uint32_t>(FLAGS_obs_async_fusion_publish_period_ms),
+      [this]() { PublishAsyncOutput(); }, false));
+  publish_timer_->Start();
+  AINFO << "Async fusion publishes every "
+        << FLAGS_obs_async_fusion_publish_period_ms << " ms";
+}
+
+void FusionComponent::EnqueueMessage(
+    const std::shared_ptr<SensorFrameMessage>& message) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    auto& queue = sensor_queues_[message->sensor_id_];
+    if (queue.size() >= kMaxQueuedFramesPerSensor) {
+      AWARN << "Fusion drops the oldest frame of " << message->sensor_id_;
+      queue.pop_front();
+    }
+    queue.push_back(message);
+  }
+  queue_cv_.notify_one();
+}
+
+bool FusionComponent::PopEarliestMessage(
+    std::shared_ptr<SensorFrameMessage>* message) {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  std::deque<std::shared_ptr<SensorFrameMessage>>* earliest = nullptr;
+  queue_cv_.wait(lock, [this, &earliest] {
+    if (async_stop_) {
+      return true;
+    }
+    double earliest_time = std::numeric_limits<double>::max();
+    for (auto& item : sensor_queues_) {
+      if (!item.second.empty() &&
+          item.second.front()->timestamp_ < earliest_time) {
+        earliest_time = item.second.front()->timestamp_;
+        earliest = &item.second;
+      }
+    }
+    return earliest != nullptr;
+  });
+  if (async_stop_) {
+    return false;
+  }
+  *message = earliest->front();
+  earliest->pop_front();
+  return true;
+}
+
+void FusionComponent::AsyncFusionLoop() {
+  std::shared_ptr<SensorFrameMessage> message;
+  while (PopEarliestMessage(&message)) {
+    std::shared_ptr<PerceptionObstacles> out_message(new (std::nothrow)
+                                                         PerceptionObstacles);
+    std::shared_ptr<SensorFrameMessage> viz_message(new (std::nothrow)
+                                                        SensorFrameMessage);
+    if (!InternalProc(message, out_message, viz_message) ||
+        message->sensor_id_ != fusion_main_sensor_) {
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(output_mutex_);
+      latest_output_ = out_message;
+      latest_output_time_ = message->timestamp_;
+    }
+    if (FLAGS_obs_enable_visualization) {
+      inner_writer_->Write(viz_message);
+    }
+  }
+}
+
+void FusionComponent::PublishAsyncOutput() {
+  std::shared_ptr<PerceptionObstacles> latest_output;
+  double latest_output_time = 0.0;
+  {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    latest_output = latest_output_;
+    latest_output_time = latest_output_time_;
+  }
+  if (latest_output == nullptr) {
+    return;
+  }
+  const double publish_time = ::apollo::cyber::Clock::NowInSeconds();
+  const double dt = publish_time - latest_output_time;
+  if (dt > FLAGS_obs_async_fusion_max_prediction_time) {
+    AWARN << "Latest fused output is " << dt << " s old, skip publishing.";
+    return;
+  }
+
+  // constant velocity prediction to the publish time
+  std::shared_ptr<PerceptionObstacles> out_message(new (std::nothrow)
+                                                       PerceptionObstacles);
+  out_message->CopyFrom(*latest_output);
+  out_message->mutable_header()->set_timestamp_sec(publish_time);
+  out_message->mutable_header()->set_sequence_num(async_seq_num_++);
+  if (dt > 0.0) {
+    for (auto& obstacle : *out_message->mutable_perception_obstacle()) {
+      const double dx = obstacle.velocity().x() * dt;
+      const double dy = obstacle.velocity().y() * dt;
+      auto* position = obstacle.mutable_position();
+      position->set_x(position->x() + dx);
+      position->set_y(position->y() + dy);
+      for (auto& point : *obstacle.mutable_polygon_point()) {
+        point.set_x(point.x() + dx);
+        point.set_y(point.y() + dy);
+      }
+    }
+  }
+  writer_->Write(out_message);
+  ADEBUG << "Async fusion published " << out_message->perception_obstacle_size()
+         << " obstacles predicted by " << dt << " s";
+}
+
 bool FusionComponent::InitAlgorithmPlugin() {
   fusion_.reset(new fusion::ObstacleMultiSensorFusion());
   fusion::ObstacleMultiSensorFusionParam param;
@@ -15,11 +15,18 @@
  *****************************************************************************/
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "cyber/component/component.h"
+#include "cyber/timer/timer.h"
 #include "modules/perception/base/object.h"
 #include "modules/perception/fusion/app/obstacle_multi_sensor_fusion.h"
 #include "modules/perception/fusion/lib/interface/base_fusion_system.h"
@@ -39,11 +46,22 @@ class FusionComponent : public cyber::Component<SensorFrameMessage> {
   bool Proc(const std::shared_ptr<SensorFrameMessage>& message) override;
 
  private:
+  void Clear() override;
+
   bool InitAlgorithmPlugin();
   bool InternalProc(const std::shared_ptr<SensorFrameMessage const>& in_message,
                     std::shared_ptr<PerceptionObstacles> out_message,
                     std::shared_ptr<SensorFrameMessage> viz_message);
 
+  // asynchronous mode, the reader only queues the frame, the fusion thread
+  // fuses the queued frames in time order and the publish timer sends the
+  // latest output predicted to the publish time
+  void StartAsyncFusion();
+  void EnqueueMessage(const std::shared_ptr<SensorFrameMessage>& message);
+  bool PopEarliestMessage(std::shared_ptr<SensorFrameMessage>* message);
+  void AsyncFusionLoop();
+  void PublishAsyncOutput();
+
  private:
   static std::mutex s_mutex_;
   static uint32_t s_seq_num_;
@@ -57,6 +75,19 @@ class FusionComponent : public cyber::Component<SensorFrameMessage> {
   map::HDMapInput* hdmap_input_ = nullptr;
   std::shared_ptr<apollo::cyber::Writer<PerceptionObstacles>> writer_;
   std::shared_ptr<apollo::cyber::Writer<SensorFrameMessage>> inner_writer_;
+
+  std::map<std::string, std::deque<std::shared_ptr<SensorFrameMessage>>>
+      sensor_queues_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::atomic<bool> async_stop_{false};
+  std::thread async_fusion_thread_;
+  std::unique_ptr<cyber::Timer> publish_timer_;
+
+  std::mutex output_mutex_;
+  std::shared_ptr<PerceptionObstacles> latest_output_;
+  double latest_output_time_ = 0.0;
+  uint32_t async_seq_num_ = 0;
 };
 
 CYBER_REGISTER_COMPONENT(FusionComponent);
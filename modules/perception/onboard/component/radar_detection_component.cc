@@ -25,6 +25,12 @@ namespace apollo {
 namespace perception {
 namespace onboard {
 
+std::mutex RadarDetectionComponent::s_roi_mutex_;
+base::HdmapStructPtr RadarDetectionComponent::s_roi_ = nullptr;
+Eigen::Vector3d RadarDetectionComponent::s_roi_center_ =
+    Eigen::Vector3d::Zero();
+double RadarDetectionComponent::s_roi_distance_ = 0.0;
+
 bool RadarDetectionComponent::Init() {
   RadarComponentConfig comp_config;
   if (!GetProtoConfig(&comp_config)) {
@@ -161,10 +167,15 @@ bool RadarDetectionComponent::InternalProc(
   position.x = radar_trans(0, 3);
   position.y = radar_trans(1, 3);
   position.z = radar_trans(2, 3);
-  options.roi_filter_options.roi.reset(new base::HdmapStruct());
-  if (FLAGS_obs_enable_hdmap_input) {
-    hdmap_input_->GetRoiHDMapStruct(position, radar_forward_distance_,
-                                    options.roi_filter_options.roi);
+  if (FLAGS_obs_enable_hdmap_input && FLAGS_obs_enable_radar_shared_roi) {
+    options.roi_filter_options.roi =
+        GetSharedRoi(radar_trans, radar2novatel_trans);
+  } else {
+    options.roi_filter_options.roi.reset(new base::HdmapStruct());
+    if (FLAGS_obs_enable_hdmap_input) {
+      hdmap_input_->GetRoiHDMapStruct(position, radar_forward_distance_,
+                                      options.roi_filter_options.roi);
+    }
   }
   PERF_BLOCK_END_WITH_INDICATOR(radar_info_.name, "GetRoiHDMapStruct");
   // Init object_filter_options
@@ -195,6 +206,42 @@ bool RadarDetectionComponent::InternalProc(
   return true;
 }
 
+base::HdmapStructPtr RadarDetectionComponent::GetSharedRoi(
+    const Eigen::Affine3d& radar2world, const Eigen::Affine3d& radar2novatel) {
+  const Eigen::Vector3d radar_center = radar2world.translation();
+  std::lock_guard<std::mutex> lock(s_roi_mutex_);
+  // the shared query still covers the forward distance of this radar
+  if (s_roi_ != nullptr &&
+      (radar_center - s_roi_center_).head<2>().norm() +
+              radar_forward_distance_ <=
+          s_roi_distance_) {
+    return s_roi_;
+  }
+
+  // query around the vehicle with a radius covering every radar mounted as
+  // far from it as this one
+  const Eigen::Affine3d novatel2world = radar2world * radar2novatel.inverse();
+  base::HdmapStructPtr roi(new base::HdmapStruct());
+  const Eigen::Vector3d center = novatel2world.translation();
+  const double distance = radar_forward_distance_ +
+                          radar2novatel.translation().head<2>().norm() +
+                          FLAGS_obs_radar_shared_roi_margin;
+  base::PointD position;
+  position.x = center(0);
+  position.y = center(1);
+  position.z = center(2);
+  if (!hdmap_input_->GetRoiHDMapStruct(position, distance, roi)) {
+    AERROR << "Failed to get shared radar roi.";
+    return roi;
+  }
+  ADEBUG << "Shared radar roi queried by " << radar_info_.name << " with "
+         << distance << " m";
+  s_roi_ = roi;
+  s_roi_center_ = center;
+  s_roi_distance_ = distance;
+  return s_roi_;
+}
+
 bool RadarDetectionComponent::GetCarLocalizationSpeed(
     double timestamp, Eigen::Vector3f* car_linear_speed,
     Eigen::Vector3f* car_angular_speed) {
@@ -62,6 +62,9 @@ class RadarDetectionComponent : public cyber::Component<ContiRadar> {
   bool GetCarLocalizationSpeed(double timestamp,
                                Eigen::Vector3f* car_linear_speed,
                                Eigen::Vector3f* car_angular_speed);
+  // roi queried once around the vehicle for all radars in the process
+  base::HdmapStructPtr GetSharedRoi(const Eigen::Affine3d& radar2world,
+                                    const Eigen::Affine3d& radar2novatel);
 
   RadarDetectionComponent(const RadarDetectionComponent&) = delete;
   RadarDetectionComponent& operator=(const RadarDetectionComponent&) = delete;
@@ -85,6 +88,11 @@ class RadarDetectionComponent : public cyber::Component<ContiRadar> {
   std::shared_ptr<radar::BaseRadarObstaclePerception> radar_perception_;
   MsgBuffer<LocalizationEstimate> localization_subscriber_;
   std::shared_ptr<apollo::cyber::Writer<SensorFrameMessage>> writer_;
+
+  static std::mutex s_roi_mutex_;
+  static base::HdmapStructPtr s_roi_;
+  static Eigen::Vector3d s_roi_center_;
+  static double s_roi_distance_;
 };
 
 CYBER_REGISTER_COMPONENT(RadarDetectionComponent);
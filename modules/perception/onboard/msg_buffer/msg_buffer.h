@@ -15,13 +15,16 @@
  *****************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
-#include <boost/circular_buffer.hpp>
 #include "gflags/gflags.h"
 
 #include "cyber/cyber.h"
@@ -33,6 +36,10 @@ namespace onboard {
 DECLARE_int32(obs_msg_buffer_size);
 DECLARE_double(obs_buffer_match_precision);
 
+// Keeps the last FLAGS_obs_msg_buffer_size messages of a channel in a ring
+// sorted by measurement time, which is binary searched by the lookups.
+// The subscriber publishes each message under a sequence lock so lookups
+// never block on it, they only retry when it wrote a message meanwhile.
 template <class T>
 class MsgBuffer {
  public:
@@ -40,7 +47,7 @@ class MsgBuffer {
   typedef std::pair<double, ConstPtr> ObjectPair;
 
  public:
-  MsgBuffer() : buffer_queue_(FLAGS_obs_msg_buffer_size) {}
+  MsgBuffer() = default;
   ~MsgBuffer() = default;
 
   MsgBuffer(const MsgBuffer&) = delete;
@@ -59,14 +66,36 @@ class MsgBuffer {
  private:
   void MsgCallback(const ConstPtr& msg);
 
+  // slot of the index-th message ever pushed
+  size_t Slot(uint64_t index) const { return index % capacity_; }
+  double TimestampAt(uint64_t index) const {
+    return timestamps_[Slot(index)].load(std::memory_order_relaxed);
+  }
+  // first index in [begin, end) whose timestamp is greater than timestamp
+  uint64_t UpperBound(uint64_t begin, uint64_t end, double timestamp) const;
+  // first index in [begin, end) whose timestamp is not less than timestamp
+  uint64_t LowerBound(uint64_t begin, uint64_t end, double timestamp) const;
+  // sequence to read the buffer at, once the subscriber is done writing
+  uint64_t ReadBegin() const;
+  // true if the subscriber wrote since ReadBegin returned sequence
+  bool ReadRetry(uint64_t sequence) const;
+
  private:
   std::string node_name_;
   std::unique_ptr<cyber::Node> node_;
   std::shared_ptr<cyber::Reader<T>> msg_subscriber_;
   std::mutex buffer_mutex_;
 
-  bool init_ = false;
-  boost::circular_buffer<ObjectPair> buffer_queue_;
+  std::atomic<bool> init_{false};
+  size_t capacity_ = 0;
+  std::unique_ptr<std::atomic<double>[]> timestamps_;
+  // read and written with the atomic shared_ptr functions, a lookup
+  // may copy a slot while the subscriber replaces it
+  std::unique_ptr<ConstPtr[]> msgs_;
+  // number of messages ever pushed
+  std::atomic<uint64_t> size_{0};
+  // odd while the subscriber is writing a slot
+  std::atomic<uint64_t> sequence_{0};
 };
 
 template <class T>
@@ -79,114 +108,211 @@ void MsgBuffer<T>::Init(const std::string& channel, const std::string& name) {
   }
   node_.reset(apollo::cyber::CreateNode(node_name_).release());
 
+  {
+    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    capacity_ = static_cast<size_t>(std::max(1, FLAGS_obs_msg_buffer_size));
+    timestamps_.reset(new std::atomic<double>[capacity_]);
+    for (size_t i = 0; i < capacity_; ++i) {
+      timestamps_[i].store(0.0, std::memory_order_relaxed);
+    }
+    msgs_.reset(new ConstPtr[capacity_]);
+    size_.store(0, std::memory_order_relaxed);
+    init_.store(true, std::memory_order_release);
+  }
+
   std::function<void(const ConstPtr&)> register_call =
       std::bind(&MsgBuffer<T>::MsgCallback, this, std::placeholders::_1);
   msg_subscriber_ = node_->CreateReader<T>(channel, register_call);
-
-  std::lock_guard<std::mutex> lock(buffer_mutex_);
-  buffer_queue_.set_capacity(FLAGS_obs_msg_buffer_size);
-  init_ = true;
 }
 
 template <class T>
 void MsgBuffer<T>::MsgCallback(const ConstPtr& msg) {
   std::lock_guard<std::mutex> lock(buffer_mutex_);
   double timestamp = msg->measurement_time();
-  buffer_queue_.push_back(std::make_pair(timestamp, msg));
+  const uint64_t size = size_.load(std::memory_order_relaxed);
+  const size_t slot = Slot(size);
+  const uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+  sequence_.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  timestamps_[slot].store(timestamp, std::memory_order_relaxed);
+  std::atomic_store_explicit(&msgs_[slot], msg, std::memory_order_relaxed);
+  size_.store(size + 1, std::memory_order_relaxed);
+  sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+template <class T>
+uint64_t MsgBuffer<T>::UpperBound(uint64_t begin, uint64_t end,
+                                  double timestamp) const {
+  while (begin < end) {
+    const uint64_t mid = begin + (end - begin) / 2;
+    if (TimestampAt(mid) > timestamp) {
+      end = mid;
+    } else {
+      begin = mid + 1;
+    }
+  }
+  return begin;
+}
+
+template <class T>
+uint64_t MsgBuffer<T>::LowerBound(uint64_t begin, uint64_t end,
+                                  double timestamp) const {
+  while (begin < end) {
+    const uint64_t mid = begin + (end - begin) / 2;
+    if (TimestampAt(mid) < timestamp) {
+      begin = mid + 1;
+    } else {
+      end = mid;
+    }
+  }
+  return begin;
+}
+
+template <class T>
+uint64_t MsgBuffer<T>::ReadBegin() const {
+  uint64_t sequence = sequence_.load(std::memory_order_acquire);
+  while (sequence & 1) {
+    std::this_thread::yield();
+    sequence = sequence_.load(std::memory_order_acquire);
+  }
+  return sequence;
+}
+
+template <class T>
+bool MsgBuffer<T>::ReadRetry(uint64_t sequence) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return sequence_.load(std::memory_order_relaxed) != sequence;
 }
 
 template <class T>
 int MsgBuffer<T>::LookupNearest(double timestamp, ConstPtr* msg) {
-  std::lock_guard<std::mutex> lock(buffer_mutex_);
-  if (!init_) {
+  if (!init_.load(std::memory_order_acquire)) {
     AERROR << "msg buffer is uninitialized.";
     return false;
   }
-  if (buffer_queue_.empty()) {
+  uint64_t end = 0;
+  double oldest = 0.0;
+  double latest = 0.0;
+  ConstPtr nearest;
+  uint64_t sequence = 0;
+  do {
+    sequence = ReadBegin();
+    nearest.reset();
+    end = size_.load(std::memory_order_relaxed);
+    if (end == 0) {
+      continue;
+    }
+    const uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+    oldest = TimestampAt(begin);
+    latest = TimestampAt(end - 1);
+    if (oldest - FLAGS_obs_buffer_match_precision > timestamp ||
+        latest + FLAGS_obs_buffer_match_precision < timestamp) {
+      continue;
+    }
+    // the last message not after timestamp, unless the next one is as near,
+    // then the last of the messages at that next timestamp
+    const uint64_t upper = UpperBound(begin, end, timestamp);
+    uint64_t idx = upper - 1;
+    if (upper == begin ||
+        (upper < end && TimestampAt(upper) - timestamp <=
+                            timestamp - TimestampAt(upper - 1))) {
+      idx = UpperBound(upper, end, TimestampAt(upper)) - 1;
+    }
+    nearest =
+        std::atomic_load_explicit(&msgs_[Slot(idx)], std::memory_order_relaxed);
+  } while (ReadRetry(sequence));
+
+  if (end == 0) {
     AERROR << "msg buffer is empty.";
     return false;
   }
-  if (buffer_queue_.front().first - FLAGS_obs_buffer_match_precision >
-      timestamp) {
+  if (oldest - FLAGS_obs_buffer_match_precision > timestamp) {
     AERROR << "Your timestamp (" << timestamp
-           << ") is earlier than the oldest timestamp ("
-           << buffer_queue_.front().first << ").";
+           << ") is earlier than the oldest timestamp (" << oldest << ").";
     return false;
   }
-  if (buffer_queue_.back().first + FLAGS_obs_buffer_match_precision <
-      timestamp) {
+  if (nearest == nullptr) {
     AERROR << "Your timestamp (" << timestamp
-           << ") is newer than the latest timestamp ("
-           << buffer_queue_.back().first << ").";
+           << ") is newer than the latest timestamp (" << latest << ").";
     return false;
   }
-
-  // loop to find nearest
-  double distance = std::numeric_limits<double>::max();
-  int idx = static_cast<int>(buffer_queue_.size()) - 1;
-  for (; idx >= 0; --idx) {
-    double temp_distance = fabs(timestamp - buffer_queue_[idx].first);
-    if (temp_distance >= distance) {
-      break;
-    }
-    distance = temp_distance;
-  }
-  *msg = buffer_queue_[idx + 1].second;
+  *msg = nearest;
 
   return true;
 }
 
 template <class T>
 int MsgBuffer<T>::LookupLatest(ConstPtr* msg) {
-  std::lock_guard<std::mutex> lock(buffer_mutex_);
-  if (!init_) {
+  if (!init_.load(std::memory_order_acquire)) {
     AERROR << "Message buffer is uninitialized.";
     return false;
   }
-  if (buffer_queue_.empty()) {
-    AERROR << "Message buffer is empty.";
-    return false;
-  }
-  *msg = buffer_queue_.back().second;
+  ConstPtr latest;
+  uint64_t sequence = 0;
+  do {
+    sequence = ReadBegin();
+    const uint64_t end = size_.load(std::memory_order_relaxed);
+    if (end == 0) {
+      AERROR << "Message buffer is empty.";
+      return false;
+    }
+    latest = std::atomic_load_explicit(&msgs_[Slot(end - 1)],
+                                       std::memory_order_relaxed);
+  } while (ReadRetry(sequence));
+  *msg = latest;
   return true;
 }
 
 template <class T>
 int MsgBuffer<T>::LookupPeriod(const double timestamp, const double period,
                                std::vector<ObjectPair>* msgs) {
-  std::lock_guard<std::mutex> lock(buffer_mutex_);
-  if (!init_) {
+  if (!init_.load(std::memory_order_acquire)) {
     AERROR << "Message buffer is uninitialized.";
     return false;
   }
-  if (buffer_queue_.empty()) {
-    AERROR << "Message buffer is empty.";
-    return false;
-  }
-  if (buffer_queue_.front().first - FLAGS_obs_buffer_match_precision >
-      timestamp) {
-    AERROR << "Your timestamp (" << timestamp << ") is earlier than the oldest "
-           << "timestamp (" << buffer_queue_.front().first << ").";
-    return false;
-  }
-  if (buffer_queue_.back().first + FLAGS_obs_buffer_match_precision <
-      timestamp) {
-    AERROR << "Your timestamp (" << timestamp << ") is newer than the latest "
-           << "timestamp (" << buffer_queue_.back().first << ").";
-    return false;
-  }
-
   const double lower_timestamp = timestamp - period;
   const double upper_timestamp = timestamp + period;
-  for (const auto& obj_pair : buffer_queue_) {
-    if (obj_pair.first < lower_timestamp) {
+  double oldest = 0.0;
+  double latest = 0.0;
+  bool in_range = false;
+  std::vector<ObjectPair> period_msgs;
+  uint64_t sequence = 0;
+  do {
+    sequence = ReadBegin();
+    period_msgs.clear();
+    const uint64_t end = size_.load(std::memory_order_relaxed);
+    if (end == 0) {
+      AERROR << "Message buffer is empty.";
+      return false;
+    }
+    const uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+    oldest = TimestampAt(begin);
+    latest = TimestampAt(end - 1);
+    in_range = oldest - FLAGS_obs_buffer_match_precision <= timestamp &&
+               latest + FLAGS_obs_buffer_match_precision >= timestamp;
+    if (!in_range) {
       continue;
     }
-    if (obj_pair.first > upper_timestamp) {
-      break;
+    const uint64_t last = UpperBound(begin, end, upper_timestamp);
+    for (uint64_t idx = LowerBound(begin, last, lower_timestamp); idx < last;
+         ++idx) {
+      period_msgs.emplace_back(
+          TimestampAt(idx), std::atomic_load_explicit(
+                                &msgs_[Slot(idx)], std::memory_order_relaxed));
     }
-    msgs->push_back(obj_pair);
+  } while (ReadRetry(sequence));
+
+  if (oldest - FLAGS_obs_buffer_match_precision > timestamp) {
+    AERROR << "Your timestamp (" << timestamp << ") is earlier than the oldest "
+           << "timestamp (" << oldest << ").";
+    return false;
+  }
+  if (!in_range) {
+    AERROR << "Your timestamp (" << timestamp << ") is newer than the latest "
+           << "timestamp (" << latest << ").";
+    return false;
   }
+  msgs->insert(msgs->end(), period_msgs.begin(), period_msgs.end());
 
   return true;
 }
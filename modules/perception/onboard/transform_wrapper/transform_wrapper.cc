@@ -247,6 +247,15 @@ bool TransformWrapper::QueryTrans(double timestamp, StampedTransform* trans,
                                   const std::string& frame_id,
                                   const std::string& child_frame_id) {
   cyber::Time query_time(timestamp);
+  apollo::transform::TransformStamped stamped_transform;
+  // static chains and transforms already in the buffer need no polling
+  if (tf2_buffer_->LookupTransform(tf2_buffer_->GetFrameHandle(frame_id),
+                                   tf2_buffer_->GetFrameHandle(child_frame_id),
+                                   query_time, &stamped_transform)) {
+    SetStampedTransform(stamped_transform, trans);
+    return true;
+  }
+
   std::string err_string;
   if (!tf2_buffer_->canTransform(frame_id, child_frame_id, query_time,
                                  static_cast<float>(FLAGS_obs_tf2_buff_size),
@@ -257,20 +266,10 @@ bool TransformWrapper::QueryTrans(double timestamp, StampedTransform* trans,
     return false;
   }
 
-  apollo::transform::TransformStamped stamped_transform;
   try {
     stamped_transform =
         tf2_buffer_->lookupTransform(frame_id, child_frame_id, query_time);
-
-    trans->translation =
-        Eigen::Translation3d(stamped_transform.transform().translation().x(),
-                             stamped_transform.transform().translation().y(),
-                             stamped_transform.transform().translation().z());
-    trans->rotation =
-        Eigen::Quaterniond(stamped_transform.transform().rotation().qw(),
-                           stamped_transform.transform().rotation().qx(),
-                           stamped_transform.transform().rotation().qy(),
-                           stamped_transform.transform().rotation().qz());
+    SetStampedTransform(stamped_transform, trans);
   } catch (tf2::TransformException& ex) {
     AERROR << ex.what();
     return false;
@@ -278,6 +277,20 @@ bool TransformWrapper::QueryTrans(double timestamp, StampedTransform* trans,
   return true;
 }
 
+void TransformWrapper::SetStampedTransform(
+    const apollo::transform::TransformStamped& stamped_transform,
+    StampedTransform* trans) {
+  trans->translation =
+      Eigen::Translation3d(stamped_transform.transform().translation().x(),
+                           stamped_transform.transform().translation().y(),
+                           stamped_transform.transform().translation().z());
+  trans->rotation =
+      Eigen::Quaterniond(stamped_transform.transform().rotation().qw(),
+                         stamped_transform.transform().rotation().qx(),
+                         stamped_transform.transform().rotation().qy(),
+                         stamped_transform.transform().rotation().qz());
+}
+
 bool TransformWrapper::GetExtrinsicsBySensorId(
     const std::string& from_sensor_id, const std::string& to_sensor_id,
     Eigen::Affine3d* trans) {
@@ -89,6 +89,10 @@ class TransformWrapper {
                   const std::string& frame_id,
                   const std::string& child_frame_id);
 
+  void SetStampedTransform(
+      const apollo::transform::TransformStamped& stamped_transform,
+      StampedTransform* trans);
+
  private:
   bool inited_ = false;
 
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #include "modules/perception/radar/lib/tracker/filter/adaptive_kalman_filter.h"
 #include "cyber/common/log.h"
+#include "modules/common/math/kalman_filter_models.h"
 
 namespace apollo {
 namespace perception {
@@ -60,9 +61,7 @@ Eigen::VectorXd AdaptiveKalmanFilter::Predict(const double time_diff) {
 Eigen::VectorXd AdaptiveKalmanFilter::UpdateWithObject(
     const base::Object& new_object, double time_diff) {
   // predict and then correct
-  a_matrix_.setIdentity();
-  a_matrix_(0, 2) = time_diff;
-  a_matrix_(1, 3) = time_diff;
+  common::math::ConstantVelocityTransition(time_diff, &a_matrix_);
   priori_state_ = a_matrix_ * posteriori_state_;
   p_matrix_ = ((a_matrix_ * p_matrix_) * a_matrix_.transpose()) + q_matrix_;
   belief_anchor_point_ = new_object.center;
@@ -0,0 +1,262 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if USE_GPU == 1
+#include <cuda_runtime_api.h>
+#endif
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/perception/common/io/io_util.h"
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/common/sensor_manager/sensor_manager.h"
+#include "modules/perception/lib/config_manager/config_manager.h"
+#include "modules/perception/lidar/app/lidar_obstacle_segmentation.h"
+#include "modules/perception/lidar/app/lidar_obstacle_tracking.h"
+#include "modules/perception/lidar/common/lidar_frame.h"
+#include "modules/perception/lidar/common/lidar_frame_pool.h"
+#include "modules/perception/lidar/common/lidar_timer.h"
+#include "modules/perception/lidar/common/pcl_util.h"
+
+DEFINE_string(pcd_path, "./pcd/", "pcd path");
+DEFINE_string(pose_path, "", "pose path");
+DEFINE_string(sensor_name, "velodyne64", "sensor name");
+DEFINE_bool(use_hdmap, false, "option to enable using hdmap");
+DEFINE_bool(enable_tracking, true, "option to enable tracking");
+DEFINE_int32(warmup_frames, 5, "frames excluded from the statistics");
+
+namespace apollo {
+namespace perception {
+namespace benchmark {
+
+using lidar::LidarFrame;
+using lidar::LidarFrameTiming;
+
+class StageLatency {
+ public:
+  explicit StageLatency(const std::string& name) : name_(name) {}
+
+  void Add(double time) { samples_.push_back(time); }
+
+  void Report(std::ostream* out) {
+    if (samples_.empty()) {
+      return;
+    }
+    std::sort(samples_.begin(), samples_.end());
+    double sum = 0.0;
+    for (double sample : samples_) {
+      sum += sample;
+    }
+    *out << std::setw(16) << name_ << std::fixed << std::setprecision(3)
+         << std::setw(10) << sum / static_cast<double>(samples_.size())
+         << std::setw(10) << Percentile(0.5) << std::setw(10)
+         << Percentile(0.95) << std::setw(10) << samples_.back() << std::endl;
+  }
+
+ private:
+  double Percentile(double ratio) const {
+    size_t id = static_cast<size_t>(ratio * (samples_.size() - 1) + 0.5);
+    return samples_[id];
+  }
+
+  std::string name_;
+  std::vector<double> samples_;
+};
+
+class LidarLatencyBenchmark {
+ public:
+  bool Init() {
+    FLAGS_config_manager_path = "./conf";
+    if (!lib::ConfigManager::Instance()->Init()) {
+      AERROR << "Failed to init ConfigManager.";
+      return false;
+    }
+    lidar::LidarObstacleSegmentationInitOptions segment_init_options;
+    segment_init_options.enable_hdmap_input = FLAGS_use_hdmap;
+    segment_init_options.sensor_name = FLAGS_sensor_name;
+    if (!segmentation_.Init(segment_init_options)) {
+      AERROR << "Failed to init LidarObstacleSegmentation.";
+      return false;
+    }
+    lidar::LidarObstacleTrackingInitOptions tracking_init_options;
+    tracking_init_options.sensor_name = FLAGS_sensor_name;
+    if (FLAGS_enable_tracking && !tracking_.Init(tracking_init_options)) {
+      AERROR << "Failed to init LidarObstacleTracking.";
+      return false;
+    }
+    if (!common::SensorManager::Instance()->GetSensorInfo(FLAGS_sensor_name,
+                                                          &sensor_info_)) {
+      AERROR << "Failed to get sensor info, sensor name: " << FLAGS_sensor_name;
+      return false;
+    }
+    segment_options_.sensor_name = FLAGS_sensor_name;
+    tracking_options_.sensor_name = FLAGS_sensor_name;
+    return true;
+  }
+
+  bool Run() {
+    std::vector<std::string> pcd_file_names;
+    if (!common::GetFileList(FLAGS_pcd_path, ".pcd", &pcd_file_names)) {
+      AERROR << "pcd_path: " << FLAGS_pcd_path << " get file list error.";
+      return false;
+    }
+    std::sort(pcd_file_names.begin(), pcd_file_names.end(),
+              [](const std::string& lhs, const std::string& rhs) {
+                if (lhs.length() != rhs.length()) {
+                  return lhs.length() < rhs.length();
+                }
+                return lhs < rhs;
+              });
+    for (size_t i = 0; i < pcd_file_names.size(); ++i) {
+      const std::string file_name =
+          cyber::common::GetFileName(pcd_file_names[i]);
+      auto frame = lidar::LidarFramePool::Instance().Get();
+      frame->sensor_info = sensor_info_;
+      if (frame->cloud == nullptr) {
+        frame->cloud = base::PointFCloudPool::Instance().Get();
+      }
+      if (!lidar::LoadPCLPCD(FLAGS_pcd_path + "/" + file_name + ".pcd",
+                             frame->cloud.get())) {
+        AERROR << "Failed to load " << pcd_file_names[i];
+        return false;
+      }
+      bool has_pose = LoadPose(file_name, frame.get());
+
+      lidar::Timer timer;
+      auto result = segmentation_.Process(segment_options_, frame.get());
+      if (result.error_code != lidar::LidarErrorCode::Succeed) {
+        AERROR << result.log;
+        return false;
+      }
+      if (FLAGS_enable_tracking && has_pose) {
+        result = tracking_.Process(tracking_options_, frame.get());
+        if (result.error_code != lidar::LidarErrorCode::Succeed) {
+          AERROR << result.log;
+          return false;
+        }
+      }
+      const double total = timer.toc();
+      UpdateGpuMemory();
+      if (static_cast<int>(i) >= FLAGS_warmup_frames) {
+        AddFrame(frame->timing, total);
+      }
+    }
+    return true;
+  }
+
+  void Report(std::ostream* out) {
+    *out << "lidar latency (ms) over " << num_frames_ << " frames" << std::endl;
+    *out << std::setw(16) << "stage" << std::setw(10) << "mean"
+         << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10)
+         << "max" << std::endl;
+    for (auto& stage : stages_) {
+      stage.Report(out);
+    }
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+      *out << "peak host memory: " << usage.ru_maxrss / 1024 << " MB"
+           << std::endl;
+    }
+#if USE_GPU == 1
+    *out << "peak gpu memory: " << peak_gpu_memory_ / (1024 * 1024) << " MB"
+         << std::endl;
+#endif
+  }
+
+ private:
+  bool LoadPose(const std::string& file_name, LidarFrame* frame) {
+    if (FLAGS_pose_path.empty()) {
+      return false;
+    }
+    std::string pose_file_name = FLAGS_pose_path + "/" + file_name + ".pose";
+    if (!cyber::common::PathExists(pose_file_name)) {
+      pose_file_name = FLAGS_pose_path + "/" + file_name + ".pcd.pose";
+    }
+    int frame_id = 0;
+    double timestamp = 0.0;
+    if (!common::ReadPoseFile(pose_file_name, &frame->lidar2world_pose,
+                              &frame_id, &timestamp)) {
+      AWARN << "Failed to load pose " << pose_file_name;
+      return false;
+    }
+    frame->timestamp = timestamp;
+    return true;
+  }
+
+  void AddFrame(const LidarFrameTiming& timing, double total) {
+    const double times[] = {
+        timing.preprocess,     timing.map_manager, timing.roi_filter,
+        timing.ground_detector, timing.segmentation, timing.object_builder,
+        timing.filter_bank,    timing.tracker,     timing.type_fusion,
+        total};
+    for (size_t i = 0; i < stages_.size(); ++i) {
+      stages_[i].Add(times[i]);
+    }
+    ++num_frames_;
+  }
+
+  void UpdateGpuMemory() {
+#if USE_GPU == 1
+    size_t free_memory = 0;
+    size_t total_memory = 0;
+    if (cudaMemGetInfo(&free_memory, &total_memory) == cudaSuccess) {
+      peak_gpu_memory_ =
+          std::max(peak_gpu_memory_, total_memory - free_memory);
+    }
+#endif
+  }
+
+  lidar::LidarObstacleSegmentation segmentation_;
+  lidar::LidarObstacleTracking tracking_;
+  lidar::LidarObstacleSegmentationOptions segment_options_;
+  lidar::LidarObstacleTrackingOptions tracking_options_;
+  base::SensorInfo sensor_info_;
+  // same order as AddFrame
+  std::vector<StageLatency> stages_ = {
+      StageLatency("preprocess"),   StageLatency("map_manager"),
+      StageLatency("roi_filter"),   StageLatency("ground_detector"),
+      StageLatency("segmentation"), StageLatency("object_builder"),
+      StageLatency("filter_bank"),  StageLatency("tracker"),
+      StageLatency("type_fusion"),  StageLatency("total")};
+  size_t num_frames_ = 0;
+  size_t peak_gpu_memory_ = 0;
+};
+
+}  // namespace benchmark
+}  // namespace perception
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+
+  apollo::perception::benchmark::LidarLatencyBenchmark benchmark;
+  if (!benchmark.Init() || !benchmark.Run()) {
+    return -1;
+  }
+  benchmark.Report(&std::cout);
+  return 0;
+}
@@ -56,6 +56,7 @@ FrameHistory::FrameHistory()
 
 Frame::Frame(uint32_t sequence_num)
     : sequence_num_(sequence_num),
+      obstacles_(EnabledArena()),
       monitor_logger_buffer_(common::monitor::MonitorMessageItem::PLANNING) {}
 
 Frame::Frame(uint32_t sequence_num, const LocalView &local_view,
@@ -66,6 +67,7 @@ Frame::Frame(uint32_t sequence_num, const LocalView &local_view,
       local_view_(local_view),
       planning_start_point_(planning_start_point),
       vehicle_state_(vehicle_state),
+      obstacles_(EnabledArena()),
       reference_line_provider_(reference_line_provider),
       monitor_logger_buffer_(common::monitor::MonitorMessageItem::PLANNING) {}
 
@@ -75,6 +77,10 @@ Frame::Frame(uint32_t sequence_num, const LocalView &local_view,
     : Frame(sequence_num, local_view, planning_start_point, vehicle_state,
             nullptr) {}
 
+FrameArena *Frame::EnabledArena() {
+  return FLAGS_enable_frame_arena ? &arena_ : nullptr;
+}
+
 const common::TrajectoryPoint &Frame::PlanningStartPoint() const {
   return planning_start_point_;
 }
@@ -167,7 +173,8 @@ bool Frame::CreateReferenceLineInfo(
       is_near_destination_ = true;
     }
     reference_line_info_.emplace_back(vehicle_state_, planning_start_point_,
-                                      *ref_line_iter, *segments_iter);
+                                      *ref_line_iter, *segments_iter,
+                                      EnabledArena());
     ++ref_line_iter;
     ++segments_iter;
   }
@@ -305,6 +312,7 @@ const Obstacle *Frame::CreateStaticObstacle(
 
 const Obstacle *Frame::CreateStaticVirtualObstacle(const std::string &id,
                                                    const Box2d &box) {
+  std::lock_guard<std::mutex> lock(virtual_obstacle_mutex_);
   const auto *object = obstacles_.Find(id);
   if (object) {
     AWARN << "obstacle " << id << " already exist.";
@@ -22,6 +22,7 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -35,6 +36,7 @@
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
 #include "modules/localization/proto/pose.pb.h"
 #include "modules/planning/common/ego_info.h"
+#include "modules/planning/common/frame_arena.h"
 #include "modules/planning/common/indexed_queue.h"
 #include "modules/planning/common/local_view.h"
 #include "modules/planning/common/obstacle.h"
@@ -88,6 +90,8 @@ class Frame {
 
   uint32_t SequenceNum() const;
 
+  const FrameArena &arena() const { return arena_; }
+
   std::string DebugString() const;
 
   const PublishableTrajectory &ComputedTrajectory() const;
@@ -211,8 +215,13 @@ class Frame {
   void ReadPadMsgDrivingAction();
   void ResetPadMsgDrivingAction();
 
+ private:
+  FrameArena *EnabledArena();
+
  private:
   static DrivingAction pad_msg_driving_action_;
+  // declared first so that it outlives everything allocated from it
+  FrameArena arena_;
   uint32_t sequence_num_ = 0;
   LocalView local_view_;
   const hdmap::HDMap *hdmap_ = nullptr;
@@ -228,6 +237,9 @@ class Frame {
   const ReferenceLineInfo *drive_reference_line_info_ = nullptr;
 
   ThreadSafeIndexedObstacles obstacles_;
+  // makes the find-or-add of a virtual obstacle atomic, reference lines may
+  // be planned concurrently
+  std::mutex virtual_obstacle_mutex_;
 
   std::unordered_map<std::string, const perception::TrafficLight *>
       traffic_lights_;
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/frame_arena.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+constexpr size_t kChunkSize = 64 * 1024;
+constexpr size_t kMaxCachedChunks = 256;
+
+// keeps the chunks of retired frames so a steady state planning cycle does
+// not go to the heap for them
+class ChunkCache {
+ public:
+  static ChunkCache* Instance() {
+    static ChunkCache instance;
+    return &instance;
+  }
+
+  char* Acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!chunks_.empty()) {
+        char* chunk = chunks_.back();
+        chunks_.pop_back();
+        return chunk;
+      }
+    }
+    return new char[kChunkSize];
+  }
+
+  void Release(char* chunk) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (chunks_.size() < kMaxCachedChunks) {
+        chunks_.push_back(chunk);
+        return;
+      }
+    }
+    delete[] chunk;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<char*> chunks_;
+};
+
+size_t Padding(const char* ptr, const size_t alignment) {
+  const auto address = reinterpret_cast<uintptr_t>(ptr);
+  return (alignment - address % alignment) % alignment;
+}
+
+}  // namespace
+
+FrameArena::~FrameArena() {
+  for (char* chunk : chunks_) {
+    ChunkCache::Instance()->Release(chunk);
+  }
+  for (char* block : large_blocks_) {
+    delete[] block;
+  }
+}
+
+void* FrameArena::Allocate(const size_t bytes, const size_t alignment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_allocations_;
+  allocated_bytes_ += bytes;
+
+  if (bytes + alignment > kChunkSize / 4) {
+    char* block = new char[bytes + alignment];
+    large_blocks_.push_back(block);
+    return block + Padding(block, alignment);
+  }
+
+  if (!chunks_.empty()) {
+    const size_t offset =
+        offset_ + Padding(chunks_.back() + offset_, alignment);
+    if (offset + bytes <= kChunkSize) {
+      offset_ = offset + bytes;
+      return chunks_.back() + offset;
+    }
+  }
+  // new[] storage is aligned for any fundamental type
+  chunks_.push_back(ChunkCache::Instance()->Acquire());
+  offset_ = bytes;
+  return chunks_.back();
+}
+
+size_t FrameArena::num_allocations() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return num_allocations_;
+}
+
+size_t FrameArena::allocated_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_bytes_;
+}
+
+}  // namespace planning
+}  // namespace apollo
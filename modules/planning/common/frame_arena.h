@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class FrameArena
+ *
+ * @brief A bump allocator holding the per planning cycle allocations of a
+ * Frame. Memory is only given back when the arena is destroyed together with
+ * its Frame, its chunks then go to a process wide cache for the next frames.
+ */
+class FrameArena {
+ public:
+  FrameArena() = default;
+
+  ~FrameArena();
+
+  void* Allocate(const size_t bytes, const size_t alignment);
+
+  size_t num_allocations() const;
+
+  size_t allocated_bytes() const;
+
+ private:
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+
+  // fixed size chunks, the last one is bumped
+  std::vector<char*> chunks_;
+  size_t offset_ = 0;
+  // blocks too large for a chunk
+  std::vector<char*> large_blocks_;
+  size_t num_allocations_ = 0;
+  size_t allocated_bytes_ = 0;
+  // reference lines of a frame can be planned concurrently
+  mutable std::mutex mutex_;
+};
+
+/**
+ * @class FrameArenaAllocator
+ *
+ * @brief A std allocator on a FrameArena. A null arena falls back to the heap
+ * so containers keep working without one. Deallocation into an arena is a
+ * no-op. Copies of a container go to the heap since they may outlive the
+ * frame.
+ */
+template <typename T>
+class FrameArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_swap = std::true_type;
+
+  FrameArenaAllocator() = default;
+
+  explicit FrameArenaAllocator(FrameArena* arena) : arena_(arena) {}
+
+  template <typename U>
+  FrameArenaAllocator(const FrameArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(const size_t n) {
+    if (arena_ == nullptr) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, const size_t) {
+    if (arena_ == nullptr) {
+      ::operator delete(p);
+    }
+  }
+
+  FrameArenaAllocator select_on_container_copy_construction() const {
+    return FrameArenaAllocator();
+  }
+
+  FrameArena* arena() const { return arena_; }
+
+ private:
+  FrameArena* arena_ = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameArenaAllocator<T>& lhs,
+                const FrameArenaAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const FrameArenaAllocator<T>& lhs,
+                const FrameArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace planning
+}  // namespace apollo
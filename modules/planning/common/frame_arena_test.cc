@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/frame_arena.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(FrameArenaTest, Allocate) {
+  FrameArena arena;
+  EXPECT_EQ(0, arena.num_allocations());
+  EXPECT_EQ(0, arena.allocated_bytes());
+
+  void* first = arena.Allocate(3, 1);
+  void* second = arena.Allocate(8, 8);
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % 8);
+
+  // larger than a chunk
+  void* large = arena.Allocate(1 << 20, 16);
+  ASSERT_NE(nullptr, large);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(large) % 16);
+  EXPECT_EQ(3, arena.num_allocations());
+  EXPECT_EQ(3 + 8 + (1 << 20), arena.allocated_bytes());
+}
+
+TEST(FrameArenaTest, Allocator) {
+  FrameArena arena;
+  {
+    const FrameArenaAllocator<int> allocator(&arena);
+    std::vector<int, FrameArenaAllocator<int>> values(allocator);
+    for (int i = 0; i < 10000; ++i) {
+      values.push_back(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+      EXPECT_EQ(i, values[i]);
+    }
+    EXPECT_LT(0, arena.num_allocations());
+
+    // copies are not tied to the arena
+    const size_t num_allocations = arena.num_allocations();
+    auto copy = values;
+    EXPECT_EQ(nullptr, copy.get_allocator().arena());
+    EXPECT_EQ(num_allocations, arena.num_allocations());
+  }
+
+  using Allocator = FrameArenaAllocator<std::pair<const int, std::string>>;
+  std::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>,
+                     Allocator>
+      dict(0, std::hash<int>(), std::equal_to<int>(), Allocator(&arena));
+  dict[1] = "one";
+  dict[2] = "two";
+  EXPECT_EQ("one", dict.at(1));
+  EXPECT_EQ("two", dict.at(2));
+
+  // falls back to the heap without an arena
+  std::vector<int, FrameArenaAllocator<int>> heap_values;
+  heap_values.assign(100, 1);
+  EXPECT_EQ(100, heap_values.size());
+}
+
+}  // namespace planning
+}  // namespace apollo
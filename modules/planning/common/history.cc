@@ -20,6 +20,7 @@
 
 #include "modules/planning/common/history.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -63,17 +64,13 @@ HistoryObjectDecision::GetObjectDecision() const {
 // HistoryFrame
 
 void HistoryFrame::Init(const ADCTrajectory& adc_trajactory) {
-  adc_trajactory_.CopyFrom(adc_trajactory);
-
   seq_num_ = adc_trajactory.header().sequence_num();
+  object_decisions_map_.clear();
   const auto& object_decisions = adc_trajactory.decision().object_decision();
+  object_decisions_.resize(object_decisions.decision_size());
   for (int i = 0; i < object_decisions.decision_size(); i++) {
-    const std::string id = object_decisions.decision(i).id();
-    HistoryObjectDecision object_decision;
-    object_decision.Init(object_decisions.decision(i));
-    object_decisions_map_[id] = object_decision;
-
-    object_decisions_.push_back(object_decision);
+    object_decisions_[i].Init(object_decisions.decision(i));
+    object_decisions_map_[object_decisions.decision(i).id()] = i;
   }
 }
 
@@ -116,10 +113,11 @@ std::vector<const HistoryObjectDecision*> HistoryFrame::GetStopObjectDecisions()
 
 const HistoryObjectDecision* HistoryFrame::GetObjectDecisionsById(
     const std::string& id) const {
-  if (object_decisions_map_.find(id) == object_decisions_map_.end()) {
+  const auto iter = object_decisions_map_.find(id);
+  if (iter == object_decisions_map_.end()) {
     return nullptr;
   }
-  return &(object_decisions_map_.at(id));
+  return &(object_decisions_[iter->second]);
 }
 
 ////////////////////////////////////////////////
@@ -153,28 +151,51 @@ bool HistoryStatus::GetObjectStatus(const std::string& id,
 // History
 
 const HistoryFrame* History::GetLastFrame() const {
-  if (history_frames_.empty()) {
+  if (size_ == 0) {
     return nullptr;
   } else {
-    return &(history_frames_.back());
+    return &(history_frames_[(head_ + size_ - 1) % history_frames_.size()]);
   }
 }
-void History::Clear() { history_frames_.clear(); }
+void History::Clear() {
+  head_ = 0;
+  size_ = 0;
+}
 
 int History::Add(const ADCTrajectory& adc_trajectory_pb) {
-  if (history_frames_.size() >=
-      static_cast<size_t>(FLAGS_history_max_record_num)) {
-    history_frames_.pop_front();
+  const size_t capacity =
+      static_cast<size_t>(std::max(FLAGS_history_max_record_num, 1));
+  if (history_frames_.size() != capacity) {
+    Resize(capacity);
   }
 
-  HistoryFrame history_frame;
-  history_frame.Init(adc_trajectory_pb);
-  history_frames_.emplace_back(std::move(history_frame));
+  size_t slot = 0;
+  if (size_ < capacity) {
+    slot = (head_ + size_) % capacity;
+    ++size_;
+  } else {
+    slot = head_;
+    head_ = (head_ + 1) % capacity;
+  }
+  history_frames_[slot].Init(adc_trajectory_pb);
 
   return 0;
 }
 
-size_t History::Size() const { return history_frames_.size(); }
+size_t History::Size() const { return size_; }
+
+void History::Resize(const size_t capacity) {
+  // keep the newest frames in order from slot 0
+  const size_t kept = std::min(size_, capacity);
+  std::vector<HistoryFrame> history_frames(capacity);
+  for (size_t i = 0; i < kept; ++i) {
+    history_frames[i] = std::move(
+        history_frames_[(head_ + size_ - kept + i) % history_frames_.size()]);
+  }
+  history_frames_ = std::move(history_frames);
+  head_ = 0;
+  size_ = kept;
+}
 
 }  // namespace planning
 }  // namespace apollo
@@ -20,7 +20,6 @@
 
 #pragma once
 
-#include <list>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -63,8 +62,9 @@ class HistoryFrame {
 
  private:
   int seq_num_;
-  ADCTrajectory adc_trajactory_;
-  std::unordered_map<std::string, HistoryObjectDecision> object_decisions_map_;
+  // index into object_decisions_ of the last decision of each id, only the
+  // decisions are kept and not the whole trajectory
+  std::unordered_map<std::string, size_t> object_decisions_map_;
   std::vector<HistoryObjectDecision> object_decisions_;
 };
 
@@ -96,6 +96,8 @@ class HistoryStatus {
   std::unordered_map<std::string, ObjectStatus> object_id_to_status_;
 };
 
+// The last FLAGS_history_max_record_num frames in a ring, the slot of the
+// oldest frame and its buffers are reused by the next one.
 class History {
  public:
   History() = default;
@@ -106,7 +108,12 @@ class History {
   HistoryStatus* mutable_history_status() { return &history_status_; }
 
  private:
-  std::list<HistoryFrame> history_frames_;
+  void Resize(const size_t capacity);
+
+  std::vector<HistoryFrame> history_frames_;
+  // slot of the oldest frame
+  size_t head_ = 0;
+  size_t size_ = 0;
   HistoryStatus history_status_;
 };
 
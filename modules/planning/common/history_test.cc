@@ -195,5 +195,41 @@ TEST_F(HistoryTest, GetObjectDecisionsById) {
   EXPECT_TRUE(obj_decision[1]->has_nudge());
 }
 
+TEST_F(HistoryTest, ReuseSlots) {
+  FLAGS_history_max_record_num = 3;  // capacity
+
+  history_->Clear();
+
+  for (int seq_num = 1; seq_num <= 5; ++seq_num) {
+    ADCTrajectory adc_trajectory;
+    adc_trajectory.mutable_header()->set_sequence_num(seq_num);
+    auto* decision = adc_trajectory.mutable_decision()
+                         ->mutable_object_decision()
+                         ->add_decision();
+    decision->set_id(std::to_string(seq_num));
+    decision->add_object_decision()->mutable_stop();
+    history_->Add(adc_trajectory);
+  }
+  EXPECT_EQ(3, history_->Size());
+  EXPECT_EQ(5, history_->GetLastFrame()->seq_num());
+  EXPECT_EQ(1, history_->GetLastFrame()->GetObjectDecisions().size());
+  EXPECT_NE(nullptr, history_->GetLastFrame()->GetObjectDecisionsById("5"));
+  // the slot of seq_num 2 was reused by seq_num 5
+  EXPECT_EQ(nullptr, history_->GetLastFrame()->GetObjectDecisionsById("2"));
+
+  // the newest frames are kept when the capacity shrinks
+  FLAGS_history_max_record_num = 2;
+  ADCTrajectory adc_trajectory;
+  adc_trajectory.mutable_header()->set_sequence_num(6);
+  history_->Add(adc_trajectory);
+  EXPECT_EQ(2, history_->Size());
+  EXPECT_EQ(6, history_->GetLastFrame()->seq_num());
+  EXPECT_TRUE(history_->GetLastFrame()->GetObjectDecisions().empty());
+
+  history_->Clear();
+  EXPECT_EQ(0, history_->Size());
+  EXPECT_EQ(nullptr, history_->GetLastFrame());
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -20,13 +20,16 @@
 
 #pragma once
 
+#include <functional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/thread/shared_mutex.hpp>
 
 #include "cyber/common/log.h"
 #include "modules/common/util/map_util.h"
+#include "modules/planning/common/frame_arena.h"
 
 namespace apollo {
 namespace planning {
@@ -34,6 +37,20 @@ namespace planning {
 template <typename I, typename T>
 class IndexedList {
  public:
+  using ObjectDict =
+      std::unordered_map<I, T, std::hash<I>, std::equal_to<I>,
+                         FrameArenaAllocator<std::pair<const I, T>>>;
+
+  IndexedList() = default;
+
+  /**
+   * @brief the objects are allocated from the arena, which has to outlive
+   * the container.
+   */
+  explicit IndexedList(FrameArena* arena)
+      : object_dict_(0, std::hash<I>(), std::equal_to<I>(),
+                     FrameArenaAllocator<std::pair<const I, T>>(arena)) {}
+
   /**
    * @brief copy object into the container. If the id is already exist,
    * overwrite the object in the container.
@@ -82,11 +99,21 @@ class IndexedList {
    */
   const std::vector<const T*>& Items() const { return object_list_; }
 
+  /**
+   * @brief Find object by its position in Items(), without hashing its id.
+   * @param index the position of the object in Items()
+   * @return the raw pointer to the object.
+   */
+  T* Item(const size_t index) {
+    // the objects are owned by the container, only listed as const
+    return const_cast<T*>(object_list_[index]);
+  }
+
   /**
    * @brief List all the items in the container.
    * @return the unordered_map of ids and objects in the container.
    */
-  const std::unordered_map<I, T>& Dict() const { return object_dict_; }
+  const ObjectDict& Dict() const { return object_dict_; }
 
   /**
    * @brief Copy the container with objects.
@@ -102,12 +129,14 @@ class IndexedList {
 
  private:
   std::vector<const T*> object_list_;
-  std::unordered_map<I, T> object_dict_;
+  ObjectDict object_dict_;
 };
 
 template <typename I, typename T>
 class ThreadSafeIndexedList : public IndexedList<I, T> {
  public:
+  using IndexedList<I, T>::IndexedList;
+
   T* Add(const I id, const T& object) {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     return IndexedList<I, T>::Add(id, object);
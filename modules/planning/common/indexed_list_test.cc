@@ -63,6 +63,17 @@ TEST(IndexedList, Find) {
   ASSERT_EQ(nullptr, object.Find(2));
 }
 
+TEST(IndexedList, Item) {
+  StringIndexedList object;
+  object.Add(2, "two");
+  object.Add(1, "one");
+  auto* one = object.Item(1);
+  ASSERT_EQ(object.Find(1), one);
+  *one = "one_again";
+  EXPECT_EQ("one_again", *object.Items()[1]);
+  EXPECT_EQ("two", *object.Item(0));
+}
+
 TEST(IndexedList, Copy) {
   StringIndexedList b_object;
   b_object.Add(1, "one");
@@ -77,5 +88,22 @@ TEST(IndexedList, Copy) {
   ASSERT_EQ(nullptr, a_object.Find(4));
 }
 
+TEST(IndexedList, Arena) {
+  FrameArena arena;
+  StringIndexedList object(&arena);
+  ASSERT_NE(nullptr, object.Add(1, "one"));
+  ASSERT_NE(nullptr, object.Add(2, "two"));
+  EXPECT_LT(0, arena.num_allocations());
+  ASSERT_NE(nullptr, object.Find(1));
+  EXPECT_EQ("two", *object.Find(2));
+  EXPECT_EQ(2, object.Items().size());
+
+  StringIndexedList copy;
+  copy = object;
+  EXPECT_EQ(&arena, object.Dict().get_allocator().arena());
+  EXPECT_EQ(nullptr, copy.Dict().get_allocator().arena());
+  EXPECT_EQ("one", *copy.Find(1));
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -18,11 +18,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <string>
 
 #include "cyber/common/file.h"
-#include "cyber/record/record_reader.h"
+#include "cyber/record/parallel_record_viewer.h"
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/util/point_factory.h"
@@ -38,8 +39,8 @@ namespace planning {
 
 using apollo::canbus::Chassis;
 using apollo::cyber::Clock;
+using apollo::cyber::record::ParallelRecordViewer;
 using apollo::cyber::record::RecordMessage;
-using apollo::cyber::record::RecordReader;
 using apollo::dreamview::HMIStatus;
 using apollo::hdmap::ClearAreaInfoConstPtr;
 using apollo::hdmap::CrosswalkInfoConstPtr;
@@ -345,14 +346,22 @@ void MessageProcess::ProcessOfflineData(const std::string& record_file) {
   log_file_ << "Processing: " << record_file << std::endl;
   record_file_ = record_file;
 
-  RecordReader reader(record_file);
-  if (!reader.IsValid()) {
+  // decoding runs ahead on the viewer threads while frames are assembled
+  const auto& topic_config = planning_config_.topic_config();
+  ParallelRecordViewer viewer(
+      {record_file}, 0, std::numeric_limits<uint64_t>::max(),
+      {topic_config.chassis_topic(), topic_config.localization_topic(),
+       topic_config.hmi_status_topic(), topic_config.prediction_topic(),
+       topic_config.routing_response_topic(),
+       topic_config.story_telling_topic(),
+       topic_config.traffic_light_detection_topic()});
+  if (!viewer.IsValid()) {
     AERROR << "Fail to open " << record_file;
     return;
   }
 
   RecordMessage message;
-  while (reader.ReadMessage(&message)) {
+  while (viewer.ReadMessage(&message)) {
     if (message.channel_name ==
         planning_config_.topic_config().chassis_topic()) {
       Chassis chassis;
@@ -118,6 +118,13 @@ Obstacle::Obstacle(const std::string& id,
         common::util::DistanceXY(prev.path_point(), cur.path_point());
     trajectory_points[i].mutable_path_point()->set_s(cumulative_s);
   }
+
+  std::vector<double> relative_times;
+  relative_times.reserve(trajectory_points.size());
+  for (const auto& point : trajectory_points) {
+    relative_times.push_back(point.relative_time());
+  }
+  trajectory_time_index_.Reset(std::move(relative_times));
 }
 
 common::TrajectoryPoint Obstacle::GetPointAtTime(
@@ -138,12 +145,16 @@ common::TrajectoryPoint Obstacle::GetPointAtTime(
     point.set_relative_time(0.0);
     return point;
   } else {
-    auto comp = [](const common::TrajectoryPoint p, const double time) {
+    auto comp = [](const common::TrajectoryPoint& p, const double time) {
       return p.relative_time() < time;
     };
 
+    // points added by AddTrajectoryPoint are not in the index
     auto it_lower =
-        std::lower_bound(points.begin(), points.end(), relative_time, comp);
+        trajectory_time_index_.size() == static_cast<size_t>(points.size())
+            ? points.begin() + trajectory_time_index_.LowerBound(relative_time)
+            : std::lower_bound(points.begin(), points.end(), relative_time,
+                               comp);
 
     if (it_lower == points.begin()) {
       return *points.begin();
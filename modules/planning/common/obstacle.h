@@ -28,6 +28,7 @@
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/common/math/box2d.h"
+#include "modules/common/math/sorted_key_index.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/planning/common/indexed_list.h"
@@ -244,6 +245,8 @@ class Obstacle {
   bool path_st_boundary_initialized_ = false;
 
   prediction::Trajectory trajectory_;
+  // relative times of the points of trajectory_ for GetPointAtTime
+  common::math::SortedKeyIndex trajectory_time_index_;
   perception::PerceptionObstacle perception_obstacle_;
   common::math::Box2d perception_bounding_box_;
   common::math::Polygon2d perception_polygon_;
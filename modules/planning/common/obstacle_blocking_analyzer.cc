@@ -18,6 +18,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/common/configs/vehicle_config_helper.h"
@@ -35,6 +38,57 @@ using apollo::hdmap::HDMapUtil;
 constexpr double kAdcDistanceThreshold = 35.0;  // unit: m
 constexpr double kObstaclesDistanceThreshold = 15.0;
 
+namespace {
+
+// the lanes around a static obstacle only change when it moves, so the lane
+// lookup of IsParkedVehicle is kept per obstacle across cycles
+struct ParkingLaneCheck {
+  common::math::Vec2d center;
+  bool is_on_parking_lane = false;
+};
+
+constexpr double kMaxParkedObstacleShift = 0.2;  // unit: m
+constexpr size_t kMaxParkingLaneChecks = 1000;
+
+std::mutex parking_lane_checks_mutex;
+std::unordered_map<std::string, ParkingLaneCheck> parking_lane_checks;
+
+bool IsOnParkingLane(const Obstacle& obstacle) {
+  const auto& obstacle_box = obstacle.PerceptionBoundingBox();
+  if (FLAGS_enable_parked_vehicle_lane_cache) {
+    std::lock_guard<std::mutex> lock(parking_lane_checks_mutex);
+    const auto iter = parking_lane_checks.find(obstacle.Id());
+    if (iter != parking_lane_checks.end() &&
+        iter->second.center.DistanceTo(obstacle_box.center()) <
+            kMaxParkedObstacleShift) {
+      return iter->second.is_on_parking_lane;
+    }
+  }
+
+  std::vector<std::shared_ptr<const hdmap::LaneInfo>> lanes;
+  HDMapUtil::BaseMapPtr()->GetLanes(
+      common::util::PointFactory::ToPointENU(obstacle_box.center().x(),
+                                             obstacle_box.center().y()),
+      std::min(obstacle_box.width(), obstacle_box.length()), &lanes);
+  const bool is_on_parking_lane =
+      lanes.size() == 1 &&
+      lanes.front()->lane().type() == apollo::hdmap::Lane::PARKING;
+
+  if (FLAGS_enable_parked_vehicle_lane_cache) {
+    std::lock_guard<std::mutex> lock(parking_lane_checks_mutex);
+    // obstacle ids keep coming, drop the stale ones once in a while
+    if (parking_lane_checks.size() >= kMaxParkingLaneChecks) {
+      parking_lane_checks.clear();
+    }
+    auto& check = parking_lane_checks[obstacle.Id()];
+    check.center = obstacle_box.center();
+    check.is_on_parking_lane = is_on_parking_lane;
+  }
+  return is_on_parking_lane;
+}
+
+}  // namespace
+
 bool IsNonmovableObstacle(const ReferenceLineInfo& reference_line_info,
                           const Obstacle& obstacle) {
   // Obstacle is far away.
@@ -215,17 +269,7 @@ bool IsParkedVehicle(const ReferenceLine& reference_line,
   bool is_at_road_edge = std::abs(obstacle->PerceptionSLBoundary().start_l()) >
                          max_road_right_width - 0.1;
 
-  std::vector<std::shared_ptr<const hdmap::LaneInfo>> lanes;
-  auto obstacle_box = obstacle->PerceptionBoundingBox();
-  HDMapUtil::BaseMapPtr()->GetLanes(
-      common::util::PointFactory::ToPointENU(obstacle_box.center().x(),
-                                             obstacle_box.center().y()),
-      std::min(obstacle_box.width(), obstacle_box.length()), &lanes);
-  bool is_on_parking_lane = false;
-  if (lanes.size() == 1 &&
-      lanes.front()->lane().type() == apollo::hdmap::Lane::PARKING) {
-    is_on_parking_lane = true;
-  }
+  const bool is_on_parking_lane = IsOnParkingLane(*obstacle);
 
   bool is_parked = is_on_parking_lane || is_at_road_edge;
   return is_parked && obstacle->IsStatic();
@@ -39,6 +39,7 @@
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
+#include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/proto/planning_internal.pb.h"
 
 namespace apollo {
@@ -307,6 +308,10 @@ class OpenSpaceInfo {
 
   void set_time_latency(double time_latency) { time_latency_ = time_latency; }
 
+  LatencyStats *mutable_latency_stats() { return &latency_stats_; }
+
+  const LatencyStats &latency_stats() const { return latency_stats_; }
+
  private:
   std::string target_parking_spot_id_;
 
@@ -385,6 +390,9 @@ class OpenSpaceInfo {
   apollo::planning_internal::Debug debug_instance_;
 
   double time_latency_ = 0.0;
+
+  // per phase time of the open space trajectory generation
+  LatencyStats latency_stats_;
 };
 
 }  // namespace planning
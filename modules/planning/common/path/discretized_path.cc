@@ -21,6 +21,7 @@
 #include "modules/planning/common/path/discretized_path.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/linear_interpolation.h"
@@ -33,6 +34,33 @@ using apollo::common::PathPoint;
 DiscretizedPath::DiscretizedPath(std::vector<PathPoint> path_points)
     : std::vector<PathPoint>(std::move(path_points)) {}
 
+DiscretizedPath::DiscretizedPath(const DiscretizedPath &other)
+    : std::vector<PathPoint>(other) {}
+
+DiscretizedPath::DiscretizedPath(DiscretizedPath &&other)
+    : std::vector<PathPoint>(std::move(other)) {}
+
+DiscretizedPath &DiscretizedPath::operator=(const DiscretizedPath &other) {
+  std::vector<PathPoint>::operator=(other);
+  s_index_.Clear();
+  return *this;
+}
+
+DiscretizedPath &DiscretizedPath::operator=(DiscretizedPath &&other) {
+  std::vector<PathPoint>::operator=(std::move(other));
+  s_index_.Clear();
+  return *this;
+}
+
+void DiscretizedPath::BuildSIndex() {
+  std::vector<double> s;
+  s.reserve(size());
+  for (const auto &point : *this) {
+    s.push_back(point.s());
+  }
+  s_index_.Reset(std::move(s));
+}
+
 double DiscretizedPath::Length() const {
   if (empty()) {
     return 0.0;
@@ -55,6 +83,9 @@ PathPoint DiscretizedPath::Evaluate(const double path_s) const {
 
 std::vector<PathPoint>::const_iterator DiscretizedPath::QueryLowerBound(
     const double path_s) const {
+  if (HasSIndex()) {
+    return begin() + s_index_.LowerBound(path_s);
+  }
   auto func = [](const PathPoint &tp, const double path_s) {
     return tp.s() < path_s;
   };
@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/sorted_key_index.h"
 #include "modules/common/proto/pnc_point.pb.h"
 
 namespace apollo {
@@ -34,17 +35,39 @@ class DiscretizedPath : public std::vector<common::PathPoint> {
 
   explicit DiscretizedPath(std::vector<common::PathPoint> path_points);
 
+  /**
+   * The s index is not carried over from other, the copy builds its own.
+   */
+  DiscretizedPath(const DiscretizedPath &other);
+  DiscretizedPath(DiscretizedPath &&other);
+  DiscretizedPath &operator=(const DiscretizedPath &other);
+  DiscretizedPath &operator=(DiscretizedPath &&other);
+
   double Length() const;
 
   common::PathPoint Evaluate(const double path_s) const;
 
   common::PathPoint EvaluateReverse(const double path_s) const;
 
+  /**
+   * Packs the s of the points so that Evaluate searches a contiguous array
+   * instead of the points. Only paths of increasing s are indexed, which
+   * leaves EvaluateReverse as is. Points changed through the std::vector
+   * interface are not seen, build the index again.
+   */
+  void BuildSIndex();
+
  protected:
   std::vector<common::PathPoint>::const_iterator QueryLowerBound(
       const double path_s) const;
   std::vector<common::PathPoint>::const_iterator QueryUpperBound(
       const double path_s) const;
+
+  bool HasSIndex() const {
+    return !s_index_.empty() && s_index_.size() == size();
+  }
+
+  common::math::SortedKeyIndex s_index_;
 };
 
 }  // namespace planning
@@ -108,5 +108,31 @@ TEST(DiscretizedPathTest, reverse_case) {
   EXPECT_EQ(discretized_path.size(), 0);
 }
 
+TEST(DiscretizedPathTest, s_index) {
+  std::vector<PathPoint> path_points;
+  for (int i = 0; i < 50; ++i) {
+    const double s = 0.5 * i + 0.01 * (i % 3);
+    path_points.push_back(PointFactory::ToPathPoint(s, 2.0 * s, 0.0, s));
+  }
+  const DiscretizedPath plain_path(path_points);
+  DiscretizedPath indexed_path(path_points);
+  indexed_path.BuildSIndex();
+
+  for (double s = -1.0; s < 26.0; s += 0.07) {
+    const auto expected = plain_path.Evaluate(s);
+    const auto point = indexed_path.Evaluate(s);
+    EXPECT_DOUBLE_EQ(expected.s(), point.s());
+    EXPECT_DOUBLE_EQ(expected.x(), point.x());
+    EXPECT_DOUBLE_EQ(expected.y(), point.y());
+  }
+
+  // the copy does not see the index, so changing its points is safe
+  DiscretizedPath copied_path(indexed_path);
+  for (auto &point : copied_path) {
+    point.set_s(point.s() * 2.0);
+  }
+  EXPECT_NEAR(copied_path.Evaluate(10.0).x(), 5.0, 0.1);
+}
+
 }  // namespace planning
 }  // namespace apollo
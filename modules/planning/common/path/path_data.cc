@@ -46,11 +46,13 @@ bool PathData::SetDiscretizedPath(DiscretizedPath path) {
     return false;
   }
   discretized_path_ = std::move(path);
+  reference_speed_limits_.clear();
   if (!XYToSL(discretized_path_, &frenet_path_)) {
     AERROR << "Fail to transfer discretized path to frenet path.";
     return false;
   }
   DCHECK_EQ(discretized_path_.size(), frenet_path_.size());
+  discretized_path_.BuildSIndex();
   return true;
 }
 
@@ -61,11 +63,13 @@ bool PathData::SetFrenetPath(FrenetFramePath frenet_path) {
     return false;
   }
   frenet_path_ = std::move(frenet_path);
+  reference_speed_limits_.clear();
   if (!SLToXY(frenet_path_, &discretized_path_)) {
     AERROR << "Fail to transfer frenet path to discretized path.";
     return false;
   }
   DCHECK_EQ(discretized_path_.size(), frenet_path_.size());
+  discretized_path_.BuildSIndex();
   return true;
 }
 
@@ -112,6 +116,25 @@ common::PathPoint PathData::GetPathPointWithPathS(const double s) const {
   return discretized_path_.Evaluate(s);
 }
 
+const std::vector<double> &PathData::ReferenceSpeedLimits(
+    const ReferenceLine &reference_line) const {
+  if (speed_limit_reference_line_ != &reference_line) {
+    reference_speed_limits_.clear();
+    speed_limit_reference_line_ = &reference_line;
+  }
+  if (reference_speed_limits_.empty()) {
+    reference_speed_limits_.reserve(frenet_path_.size());
+    for (const auto &frenet_point : frenet_path_) {
+      if (frenet_point.s() > reference_line.Length()) {
+        break;
+      }
+      reference_speed_limits_.push_back(
+          reference_line.GetSpeedLimitFromS(frenet_point.s()));
+    }
+  }
+  return reference_speed_limits_;
+}
+
 bool PathData::GetPathPointWithRefS(const double ref_s,
                                     common::PathPoint *const path_point) const {
   ACHECK(reference_line_);
@@ -154,6 +177,7 @@ void PathData::Clear() {
   frenet_path_.clear();
   path_point_decision_guide_.clear();
   path_reference_.clear();
+  reference_speed_limits_.clear();
   reference_line_ = nullptr;
 }
 
@@ -214,8 +238,12 @@ bool PathData::XYToSL(const DiscretizedPath &discretized_path,
   std::vector<common::FrenetFramePoint> frenet_frame_points;
   const double max_len = reference_line_->Length();
   for (const auto &path_point : discretized_path) {
+    // consecutive path points project close to each other
     common::FrenetFramePoint frenet_point =
-        reference_line_->GetFrenetPoint(path_point);
+        (FLAGS_enable_sl_projection_warm_start && !frenet_frame_points.empty())
+            ? reference_line_->GetFrenetPoint(path_point,
+                                              frenet_frame_points.back().s())
+            : reference_line_->GetFrenetPoint(path_point);
     if (!frenet_point.has_s()) {
       SLPoint sl_point;
       if (!reference_line_->XYToSL(path_point, &sl_point)) {
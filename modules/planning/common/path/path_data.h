@@ -64,6 +64,14 @@ class PathData {
 
   common::PathPoint GetPathPointWithPathS(const double s) const;
 
+  /*
+   * brief: the speed limits of reference_line at the frenet points of the
+   * path, queried once per path for all the speed planning tasks. They stop
+   * at the first point beyond the end of the reference line.
+   */
+  const std::vector<double> &ReferenceSpeedLimits(
+      const ReferenceLine &reference_line) const;
+
   /*
    * brief: this function will find the path_point in discretized_path whose
    * projection to reference line has s value closest to ref_s.
@@ -152,6 +160,10 @@ class PathData {
 
   // path reference
   std::vector<common::PathPoint> path_reference_;
+
+  // cache of ReferenceSpeedLimits, cleared whenever the path changes
+  mutable std::vector<double> reference_speed_limits_;
+  mutable const ReferenceLine *speed_limit_reference_line_ = nullptr;
 };
 
 }  // namespace planning
@@ -76,6 +76,27 @@ bool PathDecision::AddLateralDecision(const std::string &tag,
   return true;
 }
 
+bool PathDecision::AddLateralDecision(const std::string &tag,
+                                      const size_t index,
+                                      const ObjectDecisionType &decision) {
+  if (index >= obstacles_.Items().size()) {
+    AERROR << "failed to find obstacle";
+    return false;
+  }
+  obstacles_.Item(index)->AddLateralDecision(tag, decision);
+  return true;
+}
+
+const std::vector<size_t> &PathDecision::ObstacleIndicesOfType(
+    const perception::PerceptionObstacle::Type type) {
+  const auto &items = obstacles_.Items();
+  for (; type_indexed_num_ < items.size(); ++type_indexed_num_) {
+    const auto *obstacle = items[type_indexed_num_];
+    type_indices_[obstacle->Perception().type()].push_back(type_indexed_num_);
+  }
+  return type_indices_[type];
+}
+
 void PathDecision::EraseStBoundaries() {
   for (const auto *obstacle : obstacles_.Items()) {
     auto *obstacle_ptr = obstacles_.Find(obstacle->Id());
@@ -95,6 +116,17 @@ bool PathDecision::AddLongitudinalDecision(const std::string &tag,
   return true;
 }
 
+bool PathDecision::AddLongitudinalDecision(const std::string &tag,
+                                           const size_t index,
+                                           const ObjectDecisionType &decision) {
+  if (index >= obstacles_.Items().size()) {
+    AERROR << "failed to find obstacle";
+    return false;
+  }
+  obstacles_.Item(index)->AddLongitudinalDecision(tag, decision);
+  return true;
+}
+
 bool PathDecision::MergeWithMainStop(const ObjectStop &obj_stop,
                                      const std::string &obj_id,
                                      const ReferenceLine &reference_line,
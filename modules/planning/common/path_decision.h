@@ -22,7 +22,10 @@
 
 #include <limits>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "modules/planning/common/frame_arena.h"
 #include "modules/planning/common/indexed_list.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/proto/decision.pb.h"
@@ -39,6 +42,8 @@ class PathDecision {
  public:
   PathDecision() = default;
 
+  explicit PathDecision(FrameArena *arena) : obstacles_(arena) {}
+
   Obstacle *AddObstacle(const Obstacle &obstacle);
 
   const IndexedList<std::string, Obstacle> &obstacles() const;
@@ -48,6 +53,19 @@ class PathDecision {
   bool AddLongitudinalDecision(const std::string &tag,
                                const std::string &object_id,
                                const ObjectDecisionType &decision);
+  // The same keyed by the position of the obstacle in obstacles().Items().
+  bool AddLateralDecision(const std::string &tag, const size_t index,
+                          const ObjectDecisionType &decision);
+  bool AddLongitudinalDecision(const std::string &tag, const size_t index,
+                               const ObjectDecisionType &decision);
+
+  /**
+   * @brief The positions in obstacles().Items() of the obstacles of a
+   * perception type. The index is built once for all the traffic rules and
+   * extended with the obstacles added since.
+   */
+  const std::vector<size_t> &ObstacleIndicesOfType(
+      const perception::PerceptionObstacle::Type type);
 
   const Obstacle *Find(const std::string &object_id) const;
 
@@ -66,6 +84,8 @@ class PathDecision {
 
  private:
   IndexedList<std::string, Obstacle> obstacles_;
+  std::unordered_map<int, std::vector<size_t>> type_indices_;
+  size_t type_indexed_num_ = 0;
   MainStop main_stop_;
   double stop_reference_line_s_ = std::numeric_limits<double>::max();
 };
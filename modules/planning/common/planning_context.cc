@@ -19,6 +19,21 @@
 namespace apollo {
 namespace planning {
 
+thread_local const PlanningContext* PlanningContext::local_owner_ = nullptr;
+thread_local PlanningStatus* PlanningContext::local_status_ = nullptr;
+
+PlanningContext::LocalStatusGuard::LocalStatusGuard(
+    const PlanningContext* context, PlanningStatus* status)
+    : prev_owner_(local_owner_), prev_status_(local_status_) {
+  local_owner_ = context;
+  local_status_ = status;
+}
+
+PlanningContext::LocalStatusGuard::~LocalStatusGuard() {
+  local_owner_ = prev_owner_;
+  local_status_ = prev_status_;
+}
+
 void PlanningContext::Init() {}
 
 void PlanningContext::Clear() { planning_status_.Clear(); }
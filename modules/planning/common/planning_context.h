@@ -41,11 +41,35 @@ class PlanningContext {
    * please put all status info inside PlanningStatus for easy maintenance.
    * do NOT create new struct at this level.
    * */
-  const PlanningStatus& planning_status() const { return planning_status_; }
-  PlanningStatus* mutable_planning_status() { return &planning_status_; }
+  const PlanningStatus& planning_status() const {
+    return local_owner_ == this ? *local_status_ : planning_status_;
+  }
+  PlanningStatus* mutable_planning_status() {
+    return local_owner_ == this ? local_status_ : &planning_status_;
+  }
+
+  /**
+   * @brief Redirects planning_status() of the context to status on the
+   * calling thread while the guard is alive, so that reference lines planned
+   * concurrently do not write the same PlanningStatus.
+   */
+  class LocalStatusGuard {
+   public:
+    LocalStatusGuard(const PlanningContext* context, PlanningStatus* status);
+    ~LocalStatusGuard();
+
+   private:
+    const PlanningContext* prev_owner_;
+    PlanningStatus* prev_status_;
+
+    DISALLOW_COPY_AND_ASSIGN(LocalStatusGuard);
+  };
 
  private:
   PlanningStatus planning_status_;
+
+  static thread_local const PlanningContext* local_owner_;
+  static thread_local PlanningStatus* local_status_;
 };
 
 }  // namespace planning
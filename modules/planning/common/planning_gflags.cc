@@ -148,6 +148,9 @@ DEFINE_double(look_forward_extend_distance, 50,
 DEFINE_double(reference_line_stitch_overlap_distance, 20,
               "The overlap distance with the existing reference line when "
               "stitching the existing reference line");
+DEFINE_bool(enable_smoothed_segment_cache, false,
+            "Reuse the smoothed reference lines of recent route segments and "
+            "only smooth the part of a route segment beyond them.");
 
 DEFINE_bool(enable_smooth_reference_line, true,
             "enable smooth the map reference line");
@@ -320,6 +323,50 @@ DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_dp_poly_path, false,
+            "Enable multiple thread to calculation curve cost in "
+            "dp_road_graph.");
+DEFINE_bool(enable_dp_road_graph_cost_cache, false,
+            "Share the curve samples of the path and static obstacle costs "
+            "of dp_road_graph and cache the static obstacle cost per cell.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "Plan the reference lines of lane follow stage concurrently.");
+DEFINE_bool(enable_parallel_hybrid_a_star_expansion, false,
+            "Run the analytic expansion and the next node generation of "
+            "hybrid a star concurrently.");
+DEFINE_bool(enable_parallel_distance_approach_jacobian, false,
+            "Fill the obstacle rows of the distance approach constraint "
+            "jacobian in parallel.");
+
+DEFINE_bool(enable_frame_arena, false,
+            "Allocate the obstacles of a frame and its reference lines from "
+            "an arena released together with the frame.");
+DEFINE_bool(enable_planning_profiler, false,
+            "Record the nested timing of each planning cycle into the "
+            "latency stats of the trajectory.");
+DEFINE_string(planning_profiler_trace_file, "",
+              "If not empty, append the timing of each planning cycle to this "
+              "file in Chrome trace format.");
+DEFINE_bool(enable_sl_projection_warm_start, false,
+            "Project the points of polylines and boxes onto the reference "
+            "line by a local search from the previous point.");
+DEFINE_bool(enable_parallel_scenario_selection, false,
+            "Evaluate the transitions to the park and go, intersection, pull "
+            "over and valet parking scenarios concurrently.");
+DEFINE_bool(enable_incremental_path_reuse_check, false,
+            "Skip the collision check of a reused path while the static "
+            "obstacles stay where they were when it was last checked.");
+DEFINE_bool(enable_parked_vehicle_lane_cache, false,
+            "Keep the lane lookup of parked vehicle checks per obstacle until "
+            "the obstacle moves.");
+DEFINE_bool(enable_solver_pool, false,
+            "Keep the OSQP workspaces of solved problems and update them in "
+            "place for later problems of the same dimension and sparsity.");
+DEFINE_int32(solver_pool_capacity, 16,
+             "Max number of idle OSQP workspaces kept by the solver pool.");
+DEFINE_bool(enable_fem_pos_warm_start, false,
+            "Start the fem pos deviation smoother from its previous result "
+            "on a nearby reference line instead of the raw anchor points.");
 
 /// Lattice Planner
 DEFINE_double(numerical_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -379,6 +426,9 @@ DEFINE_double(polynomial_minimal_param, 0.01,
               "Minimal time parameter in polynomials.");
 DEFINE_double(lattice_stop_buffer, 0.02,
               "The buffer before the stop s to check trajectories.");
+DEFINE_bool(enable_lazy_lattice_trajectory_evaluation, false,
+            "Rank lattice trajectory pairs by lower bound costs, evaluate the "
+            "full cost when a pair reaches the top.");
 
 DEFINE_bool(lateral_optimization, true,
             "whether using optimization for lateral trajectory generation");
@@ -443,6 +493,11 @@ DEFINE_bool(enable_perception_obstacles, true,
 DEFINE_bool(enable_open_space_planner_thread, true,
             "Enable thread in open space planner for trajectory publish.");
 
+DEFINE_bool(enable_open_space_anytime_planning, false,
+            "Publish the hybrid a star trajectory while the open space "
+            "smoother is still running, only used with "
+            "enable_open_space_planner_thread.");
+
 DEFINE_bool(use_dual_variable_warm_start, true,
             "whether or not enable dual variable warm start ");
 
@@ -471,6 +526,9 @@ DEFINE_bool(
 
 DEFINE_bool(enable_osqp_debug, false,
             "True to turn on OSQP verbose debug output in log.");
+DEFINE_bool(enable_piecewise_jerk_warm_start, false,
+            "True to keep the OSQP workspace of piecewise jerk path and speed "
+            "optimizers across cycles and warm start from the last solution.");
 
 DEFINE_bool(export_chart, false, "export chart in planning");
 DEFINE_bool(enable_record_debug, true,
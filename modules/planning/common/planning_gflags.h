@@ -61,6 +61,7 @@ DECLARE_double(rtk_trajectory_resolution);
 DECLARE_bool(enable_reference_line_stitching);
 DECLARE_double(look_forward_extend_distance);
 DECLARE_double(reference_line_stitch_overlap_distance);
+DECLARE_bool(enable_smoothed_segment_cache);
 
 DECLARE_bool(enable_smooth_reference_line);
 
@@ -154,6 +155,21 @@ DECLARE_bool(enable_sqp_solver);
 /// thread pool
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_dp_poly_path);
+DECLARE_bool(enable_dp_road_graph_cost_cache);
+DECLARE_bool(enable_parallel_reference_line_planning);
+DECLARE_bool(enable_parallel_hybrid_a_star_expansion);
+DECLARE_bool(enable_parallel_distance_approach_jacobian);
+DECLARE_bool(enable_frame_arena);
+DECLARE_bool(enable_planning_profiler);
+DECLARE_string(planning_profiler_trace_file);
+DECLARE_bool(enable_sl_projection_warm_start);
+DECLARE_bool(enable_parallel_scenario_selection);
+DECLARE_bool(enable_incremental_path_reuse_check);
+DECLARE_bool(enable_parked_vehicle_lane_cache);
+DECLARE_bool(enable_solver_pool);
+DECLARE_int32(solver_pool_capacity);
+DECLARE_bool(enable_fem_pos_warm_start);
 
 DECLARE_double(numerical_epsilon);
 DECLARE_double(default_cruise_speed);
@@ -200,6 +216,7 @@ DECLARE_double(time_min_density);
 DECLARE_double(comfort_acceleration_factor);
 DECLARE_double(polynomial_minimal_param);
 DECLARE_double(lattice_stop_buffer);
+DECLARE_bool(enable_lazy_lattice_trajectory_evaluation);
 DECLARE_double(max_s_lateral_optimization);
 DECLARE_double(default_delta_s_lateral_optimization);
 DECLARE_double(bound_buffer);
@@ -221,6 +238,7 @@ DECLARE_double(open_space_planning_period);
 DECLARE_double(open_space_prediction_time_horizon);
 DECLARE_bool(enable_perception_obstacles);
 DECLARE_bool(enable_open_space_planner_thread);
+DECLARE_bool(enable_open_space_anytime_planning);
 DECLARE_bool(use_dual_variable_warm_start);
 DECLARE_bool(use_gear_shift_trajectory);
 DECLARE_uint64(open_space_trajectory_stitching_preserved_length);
@@ -230,6 +248,7 @@ DECLARE_bool(use_iterative_anchoring_smoother);
 DECLARE_bool(enable_parallel_trajectory_smoothing);
 
 DECLARE_bool(enable_osqp_debug);
+DECLARE_bool(enable_piecewise_jerk_warm_start);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
 
@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_profiler.h"
+
+#include <chrono>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+
+#include "cyber/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// path and depth of the spans alive on the current thread
+thread_local std::string current_path;
+thread_local uint32_t current_depth = 0;
+
+uint32_t ThreadIndex() {
+  static std::atomic<uint32_t> next_thread_index{0};
+  thread_local const uint32_t thread_index = next_thread_index++;
+  return thread_index;
+}
+
+std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+}  // namespace
+
+PlanningProfiler::PlanningProfiler() {}
+
+int64_t PlanningProfiler::NowUs() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void PlanningProfiler::BeginCycle(const uint32_t sequence_num) {
+  if (!FLAGS_enable_planning_profiler) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_.clear();
+  sequence_num_ = sequence_num;
+  cycle_start_us_ = NowUs();
+  recording_ = true;
+}
+
+void PlanningProfiler::EndCycle(LatencyStats* const latency_stats) {
+  if (!recording_.exchange(false)) {
+    return;
+  }
+  const auto cycle_spans = spans();
+  if (latency_stats != nullptr) {
+    for (const auto& span : cycle_spans) {
+      auto* task_stats = latency_stats->add_task_stats();
+      task_stats->set_name(span.path);
+      task_stats->set_time_ms(static_cast<double>(span.duration_us) / 1000.0);
+    }
+  }
+
+  if (FLAGS_planning_profiler_trace_file.empty() || cycle_spans.empty()) {
+    return;
+  }
+  if (!trace_file_.is_open()) {
+    trace_file_.open(FLAGS_planning_profiler_trace_file,
+                     std::ios::out | std::ios::trunc);
+    if (!trace_file_.is_open()) {
+      AERROR << "Failed to open planning trace file "
+             << FLAGS_planning_profiler_trace_file;
+      return;
+    }
+    trace_file_ << "[\n";
+  }
+  trace_file_ << ToChromeTraceEvents() << ",\n";
+  trace_file_.flush();
+}
+
+std::vector<PlanningProfiler::Span> PlanningProfiler::spans() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return spans_;
+}
+
+std::string PlanningProfiler::ToChromeTraceEvents() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string events;
+  for (const auto& span : spans_) {
+    if (!events.empty()) {
+      events.append(",\n");
+    }
+    const auto name_begin = span.path.find_last_of('/');
+    const std::string name = name_begin == std::string::npos
+                                 ? span.path
+                                 : span.path.substr(name_begin + 1);
+    absl::StrAppend(&events, "{\"name\":\"", EscapeJson(name),
+                    "\",\"cat\":\"planning\",\"ph\":\"X\",\"ts\":",
+                    cycle_start_us_ + span.start_us,
+                    ",\"dur\":", span.duration_us,
+                    ",\"pid\":0,\"tid\":", span.thread_index,
+                    ",\"args\":{\"sequence_num\":", sequence_num_,
+                    ",\"path\":\"", EscapeJson(span.path), "\"}}");
+  }
+  return events;
+}
+
+void PlanningProfiler::AddSpan(Span&& span) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!recording_) {
+    return;
+  }
+  span.start_us -= cycle_start_us_;
+  spans_.push_back(std::move(span));
+}
+
+ScopedPlanningProfile::ScopedPlanningProfile(const std::string& name) {
+  if (!FLAGS_enable_planning_profiler) {
+    return;
+  }
+  auto* profiler = PlanningProfiler::Instance();
+  if (!profiler->IsRecording()) {
+    return;
+  }
+  active_ = true;
+  parent_path_size_ = current_path.size();
+  if (!current_path.empty()) {
+    current_path.push_back('/');
+  }
+  current_path.append(name);
+  ++current_depth;
+  start_us_ = profiler->NowUs();
+}
+
+ScopedPlanningProfile::~ScopedPlanningProfile() {
+  if (!active_) {
+    return;
+  }
+  auto* profiler = PlanningProfiler::Instance();
+  PlanningProfiler::Span span;
+  span.path = current_path;
+  span.depth = --current_depth;
+  span.thread_index = ThreadIndex();
+  span.start_us = start_us_;
+  span.duration_us = profiler->NowUs() - start_us_;
+  current_path.resize(parent_path_size_);
+  profiler->AddSpan(std::move(span));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Scoped timing of the planning cycle as a nested tree of spans
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "modules/planning/proto/planning.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PlanningProfiler
+ * @brief Collects the spans of ScopedPlanningProfile between BeginCycle and
+ * EndCycle. Nothing is recorded unless FLAGS_enable_planning_profiler is set.
+ */
+class PlanningProfiler {
+ public:
+  struct Span {
+    // names of the enclosing spans on the same thread joined by '/'
+    std::string path;
+    uint32_t depth = 0;
+    uint32_t thread_index = 0;
+    // relative to the begin of the cycle
+    int64_t start_us = 0;
+    int64_t duration_us = 0;
+  };
+
+  /**
+   * @brief drops the spans of the previous cycle and starts recording
+   */
+  void BeginCycle(const uint32_t sequence_num);
+
+  /**
+   * @brief stops recording, appends the spans as task stats named by their
+   * path to latency_stats if not null, and appends them to
+   * FLAGS_planning_profiler_trace_file if set
+   */
+  void EndCycle(LatencyStats* const latency_stats);
+
+  bool IsRecording() const { return recording_.load(); }
+
+  std::vector<Span> spans() const;
+
+  /**
+   * @brief the spans of the cycle as Chrome trace "complete" events,
+   * separated by ",\n"
+   */
+  std::string ToChromeTraceEvents() const;
+
+ private:
+  friend class ScopedPlanningProfile;
+
+  int64_t NowUs() const;
+  void AddSpan(Span&& span);
+
+  std::atomic<bool> recording_{false};
+  uint32_t sequence_num_ = 0;
+  int64_t cycle_start_us_ = 0;
+
+  // the trace file has no closing ']', which the trace viewers accept
+  std::ofstream trace_file_;
+
+  mutable std::mutex mutex_;
+  std::vector<Span> spans_;
+
+  DECLARE_SINGLETON(PlanningProfiler)
+};
+
+/**
+ * @class ScopedPlanningProfile
+ * @brief Times its own lifetime as a span nested in the spans alive on the
+ * same thread.
+ */
+class ScopedPlanningProfile {
+ public:
+  explicit ScopedPlanningProfile(const std::string& name);
+  ~ScopedPlanningProfile();
+
+ private:
+  bool active_ = false;
+  size_t parent_path_size_ = 0;
+  int64_t start_us_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedPlanningProfile);
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#define PLANNING_PROFILE_SCOPE(name) \
+  apollo::planning::ScopedPlanningProfile _planning_profile_scope_(name)
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_profiler.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(PlanningProfilerTest, Disabled) {
+  FLAGS_enable_planning_profiler = false;
+  auto* profiler = PlanningProfiler::Instance();
+  profiler->BeginCycle(1);
+  EXPECT_FALSE(profiler->IsRecording());
+  { PLANNING_PROFILE_SCOPE("Plan"); }
+  EXPECT_TRUE(profiler->spans().empty());
+}
+
+TEST(PlanningProfilerTest, NestedSpans) {
+  FLAGS_enable_planning_profiler = true;
+  auto* profiler = PlanningProfiler::Instance();
+  profiler->BeginCycle(2);
+  {
+    PLANNING_PROFILE_SCOPE("Plan");
+    {
+      PLANNING_PROFILE_SCOPE("PathBoundsDecider");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    { PLANNING_PROFILE_SCOPE("PiecewiseJerkPathOptimizer"); }
+  }
+  LatencyStats latency_stats;
+  profiler->EndCycle(&latency_stats);
+  EXPECT_FALSE(profiler->IsRecording());
+
+  // spans are recorded in the order they end
+  const auto spans = profiler->spans();
+  ASSERT_EQ(3, spans.size());
+  EXPECT_EQ("Plan/PathBoundsDecider", spans[0].path);
+  EXPECT_EQ(1, spans[0].depth);
+  EXPECT_EQ("Plan/PiecewiseJerkPathOptimizer", spans[1].path);
+  EXPECT_EQ("Plan", spans[2].path);
+  EXPECT_EQ(0, spans[2].depth);
+  EXPECT_GE(spans[0].duration_us, 1000);
+  EXPECT_GE(spans[2].duration_us, spans[0].duration_us);
+  EXPECT_LE(spans[2].start_us, spans[0].start_us);
+
+  ASSERT_EQ(3, latency_stats.task_stats_size());
+  EXPECT_EQ("Plan/PathBoundsDecider", latency_stats.task_stats(0).name());
+
+  const std::string events = profiler->ToChromeTraceEvents();
+  EXPECT_NE(std::string::npos, events.find("\"name\":\"PathBoundsDecider\""));
+  EXPECT_NE(std::string::npos, events.find("\"ph\":\"X\""));
+
+  // nothing is recorded outside of a cycle
+  { PLANNING_PROFILE_SCOPE("Plan"); }
+  EXPECT_EQ(3, profiler->spans().size());
+  FLAGS_enable_planning_profiler = false;
+}
+
+}  // namespace planning
+}  // namespace apollo
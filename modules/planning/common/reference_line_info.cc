@@ -50,10 +50,12 @@ std::unordered_map<std::string, bool>
 ReferenceLineInfo::ReferenceLineInfo(const common::VehicleState& vehicle_state,
                                      const TrajectoryPoint& adc_planning_point,
                                      const ReferenceLine& reference_line,
-                                     const hdmap::RouteSegments& segments)
+                                     const hdmap::RouteSegments& segments,
+                                     FrameArena* arena)
     : vehicle_state_(vehicle_state),
       adc_planning_point_(adc_planning_point),
       reference_line_(reference_line),
+      path_decision_(arena),
       lanes_(segments) {}
 
 bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
@@ -329,6 +331,37 @@ const SLBoundary& ReferenceLineInfo::AdcSlBoundary() const {
   return adc_sl_boundary_;
 }
 
+bool ReferenceLineInfo::GetObstaclePolygonSLBoundary(
+    const Obstacle& obstacle, SLBoundary* const sl_boundary) const {
+  auto iter = obstacle_polygon_sl_boundaries_.find(obstacle.Id());
+  if (iter != obstacle_polygon_sl_boundaries_.end()) {
+    *sl_boundary = iter->second;
+    return true;
+  }
+  std::vector<common::SLPoint> sl_points;
+  if (!reference_line_.XYToSL(obstacle.PerceptionPolygon().points(),
+                              &sl_points)) {
+    AERROR << "Failed to get sl boundary for obstacle: " << obstacle.Id();
+    return false;
+  }
+  double start_s = std::numeric_limits<double>::max();
+  double end_s = std::numeric_limits<double>::lowest();
+  double start_l = std::numeric_limits<double>::max();
+  double end_l = std::numeric_limits<double>::lowest();
+  for (const auto& sl_point : sl_points) {
+    start_s = std::fmin(start_s, sl_point.s());
+    end_s = std::fmax(end_s, sl_point.s());
+    start_l = std::fmin(start_l, sl_point.l());
+    end_l = std::fmax(end_l, sl_point.l());
+  }
+  sl_boundary->set_start_s(start_s);
+  sl_boundary->set_end_s(end_s);
+  sl_boundary->set_start_l(start_l);
+  sl_boundary->set_end_l(end_l);
+  obstacle_polygon_sl_boundaries_.emplace(obstacle.Id(), *sl_boundary);
+  return true;
+}
+
 PathDecision* ReferenceLineInfo::path_decision() { return &path_decision_; }
 
 const PathDecision& ReferenceLineInfo::path_decision() const {
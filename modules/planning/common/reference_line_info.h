@@ -59,7 +59,8 @@ class ReferenceLineInfo {
   ReferenceLineInfo(const common::VehicleState& vehicle_state,
                     const common::TrajectoryPoint& adc_planning_point,
                     const ReferenceLine& reference_line,
-                    const hdmap::RouteSegments& segments);
+                    const hdmap::RouteSegments& segments,
+                    FrameArena* arena = nullptr);
 
   bool Init(const std::vector<const Obstacle*>& obstacles);
 
@@ -135,6 +136,14 @@ class ReferenceLineInfo {
       DiscretizedTrajectory* adjusted_trajectory);
 
   const SLBoundary& AdcSlBoundary() const;
+
+  /**
+   * @brief SL boundary of the perception polygon of an obstacle on this
+   * reference line. It is computed once per obstacle and kept for the rest of
+   * the cycle. Not thread safe.
+   */
+  bool GetObstaclePolygonSLBoundary(const Obstacle& obstacle,
+                                    SLBoundary* const sl_boundary) const;
   std::string PathSpeedDebugString() const;
 
   /**
@@ -312,6 +321,9 @@ class ReferenceLineInfo {
    */
   SLBoundary adc_sl_boundary_;
 
+  mutable std::unordered_map<std::string, SLBoundary>
+      obstacle_polygon_sl_boundaries_;
+
   planning_internal::Debug debug_;
   LatencyStats latency_stats_;
 
@@ -20,7 +20,10 @@
 
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <utility>
 
 #include "cyber/common/log.h"
 #include "modules/common/math/linear_interpolation.h"
@@ -43,13 +46,36 @@ DiscretizedTrajectory::DiscretizedTrajectory(const ADCTrajectory& trajectory) {
          trajectory.trajectory_point().end());
 }
 
+DiscretizedTrajectory::DiscretizedTrajectory(
+    const DiscretizedTrajectory& other)
+    : std::vector<TrajectoryPoint>(other) {}
+
+DiscretizedTrajectory& DiscretizedTrajectory::operator=(
+    const DiscretizedTrajectory& other) {
+  std::vector<TrajectoryPoint>::operator=(other);
+  time_index_.Clear();
+  return *this;
+}
+
 TrajectoryPoint DiscretizedTrajectory::Evaluate(
     const double relative_time) const {
-  auto comp = [](const TrajectoryPoint& p, const double relative_time) {
-    return p.relative_time() < relative_time;
-  };
+  return Evaluate(relative_time, nullptr);
+}
 
-  auto it_lower = std::lower_bound(begin(), end(), relative_time, comp);
+TrajectoryPoint DiscretizedTrajectory::Evaluate(const double relative_time,
+                                                size_t* hint) const {
+  std::vector<TrajectoryPoint>::const_iterator it_lower;
+  if (HasTimeIndex()) {
+    it_lower = begin() + time_index_.LowerBound(relative_time, hint);
+  } else {
+    auto comp = [](const TrajectoryPoint& p, const double relative_time) {
+      return p.relative_time() < relative_time;
+    };
+    it_lower = std::lower_bound(begin(), end(), relative_time, comp);
+    if (hint != nullptr) {
+      *hint = std::distance(begin(), it_lower);
+    }
+  }
 
   if (it_lower == begin()) {
     return front();
@@ -69,6 +95,19 @@ size_t DiscretizedTrajectory::QueryLowerBoundPoint(const double relative_time,
   if (relative_time >= back().relative_time()) {
     return size() - 1;
   }
+  if (HasTimeIndex()) {
+    // tp + epsilon < relative_time may round differently from
+    // tp < relative_time - epsilon, settle on the exact predicate
+    size_t index = time_index_.LowerBound(relative_time - epsilon);
+    while (index > 0 &&
+           !(time_index_.key(index - 1) + epsilon < relative_time)) {
+      --index;
+    }
+    while (index < size() && time_index_.key(index) + epsilon < relative_time) {
+      ++index;
+    }
+    return index;
+  }
   auto func = [&epsilon](const TrajectoryPoint& tp,
                          const double relative_time) {
     return tp.relative_time() + epsilon < relative_time;
@@ -116,7 +155,39 @@ void DiscretizedTrajectory::AppendTrajectoryPoint(
   if (!empty()) {
     CHECK_GT(trajectory_point.relative_time(), back().relative_time());
   }
+  const bool has_time_index = HasTimeIndex();
   push_back(trajectory_point);
+  if (has_time_index) {
+    time_index_.Append(trajectory_point.relative_time());
+  }
+}
+
+void DiscretizedTrajectory::BuildTimeIndex() {
+  std::vector<double> relative_times;
+  relative_times.reserve(size());
+  for (const auto& point : *this) {
+    relative_times.push_back(point.relative_time());
+  }
+  time_index_.Reset(std::move(relative_times));
+}
+
+DiscretizedTrajectory DiscretizedTrajectory::ResampleByTime(
+    const double dt) const {
+  ACHECK(!empty());
+  ACHECK(dt > 0.0);
+  DiscretizedTrajectory resampled;
+  const double start_time = front().relative_time();
+  const double total_time = GetTemporalLength();
+  const size_t num_samples =
+      static_cast<size_t>(std::floor(total_time / dt + 1.0e-9)) + 1;
+  resampled.reserve(num_samples);
+  size_t hint = 0;
+  for (size_t i = 0; i < num_samples; ++i) {
+    resampled.push_back(
+        Evaluate(start_time + static_cast<double>(i) * dt, &hint));
+  }
+  resampled.BuildTimeIndex();
+  return resampled;
 }
 
 const TrajectoryPoint& DiscretizedTrajectory::TrajectoryPointAt(
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "modules/common/math/sorted_key_index.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/planning/proto/planning.pb.h"
 
@@ -44,6 +45,13 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
   void SetTrajectoryPoints(
       const std::vector<common::TrajectoryPoint>& trajectory_points);
 
+  /**
+   * The time index is not carried over from other, the copy builds its own.
+   */
+  DiscretizedTrajectory(const DiscretizedTrajectory& other);
+
+  DiscretizedTrajectory& operator=(const DiscretizedTrajectory& other);
+
   virtual ~DiscretizedTrajectory() = default;
 
   virtual common::TrajectoryPoint StartPoint() const;
@@ -54,6 +62,13 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
 
   virtual common::TrajectoryPoint Evaluate(const double relative_time) const;
 
+  /**
+   * Same as Evaluate(relative_time), the search starts from *hint, which is
+   * updated for the next call. Cheap for increasing or decreasing times.
+   */
+  common::TrajectoryPoint Evaluate(const double relative_time,
+                                   size_t* hint) const;
+
   virtual size_t QueryLowerBoundPoint(const double relative_time,
                                       const double epsilon = 1.0e-5) const;
 
@@ -72,6 +87,7 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
              front().relative_time());
     }
     insert(begin(), trajectory_points.begin(), trajectory_points.end());
+    time_index_.Clear();
   }
 
   const common::TrajectoryPoint& TrajectoryPointAt(const size_t index) const;
@@ -79,11 +95,36 @@ class DiscretizedTrajectory : public std::vector<common::TrajectoryPoint> {
   size_t NumOfPoints() const;
 
   virtual void Clear();
+
+  /**
+   * Packs the relative times of the points so that the time lookups search
+   * a contiguous array instead of the points, in constant time if the points
+   * are uniformly spaced in time. AppendTrajectoryPoint keeps the index,
+   * the other mutations through this class drop it. Points changed in place
+   * through the std::vector interface are not seen, build the index again.
+   */
+  void BuildTimeIndex();
+
+  /**
+   * Samples the trajectory every dt from the start point until the end, the
+   * result has a uniform time index.
+   */
+  DiscretizedTrajectory ResampleByTime(const double dt) const;
+
+ protected:
+  bool HasTimeIndex() const {
+    return !time_index_.empty() && time_index_.size() == size();
+  }
+
+  common::math::SortedKeyIndex time_index_;
 };
 
 inline size_t DiscretizedTrajectory::NumOfPoints() const { return size(); }
 
-inline void DiscretizedTrajectory::Clear() { clear(); }
+inline void DiscretizedTrajectory::Clear() {
+  clear();
+  time_index_.Clear();
+}
 
 }  // namespace planning
 }  // namespace apollo
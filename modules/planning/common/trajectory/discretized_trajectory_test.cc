@@ -52,5 +52,49 @@ TEST(basic_test, DiscretizedTrajectory) {
   EXPECT_EQ(discretized_trajectory.NumOfPoints(), 121);
 }
 
+TEST(time_index_test, DiscretizedTrajectory) {
+  const std::string path_of_standard_trajectory =
+      "modules/planning/testdata/trajectory_data/standard_trajectory.pb.txt";
+  ADCTrajectory trajectory;
+  EXPECT_TRUE(cyber::common::GetProtoFromFile(path_of_standard_trajectory,
+                                              &trajectory));
+  const DiscretizedTrajectory plain_trajectory(trajectory);
+  DiscretizedTrajectory indexed_trajectory(trajectory);
+  indexed_trajectory.BuildTimeIndex();
+
+  size_t hint = 0;
+  for (double t = -1.0; t < 10.0; t += 0.013) {
+    const auto expected = plain_trajectory.Evaluate(t);
+    const auto p1 = indexed_trajectory.Evaluate(t);
+    const auto p2 = indexed_trajectory.Evaluate(t, &hint);
+    EXPECT_DOUBLE_EQ(expected.path_point().x(), p1.path_point().x());
+    EXPECT_DOUBLE_EQ(expected.path_point().y(), p1.path_point().y());
+    EXPECT_DOUBLE_EQ(expected.v(), p1.v());
+    EXPECT_DOUBLE_EQ(expected.path_point().x(), p2.path_point().x());
+    EXPECT_DOUBLE_EQ(expected.v(), p2.v());
+    EXPECT_EQ(plain_trajectory.QueryLowerBoundPoint(t),
+              indexed_trajectory.QueryLowerBoundPoint(t));
+  }
+  EXPECT_EQ(indexed_trajectory.QueryLowerBoundPoint(2.12), 62);
+
+  // appending keeps the index in sync
+  auto last_point = indexed_trajectory.back();
+  last_point.set_relative_time(last_point.relative_time() + 0.5);
+  last_point.set_v(1.0);
+  indexed_trajectory.AppendTrajectoryPoint(last_point);
+  EXPECT_DOUBLE_EQ(indexed_trajectory.Evaluate(100.0).v(), 1.0);
+  EXPECT_EQ(indexed_trajectory.QueryLowerBoundPoint(
+                last_point.relative_time() - 0.1),
+            indexed_trajectory.size() - 1);
+
+  const auto resampled = plain_trajectory.ResampleByTime(0.1);
+  EXPECT_EQ(resampled.size(), 81);
+  for (double t = 0.0; t < 8.0; t += 0.05) {
+    const double time = plain_trajectory.front().relative_time() + t;
+    EXPECT_NEAR(plain_trajectory.Evaluate(time).path_point().x(),
+                resampled.Evaluate(time).path_point().x(), 0.1);
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -225,19 +225,25 @@ std::vector<TrajectoryPoint> TrajectoryStitcher::ComputeStitchingTrajectory(
 
   auto matched_index = std::min(time_matched_index, position_matched_index);
 
-  std::vector<TrajectoryPoint> stitching_trajectory(
+  const auto stitching_begin =
       prev_trajectory->begin() +
-          std::max(0, static_cast<int>(matched_index - preserved_points_num)),
-      prev_trajectory->begin() + forward_time_index + 1);
-  ADEBUG << "stitching_trajectory size: " << stitching_trajectory.size();
-
-  const double zero_s = stitching_trajectory.back().path_point().s();
-  for (auto& tp : stitching_trajectory) {
-    if (!tp.has_path_point()) {
+      std::max(0, static_cast<int>(matched_index - preserved_points_num));
+  const auto stitching_end = prev_trajectory->begin() + forward_time_index + 1;
+  // check the previous points in place so that a replan copies nothing
+  for (auto it = stitching_begin; it != stitching_end; ++it) {
+    if (!it->has_path_point()) {
       *replan_reason = "replan for previous trajectory missed path point";
       return ComputeReinitStitchingTrajectory(planning_cycle_time,
                                               vehicle_state);
     }
+  }
+
+  std::vector<TrajectoryPoint> stitching_trajectory(stitching_begin,
+                                                    stitching_end);
+  ADEBUG << "stitching_trajectory size: " << stitching_trajectory.size();
+
+  const double zero_s = stitching_trajectory.back().path_point().s();
+  for (auto& tp : stitching_trajectory) {
     tp.set_relative_time(tp.relative_time() + prev_trajectory->header_time() -
                          current_timestamp);
     tp.mutable_path_point()->set_s(tp.path_point().s() - zero_s);
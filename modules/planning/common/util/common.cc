@@ -48,7 +48,7 @@ int BuildStopDecision(const std::string& stop_wall_id, const double stop_line_s,
     AERROR << "Failed to create obstacle [" << stop_wall_id << "]";
     return -1;
   }
-  const Obstacle* stop_wall = reference_line_info->AddObstacle(obstacle);
+  Obstacle* stop_wall = reference_line_info->AddObstacle(obstacle);
   if (!stop_wall) {
     AERROR << "Failed to add obstacle[" << stop_wall_id << "]";
     return -1;
@@ -73,8 +73,8 @@ int BuildStopDecision(const std::string& stop_wall_id, const double stop_line_s,
     stop_decision->add_wait_for_obstacle(wait_for_obstacles[i]);
   }
 
-  auto* path_decision = reference_line_info->path_decision();
-  path_decision->AddLongitudinalDecision(decision_tag, stop_wall->Id(), stop);
+  // the stop wall in the path decision, no need to look it up by id
+  stop_wall->AddLongitudinalDecision(decision_tag, stop);
 
   return 0;
 }
@@ -99,7 +99,7 @@ int BuildStopDecision(const std::string& stop_wall_id,
     return -1;
   }
 
-  const Obstacle* stop_wall = reference_line_info->AddObstacle(obstacle);
+  Obstacle* stop_wall = reference_line_info->AddObstacle(obstacle);
   if (!stop_wall) {
     AERROR << "Failed to create obstacle for: " << stop_wall_id;
     return -1;
@@ -124,8 +124,8 @@ int BuildStopDecision(const std::string& stop_wall_id,
   stop_decision->mutable_stop_point()->set_y(stop_point.y());
   stop_decision->mutable_stop_point()->set_z(0.0);
 
-  auto* path_decision = reference_line_info->path_decision();
-  path_decision->AddLongitudinalDecision(decision_tag, stop_wall->Id(), stop);
+  // the stop wall in the path decision, no need to look it up by id
+  stop_wall->AddLongitudinalDecision(decision_tag, stop);
 
   return 0;
 }
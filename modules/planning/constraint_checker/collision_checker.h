@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "modules/common/math/box2d.h"
+#include "modules/common/math/box2d_batch.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/reference_line_info.h"
 #include "modules/planning/common/trajectory/discretized_trajectory.h"
@@ -64,7 +65,7 @@ class CollisionChecker {
  private:
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+  std::vector<common::math::Box2dBatch> predicted_bounding_rectangles_;
 };
 
 }  // namespace planning
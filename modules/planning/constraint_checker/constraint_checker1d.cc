@@ -20,6 +20,8 @@
 
 #include "modules/planning/constraint_checker/constraint_checker1d.h"
 
+#include <vector>
+
 #include "cyber/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
 
@@ -32,47 +34,73 @@ inline bool fuzzy_within(const double v, const double lower, const double upper,
                          const double e = 1.0e-4) {
   return v > lower - e && v < upper + e;
 }
+
+std::vector<double> SampleTimes(const double param_length) {
+  std::vector<double> ts;
+  double t = 0.0;
+  while (t < param_length) {
+    ts.push_back(t);
+    t += FLAGS_trajectory_time_resolution;
+  }
+  return ts;
+}
 }  // namespace
 
 bool ConstraintChecker1d::IsValidLongitudinalTrajectory(
     const Curve1d& lon_trajectory) {
-  double t = 0.0;
-  while (t < lon_trajectory.ParamLength()) {
-    double v = lon_trajectory.Evaluate(1, t);  // evaluate_v
-    if (!fuzzy_within(v, FLAGS_speed_lower_bound, FLAGS_speed_upper_bound)) {
+  const std::vector<double> ts = SampleTimes(lon_trajectory.ParamLength());
+  std::vector<double> lon_v;
+  std::vector<double> lon_a;
+  std::vector<double> lon_j;
+  lon_trajectory.EvaluateBatch(1, ts, &lon_v);
+  lon_trajectory.EvaluateBatch(2, ts, &lon_a);
+  lon_trajectory.EvaluateBatch(3, ts, &lon_j);
+  for (size_t i = 0; i < ts.size(); ++i) {
+    if (!fuzzy_within(lon_v[i], FLAGS_speed_lower_bound,
+                      FLAGS_speed_upper_bound)) {
       return false;
     }
 
-    double a = lon_trajectory.Evaluate(2, t);  // evaluate_a
-    if (!fuzzy_within(a, FLAGS_longitudinal_acceleration_lower_bound,
+    if (!fuzzy_within(lon_a[i], FLAGS_longitudinal_acceleration_lower_bound,
                       FLAGS_longitudinal_acceleration_upper_bound)) {
       return false;
     }
 
-    double j = lon_trajectory.Evaluate(3, t);
-    if (!fuzzy_within(j, FLAGS_longitudinal_jerk_lower_bound,
+    if (!fuzzy_within(lon_j[i], FLAGS_longitudinal_jerk_lower_bound,
                       FLAGS_longitudinal_jerk_upper_bound)) {
       return false;
     }
-    t += FLAGS_trajectory_time_resolution;
   }
   return true;
 }
 
 bool ConstraintChecker1d::IsValidLateralTrajectory(
     const Curve1d& lat_trajectory, const Curve1d& lon_trajectory) {
-  double t = 0.0;
-  while (t < lon_trajectory.ParamLength()) {
-    double s = lon_trajectory.Evaluate(0, t);
-    double dd_ds = lat_trajectory.Evaluate(1, s);
-    double ds_dt = lon_trajectory.Evaluate(1, t);
-
-    double d2d_ds2 = lat_trajectory.Evaluate(2, s);
-    double d2s_dt2 = lon_trajectory.Evaluate(2, t);
+  const std::vector<double> ts = SampleTimes(lon_trajectory.ParamLength());
+  std::vector<double> lon_s;
+  std::vector<double> lon_ds_dt;
+  std::vector<double> lon_d2s_dt2;
+  std::vector<double> lon_d3s_dt3;
+  lon_trajectory.EvaluateBatch(0, ts, &lon_s);
+  lon_trajectory.EvaluateBatch(1, ts, &lon_ds_dt);
+  lon_trajectory.EvaluateBatch(2, ts, &lon_d2s_dt2);
+  lon_trajectory.EvaluateBatch(3, ts, &lon_d3s_dt3);
+
+  std::vector<double> lat_dd_ds;
+  std::vector<double> lat_d2d_ds2;
+  std::vector<double> lat_d3d_ds3;
+  lat_trajectory.EvaluateBatch(1, lon_s, &lat_dd_ds);
+  lat_trajectory.EvaluateBatch(2, lon_s, &lat_d2d_ds2);
+  lat_trajectory.EvaluateBatch(3, lon_s, &lat_d3d_ds3);
+
+  const double lat_param_length = lat_trajectory.ParamLength();
+  for (size_t i = 0; i < ts.size(); ++i) {
+    const double s = lon_s[i];
+    const double ds_dt = lon_ds_dt[i];
 
     double a = 0.0;
-    if (s < lat_trajectory.ParamLength()) {
-      a = d2d_ds2 * ds_dt * ds_dt + dd_ds * d2s_dt2;
+    if (s < lat_param_length) {
+      a = lat_d2d_ds2[i] * ds_dt * ds_dt + lat_dd_ds[i] * lon_d2s_dt2[i];
     }
 
     if (!fuzzy_within(a, -FLAGS_lateral_acceleration_bound,
@@ -82,14 +110,13 @@ bool ConstraintChecker1d::IsValidLateralTrajectory(
 
     // this is not accurate, just an approximation...
     double j = 0.0;
-    if (s < lat_trajectory.ParamLength()) {
-      j = lat_trajectory.Evaluate(3, s) * lon_trajectory.Evaluate(3, t);
+    if (s < lat_param_length) {
+      j = lat_d3d_ds3[i] * lon_d3s_dt3[i];
     }
 
     if (!fuzzy_within(j, -FLAGS_lateral_jerk_bound, FLAGS_lateral_jerk_bound)) {
       return false;
     }
-    t += FLAGS_trajectory_time_resolution;
   }
   return true;
 }
@@ -57,6 +57,32 @@ double LatticeTrajectory1d::Evaluate(const std::uint32_t order,
   }
 }
 
+void LatticeTrajectory1d::EvaluateBatch(const std::uint32_t order,
+                                        const std::vector<double>& params,
+                                        std::vector<double>* values) const {
+  // the leading params inside the curve are evaluated in one batch, the
+  // rest fall back to the extrapolation in Evaluate.
+  const double param_length = ptr_trajectory1d_->ParamLength();
+  size_t num_inside = 0;
+  while (num_inside < params.size() && params[num_inside] < param_length) {
+    ++num_inside;
+  }
+  if (num_inside == params.size()) {
+    ptr_trajectory1d_->EvaluateBatch(order, params, values);
+    return;
+  }
+  values->clear();
+  if (num_inside > 0) {
+    const std::vector<double> params_inside(params.begin(),
+                                            params.begin() + num_inside);
+    ptr_trajectory1d_->EvaluateBatch(order, params_inside, values);
+  }
+  values->reserve(params.size());
+  for (size_t i = num_inside; i < params.size(); ++i) {
+    values->push_back(Evaluate(order, params[i]));
+  }
+}
+
 double LatticeTrajectory1d::ParamLength() const {
   return ptr_trajectory1d_->ParamLength();
 }
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/curve1d.h"
 
@@ -36,6 +37,10 @@ class LatticeTrajectory1d : public Curve1d {
 
   virtual double Evaluate(const std::uint32_t order, const double param) const;
 
+  void EvaluateBatch(const std::uint32_t order,
+                     const std::vector<double>& params,
+                     std::vector<double>* values) const override;
+
   virtual double ParamLength() const;
 
   virtual std::string ToString() const;
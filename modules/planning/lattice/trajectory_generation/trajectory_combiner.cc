@@ -17,6 +17,7 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_combiner.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
@@ -40,30 +41,52 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
   double accumulated_trajectory_s = 0.0;
   PathPoint prev_trajectory_point;
 
-  double last_s = -FLAGS_numerical_epsilon;
+  std::vector<double> t_params;
   double t_param = 0.0;
   while (t_param < FLAGS_trajectory_time_length) {
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about t_param > lon_trajectory.ParamLength() situation
-    double s = lon_trajectory.Evaluate(0, t_param);
+    t_params.push_back(t_param);
+    t_param = t_param + FLAGS_trajectory_time_resolution;
+  }
+
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about t_param > lon_trajectory.ParamLength() situation
+  std::vector<double> lon_s;
+  std::vector<double> lon_s_dot;
+  std::vector<double> lon_s_ddot;
+  lon_trajectory.EvaluateBatch(0, t_params, &lon_s);
+  lon_trajectory.EvaluateBatch(1, t_params, &lon_s_dot);
+  lon_trajectory.EvaluateBatch(2, t_params, &lon_s_ddot);
+
+  double last_s = -FLAGS_numerical_epsilon;
+  std::vector<double> relative_s;
+  relative_s.reserve(t_params.size());
+  for (double& s : lon_s) {
     if (last_s > 0.0) {
       s = std::max(last_s, s);
     }
     last_s = s;
-
-    double s_dot =
-        std::max(FLAGS_numerical_epsilon, lon_trajectory.Evaluate(1, t_param));
-    double s_ddot = lon_trajectory.Evaluate(2, t_param);
     if (s > s_ref_max) {
       break;
     }
+    relative_s.push_back(s - s0);
+  }
 
-    double relative_s = s - s0;
-    // linear extrapolation is handled internally in LatticeTrajectory1d;
-    // no worry about s_param > lat_trajectory.ParamLength() situation
-    double d = lat_trajectory.Evaluate(0, relative_s);
-    double d_prime = lat_trajectory.Evaluate(1, relative_s);
-    double d_pprime = lat_trajectory.Evaluate(2, relative_s);
+  // linear extrapolation is handled internally in LatticeTrajectory1d;
+  // no worry about s_param > lat_trajectory.ParamLength() situation
+  std::vector<double> lat_d;
+  std::vector<double> lat_d_prime;
+  std::vector<double> lat_d_pprime;
+  lat_trajectory.EvaluateBatch(0, relative_s, &lat_d);
+  lat_trajectory.EvaluateBatch(1, relative_s, &lat_d_prime);
+  lat_trajectory.EvaluateBatch(2, relative_s, &lat_d_pprime);
+
+  for (size_t i = 0; i < relative_s.size(); ++i) {
+    const double s = lon_s[i];
+    const double s_dot = std::max(FLAGS_numerical_epsilon, lon_s_dot[i]);
+    const double s_ddot = lon_s_ddot[i];
+    const double d = lat_d[i];
+    const double d_prime = lat_d_prime[i];
+    const double d_pprime = lat_d_pprime[i];
 
     PathPoint matched_ref_point = PathMatcher::MatchToPath(reference_line, s);
 
@@ -102,12 +125,10 @@ DiscretizedTrajectory TrajectoryCombiner::Combine(
     trajectory_point.mutable_path_point()->set_kappa(kappa);
     trajectory_point.set_v(v);
     trajectory_point.set_a(a);
-    trajectory_point.set_relative_time(t_param + init_relative_time);
+    trajectory_point.set_relative_time(t_params[i] + init_relative_time);
 
     combined_trajectory.AppendTrajectoryPoint(trajectory_point);
 
-    t_param = t_param + FLAGS_trajectory_time_resolution;
-
     prev_trajectory_point = trajectory_point.path_point();
   }
   return combined_trajectory;
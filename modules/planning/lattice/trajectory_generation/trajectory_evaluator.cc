@@ -21,9 +21,12 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
+#include <unordered_map>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory1d/piecewise_acceleration_trajectory1d.h"
@@ -64,6 +67,12 @@ TrajectoryEvaluator::TrajectoryEvaluator(
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
+  // the lateral comfort cost is left out of the lower bound, which needs a
+  // non-negative weight.
+  const bool lazy_evaluation =
+      FLAGS_enable_lazy_lattice_trajectory_evaluation &&
+      FLAGS_weight_lat_comfort >= 0.0;
+  std::vector<PtrTrajectory1d> valid_lon_trajectories;
   for (const auto& lon_trajectory : lon_trajectories) {
     double lon_end_s = lon_trajectory->Evaluate(0, end_time);
     if (init_s[0] < stop_point &&
@@ -74,6 +83,10 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
+    if (lazy_evaluation) {
+      valid_lon_trajectories.push_back(lon_trajectory);
+      continue;
+    }
     for (const auto& lat_trajectory : lat_trajectories) {
       /**
        * The validity of the code needs to be verified.
@@ -87,7 +100,12 @@ TrajectoryEvaluator::TrajectoryEvaluator(
                           cost);
     }
   }
-  ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
+  if (lazy_evaluation) {
+    EvaluateLazily(planning_target, valid_lon_trajectories, lat_trajectories);
+    ResolveTopTrajectoryPair();
+  }
+  ADEBUG << "Number of valid 1d trajectory pairs: "
+         << num_of_trajectory_pairs();
 }
 
 bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
@@ -95,7 +113,7 @@ bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
 }
 
 size_t TrajectoryEvaluator::num_of_trajectory_pairs() const {
-  return cost_queue_.size();
+  return cost_queue_.size() + lower_bound_queue_.size();
 }
 
 std::pair<PtrTrajectory1d, PtrTrajectory1d>
@@ -103,6 +121,7 @@ TrajectoryEvaluator::next_top_trajectory_pair() {
   ACHECK(has_more_trajectory_pairs());
   auto top = cost_queue_.top();
   cost_queue_.pop();
+  ResolveTopTrajectoryPair();
   return top.first;
 }
 
@@ -162,6 +181,82 @@ double TrajectoryEvaluator::Evaluate(
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
+void TrajectoryEvaluator::EvaluateLazily(
+    const PlanningTarget& planning_target,
+    const std::vector<PtrTrajectory1d>& lon_trajectories,
+    const std::vector<PtrTrajectory1d>& lat_trajectories) {
+  std::vector<std::vector<double>> s_values(lon_trajectories.size());
+  std::vector<std::future<double>> lon_costs;
+  lon_costs.reserve(lon_trajectories.size());
+  for (size_t i = 0; i < lon_trajectories.size(); ++i) {
+    lon_costs.push_back(cyber::Async([this, &planning_target,
+                                      &lon_trajectories, &s_values, i]() {
+      return EvaluateLongitudinal(planning_target, lon_trajectories[i],
+                                  &s_values[i]);
+    }));
+  }
+
+  // The s values of all lon. trajectories start at 0.0 with the same step,
+  // so the lateral offset cost only changes with the number of them.
+  std::vector<std::unordered_map<size_t, double>> lat_offset_costs(
+      lat_trajectories.size());
+  for (size_t i = 0; i < lon_trajectories.size(); ++i) {
+    const double lon_cost = lon_costs[i].get();
+    for (size_t j = 0; j < lat_trajectories.size(); ++j) {
+      auto iter = lat_offset_costs[j].find(s_values[i].size());
+      if (iter == lat_offset_costs[j].end()) {
+        iter = lat_offset_costs[j]
+                   .emplace(s_values[i].size(),
+                            LatOffsetCost(lat_trajectories[j], s_values[i]))
+                   .first;
+      }
+      lower_bound_queue_.emplace(
+          Trajectory1dPair(lon_trajectories[i], lat_trajectories[j]),
+          lon_cost + iter->second * FLAGS_weight_lat_offset);
+    }
+  }
+}
+
+double TrajectoryEvaluator::EvaluateLongitudinal(
+    const PlanningTarget& planning_target,
+    const PtrTrajectory1d& lon_trajectory,
+    std::vector<double>* s_values) const {
+  double lon_objective_cost =
+      LonObjectiveCost(lon_trajectory, planning_target, reference_s_dot_);
+
+  double lon_jerk_cost = LonComfortCost(lon_trajectory);
+
+  double lon_collision_cost = LonCollisionCost(lon_trajectory);
+
+  double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
+
+  // same horizon as in Evaluate
+  double evaluation_horizon =
+      std::min(FLAGS_speed_lon_decision_horizon,
+               lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
+  for (double s = 0.0; s < evaluation_horizon;
+       s += FLAGS_trajectory_space_resolution) {
+    s_values->emplace_back(s);
+  }
+
+  return lon_objective_cost * FLAGS_weight_lon_objective +
+         lon_jerk_cost * FLAGS_weight_lon_jerk +
+         lon_collision_cost * FLAGS_weight_lon_collision +
+         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration;
+}
+
+void TrajectoryEvaluator::ResolveTopTrajectoryPair() {
+  while (!lower_bound_queue_.empty() &&
+         (cost_queue_.empty() ||
+          lower_bound_queue_.top().second < cost_queue_.top().second)) {
+    auto top = lower_bound_queue_.top();
+    lower_bound_queue_.pop();
+    double lat_comfort_cost = LatComfortCost(top.first.first, top.first.second);
+    cost_queue_.emplace(
+        top.first, top.second + lat_comfort_cost * FLAGS_weight_lat_comfort);
+  }
+}
+
 double TrajectoryEvaluator::LatOffsetCost(
     const PtrTrajectory1d& lat_trajectory,
     const std::vector<double>& s_values) const {
@@ -74,6 +74,30 @@ class TrajectoryEvaluator {
                   const std::shared_ptr<Curve1d>& lat_trajectory,
                   std::vector<double>* cost_components = nullptr) const;
 
+  /**
+   * @brief Queue all pairs by their cost without the lateral comfort cost,
+   * which is a lower bound of the full cost. The longitudinal costs are
+   * evaluated once per lon. trajectory in the thread pool.
+   */
+  void EvaluateLazily(
+      const PlanningTarget& planning_target,
+      const std::vector<std::shared_ptr<Curve1d>>& lon_trajectories,
+      const std::vector<std::shared_ptr<Curve1d>>& lat_trajectories);
+
+  /**
+   * @brief The weighted sum of the costs only depending on the lon.
+   * trajectory, with the s values to evaluate the lateral offset cost at.
+   */
+  double EvaluateLongitudinal(const PlanningTarget& planning_target,
+                              const std::shared_ptr<Curve1d>& lon_trajectory,
+                              std::vector<double>* s_values) const;
+
+  /**
+   * @brief Fully evaluate the lazily queued pairs until the top of
+   * cost_queue_ is the pair with the lowest cost.
+   */
+  void ResolveTopTrajectoryPair();
+
   double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
                        const std::vector<double>& s_values) const;
 
@@ -108,6 +132,10 @@ class TrajectoryEvaluator {
   std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
       cost_queue_;
 
+  // pairs with the lower bound of their cost, in lazy evaluation
+  std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
+      lower_bound_queue_;
+
   std::shared_ptr<PathTimeGraph> path_time_graph_;
 
   std::shared_ptr<std::vector<apollo::common::PathPoint>> reference_line_;
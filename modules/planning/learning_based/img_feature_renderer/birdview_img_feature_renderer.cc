@@ -617,21 +617,16 @@ bool BirdviewImgFeatureRenderer::CropByPose(const double ego_x,
     return false;
   }
 
-  cv::Rect rough_rect(ego_img_idx.x - rough_radius,
-                      ego_img_idx.y - rough_radius, 2 * rough_radius,
-                      2 * rough_radius);
-  cv::Mat rotation_matrix =
-      cv::getRotationMatrix2D(cv::Point2i(rough_radius, rough_radius),
-                              90.0 - ego_heading * 180.0 / M_PI, 1.0);
-  cv::Mat rotated_mat;
-  cv::warpAffine(base_map(rough_rect), rotated_mat, rotation_matrix,
-                 base_map(rough_rect).size());
-
-  cv::Rect fine_rect(rough_radius - config_.ego_idx_x(),
-                     rough_radius - config_.ego_idx_y(), config_.height(),
-                     config_.width());
-
-  rotated_mat(fine_rect).copyTo(*img_feature);
+  // rotate around ego and shift ego onto its feature index in one affine
+  // transform, so that only the pixels of the feature img are interpolated
+  // instead of warping the whole rough rect and cropping it afterwards
+  cv::Mat affine_matrix = cv::getRotationMatrix2D(
+      ego_img_idx, 90.0 - ego_heading * 180.0 / M_PI, 1.0);
+  affine_matrix.at<double>(0, 2) += config_.ego_idx_x() - ego_img_idx.x;
+  affine_matrix.at<double>(1, 2) += config_.ego_idx_y() - ego_img_idx.y;
+
+  cv::warpAffine(base_map, *img_feature, affine_matrix,
+                 cv::Size(config_.height(), config_.width()));
   return true;
 }
 
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "modules/planning/proto/learning_data.pb.h"
 #include "modules/planning/proto/task_config.pb.h"
@@ -57,6 +58,20 @@ class ModelInference {
    */
   virtual bool DoInference(LearningDataFrame* learning_data_frame) = 0;
 
+  /**
+   * @brief inference a learned model on several candidate frames, e.g.
+   * alternative reference lines, one inference per frame by default
+   */
+  virtual bool DoBatchInference(
+      const std::vector<LearningDataFrame*>& learning_data_frames) {
+    for (auto* learning_data_frame : learning_data_frames) {
+      if (!DoInference(learning_data_frame)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
  protected:
   LearningModelInferenceTaskConfig config_;
 };
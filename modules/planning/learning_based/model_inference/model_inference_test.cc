@@ -87,6 +87,33 @@ TEST_F(ModelInferenceTest, trajectory_imitation_libtorch_inference) {
       << "Failed to load model in libtorch inference";
   ACHECK(trajectory_imitation_libtorch_inference->DoInference(&test_data_frame))
       << "Failed to inference trajectory_imitation_model";
+
+  // a batch of identical candidates gives the single frame output each
+  LearningDataFrame first_candidate = test_data_frame;
+  LearningDataFrame second_candidate = test_data_frame;
+  first_candidate.clear_output();
+  second_candidate.clear_output();
+  ACHECK(trajectory_imitation_libtorch_inference->DoBatchInference(
+      {&first_candidate, &second_candidate}))
+      << "Failed to batch inference trajectory_imitation_model";
+  const int output_size =
+      test_data_frame.output().adc_future_trajectory_point_size();
+  EXPECT_EQ(output_size,
+            first_candidate.output().adc_future_trajectory_point_size());
+  EXPECT_EQ(output_size,
+            second_candidate.output().adc_future_trajectory_point_size());
+  for (int i = 0; i < output_size; ++i) {
+    const auto& path_point = test_data_frame.output()
+                                 .adc_future_trajectory_point(i)
+                                 .trajectory_point()
+                                 .path_point();
+    const auto& batch_path_point = second_candidate.output()
+                                       .adc_future_trajectory_point(i)
+                                       .trajectory_point()
+                                       .path_point();
+    EXPECT_NEAR(path_point.x(), batch_path_point.x(), 1e-3);
+    EXPECT_NEAR(path_point.y(), batch_path_point.y(), 1e-3);
+  }
 }
 
 }  // namespace planning
@@ -16,6 +16,7 @@
 
 #include "modules/planning/learning_based/model_inference/trajectory_imitation_libtorch_inference.h"
 
+#include <future>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "opencv2/opencv.hpp"
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/planning/common/util/math_util.h"
@@ -105,7 +107,7 @@ bool TrajectoryImitationLibtorchInference::LoadModel() {
 }
 
 void TrajectoryImitationLibtorchInference::output_postprocessing(
-    const at::Tensor& torch_output_tensor,
+    const at::Tensor& torch_output_tensor, const int batch_index,
     LearningDataFrame* const learning_data_frame) {
   const int past_points_size = learning_data_frame->adc_trajectory_point_size();
   const auto& cur_traj_point =
@@ -121,12 +123,12 @@ void TrajectoryImitationLibtorchInference::output_postprocessing(
 
   learning_data_frame->mutable_output()->clear_adc_future_trajectory_point();
   const double delta_t = config_.trajectory_delta_t();
-  auto torch_output = torch_output_tensor.accessor<float, 3>();
+  auto torch_output = torch_output_tensor.accessor<float, 3>()[batch_index];
   for (int i = 0; i < torch_output_tensor.size(1); ++i) {
-    const double dx = static_cast<double>(torch_output[0][i][0]);
-    const double dy = static_cast<double>(torch_output[0][i][1]);
-    const double dtheta = static_cast<double>(torch_output[0][i][2]);
-    const double v = static_cast<double>(torch_output[0][i][3]);
+    const double dx = static_cast<double>(torch_output[i][0]);
+    const double dy = static_cast<double>(torch_output[i][1]);
+    const double dtheta = static_cast<double>(torch_output[i][2]);
+    const double v = static_cast<double>(torch_output[i][3]);
     ADEBUG << "dx[" << dx << "], dy[" << dy << "], dtheta[" << dtheta << "], v["
            << v << "]";
     const double time_sec = cur_time_sec + delta_t * (i + 1);
@@ -150,19 +152,35 @@ void TrajectoryImitationLibtorchInference::output_postprocessing(
   }
 }
 
-bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
-    LearningDataFrame* const learning_data_frame) {
-  const int past_points_size = learning_data_frame->adc_trajectory_point_size();
-  if (past_points_size == 0) {
-    AERROR << "No current trajectory point status";
-    return false;
+bool TrajectoryImitationLibtorchInference::PrepareInputFeature(
+    const std::vector<LearningDataFrame*>& learning_data_frames,
+    torch::Tensor* input_feature_tensor) {
+  const int batch_size = static_cast<int>(learning_data_frames.size());
+  for (const auto* learning_data_frame : learning_data_frames) {
+    if (learning_data_frame->adc_trajectory_point_size() == 0) {
+      AERROR << "No current trajectory point status";
+      return false;
+    }
   }
 
   auto input_renderering_start_time = std::chrono::system_clock::now();
 
-  cv::Mat input_feature;
-  if (!BirdviewImgFeatureRenderer::Instance()->RenderMultiChannelEnv(
-          *learning_data_frame, &input_feature)) {
+  std::vector<cv::Mat> input_features(batch_size);
+  std::vector<std::future<bool>> results;
+  for (int i = 1; i < batch_size; ++i) {
+    results.push_back(cyber::Async(
+        [&learning_data_frames, &input_features, i]() {
+          return BirdviewImgFeatureRenderer::Instance()->RenderMultiChannelEnv(
+              *learning_data_frames[i], &input_features[i]);
+        }));
+  }
+  bool render_status =
+      BirdviewImgFeatureRenderer::Instance()->RenderMultiChannelEnv(
+          *learning_data_frames[0], &input_features[0]);
+  for (auto& result : results) {
+    render_status = result.get() && render_status;
+  }
+  if (!render_status) {
     AERROR << "Render multi-channel input image failed";
     return false;
   }
@@ -175,27 +193,47 @@ bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
 
   auto input_preprocessing_start_time = std::chrono::system_clock::now();
 
-  cv::Mat input_feature_float;
-  input_feature.convertTo(input_feature_float, CV_32F, 1.0 / 255);
-  torch::Tensor input_feature_tensor =
-      torch::from_blob(input_feature_float.data,
-                       {1, input_feature_float.rows, input_feature_float.cols,
-                        input_feature_float.channels()});
-  input_feature_tensor = input_feature_tensor.permute({0, 3, 1, 2});
-  for (int i = 0; i < input_feature_float.channels(); ++i) {
-    input_feature_tensor[0][i] = input_feature_tensor[0][i].sub(0.5).div(0.5);
+  const int rows = input_features[0].rows;
+  const int cols = input_features[0].cols;
+  const int channels = input_features[0].channels();
+  if (input_feature_buffer_.dim() != 4 ||
+      input_feature_buffer_.size(0) != batch_size ||
+      input_feature_buffer_.size(1) != rows ||
+      input_feature_buffer_.size(2) != cols ||
+      input_feature_buffer_.size(3) != channels) {
+    input_feature_buffer_ = torch::empty(
+        {batch_size, rows, cols, channels},
+        torch::TensorOptions().dtype(torch::kFloat32).pinned_memory(
+            device_.is_cuda()));
+  }
+  // convert from [0, 255] to the normalized [-1, 1] directly into the buffer
+  for (int i = 0; i < batch_size; ++i) {
+    cv::Mat input_feature_float(rows, cols, CV_32FC(channels),
+                                input_feature_buffer_[i].data_ptr());
+    input_features[i].convertTo(input_feature_float, CV_32F, 2.0 / 255, -1.0);
   }
+  *input_feature_tensor = input_feature_buffer_.permute({0, 3, 1, 2});
 
   auto input_preprocessing_end_time = std::chrono::system_clock::now();
   std::chrono::duration<double> preprocessing_diff =
       input_preprocessing_end_time - input_preprocessing_start_time;
   ADEBUG << "trajectory imitation model input preprocessing used time: "
          << preprocessing_diff.count() * 1000 << " ms.";
+  return true;
+}
+
+bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
+    const std::vector<LearningDataFrame*>& learning_data_frames) {
+  torch::Tensor input_feature_tensor;
+  if (!PrepareInputFeature(learning_data_frames, &input_feature_tensor)) {
+    return false;
+  }
 
   auto inference_start_time = std::chrono::system_clock::now();
 
   std::vector<torch::jit::IValue> torch_inputs;
-  torch_inputs.push_back(input_feature_tensor.to(device_));
+  torch_inputs.push_back(
+      input_feature_tensor.to(device_, torch::kFloat32, true));
   at::Tensor torch_output_tensor =
       model_.forward(torch_inputs).toTensor().to(torch::kCPU);
 
@@ -205,69 +243,38 @@ bool TrajectoryImitationLibtorchInference::DoCNNMODELInference(
   ADEBUG << "trajectory imitation model inference used time: "
          << inference_diff.count() * 1000 << " ms.";
 
-  output_postprocessing(torch_output_tensor, learning_data_frame);
+  for (size_t i = 0; i < learning_data_frames.size(); ++i) {
+    output_postprocessing(torch_output_tensor, static_cast<int>(i),
+                          learning_data_frames[i]);
+  }
 
   return true;
 }
 
 bool TrajectoryImitationLibtorchInference::DoCNNLSTMMODELInference(
-    LearningDataFrame* const learning_data_frame) {
-  const int past_points_size = learning_data_frame->adc_trajectory_point_size();
-  if (past_points_size == 0) {
-    AERROR << "No current trajectory point status";
+    const std::vector<LearningDataFrame*>& learning_data_frames) {
+  torch::Tensor input_feature_tensor;
+  if (!PrepareInputFeature(learning_data_frames, &input_feature_tensor)) {
     return false;
   }
 
-  auto input_renderering_start_time = std::chrono::system_clock::now();
-
-  cv::Mat input_feature;
-  if (!BirdviewImgFeatureRenderer::Instance()->RenderMultiChannelEnv(
-          *learning_data_frame, &input_feature)) {
-    AERROR << "Render multi-channel input image failed";
-    return false;
+  const int batch_size = static_cast<int>(learning_data_frames.size());
+  torch::Tensor current_v_tensor = torch::zeros({batch_size, 1});
+  for (int i = 0; i < batch_size; ++i) {
+    const auto& current_traj_point =
+        learning_data_frames[i]
+            ->adc_trajectory_point(
+                learning_data_frames[i]->adc_trajectory_point_size() - 1)
+            .trajectory_point();
+    current_v_tensor[i][0] = current_traj_point.v();
   }
 
-  auto input_renderering_end_time = std::chrono::system_clock::now();
-  std::chrono::duration<double> rendering_diff =
-      input_renderering_end_time - input_renderering_start_time;
-  ADEBUG << "trajectory imitation model input renderer used time: "
-         << rendering_diff.count() * 1000 << " ms.";
-
-  auto input_preprocessing_start_time = std::chrono::system_clock::now();
-
-  cv::Mat input_feature_float;
-  input_feature.convertTo(input_feature_float, CV_32F, 1.0 / 255);
-  torch::Tensor input_feature_tensor =
-      torch::from_blob(input_feature_float.data,
-                       {1, input_feature_float.rows, input_feature_float.cols,
-                        input_feature_float.channels()});
-  input_feature_tensor = input_feature_tensor.permute({0, 3, 1, 2});
-  for (int i = 0; i < input_feature_float.channels(); ++i) {
-    input_feature_tensor[0][i] = input_feature_tensor[0][i].sub(0.5).div(0.5);
-  }
-
-  const auto& current_traj_point =
-      learning_data_frame
-          ->adc_trajectory_point(
-              learning_data_frame->adc_trajectory_point_size() - 1)
-          .trajectory_point();
-
-  torch::Tensor current_v_tensor = torch::zeros({1, 1});
-  const double current_v = current_traj_point.v();
-  current_v_tensor[0][0] = current_v;
-
-  auto input_preprocessing_end_time = std::chrono::system_clock::now();
-  std::chrono::duration<double> preprocessing_diff =
-      input_preprocessing_end_time - input_preprocessing_start_time;
-  ADEBUG << "trajectory imitation model input preprocessing used time: "
-         << preprocessing_diff.count() * 1000 << " ms.";
-
   auto inference_start_time = std::chrono::system_clock::now();
 
   std::vector<torch::jit::IValue> torch_inputs;
-  torch_inputs.push_back(
-      c10::ivalue::Tuple::create({std::move(input_feature_tensor.to(device_)),
-                                  std::move(current_v_tensor.to(device_))}));
+  torch_inputs.push_back(c10::ivalue::Tuple::create(
+      {std::move(input_feature_tensor.to(device_, torch::kFloat32, true)),
+       std::move(current_v_tensor.to(device_))}));
   at::Tensor torch_output_tensor =
       model_.forward(torch_inputs).toTensor().to(torch::kCPU);
 
@@ -277,22 +284,33 @@ bool TrajectoryImitationLibtorchInference::DoCNNLSTMMODELInference(
   ADEBUG << "trajectory imitation model inference used time: "
          << inference_diff.count() * 1000 << " ms.";
 
-  output_postprocessing(torch_output_tensor, learning_data_frame);
+  for (int i = 0; i < batch_size; ++i) {
+    output_postprocessing(torch_output_tensor, i, learning_data_frames[i]);
+  }
 
   return true;
 }
 
 bool TrajectoryImitationLibtorchInference::DoInference(
     LearningDataFrame* const learning_data_frame) {
+  return DoBatchInference({learning_data_frame});
+}
+
+bool TrajectoryImitationLibtorchInference::DoBatchInference(
+    const std::vector<LearningDataFrame*>& learning_data_frames) {
+  if (learning_data_frames.empty()) {
+    AERROR << "No learning data frame to inference";
+    return false;
+  }
   switch (config_.model_type()) {
     case LearningModelInferenceTaskConfig::CNN: {
-      if (!DoCNNMODELInference(learning_data_frame)) {
+      if (!DoCNNMODELInference(learning_data_frames)) {
         return false;
       }
       break;
     }
     case LearningModelInferenceTaskConfig::CNN_LSTM: {
-      if (!DoCNNLSTMMODELInference(learning_data_frame)) {
+      if (!DoCNNLSTMMODELInference(learning_data_frames)) {
         return false;
       }
       break;
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "torch/extension.h"
 #include "torch/script.h"
@@ -60,6 +61,13 @@ class TrajectoryImitationLibtorchInference : public ModelInference {
    */
   bool DoInference(LearningDataFrame* const learning_data_frame) override;
 
+  /**
+   * @brief inference a learned model on a batch of frames in one forward pass
+   * @param learning_data_frames input and output intermediates for inference
+   */
+  bool DoBatchInference(
+      const std::vector<LearningDataFrame*>& learning_data_frames) override;
+
  private:
   /**
    * @brief load a CNN model
@@ -71,26 +79,44 @@ class TrajectoryImitationLibtorchInference : public ModelInference {
    */
   bool LoadCNNLSTMModel();
 
+  /**
+   * @brief render and normalize the birdview imgs of all frames into one
+   * NCHW tensor, frames are rendered in parallel
+   * @param learning_data_frames input intermediates for inference
+   * @param input_feature_tensor the batched input feature
+   */
+  bool PrepareInputFeature(
+      const std::vector<LearningDataFrame*>& learning_data_frames,
+      torch::Tensor* input_feature_tensor);
+
   /**
    * @brief inference a CNN model
-   * @param learning_data_frame input and output intermediate for inference
+   * @param learning_data_frames input and output intermediates for inference
    */
-  bool DoCNNMODELInference(LearningDataFrame* const learning_data_frame);
+  bool DoCNNMODELInference(
+      const std::vector<LearningDataFrame*>& learning_data_frames);
 
   /**
    * @brief inference a CNN_LSTM like model
-   * @param learning_data_frame input and output intermediate for inference
+   * @param learning_data_frames input and output intermediates for inference
    */
-  bool DoCNNLSTMMODELInference(LearningDataFrame* const learning_data_frame);
+  bool DoCNNLSTMMODELInference(
+      const std::vector<LearningDataFrame*>& learning_data_frames);
 
   /**
    * @brief postprocessing model trajectory output
+   * @param batch_index index of learning_data_frame in the batch
    */
   void output_postprocessing(const at::Tensor& torch_output_tensor,
+                             const int batch_index,
                              LearningDataFrame* const learning_data_frame);
 
   torch::jit::script::Module model_;
   torch::Device device_;
+
+  // host side NHWC input of the last batch, reused across cycles and pinned
+  // when the model runs on gpu so the copy to device is asynchronous
+  torch::Tensor input_feature_buffer_;
 };
 
 }  // namespace planning
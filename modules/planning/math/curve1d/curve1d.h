@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace apollo {
 namespace planning {
@@ -36,6 +38,16 @@ class Curve1d {
   virtual double Evaluate(const std::uint32_t order,
                           const double param) const = 0;
 
+  // Evaluate at every param into values, in the same order.
+  virtual void EvaluateBatch(const std::uint32_t order,
+                             const std::vector<double>& params,
+                             std::vector<double>* values) const {
+    values->resize(params.size());
+    for (std::size_t i = 0; i < params.size(); ++i) {
+      (*values)[i] = Evaluate(order, params[i]);
+    }
+  }
+
   virtual double ParamLength() const = 0;
 
   virtual std::string ToString() const = 0;
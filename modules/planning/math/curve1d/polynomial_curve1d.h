@@ -20,11 +20,92 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 #include "modules/planning/math/curve1d/curve1d.h"
 
 namespace apollo {
 namespace planning {
 
+// d^order/dp^order of p^power is PolynomialDerivativeFactor * p^(power-order)
+constexpr double PolynomialDerivativeFactor(const std::size_t power,
+                                            const std::uint32_t order) {
+  double factor = 1.0;
+  for (std::uint32_t k = 0; k < order; ++k) {
+    factor *= static_cast<double>(power - k);
+  }
+  return factor;
+}
+
+/**
+ * @brief Evaluate the kOrder-th derivative of sum(coef[i] * p^i) by Horner's
+ * rule. The degree and the order are fixed at compile time, so the loop is
+ * unrolled without any dispatch.
+ */
+template <std::uint32_t kOrder, std::size_t kNumCoef>
+inline double EvaluatePolynomial(const std::array<double, kNumCoef>& coef,
+                                 const double p) {
+  if (kOrder >= kNumCoef) {
+    return 0.0;
+  }
+  double value =
+      PolynomialDerivativeFactor(kNumCoef - 1, kOrder) * coef[kNumCoef - 1];
+  for (std::size_t i = kNumCoef - 1; i > kOrder; --i) {
+    value = value * p + PolynomialDerivativeFactor(i - 1, kOrder) * coef[i - 1];
+  }
+  return value;
+}
+
+/**
+ * @brief Evaluate the kOrder-th derivative at num_params params into values.
+ * The samples are independent, so the loop vectorizes.
+ */
+template <std::uint32_t kOrder, std::size_t kNumCoef>
+inline void EvaluatePolynomial(const std::array<double, kNumCoef>& coef,
+                               const double* params,
+                               const std::size_t num_params, double* values) {
+  for (std::size_t j = 0; j < num_params; ++j) {
+    values[j] = EvaluatePolynomial<kOrder>(coef, params[j]);
+  }
+}
+
+/**
+ * @brief Batch evaluation with the order chosen at run time, dispatched once
+ * for all the params.
+ */
+template <std::size_t kNumCoef>
+inline void EvaluatePolynomial(const std::array<double, kNumCoef>& coef,
+                               const std::uint32_t order, const double* params,
+                               const std::size_t num_params, double* values) {
+  switch (order) {
+    case 0:
+      EvaluatePolynomial<0>(coef, params, num_params, values);
+      break;
+    case 1:
+      EvaluatePolynomial<1>(coef, params, num_params, values);
+      break;
+    case 2:
+      EvaluatePolynomial<2>(coef, params, num_params, values);
+      break;
+    case 3:
+      EvaluatePolynomial<3>(coef, params, num_params, values);
+      break;
+    case 4:
+      EvaluatePolynomial<4>(coef, params, num_params, values);
+      break;
+    case 5:
+      EvaluatePolynomial<5>(coef, params, num_params, values);
+      break;
+    default:
+      for (std::size_t j = 0; j < num_params; ++j) {
+        values[j] = 0.0;
+      }
+      break;
+  }
+}
+
 class PolynomialCurve1d : public Curve1d {
  public:
   PolynomialCurve1d() = default;
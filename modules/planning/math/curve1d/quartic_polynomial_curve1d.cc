@@ -54,28 +54,29 @@ QuarticPolynomialCurve1d::QuarticPolynomialCurve1d(
 double QuarticPolynomialCurve1d::Evaluate(const std::uint32_t order,
                                           const double p) const {
   switch (order) {
-    case 0: {
-      return (((coef_[4] * p + coef_[3]) * p + coef_[2]) * p + coef_[1]) * p +
-             coef_[0];
-    }
-    case 1: {
-      return ((4.0 * coef_[4] * p + 3.0 * coef_[3]) * p + 2.0 * coef_[2]) * p +
-             coef_[1];
-    }
-    case 2: {
-      return (12.0 * coef_[4] * p + 6.0 * coef_[3]) * p + 2.0 * coef_[2];
-    }
-    case 3: {
-      return 24.0 * coef_[4] * p + 6.0 * coef_[3];
-    }
-    case 4: {
-      return 24.0 * coef_[4];
-    }
+    case 0:
+      return Evaluate<0>(p);
+    case 1:
+      return Evaluate<1>(p);
+    case 2:
+      return Evaluate<2>(p);
+    case 3:
+      return Evaluate<3>(p);
+    case 4:
+      return Evaluate<4>(p);
     default:
       return 0.0;
   }
 }
 
+void QuarticPolynomialCurve1d::EvaluateBatch(
+    const std::uint32_t order, const std::vector<double>& params,
+    std::vector<double>* values) const {
+  values->resize(params.size());
+  EvaluatePolynomial(coef_, order, params.data(), params.size(),
+                     values->data());
+}
+
 QuarticPolynomialCurve1d& QuarticPolynomialCurve1d::FitWithEndPointFirstOrder(
     const double x0, const double dx0, const double ddx0, const double x1,
     const double dx1, const double p) {
@@ -22,6 +22,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/polynomial_curve1d.h"
 
@@ -47,6 +48,16 @@ class QuarticPolynomialCurve1d : public PolynomialCurve1d {
 
   double Evaluate(const std::uint32_t order, const double p) const override;
 
+  // Evaluate with the order fixed at compile time
+  template <std::uint32_t kOrder>
+  double Evaluate(const double p) const {
+    return EvaluatePolynomial<kOrder>(coef_, p);
+  }
+
+  void EvaluateBatch(const std::uint32_t order,
+                     const std::vector<double>& params,
+                     std::vector<double>* values) const override;
+
   /**
    * Interface with refine quartic polynomial by meets end first order
    * and start second order boundary condition:
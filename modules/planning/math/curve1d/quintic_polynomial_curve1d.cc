@@ -55,37 +55,31 @@ QuinticPolynomialCurve1d::QuinticPolynomialCurve1d(
 double QuinticPolynomialCurve1d::Evaluate(const uint32_t order,
                                           const double p) const {
   switch (order) {
-    case 0: {
-      return ((((coef_[5] * p + coef_[4]) * p + coef_[3]) * p + coef_[2]) * p +
-              coef_[1]) *
-                 p +
-             coef_[0];
-    }
-    case 1: {
-      return (((5.0 * coef_[5] * p + 4.0 * coef_[4]) * p + 3.0 * coef_[3]) * p +
-              2.0 * coef_[2]) *
-                 p +
-             coef_[1];
-    }
-    case 2: {
-      return (((20.0 * coef_[5] * p + 12.0 * coef_[4]) * p) + 6.0 * coef_[3]) *
-                 p +
-             2.0 * coef_[2];
-    }
-    case 3: {
-      return (60.0 * coef_[5] * p + 24.0 * coef_[4]) * p + 6.0 * coef_[3];
-    }
-    case 4: {
-      return 120.0 * coef_[5] * p + 24.0 * coef_[4];
-    }
-    case 5: {
-      return 120.0 * coef_[5];
-    }
+    case 0:
+      return Evaluate<0>(p);
+    case 1:
+      return Evaluate<1>(p);
+    case 2:
+      return Evaluate<2>(p);
+    case 3:
+      return Evaluate<3>(p);
+    case 4:
+      return Evaluate<4>(p);
+    case 5:
+      return Evaluate<5>(p);
     default:
       return 0.0;
   }
 }
 
+void QuinticPolynomialCurve1d::EvaluateBatch(
+    const std::uint32_t order, const std::vector<double>& params,
+    std::vector<double>* values) const {
+  values->resize(params.size());
+  EvaluatePolynomial(coef_, order, params.data(), params.size(),
+                     values->data());
+}
+
 void QuinticPolynomialCurve1d::SetParam(const double x0, const double dx0,
                                         const double ddx0, const double x1,
                                         const double dx1, const double ddx1,
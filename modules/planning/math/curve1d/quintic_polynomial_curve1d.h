@@ -22,6 +22,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/polynomial_curve1d.h"
 
@@ -55,6 +56,16 @@ class QuinticPolynomialCurve1d : public PolynomialCurve1d {
 
   double Evaluate(const std::uint32_t order, const double p) const override;
 
+  // Evaluate with the order fixed at compile time
+  template <std::uint32_t kOrder>
+  double Evaluate(const double p) const {
+    return EvaluatePolynomial<kOrder>(coef_, p);
+  }
+
+  void EvaluateBatch(const std::uint32_t order,
+                     const std::vector<double>& params,
+                     std::vector<double>* values) const override;
+
   double ParamLength() const override { return param_; }
   std::string ToString() const override;
 
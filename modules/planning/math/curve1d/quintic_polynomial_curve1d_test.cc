@@ -16,6 +16,8 @@
 
 #include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 
@@ -70,5 +72,26 @@ TEST(QuinticPolynomialCurve1dTest, IntegratedFromQuarticCurve) {
                 quintic_curve.Evaluate(4, value), 1e-8);
   }
 }
+
+TEST(QuinticPolynomialCurve1dTest, EvaluateBatch) {
+  QuinticPolynomialCurve1d curve(0.0, 1.0, 0.8, 10.0, 5.0, 0.0, 8.0);
+  std::vector<double> params;
+  for (double value = 0.0; value < 8.1; value += 0.1) {
+    params.push_back(value);
+  }
+  for (std::uint32_t order = 0; order < 7; ++order) {
+    std::vector<double> values;
+    curve.EvaluateBatch(order, params, &values);
+    ASSERT_EQ(params.size(), values.size());
+    for (size_t i = 0; i < params.size(); ++i) {
+      EXPECT_DOUBLE_EQ(curve.Evaluate(order, params[i]), values[i]);
+    }
+  }
+  EXPECT_DOUBLE_EQ(curve.Evaluate(0, 3.0), curve.Evaluate<0>(3.0));
+  EXPECT_DOUBLE_EQ(curve.Evaluate(3, 3.0), curve.Evaluate<3>(3.0));
+  EXPECT_DOUBLE_EQ(curve.Evaluate(5, 3.0), curve.Evaluate<5>(3.0));
+  EXPECT_DOUBLE_EQ(0.0, curve.Evaluate<6>(3.0));
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -89,16 +89,16 @@ bool FemPosDeviationOsqpInterface::Solve() {
   settings->scaled_termination = scaled_termination_;
   settings->warm_start = warm_start_;
 
-  OSQPWorkspace* work = nullptr;
+  SolverPool::OsqpLease lease;
 
   bool res = OptimizeWithOsqp(num_of_variables_, lower_bounds.size(), &P_data,
                               &P_indices, &P_indptr, &A_data, &A_indices,
                               &A_indptr, &lower_bounds, &upper_bounds, &q,
-                              &primal_warm_start, data, &work, settings);
+                              &primal_warm_start, data, &lease, settings);
+  const OSQPWorkspace* work = lease.work();
   if (res == false || work == nullptr || work->solution == nullptr) {
     AERROR << "Failed to find solution.";
     // Cleanup
-    osqp_cleanup(work);
     c_free(data->A);
     c_free(data->P);
     c_free(data);
@@ -117,7 +117,6 @@ bool FemPosDeviationOsqpInterface::Solve() {
   }
 
   // Cleanup
-  osqp_cleanup(work);
   c_free(data->A);
   c_free(data->P);
   c_free(data);
@@ -257,7 +256,10 @@ void FemPosDeviationOsqpInterface::CalculateAffineConstraint(
 void FemPosDeviationOsqpInterface::SetPrimalWarmStart(
     std::vector<c_float>* primal_warm_start) {
   CHECK_EQ(ref_points_.size(), num_of_points_);
-  for (const auto& ref_point_xy : ref_points_) {
+  const auto& start_points = warm_start_points_.size() == ref_points_.size()
+                                 ? warm_start_points_
+                                 : ref_points_;
+  for (const auto& ref_point_xy : start_points) {
     primal_warm_start->push_back(ref_point_xy.first);
     primal_warm_start->push_back(ref_point_xy.second);
   }
@@ -270,7 +272,7 @@ bool FemPosDeviationOsqpInterface::OptimizeWithOsqp(
     std::vector<c_int>* A_indices, std::vector<c_int>* A_indptr,
     std::vector<c_float>* lower_bounds, std::vector<c_float>* upper_bounds,
     std::vector<c_float>* q, std::vector<c_float>* primal_warm_start,
-    OSQPData* data, OSQPWorkspace** work, OSQPSettings* settings) {
+    OSQPData* data, SolverPool::OsqpLease* lease, OSQPSettings* settings) {
   CHECK_EQ(lower_bounds->size(), upper_bounds->size());
 
   data->n = kernel_dim;
@@ -283,23 +285,28 @@ bool FemPosDeviationOsqpInterface::OptimizeWithOsqp(
   data->l = lower_bounds->data();
   data->u = upper_bounds->data();
 
-  *work = osqp_setup(data, settings);
-  // osqp_setup(work, data, settings);
+  *lease = SolverPool::Instance()->AcquireOsqp("FemPosDeviationOsqpInterface",
+                                               *data, *settings);
+  OSQPWorkspace* work = lease->work();
+  if (work == nullptr) {
+    AERROR << "failed to setup osqp workspace";
+    return false;
+  }
 
-  osqp_warm_start_x(*work, primal_warm_start->data());
+  osqp_warm_start_x(work, primal_warm_start->data());
 
   // Solve Problem
-  osqp_solve(*work);
+  lease->Solve();
 
-  auto status = (*work)->info->status_val;
+  auto status = work->info->status_val;
 
   if (status < 0) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work->info->status;
     return false;
   }
 
   if (status != 1 && status != 2) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work->info->status;
     return false;
   }
 
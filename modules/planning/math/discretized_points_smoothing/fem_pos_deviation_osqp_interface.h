@@ -25,6 +25,8 @@
 
 #include "osqp/osqp.h"
 
+#include "modules/planning/math/solver_pool.h"
+
 namespace apollo {
 namespace planning {
 
@@ -43,6 +45,13 @@ class FemPosDeviationOsqpInterface {
     bounds_around_refs_ = bounds_around_refs;
   }
 
+  // Starting points of the solver, the reference points if not set or of a
+  // different size
+  void set_warm_start_points(
+      const std::vector<std::pair<double, double>>& warm_start_points) {
+    warm_start_points_ = warm_start_points;
+  }
+
   void set_weight_fem_pos_deviation(const double weight_fem_pos_deviation) {
     weight_fem_pos_deviation_ = weight_fem_pos_deviation;
   }
@@ -95,12 +104,13 @@ class FemPosDeviationOsqpInterface {
       std::vector<c_int>* A_indices, std::vector<c_int>* A_indptr,
       std::vector<c_float>* lower_bounds, std::vector<c_float>* upper_bounds,
       std::vector<c_float>* q, std::vector<c_float>* primal_warm_start,
-      OSQPData* data, OSQPWorkspace** work, OSQPSettings* settings);
+      OSQPData* data, SolverPool::OsqpLease* lease, OSQPSettings* settings);
 
  private:
   // Reference points and deviation bounds
   std::vector<std::pair<double, double>> ref_points_;
   std::vector<double> bounds_around_refs_;
+  std::vector<std::pair<double, double>> warm_start_points_;
 
   // Weights in optimization cost function
   double weight_fem_pos_deviation_ = 1.0e5;
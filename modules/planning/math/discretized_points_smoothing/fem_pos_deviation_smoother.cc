@@ -20,16 +20,29 @@
 
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_smoother.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <coin/IpIpoptApplication.hpp>
 #include <coin/IpSolveStatistics.hpp>
 
 #include "cyber/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_ipopt_interface.h"
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_osqp_interface.h"
 #include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_sqp_osqp_interface.h"
 
 namespace apollo {
 namespace planning {
+namespace {
+
+// how far a raw point may have moved for the previous result to be a warm
+// start, and how many previous results are kept
+constexpr double kMaxWarmStartPointShift = 0.2;
+constexpr size_t kMaxNumOfWarmStartSolutions = 4;
+
+}  // namespace
+
 FemPosDeviationSmoother::FemPosDeviationSmoother(
     const FemPosDeviationSmootherConfig& config)
     : config_(config) {}
@@ -73,6 +86,10 @@ bool FemPosDeviationSmoother::QpWithOsqp(
 
   solver.set_ref_points(raw_point2d);
   solver.set_bounds_around_refs(bounds);
+  std::vector<std::pair<double, double>> warm_start_points;
+  if (FindWarmStartPoints(raw_point2d, bounds, &warm_start_points)) {
+    solver.set_warm_start_points(warm_start_points);
+  }
 
   if (!solver.Solve()) {
     return false;
@@ -80,6 +97,7 @@ bool FemPosDeviationSmoother::QpWithOsqp(
 
   *opt_x = solver.opt_x();
   *opt_y = solver.opt_y();
+  RecordSolution(raw_point2d, *opt_x, *opt_y);
   return true;
 }
 
@@ -115,12 +133,16 @@ bool FemPosDeviationSmoother::SqpWithOsqp(
 
   solver.set_ref_points(raw_point2d);
   solver.set_bounds_around_refs(bounds);
+  std::vector<std::pair<double, double>> warm_start_points;
+  if (FindWarmStartPoints(raw_point2d, bounds, &warm_start_points)) {
+    solver.set_warm_start_points(warm_start_points);
+  }
 
   if (!solver.Solve()) {
     return false;
   }
 
-  std::vector<std::pair<double, double>> opt_xy = solver.opt_xy();
+  const std::vector<std::pair<double, double>>& opt_xy = solver.opt_xy();
 
   // TODO(Jinyun): unify output data container
   opt_x->resize(opt_xy.size());
@@ -129,6 +151,7 @@ bool FemPosDeviationSmoother::SqpWithOsqp(
     (*opt_x)[i] = opt_xy[i].first;
     (*opt_y)[i] = opt_xy[i].second;
   }
+  RecordSolution(raw_point2d, *opt_x, *opt_y);
   return true;
 }
 
@@ -187,5 +210,68 @@ bool FemPosDeviationSmoother::NlpWithIpopt(
   return true;
 }
 
+bool FemPosDeviationSmoother::FindWarmStartPoints(
+    const std::vector<std::pair<double, double>>& raw_point2d,
+    const std::vector<double>& bounds,
+    std::vector<std::pair<double, double>>* warm_start_points) const {
+  if (!FLAGS_enable_fem_pos_warm_start ||
+      raw_point2d.size() != bounds.size()) {
+    return false;
+  }
+  for (const auto& solution : solutions_) {
+    const auto& prev_raw_points = solution.raw_points;
+    if (prev_raw_points.size() != raw_point2d.size()) {
+      continue;
+    }
+    bool is_nearby = true;
+    for (size_t i = 0; i < raw_point2d.size(); ++i) {
+      if (std::fabs(raw_point2d[i].first - prev_raw_points[i].first) >
+              kMaxWarmStartPointShift ||
+          std::fabs(raw_point2d[i].second - prev_raw_points[i].second) >
+              kMaxWarmStartPointShift) {
+        is_nearby = false;
+        break;
+      }
+    }
+    if (!is_nearby) {
+      continue;
+    }
+    const auto& prev_opt_points = solution.opt_points;
+    warm_start_points->resize(raw_point2d.size());
+    for (size_t i = 0; i < raw_point2d.size(); ++i) {
+      const double bound = bounds[i];
+      const double dx = std::max(
+          -bound,
+          std::min(bound, prev_opt_points[i].first - prev_raw_points[i].first));
+      const double dy = std::max(
+          -bound, std::min(bound, prev_opt_points[i].second -
+                                      prev_raw_points[i].second));
+      (*warm_start_points)[i] = std::make_pair(raw_point2d[i].first + dx,
+                                               raw_point2d[i].second + dy);
+    }
+    return true;
+  }
+  return false;
+}
+
+void FemPosDeviationSmoother::RecordSolution(
+    const std::vector<std::pair<double, double>>& raw_point2d,
+    const std::vector<double>& opt_x, const std::vector<double>& opt_y) {
+  if (!FLAGS_enable_fem_pos_warm_start || opt_x.size() != raw_point2d.size() ||
+      opt_y.size() != raw_point2d.size()) {
+    return;
+  }
+  SmoothedPoints solution;
+  solution.raw_points = raw_point2d;
+  solution.opt_points.reserve(opt_x.size());
+  for (size_t i = 0; i < opt_x.size(); ++i) {
+    solution.opt_points.emplace_back(opt_x[i], opt_y[i]);
+  }
+  solutions_.push_front(std::move(solution));
+  if (solutions_.size() > kMaxNumOfWarmStartSolutions) {
+    solutions_.pop_back();
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
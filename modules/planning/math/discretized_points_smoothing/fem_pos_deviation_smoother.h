@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <list>
 #include <utility>
 #include <vector>
 
@@ -65,7 +66,27 @@ class FemPosDeviationSmoother {
                    std::vector<double>* opt_x, std::vector<double>* opt_y);
 
  private:
+  struct SmoothedPoints {
+    std::vector<std::pair<double, double>> raw_points;
+    std::vector<std::pair<double, double>> opt_points;
+  };
+
+  // With FLAGS_enable_fem_pos_warm_start, the offsets of a previous result
+  // from its raw points, applied to raw_point2d if each raw point moved
+  // little since then
+  bool FindWarmStartPoints(
+      const std::vector<std::pair<double, double>>& raw_point2d,
+      const std::vector<double>& bounds,
+      std::vector<std::pair<double, double>>* warm_start_points) const;
+
+  void RecordSolution(const std::vector<std::pair<double, double>>& raw_point2d,
+                      const std::vector<double>& opt_x,
+                      const std::vector<double>& opt_y);
+
   FemPosDeviationSmootherConfig config_;
+
+  // most recent first
+  std::list<SmoothedPoints> solutions_;
 };
 }  // namespace planning
 }  // namespace apollo
@@ -61,9 +61,13 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
   num_of_constraints_ =
       num_of_variable_constraints_ + num_of_curvature_constraints_;
 
-  // Set primal warm start
+  // Set primal warm start, which is also the first linearization point
+  const auto& start_points = warm_start_points_.size() == ref_points_.size()
+                                 ? warm_start_points_
+                                 : ref_points_;
+  slack_.assign(num_of_slack_variables_, 0.0);
   std::vector<c_float> primal_warm_start;
-  SetPrimalWarmStart(ref_points_, &primal_warm_start);
+  SetPrimalWarmStart(start_points, &primal_warm_start);
 
   // Calculate kernel
   std::vector<c_float> P_data;
@@ -81,7 +85,7 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
   std::vector<c_int> A_indptr;
   std::vector<c_float> lower_bounds;
   std::vector<c_float> upper_bounds;
-  CalculateAffineConstraint(ref_points_, &A_data, &A_indices, &A_indptr,
+  CalculateAffineConstraint(start_points, &A_data, &A_indices, &A_indptr,
                             &lower_bounds, &upper_bounds);
 
   // Load matrices and vectors into OSQPData
@@ -111,17 +115,18 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
   settings->eps_prim_inf = 1e-5;
   settings->eps_dual_inf = 1e-5;
 
-  // Define osqp workspace
-  OSQPWorkspace* work = nullptr;
-  // osqp_setup(&work, data, settings);
-  work = osqp_setup(data, settings);
+  // Define osqp workspace, the sparsity of P and A stays the same through
+  // the sequential solution, only their values and the bounds are updated
+  SolverPool::OsqpLease lease = SolverPool::Instance()->AcquireOsqp(
+      "FemPosDeviationSqpOsqpInterface", *data, *settings);
+  OSQPWorkspace* work = lease.work();
 
   // Initial solution
-  bool initial_solve_res = OptimizeWithOsqp(primal_warm_start, &work);
+  bool initial_solve_res =
+      work != nullptr && OptimizeWithOsqp(primal_warm_start, &lease);
 
   if (!initial_solve_res) {
     AERROR << "initial iteration solving fails";
-    osqp_cleanup(work);
     c_free(data->A);
     c_free(data->P);
     c_free(data);
@@ -149,12 +154,11 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
       osqp_update_A(work, A_data.data(), OSQP_NULL, A_data.size());
       osqp_update_bounds(work, lower_bounds.data(), upper_bounds.data());
 
-      bool iterative_solve_res = OptimizeWithOsqp(primal_warm_start, &work);
+      bool iterative_solve_res = OptimizeWithOsqp(primal_warm_start, &lease);
       if (!iterative_solve_res) {
         AERROR << "iteration at " << sub_itr
                << ", solving fails with max sub iter " << sqp_sub_max_iter_;
         weight_curvature_constraint_slack_var_ = original_slack_penalty;
-        osqp_cleanup(work);
         c_free(data->A);
         c_free(data->P);
         c_free(data);
@@ -180,7 +184,6 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
     if (!fconverged) {
       AERROR << "Max number of iteration reached";
       weight_curvature_constraint_slack_var_ = original_slack_penalty;
-      osqp_cleanup(work);
       c_free(data->A);
       c_free(data->P);
       c_free(data);
@@ -197,7 +200,6 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
       ADEBUG << "constraint voilation value drops to " << ctol
              << ", under max_ctol " << sqp_ctol_;
       weight_curvature_constraint_slack_var_ = original_slack_penalty;
-      osqp_cleanup(work);
       c_free(data->A);
       c_free(data->P);
       c_free(data);
@@ -213,7 +215,6 @@ bool FemPosDeviationSqpOsqpInterface::Solve() {
   ADEBUG << "constraint voilation value drops to " << ctol
          << ", higher than max_ctol " << sqp_ctol_;
   weight_curvature_constraint_slack_var_ = original_slack_penalty;
-  osqp_cleanup(work);
   c_free(data->A);
   c_free(data->P);
   c_free(data);
@@ -412,6 +413,11 @@ void FemPosDeviationSqpOsqpInterface::CalculateAffineConstraint(
                                     lin_cache[i][1] * scale_factor);
   }
 
+  // rebuilt for every linearization, osqp_update_A takes all the values in
+  // the same order
+  A_data->clear();
+  A_indices->clear();
+  A_indptr->clear();
   int ind_a = 0;
   for (int i = 0; i < num_of_variables_; ++i) {
     A_indptr->push_back(ind_a);
@@ -482,21 +488,23 @@ void FemPosDeviationSqpOsqpInterface::SetPrimalWarmStart(
 }
 
 bool FemPosDeviationSqpOsqpInterface::OptimizeWithOsqp(
-    const std::vector<c_float>& primal_warm_start, OSQPWorkspace** work) {
-  osqp_warm_start_x(*work, primal_warm_start.data());
+    const std::vector<c_float>& primal_warm_start,
+    SolverPool::OsqpLease* lease) {
+  OSQPWorkspace* work = lease->work();
+  osqp_warm_start_x(work, primal_warm_start.data());
 
   // Solve Problem
-  osqp_solve(*work);
+  lease->Solve();
 
-  auto status = (*work)->info->status_val;
+  auto status = work->info->status_val;
 
   if (status < 0) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work->info->status;
     return false;
   }
 
   if (status != 1 && status != 2) {
-    AERROR << "failed optimization status:\t" << (*work)->info->status;
+    AERROR << "failed optimization status:\t" << work->info->status;
     return false;
   }
 
@@ -505,12 +513,12 @@ bool FemPosDeviationSqpOsqpInterface::OptimizeWithOsqp(
   slack_.resize(num_of_slack_variables_);
   for (int i = 0; i < num_of_points_; ++i) {
     int index = i * 2;
-    opt_xy_.at(i) = std::make_pair((*work)->solution->x[index],
-                                   (*work)->solution->x[index + 1]);
+    opt_xy_.at(i) = std::make_pair(work->solution->x[index],
+                                   work->solution->x[index + 1]);
   }
 
   for (int i = 0; i < num_of_slack_variables_; ++i) {
-    slack_.at(i) = (*work)->solution->x[num_of_pos_variables_ + i];
+    slack_.at(i) = work->solution->x[num_of_pos_variables_ + i];
   }
 
   return true;
@@ -25,6 +25,8 @@
 
 #include "osqp/osqp.h"
 
+#include "modules/planning/math/solver_pool.h"
+
 namespace apollo {
 namespace planning {
 
@@ -43,6 +45,13 @@ class FemPosDeviationSqpOsqpInterface {
     bounds_around_refs_ = bounds_around_refs;
   }
 
+  // Starting points of the solver, the reference points if not set or of a
+  // different size
+  void set_warm_start_points(
+      const std::vector<std::pair<double, double>>& warm_start_points) {
+    warm_start_points_ = warm_start_points;
+  }
+
   void set_weight_fem_pos_deviation(const double weight_fem_pos_deviation) {
     weight_fem_pos_deviation_ = weight_fem_pos_deviation;
   }
@@ -115,7 +124,7 @@ class FemPosDeviationSqpOsqpInterface {
                           std::vector<c_float>* primal_warm_start);
 
   bool OptimizeWithOsqp(const std::vector<c_float>& primal_warm_start,
-                        OSQPWorkspace** work);
+                        SolverPool::OsqpLease* lease);
 
   double CalculateConstraintViolation(
       const std::vector<std::pair<double, double>>& points);
@@ -124,6 +133,7 @@ class FemPosDeviationSqpOsqpInterface {
   // Init states and constraints
   std::vector<std::pair<double, double>> ref_points_;
   std::vector<double> bounds_around_refs_;
+  std::vector<std::pair<double, double>> warm_start_points_;
   double curvature_constraint_ = 0.2;
 
   // Weights in optimization cost function
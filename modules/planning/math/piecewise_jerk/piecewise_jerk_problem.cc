@@ -16,8 +16,13 @@
 
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 #include "cyber/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/math/solver_pool.h"
 
 namespace apollo {
 namespace planning {
@@ -87,31 +92,155 @@ OSQPData* PiecewiseJerkProblem::FormulateProblem() {
   return data;
 }
 
+PiecewiseJerkWorkspace::~PiecewiseJerkWorkspace() { Reset(); }
+
+void PiecewiseJerkWorkspace::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  P_indices_.clear();
+  P_indptr_.clear();
+  A_indices_.clear();
+  A_indptr_.clear();
+  has_solution_ = false;
+  primal_.clear();
+  dual_.clear();
+}
+
 bool PiecewiseJerkProblem::Optimize(const int max_iter) {
+  if (workspace_ != nullptr) {
+    return OptimizeWithWorkspace(max_iter);
+  }
+
   OSQPData* data = FormulateProblem();
 
   OSQPSettings* settings = SolverDefaultSettings();
   settings->max_iter = max_iter;
 
-  OSQPWorkspace* osqp_work = nullptr;
-  osqp_work = osqp_setup(data, settings);
-  // osqp_setup(&osqp_work, data, settings);
+  auto lease = SolverPool::Instance()->AcquireOsqp("PiecewiseJerkProblem",
+                                                   *data, *settings);
+  bool success = false;
+  if (lease.work() != nullptr) {
+    lease.Solve();
+    success = ExtractSolution(lease.work());
+  }
 
-  osqp_solve(osqp_work);
+  // Cleanup
+  FreeData(data);
+  c_free(settings);
+  return success;
+}
 
+bool PiecewiseJerkProblem::OptimizeWithWorkspace(const int max_iter) {
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  std::vector<c_float> lower_bounds;
+  std::vector<c_float> upper_bounds;
+  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
+                            &upper_bounds);
+
+  std::vector<c_float> q;
+  CalculateOffset(&q);
+
+  CHECK_EQ(lower_bounds.size(), upper_bounds.size());
+  const size_t kernel_dim = 3 * num_of_knots_;
+  const size_t num_affine_constraint = lower_bounds.size();
+
+  auto* workspace = workspace_;
+  const bool same_structure = workspace->work_ != nullptr &&
+                              workspace->P_indices_ == P_indices &&
+                              workspace->P_indptr_ == P_indptr &&
+                              workspace->A_indices_ == A_indices &&
+                              workspace->A_indptr_ == A_indptr;
+  if (same_structure) {
+    // only the values changed, keep the symbolic factorization
+    osqp_update_P_A(workspace->work_, P_data.data(), OSQP_NULL,
+                    static_cast<c_int>(P_data.size()), A_data.data(),
+                    OSQP_NULL, static_cast<c_int>(A_data.size()));
+    osqp_update_lin_cost(workspace->work_, q.data());
+    osqp_update_bounds(workspace->work_, lower_bounds.data(),
+                       upper_bounds.data());
+    osqp_update_max_iter(workspace->work_, max_iter);
+  } else {
+    workspace->Reset();
+
+    // osqp_setup copies the data, the matrices only wrap the vectors
+    OSQPData data;
+    data.n = kernel_dim;
+    data.m = num_affine_constraint;
+    data.P = csc_matrix(kernel_dim, kernel_dim, P_data.size(), P_data.data(),
+                        P_indices.data(), P_indptr.data());
+    data.q = q.data();
+    data.A = csc_matrix(num_affine_constraint, kernel_dim, A_data.size(),
+                        A_data.data(), A_indices.data(), A_indptr.data());
+    data.l = lower_bounds.data();
+    data.u = upper_bounds.data();
+
+    OSQPSettings* settings = SolverDefaultSettings();
+    settings->max_iter = max_iter;
+    workspace->work_ = osqp_setup(&data, settings);
+    c_free(data.P);
+    c_free(data.A);
+    c_free(settings);
+    if (workspace->work_ == nullptr) {
+      AERROR << "failed to setup osqp workspace";
+      return false;
+    }
+    workspace->P_indices_ = std::move(P_indices);
+    workspace->P_indptr_ = std::move(P_indptr);
+    workspace->A_indices_ = std::move(A_indices);
+    workspace->A_indptr_ = std::move(A_indptr);
+  }
+
+  // start from the previous solution moved to the current first knot, or
+  // from zero as a cold start does
+  std::vector<c_float> primal(kernel_dim, 0.0);
+  std::vector<c_float> dual(num_affine_constraint, 0.0);
+  if (same_structure && workspace->has_solution_ &&
+      workspace->delta_s_ == delta_s_) {
+    const double shift = (origin_ - workspace->origin_) / delta_s_;
+    if (shift > -0.5 && shift < static_cast<double>(num_of_knots_) - 0.5) {
+      primal = workspace->primal_;
+      dual = workspace->dual_;
+      ShiftWarmStart(static_cast<size_t>(std::round(shift)), &primal, &dual);
+    }
+  }
+  osqp_warm_start(workspace->work_, primal.data(), dual.data());
+
+  const auto solve_start = std::chrono::steady_clock::now();
+  osqp_solve(workspace->work_);
+  const std::chrono::duration<double, std::milli> solve_time =
+      std::chrono::steady_clock::now() - solve_start;
+
+  workspace->has_solution_ = ExtractSolution(workspace->work_);
+  SolverPool::Instance()->RecordSolve(
+      "PiecewiseJerkProblem", solve_time.count(), workspace->work_->info->iter,
+      workspace->has_solution_);
+  if (workspace->has_solution_) {
+    const auto* solution = workspace->work_->solution;
+    workspace->primal_.assign(solution->x, solution->x + kernel_dim);
+    workspace->dual_.assign(solution->y, solution->y + num_affine_constraint);
+    workspace->origin_ = origin_;
+    workspace->delta_s_ = delta_s_;
+  }
+  return workspace->has_solution_;
+}
+
+bool PiecewiseJerkProblem::ExtractSolution(const OSQPWorkspace* osqp_work) {
   auto status = osqp_work->info->status_val;
 
   if (status < 0 || (status != 1 && status != 2)) {
     AERROR << "failed optimization status:\t" << osqp_work->info->status;
-    osqp_cleanup(osqp_work);
-    FreeData(data);
-    c_free(settings);
     return false;
   } else if (osqp_work->solution == nullptr) {
     AERROR << "The solution from OSQP is nullptr";
-    osqp_cleanup(osqp_work);
-    FreeData(data);
-    c_free(settings);
     return false;
   }
 
@@ -125,14 +254,39 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
     ddx_.at(i) =
         osqp_work->solution->x[i + 2 * num_of_knots_] / scale_factor_[2];
   }
-
-  // Cleanup
-  osqp_cleanup(osqp_work);
-  FreeData(data);
-  c_free(settings);
   return true;
 }
 
+void PiecewiseJerkProblem::ShiftWarmStart(const size_t num_of_shift,
+                                          std::vector<c_float>* primal,
+                                          std::vector<c_float>* dual) const {
+  if (num_of_shift == 0) {
+    return;
+  }
+  auto shift_block = [num_of_shift](c_float* block, const size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      block[i] = block[std::min(i + num_of_shift, size - 1)];
+    }
+  };
+
+  // variables are x, x', x'' of all knots, one block each
+  const size_t n = num_of_knots_;
+  for (size_t i = 0; i < 3; ++i) {
+    shift_block(primal->data() + i * n, n);
+  }
+
+  // constraints are the 3 variable bounds, the 3 knot to knot constraints
+  // and the x_init constraints laid out by CalculateAffineConstraint
+  if (dual->size() != 3 * n + 3 * (n - 1) + 3) {
+    std::fill(dual->begin(), dual->end(), 0.0);
+    return;
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    shift_block(dual->data() + i * n, n);
+    shift_block(dual->data() + 3 * n + i * (n - 1), n - 1);
+  }
+}
+
 void PiecewiseJerkProblem::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
     std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
@@ -24,11 +24,47 @@
 #include <utility>
 #include <vector>
 
+#include "cyber/common/macros.h"
 #include "osqp/osqp.h"
 
 namespace apollo {
 namespace planning {
 
+/*
+ * @brief:
+ * OSQP workspace kept by the caller across planning cycles. When the next
+ * problem has the same sparsity pattern, the workspace is updated in place,
+ * which reuses the symbolic factorization, and warm started from the
+ * previous solution.
+ */
+class PiecewiseJerkWorkspace {
+ public:
+  PiecewiseJerkWorkspace() = default;
+
+  ~PiecewiseJerkWorkspace();
+
+  void Reset();
+
+ private:
+  friend class PiecewiseJerkProblem;
+
+  OSQPWorkspace* work_ = nullptr;
+
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+
+  // last solution in solver variables, with the position of its first knot
+  bool has_solution_ = false;
+  std::vector<c_float> primal_;
+  std::vector<c_float> dual_;
+  double origin_ = 0.0;
+  double delta_s_ = 0.0;
+
+  DISALLOW_COPY_AND_ASSIGN(PiecewiseJerkWorkspace);
+};
+
 /*
  * @brief:
  * This class solve an optimization problem:
@@ -108,6 +144,18 @@ class PiecewiseJerkProblem {
   void set_end_state_ref(const std::array<double, 3>& weight_end_state,
                          const std::array<double, 3>& end_state_ref);
 
+  /**
+   * @brief Solve in a workspace that outlives the problem.
+   *
+   * @param workspace: the workspace of the previous cycles
+   * @param origin: position of the first knot, the previous solution is
+   * shifted by the difference of the origins to warm start the solver
+   */
+  void set_workspace(PiecewiseJerkWorkspace* workspace, const double origin) {
+    workspace_ = workspace;
+    origin_ = origin;
+  }
+
   virtual bool Optimize(const int max_iter = 4000);
 
   const std::vector<double>& opt_x() const { return x_; }
@@ -132,6 +180,18 @@ class PiecewiseJerkProblem {
 
   virtual OSQPSettings* SolverDefaultSettings();
 
+  /**
+   * @brief Move the previous solution num_of_shift knots forward, the last
+   * knot is repeated.
+   */
+  virtual void ShiftWarmStart(const size_t num_of_shift,
+                              std::vector<c_float>* primal,
+                              std::vector<c_float>* dual) const;
+
+  bool OptimizeWithWorkspace(const int max_iter);
+
+  bool ExtractSolution(const OSQPWorkspace* osqp_work);
+
   OSQPData* FormulateProblem();
 
   void FreeData(OSQPData* data);
@@ -175,6 +235,9 @@ class PiecewiseJerkProblem {
   bool has_end_state_ref_ = false;
   std::array<double, 3> weight_end_state_ = {{0.0, 0.0, 0.0}};
   std::array<double, 3> end_state_ref_;
+
+  PiecewiseJerkWorkspace* workspace_ = nullptr;
+  double origin_ = 0.0;
 };
 
 }  // namespace planning
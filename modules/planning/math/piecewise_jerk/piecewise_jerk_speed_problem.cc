@@ -157,5 +157,16 @@ OSQPSettings* PiecewiseJerkSpeedProblem::SolverDefaultSettings() {
   return settings;
 }
 
+void PiecewiseJerkSpeedProblem::ShiftWarmStart(
+    const size_t num_of_shift, std::vector<c_float>* primal,
+    std::vector<c_float>* dual) const {
+  PiecewiseJerkProblem::ShiftWarmStart(num_of_shift, primal, dual);
+  // s is measured from the start point of each cycle
+  const c_float start_s = primal->front();
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    (*primal)[i] -= start_s;
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -66,6 +66,9 @@ class PiecewiseJerkSpeedProblem : public PiecewiseJerkProblem {
 
   OSQPSettings* SolverDefaultSettings() override;
 
+  void ShiftWarmStart(const size_t num_of_shift, std::vector<c_float>* primal,
+                      std::vector<c_float>* dual) const override;
+
   bool has_dx_ref_ = false;
   double weight_dx_ref_ = 0.0;
   double dx_ref_ = 0.0;
@@ -23,6 +23,7 @@
 #include "cyber/common/log.h"
 #include "modules/common/math/matrix_operations.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/math/solver_pool.h"
 
 namespace apollo {
 namespace planning {
@@ -144,12 +145,20 @@ bool OsqpSpline2dSolver::Solve() {
   settings->verbose = FLAGS_enable_osqp_debug;
 
   // Setup workspace
-  OSQPWorkspace* work = nullptr;
-  work = osqp_setup(data, settings);
-  // osqp_setup(&work, data, settings);
+  auto lease = SolverPool::Instance()->AcquireOsqp("OsqpSpline2dSolver",
+                                                   *data, *settings);
+  OSQPWorkspace* work = lease.work();
+  if (work == nullptr) {
+    AERROR << "failed to setup osqp workspace";
+    c_free(data->A);
+    c_free(data->P);
+    c_free(data);
+    c_free(settings);
+    return false;
+  }
 
   // Solve Problem
-  osqp_solve(work);
+  lease.Solve();
 
   MatrixXd solved_params = MatrixXd::Zero(P.rows(), 1);
   for (int i = 0; i < P.rows(); ++i) {
@@ -160,7 +169,6 @@ bool OsqpSpline2dSolver::Solve() {
   last_num_constraint_ = static_cast<int>(constraint_num);
 
   // Cleanup
-  osqp_cleanup(work);
   c_free(data->A);
   c_free(data->P);
   c_free(data);
@@ -0,0 +1,305 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/solver_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+
+#include "cyber/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+double NowMs() {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::vector<c_int> Copy(const c_int* begin, const c_int size) {
+  return std::vector<c_int>(begin, begin + size);
+}
+
+bool SamePattern(const std::vector<c_int>& pattern, const c_int* begin,
+                 const c_int size) {
+  return static_cast<c_int>(pattern.size()) == size &&
+         std::equal(pattern.begin(), pattern.end(), begin);
+}
+
+// the settings osqp can not change on an existing workspace
+bool SameFixedSettings(const OSQPSettings& a, const OSQPSettings& b) {
+  return a.sigma == b.sigma && a.scaling == b.scaling &&
+         a.adaptive_rho == b.adaptive_rho &&
+         a.adaptive_rho_interval == b.adaptive_rho_interval &&
+         a.adaptive_rho_tolerance == b.adaptive_rho_tolerance &&
+         a.linsys_solver == b.linsys_solver;
+}
+
+}  // namespace
+
+struct SolverPool::OsqpEntry {
+  ~OsqpEntry() {
+    if (work != nullptr) {
+      osqp_cleanup(work);
+    }
+  }
+
+  bool Matches(const OSQPData& data, const OSQPSettings& settings) const {
+    return n == data.n && m == data.m &&
+           SamePattern(P_indptr, data.P->p, data.n + 1) &&
+           SamePattern(P_indices, data.P->i, data.P->p[data.n]) &&
+           SamePattern(A_indptr, data.A->p, data.n + 1) &&
+           SamePattern(A_indices, data.A->i, data.A->p[data.n]) &&
+           SameFixedSettings(setup_settings, settings);
+  }
+
+  std::string name;
+  OSQPWorkspace* work = nullptr;
+  // reusable only if osqp kept P as given, i.e. P was upper triangular
+  bool reusable = false;
+
+  c_int n = 0;
+  c_int m = 0;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  OSQPSettings setup_settings;
+};
+
+SolverPool::SolverPool() {}
+
+SolverPool::OsqpLease::OsqpLease() = default;
+
+SolverPool::OsqpLease::OsqpLease(OsqpLease&& other) = default;
+
+SolverPool::OsqpLease& SolverPool::OsqpLease::operator=(OsqpLease&& other) {
+  if (this != &other) {
+    Release();
+    name_ = std::move(other.name_);
+    entry_ = std::move(other.entry_);
+  }
+  return *this;
+}
+
+SolverPool::OsqpLease::~OsqpLease() { Release(); }
+
+OSQPWorkspace* SolverPool::OsqpLease::work() const {
+  return entry_ == nullptr ? nullptr : entry_->work;
+}
+
+bool SolverPool::OsqpLease::Solve() {
+  OSQPWorkspace* work = this->work();
+  if (work == nullptr) {
+    AERROR << "no osqp workspace to solve " << name_;
+    return false;
+  }
+  const double start_ms = NowMs();
+  osqp_solve(work);
+  const bool success = work->info->status_val == OSQP_SOLVED ||
+                       work->info->status_val == OSQP_SOLVED_INACCURATE;
+  SolverPool::Instance()->RecordSolve(name_, NowMs() - start_ms,
+                                      work->info->iter, success);
+  return success;
+}
+
+void SolverPool::OsqpLease::Release() {
+  if (entry_ != nullptr) {
+    SolverPool::Instance()->Release(std::move(entry_));
+  }
+}
+
+SolverPool::OsqpLease SolverPool::AcquireOsqp(const std::string& name,
+                                              const OSQPData& data,
+                                              const OSQPSettings& settings) {
+  const double start_ms = NowMs();
+  OSQPSettings tuned_settings = settings;
+  OsqpLease lease;
+  lease.name_ = name;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto tuning = tunings_.find(name);
+    if (tuning != tunings_.end()) {
+      const SolverTuning& t = tuning->second;
+      if (t.eps_abs > 0.0) {
+        tuned_settings.eps_abs = t.eps_abs;
+      }
+      if (t.eps_rel > 0.0) {
+        tuned_settings.eps_rel = t.eps_rel;
+      }
+      if (t.time_limit > 0.0) {
+        tuned_settings.time_limit = t.time_limit;
+      }
+      if (t.max_iter > 0) {
+        tuned_settings.max_iter = t.max_iter;
+      }
+    }
+    if (FLAGS_enable_solver_pool) {
+      auto it = std::find_if(
+          idle_entries_.begin(), idle_entries_.end(),
+          [&](const std::unique_ptr<OsqpEntry>& entry) {
+            return entry->name == name && entry->Matches(data, tuned_settings);
+          });
+      if (it != idle_entries_.end()) {
+        lease.entry_ = std::move(*it);
+        idle_entries_.erase(it);
+      }
+    }
+  }
+
+  const bool reused = lease.entry_ != nullptr;
+  if (reused) {
+    OSQPWorkspace* work = lease.entry_->work;
+    osqp_update_P_A(work, data.P->x, OSQP_NULL, data.P->p[data.n], data.A->x,
+                    OSQP_NULL, data.A->p[data.n]);
+    osqp_update_lin_cost(work, data.q);
+    osqp_update_bounds(work, data.l, data.u);
+    if (work->settings->rho != tuned_settings.rho) {
+      osqp_update_rho(work, tuned_settings.rho);
+    }
+    osqp_update_max_iter(work, tuned_settings.max_iter);
+    osqp_update_eps_abs(work, tuned_settings.eps_abs);
+    osqp_update_eps_rel(work, tuned_settings.eps_rel);
+    osqp_update_eps_prim_inf(work, tuned_settings.eps_prim_inf);
+    osqp_update_eps_dual_inf(work, tuned_settings.eps_dual_inf);
+    osqp_update_alpha(work, tuned_settings.alpha);
+    osqp_update_delta(work, tuned_settings.delta);
+    osqp_update_polish(work, tuned_settings.polish);
+    osqp_update_polish_refine_iter(work, tuned_settings.polish_refine_iter);
+    osqp_update_verbose(work, tuned_settings.verbose);
+    osqp_update_scaled_termination(work, tuned_settings.scaled_termination);
+    osqp_update_check_termination(work, tuned_settings.check_termination);
+    osqp_update_warm_start(work, tuned_settings.warm_start);
+    osqp_update_time_limit(work, tuned_settings.time_limit);
+    // start where a fresh workspace starts
+    const std::vector<c_float> x(data.n, 0.0);
+    const std::vector<c_float> y(data.m, 0.0);
+    osqp_warm_start(work, x.data(), y.data());
+  } else {
+    lease.entry_.reset(new OsqpEntry());
+    OsqpEntry* entry = lease.entry_.get();
+    entry->name = name;
+    entry->work = osqp_setup(&data, &tuned_settings);
+    if (entry->work != nullptr && FLAGS_enable_solver_pool) {
+      entry->n = data.n;
+      entry->m = data.m;
+      entry->P_indptr = Copy(data.P->p, data.n + 1);
+      entry->P_indices = Copy(data.P->i, data.P->p[data.n]);
+      entry->A_indptr = Copy(data.A->p, data.n + 1);
+      entry->A_indices = Copy(data.A->i, data.A->p[data.n]);
+      entry->setup_settings = tuned_settings;
+      entry->reusable =
+          entry->work->data->P->p[data.n] == data.P->p[data.n];
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  SolverStats& stats = stats_[name];
+  stats.total_setup_time_ms += NowMs() - start_ms;
+  if (!reused) {
+    ++stats.num_setups;
+  }
+  return lease;
+}
+
+void SolverPool::Release(std::unique_ptr<OsqpEntry> entry) {
+  if (!FLAGS_enable_solver_pool || !entry->reusable ||
+      FLAGS_solver_pool_capacity <= 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  idle_entries_.push_back(std::move(entry));
+  while (idle_entries_.size() >
+         static_cast<size_t>(FLAGS_solver_pool_capacity)) {
+    idle_entries_.pop_front();
+  }
+}
+
+void SolverPool::RecordSolve(const std::string& name,
+                             const double solve_time_ms,
+                             const int64_t iterations, const bool success) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SolverStats& stats = stats_[name];
+  ++stats.num_solves;
+  if (!success) {
+    ++stats.num_failures;
+  }
+  stats.total_iterations += iterations;
+  stats.total_solve_time_ms += solve_time_ms;
+  stats.max_solve_time_ms = std::max(stats.max_solve_time_ms, solve_time_ms);
+}
+
+void SolverPool::SetTuning(const std::string& name,
+                           const SolverTuning& tuning) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  tunings_[name] = tuning;
+}
+
+bool SolverPool::GetStats(const std::string& name, SolverStats* stats) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = stats_.find(name);
+  if (it == stats_.end()) {
+    return false;
+  }
+  *stats = it->second;
+  return true;
+}
+
+std::string SolverPool::DebugString() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string debug;
+  for (const auto& item : stats_) {
+    const SolverStats& stats = item.second;
+    const double num_solves =
+        static_cast<double>(std::max<int64_t>(stats.num_solves, 1));
+    absl::StrAppend(&debug, item.first, ": solves ", stats.num_solves,
+                    " setups ", stats.num_setups, " failures ",
+                    stats.num_failures, " avg iterations ",
+                    static_cast<double>(stats.total_iterations) / num_solves,
+                    " avg setup ms ", stats.total_setup_time_ms / num_solves,
+                    " avg solve ms ", stats.total_solve_time_ms / num_solves,
+                    " max solve ms ", stats.max_solve_time_ms, "\n");
+  }
+  return debug;
+}
+
+void SolverPool::Clear() {
+  std::list<std::unique_ptr<OsqpEntry>> idle_entries;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_entries.swap(idle_entries_);
+    stats_.clear();
+  }
+}
+
+size_t SolverPool::NumIdleWorkspaces() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_entries_.size();
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Planning wide pool of OSQP workspaces with per solver statistics
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "osqp/osqp.h"
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class SolverPool
+ * @brief Hands out OSQP workspaces by solver name. With
+ * FLAGS_enable_solver_pool a released workspace is kept, and a later problem
+ * of the same solver name, dimension and sparsity updates it in place
+ * instead of running osqp_setup again, which saves the allocations and the
+ * symbolic factorization. Without the flag every lease is a plain setup and
+ * cleanup. Solve times and iterations are recorded per solver name either
+ * way.
+ */
+class SolverPool {
+ public:
+  struct SolverStats {
+    int64_t num_solves = 0;
+    // solves that had to set a workspace up instead of reusing one
+    int64_t num_setups = 0;
+    int64_t num_failures = 0;
+    int64_t total_iterations = 0;
+    double total_setup_time_ms = 0.0;
+    double total_solve_time_ms = 0.0;
+    double max_solve_time_ms = 0.0;
+  };
+
+  /**
+   * @brief overrides of the settings the callers pass, zero keeps the
+   * caller's value
+   */
+  struct SolverTuning {
+    double eps_abs = 0.0;
+    double eps_rel = 0.0;
+    double time_limit = 0.0;
+    int max_iter = 0;
+  };
+
+  struct OsqpEntry;
+
+  /**
+   * @class OsqpLease
+   * @brief Exclusive use of a workspace, which goes back to the pool when
+   * the lease is destroyed.
+   */
+  class OsqpLease {
+   public:
+    OsqpLease();
+    OsqpLease(OsqpLease&& other);
+    OsqpLease& operator=(OsqpLease&& other);
+    ~OsqpLease();
+
+    /**
+     * @brief nullptr if osqp_setup failed
+     */
+    OSQPWorkspace* work() const;
+
+    /**
+     * @brief osqp_solve, recording time, iterations and status of the solve
+     * under the name of the lease
+     * @return false if there is no workspace or the problem is not solved
+     * (status other than solved or solved inaccurate)
+     */
+    bool Solve();
+
+   private:
+    friend class SolverPool;
+
+    void Release();
+
+    std::string name_;
+    std::unique_ptr<OsqpEntry> entry_;
+  };
+
+  /**
+   * @brief a workspace holding data and settings. The data pointers are
+   * copied from and need to live only during this call. When the workspace
+   * is reused, x and y start from zero as after osqp_setup.
+   */
+  OsqpLease AcquireOsqp(const std::string& name, const OSQPData& data,
+                        const OSQPSettings& settings);
+
+  /**
+   * @brief stats of solvers not going through OsqpLease, e.g. IPOPT
+   */
+  void RecordSolve(const std::string& name, const double solve_time_ms,
+                   const int64_t iterations, const bool success);
+
+  void SetTuning(const std::string& name, const SolverTuning& tuning);
+
+  bool GetStats(const std::string& name, SolverStats* stats) const;
+
+  std::string DebugString() const;
+
+  /**
+   * @brief frees the idle workspaces and drops the stats
+   */
+  void Clear();
+
+  size_t NumIdleWorkspaces() const;
+
+ private:
+  void Release(std::unique_ptr<OsqpEntry> entry);
+
+  mutable std::mutex mutex_;
+  // least recently released first
+  std::list<std::unique_ptr<OsqpEntry>> idle_entries_;
+  std::unordered_map<std::string, SolverStats> stats_;
+  std::unordered_map<std::string, SolverTuning> tunings_;
+
+  DECLARE_SINGLETON(SolverPool)
+};
+
+}  // namespace planning
+}  // namespace apollo
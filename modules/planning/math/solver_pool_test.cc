@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/math/solver_pool.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// min 0.5 * (x^2 + y^2) - x - y, s.t. 0 <= x <= upper_x, 0 <= y <= 2
+class BoxQp {
+ public:
+  explicit BoxQp(const double upper_x) {
+    P_data_ = {1.0, 1.0};
+    P_indices_ = {0, 1};
+    P_indptr_ = {0, 1, 2};
+    A_data_ = {1.0, 1.0};
+    A_indices_ = {0, 1};
+    A_indptr_ = {0, 1, 2};
+    q_ = {-1.0, -1.0};
+    l_ = {0.0, 0.0};
+    u_ = {upper_x, 2.0};
+
+    data_.n = 2;
+    data_.m = 2;
+    data_.P = csc_matrix(2, 2, 2, P_data_.data(), P_indices_.data(),
+                         P_indptr_.data());
+    data_.A = csc_matrix(2, 2, 2, A_data_.data(), A_indices_.data(),
+                         A_indptr_.data());
+    data_.q = q_.data();
+    data_.l = l_.data();
+    data_.u = u_.data();
+
+    osqp_set_default_settings(&settings_);
+    settings_.polish = true;
+    settings_.verbose = false;
+  }
+
+  ~BoxQp() {
+    c_free(data_.P);
+    c_free(data_.A);
+  }
+
+  const OSQPData& data() const { return data_; }
+  const OSQPSettings& settings() const { return settings_; }
+
+ private:
+  std::vector<c_float> P_data_;
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_float> A_data_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+  std::vector<c_float> q_;
+  std::vector<c_float> l_;
+  std::vector<c_float> u_;
+  OSQPData data_;
+  OSQPSettings settings_;
+};
+
+}  // namespace
+
+class SolverPoolTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_solver_pool = true;
+    SolverPool::Instance()->Clear();
+  }
+
+  void TearDown() override {
+    SolverPool::Instance()->Clear();
+    FLAGS_enable_solver_pool = false;
+  }
+};
+
+TEST_F(SolverPoolTest, ReuseWorkspace) {
+  auto* pool = SolverPool::Instance();
+  {
+    BoxQp qp(0.5);
+    auto lease = pool->AcquireOsqp("box_qp", qp.data(), qp.settings());
+    ASSERT_NE(lease.work(), nullptr);
+    EXPECT_TRUE(lease.Solve());
+    EXPECT_NEAR(lease.work()->solution->x[0], 0.5, 1.0e-3);
+    EXPECT_NEAR(lease.work()->solution->x[1], 1.0, 1.0e-3);
+  }
+  EXPECT_EQ(pool->NumIdleWorkspaces(), 1U);
+
+  {
+    // same sparsity, the values of the first problem must not leak in
+    BoxQp qp(2.0);
+    auto lease = pool->AcquireOsqp("box_qp", qp.data(), qp.settings());
+    ASSERT_NE(lease.work(), nullptr);
+    EXPECT_EQ(pool->NumIdleWorkspaces(), 0U);
+    EXPECT_TRUE(lease.Solve());
+    EXPECT_NEAR(lease.work()->solution->x[0], 1.0, 1.0e-3);
+    EXPECT_NEAR(lease.work()->solution->x[1], 1.0, 1.0e-3);
+  }
+
+  SolverPool::SolverStats stats;
+  ASSERT_TRUE(pool->GetStats("box_qp", &stats));
+  EXPECT_EQ(stats.num_solves, 2);
+  EXPECT_EQ(stats.num_setups, 1);
+  EXPECT_EQ(stats.num_failures, 0);
+  EXPECT_GT(stats.total_iterations, 0);
+}
+
+TEST_F(SolverPoolTest, NoReuseAcrossNames) {
+  auto* pool = SolverPool::Instance();
+  BoxQp qp(0.5);
+  { auto lease = pool->AcquireOsqp("box_qp", qp.data(), qp.settings()); }
+  { auto lease = pool->AcquireOsqp("other_qp", qp.data(), qp.settings()); }
+  EXPECT_EQ(pool->NumIdleWorkspaces(), 2U);
+
+  SolverPool::SolverStats stats;
+  ASSERT_TRUE(pool->GetStats("other_qp", &stats));
+  EXPECT_EQ(stats.num_setups, 1);
+  EXPECT_EQ(stats.num_solves, 0);
+}
+
+TEST_F(SolverPoolTest, Disabled) {
+  FLAGS_enable_solver_pool = false;
+  auto* pool = SolverPool::Instance();
+  BoxQp qp(0.5);
+  {
+    auto lease = pool->AcquireOsqp("box_qp", qp.data(), qp.settings());
+    EXPECT_TRUE(lease.Solve());
+  }
+  EXPECT_EQ(pool->NumIdleWorkspaces(), 0U);
+}
+
+TEST_F(SolverPoolTest, Tuning) {
+  auto* pool = SolverPool::Instance();
+  SolverPool::SolverTuning tuning;
+  tuning.max_iter = 7;
+  pool->SetTuning("box_qp", tuning);
+  BoxQp qp(0.5);
+  auto lease = pool->AcquireOsqp("box_qp", qp.data(), qp.settings());
+  ASSERT_NE(lease.work(), nullptr);
+  EXPECT_EQ(lease.work()->settings->max_iter, 7);
+  pool->SetTuning("box_qp", SolverPool::SolverTuning());
+}
+
+}  // namespace planning
+}  // namespace apollo
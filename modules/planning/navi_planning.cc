@@ -561,6 +561,8 @@ Status NaviPlanning::Plan(
     ADEBUG << last_publishable_trajectory_->TrajectoryPointAt(i)
                   .ShortDebugString();
   }
+  // the next cycle matches its stitching point by time on this trajectory
+  last_publishable_trajectory_->BuildTimeIndex();
 
   last_publishable_trajectory_->PopulateTrajectoryProtobuf(trajectory_pb);
 
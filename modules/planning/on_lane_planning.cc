@@ -33,6 +33,7 @@
 #include "modules/planning/common/history.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/common/trajectory_stitcher.h"
 #include "modules/planning/common/util/util.h"
 #include "modules/planning/learning_based/img_feature_renderer/birdview_img_feature_renderer.h"
@@ -296,7 +297,11 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
 
   injector_->ego_info()->Update(stitching_trajectory.back(), vehicle_state);
   const uint32_t frame_num = static_cast<uint32_t>(seq_num_++);
-  status = InitFrame(frame_num, stitching_trajectory.back(), vehicle_state);
+  PlanningProfiler::Instance()->BeginCycle(frame_num);
+  {
+    PLANNING_PROFILE_SCOPE("InitFrame");
+    status = InitFrame(frame_num, stitching_trajectory.back(), vehicle_state);
+  }
 
   if (status.ok()) {
     injector_->ego_info()->CalculateFrontObstacleClearDistance(
@@ -333,12 +338,16 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
     ptr_trajectory_pb->set_gear(canbus::Chassis::GEAR_DRIVE);
     FillPlanningPb(start_timestamp, ptr_trajectory_pb);
     frame_->set_current_frame_planned_trajectory(*ptr_trajectory_pb);
+    ADEBUG << "frame arena allocations: "
+           << frame_->arena().num_allocations()
+           << ", bytes: " << frame_->arena().allocated_bytes();
     const uint32_t n = frame_->SequenceNum();
     injector_->frame_history()->Add(n, std::move(frame_));
     return;
   }
 
   for (auto& ref_line_info : *frame_->mutable_reference_line_info()) {
+    PLANNING_PROFILE_SCOPE("TrafficDecider");
     TrafficDecider traffic_decider;
     traffic_decider.Init(traffic_rule_configs_);
     auto traffic_status =
@@ -364,6 +373,8 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
   ADEBUG << "total planning time spend: " << time_diff_ms << " ms.";
 
   ptr_trajectory_pb->mutable_latency_stats()->set_total_time_ms(time_diff_ms);
+  PlanningProfiler::Instance()->EndCycle(
+      ptr_trajectory_pb->mutable_latency_stats());
   ADEBUG << "Planning latency: "
          << ptr_trajectory_pb->latency_stats().DebugString();
 
@@ -387,6 +398,8 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
   }
 
   if (frame_->open_space_info().is_on_open_space_trajectory()) {
+    ptr_trajectory_pb->mutable_latency_stats()->MergeFrom(
+        frame_->open_space_info().latency_stats());
     FillPlanningPb(start_timestamp, ptr_trajectory_pb);
     ADEBUG << "Planning pb:" << ptr_trajectory_pb->header().DebugString();
     frame_->set_current_frame_planned_trajectory(*ptr_trajectory_pb);
@@ -408,6 +421,8 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
     }
   }
 
+  ADEBUG << "frame arena allocations: " << frame_->arena().num_allocations()
+         << ", bytes: " << frame_->arena().allocated_bytes();
   const uint32_t n = frame_->SequenceNum();
   injector_->frame_history()->Add(n, std::move(frame_));
 }
@@ -488,6 +503,7 @@ Status OnLanePlanning::Plan(
     const double current_time_stamp,
     const std::vector<TrajectoryPoint>& stitching_trajectory,
     ADCTrajectory* const ptr_trajectory_pb) {
+  PLANNING_PROFILE_SCOPE("Plan");
   auto* ptr_debug = ptr_trajectory_pb->mutable_debug();
   if (FLAGS_enable_record_debug) {
     ptr_debug->mutable_planning_data()->mutable_init_point()->CopyFrom(
@@ -634,6 +650,8 @@ Status OnLanePlanning::Plan(
     last_publishable_trajectory_->PrependTrajectoryPoints(
         std::vector<TrajectoryPoint>(stitching_trajectory.begin(),
                                      stitching_trajectory.end() - 1));
+    // the next cycle matches its stitching point by time on this trajectory
+    last_publishable_trajectory_->BuildTimeIndex();
 
     last_publishable_trajectory_->PopulateTrajectoryProtobuf(ptr_trajectory_pb);
 
@@ -173,15 +173,22 @@ bool GridSearch::GenerateDpMap(
     const double ex, const double ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
+  XYbounds_ = XYbounds;
+  // XYbounds with xmin, xmax, ymin, ymax
+  max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
+  max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
+  // replanning towards the same end point keeps the heuristic while the
+  // roi and obstacles stay exactly the same
+  if (IsDpMapReusable(ex, ey, XYbounds, obstacles_linesegments_vec)) {
+    ADEBUG << "reuse dp map";
+    return true;
+  }
   std::priority_queue<std::pair<std::string, double>,
                       std::vector<std::pair<std::string, double>>, cmp>
       open_pq;
   std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
   dp_map_ = decltype(dp_map_)();
-  XYbounds_ = XYbounds;
-  // XYbounds with xmin, xmax, ymin, ymax
-  max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
-  max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
+  has_dp_map_ = false;
   std::shared_ptr<Node2d> end_node =
       std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
   obstacles_linesegments_vec_ = obstacles_linesegments_vec;
@@ -218,6 +225,36 @@ bool GridSearch::GenerateDpMap(
     }
   }
   ADEBUG << "explored node num is " << explored_node_num;
+  has_dp_map_ = true;
+  dp_map_ex_ = ex;
+  dp_map_ey_ = ey;
+  dp_map_XYbounds_ = XYbounds;
+  dp_map_obstacles_ = obstacles_linesegments_vec;
+  return true;
+}
+
+bool GridSearch::IsDpMapReusable(
+    const double ex, const double ey, const std::vector<double>& XYbounds,
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) const {
+  if (!has_dp_map_ || ex != dp_map_ex_ || ey != dp_map_ey_ ||
+      XYbounds != dp_map_XYbounds_ ||
+      obstacles_linesegments_vec.size() != dp_map_obstacles_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < obstacles_linesegments_vec.size(); ++i) {
+    const auto& linesegments = obstacles_linesegments_vec[i];
+    const auto& dp_map_linesegments = dp_map_obstacles_[i];
+    if (linesegments.size() != dp_map_linesegments.size()) {
+      return false;
+    }
+    for (size_t j = 0; j < linesegments.size(); ++j) {
+      if (!(linesegments[j].start() == dp_map_linesegments[j].start()) ||
+          !(linesegments[j].end() == dp_map_linesegments[j].end())) {
+        return false;
+      }
+    }
+  }
   return true;
 }
 
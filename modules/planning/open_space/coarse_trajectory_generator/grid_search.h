@@ -118,6 +118,11 @@ class GridSearch {
   double CheckDpMap(const double sx, const double sy);
 
  private:
+  // whether dp_map_ was generated from the same end point and environment
+  bool IsDpMapReusable(
+      const double ex, const double ey, const std::vector<double>& XYbounds,
+      const std::vector<std::vector<common::math::LineSegment2d>>&
+          obstacles_linesegments_vec) const;
   double EuclidDistance(const double x1, const double y1, const double x2,
                         const double y2);
   std::vector<std::shared_ptr<Node2d>> GenerateNextNodes(
@@ -144,6 +149,12 @@ class GridSearch {
     }
   };
   std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  // inputs of the last generated dp_map_
+  bool has_dp_map_ = false;
+  double dp_map_ex_ = 0.0;
+  double dp_map_ey_ = 0.0;
+  std::vector<double> dp_map_XYbounds_;
+  std::vector<std::vector<common::math::LineSegment2d>> dp_map_obstacles_;
 };
 }  // namespace planning
 }  // namespace apollo
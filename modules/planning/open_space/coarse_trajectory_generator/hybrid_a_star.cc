@@ -20,6 +20,9 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/hybrid_a_star.h"
 
+#include <future>
+
+#include "cyber/task/task.h"
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_speed_problem.h"
 
 namespace apollo {
@@ -74,11 +77,44 @@ bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
   return true;
 }
 
+bool HybridAStar::ExpandInParallel(
+    std::shared_ptr<Node3d> current_node,
+    std::vector<std::shared_ptr<Node3d>>* next_nodes) {
+  std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
+      std::make_shared<ReedSheppPath>();
+  auto analytic_expansion =
+      cyber::Async([this, &current_node, &reeds_shepp_to_check]() {
+        return reed_shepp_generator_->ShortestRSP(current_node, end_node_,
+                                                  reeds_shepp_to_check) &&
+               RSPCheck(reeds_shepp_to_check);
+      });
+  std::vector<std::future<std::shared_ptr<Node3d>>> results;
+  for (size_t i = 0; i < next_node_num_; ++i) {
+    results.push_back(cyber::Async([this, &current_node, i]() {
+      std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
+      if (next_node == nullptr || !ValidityCheck(next_node)) {
+        return std::shared_ptr<Node3d>();
+      }
+      return next_node;
+    }));
+  }
+  for (auto& result : results) {
+    next_nodes->push_back(result.get());
+  }
+  if (!analytic_expansion.get()) {
+    return false;
+  }
+
+  ADEBUG << "Reach the end configuration with Reed Sharp";
+  final_node_ = LoadRSPinCS(reeds_shepp_to_check, current_node);
+  return true;
+}
+
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
+  std::shared_ptr<Node3d> node = node_pool_.MakeNode(
       reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+      XYbounds_, planner_open_space_config_);
   return ValidityCheck(node);
 }
 
@@ -130,9 +166,9 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
 std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
     std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
+  std::shared_ptr<Node3d> end_node = node_pool_.MakeNode(
       reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+      XYbounds_, planner_open_space_config_);
   end_node->SetPre(current_node);
   close_set_.emplace(end_node->GetIndex(), end_node);
   return end_node;
@@ -188,9 +224,9 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
       intermediate_y.back() < XYbounds_[2]) {
     return nullptr;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
+  std::shared_ptr<Node3d> next_node =
+      node_pool_.MakeNode(intermediate_x, intermediate_y, intermediate_phi,
+                          XYbounds_, planner_open_space_config_);
   next_node->SetPre(current_node);
   next_node->SetDirec(traveled_distance > 0.0);
   next_node->SetSteer(steering);
@@ -694,14 +730,22 @@ bool HybridAStar::Plan(
     // configuration to the end configuration without collision. if so, search
     // ends.
     const double rs_start_time = Clock::NowInSeconds();
-    if (AnalyticExpansion(current_node)) {
+    std::vector<std::shared_ptr<Node3d>> next_nodes;
+    if (FLAGS_enable_parallel_hybrid_a_star_expansion) {
+      if (ExpandInParallel(current_node, &next_nodes)) {
+        break;
+      }
+    } else if (AnalyticExpansion(current_node)) {
       break;
     }
     const double rs_end_time = Clock::NowInSeconds();
     rs_time += rs_end_time - rs_start_time;
     close_set_.emplace(current_node->GetIndex(), current_node);
     for (size_t i = 0; i < next_node_num_; ++i) {
-      std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
+      std::shared_ptr<Node3d> next_node =
+          FLAGS_enable_parallel_hybrid_a_star_expansion
+              ? next_nodes[i]
+              : Next_node_generator(current_node, i);
       // boundary check failure handle
       if (next_node == nullptr) {
         continue;
@@ -710,8 +754,9 @@ bool HybridAStar::Plan(
       if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
         continue;
       }
-      // collision check
-      if (!ValidityCheck(next_node)) {
+      // collision check, already done by the parallel expansion
+      if (!FLAGS_enable_parallel_hybrid_a_star_expansion &&
+          !ValidityCheck(next_node)) {
         continue;
       }
       if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
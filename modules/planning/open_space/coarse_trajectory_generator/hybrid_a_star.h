@@ -68,6 +68,10 @@ class HybridAStar {
 
  private:
   bool AnalyticExpansion(std::shared_ptr<Node3d> current_node);
+  // run the analytic expansion of current_node in parallel with generating
+  // and collision checking its next nodes, the invalid ones left nullptr
+  bool ExpandInParallel(std::shared_ptr<Node3d> current_node,
+                        std::vector<std::shared_ptr<Node3d>>* next_nodes);
   // check collision and validity
   bool ValidityCheck(std::shared_ptr<Node3d> node);
   // check Reeds Shepp path collision and validity
@@ -127,6 +131,7 @@ class HybridAStar {
   std::unordered_map<std::string, std::shared_ptr<Node3d>> close_set_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
+  Node3dPool node_pool_;
 };
 
 }  // namespace planning
@@ -20,6 +20,8 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 
+#include <cstddef>
+
 #include "absl/strings/str_cat.h"
 
 namespace apollo {
@@ -113,5 +115,44 @@ std::string Node3d::ComputeStringIndex(int x_grid, int y_grid, int phi_grid) {
   return absl::StrCat(x_grid, "_", y_grid, "_", phi_grid);
 }
 
+Node3dPool::Arena::~Arena() {
+  for (char* chunk : chunks_) {
+    delete[] chunk;
+  }
+}
+
+void* Node3dPool::Arena::Allocate(const size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (block_size_ == 0) {
+    // all the blocks are of the first requested size, which is the node
+    // with its control block
+    constexpr size_t kAlignment = alignof(std::max_align_t);
+    block_size_ = (size + kAlignment - 1) / kAlignment * kAlignment;
+  }
+  if (size > block_size_) {
+    return ::operator new(size);
+  }
+  if (free_head_ != nullptr) {
+    void* block = free_head_;
+    free_head_ = *static_cast<void**>(block);
+    return block;
+  }
+  if (num_chunk_blocks_used_ == kBlocksPerChunk) {
+    chunks_.push_back(new char[block_size_ * kBlocksPerChunk]);
+    num_chunk_blocks_used_ = 0;
+  }
+  return chunks_.back() + block_size_ * num_chunk_blocks_used_++;
+}
+
+void Node3dPool::Arena::Deallocate(void* block, const size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size > block_size_) {
+    ::operator delete(block);
+    return;
+  }
+  *static_cast<void**>(block) = free_head_;
+  free_head_ = block;
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -21,7 +21,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "modules/common/math/box2d.h"
@@ -94,5 +96,67 @@ class Node3d {
   bool direction_ = true;
 };
 
+/**
+ * @class Node3dPool
+ * @brief Allocates nodes together with their shared_ptr control block from
+ * chunks kept by the pool, so that the blocks of released nodes are reused by
+ * the following searches instead of going back to the heap.
+ */
+class Node3dPool {
+ public:
+  template <typename... Args>
+  std::shared_ptr<Node3d> MakeNode(Args&&... args) {
+    return std::allocate_shared<Node3d>(Allocator<Node3d>(arena_),
+                                        std::forward<Args>(args)...);
+  }
+
+ private:
+  class Arena {
+   public:
+    ~Arena();
+    void* Allocate(const size_t size);
+    void Deallocate(void* block, const size_t size);
+
+   private:
+    static constexpr size_t kBlocksPerChunk = 1024;
+
+    std::mutex mutex_;
+    size_t block_size_ = 0;
+    std::vector<char*> chunks_;
+    size_t num_chunk_blocks_used_ = kBlocksPerChunk;
+    void* free_head_ = nullptr;
+  };
+
+  // shares the arena, which stays alive until the last node is released
+  template <typename T>
+  struct Allocator {
+    using value_type = T;
+
+    explicit Allocator(const std::shared_ptr<Arena>& arena) : arena(arena) {}
+    template <typename U>
+    Allocator(const Allocator<U>& other)  // NOLINT
+        : arena(other.arena) {}
+
+    T* allocate(const size_t n) {
+      return static_cast<T*>(arena->Allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, const size_t n) {
+      arena->Deallocate(p, n * sizeof(T));
+    }
+    template <typename U>
+    bool operator==(const Allocator<U>& other) const {
+      return arena == other.arena;
+    }
+    template <typename U>
+    bool operator!=(const Allocator<U>& other) const {
+      return arena != other.arena;
+    }
+
+    std::shared_ptr<Arena> arena;
+  };
+
+  std::shared_ptr<Arena> arena_ = std::make_shared<Arena>();
+};
+
 }  // namespace planning
 }  // namespace apollo
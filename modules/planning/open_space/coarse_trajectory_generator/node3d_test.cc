@@ -60,5 +60,21 @@ TEST_F(Node3dTest, GetBoundingBox) {
   ASSERT_EQ(test_box.width(), gold_box.width());
 }
 
+TEST(Node3dPoolTest, MakeNode) {
+  std::shared_ptr<Node3d> node;
+  {
+    Node3dPool pool;
+    std::shared_ptr<Node3d> pre_node = pool.MakeNode(1.0, 2.0, 0.5);
+    node = pool.MakeNode(3.0, 4.0, 1.0);
+    node->SetPre(pre_node);
+    pre_node.reset();
+  }
+  // nodes stay valid after the pool is gone
+  ASSERT_EQ(node->GetX(), 3.0);
+  ASSERT_EQ(node->GetPhi(), 1.0);
+  ASSERT_NE(node->GetPreNode(), nullptr);
+  ASSERT_EQ(node->GetPreNode()->GetY(), 2.0);
+}
+
 }  // namespace planning
 }  // namespace apollo
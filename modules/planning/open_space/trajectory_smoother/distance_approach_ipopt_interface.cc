@@ -1119,17 +1119,28 @@ bool DistanceApproachIPOPTInterface::eval_jac_g_ser(int n, const double* x,
     // 4. Three obstacles related equal constraints, one equality constraints,
     // [0, horizon_] * [0, obstacles_num_-1] * 4
 
-    state_index = state_start_index_;
+    // Every time step owns a fixed run of (4 * edges + 13) nonzeros per
+    // obstacle, so the offsets are known up front and the steps are filled
+    // independently.
+    const int obstacles_nz_start = nz_index;
+    const int obstacles_nz_per_step =
+        4 * obstacles_edges_sum_ + 13 * obstacles_num_;
     int l_index = l_start_index_;
     int n_index = n_start_index_;
 
+#pragma omp parallel for schedule(static) \
+    if (FLAGS_enable_parallel_distance_approach_jacobian)
     for (int i = 0; i < horizon_ + 1; ++i) {
+      int nz = obstacles_nz_start + i * obstacles_nz_per_step;
+      const int x_index = state_start_index_ + 4 * i;
+      int l_offset = l_start_index_ + i * obstacles_edges_sum_;
+      int n_offset = n_start_index_ + i * 4 * obstacles_num_;
       int edges_counter = 0;
       for (int j = 0; j < obstacles_num_; ++j) {
         int current_edges_num = obstacles_edges_num_(j, 0);
-        Eigen::MatrixXd Aj =
+        const auto Aj =
             obstacles_A_.block(edges_counter, 0, current_edges_num, 2);
-        Eigen::MatrixXd bj =
+        const auto bj =
             obstacles_b_.block(edges_counter, 0, current_edges_num, 1);
 
         // TODO(QiL) : Remove redundant calculation
@@ -1137,105 +1148,101 @@ bool DistanceApproachIPOPTInterface::eval_jac_g_ser(int n, const double* x,
         double tmp2 = 0;
         for (int k = 0; k < current_edges_num; ++k) {
           // TODO(QiL) : replace this one directly with x
-          tmp1 += Aj(k, 0) * x[l_index + k];
-          tmp2 += Aj(k, 1) * x[l_index + k];
+          tmp1 += Aj(k, 0) * x[l_offset + k];
+          tmp2 += Aj(k, 1) * x[l_offset + k];
         }
 
         // 1. norm(A* lambda == 1)
         for (int k = 0; k < current_edges_num; ++k) {
           // with respect to l
-          values[nz_index] =
-              2 * tmp1 * Aj(k, 0) + 2 * tmp2 * Aj(k, 1);  // t0~tk
-          ++nz_index;
+          values[nz] = 2 * tmp1 * Aj(k, 0) + 2 * tmp2 * Aj(k, 1);  // t0~tk
+          ++nz;
         }
 
         // 2. G' * mu + R' * lambda == 0, part 1
         // With respect to x
-        values[nz_index] = -std::sin(x[state_index + 2]) * tmp1 +
-                           std::cos(x[state_index + 2]) * tmp2;  // u
-        ++nz_index;
+        values[nz] = -std::sin(x[x_index + 2]) * tmp1 +
+                     std::cos(x[x_index + 2]) * tmp2;  // u
+        ++nz;
 
         // with respect to l
         for (int k = 0; k < current_edges_num; ++k) {
-          values[nz_index] = std::cos(x[state_index + 2]) * Aj(k, 0) +
-                             std::sin(x[state_index + 2]) * Aj(k, 1);  // v0~vn
-          ++nz_index;
+          values[nz] = std::cos(x[x_index + 2]) * Aj(k, 0) +
+                       std::sin(x[x_index + 2]) * Aj(k, 1);  // v0~vn
+          ++nz;
         }
 
         // With respect to n
-        values[nz_index] = 1.0;  // w0
-        ++nz_index;
+        values[nz] = 1.0;  // w0
+        ++nz;
 
-        values[nz_index] = -1.0;  // w2
-        ++nz_index;
+        values[nz] = -1.0;  // w2
+        ++nz;
 
         // 3. G' * mu + R' * lambda == 0, part 2
         // With respect to x
-        values[nz_index] = -std::cos(x[state_index + 2]) * tmp1 -
-                           std::sin(x[state_index + 2]) * tmp2;  // x
-        ++nz_index;
+        values[nz] = -std::cos(x[x_index + 2]) * tmp1 -
+                     std::sin(x[x_index + 2]) * tmp2;  // x
+        ++nz;
 
         // with respect to l
         for (int k = 0; k < current_edges_num; ++k) {
-          values[nz_index] = -std::sin(x[state_index + 2]) * Aj(k, 0) +
-                             std::cos(x[state_index + 2]) * Aj(k, 1);  // y0~yn
-          ++nz_index;
+          values[nz] = -std::sin(x[x_index + 2]) * Aj(k, 0) +
+                       std::cos(x[x_index + 2]) * Aj(k, 1);  // y0~yn
+          ++nz;
         }
 
         // With respect to n
-        values[nz_index] = 1.0;  // z1
-        ++nz_index;
+        values[nz] = 1.0;  // z1
+        ++nz;
 
-        values[nz_index] = -1.0;  // z3
-        ++nz_index;
+        values[nz] = -1.0;  // z3
+        ++nz;
 
         //  3. -g'*mu + (A*t - b)*lambda > 0
         double tmp3 = 0.0;
         double tmp4 = 0.0;
         for (int k = 0; k < 4; ++k) {
-          tmp3 += -g_[k] * x[n_index + k];
+          tmp3 += -g_[k] * x[n_offset + k];
         }
 
         for (int k = 0; k < current_edges_num; ++k) {
-          tmp4 += bj(k, 0) * x[l_index + k];
+          tmp4 += bj(k, 0) * x[l_offset + k];
         }
 
         // With respect to x
-        values[nz_index] = tmp1;  // aa1
-        ++nz_index;
+        values[nz] = tmp1;  // aa1
+        ++nz;
 
-        values[nz_index] = tmp2;  // bb1
-        ++nz_index;
+        values[nz] = tmp2;  // bb1
+        ++nz;
 
-        values[nz_index] =
-            -std::sin(x[state_index + 2]) * offset_ * tmp1 +
-            std::cos(x[state_index + 2]) * offset_ * tmp2;  // cc1
-        ++nz_index;
+        values[nz] = -std::sin(x[x_index + 2]) * offset_ * tmp1 +
+                     std::cos(x[x_index + 2]) * offset_ * tmp2;  // cc1
+        ++nz;
 
         // with respect to l
         for (int k = 0; k < current_edges_num; ++k) {
-          values[nz_index] =
-              (x[state_index] + std::cos(x[state_index + 2]) * offset_) *
-                  Aj(k, 0) +
-              (x[state_index + 1] + std::sin(x[state_index + 2]) * offset_) *
-                  Aj(k, 1) -
+          values[nz] =
+              (x[x_index] + std::cos(x[x_index + 2]) * offset_) * Aj(k, 0) +
+              (x[x_index + 1] + std::sin(x[x_index + 2]) * offset_) * Aj(k, 1) -
               bj(k, 0);  // ddk
-          ++nz_index;
+          ++nz;
         }
 
         // with respect to n
         for (int k = 0; k < 4; ++k) {
-          values[nz_index] = -g_[k];  // eek
-          ++nz_index;
+          values[nz] = -g_[k];  // eek
+          ++nz;
         }
 
         // Update index
         edges_counter += current_edges_num;
-        l_index += current_edges_num;
-        n_index += 4;
+        l_offset += current_edges_num;
+        n_offset += 4;
       }
-      state_index += 4;
     }
+    nz_index = obstacles_nz_start + (horizon_ + 1) * obstacles_nz_per_step;
 
     // 5. load variable bounds as constraints
     state_index = state_start_index_;
@@ -25,6 +25,7 @@
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/math/solver_pool.h"
 
 namespace apollo {
 namespace planning {
@@ -192,12 +193,20 @@ bool DualVariableWarmStartOSQPInterface::optimize() {
   data->u = ub;
 
   // Workspace
-  OSQPWorkspace* work = nullptr;
-  // osqp_setup(&work, data, settings);
-  work = osqp_setup(data, settings);
+  auto lease = SolverPool::Instance()->AcquireOsqp(
+      "DualVariableWarmStartOSQPInterface", *data, *settings);
+  OSQPWorkspace* work = lease.work();
+  if (work == nullptr) {
+    AERROR << "failed to setup osqp workspace";
+    c_free(data->A);
+    c_free(data->P);
+    c_free(data);
+    c_free(settings);
+    return false;
+  }
 
   // Solve Problem
-  osqp_solve(work);
+  lease.Solve();
 
   // check state
   if (work->info->status_val != 1 && work->info->status_val != 2) {
@@ -228,7 +237,6 @@ bool DualVariableWarmStartOSQPInterface::optimize() {
   succ = succ & (work->info->obj_val <= 1.0);
 
   // Cleanup
-  osqp_cleanup(work);
   c_free(data->A);
   c_free(data->P);
   c_free(data);
@@ -0,0 +1,329 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replays recorded planning inputs through OnLanePlanning as fast as
+ * possible and reports the RunOnce latency per scenario and stage.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "absl/strings/str_split.h"
+#include "cyber/common/file.h"
+#include "cyber/record/parallel_record_viewer.h"
+#include "cyber/time/clock.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/planning/common/dependency_injector.h"
+#include "modules/planning/common/local_view.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/util/util.h"
+#include "modules/planning/on_lane_planning.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/planning/proto/planning_config.pb.h"
+
+DEFINE_string(benchmark_planning_config_file,
+              "/apollo/modules/planning/conf/planning_config.pb.txt",
+              "planning config used to replay the records");
+DEFINE_string(benchmark_output_file, "",
+              "if not empty, write the latency report to this file");
+DEFINE_string(benchmark_baseline_file, "",
+              "latency report of another build to compare against");
+DEFINE_double(benchmark_regression_ratio, 0.1,
+              "relative p50/p99 increase over the baseline reported as a "
+              "regression");
+
+namespace apollo {
+namespace planning {
+
+using apollo::cyber::Clock;
+using apollo::cyber::record::ParallelRecordViewer;
+using apollo::cyber::record::RecordMessage;
+using apollo::perception::TrafficLightDetection;
+using apollo::storytelling::Stories;
+
+namespace {
+
+// the key of the latencies over all scenarios
+constexpr char kAllCycles[] = "ALL";
+
+struct LatencySummary {
+  size_t count = 0;
+  double p50_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+using LatencyReport = std::map<std::string, LatencySummary>;
+
+LatencySummary Summarize(std::vector<double> latencies_ms) {
+  LatencySummary summary;
+  if (latencies_ms.empty()) {
+    return summary;
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  // nearest rank percentiles
+  const auto percentile = [&latencies_ms](const double p) {
+    const size_t rank = static_cast<size_t>(
+        std::ceil(p * static_cast<double>(latencies_ms.size())));
+    return latencies_ms[std::max<size_t>(rank, 1) - 1];
+  };
+  summary.count = latencies_ms.size();
+  summary.p50_ms = percentile(0.5);
+  summary.p99_ms = percentile(0.99);
+  summary.max_ms = latencies_ms.back();
+  return summary;
+}
+
+std::string ReportToString(const LatencyReport& report) {
+  std::ostringstream os;
+  os << "# key\tcount\tp50_ms\tp99_ms\tmax_ms\n";
+  for (const auto& entry : report) {
+    os << entry.first << "\t" << entry.second.count << "\t"
+       << entry.second.p50_ms << "\t" << entry.second.p99_ms << "\t"
+       << entry.second.max_ms << "\n";
+  }
+  return os.str();
+}
+
+bool ReadReport(const std::string& file, LatencyReport* report) {
+  std::ifstream is(file);
+  if (!is.is_open()) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream ls(line);
+    std::string key;
+    LatencySummary summary;
+    if (std::getline(ls, key, '\t') &&
+        ls >> summary.count >> summary.p50_ms >> summary.p99_ms >>
+            summary.max_ms) {
+      (*report)[key] = summary;
+    }
+  }
+  return true;
+}
+
+// returns the number of keys slower than the baseline
+int CompareReports(const LatencyReport& baseline,
+                   const LatencyReport& report) {
+  int regressions = 0;
+  for (const auto& entry : report) {
+    const auto iter = baseline.find(entry.first);
+    if (iter == baseline.end()) {
+      continue;
+    }
+    const auto& base = iter->second;
+    const auto& curr = entry.second;
+    const bool regressed =
+        curr.p50_ms > base.p50_ms * (1.0 + FLAGS_benchmark_regression_ratio) ||
+        curr.p99_ms > base.p99_ms * (1.0 + FLAGS_benchmark_regression_ratio);
+    if (regressed) {
+      ++regressions;
+    }
+    AINFO << (regressed ? "[REGRESSION] " : "") << entry.first
+          << " p50: " << base.p50_ms << " -> " << curr.p50_ms
+          << " ms, p99: " << base.p99_ms << " -> " << curr.p99_ms << " ms";
+  }
+  return regressions;
+}
+
+}  // namespace
+
+class PlanningBenchmark {
+ public:
+  explicit PlanningBenchmark(const PlanningConfig& config) : config_(config) {}
+
+  /**
+   * @brief replays one record with a fresh planner, every prediction message
+   * triggers one planning cycle like in PlanningComponent
+   */
+  void ReplayRecord(const std::string& record_file) {
+    auto injector = std::make_shared<DependencyInjector>();
+    OnLanePlanning planning(injector);
+    if (!planning.Init(config_).ok()) {
+      AERROR << "Failed to init planning for " << record_file;
+      return;
+    }
+
+    const auto& topic_config = config_.topic_config();
+    ParallelRecordViewer viewer(
+        {record_file}, 0, std::numeric_limits<uint64_t>::max(),
+        {topic_config.chassis_topic(), topic_config.localization_topic(),
+         topic_config.prediction_topic(),
+         topic_config.routing_response_topic(),
+         topic_config.story_telling_topic(),
+         topic_config.traffic_light_detection_topic()});
+    if (!viewer.IsValid()) {
+      AERROR << "Fail to open " << record_file;
+      return;
+    }
+
+    LocalView local_view;
+    local_view.traffic_light = std::make_shared<TrafficLightDetection>();
+    local_view.stories = std::make_shared<Stories>();
+    RecordMessage message;
+    while (viewer.ReadMessage(&message)) {
+      if (message.channel_name == topic_config.chassis_topic()) {
+        ParseInto(message, &local_view.chassis);
+      } else if (message.channel_name == topic_config.localization_topic()) {
+        ParseInto(message, &local_view.localization_estimate);
+      } else if (message.channel_name ==
+                 topic_config.routing_response_topic()) {
+        ParseInto(message, &local_view.routing);
+      } else if (message.channel_name == topic_config.story_telling_topic()) {
+        ParseInto(message, &local_view.stories);
+      } else if (message.channel_name ==
+                 topic_config.traffic_light_detection_topic()) {
+        ParseInto(message, &local_view.traffic_light);
+      } else if (message.channel_name == topic_config.prediction_topic()) {
+        if (!ParseInto(message, &local_view.prediction_obstacles) ||
+            local_view.chassis == nullptr ||
+            local_view.localization_estimate == nullptr ||
+            local_view.routing == nullptr) {
+          continue;
+        }
+        RunCycle(&planning, injector.get(), message, local_view);
+      }
+    }
+  }
+
+  LatencyReport Report() const {
+    LatencyReport report;
+    for (const auto& entry : latencies_ms_) {
+      report[entry.first] = Summarize(entry.second);
+    }
+    return report;
+  }
+
+ private:
+  template <typename T>
+  static bool ParseInto(const RecordMessage& message,
+                        std::shared_ptr<T>* msg) {
+    auto parsed = std::make_shared<T>();
+    if (!parsed->ParseFromString(message.content)) {
+      AERROR << "Failed to parse message on " << message.channel_name;
+      return false;
+    }
+    *msg = std::move(parsed);
+    return true;
+  }
+
+  void RunCycle(OnLanePlanning* planning, DependencyInjector* injector,
+                const RecordMessage& message, const LocalView& local_view) {
+    // planning reads the clock for stitching, keep it at the record time
+    Clock::SetNowInSeconds(static_cast<double>(message.time) * 1e-9);
+
+    ADCTrajectory trajectory;
+    const auto start_time = std::chrono::steady_clock::now();
+    planning->RunOnce(local_view, &trajectory);
+    const auto end_time = std::chrono::steady_clock::now();
+    const double latency_ms =
+        std::chrono::duration<double, std::milli>(end_time - start_time)
+            .count();
+    injector->history()->Add(trajectory);
+
+    const auto& scenario =
+        injector->planning_context()->planning_status().scenario();
+    const std::string scenario_name =
+        ScenarioConfig::ScenarioType_Name(scenario.scenario_type());
+    latencies_ms_[kAllCycles].push_back(latency_ms);
+    latencies_ms_[scenario_name].push_back(latency_ms);
+    latencies_ms_[scenario_name + "/" +
+                  ScenarioConfig::StageType_Name(scenario.stage_type())]
+        .push_back(latency_ms);
+  }
+
+  PlanningConfig config_;
+  std::map<std::string, std::vector<double>> latencies_ms_;
+};
+
+int RunBenchmark() {
+  AINFO << "map_dir: " << FLAGS_map_dir;
+  if (FLAGS_planning_offline_bags.empty()) {
+    AERROR << "Requires FLAGS_planning_offline_bags to be set";
+    return -1;
+  }
+
+  PlanningConfig planning_config;
+  ACHECK(cyber::common::GetProtoFromFile(FLAGS_benchmark_planning_config_file,
+                                         &planning_config))
+      << "failed to load planning config file "
+      << FLAGS_benchmark_planning_config_file;
+
+  // the reference lines have to be ready for every replayed cycle, and their
+  // cost is part of what is measured
+  FLAGS_enable_reference_line_provider_thread = false;
+  Clock::SetMode(apollo::cyber::proto::MODE_MOCK);
+
+  PlanningBenchmark benchmark(planning_config);
+  const std::vector<std::string> inputs =
+      absl::StrSplit(FLAGS_planning_offline_bags, ':');
+  for (const auto& input : inputs) {
+    std::vector<std::string> offline_bags;
+    util::GetFilesByPath(boost::filesystem::path(input), &offline_bags);
+    std::sort(offline_bags.begin(), offline_bags.end());
+    for (std::size_t i = 0; i < offline_bags.size(); ++i) {
+      AINFO << "\tReplaying: [ " << i + 1 << " / " << offline_bags.size()
+            << " ]: " << offline_bags[i];
+      benchmark.ReplayRecord(offline_bags[i]);
+    }
+  }
+
+  const LatencyReport report = benchmark.Report();
+  const std::string report_str = ReportToString(report);
+  AINFO << "Planning latency:\n" << report_str;
+  if (!FLAGS_benchmark_output_file.empty()) {
+    std::ofstream os(FLAGS_benchmark_output_file);
+    os << report_str;
+  }
+
+  if (FLAGS_benchmark_baseline_file.empty()) {
+    return 0;
+  }
+  LatencyReport baseline;
+  if (!ReadReport(FLAGS_benchmark_baseline_file, &baseline)) {
+    AERROR << "Failed to read baseline " << FLAGS_benchmark_baseline_file;
+    return -1;
+  }
+  const int regressions = CompareReports(baseline, report);
+  AINFO << regressions << " latency regressions against the baseline";
+  return regressions > 0 ? 1 : 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::RunBenchmark();
+}
@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/planning/math/discretized_points_smoothing/fem_pos_deviation_smoother.h"
 #include "modules/planning/proto/reference_line_smoother_config.pb.h"
 #include "modules/planning/reference_line/reference_line.h"
 #include "modules/planning/reference_line/reference_line_smoother.h"
@@ -61,6 +62,9 @@ class DiscretePointsReferenceLineSmoother : public ReferenceLineSmoother {
 
   std::vector<AnchorPoint> anchor_points_;
 
+  // kept across calls so that it can warm start from its previous results
+  FemPosDeviationSmoother fem_pos_smoother_;
+
   double zero_x_ = 0.0;
 
   double zero_y_ = 0.0;
@@ -187,6 +187,23 @@ common::FrenetFramePoint ReferenceLine::GetFrenetPoint(
 
   common::SLPoint sl_point;
   XYToSL(path_point, &sl_point);
+  return GetFrenetPoint(path_point, sl_point);
+}
+
+common::FrenetFramePoint ReferenceLine::GetFrenetPoint(
+    const common::PathPoint& path_point, const double warm_start_s) const {
+  if (reference_points_.empty()) {
+    return common::FrenetFramePoint();
+  }
+
+  common::SLPoint sl_point;
+  XYToSL({path_point.x(), path_point.y()}, &sl_point, warm_start_s);
+  return GetFrenetPoint(path_point, sl_point);
+}
+
+common::FrenetFramePoint ReferenceLine::GetFrenetPoint(
+    const common::PathPoint& path_point,
+    const common::SLPoint& sl_point) const {
   common::FrenetFramePoint frenet_frame_point;
   frenet_frame_point.set_s(sl_point.s());
   frenet_frame_point.set_l(sl_point.l());
@@ -401,6 +418,38 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
+                           SLPoint* const sl_point,
+                           const double warm_start_s) const {
+  double s = warm_start_s;
+  double l = 0.0;
+  if (!map_path_.GetProjectionWithWarmStartS(xy_point, &s, &l)) {
+    AERROR << "Cannot get nearest point from path.";
+    return false;
+  }
+  sl_point->set_s(s);
+  sl_point->set_l(l);
+  return true;
+}
+
+bool ReferenceLine::XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+                           std::vector<SLPoint>* const sl_points) const {
+  sl_points->clear();
+  sl_points->reserve(xy_points.size());
+  for (const auto& xy_point : xy_points) {
+    SLPoint sl_point;
+    const bool projected =
+        (FLAGS_enable_sl_projection_warm_start && !sl_points->empty())
+            ? XYToSL(xy_point, &sl_point, sl_points->back().s())
+            : XYToSL(xy_point, &sl_point);
+    if (!projected) {
+      return false;
+    }
+    sl_points->push_back(std::move(sl_point));
+  }
+  return true;
+}
+
 ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
     const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
     const double s1, const InterpolatedIndex& index) const {
@@ -668,14 +717,10 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
 
   // The order must be counter-clockwise
   std::vector<SLPoint> sl_corners;
-  for (const auto& point : corners) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "Failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
-    sl_corners.push_back(std::move(sl_point));
+  if (!XYToSL(corners, &sl_corners)) {
+    AERROR << "Failed to get projection for box: " << box.DebugString()
+           << " on reference line.";
+    return false;
   }
 
   for (size_t i = 0; i < corners.size(); ++i) {
@@ -686,7 +731,11 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
 
     const auto p_mid = (p0 + p1) * 0.5;
     SLPoint sl_point_mid;
-    if (!XYToSL(p_mid, &sl_point_mid)) {
+    const bool projected =
+        FLAGS_enable_sl_projection_warm_start
+            ? XYToSL(p_mid, &sl_point_mid, sl_corners[index0].s())
+            : XYToSL(p_mid, &sl_point_mid);
+    if (!projected) {
       AERROR << "Failed to get projection for point: " << p_mid.DebugString()
              << " on reference line.";
       return false;
@@ -731,13 +780,18 @@ bool ReferenceLine::GetSLBoundary(const hdmap::Polygon& polygon,
   double end_s(std::numeric_limits<double>::lowest());
   double start_l(std::numeric_limits<double>::max());
   double end_l(std::numeric_limits<double>::lowest());
+  std::vector<Vec2d> points;
+  points.reserve(polygon.point_size());
   for (const auto& point : polygon.point()) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "Failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
+    points.emplace_back(point.x(), point.y());
+  }
+  std::vector<SLPoint> sl_points;
+  if (!XYToSL(points, &sl_points)) {
+    AERROR << "Failed to get projection for polygon: "
+           << polygon.ShortDebugString() << " on reference line.";
+    return false;
+  }
+  for (const auto& sl_point : sl_points) {
     start_s = std::fmin(start_s, sl_point.s());
     end_s = std::fmax(end_s, sl_point.s());
     start_l = std::fmin(start_l, sl_point.l());
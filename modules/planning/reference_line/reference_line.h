@@ -84,6 +84,8 @@ class ReferenceLine {
 
   common::FrenetFramePoint GetFrenetPoint(
       const common::PathPoint& path_point) const;
+  common::FrenetFramePoint GetFrenetPoint(const common::PathPoint& path_point,
+                                          const double warm_start_s) const;
 
   std::pair<std::array<double, 3>, std::array<double, 3>> ToFrenetFrame(
       const common::TrajectoryPoint& traj_point) const;
@@ -114,6 +116,19 @@ class ReferenceLine {
               common::math::Vec2d* const xy_point) const;
   bool XYToSL(const common::math::Vec2d& xy_point,
               common::SLPoint* const sl_point) const;
+  /**
+   * @brief Project xy_point by a local search around warm_start_s, the s of a
+   * nearby point that is already projected.
+   */
+  bool XYToSL(const common::math::Vec2d& xy_point,
+              common::SLPoint* const sl_point,
+              const double warm_start_s) const;
+  /**
+   * @brief Project the points of a polyline in order, each warm started from
+   * the projection of the previous one.
+   */
+  bool XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+              std::vector<common::SLPoint>* const sl_points) const;
   template <class XYPoint>
   bool XYToSL(const XYPoint& xy, common::SLPoint* const sl_point) const {
     return XYToSL(common::math::Vec2d(xy.x(), xy.y()), sl_point);
@@ -208,6 +223,10 @@ class ReferenceLine {
       const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
       const double s1, const hdmap::InterpolatedIndex& index) const;
 
+  common::FrenetFramePoint GetFrenetPoint(
+      const common::PathPoint& path_point,
+      const common::SLPoint& sl_point) const;
+
   static double FindMinDistancePoint(const ReferencePoint& p0, const double s0,
                                      const ReferencePoint& p1, const double s1,
                                      const double x, const double y);
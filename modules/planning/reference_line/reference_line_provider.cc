@@ -36,6 +36,7 @@
 #include "modules/map/pnc_map/path.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/routing/common/routing_gflags.h"
 
 /**
@@ -56,6 +57,11 @@ using apollo::hdmap::MapPathPoint;
 using apollo::hdmap::PncMap;
 using apollo::hdmap::RouteSegments;
 
+namespace {
+// a few route segments are alive at the same time, one per neighbor lane
+constexpr size_t kMaxSmoothedSegments = 8;
+}  // namespace
+
 ReferenceLineProvider::~ReferenceLineProvider() {}
 
 ReferenceLineProvider::ReferenceLineProvider(
@@ -698,7 +704,9 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     AWARN << "Failed to project point: " << vec2d.DebugString()
           << " to stitched reference line";
   }
-  return Shrink(sl, reference_line, segments);
+  Shrink(sl, reference_line, segments);
+  CacheSmoothedSegment(*segments, *reference_line);
+  return true;
 }
 
 bool ReferenceLineProvider::Shrink(const common::SLPoint &sl,
@@ -870,8 +878,93 @@ void ReferenceLineProvider::GetAnchorPoints(
 
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
+  if (SmoothRouteSegmentFromCache(segments, reference_line)) {
+    return true;
+  }
+  hdmap::Path path(segments);
+  if (!SmoothReferenceLine(ReferenceLine(path), reference_line)) {
+    return false;
+  }
+  CacheSmoothedSegment(segments, *reference_line);
+  return true;
+}
+
+bool ReferenceLineProvider::SmoothRouteSegmentFromCache(
+    const RouteSegments &segments, ReferenceLine *reference_line) {
+  if (!FLAGS_enable_smoothed_segment_cache ||
+      !FLAGS_enable_smooth_reference_line || segments.empty()) {
+    return false;
+  }
+  const auto first_waypoint = segments.FirstWaypoint();
+  auto cached = smoothed_segments_.begin();
+  while (cached != smoothed_segments_.end() &&
+         !cached->segments.IsWaypointOnSegment(first_waypoint)) {
+    ++cached;
+  }
+  if (cached == smoothed_segments_.end()) {
+    return false;
+  }
+  smoothed_segments_.splice(smoothed_segments_.begin(), smoothed_segments_,
+                            cached);
+  const auto &cached_ref = cached->reference_line;
+
   hdmap::Path path(segments);
-  return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  const ReferenceLine raw_ref(path);
+  ReferenceLine smoothed_ref;
+  const bool is_covered =
+      cached->segments.IsWaypointOnSegment(segments.LastWaypoint());
+  if (is_covered) {
+    // every lane of segments is smoothed already
+    smoothed_ref = cached_ref;
+  } else {
+    // smooth the tail beyond the cached lanes, anchored to the cached end
+    common::SLPoint cached_end_sl;
+    if (!raw_ref.XYToSL(cached_ref.reference_points().back(),
+                        &cached_end_sl)) {
+      return false;
+    }
+    const double tail_start_s = std::max(
+        0.0, cached_end_sl.s() - FLAGS_reference_line_stitch_overlap_distance);
+    ReferenceLine raw_tail = raw_ref;
+    if (!raw_tail.Segment(tail_start_s, 0.0,
+                          raw_ref.Length() - tail_start_s)) {
+      return false;
+    }
+    if (!SmoothPrefixedReferenceLine(cached_ref, raw_tail, &smoothed_ref)) {
+      AWARN << "Failed to smooth the tail of a cached reference line";
+      return false;
+    }
+    if (!smoothed_ref.Stitch(cached_ref)) {
+      AWARN << "Failed to stitch the tail to a cached reference line";
+      return false;
+    }
+  }
+
+  // cut out the range of segments
+  common::SLPoint start_sl;
+  common::SLPoint end_sl;
+  if (!smoothed_ref.XYToSL(raw_ref.reference_points().front(), &start_sl) ||
+      !smoothed_ref.XYToSL(raw_ref.reference_points().back(), &end_sl) ||
+      !smoothed_ref.Segment(start_sl.s(), 0.0, end_sl.s() - start_sl.s())) {
+    return false;
+  }
+  *reference_line = std::move(smoothed_ref);
+  if (!is_covered) {
+    CacheSmoothedSegment(segments, *reference_line);
+  }
+  return true;
+}
+
+void ReferenceLineProvider::CacheSmoothedSegment(
+    const RouteSegments &segments, const ReferenceLine &reference_line) {
+  if (!FLAGS_enable_smoothed_segment_cache ||
+      !FLAGS_enable_smooth_reference_line || segments.empty()) {
+    return;
+  }
+  smoothed_segments_.push_front({segments, reference_line});
+  while (smoothed_segments_.size() > kMaxSmoothedSegments) {
+    smoothed_segments_.pop_back();
+  }
 }
 
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
@@ -918,6 +1011,7 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
 
 bool ReferenceLineProvider::SmoothReferenceLine(
     const ReferenceLine &raw_reference_line, ReferenceLine *reference_line) {
+  PLANNING_PROFILE_SCOPE("SmoothReferenceLine");
   if (!FLAGS_enable_smooth_reference_line) {
     *reference_line = raw_reference_line;
     return true;
@@ -127,6 +127,17 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  /**
+   * @brief Build the smoothed reference line of segments from a cached one
+   * it starts on, smoothing only the part beyond the cached lanes.
+   * @return false if no cached reference line can be reused.
+   */
+  bool SmoothRouteSegmentFromCache(const hdmap::RouteSegments& segments,
+                                   ReferenceLine* reference_line);
+
+  void CacheSmoothedSegment(const hdmap::RouteSegments& segments,
+                            const ReferenceLine& reference_line);
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -179,6 +190,13 @@ class ReferenceLineProvider {
   std::list<hdmap::RouteSegments> route_segments_;
   double last_calculation_time_ = 0.0;
 
+  // most recently used first, looked up by lane id and s range
+  struct SmoothedSegment {
+    hdmap::RouteSegments segments;
+    ReferenceLine reference_line;
+  };
+  std::list<SmoothedSegment> smoothed_segments_;
+
   std::queue<std::list<ReferenceLine>> reference_line_history_;
   std::queue<std::list<hdmap::RouteSegments>> route_segments_history_;
 
@@ -20,9 +20,14 @@
 
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
+#include <future>
+#include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "cyber/time/clock.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/point_factory.h"
@@ -32,12 +37,15 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/tasks/deciders/lane_change_decider/lane_change_decider.h"
 #include "modules/planning/tasks/deciders/path_decider/path_decider.h"
 #include "modules/planning/tasks/deciders/speed_decider/speed_decider.h"
 #include "modules/planning/tasks/optimizers/path_time_heuristic/path_time_heuristic_optimizer.h"
+#include "modules/planning/tasks/task_factory.h"
 
 namespace apollo {
 namespace planning {
@@ -92,6 +100,15 @@ void LaneFollowStage::RecordObstacleDebugInfo(
 
 Stage::StageStatus LaneFollowStage::Process(
     const TrajectoryPoint& planning_start_point, Frame* frame) {
+  PLANNING_PROFILE_SCOPE(Name());
+  // the lane change urgency check reads the cost of the other reference
+  // lines, which are only final when planned one after another
+  if (FLAGS_enable_parallel_reference_line_planning &&
+      !FLAGS_enable_lane_change_urgency_checking &&
+      frame->mutable_reference_line_info()->size() > 1) {
+    return ProcessInParallel(planning_start_point, frame);
+  }
+
   bool has_drivable_reference_line = false;
 
   ADEBUG << "Number of reference lines:\t"
@@ -115,41 +132,156 @@ Stage::StageStatus LaneFollowStage::Process(
     auto cur_status =
         PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
 
-    if (cur_status.ok()) {
-      if (reference_line_info.IsChangeLanePath()) {
-        ADEBUG << "reference line is lane change ref.";
-        ADEBUG << "FLAGS_enable_smarter_lane_change: "
-               << FLAGS_enable_smarter_lane_change;
-        if (reference_line_info.Cost() < kStraightForwardLineCost &&
-            (LaneChangeDecider::IsClearToChangeLane(&reference_line_info) ||
-             FLAGS_enable_smarter_lane_change)) {
-          // If the path and speed optimization succeed on target lane while
-          // under smart lane-change or IsClearToChangeLane under older version
-          has_drivable_reference_line = true;
-          reference_line_info.SetDrivable(true);
-          LaneChangeDecider::UpdatePreparationDistance(
-              true, frame, &reference_line_info, injector_->planning_context());
-          ADEBUG << "\tclear for lane change";
-        } else {
-          LaneChangeDecider::UpdatePreparationDistance(
-              false, frame, &reference_line_info,
-              injector_->planning_context());
-          reference_line_info.SetDrivable(false);
-          ADEBUG << "\tlane change failed";
-        }
-      } else {
-        ADEBUG << "reference line is NOT lane change ref.";
-        has_drivable_reference_line = true;
-      }
-    } else {
+    has_drivable_reference_line =
+        SelectReferenceLine(cur_status, frame, &reference_line_info);
+  }
+
+  return has_drivable_reference_line ? StageStatus::RUNNING
+                                     : StageStatus::ERROR;
+}
+
+Stage::StageStatus LaneFollowStage::ProcessInParallel(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  auto* planning_context = injector_->planning_context();
+
+  ADEBUG << "Number of reference lines planned in parallel:\t"
+         << frame->mutable_reference_line_info()->size();
+
+  // every reference line starts from the planning status of the last frame
+  // and writes its own copy of it
+  struct LinePlan {
+    ReferenceLineInfo* reference_line_info;
+    const std::vector<Task*>* task_list;
+    PlanningStatus planning_status;
+    Status status;
+  };
+  // creates the task copies of all lines up front, so that the task lists
+  // stay put while the lines are planned
+  ReferenceLineTaskList(frame->mutable_reference_line_info()->size() - 1);
+  std::vector<LinePlan> plans;
+  std::unordered_map<const ReferenceLineInfo*, size_t> plan_index;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    plan_index[&reference_line_info] = plans.size();
+    plans.push_back({&reference_line_info,
+                     &ReferenceLineTaskList(plans.size()),
+                     planning_context->planning_status(), Status::OK()});
+  }
+
+  // lane change decider reorders the reference lines of the frame, the
+  // leading deciders of that type run line by line before fanning out
+  size_t serial_task_num = 0;
+  while (serial_task_num < task_list_.size() &&
+         task_list_[serial_task_num]->Config().task_type() ==
+             TaskConfig::LANE_CHANGE_DECIDER) {
+    ++serial_task_num;
+  }
+  for (size_t i = 0; i < plans.size(); ++i) {
+    auto& plan = plans[i];
+    PlanningContext::LocalStatusGuard guard(planning_context,
+                                            &plan.planning_status);
+    if (!plan.reference_line_info->IsChangeLanePath()) {
+      plan.reference_line_info->AddCost(kStraightForwardLineCost);
+    }
+    plan.status = ExecuteTasks(plan.task_list->begin(),
+                               plan.task_list->begin() + serial_task_num,
+                               frame, plan.reference_line_info);
+  }
+
+  auto plan_line = [this, planning_context, serial_task_num,
+                    &planning_start_point, frame, &plans](size_t i) {
+    auto& plan = plans[i];
+    PlanningContext::LocalStatusGuard guard(planning_context,
+                                            &plan.planning_status);
+    if (plan.status.ok()) {
+      plan.status = ExecuteTasks(plan.task_list->begin() + serial_task_num,
+                                 plan.task_list->end(), frame,
+                                 plan.reference_line_info);
+    }
+    plan.status = FinishPlanOnReferenceLine(plan.status, planning_start_point,
+                                            frame, plan.reference_line_info);
+  };
+  std::vector<std::future<void>> results;
+  for (size_t i = 1; i < plans.size(); ++i) {
+    results.push_back(cyber::Async(plan_line, i));
+  }
+  plan_line(0);
+  for (auto& result : results) {
+    result.get();
+  }
+
+  // pick the reference line in the same order as the sequential planning,
+  // the planning status left behind is the one of the last line looked at
+  bool has_drivable_reference_line = false;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    if (has_drivable_reference_line) {
       reference_line_info.SetDrivable(false);
+      continue;
     }
+    const auto& plan = plans[plan_index[&reference_line_info]];
+    *planning_context->mutable_planning_status() = plan.planning_status;
+    has_drivable_reference_line =
+        SelectReferenceLine(plan.status, frame, &reference_line_info);
   }
 
   return has_drivable_reference_line ? StageStatus::RUNNING
                                      : StageStatus::ERROR;
 }
 
+bool LaneFollowStage::SelectReferenceLine(
+    const Status& plan_status, Frame* frame,
+    ReferenceLineInfo* reference_line_info) {
+  if (!plan_status.ok()) {
+    reference_line_info->SetDrivable(false);
+    return false;
+  }
+  if (!reference_line_info->IsChangeLanePath()) {
+    ADEBUG << "reference line is NOT lane change ref.";
+    return true;
+  }
+  ADEBUG << "reference line is lane change ref.";
+  ADEBUG << "FLAGS_enable_smarter_lane_change: "
+         << FLAGS_enable_smarter_lane_change;
+  if (reference_line_info->Cost() < kStraightForwardLineCost &&
+      (LaneChangeDecider::IsClearToChangeLane(reference_line_info) ||
+       FLAGS_enable_smarter_lane_change)) {
+    // If the path and speed optimization succeed on target lane while
+    // under smart lane-change or IsClearToChangeLane under older version
+    reference_line_info->SetDrivable(true);
+    LaneChangeDecider::UpdatePreparationDistance(
+        true, frame, reference_line_info, injector_->planning_context());
+    ADEBUG << "\tclear for lane change";
+    return true;
+  }
+  LaneChangeDecider::UpdatePreparationDistance(
+      false, frame, reference_line_info, injector_->planning_context());
+  reference_line_info->SetDrivable(false);
+  ADEBUG << "\tlane change failed";
+  return false;
+}
+
+const std::vector<Task*>& LaneFollowStage::ReferenceLineTaskList(
+    size_t index) {
+  if (index == 0) {
+    return task_list_;
+  }
+  while (line_task_lists_.size() < index) {
+    std::unordered_map<const Task*, Task*> copies;
+    std::vector<std::unique_ptr<Task>> tasks;
+    std::vector<Task*> task_list;
+    for (const auto* task : task_list_) {
+      auto iter = copies.find(task);
+      if (iter == copies.end()) {
+        tasks.push_back(TaskFactory::CreateTask(task->Config(), injector_));
+        iter = copies.emplace(task, tasks.back().get()).first;
+      }
+      task_list.push_back(iter->second);
+    }
+    line_tasks_.push_back(std::move(tasks));
+    line_task_lists_.push_back(std::move(task_list));
+  }
+  return line_task_lists_[index - 1];
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
@@ -160,11 +292,25 @@ Status LaneFollowStage::PlanOnReferenceLine(
   ADEBUG << "Current reference_line_info is IsChangeLanePath: "
          << reference_line_info->IsChangeLanePath();
 
+  auto ret = ExecuteTasks(task_list_.begin(), task_list_.end(), frame,
+                          reference_line_info);
+  return FinishPlanOnReferenceLine(ret, planning_start_point, frame,
+                                   reference_line_info);
+}
+
+Status LaneFollowStage::ExecuteTasks(std::vector<Task*>::const_iterator first,
+                                     std::vector<Task*>::const_iterator last,
+                                     Frame* frame,
+                                     ReferenceLineInfo* reference_line_info) {
   auto ret = Status::OK();
-  for (auto* task : task_list_) {
+  for (auto iter = first; iter != last; ++iter) {
+    auto* task = *iter;
     const double start_timestamp = Clock::NowInSeconds();
 
-    ret = task->Execute(frame, reference_line_info);
+    {
+      PLANNING_PROFILE_SCOPE(task->Name());
+      ret = task->Execute(frame, reference_line_info);
+    }
 
     const double end_timestamp = Clock::NowInSeconds();
     const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
@@ -186,15 +332,19 @@ Status LaneFollowStage::PlanOnReferenceLine(
     // ADEBUG << "Current reference_line_info is IsChangeLanePath: "
     //        << reference_line_info->IsChangeLanePath();
   }
+  return ret;
+}
 
+Status LaneFollowStage::FinishPlanOnReferenceLine(
+    const Status& task_status, const TrajectoryPoint& planning_start_point,
+    Frame* frame, ReferenceLineInfo* reference_line_info) {
   RecordObstacleDebugInfo(reference_line_info);
 
   // check path and speed results for path or speed fallback
   reference_line_info->set_trajectory_type(ADCTrajectory::NORMAL);
-  if (!ret.ok()) {
+  if (!task_status.ok()) {
     PlanFallbackTrajectory(planning_start_point, frame, reference_line_info);
   }
-
   DiscretizedTrajectory trajectory;
   if (!reference_line_info->CombinePathAndSpeedProfile(
           planning_start_point.relative_time(),
@@ -69,9 +69,32 @@ class LaneFollowStage : public Stage {
 
   void RecordObstacleDebugInfo(ReferenceLineInfo* reference_line_info);
 
+ private:
+  StageStatus ProcessInParallel(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
+  common::Status ExecuteTasks(std::vector<Task*>::const_iterator first,
+                              std::vector<Task*>::const_iterator last,
+                              Frame* frame,
+                              ReferenceLineInfo* reference_line_info);
+
+  common::Status FinishPlanOnReferenceLine(
+      const common::Status& task_status,
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info);
+
+  bool SelectReferenceLine(const common::Status& plan_status, Frame* frame,
+                           ReferenceLineInfo* reference_line_info);
+
+  // task instances keep per reference line state, so every concurrently
+  // planned reference line other than the first runs its own copies
+  const std::vector<Task*>& ReferenceLineTaskList(size_t index);
+
  private:
   ScenarioConfig config_;
   std::unique_ptr<Stage> stage_;
+  std::vector<std::vector<std::unique_ptr<Task>>> line_tasks_;
+  std::vector<std::vector<Task*>> line_task_lists_;
 };
 
 }  // namespace lane_follow
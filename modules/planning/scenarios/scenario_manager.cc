@@ -16,9 +16,12 @@
 
 #include "modules/planning/scenarios/scenario_manager.h"
 
+#include <functional>
+#include <future>
 #include <string>
 #include <vector>
 
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
@@ -200,13 +203,9 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectPullOverScenario(
   const auto& scenario_config =
       config_map_[ScenarioConfig::PULL_OVER].pull_over_config();
 
-  const auto& routing = frame.local_view().routing;
-  const auto& routing_end = *(routing->routing_request().waypoint().rbegin());
-
-  common::SLPoint dest_sl;
+  const auto& dest_sl = routing_end_sl_;
   const auto& reference_line_info = frame.reference_line_info().front();
   const auto& reference_line = reference_line_info.reference_line();
-  reference_line.XYToSL(routing_end.pose(), &dest_sl);
   const double adc_front_edge_s = reference_line_info.AdcSlBoundary().end_s();
 
   const double adc_distance_to_dest = dest_sl.s() - adc_front_edge_s;
@@ -751,12 +750,8 @@ ScenarioConfig::ScenarioType ScenarioManager::SelectParkAndGoScenario(
   hdmap::LaneInfoConstPtr lane;
 
   // check ego vehicle distance to destination
-  const auto& routing = frame.local_view().routing;
-  const auto& routing_end = *(routing->routing_request().waypoint().rbegin());
-  common::SLPoint dest_sl;
+  const auto& dest_sl = routing_end_sl_;
   const auto& reference_line_info = frame.reference_line_info().front();
-  const auto& reference_line = reference_line_info.reference_line();
-  reference_line.XYToSL(routing_end.pose(), &dest_sl);
   const double adc_front_edge_s = reference_line_info.AdcSlBoundary().end_s();
 
   const double adc_distance_to_dest = dest_sl.s() - adc_front_edge_s;
@@ -793,6 +788,16 @@ void ScenarioManager::Observe(const Frame& frame) {
       first_encountered_overlap_map_[overlap.first] = overlap.second;
     }
   }
+
+  // project routing end
+  routing_end_sl_.Clear();
+  const auto& routing = frame.local_view().routing;
+  if (routing && routing->routing_request().waypoint_size() > 0) {
+    const auto& routing_end =
+        *(routing->routing_request().waypoint().rbegin());
+    reference_line_info.reference_line().XYToSL(routing_end.pose(),
+                                                &routing_end_sl_);
+  }
 }
 
 void ScenarioManager::Update(const common::TrajectoryPoint& ego_point,
@@ -879,6 +884,11 @@ ScenarioConfig::ScenarioType ScenarioManager::ScenarioDispatchNonLearning(
     }
   }
 
+  if (scenario_type == default_scenario_type_ &&
+      FLAGS_enable_parallel_scenario_selection) {
+    return SelectScenarioInParallel(frame);
+  }
+
   ////////////////////////////////////////
   // ParkAndGo / starting scenario
   if (scenario_type == default_scenario_type_) {
@@ -910,6 +920,40 @@ ScenarioConfig::ScenarioType ScenarioManager::ScenarioDispatchNonLearning(
   return scenario_type;
 }
 
+ScenarioConfig::ScenarioType ScenarioManager::SelectScenarioInParallel(
+    const Frame& frame) {
+  // the selectors only read the frame, the planning context and the configs,
+  // so they are all evaluated at once and the first one in the order of the
+  // sequential dispatch wins
+  std::vector<std::function<ScenarioConfig::ScenarioType()>> selectors;
+  if (FLAGS_enable_scenario_park_and_go) {
+    selectors.emplace_back(
+        [this, &frame] { return SelectParkAndGoScenario(frame); });
+  }
+  selectors.emplace_back(
+      [this, &frame] { return SelectInterceptionScenario(frame); });
+  if (FLAGS_enable_scenario_pull_over) {
+    selectors.emplace_back(
+        [this, &frame] { return SelectPullOverScenario(frame); });
+  }
+  selectors.emplace_back(
+      [this, &frame] { return SelectValetParkingScenario(frame); });
+
+  std::vector<std::future<ScenarioConfig::ScenarioType>> results;
+  results.reserve(selectors.size());
+  for (const auto& selector : selectors) {
+    results.push_back(cyber::Async(selector));
+  }
+  ScenarioConfig::ScenarioType scenario_type = default_scenario_type_;
+  for (auto& result : results) {
+    const auto selected = result.get();
+    if (scenario_type == default_scenario_type_) {
+      scenario_type = selected;
+    }
+  }
+  return scenario_type;
+}
+
 bool ScenarioManager::IsBareIntersectionScenario(
     const ScenarioConfig::ScenarioType& scenario_type) {
   return (scenario_type == ScenarioConfig::BARE_INTERSECTION_UNPROTECTED);
@@ -1185,10 +1229,7 @@ void ScenarioManager::UpdatePlanningContextPullOverScenario(
       const auto& reference_line_info = frame.reference_line_info().front();
       const auto& reference_line = reference_line_info.reference_line();
 
-      common::SLPoint dest_sl;
-      const auto& routing_end =
-          *(routing->routing_request().waypoint().rbegin());
-      reference_line.XYToSL(routing_end.pose(), &dest_sl);
+      const auto& dest_sl = routing_end_sl_;
 
       common::SLPoint pull_over_sl;
       reference_line.XYToSL(pull_over_status.position(), &pull_over_sl);
@@ -75,6 +75,7 @@ class ScenarioManager final {
   void ScenarioDispatch(const Frame& frame);
   ScenarioConfig::ScenarioType ScenarioDispatchLearning();
   ScenarioConfig::ScenarioType ScenarioDispatchNonLearning(const Frame& frame);
+  ScenarioConfig::ScenarioType SelectScenarioInParallel(const Frame& frame);
 
   bool IsBareIntersectionScenario(
       const ScenarioConfig::ScenarioType& scenario_type);
@@ -116,6 +117,9 @@ class ScenarioManager final {
   std::unordered_map<ReferenceLineInfo::OverlapType, hdmap::PathOverlap,
                      std::hash<int>>
       first_encountered_overlap_map_;
+  // routing end projected on the first reference line, shared by the
+  // selectors within a frame
+  common::SLPoint routing_end_sl_;
 };
 
 }  // namespace scenario
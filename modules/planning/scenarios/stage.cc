@@ -25,6 +25,7 @@
 
 #include "cyber/time/clock.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/tasks/task_factory.h"
@@ -86,6 +87,7 @@ Task* Stage::FindTask(TaskConfig::TaskType task_type) const {
 
 bool Stage::ExecuteTaskOnReferenceLine(
     const common::TrajectoryPoint& planning_start_point, Frame* frame) {
+  PLANNING_PROFILE_SCOPE(Name());
   for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
     if (!reference_line_info.IsDrivable()) {
       AERROR << "The generated path is not drivable";
@@ -95,7 +97,11 @@ bool Stage::ExecuteTaskOnReferenceLine(
     for (auto* task : task_list_) {
       const double start_timestamp = Clock::NowInSeconds();
 
-      const auto ret = task->Execute(frame, &reference_line_info);
+      common::Status ret;
+      {
+        PLANNING_PROFILE_SCOPE(task->Name());
+        ret = task->Execute(frame, &reference_line_info);
+      }
 
       const double end_timestamp = Clock::NowInSeconds();
       const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
@@ -147,7 +153,11 @@ bool Stage::ExecuteTaskOnReferenceLineForOnlineLearning(
   for (auto* task : task_list_) {
     const double start_timestamp = Clock::NowInSeconds();
 
-    const auto ret = task->Execute(frame, &picked_reference_line_info);
+    common::Status ret;
+    {
+      PLANNING_PROFILE_SCOPE(task->Name());
+      ret = task->Execute(frame, &picked_reference_line_info);
+    }
 
     const double end_timestamp = Clock::NowInSeconds();
     const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
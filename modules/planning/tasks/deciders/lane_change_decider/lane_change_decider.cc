@@ -27,7 +27,6 @@ namespace apollo {
 namespace planning {
 
 using apollo::common::ErrorCode;
-using apollo::common::SLPoint;
 using apollo::common::Status;
 using apollo::cyber::Clock;
 
@@ -283,20 +282,15 @@ bool LaneChangeDecider::IsClearToChangeLane(
       continue;
     }
 
-    double start_s = std::numeric_limits<double>::max();
-    double end_s = -std::numeric_limits<double>::max();
-    double start_l = std::numeric_limits<double>::max();
-    double end_l = -std::numeric_limits<double>::max();
-
-    for (const auto& p : obstacle->PerceptionPolygon().points()) {
-      SLPoint sl_point;
-      reference_line_info->reference_line().XYToSL(p, &sl_point);
-      start_s = std::fmin(start_s, sl_point.s());
-      end_s = std::fmax(end_s, sl_point.s());
-
-      start_l = std::fmin(start_l, sl_point.l());
-      end_l = std::fmax(end_l, sl_point.l());
+    SLBoundary obstacle_sl_boundary;
+    if (!reference_line_info->GetObstaclePolygonSLBoundary(
+            *obstacle, &obstacle_sl_boundary)) {
+      continue;
     }
+    const double start_s = obstacle_sl_boundary.start_s();
+    const double end_s = obstacle_sl_boundary.end_s();
+    const double start_l = obstacle_sl_boundary.start_l();
+    const double end_l = obstacle_sl_boundary.end_l();
 
     if (reference_line_info->IsChangeLanePath()) {
       static constexpr double kLateralShift = 2.5;
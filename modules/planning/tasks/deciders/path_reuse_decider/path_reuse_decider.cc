@@ -20,9 +20,12 @@
 #include "modules/planning/tasks/deciders/path_reuse_decider/path_reuse_decider.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
+#include "modules/common/math/math_utils.h"
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/planning/common/planning_context.h"
@@ -31,12 +34,15 @@ namespace apollo {
 namespace planning {
 
 using apollo::common::Status;
+using apollo::common::math::Box2d;
 using apollo::common::math::Polygon2d;
 using apollo::common::math::Vec2d;
 
 int PathReuseDecider::reusable_path_counter_ = 0;
 int PathReuseDecider::total_path_counter_ = 0;
 bool PathReuseDecider::path_reusable_ = false;
+std::unordered_map<std::string, Box2d>
+    PathReuseDecider::checked_static_obstacle_boxes_;
 
 PathReuseDecider::PathReuseDecider(
     const TaskConfig& config,
@@ -125,7 +131,8 @@ Status PathReuseDecider::Process(Frame* const frame,
   //                                          .trajectory_type();
   if (path_reusable_) {
     if (!frame->current_frame_planned_trajectory().is_replan() &&
-        speed_optimization_successful && IsCollisionFree(reference_line_info) &&
+        speed_optimization_successful &&
+        IsReusedPathCollisionFree(reference_line_info) &&
         TrimHistoryPath(frame, reference_line_info)) {
       ADEBUG << "reuse path";
       ++reusable_path_counter_;  // count reusable path
@@ -136,6 +143,8 @@ Status PathReuseDecider::Process(Frame* const frame,
     }
   } else {
     // F -> T
+    // the history path is a newly planned one
+    checked_static_obstacle_boxes_.clear();
     auto* mutable_path_decider_status = injector_->planning_context()
                                             ->mutable_planning_status()
                                             ->mutable_path_decider();
@@ -326,6 +335,56 @@ bool PathReuseDecider::IsCollisionFree(
   return true;
 }
 
+bool PathReuseDecider::IsReusedPathCollisionFree(
+    ReferenceLineInfo* const reference_line_info) {
+  if (!FLAGS_enable_incremental_path_reuse_check) {
+    return IsCollisionFree(reference_line_info);
+  }
+  static constexpr double kMaxObstacleShift = 0.2;    // meter
+  static constexpr double kMaxObstacleRotation = 0.1;  // rad
+
+  std::unordered_map<std::string, Box2d> static_obstacle_boxes;
+  for (const auto* obstacle :
+       reference_line_info->path_decision()->obstacles().Items()) {
+    if (obstacle->IsStatic() && !obstacle->IsVirtual()) {
+      static_obstacle_boxes.emplace(obstacle->Id(),
+                                    obstacle->PerceptionBoundingBox());
+    }
+  }
+
+  // the reused path only loses points at its front, so it stays collision
+  // free as long as no static obstacle appeared or moved materially
+  bool obstacles_changed =
+      checked_static_obstacle_boxes_.empty() ||
+      static_obstacle_boxes.size() != checked_static_obstacle_boxes_.size();
+  for (const auto& box : static_obstacle_boxes) {
+    if (obstacles_changed) {
+      break;
+    }
+    const auto checked = checked_static_obstacle_boxes_.find(box.first);
+    obstacles_changed =
+        checked == checked_static_obstacle_boxes_.end() ||
+        checked->second.center().DistanceTo(box.second.center()) >
+            kMaxObstacleShift ||
+        std::fabs(common::math::NormalizeAngle(
+            checked->second.heading() - box.second.heading())) >
+            kMaxObstacleRotation ||
+        box.second.length() > checked->second.length() + kMaxObstacleShift ||
+        box.second.width() > checked->second.width() + kMaxObstacleShift;
+  }
+  if (!obstacles_changed) {
+    ADEBUG << "static obstacles unchanged since last collision check";
+    return true;
+  }
+
+  if (!IsCollisionFree(reference_line_info)) {
+    checked_static_obstacle_boxes_.clear();
+    return false;
+  }
+  checked_static_obstacle_boxes_ = std::move(static_obstacle_boxes);
+  return true;
+}
+
 // check the length of the path
 bool PathReuseDecider::NotShortPath(const DiscretizedPath& current_path) {
   // TODO(shu): use gflag
@@ -21,6 +21,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -64,6 +66,9 @@ class PathReuseDecider : public Decider {
   bool IsIgnoredBlockingObstacle(ReferenceLineInfo* const reference_line_info);
   // check if path is collision free
   bool IsCollisionFree(ReferenceLineInfo* const reference_line_info);
+  // check if the reused path is still collision free, skipping the check
+  // while the static obstacles stay where they were when last checked
+  bool IsReusedPathCollisionFree(ReferenceLineInfo* const reference_line_info);
 
   // check path length
   bool NotShortPath(const DiscretizedPath& current_path);
@@ -76,6 +81,9 @@ class PathReuseDecider : public Decider {
   static int reusable_path_counter_;  // count reused path
   static int total_path_counter_;     // count total path
   static bool path_reusable_;
+  // static obstacles the reused path was last checked against
+  static std::unordered_map<std::string, common::math::Box2d>
+      checked_static_obstacle_boxes_;
 };
 
 }  // namespace planning
@@ -16,6 +16,7 @@
 
 #include "modules/planning/tasks/deciders/rule_based_stop_decider/rule_based_stop_decider.h"
 
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -136,6 +137,8 @@ void RuleBasedStopDecider::StopOnSidePass(
     Frame *const frame, ReferenceLineInfo *const reference_line_info) {
   static bool check_clear;
   static common::PathPoint change_lane_stop_path_point;
+  static std::mutex mutex_side_pass;
+  std::lock_guard<std::mutex> lock(mutex_side_pass);
 
   const PathData &path_data = reference_line_info->path_data();
   double stop_s_on_pathdata = 0.0;
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 #include "cyber/common/log.h"
 #include "modules/common/configs/vehicle_config_helper.h"
@@ -50,6 +51,21 @@ Status SpeedLimitDecider::GetSpeedLimits(
 
   const auto& discretized_path = path_data_.discretized_path();
   const auto& frenet_path = path_data_.frenet_frame_path();
+  // shared by the speed bounds deciders of the path
+  const auto& reference_speed_limits =
+      path_data_.ReferenceSpeedLimits(reference_line_);
+
+  // only the obstacles with nudge decisions limit the speed
+  std::vector<const Obstacle*> nudge_obstacles;
+  for (const auto* ptr_obstacle : obstacles.Items()) {
+    if (ptr_obstacle->IsVirtual()) {
+      continue;
+    }
+    if (!ptr_obstacle->LateralDecision().has_nudge()) {
+      continue;
+    }
+    nudge_obstacles.push_back(ptr_obstacle);
+  }
 
   for (uint32_t i = 0; i < discretized_path.size(); ++i) {
     const double path_s = discretized_path.at(i).s();
@@ -62,8 +78,7 @@ Status SpeedLimitDecider::GetSpeedLimits(
     }
 
     // (1) speed limit from map
-    double speed_limit_from_reference_line =
-        reference_line_.GetSpeedLimitFromS(reference_line_s);
+    double speed_limit_from_reference_line = reference_speed_limits[i];
 
     // (2) speed limit from path curvature
     //  -- 2.1: limit by centripetal force (acceleration)
@@ -79,14 +94,7 @@ Status SpeedLimitDecider::GetSpeedLimits(
         std::numeric_limits<double>::max();
     const double collision_safety_range =
         speed_bounds_config_.collision_safety_range();
-    for (const auto* ptr_obstacle : obstacles.Items()) {
-      if (ptr_obstacle->IsVirtual()) {
-        continue;
-      }
-      if (!ptr_obstacle->LateralDecision().has_nudge()) {
-        continue;
-      }
-
+    for (const auto* ptr_obstacle : nudge_obstacles) {
       /* ref line:
        * -------------------------------
        *    start_s   end_s
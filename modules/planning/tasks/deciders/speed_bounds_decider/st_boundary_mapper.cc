@@ -36,6 +36,7 @@
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/proto/decision.pb.h"
 
 namespace apollo {
@@ -44,6 +45,7 @@ namespace planning {
 using apollo::common::ErrorCode;
 using apollo::common::PathPoint;
 using apollo::common::Status;
+using apollo::common::math::AABoxKDTreeParams;
 using apollo::common::math::Box2d;
 using apollo::common::math::Vec2d;
 
@@ -61,6 +63,7 @@ STBoundaryMapper::STBoundaryMapper(
       injector_(injector) {}
 
 Status STBoundaryMapper::ComputeSTBoundary(PathDecision* path_decision) const {
+  PLANNING_PROFILE_SCOPE("ComputeSTBoundary");
   // Sanity checks.
   CHECK_GT(planning_max_time_, 0.0);
   if (path_data_.discretized_path().size() < 2) {
@@ -272,64 +275,60 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
       }
 
       const double step_length = vehicle_param_.front_edge_to_center();
-      auto path_len =
-          std::min(FLAGS_max_trajectory_len, discretized_path.Length());
-      // Go through every point of the ADC's path.
-      for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
-        const auto curr_adc_path_point =
-            discretized_path.Evaluate(path_s + discretized_path.front().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box, l_buffer)) {
-          // Found overlap, start searching with higher resolution
-          const double backward_distance = -step_length;
-          const double forward_distance = vehicle_param_.length() +
-                                          vehicle_param_.width() +
-                                          obs_box.length() + obs_box.width();
-          const double default_min_step = 0.1;  // in meters
-          const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
-
-          bool find_low = false;
-          bool find_high = false;
-          double low_s = std::fmax(0.0, path_s + backward_distance);
-          double high_s =
-              std::fmin(discretized_path.Length(), path_s + forward_distance);
-
-          // Keep shrinking by the resolution bidirectionally until finally
-          // locating the tight upper and lower bounds.
-          while (low_s < high_s) {
-            if (find_low && find_high) {
-              break;
-            }
-            if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.front().s());
-              if (!CheckOverlap(point_low, obs_box, l_buffer)) {
-                low_s += fine_tuning_step_length;
-              } else {
-                find_low = true;
-              }
-            }
-            if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.front().s());
-              if (!CheckOverlap(point_high, obs_box, l_buffer)) {
-                high_s -= fine_tuning_step_length;
-              } else {
-                find_high = true;
-              }
-            }
+      // Find the first point of the ADC's path overlapping with the box.
+      double path_s = 0.0;
+      if (!GetFirstOverlapPathS(discretized_path, obs_box, l_buffer,
+                                &path_s)) {
+        continue;
+      }
+      // Found overlap, start searching with higher resolution
+      const double backward_distance = -step_length;
+      const double forward_distance = vehicle_param_.length() +
+                                      vehicle_param_.width() +
+                                      obs_box.length() + obs_box.width();
+      const double default_min_step = 0.1;  // in meters
+      const double fine_tuning_step_length = std::fmin(
+          default_min_step, discretized_path.Length() / default_num_point);
+
+      bool find_low = false;
+      bool find_high = false;
+      double low_s = std::fmax(0.0, path_s + backward_distance);
+      double high_s =
+          std::fmin(discretized_path.Length(), path_s + forward_distance);
+
+      // Keep shrinking by the resolution bidirectionally until finally
+      // locating the tight upper and lower bounds.
+      while (low_s < high_s) {
+        if (find_low && find_high) {
+          break;
+        }
+        if (!find_low) {
+          const auto& point_low = discretized_path.Evaluate(
+              low_s + discretized_path.front().s());
+          if (!CheckOverlap(point_low, obs_box, l_buffer)) {
+            low_s += fine_tuning_step_length;
+          } else {
+            find_low = true;
           }
-          if (find_high && find_low) {
-            lower_points->emplace_back(
-                low_s - speed_bounds_config_.point_extension(),
-                trajectory_point_time);
-            upper_points->emplace_back(
-                high_s + speed_bounds_config_.point_extension(),
-                trajectory_point_time);
+        }
+        if (!find_high) {
+          const auto& point_high = discretized_path.Evaluate(
+              high_s + discretized_path.front().s());
+          if (!CheckOverlap(point_high, obs_box, l_buffer)) {
+            high_s -= fine_tuning_step_length;
+          } else {
+            find_high = true;
           }
-          break;
         }
       }
+      if (find_high && find_low) {
+        lower_points->emplace_back(
+            low_s - speed_bounds_config_.point_extension(),
+            trajectory_point_time);
+        upper_points->emplace_back(
+            high_s + speed_bounds_config_.point_extension(),
+            trajectory_point_time);
+      }
     }
   }
 
@@ -389,6 +388,12 @@ void STBoundaryMapper::ComputeSTBoundaryWithDecision(
 bool STBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double l_buffer) const {
+  // Check whether ADC bounding box overlaps with obstacle bounding box.
+  return obs_box.HasOverlap(GetADCBoundingBox(path_point, l_buffer));
+}
+
+Box2d STBoundaryMapper::GetADCBoundingBox(const PathPoint& path_point,
+                                          const double l_buffer) const {
   // Convert reference point from center of rear axis to center of ADC.
   Vec2d ego_center_map_frame((vehicle_param_.front_edge_to_center() -
                               vehicle_param_.back_edge_to_center()) *
@@ -401,11 +406,41 @@ bool STBoundaryMapper::CheckOverlap(const PathPoint& path_point,
   ego_center_map_frame.set_y(ego_center_map_frame.y() + path_point.y());
 
   // Compute the ADC bounding box.
-  Box2d adc_box(ego_center_map_frame, path_point.theta(),
-                vehicle_param_.length(), vehicle_param_.width() + l_buffer * 2);
+  return Box2d(ego_center_map_frame, path_point.theta(),
+               vehicle_param_.length(), vehicle_param_.width() + l_buffer * 2);
+}
 
-  // Check whether ADC bounding box overlaps with obstacle bounding box.
-  return obs_box.HasOverlap(adc_box);
+bool STBoundaryMapper::GetFirstOverlapPathS(
+    const DiscretizedPath& discretized_path, const Box2d& obs_box,
+    const double l_buffer, double* path_s) const {
+  if (path_footprint_index_ == nullptr) {
+    const double step_length = vehicle_param_.front_edge_to_center();
+    const double path_len =
+        std::min(FLAGS_max_trajectory_len, discretized_path.Length());
+    for (double s = 0.0; s < path_len; s += step_length) {
+      path_footprints_.emplace_back(
+          s, GetADCBoundingBox(
+                 discretized_path.Evaluate(s + discretized_path.front().s()),
+                 l_buffer));
+    }
+    AABoxKDTreeParams params;
+    params.max_leaf_size = 4;
+    path_footprint_index_.reset(
+        new PathFootprintIndex(path_footprints_, params));
+  }
+
+  // Any ADC box overlapping with the obstacle box is within half of its
+  // diagonal from the obstacle center.
+  bool has_overlap = false;
+  for (const auto* footprint : path_footprint_index_->GetObjects(
+           obs_box.center(), obs_box.diagonal() * 0.5)) {
+    if ((!has_overlap || footprint->path_s() < *path_s) &&
+        obs_box.HasOverlap(footprint->box())) {
+      *path_s = footprint->path_s();
+      has_overlap = true;
+    }
+  }
+  return has_overlap;
 }
 
 }  // namespace planning
@@ -25,9 +25,14 @@
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/vec2d.h"
 #include "modules/common/status/status.h"
 #include "modules/planning/common/dependency_injector.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path/discretized_path.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
@@ -78,6 +83,22 @@ class STBoundaryMapper {
                     const common::math::Box2d& obs_box,
                     const double l_buffer) const;
 
+  /** @brief The ADC bounding box, with the extra lateral buffer, when the
+   *        center of rear-axis is at the given path-point.
+   */
+  common::math::Box2d GetADCBoundingBox(const common::PathPoint& path_point,
+                                        const double l_buffer) const;
+
+  /** @brief Find the smallest sampled s (relative to the path start) at which
+   *        the ADC overlaps with the obstacle bounding box. The ADC boxes
+   *        along the path are indexed on first use, so that only those near
+   *        the obstacle box are checked.
+   * @return false if the ADC does not overlap with the box along the path.
+   */
+  bool GetFirstOverlapPathS(const DiscretizedPath& discretized_path,
+                            const common::math::Box2d& obs_box,
+                            const double l_buffer, double* path_s) const;
+
   /** @brief Maps the closest STOP decision onto the ST-graph. This STOP
    * decision can be stopping for blocking obstacles, or can be due to
    * traffic rules, etc.
@@ -93,6 +114,30 @@ class STBoundaryMapper {
                                      const ObjectDecisionType& decision) const;
 
  private:
+  class PathFootprint {
+   public:
+    PathFootprint(const double path_s, const common::math::Box2d& box)
+        : path_s_(path_s), box_(box), aabox_(box.GetAABox()) {}
+
+    double path_s() const { return path_s_; }
+    const common::math::Box2d& box() const { return box_; }
+    const common::math::AABox2d& aabox() const { return aabox_; }
+
+    double DistanceTo(const common::math::Vec2d& point) const {
+      return box_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d& point) const {
+      const double distance = box_.DistanceTo(point);
+      return distance * distance;
+    }
+
+   private:
+    double path_s_;
+    common::math::Box2d box_;
+    common::math::AABox2d aabox_;
+  };
+  using PathFootprintIndex = common::math::AABoxKDTree2d<PathFootprint>;
+
   const SpeedBoundsDeciderConfig& speed_bounds_config_;
   const ReferenceLine& reference_line_;
   const PathData& path_data_;
@@ -100,6 +145,10 @@ class STBoundaryMapper {
   const double planning_max_distance_;
   const double planning_max_time_;
   std::shared_ptr<DependencyInjector> injector_;
+
+  // ADC boxes at the sampled path points, built by the first moving obstacle.
+  mutable std::vector<PathFootprint> path_footprints_;
+  mutable std::unique_ptr<PathFootprintIndex> path_footprint_index_;
 };
 
 }  // namespace planning
@@ -38,11 +38,13 @@ void STGuideLine::Init(
   t0_ = 0.0;
   v0_ = desired_v;
   DiscretizedTrajectory discrete_speed_reference(speed_reference);
+  discrete_speed_reference.BuildTimeIndex();
   double total_time = discrete_speed_reference.GetTemporalLength();
   guideline_speed_data_.clear();
+  size_t hint = 0;
   for (double t = 0; t <= total_time; t += kSpeedGuideLineResolution) {
     const common::TrajectoryPoint trajectory_point =
-        discrete_speed_reference.Evaluate(t);
+        discrete_speed_reference.Evaluate(t, &hint);
     guideline_speed_data_.AppendSpeedPoint(
         trajectory_point.path_point().s(), trajectory_point.relative_time(),
         trajectory_point.v(), trajectory_point.a(), trajectory_point.da());
@@ -59,6 +59,9 @@ Status OpenSpaceTrajectoryOptimizer::Plan(
     const Eigen::MatrixXd& obstacles_A, const Eigen::MatrixXd& obstacles_b,
     const std::vector<std::vector<Vec2d>>& obstacles_vertices_vec,
     double* time_latency) {
+  latency_stats_.Clear();
+  cancel_requested_.store(false);
+
   if (XYbounds.empty() || end_pose.empty() || obstacles_edges_num.cols() == 0 ||
       obstacles_A.cols() == 0 || obstacles_b.cols() == 0) {
     ADEBUG << "OpenSpaceTrajectoryOptimizer input data not ready";
@@ -111,6 +114,15 @@ Status OpenSpaceTrajectoryOptimizer::Plan(
     return Status(ErrorCode::PLANNING_ERROR,
                   "State warm start problem failed to solve");
   }
+  const auto warm_start_timestamp = std::chrono::system_clock::now();
+  RecordLatency("HybridAStar", start_timestamp, warm_start_timestamp);
+
+  if (warm_start_callback_) {
+    PublishWarmStartTrajectory(result, rotate_angle, translate_origin);
+  }
+  if (cancel_requested_) {
+    return Status(ErrorCode::OK, "Open space trajectory generation cancelled");
+  }
 
   // Containers for distance approach trajectory smoothing problem
   Eigen::MatrixXd xWS;
@@ -151,6 +163,10 @@ Status OpenSpaceTrajectoryOptimizer::Plan(
     // In for loop
     ADEBUG << "Trajectories size in smoother is " << size;
     for (size_t i = 0; i < size; ++i) {
+      if (cancel_requested_) {
+        return Status(ErrorCode::OK,
+                      "Open space trajectory generation cancelled");
+      }
       LoadHybridAstarResultInEigen(&partition_trajectories[i], &xWS_vec[i],
                                    &uWS_vec[i]);
       // checking initial and ending points
@@ -263,6 +279,8 @@ Status OpenSpaceTrajectoryOptimizer::Plan(
                     "distance approach smoothing problem failed to solve");
     }
   }
+  RecordLatency("TrajectorySmoother", warm_start_timestamp,
+                std::chrono::system_clock::now());
 
   // record debug info
   if (FLAGS_enable_record_debug) {
@@ -281,7 +299,8 @@ Status OpenSpaceTrajectoryOptimizer::Plan(
                            &(state_result_ds(2, i)));
   }
 
-  LoadTrajectory(state_result_ds, control_result_ds, time_result_ds);
+  LoadTrajectory(state_result_ds, control_result_ds, time_result_ds,
+                 &optimized_trajectory_);
 
   const auto end_timestamp = std::chrono::system_clock::now();
   std::chrono::duration<double> diff = end_timestamp - start_timestamp;
@@ -474,8 +493,8 @@ void OpenSpaceTrajectoryOptimizer::PathPointDeNormalizing(
 
 void OpenSpaceTrajectoryOptimizer::LoadTrajectory(
     const Eigen::MatrixXd& state_result, const Eigen::MatrixXd& control_result,
-    const Eigen::MatrixXd& time_result) {
-  optimized_trajectory_.clear();
+    const Eigen::MatrixXd& time_result, DiscretizedTrajectory* trajectory) {
+  trajectory->clear();
 
   // Optimizer doesn't take end condition control state into consideration for
   // now
@@ -512,11 +531,54 @@ void OpenSpaceTrajectoryOptimizer::LoadTrajectory(
       point.set_relative_time(relative_time);
     }
 
-    optimized_trajectory_.emplace_back(point);
+    trajectory->emplace_back(point);
     last_path_point = cur_path_point;
   }
 }
 
+void OpenSpaceTrajectoryOptimizer::PublishWarmStartTrajectory(
+    const HybridAStartResult& result, const double rotate_angle,
+    const Vec2d& translate_origin) {
+  const size_t states_size = result.x.size();
+  if (states_size < 2) {
+    return;
+  }
+  // hybrid a star points are evenly spaced by delta_t
+  Eigen::MatrixXd state_result(4, states_size);
+  Eigen::MatrixXd control_result(2, states_size - 1);
+  const Eigen::MatrixXd time_result = Eigen::MatrixXd::Constant(
+      1, states_size - 1, config_.planner_open_space_config().delta_t());
+  for (size_t i = 0; i < states_size; ++i) {
+    state_result(0, i) = result.x[i];
+    state_result(1, i) = result.y[i];
+    state_result(2, i) = result.phi[i];
+    state_result(3, i) = result.v[i];
+    PathPointDeNormalizing(rotate_angle, translate_origin,
+                           &(state_result(0, i)), &(state_result(1, i)),
+                           &(state_result(2, i)));
+  }
+  for (size_t i = 0; i + 1 < states_size; ++i) {
+    control_result(0, i) = result.steer[i];
+    control_result(1, i) = result.a[i];
+  }
+
+  DiscretizedTrajectory warm_start_trajectory;
+  LoadTrajectory(state_result, control_result, time_result,
+                 &warm_start_trajectory);
+  warm_start_callback_(warm_start_trajectory);
+}
+
+void OpenSpaceTrajectoryOptimizer::RecordLatency(
+    const std::string& name,
+    const std::chrono::system_clock::time_point& start_timestamp,
+    const std::chrono::system_clock::time_point& end_timestamp) {
+  auto* task_stats = latency_stats_.add_task_stats();
+  task_stats->set_name(name);
+  task_stats->set_time_ms(std::chrono::duration<double, std::milli>(
+                              end_timestamp - start_timestamp)
+                              .count());
+}
+
 void OpenSpaceTrajectoryOptimizer::UseWarmStartAsResult(
     const Eigen::MatrixXd& xWS, const Eigen::MatrixXd& uWS,
     const Eigen::MatrixXd& l_warm_up, const Eigen::MatrixXd& n_warm_up,
@@ -20,7 +20,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "Eigen/Eigen"
@@ -38,6 +42,7 @@
 #include "modules/planning/open_space/trajectory_smoother/dual_variable_warm_start_problem.h"
 #include "modules/planning/open_space/trajectory_smoother/iterative_anchoring_smoother.h"
 #include "modules/planning/proto/open_space_task_config.pb.h"
+#include "modules/planning/proto/planning.pb.h"
 
 namespace apollo {
 namespace planning {
@@ -90,6 +95,26 @@ class OpenSpaceTrajectoryOptimizer {
     return &open_space_debug_;
   }
 
+  /**
+   * @brief set a callback receiving the hybrid a star trajectory in world
+   * frame as soon as the warm start is solved, before it is smoothed. It is
+   * called from the thread running Plan().
+   */
+  void SetWarmStartCallback(
+      const std::function<void(const DiscretizedTrajectory&)>& callback) {
+    warm_start_callback_ = callback;
+  }
+
+  /**
+   * @brief stop the Plan() in flight at its next phase boundary, Plan() then
+   * returns an OK error code without a new trajectory.
+   */
+  void RequestCancel() { cancel_requested_.store(true); }
+
+  void GetLatencyStats(LatencyStats* latency_stats) const {
+    *latency_stats = latency_stats_;
+  }
+
  private:
   bool IsInitPointNearDestination(
       const common::TrajectoryPoint& planning_init_point,
@@ -106,7 +131,17 @@ class OpenSpaceTrajectoryOptimizer {
 
   void LoadTrajectory(const Eigen::MatrixXd& state_result_ds,
                       const Eigen::MatrixXd& control_result_ds,
-                      const Eigen::MatrixXd& time_result_ds);
+                      const Eigen::MatrixXd& time_result_ds,
+                      DiscretizedTrajectory* trajectory);
+
+  void PublishWarmStartTrajectory(const HybridAStartResult& result,
+                                  const double rotate_angle,
+                                  const common::math::Vec2d& translate_origin);
+
+  void RecordLatency(
+      const std::string& name,
+      const std::chrono::system_clock::time_point& start_timestamp,
+      const std::chrono::system_clock::time_point& end_timestamp);
 
   void LoadHybridAstarResultInEigen(HybridAStartResult* result,
                                     Eigen::MatrixXd* xWS, Eigen::MatrixXd* uWS);
@@ -171,6 +206,10 @@ class OpenSpaceTrajectoryOptimizer {
   DiscretizedTrajectory optimized_trajectory_;
 
   apollo::planning_internal::OpenSpaceDebug open_space_debug_;
+
+  std::function<void(const DiscretizedTrajectory&)> warm_start_callback_;
+  std::atomic<bool> cancel_requested_{false};
+  LatencyStats latency_stats_;
 };
 }  // namespace planning
 }  // namespace apollo
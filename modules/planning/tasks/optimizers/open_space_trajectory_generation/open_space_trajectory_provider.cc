@@ -46,6 +46,20 @@ OpenSpaceTrajectoryProvider::OpenSpaceTrajectoryProvider(
   open_space_trajectory_optimizer_.reset(new OpenSpaceTrajectoryOptimizer(
       config.open_space_trajectory_provider_config()
           .open_space_trajectory_optimizer_config()));
+  if (FLAGS_enable_open_space_planner_thread &&
+      FLAGS_enable_open_space_anytime_planning) {
+    // runs on the generation thread inside Plan(), so the optimizer's
+    // stitching trajectory and latency stats belong to the plan in flight
+    open_space_trajectory_optimizer_->SetWarmStartCallback(
+        [this](const DiscretizedTrajectory& warm_start_trajectory) {
+          std::lock_guard<std::mutex> lock(open_space_mutex_);
+          warm_start_trajectory_ = warm_start_trajectory;
+          open_space_trajectory_optimizer_->GetStitchingTrajectory(
+              &warm_start_stitching_trajectory_);
+          open_space_trajectory_optimizer_->GetLatencyStats(&latency_stats_);
+          warm_start_updated_.store(true);
+        });
+  }
 }
 
 OpenSpaceTrajectoryProvider::~OpenSpaceTrajectoryProvider() {
@@ -57,12 +71,14 @@ OpenSpaceTrajectoryProvider::~OpenSpaceTrajectoryProvider() {
 void OpenSpaceTrajectoryProvider::Stop() {
   if (FLAGS_enable_open_space_planner_thread) {
     is_generation_thread_stop_.store(true);
+    open_space_trajectory_optimizer_->RequestCancel();
     if (thread_init_flag_) {
       task_future_.get();
     }
     trajectory_updated_.store(false);
     trajectory_error_.store(false);
     trajectory_skipped_.store(false);
+    warm_start_updated_.store(false);
     optimizer_thread_counter = 0;
   }
 }
@@ -70,6 +86,7 @@ void OpenSpaceTrajectoryProvider::Stop() {
 void OpenSpaceTrajectoryProvider::Restart() {
   if (FLAGS_enable_open_space_planner_thread) {
     is_generation_thread_stop_.store(true);
+    open_space_trajectory_optimizer_->RequestCancel();
     if (thread_init_flag_) {
       task_future_.get();
     }
@@ -78,6 +95,7 @@ void OpenSpaceTrajectoryProvider::Restart() {
     trajectory_updated_.store(false);
     trajectory_error_.store(false);
     trajectory_skipped_.store(false);
+    warm_start_updated_.store(false);
     optimizer_thread_counter = 0;
   }
 }
@@ -126,6 +144,10 @@ Status OpenSpaceTrajectoryProvider::Process() {
         &last_frame_complete_trajectory, &replan_reason);
   } else {
     ADEBUG << "Replan due to fallback stop";
+    if (FLAGS_enable_open_space_planner_thread) {
+      // the plan in flight starts from the abandoned stitching point
+      open_space_trajectory_optimizer_->RequestCancel();
+    }
     const double planning_cycle_time =
         1.0 / static_cast<double>(FLAGS_planning_loop_rate);
     stitching_trajectory = TrajectoryStitcher::ComputeReinitStitchingTrajectory(
@@ -167,6 +189,7 @@ Status OpenSpaceTrajectoryProvider::Process() {
             open_space_info.origin_heading(), open_space_info.origin_point())) {
       GenerateStopTrajectory(trajectory_data);
       is_generation_thread_stop_.store(true);
+      open_space_trajectory_optimizer_->RequestCancel();
       return Status(ErrorCode::OK, "Vehicle is near to destination");
     }
 
@@ -174,6 +197,8 @@ Status OpenSpaceTrajectoryProvider::Process() {
     if (trajectory_updated_) {
       std::lock_guard<std::mutex> lock(open_space_mutex_);
       LoadResult(trajectory_data);
+      *(frame_->mutable_open_space_info()->mutable_latency_stats()) =
+          latency_stats_;
       if (FLAGS_enable_record_debug) {
         // call merge debug ptr, open_space_trajectory_optimizer_
         auto* ptr_debug = frame_->mutable_open_space_info()->mutable_debug();
@@ -184,6 +209,7 @@ Status OpenSpaceTrajectoryProvider::Process() {
         frame_->mutable_open_space_info()->sync_debug_instance();
       }
       data_ready_.store(false);
+      warm_start_updated_.store(false);
       trajectory_updated_.store(false);
       return Status::OK();
     }
@@ -202,6 +228,19 @@ Status OpenSpaceTrajectoryProvider::Process() {
       }
     }
 
+    // Publish the hybrid a star trajectory until the smoothed one is ready,
+    // later frames keep reusing it as the last successful result
+    if (warm_start_updated_) {
+      std::lock_guard<std::mutex> lock(open_space_mutex_);
+      LoadWarmStartResult(trajectory_data);
+      *(frame_->mutable_open_space_info()->mutable_latency_stats()) =
+          latency_stats_;
+      warm_start_updated_.store(false);
+      return Status(ErrorCode::OK,
+                    "Use warm start trajectory while smoothing in "
+                    "open_space_trajectory_provider");
+    }
+
     if (previous_frame->open_space_info().open_space_provider_success()) {
       ReuseLastFrameResult(previous_frame, trajectory_data);
       if (FLAGS_enable_record_debug) {
@@ -241,6 +280,8 @@ Status OpenSpaceTrajectoryProvider::Process() {
         translate_origin, obstacles_edges_num, obstacles_A, obstacles_b,
         obstacles_vertices_vec, &time_latency);
     frame_->mutable_open_space_info()->set_time_latency(time_latency);
+    open_space_trajectory_optimizer_->GetLatencyStats(
+        frame_->mutable_open_space_info()->mutable_latency_stats());
 
     // If status is OK, update vehicle trajectory;
     if (status == Status::OK()) {
@@ -271,6 +312,7 @@ void OpenSpaceTrajectoryProvider::GenerateTrajectoryThread() {
       frame_->mutable_open_space_info()->set_time_latency(time_latency);
       if (status == Status::OK()) {
         std::lock_guard<std::mutex> lock(open_space_mutex_);
+        open_space_trajectory_optimizer_->GetLatencyStats(&latency_stats_);
         trajectory_updated_.store(true);
       } else {
         if (status.ok()) {
@@ -387,6 +429,25 @@ void OpenSpaceTrajectoryProvider::LoadResult(
       optimizer_trajectory_ptr);
   open_space_trajectory_optimizer_->GetStitchingTrajectory(
       stitching_trajectory_ptr);
+  StitchResult(trajectory_data);
+}
+
+void OpenSpaceTrajectoryProvider::LoadWarmStartResult(
+    DiscretizedTrajectory* const trajectory_data) {
+  trajectory_data->clear();
+  *(frame_->mutable_open_space_info()->mutable_optimizer_trajectory_data()) =
+      warm_start_trajectory_;
+  *(frame_->mutable_open_space_info()->mutable_stitching_trajectory_data()) =
+      warm_start_stitching_trajectory_;
+  StitchResult(trajectory_data);
+}
+
+void OpenSpaceTrajectoryProvider::StitchResult(
+    DiscretizedTrajectory* const trajectory_data) {
+  auto optimizer_trajectory_ptr =
+      frame_->mutable_open_space_info()->mutable_optimizer_trajectory_data();
+  auto stitching_trajectory_ptr =
+      frame_->mutable_open_space_info()->mutable_stitching_trajectory_data();
   // Stitch two trajectories and load back to trajectory_data from frame
   size_t optimizer_trajectory_size = optimizer_trajectory_ptr->size();
   double stitching_point_relative_time =
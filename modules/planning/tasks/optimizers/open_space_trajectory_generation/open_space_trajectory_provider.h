@@ -74,6 +74,10 @@ class OpenSpaceTrajectoryProvider : public TrajectoryOptimizer {
 
   void LoadResult(DiscretizedTrajectory* const trajectory_data);
 
+  void LoadWarmStartResult(DiscretizedTrajectory* const trajectory_data);
+
+  void StitchResult(DiscretizedTrajectory* const trajectory_data);
+
   void ReuseLastFrameResult(const Frame* last_frame,
                             DiscretizedTrajectory* const trajectory_data);
 
@@ -95,6 +99,12 @@ class OpenSpaceTrajectoryProvider : public TrajectoryOptimizer {
   std::atomic<bool> trajectory_error_{false};
   std::atomic<bool> trajectory_skipped_{false};
   std::mutex open_space_mutex_;
+
+  // result of the warm start of the plan in flight in anytime mode
+  DiscretizedTrajectory warm_start_trajectory_;
+  std::vector<common::TrajectoryPoint> warm_start_stitching_trajectory_;
+  std::atomic<bool> warm_start_updated_{false};
+  LatencyStats latency_stats_;
 };
 
 }  // namespace planning
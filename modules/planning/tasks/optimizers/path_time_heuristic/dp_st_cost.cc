@@ -44,24 +44,57 @@ DpStCost::DpStCost(const DpStSpeedOptimizerConfig& config, const double total_t,
       init_point_(init_point),
       unit_t_(config.unit_t()),
       total_s_(total_s) {
-  int index = 0;
-  for (const auto& obstacle : obstacles) {
-    boundary_map_[obstacle->path_st_boundary().id()] = index++;
-  }
-
   AddToKeepClearRange(obstacles);
 
   const auto dimension_t =
       static_cast<uint32_t>(std::ceil(total_t / static_cast<double>(unit_t_))) +
       1;
-  boundary_cost_.resize(obstacles_.size());
-  for (auto& vec : boundary_cost_) {
-    vec.resize(dimension_t, std::make_pair(-1.0, -1.0));
-  }
+  InitObstacleSlices(dimension_t);
   accel_cost_.fill(-1.0);
   jerk_cost_.fill(-1.0);
 }
 
+void DpStCost::InitObstacleSlices(const uint32_t dimension_t) {
+  std::vector<const STBoundary*> boundaries;
+  for (const auto* obstacle : obstacles_) {
+    // Not applying obstacle approaching cost to virtual obstacle like created
+    // stop fences
+    if (obstacle->IsVirtual()) {
+      continue;
+    }
+    // Stop obstacles are assumed to have a safety margin when mapping them out,
+    // so repelling force in dp st is not needed as it is designed to have adc
+    // stop right at the stop distance we design in prior mapping process
+    if (obstacle->LongitudinalDecision().has_stop()) {
+      continue;
+    }
+    if (obstacle->path_st_boundary().min_s() >
+        FLAGS_speed_lon_decision_horizon) {
+      continue;
+    }
+    boundaries.push_back(&obstacle->path_st_boundary());
+  }
+
+  slice_offsets_.assign(dimension_t + 1, 0);
+  slice_obstacles_.clear();
+  // same accumulation of t as the cost table of the graph
+  double t = 0.0;
+  for (uint32_t i = 0; i < dimension_t; ++i, t += unit_t_) {
+    slice_offsets_[i] = slice_obstacles_.size();
+    for (const auto* boundary : boundaries) {
+      if (t < boundary->min_t() || t > boundary->max_t()) {
+        continue;
+      }
+      SliceObstacle slice_obstacle;
+      slice_obstacle.boundary = boundary;
+      boundary->GetBoundarySRange(t, &slice_obstacle.s_upper,
+                                  &slice_obstacle.s_lower);
+      slice_obstacles_.push_back(slice_obstacle);
+    }
+  }
+  slice_offsets_[dimension_t] = slice_obstacles_.size();
+}
+
 void DpStCost::AddToKeepClearRange(
     const std::vector<const Obstacle*>& obstacles) {
   for (const auto& obstacle : obstacles) {
@@ -130,45 +163,22 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
     }
   }
 
-  for (const auto* obstacle : obstacles_) {
-    // Not applying obstacle approaching cost to virtual obstacle like created
-    // stop fences
-    if (obstacle->IsVirtual()) {
-      continue;
-    }
-
-    // Stop obstacles are assumed to have a safety margin when mapping them out,
-    // so repelling force in dp st is not needed as it is designed to have adc
-    // stop right at the stop distance we design in prior mapping process
-    if (obstacle->LongitudinalDecision().has_stop()) {
-      continue;
-    }
-
-    auto boundary = obstacle->path_st_boundary();
-
-    if (boundary.min_s() > FLAGS_speed_lon_decision_horizon) {
-      continue;
-    }
-    if (t < boundary.min_t() || t > boundary.max_t()) {
-      continue;
-    }
-    if (boundary.IsPointInBoundary(st_graph_point.point())) {
+  const uint32_t index_t = st_graph_point.index_t();
+  if (index_t + 1 >= slice_offsets_.size()) {
+    return cost;
+  }
+  const double follow_distance_s = config_.safe_distance();
+  const double overtake_distance_s =
+      StGapEstimator::EstimateSafeOvertakingGap();
+  for (size_t i = slice_offsets_[index_t]; i < slice_offsets_[index_t + 1];
+       ++i) {
+    const auto& slice_obstacle = slice_obstacles_[i];
+    if (slice_obstacle.boundary->IsPointInBoundary(st_graph_point.point())) {
       return kInf;
     }
-    double s_upper = 0.0;
-    double s_lower = 0.0;
-
-    int boundary_index = boundary_map_[boundary.id()];
-    if (boundary_cost_[boundary_index][st_graph_point.index_t()].first < 0.0) {
-      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
-      boundary_cost_[boundary_index][st_graph_point.index_t()] =
-          std::make_pair(s_upper, s_lower);
-    } else {
-      s_upper = boundary_cost_[boundary_index][st_graph_point.index_t()].first;
-      s_lower = boundary_cost_[boundary_index][st_graph_point.index_t()].second;
-    }
+    const double s_upper = slice_obstacle.s_upper;
+    const double s_lower = slice_obstacle.s_lower;
     if (s < s_lower) {
-      const double follow_distance_s = config_.safe_distance();
       if (s + follow_distance_s < s_lower) {
         continue;
       } else {
@@ -177,8 +187,6 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
                 s_diff * s_diff;
       }
     } else if (s > s_upper) {
-      const double overtake_distance_s =
-          StGapEstimator::EstimateSafeOvertakingGap();
       if (s > s_upper + overtake_distance_s) {  // or calculated from velocity
         continue;
       } else {
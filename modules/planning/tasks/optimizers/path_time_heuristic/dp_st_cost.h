@@ -20,8 +20,6 @@
 
 #pragma once
 
-#include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -74,6 +72,15 @@ class DpStCost {
   double GetAccelCost(const double accel);
   double JerkCost(const double jerk);
 
+  // obstacle of one time slice and its s range at that time
+  struct SliceObstacle {
+    const STBoundary* boundary = nullptr;
+    double s_upper = 0.0;
+    double s_lower = 0.0;
+  };
+
+  void InitObstacleSlices(const uint32_t dimension_t);
+
   void AddToKeepClearRange(const std::vector<const Obstacle*>& obstacles);
   static void SortAndMergeRange(
       std::vector<std::pair<double, double>>* keep_clear_range_);
@@ -89,8 +96,10 @@ class DpStCost {
   double unit_t_ = 0.0;
   double total_s_ = 0.0;
 
-  std::unordered_map<std::string, int> boundary_map_;
-  std::vector<std::vector<std::pair<double, double>>> boundary_cost_;
+  // obstacles costing time slice i are slice_obstacles_[slice_offsets_[i]]
+  // up to slice_obstacles_[slice_offsets_[i + 1]]
+  std::vector<size_t> slice_offsets_;
+  std::vector<SliceObstacle> slice_obstacles_;
 
   std::vector<std::pair<double, double>> keep_clear_range_;
 
@@ -30,6 +30,7 @@
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/util/point_factory.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 
 namespace apollo {
 namespace planning {
@@ -91,6 +92,7 @@ GriddedPathTimeGraph::GriddedPathTimeGraph(
 }
 
 Status GriddedPathTimeGraph::Search(SpeedData* const speed_data) {
+  PLANNING_PROFILE_SCOPE("DpStSearch");
   static constexpr double kBounadryEpsilon = 1e-2;
   for (const auto& boundary : st_graph_data_.st_boundaries()) {
     // KeepClear obstacles not considered in Dp St decision
@@ -183,27 +185,26 @@ Status GriddedPathTimeGraph::InitCostTable() {
     return Status(ErrorCode::PLANNING_ERROR, msg);
   }
 
-  cost_table_ = std::vector<std::vector<StGraphPoint>>(
-      dimension_t_, std::vector<StGraphPoint>(dimension_s_, StGraphPoint()));
+  cost_table_.Reset(dimension_t_, dimension_s_);
 
   double curr_t = 0.0;
-  for (uint32_t i = 0; i < cost_table_.size(); ++i, curr_t += unit_t_) {
-    auto& cost_table_i = cost_table_[i];
+  for (uint32_t i = 0; i < dimension_t_; ++i, curr_t += unit_t_) {
+    auto* cost_table_i = cost_table_[i];
     double curr_s = 0.0;
     for (uint32_t j = 0; j < dense_dimension_s_; ++j, curr_s += dense_unit_s_) {
       cost_table_i[j].Init(i, j, STPoint(curr_s, curr_t));
     }
     curr_s = static_cast<double>(dense_dimension_s_ - 1) * dense_unit_s_ +
              sparse_unit_s_;
-    for (uint32_t j = dense_dimension_s_; j < cost_table_i.size();
+    for (uint32_t j = dense_dimension_s_; j < dimension_s_;
          ++j, curr_s += sparse_unit_s_) {
       cost_table_i[j].Init(i, j, STPoint(curr_s, curr_t));
     }
   }
 
-  const auto& cost_table_0 = cost_table_[0];
-  spatial_distance_by_index_ = std::vector<double>(cost_table_0.size(), 0.0);
-  for (uint32_t i = 0; i < cost_table_0.size(); ++i) {
+  const auto* cost_table_0 = cost_table_[0];
+  spatial_distance_by_index_ = std::vector<double>(dimension_s_, 0.0);
+  for (uint32_t i = 0; i < dimension_s_; ++i) {
     spatial_distance_by_index_[i] = cost_table_0[i].point().s();
   }
   return Status::OK();
@@ -229,27 +230,36 @@ Status GriddedPathTimeGraph::CalculateTotalCost() {
   size_t next_highest_row = 0;
   size_t next_lowest_row = 0;
 
-  for (size_t c = 0; c < cost_table_.size(); ++c) {
+  // rows of one column only read the previous columns, so a column can be
+  // split into independent blocks of rows
+  constexpr size_t kMinRowsPerTask = 8;
+
+  for (size_t c = 0; c < dimension_t_; ++c) {
     size_t highest_row = 0;
-    size_t lowest_row = cost_table_.back().size() - 1;
+    size_t lowest_row = dimension_s_ - 1;
 
     int count = static_cast<int>(next_highest_row) -
                 static_cast<int>(next_lowest_row) + 1;
     if (count > 0) {
-      std::vector<std::future<void>> results;
-      for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
-        auto msg = std::make_shared<StGraphMessage>(c, r);
-        if (FLAGS_enable_multi_thread_in_dp_st_graph) {
+      if (FLAGS_enable_multi_thread_in_dp_st_graph &&
+          static_cast<size_t>(count) > kMinRowsPerTask) {
+        std::vector<std::future<void>> results;
+        for (size_t r = next_lowest_row; r <= next_highest_row;
+             r += kMinRowsPerTask) {
+          const size_t r_end =
+              std::min(r + kMinRowsPerTask - 1, next_highest_row);
           results.push_back(
-              cyber::Async(&GriddedPathTimeGraph::CalculateCostAt, this, msg));
-        } else {
-          CalculateCostAt(msg);
+              cyber::Async(&GriddedPathTimeGraph::CalculateCostInRows, this,
+                           static_cast<uint32_t>(c), static_cast<uint32_t>(r),
+                           static_cast<uint32_t>(r_end)));
         }
-      }
-      if (FLAGS_enable_multi_thread_in_dp_st_graph) {
         for (auto& result : results) {
           result.get();
         }
+      } else {
+        CalculateCostInRows(static_cast<uint32_t>(c),
+                            static_cast<uint32_t>(next_lowest_row),
+                            static_cast<uint32_t>(next_highest_row));
       }
     }
 
@@ -314,10 +324,15 @@ void GriddedPathTimeGraph::GetRowRange(const StGraphPoint& point,
   }
 }
 
-void GriddedPathTimeGraph::CalculateCostAt(
-    const std::shared_ptr<StGraphMessage>& msg) {
-  const uint32_t c = msg->c;
-  const uint32_t r = msg->r;
+void GriddedPathTimeGraph::CalculateCostInRows(const uint32_t c,
+                                               const uint32_t lowest_row,
+                                               const uint32_t highest_row) {
+  for (uint32_t r = lowest_row; r <= highest_row; ++r) {
+    CalculateCostAt(c, r);
+  }
+}
+
+void GriddedPathTimeGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
   auto& cost_cr = cost_table_[c][r];
 
   cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
@@ -381,7 +396,7 @@ void GriddedPathTimeGraph::CalculateCostAt(
         std::distance(spatial_distance_by_index_.begin(), pre_lowest_itr));
   }
   const uint32_t r_pre_size = r - r_low + 1;
-  const auto& pre_col = cost_table_[c - 1];
+  const auto* pre_col = cost_table_[c - 1];
   double curr_speed_limit = speed_limit;
 
   if (c == 2) {
@@ -497,7 +512,9 @@ void GriddedPathTimeGraph::CalculateCostAt(
 Status GriddedPathTimeGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
   double min_cost = std::numeric_limits<double>::infinity();
   const StGraphPoint* best_end_point = nullptr;
-  for (const StGraphPoint& cur_point : cost_table_.back()) {
+  const StGraphPoint* last_col = cost_table_[dimension_t_ - 1];
+  for (uint32_t r = 0; r < dimension_s_; ++r) {
+    const StGraphPoint& cur_point = last_col[r];
     if (!std::isinf(cur_point.total_cost()) &&
         cur_point.total_cost() < min_cost) {
       best_end_point = &cur_point;
@@ -505,8 +522,8 @@ Status GriddedPathTimeGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
     }
   }
 
-  for (const auto& row : cost_table_) {
-    const StGraphPoint& cur_point = row.back();
+  for (uint32_t c = 0; c < dimension_t_; ++c) {
+    const StGraphPoint& cur_point = cost_table_[c][dimension_s_ - 1];
     if (!std::isinf(cur_point.total_cost()) &&
         cur_point.total_cost() < min_cost) {
       best_end_point = &cur_point;
@@ -20,7 +20,6 @@
 
 #pragma once
 
-#include <memory>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
@@ -58,13 +57,11 @@ class GriddedPathTimeGraph {
 
   common::Status CalculateTotalCost();
 
-  // defined for cyber task
-  struct StGraphMessage {
-    StGraphMessage(const uint32_t c_, const int32_t r_) : c(c_), r(r_) {}
-    uint32_t c;
-    uint32_t r;
-  };
-  void CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg);
+  // evaluates rows [lowest_row, highest_row] of column c, one cyber task
+  // takes a block of rows instead of a single cell
+  void CalculateCostInRows(const uint32_t c, const uint32_t lowest_row,
+                           const uint32_t highest_row);
+  void CalculateCostAt(const uint32_t c, const uint32_t r);
 
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
                            const STPoint& third, const STPoint& forth,
@@ -118,9 +115,30 @@ class GriddedPathTimeGraph {
   double max_acceleration_ = 0.0;
   double max_deceleration_ = 0.0;
 
+  // all points of the graph in one contiguous block, column after column,
+  // so a column is a plain array and the table is allocated only once
+  class CostTable {
+   public:
+    void Reset(const uint32_t dimension_t, const uint32_t dimension_s) {
+      dimension_s_ = dimension_s;
+      points_.assign(static_cast<size_t>(dimension_t) * dimension_s,
+                     StGraphPoint());
+    }
+    StGraphPoint* operator[](const size_t c) {
+      return points_.data() + c * dimension_s_;
+    }
+    const StGraphPoint* operator[](const size_t c) const {
+      return points_.data() + c * dimension_s_;
+    }
+
+   private:
+    std::vector<StGraphPoint> points_;
+    size_t dimension_s_ = 0;
+  };
+
   // cost_table_[t][s]
   // row: s, col: t --- NOTICE: Please do NOT change.
-  std::vector<std::vector<StGraphPoint>> cost_table_;
+  CostTable cost_table_;
 };
 
 }  // namespace planning
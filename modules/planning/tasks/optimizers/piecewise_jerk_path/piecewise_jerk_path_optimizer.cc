@@ -27,6 +27,7 @@
 #include "modules/common/util/point_factory.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/common/speed/speed_data.h"
 #include "modules/planning/common/trajectory1d/piecewise_jerk_trajectory1d.h"
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_path_problem.h"
@@ -168,8 +169,11 @@ common::Status PiecewiseJerkPathOptimizer::Process(
     bool res_opt = OptimizePath(
         init_frenet_state.second, end_state, std::move(path_reference_l),
         path_reference_size, path_boundary.delta_s(), is_valid_path_reference,
-        path_boundary.boundary(), ddl_bounds, w, max_iter, &opt_l, &opt_dl,
-        &opt_ddl);
+        path_boundary.boundary(), ddl_bounds, w, max_iter,
+        FLAGS_enable_piecewise_jerk_warm_start
+            ? &workspaces_[path_boundary.label()]
+            : nullptr,
+        path_boundary.start_s(), &opt_l, &opt_dl, &opt_ddl);
 
     if (res_opt) {
       for (size_t i = 0; i < path_boundary_size; i += 4) {
@@ -239,8 +243,10 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
     const double delta_s, const bool is_valid_path_reference,
     const std::vector<std::pair<double, double>>& lat_boundaries,
     const std::vector<std::pair<double, double>>& ddl_bounds,
-    const std::array<double, 5>& w, const int max_iter, std::vector<double>* x,
-    std::vector<double>* dx, std::vector<double>* ddx) {
+    const std::array<double, 5>& w, const int max_iter,
+    PiecewiseJerkWorkspace* workspace, const double start_s,
+    std::vector<double>* x, std::vector<double>* dx, std::vector<double>* ddx) {
+  PLANNING_PROFILE_SCOPE("OptimizePath");
   // num of knots
   const size_t kNumKnots = lat_boundaries.size();
   PiecewiseJerkPathProblem piecewise_jerk_problem(kNumKnots, delta_s,
@@ -307,6 +313,10 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
                                                  axis_distance, max_yaw_rate);
   piecewise_jerk_problem.set_dddx_bound(jerk_bound);
 
+  if (workspace != nullptr) {
+    piecewise_jerk_problem.set_workspace(workspace, start_s);
+  }
+
   bool success = piecewise_jerk_problem.Optimize(max_iter);
 
   auto end_time = std::chrono::system_clock::now();
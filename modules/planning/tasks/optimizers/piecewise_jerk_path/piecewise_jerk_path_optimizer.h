@@ -21,9 +21,12 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -63,6 +66,8 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
    * @param ddl_bounds: constains
    * @param w: weighting scales
    * @param max_iter: optimization max interations
+   * @param workspace: solver workspace of the previous cycles, or nullptr
+   * @param start_s: s of the first knot, warm starts from workspace
    * @param ptr_x: optimization result of x
    * @param ptr_dx: optimization result of dx
    * @param ptr_ddx: optimization result of ddx
@@ -78,6 +83,7 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
       const std::vector<std::pair<double, double>>& lat_boundaries,
       const std::vector<std::pair<double, double>>& ddl_bounds,
       const std::array<double, 5>& w, const int max_iter,
+      PiecewiseJerkWorkspace* workspace, const double start_s,
       std::vector<double>* ptr_x, std::vector<double>* ptr_dx,
       std::vector<double>* ptr_ddx);
 
@@ -93,6 +99,9 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
 
   double GaussianWeighting(const double x, const double peak_weighting,
                            const double peak_weighting_x) const;
+
+  // one workspace per path boundary label, they differ in size and bounds
+  std::unordered_map<std::string, PiecewiseJerkWorkspace> workspaces_;
 };
 
 }  // namespace planning
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "cyber/time/clock.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -39,6 +40,7 @@ using apollo::common::PathPoint;
 using apollo::common::SpeedPoint;
 using apollo::common::Status;
 using apollo::common::TrajectoryPoint;
+using apollo::cyber::Clock;
 
 PiecewiseJerkSpeedOptimizer::PiecewiseJerkSpeedOptimizer(
     const TaskConfig& config)
@@ -157,6 +159,12 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   piecewise_jerk_problem.set_penalty_dx(penalty_dx);
   piecewise_jerk_problem.set_dx_bounds(std::move(s_dot_bounds));
 
+  // knots are delta_t apart from now on, the last solution is shifted by
+  // the time since then
+  if (FLAGS_enable_piecewise_jerk_warm_start) {
+    piecewise_jerk_problem.set_workspace(&workspace_, Clock::NowInSeconds());
+  }
+
   // Solve the problem
   if (!piecewise_jerk_problem.Optimize()) {
     const std::string msg = "Piecewise jerk speed optimizer failed!";
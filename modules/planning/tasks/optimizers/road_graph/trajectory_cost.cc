@@ -20,7 +20,11 @@
 
 #include "modules/planning/tasks/optimizers/road_graph/trajectory_cost.h"
 
+#include <cmath>
+#include <utility>
+
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/math/angle.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/common/util/point_factory.h"
@@ -28,6 +32,14 @@
 
 namespace apollo {
 namespace planning {
+namespace {
+
+// lateral size of the cells of the static obstacle cost cache, their
+// longitudinal size is the path resolution
+constexpr double kStaticObstacleCostCellWidth = 0.05;
+constexpr size_t kStaticObstacleCostCacheCapacity = 1 << 16;
+
+}  // namespace
 
 TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
                                const ReferenceLine &reference_line,
@@ -95,6 +107,48 @@ TrajectoryCost::TrajectoryCost(const DpPolyPathConfig &config,
       dynamic_obstacle_boxes_.push_back(std::move(box_by_time));
     }
   }
+
+  const auto &param = common::VehicleConfigHelper::GetConfig().vehicle_param();
+  vec_to_center_ = Vec2d(
+      (param.front_edge_to_center() - param.back_edge_to_center()) / 2.0,
+      (param.left_edge_to_center() - param.right_edge_to_center()) / 2.0);
+  const double r_w =
+      (param.left_edge_to_center() + param.right_edge_to_center()) / 2.0;
+  const double r_l = param.back_edge_to_center();
+  off_road_radius_ = std::sqrt(r_w * r_w + r_l * r_l);
+
+  // the time stamps, thus where the ADC is at each of them, are the same for
+  // every curve
+  if (!dynamic_obstacle_boxes_.empty()) {
+    double time_stamp = 0.0;
+    for (size_t index = 0; index < num_of_time_stamps_;
+         ++index, time_stamp += config_.eval_time_interval()) {
+      common::SpeedPoint speed_point;
+      heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
+      DynamicEvalPoint point;
+      point.ref_s = speed_point.s() + init_sl_point_.s();
+      Vec2d xy_point;
+      point.has_xy = reference_line_->SLToXY(
+          common::util::PointFactory::ToSLPoint(point.ref_s, 0.0), &xy_point);
+      const ReferencePoint reference_point =
+          reference_line_->GetReferencePoint(point.ref_s);
+      const auto angle =
+          common::math::Angle16::from_rad(reference_point.heading());
+      point.x = reference_point.x();
+      point.y = reference_point.y();
+      point.sin_heading = common::math::sin(angle);
+      point.cos_heading = common::math::cos(angle);
+      point.heading = reference_point.heading();
+      point.kappa = reference_point.kappa();
+      dynamic_eval_points_.push_back(point);
+    }
+  }
+
+  if (FLAGS_enable_dp_road_graph_cost_cache) {
+    static_obstacle_cost_cache_.reset(
+        new common::util::ShardedLRUCache<uint64_t, ComparableCost>(
+            kStaticObstacleCostCacheCapacity));
+  }
 }
 
 ComparableCost TrajectoryCost::CalculatePathCost(
@@ -145,20 +199,12 @@ bool TrajectoryCost::IsOffRoad(const double ref_s, const double l,
   }
   Vec2d rear_center(0.0, l);
 
-  const auto &param = common::VehicleConfigHelper::GetConfig().vehicle_param();
-  Vec2d vec_to_center(
-      (param.front_edge_to_center() - param.back_edge_to_center()) / 2.0,
-      (param.left_edge_to_center() - param.right_edge_to_center()) / 2.0);
-
-  Vec2d rear_center_to_center = vec_to_center.rotate(std::atan(dl));
+  Vec2d rear_center_to_center = vec_to_center_.rotate(std::atan(dl));
   Vec2d center = rear_center + rear_center_to_center;
   Vec2d front_center = center + rear_center_to_center;
 
   const double buffer = 0.1;  // in meters
-  const double r_w =
-      (param.left_edge_to_center() + param.right_edge_to_center()) / 2.0;
-  const double r_l = param.back_edge_to_center();
-  const double r = std::sqrt(r_w * r_w + r_l * r_l);
+  const double r = off_road_radius_;
 
   double left_width = 0.0;
   double right_width = 0.0;
@@ -201,12 +247,9 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
     return obstacle_cost;
   }
 
-  double time_stamp = 0.0;
-  for (size_t index = 0; index < num_of_time_stamps_;
-       ++index, time_stamp += config_.eval_time_interval()) {
-    common::SpeedPoint speed_point;
-    heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
-    double ref_s = speed_point.s() + init_sl_point_.s();
+  for (size_t index = 0; index < dynamic_eval_points_.size(); ++index) {
+    const auto &eval_point = dynamic_eval_points_[index];
+    const double ref_s = eval_point.ref_s;
     if (ref_s < start_s) {
       continue;
     }
@@ -218,8 +261,7 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
     const double l = curve.Evaluate(0, s);
     const double dl = curve.Evaluate(1, s);
 
-    const common::SLPoint sl = common::util::PointFactory::ToSLPoint(ref_s, l);
-    const Box2d ego_box = GetBoxFromSLPoint(sl, dl);
+    const Box2d ego_box = GetBoxFromEvalPoint(eval_point, l, dl);
     for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
       obstacle_cost +=
           GetCostBetweenObsBoxes(ego_box, obstacle_trajectory.at(index));
@@ -316,12 +358,126 @@ Box2d TrajectoryCost::GetBoxFromSLPoint(const common::SLPoint &sl,
                vehicle_param_.width());
 }
 
-// TODO(All): optimize obstacle cost calculation time
+Box2d TrajectoryCost::GetBoxFromEvalPoint(const DynamicEvalPoint &point,
+                                          const double l,
+                                          const double dl) const {
+  // same as GetBoxFromSLPoint, with the reference point looked up once
+  Vec2d xy_point;
+  if (point.has_xy) {
+    xy_point.set_x(point.x - point.sin_heading * l);
+    xy_point.set_y(point.y + point.cos_heading * l);
+  }
+  const double one_minus_kappa_r_d = 1 - point.kappa * l;
+  const double delta_theta = std::atan2(dl, one_minus_kappa_r_d);
+  const double theta =
+      common::math::NormalizeAngle(delta_theta + point.heading);
+  return Box2d(xy_point, theta, vehicle_param_.length(),
+               vehicle_param_.width());
+}
+
+ComparableCost TrajectoryCost::CalculatePathCost(
+    const CurveSamples &samples, const QuinticPolynomialCurve1d &curve,
+    const double start_s, const double end_s, const uint32_t curr_level,
+    const uint32_t total_level) {
+  ComparableCost cost;
+  double path_cost = 0.0;
+  const double l0 = config_.path_l_cost_param_l0();
+  const double b = config_.path_l_cost_param_b();
+  const double k = config_.path_l_cost_param_k();
+  for (size_t i = 0; i < samples.s.size(); ++i) {
+    const double l = samples.l[i];
+    const double exp_term = std::exp(-k * (std::fabs(l) - l0));
+    path_cost +=
+        l * l * config_.path_l_cost() * (b + exp_term) / (1.0 + exp_term);
+
+    const double dl = std::fabs(samples.dl[i]);
+    if (IsOffRoad(samples.s[i] + start_s, l, dl, is_change_lane_path_)) {
+      cost.cost_items[ComparableCost::OUT_OF_BOUNDARY] = true;
+    }
+    path_cost += dl * dl * config_.path_dl_cost();
+
+    const double ddl = std::fabs(samples.ddl[i]);
+    path_cost += ddl * ddl * config_.path_ddl_cost();
+  }
+  path_cost *= config_.path_resolution();
+
+  if (curr_level == total_level) {
+    const double end_l = curve.Evaluate(0, end_s - start_s);
+    path_cost +=
+        std::sqrt(end_l - init_sl_point_.l() / 2.0) * config_.path_end_l_cost();
+  }
+  cost.smoothness_cost = path_cost;
+  return cost;
+}
+
+ComparableCost TrajectoryCost::CalculateStaticObstacleCost(
+    const CurveSamples &samples, const double start_s) {
+  ComparableCost obstacle_cost;
+  if (static_obstacle_sl_boundaries_.empty()) {
+    return obstacle_cost;
+  }
+  for (size_t i = 0; i < samples.s.size(); ++i) {
+    obstacle_cost +=
+        GetStaticObstacleCostOfCell(samples.s[i] + start_s, samples.l[i]);
+  }
+  obstacle_cost.safety_cost *= config_.path_resolution();
+  return obstacle_cost;
+}
+
+ComparableCost TrajectoryCost::GetStaticObstacleCostOfCell(const double s,
+                                                           const double l) {
+  const int32_t s_index = static_cast<int32_t>(
+      std::lround((s - init_sl_point_.s()) / config_.path_resolution()));
+  const int32_t l_index =
+      static_cast<int32_t>(std::lround(l / kStaticObstacleCostCellWidth));
+  const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(s_index))
+                        << 32) |
+                       static_cast<uint32_t>(l_index);
+  ComparableCost cost;
+  if (static_obstacle_cost_cache_->GetCopy(key, &cost)) {
+    return cost;
+  }
+  const double cell_s =
+      init_sl_point_.s() + s_index * config_.path_resolution();
+  const double cell_l = l_index * kStaticObstacleCostCellWidth;
+  for (const auto &obs_sl_boundary : static_obstacle_sl_boundaries_) {
+    cost += GetCostFromObsSL(cell_s, cell_l, obs_sl_boundary);
+  }
+  static_obstacle_cost_cache_->Put(key, cost);
+  return cost;
+}
+
+ComparableCost TrajectoryCost::CalculateWithCache(
+    const QuinticPolynomialCurve1d &curve, const double start_s,
+    const double end_s, const uint32_t curr_level,
+    const uint32_t total_level) {
+  // the path cost and the static obstacle cost share the samples of the
+  // curve
+  CurveSamples samples;
+  for (double curve_s = 0.0; curve_s < (end_s - start_s);
+       curve_s += config_.path_resolution()) {
+    samples.s.push_back(curve_s);
+  }
+  curve.EvaluateBatch(0, samples.s, &samples.l);
+  curve.EvaluateBatch(1, samples.s, &samples.dl);
+  curve.EvaluateBatch(2, samples.s, &samples.ddl);
+
+  ComparableCost total_cost;
+  total_cost += CalculatePathCost(samples, curve, start_s, end_s, curr_level,
+                                  total_level);
+  total_cost += CalculateStaticObstacleCost(samples, start_s);
+  total_cost += CalculateDynamicObstacleCost(curve, start_s, end_s);
+  return total_cost;
+}
+
 ComparableCost TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
                                          const double start_s,
                                          const double end_s,
                                          const uint32_t curr_level,
                                          const uint32_t total_level) {
+  if (static_obstacle_cost_cache_ != nullptr) {
+    return CalculateWithCache(curve, start_s, end_s, curr_level, total_level);
+  }
   ComparableCost total_cost;
   // path cost
   total_cost +=
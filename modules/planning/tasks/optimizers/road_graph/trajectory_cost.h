@@ -20,8 +20,13 @@
 
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/common/math/box2d.h"
+#include "modules/common/util/sharded_lru_cache.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/speed_data.h"
@@ -44,12 +49,52 @@ class TrajectoryCost {
                  const SpeedData &heuristic_speed_data,
                  const common::SLPoint &init_sl_point,
                  const SLBoundary &adc_sl_boundary);
+  // safe to call concurrently
   ComparableCost Calculate(const QuinticPolynomialCurve1d &curve,
                            const double start_s, const double end_s,
                            const uint32_t curr_level,
                            const uint32_t total_level);
 
  private:
+  // where the ADC is expected at a time stamp of the dynamic obstacle boxes,
+  // by the heuristic speed, and the reference point there
+  struct DynamicEvalPoint {
+    double ref_s = 0.0;
+    bool has_xy = false;
+    double x = 0.0;
+    double y = 0.0;
+    double sin_heading = 0.0;
+    double cos_heading = 0.0;
+    double heading = 0.0;
+    double kappa = 0.0;
+  };
+
+  // l, dl and ddl of a curve every path_resolution from its start
+  struct CurveSamples {
+    std::vector<double> s;
+    std::vector<double> l;
+    std::vector<double> dl;
+    std::vector<double> ddl;
+  };
+
+  ComparableCost CalculateWithCache(const QuinticPolynomialCurve1d &curve,
+                                    const double start_s, const double end_s,
+                                    const uint32_t curr_level,
+                                    const uint32_t total_level);
+
+  ComparableCost CalculatePathCost(const CurveSamples &samples,
+                                   const QuinticPolynomialCurve1d &curve,
+                                   const double start_s, const double end_s,
+                                   const uint32_t curr_level,
+                                   const uint32_t total_level);
+
+  ComparableCost CalculateStaticObstacleCost(const CurveSamples &samples,
+                                             const double start_s);
+
+  // static obstacle cost of the (s, l) cell around a point, evaluated at the
+  // cell center so that it does not depend on which curve filled it
+  ComparableCost GetStaticObstacleCostOfCell(const double s, const double l);
+
   ComparableCost CalculatePathCost(const QuinticPolynomialCurve1d &curve,
                                    const double start_s, const double end_s,
                                    const uint32_t curr_level,
@@ -71,6 +116,10 @@ class TrajectoryCost {
   common::math::Box2d GetBoxFromSLPoint(const common::SLPoint &sl,
                                         const double dl) const;
 
+  common::math::Box2d GetBoxFromEvalPoint(const DynamicEvalPoint &point,
+                                          const double l,
+                                          const double dl) const;
+
   bool IsOffRoad(const double ref_s, const double l, const double dl,
                  const bool is_change_lane_path);
 
@@ -86,6 +135,16 @@ class TrajectoryCost {
   std::vector<double> obstacle_probabilities_;
 
   std::vector<SLBoundary> static_obstacle_sl_boundaries_;
+
+  std::vector<DynamicEvalPoint> dynamic_eval_points_;
+
+  // the vehicle geometry IsOffRoad needs
+  common::math::Vec2d vec_to_center_;
+  double off_road_radius_ = 0.0;
+
+  // with FLAGS_enable_dp_road_graph_cost_cache
+  std::unique_ptr<common::util::ShardedLRUCache<uint64_t, ComparableCost>>
+      static_obstacle_cost_cache_;
 };
 
 }  // namespace planning
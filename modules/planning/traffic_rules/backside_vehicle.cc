@@ -34,7 +34,9 @@ void BacksideVehicle::MakeLaneKeepingObstacleDecision(
   ignore.mutable_ignore();
   const double adc_length_s =
       adc_sl_boundary.end_s() - adc_sl_boundary.start_s();
-  for (const auto* obstacle : path_decision->obstacles().Items()) {
+  const auto& obstacles = path_decision->obstacles().Items();
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    const auto* obstacle = obstacles[i];
     if (obstacle->PerceptionSLBoundary().end_s() >= adc_sl_boundary.end_s() ||
         obstacle->IsCautionLevelObstacle()) {
       // don't ignore such vehicles.
@@ -42,18 +44,18 @@ void BacksideVehicle::MakeLaneKeepingObstacleDecision(
     }
 
     if (obstacle->reference_line_st_boundary().IsEmpty()) {
-      path_decision->AddLongitudinalDecision("backside_vehicle/no-st-region",
-                                             obstacle->Id(), ignore);
-      path_decision->AddLateralDecision("backside_vehicle/no-st-region",
-                                        obstacle->Id(), ignore);
+      path_decision->AddLongitudinalDecision("backside_vehicle/no-st-region", i,
+                                             ignore);
+      path_decision->AddLateralDecision("backside_vehicle/no-st-region", i,
+                                        ignore);
       continue;
     }
     // Ignore the car comes from back of ADC
     if (obstacle->reference_line_st_boundary().min_s() < -adc_length_s) {
       path_decision->AddLongitudinalDecision("backside_vehicle/st-min-s < adc",
-                                             obstacle->Id(), ignore);
-      path_decision->AddLateralDecision("backside_vehicle/st-min-s < adc",
-                                        obstacle->Id(), ignore);
+                                             i, ignore);
+      path_decision->AddLateralDecision("backside_vehicle/st-min-s < adc", i,
+                                        ignore);
       continue;
     }
 
@@ -65,9 +67,9 @@ void BacksideVehicle::MakeLaneKeepingObstacleDecision(
         continue;
       }
       path_decision->AddLongitudinalDecision("backside_vehicle/sl < adc.end_s",
-                                             obstacle->Id(), ignore);
-      path_decision->AddLateralDecision("backside_vehicle/sl < adc.end_s",
-                                        obstacle->Id(), ignore);
+                                             i, ignore);
+      path_decision->AddLateralDecision("backside_vehicle/sl < adc.end_s", i,
+                                        ignore);
       continue;
     }
   }
@@ -99,6 +99,17 @@ void Crosswalk::MakeDecisions(Frame* const frame,
   const auto& finished_crosswalks =
       mutable_crosswalk_status->finished_crosswalk();
 
+  // only these types may stop the adc, in the order of the obstacles
+  std::vector<size_t> obstacle_indices;
+  for (const auto type :
+       {PerceptionObstacle::PEDESTRIAN, PerceptionObstacle::BICYCLE,
+        PerceptionObstacle::UNKNOWN_MOVABLE, PerceptionObstacle::UNKNOWN}) {
+    const auto& indices = path_decision->ObstacleIndicesOfType(type);
+    obstacle_indices.insert(obstacle_indices.end(), indices.begin(),
+                            indices.end());
+  }
+  std::sort(obstacle_indices.begin(), obstacle_indices.end());
+
   const auto& reference_line = reference_line_info->reference_line();
   for (auto crosswalk_overlap : crosswalk_overlaps_) {
     auto crosswalk_ptr = HDMapUtil::BaseMap().GetCrosswalkById(
@@ -130,14 +141,21 @@ void Crosswalk::MakeDecisions(Frame* const frame,
       continue;
     }
 
-    std::vector<std::string> pedestrians;
-    for (const auto* obstacle : path_decision->obstacles().Items()) {
-      const double stop_deceleration = util::GetADCStopDeceleration(
-          injector_->vehicle_state(), adc_front_edge_s,
-          crosswalk_overlap->start_s);
+    const double stop_deceleration = util::GetADCStopDeceleration(
+        injector_->vehicle_state(), adc_front_edge_s,
+        crosswalk_overlap->start_s);
+    // expand crosswalk polygon
+    // note: crosswalk expanded area will include sideway area
+    const Polygon2d crosswalk_exp_poly =
+        crosswalk_ptr->polygon().ExpandByDistance(
+            config_.crosswalk().expand_s_distance());
 
+    std::vector<std::string> pedestrians;
+    for (const size_t index : obstacle_indices) {
+      const auto* obstacle = path_decision->obstacles().Items()[index];
       bool stop = CheckStopForObstacle(reference_line_info, crosswalk_ptr,
-                                       *obstacle, stop_deceleration);
+                                       crosswalk_exp_poly, *obstacle,
+                                       stop_deceleration);
 
       const std::string& obstacle_id = obstacle->Id();
       const PerceptionObstacle& perception_obstacle = obstacle->Perception();
@@ -259,7 +277,8 @@ bool Crosswalk::FindCrosswalks(ReferenceLineInfo* const reference_line_info) {
 
 bool Crosswalk::CheckStopForObstacle(
     ReferenceLineInfo* const reference_line_info,
-    const CrosswalkInfoConstPtr crosswalk_ptr, const Obstacle& obstacle,
+    const CrosswalkInfoConstPtr crosswalk_ptr,
+    const Polygon2d& crosswalk_exp_poly, const Obstacle& obstacle,
     const double stop_deceleration) {
   CHECK_NOTNULL(reference_line_info);
 
@@ -281,13 +300,8 @@ bool Crosswalk::CheckStopForObstacle(
     return false;
   }
 
-  // expand crosswalk polygon
-  // note: crosswalk expanded area will include sideway area
   Vec2d point(perception_obstacle.position().x(),
               perception_obstacle.position().y());
-  const Polygon2d crosswalk_exp_poly =
-      crosswalk_ptr->polygon().ExpandByDistance(
-          config_.crosswalk().expand_s_distance());
   bool in_expanded_crosswalk = crosswalk_exp_poly.IsPointIn(point);
 
   if (!in_expanded_crosswalk) {
@@ -36,10 +36,17 @@ std::size_t FeatureOutput::idx_learning_ = 0;
 std::size_t FeatureOutput::idx_prediction_result_ = 0;
 std::size_t FeatureOutput::idx_frame_env_ = 0;
 std::size_t FeatureOutput::idx_tuning_ = 0;
+std::string FeatureOutput::file_tag_;
+std::vector<std::string> FeatureOutput::written_files_;
 std::mutex FeatureOutput::mutex_feature_;
 
 void FeatureOutput::Close() {
   ADEBUG << "Close feature output";
+  Flush();
+  Clear();
+}
+
+void FeatureOutput::Flush() {
   switch (FLAGS_prediction_offline_mode) {
     case 1: {
       WriteFeatureProto();
@@ -66,7 +73,18 @@ void FeatureOutput::Close() {
       break;
     }
   }
-  Clear();
+}
+
+void FeatureOutput::SetFileTag(const std::string& tag) {
+  UNIQUE_LOCK_MULTITHREAD(mutex_feature_);
+  file_tag_ = tag.empty() ? tag : absl::StrCat(tag, ".");
+}
+
+std::vector<std::string> FeatureOutput::TakeWrittenFiles() {
+  UNIQUE_LOCK_MULTITHREAD(mutex_feature_);
+  std::vector<std::string> written_files;
+  written_files.swap(written_files_);
+  return written_files;
 }
 
 void FeatureOutput::Clear() {
@@ -81,6 +99,7 @@ void FeatureOutput::Clear() {
   list_prediction_result_.Clear();
   list_frame_env_.Clear();
   list_data_for_tuning_.Clear();
+  written_files_.clear();
 }
 
 bool FeatureOutput::Ready() {
@@ -174,9 +193,11 @@ void FeatureOutput::WriteFeatureProto() {
   if (features_.feature().empty()) {
     ADEBUG << "Skip writing empty feature.";
   } else {
-    const std::string file_name = absl::StrCat(
-        FLAGS_prediction_data_dir, "/feature.", idx_feature_, ".bin");
+    const std::string file_name =
+        absl::StrCat(FLAGS_prediction_data_dir, "/feature.", file_tag_,
+                     idx_feature_, ".bin");
     cyber::common::SetProtoToBinaryFile(features_, file_name);
+    written_files_.push_back(file_name);
     features_.Clear();
     ++idx_feature_;
   }
@@ -187,9 +208,11 @@ void FeatureOutput::WriteDataForLearning() {
   if (list_data_for_learning_.data_for_learning().empty()) {
     ADEBUG << "Skip writing empty data_for_learning.";
   } else {
-    const std::string file_name = absl::StrCat(
-        FLAGS_prediction_data_dir, "/datalearn.", idx_learning_, ".bin");
+    const std::string file_name =
+        absl::StrCat(FLAGS_prediction_data_dir, "/datalearn.", file_tag_,
+                     idx_learning_, ".bin");
     cyber::common::SetProtoToBinaryFile(list_data_for_learning_, file_name);
+    written_files_.push_back(file_name);
     list_data_for_learning_.Clear();
     ++idx_learning_;
   }
@@ -202,8 +225,9 @@ void FeatureOutput::WritePredictionResult() {
   } else {
     const std::string file_name =
         absl::StrCat(FLAGS_prediction_data_dir, "/prediction_result.",
-                     idx_prediction_result_, ".bin");
+                     file_tag_, idx_prediction_result_, ".bin");
     cyber::common::SetProtoToBinaryFile(list_prediction_result_, file_name);
+    written_files_.push_back(file_name);
     list_prediction_result_.Clear();
     ++idx_prediction_result_;
   }
@@ -214,9 +238,11 @@ void FeatureOutput::WriteFrameEnv() {
   if (list_frame_env_.frame_env().empty()) {
     ADEBUG << "Skip writing empty prediction_result.";
   } else {
-    const std::string file_name = absl::StrCat(
-        FLAGS_prediction_data_dir, "/frame_env.", idx_frame_env_, ".bin");
+    const std::string file_name =
+        absl::StrCat(FLAGS_prediction_data_dir, "/frame_env.", file_tag_,
+                     idx_frame_env_, ".bin");
     cyber::common::SetProtoToBinaryFile(list_frame_env_, file_name);
+    written_files_.push_back(file_name);
     list_frame_env_.Clear();
     ++idx_frame_env_;
   }
@@ -228,9 +254,11 @@ void FeatureOutput::WriteDataForTuning() {
     ADEBUG << "Skip writing empty data_for_tuning.";
     return;
   }
-  const std::string file_name = absl::StrCat(
-      FLAGS_prediction_data_dir, "/datatuning.", idx_tuning_, ".bin");
+  const std::string file_name =
+      absl::StrCat(FLAGS_prediction_data_dir, "/datatuning.", file_tag_,
+                   idx_tuning_, ".bin");
   cyber::common::SetProtoToBinaryFile(list_data_for_tuning_, file_name);
+  written_files_.push_back(file_name);
   list_data_for_tuning_.Clear();
   ++idx_tuning_;
 }
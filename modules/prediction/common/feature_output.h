@@ -50,6 +50,24 @@ class FeatureOutput {
    */
   static bool Ready();
 
+  /**
+   * @brief Set the tag inserted into the names of the written files, so that
+   *        several writers can share one output directory
+   * @param The tag, e.g. the shard index
+   */
+  static void SetFileTag(const std::string& tag);
+
+  /**
+   * @brief Write the buffered data of the offline mode to a new file
+   */
+  static void Flush();
+
+  /**
+   * @brief Get the files written since the last call and forget them
+   * @return The names of the written files
+   */
+  static std::vector<std::string> TakeWrittenFiles();
+
   /**
    * @brief Insert a feature
    * @param A feature in proto
@@ -166,6 +184,8 @@ class FeatureOutput {
   static std::size_t idx_frame_env_;
   static ListDataForTuning list_data_for_tuning_;
   static std::size_t idx_tuning_;
+  static std::string file_tag_;
+  static std::vector<std::string> written_files_;
   static std::mutex mutex_feature_;
 };
 
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/frame_deadline.h"
+
+namespace apollo {
+namespace prediction {
+
+FrameDeadline::FrameDeadline() {}
+
+void FrameDeadline::Start(const double time_budget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  deadline_ = std::chrono::steady_clock::now() +
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  std::chrono::duration<double>(time_budget));
+  downgraded_obstacle_ids_.clear();
+}
+
+bool FrameDeadline::Expired() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::chrono::steady_clock::now() > deadline_;
+}
+
+void FrameDeadline::Downgrade(const int obstacle_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  downgraded_obstacle_ids_.insert(obstacle_id);
+}
+
+bool FrameDeadline::IsDowngraded(const int obstacle_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return downgraded_obstacle_ids_.count(obstacle_id) > 0;
+}
+
+size_t FrameDeadline::NumDowngraded() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return downgraded_obstacle_ids_.size();
+}
+
+}  // namespace prediction
+}  // namespace apollo
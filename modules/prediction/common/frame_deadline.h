@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The time budget of processing a perception frame
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <unordered_set>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace prediction {
+
+class FrameDeadline {
+ public:
+  /**
+   * @brief Start a frame with a time budget from now
+   * @param Time budget in seconds
+   */
+  void Start(const double time_budget);
+
+  /**
+   * @brief Check if the time budget of the current frame is spent
+   * @return True if the deadline has passed
+   */
+  bool Expired() const;
+
+  /**
+   * @brief Record an obstacle processed with a cheaper fallback this frame
+   * @param Obstacle ID
+   */
+  void Downgrade(const int obstacle_id);
+
+  /**
+   * @brief Check if an obstacle was downgraded this frame
+   * @param Obstacle ID
+   * @return True if the obstacle was downgraded
+   */
+  bool IsDowngraded(const int obstacle_id) const;
+
+  /**
+   * @brief Get the number of obstacles downgraded this frame
+   */
+  size_t NumDowngraded() const;
+
+ private:
+  std::chrono::steady_clock::time_point deadline_ =
+      std::chrono::steady_clock::time_point::max();
+  std::unordered_set<int> downgraded_obstacle_ids_;
+  mutable std::mutex mutex_;
+
+  DECLARE_SINGLETON(FrameDeadline)
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/frame_deadline.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+TEST(FrameDeadlineTest, Expired) {
+  FrameDeadline* deadline = FrameDeadline::Instance();
+  deadline->Start(10.0);
+  EXPECT_FALSE(deadline->Expired());
+  deadline->Start(0.001);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_TRUE(deadline->Expired());
+}
+
+TEST(FrameDeadlineTest, Downgrade) {
+  FrameDeadline* deadline = FrameDeadline::Instance();
+  deadline->Start(10.0);
+  deadline->Downgrade(3);
+  deadline->Downgrade(5);
+  deadline->Downgrade(3);
+  EXPECT_EQ(deadline->NumDowngraded(), 2);
+  EXPECT_TRUE(deadline->IsDowngraded(5));
+  EXPECT_FALSE(deadline->IsDowngraded(4));
+
+  deadline->Start(10.0);
+  EXPECT_EQ(deadline->NumDowngraded(), 0);
+  EXPECT_FALSE(deadline->IsDowngraded(3));
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include <algorithm>
+
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+LaneGraphCache::LaneGraphCache() {}
+
+std::shared_ptr<const LaneGraph> LaneGraphCache::Get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second;
+}
+
+std::shared_ptr<const LaneGraph> LaneGraphCache::Put(const std::string& key,
+                                                     LaneGraph lane_graph) {
+  auto lane_graph_ptr =
+      std::make_shared<const LaneGraph>(std::move(lane_graph));
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second->second = lane_graph_ptr;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return lane_graph_ptr;
+  }
+  entries_.emplace_front(key, lane_graph_ptr);
+  index_[key] = entries_.begin();
+  const size_t capacity =
+      static_cast<size_t>(std::max(FLAGS_lane_graph_cache_capacity, 1));
+  while (entries_.size() > capacity) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+  return lane_graph_ptr;
+}
+
+void LaneGraphCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+}
+
+size_t LaneGraphCache::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+}  // namespace prediction
+}  // namespace apollo
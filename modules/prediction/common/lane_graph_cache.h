@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A bounded LRU cache of lane graphs shared across frames
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "cyber/common/macros.h"
+#include "modules/prediction/proto/lane_graph.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+class LaneGraphCache {
+ public:
+  /**
+   * @brief Get a cached lane graph and mark it as recently used
+   * @param Key of the lane graph
+   * @return The lane graph, nullptr if it is not cached
+   */
+  std::shared_ptr<const LaneGraph> Get(const std::string& key);
+
+  /**
+   * @brief Cache a lane graph, evicting the least recently used ones beyond
+   *        the capacity
+   * @param Key of the lane graph
+   * @param The lane graph
+   * @return The cached lane graph
+   */
+  std::shared_ptr<const LaneGraph> Put(const std::string& key,
+                                       LaneGraph lane_graph);
+
+  /**
+   * @brief Remove all the cached lane graphs
+   */
+  void Clear();
+
+  /**
+   * @brief Get the number of cached lane graphs
+   */
+  size_t Size() const;
+
+ private:
+  using Entry = std::pair<std::string, std::shared_ptr<const LaneGraph>>;
+
+  // most recently used first
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  mutable std::mutex mutex_;
+
+  DECLARE_SINGLETON(LaneGraphCache)
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+LaneGraph MakeLaneGraph(const std::string& lane_id) {
+  LaneGraph lane_graph;
+  lane_graph.add_lane_sequence()->add_lane_segment()->set_lane_id(lane_id);
+  return lane_graph;
+}
+
+}  // namespace
+
+class LaneGraphCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override { LaneGraphCache::Instance()->Clear(); }
+  void TearDown() override {
+    LaneGraphCache::Instance()->Clear();
+    FLAGS_lane_graph_cache_capacity = 4096;
+  }
+};
+
+TEST_F(LaneGraphCacheTest, GetAndPut) {
+  auto cache = LaneGraphCache::Instance();
+  EXPECT_EQ(cache->Get("l1"), nullptr);
+
+  auto lane_graph = cache->Put("l1", MakeLaneGraph("l1"));
+  ASSERT_NE(lane_graph, nullptr);
+  EXPECT_EQ(cache->Get("l1"), lane_graph);
+  EXPECT_EQ(cache->Get("l1")->lane_sequence(0).lane_segment(0).lane_id(),
+            "l1");
+  EXPECT_EQ(cache->Size(), 1);
+
+  // putting the same key again replaces the lane graph
+  cache->Put("l1", MakeLaneGraph("l2"));
+  EXPECT_EQ(cache->Size(), 1);
+  EXPECT_EQ(cache->Get("l1")->lane_sequence(0).lane_segment(0).lane_id(),
+            "l2");
+  // the replaced lane graph stays valid for its holders
+  EXPECT_EQ(lane_graph->lane_sequence(0).lane_segment(0).lane_id(), "l1");
+}
+
+TEST_F(LaneGraphCacheTest, EvictLeastRecentlyUsed) {
+  FLAGS_lane_graph_cache_capacity = 2;
+  auto cache = LaneGraphCache::Instance();
+  cache->Put("l1", MakeLaneGraph("l1"));
+  cache->Put("l2", MakeLaneGraph("l2"));
+  EXPECT_NE(cache->Get("l1"), nullptr);
+  cache->Put("l3", MakeLaneGraph("l3"));
+  EXPECT_EQ(cache->Size(), 2);
+  EXPECT_NE(cache->Get("l1"), nullptr);
+  EXPECT_EQ(cache->Get("l2"), nullptr);
+  EXPECT_NE(cache->Get("l3"), nullptr);
+
+  cache->Clear();
+  EXPECT_EQ(cache->Size(), 0);
+  EXPECT_EQ(cache->Get("l1"), nullptr);
+}
+
+}  // namespace prediction
+}  // namespace apollo
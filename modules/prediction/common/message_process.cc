@@ -16,16 +16,19 @@
 
 #include "modules/prediction/common/message_process.h"
 
+#include <limits>
 #include <memory>
 
 #include "cyber/common/file.h"
-#include "cyber/record/record_reader.h"
+#include "cyber/record/parallel_record_viewer.h"
 #include "cyber/record/record_writer.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/prediction/common/feature_output.h"
+#include "modules/prediction/common/frame_deadline.h"
 #include "modules/prediction/common/junction_analyzer.h"
 #include "modules/prediction/common/prediction_constants.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_profiler.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/common/validation_checker.h"
 #include "modules/prediction/container/storytelling/storytelling_container.h"
@@ -41,8 +44,8 @@ namespace prediction {
 
 using apollo::common::adapter::AdapterConfig;
 using apollo::cyber::proto::SingleMessage;
+using apollo::cyber::record::ParallelRecordViewer;
 using apollo::cyber::record::RecordMessage;
-using apollo::cyber::record::RecordReader;
 using apollo::cyber::record::RecordWriter;
 using apollo::localization::LocalizationEstimate;
 using apollo::perception::PerceptionObstacle;
@@ -146,27 +149,40 @@ void MessageProcess::ContainerProcess(
     ptr_ego_trajectory_container->SetPosition({x, y});
   }
 
+  const size_t num_obstacles = perception_obstacles.perception_obstacle_size();
   // Insert perception_obstacles
-  ptr_obstacles_container->Insert(perception_obstacles);
+  {
+    PredictionProfiler::ScopedTimer timer("container", "", num_obstacles);
+    ptr_obstacles_container->Insert(perception_obstacles);
+  }
 
   ObstaclesPrioritizer obstacles_prioritizer(container_manager);
   // Ignore some obstacles
   obstacles_prioritizer.AssignIgnoreLevel();
 
   // Scenario analysis
-  scenario_manager->Run(container_manager.get());
+  {
+    PredictionProfiler::ScopedTimer timer("scenario", "", num_obstacles);
+    scenario_manager->Run(container_manager.get());
+  }
 
   // Build junction feature for the obstacles in junction
   const Scenario scenario = scenario_manager->scenario();
   if (scenario.type() == Scenario::JUNCTION && scenario.has_junction_id()) {
+    PredictionProfiler::ScopedTimer timer("junction_feature", "",
+                                          num_obstacles);
     ptr_obstacles_container->GetJunctionAnalyzer()->Init(
         scenario.junction_id());
     ptr_obstacles_container->BuildJunctionFeature();
   }
 
   // Build lane graph
-  ptr_obstacles_container->BuildLaneGraph();
+  {
+    PredictionProfiler::ScopedTimer timer("lane_graph", "", num_obstacles);
+    ptr_obstacles_container->BuildLaneGraph();
+  }
 
+  PredictionProfiler::ScopedTimer timer("prioritization", "", num_obstacles);
   // Assign CautionLevel for obstacles
   obstacles_prioritizer.AssignCautionLevel();
 
@@ -180,6 +196,27 @@ void MessageProcess::OnPerception(
     EvaluatorManager* evaluator_manager, PredictorManager* predictor_manager,
     ScenarioManager* scenario_manager,
     PredictionObstacles* const prediction_obstacles) {
+  if (FLAGS_enable_anytime_prediction) {
+    FrameDeadline::Instance()->Start(FLAGS_prediction_frame_time_budget);
+  }
+  if (FLAGS_enable_prediction_profiling) {
+    PredictionProfiler::Instance()->StartFrame(
+        perception_obstacles.perception_obstacle_size());
+  }
+  OnPerceptionStages(perception_obstacles, container_manager,
+                     evaluator_manager, predictor_manager, scenario_manager,
+                     prediction_obstacles);
+  if (FLAGS_enable_prediction_profiling) {
+    PredictionProfiler::Instance()->EndFrame();
+  }
+}
+
+void MessageProcess::OnPerceptionStages(
+    const perception::PerceptionObstacles& perception_obstacles,
+    const std::shared_ptr<ContainerManager>& container_manager,
+    EvaluatorManager* evaluator_manager, PredictorManager* predictor_manager,
+    ScenarioManager* scenario_manager,
+    PredictionObstacles* const prediction_obstacles) {
   ContainerProcess(container_manager, perception_obstacles, scenario_manager);
 
   auto ptr_obstacles_container =
@@ -218,16 +255,24 @@ void MessageProcess::OnPerception(
     return;
   }
 
+  const size_t num_obstacles =
+      ptr_obstacles_container->curr_frame_considered_obstacle_ids().size();
   // Make evaluations
-  evaluator_manager->Run(ptr_obstacles_container);
+  {
+    PredictionProfiler::ScopedTimer timer("evaluator", "", num_obstacles);
+    evaluator_manager->Run(ptr_obstacles_container);
+  }
   if (FLAGS_prediction_offline_mode ==
           PredictionConstants::kDumpDataForLearning ||
       FLAGS_prediction_offline_mode == PredictionConstants::kDumpFrameEnv) {
     return;
   }
   // Make predictions
-  predictor_manager->Run(perception_obstacles, ptr_ego_trajectory_container,
-                         ptr_obstacles_container);
+  {
+    PredictionProfiler::ScopedTimer timer("predictor", "", num_obstacles);
+    predictor_manager->Run(perception_obstacles, ptr_ego_trajectory_container,
+                           ptr_obstacles_container);
+  }
 
   // Get predicted obstacles
   *prediction_obstacles = predictor_manager->prediction_obstacles();
@@ -282,13 +327,18 @@ void MessageProcess::ProcessOfflineData(
     const std::shared_ptr<ContainerManager>& container_manager,
     EvaluatorManager* evaluator_manager, PredictorManager* predictor_manager,
     ScenarioManager* scenario_manager, const std::string& record_filepath) {
-  RecordReader reader(record_filepath);
+  // decoding runs ahead on the viewer threads while obstacles are evaluated
+  ParallelRecordViewer viewer(
+      {record_filepath}, 0, std::numeric_limits<uint64_t>::max(),
+      {prediction_conf.topic_conf().perception_obstacle_topic(),
+       prediction_conf.topic_conf().localization_topic(),
+       prediction_conf.topic_conf().planning_trajectory_topic()});
   RecordMessage message;
   RecordWriter writer;
   if (FLAGS_prediction_offline_mode == PredictionConstants::kDumpRecord) {
     writer.Open(record_filepath + ".new_prediction");
   }
-  while (reader.ReadMessage(&message)) {
+  while (viewer.ReadMessage(&message)) {
     if (message.channel_name ==
         prediction_conf.topic_conf().perception_obstacle_topic()) {
       PerceptionObstacles perception_obstacles;
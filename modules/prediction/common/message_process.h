@@ -81,6 +81,14 @@ class MessageProcess {
       const std::shared_ptr<ContainerManager> &container_manager,
       EvaluatorManager *evaluator_manager, PredictorManager *predictor_manager,
       ScenarioManager *scenario_manager, const std::string &record_filepath);
+
+ private:
+  static void OnPerceptionStages(
+      const perception::PerceptionObstacles &perception_obstacles,
+      const std::shared_ptr<ContainerManager> &container_manager,
+      EvaluatorManager *evaluator_manager, PredictorManager *predictor_manager,
+      ScenarioManager *scenario_manager,
+      PredictionObstacles *const prediction_obstacles);
 };
 
 }  // namespace prediction
@@ -25,6 +25,9 @@ DEFINE_double(prediction_trajectory_time_length, 8.0,
               "Time length of predicted trajectory (in seconds)");
 DEFINE_double(prediction_trajectory_time_resolution, 0.1,
               "Time resolution of predicted trajectory (in seconds");
+DEFINE_bool(enable_batch_trajectory_sampling, false,
+            "If convert the sampled lane coordinates of a predicted trajectory "
+            "to points in one pass over the lanes.");
 DEFINE_double(min_prediction_trajectory_spatial_length, 100.0,
               "Minimal spatial length of predicted trajectory");
 DEFINE_bool(enable_trajectory_validation_check, false,
@@ -53,12 +56,28 @@ DEFINE_double(pedestrian_nearby_lane_search_radius, 5.0,
               "Radius to determine if pedestrian-like obstacle is near lane.");
 DEFINE_int32(road_graph_max_search_horizon, 20,
              "Maximal search depth for building road graph");
+DEFINE_bool(enable_lane_graph_cache, false,
+            "If build the forward lane graphs from cached lane sequences "
+            "shared across obstacles and frames.");
+DEFINE_int32(lane_graph_cache_capacity, 4096,
+             "Maximal number of cached lane graphs.");
+DEFINE_double(lane_graph_cache_horizon_bucket, 10.0,
+              "Bucket size in meters of the search horizon from the start of "
+              "the lane, which a cached lane graph covers.");
 DEFINE_double(surrounding_lane_search_radius, 3.0,
               "Search radius for surrounding lanes.");
 
 // Semantic Map
 DEFINE_double(base_image_half_range, 100.0, "The half range of base image.");
 DEFINE_bool(img_show_semantic_map, false, "If show the image of semantic map.");
+DEFINE_bool(enable_semantic_map_tile_cache, false,
+            "If align the base image to tiles and only draw the tiles newly "
+            "entering the base image.");
+DEFINE_double(semantic_map_tile_size, 20.0,
+              "The size of a base image tile in meters.");
+DEFINE_bool(enable_semantic_map_local_crop, false,
+            "If crop the feature map of an obstacle from the area around it "
+            "with one affine warp instead of rotating the whole image.");
 
 // Scenario
 DEFINE_double(junction_distance_threshold, 10.0,
@@ -127,6 +146,14 @@ DEFINE_double(still_unknown_position_std, 0.5,
 DEFINE_double(slow_obstacle_speed_threshold, 2.0,
               "Speed threshold for slow obstacles");
 DEFINE_double(max_history_time, 7.0, "Obstacles' maximal historical time.");
+DEFINE_bool(enable_compact_feature_history, false,
+            "If keep the older features of obstacles in a compact history and "
+            "build their protobuf only on demand.");
+DEFINE_int32(compact_feature_history_capacity, 128,
+             "Maximal number of frames in the compact feature history.");
+DEFINE_int32(max_num_full_feature_history, 3,
+             "Number of latest features kept as full protobuf messages when "
+             "the compact feature history is enabled.");
 DEFINE_double(target_lane_gap, 2.0, "Gap between two lane points.");
 DEFINE_double(dense_lane_gap, 0.2,
               "Gap between two adjacent lane points"
@@ -329,6 +356,12 @@ DEFINE_double(collision_cost_exp_coefficient, 1.0,
               "The coefficient in the collision exponential cost function");
 DEFINE_double(likelihood_exp_coefficient, 1.0,
               "The coefficient in the likelihood exponential function");
+DEFINE_bool(enable_interaction_pair_pruning, false,
+            "Skip the collision cost of obstacles which can not get close to "
+            "the ego trajectory within the prediction horizon");
+DEFINE_double(interaction_gating_distance, 10.0,
+              "The distance beyond which an obstacle and the ego trajectory "
+              "have no collision cost");
 
 DEFINE_double(lane_distance_threshold, 3.0,
               "The threshold for distance to ego/neighbor lane "
@@ -23,6 +23,7 @@ DECLARE_double(double_precision);
 // prediction trajectory and dynamic model
 DECLARE_double(prediction_trajectory_time_length);
 DECLARE_double(prediction_trajectory_time_resolution);
+DECLARE_bool(enable_batch_trajectory_sampling);
 DECLARE_double(min_prediction_trajectory_spatial_length);
 DECLARE_bool(enable_trajectory_validation_check);
 DECLARE_bool(enable_tracking_adaptation);
@@ -41,11 +42,17 @@ DECLARE_double(lane_search_radius_in_junction);
 DECLARE_double(junction_search_radius);
 DECLARE_double(pedestrian_nearby_lane_search_radius);
 DECLARE_int32(road_graph_max_search_horizon);
+DECLARE_bool(enable_lane_graph_cache);
+DECLARE_int32(lane_graph_cache_capacity);
+DECLARE_double(lane_graph_cache_horizon_bucket);
 DECLARE_double(surrounding_lane_search_radius);
 
 // Semantic Map
 DECLARE_double(base_image_half_range);
 DECLARE_bool(img_show_semantic_map);
+DECLARE_bool(enable_semantic_map_tile_cache);
+DECLARE_double(semantic_map_tile_size);
+DECLARE_bool(enable_semantic_map_local_crop);
 
 // Scenario
 DECLARE_double(junction_distance_threshold);
@@ -84,6 +91,9 @@ DECLARE_double(still_pedestrian_position_std);
 DECLARE_double(still_unknown_position_std);
 DECLARE_double(slow_obstacle_speed_threshold);
 DECLARE_double(max_history_time);
+DECLARE_bool(enable_compact_feature_history);
+DECLARE_int32(compact_feature_history_capacity);
+DECLARE_int32(max_num_full_feature_history);
 DECLARE_double(target_lane_gap);
 DECLARE_double(dense_lane_gap);
 DECLARE_int32(max_num_current_lane);
@@ -178,6 +188,8 @@ DECLARE_double(centripedal_acceleration_cost_weight);
 DECLARE_double(collision_cost_weight);
 DECLARE_double(collision_cost_exp_coefficient);
 DECLARE_double(likelihood_exp_coefficient);
+DECLARE_bool(enable_interaction_pair_pruning);
+DECLARE_double(interaction_gating_distance);
 
 // scenario feature extraction
 DECLARE_double(lane_distance_threshold);
@@ -21,6 +21,8 @@
 #include <unordered_set>
 #include <utility>
 
+#include "modules/common/math/linear_interpolation.h"
+#include "modules/common/math/math_utils.h"
 #include "modules/prediction/common/prediction_gflags.h"
 
 namespace apollo {
@@ -383,6 +385,81 @@ bool PredictionMap::SmoothPointFromLane(const std::string& id, const double s,
   return true;
 }
 
+bool PredictionMap::SmoothPointsFromLanes(
+    const std::vector<std::string>& lane_ids,
+    const std::vector<int>& lane_indices, const std::vector<double>& lane_s,
+    const std::vector<double>& lane_l, std::vector<Eigen::Vector2d>* points,
+    std::vector<double>* headings) {
+  if (points == nullptr || headings == nullptr ||
+      lane_indices.size() != lane_s.size() ||
+      lane_indices.size() != lane_l.size()) {
+    return false;
+  }
+  std::vector<std::shared_ptr<const LaneInfo>> lanes;
+  lanes.reserve(lane_ids.size());
+  for (const std::string& lane_id : lane_ids) {
+    std::shared_ptr<const LaneInfo> lane = LaneById(lane_id);
+    if (lane == nullptr) {
+      AERROR << "Null lane_info ptr found for lane [" << lane_id << "]";
+      return false;
+    }
+    lanes.push_back(std::move(lane));
+  }
+
+  const size_t num_points = lane_indices.size();
+  points->resize(num_points);
+  headings->resize(num_points);
+  int prev_lane_index = -1;
+  size_t index = 0;
+  for (size_t i = 0; i < num_points; ++i) {
+    const int lane_index = lane_indices[i];
+    if (lane_index < 0 || lane_index >= static_cast<int>(lanes.size())) {
+      return false;
+    }
+    const LaneInfo& lane = *lanes[lane_index];
+    const auto& accumulated_s = lane.accumulate_s();
+    const auto& lane_points = lane.points();
+    if (lane_points.size() < 2) {
+      // same as the point look-up for a degenerate lane
+      if (!SmoothPointFromLane(lane_ids[lane_index], lane_s[i], lane_l[i],
+                               &(*points)[i], &(*headings)[i])) {
+        return false;
+      }
+      prev_lane_index = lane_index;
+      continue;
+    }
+    const double s =
+        common::math::Clamp(lane_s[i], 0.0, lane.total_length());
+    // the first index with accumulated s not less than s, starting from the
+    // previous one on the same lane
+    if (lane_index != prev_lane_index ||
+        (index > 0 && accumulated_s[index - 1] >= s)) {
+      index = std::lower_bound(accumulated_s.begin(), accumulated_s.end(), s) -
+              accumulated_s.begin();
+    } else {
+      while (index + 1 < accumulated_s.size() && accumulated_s[index] < s) {
+        ++index;
+      }
+    }
+    prev_lane_index = lane_index;
+
+    Vec2d smooth_point = lane_points[index];
+    double heading = lane.headings()[index];
+    const double delta_s = accumulated_s[index] - s;
+    if (index > 0 && delta_s >= common::math::kMathEpsilon) {
+      smooth_point = lane_points[index] -
+                     lane.unit_directions()[index - 1] * delta_s;
+      heading = common::math::slerp(
+          lane.headings()[index - 1], accumulated_s[index - 1],
+          lane.headings()[index], accumulated_s[index], s);
+    }
+    (*headings)[i] = heading;
+    (*points)[i].x() = smooth_point.x() - std::sin(heading) * lane_l[i];
+    (*points)[i].y() = smooth_point.y() + std::cos(heading) * lane_l[i];
+  }
+  return true;
+}
+
 void PredictionMap::NearbyLanesByCurrentLanes(
     const Eigen::Vector2d& point, const double heading, const double radius,
     const std::vector<std::shared_ptr<const LaneInfo>>& lanes,
@@ -257,6 +257,25 @@ class PredictionMap {
                                   const double l, Eigen::Vector2d* point,
                                   double* heading);
 
+  /**
+   * @brief Get the smooth points of a sequence of positions on lanes, walking
+   *        along the lane polylines instead of searching them per position.
+   * @param lane_ids The lane IDs, each looked up once.
+   * @param lane_indices The index in lane_ids of the lane of each position;
+   *        positions on the same lane are fastest with non-decreasing s.
+   * @param lane_s The longitudinal coordinate of each position.
+   * @param lane_l The lateral coordinate of each position.
+   * @param points The points corresponding to the positions.
+   * @param headings The lane headings on the points.
+   * @return If the process is successful.
+   */
+  static bool SmoothPointsFromLanes(const std::vector<std::string>& lane_ids,
+                                    const std::vector<int>& lane_indices,
+                                    const std::vector<double>& lane_s,
+                                    const std::vector<double>& lane_l,
+                                    std::vector<Eigen::Vector2d>* points,
+                                    std::vector<double>* headings);
+
   /**
    * @brief Get nearby lanes by a position and current lanes.
    * @param point The position to search its nearby lanes.
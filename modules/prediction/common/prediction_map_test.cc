@@ -164,6 +164,42 @@ TEST_F(PredictionMapTest, get_smooth_point_from_lane) {
   EXPECT_DOUBLE_EQ(-0.066794953844859783, heading);
 }
 
+TEST_F(PredictionMapTest, get_smooth_points_from_lanes) {
+  const std::vector<std::string> lane_ids = {"l20", "l21"};
+  std::vector<int> lane_indices;
+  std::vector<double> lane_s;
+  std::vector<double> lane_l;
+  for (int i = 0; i < 20; ++i) {
+    lane_indices.push_back(i < 12 ? 0 : 1);
+    lane_s.push_back(i < 12 ? i * 2.5 : (i - 12) * 2.5);
+    lane_l.push_back(0.1 * i);
+  }
+  // an s going backward on the same lane
+  lane_indices.push_back(1);
+  lane_s.push_back(1.0);
+  lane_l.push_back(0.0);
+
+  std::vector<Eigen::Vector2d> points;
+  std::vector<double> headings;
+  EXPECT_TRUE(PredictionMap::SmoothPointsFromLanes(
+      lane_ids, lane_indices, lane_s, lane_l, &points, &headings));
+  ASSERT_EQ(points.size(), lane_s.size());
+  ASSERT_EQ(headings.size(), lane_s.size());
+  for (size_t i = 0; i < lane_s.size(); ++i) {
+    Eigen::Vector2d point;
+    double heading = M_PI;
+    EXPECT_TRUE(PredictionMap::SmoothPointFromLane(
+        lane_ids[lane_indices[i]], lane_s[i], lane_l[i], &point, &heading));
+    EXPECT_NEAR(point.x(), points[i].x(), 1e-6);
+    EXPECT_NEAR(point.y(), points[i].y(), 1e-6);
+    EXPECT_NEAR(heading, headings[i], 1e-6);
+  }
+
+  lane_indices.back() = 2;
+  EXPECT_FALSE(PredictionMap::SmoothPointsFromLanes(
+      lane_ids, lane_indices, lane_s, lane_l, &points, &headings));
+}
+
 TEST_F(PredictionMapTest, get_nearby_lanes_by_current_lanes) {
   std::vector<std::shared_ptr<const LaneInfo>> curr_lanes(0);
   curr_lanes.emplace_back(PredictionMap::LaneById("l20"));
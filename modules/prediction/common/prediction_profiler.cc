@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/prediction_profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "cyber/common/log.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+PredictionProfiler::PredictionProfiler() {}
+
+PredictionProfiler::ScopedTimer::ScopedTimer(const std::string& stage,
+                                             const std::string& type,
+                                             const size_t num_obstacles)
+    : enabled_(FLAGS_enable_prediction_profiling) {
+  if (!enabled_) {
+    return;
+  }
+  name_ = type.empty() ? stage : stage + "/" + type;
+  num_obstacles_ = num_obstacles;
+  start_time_ = std::chrono::steady_clock::now();
+}
+
+PredictionProfiler::ScopedTimer::~ScopedTimer() {
+  if (!enabled_) {
+    return;
+  }
+  auto duration = std::chrono::steady_clock::now() - start_time_;
+  PredictionProfiler::Instance()->Record(
+      name_,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+      num_obstacles_);
+}
+
+void PredictionProfiler::StartFrame(const size_t num_obstacles) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  density_bucket_ = DensityBucket(num_obstacles);
+  frame_records_.clear();
+  frame_records_["frame"].num_obstacles = num_obstacles;
+  frame_start_time_ = std::chrono::steady_clock::now();
+}
+
+void PredictionProfiler::Record(const std::string& name,
+                                const uint64_t nanoseconds,
+                                const size_t num_obstacles) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  FrameRecord& record = frame_records_[name];
+  record.nanoseconds += nanoseconds;
+  record.num_obstacles += num_obstacles;
+}
+
+void PredictionProfiler::EndFrame() {
+  const uint64_t report_interval = static_cast<uint64_t>(
+      std::max(FLAGS_prediction_profiling_report_interval, 1));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AggregateFrame();
+    if (++num_frames_ % report_interval != 0) {
+      return;
+    }
+  }
+  AINFO << "Prediction profile after " << report_interval << " frames:\n"
+        << DebugString();
+}
+
+void PredictionProfiler::AggregateFrame() {
+  frame_records_["frame"].nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - frame_start_time_)
+          .count();
+  // the total time of a model within the frame is what competes for the
+  // frame budget, so the histograms take one sample per frame
+  for (const auto& name_record : frame_records_) {
+    auto& aggregate = aggregates_[{name_record.first, density_bucket_}];
+    if (aggregate == nullptr) {
+      aggregate.reset(new Aggregate());
+    }
+    aggregate->histogram.Record(name_record.second.nanoseconds);
+    aggregate->num_obstacles += name_record.second.num_obstacles;
+    ADEBUG << "Prediction profile [" << name_record.first << "]: "
+           << static_cast<double>(name_record.second.nanoseconds) * 1e-6
+           << " ms for " << name_record.second.num_obstacles << " obstacles.";
+  }
+}
+
+std::string PredictionProfiler::DebugString() const {
+  static const char* kDensityNames[kNumDensityBuckets] = {"<8", "8-15",
+                                                          "16-31", "32-63",
+                                                          "64+"};
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  for (const auto& key_aggregate : aggregates_) {
+    const auto& histogram = key_aggregate.second->histogram;
+    const uint64_t count = histogram.Count();
+    if (count == 0) {
+      continue;
+    }
+    os << key_aggregate.first.first
+       << " obstacles=" << kDensityNames[key_aggregate.first.second]
+       << " frames=" << count << " mean_ms="
+       << static_cast<double>(histogram.Sum()) * 1e-6 /
+              static_cast<double>(count)
+       << " p50_us<" << histogram.Percentile(0.5)
+       << " p99_us<" << histogram.Percentile(0.99)
+       << " max_ms=" << static_cast<double>(histogram.Max()) * 1e-6
+       << " obstacles_per_frame="
+       << static_cast<double>(key_aggregate.second->num_obstacles) /
+              static_cast<double>(count)
+       << "\n";
+  }
+  return os.str();
+}
+
+void PredictionProfiler::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  density_bucket_ = 0;
+  num_frames_ = 0;
+  frame_records_.clear();
+  aggregates_.clear();
+}
+
+size_t PredictionProfiler::DensityBucket(const size_t num_obstacles) {
+  size_t bucket = 0;
+  for (size_t bound = 8; bucket + 1 < kNumDensityBuckets; bound *= 2) {
+    if (num_obstacles < bound) {
+      break;
+    }
+    ++bucket;
+  }
+  return bucket;
+}
+
+}  // namespace prediction
+}  // namespace apollo
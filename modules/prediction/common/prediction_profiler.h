@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Latency of the prediction stages and models, aggregated by the
+ *        number of obstacles of the frames
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "cyber/base/latency_histogram.h"
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace prediction {
+
+class PredictionProfiler {
+ public:
+  /**
+   * @brief Time a scope and record it when profiling is enabled
+   */
+  class ScopedTimer {
+   public:
+    /**
+     * @brief Constructor
+     * @param Stage of the frame, e.g. evaluator
+     * @param Model type within the stage, empty for the whole stage
+     * @param Number of obstacles processed in the scope
+     */
+    explicit ScopedTimer(const std::string& stage,
+                         const std::string& type = "",
+                         const size_t num_obstacles = 1);
+
+    ~ScopedTimer();
+
+   private:
+    bool enabled_ = false;
+    std::string name_;
+    size_t num_obstacles_ = 0;
+    std::chrono::steady_clock::time_point start_time_;
+  };
+
+  /**
+   * @brief Start a frame
+   * @param Number of perception obstacles of the frame
+   */
+  void StartFrame(const size_t num_obstacles);
+
+  /**
+   * @brief Add a duration to the current frame
+   * @param Name of the stage or model
+   * @param Duration in nanoseconds
+   * @param Number of obstacles processed
+   */
+  void Record(const std::string& name, const uint64_t nanoseconds,
+              const size_t num_obstacles);
+
+  /**
+   * @brief End the current frame and add its durations to the histograms
+   */
+  void EndFrame();
+
+  /**
+   * @brief Get the report of the histograms
+   * @return One line per name and obstacle density
+   */
+  std::string DebugString() const;
+
+  /**
+   * @brief Remove all the records
+   */
+  void Reset();
+
+  /**
+   * @brief Get the density bucket of a frame
+   * @param Number of obstacles of the frame
+   * @return 0 for less than 8 obstacles, i for [8 * 2^(i-1), 8 * 2^i)
+   */
+  static size_t DensityBucket(const size_t num_obstacles);
+
+ private:
+  struct FrameRecord {
+    uint64_t nanoseconds = 0;
+    size_t num_obstacles = 0;
+  };
+
+  struct Aggregate {
+    cyber::base::LatencyHistogram histogram;
+    uint64_t num_obstacles = 0;
+  };
+
+  static const size_t kNumDensityBuckets = 5;
+
+  // requires mutex_ held
+  void AggregateFrame();
+
+  size_t density_bucket_ = 0;
+  uint64_t num_frames_ = 0;
+  std::chrono::steady_clock::time_point frame_start_time_;
+  std::map<std::string, FrameRecord> frame_records_;
+  std::map<std::pair<std::string, size_t>, std::unique_ptr<Aggregate>>
+      aggregates_;
+  mutable std::mutex mutex_;
+
+  DECLARE_SINGLETON(PredictionProfiler)
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/prediction_profiler.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/prediction/common/prediction_system_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+TEST(PredictionProfilerTest, DensityBucket) {
+  EXPECT_EQ(PredictionProfiler::DensityBucket(0), 0);
+  EXPECT_EQ(PredictionProfiler::DensityBucket(7), 0);
+  EXPECT_EQ(PredictionProfiler::DensityBucket(8), 1);
+  EXPECT_EQ(PredictionProfiler::DensityBucket(31), 2);
+  EXPECT_EQ(PredictionProfiler::DensityBucket(32), 3);
+  EXPECT_EQ(PredictionProfiler::DensityBucket(64), 4);
+  EXPECT_EQ(PredictionProfiler::DensityBucket(1000), 4);
+}
+
+TEST(PredictionProfilerTest, AggregateByDensity) {
+  auto* profiler = PredictionProfiler::Instance();
+  profiler->Reset();
+
+  profiler->StartFrame(3);
+  profiler->Record("evaluator/MLP_EVALUATOR", 2000000, 1);
+  profiler->Record("evaluator/MLP_EVALUATOR", 2000000, 1);
+  profiler->EndFrame();
+
+  profiler->StartFrame(40);
+  profiler->Record("evaluator/MLP_EVALUATOR", 8000000, 20);
+  profiler->EndFrame();
+
+  const std::string report = profiler->DebugString();
+  EXPECT_NE(
+      report.find("evaluator/MLP_EVALUATOR obstacles=<8 frames=1 "
+                  "mean_ms=4.000"),
+      std::string::npos);
+  EXPECT_NE(
+      report.find("evaluator/MLP_EVALUATOR obstacles=32-63 frames=1 "
+                  "mean_ms=8.000"),
+      std::string::npos);
+  EXPECT_NE(report.find("frame obstacles=<8 frames=1"), std::string::npos);
+  EXPECT_NE(report.find("obstacles_per_frame=20.000"), std::string::npos);
+
+  profiler->Reset();
+  EXPECT_TRUE(profiler->DebugString().empty());
+}
+
+TEST(PredictionProfilerTest, ScopedTimer) {
+  auto* profiler = PredictionProfiler::Instance();
+  profiler->Reset();
+
+  profiler->StartFrame(1);
+  FLAGS_enable_prediction_profiling = false;
+  { PredictionProfiler::ScopedTimer timer("predictor", "FREE_MOVE"); }
+  FLAGS_enable_prediction_profiling = true;
+  { PredictionProfiler::ScopedTimer timer("evaluator", "COST_EVALUATOR"); }
+  FLAGS_enable_prediction_profiling = false;
+  profiler->EndFrame();
+
+  const std::string report = profiler->DebugString();
+  EXPECT_EQ(report.find("predictor/FREE_MOVE"), std::string::npos);
+  EXPECT_NE(report.find("evaluator/COST_EVALUATOR obstacles=<8 frames=1"),
+            std::string::npos);
+  profiler->Reset();
+}
+
+}  // namespace prediction
+}  // namespace apollo
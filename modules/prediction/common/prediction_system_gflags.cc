@@ -54,13 +54,35 @@ DEFINE_int32(prediction_offline_mode, 0,
              "3: dump predicted trajectory to predict_result.*.bin"
              "4: dump frame environment info to frame_env.*.bin"
              "5: dump data for tuning to datatuning.*.bin");
+DEFINE_int32(prediction_offline_num_workers, 1,
+             "Number of worker processes the offline records are sharded to.");
+DEFINE_int32(prediction_offline_records_per_partition, 0,
+             "Number of records dumped into one output partition of a worker, "
+             "0 to dump all records of a worker into one partition.");
 DEFINE_bool(enable_multi_thread, true, "If enable multi-thread.");
 DEFINE_int32(max_thread_num, 8, "Maximal number of threads.");
 DEFINE_int32(max_caution_thread_num, 2,
              "Maximal number of threads for caution obstacles.");
+DEFINE_bool(enable_parallel_obstacle_insertion, false,
+            "If build the features of the perception obstacles in parallel.");
 DEFINE_bool(enable_async_draw_base_image, true,
             "If enable async to draw base image");
 DEFINE_bool(use_cuda, true, "If use cuda for torch.");
+DEFINE_bool(enable_batched_evaluation, false,
+            "If evaluate the obstacles assigned to the same evaluator with "
+            "one batched inference.");
+DEFINE_int32(max_evaluation_batch_size, 32,
+             "Maximal number of obstacles in one batched inference.");
+DEFINE_bool(enable_anytime_prediction, false,
+            "If process caution obstacles first and fall back to free move "
+            "prediction for the others once the frame time budget is spent.");
+DEFINE_double(prediction_frame_time_budget, 0.08,
+              "Time budget in seconds of evaluating and predicting a frame.");
+DEFINE_bool(enable_prediction_profiling, false,
+            "Record the latency of every prediction stage and model type.");
+DEFINE_int32(prediction_profiling_report_interval, 100,
+             "Number of frames between two reports of the latency "
+             "histograms.");
 
 // Bag replay timestamp gap
 DEFINE_double(replay_timestamp_gap, 10.0,
@@ -32,11 +32,20 @@ DECLARE_double(prediction_test_duration);
 
 DECLARE_string(prediction_offline_bags);
 DECLARE_int32(prediction_offline_mode);
+DECLARE_int32(prediction_offline_num_workers);
+DECLARE_int32(prediction_offline_records_per_partition);
 DECLARE_bool(enable_multi_thread);
 DECLARE_int32(max_thread_num);
 DECLARE_int32(max_caution_thread_num);
+DECLARE_bool(enable_parallel_obstacle_insertion);
 DECLARE_bool(enable_async_draw_base_image);
 DECLARE_bool(use_cuda);
+DECLARE_bool(enable_batched_evaluation);
+DECLARE_int32(max_evaluation_batch_size);
+DECLARE_bool(enable_anytime_prediction);
+DECLARE_double(prediction_frame_time_budget);
+DECLARE_bool(enable_prediction_profiling);
+DECLARE_int32(prediction_profiling_report_interval);
 
 // Bag replay timestamp gap
 DECLARE_double(replay_timestamp_gap);
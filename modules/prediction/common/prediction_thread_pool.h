@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <functional>
 #include <future>
+#include <iterator>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -42,9 +44,28 @@ class BaseThreadPool {
   template <typename InputIter, typename F>
   void ForEach(InputIter begin, InputIter end, F f) {
     std::vector<std::future<void>> futures;
+    std::vector<std::function<void()>> tasks;
     for (auto iter = begin; iter != end; ++iter) {
       auto& elem = *iter;
-      futures.emplace_back(this->Post([&] { f(elem); }));
+      auto task =
+          std::make_shared<std::packaged_task<void()>>([&] { f(elem); });
+      futures.emplace_back(task->get_future());
+      tasks.emplace_back([task]() { (*task)(); });
+    }
+    // the whole fan-out is queued with a few bulk enqueues, when the queue
+    // is full or stopped the caller runs a task itself instead of dropping it
+    uint64_t posted = 0;
+    while (posted < tasks.size()) {
+      uint64_t num = 0;
+      if (!stopped_) {
+        num = task_queue_.EnqueueBulk(
+            std::make_move_iterator(tasks.begin() + posted),
+            tasks.size() - posted);
+      }
+      if (num == 0) {
+        tasks[posted++]();
+      }
+      posted += num;
     }
     for (auto& future : futures) {
       if (future.valid()) {
@@ -33,6 +33,20 @@ TEST(PredictionThreadPoolTest, global_for_each) {
   EXPECT_EQ(expect, real);
 }
 
+TEST(PredictionThreadPoolTest, for_each_more_than_queue) {
+  std::vector<int> expect(500);
+  std::vector<int> real(500);
+  for (int i = 0; i < 500; ++i) {
+    expect[i] = i + 1;
+    real[i] = i;
+  }
+
+  PredictionThreadPool::ForEach(real.begin(), real.end(),
+                                [](int& input) { ++input; });
+
+  EXPECT_EQ(expect, real);
+}
+
 /* TODO(kechxu) uncomment this when deadlock issue is fixed
 TEST(PredictionThreadPoolTest, avoid_deadlock) {
   std::vector<int> expect = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
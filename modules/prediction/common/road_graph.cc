@@ -17,9 +17,12 @@
 #include "modules/prediction/common/road_graph.h"
 
 #include <algorithm>
+#include <cmath>
 #include <set>
 #include <utility>
 
+#include "absl/strings/str_cat.h"
+#include "modules/prediction/common/lane_graph_cache.h"
 #include "modules/prediction/common/prediction_constants.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
@@ -81,6 +84,21 @@ bool IsAtLeft(std::shared_ptr<const LaneInfo> lane1,
   return HeadingIsAtLeft(lane1->headings(), lane2->headings(), 0);
 }
 
+bool IsSameLaneSequence(const LaneSequence& lane_sequence1,
+                        const LaneSequence& lane_sequence2) {
+  if (lane_sequence1.lane_segment_size() !=
+      lane_sequence2.lane_segment_size()) {
+    return false;
+  }
+  for (int i = 0; i < lane_sequence1.lane_segment_size(); ++i) {
+    if (lane_sequence1.lane_segment(i).lane_id() !=
+        lane_sequence2.lane_segment(i).lane_id()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
 RoadGraph::RoadGraph(const double start_s, const double length,
@@ -105,6 +123,11 @@ Status RoadGraph::BuildLaneGraph(LaneGraph* const lane_graph_ptr) {
     return Status(ErrorCode::PREDICTION_ERROR, error_msg);
   }
 
+  if (FLAGS_enable_lane_graph_cache) {
+    BuildLaneGraphFromCache(lane_graph_ptr);
+    return Status::OK();
+  }
+
   // Run the recursive function to perform DFS.
   std::list<LaneSegment> lane_segments;
   double accumulated_s = 0.0;
@@ -147,6 +170,66 @@ Status RoadGraph::BuildLaneGraphBidirection(LaneGraph* const lane_graph_ptr) {
   return Status::OK();
 }
 
+void RoadGraph::BuildLaneGraphFromCache(
+    LaneGraph* const lane_graph_ptr) const {
+  // Past the start lane, the lane sequences only depend on how far the
+  // search reaches from the beginning of the start lane. A graph searched
+  // up to the next bucket holds every sequence of this graph as a prefix.
+  const double curr_s =
+      start_s_ >= 0.0 ? start_s_ : lane_info_ptr_->total_length();
+  const double bucket = std::max(FLAGS_lane_graph_cache_horizon_bucket, 0.1);
+  const int64_t bucket_idx =
+      static_cast<int64_t>(std::floor((curr_s + length_) / bucket)) + 1;
+  const std::string key = absl::StrCat(lane_info_ptr_->id().id(), "|",
+                                       consider_divide_, "|", bucket_idx);
+  std::shared_ptr<const LaneGraph> cached_lane_graph =
+      LaneGraphCache::Instance()->Get(key);
+  if (cached_lane_graph == nullptr) {
+    RoadGraph road_graph(0.0, static_cast<double>(bucket_idx) * bucket,
+                         consider_divide_, lane_info_ptr_);
+    LaneGraph lane_graph;
+    std::list<LaneSegment> lane_segments;
+    road_graph.ConstructLaneSequence(0.0, 0.0, lane_info_ptr_,
+                                     FLAGS_road_graph_max_search_horizon,
+                                     consider_divide_, &lane_segments,
+                                     &lane_graph);
+    cached_lane_graph =
+        LaneGraphCache::Instance()->Put(key, std::move(lane_graph));
+  }
+
+  // Cut the cached sequences where this search ends, with the same s
+  // arithmetic as ConstructLaneSequence.
+  for (const auto& cached_sequence : cached_lane_graph->lane_sequence()) {
+    LaneSequence lane_sequence;
+    double accumulated_s = 0.0;
+    double lane_seg_s = curr_s;
+    for (const auto& cached_segment : cached_sequence.lane_segment()) {
+      LaneSegment* lane_segment = lane_sequence.add_lane_segment();
+      lane_segment->set_adc_s(lane_seg_s);
+      lane_segment->set_lane_id(cached_segment.lane_id());
+      lane_segment->set_lane_turn_type(cached_segment.lane_turn_type());
+      lane_segment->set_total_length(cached_segment.total_length());
+      lane_segment->set_start_s(lane_seg_s);
+      lane_segment->set_end_s(
+          std::fmin(lane_seg_s + length_ - accumulated_s,
+                    cached_segment.total_length()));
+      if (lane_segment->end_s() < cached_segment.total_length()) {
+        break;
+      }
+      accumulated_s += cached_segment.total_length() - lane_seg_s;
+      lane_seg_s = 0.0;
+    }
+    // sequences cut at the same lane come one after another
+    const int num_sequences = lane_graph_ptr->lane_sequence_size();
+    if (num_sequences > 0 &&
+        IsSameLaneSequence(
+            lane_graph_ptr->lane_sequence(num_sequences - 1), lane_sequence)) {
+      continue;
+    }
+    *lane_graph_ptr->add_lane_sequence() = std::move(lane_sequence);
+  }
+}
+
 LaneGraph RoadGraph::CombineLaneGraphs(const LaneGraph& lane_graph_predecessor,
                                        const LaneGraph& lane_graph_successor) {
   LaneGraph final_lane_graph;
@@ -61,6 +61,13 @@ class RoadGraph {
                      const LaneGraph& lane_graph);
 
  private:
+  /**
+   * @brief Build the lane graph from the lane sequences cached for the start
+   *        lane, which reach at least as far as this lane graph.
+   * @param The built lane graph.
+   */
+  void BuildLaneGraphFromCache(LaneGraph* const lane_graph_ptr) const;
+
   /** @brief Combine the lane-graph of forward direction and that of backward
    *        direction together.
    */
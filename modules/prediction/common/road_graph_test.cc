@@ -17,6 +17,8 @@
 #include "modules/prediction/common/road_graph.h"
 
 #include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/lane_graph_cache.h"
+#include "modules/prediction/common/prediction_gflags.h"
 
 namespace apollo {
 namespace prediction {
@@ -57,6 +59,30 @@ TEST_F(RoadGraphTest, General) {
   }
 }
 
+TEST_F(RoadGraphTest, Cached) {
+  auto lane = PredictionMap::LaneById("l9");
+  EXPECT_NE(lane, nullptr);
+
+  for (double start_s : {0.0, 50.0, 99.0}) {
+    for (double length : {10.0, 100.0, 150.0}) {
+      RoadGraph road_graph(start_s, length, true, lane);
+      LaneGraph lane_graph;
+      EXPECT_TRUE(road_graph.BuildLaneGraph(&lane_graph).ok());
+
+      FLAGS_enable_lane_graph_cache = true;
+      // the second build reads the lane graph cached by the first one
+      for (int i = 0; i < 2; ++i) {
+        LaneGraph cached_lane_graph;
+        EXPECT_TRUE(road_graph.BuildLaneGraph(&cached_lane_graph).ok());
+        EXPECT_EQ(lane_graph.DebugString(), cached_lane_graph.DebugString());
+      }
+      FLAGS_enable_lane_graph_cache = false;
+    }
+  }
+  EXPECT_GT(LaneGraphCache::Instance()->Size(), 0);
+  LaneGraphCache::Instance()->Clear();
+}
+
 /*
 TEST_F(RoadGraphTest, NegativeStartS) {
   auto lane = PredictionMap::LaneById("l9");
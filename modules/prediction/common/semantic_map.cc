@@ -16,6 +16,8 @@
 
 #include "modules/prediction/common/semantic_map.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 #include <vector>
 
@@ -70,11 +72,9 @@ void SemanticMap::RunCurrFrame(
 
   ego_feature_ = obstacle_id_history_map.at(FLAGS_ego_vehicle_id).feature(0);
   if (!FLAGS_enable_async_draw_base_image) {
-    double x = ego_feature_.position().x();
-    double y = ego_feature_.position().y();
-    curr_base_x_ = x - FLAGS_base_image_half_range;
-    curr_base_y_ = y - FLAGS_base_image_half_range;
-    DrawBaseMap(x, y, curr_base_x_, curr_base_y_);
+    GetBasePoint(ego_feature_.position().x(), ego_feature_.position().y(),
+                 &curr_base_x_, &curr_base_y_);
+    DrawBaseMap(curr_base_x_, curr_base_y_);
     base_img_.copyTo(curr_img_);
   } else {
     base_img_.copyTo(curr_img_);
@@ -107,30 +107,94 @@ void SemanticMap::RunCurrFrame(
   }
 }
 
-void SemanticMap::DrawBaseMap(const double x, const double y,
-                              const double base_x, const double base_y) {
+void SemanticMap::GetBasePoint(const double x, const double y,
+                               double* base_x, double* base_y) {
+  *base_x = x - FLAGS_base_image_half_range;
+  *base_y = y - FLAGS_base_image_half_range;
+  if (!FLAGS_enable_semantic_map_tile_cache) {
+    return;
+  }
+  // a whole number of pixels per tile keeps the shifts pixel exact
+  const double tile_size =
+      std::max(std::round(FLAGS_semantic_map_tile_size / 0.1), 1.0) * 0.1;
+  *base_x = std::round(*base_x / tile_size) * tile_size;
+  *base_y = std::round(*base_y / tile_size) * tile_size;
+}
+
+void SemanticMap::DrawBaseMap(const double base_x, const double base_y) {
+  if (FLAGS_enable_semantic_map_tile_cache && ShiftBaseMap(base_x, base_y)) {
+    return;
+  }
   base_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
+  drawn_base_x_ = base_x;
+  drawn_base_y_ = base_y;
+  DrawBaseMapArea(cv::Rect(0, 0, base_img_.cols, base_img_.rows), base_x,
+                  base_y);
+}
+
+bool SemanticMap::ShiftBaseMap(const double base_x, const double base_y) {
+  if (base_img_.empty()) {
+    return false;
+  }
+  const int size = base_img_.cols;
+  const int dx = static_cast<int>(std::lround((base_x - drawn_base_x_) / 0.1));
+  const int dy = static_cast<int>(std::lround((base_y - drawn_base_y_) / 0.1));
+  if (std::abs(dx) >= size || std::abs(dy) >= size) {
+    return false;
+  }
+  drawn_base_x_ = base_x;
+  drawn_base_y_ = base_y;
+  if (dx == 0 && dy == 0) {
+    return true;
+  }
+
+  // pixel (col, row) of the old image is pixel (col - dx, row + dy) now
+  const int width = size - std::abs(dx);
+  const int height = size - std::abs(dy);
+  cv::Mat img(size, size, CV_8UC3, cv::Scalar(0, 0, 0));
+  base_img_(cv::Rect(std::max(dx, 0), std::max(-dy, 0), width, height))
+      .copyTo(img(cv::Rect(std::max(-dx, 0), std::max(dy, 0), width, height)));
+  base_img_ = img;
+
+  if (dx != 0) {
+    DrawBaseMapArea(cv::Rect(dx > 0 ? width : 0, 0, std::abs(dx), size),
+                    base_x, base_y);
+  }
+  if (dy != 0) {
+    DrawBaseMapArea(cv::Rect(0, dy > 0 ? 0 : height, size, std::abs(dy)),
+                    base_x, base_y);
+  }
+  return true;
+}
+
+void SemanticMap::DrawBaseMapArea(const cv::Rect& area, const double base_x,
+                                  const double base_y) {
+  base_img_(area).setTo(cv::Scalar(0, 0, 0));
+  // every map element overlapping the area is within its half diagonal
+  double x = base_x + (area.x + area.width * 0.5) * 0.1;
+  double y = base_y + (base_img_.rows - area.y - area.height * 0.5) * 0.1;
+  double radius = std::hypot(area.width, area.height) * 0.5 * 0.1;
   common::PointENU center_point = common::util::PointFactory::ToPointENU(x, y);
-  DrawRoads(center_point, base_x, base_y);
-  DrawJunctions(center_point, base_x, base_y);
-  DrawCrosswalks(center_point, base_x, base_y);
-  DrawLanes(center_point, base_x, base_y);
+  DrawRoads(center_point, radius, base_x, base_y, area);
+  DrawJunctions(center_point, radius, base_x, base_y, area);
+  DrawCrosswalks(center_point, radius, base_x, base_y, area);
+  DrawLanes(center_point, radius, base_x, base_y, area);
 }
 
 void SemanticMap::DrawBaseMapThread() {
   std::lock_guard<std::mutex> lock(draw_base_map_thread_mutex_);
-  double x = ego_feature_.position().x();
-  double y = ego_feature_.position().y();
-  base_x_ = x - FLAGS_base_image_half_range;
-  base_y_ = y - FLAGS_base_image_half_range;
-  DrawBaseMap(x, y, base_x_, base_y_);
+  GetBasePoint(ego_feature_.position().x(), ego_feature_.position().y(),
+               &base_x_, &base_y_);
+  DrawBaseMap(base_x_, base_y_);
 }
 
 void SemanticMap::DrawRoads(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+                            const double radius, const double base_x,
+                            const double base_y, const cv::Rect& area,
                             const cv::Scalar& color) {
+  cv::Mat img = base_img_(area);
   std::vector<apollo::hdmap::RoadInfoConstPtr> roads;
-  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, 141.4, &roads);
+  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, radius, &roads);
   for (const auto& road : roads) {
     for (const auto& section : road->road().section()) {
       std::vector<cv::Point> polygon;
@@ -152,18 +216,20 @@ void SemanticMap::DrawRoads(const common::PointENU& center_point,
           }
         }
       }
-      cv::fillPoly(base_img_,
+      cv::fillPoly(img,
                    std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-                   color);
+                   color, cv::LINE_8, 0, -area.tl());
     }
   }
 }
 
 void SemanticMap::DrawJunctions(const common::PointENU& center_point,
-                                const double base_x, const double base_y,
+                                const double radius, const double base_x,
+                                const double base_y, const cv::Rect& area,
                                 const cv::Scalar& color) {
+  cv::Mat img = base_img_(area);
   std::vector<apollo::hdmap::JunctionInfoConstPtr> junctions;
-  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, radius,
                                                    &junctions);
   for (const auto& junction : junctions) {
     std::vector<cv::Point> polygon;
@@ -171,17 +237,19 @@ void SemanticMap::DrawJunctions(const common::PointENU& center_point,
       polygon.push_back(
           std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-                 color);
+                 color, cv::LINE_8, 0, -area.tl());
   }
 }
 
 void SemanticMap::DrawCrosswalks(const common::PointENU& center_point,
-                                 const double base_x, const double base_y,
+                                 const double radius, const double base_x,
+                                 const double base_y, const cv::Rect& area,
                                  const cv::Scalar& color) {
+  cv::Mat img = base_img_(area);
   std::vector<apollo::hdmap::CrosswalkInfoConstPtr> crosswalks;
-  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, radius,
                                                     &crosswalks);
   for (const auto& crosswalk : crosswalks) {
     std::vector<cv::Point> polygon;
@@ -189,17 +257,20 @@ void SemanticMap::DrawCrosswalks(const common::PointENU& center_point,
       polygon.push_back(
           std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-                 color);
+                 color, cv::LINE_8, 0, -area.tl());
   }
 }
 
 void SemanticMap::DrawLanes(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+                            const double radius, const double base_x,
+                            const double base_y, const cv::Rect& area,
                             const cv::Scalar& color) {
+  cv::Mat img = base_img_(area);
+  const cv::Point2i offset = area.tl();
   std::vector<apollo::hdmap::LaneInfoConstPtr> lanes;
-  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, 141.4, &lanes);
+  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, radius, &lanes);
   for (const auto& lane : lanes) {
     // Draw lane_central first
     for (const auto& segment : lane->lane().central_curve().segment()) {
@@ -223,7 +294,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         //     cv::Scalar(rgb.at<float>(0, 0) * 255, rgb.at<float>(0, 1) * 255,
         //                rgb.at<float>(0, 2) * 255);
 
-        cv::line(base_img_, p0, p1, HSVtoRGB(H), 4);
+        cv::line(img, p0 - offset, p1 - offset, HSVtoRGB(H), 4);
       }
     }
     // Not drawing boundary for virtual city_driving lane
@@ -240,7 +311,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
                                        segment.line_segment().point(i + 1).y(),
                                        base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        cv::line(img, p0 - offset, p1 - offset, color, 2);
       }
     }
     // Draw lane's right_boundary
@@ -253,7 +324,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
                                        segment.line_segment().point(i + 1).y(),
                                        base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        cv::line(img, p0 - offset, p1 - offset, color, 2);
       }
     }
   }
@@ -283,7 +354,7 @@ cv::Scalar SemanticMap::HSVtoRGB(double H, double S, double V) {
 
 void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Point2i& offset) {
   double obs_l = feature.length();
   double obs_w = feature.width();
   double obs_x = feature.position().x();
@@ -308,36 +379,37 @@ void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
       obs_x + (cos(theta) * obs_l - sin(theta) * -obs_w) / 2,
       obs_y + (sin(theta) * obs_l + cos(theta) * -obs_w) / 2, base_x, base_y)));
   cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+               color, cv::LINE_8, 0, -offset);
 }
 
 void SemanticMap::DrawPoly(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Point2i& offset) {
   std::vector<cv::Point> polygon;
   for (auto& polygon_point : feature.polygon_point()) {
     polygon.push_back(std::move(
         GetTransPoint(polygon_point.x(), polygon_point.y(), base_x, base_y)));
   }
   cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+               color, cv::LINE_8, 0, -offset);
 }
 
 void SemanticMap::DrawHistory(const ObstacleHistory& history,
                               const cv::Scalar& color, const double base_x,
-                              const double base_y, cv::Mat* img) {
+                              const double base_y, cv::Mat* img,
+                              const cv::Point2i& offset) {
   for (int i = history.feature_size() - 1; i >= 0; --i) {
     const Feature& feature = history.feature(i);
     double time_decay = 1.0 - ego_feature_.timestamp() + feature.timestamp();
     cv::Scalar decay_color = color * time_decay;
     if (feature.id() == FLAGS_ego_vehicle_id) {
-      DrawRect(feature, decay_color, base_x, base_y, img);
+      DrawRect(feature, decay_color, base_x, base_y, img, offset);
     } else {
       if (feature.polygon_point_size() == 0) {
         AERROR << "No polygon points in feature, please check!";
         continue;
       }
-      DrawPoly(feature, decay_color, base_x, base_y, img);
+      DrawPoly(feature, decay_color, base_x, base_y, img, offset);
     }
   }
 }
@@ -366,6 +438,42 @@ cv::Mat SemanticMap::CropByHistory(const ObstacleHistory& history,
   return CropArea(feature_map, center_point, curr_feature.theta());
 }
 
+cv::Mat SemanticMap::CropByHistoryLocally(const ObstacleHistory& history,
+                                          const cv::Scalar& color,
+                                          const double base_x,
+                                          const double base_y) {
+  const Feature& curr_feature = history.feature(0);
+  const cv::Point2i& center_point = GetTransPoint(
+      curr_feature.position().x(), curr_feature.position().y(), base_x, base_y);
+  // CropArea keeps [-200, 200) x [-300, 100) around the center after the
+  // rotation, which stays within the circle through its farthest corner
+  const int radius = static_cast<int>(std::ceil(std::hypot(200.0, 300.0))) + 1;
+  cv::Rect area(center_point.x - radius, center_point.y - radius, 2 * radius,
+                2 * radius);
+  area &= cv::Rect(0, 0, curr_img_.cols, curr_img_.rows);
+  if (area.empty()) {
+    return cv::Mat(224, 224, CV_8UC3, cv::Scalar(0, 0, 0));
+  }
+  cv::Mat feature_map = curr_img_(area).clone();
+  DrawHistory(history, color, base_x, base_y, &feature_map, area.tl());
+
+  // rotation as in CropArea, then the crop and the resize of cv::resize,
+  // which maps the centers of the pixels onto each other
+  const cv::Point2f local_center(static_cast<float>(center_point.x - area.x),
+                                 static_cast<float>(center_point.y - area.y));
+  cv::Mat affine_mat = cv::getRotationMatrix2D(
+      local_center, 90.0 - curr_feature.theta() * 180.0 / M_PI, 1.0);
+  affine_mat.at<double>(0, 2) -= local_center.x - 200.0;
+  affine_mat.at<double>(1, 2) -= local_center.y - 300.0;
+  const double scale = 224.0 / 400.0;
+  affine_mat *= scale;
+  affine_mat.at<double>(0, 2) += 0.5 * scale - 0.5;
+  affine_mat.at<double>(1, 2) += 0.5 * scale - 0.5;
+  cv::Mat output_img;
+  cv::warpAffine(feature_map, output_img, affine_mat, cv::Size(224, 224));
+  return output_img;
+}
+
 bool SemanticMap::GetMapById(const int obstacle_id, cv::Mat* feature_map) {
   if (obstacle_id_history_map_.find(obstacle_id) ==
       obstacle_id_history_map_.end()) {
@@ -378,8 +486,11 @@ bool SemanticMap::GetMapById(const int obstacle_id, cv::Mat* feature_map) {
   }
 
   cv::Mat output_img =
-      CropByHistory(obstacle_id_history_map_[obstacle_id],
-                    cv::Scalar(0, 0, 255), curr_base_x_, curr_base_y_);
+      FLAGS_enable_semantic_map_local_crop
+          ? CropByHistoryLocally(obstacle_history, cv::Scalar(0, 0, 255),
+                                 curr_base_x_, curr_base_y_)
+          : CropByHistory(obstacle_history, cv::Scalar(0, 0, 255),
+                          curr_base_x_, curr_base_y_);
   output_img.copyTo(*feature_map);
   return true;
 }
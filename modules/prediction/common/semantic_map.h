@@ -47,37 +47,55 @@ class SemanticMap {
                        static_cast<int>(2000 - (y - base_y) / 0.1));
   }
 
-  void DrawBaseMap(const double x, const double y, const double base_x,
-                   const double base_y);
+  void GetBasePoint(const double x, const double y, double* base_x,
+                    double* base_y);
+
+  void DrawBaseMap(const double base_x, const double base_y);
+
+  // Moves base_img_ to the new base point, keeping the overlapping pixels
+  // and drawing the newly entered areas only. Returns false if base_img_ has
+  // no overlap with the new base image.
+  bool ShiftBaseMap(const double base_x, const double base_y);
+
+  void DrawBaseMapArea(const cv::Rect& area, const double base_x,
+                       const double base_y);
 
   void DrawBaseMapThread();
 
-  void DrawRoads(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  void DrawRoads(const common::PointENU& center_point, const double radius,
+                 const double base_x, const double base_y,
+                 const cv::Rect& area,
                  const cv::Scalar& color = cv::Scalar(64, 64, 64));
 
-  void DrawJunctions(const common::PointENU& center_point, const double base_x,
-                     const double base_y,
+  void DrawJunctions(const common::PointENU& center_point, const double radius,
+                     const double base_x, const double base_y,
+                     const cv::Rect& area,
                      const cv::Scalar& color = cv::Scalar(128, 128, 128));
 
-  void DrawCrosswalks(const common::PointENU& center_point, const double base_x,
-                      const double base_y,
+  void DrawCrosswalks(const common::PointENU& center_point, const double radius,
+                      const double base_x, const double base_y,
+                      const cv::Rect& area,
                       const cv::Scalar& color = cv::Scalar(192, 192, 192));
 
-  void DrawLanes(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  void DrawLanes(const common::PointENU& center_point, const double radius,
+                 const double base_x, const double base_y,
+                 const cv::Rect& area,
                  const cv::Scalar& color = cv::Scalar(255, 255, 255));
 
   cv::Scalar HSVtoRGB(double H = 1.0, double S = 1.0, double V = 1.0);
 
+  // offset is the position of img in the base image
   void DrawRect(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Point2i& offset = cv::Point2i(0, 0));
 
   void DrawPoly(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Point2i& offset = cv::Point2i(0, 0));
 
   void DrawHistory(const ObstacleHistory& history, const cv::Scalar& color,
-                   const double base_x, const double base_y, cv::Mat* img);
+                   const double base_x, const double base_y, cv::Mat* img,
+                   const cv::Point2i& offset = cv::Point2i(0, 0));
 
   cv::Mat CropArea(const cv::Mat& input_img, const cv::Point2i& center_point,
                    const double heading);
@@ -85,12 +103,22 @@ class SemanticMap {
   cv::Mat CropByHistory(const ObstacleHistory& history, const cv::Scalar& color,
                         const double base_x, const double base_y);
 
+  // Same as CropByHistory, but only copies and draws the area that the
+  // rotated crop can reach, then rotates, crops and resizes it at once.
+  cv::Mat CropByHistoryLocally(const ObstacleHistory& history,
+                               const cv::Scalar& color, const double base_x,
+                               const double base_y);
+
  private:
   // base_image, base_x, and base_y to be updated by async thread
   cv::Mat base_img_;
   double base_x_ = 0.0;
   double base_y_ = 0.0;
 
+  // the base point base_img_ is drawn for
+  double drawn_base_x_ = 0.0;
+  double drawn_base_y_ = 0.0;
+
   std::mutex draw_base_map_thread_mutex_;
 
   // base_image, base_x, and base_y to be used in the current cycle
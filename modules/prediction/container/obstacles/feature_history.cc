@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+FeatureHistory::FeatureHistory(const size_t capacity)
+    : capacity_(capacity),
+      flags_(capacity, 0),
+      timestamp_(capacity, 0.0),
+      position_x_(capacity, 0.0),
+      position_y_(capacity, 0.0),
+      velocity_x_(capacity, 0.0),
+      velocity_y_(capacity, 0.0),
+      acceleration_x_(capacity, 0.0),
+      acceleration_y_(capacity, 0.0),
+      speed_(capacity, 0.0),
+      acc_(capacity, 0.0),
+      velocity_heading_(capacity, 0.0),
+      theta_(capacity, 0.0),
+      length_(capacity, 0.0),
+      width_(capacity, 0.0),
+      lane_id_(capacity),
+      lane_turn_type_(capacity, 0),
+      lane_s_(capacity, 0.0),
+      lane_l_(capacity, 0.0),
+      angle_diff_(capacity, 0.0),
+      dist_to_left_boundary_(capacity, 0.0),
+      dist_to_right_boundary_(capacity, 0.0),
+      lane_heading_(capacity, 0.0) {
+  ACHECK(capacity > 0);
+}
+
+void FeatureHistory::PushFront(const Feature& feature) {
+  head_ = (head_ + capacity_ - 1) % capacity_;
+  if (size_ < capacity_) {
+    ++size_;
+  }
+  const size_t k = head_;
+  uint8_t flags = 0;
+  if (feature.has_position()) {
+    flags |= kHasPosition;
+  }
+  if (feature.has_velocity()) {
+    flags |= kHasVelocity;
+  }
+  if (feature.has_acceleration()) {
+    flags |= kHasAcceleration;
+  }
+  if (feature.has_velocity_heading()) {
+    flags |= kHasVelocityHeading;
+  }
+  if (feature.is_still()) {
+    flags |= kIsStill;
+  }
+  timestamp_[k] = feature.timestamp();
+  position_x_[k] = feature.position().x();
+  position_y_[k] = feature.position().y();
+  velocity_x_[k] = feature.velocity().x();
+  velocity_y_[k] = feature.velocity().y();
+  acceleration_x_[k] = feature.acceleration().x();
+  acceleration_y_[k] = feature.acceleration().y();
+  speed_[k] = feature.speed();
+  acc_[k] = feature.acc();
+  velocity_heading_[k] = feature.velocity_heading();
+  theta_[k] = feature.theta();
+  length_[k] = feature.length();
+  width_[k] = feature.width();
+
+  if (feature.has_lane() && feature.lane().has_lane_feature()) {
+    flags |= kHasLaneFeature;
+    const LaneFeature& lane_feature = feature.lane().lane_feature();
+    lane_id_[k] = lane_feature.lane_id();
+    lane_turn_type_[k] = lane_feature.lane_turn_type();
+    lane_s_[k] = lane_feature.lane_s();
+    lane_l_[k] = lane_feature.lane_l();
+    angle_diff_[k] = lane_feature.angle_diff();
+    dist_to_left_boundary_[k] = lane_feature.dist_to_left_boundary();
+    dist_to_right_boundary_[k] = lane_feature.dist_to_right_boundary();
+    lane_heading_[k] = lane_feature.lane_heading();
+  } else {
+    lane_id_[k].clear();
+  }
+  flags_[k] = flags;
+}
+
+void FeatureHistory::PopBack() {
+  if (size_ > 0) {
+    --size_;
+  }
+}
+
+void FeatureHistory::Trim(const size_t remain_size) {
+  if (size_ > remain_size) {
+    size_ = remain_size;
+  }
+}
+
+void FeatureHistory::Clear() { size_ = 0; }
+
+void FeatureHistory::set_is_still(const bool is_still) {
+  ACHECK(size_ > 0);
+  if (is_still) {
+    flags_[head_] |= kIsStill;
+  } else {
+    flags_[head_] &= static_cast<uint8_t>(~kIsStill);
+  }
+}
+
+void FeatureHistory::ToFeature(const size_t i, Feature* feature) const {
+  ACHECK(i < size_);
+  const size_t k = Index(i);
+  const uint8_t flags = flags_[k];
+  feature->set_timestamp(timestamp_[k]);
+  if (flags & kHasPosition) {
+    feature->mutable_position()->set_x(position_x_[k]);
+    feature->mutable_position()->set_y(position_y_[k]);
+  }
+  if (flags & kHasVelocity) {
+    feature->mutable_velocity()->set_x(velocity_x_[k]);
+    feature->mutable_velocity()->set_y(velocity_y_[k]);
+  }
+  if (flags & kHasAcceleration) {
+    feature->mutable_acceleration()->set_x(acceleration_x_[k]);
+    feature->mutable_acceleration()->set_y(acceleration_y_[k]);
+  }
+  if (flags & kHasVelocityHeading) {
+    feature->set_velocity_heading(velocity_heading_[k]);
+  }
+  feature->set_speed(speed_[k]);
+  feature->set_acc(acc_[k]);
+  feature->set_theta(theta_[k]);
+  feature->set_length(length_[k]);
+  feature->set_width(width_[k]);
+  feature->set_is_still((flags & kIsStill) != 0);
+  if (flags & kHasLaneFeature) {
+    LaneFeature* lane_feature =
+        feature->mutable_lane()->mutable_lane_feature();
+    lane_feature->set_lane_id(lane_id_[k]);
+    lane_feature->set_lane_turn_type(lane_turn_type_[k]);
+    lane_feature->set_lane_s(lane_s_[k]);
+    lane_feature->set_lane_l(lane_l_[k]);
+    lane_feature->set_angle_diff(angle_diff_[k]);
+    lane_feature->set_dist_to_left_boundary(dist_to_left_boundary_[k]);
+    lane_feature->set_dist_to_right_boundary(dist_to_right_boundary_[k]);
+    lane_feature->set_lane_heading(lane_heading_[k]);
+  }
+}
+
+}  // namespace prediction
+}  // namespace apollo
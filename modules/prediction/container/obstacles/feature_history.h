@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Compact fixed-capacity history of the features of an obstacle
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class FeatureHistory
+ * @brief Ring buffer of the kinematic and lane fields of the features of an
+ *        obstacle, stored as structure of arrays. Frame 0 is the latest one,
+ *        like the feature history of Obstacle.
+ */
+class FeatureHistory {
+ public:
+  /**
+   * @brief Constructor
+   * @param The maximal number of frames, older frames are dropped when a
+   *        frame is pushed to a full history
+   */
+  explicit FeatureHistory(const size_t capacity);
+
+  /**
+   * @brief Push a feature as the latest frame
+   * @param Feature
+   */
+  void PushFront(const Feature& feature);
+
+  /**
+   * @brief Drop the earliest frame
+   */
+  void PopBack();
+
+  /**
+   * @brief Keep the latest frames only
+   * @param The number of frames to keep
+   */
+  void Trim(const size_t remain_size);
+
+  /**
+   * @brief Drop all frames
+   */
+  void Clear();
+
+  /**
+   * @brief Fill a feature with the stored fields of a frame
+   * @param Index of the frame
+   * @param Feature to be filled
+   */
+  void ToFeature(const size_t i, Feature* feature) const;
+
+  size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  size_t capacity() const { return capacity_; }
+
+  double timestamp(const size_t i) const { return timestamp_[Index(i)]; }
+
+  double position_x(const size_t i) const { return position_x_[Index(i)]; }
+
+  double position_y(const size_t i) const { return position_y_[Index(i)]; }
+
+  double speed(const size_t i) const { return speed_[Index(i)]; }
+
+  bool is_still(const size_t i) const {
+    return (flags_[Index(i)] & kIsStill) != 0;
+  }
+
+  /**
+   * @brief Set the motion status of the latest frame
+   * @param If the obstacle is still
+   */
+  void set_is_still(const bool is_still);
+
+ private:
+  enum Flag : uint8_t {
+    kHasPosition = 1 << 0,
+    kHasVelocity = 1 << 1,
+    kHasAcceleration = 1 << 2,
+    kHasVelocityHeading = 1 << 3,
+    kHasLaneFeature = 1 << 4,
+    kIsStill = 1 << 5,
+  };
+
+  size_t Index(const size_t i) const { return (head_ + i) % capacity_; }
+
+  size_t capacity_ = 0;
+  // slot of the latest frame
+  size_t head_ = 0;
+  size_t size_ = 0;
+
+  std::vector<uint8_t> flags_;
+  std::vector<double> timestamp_;
+  std::vector<double> position_x_;
+  std::vector<double> position_y_;
+  std::vector<double> velocity_x_;
+  std::vector<double> velocity_y_;
+  std::vector<double> acceleration_x_;
+  std::vector<double> acceleration_y_;
+  std::vector<double> speed_;
+  std::vector<double> acc_;
+  std::vector<double> velocity_heading_;
+  std::vector<double> theta_;
+  std::vector<double> length_;
+  std::vector<double> width_;
+
+  std::vector<std::string> lane_id_;
+  std::vector<uint32_t> lane_turn_type_;
+  std::vector<double> lane_s_;
+  std::vector<double> lane_l_;
+  std::vector<double> angle_diff_;
+  std::vector<double> dist_to_left_boundary_;
+  std::vector<double> dist_to_right_boundary_;
+  std::vector<double> lane_heading_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/container/obstacles/feature_history.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+Feature MakeFeature(const double timestamp) {
+  Feature feature;
+  feature.set_timestamp(timestamp);
+  feature.mutable_position()->set_x(timestamp * 2.0);
+  feature.mutable_position()->set_y(-timestamp);
+  feature.mutable_velocity()->set_x(1.0);
+  feature.mutable_velocity()->set_y(0.5);
+  feature.set_velocity_heading(0.3);
+  feature.set_speed(timestamp + 1.0);
+  LaneFeature* lane_feature = feature.mutable_lane()->mutable_lane_feature();
+  lane_feature->set_lane_id("l" + std::to_string(static_cast<int>(timestamp)));
+  lane_feature->set_lane_l(0.2);
+  lane_feature->set_angle_diff(0.1);
+  return feature;
+}
+
+}  // namespace
+
+TEST(FeatureHistoryTest, RingOrder) {
+  FeatureHistory history(3);
+  EXPECT_TRUE(history.empty());
+  for (int i = 0; i < 5; ++i) {
+    history.PushFront(MakeFeature(static_cast<double>(i)));
+  }
+  EXPECT_EQ(history.size(), 3);
+  EXPECT_DOUBLE_EQ(history.timestamp(0), 4.0);
+  EXPECT_DOUBLE_EQ(history.timestamp(1), 3.0);
+  EXPECT_DOUBLE_EQ(history.timestamp(2), 2.0);
+  EXPECT_DOUBLE_EQ(history.position_x(1), 6.0);
+  EXPECT_DOUBLE_EQ(history.position_y(2), -2.0);
+
+  history.PopBack();
+  EXPECT_EQ(history.size(), 2);
+  EXPECT_DOUBLE_EQ(history.timestamp(1), 3.0);
+  history.PushFront(MakeFeature(5.0));
+  EXPECT_DOUBLE_EQ(history.timestamp(0), 5.0);
+  EXPECT_DOUBLE_EQ(history.timestamp(2), 3.0);
+
+  history.Trim(1);
+  EXPECT_EQ(history.size(), 1);
+  history.Clear();
+  EXPECT_TRUE(history.empty());
+}
+
+TEST(FeatureHistoryTest, ToFeature) {
+  FeatureHistory history(4);
+  Feature without_lane;
+  without_lane.set_timestamp(0.5);
+  history.PushFront(MakeFeature(1.0));
+  history.PushFront(without_lane);
+  history.set_is_still(true);
+
+  Feature feature;
+  history.ToFeature(1, &feature);
+  EXPECT_DOUBLE_EQ(feature.timestamp(), 1.0);
+  EXPECT_DOUBLE_EQ(feature.position().x(), 2.0);
+  EXPECT_DOUBLE_EQ(feature.velocity().y(), 0.5);
+  EXPECT_DOUBLE_EQ(feature.speed(), 2.0);
+  EXPECT_FALSE(feature.has_acceleration());
+  EXPECT_FALSE(feature.is_still());
+  ASSERT_TRUE(feature.lane().has_lane_feature());
+  EXPECT_EQ(feature.lane().lane_feature().lane_id(), "l1");
+  EXPECT_DOUBLE_EQ(feature.lane().lane_feature().angle_diff(), 0.1);
+
+  Feature latest;
+  history.ToFeature(0, &latest);
+  EXPECT_TRUE(latest.is_still());
+  EXPECT_TRUE(history.is_still(0));
+  EXPECT_FALSE(latest.has_position());
+  EXPECT_FALSE(latest.has_lane());
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <iomanip>
 #include <limits>
+#include <tuple>
 
 #include "modules/common/util/util.h"
 #include "modules/prediction/common/junction_analyzer.h"
@@ -65,8 +66,18 @@ double Obstacle::timestamp() const {
 }
 
 const Feature& Obstacle::feature(const size_t i) const {
-  ACHECK(i < feature_history_.size());
-  return feature_history_[i];
+  if (i < feature_history_.size()) {
+    return feature_history_[i];
+  }
+  ACHECK(compact_history_ != nullptr && i < compact_history_->size());
+  auto it = materialized_features_.find(i);
+  if (it == materialized_features_.end()) {
+    it = materialized_features_.emplace(i, Feature()).first;
+    compact_history_->ToFeature(i, &it->second);
+    it->second.set_id(id_);
+    it->second.set_type(type_);
+  }
+  return it->second;
 }
 
 Feature* Obstacle::mutable_feature(const size_t i) {
@@ -82,7 +93,7 @@ const Feature& Obstacle::latest_feature() const {
 
 const Feature& Obstacle::earliest_feature() const {
   ACHECK(!feature_history_.empty());
-  return feature_history_.back();
+  return feature(history_size() - 1);
 }
 
 Feature* Obstacle::mutable_latest_feature() {
@@ -90,7 +101,12 @@ Feature* Obstacle::mutable_latest_feature() {
   return &(feature_history_.front());
 }
 
-size_t Obstacle::history_size() const { return feature_history_.size(); }
+size_t Obstacle::history_size() const {
+  if (compact_history_ != nullptr) {
+    return compact_history_->size();
+  }
+  return feature_history_.size();
+}
 
 bool Obstacle::IsStill() {
   if (feature_history_.size() > 0) {
@@ -217,6 +233,10 @@ void Obstacle::TrimHistory(const size_t remain_size) {
   if (feature_history_.size() > remain_size) {
     feature_history_.resize(remain_size);
   }
+  if (compact_history_ != nullptr) {
+    compact_history_->Trim(remain_size);
+    materialized_features_.clear();
+  }
 }
 
 bool Obstacle::IsInJunction(const std::string& junction_id) const {
@@ -1301,7 +1321,7 @@ void Obstacle::SetNearbyObstacles() {
 }
 
 void Obstacle::SetMotionStatus() {
-  int history_size = static_cast<int>(feature_history_.size());
+  int history_size = static_cast<int>(this->history_size());
   if (history_size == 0) {
     AERROR << "Zero history found";
     return;
@@ -1323,9 +1343,9 @@ void Obstacle::SetMotionStatus() {
     if (speed < speed_threshold) {
       ADEBUG << "Obstacle [" << id_ << "] has a small speed [" << speed
              << "] and is considered stationary in the first frame.";
-      feature_history_.front().set_is_still(true);
+      SetIsStill(true);
     } else {
-      feature_history_.front().set_is_still(false);
+      SetIsStill(false);
     }
     return;
   }
@@ -1338,48 +1358,44 @@ void Obstacle::SetMotionStatus() {
   len = std::max(len, FLAGS_min_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
-  start_x = feature_riter->position().x();
-  start_y = feature_riter->position().y();
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
-    avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-    avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
-    ++feature_riter;
+  std::tie(start_x, start_y) = HistoryPosition(history_size - 1);
+  for (int i = history_size - 2; i >= 0; --i) {
+    const auto position = HistoryPosition(i);
+    avg_drift_x += (position.first - start_x) / (len - 1);
+    avg_drift_y += (position.second - start_y) / (len - 1);
   }
 
-  double delta_ts = feature_history_.front().timestamp() -
-                    feature_history_.back().timestamp();
+  double delta_ts = HistoryTimestamp(0) - HistoryTimestamp(history_size - 1);
   double speed_sensibility = std::sqrt(2 * history_size) * 4 * pos_std /
                              ((history_size + 1) * delta_ts);
   if (speed < speed_threshold) {
     ADEBUG << "Obstacle [" << id_ << "] has a small speed [" << speed
            << "] and is considered stationary.";
-    feature_history_.front().set_is_still(true);
+    SetIsStill(true);
   } else if (speed_sensibility < speed_threshold) {
     ADEBUG << "Obstacle [" << id_ << "]"
            << "] considered moving [sensibility = " << speed_sensibility << "]";
-    feature_history_.front().set_is_still(false);
+    SetIsStill(false);
   } else {
     double distance = std::hypot(avg_drift_x, avg_drift_y);
     double distance_std = std::sqrt(2.0 / len) * pos_std;
     if (distance > 2.0 * distance_std) {
       ADEBUG << "Obstacle [" << id_ << "] is moving.";
-      feature_history_.front().set_is_still(false);
+      SetIsStill(false);
     } else {
       ADEBUG << "Obstacle [" << id_ << "] is stationary.";
-      feature_history_.front().set_is_still(true);
+      SetIsStill(true);
     }
   }
 }
 
 void Obstacle::SetMotionStatusBySpeed() {
-  auto history_size = feature_history_.size();
+  auto history_size = this->history_size();
   if (history_size < 2) {
     ADEBUG << "Obstacle [" << id_ << "] has no history and "
            << "is considered moving.";
     if (history_size > 0) {
-      feature_history_.front().set_is_still(false);
+      SetIsStill(false);
     }
     return;
   }
@@ -1389,18 +1405,53 @@ void Obstacle::SetMotionStatusBySpeed() {
 
   if (FLAGS_use_navigation_mode) {
     if (speed < speed_threshold) {
-      feature_history_.front().set_is_still(true);
+      SetIsStill(true);
     } else {
-      feature_history_.front().set_is_still(false);
+      SetIsStill(false);
     }
   }
 }
 
 void Obstacle::InsertFeatureToHistory(const Feature& feature) {
   feature_history_.emplace_front(feature);
+  if (FLAGS_enable_compact_feature_history) {
+    if (compact_history_ == nullptr) {
+      compact_history_.reset(new FeatureHistory(
+          static_cast<size_t>(FLAGS_compact_feature_history_capacity)));
+    }
+    compact_history_->PushFront(feature);
+    materialized_features_.clear();
+    const size_t max_num_full_features =
+        static_cast<size_t>(std::max(FLAGS_max_num_full_feature_history, 2));
+    while (feature_history_.size() > max_num_full_features) {
+      feature_history_.pop_back();
+    }
+  }
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
+void Obstacle::SetIsStill(const bool is_still) {
+  feature_history_.front().set_is_still(is_still);
+  if (compact_history_ != nullptr) {
+    compact_history_->set_is_still(is_still);
+  }
+}
+
+double Obstacle::HistoryTimestamp(const size_t i) const {
+  if (compact_history_ != nullptr) {
+    return compact_history_->timestamp(i);
+  }
+  return feature_history_[i].timestamp();
+}
+
+std::pair<double, double> Obstacle::HistoryPosition(const size_t i) const {
+  if (compact_history_ != nullptr) {
+    return {compact_history_->position_x(i), compact_history_->position_y(i)};
+  }
+  return {feature_history_[i].position().x(),
+          feature_history_[i].position().y()};
+}
+
 std::unique_ptr<Obstacle> Obstacle::Create(
     const PerceptionObstacle& perception_obstacle, const double timestamp,
     const int prediction_id, ObstacleClusters* clusters_ptr) {
@@ -1420,6 +1471,12 @@ std::unique_ptr<Obstacle> Obstacle::Create(const Feature& feature,
   return ptr_obstacle;
 }
 
+std::unique_ptr<Obstacle> Obstacle::Create(ObstacleClusters* clusters_ptr) {
+  std::unique_ptr<Obstacle> ptr_obstacle(new Obstacle());
+  ptr_obstacle->SetClusters(clusters_ptr);
+  return ptr_obstacle;
+}
+
 bool Obstacle::ReceivedOlderMessage(const double timestamp) const {
   if (feature_history_.empty()) {
     return false;
@@ -1429,13 +1486,25 @@ bool Obstacle::ReceivedOlderMessage(const double timestamp) const {
 }
 
 void Obstacle::DiscardOutdatedHistory() {
-  auto num_of_frames = feature_history_.size();
+  auto num_of_frames = history_size();
   const double latest_ts = feature_history_.front().timestamp();
-  while (latest_ts - feature_history_.back().timestamp() >=
-         FLAGS_max_history_time) {
-    feature_history_.pop_back();
+  if (compact_history_ != nullptr) {
+    while (latest_ts - compact_history_->timestamp(
+                           compact_history_->size() - 1) >=
+           FLAGS_max_history_time) {
+      compact_history_->PopBack();
+    }
+    while (feature_history_.size() > compact_history_->size()) {
+      feature_history_.pop_back();
+    }
+    materialized_features_.clear();
+  } else {
+    while (latest_ts - feature_history_.back().timestamp() >=
+           FLAGS_max_history_time) {
+      feature_history_.pop_back();
+    }
   }
-  auto num_of_discarded_frames = num_of_frames - feature_history_.size();
+  auto num_of_discarded_frames = num_of_frames - history_size();
   if (num_of_discarded_frames > 0) {
     ADEBUG << "Obstacle [" << id_ << "] discards " << num_of_discarded_frames
            << " historical features";
@@ -25,7 +25,9 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "modules/common/filters/digital_filter.h"
@@ -33,6 +35,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/prediction/common/junction_analyzer.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/container/obstacles/feature_history.h"
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 #include "modules/prediction/proto/feature.pb.h"
 #include "modules/prediction/proto/prediction_conf.pb.h"
@@ -62,6 +65,12 @@ class Obstacle {
   static std::unique_ptr<Obstacle> Create(const Feature& feature,
                                           ObstacleClusters* clusters_ptr);
 
+  /**
+   * @brief Create an obstacle without any frame, to insert perception
+   *        obstacles into later
+   */
+  static std::unique_ptr<Obstacle> Create(ObstacleClusters* clusters_ptr);
+
   Obstacle() = default;
 
   /**
@@ -114,14 +123,17 @@ class Obstacle {
   bool ReceivedOlderMessage(const double timestamp) const;
 
   /**
-   * @brief Get the ith feature from latest to earliest.
+   * @brief Get the ith feature from latest to earliest. With the compact
+   *        feature history, older features only have the fields kept in it
+   *        and are built on the first access after each insertion.
    * @param i The index of the feature.
    * @return The ith feature.
    */
   const Feature& feature(const size_t i) const;
 
   /**
-   * @brief Get a pointer to the ith feature from latest to earliest.
+   * @brief Get a pointer to the ith feature from latest to earliest,
+   *        which must be kept as a full feature.
    * @param i The index of the feature.
    * @return A pointer to the ith feature.
    */
@@ -306,6 +318,12 @@ class Obstacle {
 
   void InsertFeatureToHistory(const Feature& feature);
 
+  void SetIsStill(const bool is_still);
+
+  double HistoryTimestamp(const size_t i) const;
+
+  std::pair<double, double> HistoryPosition(const size_t i) const;
+
   void SetJunctionFeatureWithEnterLane(const std::string& enter_lane_id,
                                        Feature* const feature_ptr);
 
@@ -333,6 +351,11 @@ class Obstacle {
 
   std::deque<Feature> feature_history_;
 
+  // all the frames when the compact feature history is enabled, with only
+  // the latest ones also in feature_history_
+  std::unique_ptr<FeatureHistory> compact_history_;
+  mutable std::unordered_map<size_t, Feature> materialized_features_;
+
   std::vector<std::shared_ptr<const hdmap::LaneInfo>> current_lanes_;
 
   ObstacleConf obstacle_conf_;
@@ -53,6 +53,7 @@ void ObstacleClusters::AddObstacle(const int obstacle_id,
   lane_obstacle.set_lane_id(lane_id);
   lane_obstacle.set_lane_s(lane_s);
   lane_obstacle.set_lane_l(lane_l);
+  std::lock_guard<std::mutex> lock(lane_obstacles_mutex_);
   lane_obstacles_[lane_id].push_back(std::move(lane_obstacle));
 }
 
@@ -61,7 +62,12 @@ void ObstacleClusters::SortObstacles() {
        ++iter) {
     std::sort(iter->second.begin(), iter->second.end(),
               [](const LaneObstacle& obs0, const LaneObstacle& obs1) -> bool {
-                return obs0.lane_s() < obs1.lane_s();
+                // obstacles may be added in any order when inserted in
+                // parallel
+                if (obs0.lane_s() != obs1.lane_s()) {
+                  return obs0.lane_s() < obs1.lane_s();
+                }
+                return obs0.obstacle_id() < obs1.obstacle_id();
               });
   }
 }
@@ -129,6 +129,7 @@ class ObstacleClusters {
 
  private:
   std::unordered_map<std::string, std::vector<LaneObstacle>> lane_obstacles_;
+  std::mutex lane_obstacles_mutex_;
   std::unordered_map<std::string, StopSign> lane_id_stop_sign_map_;
 };
 
@@ -182,5 +182,32 @@ TEST_F(ObstacleTest, Priority) {
   EXPECT_FALSE(obstacle_ptr->ToIgnore());
 }
 
+TEST_F(ObstacleTest, CompactHistory) {
+  FLAGS_enable_compact_feature_history = true;
+  FLAGS_max_num_full_feature_history = 2;
+  ObstaclesContainer container;
+  for (int i = 1; i <= 3; ++i) {
+    const auto filename = absl::StrCat(
+        "modules/prediction/testdata/frame_sequence/frame_", i, ".pb.txt");
+    perception::PerceptionObstacles perception_obstacles;
+    cyber::common::GetProtoFromFile(filename, &perception_obstacles);
+    container.Insert(perception_obstacles);
+  }
+  FLAGS_enable_compact_feature_history = false;
+  FLAGS_max_num_full_feature_history = 3;
+
+  Obstacle* obstacle_ptr = container.GetObstacle(1);
+  ASSERT_NE(obstacle_ptr, nullptr);
+  EXPECT_EQ(obstacle_ptr->history_size(), 3);
+  const Feature& start_feature = obstacle_ptr->feature(2);
+  EXPECT_EQ(start_feature.id(), 1);
+  EXPECT_DOUBLE_EQ(start_feature.timestamp(), 0.0);
+  EXPECT_DOUBLE_EQ(start_feature.position().x(), -458.941);
+  EXPECT_DOUBLE_EQ(start_feature.position().y(), -159.240);
+  EXPECT_DOUBLE_EQ(obstacle_ptr->earliest_feature().timestamp(), 0.0);
+  EXPECT_EQ(obstacle_ptr->IsStill(),
+            container_.GetObstacle(1)->IsStill());
+}
+
 }  // namespace prediction
 }  // namespace apollo
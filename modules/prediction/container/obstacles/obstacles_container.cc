@@ -17,13 +17,16 @@
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 
 #include <iomanip>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/junction_analyzer.h"
 #include "modules/prediction/common/prediction_constants.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 #include "modules/prediction/container/obstacles/obstacle_clusters.h"
 
 namespace apollo {
@@ -145,13 +148,17 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
 
   // Set up the ObstacleClusters:
   // Insert the Obstacles one by one
-  for (const PerceptionObstacle& perception_obstacle :
-       perception_obstacles.perception_obstacle()) {
-    ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
-           << "was detected";
-    InsertPerceptionObstacle(perception_obstacle, timestamp_);
-    ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
-           << "was inserted";
+  if (FLAGS_enable_parallel_obstacle_insertion) {
+    InsertPerceptionObstaclesInParallel(perception_obstacles, timestamp_);
+  } else {
+    for (const PerceptionObstacle& perception_obstacle :
+         perception_obstacles.perception_obstacle()) {
+      ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
+             << "was detected";
+      InsertPerceptionObstacle(perception_obstacle, timestamp_);
+      ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
+             << "was inserted";
+    }
   }
 
   SetConsideredObstacleIds();
@@ -258,6 +265,88 @@ void ObstaclesContainer::InsertPerceptionObstacle(
   }
 }
 
+void ObstaclesContainer::InsertPerceptionObstaclesInParallel(
+    const PerceptionObstacles& perception_obstacles, const double timestamp) {
+  // Perception obstacles of the same id are inserted in order by one task,
+  // tasks of different obstacles only share the clusters.
+  struct InsertionTask {
+    int id = 0;
+    Obstacle* obstacle_ptr = nullptr;
+    std::unique_ptr<Obstacle> new_obstacle;
+    std::vector<const PerceptionObstacle*> perception_obstacles;
+    bool inserted = true;
+  };
+  std::vector<InsertionTask> tasks;
+  std::unordered_map<int, size_t> id_task_idx;
+  // task of every movable perception obstacle in the frame order
+  std::vector<size_t> movable_task_indices;
+
+  // The LRUCache is only touched here and below, by this thread.
+  for (const PerceptionObstacle& perception_obstacle :
+       perception_obstacles.perception_obstacle()) {
+    int id = perception_obstacle.id();
+    if (id < FLAGS_ego_vehicle_id) {
+      AERROR << "Invalid ID [" << id << "]";
+      continue;
+    }
+    if (!IsMovable(perception_obstacle)) {
+      ADEBUG << "Perception obstacle [" << id << "] is unmovable.";
+      curr_frame_unmovable_obstacle_ids_.push_back(id);
+      continue;
+    }
+    auto it = id_task_idx.find(id);
+    if (it == id_task_idx.end()) {
+      InsertionTask task;
+      task.id = id;
+      task.obstacle_ptr = GetObstacleWithLRUUpdate(id);
+      if (task.obstacle_ptr == nullptr) {
+        task.new_obstacle = Obstacle::Create(clusters_.get());
+        task.obstacle_ptr = task.new_obstacle.get();
+      }
+      it = id_task_idx.emplace(id, tasks.size()).first;
+      tasks.push_back(std::move(task));
+    }
+    tasks[it->second].perception_obstacles.push_back(&perception_obstacle);
+    movable_task_indices.push_back(it->second);
+  }
+
+  PredictionThreadPool::ForEach(
+      tasks.begin(), tasks.end(), [&](InsertionTask& task) {
+        for (const PerceptionObstacle* perception_obstacle :
+             task.perception_obstacles) {
+          task.obstacle_ptr->Insert(*perception_obstacle, timestamp,
+                                    task.id);
+        }
+        // a new obstacle exists only if one of its frames is inserted
+        if (task.new_obstacle != nullptr) {
+          task.inserted = task.obstacle_ptr->history_size() > 0;
+        }
+      });
+
+  for (InsertionTask& task : tasks) {
+    if (task.new_obstacle == nullptr) {
+      ADEBUG << "Refresh obstacle [" << task.id << "]";
+      continue;
+    }
+    if (!task.inserted) {
+      AERROR << "Failed to insert obstacle into container";
+      continue;
+    }
+    task.new_obstacle->SetJunctionAnalyzer(&junction_analyzer_);
+    ptr_obstacles_.Put(task.id, std::move(task.new_obstacle));
+    ADEBUG << "Insert obstacle [" << task.id << "]";
+  }
+  for (size_t task_idx : movable_task_indices) {
+    const InsertionTask& task = tasks[task_idx];
+    if (task.inserted &&
+        (FLAGS_prediction_offline_mode ==
+             PredictionConstants::kDumpDataForLearning ||
+         task.id != FLAGS_ego_vehicle_id)) {
+      curr_frame_movable_obstacle_ids_.push_back(task.id);
+    }
+  }
+}
+
 void ObstaclesContainer::InsertFeatureProto(const Feature& feature) {
   if (!feature.has_id()) {
     AERROR << "Invalid feature, no ID found.";
@@ -68,6 +68,16 @@ class ObstaclesContainer : public Container {
       const perception::PerceptionObstacle& perception_obstacle,
       const double timestamp);
 
+  /**
+   * @brief Insert the perception obstacles of a frame, building the features
+   *        of different obstacles in parallel
+   * @param Perception obstacles
+   *        Timestamp
+   */
+  void InsertPerceptionObstaclesInParallel(
+      const perception::PerceptionObstacles& perception_obstacles,
+      const double timestamp);
+
   /**
    * @brief Insert a feature proto message into the container
    * @param feature proto message
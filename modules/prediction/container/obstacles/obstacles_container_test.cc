@@ -18,6 +18,7 @@
 
 #include "cyber/common/file.h"
 #include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
 
 namespace apollo {
 namespace prediction {
@@ -84,5 +85,28 @@ TEST_F(ObstaclesContainerTest, ClearAll) {
   EXPECT_EQ(nullptr, container_.GetObstacle(102));
 }
 
+TEST_F(ObstaclesContainerTest, ParallelInsertion) {
+  const std::string file =
+      "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt";
+  perception::PerceptionObstacles perception_obstacles;
+  cyber::common::GetProtoFromFile(file, &perception_obstacles);
+  FLAGS_enable_parallel_obstacle_insertion = true;
+  ObstaclesContainer parallel_container;
+  parallel_container.Insert(perception_obstacles);
+  FLAGS_enable_parallel_obstacle_insertion = false;
+
+  EXPECT_EQ(parallel_container.curr_frame_movable_obstacle_ids(),
+            container_.curr_frame_movable_obstacle_ids());
+  for (const int id : container_.curr_frame_movable_obstacle_ids()) {
+    Obstacle* obstacle_ptr = parallel_container.GetObstacle(id);
+    ASSERT_NE(nullptr, obstacle_ptr);
+    EXPECT_EQ(obstacle_ptr->type(), container_.GetObstacle(id)->type());
+    EXPECT_EQ(obstacle_ptr->history_size(),
+              container_.GetObstacle(id)->history_size());
+  }
+  EXPECT_EQ(nullptr, parallel_container.GetObstacle(4));
+  EXPECT_EQ(nullptr, parallel_container.GetObstacle(103));
+}
+
 }  // namespace prediction
 }  // namespace apollo
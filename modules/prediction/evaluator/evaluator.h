@@ -71,6 +71,21 @@ class Evaluator {
     return Evaluate(obstacle, obstacles_container);
   }
 
+  /**
+   * @brief Evaluate a batch of obstacles
+   * @param Obstacle pointers
+   * @param Obstacles container
+   * @param Whether each obstacle is evaluated successfully
+   */
+  virtual void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                             ObstaclesContainer* obstacles_container,
+                             std::vector<bool>* results) {
+    results->clear();
+    for (Obstacle* obstacle : obstacles) {
+      results->push_back(Evaluate(obstacle, obstacles_container));
+    }
+  }
+
   /**
    * @brief Get the name of evaluator
    */
@@ -17,11 +17,14 @@
 #include "modules/prediction/evaluator/evaluator_manager.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/prediction/common/feature_output.h"
+#include "modules/prediction/common/frame_deadline.h"
 #include "modules/prediction/common/prediction_constants.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_profiler.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/common/prediction_thread_pool.h"
 #include "modules/prediction/container/container_manager.h"
@@ -205,6 +208,16 @@ void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
     semantic_map_->RunCurrFrame(obstacle_id_history_map_);
   }
 
+  if (FLAGS_enable_anytime_prediction) {
+    EvaluateObstaclesAnytime(obstacles_container);
+    return;
+  }
+
+  if (FLAGS_enable_batched_evaluation) {
+    EvaluateObstaclesInBatch(obstacles_container);
+    return;
+  }
+
   std::vector<Obstacle*> dynamic_env;
 
   if (FLAGS_enable_multi_thread) {
@@ -237,28 +250,51 @@ void EvaluatorManager::Run(ObstaclesContainer* obstacles_container) {
 void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
                                         ObstaclesContainer* obstacles_container,
                                         std::vector<Obstacle*> dynamic_env) {
+  Evaluator* evaluator = GetCautionEvaluator(obstacle);
+  // Evaluate and return if success
+  if (evaluator != nullptr) {
+    PredictionProfiler::ScopedTimer timer("evaluator", evaluator->GetName());
+    if (evaluator->Evaluate(obstacle, obstacles_container)) {
+      return;
+    }
+    AERROR << "Obstacle: " << obstacle->id()
+           << " caution evaluator failed, downgrade to normal level!";
+  }
+  // if obstacle is not caution or caution_evaluator run failed
+  evaluator = GetNormalEvaluator(obstacle);
+  if (evaluator == nullptr) {
+    return;
+  }
+  PredictionProfiler::ScopedTimer timer("evaluator", evaluator->GetName());
+  if (evaluator->GetName() == "LANE_SCANNING_EVALUATOR") {
+    evaluator->Evaluate(obstacle, obstacles_container, dynamic_env);
+  } else {
+    evaluator->Evaluate(obstacle, obstacles_container);
+  }
+}
+
+Evaluator* EvaluatorManager::GetCautionEvaluator(Obstacle* obstacle) {
+  if (obstacle->type() != PerceptionObstacle::VEHICLE ||
+      !obstacle->IsCaution() || obstacle->IsSlow()) {
+    return nullptr;
+  }
+  Evaluator* evaluator = nullptr;
+  if (obstacle->IsNearJunction()) {
+    evaluator = GetEvaluator(vehicle_in_junction_caution_evaluator_);
+  } else if (obstacle->IsOnLane()) {
+    evaluator = GetEvaluator(vehicle_on_lane_caution_evaluator_);
+  } else {
+    evaluator = GetEvaluator(vehicle_default_caution_evaluator_);
+  }
+  CHECK_NOTNULL(evaluator);
+  return evaluator;
+}
+
+Evaluator* EvaluatorManager::GetNormalEvaluator(Obstacle* obstacle) {
   Evaluator* evaluator = nullptr;
   // Select different evaluators depending on the obstacle's type.
   switch (obstacle->type()) {
     case PerceptionObstacle::VEHICLE: {
-      if (obstacle->IsCaution() && !obstacle->IsSlow()) {
-        if (obstacle->IsNearJunction()) {
-          evaluator = GetEvaluator(vehicle_in_junction_caution_evaluator_);
-        } else if (obstacle->IsOnLane()) {
-          evaluator = GetEvaluator(vehicle_on_lane_caution_evaluator_);
-        } else {
-          evaluator = GetEvaluator(vehicle_default_caution_evaluator_);
-        }
-        CHECK_NOTNULL(evaluator);
-        // Evaluate and break if success
-        if (evaluator->Evaluate(obstacle, obstacles_container)) {
-          break;
-        } else {
-          AERROR << "Obstacle: " << obstacle->id()
-                 << " caution evaluator failed, downgrade to normal level!";
-        }
-      }
-      // if obstacle is not caution or caution_evaluator run failed
       if (obstacle->HasJunctionFeatureWithExits() &&
           !obstacle->IsCloseToJunctionExit()) {
         evaluator = GetEvaluator(vehicle_in_junction_evaluator_);
@@ -267,22 +303,15 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
       } else {
         ADEBUG << "Obstacle: " << obstacle->id()
                << " is neither on lane, nor in junction. Skip evaluating.";
-        break;
-      }
-      CHECK_NOTNULL(evaluator);
-      if (evaluator->GetName() == "LANE_SCANNING_EVALUATOR") {
-        evaluator->Evaluate(obstacle, obstacles_container, dynamic_env);
-      } else {
-        evaluator->Evaluate(obstacle, obstacles_container);
+        return nullptr;
       }
       break;
     }
     case PerceptionObstacle::BICYCLE: {
-      if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
-        CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
+      if (!obstacle->IsOnLane()) {
+        return nullptr;
       }
+      evaluator = GetEvaluator(cyclist_on_lane_evaluator_);
       break;
     }
     case PerceptionObstacle::PEDESTRIAN: {
@@ -291,20 +320,158 @@ void EvaluatorManager::EvaluateObstacle(Obstacle* obstacle,
           obstacle->latest_feature().priority().priority() ==
               ObstaclePriority::CAUTION) {
         evaluator = GetEvaluator(pedestrian_evaluator_);
-        CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
         break;
       }
     }
     default: {
-      if (obstacle->IsOnLane()) {
-        evaluator = GetEvaluator(default_on_lane_evaluator_);
-        CHECK_NOTNULL(evaluator);
-        evaluator->Evaluate(obstacle, obstacles_container);
+      if (!obstacle->IsOnLane()) {
+        return nullptr;
       }
+      evaluator = GetEvaluator(default_on_lane_evaluator_);
       break;
     }
   }
+  CHECK_NOTNULL(evaluator);
+  return evaluator;
+}
+
+void EvaluatorManager::EvaluateObstaclesAnytime(
+    ObstaclesContainer* obstacles_container) {
+  std::vector<Obstacle*> caution_obstacles;
+  std::vector<Obstacle*> normal_obstacles;
+  for (int id : obstacles_container->curr_frame_considered_obstacle_ids()) {
+    Obstacle* obstacle = obstacles_container->GetObstacle(id);
+    if (obstacle == nullptr || obstacle->IsStill()) {
+      continue;
+    }
+    if (obstacle->IsCaution()) {
+      caution_obstacles.push_back(obstacle);
+    } else {
+      normal_obstacles.push_back(obstacle);
+    }
+  }
+
+  std::vector<Obstacle*> dynamic_env;
+  auto evaluate_caution = [&](Obstacle* obstacle) {
+    EvaluateObstacle(obstacle, obstacles_container, dynamic_env);
+  };
+  // the obstacles left after the deadline are predicted by free move
+  auto evaluate_normal = [&](Obstacle* obstacle) {
+    FrameDeadline* deadline = FrameDeadline::Instance();
+    if (deadline->Expired()) {
+      deadline->Downgrade(obstacle->id());
+      return;
+    }
+    EvaluateObstacle(obstacle, obstacles_container, dynamic_env);
+  };
+
+  if (FLAGS_enable_multi_thread) {
+    PredictionThreadPool::ForEach(caution_obstacles.begin(),
+                                  caution_obstacles.end(), evaluate_caution);
+    PredictionThreadPool::ForEach(normal_obstacles.begin(),
+                                  normal_obstacles.end(), evaluate_normal);
+  } else {
+    for (Obstacle* obstacle : caution_obstacles) {
+      evaluate_caution(obstacle);
+    }
+    for (Obstacle* obstacle : normal_obstacles) {
+      evaluate_normal(obstacle);
+    }
+  }
+}
+
+void EvaluatorManager::EvaluateObstaclesInBatch(
+    ObstaclesContainer* obstacles_container) {
+  std::map<Evaluator*, std::vector<Obstacle*>> caution_batches;
+  std::map<Evaluator*, std::vector<Obstacle*>> normal_batches;
+  for (int id : obstacles_container->curr_frame_considered_obstacle_ids()) {
+    Obstacle* obstacle = obstacles_container->GetObstacle(id);
+    if (obstacle == nullptr) {
+      continue;
+    }
+    if (obstacle->IsStill()) {
+      ADEBUG << "Ignore still obstacle [" << id << "] in evaluator_manager";
+      continue;
+    }
+    Evaluator* evaluator = GetCautionEvaluator(obstacle);
+    if (evaluator != nullptr) {
+      caution_batches[evaluator].push_back(obstacle);
+      continue;
+    }
+    evaluator = GetNormalEvaluator(obstacle);
+    if (evaluator != nullptr) {
+      normal_batches[evaluator].push_back(obstacle);
+    }
+  }
+
+  std::vector<Obstacle*> failed_obstacles;
+  EvaluateBatches(caution_batches, obstacles_container, &failed_obstacles);
+  // the failed caution obstacles join the batches of their normal level
+  for (Obstacle* obstacle : failed_obstacles) {
+    AERROR << "Obstacle: " << obstacle->id()
+           << " caution evaluator failed, downgrade to normal level!";
+    Evaluator* evaluator = GetNormalEvaluator(obstacle);
+    if (evaluator != nullptr) {
+      normal_batches[evaluator].push_back(obstacle);
+    }
+  }
+  EvaluateBatches(normal_batches, obstacles_container, nullptr);
+}
+
+void EvaluatorManager::EvaluateBatches(
+    const std::map<Evaluator*, std::vector<Obstacle*>>& batches,
+    ObstaclesContainer* obstacles_container,
+    std::vector<Obstacle*>* failed_obstacles) {
+  // split the large groups so that one inference is bounded in size
+  const size_t max_batch_size = static_cast<size_t>(
+      std::max(FLAGS_max_evaluation_batch_size, 1));
+  std::vector<std::pair<Evaluator*, std::vector<Obstacle*>>> tasks;
+  for (const auto& batch : batches) {
+    for (size_t i = 0; i < batch.second.size(); i += max_batch_size) {
+      size_t end = std::min(i + max_batch_size, batch.second.size());
+      tasks.emplace_back(batch.first,
+                         std::vector<Obstacle*>(batch.second.begin() + i,
+                                                batch.second.begin() + end));
+    }
+  }
+
+  std::vector<std::vector<bool>> results(tasks.size());
+  auto evaluate = [&](size_t i) {
+    PredictionProfiler::ScopedTimer timer(
+        "evaluator", tasks[i].first->GetName(), tasks[i].second.size());
+    tasks[i].first->EvaluateBatch(tasks[i].second, obstacles_container,
+                                  &results[i]);
+  };
+  // an evaluator holds one model, so only batches of different evaluators
+  // run in parallel
+  std::map<Evaluator*, std::vector<size_t>> evaluator_tasks;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    evaluator_tasks[tasks[i].first].push_back(i);
+  }
+  if (FLAGS_enable_multi_thread) {
+    PredictionThreadPool::ForEach(
+        evaluator_tasks.begin(), evaluator_tasks.end(),
+        [&](std::map<Evaluator*, std::vector<size_t>>::value_type& item) {
+          for (size_t i : item.second) {
+            evaluate(i);
+          }
+        });
+  } else {
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      evaluate(i);
+    }
+  }
+
+  if (failed_obstacles == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    for (size_t j = 0; j < tasks[i].second.size(); ++j) {
+      if (j >= results[i].size() || !results[i][j]) {
+        failed_obstacles->push_back(tasks[i].second[j]);
+      }
+    }
+  }
 }
 
 void EvaluatorManager::EvaluateObstacle(
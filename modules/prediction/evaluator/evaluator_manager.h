@@ -81,6 +81,46 @@ class EvaluatorManager {
 
   void DumpCurrentFrameEnv(ObstaclesContainer* obstacles_container);
 
+  /**
+   * @brief Get the caution evaluator of an obstacle, whose failure downgrades
+   *        the obstacle to the normal level
+   * @param Obstacle pointer
+   * @return Pointer to the evaluator, nullptr if the obstacle has none
+   */
+  Evaluator* GetCautionEvaluator(Obstacle* obstacle);
+
+  /**
+   * @brief Get the normal level evaluator of an obstacle
+   * @param Obstacle pointer
+   * @return Pointer to the evaluator, nullptr if the obstacle is skipped
+   */
+  Evaluator* GetNormalEvaluator(Obstacle* obstacle);
+
+  /**
+   * @brief Evaluate the obstacles grouped by evaluator, each group with
+   *        batched inferences
+   * @param Obstacles container
+   */
+  void EvaluateObstaclesInBatch(ObstaclesContainer* obstacles_container);
+
+  /**
+   * @brief Evaluate the caution obstacles first, then the others as long as
+   *        the frame deadline has not expired
+   * @param Obstacles container
+   */
+  void EvaluateObstaclesAnytime(ObstaclesContainer* obstacles_container);
+
+  /**
+   * @brief Run the batches of every evaluator
+   * @param Obstacles grouped by evaluator
+   * @param Obstacles container
+   * @param Failed obstacles
+   */
+  void EvaluateBatches(
+      const std::map<Evaluator*, std::vector<Obstacle*>>& batches,
+      ObstaclesContainer* obstacles_container,
+      std::vector<Obstacle*>* failed_obstacles);
+
   /**
    * @brief Register an evaluator by type
    * @param Evaluator type
@@ -18,6 +18,7 @@
 
 #include "cyber/common/file.h"
 #include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 
@@ -69,5 +70,35 @@ TEST_F(EvaluatorManagerTest, General) {
   }
 }
 
+TEST_F(EvaluatorManagerTest, Batched) {
+  std::string conf_file = "modules/prediction/testdata/adapter_conf.pb.txt";
+  bool ret_load_conf =
+      cyber::common::GetProtoFromFile(conf_file, &adapter_conf_);
+  EXPECT_TRUE(ret_load_conf);
+
+  ContainerManager container_manager;
+  container_manager.Init(adapter_conf_);
+  auto obstacles_container =
+      container_manager.GetContainer<ObstaclesContainer>(
+          AdapterConfig::PERCEPTION_OBSTACLES);
+  CHECK_NOTNULL(obstacles_container);
+  obstacles_container->Insert(perception_obstacles_);
+
+  EvaluatorManager evaluator_manager;
+
+  evaluator_manager.Init(prediction_conf_);
+  FLAGS_enable_batched_evaluation = true;
+  evaluator_manager.Run(obstacles_container);
+  FLAGS_enable_batched_evaluation = false;
+
+  Obstacle* obstacle_ptr = obstacles_container->GetObstacle(1);
+  EXPECT_NE(obstacle_ptr, nullptr);
+  const Feature& feature = obstacle_ptr->latest_feature();
+  const LaneGraph& lane_graph = feature.lane().lane_graph();
+  for (const auto& lane_sequence : lane_graph.lane_sequence()) {
+    EXPECT_TRUE(lane_sequence.has_probability());
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -60,24 +60,11 @@ bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
   obstacle_ptr->SetEvaluatorType(evaluator_type_);
 
   int id = obstacle_ptr->id();
-  if (!obstacle_ptr->latest_feature().IsInitialized()) {
-    AERROR << "Obstacle [" << id << "] has no latest feature.";
+  LaneGraph* lane_graph_ptr = GetLaneGraph(obstacle_ptr);
+  if (lane_graph_ptr == nullptr) {
     return false;
   }
   Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
-  CHECK_NOTNULL(latest_feature_ptr);
-  if (!latest_feature_ptr->has_lane() ||
-      !latest_feature_ptr->lane().has_lane_graph()) {
-    ADEBUG << "Obstacle [" << id << "] has no lane graph.";
-    return false;
-  }
-  LaneGraph* lane_graph_ptr =
-      latest_feature_ptr->mutable_lane()->mutable_lane_graph();
-  CHECK_NOTNULL(lane_graph_ptr);
-  if (lane_graph_ptr->lane_sequence().empty()) {
-    AERROR << "Obstacle [" << id << "] has no lane sequences.";
-    return false;
-  }
 
   ADEBUG << "There are " << lane_graph_ptr->lane_sequence_size()
          << " lane sequences with probabilities:";
@@ -137,6 +124,84 @@ bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
   return true;
 }
 
+void CruiseMLPEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles,
+    ObstaclesContainer* obstacles_container, std::vector<bool>* results) {
+  // Dumping data for learning works on single obstacles
+  if (FLAGS_prediction_offline_mode ==
+      PredictionConstants::kDumpDataForLearning) {
+    Evaluator::EvaluateBatch(obstacles, obstacles_container, results);
+    return;
+  }
+  omp_set_num_threads(1);
+  Clear();
+  results->assign(obstacles.size(), false);
+
+  // Rows of the go model and the cutin model, one per lane sequence
+  const int input_dim = static_cast<int>(
+      OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
+  std::vector<float> go_inputs;
+  std::vector<float> cutin_inputs;
+  std::vector<LaneSequence*> go_lane_sequences;
+  std::vector<LaneSequence*> cutin_lane_sequences;
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    Obstacle* obstacle_ptr = obstacles[i];
+    CHECK_NOTNULL(obstacle_ptr);
+    obstacle_ptr->SetEvaluatorType(evaluator_type_);
+    LaneGraph* lane_graph_ptr = GetLaneGraph(obstacle_ptr);
+    if (lane_graph_ptr == nullptr) {
+      continue;
+    }
+    for (int j = 0; j < lane_graph_ptr->lane_sequence_size(); ++j) {
+      LaneSequence* lane_sequence_ptr =
+          lane_graph_ptr->mutable_lane_sequence(j);
+      CHECK_NOTNULL(lane_sequence_ptr);
+      std::vector<double> feature_values;
+      ExtractFeatureValues(obstacle_ptr, lane_sequence_ptr, &feature_values);
+      if (feature_values.size() != static_cast<size_t>(input_dim)) {
+        lane_sequence_ptr->set_probability(0.0);
+        ADEBUG << "Skip lane sequence due to incorrect feature size";
+        continue;
+      }
+      bool on_lane = lane_sequence_ptr->vehicle_on_lane();
+      std::vector<float>* inputs = on_lane ? &go_inputs : &cutin_inputs;
+      inputs->insert(inputs->end(), feature_values.begin(),
+                     feature_values.end());
+      (on_lane ? go_lane_sequences : cutin_lane_sequences)
+          .push_back(lane_sequence_ptr);
+    }
+    (*results)[i] = true;
+  }
+
+  BatchModelInference(input_dim, &go_inputs, torch_go_model_,
+                      go_lane_sequences);
+  BatchModelInference(input_dim, &cutin_inputs, torch_cutin_model_,
+                      cutin_lane_sequences);
+}
+
+LaneGraph* CruiseMLPEvaluator::GetLaneGraph(Obstacle* obstacle_ptr) {
+  int id = obstacle_ptr->id();
+  if (!obstacle_ptr->latest_feature().IsInitialized()) {
+    AERROR << "Obstacle [" << id << "] has no latest feature.";
+    return nullptr;
+  }
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
+  CHECK_NOTNULL(latest_feature_ptr);
+  if (!latest_feature_ptr->has_lane() ||
+      !latest_feature_ptr->lane().has_lane_graph()) {
+    ADEBUG << "Obstacle [" << id << "] has no lane graph.";
+    return nullptr;
+  }
+  LaneGraph* lane_graph_ptr =
+      latest_feature_ptr->mutable_lane()->mutable_lane_graph();
+  CHECK_NOTNULL(lane_graph_ptr);
+  if (lane_graph_ptr->lane_sequence().empty()) {
+    AERROR << "Obstacle [" << id << "] has no lane sequences.";
+    return nullptr;
+  }
+  return lane_graph_ptr;
+}
+
 void CruiseMLPEvaluator::ExtractFeatureValues(
     Obstacle* obstacle_ptr, LaneSequence* lane_sequence_ptr,
     std::vector<double>* feature_values) {
@@ -555,5 +620,31 @@ void CruiseMLPEvaluator::ModelInference(
       static_cast<double>(finish_time_tensor.accessor<float, 2>()[0][0]));
 }
 
+void CruiseMLPEvaluator::BatchModelInference(
+    const int input_dim, std::vector<float>* inputs,
+    torch::jit::script::Module torch_model_ptr,
+    const std::vector<LaneSequence*>& lane_sequences) {
+  if (lane_sequences.empty()) {
+    return;
+  }
+  const int64_t batch_size = static_cast<int64_t>(lane_sequences.size());
+  std::vector<torch::jit::IValue> torch_inputs;
+  torch_inputs.push_back(
+      torch::from_blob(inputs->data(), {batch_size, input_dim}).to(device_));
+  auto torch_output_tuple = torch_model_ptr.forward(torch_inputs).toTuple();
+  auto probability_tensor =
+      torch_output_tuple->elements()[0].toTensor().to(torch::kCPU);
+  auto finish_time_tensor =
+      torch_output_tuple->elements()[1].toTensor().to(torch::kCPU);
+  auto probability = probability_tensor.accessor<float, 2>();
+  auto finish_time = finish_time_tensor.accessor<float, 2>();
+  for (int64_t i = 0; i < batch_size; ++i) {
+    lane_sequences[i]->set_probability(apollo::common::math::Sigmoid(
+        static_cast<double>(probability[i][0])));
+    lane_sequences[i]->set_time_to_lane_center(
+        static_cast<double>(finish_time[i][0]));
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
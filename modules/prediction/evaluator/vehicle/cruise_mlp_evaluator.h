@@ -49,6 +49,17 @@ class CruiseMLPEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override EvaluateBatch, the lane sequences of all the obstacles
+   *        share one forward pass of each model
+   * @param Obstacle pointers
+   * @param Obstacles container
+   * @param Whether each obstacle is evaluated successfully
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                     ObstaclesContainer* obstacles_container,
+                     std::vector<bool>* results) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -105,6 +116,24 @@ class CruiseMLPEvaluator : public Evaluator {
                       torch::jit::script::Module torch_model_ptr,
                       LaneSequence* lane_sequence_ptr);
 
+  /**
+   * @brief Run one forward pass for several lane sequences
+   * @param Feature size of one lane sequence
+   * @param Row major features, one row per lane sequence
+   * @param Model
+   * @param Lane sequences receiving the outputs
+   */
+  void BatchModelInference(const int input_dim, std::vector<float>* inputs,
+                           torch::jit::script::Module torch_model_ptr,
+                           const std::vector<LaneSequence*>& lane_sequences);
+
+  /**
+   * @brief Get the lane graph of an obstacle to evaluate
+   * @param Obstacle pointer
+   * @return Lane graph pointer, nullptr if the obstacle has no lane sequence
+   */
+  LaneGraph* GetLaneGraph(Obstacle* obstacle_ptr);
+
  private:
   static const size_t OBSTACLE_FEATURE_SIZE = 23 + 5 * 9;
   static const size_t INTERACTION_FEATURE_SIZE = 8;
@@ -70,20 +70,10 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
 
   obstacle_ptr->SetEvaluatorType(evaluator_type_);
 
-  int id = obstacle_ptr->id();
-  if (!obstacle_ptr->latest_feature().IsInitialized()) {
-    AERROR << "Obstacle [" << id << "] has no latest feature.";
+  if (!HasJunctionExit(obstacle_ptr)) {
     return false;
   }
   Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
-  CHECK_NOTNULL(latest_feature_ptr);
-
-  // Assume obstacle is NOT closed to any junction exit
-  if (!latest_feature_ptr->has_junction_feature() ||
-      latest_feature_ptr->junction_feature().junction_exit_size() < 1) {
-    ADEBUG << "Obstacle [" << id << "] has no junction_exit.";
-    return false;
-  }
 
   std::vector<double> feature_values;
   ExtractFeatureValues(obstacle_ptr, obstacles_container, &feature_values);
@@ -118,6 +108,93 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                            EGO_VEHICLE_FEATURE_SIZE + 8 * i]);
     }
   }
+  return SetLaneSequenceProbabilities(obstacle_ptr, probability);
+}
+
+void JunctionMLPEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles,
+    ObstaclesContainer* obstacles_container, std::vector<bool>* results) {
+  // Dumping data for learning works on single obstacles
+  if (FLAGS_prediction_offline_mode ==
+      PredictionConstants::kDumpDataForLearning) {
+    Evaluator::EvaluateBatch(obstacles, obstacles_container, results);
+    return;
+  }
+  omp_set_num_threads(1);
+  Clear();
+  results->assign(obstacles.size(), false);
+
+  const int input_dim = static_cast<int>(
+      OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE + JUNCTION_FEATURE_SIZE);
+  std::vector<float> inputs;
+  std::vector<size_t> batch_indices;
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    Obstacle* obstacle_ptr = obstacles[i];
+    CHECK_NOTNULL(obstacle_ptr);
+    obstacle_ptr->SetEvaluatorType(evaluator_type_);
+    if (!HasJunctionExit(obstacle_ptr)) {
+      continue;
+    }
+    std::vector<double> feature_values;
+    ExtractFeatureValues(obstacle_ptr, obstacles_container, &feature_values);
+    feature_values.resize(input_dim, 0.0);
+    if (obstacle_ptr->latest_feature().junction_feature().junction_exit_size() >
+        1) {
+      inputs.insert(inputs.end(), feature_values.begin(),
+                    feature_values.end());
+      batch_indices.push_back(i);
+      continue;
+    }
+    std::vector<double> probability;
+    for (int j = 0; j < 12; ++j) {
+      probability.push_back(feature_values[OBSTACLE_FEATURE_SIZE +
+                                           EGO_VEHICLE_FEATURE_SIZE + 8 * j]);
+    }
+    (*results)[i] = SetLaneSequenceProbabilities(obstacle_ptr, probability);
+  }
+  if (batch_indices.empty()) {
+    return;
+  }
+
+  const int64_t batch_size = static_cast<int64_t>(batch_indices.size());
+  std::vector<torch::jit::IValue> torch_inputs;
+  torch_inputs.push_back(
+      torch::from_blob(inputs.data(), {batch_size, input_dim}).to(device_));
+  at::Tensor torch_output_tensor =
+      torch_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+  auto torch_output = torch_output_tensor.accessor<float, 2>();
+  for (int64_t k = 0; k < batch_size; ++k) {
+    std::vector<double> probability;
+    for (int j = 0; j < torch_output.size(1); ++j) {
+      probability.push_back(static_cast<double>(torch_output[k][j]));
+    }
+    const size_t i = batch_indices[k];
+    (*results)[i] = SetLaneSequenceProbabilities(obstacles[i], probability);
+  }
+}
+
+bool JunctionMLPEvaluator::HasJunctionExit(Obstacle* obstacle_ptr) {
+  int id = obstacle_ptr->id();
+  if (!obstacle_ptr->latest_feature().IsInitialized()) {
+    AERROR << "Obstacle [" << id << "] has no latest feature.";
+    return false;
+  }
+  const Feature& latest_feature = obstacle_ptr->latest_feature();
+
+  // Assume obstacle is NOT closed to any junction exit
+  if (!latest_feature.has_junction_feature() ||
+      latest_feature.junction_feature().junction_exit_size() < 1) {
+    ADEBUG << "Obstacle [" << id << "] has no junction_exit.";
+    return false;
+  }
+  return true;
+}
+
+bool JunctionMLPEvaluator::SetLaneSequenceProbabilities(
+    Obstacle* obstacle_ptr, const std::vector<double>& probability) {
+  int id = obstacle_ptr->id();
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
+  CHECK_NOTNULL(latest_feature_ptr);
   for (double prob : probability) {
     latest_feature_ptr->mutable_junction_feature()
         ->add_junction_mlp_probability(prob);
@@ -53,6 +53,17 @@ class JunctionMLPEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override EvaluateBatch, the obstacles with several junction exits
+   *        share one forward pass
+   * @param Obstacle pointers
+   * @param Obstacles container
+   * @param Whether each obstacle is evaluated successfully
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                     ObstaclesContainer* obstacles_container,
+                     std::vector<bool>* results) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -100,6 +111,21 @@ class JunctionMLPEvaluator : public Evaluator {
    */
   void LoadModel();
 
+  /**
+   * @brief Check if an obstacle has the junction exits to evaluate
+   * @param Obstacle pointer
+   */
+  bool HasJunctionExit(Obstacle* obstacle_ptr);
+
+  /**
+   * @brief Set the junction exit probabilities and the lane sequence
+   *        probabilities of an obstacle
+   * @param Obstacle pointer
+   * @param Probabilities of the 12 fan areas
+   */
+  bool SetLaneSequenceProbabilities(Obstacle* obstacle_ptr,
+                                    const std::vector<double>& probability);
+
  private:
   // obstacle feature with 4 basic features and 5 frames of history position
   static const size_t OBSTACLE_FEATURE_SIZE = 4 + 2 * 5;
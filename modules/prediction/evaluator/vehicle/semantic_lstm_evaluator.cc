@@ -46,14 +46,110 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
   obstacle_ptr->SetEvaluatorType(evaluator_type_);
 
   Clear();
+  torch::Tensor img_tensor;
+  torch::Tensor obstacle_pos;
+  torch::Tensor obstacle_pos_step;
+  if (!ExtractFeatureTensors(obstacle_ptr, &img_tensor, &obstacle_pos,
+                             &obstacle_pos_step)) {
+    return false;
+  }
+
+  // Build input features for torch
+  std::vector<torch::jit::IValue> torch_inputs;
+
+  torch_inputs.push_back(c10::ivalue::Tuple::create(
+      {std::move(img_tensor.to(device_)), std::move(obstacle_pos.to(device_)),
+       std::move(obstacle_pos_step.to(device_))}));
+
+  // Compute pred_traj
+  auto start_time = std::chrono::system_clock::now();
+  at::Tensor torch_output_tensor = torch_default_output_tensor_;
+  if (obstacle_ptr->IsPedestrian()) {
+    torch_output_tensor = torch_pedestrian_model_.forward(torch_inputs)
+                              .toTensor()
+                              .to(torch::kCPU);
+  } else {
+    torch_output_tensor =
+        torch_vehicle_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+  }
+
+  auto end_time = std::chrono::system_clock::now();
+  std::chrono::duration<double> diff = end_time - start_time;
+  ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
+         << " ms.";
+
+  AddPredictedTrajectory(torch_output_tensor, 0, obstacle_ptr);
+  return true;
+}
+
+void SemanticLSTMEvaluator::EvaluateBatch(
+    const std::vector<Obstacle*>& obstacles,
+    ObstaclesContainer* obstacles_container, std::vector<bool>* results) {
+  omp_set_num_threads(1);
+  Clear();
+  results->assign(obstacles.size(), false);
+
+  // Vehicles and pedestrians go through different models, so each of them
+  // gets its own batch.
+  std::vector<size_t> batch_indices[2];
+  std::vector<torch::Tensor> img_tensors[2];
+  std::vector<torch::Tensor> obstacle_poses[2];
+  std::vector<torch::Tensor> obstacle_pos_steps[2];
+  for (size_t i = 0; i < obstacles.size(); ++i) {
+    Obstacle* obstacle_ptr = obstacles[i];
+    obstacle_ptr->SetEvaluatorType(evaluator_type_);
+    torch::Tensor img_tensor;
+    torch::Tensor obstacle_pos;
+    torch::Tensor obstacle_pos_step;
+    if (!ExtractFeatureTensors(obstacle_ptr, &img_tensor, &obstacle_pos,
+                               &obstacle_pos_step)) {
+      continue;
+    }
+    const int model_idx = obstacle_ptr->IsPedestrian() ? 1 : 0;
+    batch_indices[model_idx].push_back(i);
+    img_tensors[model_idx].push_back(std::move(img_tensor));
+    obstacle_poses[model_idx].push_back(std::move(obstacle_pos));
+    obstacle_pos_steps[model_idx].push_back(std::move(obstacle_pos_step));
+  }
+
+  for (int model_idx = 0; model_idx < 2; ++model_idx) {
+    if (batch_indices[model_idx].empty()) {
+      continue;
+    }
+    std::vector<torch::jit::IValue> torch_inputs;
+    torch_inputs.push_back(c10::ivalue::Tuple::create(
+        {torch::cat(img_tensors[model_idx]).to(device_),
+         torch::cat(obstacle_poses[model_idx]).to(device_),
+         torch::cat(obstacle_pos_steps[model_idx]).to(device_)}));
+
+    auto start_time = std::chrono::system_clock::now();
+    torch::jit::script::Module& torch_model =
+        model_idx == 1 ? torch_pedestrian_model_ : torch_vehicle_model_;
+    at::Tensor torch_output_tensor =
+        torch_model.forward(torch_inputs).toTensor().to(torch::kCPU);
+    auto end_time = std::chrono::system_clock::now();
+    std::chrono::duration<double> diff = end_time - start_time;
+    ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
+           << " ms for " << batch_indices[model_idx].size() << " obstacles.";
+
+    for (size_t k = 0; k < batch_indices[model_idx].size(); ++k) {
+      const size_t i = batch_indices[model_idx][k];
+      AddPredictedTrajectory(torch_output_tensor, static_cast<int>(k),
+                             obstacles[i]);
+      (*results)[i] = true;
+    }
+  }
+}
+
+bool SemanticLSTMEvaluator::ExtractFeatureTensors(
+    Obstacle* obstacle_ptr, torch::Tensor* img_tensor,
+    torch::Tensor* obstacle_pos, torch::Tensor* obstacle_pos_step) {
   CHECK_NOTNULL(obstacle_ptr);
   int id = obstacle_ptr->id();
   if (!obstacle_ptr->latest_feature().IsInitialized()) {
     AERROR << "Obstacle [" << id << "] has no latest feature.";
     return false;
   }
-  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
-  CHECK_NOTNULL(latest_feature_ptr);
 
   if (!FLAGS_enable_semantic_map) {
     ADEBUG << "Not enable semantic map, exit semantic_lstm_evaluator.";
@@ -67,11 +163,14 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
   cv::cvtColor(feature_map, feature_map, cv::COLOR_BGR2RGB);
   cv::Mat img_float;
   feature_map.convertTo(img_float, CV_32F, 1.0 / 255);
-  torch::Tensor img_tensor = torch::from_blob(img_float.data, {1, 224, 224, 3});
-  img_tensor = img_tensor.permute({0, 3, 1, 2});
-  img_tensor[0][0] = img_tensor[0][0].sub(0.485).div(0.229);
-  img_tensor[0][1] = img_tensor[0][1].sub(0.456).div(0.224);
-  img_tensor[0][2] = img_tensor[0][2].sub(0.406).div(0.225);
+  // contiguous() copies the permuted image out of img_float, the tensor
+  // owns its data after this function returns
+  *img_tensor = torch::from_blob(img_float.data, {1, 224, 224, 3})
+                    .permute({0, 3, 1, 2})
+                    .contiguous();
+  (*img_tensor)[0][0] = (*img_tensor)[0][0].sub(0.485).div(0.229);
+  (*img_tensor)[0][1] = (*img_tensor)[0][1].sub(0.456).div(0.224);
+  (*img_tensor)[0][2] = (*img_tensor)[0][2].sub(0.406).div(0.225);
 
   // Extract features of pos_history
   std::vector<std::pair<double, double>> pos_history(20, {0.0, 0.0});
@@ -81,45 +180,29 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
   }
   // Process obstacle_history
   // TODO(Hongyi): move magic numbers to parameters and gflags
-  torch::Tensor obstacle_pos = torch::zeros({1, 20, 2});
-  torch::Tensor obstacle_pos_step = torch::zeros({1, 20, 2});
+  *obstacle_pos = torch::zeros({1, 20, 2});
+  *obstacle_pos_step = torch::zeros({1, 20, 2});
+  auto pos = obstacle_pos->accessor<float, 3>();
+  auto pos_step = obstacle_pos_step->accessor<float, 3>();
   for (int i = 0; i < 20; ++i) {
-    obstacle_pos[0][19 - i][0] = pos_history[i].first;
-    obstacle_pos[0][19 - i][1] = pos_history[i].second;
+    pos[0][19 - i][0] = static_cast<float>(pos_history[i].first);
+    pos[0][19 - i][1] = static_cast<float>(pos_history[i].second);
     if (i == 19 || (i > 0 && pos_history[i].first == 0.0)) {
       break;
     }
-    obstacle_pos_step[0][19 - i][0] =
-        pos_history[i].first - pos_history[i + 1].first;
-    obstacle_pos_step[0][19 - i][1] =
-        pos_history[i].second - pos_history[i + 1].second;
-  }
-
-  // Build input features for torch
-  std::vector<torch::jit::IValue> torch_inputs;
-
-  torch_inputs.push_back(c10::ivalue::Tuple::create(
-      {std::move(img_tensor.to(device_)), std::move(obstacle_pos.to(device_)),
-       std::move(obstacle_pos_step.to(device_))}));
-
-  // Compute pred_traj
-  std::vector<double> pred_traj;
-
-  auto start_time = std::chrono::system_clock::now();
-  at::Tensor torch_output_tensor = torch_default_output_tensor_;
-  if (obstacle_ptr->IsPedestrian()) {
-    torch_output_tensor = torch_pedestrian_model_.forward(torch_inputs)
-                              .toTensor()
-                              .to(torch::kCPU);
-  } else {
-    torch_output_tensor =
-        torch_vehicle_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
+    pos_step[0][19 - i][0] =
+        static_cast<float>(pos_history[i].first - pos_history[i + 1].first);
+    pos_step[0][19 - i][1] =
+        static_cast<float>(pos_history[i].second - pos_history[i + 1].second);
   }
+  return true;
+}
 
-  auto end_time = std::chrono::system_clock::now();
-  std::chrono::duration<double> diff = end_time - start_time;
-  ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
-         << " ms.";
+void SemanticLSTMEvaluator::AddPredictedTrajectory(
+    const at::Tensor& torch_output_tensor, const int index,
+    Obstacle* obstacle_ptr) {
+  Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
+  CHECK_NOTNULL(latest_feature_ptr);
   auto torch_output = torch_output_tensor.accessor<float, 3>();
 
   // Get the trajectory
@@ -137,8 +220,8 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
       prev_y = last_point.y();
     }
     TrajectoryPoint* point = trajectory->add_trajectory_point();
-    double dx = static_cast<double>(torch_output[0][i][0]);
-    double dy = static_cast<double>(torch_output[0][i][1]);
+    double dx = static_cast<double>(torch_output[index][i][0]);
+    double dy = static_cast<double>(torch_output[index][i][1]);
 
     double heading = latest_feature_ptr->velocity_heading();
     Vec2d offset(dx, dy);
@@ -149,9 +232,11 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
     point->mutable_path_point()->set_y(point_y);
 
     if (torch_output_tensor.sizes()[2] == 5) {
-      double sigma_xr = std::abs(static_cast<double>(torch_output[0][i][2]));
-      double sigma_yr = std::abs(static_cast<double>(torch_output[0][i][3]));
-      double corr_r = static_cast<double>(torch_output[0][i][4]);
+      double sigma_xr =
+          std::abs(static_cast<double>(torch_output[index][i][2]));
+      double sigma_yr =
+          std::abs(static_cast<double>(torch_output[index][i][3]));
+      double corr_r = static_cast<double>(torch_output[index][i][4]);
       Eigen::Matrix2d cov_matrix_r;
       cov_matrix_r(0, 0) = sigma_xr * sigma_xr;
       cov_matrix_r(0, 1) = corr_r * sigma_xr * sigma_yr;
@@ -212,8 +297,6 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
                    FLAGS_prediction_trajectory_time_resolution);
     }
   }
-
-  return true;
 }
 
 bool SemanticLSTMEvaluator::ExtractObstacleHistory(
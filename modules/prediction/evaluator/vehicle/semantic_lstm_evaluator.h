@@ -54,6 +54,17 @@ class SemanticLSTMEvaluator : public Evaluator {
   bool Evaluate(Obstacle* obstacle_ptr,
                 ObstaclesContainer* obstacles_container) override;
 
+  /**
+   * @brief Override EvaluateBatch, one forward pass for the vehicles and one
+   *        for the pedestrians of the batch
+   * @param Obstacle pointers
+   * @param Obstacles container
+   * @param Whether each obstacle is evaluated successfully
+   */
+  void EvaluateBatch(const std::vector<Obstacle*>& obstacles,
+                     ObstaclesContainer* obstacles_container,
+                     std::vector<bool>* results) override;
+
   /**
    * @brief Extract obstacle history
    * @param Obstacle pointer
@@ -74,6 +85,26 @@ class SemanticLSTMEvaluator : public Evaluator {
    */
   void LoadModel();
 
+  /**
+   * @brief Extract the model inputs of an obstacle, each with batch size 1
+   * @param Obstacle pointer
+   * @param Semantic map image
+   * @param Obstacle position history
+   * @param Obstacle position steps
+   */
+  bool ExtractFeatureTensors(Obstacle* obstacle_ptr, torch::Tensor* img_tensor,
+                             torch::Tensor* obstacle_pos,
+                             torch::Tensor* obstacle_pos_step);
+
+  /**
+   * @brief Add the predicted trajectory from one row of the model output
+   * @param Model output
+   * @param Row of the obstacle in the model output
+   * @param Obstacle pointer
+   */
+  void AddPredictedTrajectory(const at::Tensor& torch_output_tensor,
+                              const int index, Obstacle* obstacle_ptr);
+
  private:
   torch::jit::script::Module torch_vehicle_model_;
   torch::jit::script::Module torch_pedestrian_model_;
@@ -14,8 +14,23 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "cyber/common/file.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "modules/prediction/common/feature_output.h"
 #include "modules/prediction/common/message_process.h"
@@ -26,15 +41,59 @@
 
 namespace apollo {
 namespace prediction {
+namespace {
+
+std::string IndexFileName(const std::string& tag) {
+  if (tag.empty()) {
+    return absl::StrCat(FLAGS_prediction_data_dir, "/index.txt");
+  }
+  return absl::StrCat(FLAGS_prediction_data_dir, "/index.", tag, ".txt");
+}
 
-void GenerateDataForLearning() {
+// records are assigned largest first to the least loaded shard, so that the
+// workers finish at about the same time
+std::vector<std::vector<std::string>> ShardRecords(
+    const std::vector<std::string>& records, const size_t num_shards) {
+  std::vector<std::pair<uintmax_t, std::string>> sized_records;
+  for (const auto& record : records) {
+    boost::system::error_code error;
+    uintmax_t size = boost::filesystem::file_size(record, error);
+    sized_records.emplace_back(error ? 0 : size, record);
+  }
+  std::stable_sort(sized_records.begin(), sized_records.end(),
+                   [](const std::pair<uintmax_t, std::string>& lhs,
+                      const std::pair<uintmax_t, std::string>& rhs) {
+                     return lhs.first > rhs.first;
+                   });
+
+  std::vector<std::vector<std::string>> shards(num_shards);
+  std::vector<uintmax_t> loads(num_shards, 0);
+  for (const auto& sized_record : sized_records) {
+    size_t shard = std::min_element(loads.begin(), loads.end()) - loads.begin();
+    loads[shard] += sized_record.first;
+    shards[shard].push_back(sized_record.second);
+  }
+  for (auto& shard : shards) {
+    std::sort(shard.begin(), shard.end());
+  }
+  return shards;
+}
+
+// each line of the index maps an output file to the records it was dumped from
+void WriteIndexEntries(const std::vector<std::string>& records,
+                       std::ofstream* index) {
+  const std::string joined_records = absl::StrJoin(records, ":");
+  for (const auto& file_name : FeatureOutput::TakeWrittenFiles()) {
+    *index << file_name << "\t" << joined_records << "\n";
+  }
+}
+
+bool ProcessRecords(const std::vector<std::string>& records,
+                    const std::string& index_file_name) {
   apollo::hdmap::HDMapUtil::ReloadMaps();
   if (!FeatureOutput::Ready()) {
     AERROR << "Feature output is not ready.";
-    return;
-  }
-  if (FLAGS_prediction_offline_bags.empty()) {
-    return;
+    return false;
   }
 
   PredictionConf prediction_conf;
@@ -42,7 +101,7 @@ void GenerateDataForLearning() {
                                        &prediction_conf)) {
     AERROR << "Unable to load adapter conf file: "
            << FLAGS_prediction_adapter_config_filename;
-    return;
+    return false;
   }
   ADEBUG << "Adapter config file is loaded into: "
          << prediction_conf.ShortDebugString();
@@ -54,8 +113,45 @@ void GenerateDataForLearning() {
 
   if (!MessageProcess::Init(container_manager.get(), &evaluator_manager,
                             &predictor_manager, prediction_conf)) {
-    return;
+    return false;
+  }
+
+  std::ofstream index(index_file_name);
+  if (!index) {
+    AERROR << "Unable to open index file: " << index_file_name;
+    return false;
   }
+  const size_t records_per_partition = static_cast<size_t>(
+      std::max(FLAGS_prediction_offline_records_per_partition, 0));
+  std::vector<std::string> partition_records;
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    AINFO << "\tProcessing: [ " << i << " / " << records.size()
+          << " ]: " << records[i];
+    MessageProcess::ProcessOfflineData(prediction_conf, container_manager,
+                                       &evaluator_manager, &predictor_manager,
+                                       &scenario_manager, records[i]);
+    partition_records.push_back(records[i]);
+    if (records_per_partition > 0 &&
+        partition_records.size() >= records_per_partition) {
+      FeatureOutput::Flush();
+      WriteIndexEntries(partition_records, &index);
+      partition_records.clear();
+    }
+  }
+  FeatureOutput::Flush();
+  WriteIndexEntries(partition_records, &index);
+  FeatureOutput::Close();
+  return static_cast<bool>(index);
+}
+
+}  // namespace
+
+bool GenerateDataForLearning() {
+  if (FLAGS_prediction_offline_bags.empty()) {
+    return true;
+  }
+
+  std::vector<std::string> records;
   const std::vector<std::string> inputs =
       absl::StrSplit(FLAGS_prediction_offline_bags, ':');
   for (const auto& input : inputs) {
@@ -64,15 +160,58 @@ void GenerateDataForLearning() {
     std::sort(offline_bags.begin(), offline_bags.end());
     AINFO << "For input " << input << ", found " << offline_bags.size()
           << "  rosbags to process";
-    for (std::size_t i = 0; i < offline_bags.size(); ++i) {
-      AINFO << "\tProcessing: [ " << i << " / " << offline_bags.size()
-            << " ]: " << offline_bags[i];
-      MessageProcess::ProcessOfflineData(prediction_conf, container_manager,
-                                         &evaluator_manager, &predictor_manager,
-                                         &scenario_manager, offline_bags[i]);
+    records.insert(records.end(), offline_bags.begin(), offline_bags.end());
+  }
+
+  const size_t num_workers = std::min(
+      static_cast<size_t>(std::max(FLAGS_prediction_offline_num_workers, 1)),
+      records.size());
+  if (num_workers <= 1) {
+    return ProcessRecords(records, IndexFileName(""));
+  }
+
+  // the workers are processes rather than threads, since the feature output,
+  // the map and the analyzers are process wide singletons
+  const auto shards = ShardRecords(records, num_workers);
+  std::vector<pid_t> workers;
+  for (size_t i = 0; i < shards.size(); ++i) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      AERROR << "Unable to fork worker " << i << ": " << strerror(errno);
+      break;
     }
+    if (pid == 0) {
+      const std::string tag = std::to_string(i);
+      FeatureOutput::SetFileTag(tag);
+      bool success = ProcessRecords(shards[i], IndexFileName(tag));
+      google::FlushLogFiles(google::GLOG_INFO);
+      _exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    AINFO << "Worker " << i << " processes " << shards[i].size()
+          << " records.";
+    workers.push_back(pid);
   }
-  FeatureOutput::Close();
+
+  bool success = workers.size() == shards.size();
+  std::ofstream index(IndexFileName(""));
+  for (size_t i = 0; i < workers.size(); ++i) {
+    int status = 0;
+    if (waitpid(workers[i], &status, 0) < 0 || !WIFEXITED(status) ||
+        WEXITSTATUS(status) != EXIT_SUCCESS) {
+      AERROR << "Worker " << i << " failed.";
+      success = false;
+      continue;
+    }
+    const std::string shard_index_file_name = IndexFileName(std::to_string(i));
+    std::ifstream shard_index(shard_index_file_name);
+    std::string line;
+    while (std::getline(shard_index, line)) {
+      index << line << "\n";
+    }
+    shard_index.close();
+    std::remove(shard_index_file_name.c_str());
+  }
+  return success && static_cast<bool>(index);
 }
 
 }  // namespace prediction
@@ -80,6 +219,6 @@ void GenerateDataForLearning() {
 
 int main(int argc, char* argv[]) {
   google::ParseCommandLineFlags(&argc, &argv, true);
-  apollo::prediction::GenerateDataForLearning();
-  return 0;
+  return apollo::prediction::GenerateDataForLearning() ? EXIT_SUCCESS
+                                                       : EXIT_FAILURE;
 }
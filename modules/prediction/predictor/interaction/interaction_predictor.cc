@@ -49,8 +49,8 @@ bool InteractionPredictor::Predict(
   CHECK_NOTNULL(obstacle);
   CHECK_GT(obstacle->history_size(), 0);
 
-  BuildADCTrajectory(adc_trajectory_container,
-                     FLAGS_collision_cost_time_resolution);
+  std::shared_ptr<const ADCTrajectory> adc_trajectory = GetADCTrajectory(
+      adc_trajectory_container, FLAGS_collision_cost_time_resolution);
 
   obstacle->SetPredictorType(predictor_type_);
 
@@ -66,6 +66,14 @@ bool InteractionPredictor::Predict(
   std::vector<double> best_lon_accelerations(num_lane_sequence, 0.0);
   std::vector<double> candidate_lon_accelerations = {0.0,  -0.5, -1.0, -1.5,
                                                      -2.0, -2.5, -3.0};
+  // an obstacle out of reach of the ego trajectory has no collision cost
+  // on any of its lane sequences
+  const bool far_from_adc =
+      FLAGS_enable_interaction_pair_pruning &&
+      IsFarFromADCTrajectory(*obstacle, *adc_trajectory,
+                             *std::max_element(
+                                 candidate_lon_accelerations.begin(),
+                                 candidate_lon_accelerations.end()));
   double smallest_cost = std::numeric_limits<double>::max();
   std::vector<double> posteriors(num_lane_sequence, 0.0);
   double posterior_sum = 0.0;
@@ -73,7 +81,8 @@ bool InteractionPredictor::Predict(
     const LaneSequence& lane_sequence = lane_graph->lane_sequence(i);
     for (const double lon_acceleration : candidate_lon_accelerations) {
       double cost = ComputeTrajectoryCost(
-          *obstacle, lane_sequence, lon_acceleration, adc_trajectory_container);
+          *obstacle, lane_sequence, lon_acceleration, adc_trajectory_container,
+          *adc_trajectory, far_from_adc);
       if (cost < smallest_cost) {
         smallest_cost = cost;
         best_lon_accelerations[i] = lon_acceleration;
@@ -146,21 +155,79 @@ bool InteractionPredictor::Predict(
 
 void InteractionPredictor::Clear() { Predictor::Clear(); }
 
-void InteractionPredictor::BuildADCTrajectory(
+std::shared_ptr<const InteractionPredictor::ADCTrajectory>
+InteractionPredictor::GetADCTrajectory(
     const ADCTrajectoryContainer* adc_trajectory_container,
     const double time_resolution) {
+  std::lock_guard<std::mutex> lock(adc_trajectory_mutex_);
   if (adc_trajectory_container == nullptr) {
     AERROR << "Null adc trajectory container";
-    return;
+    adc_trajectory_ = std::make_shared<const ADCTrajectory>();
+    return adc_trajectory_;
   }
-  const auto& adc_trajectory = adc_trajectory_container->adc_trajectory();
+  const auto& trajectory = adc_trajectory_container->adc_trajectory();
+  // the sampled trajectory is reused until planning publishes a new one
+  if (adc_trajectory_ != nullptr &&
+      adc_trajectory_->timestamp == trajectory.header().timestamp_sec() &&
+      adc_trajectory_->sequence_num == trajectory.header().sequence_num() &&
+      adc_trajectory_->num_trajectory_points ==
+          trajectory.trajectory_point_size()) {
+    return adc_trajectory_;
+  }
+
+  auto adc_trajectory = std::make_shared<ADCTrajectory>();
+  adc_trajectory->timestamp = trajectory.header().timestamp_sec();
+  adc_trajectory->sequence_num = trajectory.header().sequence_num();
+  adc_trajectory->num_trajectory_points = trajectory.trajectory_point_size();
+  adc_trajectory->min_x = std::numeric_limits<double>::max();
+  adc_trajectory->max_x = std::numeric_limits<double>::lowest();
+  adc_trajectory->min_y = std::numeric_limits<double>::max();
+  adc_trajectory->max_y = std::numeric_limits<double>::lowest();
   double curr_timestamp = 0.0;
-  for (const TrajectoryPoint& point : adc_trajectory.trajectory_point()) {
+  for (const TrajectoryPoint& point : trajectory.trajectory_point()) {
+    if (FLAGS_enable_interaction_pair_pruning &&
+        point.relative_time() >
+            FLAGS_prediction_trajectory_time_length + FLAGS_double_precision) {
+      // obstacle trajectories end at the prediction horizon
+      break;
+    }
     if (point.relative_time() + FLAGS_double_precision > curr_timestamp) {
-      adc_trajectory_.push_back(point);
+      adc_trajectory->points.push_back(point);
+      adc_trajectory->min_x =
+          std::min(adc_trajectory->min_x, point.path_point().x());
+      adc_trajectory->max_x =
+          std::max(adc_trajectory->max_x, point.path_point().x());
+      adc_trajectory->min_y =
+          std::min(adc_trajectory->min_y, point.path_point().y());
+      adc_trajectory->max_y =
+          std::max(adc_trajectory->max_y, point.path_point().y());
       curr_timestamp += time_resolution;
     }
   }
+  adc_trajectory_ = adc_trajectory;
+  return adc_trajectory_;
+}
+
+bool InteractionPredictor::IsFarFromADCTrajectory(
+    const Obstacle& obstacle, const ADCTrajectory& adc_trajectory,
+    const double max_acceleration) const {
+  if (adc_trajectory.points.empty()) {
+    return true;
+  }
+  const Feature& feature = obstacle.latest_feature();
+  const double x = feature.position().x();
+  const double y = feature.position().y();
+  const double dx = std::max(
+      {adc_trajectory.min_x - x, 0.0, x - adc_trajectory.max_x});
+  const double dy = std::max(
+      {adc_trajectory.min_y - y, 0.0, y - adc_trajectory.max_y});
+  // the farthest the obstacle travels along its lanes within the horizon
+  const double time_length = FLAGS_prediction_trajectory_time_length;
+  const double reach = std::max(
+      0.0, feature.speed() * time_length +
+               0.5 * std::max(max_acceleration, 0.0) * time_length *
+                   time_length);
+  return std::hypot(dx, dy) > reach + FLAGS_interaction_gating_distance;
 }
 
 bool InteractionPredictor::DrawTrajectory(
@@ -239,7 +306,8 @@ bool InteractionPredictor::DrawTrajectory(
 double InteractionPredictor::ComputeTrajectoryCost(
     const Obstacle& obstacle, const LaneSequence& lane_sequence,
     const double acceleration,
-    const ADCTrajectoryContainer* adc_trajectory_container) {
+    const ADCTrajectoryContainer* adc_trajectory_container,
+    const ADCTrajectory& adc_trajectory, const bool far_from_adc) {
   CHECK_GT(obstacle.history_size(), 0);
   double speed = obstacle.latest_feature().speed();
   double total_cost = 0.0;
@@ -252,10 +320,11 @@ double InteractionPredictor::ComputeTrajectoryCost(
   total_cost += FLAGS_centripedal_acceleration_cost_weight * centri_acc_cost;
 
   double collision_cost = 0.0;
-  if (LowerRightOfWayThanEgo(obstacle, lane_sequence,
+  if (!far_from_adc &&
+      LowerRightOfWayThanEgo(obstacle, lane_sequence,
                              adc_trajectory_container)) {
-    collision_cost =
-        CollisionWithEgoVehicleCost(lane_sequence, speed, acceleration);
+    collision_cost = CollisionWithEgoVehicleCost(lane_sequence, speed,
+                                                 acceleration, adc_trajectory);
   }
   total_cost += FLAGS_collision_cost_weight * collision_cost;
 
@@ -265,7 +334,7 @@ double InteractionPredictor::ComputeTrajectoryCost(
                                        collision_cost};
     FeatureOutput::InsertDataForTuning(obstacle.latest_feature(), cost_values,
                                        "interaction", lane_sequence,
-                                       adc_trajectory_);
+                                       adc_trajectory.points);
   }
 
   return total_cost;
@@ -296,32 +365,36 @@ double InteractionPredictor::CentripetalAccelerationCost(
 
 double InteractionPredictor::CollisionWithEgoVehicleCost(
     const LaneSequence& lane_sequence, const double speed,
-    const double acceleration) {
+    const double acceleration, const ADCTrajectory& adc_trajectory) {
   CHECK_GT(lane_sequence.lane_segment_size(), 0);
   double cost_abs_sum = 0.0;
   double cost_sqr_sum = 0.0;
   int num_lane_segment = lane_sequence.lane_segment_size();
+  std::vector<std::shared_ptr<const LaneInfo>> lane_infos;
+  lane_infos.reserve(num_lane_segment);
+  for (const LaneSegment& lane_segment : lane_sequence.lane_segment()) {
+    std::shared_ptr<const LaneInfo> lane_info_ptr =
+        PredictionMap::LaneById(lane_segment.lane_id());
+    if (lane_info_ptr == nullptr) {
+      AERROR << "Null lane info ptr found with lane ID ["
+             << lane_segment.lane_id() << "]";
+      return 0.0;
+    }
+    lane_infos.push_back(std::move(lane_info_ptr));
+  }
 
   double remained_s = lane_sequence.lane_segment(0).start_s();
   int lane_seg_idx = 0;
   double prev_s = 0.0;
 
-  for (const TrajectoryPoint& adc_trajectory_point : adc_trajectory_) {
+  for (const TrajectoryPoint& adc_trajectory_point : adc_trajectory.points) {
     double relative_time = adc_trajectory_point.relative_time();
     double curr_s =
         GetSByConstantAcceleration(speed, acceleration, relative_time);
     double delta_s = curr_s - prev_s;
     remained_s += delta_s;
     while (lane_seg_idx < num_lane_segment) {
-      const LaneSegment& lane_segment =
-          lane_sequence.lane_segment(lane_seg_idx);
-      const std::string& lane_id = lane_segment.lane_id();
-      std::shared_ptr<const LaneInfo> lane_info_ptr =
-          PredictionMap::LaneById(lane_id);
-      if (lane_info_ptr == nullptr) {
-        AERROR << "Null lane info ptr found with lane ID [" << lane_id << "]";
-        continue;
-      }
+      const auto& lane_info_ptr = lane_infos[lane_seg_idx];
       double lane_length = lane_info_ptr->total_length();
       if (remained_s < lane_length) {
         apollo::common::PointENU point_enu =
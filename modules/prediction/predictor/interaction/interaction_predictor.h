@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -51,12 +53,31 @@ class InteractionPredictor : public SequencePredictor {
                ObstaclesContainer* obstacles_container) override;
 
  private:
+  /**
+   * @brief The ego trajectory sampled for the collision cost, shared by all
+   *        the obstacles of a frame
+   */
+  struct ADCTrajectory {
+    double timestamp = 0.0;
+    uint32_t sequence_num = 0;
+    int num_trajectory_points = 0;
+    std::vector<apollo::common::TrajectoryPoint> points;
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+  };
+
   void Clear();
 
-  void BuildADCTrajectory(
+  std::shared_ptr<const ADCTrajectory> GetADCTrajectory(
       const ADCTrajectoryContainer* adc_trajectory_container,
       const double time_resolution);
 
+  bool IsFarFromADCTrajectory(const Obstacle& obstacle,
+                              const ADCTrajectory& adc_trajectory,
+                              const double max_acceleration) const;
+
   bool DrawTrajectory(
       const Obstacle& obstacle, const LaneSequence& lane_sequence,
       const double lon_acceleration, const double total_time,
@@ -66,7 +87,8 @@ class InteractionPredictor : public SequencePredictor {
   double ComputeTrajectoryCost(
       const Obstacle& obstacle, const LaneSequence& lane_sequence,
       const double acceleration,
-      const ADCTrajectoryContainer* adc_trajectory_container);
+      const ADCTrajectoryContainer* adc_trajectory_container,
+      const ADCTrajectory& adc_trajectory, const bool far_from_adc);
 
   double LongitudinalAccelerationCost(const double acceleration);
 
@@ -76,7 +98,8 @@ class InteractionPredictor : public SequencePredictor {
 
   double CollisionWithEgoVehicleCost(const LaneSequence& lane_sequence,
                                      const double speed,
-                                     const double acceleration);
+                                     const double acceleration,
+                                     const ADCTrajectory& adc_trajectory);
 
   bool LowerRightOfWayThanEgo(
       const Obstacle& obstacle, const LaneSequence& lane_sequence,
@@ -87,7 +110,9 @@ class InteractionPredictor : public SequencePredictor {
   double ComputePosterior(const double prior, const double likelihood);
 
  private:
-  std::vector<apollo::common::TrajectoryPoint> adc_trajectory_;
+  // predictions of different obstacles may run concurrently
+  std::mutex adc_trajectory_mutex_;
+  std::shared_ptr<const ADCTrajectory> adc_trajectory_;
 };
 
 }  // namespace prediction
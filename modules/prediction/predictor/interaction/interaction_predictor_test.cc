@@ -18,6 +18,7 @@
 
 #include "cyber/common/file.h"
 #include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
 
@@ -55,5 +56,23 @@ TEST_F(InteractionPredictorTest, OnLaneCase) {
   EXPECT_EQ(predictor.NumOfTrajectories(*obstacle_ptr), 1);
 }
 
+TEST_F(InteractionPredictorTest, OnLaneCaseWithPairPruning) {
+  FLAGS_enable_interaction_pair_pruning = true;
+  MLPEvaluator mlp_evaluator;
+  ObstaclesContainer container;
+  ADCTrajectoryContainer adc_trajectory_container;
+  container.Insert(perception_obstacles_);
+  container.BuildLaneGraph();
+  Obstacle* obstacle_ptr = container.GetObstacle(1);
+  EXPECT_NE(obstacle_ptr, nullptr);
+  mlp_evaluator.Evaluate(obstacle_ptr, &container);
+  InteractionPredictor predictor;
+  // without an ego trajectory the obstacle is pruned from the collision cost
+  // and still gets its trajectory
+  predictor.Predict(&adc_trajectory_container, obstacle_ptr, &container);
+  EXPECT_EQ(predictor.NumOfTrajectories(*obstacle_ptr), 1);
+  FLAGS_enable_interaction_pair_pruning = false;
+}
+
 }  // namespace prediction
 }  // namespace apollo
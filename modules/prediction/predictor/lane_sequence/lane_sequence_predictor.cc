@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/validation_checker.h"
@@ -147,6 +148,25 @@ void LaneSequencePredictor::DrawLaneSequenceTrajectoryPoints(
     approach_rate = FLAGS_cutin_approach_rate;
   }
   size_t total_num = static_cast<size_t>(total_time / period);
+  if (FLAGS_enable_batch_trajectory_sampling) {
+    const std::vector<double> lane_lengths =
+        GetLaneSegmentLengths(lane_sequence);
+    LaneSequenceSamples samples;
+    for (size_t i = 0; i < total_num; ++i) {
+      double relative_time = static_cast<double>(i) * period;
+      samples.Add(lane_segment_index, lane_s, lane_l, speed, 0.0,
+                  relative_time);
+      lane_s += speed * period;
+      while (lane_s > lane_lengths[lane_segment_index] &&
+             lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
+        lane_s -= lane_lengths[lane_segment_index];
+        lane_segment_index += 1;
+      }
+      lane_l *= approach_rate;
+    }
+    DrawLaneSequenceSamples(lane_sequence, samples, points);
+    return;
+  }
   for (size_t i = 0; i < total_num; ++i) {
     double relative_time = static_cast<double>(i) * period;
     Eigen::Vector2d point;
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_util.h"
@@ -176,6 +177,40 @@ bool MoveSequencePredictor::DrawMoveSequenceTrajectoryPoints(
 
   // Draw each trajectory point within the total time of prediction
   size_t total_num = static_cast<size_t>(total_time / period);
+  if (FLAGS_enable_batch_trajectory_sampling) {
+    const std::vector<double> lane_lengths =
+        GetLaneSegmentLengths(lane_sequence);
+    LaneSequenceSamples samples;
+    double prev_s = 0.0;
+    for (size_t i = 0; i < total_num; ++i) {
+      double relative_time = static_cast<double>(i) * period;
+      lane_l = EvaluateCubicPolynomial(lateral_coeffs, relative_time, 0,
+                                       time_to_lat_end_state, 0.0);
+      double curr_s =
+          EvaluateQuarticPolynomial(longitudinal_coeffs, relative_time, 0,
+                                    lon_end_vt.second, lon_end_vt.first);
+      lane_s += std::max(0.0, (curr_s - prev_s));
+      if (curr_s + FLAGS_double_precision < prev_s) {
+        lane_l = prev_lane_l;
+      }
+      prev_lane_l = lane_l;
+      prev_s = curr_s;
+      double lane_speed =
+          EvaluateQuarticPolynomial(longitudinal_coeffs, relative_time, 1,
+                                    lon_end_vt.second, lon_end_vt.first);
+      double lane_acc =
+          EvaluateQuarticPolynomial(longitudinal_coeffs, relative_time, 2,
+                                    lon_end_vt.second, lon_end_vt.first);
+      samples.Add(lane_segment_index, lane_s, lane_l, lane_speed, lane_acc,
+                  relative_time);
+      while (lane_s > lane_lengths[lane_segment_index] &&
+             lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
+        lane_s -= lane_lengths[lane_segment_index];
+        lane_segment_index += 1;
+      }
+    }
+    return DrawLaneSequenceSamples(lane_sequence, samples, points);
+  }
   for (size_t i = 0; i < total_num; ++i) {
     double relative_time = static_cast<double>(i) * period;
     Eigen::Vector2d point;
@@ -20,6 +20,8 @@
 #include <unordered_map>
 
 #include "modules/prediction/common/feature_output.h"
+#include "modules/prediction/common/frame_deadline.h"
+#include "modules/prediction/common/prediction_profiler.h"
 #include "modules/prediction/common/prediction_constants.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
@@ -140,12 +142,35 @@ void PredictorManager::Run(
     PredictObstacles(perception_obstacles, adc_trajectory_container,
                      obstacles_container);
   }
+
+  if (FLAGS_enable_anytime_prediction) {
+    size_t num_downgraded = FrameDeadline::Instance()->NumDowngraded();
+    if (num_downgraded > 0) {
+      AINFO << num_downgraded << " obstacles are downgraded to "
+            << "free move prediction by the frame deadline.";
+    }
+  }
 }
 
 void PredictorManager::PredictObstacles(
     const PerceptionObstacles& perception_obstacles,
     const ADCTrajectoryContainer* adc_trajectory_container,
     ObstaclesContainer* obstacles_container) {
+  // caution obstacles are predicted before the deadline checks of the others
+  std::unordered_map<int, PredictionObstacle> caution_prediction_obstacles;
+  if (FLAGS_enable_anytime_prediction) {
+    for (const PerceptionObstacle& perception_obstacle :
+         perception_obstacles.perception_obstacle()) {
+      int id = perception_obstacle.id();
+      Obstacle* obstacle = obstacles_container->GetObstacle(id);
+      if (id < 0 || obstacle == nullptr || !obstacle->IsCaution()) {
+        continue;
+      }
+      PredictObstacle(adc_trajectory_container, obstacle, obstacles_container,
+                      &caution_prediction_obstacles[id]);
+    }
+  }
+
   for (const PerceptionObstacle& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     int id = perception_obstacle.id();
@@ -159,7 +184,10 @@ void PredictorManager::PredictObstacles(
 
     // if obstacle == nullptr, that means obstacle is unmovable
     // Checkout the logic of unmovable in obstacle.cc
-    if (obstacle != nullptr) {
+    auto caution_iter = caution_prediction_obstacles.find(id);
+    if (caution_iter != caution_prediction_obstacles.end()) {
+      prediction_obstacle.Swap(&caution_iter->second);
+    } else if (obstacle != nullptr) {
       PredictObstacle(adc_trajectory_container, obstacle, obstacles_container,
                       &prediction_obstacle);
     } else {  // obstacle == nullptr
@@ -189,6 +217,8 @@ void PredictorManager::PredictObstaclesInParallel(
     id_prediction_obstacle_map[id] = std::make_shared<PredictionObstacle>();
   }
   IdObstacleListMap id_obstacle_map;
+  // caution obstacles are predicted before the deadline checks of the others
+  IdObstacleListMap caution_id_obstacle_map;
   for (const auto& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     int id = perception_obstacle.id();
@@ -198,12 +228,14 @@ void PredictorManager::PredictObstaclesInParallel(
           id_prediction_obstacle_map[id];
       prediction_obstacle_ptr->set_is_static(true);
       prediction_obstacle_ptr->set_timestamp(perception_obstacle.timestamp());
+    } else if (FLAGS_enable_anytime_prediction && obstacle->IsCaution()) {
+      GroupObstaclesByObstacleId(id, obstacles_container,
+                                 &caution_id_obstacle_map);
     } else {
       GroupObstaclesByObstacleId(id, obstacles_container, &id_obstacle_map);
     }
   }
-  PredictionThreadPool::ForEach(
-      id_obstacle_map.begin(), id_obstacle_map.end(),
+  auto predict_obstacles =
       [&](IdObstacleListMap::iterator::value_type& obstacles_iter) {
         for (auto obstacle_ptr : obstacles_iter.second) {
           int id = obstacle_ptr->id();
@@ -211,7 +243,12 @@ void PredictorManager::PredictObstaclesInParallel(
                           obstacles_container,
                           id_prediction_obstacle_map[id].get());
         }
-      });
+      };
+  PredictionThreadPool::ForEach(caution_id_obstacle_map.begin(),
+                                caution_id_obstacle_map.end(),
+                                predict_obstacles);
+  PredictionThreadPool::ForEach(id_obstacle_map.begin(), id_obstacle_map.end(),
+                                predict_obstacles);
   for (const PerceptionObstacle& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     int id = perception_obstacle.id();
@@ -244,6 +281,10 @@ void PredictorManager::PredictObstacle(
   } else if (obstacle->IsStill()) {
     ADEBUG << "Still obstacle [" << obstacle->id() << "]";
     RunEmptyPredictor(adc_trajectory_container, obstacle, obstacles_container);
+  } else if (ToDowngrade(*obstacle)) {
+    ADEBUG << "Downgraded obstacle [" << obstacle->id() << "]";
+    RunFallbackPredictor(adc_trajectory_container, obstacle,
+                         obstacles_container);
   } else {
     switch (obstacle->type()) {
       case PerceptionObstacle::VEHICLE: {
@@ -403,8 +444,8 @@ void PredictorManager::RunVehiclePredictor(
       predictor = GetPredictor(vehicle_default_caution_predictor_);
     }
     CHECK_NOTNULL(predictor);
-    if (predictor->Predict(adc_trajectory_container, obstacle,
-                           obstacles_container)) {
+    if (RunPredictor(predictor, adc_trajectory_container, obstacle,
+                     obstacles_container)) {
       return;
     } else {
       AERROR << "Obstacle: " << obstacle->id()
@@ -425,7 +466,8 @@ void PredictorManager::RunVehiclePredictor(
     AERROR << "Nullptr found for obstacle [" << obstacle->id() << "]";
     return;
   }
-  predictor->Predict(adc_trajectory_container, obstacle, obstacles_container);
+  RunPredictor(predictor, adc_trajectory_container, obstacle,
+               obstacles_container);
   if (FLAGS_enable_trim_prediction_trajectory) {
     CHECK_NOTNULL(adc_trajectory_container);
     predictor->TrimTrajectories(*adc_trajectory_container, obstacle);
@@ -441,7 +483,8 @@ void PredictorManager::RunPedestrianPredictor(
     AERROR << "Nullptr found for obstacle [" << obstacle->id() << "]";
     return;
   }
-  predictor->Predict(adc_trajectory_container, obstacle, obstacles_container);
+  RunPredictor(predictor, adc_trajectory_container, obstacle,
+               obstacles_container);
 }
 
 void PredictorManager::RunCyclistPredictor(
@@ -457,7 +500,8 @@ void PredictorManager::RunCyclistPredictor(
     AERROR << "Nullptr found for obstacle [" << obstacle->id() << "]";
     return;
   }
-  predictor->Predict(adc_trajectory_container, obstacle, obstacles_container);
+  RunPredictor(predictor, adc_trajectory_container, obstacle,
+               obstacles_container);
 }
 
 void PredictorManager::RunDefaultPredictor(
@@ -473,7 +517,40 @@ void PredictorManager::RunDefaultPredictor(
     AERROR << "Nullptr found for obstacle [" << obstacle->id() << "]";
     return;
   }
-  predictor->Predict(adc_trajectory_container, obstacle, obstacles_container);
+  RunPredictor(predictor, adc_trajectory_container, obstacle,
+               obstacles_container);
+}
+
+bool PredictorManager::RunPredictor(
+    Predictor* predictor,
+    const ADCTrajectoryContainer* adc_trajectory_container, Obstacle* obstacle,
+    ObstaclesContainer* obstacles_container) {
+  PredictionProfiler::ScopedTimer timer(
+      "predictor",
+      ObstacleConf::PredictorType_Name(predictor->predictor_type()));
+  return predictor->Predict(adc_trajectory_container, obstacle,
+                            obstacles_container);
+}
+
+void PredictorManager::RunFallbackPredictor(
+    const ADCTrajectoryContainer* adc_trajectory_container, Obstacle* obstacle,
+    ObstaclesContainer* obstacles_container) {
+  FrameDeadline::Instance()->Downgrade(obstacle->id());
+  Predictor* predictor = GetPredictor(ObstacleConf::FREE_MOVE_PREDICTOR);
+  if (predictor == nullptr) {
+    AERROR << "Nullptr found for obstacle [" << obstacle->id() << "]";
+    return;
+  }
+  RunPredictor(predictor, adc_trajectory_container, obstacle,
+               obstacles_container);
+}
+
+bool PredictorManager::ToDowngrade(const Obstacle& obstacle) const {
+  if (!FLAGS_enable_anytime_prediction || obstacle.IsCaution()) {
+    return false;
+  }
+  const FrameDeadline* deadline = FrameDeadline::Instance();
+  return deadline->IsDowngraded(obstacle.id()) || deadline->Expired();
 }
 
 void PredictorManager::RunEmptyPredictor(
@@ -484,7 +561,8 @@ void PredictorManager::RunEmptyPredictor(
     AERROR << "Nullptr found for obstacle [" << obstacle->id() << "]";
     return;
   }
-  predictor->Predict(adc_trajectory_container, obstacle, obstacles_container);
+  RunPredictor(predictor, adc_trajectory_container, obstacle,
+               obstacles_container);
 }
 
 }  // namespace prediction
@@ -138,6 +138,17 @@ class PredictorManager {
       const ADCTrajectoryContainer* adc_trajectory_container,
       Obstacle* obstacle, ObstaclesContainer* obstacles_container);
 
+  bool RunPredictor(Predictor* predictor,
+                    const ADCTrajectoryContainer* adc_trajectory_container,
+                    Obstacle* obstacle,
+                    ObstaclesContainer* obstacles_container);
+
+  void RunFallbackPredictor(
+      const ADCTrajectoryContainer* adc_trajectory_container,
+      Obstacle* obstacle, ObstaclesContainer* obstacles_container);
+
+  bool ToDowngrade(const Obstacle& obstacle) const;
+
   void RunEmptyPredictor(const ADCTrajectoryContainer* adc_trajectory_container,
                          Obstacle* obstacle,
                          ObstaclesContainer* obstacles_container);
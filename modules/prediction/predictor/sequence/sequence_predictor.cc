@@ -18,6 +18,8 @@
 
 #include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/prediction/common/prediction_gflags.h"
@@ -283,6 +285,29 @@ void SequencePredictor::DrawConstantAccelerationTrajectory(
     return;
   }
   size_t total_num = static_cast<size_t>(total_time / period);
+  if (FLAGS_enable_batch_trajectory_sampling) {
+    const std::vector<double> lane_lengths =
+        GetLaneSegmentLengths(lane_sequence);
+    LaneSequenceSamples samples;
+    for (size_t i = 0; i < total_num; ++i) {
+      double relative_time = static_cast<double>(i) * period;
+      samples.Add(lane_segment_index, lane_s, lane_l, speed, 0.0,
+                  relative_time);
+      if (speed < FLAGS_double_precision) {
+        continue;
+      }
+      lane_s += speed * period + 0.5 * acceleration * period * period;
+      speed += acceleration * period;
+      while (lane_s > lane_lengths[lane_segment_index] &&
+             lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
+        lane_s -= lane_lengths[lane_segment_index];
+        lane_segment_index += 1;
+      }
+      lane_l *= FLAGS_go_approach_rate;
+    }
+    DrawLaneSequenceSamples(lane_sequence, samples, points);
+    return;
+  }
   for (size_t i = 0; i < total_num; ++i) {
     double relative_time = static_cast<double>(i) * period;
     Eigen::Vector2d point;
@@ -324,6 +349,64 @@ void SequencePredictor::DrawConstantAccelerationTrajectory(
   }
 }
 
+void SequencePredictor::LaneSequenceSamples::Add(
+    const int lane_segment_index, const double lane_s, const double lane_l,
+    const double speed, const double acc, const double relative_time) {
+  lane_segment_indices.push_back(lane_segment_index);
+  this->lane_s.push_back(lane_s);
+  this->lane_l.push_back(lane_l);
+  speeds.push_back(speed);
+  accs.push_back(acc);
+  relative_times.push_back(relative_time);
+}
+
+std::vector<double> SequencePredictor::GetLaneSegmentLengths(
+    const LaneSequence& lane_sequence) {
+  std::vector<double> lane_lengths;
+  lane_lengths.reserve(lane_sequence.lane_segment_size());
+  for (const LaneSegment& lane_segment : lane_sequence.lane_segment()) {
+    std::shared_ptr<const LaneInfo> lane_info =
+        PredictionMap::LaneById(lane_segment.lane_id());
+    lane_lengths.push_back(lane_info == nullptr ? 0.0
+                                                : lane_info->total_length());
+  }
+  return lane_lengths;
+}
+
+bool SequencePredictor::DrawLaneSequenceSamples(
+    const LaneSequence& lane_sequence, const LaneSequenceSamples& samples,
+    std::vector<TrajectoryPoint>* points) {
+  std::vector<std::string> lane_ids;
+  lane_ids.reserve(lane_sequence.lane_segment_size());
+  for (const LaneSegment& lane_segment : lane_sequence.lane_segment()) {
+    lane_ids.push_back(lane_segment.lane_id());
+  }
+  std::vector<Eigen::Vector2d> smooth_points;
+  std::vector<double> headings;
+  if (!PredictionMap::SmoothPointsFromLanes(
+          lane_ids, samples.lane_segment_indices, samples.lane_s,
+          samples.lane_l, &smooth_points, &headings)) {
+    AERROR << "Unable to get smooth points from lane sequence ["
+           << ToString(lane_sequence) << "]";
+    return false;
+  }
+  points->reserve(points->size() + smooth_points.size());
+  for (size_t i = 0; i < smooth_points.size(); ++i) {
+    TrajectoryPoint trajectory_point;
+    PathPoint* path_point = trajectory_point.mutable_path_point();
+    path_point->set_x(smooth_points[i].x());
+    path_point->set_y(smooth_points[i].y());
+    path_point->set_z(0.0);
+    path_point->set_theta(headings[i]);
+    path_point->set_lane_id(lane_ids[samples.lane_segment_indices[i]]);
+    trajectory_point.set_v(samples.speeds[i]);
+    trajectory_point.set_a(samples.accs[i]);
+    trajectory_point.set_relative_time(samples.relative_times[i]);
+    points->emplace_back(std::move(trajectory_point));
+  }
+  return true;
+}
+
 double SequencePredictor::GetLaneSequenceCurvatureByS(
     const LaneSequence& lane_sequence, const double s) {
   CHECK_GT(lane_sequence.lane_segment_size(), 0);
@@ -124,6 +124,42 @@ class SequencePredictor : public Predictor {
       const double total_time, const double period, const double acceleration,
       std::vector<apollo::common::TrajectoryPoint>* points);
 
+  /**
+   * @brief Lane coordinates and motion of the points of a trajectory along a
+   *        lane sequence
+   */
+  struct LaneSequenceSamples {
+    void Add(const int lane_segment_index, const double lane_s,
+             const double lane_l, const double speed, const double acc,
+             const double relative_time);
+
+    std::vector<int> lane_segment_indices;
+    std::vector<double> lane_s;
+    std::vector<double> lane_l;
+    std::vector<double> speeds;
+    std::vector<double> accs;
+    std::vector<double> relative_times;
+  };
+
+  /**
+   * @brief Get the lengths of the lanes of a lane sequence
+   * @param Lane sequence
+   * @return The length of each lane segment's lane
+   */
+  std::vector<double> GetLaneSegmentLengths(const LaneSequence& lane_sequence);
+
+  /**
+   * @brief Draw trajectory points of samples along a lane sequence, looking up
+   *        each lane once
+   * @param Lane sequence
+   * @param Samples
+   * @param A vector of generated trajectory points
+   * @return If the points are drawn successfully
+   */
+  bool DrawLaneSequenceSamples(
+      const LaneSequence& lane_sequence, const LaneSequenceSamples& samples,
+      std::vector<apollo::common::TrajectoryPoint>* points);
+
   /**
    * @brief Get lane sequence curvature by s
    * @param lane sequence
@@ -19,6 +19,7 @@
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/adapters/proto/adapter_config.pb.h"
+#include "modules/prediction/common/frame_deadline.h"
 #include "modules/prediction/common/message_process.h"
 #include "modules/prediction/common/prediction_system_gflags.h"
 
@@ -55,6 +56,9 @@ bool EvaluatorSubmodule::Proc(
     const std::shared_ptr<SubmoduleOutput>& container_output) {
   constexpr static size_t kHistorySize = 1;
   const auto frame_start_time = container_output->frame_start_time();
+  if (FLAGS_enable_anytime_prediction) {
+    FrameDeadline::Instance()->Start(FLAGS_prediction_frame_time_budget);
+  }
   ObstaclesContainer obstacles_container(*container_output);
   evaluator_manager_->Run(&obstacles_container);
   SubmoduleOutput submodule_output =
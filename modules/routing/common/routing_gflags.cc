@@ -32,3 +32,12 @@ DEFINE_bool(enable_change_lane_in_result, true,
 
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
+
+DEFINE_uint32(routing_num_landmarks, 0,
+              "number of landmarks whose cost tables are built when loading "
+              "the topo graph to guide A* search, 0 to search with the "
+              "distance heuristic instead");
+
+DEFINE_uint32(routing_cache_size, 0,
+              "number of routes between way points kept for later requests "
+              "with the same way points, 0 to disable the cache");
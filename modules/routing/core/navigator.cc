@@ -107,6 +107,9 @@ Navigator::Navigator(const std::string& topo_file_path) {
   }
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
+  if (FLAGS_routing_cache_size > 0) {
+    route_cache_.reset(new RouteCache(FLAGS_routing_cache_size));
+  }
   is_ready_ = true;
   AINFO << "The navigator is ready.";
 }
@@ -151,7 +154,7 @@ bool Navigator::MergeRoute(
 bool Navigator::SearchRouteByStrategy(
     const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
     const std::vector<double>& way_s,
-    std::vector<NodeWithRange>* const result_nodes) const {
+    std::vector<NodeWithRange>* const result_nodes) {
   std::unique_ptr<Strategy> strategy_ptr;
   strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
 
@@ -163,6 +166,19 @@ bool Navigator::SearchRouteByStrategy(
     double way_start_s = way_s[i - 1];
     double way_end_s = way_s[i];
 
+    // Only the changed legs of a request, e.g. after its last way point
+    // moved, are searched again.
+    std::vector<NodeWithRange> cur_result_nodes;
+    if (route_cache_ != nullptr &&
+        route_cache_->Get(way_start, way_start_s, way_end, way_end_s,
+                          topo_range_manager_.RangeMap(), &cur_result_nodes)) {
+      ADEBUG << "Reuse cached route from " << way_start->LaneId() << " to "
+             << way_end->LaneId();
+      node_vec.insert(node_vec.end(), cur_result_nodes.begin(),
+                      cur_result_nodes.end());
+      continue;
+    }
+
     TopoRangeManager full_range_manager = topo_range_manager_;
     black_list_generator_->AddBlackMapFromTerminal(
         way_start, way_end, way_start_s, way_end_s, &full_range_manager);
@@ -181,13 +197,16 @@ bool Navigator::SearchRouteByStrategy(
       return false;
     }
 
-    std::vector<NodeWithRange> cur_result_nodes;
     if (!strategy_ptr->Search(graph, &sub_graph, start, end,
                               &cur_result_nodes)) {
       AERROR << "Failed to search route with waypoint from " << start->LaneId()
              << " to " << end->LaneId();
       return false;
     }
+    if (route_cache_ != nullptr) {
+      route_cache_->Put(way_start, way_start_s, way_end, way_end_s,
+                        topo_range_manager_.RangeMap(), cur_result_nodes);
+    }
 
     node_vec.insert(node_vec.end(), cur_result_nodes.begin(),
                     cur_result_nodes.end());
@@ -22,6 +22,7 @@
 
 #include "modules/routing/core/black_list_range_generator.h"
 #include "modules/routing/core/result_generator.h"
+#include "modules/routing/core/route_cache.h"
 
 namespace apollo {
 namespace routing {
@@ -46,7 +47,7 @@ class Navigator {
   bool SearchRouteByStrategy(
       const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
       const std::vector<double>& way_s,
-      std::vector<NodeWithRange>* const result_nodes) const;
+      std::vector<NodeWithRange>* const result_nodes);
 
   bool MergeRoute(const std::vector<NodeWithRange>& node_vec,
                   std::vector<NodeWithRange>* const result_node_vec) const;
@@ -59,6 +60,7 @@ class Navigator {
 
   std::unique_ptr<BlackListRangeGenerator> black_list_generator_;
   std::unique_ptr<ResultGenerator> result_generator_;
+  std::unique_ptr<RouteCache> route_cache_;
 };
 
 }  // namespace routing
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/core/route_cache.h"
+
+#include <unordered_set>
+
+namespace apollo {
+namespace routing {
+namespace {
+
+bool IsSameRanges(const std::vector<NodeSRange>& lhs,
+                  const std::vector<NodeSRange>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].StartS() != rhs[i].StartS() || lhs[i].EndS() != rhs[i].EndS()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+RouteCache::RouteCache(const size_t capacity) : capacity_(capacity) {}
+
+bool RouteCache::IsRouteValid(const Entry& entry, const BlackMap& black_map) {
+  // Every range blocked when the route was searched must still be blocked,
+  // otherwise the search may find a cheaper route through it now.
+  for (const auto& black : entry.black_map) {
+    const auto iter = black_map.find(black.first);
+    if (iter == black_map.end() || !IsSameRanges(black.second, iter->second)) {
+      return false;
+    }
+  }
+  if (black_map.size() == entry.black_map.size()) {
+    return true;
+  }
+  std::unordered_set<const TopoNode*> route_nodes;
+  for (const auto& node : entry.route) {
+    route_nodes.insert(node.GetTopoNode());
+  }
+  for (const auto& black : black_map) {
+    if (entry.black_map.count(black.first) == 0 &&
+        route_nodes.count(black.first) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RouteCache::Get(const TopoNode* start_node, const double start_s,
+                     const TopoNode* end_node, const double end_s,
+                     const BlackMap& black_map,
+                     std::vector<NodeWithRange>* const route) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto iter =
+      index_.find(std::make_tuple(start_node, start_s, end_node, end_s));
+  if (iter == index_.end() || !IsRouteValid(*iter->second, black_map)) {
+    return false;
+  }
+  entries_.splice(entries_.begin(), entries_, iter->second);
+  *route = iter->second->route;
+  return true;
+}
+
+void RouteCache::Put(const TopoNode* start_node, const double start_s,
+                     const TopoNode* end_node, const double end_s,
+                     const BlackMap& black_map,
+                     const std::vector<NodeWithRange>& route) {
+  if (capacity_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Key key = std::make_tuple(start_node, start_s, end_node, end_s);
+  const auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    entries_.erase(iter->second);
+    index_.erase(iter);
+  }
+  entries_.push_front(Entry{key, black_map, route});
+  index_[key] = entries_.begin();
+  if (entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/routing/graph/node_with_range.h"
+#include "modules/routing/graph/topo_range_manager.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class RouteCache
+ * @brief Least recently used cache of the routes searched between two way
+ *        points.
+ *
+ * A route is reused under the black list it was searched with, and also
+ * under a black list that only adds ranges on lanes the route doesn't touch:
+ * blocking lanes off the route can't make a cheaper route appear.
+ */
+class RouteCache {
+ public:
+  using BlackMap =
+      std::unordered_map<const TopoNode*, std::vector<NodeSRange>>;
+
+  explicit RouteCache(const size_t capacity);
+  ~RouteCache() = default;
+
+  bool Get(const TopoNode* start_node, const double start_s,
+           const TopoNode* end_node, const double end_s,
+           const BlackMap& black_map,
+           std::vector<NodeWithRange>* const route);
+
+  void Put(const TopoNode* start_node, const double start_s,
+           const TopoNode* end_node, const double end_s,
+           const BlackMap& black_map, const std::vector<NodeWithRange>& route);
+
+ private:
+  using Key = std::tuple<const TopoNode*, double, const TopoNode*, double>;
+  struct Entry {
+    Key key;
+    BlackMap black_map;
+    std::vector<NodeWithRange> route;
+  };
+
+  static bool IsRouteValid(const Entry& entry, const BlackMap& black_map);
+
+  const size_t capacity_;
+  std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<Key, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -18,13 +18,17 @@
 
 #include <utility>
 
+#include "modules/routing/common/routing_gflags.h"
+
 namespace apollo {
 namespace routing {
 
 void TopoGraph::Clear() {
   topo_nodes_.clear();
   topo_edges_.clear();
-  node_index_map_.clear();
+  road_node_map_.clear();
+  csr_.Clear();
+  landmarks_.reset();
 }
 
 bool TopoGraph::LoadNodes(const Graph& graph) {
@@ -32,10 +36,11 @@ bool TopoGraph::LoadNodes(const Graph& graph) {
     AERROR << "No nodes found in topology graph.";
     return false;
   }
+  topo_nodes_.reserve(graph.node_size());
   for (const auto& node : graph.node()) {
-    node_index_map_[node.lane_id()] = static_cast<int>(topo_nodes_.size());
     std::shared_ptr<TopoNode> topo_node;
     topo_node.reset(new TopoNode(node));
+    topo_node->SetIndex(static_cast<int>(topo_nodes_.size()));
     road_node_map_[node.road_id()].insert(topo_node.get());
     topo_nodes_.push_back(std::move(topo_node));
   }
@@ -48,16 +53,12 @@ bool TopoGraph::LoadEdges(const Graph& graph) {
     AINFO << "0 edges found in topology graph, but it's fine";
     return true;
   }
+  // Load() of csr_ has checked that all the edges connect known lanes.
+  topo_edges_.reserve(graph.edge_size());
   for (const auto& edge : graph.edge()) {
-    const std::string& from_lane_id = edge.from_lane_id();
-    const std::string& to_lane_id = edge.to_lane_id();
-    if (node_index_map_.count(from_lane_id) != 1 ||
-        node_index_map_.count(to_lane_id) != 1) {
-      return false;
-    }
     std::shared_ptr<TopoEdge> topo_edge;
-    TopoNode* from_node = topo_nodes_[node_index_map_[from_lane_id]].get();
-    TopoNode* to_node = topo_nodes_[node_index_map_[to_lane_id]].get();
+    TopoNode* from_node = topo_nodes_[csr_.NodeId(edge.from_lane_id())].get();
+    TopoNode* to_node = topo_nodes_[csr_.NodeId(edge.to_lane_id())].get();
     topo_edge.reset(new TopoEdge(edge, from_node, to_node));
     from_node->AddOutEdge(topo_edge.get());
     to_node->AddInEdge(topo_edge.get());
@@ -72,6 +73,10 @@ bool TopoGraph::LoadGraph(const Graph& graph) {
   map_version_ = graph.hdmap_version();
   map_district_ = graph.hdmap_district();
 
+  if (!csr_.Load(graph)) {
+    AERROR << "Failed to index topology graph.";
+    return false;
+  }
   if (!LoadNodes(graph)) {
     AERROR << "Failed to load nodes from topology graph.";
     return false;
@@ -80,20 +85,34 @@ bool TopoGraph::LoadGraph(const Graph& graph) {
     AERROR << "Failed to load edges from topology graph.";
     return false;
   }
+  if (FLAGS_routing_num_landmarks > 0) {
+    BuildLandmarks();
+  }
   AINFO << "Load Topo data successful.";
   return true;
 }
 
+void TopoGraph::BuildLandmarks() {
+  landmarks_.reset(new TopoLandmarks());
+  landmarks_->Build(csr_, FLAGS_routing_num_landmarks);
+}
+
+const TopoLandmarks* TopoGraph::Landmarks() const {
+  return landmarks_ != nullptr && landmarks_->NumLandmarks() > 0
+             ? landmarks_.get()
+             : nullptr;
+}
+
 const std::string& TopoGraph::MapVersion() const { return map_version_; }
 
 const std::string& TopoGraph::MapDistrict() const { return map_district_; }
 
 const TopoNode* TopoGraph::GetNode(const std::string& id) const {
-  const auto& iter = node_index_map_.find(id);
-  if (iter == node_index_map_.end()) {
+  const int index = csr_.NodeId(id);
+  if (index < 0) {
     return nullptr;
   }
-  return topo_nodes_[iter->second].get();
+  return topo_nodes_[index].get();
 }
 
 void TopoGraph::GetNodesByRoadId(
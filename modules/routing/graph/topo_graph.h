@@ -23,6 +23,8 @@
 #include <vector>
 
 #include "cyber/common/log.h"
+#include "modules/routing/graph/topo_graph_csr.h"
+#include "modules/routing/graph/topo_landmarks.h"
 #include "modules/routing/graph/topo_node.h"
 
 namespace apollo {
@@ -41,20 +43,27 @@ class TopoGraph {
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
+  // Landmark cost tables for the search heuristic, nullptr if not built.
+  const TopoLandmarks* Landmarks() const;
+  // The graph in compressed sparse row layout, node i is the node with
+  // Index() i.
+  const TopoGraphCsr& Csr() const { return csr_; }
 
  private:
   void Clear();
   bool LoadNodes(const Graph& graph);
   bool LoadEdges(const Graph& graph);
+  void BuildLandmarks();
 
  private:
   std::string map_version_;
   std::string map_district_;
   std::vector<std::shared_ptr<TopoNode> > topo_nodes_;
   std::vector<std::shared_ptr<TopoEdge> > topo_edges_;
-  std::unordered_map<std::string, int> node_index_map_;
+  TopoGraphCsr csr_;
   std::unordered_map<std::string, std::unordered_set<const TopoNode*> >
       road_node_map_;
+  std::unique_ptr<TopoLandmarks> landmarks_;
 };
 
 }  // namespace routing
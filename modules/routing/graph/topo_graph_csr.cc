@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_graph_csr.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+
+void TopoGraphCsr::Clear() {
+  lane_ids_.clear();
+  node_ids_.clear();
+  node_costs_.clear();
+  node_lengths_.clear();
+  out_offsets_.clear();
+  edge_from_.clear();
+  edge_to_.clear();
+  edge_costs_.clear();
+  edge_forward_.clear();
+  in_offsets_.clear();
+  in_edges_.clear();
+}
+
+bool TopoGraphCsr::Load(const Graph& graph) {
+  Clear();
+  const int num_nodes = graph.node_size();
+  lane_ids_.reserve(num_nodes);
+  node_ids_.reserve(num_nodes);
+  node_costs_.reserve(num_nodes);
+  node_lengths_.reserve(num_nodes);
+  for (const auto& node : graph.node()) {
+    node_ids_[node.lane_id()] = static_cast<int>(lane_ids_.size());
+    lane_ids_.push_back(node.lane_id());
+    node_costs_.push_back(node.cost());
+    node_lengths_.push_back(node.length());
+  }
+
+  // Resolve the lane ids once, then bucket the edges by their from node.
+  const int num_edges = graph.edge_size();
+  std::vector<int> from_nodes(num_edges);
+  std::vector<int> to_nodes(num_edges);
+  out_offsets_.assign(num_nodes + 1, 0);
+  in_offsets_.assign(num_nodes + 1, 0);
+  for (int i = 0; i < num_edges; ++i) {
+    const auto& edge = graph.edge(i);
+    from_nodes[i] = NodeId(edge.from_lane_id());
+    to_nodes[i] = NodeId(edge.to_lane_id());
+    if (from_nodes[i] < 0 || to_nodes[i] < 0) {
+      AERROR << "Edge from " << edge.from_lane_id() << " to "
+             << edge.to_lane_id() << " connects a lane without node.";
+      Clear();
+      return false;
+    }
+    ++out_offsets_[from_nodes[i] + 1];
+    ++in_offsets_[to_nodes[i] + 1];
+  }
+  for (int node = 0; node < num_nodes; ++node) {
+    out_offsets_[node + 1] += out_offsets_[node];
+    in_offsets_[node + 1] += in_offsets_[node];
+  }
+
+  edge_from_.resize(num_edges);
+  edge_to_.resize(num_edges);
+  edge_costs_.resize(num_edges);
+  edge_forward_.resize(num_edges);
+  in_edges_.resize(num_edges);
+  std::vector<int> out_next(out_offsets_.begin(), out_offsets_.end() - 1);
+  for (int i = 0; i < num_edges; ++i) {
+    const int edge_id = out_next[from_nodes[i]]++;
+    edge_from_[edge_id] = from_nodes[i];
+    edge_to_[edge_id] = to_nodes[i];
+    edge_costs_[edge_id] = graph.edge(i).cost();
+    // Same as TopoEdge::Type, anything but a lane change is forward.
+    const auto direction = graph.edge(i).direction_type();
+    edge_forward_[edge_id] =
+        direction != Edge::LEFT && direction != Edge::RIGHT;
+  }
+  // Walking the edges in id order keeps the in edges of a node sorted too.
+  std::vector<int> in_next(in_offsets_.begin(), in_offsets_.end() - 1);
+  for (int edge_id = 0; edge_id < num_edges; ++edge_id) {
+    in_edges_[in_next[edge_to_[edge_id]]++] = edge_id;
+  }
+  return true;
+}
+
+int TopoGraphCsr::NodeId(const std::string& lane_id) const {
+  const auto iter = node_ids_.find(lane_id);
+  return iter == node_ids_.end() ? -1 : iter->second;
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class TopoGraphCsr
+ * @brief The nodes and edges of a routing topo graph in compressed sparse row
+ *        layout: nodes are integer ids in the order of the routing map, the
+ *        edges of a node are contiguous ids, and the lane ids are kept in a
+ *        separate dictionary.
+ */
+class TopoGraphCsr {
+ public:
+  TopoGraphCsr() = default;
+  ~TopoGraphCsr() = default;
+
+  /**
+   * @brief Load the nodes and edges of a routing map.
+   * @return False if an edge connects a lane the graph has no node for.
+   */
+  bool Load(const Graph& graph);
+
+  void Clear();
+
+  int NumNodes() const { return static_cast<int>(lane_ids_.size()); }
+  int NumEdges() const { return static_cast<int>(edge_to_.size()); }
+
+  /**
+   * @brief The id of the node of a lane, -1 if there is none.
+   */
+  int NodeId(const std::string& lane_id) const;
+  const std::string& LaneId(const int node) const { return lane_ids_[node]; }
+  double NodeCost(const int node) const { return node_costs_[node]; }
+  double NodeLength(const int node) const { return node_lengths_[node]; }
+
+  // The out edges of a node are the edge ids in [OutEdgesBegin, OutEdgesEnd).
+  int OutEdgesBegin(const int node) const { return out_offsets_[node]; }
+  int OutEdgesEnd(const int node) const { return out_offsets_[node + 1]; }
+
+  // The in edges of a node are InEdge(i) for i in [InEdgesBegin, InEdgesEnd).
+  int InEdgesBegin(const int node) const { return in_offsets_[node]; }
+  int InEdgesEnd(const int node) const { return in_offsets_[node + 1]; }
+  int InEdge(const int index) const { return in_edges_[index]; }
+
+  int EdgeFrom(const int edge) const { return edge_from_[edge]; }
+  int EdgeTo(const int edge) const { return edge_to_[edge]; }
+  double EdgeCost(const int edge) const { return edge_costs_[edge]; }
+  bool IsForwardEdge(const int edge) const { return edge_forward_[edge] != 0; }
+
+ private:
+  std::vector<std::string> lane_ids_;
+  std::unordered_map<std::string, int> node_ids_;
+  std::vector<double> node_costs_;
+  std::vector<double> node_lengths_;
+
+  std::vector<int> out_offsets_;
+  std::vector<int> edge_from_;
+  std::vector<int> edge_to_;
+  std::vector<double> edge_costs_;
+  std::vector<char> edge_forward_;
+
+  std::vector<int> in_offsets_;
+  std::vector<int> in_edges_;
+};
+
+}  // namespace routing
+}  // namespace apollo
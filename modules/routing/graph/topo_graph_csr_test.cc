@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_graph_csr.h"
+
+#include "gtest/gtest.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+TEST(TopoGraphCsrTestSuit, load) {
+  Graph graph;
+  GetGraphForTest(&graph);
+
+  TopoGraphCsr csr;
+  ASSERT_TRUE(csr.Load(graph));
+  ASSERT_EQ(4, csr.NumNodes());
+  ASSERT_EQ(6, csr.NumEdges());
+  EXPECT_EQ(0, csr.NodeId(TEST_L1));
+  EXPECT_EQ(3, csr.NodeId(TEST_L4));
+  EXPECT_EQ(-1, csr.NodeId(TEST_L6));
+  EXPECT_EQ(TEST_L2, csr.LaneId(1));
+  EXPECT_DOUBLE_EQ(TEST_LANE_COST, csr.NodeCost(2));
+  EXPECT_DOUBLE_EQ(TEST_LANE_LENGTH, csr.NodeLength(2));
+
+  // L1 goes right to L2 and forward to L3, in the order of the map.
+  const int node_1 = csr.NodeId(TEST_L1);
+  ASSERT_EQ(2, csr.OutEdgesEnd(node_1) - csr.OutEdgesBegin(node_1));
+  const int right_edge = csr.OutEdgesBegin(node_1);
+  EXPECT_EQ(node_1, csr.EdgeFrom(right_edge));
+  EXPECT_EQ(csr.NodeId(TEST_L2), csr.EdgeTo(right_edge));
+  EXPECT_FALSE(csr.IsForwardEdge(right_edge));
+  EXPECT_DOUBLE_EQ(TEST_EDGE_COST, csr.EdgeCost(right_edge));
+  EXPECT_EQ(csr.NodeId(TEST_L3), csr.EdgeTo(right_edge + 1));
+  EXPECT_TRUE(csr.IsForwardEdge(right_edge + 1));
+
+  // L4 comes forward from L2 and left from L3.
+  const int node_4 = csr.NodeId(TEST_L4);
+  ASSERT_EQ(2, csr.InEdgesEnd(node_4) - csr.InEdgesBegin(node_4));
+  const int in_edge = csr.InEdge(csr.InEdgesBegin(node_4));
+  EXPECT_EQ(csr.NodeId(TEST_L2), csr.EdgeFrom(in_edge));
+  EXPECT_EQ(node_4, csr.EdgeTo(in_edge));
+  EXPECT_TRUE(csr.IsForwardEdge(in_edge));
+  EXPECT_EQ(csr.NodeId(TEST_L3),
+            csr.EdgeFrom(csr.InEdge(csr.InEdgesBegin(node_4) + 1)));
+}
+
+TEST(TopoGraphCsrTestSuit, unknown_lane) {
+  Graph graph;
+  GetGraphForTest(&graph);
+  GetEdgeForTest(graph.add_edge(), TEST_L4, TEST_L6, Edge::FORWARD);
+
+  TopoGraphCsr csr;
+  EXPECT_FALSE(csr.Load(graph));
+  EXPECT_EQ(0, csr.NumNodes());
+  EXPECT_EQ(0, csr.NumEdges());
+}
+
+}  // namespace routing
+}  // namespace apollo
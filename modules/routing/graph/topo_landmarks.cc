@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_landmarks.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace routing {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+// Index of the node with the largest cost, unreachable nodes first.
+int FarthestNode(const std::vector<double>& costs) {
+  int farthest = 0;
+  for (size_t i = 1; i < costs.size(); ++i) {
+    if (costs[i] > costs[farthest]) {
+      farthest = static_cast<int>(i);
+    }
+  }
+  return farthest;
+}
+
+}  // namespace
+
+// Same cost as AStarStrategy adds for the edge, clamped for Dijkstra.
+double TopoLandmarks::EdgeCost(const TopoEdge* edge) {
+  double cost = edge->Cost() + edge->ToNode()->Cost();
+  if (edge->Type() != TopoEdgeType::TET_FORWARD) {
+    cost -= (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
+  }
+  return std::max(cost, 0.0);
+}
+
+double TopoLandmarks::EdgeCost(const TopoGraphCsr& graph, const int edge) {
+  const double from_cost = graph.NodeCost(graph.EdgeFrom(edge));
+  const double to_cost = graph.NodeCost(graph.EdgeTo(edge));
+  double cost = graph.EdgeCost(edge) + to_cost;
+  if (!graph.IsForwardEdge(edge)) {
+    cost -= (from_cost + to_cost) / 2;
+  }
+  return std::max(cost, 0.0);
+}
+
+void TopoLandmarks::Dijkstra(const Adjacency& adjacency, const int source,
+                             std::vector<double>* const costs) {
+  using CostIndex = std::pair<double, int>;
+  costs->assign(adjacency.size(), kInfinity);
+  std::priority_queue<CostIndex, std::vector<CostIndex>,
+                      std::greater<CostIndex>>
+      open_set;
+  (*costs)[source] = 0.0;
+  open_set.emplace(0.0, source);
+  while (!open_set.empty()) {
+    const auto top = open_set.top();
+    open_set.pop();
+    if (top.first > (*costs)[top.second]) {
+      continue;
+    }
+    for (const auto& neighbor : adjacency[top.second]) {
+      const double cost = top.first + neighbor.second;
+      if (cost < (*costs)[neighbor.first]) {
+        (*costs)[neighbor.first] = cost;
+        open_set.emplace(cost, neighbor.first);
+      }
+    }
+  }
+}
+
+void TopoLandmarks::Build(const TopoGraphCsr& graph,
+                          const size_t num_landmarks) {
+  landmarks_.clear();
+  costs_from_.clear();
+  costs_to_.clear();
+  const size_t num_nodes = graph.NumNodes();
+  if (num_nodes == 0 || num_landmarks == 0) {
+    return;
+  }
+  Adjacency out_adjacency(num_nodes);
+  Adjacency in_adjacency(num_nodes);
+  for (int node = 0; node < graph.NumNodes(); ++node) {
+    out_adjacency[node].reserve(graph.OutEdgesEnd(node) -
+                                graph.OutEdgesBegin(node));
+    for (int edge = graph.OutEdgesBegin(node); edge < graph.OutEdgesEnd(node);
+         ++edge) {
+      out_adjacency[node].emplace_back(graph.EdgeTo(edge),
+                                       EdgeCost(graph, edge));
+    }
+    in_adjacency[node].reserve(graph.InEdgesEnd(node) -
+                               graph.InEdgesBegin(node));
+    for (int i = graph.InEdgesBegin(node); i < graph.InEdgesEnd(node); ++i) {
+      const int edge = graph.InEdge(i);
+      in_adjacency[node].emplace_back(graph.EdgeFrom(edge),
+                                      EdgeCost(graph, edge));
+    }
+  }
+
+  // Farthest point selection: every new landmark is the node farthest from
+  // the landmarks picked so far, which spreads them to the map borders where
+  // they bound the most routes.
+  std::vector<double> min_costs;
+  Dijkstra(out_adjacency, 0, &min_costs);
+  const size_t size = std::min(num_landmarks, num_nodes);
+  for (size_t i = 0; i < size; ++i) {
+    const int landmark = FarthestNode(min_costs);
+    if (i > 0 && min_costs[landmark] == 0.0) {
+      break;
+    }
+    landmarks_.push_back(landmark);
+    costs_from_.emplace_back();
+    costs_to_.emplace_back();
+    Dijkstra(out_adjacency, landmark, &costs_from_.back());
+    Dijkstra(in_adjacency, landmark, &costs_to_.back());
+    if (i == 0) {
+      min_costs = costs_from_.back();
+    } else {
+      for (size_t v = 0; v < min_costs.size(); ++v) {
+        min_costs[v] = std::min(min_costs[v], costs_from_.back()[v]);
+      }
+    }
+  }
+  AINFO << "Built " << landmarks_.size() << " routing landmarks over "
+        << num_nodes << " nodes.";
+}
+
+double TopoLandmarks::LowerBound(const TopoNode* from_node,
+                                 const TopoNode* to_node) const {
+  const int from = from_node->Index();
+  const int to = to_node->Index();
+  if (landmarks_.empty() || from < 0 || to < 0 ||
+      static_cast<size_t>(std::max(from, to)) >= costs_from_[0].size()) {
+    return 0.0;
+  }
+  double lower_bound = 0.0;
+  for (size_t i = 0; i < landmarks_.size(); ++i) {
+    // cost(L, to) <= cost(L, from) + cost(from, to)
+    const double from_landmark_to = costs_from_[i][to];
+    const double from_landmark_from = costs_from_[i][from];
+    if (from_landmark_from != kInfinity && from_landmark_to != kInfinity) {
+      lower_bound =
+          std::max(lower_bound, from_landmark_to - from_landmark_from);
+    }
+    // cost(from, L) <= cost(from, to) + cost(to, L)
+    const double from_to_landmark = costs_to_[i][from];
+    const double to_to_landmark = costs_to_[i][to];
+    if (from_to_landmark != kInfinity && to_to_landmark != kInfinity) {
+      lower_bound = std::max(lower_bound, from_to_landmark - to_to_landmark);
+    }
+  }
+  return lower_bound;
+}
+
+}  // namespace routing
+}  // namespace apollo
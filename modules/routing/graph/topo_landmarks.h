@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "modules/routing/graph/topo_graph_csr.h"
+#include "modules/routing/graph/topo_node.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class TopoLandmarks
+ * @brief Shortest path costs from and to a few landmark nodes of a topo graph,
+ *        which give A* search a lower bound of the cost between any two nodes
+ *        from the triangle inequality.
+ */
+class TopoLandmarks {
+ public:
+  TopoLandmarks() = default;
+  ~TopoLandmarks() = default;
+
+  /**
+   * @brief Pick the landmarks among nodes and compute their cost tables.
+   * @param graph The graph, whose node ids are the TopoNode::Index().
+   * @param num_landmarks The number of landmarks to pick.
+   */
+  void Build(const TopoGraphCsr& graph, const size_t num_landmarks);
+
+  size_t NumLandmarks() const { return landmarks_.size(); }
+
+  /**
+   * @brief Lower bound of the search cost from from_node to to_node, sub
+   *        nodes are bounded by their origin nodes.
+   */
+  double LowerBound(const TopoNode* from_node, const TopoNode* to_node) const;
+
+  /**
+   * @brief The cost of moving along edge during search and in the tables.
+   */
+  static double EdgeCost(const TopoEdge* edge);
+  static double EdgeCost(const TopoGraphCsr& graph, const int edge);
+
+ private:
+  using Adjacency = std::vector<std::vector<std::pair<int, double>>>;
+
+  static void Dijkstra(const Adjacency& adjacency, const int source,
+                       std::vector<double>* const costs);
+
+  std::vector<int> landmarks_;
+  // costs_from_[i][v] is the cost from the i-th landmark to node v, and
+  // costs_to_[i][v] the cost from node v to it.
+  std::vector<std::vector<double>> costs_from_;
+  std::vector<std::vector<double>> costs_to_;
+};
+
+}  // namespace routing
+}  // namespace apollo
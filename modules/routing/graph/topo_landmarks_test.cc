@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/topo_landmarks.h"
+
+#include "gtest/gtest.h"
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+TEST(TopoLandmarksTestSuit, lower_bound) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+
+  FLAGS_routing_num_landmarks = 2;
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  FLAGS_routing_num_landmarks = 0;
+
+  const TopoLandmarks* landmarks = topo_graph.Landmarks();
+  ASSERT_TRUE(landmarks != nullptr);
+  ASSERT_EQ(2, landmarks->NumLandmarks());
+
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_3 = topo_graph.GetNode(TEST_L3);
+  const TopoNode* node_6 = topo_graph.GetNode(TEST_L6);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_TRUE(node_3 != nullptr);
+  ASSERT_TRUE(node_6 != nullptr);
+
+  // L1 -> L3 -> L5 -> L6, two forward edges and one lane change.
+  const double forward_cost = TEST_EDGE_COST + TEST_LANE_COST;
+  const double change_cost = TEST_EDGE_COST;
+  const double cost_1_6 = 2 * forward_cost + change_cost;
+  EXPECT_DOUBLE_EQ(0.0, landmarks->LowerBound(node_1, node_1));
+  EXPECT_NEAR(cost_1_6, landmarks->LowerBound(node_1, node_6), 1e-9);
+  EXPECT_LE(landmarks->LowerBound(node_1, node_3), forward_cost + 1e-9);
+  // L1 is not reachable from L6, but the bound never overestimates.
+  EXPECT_DOUBLE_EQ(0.0, landmarks->LowerBound(node_6, node_1));
+}
+
+TEST(TopoLandmarksTestSuit, not_built) {
+  Graph graph;
+  GetGraphForTest(&graph);
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  EXPECT_TRUE(topo_graph.Landmarks() == nullptr);
+}
+
+}  // namespace routing
+}  // namespace apollo
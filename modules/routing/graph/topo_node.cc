@@ -229,6 +229,10 @@ const TopoEdge* TopoNode::GetOutEdgeTo(const TopoNode* to_node) const {
 
 const TopoNode* TopoNode::OriginNode() const { return origin_node_; }
 
+int TopoNode::Index() const { return origin_node_->index_; }
+
+void TopoNode::SetIndex(const int index) { index_ = index; }
+
 double TopoNode::StartS() const { return start_s_; }
 
 double TopoNode::EndS() const { return end_s_; }
@@ -67,6 +67,9 @@ class TopoNode {
   const TopoEdge* GetOutEdgeTo(const TopoNode* to_node) const;
 
   const TopoNode* OriginNode() const;
+  // Id of the origin node in TopoGraph::Csr(), -1 if it has none.
+  int Index() const;
+  void SetIndex(const int index);
   double StartS() const;
   double EndS() const;
   bool IsSubNode() const;
@@ -110,6 +113,7 @@ class TopoNode {
   std::unordered_map<const TopoNode*, const TopoEdge*> in_edge_map_;
 
   const TopoNode* origin_node_;
+  int index_ = -1;
 };
 
 enum TopoEdgeType {
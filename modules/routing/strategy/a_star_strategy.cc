@@ -214,6 +214,9 @@ void AStarStrategy::Clear() {
 
 double AStarStrategy::HeuristicCost(const TopoNode* src_node,
                                     const TopoNode* dest_node) {
+  if (landmarks_ != nullptr) {
+    return landmarks_->LowerBound(src_node, dest_node);
+  }
   const auto& src_point = src_node->AnchorPoint();
   const auto& dest_point = dest_node->AnchorPoint();
   double distance = std::fabs(src_point.x() - dest_point.x()) +
@@ -227,6 +230,9 @@ bool AStarStrategy::Search(const TopoGraph* graph,
                            std::vector<NodeWithRange>* const result_nodes) {
   Clear();
   AINFO << "Start A* search algorithm.";
+  // The landmark bound is consistent, so g_score_ then holds plain costs and
+  // the first time dest_node is popped its route is the cheapest one.
+  landmarks_ = graph->Landmarks();
 
   std::priority_queue<SearchNode> open_set_detail;
 
@@ -290,7 +296,12 @@ bool AStarStrategy::Search(const TopoGraph* graph,
             (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
       }
       double f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      if (open_set_.count(to_node) != 0 && f >= g_score_[to_node]) {
+      if (landmarks_ != nullptr) {
+        const auto iter = g_score_.find(to_node);
+        if (iter != g_score_.end() && tentative_g_score >= iter->second) {
+          continue;
+        }
+      } else if (open_set_.count(to_node) != 0 && f >= g_score_[to_node]) {
         continue;
       }
       // if to_node is reached by forward, reset enter_s to start_s
@@ -310,7 +321,7 @@ bool AStarStrategy::Search(const TopoGraph* graph,
         enter_s_[to_node] = to_node_enter_s;
       }
 
-      g_score_[to_node] = f;
+      g_score_[to_node] = landmarks_ != nullptr ? tentative_g_score : f;
       SearchNode next_node(to_node);
       next_node.f = f;
       open_set_detail.push(next_node);
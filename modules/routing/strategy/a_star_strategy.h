@@ -20,6 +20,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "modules/routing/graph/topo_landmarks.h"
 #include "modules/routing/strategy/strategy.h"
 
 namespace apollo {
@@ -42,6 +43,7 @@ class AStarStrategy : public Strategy {
 
  private:
   bool change_lane_enabled_;
+  const TopoLandmarks* landmarks_ = nullptr;
   std::unordered_set<const TopoNode*> open_set_;
   std::unordered_set<const TopoNode*> closed_set_;
   std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
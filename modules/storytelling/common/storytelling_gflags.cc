@@ -20,3 +20,6 @@ DEFINE_double(search_radius, 1.0, "Search radius for a junction");
 
 DEFINE_double(adc_trajectory_search_distance, 10.0,
               "How far to search junction along adc planning trajectory");
+
+DEFINE_bool(enable_incremental_storytelling, false,
+            "Skip the tellers whose inputs did not change since last frame");
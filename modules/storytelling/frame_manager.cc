@@ -16,19 +16,124 @@
 
 #include "modules/storytelling/frame_manager.h"
 
+#include <vector>
+
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/storytelling/common/storytelling_gflags.h"
+
 namespace apollo {
 namespace storytelling {
+namespace {
+
+using apollo::common::PathPoint;
+using apollo::hdmap::HDMapUtil;
+using apollo::planning::ADCTrajectory;
+
+// Sets overlap to the first element found around point by search.
+template <class InfoConstPtr>
+void SearchOverlap(
+    const common::PointENU& point, const double distance,
+    int (apollo::hdmap::HDMap::*search)(const common::PointENU&, double,
+                                        std::vector<InfoConstPtr>*) const,
+    std::vector<InfoConstPtr>* elements, TrajectoryOverlap* overlap) {
+  if (overlap->Exists()) {
+    return;
+  }
+  elements->clear();
+  if ((HDMapUtil::BaseMap().*search)(point, FLAGS_search_radius, elements) ==
+          0 &&
+      !elements->empty()) {
+    overlap->id = elements->front()->id().id();
+    overlap->distance = distance;
+  }
+}
+
+/**
+ * @brief Get overlaps within search radius.
+ */
+void SearchOverlaps(const ADCTrajectory& adc_trajectory,
+                    TrajectoryOverlaps* overlaps) {
+  *overlaps = TrajectoryOverlaps();
+  if (adc_trajectory.trajectory_point().empty()) {
+    return;
+  }
+  const double s_start = adc_trajectory.trajectory_point(0).path_point().s();
+
+  std::vector<apollo::hdmap::ClearAreaInfoConstPtr> clear_areas;
+  std::vector<apollo::hdmap::CrosswalkInfoConstPtr> crosswalks;
+  std::vector<apollo::hdmap::JunctionInfoConstPtr> junctions;
+  std::vector<apollo::hdmap::PNCJunctionInfoConstPtr> pnc_junctions;
+  std::vector<apollo::hdmap::SignalInfoConstPtr> signals;
+  std::vector<apollo::hdmap::StopSignInfoConstPtr> stop_signs;
+  std::vector<apollo::hdmap::YieldSignInfoConstPtr> yield_signs;
+  common::PointENU hdmap_point;
+  for (const auto& point : adc_trajectory.trajectory_point()) {
+    const PathPoint& path_point = point.path_point();
+    if (path_point.s() > FLAGS_adc_trajectory_search_distance) {
+      break;
+    }
+    hdmap_point.set_x(path_point.x());
+    hdmap_point.set_y(path_point.y());
+    const double distance = path_point.s() - s_start;
+    SearchOverlap(hdmap_point, distance, &apollo::hdmap::HDMap::GetClearAreas,
+                  &clear_areas, &overlaps->clear_area);
+    SearchOverlap(hdmap_point, distance, &apollo::hdmap::HDMap::GetCrosswalks,
+                  &crosswalks, &overlaps->crosswalk);
+    SearchOverlap(hdmap_point, distance, &apollo::hdmap::HDMap::GetJunctions,
+                  &junctions, &overlaps->junction);
+    SearchOverlap(hdmap_point, distance,
+                  &apollo::hdmap::HDMap::GetPNCJunctions, &pnc_junctions,
+                  &overlaps->pnc_junction);
+    SearchOverlap(hdmap_point, distance, &apollo::hdmap::HDMap::GetSignals,
+                  &signals, &overlaps->signal);
+    SearchOverlap(hdmap_point, distance, &apollo::hdmap::HDMap::GetStopSigns,
+                  &stop_signs, &overlaps->stop_sign);
+    SearchOverlap(hdmap_point, distance, &apollo::hdmap::HDMap::GetYieldSigns,
+                  &yield_signs, &overlaps->yield_sign);
+  }
+}
+
+}  // namespace
 
 FrameManager::FrameManager(const std::shared_ptr<cyber::Node>& node)
     : log_buffer_(apollo::common::monitor::MonitorMessageItem::STORYTELLING),
       node_(node) {}
 
-void FrameManager::StartFrame() { node_->Observe(); }
+void FrameManager::Init(const StorytellingConfig& storytelling_conf) {
+  planning_reader_ = CreateOrGetReader<ADCTrajectory>(
+      storytelling_conf.topic_config().planning_trajectory_topic());
+}
+
+void FrameManager::StartFrame() {
+  node_->Observe();
+  if (planning_reader_ == nullptr) {
+    return;
+  }
+  auto trajectory = planning_reader_->GetLatestObserved();
+  planning_trajectory_updated_ = trajectory != planning_trajectory_;
+  if (planning_trajectory_updated_) {
+    // the map does not change, so the overlaps only change with the trajectory
+    planning_trajectory_ = trajectory;
+    overlaps_searched_ = false;
+  }
+}
 
 void FrameManager::EndFrame() {
   // Print and publish all monitor logs.
   log_buffer_.Publish();
 }
 
+const TrajectoryOverlaps& FrameManager::PlanningTrajectoryOverlaps() {
+  if (!overlaps_searched_) {
+    if (planning_trajectory_ == nullptr) {
+      overlaps_ = TrajectoryOverlaps();
+    } else {
+      SearchOverlaps(*planning_trajectory_, &overlaps_);
+    }
+    overlaps_searched_ = true;
+  }
+  return overlaps_;
+}
+
 }  // namespace storytelling
 }  // namespace apollo
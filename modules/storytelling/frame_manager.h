@@ -21,21 +21,59 @@
 
 #include "cyber/common/macros.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/storytelling/proto/storytelling_config.pb.h"
 
 namespace apollo {
 namespace storytelling {
 
+// The first map element of a kind along the planning trajectory.
+struct TrajectoryOverlap {
+  std::string id;
+  // Distance from the trajectory start, negative if there is none.
+  double distance = -1.0;
+
+  bool Exists() const { return !id.empty() && distance >= 0; }
+};
+
+struct TrajectoryOverlaps {
+  TrajectoryOverlap clear_area;
+  TrajectoryOverlap crosswalk;
+  TrajectoryOverlap junction;
+  TrajectoryOverlap pnc_junction;
+  TrajectoryOverlap signal;
+  TrajectoryOverlap stop_sign;
+  TrajectoryOverlap yield_sign;
+};
+
 class FrameManager {
  public:
   FrameManager() = delete;
   explicit FrameManager(const std::shared_ptr<cyber::Node>& node);
 
+  void Init(const StorytellingConfig& storytelling_conf);
+
   void StartFrame();
   void EndFrame();
 
   // Getters.
   apollo::common::monitor::MonitorLogBuffer& LogBuffer() { return log_buffer_; }
 
+  // Latest planning trajectory of the frame, nullptr if there is none.
+  const std::shared_ptr<apollo::planning::ADCTrajectory>& PlanningTrajectory()
+      const {
+    return planning_trajectory_;
+  }
+
+  // True if the planning trajectory is not the one of the last frame.
+  bool PlanningTrajectoryUpdated() const {
+    return planning_trajectory_updated_;
+  }
+
+  // Map overlaps along the planning trajectory. They are searched on the
+  // first call for a trajectory and shared by all tellers after that.
+  const TrajectoryOverlaps& PlanningTrajectoryOverlaps();
+
   // Cyber reader / writer creator.
   template <class T>
   std::shared_ptr<cyber::Reader<T>> CreateOrGetReader(
@@ -52,6 +90,13 @@ class FrameManager {
  private:
   apollo::common::monitor::MonitorLogBuffer log_buffer_;
   std::shared_ptr<cyber::Node> node_;
+
+  std::shared_ptr<cyber::Reader<apollo::planning::ADCTrajectory>>
+      planning_reader_;
+  std::shared_ptr<apollo::planning::ADCTrajectory> planning_trajectory_;
+  bool planning_trajectory_updated_ = false;
+  bool overlaps_searched_ = false;
+  TrajectoryOverlaps overlaps_;
 };
 
 }  // namespace storytelling
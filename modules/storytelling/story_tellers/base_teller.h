@@ -32,6 +32,8 @@ class BaseTeller {
   virtual ~BaseTeller() = default;
   virtual void Init(const StorytellingConfig& storytelling_conf) = 0;
   virtual void Update(Stories* stories) = 0;
+  // True if the inputs of the stories changed since the last Update.
+  virtual bool InputsUpdated() const { return true; }
 
  protected:
   std::shared_ptr<FrameManager> frame_manager_;
@@ -16,6 +16,7 @@
 #include "modules/storytelling/storytelling.h"
 
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/storytelling/common/storytelling_gflags.h"
 #include "modules/storytelling/story_tellers/close_to_junction_teller.h"
 
 namespace apollo {
@@ -35,6 +36,7 @@ bool Storytelling::Init() {
       node_->CreateWriter<Stories>(config_.topic_config().storytelling_topic());
 
   // Init all tellers.
+  frame_manager_->Init(config_);
   for (const auto& teller : story_tellers_) {
     teller->Init(config_);
   }
@@ -45,8 +47,12 @@ bool Storytelling::Init() {
 bool Storytelling::Proc() {
   frame_manager_->StartFrame();
 
-  // Query all tellers.
+  // Query all tellers, the stories of a teller stay as they are until its
+  // inputs change.
   for (const auto& teller : story_tellers_) {
+    if (FLAGS_enable_incremental_storytelling && !teller->InputsUpdated()) {
+      continue;
+    }
     teller->Update(&stories_);
   }
 
@@ -62,28 +62,26 @@ void ThirdPartyPerceptionMobileye::OnMobileye(const Mobileye& message) {
 void ThirdPartyPerceptionMobileye::OnDelphiESR(const DelphiESR& message) {
   ADEBUG << "Received delphi esr data: run delphi esr callback.";
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
-  last_radar_obstacles_.CopyFrom(current_radar_obstacles_);
+  // the current obstacles become the last ones, no need to copy them
+  last_radar_obstacles_.Swap(&current_radar_obstacles_);
   current_radar_obstacles_ = conversion_radar::DelphiToRadarObstacles(
       message, localization_, last_radar_obstacles_);
-  RadarObstacles filtered_radar_obstacles =
-      filter::FilterRadarObstacles(current_radar_obstacles_);
   if (FLAGS_enable_radar) {
-    radar_obstacles_ = conversion_radar::RadarObstaclesToPerceptionObstacles(
-        filtered_radar_obstacles);
+    conversion_radar::RadarObstaclesToPerceptionObstacles(
+        current_radar_obstacles_, &filter::IsPreserved, &radar_obstacles_);
   }
 }
 
 void ThirdPartyPerceptionMobileye::OnContiRadar(const ContiRadar& message) {
   ADEBUG << "Received delphi esr data: run continental radar callback.";
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
-  last_radar_obstacles_.CopyFrom(current_radar_obstacles_);
+  // the current obstacles become the last ones, no need to copy them
+  last_radar_obstacles_.Swap(&current_radar_obstacles_);
   current_radar_obstacles_ = conversion_radar::ContiToRadarObstacles(
       message, localization_, last_radar_obstacles_, chassis_);
-  RadarObstacles filtered_radar_obstacles =
-      filter::FilterRadarObstacles(current_radar_obstacles_);
   if (FLAGS_enable_radar) {
-    radar_obstacles_ = conversion_radar::RadarObstaclesToPerceptionObstacles(
-        filtered_radar_obstacles);
+    conversion_radar::RadarObstaclesToPerceptionObstacles(
+        current_radar_obstacles_, &filter::IsPreserved, &radar_obstacles_);
   }
 }
 
@@ -94,7 +92,9 @@ bool ThirdPartyPerceptionMobileye::Process(
 
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
 
-  *response = fusion::EyeRadarFusion(eye_obstacles_, radar_obstacles_);
+  // fuse in place and hand the obstacles over instead of copying them
+  fusion::EyeRadarFusion(radar_obstacles_, &eye_obstacles_);
+  response->Swap(&eye_obstacles_);
 
   common::util::FillHeader(FLAGS_third_party_perception_node_name, response);
 
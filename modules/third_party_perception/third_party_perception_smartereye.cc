@@ -67,7 +67,7 @@ bool ThirdPartyPerceptionSmartereye::Process(
 
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
 
-  *response = eye_obstacles_;
+  response->Swap(&eye_obstacles_);
 
   common::util::FillHeader(FLAGS_third_party_perception_node_name, response);
 
@@ -275,10 +275,22 @@ RadarObstacles DelphiToRadarObstacles(
 PerceptionObstacles RadarObstaclesToPerceptionObstacles(
     const RadarObstacles& radar_obstacles) {
   PerceptionObstacles obstacles;
+  RadarObstaclesToPerceptionObstacles(radar_obstacles, nullptr, &obstacles);
+  return obstacles;
+}
+
+void RadarObstaclesToPerceptionObstacles(
+    const RadarObstacles& radar_obstacles,
+    bool (*is_preserved)(const RadarObstacle&),
+    PerceptionObstacles* obstacles) {
+  obstacles->Clear();
 
   for (const auto& iter : radar_obstacles.radar_obstacle()) {
-    auto* pob = obstacles.add_perception_obstacle();
     const auto& radar_obstacle = iter.second;
+    if (is_preserved != nullptr && !is_preserved(radar_obstacle)) {
+      continue;
+    }
+    auto* pob = obstacles->add_perception_obstacle();
 
     pob->set_id(radar_obstacle.id() + FLAGS_radar_id_offset);
 
@@ -304,9 +316,7 @@ PerceptionObstacles RadarObstaclesToPerceptionObstacles(
     pob->set_confidence(0.01);
   }
 
-  obstacles.mutable_header()->CopyFrom(radar_obstacles.header());
-
-  return obstacles;
+  obstacles->mutable_header()->CopyFrom(radar_obstacles.header());
 }
 
 }  // namespace conversion_radar
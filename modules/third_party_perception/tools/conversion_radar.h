@@ -48,6 +48,14 @@ RadarObstacles ContiToRadarObstacles(
 apollo::perception::PerceptionObstacles RadarObstaclesToPerceptionObstacles(
     const RadarObstacles& radar_obstacles);
 
+// Converts the radar obstacles for which is_preserved is true, or all of
+// them when it is null. obstacles is cleared first, so its allocated
+// obstacles are reused.
+void RadarObstaclesToPerceptionObstacles(
+    const RadarObstacles& radar_obstacles,
+    bool (*is_preserved)(const RadarObstacle&),
+    apollo::perception::PerceptionObstacles* obstacles);
+
 }  // namespace conversion_radar
 }  // namespace third_party_perception
 }  // namespace apollo
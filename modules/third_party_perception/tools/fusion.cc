@@ -67,21 +67,39 @@ bool HasOverlap(const PerceptionObstacle& obstacle,
 PerceptionObstacles EyeRadarFusion(const PerceptionObstacles& eye_obstacles,
                                    const PerceptionObstacles& radar_obstacles) {
   PerceptionObstacles eye_obstacles_fusion = eye_obstacles;
-  PerceptionObstacles radar_obstacles_fusion = radar_obstacles;
+  EyeRadarFusion(radar_obstacles, &eye_obstacles_fusion);
 
-  for (auto& eye_obstacle :
-       *(eye_obstacles_fusion.mutable_perception_obstacle())) {
-    for (auto& radar_obstacle :
-         *(radar_obstacles_fusion.mutable_perception_obstacle())) {
-      if (HasOverlap(eye_obstacle, radar_obstacle)) {
+  // mobileye_obstacles_fusion.MergeFrom(radar_obstacles_fusion);
+  return eye_obstacles_fusion;
+}
+
+void EyeRadarFusion(const PerceptionObstacles& radar_obstacles,
+                    PerceptionObstacles* eye_obstacles) {
+  if (eye_obstacles->perception_obstacle().empty() ||
+      radar_obstacles.perception_obstacle().empty()) {
+    return;
+  }
+  // every polygon is built once, the overlap test rejects the pairs whose
+  // bounding boxes are apart before looking at the polygons
+  std::vector<common::math::Polygon2d> radar_polygons;
+  radar_polygons.reserve(radar_obstacles.perception_obstacle_size());
+  for (const auto& radar_obstacle : radar_obstacles.perception_obstacle()) {
+    radar_polygons.emplace_back(
+        PerceptionObstacleToVectorVec2d(radar_obstacle));
+  }
+
+  for (auto& eye_obstacle : *(eye_obstacles->mutable_perception_obstacle())) {
+    const common::math::Polygon2d eye_polygon(
+        PerceptionObstacleToVectorVec2d(eye_obstacle));
+    for (std::size_t i = 0; i < radar_polygons.size(); ++i) {
+      if (eye_polygon.HasOverlap(radar_polygons[i])) {
         eye_obstacle.set_confidence(0.99);
-        eye_obstacle.mutable_velocity()->CopyFrom(radar_obstacle.velocity());
+        eye_obstacle.mutable_velocity()->CopyFrom(
+            radar_obstacles.perception_obstacle(static_cast<int>(i))
+                .velocity());
       }
     }
   }
-
-  // mobileye_obstacles_fusion.MergeFrom(radar_obstacles_fusion);
-  return eye_obstacles_fusion;
 }
 
 }  // namespace fusion
@@ -34,6 +34,11 @@ apollo::perception::PerceptionObstacles EyeRadarFusion(
     const apollo::perception::PerceptionObstacles& eye_obstacles,
     const apollo::perception::PerceptionObstacles& radar_obstacles);
 
+// Same as above, but fuses radar_obstacles into eye_obstacles in place.
+void EyeRadarFusion(
+    const apollo::perception::PerceptionObstacles& radar_obstacles,
+    apollo::perception::PerceptionObstacles* eye_obstacles);
+
 }  // namespace fusion
 }  // namespace third_party_perception
 }  // namespace apollo
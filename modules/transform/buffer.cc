@@ -17,12 +17,16 @@
 #include "modules/transform/buffer.h"
 
 #include "absl/strings/str_cat.h"
+#include "cyber/base/rw_lock_guard.h"
 #include "cyber/cyber.h"
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 
 using Time = ::apollo::cyber::Time;
 using Clock = ::apollo::cyber::Clock;
+using ::apollo::cyber::base::AtomicRWLock;
+using ::apollo::cyber::base::ReadLockGuard;
+using ::apollo::cyber::base::WriteLockGuard;
 
 namespace {
 constexpr float kSecondToNanoFactor = 1e9f;
@@ -31,7 +35,13 @@ constexpr float kSecondToNanoFactor = 1e9f;
 namespace apollo {
 namespace transform {
 
-Buffer::Buffer() : BufferCore() { Init(); }
+constexpr Buffer::FrameHandle Buffer::kInvalidFrameHandle;
+
+Buffer::Buffer() : BufferCore() {
+  // handle 0 is kInvalidFrameHandle
+  frame_names_.emplace_back();
+  Init();
+}
 
 int Buffer::Init() {
   const std::string node_name =
@@ -110,7 +120,9 @@ void Buffer::SubscriptionCallbackImpl(
       if (is_static) {
         static_msgs_.push_back(trans_stamped);
       }
-      setTransform(trans_stamped, authority, is_static);
+      if (setTransform(trans_stamped, authority, is_static)) {
+        UpdateStaticGraph(trans_stamped, is_static);
+      }
     } catch (tf2::TransformException& ex) {
       std::string temp = ex.what();
       AERROR << "Failure to set received transform:" << temp.c_str();
@@ -132,6 +144,212 @@ bool Buffer::GetLatestStaticTF(const std::string& frame_id,
   return false;
 }
 
+Buffer::FrameHandle Buffer::GetFrameHandle(const std::string& frame_id) {
+  if (frame_id.empty()) {
+    return kInvalidFrameHandle;
+  }
+  {
+    ReadLockGuard<AtomicRWLock> lock(frame_lock_);
+    auto iter = frame_handles_.find(frame_id);
+    if (iter != frame_handles_.end()) {
+      return iter->second;
+    }
+  }
+  WriteLockGuard<AtomicRWLock> lock(frame_lock_);
+  auto iter = frame_handles_.find(frame_id);
+  if (iter != frame_handles_.end()) {
+    return iter->second;
+  }
+  FrameHandle frame = static_cast<FrameHandle>(frame_names_.size());
+  frame_names_.push_back(frame_id);
+  frame_handles_[frame_id] = frame;
+  return frame;
+}
+
+std::string Buffer::GetFrameName(FrameHandle frame) const {
+  ReadLockGuard<AtomicRWLock> lock(frame_lock_);
+  if (frame >= frame_names_.size()) {
+    return std::string();
+  }
+  return frame_names_[frame];
+}
+
+void Buffer::UpdateStaticGraph(
+    const geometry_msgs::TransformStamped& tf2_trans_stamped,
+    bool is_static) {
+  FrameHandle child = GetFrameHandle(tf2_trans_stamped.child_frame_id);
+  FrameHandle parent = GetFrameHandle(tf2_trans_stamped.header.frame_id);
+  if (!is_static) {
+    {
+      ReadLockGuard<AtomicRWLock> lock(static_lock_);
+      if (dynamic_children_.count(child) > 0) {
+        return;
+      }
+    }
+    WriteLockGuard<AtomicRWLock> lock(static_lock_);
+    dynamic_children_.insert(child);
+    static_parents_.erase(child);
+    static_chains_.clear();
+    ++static_generation_;
+    return;
+  }
+
+  const auto& translation = tf2_trans_stamped.transform.translation;
+  const auto& rotation = tf2_trans_stamped.transform.rotation;
+  StaticEdge edge;
+  edge.parent = parent;
+  edge.transform = tf2::Transform(
+      tf2::Quaternion(rotation.x, rotation.y, rotation.z, rotation.w),
+      tf2::Vector3(translation.x, translation.y, translation.z));
+
+  WriteLockGuard<AtomicRWLock> lock(static_lock_);
+  if (dynamic_children_.count(child) > 0) {
+    return;
+  }
+  static_parents_[child] = edge;
+  static_chains_.clear();
+  ++static_generation_;
+}
+
+bool Buffer::ComposeStaticChain(FrameHandle target_frame,
+                                FrameHandle source_frame,
+                                tf2::Transform* transform) const {
+  // ancestors of the source with ancestor <- source
+  std::unordered_map<FrameHandle, tf2::Transform> source_ancestors;
+  FrameHandle frame = source_frame;
+  tf2::Transform frame_from_source = tf2::Transform::getIdentity();
+  source_ancestors.emplace(frame, frame_from_source);
+  while (true) {
+    auto edge = static_parents_.find(frame);
+    if (edge == static_parents_.end()) {
+      break;
+    }
+    frame_from_source = edge->second.transform * frame_from_source;
+    frame = edge->second.parent;
+    if (!source_ancestors.emplace(frame, frame_from_source).second) {
+      // loop in the static transforms, leave it to tf2
+      return false;
+    }
+  }
+
+  // walk up from the target until the first common ancestor
+  frame = target_frame;
+  tf2::Transform frame_from_target = tf2::Transform::getIdentity();
+  for (size_t depth = 0; depth <= static_parents_.size(); ++depth) {
+    auto common = source_ancestors.find(frame);
+    if (common != source_ancestors.end()) {
+      *transform = frame_from_target.inverse() * common->second;
+      return true;
+    }
+    auto edge = static_parents_.find(frame);
+    if (edge == static_parents_.end()) {
+      return false;
+    }
+    frame_from_target = edge->second.transform * frame_from_target;
+    frame = edge->second.parent;
+  }
+  return false;
+}
+
+bool Buffer::LookupStaticChain(FrameHandle target_frame,
+                               FrameHandle source_frame,
+                               tf2::Transform* transform) const {
+  const uint64_t key =
+      (static_cast<uint64_t>(target_frame) << 32) | source_frame;
+  StaticChain chain;
+  uint64_t generation = 0;
+  {
+    ReadLockGuard<AtomicRWLock> lock(static_lock_);
+    auto iter = static_chains_.find(key);
+    if (iter != static_chains_.end()) {
+      if (iter->second.is_static) {
+        *transform = iter->second.transform;
+      }
+      return iter->second.is_static;
+    }
+    chain.is_static =
+        ComposeStaticChain(target_frame, source_frame, &chain.transform);
+    generation = static_generation_;
+  }
+  {
+    WriteLockGuard<AtomicRWLock> lock(static_lock_);
+    // the graph changed while composing, do not cache a stale chain
+    if (generation == static_generation_) {
+      static_chains_.emplace(key, chain);
+    }
+  }
+  if (chain.is_static) {
+    *transform = chain.transform;
+  }
+  return chain.is_static;
+}
+
+bool Buffer::LookupTransform(FrameHandle target_frame,
+                             FrameHandle source_frame, const cyber::Time& time,
+                             TransformStamped* transform,
+                             std::string* errstr) const {
+  const std::string target_frame_id = GetFrameName(target_frame);
+  const std::string source_frame_id = GetFrameName(source_frame);
+  if (target_frame_id.empty() || source_frame_id.empty()) {
+    if (errstr != nullptr) {
+      *errstr = absl::StrCat("invalid frame handle: ", target_frame, " <- ",
+                             source_frame);
+    }
+    return false;
+  }
+
+  tf2::Transform chain;
+  if (LookupStaticChain(target_frame, source_frame, &chain)) {
+    transform->mutable_header()->set_timestamp_sec(time.ToSecond());
+    transform->mutable_header()->set_frame_id(target_frame_id);
+    transform->set_child_frame_id(source_frame_id);
+    const tf2::Vector3& origin = chain.getOrigin();
+    auto* translation = transform->mutable_transform()->mutable_translation();
+    translation->set_x(origin.x());
+    translation->set_y(origin.y());
+    translation->set_z(origin.z());
+    const tf2::Quaternion rotation = chain.getRotation();
+    auto* quaternion = transform->mutable_transform()->mutable_rotation();
+    quaternion->set_qx(rotation.x());
+    quaternion->set_qy(rotation.y());
+    quaternion->set_qz(rotation.z());
+    quaternion->set_qw(rotation.w());
+    return true;
+  }
+
+  try {
+    *transform = lookupTransform(target_frame_id, source_frame_id, time);
+  } catch (tf2::TransformException& ex) {
+    if (errstr != nullptr) {
+      *errstr = ex.what();
+    }
+    return false;
+  }
+  return true;
+}
+
+bool Buffer::LookupTransforms(const std::vector<FramePair>& frame_pairs,
+                              const cyber::Time& time,
+                              std::vector<TransformStamped>* transforms,
+                              std::string* errstr) const {
+  transforms->resize(frame_pairs.size());
+  if (errstr != nullptr) {
+    errstr->clear();
+  }
+  bool found_all = true;
+  std::string pair_errstr;
+  for (size_t i = 0; i < frame_pairs.size(); ++i) {
+    if (!LookupTransform(frame_pairs[i].first, frame_pairs[i].second, time,
+                         &(*transforms)[i], &pair_errstr)) {
+      found_all = false;
+      if (errstr != nullptr) {
+        absl::StrAppend(errstr, errstr->empty() ? "" : "; ", pair_errstr);
+      }
+    }
+  }
+  return found_all;
+}
+
 void Buffer::TF2MsgToCyber(
     const geometry_msgs::TransformStamped& tf2_trans_stamped,
     TransformStamped& trans_stamped) const {
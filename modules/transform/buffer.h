@@ -18,11 +18,16 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "tf2/LinearMath/Transform.h"
 #include "tf2/buffer_core.h"
 #include "tf2/convert.h"
 
+#include "cyber/base/atomic_rw_lock.h"
 #include "cyber/node/node.h"
 #include "modules/transform/buffer_interface.h"
 
@@ -32,6 +37,13 @@ namespace transform {
 // extend the BufferInterface class and BufferCore class
 class Buffer : public BufferInterface, public tf2::BufferCore {
  public:
+  // integer id of a frame, valid for the lifetime of the buffer
+  using FrameHandle = uint32_t;
+  // (target_frame, source_frame)
+  using FramePair = std::pair<FrameHandle, FrameHandle>;
+
+  static constexpr FrameHandle kInvalidFrameHandle = 0;
+
   /**
    * @brief  Constructor for a Buffer object
    * @param cache_time How long to keep a history of transforms
@@ -116,7 +128,53 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
                          const std::string& child_frame_id,
                          TransformStamped* tf);
 
+  /** \brief Get the handle of a frame, registering the frame if needed.
+   * \param frame_id The frame id
+   * \return The handle of the frame, kInvalidFrameHandle for an empty id
+   */
+  FrameHandle GetFrameHandle(const std::string& frame_id);
+
+  /** \brief Get the transform between two frames by frame handle.
+   * Chains made only of static transforms are composed once and served from
+   * a cache, the other ones are looked up in the tf2 buffer without waiting.
+   * \param target_frame The frame to which data should be transformed
+   * \param source_frame The frame where the data originated
+   * \param time The time at which the value of the transform is desired
+   * \param transform The transform between the frames
+   * \param errstr A pointer to a string which will be filled with why the
+   * lookup failed, if not nullptr
+   * \return True if the transform was found, false otherwise
+   */
+  bool LookupTransform(FrameHandle target_frame, FrameHandle source_frame,
+                       const cyber::Time& time, TransformStamped* transform,
+                       std::string* errstr = nullptr) const;
+
+  /** \brief Get the transforms of several frame pairs at a common time.
+   * \param frame_pairs The (target_frame, source_frame) pairs
+   * \param time The time at which the values of the transforms are desired
+   * \param transforms The transforms, in the order of frame_pairs
+   * \param errstr A pointer to a string which will be filled with why the
+   * lookups failed, if not nullptr
+   * \return True if all the transforms were found, false otherwise
+   */
+  bool LookupTransforms(const std::vector<FramePair>& frame_pairs,
+                        const cyber::Time& time,
+                        std::vector<TransformStamped>* transforms,
+                        std::string* errstr = nullptr) const;
+
  private:
+  struct StaticEdge {
+    FrameHandle parent = kInvalidFrameHandle;
+    // parent <- child
+    tf2::Transform transform;
+  };
+
+  struct StaticChain {
+    bool is_static = false;
+    // target <- source
+    tf2::Transform transform;
+  };
+
   void SubscriptionCallback(
       const std::shared_ptr<const TransformStampeds>& transform);
   void StaticSubscriptionCallback(
@@ -128,6 +186,15 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
   void TF2MsgToCyber(const geometry_msgs::TransformStamped& tf2_trans_stamped,
                      TransformStamped& trans_stamped) const;  // NOLINT
 
+  std::string GetFrameName(FrameHandle frame) const;
+  void UpdateStaticGraph(
+      const geometry_msgs::TransformStamped& tf2_trans_stamped,
+      bool is_static);
+  bool LookupStaticChain(FrameHandle target_frame, FrameHandle source_frame,
+                         tf2::Transform* transform) const;
+  bool ComposeStaticChain(FrameHandle target_frame, FrameHandle source_frame,
+                          tf2::Transform* transform) const;
+
   std::unique_ptr<cyber::Node> node_;
   std::shared_ptr<cyber::Reader<TransformStampeds>> message_subscriber_tf_;
   std::shared_ptr<cyber::Reader<TransformStampeds>>
@@ -136,6 +203,18 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
   cyber::Time last_update_;
   std::vector<geometry_msgs::TransformStamped> static_msgs_;
 
+  mutable cyber::base::AtomicRWLock frame_lock_;
+  std::unordered_map<std::string, FrameHandle> frame_handles_;
+  std::vector<std::string> frame_names_;
+
+  // static transforms keyed by child frame, children that were ever
+  // published on /tf are left out so that their chains go through tf2
+  mutable cyber::base::AtomicRWLock static_lock_;
+  std::unordered_map<FrameHandle, StaticEdge> static_parents_;
+  std::unordered_set<FrameHandle> dynamic_children_;
+  mutable std::unordered_map<uint64_t, StaticChain> static_chains_;
+  uint64_t static_generation_ = 0;
+
   DECLARE_SINGLETON(Buffer)
 };  // class
 
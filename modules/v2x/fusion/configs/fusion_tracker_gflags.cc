@@ -34,6 +34,12 @@ DEFINE_string(v2x_fusion_obstacles_topic, "/apollo/msf/obstacles",
 DEFINE_bool(use_v2x, false, "use v2x");
 // fusion
 DEFINE_string(fusion_conf_file, "fusion_params.pt", "the roi conf path");
+DEFINE_bool(v2x_fusion_sparse_association, false,
+            "score only the object pairs within the match distance through a "
+            "grid and run km on each group of connected pairs");
+DEFINE_bool(v2x_fusion_keep_track_association, false,
+            "keep the matches of the last frame while the tracks stay within "
+            "the match distance, needs v2x_fusion_sparse_association");
 // app
 DEFINE_string(app_conf_file, "app_config.pt", "the inputs conf path");
 
@@ -34,6 +34,8 @@ DECLARE_string(v2x_fusion_obstacles_topic);
 DECLARE_bool(use_v2x);
 // fusion
 DECLARE_string(fusion_conf_file);
+DECLARE_bool(v2x_fusion_sparse_association);
+DECLARE_bool(v2x_fusion_keep_track_association);
 // app
 DECLARE_string(app_conf_file);
 
@@ -17,12 +17,34 @@
 #include "modules/v2x/fusion/libs/fusion/fusion.h"
 
 #include <cmath>
+#include <numeric>
+#include <unordered_map>
 #include <utility>
 
 namespace apollo {
 namespace v2x {
 namespace ft {
 
+namespace {
+
+int FindRoot(std::vector<int> *parents, int i) {
+  while ((*parents)[i] != i) {
+    (*parents)[i] = (*parents)[(*parents)[i]];
+    i = (*parents)[i];
+  }
+  return i;
+}
+
+int64_t GridCoord(const double value, const double cell_size) {
+  return static_cast<int64_t>(std::floor(value / cell_size));
+}
+
+int64_t GridKey(const int64_t x, const int64_t y) {
+  return (x << 32) ^ (y & 0xffffffff);
+}
+
+}  // namespace
+
 Fusion::Fusion() {
   ft_config_manager_ptr_ = FTConfigManager::Instance();
 
@@ -81,6 +103,21 @@ bool Fusion::CombineNewResource(
     }
     return true;
   }
+  if (FLAGS_v2x_fusion_sparse_association) {
+    std::vector<int> new_to_fused;
+    SparseAssociate(*fused_objects, new_objects, &new_to_fused);
+    for (size_t j = 0; j < new_objects.size(); ++j) {
+      if (new_to_fused[j] == -1) {
+        fused_objects->push_back(new_objects[j]);
+        std::vector<base::Object> matched_objects;
+        matched_objects.push_back(fused_objects->back());
+        fusion_result->push_back(matched_objects);
+      } else {
+        (*fusion_result)[new_to_fused[j]].push_back(new_objects[j]);
+      }
+    }
+    return true;
+  }
   int u_num = fused_objects->size();
   int v_num = new_objects.size();
   Eigen::MatrixXf association_mat(u_num, v_num);
@@ -174,27 +211,167 @@ bool Fusion::CheckTypeScore(const base::Object &in1_ptr,
   return true;
 }
 
+float Fusion::ComputeScore(const base::Object &in1_ptr,
+                           const base::Object &in2_ptr) {
+  double score = 0;
+  if (!CheckDisScore(in1_ptr, in2_ptr, &score)) {
+    AERROR << "V2X Fusion: check dis score failed";
+  }
+  if (score_params_.check_type() &&
+      !CheckTypeScore(in1_ptr, in2_ptr, &score)) {
+    AERROR << "V2X Fusion: check type failed";
+  }
+  return (score >= score_params_.min_score()) ? static_cast<float>(score) : 0;
+}
+
 bool Fusion::ComputeAssociateMatrix(
     const std::vector<base::Object> &in1_objects,  // fused
     const std::vector<base::Object> &in2_objects,  // new
     Eigen::MatrixXf *association_mat) {
   for (unsigned int i = 0; i < in1_objects.size(); ++i) {
     for (unsigned int j = 0; j < in2_objects.size(); ++j) {
-      const base::Object &obj1_ptr = in1_objects[i];
-      const base::Object &obj2_ptr = in2_objects[j];
-      double score = 0;
-      if (!CheckDisScore(obj1_ptr, obj2_ptr, &score)) {
-        AERROR << "V2X Fusion: check dis score failed";
+      (*association_mat)(i, j) = ComputeScore(in1_objects[i], in2_objects[j]);
+    }
+  }
+  return true;
+}
+
+void Fusion::SparseAssociate(const std::vector<base::Object> &fused_objects,
+                             const std::vector<base::Object> &new_objects,
+                             std::vector<int> *new_to_fused) {
+  const int u_num = static_cast<int>(fused_objects.size());
+  const int v_num = static_cast<int>(new_objects.size());
+  new_to_fused->assign(v_num, -1);
+  std::vector<bool> fused_taken(u_num, false);
+  std::map<int, TrackKey> *associations =
+      &track_associations_[new_objects.front().frame_id];
+
+  // keep the matches of the last frame which are still plausible, only the
+  // new and the moved tracks go through km again
+  if (FLAGS_v2x_fusion_keep_track_association && !associations->empty()) {
+    std::map<TrackKey, int> fused_index;
+    for (int i = 0; i < u_num; ++i) {
+      if (fused_objects[i].track_id >= 0) {
+        fused_index.emplace(
+            TrackKey(fused_objects[i].frame_id, fused_objects[i].track_id), i);
       }
-      if (score_params_.check_type() &&
-          !CheckTypeScore(obj1_ptr, obj2_ptr, &score)) {
-        AERROR << "V2X Fusion: check type failed";
+    }
+    for (int j = 0; j < v_num; ++j) {
+      const auto last = associations->find(new_objects[j].track_id);
+      if (new_objects[j].track_id < 0 || last == associations->end()) {
+        continue;
       }
-      (*association_mat)(i, j) =
-          (score >= score_params_.min_score()) ? score : 0;
+      const auto fused = fused_index.find(last->second);
+      if (fused == fused_index.end() || fused_taken[fused->second] ||
+          ComputeScore(fused_objects[fused->second], new_objects[j]) <= 0) {
+        continue;
+      }
+      (*new_to_fused)[j] = fused->second;
+      fused_taken[fused->second] = true;
+    }
+  }
+
+  // a pair further than max_match_distance scores 0, so only the fused
+  // objects in the neighbouring cells of a grid this size are candidates
+  const double cell_size = score_params_.max_match_distance();
+  std::vector<std::pair<int, int>> edges;
+  std::vector<float> scores;
+  if (cell_size > 0) {
+    std::unordered_map<int64_t, std::vector<int>> grid;
+    for (int i = 0; i < u_num; ++i) {
+      if (!fused_taken[i]) {
+        grid[GridKey(GridCoord(fused_objects[i].position.x(), cell_size),
+                     GridCoord(fused_objects[i].position.y(), cell_size))]
+            .push_back(i);
+      }
+    }
+    for (int j = 0; j < v_num; ++j) {
+      if ((*new_to_fused)[j] != -1) {
+        continue;
+      }
+      const int64_t x = GridCoord(new_objects[j].position.x(), cell_size);
+      const int64_t y = GridCoord(new_objects[j].position.y(), cell_size);
+      for (int64_t dx = -1; dx <= 1; ++dx) {
+        for (int64_t dy = -1; dy <= 1; ++dy) {
+          const auto cell = grid.find(GridKey(x + dx, y + dy));
+          if (cell == grid.end()) {
+            continue;
+          }
+          for (const int i : cell->second) {
+            const float score = ComputeScore(fused_objects[i], new_objects[j]);
+            if (score > 0) {
+              edges.emplace_back(i, j);
+              scores.push_back(score);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // pairs without a shared object never compete, so km runs on each group
+  // of connected objects alone, fused objects are nodes [0, u_num) and new
+  // objects [u_num, u_num + v_num)
+  std::vector<int> parents(u_num + v_num);
+  std::iota(parents.begin(), parents.end(), 0);
+  for (const auto &edge : edges) {
+    parents[FindRoot(&parents, edge.first)] =
+        FindRoot(&parents, u_num + edge.second);
+  }
+  std::unordered_map<int, std::vector<size_t>> groups;
+  for (size_t k = 0; k < edges.size(); ++k) {
+    groups[FindRoot(&parents, edges[k].first)].push_back(k);
+  }
+  std::vector<int> local_index(u_num + v_num, -1);
+  std::vector<int> group_fused;
+  std::vector<int> group_new;
+  std::vector<std::pair<int, int>> match_cps;
+  for (const auto &group : groups) {
+    if (group.second.size() == 1) {
+      const auto &edge = edges[group.second.front()];
+      (*new_to_fused)[edge.second] = edge.first;
+      continue;
+    }
+    group_fused.clear();
+    group_new.clear();
+    for (const size_t k : group.second) {
+      if (local_index[edges[k].first] == -1) {
+        local_index[edges[k].first] = static_cast<int>(group_fused.size());
+        group_fused.push_back(edges[k].first);
+      }
+      if (local_index[u_num + edges[k].second] == -1) {
+        local_index[u_num + edges[k].second] =
+            static_cast<int>(group_new.size());
+        group_new.push_back(edges[k].second);
+      }
+    }
+    Eigen::MatrixXf association_mat =
+        Eigen::MatrixXf::Zero(group_fused.size(), group_new.size());
+    for (const size_t k : group.second) {
+      association_mat(local_index[edges[k].first],
+                      local_index[u_num + edges[k].second]) = scores[k];
+    }
+    if (group_fused.size() > group_new.size()) {
+      km_matcher_.GetKMResult(association_mat.transpose(), &match_cps, true);
+    } else {
+      km_matcher_.GetKMResult(association_mat, &match_cps, false);
+    }
+    for (const auto &match : match_cps) {
+      if (match.first != -1 && match.second != -1) {
+        (*new_to_fused)[group_new[match.second]] = group_fused[match.first];
+      }
+    }
+  }
+
+  associations->clear();
+  for (int j = 0; j < v_num; ++j) {
+    const int i = (*new_to_fused)[j];
+    if (i != -1 && new_objects[j].track_id >= 0 &&
+        fused_objects[i].track_id >= 0) {
+      (*associations)[new_objects[j].track_id] =
+          TrackKey(fused_objects[i].frame_id, fused_objects[i].track_id);
     }
   }
-  return true;
 }
 
 int Fusion::DeleteRedundant(std::vector<base::Object> *objects) {
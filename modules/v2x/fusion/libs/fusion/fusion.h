@@ -22,12 +22,15 @@
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Core>
 
 #include "modules/v2x/fusion/configs/ft_config_manager.h"
+#include "modules/v2x/fusion/configs/fusion_tracker_gflags.h"
 #include "modules/v2x/fusion/libs/common/v2x_object.h"
 #include "modules/v2x/fusion/libs/fusion/km.h"
 
@@ -56,7 +59,17 @@ class Fusion {
   int DeleteRedundant(std::vector<base::Object> *objects);
 
  private:
+  // source frame id and track id of an object
+  using TrackKey = std::pair<std::string, int>;
+
   bool CombineNewResource(const std::vector<base::Object> &new_objects);
+  // Matches only the pairs within the match distance, see
+  // FLAGS_v2x_fusion_sparse_association. Fills the fused index of every new
+  // object, -1 for the unmatched ones.
+  void SparseAssociate(const std::vector<base::Object> &fused_objects,
+                       const std::vector<base::Object> &new_objects,
+                       std::vector<int> *new_to_fused);
+  float ComputeScore(const base::Object &in1_ptr, const base::Object &in2_ptr);
   bool ComputeAssociateMatrix(const std::vector<base::Object> &in1_objects,
                               const std::vector<base::Object> &in2_objects,
                               Eigen::MatrixXf *association_mat);
@@ -76,6 +89,9 @@ class Fusion {
   fusion::ScoreParams score_params_;
   std::vector<std::vector<base::Object>> fusion_result_;
   std::vector<base::Object> updated_objects_;
+  // the fused track each new track was matched to in the last frame, by new
+  // source frame id
+  std::map<std::string, std::map<int, TrackKey>> track_associations_;
 };
 
 }  // namespace ft
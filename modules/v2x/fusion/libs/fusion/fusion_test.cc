@@ -17,6 +17,8 @@
 
 #include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -56,6 +58,60 @@ TEST(Fusion, get_km_result) {
   EXPECT_LE(fused_objects.size(), 12);
 }
 
+base::Object MakeObject(double x, double y, int track_id,
+                        const std::string &frame_id) {
+  base::Object obj;
+  Eigen::Vector3d pos(x, y, 0);
+  Eigen::Matrix3d var = Eigen::Matrix3d::Identity();
+  obj.position.Set(pos, var);
+  obj.type = base::ObjectType::VEHICLE;
+  obj.sub_type = base::ObjectSubType::CAR;
+  obj.sub_type_probs.push_back(0.8f);
+  obj.track_id = track_id;
+  obj.frame_id = frame_id;
+  return obj;
+}
+
+TEST(Fusion, sparse_association) {
+  std::vector<base::Object> objects1;
+  std::vector<base::Object> objects2;
+  for (int i = 0; i < 50; ++i) {
+    objects1.push_back(MakeObject(i * 37.0, (i % 7) * 53.0, i, "VEHICLE"));
+    if (i % 3 != 0) {
+      objects2.push_back(
+          MakeObject(i * 37.0 + 0.5, (i % 7) * 53.0 - 0.5, 100 + i, "V2X"));
+    }
+  }
+  objects2.push_back(MakeObject(-500.0, -500.0, 200, "V2X"));
+
+  Fusion fusion;
+  std::vector<base::Object> dense_objects;
+  std::vector<std::vector<base::Object>> dense_result;
+  EXPECT_TRUE(
+      fusion.CombineNewResource(objects1, &dense_objects, &dense_result));
+  EXPECT_TRUE(
+      fusion.CombineNewResource(objects2, &dense_objects, &dense_result));
+
+  FLAGS_v2x_fusion_sparse_association = true;
+  for (const bool keep : {false, true, true}) {
+    FLAGS_v2x_fusion_keep_track_association = keep;
+    std::vector<base::Object> sparse_objects;
+    std::vector<std::vector<base::Object>> sparse_result;
+    EXPECT_TRUE(
+        fusion.CombineNewResource(objects1, &sparse_objects, &sparse_result));
+    EXPECT_TRUE(
+        fusion.CombineNewResource(objects2, &sparse_objects, &sparse_result));
+    ASSERT_EQ(dense_result.size(), sparse_result.size());
+    for (size_t i = 0; i < dense_result.size(); ++i) {
+      ASSERT_EQ(dense_result[i].size(), sparse_result[i].size());
+      EXPECT_EQ(dense_result[i].back().track_id,
+                sparse_result[i].back().track_id);
+    }
+  }
+  FLAGS_v2x_fusion_sparse_association = false;
+  FLAGS_v2x_fusion_keep_track_association = false;
+}
+
 }  // namespace ft
 }  // namespace v2x
 }  // namespace apollo